@@ -0,0 +1,599 @@
+/**
+ * \file geobench.cpp
+ * \brief Benchmarks for the core GeographicLib solvers
+ *
+ * Each benchmark applies one operation to a fixed set of randomly generated
+ * inputs.  The inputs are generated with std::mt19937 using a fixed seed (and
+ * without the implementation-defined std distributions), so that the
+ * workloads are the same on all platforms and for all values of
+ * GEOGRAPHICLIB_PRECISION.  The reported time is the minimum over several
+ * repetitions of the time per operation.  The checksum, a sum of the
+ * results, allows changes in the results to be detected.  Alternatively,
+ * with -f, the geodesic problems are sampled from a file of the geodesic
+ * test data, GeodTest.dat; this gives a representative workload (e.g., for
+ * the training run of the pgo target).
+ *
+ * Copyright (c) Charles Karney (2023) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/GeodesicLine.hpp>
+#include <GeographicLib/GeodesicExact.hpp>
+#include <GeographicLib/GeodesicTrack.hpp>
+#include <GeographicLib/Rhumb.hpp>
+#include <GeographicLib/TransverseMercator.hpp>
+#include <GeographicLib/TransverseMercatorExact.hpp>
+#include <GeographicLib/UTMUPS.hpp>
+#include <GeographicLib/MGRS.hpp>
+#include <GeographicLib/MGRSCache.hpp>
+#include <GeographicLib/OSGB.hpp>
+#include <GeographicLib/Geoid.hpp>
+#include <GeographicLib/GravityModel.hpp>
+#include <GeographicLib/MagneticModel.hpp>
+#include <GeographicLib/PolygonArea.hpp>
+#include <GeographicLib/Intersect.hpp>
+#include <GeographicLib/JacobiConformal.hpp>
+#include <GeographicLib/TriaxialGeodesic.hpp>
+#include <GeographicLib/Utility.hpp>
+
+using namespace std;
+using namespace GeographicLib;
+
+typedef Math::real T;
+
+namespace {
+
+  // The workloads
+  class Workload {
+  public:
+    size_t n;
+    vector<T> lat1, lon1, azi1, lat2, lon2, s12, h;
+    vector<int> zone;
+    vector<bool> northp;
+    vector<T> x, y;
+    vector<string> mgrs;
+    Workload(size_t num, unsigned seed, const string& testfile)
+      : n(num) {
+      mt19937 r(seed);
+      // Uniform deviate in [a, b) which doesn't depend on the implementation
+      // of std::uniform_real_distribution.
+      auto uniform = [&r](T a, T b) -> T {
+        return a + (b - a) * (T(r()) / T(4294967296.0));
+      };
+      if (testfile.empty()) {
+        for (size_t i = 0; i < n; ++i) {
+          // Points uniformly distributed on the sphere
+          lat1.push_back(asin(uniform(-1, 1)) / Math::degree<T>());
+          lon1.push_back(uniform(-180, 180));
+          azi1.push_back(uniform(-180, 180));
+          lat2.push_back(asin(uniform(-1, 1)) / Math::degree<T>());
+          lon2.push_back(uniform(-180, 180));
+          s12.push_back(uniform(0, 20000e3));
+        }
+      } else {
+        // Sample the geodesic problems evenly from a file in the format
+        // of GeodTest.dat: lat1 lon1 azi1 lat2 lon2 azi2 s12 ...
+        ifstream str(testfile.c_str());
+        if (!str.good())
+          throw GeographicErr("Cannot open " + testfile);
+        vector<string> lines;
+        for (string line; getline(str, line);)
+          if (!line.empty()) lines.push_back(line);
+        size_t stride = max(size_t(1), lines.size() / num);
+        for (size_t k = 0; k < lines.size() && lat1.size() < num;
+             k += stride) {
+          istringstream is(lines[k]);
+          T la1, lo1, az1, la2, lo2, az2, s;
+          if (!(is >> la1 >> lo1 >> az1 >> la2 >> lo2 >> az2 >> s))
+            throw GeographicErr("Bad line in " + testfile + ": " + lines[k]);
+          lat1.push_back(la1); lon1.push_back(lo1); azi1.push_back(az1);
+          lat2.push_back(la2); lon2.push_back(lo2); s12.push_back(s);
+        }
+        n = lat1.size();
+        if (n == 0)
+          throw GeographicErr("No geodesic problems in " + testfile);
+      }
+      for (size_t i = 0; i < n; ++i)
+        h.push_back(uniform(-100, 10000));
+      for (size_t i = 0; i < n; ++i) {
+        int z; bool np; T xx, yy, gam, k;
+        UTMUPS::Forward(lat1[i], lon1[i], z, np, xx, yy, gam, k);
+        zone.push_back(z); northp.push_back(np);
+        x.push_back(xx); y.push_back(yy);
+        string s;
+        MGRS::Forward(z, np, xx, yy, lat1[i], 5, s);
+        mgrs.push_back(s);
+      }
+    }
+  };
+
+  class Bench {
+  private:
+    const vector<string>& _filters;
+    int _reps;
+  public:
+    Bench(const vector<string>& filters, int reps)
+      : _filters(filters), _reps(reps) {}
+    bool selected(const string& name) const {
+      if (_filters.empty()) return true;
+      for (const string& f : _filters)
+        if (name.find(f) != string::npos) return true;
+      return false;
+    }
+    // Time f(i) for i in [0, n); f returns a value which is accumulated in
+    // the checksum.
+    template<class F>
+    void run(const string& name, size_t n, F f) const {
+      if (!selected(name)) return;
+      typedef chrono::steady_clock clock;
+      double best = 0;
+      T sum = 0;
+      for (int rep = 0; rep < _reps; ++rep) {
+        T s = 0;
+        clock::time_point t0 = clock::now();
+        for (size_t i = 0; i < n; ++i)
+          s += f(i);
+        double t = chrono::duration<double>(clock::now() - t0).count();
+        if (rep == 0 || t < best) best = t;
+        sum = s;
+      }
+      cout << left << setw(36) << name << right
+           << setw(12) << fixed << setprecision(1) << 1e9 * best / double(n)
+           << " ns  checksum " << Utility::str(sum, 6) << "\n";
+    }
+    void skip(const string& name, const string& reason) const {
+      if (!selected(name)) return;
+      cout << left << setw(36) << name << " skipped: " << reason << "\n";
+    }
+  };
+
+} // namespace
+
+int usage(int retval) {
+  ( retval ? cerr : cout ) <<
+"geobench [ -n count ] [ -r reps ] [ -s seed ] [ -f file ] [ -h ]\n\
+    [ name ... ]\n\
+\n\
+Time the core GeographicLib solvers using fixed-seed random workloads.\n\
+-n count the number of operations in each benchmark (default 100000)\n\
+-r reps the benchmark is repeated reps times and the minimum time\n\
+   is reported (default 5)\n\
+-s seed the seed for the random number generator (default 1)\n\
+-f file take the geodesic problems from file, which is in the format of\n\
+   the geodesic test data, GeodTest.dat; count problems are sampled\n\
+   evenly from the file\n\
+-h print this help\n\
+\n\
+If any names are given, only the benchmarks whose names contain one of\n\
+these strings are run.  The benchmarks for Geoid, GravityModel, and\n\
+MagneticModel use the default models and are skipped if these are not\n\
+installed.\n";
+  return retval;
+}
+
+int main(int argc, const char* const argv[]) {
+  try {
+    Utility::set_digits();
+    size_t num = 100000;
+    int reps = 5;
+    unsigned seed = 1;
+    string testfile;
+    vector<string> filters;
+    for (int m = 1; m < argc; ++m) {
+      string arg(argv[m]);
+      if (arg == "-f") {
+        if (++m == argc) return usage(1);
+        testfile = argv[m];
+      } else if (arg == "-n" || arg == "-r" || arg == "-s") {
+        if (++m == argc) return usage(1);
+        try {
+          long long v = Utility::val<long long>(string(argv[m]));
+          if (v < 1) return usage(1);
+          if (arg == "-n") num = size_t(v);
+          else if (arg == "-r") reps = int(v);
+          else seed = unsigned(v);
+        }
+        catch (const exception&) {
+          return usage(1);
+        }
+      } else if (arg == "-h")
+        return usage(0);
+      else if (arg.size() > 0 && arg[0] == '-')
+        return usage(1);
+      else
+        filters.push_back(arg);
+    }
+
+    cout << "GeographicLib " << GEOGRAPHICLIB_VERSION_STRING
+         << ", GEOGRAPHICLIB_PRECISION = " << GEOGRAPHICLIB_PRECISION
+         << " (" << Math::digits() << " bits)"
+         << ", GEOGRAPHICLIB_GEODESIC_ORDER = " << GEOGRAPHICLIB_GEODESIC_ORDER
+         << "\n";
+
+    const Workload w(num, seed, testfile);
+    const Bench b(filters, reps);
+    const size_t n = w.n;
+    cout << "count = " << n << ", reps = " << reps
+         << ", seed = " << seed;
+    if (!testfile.empty())
+      cout << ", geodesics from " << testfile;
+    cout << "\n";
+
+    {
+      const Geodesic& g = Geodesic::WGS84();
+      b.run("Geodesic::Direct", n, [&](size_t i) -> T {
+          T lat, lon;
+          g.Direct(w.lat1[i], w.lon1[i], w.azi1[i], w.s12[i], lat, lon);
+          return lat + lon;
+        });
+      b.run("Geodesic::Inverse", n, [&](size_t i) -> T {
+          T s12, azi1, azi2;
+          g.Inverse(w.lat1[i], w.lon1[i], w.lat2[i], w.lon2[i],
+                    s12, azi1, azi2);
+          return s12 / 1000 + azi1 + azi2;
+        });
+      const GeodesicLine l = g.Line(w.lat1[0], w.lon1[0], w.azi1[0]);
+      b.run("GeodesicLine::Position", n, [&](size_t i) -> T {
+          T lat, lon;
+          l.Position(w.s12[i], lat, lon);
+          return lat + lon;
+        });
+      // A track with 100 km legs which turns by up to 3 degrees at each
+      // point.
+      vector<T> tlat(n + 1), tlon(n + 1);
+      {
+        T lat = w.lat1[0] / 2, lon = w.lon1[0], azi = w.azi1[0];
+        for (size_t i = 0; i <= n; ++i) {
+          tlat[i] = lat; tlon[i] = lon;
+          if (i < n) {
+            g.Direct(lat, lon, azi, 100e3, lat, lon, azi);
+            azi += w.azi1[i] / 60;
+          }
+        }
+      }
+      b.run("Geodesic::Inverse(track)", n, [&](size_t i) -> T {
+          T s12, azi1, azi2;
+          g.Inverse(tlat[i], tlon[i], tlat[i+1], tlon[i+1], s12, azi1, azi2);
+          return s12 / 1000 + azi1 + azi2;
+        });
+      GeodesicTrack track(g);
+      b.run("GeodesicTrack::Inverse", n, [&](size_t i) -> T {
+          T s12, azi1, azi2;
+          track.Inverse(tlat[i], tlon[i], tlat[i+1], tlon[i+1],
+                        s12, azi1, azi2);
+          return s12 / 1000 + azi1 + azi2;
+        });
+    }
+    {
+      const GeodesicExact& g = GeodesicExact::WGS84();
+      b.run("GeodesicExact::Direct", n, [&](size_t i) -> T {
+          T lat, lon;
+          g.Direct(w.lat1[i], w.lon1[i], w.azi1[i], w.s12[i], lat, lon);
+          return lat + lon;
+        });
+      b.run("GeodesicExact::Inverse", n, [&](size_t i) -> T {
+          T s12, azi1, azi2;
+          g.Inverse(w.lat1[i], w.lon1[i], w.lat2[i], w.lon2[i],
+                    s12, azi1, azi2);
+          return s12 / 1000 + azi1 + azi2;
+        });
+    }
+    {
+      // An ellipsoid with a large flattening for which Geodesic is
+      // inaccurate.  The batch GenInverse is timed by solving a block of
+      // problems at the start of each block, so the time is per problem.
+      const Geodesic g(T(6.4e6), T(1)/10);
+      const GeodesicExact ge(T(6.4e6), T(1)/10);
+      b.run("Geodesic::Inverse(f=1/10)", n, [&](size_t i) -> T {
+          T s12, azi1, azi2;
+          g.Inverse(w.lat1[i], w.lon1[i], w.lat2[i], w.lon2[i],
+                    s12, azi1, azi2);
+          return s12 / 1000 + azi1 + azi2;
+        });
+      b.run("GeodesicExact::Direct(f=1/10)", n, [&](size_t i) -> T {
+          T lat, lon;
+          ge.Direct(w.lat1[i], w.lon1[i], w.azi1[i], w.s12[i], lat, lon);
+          return lat + lon;
+        });
+      b.run("GeodesicExact::Inverse(f=1/10)", n, [&](size_t i) -> T {
+          T s12, azi1, azi2;
+          ge.Inverse(w.lat1[i], w.lon1[i], w.lat2[i], w.lon2[i],
+                     s12, azi1, azi2);
+          return s12 / 1000 + azi1 + azi2;
+        });
+      const size_t block = 1000;
+      vector<T> s12(block), azi1(block), azi2(block);
+      b.run("GeodesicExact::GenInverse[](f=1/10)", n, [&](size_t i) -> T {
+          if (i % block) return 0;
+          const size_t m = min(block, n - i);
+          ge.GenInverse(m, &w.lat1[i], &w.lon1[i], &w.lat2[i], &w.lon2[i],
+                        GeodesicExact::DISTANCE | GeodesicExact::AZIMUTH,
+                        s12.data(), azi1.data(), azi2.data(),
+                        nullptr, nullptr, nullptr, nullptr);
+          T sum = 0;
+          for (size_t k = 0; k < m; ++k)
+            sum += s12[k] / 1000 + azi1[k] + azi2[k];
+          return sum;
+        });
+    }
+    {
+      const Rhumb& r = Rhumb::WGS84();
+      b.run("Rhumb::Direct", n, [&](size_t i) -> T {
+          T lat, lon;
+          r.Direct(w.lat1[i] / 2, w.lon1[i], w.azi1[i], w.s12[i] / 20,
+                   lat, lon);
+          return lat + lon;
+        });
+      b.run("Rhumb::Inverse", n, [&](size_t i) -> T {
+          T s12, azi12;
+          r.Inverse(w.lat1[i], w.lon1[i], w.lat2[i], w.lon2[i], s12, azi12);
+          return s12 / 1000 + azi12;
+        });
+    }
+    {
+      // Points within 30 degrees of the central meridian
+      const TransverseMercator& tm = TransverseMercator::UTM();
+      const TransverseMercatorExact& tmx = TransverseMercatorExact::UTM();
+      b.run("TransverseMercator::Forward", n, [&](size_t i) -> T {
+          T x, y;
+          tm.Forward(0, w.lat1[i], w.lon1[i] / 6, x, y);
+          return x / 1000 + y / 1000;
+        });
+      b.run("TransverseMercator::Reverse", n, [&](size_t i) -> T {
+          T lat, lon;
+          tm.Reverse(0, w.x[i] - 500e3, w.y[i], lat, lon);
+          return lat + lon;
+        });
+      b.run("TransverseMercatorExact::Forward", n, [&](size_t i) -> T {
+          T x, y;
+          tmx.Forward(0, w.lat1[i], w.lon1[i] / 6, x, y);
+          return x / 1000 + y / 1000;
+        });
+      b.run("TransverseMercatorExact::Reverse", n, [&](size_t i) -> T {
+          T lat, lon;
+          tmx.Reverse(0, w.x[i] - 500e3, w.y[i], lat, lon);
+          return lat + lon;
+        });
+    }
+    {
+      // A triaxial ellipsoid with the dimensions of Vesta (km)
+      const JacobiConformal jc(T(286.3), T(278.6), T(223.2));
+      b.run("JacobiConformal::Forward", n, [&](size_t i) -> T {
+          T x, y;
+          jc.Forward(w.lon1[i], w.lat1[i], x, y);
+          return x + y;
+        });
+      b.run("JacobiConformal::Reverse", n, [&](size_t i) -> T {
+          T omg, bet;
+          jc.Reverse(w.lon1[i], w.lat1[i], omg, bet);
+          return omg + bet;
+        });
+      const size_t block = 1000;
+      vector<T> x(block), y(block);
+      b.run("JacobiConformal::Forward[]", n, [&](size_t i) -> T {
+          if (i % block) return 0;
+          const size_t m = min(block, n - i);
+          jc.Forward(m, &w.lon1[i], &w.lat1[i], x.data(), y.data());
+          T sum = 0;
+          for (size_t k = 0; k < m; ++k)
+            sum += x[k] + y[k];
+          return sum;
+        });
+      // The triaxial geodesics are integrated numerically and are much
+      // slower, so time them on a sample of the workload; s12 is scaled to
+      // [0, 1000] km.
+      const TriaxialGeodesic tg(T(286.3), T(278.6), T(223.2));
+      const size_t nt = max(size_t(1), n / 100), tblock = 100;
+      b.run("TriaxialGeodesic::Direct", nt, [&](size_t i) -> T {
+          T bet2, omg2, alp2;
+          tg.Direct(w.lat1[i], w.lon1[i], w.azi1[i], w.s12[i] / 20000,
+                    bet2, omg2, alp2);
+          return bet2 + omg2 + alp2;
+        });
+      b.run("TriaxialGeodesic::Inverse", nt, [&](size_t i) -> T {
+          T s12, alp1, alp2;
+          tg.Inverse(w.lat1[i], w.lon1[i], w.lat2[i], w.lon2[i],
+                     s12, alp1, alp2);
+          return s12 + alp1 + alp2;
+        });
+      vector<T> s12(tblock), alp1(tblock), alp2(tblock);
+      b.run("TriaxialGeodesic::Inverse[]", nt, [&](size_t i) -> T {
+          if (i % tblock) return 0;
+          const size_t m = min(tblock, nt - i);
+          tg.Inverse(m, &w.lat1[i], &w.lon1[i], &w.lat2[i], &w.lon2[i],
+                     s12.data(), alp1.data(), alp2.data());
+          T sum = 0;
+          for (size_t k = 0; k < m; ++k)
+            sum += s12[k] + alp1[k] + alp2[k];
+          return sum;
+        });
+    }
+    {
+      b.run("UTMUPS::Forward", n, [&](size_t i) -> T {
+          int zone; bool northp; T x, y;
+          UTMUPS::Forward(w.lat1[i], w.lon1[i], zone, northp, x, y);
+          return x / 1000 + y / 1000 + zone;
+        });
+      b.run("UTMUPS::Reverse", n, [&](size_t i) -> T {
+          T lat, lon;
+          UTMUPS::Reverse(w.zone[i], w.northp[i], w.x[i], w.y[i], lat, lon);
+          return lat + lon;
+        });
+      // Points within 1 degree of a zone boundary transferred to the
+      // neighboring zone on their side of the central meridian
+      vector<int> zonein(n), zoneout(n);
+      vector<T> x(n), y(n);
+      vector<bool> northp(n);
+      for (size_t i = 0; i < n; ++i) {
+        T lon = 6 * round(w.lon1[i] / 6) + w.lon1[i] / 180;
+        bool np;
+        UTMUPS::Forward(w.lat1[i], lon, zonein[i], np, x[i], y[i]);
+        northp[i] = np;
+        zoneout[i] = zonein[i] == UTMUPS::UPS ? UTMUPS::UPS :
+          (x[i] < 500e3 ? zonein[i] + 58 : zonein[i]) % 60 + 1;
+      }
+      b.run("UTMUPS::Transfer", n, [&](size_t i) -> T {
+          int zone; T xx, yy;
+          UTMUPS::Transfer(zonein[i], northp[i], x[i], y[i],
+                           zoneout[i], northp[i], xx, yy, zone);
+          return xx / 1000 + yy / 1000;
+        });
+      b.run("MGRS::Forward", n, [&](size_t i) -> T {
+          string s;
+          MGRS::Forward(w.zone[i], w.northp[i], w.x[i], w.y[i], 5, s);
+          return T(s[s.size() - 1] - '0');
+        });
+      b.run("MGRS::Reverse", n, [&](size_t i) -> T {
+          int zone, prec; bool northp; T x, y;
+          MGRS::Reverse(w.mgrs[i], zone, northp, x, y, prec);
+          return x / 1000 + y / 1000;
+        });
+      b.run("MGRS::Decode", n, [&](size_t i) -> T {
+          int zone, prec; bool northp; long long ix, iy;
+          MGRS::Decode(w.mgrs[i].c_str(), zone, northp, ix, iy, prec);
+          return T(ix + iy);
+        });
+      // Queries for 1000 distinct 1 km squares
+      vector<string> tiles(n);
+      for (size_t i = 0; i < n; ++i)
+        MGRS::Forward(w.zone[i % 1000], w.northp[i % 1000],
+                      w.x[i % 1000], w.y[i % 1000], 2, tiles[i]);
+      b.run("MGRS+UTMUPS::Reverse", n, [&](size_t i) -> T {
+          int zone, prec; bool northp; T x, y, lat, lon;
+          MGRS::Reverse(tiles[i], zone, northp, x, y, prec);
+          UTMUPS::Reverse(zone, northp, x, y, lat, lon);
+          return lat + lon;
+        });
+      MGRSCache cache(10000);
+      b.run("MGRSCache::Reverse", n, [&](size_t i) -> T {
+          int prec; T lat, lon;
+          cache.Reverse(tiles[i], lat, lon, prec);
+          return lat + lon;
+        });
+    }
+    {
+      // Points in Great Britain: lat in [50, 60], lon in [-5, 1]
+      vector<T> lat(n), lon(n), x(n), y(n);
+      for (size_t i = 0; i < n; ++i) {
+        lat[i] = 55 + w.lat1[i] / 18;
+        lon[i] = -2 + w.lon1[i] / 60;
+      }
+      b.run("OSGB::Forward", n, [&](size_t i) -> T {
+          T xx, yy;
+          OSGB::Forward(lat[i], lon[i], xx, yy);
+          return xx / 1000 + yy / 1000;
+        });
+      const size_t block = 1000;
+      b.run("OSGB::Forward[]", n, [&](size_t i) -> T {
+          if (i % block) return 0;
+          const size_t m = min(block, n - i);
+          OSGB::Forward(m, &lat[i], &lon[i], &x[i], &y[i]);
+          T sum = 0;
+          for (size_t k = 0; k < m; ++k)
+            sum += x[i + k] / 1000 + y[i + k] / 1000;
+          return sum;
+        });
+      b.run("OSGB::GridReference", n, [&](size_t i) -> T {
+          string s;
+          OSGB::GridReference(x[i], y[i], 5, s);
+          return T(s[s.size() - 1] - '0');
+        });
+      const size_t width = 16;
+      vector<char> buf(block * width);
+      b.run("OSGB::GridReference[]", n, [&](size_t i) -> T {
+          if (i % block) return 0;
+          const size_t m = min(block, n - i);
+          OSGB::GridReference(m, &x[i], &y[i], 5, buf.data(), width);
+          T sum = 0;
+          for (size_t k = 0; k < m; ++k)
+            sum += T(buf[k * width + 11] - '0');
+          return sum;
+        });
+    }
+    if (b.selected("Geoid")) {
+      const string name("Geoid::operator()");
+      try {
+        const Geoid geoid(Geoid::DefaultGeoidName(), "", true, true);
+        b.run(name, n, [&](size_t i) -> T {
+            return geoid(w.lat1[i], w.lon1[i]);
+          });
+      }
+      catch (const exception& e) {
+        b.skip(name, e.what());
+      }
+    }
+    if (b.selected("GravityModel")) {
+      const string name("GravityModel::Gravity");
+      try {
+        const GravityModel grav(GravityModel::DefaultGravityName());
+        b.run(name, n / 10, [&](size_t i) -> T {
+            T gx, gy, gz;
+            return grav.Gravity(w.lat1[i], w.lon1[i], w.h[i], gx, gy, gz)
+              / 1000 + gz;
+          });
+      }
+      catch (const exception& e) {
+        b.skip(name, e.what());
+      }
+    }
+    if (b.selected("MagneticModel")) {
+      const string name("MagneticModel::operator()");
+      try {
+        const MagneticModel mag(MagneticModel::DefaultMagneticName());
+        const T t = mag.MinTime();
+        b.run(name, n / 10, [&](size_t i) -> T {
+            T bx, by, bz;
+            mag(t, w.lat1[i], w.lon1[i], w.h[i], bx, by, bz);
+            return (bx + by + bz) / 1000;
+          });
+      }
+      catch (const exception& e) {
+        b.skip(name, e.what());
+      }
+    }
+    {
+      // Polygons with 8 vertices in a 10 degree square
+      const Geodesic& g = Geodesic::WGS84();
+      const int nv = 8;
+      b.run("PolygonArea::Compute", n / nv, [&](size_t i) -> T {
+          PolygonArea poly(g);
+          for (int k = 0; k < nv; ++k) {
+            size_t j = (i * nv + k) % n;
+            poly.AddPoint(w.lat1[j] / 9, w.lon1[j] / 18);
+          }
+          T perimeter, area;
+          poly.Compute(false, true, perimeter, area);
+          return perimeter / 1000 + area / 1e9;
+        });
+    }
+    {
+      const Intersect inter(Geodesic::WGS84());
+      b.run("Intersect::Closest", n / 10, [&](size_t i) -> T {
+          Intersect::Point p =
+            inter.Closest(w.lat1[i], w.lon1[i], w.azi1[i],
+                          w.lat2[i], w.lon2[i], w.lon2[(i + 1) % n]);
+          return p.first / 1000 + p.second / 1000;
+        });
+    }
+  }
+  catch (const exception& e) {
+    cerr << "Caught exception: " << e.what() << "\n";
+    return 1;
+  }
+  catch (...) {
+    cerr << "Caught unknown exception\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,395 @@
+/**
+ * \file harmbench.cpp
+ * \brief Benchmarks for the spherical harmonic sums
+ *
+ * This times SphericalHarmonic for synthetic models of several degrees
+ * (from 12, as for the World Magnetic Model, to 2190, as for EGM2008) and,
+ * if they are installed, the default GravityModel and MagneticModel.  For
+ * each degree, the sums are evaluated at a fixed set of randomly generated
+ * points, one at a time (with and without the gradient) and all at once,
+ * and on a grid of circles of latitude with CircularEngine.  The
+ * coefficients and the points are generated with std::mt19937 using a fixed
+ * seed (as in geobench), so that the workloads are the same on all
+ * platforms.  The reported time is the minimum over several repetitions of
+ * the time per point; for the circles this includes the setup of the
+ * CircularEngine and the speedup over the single point sums is also
+ * reported.  The checksum, a sum of the results, allows changes in the
+ * results to be detected.  The output of an earlier run may be given with
+ * -b; the ratio of the times to those of the earlier run are then reported,
+ * so that the performance can be tracked across builds.
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <GeographicLib/SphericalHarmonic.hpp>
+#include <GeographicLib/CircularEngine.hpp>
+#include <GeographicLib/GravityModel.hpp>
+#include <GeographicLib/GravityCircle.hpp>
+#include <GeographicLib/MagneticModel.hpp>
+#include <GeographicLib/MagneticCircle.hpp>
+#include <GeographicLib/Utility.hpp>
+
+using namespace std;
+using namespace GeographicLib;
+
+typedef Math::real T;
+
+namespace {
+
+  // Uniform deviates which don't depend on the implementation of the std
+  // distributions.
+  class Random {
+  private:
+    mt19937 _r;
+  public:
+    explicit Random(unsigned seed) : _r(seed) {}
+    T operator()(T a, T b)
+    { return a + (b - a) * (T(_r()) / T(4294967296.0)); }
+    // A latitude for points uniformly distributed on the sphere
+    T lat() { return asin((*this)(-1, 1)) / Math::degree<T>(); }
+  };
+
+  class Bench {
+  private:
+    const vector<string>& _filters;
+    int _reps;
+    // The times per point from an earlier run
+    map<string, double> _baseline;
+  public:
+    Bench(const vector<string>& filters, int reps, const string& baseline)
+      : _filters(filters), _reps(reps) {
+      if (baseline.empty()) return;
+      ifstream str(baseline.c_str());
+      if (!str.good())
+        throw GeographicErr("Cannot open " + baseline);
+      // Lines for the benchmarks are: name time "ns" ...
+      for (string line; getline(str, line);) {
+        istringstream is(line);
+        string name, unit; double t;
+        if (is >> name >> t >> unit && unit == "ns")
+          _baseline[name] = t;
+      }
+    }
+    bool selected(const string& name) const {
+      if (_filters.empty()) return true;
+      for (const string& f : _filters)
+        if (name.find(f) != string::npos) return true;
+      return false;
+    }
+    // Time f() which evaluates n points and returns a value which is the
+    // checksum.  Return the time per point (ns) or 0 if the benchmark isn't
+    // selected.  If ref > 0, report ref / (time per point) as the speedup.
+    template<class F>
+    double run(const string& name, size_t n, F f, double ref = 0) const {
+      if (!selected(name)) return 0;
+      typedef chrono::steady_clock clock;
+      double best = 0;
+      T sum = 0;
+      for (int rep = 0; rep < _reps; ++rep) {
+        clock::time_point t0 = clock::now();
+        T s = f();
+        double t = chrono::duration<double>(clock::now() - t0).count();
+        if (rep == 0 || t < best) best = t;
+        sum = s;
+      }
+      best *= 1e9 / double(n);
+      cout << left << setw(44) << name << right
+           << setw(12) << fixed << setprecision(1) << best
+           << " ns  checksum " << Utility::str(sum, 6);
+      if (ref > 0)
+        cout << "  speedup " << setprecision(1) << ref / best;
+      auto p = _baseline.find(name);
+      if (p != _baseline.end() && p->second > 0)
+        cout << "  ratio " << setprecision(3) << best / p->second;
+      cout << "\n";
+      return best;
+    }
+    void skip(const string& name, const string& reason) const {
+      if (!selected(name)) return;
+      cout << left << setw(44) << name << " skipped: " << reason << "\n";
+    }
+  };
+
+  // The points at which the sums are evaluated.
+  struct Points {
+    vector<T> lat, lon, h;
+    Points(size_t n, unsigned seed) {
+      Random r(seed);
+      for (size_t i = 0; i < n; ++i) {
+        lat.push_back(r.lat()); lon.push_back(r(-180, 180));
+        h.push_back(r(-100, 10000));
+      }
+    }
+  };
+
+  // The number of points for a sum of degree N; the work per repetition is
+  // limited to about count * 2000 terms, with at least 16 points.
+  size_t npoints(size_t count, int N) {
+    double terms = (N + 1) * double(N + 2) / 2;
+    return max(size_t(16), min(count, size_t(double(count) * 2000 / terms)));
+  }
+
+  // The number of longitudes on the circles of latitude
+  const int nlon = 360;
+
+  // Time a synthetic model of degree N.
+  void Synthetic(const Bench& b, int N, size_t count, unsigned seed,
+                 const Points& pts) {
+    const string deg = "(N=" + Utility::str(N) + ")";
+    {
+      static const char* const names[] = {
+        "SphericalHarmonic::Value", "SphericalHarmonic::Value+grad",
+        "SphericalHarmonic::Values[]", "SphericalHarmonic::Values[]+grad",
+        "CircularEngine::Values", "CircularEngine::Values+grad",
+      };
+      bool any = false;
+      for (const char* name : names)
+        any = any || b.selected(name + deg);
+      if (!any) return;
+    }
+    // Coefficients with a Kaula-like decay, C_nm ~ 1/n^2.
+    Random r(seed + unsigned(N));
+    vector<T> C(SphericalEngine::coeff::Csize(N, N)),
+      S(SphericalEngine::coeff::Ssize(N, N));
+    for (int m = 0, k = 0; m <= N; ++m)
+      for (int n = m; n <= N; ++n, ++k) {
+        T scale = n == 0 ? 1 : 1 / T(n * n);
+        C[k] = n == 0 ? 1 : r(-1, 1) * scale;
+        if (m > 0) S[k - (N + 1)] = r(-1, 1) * scale;
+      }
+    const T a = Constants::WGS84_a();
+    const SphericalHarmonic h(C, S, N, a);
+    const size_t n = npoints(count, N);
+    vector<T> x(n), y(n), z(n), v(n), gx(n), gy(n), gz(n);
+    for (size_t i = 0; i < n; ++i) {
+      T rad = a + pts.h[i], slat, clat, slon, clon;
+      Math::sincosd(pts.lat[i], slat, clat);
+      Math::sincosd(pts.lon[i], slon, clon);
+      x[i] = rad * clat * clon; y[i] = rad * clat * slon; z[i] = rad * slat;
+    }
+    double t = b.run("SphericalHarmonic::Value" + deg, n, [&]() -> T {
+        T sum = 0;
+        for (size_t i = 0; i < n; ++i)
+          sum += h(x[i], y[i], z[i]);
+        return sum;
+      });
+    double tg = b.run("SphericalHarmonic::Value+grad" + deg, n, [&]() -> T {
+        T sum = 0;
+        for (size_t i = 0; i < n; ++i) {
+          T ggx, ggy, ggz;
+          sum += h(x[i], y[i], z[i], ggx, ggy, ggz) + ggx + ggy + ggz;
+        }
+        return sum;
+      });
+    b.run("SphericalHarmonic::Values[]" + deg, n, [&]() -> T {
+        h(n, x.data(), y.data(), z.data(), v.data());
+        T sum = 0;
+        for (size_t i = 0; i < n; ++i)
+          sum += v[i];
+        return sum;
+      }, t);
+    b.run("SphericalHarmonic::Values[]+grad" + deg, n, [&]() -> T {
+        h(n, x.data(), y.data(), z.data(), v.data(),
+          gx.data(), gy.data(), gz.data());
+        T sum = 0;
+        for (size_t i = 0; i < n; ++i)
+          sum += v[i] + gx[i] + gy[i] + gz[i];
+        return sum;
+      }, tg);
+    // Circles at the latitudes of the points with nlon longitudes each
+    const size_t nc = max(size_t(1), n / nlon), np = nc * nlon;
+    vector<T> V(nlon), Gx(nlon), Gy(nlon), Gz(nlon);
+    auto circles = [&](bool gradp) -> T {
+      T sum = 0;
+      for (size_t i = 0; i < nc; ++i) {
+        T rad = a + pts.h[i], slat, clat;
+        Math::sincosd(pts.lat[i], slat, clat);
+        const CircularEngine c = h.Circle(rad * clat, rad * slat, gradp);
+        if (gradp)
+          c.Values(-180, 360 / T(nlon), nlon, V.data(),
+                   Gx.data(), Gy.data(), Gz.data());
+        else
+          c.Values(-180, 360 / T(nlon), nlon, V.data());
+        for (int j = 0; j < nlon; ++j)
+          sum += V[j] + (gradp ? Gx[j] + Gy[j] + Gz[j] : 0);
+      }
+      return sum;
+    };
+    b.run("CircularEngine::Values" + deg, np,
+          [&]() -> T { return circles(false); }, t);
+    b.run("CircularEngine::Values+grad" + deg, np,
+          [&]() -> T { return circles(true); }, tg);
+  }
+
+} // namespace
+
+int usage(int retval) {
+  ( retval ? cerr : cout ) <<
+"harmbench [ -n count ] [ -r reps ] [ -s seed ] [ -N degree ] [ -j nthreads ]\n\
+    [ -g gravity ] [ -m magnetic ] [ -b baseline ] [ -h ] [ name ... ]\n\
+\n\
+Time the spherical harmonic sums using fixed-seed random workloads.\n\
+-n count the maximum number of points in each benchmark (default 20000);\n\
+   for high degrees the number of points is reduced so that each\n\
+   repetition evaluates about 2000 count terms (with at least 16 points)\n\
+-r reps the benchmark is repeated reps times and the minimum time\n\
+   is reported (default 5)\n\
+-s seed the seed for the random number generator (default 1)\n\
+-N degree the degree of a synthetic model; this option may be repeated\n\
+   (default 12, 36, 120, 360, 720, and 2190)\n\
+-j nthreads the number of threads used by the single point sums (see\n\
+   SphericalEngine::set_threads, default 1)\n\
+-g gravity the gravity model to use (default the default model)\n\
+-m magnetic the magnetic model to use (default the default model)\n\
+-b baseline the output of an earlier run of harmbench; the ratio of the\n\
+   times to those in baseline is reported\n\
+-h print this help\n\
+\n\
+If any names are given, only the benchmarks whose names contain one of\n\
+these strings are run.  The benchmarks for GravityModel and MagneticModel\n\
+are skipped if the models are not installed.\n";
+  return retval;
+}
+
+int main(int argc, const char* const argv[]) {
+  try {
+    Utility::set_digits();
+    size_t num = 20000;
+    int reps = 5, nthreads = 1;
+    unsigned seed = 1;
+    vector<int> degrees;
+    string gravity(GravityModel::DefaultGravityName()),
+      magnetic(MagneticModel::DefaultMagneticName()), baseline;
+    vector<string> filters;
+    for (int m = 1; m < argc; ++m) {
+      string arg(argv[m]);
+      if (arg == "-g" || arg == "-m" || arg == "-b") {
+        if (++m == argc) return usage(1);
+        (arg == "-g" ? gravity : (arg == "-m" ? magnetic : baseline)) =
+          argv[m];
+      } else if (arg == "-n" || arg == "-r" || arg == "-s" || arg == "-N" ||
+                 arg == "-j") {
+        if (++m == argc) return usage(1);
+        try {
+          long long v = Utility::val<long long>(string(argv[m]));
+          if (v < (arg == "-N" ? 0 : 1)) return usage(1);
+          if (arg == "-n") num = size_t(v);
+          else if (arg == "-r") reps = int(v);
+          else if (arg == "-N") degrees.push_back(int(v));
+          else if (arg == "-j") nthreads = int(v);
+          else seed = unsigned(v);
+        }
+        catch (const exception&) {
+          return usage(1);
+        }
+      } else if (arg == "-h")
+        return usage(0);
+      else if (arg.size() > 0 && arg[0] == '-')
+        return usage(1);
+      else
+        filters.push_back(arg);
+    }
+    if (degrees.empty())
+      degrees = {12, 36, 120, 360, 720, 2190};
+    SphericalEngine::set_threads(nthreads);
+
+    cout << "GeographicLib " << GEOGRAPHICLIB_VERSION_STRING
+         << ", GEOGRAPHICLIB_PRECISION = " << GEOGRAPHICLIB_PRECISION
+         << " (" << Math::digits() << " bits)\n"
+         << "count = " << num << ", reps = " << reps
+         << ", seed = " << seed << ", nthreads = "
+         << SphericalEngine::threads() << "\n";
+
+    const Bench b(filters, reps, baseline);
+    const Points pts(num, seed);
+    for (int N : degrees)
+      Synthetic(b, N, num, seed, pts);
+
+    if (b.selected("GravityModel") || b.selected("GravityCircle")) {
+      const string name("GravityModel::Gravity");
+      try {
+        const GravityModel grav(gravity);
+        const size_t n = npoints(num, grav.Degree()),
+          nc = max(size_t(1), n / nlon), np = nc * nlon;
+        double t = b.run(name, n, [&]() -> T {
+            T sum = 0;
+            for (size_t i = 0; i < n; ++i) {
+              T gx, gy, gz;
+              sum += grav.Gravity(pts.lat[i], pts.lon[i], pts.h[i],
+                                  gx, gy, gz) / 1000 + gz;
+            }
+            return sum;
+          });
+        b.run("GravityCircle::Gravity", np, [&]() -> T {
+            T sum = 0;
+            for (size_t i = 0; i < nc; ++i) {
+              const GravityCircle c = grav.Circle(pts.lat[i], pts.h[i]);
+              for (int j = 0; j < nlon; ++j) {
+                T gx, gy, gz;
+                sum += c.Gravity(-180 + j * 360 / T(nlon), gx, gy, gz)
+                  / 1000 + gz;
+              }
+            }
+            return sum;
+          }, t);
+      }
+      catch (const exception& e) {
+        b.skip(name, e.what());
+      }
+    }
+    if (b.selected("MagneticModel") || b.selected("MagneticCircle")) {
+      const string name("MagneticModel::operator()");
+      try {
+        const MagneticModel mag(magnetic);
+        const T t0 = mag.MinTime();
+        const size_t n = npoints(num, mag.Degree()),
+          nc = max(size_t(1), n / nlon), np = nc * nlon;
+        double t = b.run(name, n, [&]() -> T {
+            T sum = 0;
+            for (size_t i = 0; i < n; ++i) {
+              T bx, by, bz;
+              mag(t0, pts.lat[i], pts.lon[i], pts.h[i], bx, by, bz);
+              sum += (bx + by + bz) / 1000;
+            }
+            return sum;
+          });
+        b.run("MagneticCircle::operator()", np, [&]() -> T {
+            T sum = 0;
+            for (size_t i = 0; i < nc; ++i) {
+              const MagneticCircle c = mag.Circle(t0, pts.lat[i], pts.h[i]);
+              for (int j = 0; j < nlon; ++j) {
+                T bx, by, bz;
+                c(-180 + j * 360 / T(nlon), bx, by, bz);
+                sum += (bx + by + bz) / 1000;
+              }
+            }
+            return sum;
+          }, t);
+      }
+      catch (const exception& e) {
+        b.skip(name, e.what());
+      }
+    }
+  }
+  catch (const exception& e) {
+    cerr << "Caught exception: " << e.what() << "\n";
+    return 1;
+  }
+  catch (...) {
+    cerr << "Caught unknown exception\n";
+    return 1;
+  }
+  return 0;
+}
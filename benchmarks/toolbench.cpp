@@ -0,0 +1,347 @@
+/**
+ * \file toolbench.cpp
+ * \brief Throughput benchmarks for the command-line utilities
+ *
+ * Each benchmark runs one of the utilities on a large input file and reports
+ * the number of records processed per second and the peak resident set size
+ * of the utility.  The input files are generated with std::mt19937 using a
+ * fixed seed (as in geobench), so the workloads are the same on all
+ * platforms.  Each utility is run with one thread and with -j \e nthreads
+ * and, if it supports --binary, with text and binary records.  The reported
+ * time is the minimum over several repetitions of the wall-clock time of
+ * the whole process (including reading the model files and writing the
+ * output).
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <cstdio>
+#include <cmath>
+#include <GeographicLib/Math.hpp>
+#include <GeographicLib/Utility.hpp>
+
+#if defined(_WIN32)
+#  include <cstdlib>
+#else
+#  include <sys/resource.h>
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
+using namespace std;
+using namespace GeographicLib;
+
+namespace {
+
+  // Uniform deviates which don't depend on the implementation of the std
+  // distributions; the binary records are doubles.
+  class Random {
+  private:
+    mt19937 _r;
+  public:
+    explicit Random(unsigned seed) : _r(seed) {}
+    double operator()(double a, double b)
+    { return a + (b - a) * (double(_r()) / 4294967296.0); }
+    // A latitude for points uniformly distributed on the sphere
+    double lat() { return asin((*this)(-1, 1)) / Math::degree<double>(); }
+  };
+
+  // An input file in text and (optionally) binary form.
+  struct Input {
+    string text, binary;
+    size_t records;
+  };
+
+  // Write n records of nin numbers each, given by gen(rnd, rec), to
+  // base.txt and, if binaryp, base.bin.  If group > 0, a blank line is
+  // written to the text file after every group records.
+  template<class F>
+  Input MakeInput(const string& base, size_t n, int nin, bool binaryp,
+                  size_t group, unsigned seed, F gen) {
+    Input in{base + ".txt", binaryp ? base + ".bin" : string(), n};
+    ofstream text(in.text.c_str());
+    ofstream bin;
+    if (binaryp)
+      bin.open(in.binary.c_str(), ios::out | ios::binary);
+    if (!text.good() || (binaryp && !bin.good()))
+      throw GeographicErr("Cannot create the input files for " + base);
+    Random rnd(seed);
+    vector<double> rec(nin);
+    text << setprecision(12);
+    for (size_t i = 0; i < n; ++i) {
+      gen(rnd, rec.data());
+      for (int k = 0; k < nin; ++k)
+        text << (k ? " " : "") << rec[k];
+      text << "\n";
+      if (group && (i + 1) % group == 0)
+        text << "\n";
+      if (binaryp)
+        Utility::writearray<double, double, false>(bin, rec);
+    }
+    if (!text.good() || (binaryp && !bin.good()))
+      throw GeographicErr("Error writing the input files for " + base);
+    return in;
+  }
+
+  // Run the program given by args[0].  Return its exit status (or -1 if it
+  // couldn't be run) and set secs to the elapsed time and rss to its peak
+  // resident set size in bytes (or 0 if this isn't available).
+  int Execute(const vector<string>& args, double& secs, double& rss) {
+    typedef chrono::steady_clock clock;
+    clock::time_point t0 = clock::now();
+    int status = -1;
+    rss = 0;
+#if defined(_WIN32)
+    string cmd("\"");
+    for (const string& a : args)
+      cmd += "\"" + a + "\" ";
+    cmd += "\"";
+    status = system(cmd.c_str());
+#else
+    vector<char*> argv;
+    for (const string& a : args)
+      argv.push_back(const_cast<char*>(a.c_str()));
+    argv.push_back(nullptr);
+    pid_t pid = fork();
+    if (pid == 0) {
+      execv(argv[0], argv.data());
+      _exit(127);
+    }
+    if (pid > 0) {
+      int wstatus;
+      struct rusage ru;
+      if (wait4(pid, &wstatus, 0, &ru) == pid) {
+        status = WIFEXITED(wstatus) ? WEXITSTATUS(wstatus) : -1;
+#  if defined(__APPLE__)
+        rss = double(ru.ru_maxrss);          // bytes
+#  else
+        rss = double(ru.ru_maxrss) * 1024;   // kilobytes
+#  endif
+      }
+    }
+#endif
+    secs = chrono::duration<double>(clock::now() - t0).count();
+    return status;
+  }
+
+  class Bench {
+  private:
+    const vector<string>& _filters;
+    string _tooldir, _output;
+    int _reps, _nthreads;
+  public:
+    Bench(const vector<string>& filters, const string& tooldir,
+          const string& output, int reps, int nthreads)
+      : _filters(filters), _tooldir(tooldir), _output(output)
+      , _reps(reps), _nthreads(nthreads) {}
+    bool selected(const string& tool) const {
+      if (_filters.empty()) return true;
+      for (const string& f : _filters)
+        if (tool.find(f) != string::npos) return true;
+      return false;
+    }
+    // Run tool with args on the input, reading a text or binary file,
+    // with 1 thread and with nthreads threads.
+    void run(const string& tool, const string& label,
+             const vector<string>& args, const Input& in, bool binaryp)
+      const {
+      string path = _tooldir + "/" + tool;
+#if defined(_WIN32)
+      path += ".exe";
+#endif
+      for (int nt : {1, _nthreads}) {
+        vector<string> cmd{path};
+        cmd.insert(cmd.end(), args.begin(), args.end());
+        if (binaryp) cmd.push_back("--binary");
+        cmd.insert(cmd.end(), {"-j", Utility::str(nt),
+                               "--input-file", binaryp ? in.binary : in.text,
+                               "--output-file", _output});
+        double best = 0, peak = 0;
+        int status = 0;
+        for (int rep = 0; rep < _reps && status == 0; ++rep) {
+          double secs, rss;
+          status = Execute(cmd, secs, rss);
+          if (rep == 0 || secs < best) best = secs;
+          peak = max(peak, rss);
+        }
+        remove(_output.c_str());
+        cout << left << setw(14) << tool << setw(14) << label
+             << setw(7) << (binaryp ? "binary" : "text")
+             << right << setw(4) << nt;
+        if (status != 0)
+          cout << "  failed (exit status " << status << ")\n";
+        else {
+          cout << setw(14) << fixed << setprecision(0)
+               << double(in.records) / best << " rec/s";
+          if (peak > 0)
+            cout << setw(9) << setprecision(1) << peak / 1048576 << " MB";
+          cout << "\n";
+        }
+        if (_nthreads == 1) break;
+      }
+    }
+  };
+
+} // namespace
+
+int usage(int retval) {
+  ( retval ? cerr : cout ) <<
+"toolbench [ -d dir ] [ -w dir ] [ -n count ] [ -j nthreads ] [ -r reps ]\n\
+    [ -s seed ] [ -k ] [ -h ] [ name ... ]\n\
+\n\
+Measure the throughput of the GeographicLib utilities on fixed-seed random\n\
+input files.\n\
+-d dir the directory containing the utilities (default .)\n\
+-w dir the directory for the input and output files (default .)\n\
+-n count the number of records in the input files (default 1000000); the\n\
+   files for Gravity and MagneticField have count/10 records\n\
+-j nthreads the number of threads for the multi-threaded runs (default\n\
+   the number of hardware threads)\n\
+-r reps each run is repeated reps times and the minimum time is reported\n\
+   (default 3)\n\
+-s seed the seed for the random number generator (default 1)\n\
+-k keep the input files\n\
+-h print this help\n\
+\n\
+If any names are given, only the utilities whose names contain one of\n\
+these strings are run.  For each run, the number of records per second\n\
+and the peak resident set size (not available on Windows) are printed.\n\
+GeoidEval, Gravity, and MagneticField use the default models and fail\n\
+if these are not installed.\n";
+  return retval;
+}
+
+int main(int argc, const char* const argv[]) {
+  try {
+    size_t num = 1000000;
+    int reps = 3, nthreads = int(thread::hardware_concurrency());
+    unsigned seed = 1;
+    bool keep = false;
+    string tooldir("."), workdir(".");
+    vector<string> filters;
+    for (int m = 1; m < argc; ++m) {
+      string arg(argv[m]);
+      if (arg == "-d" || arg == "-w") {
+        if (++m == argc) return usage(1);
+        (arg == "-d" ? tooldir : workdir) = argv[m];
+      } else if (arg == "-n" || arg == "-j" || arg == "-r" || arg == "-s") {
+        if (++m == argc) return usage(1);
+        try {
+          long long v = Utility::val<long long>(string(argv[m]));
+          if (v < 1) return usage(1);
+          if (arg == "-n") num = size_t(v);
+          else if (arg == "-j") nthreads = int(v);
+          else if (arg == "-r") reps = int(v);
+          else seed = unsigned(v);
+        }
+        catch (const exception&) {
+          return usage(1);
+        }
+      } else if (arg == "-k")
+        keep = true;
+      else if (arg == "-h")
+        return usage(0);
+      else if (arg.size() > 0 && arg[0] == '-')
+        return usage(1);
+      else
+        filters.push_back(arg);
+    }
+    nthreads = max(1, nthreads);
+
+    cout << "GeographicLib " << GEOGRAPHICLIB_VERSION_STRING
+         << ", count = " << num << ", reps = " << reps
+         << ", seed = " << seed << ", nthreads = " << nthreads << "\n";
+
+    const Bench b(filters, tooldir, workdir + "/toolbench.out",
+                  reps, nthreads);
+    vector<Input> inputs;
+    const string base = workdir + "/toolbench-";
+    // Random positions: lat lon
+    auto latlon = [](Random& r, double rec[]) -> void {
+      rec[0] = r.lat(); rec[1] = r(-180, 180);
+    };
+    // Random positions with heights: lat lon h
+    auto latlonh = [](Random& r, double rec[]) -> void {
+      rec[0] = r.lat(); rec[1] = r(-180, 180); rec[2] = r(-100, 10000);
+    };
+    if (b.selected("GeodSolve")) {
+      inputs.push_back
+        (MakeInput(base + "direct", num, 4, true, 0, seed,
+                   [](Random& r, double rec[]) -> void {
+                     rec[0] = r.lat(); rec[1] = r(-180, 180);
+                     rec[2] = r(-180, 180); rec[3] = r(0, 20000e3);
+                   }));
+      b.run("GeodSolve", "direct", {}, inputs.back(), false);
+      b.run("GeodSolve", "direct", {}, inputs.back(), true);
+      inputs.push_back
+        (MakeInput(base + "inverse", num, 4, true, 0, seed,
+                   [](Random& r, double rec[]) -> void {
+                     rec[0] = r.lat(); rec[1] = r(-180, 180);
+                     rec[2] = r.lat(); rec[3] = r(-180, 180);
+                   }));
+      b.run("GeodSolve", "inverse", {"-i"}, inputs.back(), false);
+      b.run("GeodSolve", "inverse", {"-i"}, inputs.back(), true);
+    }
+    if (b.selected("GeoConvert")) {
+      inputs.push_back(MakeInput(base + "latlon", num, 2, true, 0, seed,
+                                 latlon));
+      b.run("GeoConvert", "utm", {"-u"}, inputs.back(), false);
+      b.run("GeoConvert", "utm", {"-u"}, inputs.back(), true);
+    }
+    if (b.selected("GeoidEval")) {
+      inputs.push_back(MakeInput(base + "geoid", num, 2, false, 0, seed,
+                                 latlon));
+      b.run("GeoidEval", "height", {}, inputs.back(), false);
+    }
+    if (b.selected("Gravity")) {
+      inputs.push_back(MakeInput(base + "gravity", num / 10 + 1, 3, false, 0,
+                                 seed, latlonh));
+      b.run("Gravity", "gravity", {}, inputs.back(), false);
+    }
+    if (b.selected("MagneticField")) {
+      inputs.push_back(MakeInput(base + "magnetic", num / 10 + 1, 3, false,
+                                 0, seed, latlonh));
+      b.run("MagneticField", "field", {"-t", "2025"}, inputs.back(), false);
+    }
+    if (b.selected("Planimeter")) {
+      // Polygons with 8 vertices in 10 degree squares centered at random
+      // points; the records are the vertices.
+      double lat0 = 0, lon0 = 0;
+      size_t k = 0;
+      inputs.push_back
+        (MakeInput(base + "polygons", num, 2, false, 8, seed,
+                   [&lat0, &lon0, &k](Random& r, double rec[]) -> void {
+                     if (k++ % 8 == 0) {
+                       lat0 = r(-80, 80); lon0 = r(-180, 180);
+                     }
+                     rec[0] = lat0 + r(-5, 5); rec[1] = lon0 + r(-5, 5);
+                   }));
+      b.run("Planimeter", "area", {}, inputs.back(), false);
+    }
+    if (!keep)
+      for (const Input& in : inputs) {
+        remove(in.text.c_str());
+        if (!in.binary.empty()) remove(in.binary.c_str());
+      }
+  }
+  catch (const exception& e) {
+    cerr << "Caught exception: " << e.what() << "\n";
+    return 1;
+  }
+  catch (...) {
+    cerr << "Caught unknown exception\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,139 @@
+# Build GeographicLib with profile guided optimization.
+#
+# This script is run by the pgo target, e.g.,
+#   make pgo
+# and carries out the following steps in the directory PGO_BINARY_DIR:
+#
+#   (1) run geobench from the current build tree to give the baseline
+#       times;
+#   (2) configure and build GeographicLib in PGO_BINARY_DIR/build with
+#       GEOGRAPHICLIB_PGO = GENERATE;
+#   (3) the training run: ctest (which runs geodtest, signtest, etc., and
+#       exercises the tools) and geobench (with the geodesic problems
+#       sampled from GeodTest.dat if PGO_GEODTEST is set); the profiles are
+#       written to PGO_BINARY_DIR/profile;
+#   (4) for clang, merge the raw profiles with llvm-profdata;
+#   (5) reconfigure and rebuild the same tree with GEOGRAPHICLIB_PGO = USE
+#       and check the result with ctest;
+#   (6) run geobench from the optimized build and report the times before
+#       and after.
+#
+# The optimized library and tools are left in PGO_BINARY_DIR/build; they
+# can be installed from there with
+#   cmake --install PGO_BINARY_DIR/build
+# Alternatively, another build tree configured with GEOGRAPHICLIB_PGO = USE
+# and GEOGRAPHICLIB_PGO_DIR = PGO_BINARY_DIR/profile uses the same profiles
+# (with g++ this must be the same build tree, since the profiles are
+# matched to the object files by their paths).
+#
+# The variables PGO_SOURCE_DIR, PGO_BINARY_DIR, PGO_BASELINE (the geobench
+# executable of the current build), PGO_GENERATOR, PGO_BUILD_TYPE,
+# PGO_CXX_COMPILER, PGO_COMPILER_ID, PGO_PRECISION, PGO_PROFDATA,
+# PGO_GEODTEST, and PGO_COUNT are set by the pgo target.
+
+include (ProcessorCount)
+ProcessorCount (_NPROC)
+if (_NPROC EQUAL 0)
+  set (_NPROC 1)
+endif ()
+
+set (_BUILD "${PGO_BINARY_DIR}/build")
+set (_PROFILE "${PGO_BINARY_DIR}/profile")
+
+# Run a command, stopping on failure.
+function (pgo_run)
+  execute_process (COMMAND ${ARGN} RESULT_VARIABLE _res)
+  if (NOT _res EQUAL 0)
+    message (FATAL_ERROR "pgo: command failed: ${ARGN}")
+  endif ()
+endfunction ()
+
+# Run geobench and save the output in file.
+function (pgo_bench exe file)
+  set (_args -n ${PGO_COUNT})
+  if (PGO_GEODTEST)
+    list (APPEND _args -f ${PGO_GEODTEST})
+  endif ()
+  execute_process (COMMAND ${exe} ${_args}
+    OUTPUT_FILE ${file} RESULT_VARIABLE _res)
+  if (NOT _res EQUAL 0)
+    message (FATAL_ERROR "pgo: ${exe} failed")
+  endif ()
+endfunction ()
+
+# Run the tests in _BUILD.
+function (pgo_test)
+  execute_process (COMMAND ${CMAKE_CTEST_COMMAND} --output-on-failure
+    -j ${_NPROC} WORKING_DIRECTORY ${_BUILD} RESULT_VARIABLE _res)
+  if (NOT _res EQUAL 0)
+    message (FATAL_ERROR "pgo: the tests failed in ${_BUILD}")
+  endif ()
+endfunction ()
+
+# Configure and build the tree in _BUILD with GEOGRAPHICLIB_PGO = mode.
+function (pgo_build mode)
+  message (STATUS "pgo: building with GEOGRAPHICLIB_PGO = ${mode}")
+  pgo_run (${CMAKE_COMMAND} -S ${PGO_SOURCE_DIR} -B ${_BUILD}
+    -G ${PGO_GENERATOR}
+    -D CMAKE_BUILD_TYPE=${PGO_BUILD_TYPE}
+    -D CMAKE_CXX_COMPILER=${PGO_CXX_COMPILER}
+    -D GEOGRAPHICLIB_PRECISION=${PGO_PRECISION}
+    -D GEOGRAPHICLIB_PGO=${mode}
+    -D GEOGRAPHICLIB_PGO_DIR=${_PROFILE})
+  pgo_run (${CMAKE_COMMAND} --build ${_BUILD} --parallel ${_NPROC})
+  pgo_run (${CMAKE_COMMAND} --build ${_BUILD} --parallel ${_NPROC}
+    --target geobench)
+endfunction ()
+
+message (STATUS "pgo: baseline run of ${PGO_BASELINE}")
+file (MAKE_DIRECTORY ${PGO_BINARY_DIR})
+pgo_bench (${PGO_BASELINE} ${PGO_BINARY_DIR}/before.txt)
+
+file (REMOVE_RECURSE ${_PROFILE})
+file (MAKE_DIRECTORY ${_PROFILE})
+pgo_build (GENERATE)
+
+message (STATUS "pgo: training run")
+pgo_test ()
+pgo_bench (${_BUILD}/benchmarks/geobench ${PGO_BINARY_DIR}/training.txt)
+
+if (PGO_COMPILER_ID MATCHES "Clang")
+  if (NOT PGO_PROFDATA)
+    message (FATAL_ERROR "pgo: llvm-profdata is needed with clang")
+  endif ()
+  file (GLOB _RAW "${_PROFILE}/*.profraw")
+  pgo_run (${PGO_PROFDATA} merge -output=${_PROFILE}/default.profdata
+    ${_RAW})
+endif ()
+
+pgo_build (USE)
+pgo_test ()
+pgo_bench (${_BUILD}/benchmarks/geobench ${PGO_BINARY_DIR}/after.txt)
+
+# Report the times.
+file (STRINGS ${PGO_BINARY_DIR}/before.txt _before REGEX " ns  checksum ")
+file (STRINGS ${PGO_BINARY_DIR}/after.txt _after REGEX " ns  checksum ")
+set (_report "Time per operation (ns) without and with PGO\n")
+foreach (_line ${_before})
+  string (REGEX REPLACE "^([^ ]+) +([0-9.]+) ns .*" "\\1;\\2" _b "${_line}")
+  list (GET _b 0 _name)
+  list (GET _b 1 _t0)
+  foreach (_line1 ${_after})
+    string (REGEX REPLACE "^([^ ]+) +([0-9.]+) ns .*" "\\1;\\2" _a
+      "${_line1}")
+    list (GET _a 0 _name1)
+    if (_name1 STREQUAL _name)
+      list (GET _a 1 _t1)
+      # The saving in percent; the times are printed with one decimal
+      # place, so remove the point for the integer arithmetic.
+      string (REPLACE "." "" _i0 "${_t0}")
+      string (REPLACE "." "" _i1 "${_t1}")
+      math (EXPR _s "(${_i0} - ${_i1}) * 100 / ${_i0}")
+      string (APPEND _report "  ${_name}  ${_t0}  ${_t1}  (${_s}%)\n")
+    endif ()
+  endforeach ()
+endforeach ()
+file (WRITE ${PGO_BINARY_DIR}/report.txt "${_report}")
+message ("${_report}")
+message (STATUS "pgo: optimized build in ${_BUILD}; "
+  "report in ${PGO_BINARY_DIR}/report.txt")
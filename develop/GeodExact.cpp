@@ -1,34 +1,113 @@
+/**
+ * \file GeodExact.cpp
+ *
+ * Reference solutions of geodesic problems using the 30th order series in
+ * Geodesic30.  This uses the most precise type available: quad precision if
+ * the library is built with GEOGRAPHICLIB_PRECISION = 4, otherwise long
+ * double (if supported) or double.
+ *
+ * Usage: GeodExact [-i | -d] [-e a f] [-p prec] [-t nthreads] [-h]
+ *
+ * Standard input contains one problem per line (lat1 lon1 lat2 lon2 with
+ * -i, the default, or lat1 lon1 azi1 s12 with -d).  The results (s12 azi1
+ * azi2 m12 M12 M21 S12 with -i, lat2 lon2 azi2 m12 M12 M21 S12 with -d)
+ * are printed with prec decimal places (default 15 + extra digits for the
+ * type).  The problems are solved in batches with nthreads threads.
+ **********************************************************************/
+
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <GeographicLib/Utility.hpp>
 #include "Geodesic30.hpp"
 
-int main() {
-  {
-    GeographicLib::Geodesic30<double> g(6.4e6, 0.01);
-    {
-      double lat2, lon2, azi2;
-      g.Direct(10, 30, 20, 1e6, lat2, lon2, azi2);
-      std::cout << lat2 << " " << lon2 << " " << azi2 << "\n";
+using namespace GeographicLib;
+using namespace std;
+
+static int usage(int retval) {
+  ( retval ? cerr : cout ) <<
+    "Usage: GeodExact [-i | -d] [-e a f] [-p prec] [-t nthreads] [-h]\n";
+  return retval;
+}
+
+int main(int argc, const char* const argv[]) {
+  try {
+#if GEOGRAPHICLIB_PRECISION == 4
+    typedef Math::real real;
+#elif GEOGRAPHICLIB_HAVE_LONG_DOUBLE
+    typedef long double real;
+#else
+    typedef double real;
+#endif
+    Utility::set_digits();
+    bool direct = false;
+    real a = Constants::WGS84_a<real>(), f = Constants::WGS84_f<real>();
+    int prec = 15 + (numeric_limits<real>::digits - 53) * 3 / 10,
+      nthreads = 1;
+    for (int m = 1; m < argc; ++m) {
+      string arg(argv[m]);
+      if (arg == "-i")
+        direct = false;
+      else if (arg == "-d")
+        direct = true;
+      else if (arg == "-e" && m + 2 < argc) {
+        a = Utility::val<real>(string(argv[m + 1]));
+        f = Utility::fract<real>(string(argv[m + 2]));
+        m += 2;
+      } else if (arg == "-p" && m + 1 < argc)
+        prec = Utility::val<int>(string(argv[++m]));
+      else if (arg == "-t" && m + 1 < argc)
+        nthreads = Utility::val<int>(string(argv[++m]));
+      else
+        return usage(arg == "-h" ? 0 : 1);
     }
-    {
-      double s12, azi1, azi2;
-      g.Inverse(-20, 0, 10, 70, s12, azi1, azi2);
-      std::cout << s12 << " " << azi1 << " " << azi2 << "\n";
+    const Geodesic30<real> g(a, f);
+    const size_t batch = 10000;
+    vector<real> x1(batch), y1(batch), x2(batch), y2(batch),
+      r1(batch), r2(batch), r3(batch), m12(batch), M12(batch), M21(batch),
+      S12(batch), s12(batch);
+    string line;
+    bool more = true;
+    while (more) {
+      size_t n = 0;
+      while (n < batch && (more = bool(getline(cin, line)))) {
+        istringstream str(line);
+        string s1, s2, s3, s4;
+        if (!(str >> s1 >> s2 >> s3 >> s4))
+          throw GeographicErr("Incomplete input: " + line);
+        x1[n] = Utility::val<real>(s1); y1[n] = Utility::val<real>(s2);
+        x2[n] = Utility::val<real>(s3); y2[n] = Utility::val<real>(s4);
+        ++n;
+      }
+      const unsigned outmask = Geodesic30<real>::ALL;
+      if (direct)
+        g.GenDirect(n, x1.data(), y1.data(), x2.data(), false, y2.data(),
+                    outmask, r1.data(), r2.data(), r3.data(), s12.data(),
+                    m12.data(), M12.data(), M21.data(), S12.data(),
+                    nullptr, nthreads);
+      else
+        g.GenInverse(n, x1.data(), y1.data(), x2.data(), y2.data(),
+                     outmask, r1.data(), r2.data(), r3.data(),
+                     m12.data(), M12.data(), M21.data(), S12.data(),
+                     nullptr, nthreads);
+      for (size_t i = 0; i < n; ++i)
+        cout << Utility::str(r1[i], prec) << " "
+             << Utility::str(r2[i], prec) << " "
+             << Utility::str(r3[i], prec) << " "
+             << Utility::str(m12[i], prec) << " "
+             << Utility::str(M12[i], prec) << " "
+             << Utility::str(M21[i], prec) << " "
+             << Utility::str(S12[i], prec) << "\n";
     }
   }
-  /*
-  {
-    GeographicLib::Geodesic30<long double> g(6.4e6L, 0.01L);
-    {
-      long double lat2, lon2, azi2;
-      g.Direct(10, 30, 20, 1e6L, lat2, lon2, azi2);
-      std::cout << lat2 << " " << lon2 << " " << azi2 << "\n";
-    }
-    {
-      long double s12, azi1, azi2;
-      g.Inverse(-20, 0, 10, 70, s12, azi1, azi2);
-      std::cout << s12 << " " << azi1 << " " << azi2 << "\n";
-    }
+  catch (const exception& e) {
+    cerr << "Caught exception: " << e.what() << "\n";
+    return 1;
+  }
+  catch (...) {
+    cerr << "Caught unknown exception\n";
+    return 1;
   }
-  */
   return 0;
 }
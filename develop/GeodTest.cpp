@@ -19,13 +19,21 @@
 #include <utility>
 #include <algorithm>
 #include <limits>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <iterator>
+#if defined(_WIN32)
+#  include <io.h>
+#  include <fcntl.h>
+#endif
 
 using namespace std;
 using namespace GeographicLib;
 
 int usage(int retval) {
   ( retval ? cerr : cout ) <<
-"GeodTest [ -a | -c | -t0 | -t1 | -t2 | -t3 | -h ]\n\
+"GeodTest [ -a | -E | -F | -c | -p | -B | -t0 | -t1 | -t2 | -t3 | -h ]\n\
 \n\
 Check GeographicLib::Geodesic class.\n\
 -a (default) accuracy test (reads test data on standard input)\n\
@@ -33,6 +41,10 @@ Check GeographicLib::Geodesic class.\n\
 -F accuracy test with GeodesicExact (reads test data on standard input\n\
    first line gives a and f)\n\
 -c coverage test (reads test data on standard input)\n\
+-p time and check the accuracy of the solvers (Geodesic, Geodesic with\n\
+   orders 5, 4, and 3, GeodesicExact, and the batch interfaces) on the test\n\
+   data on standard input; report ns per problem and the maximum errors\n\
+-B convert the test data on standard input to binary on standard output\n\
 -t0 time GeodecicLine with distances using synthetic data\n\
 -t1 time GeodecicLine with angles using synthetic data\n\
 -t2 time Geodecic::Direct using synthetic data\n\
@@ -42,7 +54,9 @@ Check GeographicLib::Geodesic class.\n\
 -T2 time GeodecicExact::Direct using synthetic data\n\
 -T3 time GeodecicExact::Inverse with synthetic data\n\
 \n\
--c requires an instrumented version of Geodesic.\n";
+-c requires an instrumented version of Geodesic.  The test data may be\n\
+the text GeodTest.dat or the (faster to read) binary version written by -B\n\
+with the same precision.\n";
   return retval;
 }
 
@@ -184,6 +198,183 @@ void GeodError(const test& tgeod,
   }
 }
 
+// A test problem: the ten fields of a line of GeodTest.dat.  S12 is NaN if
+// it's missing.
+struct TestCase {
+  Math::real lat1, lon1, azi1, lat2, lon2, azi2, s12, a12, m12, S12;
+};
+
+// The binary version of the test set written by GeodTest -B: the 8 byte
+// magic "GeodTest", a 64-bit record count, and a 64-bit giving the size of
+// Math::real (all little-endian), followed by the records as arrays of ten
+// Math::real numbers in native order.  It's several times faster to read
+// than the text version.
+const char binmagic[] = "GeodTest";
+
+// Parse the numbers in [p, e) into t; return false if there aren't 9 or 10
+// numbers.
+bool ParseLine(const char* p, const char* e, TestCase& t) {
+  Math::real* v = &t.lat1;
+#if GEOGRAPHICLIB_PRECISION <= 3
+  for (int k = 0; k < 10; ++k) {
+    while (p < e && (*p == ' ' || *p == '\t')) ++p;
+    if (p == e || *p == '\r') {
+      if (k < 9) return false;
+      t.S12 = Math::NaN();
+      return true;
+    }
+    char* q;
+#  if GEOGRAPHICLIB_PRECISION == 1
+    v[k] = strtof(p, &q);
+#  elif GEOGRAPHICLIB_PRECISION == 2
+    v[k] = strtod(p, &q);
+#  else
+    v[k] = strtold(p, &q);
+#  endif
+    if (q == p || q > e) return false;
+    p = q;
+  }
+  return true;
+#else
+  istringstream str(string(p, e));
+  for (int k = 0; k < 9; ++k)
+    if (!(str >> v[k])) return false;
+  if (!(str >> t.S12)) t.S12 = Math::NaN();
+  return true;
+#endif
+}
+
+// Read the test set from in, either the text or the binary version.  The
+// text version stops at the first line which can't be parsed.
+vector<TestCase> ReadTestSet(istream& in) {
+  vector<TestCase> tests;
+  string buf((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+  const size_t hdr = 8 + 2 * 8;
+  if (buf.size() >= hdr && buf.compare(0, 8, binmagic) == 0) {
+    unsigned long long num = 0, size = 0;
+    for (int k = 7; k >= 0; --k) {
+      num = num << 8 | (unsigned char)(buf[8 + k]);
+      size = size << 8 | (unsigned char)(buf[16 + k]);
+    }
+    if (size != sizeof(Math::real))
+      throw GeographicErr("Binary test set has the wrong precision");
+    if ((buf.size() - hdr) / sizeof(TestCase) < num)
+      throw GeographicErr("Binary test set is truncated");
+    tests.resize(size_t(num));
+    if (num)
+      memcpy(&tests[0], buf.data() + hdr, size_t(num) * sizeof(TestCase));
+    return tests;
+  }
+  tests.reserve(buf.size() / 150);
+  for (const char* p = buf.data(), *end = p + buf.size(); p < end;) {
+    const char* e = static_cast<const char*>(memchr(p, '\n', end - p));
+    if (!e) e = end;
+    TestCase t;
+    if (!ParseLine(p, e, t)) break;
+    tests.push_back(t);
+    p = e + 1;
+  }
+  return tests;
+}
+
+// Write the binary version of the test set to out.
+void WriteTestSet(ostream& out, const vector<TestCase>& tests) {
+  char hdr[8 + 2 * 8];
+  memcpy(hdr, binmagic, 8);
+  unsigned long long num = tests.size(), size = sizeof(Math::real);
+  for (int k = 0; k < 8; ++k) {
+    hdr[8 + k] = char(num >> (8 * k) & 0xff);
+    hdr[16 + k] = char(size >> (8 * k) & 0xff);
+  }
+  out.write(hdr, sizeof(hdr));
+  if (!tests.empty())
+    out.write(reinterpret_cast<const char*>(&tests[0]),
+              tests.size() * sizeof(TestCase));
+}
+
+// For each of the solvers, time the direct and inverse problems over the
+// test set and report the time per problem and the maximum errors in the
+// position of point 2 (direct) and in s12 (inverse).
+void Benchmark(Math::real a, Math::real f, const vector<TestCase>& tests) {
+  typedef Math::real real;
+  typedef chrono::steady_clock clock;
+  const size_t n = tests.size();
+  if (n == 0) return;
+  vector<real> lat1(n), lon1(n), azi1(n), lat2(n), lon2(n), s12(n),
+    tlat2(n), tlon2(n), ts12(n);
+  for (size_t i = 0; i < n; ++i) {
+    lat1[i] = tests[i].lat1; lon1[i] = tests[i].lon1;
+    azi1[i] = tests[i].azi1; lat2[i] = tests[i].lat2;
+    lon2[i] = tests[i].lon2; s12[i] = tests[i].s12;
+  }
+  const Geodesic geod(a, f);
+  const Geodesic geod3(a, f, false, 3), geod4(a, f, false, 4),
+    geod5(a, f, false, 5);
+  const GeodesicExact geode(a, f);
+  const real mult = real(Math::extra_digits() == 0 ? 1e9l :
+                         Math::extra_digits() <= 3 ? 1e12l : 1e15l);
+  cout << n << " problems; errors in "
+       << (Math::extra_digits() == 0 ? "nm" :
+           Math::extra_digits() <= 3 ? "pm" : "fm") << "\n"
+       << left << setw(24) << "solver" << setw(10) << "problem" << right
+       << setw(10) << "ns/op" << setw(14) << "max error" << "\n";
+  // Report and reset the results of a run which started at t0.
+  auto report = [&](const string& solver, bool direct,
+                    clock::time_point t0) -> void {
+    double ns = chrono::duration<double, nano>(clock::now() - t0).count();
+    real err = 0;
+    for (size_t i = 0; i < n; ++i) {
+      real e = direct ?
+        dist(a, f, lat2[i], lon2[i], tlat2[i], tlon2[i]) :
+        abs(ts12[i] - s12[i]);
+      // NaNs count as errors
+      if (!(e <= err)) err = e;
+    }
+    cout << left << setw(24) << solver
+         << setw(10) << (direct ? "direct" : "inverse") << right
+         << fixed << setprecision(1) << setw(10) << ns / double(n)
+         << setprecision(2) << setw(14) << mult * err << "\n";
+  };
+  auto single = [&](const string& solver, const Geodesic& g) -> void {
+    clock::time_point t0 = clock::now();
+    for (size_t i = 0; i < n; ++i)
+      g.Direct(lat1[i], lon1[i], azi1[i], s12[i], tlat2[i], tlon2[i]);
+    report(solver, true, t0);
+    t0 = clock::now();
+    for (size_t i = 0; i < n; ++i)
+      g.Inverse(lat1[i], lon1[i], lat2[i], lon2[i], ts12[i]);
+    report(solver, false, t0);
+  };
+  single("Geodesic", geod);
+  single("Geodesic order 5", geod5);
+  single("Geodesic order 4", geod4);
+  single("Geodesic order 3", geod3);
+  clock::time_point t0 = clock::now();
+  geod.GenInverse(n, lat1.data(), lon1.data(), lat2.data(), lon2.data(),
+                  Geodesic::DISTANCE, ts12.data(), nullptr, nullptr,
+                  nullptr, nullptr, nullptr, nullptr);
+  report("Geodesic batch", false, t0);
+  t0 = clock::now();
+  for (size_t i = 0; i < n; ++i)
+    geode.Direct(lat1[i], lon1[i], azi1[i], s12[i], tlat2[i], tlon2[i]);
+  report("GeodesicExact", true, t0);
+  t0 = clock::now();
+  for (size_t i = 0; i < n; ++i)
+    geode.Inverse(lat1[i], lon1[i], lat2[i], lon2[i], ts12[i]);
+  report("GeodesicExact", false, t0);
+  t0 = clock::now();
+  geode.GenDirect(n, lat1.data(), lon1.data(), azi1.data(), false,
+                  s12.data(), GeodesicExact::LATITUDE |
+                  GeodesicExact::LONGITUDE, tlat2.data(), tlon2.data(),
+                  nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
+  report("GeodesicExact batch", true, t0);
+  t0 = clock::now();
+  geode.GenInverse(n, lat1.data(), lon1.data(), lat2.data(), lon2.data(),
+                   GeodesicExact::DISTANCE, ts12.data(), nullptr, nullptr,
+                   nullptr, nullptr, nullptr, nullptr);
+  report("GeodesicExact batch", false, t0);
+}
+
 int main(int argc, char* argv[]) {
   Utility::set_digits();
   Math::real a = Constants::WGS84_a();
@@ -193,6 +384,8 @@ int main(int argc, char* argv[]) {
   bool accuracytest = true;
   bool coverage = false;
   bool exact = false;
+  bool bench = false;
+  bool convert = false;
   if (argc == 2) {
     string arg = argv[1];
     if (arg == "-a") {
@@ -219,6 +412,12 @@ int main(int argc, char* argv[]) {
       coverage = true;
       timing = false;
       exact = false;
+    } else if (arg == "-p" || arg == "-B") {
+      accuracytest = false;
+      coverage = false;
+      timing = false;
+      bench = arg == "-p";
+      convert = !bench;
     } else if (arg == "-t0") {
       accuracytest = false;
       coverage = false;
@@ -272,7 +471,24 @@ int main(int argc, char* argv[]) {
   } else if (argc > 2)
     return usage(1);
 
-  if (timing) {
+  if (bench || convert) {
+    try {
+#if defined(_WIN32)
+      _setmode(_fileno(stdin), _O_BINARY);
+      if (convert) _setmode(_fileno(stdout), _O_BINARY);
+#endif
+      vector<TestCase> tests = ReadTestSet(cin);
+      if (convert)
+        WriteTestSet(cout, tests);
+      else
+        Benchmark(a, f, tests);
+    }
+    catch (const exception& e) {
+      cerr << "Caught exception: " << e.what() << "\n";
+      return 1;
+    }
+  }
+  else if (timing) {
     if (!exact) {
       const Geodesic& geod = Geodesic::WGS84();
       unsigned cnt = 0;
@@ -446,17 +662,13 @@ int main(int argc, char* argv[]) {
     vector<Math::real> err(NUMERR, 0.0);
     vector<unsigned> errind(NUMERR);
     unsigned cnt = 0;
-    string s;
-    while (getline(cin, s)) {
-      istringstream str(s);
-      Math::real lat1l, lon1l, azi1l, lat2l, lon2l, azi2l,
-        s12l, a12l, m12l, S12l;
-      if (!(str >> lat1l >> lon1l >> azi1l
-                >> lat2l >> lon2l >> azi2l
-                >> s12l >> a12l >> m12l))
-        break;
-      if (!(str >> S12l))
-        S12l = Math::NaN();
+#if defined(_WIN32)
+    _setmode(_fileno(stdin), _O_BINARY);
+#endif
+    for (const TestCase& t : ReadTestSet(cin)) {
+      Math::real lat1l = t.lat1, lon1l = t.lon1, azi1l = t.azi1,
+        lat2l = t.lat2, lon2l = t.lon2, azi2l = t.azi2,
+        s12l = t.s12, a12l = t.a12, m12l = t.m12, S12l = t.S12;
       if (coverage) {
 #if defined(GEOD_DIAG) && GEOD_DIAG
         Math::real
@@ -27,7 +27,11 @@
  **********************************************************************/
 
 #include "Geodesic30.hpp"
+#include <atomic>
+#include <exception>
+#include <vector>
 #include "GeodesicLine30.hpp"
+#include <GeographicLib/Executor.hpp>
 
 #if defined(_MSC_VER)
 // Squelch warnings about potentially uninitialized local variables
@@ -38,6 +42,41 @@ namespace GeographicLib {
 
   using namespace std;
 
+  namespace {
+
+    // Call work(i) for i in [0, n) on nthreads threads.  The indices are
+    // claimed in blocks with an atomic counter.
+    template<class F> void Blocks(size_t n, int nthreads, F work) {
+      const size_t block = 64, nblocks = (n + block - 1) / block;
+      auto run = [&](size_t b) -> void {
+        for (size_t i = b * block; i < min(n, (b + 1) * block); ++i)
+          work(i);
+      };
+      nthreads = int(min(size_t(max(1, nthreads)), nblocks));
+      if (nthreads <= 1) {
+        for (size_t b = 0; b < nblocks; ++b) run(b);
+        return;
+      }
+      atomic<size_t> next(0);
+      const int ndigits = Math::digits();
+      vector<exception_ptr> errs(nthreads);
+      Executor::Current().Run(nthreads, [&](int t) -> void {
+        try {
+          Math::set_digits(ndigits);
+          for (size_t b; (b = next++) < nblocks;)
+            run(b);
+        }
+        catch (...) {
+          errs[t] = current_exception();
+          next = nblocks;       // Stop the other threads
+        }
+      });
+      for (auto& e : errs)
+        if (e) rethrow_exception(e);
+    }
+
+  } // namespace
+
   // Underflow guard.  We require
   //   tiny_ * epsilon() > 0
   //   tiny_ + epsilon() == epsilon()
@@ -131,6 +170,62 @@ namespace GeographicLib {
                   lat2, lon2, azi2, s12, m12, M12, M21, S12);
   }
 
+  template<typename real>
+  void Geodesic30<real>::GenDirect(size_t n,
+                                   const real lat1[], const real lon1[],
+                                   const real azi1[],
+                                   bool arcmode, const real s12_a12[],
+                                   unsigned outmask,
+                                   real lat2[], real lon2[], real azi2[],
+                                   real s12[], real m12[],
+                                   real M12[], real M21[],
+                                   real S12[], real a12[],
+                                   int nthreads) const {
+    // The capabilities in outmask are needed by GenDirect; the output bits
+    // determine which arrays are set.
+    const unsigned out = outmask & OUT_ALL;
+    Blocks(n, nthreads, [&](size_t i) -> void {
+      // Scratch outputs for the quantities not requested
+      real lat2x, lon2x, azi2x, s12x, m12x, M12x, M21x, S12x;
+      real a12x = GenDirect(lat1[i], lon1[i], azi1[i], arcmode, s12_a12[i],
+                            outmask,
+                            out & LATITUDE ? lat2[i] : lat2x,
+                            out & LONGITUDE ? lon2[i] : lon2x,
+                            out & AZIMUTH ? azi2[i] : azi2x,
+                            out & DISTANCE ? s12[i] : s12x,
+                            out & REDUCEDLENGTH ? m12[i] : m12x,
+                            out & GEODESICSCALE ? M12[i] : M12x,
+                            out & GEODESICSCALE ? M21[i] : M21x,
+                            out & AREA ? S12[i] : S12x);
+      if (a12) a12[i] = a12x;
+    });
+  }
+
+  template<typename real>
+  void Geodesic30<real>::GenInverse(size_t n,
+                                    const real lat1[], const real lon1[],
+                                    const real lat2[], const real lon2[],
+                                    unsigned outmask,
+                                    real s12[], real azi1[], real azi2[],
+                                    real m12[], real M12[], real M21[],
+                                    real S12[], real a12[],
+                                    int nthreads) const {
+    const unsigned out = outmask & OUT_ALL;
+    Blocks(n, nthreads, [&](size_t i) -> void {
+      // Scratch outputs for the quantities not requested
+      real s12x, azi1x, azi2x, m12x, M12x, M21x, S12x;
+      real a12x = GenInverse(lat1[i], lon1[i], lat2[i], lon2[i], outmask,
+                             out & DISTANCE ? s12[i] : s12x,
+                             out & AZIMUTH ? azi1[i] : azi1x,
+                             out & AZIMUTH ? azi2[i] : azi2x,
+                             out & REDUCEDLENGTH ? m12[i] : m12x,
+                             out & GEODESICSCALE ? M12[i] : M12x,
+                             out & GEODESICSCALE ? M21[i] : M21x,
+                             out & AREA ? S12[i] : S12x);
+      if (a12) a12[i] = a12x;
+    });
+  }
+
   template<typename real>
   real Geodesic30<real>::GenInverse(real lat1, real lon1,
                                     real lat2, real lon2,
@@ -560,8 +655,8 @@ namespace GeographicLib {
     // and g++ 4.4.0 (mingw) and g++ 4.6.1 (tdm mingw).
     real sbet12a;
     {
-      volatile real xx1 = sbet2 * cbet1;
-      volatile real xx2 = cbet2 * sbet1;
+      GEOGRAPHICLIB_VOLATILE real xx1 = sbet2 * cbet1;
+      GEOGRAPHICLIB_VOLATILE real xx2 = cbet2 * sbet1;
       sbet12a = xx1 + xx2;
     }
 #else
@@ -600,7 +695,7 @@ namespace GeographicLib {
       // Volatile declaration needed to fix inverse case
       // 56.320923501171 0 -56.320923501171 179.664747671772880215
       // which otherwise fails with g++ 4.4.4 x86 -O3
-      volatile real x;
+      GEOGRAPHICLIB_VOLATILE real x;
       if (_f >= 0) {            // In fact f == 0 does not get here
         // x = dlong, y = dlat
         {
@@ -6169,5 +6264,9 @@ namespace GeographicLib {
 #if GEOGRAPHICLIB_HAVE_LONG_DOUBLE
   template class Geodesic30<long double>;
 #endif
+#if GEOGRAPHICLIB_PRECISION == 4
+  // Quad precision, boost::multiprecision::float128 (which wraps __float128)
+  template class Geodesic30<Math::real>;
+#endif
 
 } // namespace GeographicLib
@@ -7,16 +7,17 @@
  * https://geographiclib.sourceforge.io/
  **********************************************************************/
 
-#if !defined(GEOGRAPHICLIB_GEODESICEXACT_HPP)
-#define GEOGRAPHICLIB_GEODESICEXACT_HPP 1
+#if !defined(GEOGRAPHICLIB_GEODESIC30_HPP)
+#define GEOGRAPHICLIB_GEODESIC30_HPP 1
 
 #include <GeographicLib/Constants.hpp>
 
-#if !defined(GEOGRAPHICLIB_GEODESICEXACT_ORDER)
+#if !defined(GEOGRAPHICLIB_GEODESIC30_ORDER)
 /**
- * The order of the expansions used by Geodesic30.
+ * The order of the expansions used by Geodesic30.  Only 30 is supported
+ * by the coefficients in Geodesic30.cpp.
  **********************************************************************/
-#  define GEOGRAPHICLIB_GEODESICEXACT_ORDER 30
+#  define GEOGRAPHICLIB_GEODESIC30_ORDER 30
 #endif
 
 namespace GeographicLib {
@@ -118,16 +119,16 @@ namespace GeographicLib {
   class Geodesic30 {
   private:
     friend class GeodesicLine30<real>;
-    static const int nA1_ = GEOGRAPHICLIB_GEODESICEXACT_ORDER;
-    static const int nC1_ = GEOGRAPHICLIB_GEODESICEXACT_ORDER;
-    static const int nC1p_ = GEOGRAPHICLIB_GEODESICEXACT_ORDER;
-    static const int nA2_ = GEOGRAPHICLIB_GEODESICEXACT_ORDER;
-    static const int nC2_ = GEOGRAPHICLIB_GEODESICEXACT_ORDER;
-    static const int nA3_ = GEOGRAPHICLIB_GEODESICEXACT_ORDER;
+    static const int nA1_ = GEOGRAPHICLIB_GEODESIC30_ORDER;
+    static const int nC1_ = GEOGRAPHICLIB_GEODESIC30_ORDER;
+    static const int nC1p_ = GEOGRAPHICLIB_GEODESIC30_ORDER;
+    static const int nA2_ = GEOGRAPHICLIB_GEODESIC30_ORDER;
+    static const int nC2_ = GEOGRAPHICLIB_GEODESIC30_ORDER;
+    static const int nA3_ = GEOGRAPHICLIB_GEODESIC30_ORDER;
     static const int nA3x_ = nA3_;
-    static const int nC3_ = GEOGRAPHICLIB_GEODESICEXACT_ORDER;
+    static const int nC3_ = GEOGRAPHICLIB_GEODESIC30_ORDER;
     static const int nC3x_ = (nC3_ * (nC3_ - 1)) / 2;
-    static const int nC4_ = GEOGRAPHICLIB_GEODESICEXACT_ORDER;
+    static const int nC4_ = GEOGRAPHICLIB_GEODESIC30_ORDER;
     static const int nC4x_ = (nC4_ * (nC4_ + 1)) / 2;
     static const unsigned maxit_ = 50;
 
@@ -158,7 +159,8 @@ namespace GeographicLib {
       // degrees.)  We use this to avoid having to deal with near singular
       // cases when x is non-zero but tiny (e.g., 1.0e-200).
       const real z = real(0.0625); // 1/16
-      volatile real y = std::abs(x);
+      using std::abs;
+      GEOGRAPHICLIB_VOLATILE real y = abs(x);
       // The compiler mustn't "simplify" z - (z - y) to y
       y = y < z ? z - (z - y) : y;
       return x < 0 ? -y : y;
@@ -582,6 +584,47 @@ namespace GeographicLib {
                          real& lat2, real& lon2, real& azi2,
                          real& s12, real& m12, real& M12, real& M21,
                          real& S12) const;
+
+    /**
+     * Solve many direct geodesic problems given as structure-of-arrays.
+     *
+     * @param[in] n the number of problems to solve.
+     * @param[in] lat1 array of \e n latitudes of point 1 (degrees).
+     * @param[in] lon1 array of \e n longitudes of point 1 (degrees).
+     * @param[in] azi1 array of \e n azimuths at point 1 (degrees).
+     * @param[in] arcmode boolean flag determining the meaning of \e
+     *   s12_a12.
+     * @param[in] s12_a12 array of \e n distances (meters) or arc lengths
+     *   (degrees) between point 1 and point 2.
+     * @param[in] outmask a bitor'ed combination of Geodesic30::mask values
+     *   specifying which of the following arrays should be set.
+     * @param[out] lat2 array of latitudes of point 2 (degrees).
+     * @param[out] lon2 array of longitudes of point 2 (degrees).
+     * @param[out] azi2 array of (forward) azimuths at point 2 (degrees).
+     * @param[out] s12 array of distances between point 1 and point 2
+     *   (meters).
+     * @param[out] m12 array of reduced lengths (meters).
+     * @param[out] M12 array of geodesic scales of point 2 relative to point 1
+     *   (dimensionless).
+     * @param[out] M21 array of geodesic scales of point 1 relative to point 2
+     *   (dimensionless).
+     * @param[out] S12 array of areas under the geodesics
+     *   (meters<sup>2</sup>).
+     * @param[out] a12 array of arc lengths between point 1 and point 2
+     *   (degrees); this may be a null pointer.
+     * @param[in] nthreads the number of threads to use (default 1).
+     *
+     * This is the same as GeodesicExact::GenDirect(size_t n, ...).  The
+     * output arrays need only be supplied for the quantities requested in \e
+     * outmask.  With \e nthreads &gt; 1, blocks of problems are solved
+     * concurrently with Executor::Current.
+     **********************************************************************/
+    void GenDirect(size_t n,
+                   const real lat1[], const real lon1[], const real azi1[],
+                   bool arcmode, const real s12_a12[], unsigned outmask,
+                   real lat2[], real lon2[], real azi2[],
+                   real s12[], real m12[], real M12[], real M21[],
+                   real S12[], real a12[] = nullptr, int nthreads = 1) const;
     ///@}
 
     /** \name Inverse geodesic problem.
@@ -743,6 +786,44 @@ namespace GeographicLib {
                           real& s12, real& azi1, real& azi2,
                           real& m12, real& M12, real& M21, real& S12)
       const;
+
+    /**
+     * Solve many inverse geodesic problems given as structure-of-arrays.
+     *
+     * @param[in] n the number of problems to solve.
+     * @param[in] lat1 array of \e n latitudes of point 1 (degrees).
+     * @param[in] lon1 array of \e n longitudes of point 1 (degrees).
+     * @param[in] lat2 array of \e n latitudes of point 2 (degrees).
+     * @param[in] lon2 array of \e n longitudes of point 2 (degrees).
+     * @param[in] outmask a bitor'ed combination of Geodesic30::mask values
+     *   specifying which of the following arrays should be set.
+     * @param[out] s12 array of distances between point 1 and point 2
+     *   (meters).
+     * @param[out] azi1 array of azimuths at point 1 (degrees).
+     * @param[out] azi2 array of (forward) azimuths at point 2 (degrees).
+     * @param[out] m12 array of reduced lengths (meters).
+     * @param[out] M12 array of geodesic scales of point 2 relative to point 1
+     *   (dimensionless).
+     * @param[out] M21 array of geodesic scales of point 1 relative to point 2
+     *   (dimensionless).
+     * @param[out] S12 array of areas under the geodesics
+     *   (meters<sup>2</sup>).
+     * @param[out] a12 array of arc lengths between point 1 and point 2
+     *   (degrees); this may be a null pointer.
+     * @param[in] nthreads the number of threads to use (default 1).
+     *
+     * This is the same as GeodesicExact::GenInverse(size_t n, ...).  The
+     * output arrays need only be supplied for the quantities requested in \e
+     * outmask.  With \e nthreads &gt; 1, blocks of problems are solved
+     * concurrently with Executor::Current.
+     **********************************************************************/
+    void GenInverse(size_t n,
+                    const real lat1[], const real lon1[],
+                    const real lat2[], const real lon2[],
+                    unsigned outmask,
+                    real s12[], real azi1[], real azi2[],
+                    real m12[], real M12[], real M21[], real S12[],
+                    real a12[] = nullptr, int nthreads = 1) const;
     ///@}
 
     /** \name Interface to GeodesicLine30.
@@ -835,4 +916,4 @@ namespace GeographicLib {
 
 } // namespace GeographicLib
 
-#endif  // GEOGRAPHICLIB_GEODESICEXACT_HPP
+#endif  // GEOGRAPHICLIB_GEODESIC30_HPP
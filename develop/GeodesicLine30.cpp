@@ -266,5 +266,8 @@ namespace GeographicLib {
 #if GEOGRAPHICLIB_HAVE_LONG_DOUBLE
   template class GeodesicLine30<long double>;
 #endif
+#if GEOGRAPHICLIB_PRECISION == 4
+  template class GeodesicLine30<Math::real>;
+#endif
 
 } // namespace GeographicLib
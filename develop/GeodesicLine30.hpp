@@ -7,8 +7,8 @@
  * https://geographiclib.sourceforge.io/
  **********************************************************************/
 
-#if !defined(GEOGRAPHICLIB_GEODESICLINEEXACT_HPP)
-#define GEOGRAPHICLIB_GEODESICLINEEXACT_HPP 1
+#if !defined(GEOGRAPHICLIB_GEODESICLINE30_HPP)
+#define GEOGRAPHICLIB_GEODESICLINE30_HPP 1
 
 #include <GeographicLib/Constants.hpp>
 #include "Geodesic30.hpp"
@@ -590,4 +590,4 @@ namespace GeographicLib {
 
 } // namespace GeographicLib
 
-#endif  // GEOGRAPHICLIB_GEODESICLINEEXACT_HPP
+#endif  // GEOGRAPHICLIB_GEODESICLINE30_HPP
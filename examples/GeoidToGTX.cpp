@@ -5,6 +5,13 @@
 // For the format of gtx files, see
 // https://vdatum.noaa.gov/docs/gtx_info.html#dev_gtx_binary
 //
+// The Gravity utility provides the same functionality (using C++11 threads
+// instead of OpenMP), e.g.,
+//   Gravity -n egm2008 -H --grid -90 -180 90 180 1/60 1/60 -j 0
+//     --output-file egm2008-1.gtx
+// (the grid then includes a column at 180 deg); GeoidEval --grid does the
+// same for the interpolated geoid heights given by the Geoid class.
+//
 // data is binary big-endian:
 //   south latitude edge (degrees double)
 //   west longitude edge (degrees double)
@@ -111,6 +111,7 @@ int main() {
     double d;
     int count = 0;
     vector<int> k;
+    pointset.EnableStatistics();
     while (is >> sa >> sb) {
       ++count;
       DMS::DecodeLatLon(sa, sb, lat, lon);
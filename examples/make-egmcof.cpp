@@ -1,37 +1,96 @@
 // Write the coefficient files needed for approximating the normal gravity
 // field with a GravityModel.  WARNING: this creates files, wgs84.egm.cof and
 // grs80.egm.cof, in the current directory.
+//
+// Each file is read back and checked after it is written and its size and
+// checksum (64-bit FNV-1a) are printed.  If file names are given on the
+// command line, these files are checked instead and nothing is written; this
+// allows the .cof files of a deployment to be verified, e.g., by comparing
+// the checksums with those recorded when the files were installed.
+//
+// The .cof files are already in the format used by GravityModel and, on
+// little-endian systems, GravityModel maps them directly into memory; so
+// there is no separate "cache" format.  The table of square roots used by
+// SphericalEngine is not stored since it takes only N square roots to
+// compute.
 
 #include <cmath>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
 #include <GeographicLib/NormalGravity.hpp>
+#include <GeographicLib/SphericalEngine.hpp>
 #include <GeographicLib/Utility.hpp>
 
 using namespace std;
 using namespace GeographicLib;
 
-int main() {
+// Check the .cof file filename and print its size and checksum.  This throws
+// an exception if the file is not a valid .cof file.
+void check(const string& filename) {
+  ifstream file(filename.c_str(), ios::binary);
+  if (!file.good())
+    throw GeographicErr("Cannot open " + filename);
+  ostringstream buf;
+  buf << file.rdbuf();
+  const string data = buf.str();
+  istringstream str(data);
+  char id[9];
+  str.read(id, 8);
+  if (!str.good())
+    throw GeographicErr("No header in " + filename);
+  id[8] = '\0';
+  // There are two sets of coefficients: the gravitational potential and the
+  // correction to the geoid height.
+  int N[2], M[2];
+  vector<Math::real> C, S;
+  for (int k = 0; k < 2; ++k)
+    SphericalEngine::coeff::readcoeffs(str, N[k], M[k], C, S);
+  if (str.tellg() != streampos(data.size()))
+    throw GeographicErr("Extra data in " + filename);
+  uint64_t h = 14695981039346656037ULL;
+  for (char c : data)
+    h = (h ^ uint64_t(static_cast<unsigned char>(c))) * 1099511628211ULL;
+  cout << filename << " " << id << " "
+       << N[0] << " " << M[0] << " " << N[1] << " " << M[1] << " "
+       << data.size() << " "
+       << hex << setfill('0') << setw(16) << h << dec << setfill(' ') << "\n";
+}
+
+int main(int argc, const char* const argv[]) {
   try {
     Utility::set_digits();
+    if (argc > 1) {
+      for (int i = 1; i < argc; ++i)
+        check(argv[i]);
+      return 0;
+    }
     const char* filenames[] = {"wgs84.egm.cof", "grs80.egm.cof"};
     const char* ids[] = {"WGS1984A", "GRS1980A"};
     for (int grs80 = 0; grs80 < 2; ++grs80) {
-      ofstream file(filenames[grs80], ios::binary);
-      Utility::writearray<char, char, false>(file, ids[grs80], 8);
-      const int N = 20, M = 0,
-        cnum = (M + 1) * (2 * N - M + 2) / 2; // cnum = N + 1
-      vector<int> num(2);
-      num[0] = N; num[1] = M;
-      Utility::writearray<int, int, false>(file, num);
-      vector<Math::real> c(cnum, 0);
-      const NormalGravity& earth(grs80 ? NormalGravity::GRS80() :
-                                 NormalGravity::WGS84());
-      for (int n = 2; n <= N; n += 2)
-        c[n] = - earth.DynamicalFormFactor(n) / sqrt(Math::real(2*n + 1));
-      Utility::writearray<double, Math::real, false>(file, c);
-      num[0] = num[1] = -1;
-      Utility::writearray<int, int, false>(file, num);
+      {
+        ofstream file(filenames[grs80], ios::binary);
+        Utility::writearray<char, char, false>(file, ids[grs80], 8);
+        const int N = 20, M = 0,
+          cnum = (M + 1) * (2 * N - M + 2) / 2; // cnum = N + 1
+        vector<int> num(2);
+        num[0] = N; num[1] = M;
+        Utility::writearray<int, int, false>(file, num);
+        vector<Math::real> c(cnum, 0);
+        const NormalGravity& earth(grs80 ? NormalGravity::GRS80() :
+                                   NormalGravity::WGS84());
+        for (int n = 2; n <= N; n += 2)
+          c[n] = - earth.DynamicalFormFactor(n) / sqrt(Math::real(2*n + 1));
+        Utility::writearray<double, Math::real, false>(file, c);
+        num[0] = num[1] = -1;
+        Utility::writearray<int, int, false>(file, num);
+        if (!file.good())
+          throw GeographicErr(string("Error writing ") + filenames[grs80]);
+      }
+      check(filenames[grs80]);
     }
   }
   catch (const exception& e) {
@@ -135,6 +135,37 @@ namespace GeographicLib {
      * @param[in] y set \e sum -= \e y.
      **********************************************************************/
     Accumulator& operator-=(T y) { Add(-y); return *this; }
+    /**
+     * Add an array of numbers to the accumulator.
+     *
+     * @param[in] n the number of elements of \e y.
+     * @param[in] y the array of numbers; set \e sum += <i>y</i>[0] + ... +
+     *   <i>y</i>[<i>n</i>&minus;1].
+     * @return a reference to this accumulator.
+     *
+     * The numbers are added in order and the result is identical to adding
+     * them one at a time with operator+=.  (The additions are not
+     * associative and so the sum cannot be split into several independent
+     * lanes without changing the result; to split a large sum, e.g., between
+     * threads, add the parts to separate accumulators and combine them with
+     * operator+=(const Accumulator&).)  The two words of the sum are held in
+     * local variables during the loop.
+     **********************************************************************/
+    Accumulator& Add(size_t n, const T y[]) {
+      Accumulator a(*this);
+      for (size_t i = 0; i < n; ++i)
+        a.Add(y[i]);
+      return *this = a;
+    }
+    /**
+     * Add another accumulator to this one.  Both words of \e a are added so
+     * that partial sums computed separately (e.g., on different threads)
+     * can be combined without loss of accuracy.
+     *
+     * @param[in] a set \e sum += \e a.
+     **********************************************************************/
+    Accumulator& operator+=(const Accumulator& a)
+    { Add(a._t); Add(a._s); return *this; }
     /**
      * Multiply accumulator by an integer.  To avoid loss of accuracy, use only
      * integers such that \e n &times; \e T is exactly representable as a \e T
@@ -118,6 +118,9 @@ namespace GeographicLib {
     void Init(real sphi1, real cphi1, real sphi2, real cphi2, real k1);
     real txif(real tphi) const;
     real tphif(real txi) const;
+    // Reverse with lon0 already reduced with Math::AngNormalize
+    void GenReverse(real lon0, real x, real y,
+                    real& lat, real& lon, real& gamma, real& k) const;
   public:
 
     /**
@@ -235,6 +238,52 @@ namespace GeographicLib {
     void Reverse(real lon0, real x, real y,
                  real& lat, real& lon, real& gamma, real& k) const;
 
+    /**
+     * Forward projection of many points with a common central meridian.
+     *
+     * @param[in] lon0 central meridian longitude (degrees).
+     * @param[in] n the number of points.
+     * @param[in] lat array of \e n latitudes (degrees).
+     * @param[in] lon array of \e n longitudes (degrees).
+     * @param[out] x array of \e n eastings (meters).
+     * @param[out] y array of \e n northings (meters).
+     * @param[out] gamma array of \e n meridian convergences (degrees); this
+     *   may be a null pointer.
+     * @param[out] k array of \e n azimuthal scales; this may be a null
+     *   pointer.
+     *
+     * Element \e i of the output arrays is set to the result of
+     * AlbersEqualArea::Forward applied to element \e i of the input arrays;
+     * the results are bitwise identical.  The input and output arrays must
+     * not overlap.
+     **********************************************************************/
+    void Forward(real lon0, size_t n, const real lat[], const real lon[],
+                 real x[], real y[],
+                 real gamma[] = nullptr, real k[] = nullptr) const;
+
+    /**
+     * Reverse projection of many points with a common central meridian.
+     *
+     * @param[in] lon0 central meridian longitude (degrees).
+     * @param[in] n the number of points.
+     * @param[in] x array of \e n eastings (meters).
+     * @param[in] y array of \e n northings (meters).
+     * @param[out] lat array of \e n latitudes (degrees).
+     * @param[out] lon array of \e n longitudes (degrees).
+     * @param[out] gamma array of \e n meridian convergences (degrees); this
+     *   may be a null pointer.
+     * @param[out] k array of \e n azimuthal scales; this may be a null
+     *   pointer.
+     *
+     * Element \e i of the output arrays is set to the result of
+     * AlbersEqualArea::Reverse applied to element \e i of the input arrays;
+     * the results are bitwise identical.  \e lon0 is reduced once for the
+     * whole batch.  The input and output arrays must not overlap.
+     **********************************************************************/
+    void Reverse(real lon0, size_t n, const real x[], const real y[],
+                 real lat[], real lon[],
+                 real gamma[] = nullptr, real k[] = nullptr) const;
+
     /**
      * AlbersEqualArea::Forward without returning the convergence and
      * scale.
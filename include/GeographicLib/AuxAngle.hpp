@@ -122,6 +122,22 @@ namespace GeographicLib {
      *   equal to the sine and cosine of the angle.
      **********************************************************************/
     void normalize() { *this = normalized(); }
+    /**
+     * Normalize many angles in place.
+     *
+     * @param[in] n the number of angles.
+     * @param[in,out] y array of \e n \e y components.
+     * @param[in,out] x array of \e n \e x components.
+     *
+     * The angles are held as separate arrays of their components.  This gives
+     * the same results as AuxAngle::normalize applied to each angle.  The
+     * arrays may hold unnormalized angles, e.g., the results of
+     * AuxLatitude::Convert, so that normalization can be deferred and then
+     * done for a whole batch at once; the common case, where the components
+     * are finite and not both zero, is handled by a loop which the compiler
+     * can vectorize.
+     **********************************************************************/
+    static void normalize(size_t n, real y[], real x[]);
     /**
      * Set the quadrant for the AuxAngle.
      *
@@ -69,6 +69,11 @@ namespace GeographicLib {
    * simple that the exact method should be used for such conversions and also
    * for conversions with with abs(\e f) &gt; 1/150.
    *
+   * The coefficients for the series method are all computed by the
+   * constructor.  Thus the const member functions do not modify the object
+   * and a single instance (e.g., AuxLatitude::WGS84()) may be used
+   * concurrently by several threads.
+   *
    * Example of use:
    * \include example-AuxLatitude.cpp
    **********************************************************************/
@@ -235,6 +240,37 @@ namespace GeographicLib {
      **********************************************************************/
     Math::real Convert(int auxin, int auxout, real zeta, bool exact = false)
       const;
+    /**
+     * Convert an array of auxiliary latitudes specified in degrees.
+     *
+     * @param[in] auxin an AuxLatitude::aux indicating the type of
+     *   auxiliary latitudes \e zeta.
+     * @param[in] auxout an AuxLatitude::aux indicating the type of
+     *   auxiliary latitudes \e eta.
+     * @param[in] n the number of latitudes.
+     * @param[in] zeta the input auxiliary latitudes in degrees.
+     * @param[out] eta the output auxiliary latitudes in degrees.
+     * @param[in] exact if true use the exact equations instead of the Taylor
+     *   series [default false].
+     *
+     * This gives the same results as Convert(int, int, real, bool) const
+     * for each element; the output array may coincide with the input array.
+     * With \e exact = false, the latitudes are processed in groups of
+     * AuxLatitude::lanes and the Fourier series for a group are summed
+     * together, so that each coefficient is loaded once per group and the
+     * compiler can vectorize the sums.  With \e exact = true, the
+     * conversions are done one at a time, because the number of iterations
+     * of Newton's method used by FromAuxiliary differs from one latitude to
+     * the next; for many exact conversions on a fixed ellipsoid, consider
+     * Ellipsoid::Tabulate.
+     **********************************************************************/
+    void Convert(int auxin, int auxout, size_t n,
+                 const real zeta[], real eta[], bool exact = false) const;
+    /**
+     * The number of latitudes handled together by the array version of
+     * Convert.
+     **********************************************************************/
+    static const int lanes = 8;
     /**
      * Convert geographic latitude to an auxiliary latitude \e eta.
      *
@@ -316,7 +352,7 @@ namespace GeographicLib {
     static const int Lmax = GEOGRAPHICLIB_AUXLATITUDE_ORDER;
     /**
      * A global instantiation of Ellipsoid with the parameters for the WGS84
-     * ellipsoid.
+     * ellipsoid.  See Geodesic::WGS84() for when this is constructed.
      **********************************************************************/
     static const AuxLatitude& WGS84();
   private:
@@ -374,7 +410,7 @@ namespace GeographicLib {
     // Ellipsoid parameters
     real _a, _b, _f, _fm1, _e2, _e2m1, _e12, _e12p1, _n, _e, _e1, _n2, _q;
     // To hold computed Fourier coefficients
-    mutable real _c[Lmax * AUXNUMBER * AUXNUMBER];
+    real _c[Lmax * AUXNUMBER * AUXNUMBER];
     // 1d index into AUXNUMBER x AUXNUMBER data
     static int ind(int auxout, int auxin) {
       return (auxout >= 0 && auxout < AUXNUMBER &&
@@ -390,7 +426,7 @@ namespace GeographicLib {
       return isinf(tphi) ? copysign(real(1), tphi) : tphi / sc(tphi);
     }
     // Populate [_c[Lmax * k], _c[Lmax * (k + 1)])
-    void fillcoeff(int auxin, int auxout, int k) const;
+    void fillcoeff(int auxin, int auxout, int k);
     // the function atanh(e * sphi)/e; works for e^2 = 0 and e^2 < 0
     real atanhee(real tphi) const;
     /// \endcond
@@ -73,6 +73,9 @@ namespace GeographicLib {
     GeodesicLine _meridian;
     real _sbet0, _cbet0;
     static const unsigned maxit_ = 10;
+    // Forward; the scale is only computed if wantrk is true.
+    void GenForward(real lat, real lon, bool wantrk,
+                    real& x, real& y, real& azi, real& rk) const;
 
   public:
 
@@ -146,6 +149,54 @@ namespace GeographicLib {
     void Reverse(real x, real y,
                  real& lat, real& lon, real& azi, real& rk) const;
 
+    /**
+     * Forward projection of many points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of \e n latitudes (degrees).
+     * @param[in] lon array of \e n longitudes (degrees).
+     * @param[out] x array of \e n eastings (meters).
+     * @param[out] y array of \e n northings (meters).
+     * @param[out] azi array of \e n azimuths of the easting direction
+     *   (degrees); this may be a null pointer.
+     * @param[out] rk array of \e n reciprocals of the azimuthal northing
+     *   scale; this may be a null pointer.
+     *
+     * Element \e i of the output arrays is set to the result of
+     * CassiniSoldner::Forward applied to element \e i of the input arrays;
+     * the results are bitwise identical.  If \e rk is a null pointer, the
+     * evaluation of the scale along the perpendicular geodesic is skipped.
+     * The input and output arrays must not overlap.  The routine does
+     * nothing if the origin has not been set.
+     **********************************************************************/
+    void Forward(size_t n, const real lat[], const real lon[],
+                 real x[], real y[],
+                 real azi[] = nullptr, real rk[] = nullptr) const;
+
+    /**
+     * Reverse projection of many points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] x array of \e n eastings (meters).
+     * @param[in] y array of \e n northings (meters).
+     * @param[out] lat array of \e n latitudes (degrees).
+     * @param[out] lon array of \e n longitudes (degrees).
+     * @param[out] azi array of \e n azimuths of the easting direction
+     *   (degrees); this may be a null pointer.
+     * @param[out] rk array of \e n reciprocals of the azimuthal northing
+     *   scale; this may be a null pointer.
+     *
+     * Element \e i of the output arrays is set to the result of
+     * CassiniSoldner::Reverse applied to element \e i of the input arrays;
+     * the results are bitwise identical.  The foot point on the central
+     * meridian is reused while \e y is unchanged, so it pays to order the
+     * points by rows.  The input and output arrays must not overlap.  The
+     * routine does nothing if the origin has not been set.
+     **********************************************************************/
+    void Reverse(size_t n, const real x[], const real y[],
+                 real lat[], real lon[],
+                 real azi[] = nullptr, real rk[] = nullptr) const;
+
     /**
      * CassiniSoldner::Forward without returning the azimuth and scale.
      **********************************************************************/
@@ -0,0 +1,325 @@
+/**
+ * \file CircleCache.hpp
+ * \brief Header for GeographicLib::GravityCircleCache and
+ *   GeographicLib::MagneticCircleCache classes
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_CIRCLECACHE_HPP)
+#define GEOGRAPHICLIB_CIRCLECACHE_HPP 1
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <GeographicLib/Constants.hpp>
+#include <GeographicLib/GravityCircle.hpp>
+#include <GeographicLib/MagneticCircle.hpp>
+
+#if defined(_MSC_VER)
+// Squelch warnings about dll vs std::list, std::map, and std::mutex
+#  pragma warning (push)
+#  pragma warning (disable: 4251)
+#endif
+
+namespace GeographicLib {
+
+  class MagneticModel;
+
+  /// \cond SKIP
+  /**
+   * \brief A bounded least-recently-used store of circle objects
+   *
+   * This is the common machinery for GravityCircleCache and
+   * MagneticCircleCache.  The key consists of three reals and an unsigned.
+   * The mutex guards the list and the map; the circles themselves are
+   * immutable and are handed out as shared pointers so that an eviction
+   * doesn't invalidate a circle that is still in use.
+   **********************************************************************/
+  template<class C>
+  class CircleLRU {
+  private:
+    typedef Math::real real;
+    typedef std::pair<std::pair<real, real>, std::pair<real, unsigned> > key;
+    typedef std::list<std::pair<key, std::shared_ptr<const C> > > list;
+    list _list;                 // most recently used at the front
+    std::map<key, typename list::iterator> _map;
+    size_t _maxsize;
+    unsigned long long _hits, _misses;
+    mutable std::mutex _lock;
+  public:
+    explicit CircleLRU(size_t maxsize)
+      : _maxsize(maxsize)
+      , _hits(0)
+      , _misses(0)
+    {}
+    static key Key(real x, real y, real z, unsigned k)
+    { return key(std::make_pair(x, y), std::make_pair(z, k)); }
+    std::shared_ptr<const C> Find(const key& k) {
+      std::lock_guard<std::mutex> guard(_lock);
+      auto p = _map.find(k);
+      if (p == _map.end()) {
+        ++_misses;
+        return std::shared_ptr<const C>();
+      }
+      ++_hits;
+      _list.splice(_list.begin(), _list, p->second);
+      return p->second->second;
+    }
+    std::shared_ptr<const C> Insert(const key& k,
+                                    const std::shared_ptr<const C>& c) {
+      std::lock_guard<std::mutex> guard(_lock);
+      if (_maxsize == 0) return c;
+      auto p = _map.find(k);
+      if (p != _map.end()) {
+        // Another thread inserted this circle while we were building ours
+        _list.splice(_list.begin(), _list, p->second);
+        return p->second->second;
+      }
+      _list.emplace_front(k, c);
+      _map[k] = _list.begin();
+      while (_list.size() > _maxsize) {
+        _map.erase(_list.back().first);
+        _list.pop_back();
+      }
+      return c;
+    }
+    void Clear() {
+      std::lock_guard<std::mutex> guard(_lock);
+      _list.clear(); _map.clear();
+      _hits = _misses = 0;
+    }
+    size_t Size() const
+    { std::lock_guard<std::mutex> guard(_lock); return _list.size(); }
+    size_t MaxSize() const { return _maxsize; }
+    // The memory used by the cached circles (which may also be held by the
+    // callers).
+    size_t Bytes() const {
+      std::lock_guard<std::mutex> guard(_lock);
+      size_t bytes = 0;
+      for (const auto& e : _list)
+        bytes += e.second->MemoryUsage();
+      return bytes;
+    }
+    unsigned long long Hits() const
+    { std::lock_guard<std::mutex> guard(_lock); return _hits; }
+    unsigned long long Misses() const
+    { std::lock_guard<std::mutex> guard(_lock); return _misses; }
+  };
+  /// \endcond
+
+  /**
+   * \brief A cache of GravityCircle objects
+   *
+   * Repeated calls to GravityModel::Circle at the same latitude and height
+   * (for example, when processing many ground tracks at a fixed altitude)
+   * each pay the O(<i>N</i><sup>2</sup>) cost of summing the coefficients
+   * into a CircularEngine.  GravityCircleCache holds the most recently used
+   * GravityCircle objects, keyed by the latitude, height, and capabilities,
+   * so that a repeated circle costs only O(\e N) per point.
+   *
+   * The latitude and height may optionally be quantized, in which case the
+   * circle is computed at the nearest multiple of the quantum (and not at
+   * the requested position).  With the default quanta of zero, the key is the
+   * exact latitude and height and the results are identical to those from
+   * GravityModel::Circle.
+   *
+   * The cache holds a reference to the GravityModel which must therefore
+   * outlive it.  All the member functions are thread safe; the circles are
+   * returned as shared pointers which remain valid after they are evicted
+   * from the cache.
+   *
+   * Example of use:
+   * \code
+   *   GravityModel grav("egm96");
+   *   GravityCircleCache cache(grav, 100);
+   *   for (...) {
+   *     auto circ = cache.Circle(lat, h, GravityModel::GRAVITY);
+   *     circ->Gravity(lon, gx, gy, gz);
+   *   }
+   * \endcode
+   **********************************************************************/
+  class GEOGRAPHICLIB_EXPORT GravityCircleCache {
+  private:
+    typedef Math::real real;
+    const GravityModel& _model;
+    real _dlat, _dh;
+    CircleLRU<GravityCircle> _cache;
+  public:
+
+    /**
+     * Constructor for a GravityCircleCache.
+     *
+     * @param[in] model the GravityModel used to compute the circles.
+     * @param[in] maxsize the maximum number of circles to retain (default
+     *   64); if this is 0, no circles are retained.
+     * @param[in] dlat the quantum for the latitude (degrees); if this is 0
+     *   (the default), the latitude is not quantized.
+     * @param[in] dh the quantum for the height (meters); if this is 0 (the
+     *   default), the height is not quantized.
+     * @exception GeographicErr if \e dlat or \e dh is negative or not
+     *   finite.
+     **********************************************************************/
+    GravityCircleCache(const GravityModel& model, size_t maxsize = 64,
+                       real dlat = 0, real dh = 0);
+
+    /**
+     * Return a GravityCircle from the cache, creating it if necessary.
+     *
+     * @param[in] lat latitude of the point (degrees).
+     * @param[in] h the height of the point above the ellipsoid (meters).
+     * @param[in] caps bitor'ed combination of GravityModel::mask values
+     *   specifying the capabilities of the resulting GravityCircle object.
+     * @exception std::bad_alloc if the memory for the GravityCircle can't be
+     *   allocated.
+     * @return a shared pointer to a GravityCircle as returned by
+     *   GravityModel::Circle(\e lat, \e h, \e caps) (with \e lat and \e h
+     *   quantized).
+     *
+     * A circle created with more capabilities is not used to satisfy a
+     * request with fewer capabilities; \e caps is part of the key.  A NaN
+     * latitude or height bypasses the cache.
+     **********************************************************************/
+    std::shared_ptr<const GravityCircle>
+    Circle(real lat, real h, unsigned caps = GravityModel::ALL);
+
+    /**
+     * Remove all the circles from the cache and reset the statistics.
+     **********************************************************************/
+    void Clear() { _cache.Clear(); }
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return the number of circles currently in the cache.
+     **********************************************************************/
+    size_t Size() const { return _cache.Size(); }
+
+    /**
+     * @return the maximum number of circles retained.
+     **********************************************************************/
+    size_t MaxSize() const { return _cache.MaxSize(); }
+
+    /**
+     * @return the memory (in bytes) used by the circles in the cache.
+     *
+     * This is bounded by MaxSize() times the size of the largest circle
+     * (the size of a circle depends on its capabilities).  A circle which
+     * has been evicted but is still held by a caller isn't counted.
+     **********************************************************************/
+    size_t MemoryUsage() const { return _cache.Bytes(); }
+
+    /**
+     * @return the number of calls to Circle satisfied from the cache.
+     **********************************************************************/
+    unsigned long long Hits() const { return _cache.Hits(); }
+
+    /**
+     * @return the number of calls to Circle which created a new circle.
+     **********************************************************************/
+    unsigned long long Misses() const { return _cache.Misses(); }
+    ///@}
+  };
+
+  /**
+   * \brief A cache of MagneticCircle objects
+   *
+   * This is the analog of GravityCircleCache for MagneticModel::Circle.  The
+   * key is the time, latitude, and height, each of which may optionally be
+   * quantized.  With the default quanta of zero, the results are identical to
+   * those from MagneticModel::Circle.
+   *
+   * The cache holds a reference to the MagneticModel which must therefore
+   * outlive it.  All the member functions are thread safe.
+   **********************************************************************/
+  class GEOGRAPHICLIB_EXPORT MagneticCircleCache {
+  private:
+    typedef Math::real real;
+    const MagneticModel& _model;
+    real _dt, _dlat, _dh;
+    CircleLRU<MagneticCircle> _cache;
+  public:
+
+    /**
+     * Constructor for a MagneticCircleCache.
+     *
+     * @param[in] model the MagneticModel used to compute the circles.
+     * @param[in] maxsize the maximum number of circles to retain (default
+     *   64); if this is 0, no circles are retained.
+     * @param[in] dt the quantum for the time (years); if this is 0 (the
+     *   default), the time is not quantized.
+     * @param[in] dlat the quantum for the latitude (degrees); if this is 0
+     *   (the default), the latitude is not quantized.
+     * @param[in] dh the quantum for the height (meters); if this is 0 (the
+     *   default), the height is not quantized.
+     * @exception GeographicErr if \e dt, \e dlat, or \e dh is negative or
+     *   not finite.
+     **********************************************************************/
+    MagneticCircleCache(const MagneticModel& model, size_t maxsize = 64,
+                        real dt = 0, real dlat = 0, real dh = 0);
+
+    /**
+     * Return a MagneticCircle from the cache, creating it if necessary.
+     *
+     * @param[in] t the time (years).
+     * @param[in] lat latitude of the point (degrees).
+     * @param[in] h the height of the point above the ellipsoid (meters).
+     * @exception std::bad_alloc if the memory for the MagneticCircle can't be
+     *   allocated.
+     * @return a shared pointer to a MagneticCircle as returned by
+     *   MagneticModel::Circle(\e t, \e lat, \e h) (with \e t, \e lat, and \e h
+     *   quantized).
+     **********************************************************************/
+    std::shared_ptr<const MagneticCircle> Circle(real t, real lat, real h);
+
+    /**
+     * Remove all the circles from the cache and reset the statistics.
+     **********************************************************************/
+    void Clear() { _cache.Clear(); }
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return the number of circles currently in the cache.
+     **********************************************************************/
+    size_t Size() const { return _cache.Size(); }
+
+    /**
+     * @return the maximum number of circles retained.
+     **********************************************************************/
+    size_t MaxSize() const { return _cache.MaxSize(); }
+
+    /**
+     * @return the memory (in bytes) used by the circles in the cache.
+     *
+     * This is bounded by MaxSize() times the size of the largest circle
+     * (the size of a circle depends on its capabilities).  A circle which
+     * has been evicted but is still held by a caller isn't counted.
+     **********************************************************************/
+    size_t MemoryUsage() const { return _cache.Bytes(); }
+
+    /**
+     * @return the number of calls to Circle satisfied from the cache.
+     **********************************************************************/
+    unsigned long long Hits() const { return _cache.Hits(); }
+
+    /**
+     * @return the number of calls to Circle which created a new circle.
+     **********************************************************************/
+    unsigned long long Misses() const { return _cache.Misses(); }
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#if defined(_MSC_VER)
+#  pragma warning (pop)
+#endif
+
+#endif  // GEOGRAPHICLIB_CIRCLECACHE_HPP
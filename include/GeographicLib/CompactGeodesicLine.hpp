@@ -0,0 +1,383 @@
+/**
+ * \file CompactGeodesicLine.hpp
+ * \brief Header for GeographicLib::CompactGeodesicLine class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_COMPACTGEODESICLINE_HPP)
+#define GEOGRAPHICLIB_COMPACTGEODESICLINE_HPP 1
+
+#include <GeographicLib/Constants.hpp>
+#include <GeographicLib/Geodesic.hpp>
+
+namespace GeographicLib {
+
+  /**
+   * \brief A geodesic line with capabilities fixed at compile time
+   *
+   * @tparam caps bitor'ed combination of Geodesic::mask values specifying
+   *   the capabilities of the line.
+   *
+   * This provides the core of GeodesicLine (the construction from a point
+   * and an azimuth and the calculation of positions) for a set of
+   * capabilities, \e caps, given as a template parameter.  Only the
+   * coefficients needed for \e caps are stored and the tests on the
+   * capabilities in GenPosition are resolved at compile time.  This is
+   * useful for holding large numbers of lines in memory; for example
+   * \code
+   *   typedef CompactGeodesicLine<Geodesic::LONGITUDE> track;
+   * \endcode
+   * is a quarter of the size of a GeodesicLine and supports
+   * CompactGeodesicLine::ArcPosition.  Add Geodesic::DISTANCE_IN to allow
+   * positions to be specified by distance.  The results are identical to
+   * those of a GeodesicLine with the same capabilities.
+   *
+   * Unlike GeodesicLine, this class does not handle exact geodesics (the
+   * constructor throws an exception if the Geodesic object was constructed
+   * with \e exact = true), nor does it hold a reference point 3.  The class is
+   * implemented entirely in the header file.
+   **********************************************************************/
+
+  template<unsigned caps>
+  class CompactGeodesicLine {
+  private:
+    typedef Math::real real;
+    static const unsigned caps_ =
+      caps | Geodesic::LATITUDE | Geodesic::AZIMUTH | Geodesic::LONG_UNROLL;
+    static const bool c1_ = (caps_ & Geodesic::CAP_C1) != 0;
+    static const bool c1p_ = (caps_ & Geodesic::CAP_C1p) != 0;
+    static const bool c2_ = (caps_ & Geodesic::CAP_C2) != 0;
+    static const bool c3_ = (caps_ & Geodesic::CAP_C3) != 0;
+    static const bool c4_ = (caps_ & Geodesic::CAP_C4) != 0;
+    static const int nC1_ = Geodesic::nC1_;
+    static const int nC1p_ = Geodesic::nC1p_;
+    static const int nC2_ = Geodesic::nC2_;
+    static const int nC3_ = Geodesic::nC3_;
+    static const int nC4_ = Geodesic::nC4_;
+
+    real _lat1, _lon1, _azi1;
+    real _b, _f, _f1, _salp0, _calp0, _k2, _salp1, _calp1,
+      _ssig1, _csig1, _dn1, _somg1, _comg1, _tiny;
+    int _order;
+    // The scalars for each series followed by its coefficients; a series
+    // which is not needed is given a single unused element.  As in
+    // GeodesicLine, the index zero elements of the coefficients for C1, C1p,
+    // C2 are unused.
+    //   _c1 = A1m1, B11, stau1, ctau1, C1a[0..nC1]
+    //   _c1p = C1pa[0..nC1p]
+    //   _c2 = A2m1, B21, C2a[0..nC2]
+    //   _c3 = A3c, B31, C3a[0..nC3-1]
+    //   _c4 = c2, A4, B41, C4a[0..nC4-1]
+    real _c1[c1_ ? nC1_ + 5 : 1], _c1p[c1p_ ? nC1p_ + 1 : 1],
+      _c2[c2_ ? nC2_ + 3 : 1], _c3[c3_ ? nC3_ + 2 : 1],
+      _c4[c4_ ? nC4_ + 3 : 1];
+
+  public:
+
+    /**
+     * Constructor for a geodesic line staring at latitude \e lat1, longitude
+     * \e lon1, and azimuth \e azi1 (all in degrees).
+     *
+     * @param[in] g A Geodesic object used to compute the necessary
+     *   information about the line.
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] azi1 azimuth at point 1 (degrees).
+     * @exception GeographicErr if \e g was constructed with \e exact = true.
+     *
+     * This is the same as GeodesicLine(\e g, \e lat1, \e lon1, \e azi1, \e
+     * caps).
+     **********************************************************************/
+    CompactGeodesicLine(const Geodesic& g, real lat1, real lon1, real azi1) {
+      using std::sqrt; using std::hypot; using std::fmax;
+      using std::sin; using std::cos;
+      if (g._exact)
+        throw GeographicErr("CompactGeodesicLine doesn't support "
+                            "exact geodesics");
+      _azi1 = Math::AngNormalize(azi1);
+      // Guard against underflow in salp0.  Also -0 is converted to +0.
+      Math::sincosd(Math::AngRound(_azi1), _salp1, _calp1);
+      _tiny = g.tiny_;
+      _lat1 = Math::LatFix(lat1);
+      _lon1 = lon1;
+      _b = g._b;
+      _f = g._f;
+      _f1 = g._f1;
+      _order = g._order;
+
+      // The rest of this follows GeodesicLine::LineInit
+      real cbet1, sbet1;
+      Math::sincosd(Math::AngRound(_lat1), sbet1, cbet1); sbet1 *= _f1;
+      // Ensure cbet1 = +epsilon at poles
+      Math::norm(sbet1, cbet1); cbet1 = fmax(_tiny, cbet1);
+      _dn1 = sqrt(1 + g._ep2 * Math::sq(sbet1));
+      _salp0 = _salp1 * cbet1;
+      _calp0 = hypot(_calp1, _salp1 * sbet1);
+      _ssig1 = sbet1; _somg1 = _salp0 * sbet1;
+      _csig1 = _comg1 = sbet1 != 0 || _calp1 != 0 ? cbet1 * _calp1 : 1;
+      Math::norm(_ssig1, _csig1); // sig1 in (-pi, pi]
+
+      _k2 = Math::sq(_calp0) * g._ep2;
+      real eps = _k2 / (2 * (1 + sqrt(1 + _k2)) + _k2);
+
+      if (c1_) {
+        _c1[0] = Geodesic::A1m1f(eps, _order);
+        Geodesic::C1f(eps, _c1 + 4, _order);
+        _c1[1] = Geodesic::SinCosSeries(true, _ssig1, _csig1, _c1 + 4,
+                                        _order);
+        real s = sin(_c1[1]), c = cos(_c1[1]);
+        // tau1 = sig1 + B11
+        _c1[2] = _ssig1 * c + _csig1 * s;
+        _c1[3] = _csig1 * c - _ssig1 * s;
+      }
+
+      if (c1p_)
+        Geodesic::C1pf(eps, _c1p, _order);
+
+      if (c2_) {
+        _c2[0] = Geodesic::A2m1f(eps, _order);
+        Geodesic::C2f(eps, _c2 + 2, _order);
+        _c2[1] = Geodesic::SinCosSeries(true, _ssig1, _csig1, _c2 + 2,
+                                        _order);
+      }
+
+      if (c3_) {
+        g.C3f(eps, _c3 + 2);
+        _c3[0] = -_f * _salp0 * g.A3f(eps);
+        _c3[1] = Geodesic::SinCosSeries(true, _ssig1, _csig1, _c3 + 2,
+                                        _order-1);
+      }
+
+      if (c4_) {
+        g.C4f(eps, _c4 + 3);
+        _c4[0] = g._c2;
+        // Multiplier = a^2 * e^2 * cos(alpha0) * sin(alpha0)
+        _c4[1] = Math::sq(g._a) * _calp0 * _salp0 * g._e2;
+        _c4[2] = Geodesic::SinCosSeries(false, _ssig1, _csig1, _c4 + 3,
+                                        _order);
+      }
+    }
+
+    /**
+     * The general position function.
+     *
+     * @param[in] arcmode boolean flag determining the meaning of the second
+     *   parameter.
+     * @param[in] s12_a12 if \e arcmode is false, this is the distance between
+     *   point 1 and point 2 (meters); otherwise it is the arc length between
+     *   point 1 and point 2 (degrees); it can be negative.
+     * @param[in] outmask a bitor'ed combination of Geodesic::mask values
+     *   specifying which of the following parameters should be set.
+     * @param[out] lat2 latitude of point 2 (degrees).
+     * @param[out] lon2 longitude of point 2 (degrees).
+     * @param[out] azi2 (forward) azimuth at point 2 (degrees).
+     * @param[out] s12 distance from point 1 to point 2 (meters).
+     * @param[out] m12 reduced length of geodesic (meters).
+     * @param[out] M12 geodesic scale of point 2 relative to point 1
+     *   (dimensionless).
+     * @param[out] M21 geodesic scale of point 1 relative to point 2
+     *   (dimensionless).
+     * @param[out] S12 area under the geodesic (meters<sup>2</sup>).
+     * @return \e a12 arc length from point 1 to point 2 (degrees).
+     *
+     * This behaves in the same way as GeodesicLine::GenPosition.  Requested
+     * quantities which are not included in \e caps are not set and NaN is
+     * returned if \e arcmode is false and \e caps doesn't include
+     * Geodesic::DISTANCE_IN.
+     **********************************************************************/
+    Math::real GenPosition(bool arcmode, real s12_a12, unsigned outmask,
+                           real& lat2, real& lon2, real& azi2,
+                           real& s12, real& m12, real& M12, real& M21,
+                           real& S12) const {
+      using std::fabs; using std::sin; using std::cos; using std::sqrt;
+      using std::hypot; using std::atan2; using std::copysign;
+      outmask &= caps_ & Geodesic::OUT_MASK;
+      if (!( arcmode || (caps_ & (Geodesic::OUT_MASK &
+                                  Geodesic::DISTANCE_IN)) ))
+        // Impossible distance calculation requested
+        return Math::NaN();
+
+      real sig12, ssig12, csig12, B12 = 0, AB1 = 0;
+      if (arcmode) {
+        // Interpret s12_a12 as spherical arc length
+        sig12 = s12_a12 * Math::degree();
+        Math::sincosd(s12_a12, ssig12, csig12);
+      } else {
+        // Interpret s12_a12 as distance
+        real
+          tau12 = s12_a12 / (_b * (1 + _c1[0])),
+          s = sin(tau12),
+          c = cos(tau12);
+        // tau2 = tau1 + tau12
+        B12 = - Geodesic::SinCosSeries(true,
+                                       _c1[2] * c + _c1[3] * s,
+                                       _c1[3] * c - _c1[2] * s,
+                                       _c1p, _order);
+        sig12 = tau12 - (B12 - _c1[1]);
+        ssig12 = sin(sig12); csig12 = cos(sig12);
+        if (fabs(_f) > 0.01) {
+          // Correct sig12 with 1 Newton iteration; see
+          // GeodesicLine::GenPosition.
+          real
+            ssig2 = _ssig1 * csig12 + _csig1 * ssig12,
+            csig2 = _csig1 * csig12 - _ssig1 * ssig12;
+          B12 = Geodesic::SinCosSeries(true, ssig2, csig2, _c1 + 4, _order);
+          real serr = (1 + _c1[0]) * (sig12 + (B12 - _c1[1])) - s12_a12 / _b;
+          sig12 = sig12 - serr / sqrt(1 + _k2 * Math::sq(ssig2));
+          ssig12 = sin(sig12); csig12 = cos(sig12);
+          // Update B12 below
+        }
+      }
+
+      real ssig2, csig2, sbet2, cbet2, salp2, calp2;
+      // sig2 = sig1 + sig12
+      ssig2 = _ssig1 * csig12 + _csig1 * ssig12;
+      csig2 = _csig1 * csig12 - _ssig1 * ssig12;
+      real dn2 = sqrt(1 + _k2 * Math::sq(ssig2));
+      if (outmask & (Geodesic::DISTANCE | Geodesic::REDUCEDLENGTH |
+                     Geodesic::GEODESICSCALE)) {
+        if (arcmode || fabs(_f) > 0.01)
+          B12 = Geodesic::SinCosSeries(true, ssig2, csig2, _c1 + 4, _order);
+        AB1 = (1 + _c1[0]) * (B12 - _c1[1]);
+      }
+      // sin(bet2) = cos(alp0) * sin(sig2)
+      sbet2 = _calp0 * ssig2;
+      cbet2 = hypot(_salp0, _calp0 * csig2);
+      if (cbet2 == 0)
+        // I.e., salp0 = 0, csig2 = 0.  Break the degeneracy in this case
+        cbet2 = csig2 = _tiny;
+      // tan(alp0) = cos(sig2)*tan(alp2)
+      salp2 = _salp0; calp2 = _calp0 * csig2; // No need to normalize
+
+      if (outmask & Geodesic::DISTANCE)
+        s12 = arcmode ? _b * ((1 + _c1[0]) * sig12 + AB1) : s12_a12;
+
+      if (outmask & Geodesic::LONGITUDE) {
+        // tan(omg2) = sin(alp0) * tan(sig2)
+        real somg2 = _salp0 * ssig2, comg2 = csig2,  // No need to normalize
+          E = copysign(real(1), _salp0);       // east-going?
+        // omg12 = omg2 - omg1
+        real omg12 = outmask & Geodesic::LONG_UNROLL
+          ? E * (sig12
+                 - (atan2(    ssig2, csig2) - atan2(    _ssig1, _csig1))
+                 + (atan2(E * somg2, comg2) - atan2(E * _somg1, _comg1)))
+          : atan2(somg2 * _comg1 - comg2 * _somg1,
+                  comg2 * _comg1 + somg2 * _somg1);
+        real lam12 = omg12 + _c3[0] *
+          ( sig12 + (Geodesic::SinCosSeries(true, ssig2, csig2, _c3 + 2,
+                                            _order-1)
+                     - _c3[1]));
+        real lon12 = lam12 / Math::degree();
+        lon2 = outmask & Geodesic::LONG_UNROLL ? _lon1 + lon12 :
+          Math::AngNormalize(Math::AngNormalize(_lon1) +
+                             Math::AngNormalize(lon12));
+      }
+
+      if (outmask & Geodesic::LATITUDE)
+        lat2 = Math::atan2d(sbet2, _f1 * cbet2);
+
+      if (outmask & Geodesic::AZIMUTH)
+        azi2 = Math::atan2d(salp2, calp2);
+
+      if (outmask & (Geodesic::REDUCEDLENGTH | Geodesic::GEODESICSCALE)) {
+        real
+          B22 = Geodesic::SinCosSeries(true, ssig2, csig2, _c2 + 2, _order),
+          AB2 = (1 + _c2[0]) * (B22 - _c2[1]),
+          J12 = (_c1[0] - _c2[0]) * sig12 + (AB1 - AB2);
+        if (outmask & Geodesic::REDUCEDLENGTH)
+          m12 = _b * ((dn2 * (_csig1 * ssig2) - _dn1 * (_ssig1 * csig2))
+                      - _csig1 * csig2 * J12);
+        if (outmask & Geodesic::GEODESICSCALE) {
+          real t = _k2 * (ssig2 - _ssig1) * (ssig2 + _ssig1) / (_dn1 + dn2);
+          M12 = csig12 + (t *  ssig2 -  csig2 * J12) * _ssig1 / _dn1;
+          M21 = csig12 - (t * _ssig1 - _csig1 * J12) *  ssig2 /  dn2;
+        }
+      }
+
+      if (outmask & Geodesic::AREA) {
+        real
+          B42 = Geodesic::SinCosSeries(false, ssig2, csig2, _c4 + 3, _order);
+        real salp12, calp12;
+        if (_calp0 == 0 || _salp0 == 0) {
+          // alp12 = alp2 - alp1, used in atan2 so no need to normalize
+          salp12 = salp2 * _calp1 - calp2 * _salp1;
+          calp12 = calp2 * _calp1 + salp2 * _salp1;
+        } else {
+          // See GeodesicLine::GenPosition
+          salp12 = _calp0 * _salp0 *
+            (csig12 <= 0 ? _csig1 * (1 - csig12) + ssig12 * _ssig1 :
+             ssig12 * (_csig1 * ssig12 / (1 + csig12) + _ssig1));
+          calp12 = Math::sq(_salp0) + Math::sq(_calp0) * _csig1 * csig2;
+        }
+        S12 = _c4[0] * atan2(salp12, calp12) + _c4[1] * (B42 - _c4[2]);
+      }
+
+      return arcmode ? s12_a12 : sig12 / Math::degree();
+    }
+
+    /**
+     * Compute the position of point 2 which is a distance \e s12 (meters)
+     * from point 1.
+     *
+     * @param[in] s12 distance from point 1 to point 2 (meters); it can be
+     *   negative.
+     * @param[out] lat2 latitude of point 2 (degrees).
+     * @param[out] lon2 longitude of point 2 (degrees); requires that \e caps
+     *   include Geodesic::LONGITUDE.
+     * @return \e a12 arc length from point 1 to point 2 (degrees); this is
+     *   NaN unless \e caps includes Geodesic::DISTANCE_IN.
+     **********************************************************************/
+    Math::real Position(real s12, real& lat2, real& lon2) const {
+      real t;
+      return GenPosition(false, s12, Geodesic::LATITUDE | Geodesic::LONGITUDE,
+                         lat2, lon2, t, t, t, t, t, t);
+    }
+
+    /**
+     * Compute the position of point 2 which is an arc length \e a12
+     * (degrees) from point 1.
+     *
+     * @param[in] a12 arc length from point 1 to point 2 (degrees); it can
+     *   be negative.
+     * @param[out] lat2 latitude of point 2 (degrees).
+     * @param[out] lon2 longitude of point 2 (degrees); requires that \e caps
+     *   include Geodesic::LONGITUDE.
+     **********************************************************************/
+    void ArcPosition(real a12, real& lat2, real& lon2) const {
+      real t;
+      GenPosition(true, a12, Geodesic::LATITUDE | Geodesic::LONGITUDE,
+                  lat2, lon2, t, t, t, t, t, t);
+    }
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return \e lat1 the latitude of point 1 (degrees).
+     **********************************************************************/
+    Math::real Latitude() const { return _lat1; }
+
+    /**
+     * @return \e lon1 the longitude of point 1 (degrees).
+     **********************************************************************/
+    Math::real Longitude() const { return _lon1; }
+
+    /**
+     * @return \e azi1 the azimuth (degrees) of the geodesic line at point 1.
+     **********************************************************************/
+    Math::real Azimuth() const { return _azi1; }
+
+    /**
+     * @return \e caps the computational capabilities that this object was
+     *   constructed with.  LATITUDE and AZIMUTH are always included.
+     **********************************************************************/
+    static unsigned Capabilities() { return caps_; }
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_COMPACTGEODESICLINE_HPP
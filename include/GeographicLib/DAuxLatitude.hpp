@@ -61,6 +61,33 @@ namespace GeographicLib {
      **********************************************************************/
     Math::real DConvert(int auxin, int auxout,
                         const AuxAngle& zeta1, const AuxAngle& zeta2) const;
+    /**
+     * The divided difference of one auxiliary latitude with respect to
+     * another for many pairs of latitudes.
+     *
+     * @param[in] auxin an AuxLatitude::aux indicating the type of
+     *   auxiliary latitude \e zeta.
+     * @param[in] auxout an AuxLatitude::aux indicating the type of
+     *   auxiliary latitude \e eta.
+     * @param[in] n the number of pairs.
+     * @param[in] zeta1y array of \e n \e y components of \e zeta1.
+     * @param[in] zeta1x array of \e n \e x components of \e zeta1.
+     * @param[in] zeta2y array of \e n \e y components of \e zeta2.
+     * @param[in] zeta2x array of \e n \e x components of \e zeta2.
+     * @param[out] D array of \e n divided differences.
+     *
+     * Element \e i of \e D is set to DConvert(auxin, auxout, zeta1, zeta2)
+     * const for the AuxAngle%s \e zeta1 = (\e zeta1y[\e i], \e
+     * zeta1x[\e i]) and \e zeta2 = (\e zeta2y[\e i], \e zeta2x[\e i]);
+     * the angles need not be normalized.  The pairs are processed in groups
+     * of AuxLatitude::lanes using the array version of DClenshaw.  The
+     * results are identical to those of the scalar version; \e D may not
+     * overlap the input arrays.
+     **********************************************************************/
+    void DConvert(int auxin, int auxout, size_t n,
+                  const real zeta1y[], const real zeta1x[],
+                  const real zeta2y[], const real zeta2x[],
+                  real D[]) const;
     /**
      * The divided difference of the parametric latitude with respect to the
      * geographic latitude.
@@ -127,6 +154,33 @@ namespace GeographicLib {
                                 real szeta1, real czeta1,
                                 real szeta2, real czeta2,
                                 const real c[], int K);
+    /**
+     * The divided difference of AuxLatitude::Clenshaw for many pairs of
+     * angles.
+     *
+     * @param[in] sinp if true sum the sine series, else sum the cosine series.
+     * @param[in] n the number of pairs.
+     * @param[in] Delta array of \e n values of \e Delta.
+     * @param[in] szeta1 array of \e n values of sin(\e zeta1).
+     * @param[in] czeta1 array of \e n values of cos(\e zeta1).
+     * @param[in] szeta2 array of \e n values of sin(\e zeta2).
+     * @param[in] czeta2 array of \e n values of cos(\e zeta2).
+     * @param[in] c the array of coefficients.
+     * @param[in] K the number of coefficients.
+     * @param[out] D array of \e n divided differences.
+     *
+     * Element \e i of \e D is set to the result of the scalar version of
+     * DClenshaw applied to element \e i of the input arrays.  The pairs are
+     * processed in groups of AuxLatitude::lanes and the sums for a group are
+     * carried out together, so that each coefficient is loaded once per
+     * group and the compiler can vectorize the recurrence.  The results are
+     * identical to those of the scalar version; \e D may coincide with one
+     * of the input arrays.
+     **********************************************************************/
+    static void DClenshaw(bool sinp, size_t n, const real Delta[],
+                          const real szeta1[], const real czeta1[],
+                          const real szeta2[], const real czeta2[],
+                          const real c[], int K, real D[]);
     /**
      * The divided difference of the isometric latitude with respect to the
      * conformal latitude.
@@ -148,6 +202,18 @@ namespace GeographicLib {
          (isinf(x) || isinf(y) ? std::numeric_limits<real>::infinity() :
           Dasinh(x, y) / Datan(x, y)));
     }
+    /**
+     * Dlam for many pairs of latitudes.
+     *
+     * @param[in] n the number of pairs.
+     * @param[in] x array of \e n values of tan(\e chi1).
+     * @param[in] y array of \e n values of tan(\e chi2).
+     * @param[out] D array of \e n divided differences.
+     *
+     * Element \e i of \e D is set to Dlam(\e x[\e i], \e y[\e i]); \e D
+     * may coincide with \e x or \e y.
+     **********************************************************************/
+    static void Dlam(size_t n, const real x[], const real y[], real D[]);
     // Dp0Dpsi in terms of chi
     /**
      * The divided difference of the spherical rhumb area term with respect to
@@ -170,6 +236,18 @@ namespace GeographicLib {
           (isinf(y) ? copysign(real(1), y) :
            Dasinh(h(x), h(y)) * Dh(x, y) / Dasinh(x, y))));
     }
+    /**
+     * Dp0Dpsi for many pairs of latitudes.
+     *
+     * @param[in] n the number of pairs.
+     * @param[in] x array of \e n values of tan(\e chi1).
+     * @param[in] y array of \e n values of tan(\e chi2).
+     * @param[out] D array of \e n divided differences.
+     *
+     * Element \e i of \e D is set to Dp0Dpsi(\e x[\e i], \e y[\e i]);
+     * \e D may coincide with \e x or \e y.
+     **********************************************************************/
+    static void Dp0Dpsi(size_t n, const real x[], const real y[], real D[]);
   protected:                    // so TestAux can access these functions
     /// \cond SKIP
     // (sn(y) - sn(x)) / (y - x)
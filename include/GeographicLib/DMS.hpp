@@ -99,6 +99,7 @@ namespace GeographicLib {
     static const char* const components_[3];
     static Math::real NumMatch(const std::string& s);
     static Math::real InternalDecode(const std::string& dmsa, flag& ind);
+    static bool DecodeDecimal(const std::string& dms, real& v);
     DMS() = delete;             // Disable constructor
 
   public:
@@ -232,6 +233,10 @@ namespace GeographicLib {
      * .
      * The codes with a leading zero byte, e.g., U+00b0, are accepted in their
      * UTF-8 coded form 0xc2 0xb0 and as a single byte 0xb0.
+     *
+     * A string consisting of just a decimal number, e.g., &minus;12.345,
+     * with no more than Math::digits10() digits is decoded directly without
+     * the processing described above; the result is the same.
      **********************************************************************/
     static Math::real Decode(const std::string& dms, flag& ind);
 
@@ -12,8 +12,10 @@
 
 #include <GeographicLib/Constants.hpp>
 
+#include <complex>
 #include <functional>
 #include <memory>
+#include <vector>
 
 /// \cond SKIP
 template<typename scalar_t>
@@ -58,6 +60,12 @@ namespace GeographicLib {
    * \note The FFTW package https://www.fftw.org/ can also be used.  However
    * this is a more complicated dependency, its CMake support is broken, and it
    * doesn't work with mpreals (GEOGRAPHICLIB_PRECISION = 5).
+   *
+   * The FFT plans (principally the table of twiddle factors) are cached and
+   * shared between all the DST objects with the same \e N; so constructing
+   * several objects with the same \e N, or resetting an object to a
+   * previously used \e N, is cheap.  The plans are held in a Registry (of
+   * up to 256 sizes), so that looking them up doesn't take a lock.
    **********************************************************************/
 
   class DST {
@@ -66,10 +74,17 @@ namespace GeographicLib {
     int _N;
     typedef kissfft<real> fft_t;
     std::shared_ptr<fft_t> _fft;
+    // Return the (possibly cached) FFT plan for a DST with N points
+    static std::shared_ptr<fft_t> plan(int N);
     // Implement DST-III (centerp = false) or DST-IV (centerp = true)
-    void fft_transform(real data[], real F[], bool centerp) const;
+    void fft_transform(real data[], real F[], bool centerp,
+                       std::complex<real> ctemp[],
+                       const std::complex<real> twist[]) const;
     // Add another N terms to F
-    void fft_transform2(real data[], real F[]) const;
+    void fft_transform2(real data[], real F[], std::complex<real> ctemp[],
+                        const std::complex<real> twist[]) const;
+    // The phase factors for the DST-IV
+    std::vector<std::complex<real>> twists() const;
   public:
     /**
      * Constructor specifying the number of points to use.
@@ -124,6 +139,44 @@ namespace GeographicLib {
     void GEOGRAPHICLIB_EXPORT refine(std::function<real(real)> f, real F[])
       const;
 
+    /**
+     * Determine first \e N terms in the Fourier series of several functions
+     *
+     * @param[in] M the number of functions.
+     * @param[in] f the function used for evaluation; f(&sigma;, \e y) sets
+     *   \e y[\e k], for \e k in [0, \e M), to the values of the \e M
+     *   functions at &sigma;.
+     * @param[out] F an array of \e M pointers; the first \e N coefficients
+     *   of the Fourier series of function \e k are written to \e F[\e k].
+     *
+     * This is equivalent to calling transform for each function in turn.
+     * However \e f is only called \e N times to evaluate all the functions,
+     * e.g., for the integrands of the same quantity on several ellipsoids,
+     * and the scratch space is shared between the transforms.
+     **********************************************************************/
+    void GEOGRAPHICLIB_EXPORT transform(int M,
+                                        std::function<void(real, real[])> f,
+                                        real* const F[]) const;
+
+    /**
+     * Refine the Fourier series of several functions
+     *
+     * @param[in] M the number of functions.
+     * @param[in] f the function used for evaluation; see the previous
+     *   function.
+     * @param[inout] F an array of \e M pointers to the transforms; on input
+     *   \e F[\e k] contains the first \e N coefficents of the series for
+     *   function \e k; on output it contains the first 2\e N coefficients.
+     *
+     * This is equivalent to calling refine for each function in turn, but,
+     * in addition to the savings for transform(int, std::function<void(real,
+     * real[])>, real* const[]) const, the phase factors for the DST-IV are
+     * only computed once.
+     **********************************************************************/
+    void GEOGRAPHICLIB_EXPORT refine(int M,
+                                     std::function<void(real, real[])> f,
+                                     real* const F[]) const;
+
     /**
      * Evaluate the Fourier sum given the sine and cosine of the angle
      *
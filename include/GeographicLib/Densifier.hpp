@@ -0,0 +1,154 @@
+/**
+ * \file Densifier.hpp
+ * \brief Header for GeographicLib::DensifierT class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_DENSIFIER_HPP)
+#define GEOGRAPHICLIB_DENSIFIER_HPP 1
+
+#include <functional>
+#include <vector>
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/GeodesicExact.hpp>
+#include <GeographicLib/Rhumb.hpp>
+
+namespace GeographicLib {
+
+  /**
+   * \brief Adaptive densification of polylines
+   *
+   * @tparam GeodType the geodesic class to use.
+   *
+   * This inserts points into the segments of a polyline so that, when the
+   * result is drawn with straight lines in a given projection, it follows
+   * the geodesics (or rhumb lines) joining the vertices to within a
+   * specified tolerance.  Each segment is bisected recursively: an interval
+   * is split if the projected position of its midpoint is further than the
+   * tolerance from the chord joining the projected ends of the interval.
+   * Only the midpoints are tested, so a curve which wiggles within one
+   * interval may be missed; this is not a problem for the smooth curves
+   * given by geodesics and rhumb lines with the usual projections.
+   *
+   * The projection is supplied as a function object which maps a latitude
+   * and longitude to \e x and \e y.  It should be continuous along each
+   * segment (e.g., there should be no cut in longitude); a segment which
+   * straddles a discontinuity is subdivided until the maximum depth is
+   * reached.  The longitudes passed to the projection and returned are those
+   * given by the Position functions of the line class and are in
+   * [&minus;180&deg;, 180&deg;] for geodesics.
+   *
+   * One line object is created for each segment and all the points on the
+   * segment are computed with it.  The segments may be processed in
+   * parallel by several threads; the results are still passed to the
+   * callback in order and on the calling thread.  The memory used is
+   * bounded by processing the segments in batches.
+   *
+   * This class may be used with \e GeodType = Geodesic, GeodesicExact, or
+   * Rhumb; the typedefs Densifier, DensifierExact, DensifierRhumb are
+   * provided for these cases.
+   *
+   * Example of use:
+   * \code
+   *   Densifier dens(Geodesic::WGS84());
+   *   std::vector<real> lats, lons;
+   *   dens.Densify(n, lat, lon, 100,
+   *                [](real la, real lo, real& x, real& y)
+   *                { x = lo * 111e3; y = la * 111e3; },
+   *                [&](size_t, real la, real lo)
+   *                { lats.push_back(la); lons.push_back(lo); });
+   * \endcode
+   **********************************************************************/
+
+  template<class GeodType = Geodesic>
+  class DensifierT {
+  private:
+    typedef Math::real real;
+    GeodType _earth;
+    int _maxdepth;
+
+  public:
+
+    /**
+     * The type of the projection, \e proj(\e lat, \e lon, \e x, \e y).
+     **********************************************************************/
+    typedef std::function<void(real, real, real&, real&)> projection;
+
+    /**
+     * The type of the callback, \e out(\e i, \e lat, \e lon), which receives
+     * the points of the densified polyline in order.  \e i is the index of
+     * the vertex at the start of the segment containing the point (or \e n
+     * &minus; 1 for the last vertex).
+     **********************************************************************/
+    typedef std::function<void(size_t, real, real)> callback;
+
+    /**
+     * Constructor for DensifierT.
+     *
+     * @param[in] earth the Geodesic object to use for geodesic calculations.
+     * @param[in] maxdepth the maximum depth of the bisection (default 12);
+     *   this limits the number of points inserted into a segment to
+     *   2<sup><i>maxdepth</i></sup> &minus; 1.
+     * @exception GeographicErr if \e maxdepth is not in [0, 30].
+     **********************************************************************/
+    explicit DensifierT(const GeodType& earth, int maxdepth = 12);
+
+    /**
+     * Densify a polyline.
+     *
+     * @param[in] n the number of vertices.
+     * @param[in] lat array of \e n latitudes of the vertices (degrees).
+     * @param[in] lon array of \e n longitudes of the vertices (degrees).
+     * @param[in] tol the tolerance for the deviation from the chords (in the
+     *   units of the projection).
+     * @param[in] proj the projection.
+     * @param[in] out the callback receiving the points.
+     * @param[in] nthreads the number of threads to use (default 1).
+     * @exception GeographicErr if \e tol is not positive.
+     * @exception any exception thrown by \e proj or \e out.
+     *
+     * The vertices of the polyline are passed to \e out unchanged, with the
+     * inserted points between them.  If \e nthreads &gt; 1, \e proj is called
+     * concurrently on several threads and so must be thread safe.
+     **********************************************************************/
+    void Densify(size_t n, const real lat[], const real lon[], real tol,
+                 const projection& proj, const callback& out,
+                 int nthreads = 1) const;
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return the maximum depth of the bisection.
+     **********************************************************************/
+    int MaxDepth() const { return _maxdepth; }
+    ///@}
+  };
+
+  /**
+   * @relates DensifierT
+   *
+   * Densification of polylines consisting of geodesics.
+   **********************************************************************/
+  typedef DensifierT<Geodesic> Densifier;
+
+  /**
+   * @relates DensifierT
+   *
+   * Densification of polylines consisting of exact geodesics.
+   **********************************************************************/
+  typedef DensifierT<GeodesicExact> DensifierExact;
+
+  /**
+   * @relates DensifierT
+   *
+   * Densification of polylines consisting of rhumb lines.
+   **********************************************************************/
+  typedef DensifierT<Rhumb> DensifierRhumb;
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_DENSIFIER_HPP
@@ -10,6 +10,7 @@
 #if !defined(GEOGRAPHICLIB_ELLIPSOID_HPP)
 #define GEOGRAPHICLIB_ELLIPSOID_HPP 1
 
+#include <vector>
 #include <GeographicLib/Constants.hpp>
 #include <GeographicLib/AuxLatitude.hpp>
 
@@ -24,6 +25,13 @@ namespace GeographicLib {
    * true so that the results are valid for arbitrary flattenings &minus;100 <
    * \e f < 99/100 (i.e., 1/100 < b/a < 100).
    *
+   * The latitude conversions have array versions which give the same results
+   * as the scalar versions applied to each element; the output array may
+   * coincide with the input array.  For many conversions with the same
+   * ellipsoid, Tabulate() replaces the conversions to and from the
+   * rectifying, conformal, and authalic latitudes with piecewise Chebyshev
+   * approximations.
+   *
    * Example of use:
    * \include example-Ellipsoid.cpp
    **********************************************************************/
@@ -36,6 +44,18 @@ namespace GeographicLib {
     real _a, _f,_b, _e2, _e12, _n;
     AuxLatitude _aux;
     real _rm, _c2;
+    // Piecewise Chebyshev tables set up by Tabulate for the conversions
+    // between phi and mu, chi, and xi (indexed by tabindex); _tabn = 0 if not
+    // in use.  Each contains the breakpoints of the pieces followed by _tabn
+    // coefficients for each piece.
+    int _tabn;
+    real _taberr;
+    std::vector<real> _tab[6];
+    static int tabindex(int auxin, int auxout);
+    real tabeval(const std::vector<real>& t, real zeta, size_t& i) const;
+    real convert(int auxin, int auxout, real zeta) const;
+    void convert(int auxin, int auxout,
+                 size_t n, const real zeta[], real eta[]) const;
 
   public:
     /** \name Constructor
@@ -306,6 +326,163 @@ namespace GeographicLib {
      * sphere &phi; = tan<sup>&minus;1</sup> sinh &psi;.
      **********************************************************************/
     Math::real InverseIsometricLatitude(real psi) const;
+
+    /**
+     * Switch to tabulated approximations for the conversions between the
+     * geographic latitude and the rectifying, conformal, and authalic
+     * latitudes.
+     *
+     * @param[in] tol the maximum error allowed in the tables (radians); the
+     *   default value, 0, is interpreted as 8&epsilon;.
+     * @exception GeographicErr if \e tol is too small.
+     *
+     * This is worthwhile when very many conversions are made with the same
+     * ellipsoid.  For each of the six conversions, the difference between
+     * the output and input latitudes &zeta; is written as &zeta;
+     * (&pi;/2 &minus; &zeta;) \e h(&zeta;) and \e h(&zeta;) is approximated
+     * by a piecewise Chebyshev polynomial on [0, &pi;/2]; the intervals are
+     * bisected until the error, measured at several points between the
+     * Chebyshev nodes, is less than \e tol.  The largest error found is
+     * returned by TabulationError().  Thereafter RectifyingLatitude,
+     * ConformalLatitude, AuthalicLatitude, their inverses, MeridianDistance,
+     * and InverseMeridianDistance (both the scalar and the array versions)
+     * use the tables; the conversions of &plusmn;90&deg; and 0 remain exact.
+     * The other conversions are unaffected because they are already cheap.
+     * The array versions start the search for the piece of the table
+     * containing each element at the piece used for the previous one, so
+     * sorted inputs, e.g., a dense profile along a meridian, are converted
+     * without any searching.
+     **********************************************************************/
+    void Tabulate(real tol = 0);
+
+    /**
+     * @return true if Tabulate() has been called.
+     **********************************************************************/
+    bool Tabulated() const { return _tabn > 0; }
+
+    /**
+     * @return the largest error (radians) found in the tables set up by
+     *   Tabulate() (0 if not tabulated).
+     **********************************************************************/
+    Math::real TabulationError() const { return _taberr; }
+    ///@}
+
+    /** \name Latitude conversion for arrays.
+     **********************************************************************/
+    ///@{
+
+    /**
+     * Array version of ParametricLatitude(real) const.
+     *
+     * @param[in] n the number of latitudes.
+     * @param[in] phi the geographic latitudes (degrees).
+     * @param[out] beta the parametric latitudes (degrees).
+     **********************************************************************/
+    void ParametricLatitude(size_t n, const real phi[], real beta[]) const;
+
+    /**
+     * Array version of InverseParametricLatitude(real) const.
+     *
+     * @param[in] n the number of latitudes.
+     * @param[in] beta the parametric latitudes (degrees).
+     * @param[out] phi the geographic latitudes (degrees).
+     **********************************************************************/
+    void InverseParametricLatitude(size_t n, const real beta[], real phi[])
+      const;
+
+    /**
+     * Array version of GeocentricLatitude(real) const.
+     *
+     * @param[in] n the number of latitudes.
+     * @param[in] phi the geographic latitudes (degrees).
+     * @param[out] theta the geocentric latitudes (degrees).
+     **********************************************************************/
+    void GeocentricLatitude(size_t n, const real phi[], real theta[]) const;
+
+    /**
+     * Array version of InverseGeocentricLatitude(real) const.
+     *
+     * @param[in] n the number of latitudes.
+     * @param[in] theta the geocentric latitudes (degrees).
+     * @param[out] phi the geographic latitudes (degrees).
+     **********************************************************************/
+    void InverseGeocentricLatitude(size_t n, const real theta[], real phi[])
+      const;
+
+    /**
+     * Array version of RectifyingLatitude(real) const.
+     *
+     * @param[in] n the number of latitudes.
+     * @param[in] phi the geographic latitudes (degrees).
+     * @param[out] mu the rectifying latitudes (degrees).
+     **********************************************************************/
+    void RectifyingLatitude(size_t n, const real phi[], real mu[]) const;
+
+    /**
+     * Array version of InverseRectifyingLatitude(real) const.
+     *
+     * @param[in] n the number of latitudes.
+     * @param[in] mu the rectifying latitudes (degrees).
+     * @param[out] phi the geographic latitudes (degrees).
+     **********************************************************************/
+    void InverseRectifyingLatitude(size_t n, const real mu[], real phi[])
+      const;
+
+    /**
+     * Array version of AuthalicLatitude(real) const.
+     *
+     * @param[in] n the number of latitudes.
+     * @param[in] phi the geographic latitudes (degrees).
+     * @param[out] xi the authalic latitudes (degrees).
+     **********************************************************************/
+    void AuthalicLatitude(size_t n, const real phi[], real xi[]) const;
+
+    /**
+     * Array version of InverseAuthalicLatitude(real) const.
+     *
+     * @param[in] n the number of latitudes.
+     * @param[in] xi the authalic latitudes (degrees).
+     * @param[out] phi the geographic latitudes (degrees).
+     **********************************************************************/
+    void InverseAuthalicLatitude(size_t n, const real xi[], real phi[]) const;
+
+    /**
+     * Array version of ConformalLatitude(real) const.
+     *
+     * @param[in] n the number of latitudes.
+     * @param[in] phi the geographic latitudes (degrees).
+     * @param[out] chi the conformal latitudes (degrees).
+     **********************************************************************/
+    void ConformalLatitude(size_t n, const real phi[], real chi[]) const;
+
+    /**
+     * Array version of InverseConformalLatitude(real) const.
+     *
+     * @param[in] n the number of latitudes.
+     * @param[in] chi the conformal latitudes (degrees).
+     * @param[out] phi the geographic latitudes (degrees).
+     **********************************************************************/
+    void InverseConformalLatitude(size_t n, const real chi[], real phi[])
+      const;
+
+    /**
+     * Array version of IsometricLatitude(real) const.
+     *
+     * @param[in] n the number of latitudes.
+     * @param[in] phi the geographic latitudes (degrees).
+     * @param[out] psi the isometric latitudes (degrees).
+     **********************************************************************/
+    void IsometricLatitude(size_t n, const real phi[], real psi[]) const;
+
+    /**
+     * Array version of InverseIsometricLatitude(real) const.
+     *
+     * @param[in] n the number of latitudes.
+     * @param[in] psi the isometric latitudes (degrees).
+     * @param[out] phi the geographic latitudes (degrees).
+     **********************************************************************/
+    void InverseIsometricLatitude(size_t n, const real psi[], real phi[])
+      const;
     ///@}
 
     /** \name Other quantities.
@@ -346,6 +523,40 @@ namespace GeographicLib {
      **********************************************************************/
     Math::real MeridianDistance(real phi) const;
 
+    /**
+     * @param[in] s the distance along a meridian between the equator and a
+     *   point (meters).
+     * @return &phi; the geographic latitude of the point (degrees).
+     *
+     * This is the inverse of MeridianDistance().  \e s must lie in the
+     * range [&minus;\e L, \e L], where \e L = QuarterMeridian(); NaN is
+     * returned if this condition does not hold.  A value of |\e s| which
+     * exceeds \e L only because of roundoff gives &plusmn;90&deg;.
+     **********************************************************************/
+    Math::real InverseMeridianDistance(real s) const;
+
+    /**
+     * Array version of MeridianDistance(real) const.
+     *
+     * @param[in] n the number of latitudes.
+     * @param[in] phi the geographic latitudes (degrees).
+     * @param[out] s the meridian distances (meters).
+     **********************************************************************/
+    void MeridianDistance(size_t n, const real phi[], real s[]) const;
+
+    /**
+     * Array version of InverseMeridianDistance(real) const.
+     *
+     * @param[in] n the number of distances.
+     * @param[in] s the meridian distances (meters).
+     * @param[out] phi the geographic latitudes (degrees).
+     *
+     * \e s and \e phi may be the same array.  This is particularly fast
+     * for the sorted distances of a linear-referencing system if Tabulate()
+     * has been called.
+     **********************************************************************/
+    void InverseMeridianDistance(size_t n, const real s[], real phi[]) const;
+
     /**
      * @param[in] phi the geographic latitude (degrees).
      * @return &rho; the meridional radius of curvature of the ellipsoid at
@@ -511,7 +722,7 @@ namespace GeographicLib {
 
     /**
      * A global instantiation of Ellipsoid with the parameters for the WGS84
-     * ellipsoid.
+     * ellipsoid.  See Geodesic::WGS84() for when this is constructed.
      **********************************************************************/
     static const Ellipsoid& WGS84();
   };
@@ -10,6 +10,8 @@
 #if !defined(GEOGRAPHICLIB_ELLIPTICFUNCTION_HPP)
 #define GEOGRAPHICLIB_ELLIPTICFUNCTION_HPP 1
 
+#include <atomic>
+#include <vector>
 #include <GeographicLib/Constants.hpp>
 
 namespace GeographicLib {
@@ -33,6 +35,15 @@ namespace GeographicLib {
    * Stegun call \e m = <i>k</i><sup>2</sup> the "parameter" and \e n =
    * &alpha;<sup>2</sup> the "characteristic".)
    *
+   * The constructor and Reset() compute the complete integrals \e K(\e k),
+   * \e E(\e k), and \e D(\e k).  The complete integrals of the third kind,
+   * &Pi;(&alpha;<sup>2</sup>, \e k), \e G(&alpha;<sup>2</sup>, \e k), and \e
+   * H(&alpha;<sup>2</sup>, \e k), are computed when first needed (by Pi(),
+   * G(), H(), or the incomplete integrals which use them); this saves the
+   * cost of evaluating RJ or RD for applications, such as
+   * TransverseMercatorExact, which don't use them.  This is done in a way
+   * which allows an object to be used by several threads at once.
+   *
    * In geodesic applications, it is convenient to separate the incomplete
    * integrals into secular and periodic components, e.g.,
    * \f[
@@ -66,7 +77,46 @@ namespace GeographicLib {
 
     enum { num_ = 13 }; // Max depth required for sncndn; probably 5 is enough.
     real _k2, _kp2, _alpha2, _alphap2, _eps;
-    real _kKc, _eEc, _dDc, _pPic, _gGc, _hHc;
+    real _kKc, _eEc, _dDc;
+    // The complete integrals of the third kind, Pi, G, and H, and rjc =
+    // RJ(0, kp2, 1, alphap2) (0 if alpha2 = 0) from which they are found.
+    // These are computed on first use.  state is 0 if they have not been
+    // computed, 1 while a thread is storing them, and 2 once they are set.
+    // Only the values which are set are copied.
+    class ThirdKind {
+    public:
+      std::atomic<int> state;
+      real pPic, gGc, hHc, rjc;
+      ThirdKind() : state(0), pPic(0), gGc(0), hHc(0), rjc(0) {}
+      ThirdKind(const ThirdKind& t) : ThirdKind() { *this = t; }
+      ThirdKind& operator=(const ThirdKind& t) {
+        if (this != &t) {
+          if (t.state.load(std::memory_order_acquire) == 2) {
+            pPic = t.pPic; gGc = t.gGc; hHc = t.hHc; rjc = t.rjc;
+            state.store(2, std::memory_order_relaxed);
+          } else
+            state.store(0, std::memory_order_relaxed);
+        }
+        return *this;
+      }
+    };
+    mutable ThirdKind _third;
+    // Compute the integrals of the third kind
+    void ThirdKindCalc(real& pPic, real& gGc, real& hHc, real& rjc) const;
+    // Return Pi, G, H, or rj (for i = 0, 1, 2, 3) computing and storing them
+    // if necessary.
+    real ThirdKindGet(int i) const;
+    // Piecewise Chebyshev table for E(phi) set up by Tabulate; _tabn = 0 if
+    // not in use.  This contains the breakpoints of the pieces followed by
+    // _tabn coefficients for each piece.
+    int _tabn;
+    real _taberr;
+    std::vector<real> _tabE;
+    static int TabOrder();
+    real TabEval(const std::vector<real>& t, real x) const;
+    template<class Exact, class Lin, class Wt>
+    real TabFit(Exact exact, Lin lin, Wt wt, real scale, real a, real b,
+                real tol, std::vector<real>& x, std::vector<real>& c) const;
   public:
     /** \name Constructor
      **********************************************************************/
@@ -147,6 +197,55 @@ namespace GeographicLib {
      **********************************************************************/
     void Reset(real k2, real alpha2, real kp2, real alphap2);
 
+    /**
+     * Change the modulus keeping the parameter.
+     *
+     * @param[in] k2 the new value of the square of the modulus
+     *   <i>k</i><sup>2</sup>.  <i>k</i><sup>2</sup> must lie in
+     *   (&minus;&infin;, 1].
+     * @param[in] kp2 the new value of the complementary modulus squared
+     *   <i>k'</i><sup>2</sup> = 1 &minus; <i>k</i><sup>2</sup>.  This must
+     *   lie in [0, &infin;).
+     * @exception GeographicErr if \e k2 or \e kp2 is out of its legal
+     *   range.
+     *
+     * This is equivalent to Reset(\e k2, alpha2(), \e kp2, alphap2()),
+     * except that, if <i>k</i><sup>2</sup> changes by a small enough
+     * amount, the complete integrals are updated by a first order Taylor
+     * step instead of being computed afresh with the Carlson functions.  The
+     * step is taken only if the change in <i>k</i><sup>2</sup> is less
+     * than &epsilon;<sup>1/2</sup>/8 times the smaller of
+     * <i>k'</i><sup>2</sup> (before and after), |<i>k</i><sup>2</sup>|, and
+     * |<i>k</i><sup>2</sup> &minus; &alpha;<sup>2</sup>|, so that the
+     * truncation error and the roundoff error in the derivatives are
+     * negligible.  This is useful when the modulus is adjusted by an
+     * iterative method, e.g., the Newton's method in GeodesicExact.
+     **********************************************************************/
+    void Update(real k2, real kp2);
+
+    /**
+     * Switch to a tabulated approximation for the incomplete integral of the
+     * second kind.
+     *
+     * @param[in] tol the maximum relative error allowed in the table; the
+     *   default value, 0, is interpreted as 8&epsilon;.
+     * @exception GeographicErr if <i>k</i><sup>2</sup> does not lie in
+     *   (&minus;&infin;, 1) or if \e tol is too small.
+     *
+     * This is worthwhile when very many evaluations are made with the same
+     * modulus.  The periodic part of \e E(&phi;, \e k) is approximated by a
+     * piecewise Chebyshev polynomial on [0, &pi;/2]; the intervals are
+     * bisected until the error, measured at several points between the
+     * Chebyshev nodes, is less than \e tol \e E(\e k).  The largest error
+     * found is returned by TabulationError().  Thereafter E(real, real, real)
+     * const, and the functions which call it, e.g., E(real) const, Ed(), and
+     * Einv(), use the table; this makes them about twice as fast.  The
+     * other integrals and sncndn() are unaffected because the table lookup
+     * is no faster than the direct methods.  The table is discarded by
+     * Reset().
+     **********************************************************************/
+    void Tabulate(real tol = 0);
+
     ///@}
 
     /** \name Inspector functions.
@@ -173,6 +272,17 @@ namespace GeographicLib {
      *   &alpha;<sup>2</sup>.
      **********************************************************************/
     Math::real alphap2() const { return _alphap2; }
+
+    /**
+     * @return true if Tabulate() has been called.
+     **********************************************************************/
+    bool Tabulated() const { return _tabn > 0; }
+
+    /**
+     * @return the largest relative error found in the table set up by
+     *   Tabulate() (0 if not tabulated).
+     **********************************************************************/
+    Math::real TabulationError() const { return _taberr; }
     ///@}
 
     /** \name Complete elliptic integrals.
@@ -235,7 +345,10 @@ namespace GeographicLib {
      *     \frac1{\sqrt{1-k^2\sin^2\phi}(1 - \alpha^2\sin^2\phi)}\,d\phi.
      * \f]
      **********************************************************************/
-    Math::real Pi() const { return _pPic; }
+    Math::real Pi() const {
+      return _third.state.load(std::memory_order_acquire) == 2 ?
+        _third.pPic : ThirdKindGet(0);
+    }
 
     /**
      * Legendre's complete geodesic longitude integral.
@@ -248,7 +361,10 @@ namespace GeographicLib {
      *     \frac{\sqrt{1-k^2\sin^2\phi}}{1 - \alpha^2\sin^2\phi}\,d\phi.
      * \f]
      **********************************************************************/
-    Math::real G() const { return _gGc; }
+    Math::real G() const {
+      return _third.state.load(std::memory_order_acquire) == 2 ?
+        _third.gGc : ThirdKindGet(1);
+    }
 
     /**
      * Cayley's complete geodesic longitude difference integral.
@@ -262,7 +378,10 @@ namespace GeographicLib {
      *     \,d\phi.
      * \f]
      **********************************************************************/
-    Math::real H() const { return _hHc; }
+    Math::real H() const {
+      return _third.state.load(std::memory_order_acquire) == 2 ?
+        _third.hHc : ThirdKindGet(2);
+    }
     ///@}
 
     /** \name Incomplete elliptic integrals.
@@ -0,0 +1,140 @@
+/**
+ * \file Executor.hpp
+ * \brief Header for GeographicLib::Executor class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_EXECUTOR_HPP)
+#define GEOGRAPHICLIB_EXECUTOR_HPP 1
+
+#include <functional>
+#include <GeographicLib/Constants.hpp>
+
+namespace GeographicLib {
+
+  /**
+   * \brief The interface used to run parallel work
+   *
+   * All the parallel features of GeographicLib (the functions with an \e
+   * nthreads argument, SphericalEngine::set_threads, etc.) hand their work
+   * to the Executor returned by Executor::Current.  By default, this is a
+   * pool of worker threads, Executor::Default, which is shared by the whole
+   * library; the threads are started when they are first needed and are
+   * reused for subsequent calls.  An application which already has its own
+   * scheduler can avoid oversubscribing the processors by supplying an
+   * Executor which delegates to it with Executor::Set.
+   *
+   * The work is presented as \e n tasks, \e task(\e i) for \e i in [0, \e
+   * n).  In the library, \e n is the requested number of threads and each
+   * task claims pieces of the work from a shared counter, so the results do
+   * not depend on how many tasks actually run concurrently.  The tasks may
+   * therefore be run in any order, with any degree of concurrency, including
+   * one after another on the calling thread.  The tasks never throw
+   * exceptions (any exception is caught and rethrown by the library on the
+   * calling thread) and any per-thread state they need, such as the
+   * precision set by Math::set_digits, is set by the tasks themselves, so
+   * they may run on any thread.  Tasks may call Run recursively.
+   *
+   * Here are adapters for OpenMP and Intel's oneTBB:
+   * \code
+   *   class OpenMPExecutor : public GeographicLib::Executor {
+   *   public:
+   *     void Run(int n, const std::function<void(int)>& task) override {
+   *   #pragma omp parallel for schedule(dynamic, 1)
+   *       for (int i = 0; i < n; ++i)
+   *         task(i);
+   *     }
+   *   };
+   *
+   *   class TBBExecutor : public GeographicLib::Executor {
+   *   public:
+   *     void Run(int n, const std::function<void(int)>& task) override {
+   *       tbb::parallel_for(0, n, [&](int i) { task(i); });
+   *     }
+   *   };
+   *
+   *   static TBBExecutor tbbexec;
+   *   GeographicLib::Executor::Set(&tbbexec);
+   * \endcode
+   **********************************************************************/
+  class GEOGRAPHICLIB_EXPORT Executor {
+  public:
+    virtual ~Executor() {}
+
+    /**
+     * Run a set of tasks.
+     *
+     * @param[in] n the number of tasks.
+     * @param[in] task the function object.
+     *
+     * This calls \e task(\e i) exactly once for each \e i in [0, \e n) and
+     * returns when all the calls have returned.  The calls may be made
+     * concurrently and in any order.  \e task does not throw exceptions.
+     * Implementations should not throw exceptions either; if threads are not
+     * available, the tasks should be run on the calling thread.
+     **********************************************************************/
+    virtual void Run(int n, const std::function<void(int)>& task) = 0;
+
+    /**
+     * Run a set of tasks which may throw exceptions on Current().
+     *
+     * @param[in] n the number of tasks.
+     * @param[in] task the function object.
+     * @param[in] stop a function object to call when a task throws.
+     * @exception any exception thrown by \e task.
+     *
+     * This is the wrapper for Run used by the library.  Each call of \e
+     * task(\e i) runs with the precision, Math::digits(), of the calling
+     * thread.  If a call throws, \e stop() is called (typically it exhausts
+     * the counter from which the tasks claim their work, so that the other
+     * tasks return early) and, once all the calls have returned, the
+     * exception from the lowest \e i is rethrown on the calling thread.
+     **********************************************************************/
+    static void RunGuarded(int n, const std::function<void(int)>& task,
+                           const std::function<void()>& stop);
+
+    /**
+     * @return the library's default Executor, a pool of threads.
+     *
+     * When Run is called with \e n tasks, the pool starts new threads, if
+     * necessary, so that \e n &minus; 1 of its threads are idle (the calling
+     * thread works on the tasks too).  Thus the number of threads is bounded
+     * by the largest number of tasks running at once, which is less than the
+     * \e nthreads requested of the library.  Idle threads wait without
+     * consuming processor time.
+     * The tasks are claimed with an atomic counter by the calling thread and
+     * the idle threads; since the calling thread runs any task which has not
+     * been claimed, recursive calls cannot deadlock.
+     **********************************************************************/
+    static Executor& Default();
+
+    /**
+     * @return an Executor which runs the tasks in order on the calling
+     *   thread.
+     **********************************************************************/
+    static Executor& Serial();
+
+    /**
+     * @return the Executor used by the library.
+     **********************************************************************/
+    static Executor& Current();
+
+    /**
+     * Set the Executor used by the library.
+     *
+     * @param[in] exec a pointer to the Executor; if it is null (the
+     *   default), use Executor::Default.
+     *
+     * \e exec must remain valid until it is replaced and until any parallel
+     * calls into the library which may use it have returned.  This should
+     * usually be called once at the start of the program.
+     **********************************************************************/
+    static void Set(Executor* exec = nullptr);
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_EXECUTOR_HPP
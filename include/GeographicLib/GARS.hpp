@@ -53,10 +53,18 @@ namespace GeographicLib {
     static constexpr int m_ = mult1_ * mult2_ * mult3_;
     static constexpr int maxprec_ = 2;
     static constexpr int maxlen_ = baselen_ + maxprec_;
+    static void GenReverse(const char* gars, int len, real& lat, real& lon,
+                           int& prec, bool centerp);
     GARS() = delete;            // Disable constructor
 
   public:
 
+    /**
+     * The size of a char array which can hold any GARS produced by the char
+     * array versions of Forward, including the terminating null.
+     **********************************************************************/
+    enum { MAXBUF = maxlen_ + 1 };
+
     /**
      * Convert from geographic coordinates to GARS.
      *
@@ -100,6 +108,76 @@ namespace GeographicLib {
     static void Reverse(const std::string& gars, real& lat, real& lon,
                         int& prec, bool centerp = true);
 
+    /**
+     * Convert from geographic coordinates to GARS in a char array.
+     *
+     * @param[in] lat latitude of point (degrees).
+     * @param[in] lon longitude of point (degrees).
+     * @param[in] prec the precision of the resulting GARS.
+     * @param[out] gars a char array of at least GARS::MAXBUF characters
+     *   which receives the null-terminated GARS.
+     * @exception GeographicErr if \e lat is not in [&minus;90&deg;,
+     *   90&deg;].
+     *
+     * This is the same as the version returning a std::string, except that
+     * no memory is allocated.
+     **********************************************************************/
+    static void Forward(real lat, real lon, int prec, char gars[]);
+
+    /**
+     * Convert many geographic coordinates to GARS.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of \e n latitudes (degrees).
+     * @param[in] lon array of \e n longitudes (degrees).
+     * @param[in] prec the precision of the resulting GARS.
+     * @param[out] gars a char array of \e n \e width characters; GARS
+     *   \e i is written null-terminated starting at gars[\e i \e width].
+     * @param[in] width the spacing of the strings in \e gars; this must
+     *   be at least 8.
+     * @exception GeographicErr if \e width is too small or if any latitude
+     *   is not in [&minus;90&deg;, 90&deg;].
+     **********************************************************************/
+    static void Forward(size_t n, const real lat[], const real lon[],
+                        int prec, char gars[], size_t width);
+
+    /**
+     * Convert from GARS given as a null-terminated char array to
+     * geographic coordinates.
+     *
+     * @param[in] gars the GARS.
+     * @param[out] lat latitude of point (degrees).
+     * @param[out] lon longitude of point (degrees).
+     * @param[out] prec the precision of \e gars.
+     * @param[in] centerp if true (the default) return the center of the
+     *   \e gars, otherwise return the south-west corner.
+     * @exception GeographicErr if \e gars is illegal.
+     *
+     * This is the same as the version taking a std::string, except that no
+     * memory is allocated unless an error is thrown.
+     **********************************************************************/
+    static void Reverse(const char* gars, real& lat, real& lon,
+                        int& prec, bool centerp = true);
+
+    /**
+     * Convert many GARS strings to geographic coordinates.
+     *
+     * @param[in] n the number of strings.
+     * @param[in] gars a char array of \e n \e width characters; string
+     *   \e i starts at gars[\e i \e width] and ends at the first null or
+     *   after \e width characters.
+     * @param[in] width the spacing of the strings in \e gars.
+     * @param[out] lat array of \e n latitudes (degrees).
+     * @param[out] lon array of \e n longitudes (degrees).
+     * @param[out] prec array of \e n precisions; this may be a null pointer.
+     * @param[in] centerp if true (the default) return the center of the
+     *   squares, otherwise return the south-west corners.
+     * @exception GeographicErr if any string is illegal.
+     **********************************************************************/
+    static void Reverse(size_t n, const char gars[], size_t width,
+                        real lat[], real lon[], int prec[] = nullptr,
+                        bool centerp = true);
+
     /**
      * The angular resolution of a GARS.
      *
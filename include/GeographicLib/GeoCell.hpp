@@ -0,0 +1,277 @@
+/**
+ * \file GeoCell.hpp
+ * \brief Header for GeographicLib::GeoCell class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_GEOCELL_HPP)
+#define GEOGRAPHICLIB_GEOCELL_HPP 1
+
+#include <vector>
+#include <GeographicLib/Constants.hpp>
+
+#if defined(_MSC_VER)
+// Squelch warnings about dll vs vector
+#  pragma warning (push)
+#  pragma warning (disable: 4251)
+#endif
+
+namespace GeographicLib {
+
+  /**
+   * \brief Integer identifiers for Geohash, GARS, and Georef cells
+   *
+   * The Geohash, GARS, and Georef classes convert between geographic
+   * coordinates and strings which identify cells in a hierarchy of grids in
+   * latitude and longitude.  This class identifies the same cells by 64-bit
+   * integers, allowing the cells to be manipulated (e.g., for spatial joins)
+   * without strings or floating-point round trips.  For a given scheme,
+   * - Forward gives the identifier of the cell containing a point;
+   * - Reverse gives the center or south-west corner of a cell;
+   * - Parent and Children move up and down the hierarchy;
+   * - Neighbors lists the adjacent cells;
+   * - Cover lists the cells which overlap a range of latitude and longitude.
+   * .
+   * Each of the grids at a given precision has \e nlon &times; \e nlat
+   * cells of equal size (in degrees) with the origin at latitude
+   * &minus;90&deg; and longitude &minus;180&deg;.  A point is assigned to
+   * the same cell as by the Forward function of the corresponding string
+   * class.
+   *
+   * An identifier consists of the level of the cell (its depth in the
+   * hierarchy) in the top 4 bits and a cell number in the low 60 bits.  The
+   * cell number is built from one digit per level, most significant first;
+   * thus the children of a cell have consecutive identifiers and sorting
+   * the identifiers at one level keeps each parent's children together.
+   * - For GeoCell::GEOHASH, the levels are the geohash lengths [0, 12] and
+   *   the cell number is the value returned by Geohash::Key.
+   * - For GeoCell::GARS, the levels are the GARS precisions [0, 2]; the
+   *   first digit gives the 30' cell, and the next two give the 15' and 5'
+   *   subdivisions.
+   * - For GeoCell::GEOREF, the levels 0, 1, 2, &hellip; 6 correspond to the
+   *   Georef precisions &minus;1, 0, 2, &hellip; 6 (15&deg;, 1&deg;, 1',
+   *   &hellip; 10<sup>&minus;4</sup>'); higher precisions can't be
+   *   represented in 64 bits.
+   * .
+   * For GARS and Georef, each digit is \e ilon &times; \e mlat + \e ilat,
+   * where \e mlon &times; \e mlat is the subdivision at that level and \e
+   * ilon and \e ilat are the indices of the subcell.  The identifier for
+   * invalid input (e.g., a NaN latitude), and the result of an operation on
+   * an invalid identifier, is ~0ULL.
+   *
+   * Example of use:
+   * \code
+   *   using namespace GeographicLib;
+   *   unsigned long long id =
+   *     GeoCell::Forward(GeoCell::GEOHASH, 57.64911, 10.40744, 6),
+   *     nbrs[8], first;
+   *   int n = GeoCell::Neighbors(GeoCell::GEOHASH, id, nbrs);
+   *   unsigned long long m = GeoCell::Children(GeoCell::GEOHASH, id, first);
+   *   double lat, lon; int prec;
+   *   GeoCell::Reverse(GeoCell::GEOHASH,
+   *                    GeoCell::Parent(GeoCell::GEOHASH, id), lat, lon, prec);
+   * \endcode
+   **********************************************************************/
+
+  class GEOGRAPHICLIB_EXPORT GeoCell {
+  private:
+    typedef Math::real real;
+    GeoCell() = delete;         // Disable constructor
+
+  public:
+    /**
+     * The cell schemes.
+     **********************************************************************/
+    enum scheme {
+      /**
+       * Geohash cells (see Geohash).
+       * @hideinitializer
+       **********************************************************************/
+      GEOHASH = 0,
+      /**
+       * Global Area Reference System cells (see GARS).
+       * @hideinitializer
+       **********************************************************************/
+      GARS = 1,
+      /**
+       * World Geographic Reference System cells (see Georef).
+       * @hideinitializer
+       **********************************************************************/
+      GEOREF = 2,
+    };
+
+    /**
+     * Find the cell containing a point.
+     *
+     * @param[in] s the GeoCell::scheme.
+     * @param[in] lat latitude of point (degrees).
+     * @param[in] lon longitude of point (degrees).
+     * @param[in] prec the precision of the cell, as for the Forward function
+     *   of the corresponding string class.
+     * @exception GeographicErr if \e lat is not in [&minus;90&deg;,
+     *   90&deg;].
+     * @return the identifier for the cell.
+     *
+     * Internally, \e prec is first put in the range [MinPrecision(\e s),
+     * MaxPrecision(\e s)] and, for Georef, \e prec = 1 is treated as 2 (as
+     * it is by Georef::Forward).  If \e lat or \e lon is NaN, the result is
+     * ~0ULL.
+     **********************************************************************/
+    static unsigned long long Forward(scheme s, real lat, real lon, int prec);
+
+    /**
+     * Find the cells containing many points.
+     *
+     * @param[in] s the GeoCell::scheme.
+     * @param[in] n the number of points.
+     * @param[in] lat array of \e n latitudes (degrees).
+     * @param[in] lon array of \e n longitudes (degrees).
+     * @param[in] prec the precision of the cells.
+     * @param[out] id array of \e n identifiers.
+     * @exception GeographicErr if any latitude is not in [&minus;90&deg;,
+     *   90&deg;].
+     **********************************************************************/
+    static void Forward(scheme s, size_t n, const real lat[], const real lon[],
+                        int prec, unsigned long long id[]);
+
+    /**
+     * Find the position of a cell.
+     *
+     * @param[in] s the GeoCell::scheme.
+     * @param[in] id the identifier for the cell.
+     * @param[out] lat latitude of the cell (degrees).
+     * @param[out] lon longitude of the cell (degrees).
+     * @param[out] prec the precision of the cell.
+     * @param[in] centerp if true (the default) return the center of the
+     *   cell, otherwise return the south-west corner.
+     *
+     * The results agree with those of the Reverse function of the
+     * corresponding string class (to roundoff for GARS and Georef).  If \e
+     * id is invalid, \e lat and \e lon are set to NaN and \e prec is
+     * unchanged.
+     **********************************************************************/
+    static void Reverse(scheme s, unsigned long long id,
+                        real& lat, real& lon, int& prec, bool centerp = true);
+
+    /**
+     * The precision of a cell.
+     *
+     * @param[in] s the GeoCell::scheme.
+     * @param[in] id the identifier for the cell.
+     * @return the precision of the cell; this is MinPrecision(\e s) &minus; 1
+     *   if \e id is invalid.
+     **********************************************************************/
+    static int Precision(scheme s, unsigned long long id);
+
+    /**
+     * The parent of a cell.
+     *
+     * @param[in] s the GeoCell::scheme.
+     * @param[in] id the identifier for the cell.
+     * @return the identifier for the cell at the next lower level which
+     *   contains \e id; this is ~0ULL if \e id is invalid or at level 0.
+     **********************************************************************/
+    static unsigned long long Parent(scheme s, unsigned long long id);
+
+    /**
+     * The children of a cell.
+     *
+     * @param[in] s the GeoCell::scheme.
+     * @param[in] id the identifier for the cell.
+     * @param[out] first the identifier for the first child.
+     * @return the number of children \e m; the identifiers of the children
+     *   are \e first, \e first + 1, &hellip;, \e first + \e m &minus; 1.
+     *
+     * The number of children is 0 if \e id is invalid or is at the highest
+     * level.  Otherwise, it is 32 for Geohash, 4 or 9 for GARS, and 225,
+     * 3600, or 100 for Georef.
+     **********************************************************************/
+    static unsigned long long Children(scheme s, unsigned long long id,
+                                       unsigned long long& first);
+
+    /**
+     * The neighbors of a cell.
+     *
+     * @param[in] s the GeoCell::scheme.
+     * @param[in] id the identifier for the cell.
+     * @param[out] nbrs an array of 8 identifiers.
+     * @return the number of neighbors.
+     *
+     * The neighbors are the cells at the same level which share an edge or a
+     * corner with \e id, listed from south to north and, within a row, from
+     * west to east.  The grid wraps around in longitude but not across the
+     * poles, so cells at the poles have 5 neighbors (fewer at the lowest
+     * levels, where the same cell may occur several times in the 3 &times;
+     * 3 block around \e id; duplicates are omitted).  The number of
+     * neighbors is 0 if \e id is invalid.
+     **********************************************************************/
+    static int Neighbors(scheme s, unsigned long long id,
+                         unsigned long long nbrs[8]);
+
+    /**
+     * The cells covering a range of latitude and longitude.
+     *
+     * @param[in] s the GeoCell::scheme.
+     * @param[in] latmin the southern boundary (degrees).
+     * @param[in] lonmin the western boundary (degrees).
+     * @param[in] latmax the northern boundary (degrees).
+     * @param[in] lonmax the eastern boundary (degrees).
+     * @param[in] prec the precision of the cells.
+     * @param[out] ids the identifiers of the cells, in increasing order.
+     * @exception GeographicErr if \e latmin or \e latmax is not in
+     *   [&minus;90&deg;, 90&deg;] or if \e latmin &gt; \e latmax.
+     * @exception std::bad_alloc if memory for \e ids can't be allocated.
+     *
+     * The range of longitude extends eastwards from \e lonmin to \e lonmax;
+     * it crosses the antimeridian if \e lonmax &lt; \e lonmin, and includes
+     * all longitudes if \e lonmax &minus; \e lonmin &ge; 360&deg;.  The cells
+     * are those which contain some point in the range, i.e., the cells
+     * between those returned by Forward for the corners.  Any previous
+     * contents of \e ids are discarded.  If any of the arguments is NaN, \e
+     * ids is empty.  The number of cells can be very large; check the size
+     * of the range against Resolution(\e s, \e prec) before calling this.
+     **********************************************************************/
+    static void Cover(scheme s, real latmin, real lonmin,
+                      real latmax, real lonmax, int prec,
+                      std::vector<unsigned long long>& ids);
+
+    /**
+     * The resolution of the cells.
+     *
+     * @param[in] s the GeoCell::scheme.
+     * @param[in] prec the precision of the cells.
+     * @param[out] latres the latitude size of the cells (degrees).
+     * @param[out] lonres the longitude size of the cells (degrees).
+     *
+     * Internally, \e prec is first put in the range [MinPrecision(\e s),
+     * MaxPrecision(\e s)].
+     **********************************************************************/
+    static void Resolution(scheme s, int prec, real& latres, real& lonres);
+
+    /**
+     * @param[in] s the GeoCell::scheme.
+     * @return the minimum precision of the cells (0 for Geohash and GARS,
+     *   &minus;1 for Georef).
+     **********************************************************************/
+    static int MinPrecision(scheme s) { return s == GEOREF ? -1 : 0; }
+
+    /**
+     * @param[in] s the GeoCell::scheme.
+     * @return the maximum precision of the cells which can be represented
+     *   (12 for Geohash, 2 for GARS, and 6 for Georef).
+     **********************************************************************/
+    static int MaxPrecision(scheme s)
+    { return s == GEOHASH ? 12 : (s == GARS ? 2 : 6); }
+
+  };
+
+} // namespace GeographicLib
+
+#if defined(_MSC_VER)
+#  pragma warning (pop)
+#endif
+
+#endif  // GEOGRAPHICLIB_GEOCELL_HPP
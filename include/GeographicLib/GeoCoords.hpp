@@ -31,6 +31,11 @@ namespace GeographicLib {
    *
    * The mutable state consists of the UTM or UPS coordinates for a alternate
    * zone.  A method SetAltZone is provided to set the alternate UPS/UTM zone.
+   * If the object is initialized from a string giving the latitude and
+   * longitude, the UTM/UPS coordinates are only computed when they are first
+   * needed (so that, e.g., converting geographic coordinates to DMS does no
+   * projection); this is part of the mutable state too.  A const GeoCoords
+   * object should therefore not be used by several threads at once.
    *
    * Methods are provided to return the geographic coordinates, the input UTM
    * or UPS coordinates (and associated meridian convergence and scale), or
@@ -49,12 +54,23 @@ namespace GeographicLib {
   class GEOGRAPHICLIB_EXPORT GeoCoords {
   private:
     typedef Math::real real;
-    real _lat, _long, _easting, _northing, _gamma, _k;
-    bool _northp;
-    int _zone;                  // See UTMUPS::zonespec
+    real _lat, _long;
+    // The UTM/UPS coordinates are valid if _utm is true; otherwise they are
+    // found by UTM() from _lat and _long using the standard zone.
+    mutable real _easting, _northing, _gamma, _k;
+    mutable bool _northp, _utm;
+    mutable int _zone;          // See UTMUPS::zonespec
     mutable real _alt_easting, _alt_northing, _alt_gamma, _alt_k;
     mutable int _alt_zone;
 
+    void UTM() const {
+      if (_utm) return;
+      UTMUPS::Forward(_lat, _long,
+                      _zone, _northp, _easting, _northing, _gamma, _k);
+      _utm = true;
+      CopyToAlt();
+    }
+
     void CopyToAlt() const {
       _alt_easting = _easting;
       _alt_northing = _northing;
@@ -82,6 +98,7 @@ namespace GeographicLib {
       , _gamma(Math::NaN())
       , _k(Math::NaN())
       , _northp(false)
+      , _utm(true)
       , _zone(UTMUPS::INVALID)
     { CopyToAlt(); }
 
@@ -241,6 +258,7 @@ namespace GeographicLib {
                       zone);
       _lat = latitude;
       _long = Math::AngNormalize(longitude);
+      _utm = true;
       CopyToAlt();
     }
 
@@ -262,6 +280,7 @@ namespace GeographicLib {
       _northp = northp;
       _easting = easting;
       _northing = northing;
+      _utm = true;
       FixHemisphere();
       CopyToAlt();
     }
@@ -283,37 +302,37 @@ namespace GeographicLib {
     /**
      * @return easting (meters)
      **********************************************************************/
-    Math::real Easting() const { return _easting; }
+    Math::real Easting() const { UTM(); return _easting; }
 
     /**
      * @return northing (meters)
      **********************************************************************/
-    Math::real Northing() const { return _northing; }
+    Math::real Northing() const { UTM(); return _northing; }
 
     /**
      * @return meridian convergence (degrees) for the UTM/UPS projection.
      **********************************************************************/
-    Math::real Convergence() const { return _gamma; }
+    Math::real Convergence() const { UTM(); return _gamma; }
 
     /**
      * @return scale for the UTM/UPS projection.
      **********************************************************************/
-    Math::real Scale() const { return _k; }
+    Math::real Scale() const { UTM(); return _k; }
 
     /**
      * @return hemisphere (false means south, true means north).
      **********************************************************************/
-    bool Northp() const { return _northp; }
+    bool Northp() const { UTM(); return _northp; }
 
     /**
      * @return hemisphere letter n or s.
      **********************************************************************/
-    char Hemisphere() const { return _northp ? 'n' : 's'; }
+    char Hemisphere() const { UTM(); return _northp ? 'n' : 's'; }
 
     /**
      * @return the zone corresponding to the input (return 0 for UPS).
      **********************************************************************/
-    int Zone() const { return _zone; }
+    int Zone() const { UTM(); return _zone; }
 
     ///@}
 
@@ -335,6 +354,7 @@ namespace GeographicLib {
     void SetAltZone(int zone = UTMUPS::STANDARD) const {
       if (zone == UTMUPS::MATCH)
         return;
+      UTM();
       zone = UTMUPS::StandardZone(_lat, _long, zone);
       if (zone == _zone)
         CopyToAlt();
@@ -350,27 +370,27 @@ namespace GeographicLib {
     /**
      * @return current alternate zone (return 0 for UPS).
      **********************************************************************/
-    int AltZone() const { return _alt_zone; }
+    int AltZone() const { UTM(); return _alt_zone; }
 
     /**
      * @return easting (meters) for alternate zone.
      **********************************************************************/
-    Math::real AltEasting() const { return _alt_easting; }
+    Math::real AltEasting() const { UTM(); return _alt_easting; }
 
     /**
      * @return northing (meters) for alternate zone.
      **********************************************************************/
-    Math::real AltNorthing() const { return _alt_northing; }
+    Math::real AltNorthing() const { UTM(); return _alt_northing; }
 
     /**
      * @return meridian convergence (degrees) for alternate zone.
      **********************************************************************/
-    Math::real AltConvergence() const { return _alt_gamma; }
+    Math::real AltConvergence() const { UTM(); return _alt_gamma; }
 
     /**
      * @return scale for alternate zone.
      **********************************************************************/
-    Math::real AltScale() const { return _alt_k; }
+    Math::real AltScale() const { UTM(); return _alt_k; }
     ///@}
 
     /** \name String representations of the GeoCoords object
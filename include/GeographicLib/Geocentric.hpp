@@ -62,12 +62,19 @@ namespace GeographicLib {
    *
    * <a href="CartConvert.1.html">CartConvert</a> is a command-line utility
    * providing access to the functionality of Geocentric and LocalCartesian.
+   *
+   * The class is a template on the floating point type \e T.  It is
+   * instantiated for float, double, long double (if this is distinct from
+   * double), and Math::real.  Geocentric is the version using Math::real.
+   *
+   * @tparam T the floating point type.
    **********************************************************************/
 
-  class GEOGRAPHICLIB_EXPORT Geocentric {
+  template<typename T>
+  class GEOGRAPHICLIB_EXPORT GeocentricT {
   private:
-    typedef Math::real real;
-    friend class LocalCartesian;
+    typedef T real;
+    template<typename U> friend class LocalCartesianT;
     friend class MagneticCircle; // MagneticCircle uses Rotation
     friend class MagneticModel;  // MagneticModel uses IntForward
     friend class GravityCircle;  // GravityCircle uses Rotation
@@ -110,12 +117,12 @@ namespace GeographicLib {
      * @exception GeographicErr if \e a or (1 &minus; \e f) \e a is not
      *   positive.
      **********************************************************************/
-    Geocentric(real a, real f);
+    GeocentricT(real a, real f);
 
     /**
      * A default constructor (for use by NormalGravity).
      **********************************************************************/
-    Geocentric() : _a(-1) {}
+    GeocentricT() : _a(-1) {}
 
     /**
      * Convert from geodetic to geocentric coordinates.
@@ -234,6 +241,48 @@ namespace GeographicLib {
         IntReverse(X, Y, Z, lat, lon, h, NULL);
     }
 
+    /**
+     * Convert many points from geodetic to geocentric coordinates.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of \e n latitudes (degrees).
+     * @param[in] lon array of \e n longitudes (degrees).
+     * @param[in] h array of \e n heights above the ellipsoid (meters).
+     * @param[out] X array of \e n geocentric coordinates (meters).
+     * @param[out] Y array of \e n geocentric coordinates (meters).
+     * @param[out] Z array of \e n geocentric coordinates (meters).
+     * @param[out] M array of 9\e n values; if this is not a null pointer,
+     *   the rotation matrix for point \e i is stored in row-major order in
+     *   elements 9\e i through 9\e i + 8.
+     *
+     * The results are bitwise identical to calling the scalar Forward for
+     * each point.  The rotation matrices are only computed if \e M is not a
+     * null pointer.  The input and output arrays must not overlap.
+     **********************************************************************/
+    void Forward(size_t n, const real lat[], const real lon[], const real h[],
+                 real X[], real Y[], real Z[], real M[] = nullptr) const;
+
+    /**
+     * Convert many points from geocentric to geodetic coordinates.
+     *
+     * @param[in] n the number of points.
+     * @param[in] X array of \e n geocentric coordinates (meters).
+     * @param[in] Y array of \e n geocentric coordinates (meters).
+     * @param[in] Z array of \e n geocentric coordinates (meters).
+     * @param[out] lat array of \e n latitudes (degrees).
+     * @param[out] lon array of \e n longitudes (degrees).
+     * @param[out] h array of \e n heights above the ellipsoid (meters).
+     * @param[out] M array of 9\e n values; if this is not a null pointer,
+     *   the rotation matrix for point \e i is stored in row-major order in
+     *   elements 9\e i through 9\e i + 8.
+     *
+     * The results are bitwise identical to calling the scalar Reverse for
+     * each point.  The rotation matrices are only computed if \e M is not a
+     * null pointer.  The input and output arrays must not overlap.
+     **********************************************************************/
+    void Reverse(size_t n, const real X[], const real Y[], const real Z[],
+                 real lat[], real lon[], real h[], real M[] = nullptr) const;
+
     /** \name Inspector functions
      **********************************************************************/
     ///@{
@@ -245,24 +294,41 @@ namespace GeographicLib {
      * @return \e a the equatorial radius of the ellipsoid (meters).  This is
      *   the value used in the constructor.
      **********************************************************************/
-    Math::real EquatorialRadius() const
-    { return Init() ? _a : Math::NaN(); }
+    real EquatorialRadius() const
+    { return Init() ? _a : Math::NaN<real>(); }
 
     /**
      * @return \e f the  flattening of the ellipsoid.  This is the
      *   value used in the constructor.
      **********************************************************************/
-    Math::real Flattening() const
-    { return Init() ? _f : Math::NaN(); }
+    real Flattening() const
+    { return Init() ? _f : Math::NaN<real>(); }
     ///@}
 
     /**
      * A global instantiation of Geocentric with the parameters for the WGS84
-     * ellipsoid.
+     * ellipsoid.  See Geodesic::WGS84() for when this is constructed.
      **********************************************************************/
-    static const Geocentric& WGS84();
+    static const GeocentricT& WGS84();
   };
 
+  /**
+   * The Geocentric class using Math::real.
+   **********************************************************************/
+  typedef GeocentricT<Math::real> Geocentric;
+
+  /// \cond SKIP
+  // The instantiations are in Geocentric.cpp
+  extern template class GeocentricT<float>;
+  extern template class GeocentricT<double>;
+#if GEOGRAPHICLIB_HAVE_LONG_DOUBLE
+  extern template class GeocentricT<long double>;
+#endif
+#if GEOGRAPHICLIB_PRECISION > 3
+  extern template class GeocentricT<Math::real>;
+#endif
+  /// \endcond
+
 } // namespace GeographicLib
 
 #endif  // GEOGRAPHICLIB_GEOCENTRIC_HPP
@@ -24,9 +24,56 @@
     (GEOGRAPHICLIB_PRECISION == 3 ? 7 : 8)))
 #endif
 
+#if !defined(GEOGRAPHICLIB_GEODESIC_STATS)
+/**
+ * Whether Geodesic collects statistics on the inverse calculation.  This is
+ * set by the cmake option of the same name.  See Geodesic::GetStats.
+ **********************************************************************/
+#  define GEOGRAPHICLIB_GEODESIC_STATS 0
+#endif
+
 namespace GeographicLib {
 
   class GeodesicLine;
+  class GeodesicKernel;
+  class GeodesicOrigin;
+  template<unsigned caps> class CompactGeodesicLine;
+
+  /**
+   * \brief The parameters of a Geodesic object
+   *
+   * This holds the parameters of the ellipsoid, the thresholds, and the
+   * coefficients of the series used by Geodesic.  It is a plain struct with
+   * no constructors and no pointers, so that it can be copied with memcpy
+   * (e.g., to a GPU with cudaMemcpy) and passed by value to a kernel.  It is
+   * returned by GeodesicKernel::Coefficients and its members shouldn't be
+   * altered.  Geodesic derives from this struct, so the calculations in
+   * GeodesicKernel are those made by Geodesic.
+   **********************************************************************/
+  struct GEOGRAPHICLIB_EXPORT GeodesicCoeffs {
+    /// \cond SKIP
+    typedef Math::real real;
+    static const int N_ = GEOGRAPHICLIB_GEODESIC_ORDER;
+    static const unsigned maxit1_ = 20;
+    unsigned maxit2_;
+    real tiny_, tol0_, tol1_, tol2_, tolb_, xthresh_;
+    real _a, _f;
+    bool _exact;
+    int _order;
+    real _f1, _e2, _ep2, _n, _b, _c2, _etol2, _stol2;
+    // The coefficients for A3f, C3f, and C4f
+    real _aA3x[N_], _cC3x[(N_ * (N_ - 1)) / 2], _cC4x[(N_ * (N_ + 1)) / 2];
+    // Copies of the static coefficients for A1m1f, C1f, C1pf, A2m1f, and C2f
+    real _aA1m1x[N_/2 + 2], _cC1x[(N_*N_ + 7*N_ - 2*(N_/2)) / 4],
+      _cC1px[(N_*N_ + 7*N_ - 2*(N_/2)) / 4], _aA2m1x[N_/2 + 2],
+      _cC2x[(N_*N_ + 7*N_ - 2*(N_/2)) / 4];
+#if GEOGRAPHICLIB_PRECISION > 3
+    // Double precision copies of the coefficients for
+    // GeodesicKernel::DoubleStart
+    double _aA3xd[N_], _cC3xd[(N_ * (N_ - 1)) / 2];
+#endif
+    /// \endcond
+  };
 
   /**
    * \brief %Geodesic calculations
@@ -152,6 +199,13 @@ namespace GeographicLib {
    * For very eccentric ellipsoids, set \e exact to true in the constructor;
    * this will delegate the calculations to the GeodesicExact class.
    *
+   * If the library is compiled with GEOGRAPHICLIB_PRECISION = 4 or 5 (quad
+   * or arbitrary precision), the Newton iteration for the inverse problem is
+   * started with doubles; the iteration with the full precision then only
+   * needs two or three steps.  For WGS84 this reduces the time for an
+   * inverse calculation with quad precision by about a third.  The results
+   * are unchanged, apart from roundoff.
+   *
    * The algorithms are described in
    * - C. F. F. Karney,
    *   <a href="https://doi.org/10.1007/s00190-012-0578-z">
@@ -172,10 +226,14 @@ namespace GeographicLib {
    * providing access to the functionality of Geodesic and GeodesicLine.
    **********************************************************************/
 
-  class GEOGRAPHICLIB_EXPORT Geodesic {
+  class GEOGRAPHICLIB_EXPORT Geodesic : private GeodesicCoeffs {
   private:
     typedef Math::real real;
     friend class GeodesicLine;
+    friend class GeodesicKernel;
+    friend class GeodesicOrigin;
+    friend class GeodesicTrack;
+    template<unsigned caps> friend class CompactGeodesicLine;
     static const int nA1_ = GEOGRAPHICLIB_GEODESIC_ORDER;
     static const int nC1_ = GEOGRAPHICLIB_GEODESIC_ORDER;
     static const int nC1p_ = GEOGRAPHICLIB_GEODESIC_ORDER;
@@ -190,9 +248,6 @@ namespace GeographicLib {
     // Size for temporary array
     // nC = max(max(nC1_, nC1p_, nC2_) + 1, max(nC3_, nC4_))
     static const int nC_ = GEOGRAPHICLIB_GEODESIC_ORDER + 1;
-    static const unsigned maxit1_ = 20;
-    unsigned maxit2_;
-    real tiny_, tol0_, tol1_, tol2_, tolb_, xthresh_;
 
     static constexpr unsigned CAP_NONE = 0U;
     static constexpr unsigned CAP_C1   = 1U<<0;
@@ -203,49 +258,62 @@ namespace GeographicLib {
     static constexpr unsigned CAP_ALL  = 0x1FU;
     static constexpr unsigned CAP_MASK = CAP_ALL;
     static constexpr unsigned OUT_ALL  = 0x7F80U;
-    static constexpr unsigned OUT_MASK = 0xFF80U;    // Includes LONG_UNROLL
+    // Includes LONG_UNROLL and SHORT_APPROX
+    static constexpr unsigned OUT_MASK = 0x1FF80U;
 
     static real SinCosSeries(bool sinp,
                              real sinx, real cosx, const real c[], int n);
-    static real Astroid(real x, real y);
 
-    real _a, _f;
-    bool _exact;
-    real _f1, _e2, _ep2, _n, _b, _c2, _etol2;
-    real _aA3x[nA3x_], _cC3x[nC3x_], _cC4x[nC4x_];
     GeodesicExact _geodexact;
 
-    void Lengths(real eps, real sig12,
-                 real ssig1, real csig1, real dn1,
-                 real ssig2, real csig2, real dn2,
-                 real cbet1, real cbet2, unsigned outmask,
-                 real& s12s, real& m12a, real& m0,
-                 real& M12, real& M21, real Ca[]) const;
-    real InverseStart(real sbet1, real cbet1, real dn1,
-                      real sbet2, real cbet2, real dn2,
-                      real lam12, real slam12, real clam12,
-                      real& salp1, real& calp1,
-                      real& salp2, real& calp2, real& dnm,
-                      real Ca[]) const;
-    real Lambda12(real sbet1, real cbet1, real dn1,
-                  real sbet2, real cbet2, real dn2,
-                  real salp1, real calp1, real slam120, real clam120,
-                  real& salp2, real& calp2, real& sig12,
-                  real& ssig1, real& csig1, real& ssig2, real& csig2,
-                  real& eps, real& domg12,
-                  bool diffp, real& dlam12, real Ca[]) const;
+    // The reduced latitude terms for a latitude of either sign; element
+    // signbit(lat) applies to the (rounded) latitude lat.
+    struct LatTerms {
+      real sbet[2], cbet[2], dn[2];
+    };
+    void LatSetup(real lat, LatTerms& t) const;
+    // The correction to the starting guess for Newton's method found for a
+    // previous inverse problem: dalp1 = alp1 - alp1s in the canonical frame
+    // with the signs which define this frame.
+    struct WarmStart {
+      real sdalp1, cdalp1;
+      int lonsign, swapp, latsign;
+      bool valid;
+      WarmStart() : sdalp1(0), cdalp1(1), lonsign(0), swapp(0), latsign(0)
+                  , valid(false) {}
+    };
+    // If t1 (t2) is not null, it holds the terms for lat1 (lat2) computed by
+    // LatSetup.  If warm is not null and valid and its frame matches, its
+    // correction is applied to the starting guess for Newton's method; it is
+    // updated whenever Newton's method is used.
     real GenInverse(real lat1, real lon1, real lat2, real lon2,
                     unsigned outmask, real& s12,
                     real& salp1, real& calp1, real& salp2, real& calp2,
-                    real& m12, real& M12, real& M21, real& S12) const;
+                    real& m12, real& M12, real& M21, real& S12,
+                    const LatTerms* t1 = nullptr,
+                    const LatTerms* t2 = nullptr,
+                    WarmStart* warm = nullptr) const;
+    // The implementation of the symmetric DistanceMatrix with the distances
+    // converted to U.
+    template<class U>
+    void SymmetricMatrix(size_t n, const real lat[], const real lon[],
+                         U s12[], int nthreads) const;
 
     // These are Maxima generated functions to provide series approximations to
     // the integrals for the ellipsoidal geodesic.
-    static real A1m1f(real eps);
-    static void C1f(real eps, real c[]);
-    static void C1pf(real eps, real c[]);
-    static real A2m1f(real eps);
-    static void C2f(real eps, real c[]);
+    // The static functions take the order of the series as an argument;
+    // order <= GEOGRAPHICLIB_GEODESIC_ORDER.  The coefficients of these are
+    // returned by A1m1coeff, etc.
+    static const real* A1m1coeff();
+    static const real* C1coeff();
+    static const real* C1pcoeff();
+    static const real* A2m1coeff();
+    static const real* C2coeff();
+    static real A1m1f(real eps, int order);
+    static void C1f(real eps, real c[], int order);
+    static void C1pf(real eps, real c[], int order);
+    static real A2m1f(real eps, int order);
+    static void C2f(real eps, real c[], int order);
 
     void A3coeff();
     real A3f(real eps) const;
@@ -325,8 +393,23 @@ namespace GeographicLib {
        **********************************************************************/
       LONG_UNROLL   = 1U<<15,
       /**
-       * All capabilities, calculate everything.  (Geodesic::LONG_UNROLL is not
-       * included in this mask.)
+       * Allow an approximate solution for short lines in the inverse
+       * calculation.  If the points are within about 2 km of one another
+       * (for the WGS84 ellipsoid), then the inverse problem is solved using a
+       * closed form approximation without iteration.  The resulting errors in
+       * \e s12, \e m12, and the positions implied by \e azi1 and \e azi2
+       * are less than 10<sup>&minus;13</sup> \e a (0.6 &mu;m for WGS84) and
+       * the errors in \e M12 and \e M21 are less than
+       * 10<sup>&minus;14</sup>.  For longer lines, the full solution is used.
+       * This flag is ignored if Geodesic::AREA is requested (because the
+       * approximation is not accurate enough for \e S12), by the direct
+       * calculation, and if \e exact = true.
+       * @hideinitializer
+       **********************************************************************/
+      SHORT_APPROX  = 1U<<16,
+      /**
+       * All capabilities, calculate everything.  (Geodesic::LONG_UNROLL and
+       * Geodesic::SHORT_APPROX are not included in this mask.)
        * @hideinitializer
        **********************************************************************/
       ALL           = OUT_ALL| CAP_ALL,
@@ -351,6 +434,38 @@ namespace GeographicLib {
      * problems in terms of elliptic integrals.
      **********************************************************************/
     Geodesic(real a, real f, bool exact = false);
+
+    /**
+     * Constructor for an ellipsoid with a specified order of the series
+     * expansions.
+     *
+     * @param[in] a equatorial radius (meters).
+     * @param[in] f flattening of ellipsoid.  Setting \e f = 0 gives a sphere.
+     *   Negative \e f gives a prolate ellipsoid.
+     * @param[in] exact if true use exact formulation in terms of elliptic
+     *   integrals instead of series expansions.
+     * @param[in] order the order of the series expansions.
+     * @exception GeographicErr if \e a or (1 &minus; \e f) \e a is not
+     *   positive.
+     * @exception GeographicErr if \e exact = false and \e order is not in
+     *   [3, GEOGRAPHICLIB_GEODESIC_ORDER].
+     *
+     * The series expansions in the flattening are truncated at
+     * <i>O</i>(<i>f</i><sup><i>order</i></sup>) instead of
+     * <i>O</i>(<i>f</i><sup><i>N</i></sup>) where \e N =
+     * GEOGRAPHICLIB_GEODESIC_ORDER (6 for doubles).  For the WGS84 ellipsoid,
+     * the maximum errors in the positions are then about 1&nbsp;mm for \e
+     * order = 3, 1&nbsp;&mu;m for \e order = 4, and 0.2&nbsp;&mu;m for \e
+     * order = 5; the corresponding errors in the area \e S12 are about
+     * 3000&nbsp;m<sup>2</sup>, 3&nbsp;m<sup>2</sup>, and
+     * 1&nbsp;m<sup>2</sup>.  The evaluation of the series is cheaper;
+     * however this is only part of the cost of a geodesic calculation, so
+     * the overall speed up is modest.  Several Geodesic objects with
+     * different orders can be used side by side.  With \e order =
+     * GEOGRAPHICLIB_GEODESIC_ORDER, this constructor is equivalent to the
+     * previous one.  \e order is ignored if \e exact = true.
+     **********************************************************************/
+    Geodesic(real a, real f, bool exact, int order);
     ///@}
 
     /** \name Direct geodesic problem specified in terms of distance.
@@ -809,6 +924,153 @@ namespace GeographicLib {
                           real& m12, real& M12, real& M21, real& S12) const;
     ///@}
 
+    /** \name Batch version of inverse geodesic solution.
+     **********************************************************************/
+    ///@{
+    /**
+     * Solve many inverse geodesic problems given as structure-of-arrays.
+     *
+     * @param[in] n the number of problems to solve.
+     * @param[in] lat1 array of \e n latitudes of point 1 (degrees).
+     * @param[in] lon1 array of \e n longitudes of point 1 (degrees).
+     * @param[in] lat2 array of \e n latitudes of point 2 (degrees).
+     * @param[in] lon2 array of \e n longitudes of point 2 (degrees).
+     * @param[in] outmask a bitor'ed combination of Geodesic::mask values
+     *   specifying which of the following arrays should be set.
+     * @param[out] s12 array of distances between point 1 and point 2
+     *   (meters).
+     * @param[out] azi1 array of azimuths at point 1 (degrees).
+     * @param[out] azi2 array of (forward) azimuths at point 2 (degrees).
+     * @param[out] m12 array of reduced lengths (meters).
+     * @param[out] M12 array of geodesic scales of point 2 relative to point 1
+     *   (dimensionless).
+     * @param[out] M21 array of geodesic scales of point 1 relative to point 2
+     *   (dimensionless).
+     * @param[out] S12 array of areas under the geodesics
+     *   (meters<sup>2</sup>).
+     * @param[out] a12 array of arc lengths between point 1 and point 2
+     *   (degrees).
+     *
+     * Element \e i of the output arrays is set to the result of
+     * Geodesic::GenInverse applied to element \e i of the input arrays.  The
+     * output arrays need only be supplied for the quantities requested in \e
+     * outmask; the others may be null pointers.  \e a12 is set if it is
+     * non-null.  The input and output arrays must not overlap.
+     *
+     * This is a plain loop which calls Geodesic::GenInverse for each
+     * problem, so the results are identical to those of the scalar calls.
+     * It saves only the overhead of the calls and of the unrequested
+     * outputs; it is a convenient interface when many independent inverse
+     * problems need to be solved.
+     **********************************************************************/
+    void GenInverse(size_t n,
+                    const real lat1[], const real lon1[],
+                    const real lat2[], const real lon2[],
+                    unsigned outmask,
+                    real s12[], real azi1[], real azi2[],
+                    real m12[], real M12[], real M21[], real S12[],
+                    real a12[] = nullptr) const;
+
+    /**
+     * Set up to solve several inverse geodesic problems with a common point
+     * 1.
+     *
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @return a GeodesicOrigin object.
+     *
+     * \e lat1 should be in the range [&minus;90&deg;, 90&deg;].  The setup
+     * for point 1 is done once and GeodesicOrigin::GenInverse then solves the
+     * inverse problem to any number of points 2.
+     **********************************************************************/
+    GeodesicOrigin InverseFrom(real lat1, real lon1) const;
+
+    /**
+     * Compute the matrix of distances between two sets of points.
+     *
+     * @param[in] n1 the number of points 1.
+     * @param[in] lat1 array of \e n1 latitudes of point 1 (degrees).
+     * @param[in] lon1 array of \e n1 longitudes of point 1 (degrees).
+     * @param[in] n2 the number of points 2.
+     * @param[in] lat2 array of \e n2 latitudes of point 2 (degrees).
+     * @param[in] lon2 array of \e n2 longitudes of point 2 (degrees).
+     * @param[out] s12 array of \e n1 &times; \e n2 distances (meters);
+     *   element \e i \e n2 + \e j is the distance from point 1 \e i to
+     *   point 2 \e j.
+     * @param[out] azi1 array of \e n1 &times; \e n2 azimuths at points 1
+     *   (degrees); this may be a null pointer.
+     * @param[out] azi2 array of \e n1 &times; \e n2 (forward) azimuths at
+     *   points 2 (degrees); this may be a null pointer.
+     * @param[in] nthreads the number of threads to use (default 1).
+     * @exception std::bad_alloc if the memory for the setup of the points 2
+     *   can't be allocated.
+     *
+     * The matrices are stored in row-major order and are supplied by the
+     * caller.  The results are bitwise identical to those given by
+     * Geodesic::Inverse(\e lat1[\e i], \e lon1[\e i], \e lat2[\e j], \e
+     * lon2[\e j], ...) regardless of \e nthreads.  The setup for each point
+     * (1 or 2) is done only once.  With \e nthreads &gt; 1 the rows are
+     * distributed over the threads.  The input and output arrays must not
+     * overlap.
+     **********************************************************************/
+    void DistanceMatrix(size_t n1, const real lat1[], const real lon1[],
+                        size_t n2, const real lat2[], const real lon2[],
+                        real s12[], real azi1[] = nullptr,
+                        real azi2[] = nullptr, int nthreads = 1) const;
+
+    /**
+     * Compute the symmetric matrix of distances between the points of a set.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of \e n latitudes (degrees).
+     * @param[in] lon array of \e n longitudes (degrees).
+     * @param[out] s12 array of \e n &times; \e n distances (meters);
+     *   element \e i \e n + \e j is the distance from point \e i to point
+     *   \e j.
+     * @param[in] nthreads the number of threads to use (default 1).
+     * @exception std::bad_alloc if the memory for the setup of the points
+     *   can't be allocated.
+     *
+     * The solution of the inverse problem is exactly symmetric in the two
+     * points, so only the upper triangle of the matrix (including the
+     * diagonal) is computed and this is copied to the lower triangle.  The
+     * results are bitwise identical to those given by Geodesic::Inverse(\e
+     * lat[\e i], \e lon[\e i], \e lat[\e j], \e lon[\e j], \e s12)
+     * regardless of \e nthreads.  The work is divided into tiles of 64
+     * &times; 64 elements so that a tile and its transpose stay in the cache
+     * while they are written; with \e nthreads &gt; 1 the rows of tiles are
+     * distributed over the threads.  The input and output arrays must not
+     * overlap.
+     **********************************************************************/
+    void DistanceMatrix(size_t n, const real lat[], const real lon[],
+                        real s12[], int nthreads = 1) const;
+
+#if GEOGRAPHICLIB_PRECISION > 1 && GEOGRAPHICLIB_PRECISION < 5
+    /**
+     * Compute the symmetric matrix of distances with single precision
+     * output.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of \e n latitudes (degrees).
+     * @param[in] lon array of \e n longitudes (degrees).
+     * @param[out] s12 array of \e n &times; \e n distances (meters).
+     * @param[in] nthreads the number of threads to use (default 1).
+     * @exception std::bad_alloc if the memory for the setup of the points
+     *   can't be allocated.
+     *
+     * This is the same as Geodesic::DistanceMatrix(size_t, const real[],
+     * const real[], real[], int) const except that the distances are
+     * rounded to floats; this halves the memory needed for the matrix (10
+     * GB instead of 20 GB for \e n = 50000) while retaining a relative
+     * precision of 6 &times; 10<sup>&minus;8</sup>.  The calculation is still
+     * carried out at full precision.  (This overload isn't provided if
+     * Math::real is a float or a multiprecision type.)
+     **********************************************************************/
+    void DistanceMatrix(size_t n, const real lat[], const real lon[],
+                        float s12[], int nthreads = 1) const;
+#endif
+    ///@}
+
     /** \name Interface to GeodesicLine.
      **********************************************************************/
     ///@{
@@ -952,6 +1214,62 @@ namespace GeographicLib {
                                unsigned caps = ALL) const;
     ///@}
 
+    /** \name Geodesic circles.
+     **********************************************************************/
+    ///@{
+    /**
+     * The number of vertices needed to approximate a geodesic circle.
+     *
+     * @param[in] lat1 latitude of the center (degrees).
+     * @param[in] lon1 longitude of the center (degrees).
+     * @param[in] radius the radius of the circle (meters).
+     * @param[in] tolerance the maximum distance between the circle and the
+     *   polygon (meters).
+     * @exception GeographicErr if \e radius is negative or not finite, if
+     *   \e tolerance is not positive, or if the number of vertices is too
+     *   large.
+     * @return the number of vertices \e n.
+     *
+     * The geodesic circle is the set of points at distance \e radius from
+     * the center.  It is approximated by the polygon computed by
+     * Geodesic::Circle whose \e n edges are geodesics.  The circle at
+     * azimuth &alpha; has radius of curvature \e m12 / \e M21 and an edge
+     * with length \e L deviates from it by about \e L<sup>2</sup> \e M21
+     * / (8 \e m12), where \e m12 and \e M21 are the reduced length and
+     * geodesic scale from the center.  These are sampled at 8 azimuths to
+     * give the smallest \e n (no less than 8) such that the deviation is
+     * within \e tolerance.  \e lat1 should be in the range [&minus;90&deg;,
+     * 90&deg;].
+     **********************************************************************/
+    int CircleVertices(real lat1, real lon1, real radius, real tolerance)
+      const;
+
+    /**
+     * Compute the vertices of a polygon approximating a geodesic circle.
+     *
+     * @param[in] lat1 latitude of the center (degrees).
+     * @param[in] lon1 longitude of the center (degrees).
+     * @param[in] radius the radius of the circle (meters).
+     * @param[in] n the number of vertices.
+     * @param[out] lat2 array of \e n latitudes of the vertices (degrees).
+     * @param[out] lon2 array of \e n longitudes of the vertices (degrees).
+     * @exception GeographicErr if \e n is less than 3.
+     * @exception std::bad_alloc if the memory for the GeodesicFan can't be
+     *   allocated.
+     *
+     * Vertex \e i is at distance \e radius from the center along the
+     * geodesic with azimuth \e i (360&deg; / \e n); thus the circle is
+     * traversed clockwise and PolygonArea::Compute gives the enclosed area
+     * as positive with \e reverse = true.
+     * The vertices are computed with GeodesicFan::Position and written to
+     * the caller's arrays, which can be reused for many circles.  Use
+     * Geodesic::CircleVertices to select \e n for a given tolerance.  \e
+     * lat1 should be in the range [&minus;90&deg;, 90&deg;].
+     **********************************************************************/
+    void Circle(real lat1, real lon1, real radius, int n,
+                real lat2[], real lon2[]) const;
+    ///@}
+
     /** \name Inspector functions.
      **********************************************************************/
     ///@{
@@ -974,6 +1292,13 @@ namespace GeographicLib {
      **********************************************************************/
     bool Exact() const { return _exact; }
 
+    /**
+     * @return \e order the order of the series expansions.  This is the
+     *   value used in the constructor (or GEOGRAPHICLIB_GEODESIC_ORDER if it
+     *   was not specified).
+     **********************************************************************/
+    int Order() const { return _order; }
+
     /**
      * @return total area of ellipsoid in meters<sup>2</sup>.  The area of a
      *   polygon encircling a pole can be found by adding
@@ -987,9 +1312,112 @@ namespace GeographicLib {
     /**
      * A global instantiation of Geodesic with the parameters for the WGS84
      * ellipsoid.
+     *
+     * The object is constructed on the first call.  If the library is
+     * built with the cmake option GEOGRAPHICLIB_EAGER_SINGLETONS = ON
+     * (default OFF), it is instead constructed when the library is loaded,
+     * so that the first call doesn't incur the cost of the construction
+     * (except with GEOGRAPHICLIB_PRECISION = 5, where the precision is set
+     * at run time).  In either case, it's safe to call this function during
+     * the static initialization of your program.  The other global
+     * instantiations, e.g., TransverseMercator::UTM(), are treated in the
+     * same way.  Each call checks that the object has been constructed; in
+     * inner loops, bind the result to a reference, e.g.,
+     * \code
+     *   const Geodesic& geod = Geodesic::WGS84();
+     * \endcode
      **********************************************************************/
     static const Geodesic& WGS84();
 
+    /** \name Statistics on the inverse calculation.
+     **********************************************************************/
+    ///@{
+
+    /**
+     * \brief Counts of the paths taken in the inverse calculation.
+     *
+     * These counts show how the inverse problems were solved; in particular,
+     * a large number of bisection steps indicates that some problems (e.g.,
+     * nearly antipodal ones) required many iterations.  Stats objects for
+     * several threads can be combined with the += operator.
+     **********************************************************************/
+    struct Stats {
+      /**
+       * The number of inverse calculations.
+       **********************************************************************/
+      long long inverse;
+      /**
+       * The number of meridional geodesics (solved without iteration).
+       **********************************************************************/
+      long long meridional;
+      /**
+       * The number of equatorial geodesics (solved without iteration).
+       **********************************************************************/
+      long long equatorial;
+      /**
+       * The number of short geodesics (solved without iteration).
+       **********************************************************************/
+      long long shortline;
+      /**
+       * The number of calls to the astroid solver for the starting guess for
+       * nearly antipodal points.
+       **********************************************************************/
+      long long astroid;
+      /**
+       * The number of Newton steps.
+       **********************************************************************/
+      long long newton;
+      /**
+       * The number of bisection steps (taken when a Newton step fails).
+       **********************************************************************/
+      long long bisection;
+      /**
+       * Constructor, all counts are zero.
+       **********************************************************************/
+      Stats()
+        : inverse(0), meridional(0), equatorial(0), shortline(0), astroid(0)
+        , newton(0), bisection(0) {}
+      /**
+       * Add the counts from another Stats object.
+       *
+       * @param[in] s the other object.
+       * @return a reference to this object.
+       **********************************************************************/
+      Stats& operator+=(const Stats& s) {
+        inverse += s.inverse; meridional += s.meridional;
+        equatorial += s.equatorial; shortline += s.shortline;
+        astroid += s.astroid; newton += s.newton; bisection += s.bisection;
+        return *this;
+      }
+    };
+
+    /**
+     * @return the counts for the calculations made by the calling thread (for
+     *   all Geodesic objects) since the start of the thread or the last call
+     *   to ResetStats().
+     *
+     * The counts are kept separately for each thread so they add no
+     * synchronization overhead; combine the results for several threads
+     * with Stats::operator+=().  The counts are only collected if the
+     * library was built with the cmake option GEOGRAPHICLIB_GEODESIC_STATS
+     * = ON; otherwise, the counting code is compiled out and this function
+     * returns zero counts.  The inverse calculation for \e exact = true is
+     * not counted.
+     **********************************************************************/
+    static Stats GetStats();
+
+    /**
+     * Reset the counts for the calling thread to zero.
+     **********************************************************************/
+    static void ResetStats();
+
+    /**
+     * @return whether the statistics are being collected; this is the value
+     *   of GEOGRAPHICLIB_GEODESIC_STATS with which the library was compiled.
+     **********************************************************************/
+    static bool StatsEnabled();
+    ///@}
+
   };
 
 } // namespace GeographicLib
@@ -0,0 +1,249 @@
+/**
+ * \file GeodesicCache.hpp
+ * \brief Header for GeographicLib::GeodesicCache class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_GEODESICCACHE_HPP)
+#define GEOGRAPHICLIB_GEODESICCACHE_HPP 1
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <GeographicLib/Constants.hpp>
+#include <GeographicLib/Geodesic.hpp>
+
+#if defined(_MSC_VER)
+// Squelch warnings about dll vs std::list, std::unordered_map, and
+// std::vector
+#  pragma warning (push)
+#  pragma warning (disable: 4251)
+#endif
+
+namespace GeographicLib {
+
+  /**
+   * \brief A cache of inverse geodesic solutions
+   *
+   * Applications which repeatedly solve the inverse problem for the same
+   * pairs of points (for example, the distances between a fixed set of
+   * airports and waypoints) can use a GeodesicCache in place of
+   * Geodesic::GenInverse.  The results of the most recently used problems
+   * are retained, keyed by the positions of the two points and \e outmask.
+   *
+   * The positions may optionally be quantized, in which case the problem is
+   * solved for the positions rounded to the nearest multiple of the quantum
+   * (and not with the requested positions).  With the default quantum of
+   * zero, the key is the exact bit pattern of the positions (so 0 and
+   * &minus;0 are different keys).  If \e symmetric is true (the default),
+   * the problem for the points in the reverse order shares the same entry:
+   * the azimuths are then obtained by reversing those of the stored solution,
+   * \e M12 and \e M21 are swapped and \e S12 is negated.  In this case, the
+   * azimuths may differ from those given by Geodesic::GenInverse by a
+   * roundoff error (a few times 10<sup>&minus;14</sup>&deg;) and the other
+   * results may differ in the last bit.  With \e symmetric = false and a
+   * quantum of zero, the results are identical to those from
+   * Geodesic::GenInverse.
+   *
+   * The entries are held in several shards, each of which is a bounded hash
+   * map with its own lock and evicts its least recently used entries; the
+   * shard for a problem is selected by its key.  All the member functions
+   * are thread safe and the inverse problem for a new key is solved with the
+   * lock released, so that threads only contend when they access the same
+   * shard.  The cache holds a reference to the Geodesic object which must
+   * therefore outlive it.
+   *
+   * Example of use:
+   * \code
+   *   GeodesicCache cache(Geodesic::WGS84(), 100000);
+   *   double s12, azi1, azi2;
+   *   for (...)
+   *     cache.Inverse(lat1, lon1, lat2, lon2, s12, azi1, azi2);
+   * \endcode
+   **********************************************************************/
+  class GEOGRAPHICLIB_EXPORT GeodesicCache {
+  private:
+    typedef Math::real real;
+    struct Key {
+      real lat1, lon1, lat2, lon2;
+      unsigned outmask;
+      bool operator==(const Key& k) const;
+    };
+    struct Hash {
+      size_t operator()(const Key& k) const;
+    };
+    struct Value {
+      real a12, s12, azi1, azi2, m12, M12, M21, S12;
+    };
+    class Shard {
+    private:
+      typedef std::list<std::pair<Key, Value> > list;
+      list _list;               // most recently used at the front
+      std::unordered_map<Key, list::iterator, Hash> _map;
+      size_t _maxsize;
+      unsigned long long _hits, _misses;
+      mutable std::mutex _lock;
+    public:
+      explicit Shard(size_t maxsize);
+      bool Find(const Key& k, Value& v);
+      void Insert(const Key& k, const Value& v);
+      void Clear();
+      size_t Size() const;
+      unsigned long long Hits() const;
+      unsigned long long Misses() const;
+    };
+    const Geodesic& _geod;
+    size_t _maxsize;
+    real _dq;
+    bool _symmetric;
+    std::vector<std::unique_ptr<Shard> > _shards;
+    Shard& shard(const Key& k);
+  public:
+
+    /**
+     * Constructor for a GeodesicCache.
+     *
+     * @param[in] geod the Geodesic object used to solve the problems.
+     * @param[in] maxsize the maximum number of solutions to retain (default
+     *   65536); if this is 0, no solutions are retained.
+     * @param[in] dq the quantum for the latitudes and longitudes (degrees);
+     *   if this is 0 (the default), the positions are not quantized.
+     * @param[in] symmetric whether to exploit the symmetry of the problem on
+     *   interchanging the points (default true).
+     * @param[in] nshards the number of shards (default 16).
+     * @exception GeographicErr if \e dq is negative or not finite or if \e
+     *   nshards is not positive.
+     *
+     * The bound \e maxsize is divided evenly between the shards (rounding
+     * up).
+     **********************************************************************/
+    GeodesicCache(const Geodesic& geod, size_t maxsize = 65536,
+                  real dq = 0, bool symmetric = true, int nshards = 16);
+
+    /**
+     * The general inverse geodesic calculation using the cache.
+     *
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] lat2 latitude of point 2 (degrees).
+     * @param[in] lon2 longitude of point 2 (degrees).
+     * @param[in] outmask a bitor'ed combination of Geodesic::mask values
+     *   specifying which of the following parameters should be set.
+     * @param[out] s12 distance between point 1 and point 2 (meters).
+     * @param[out] azi1 azimuth at point 1 (degrees).
+     * @param[out] azi2 (forward) azimuth at point 2 (degrees).
+     * @param[out] m12 reduced length of geodesic (meters).
+     * @param[out] M12 geodesic scale of point 2 relative to point 1
+     *   (dimensionless).
+     * @param[out] M21 geodesic scale of point 1 relative to point 2
+     *   (dimensionless).
+     * @param[out] S12 area under the geodesic (meters<sup>2</sup>).
+     * @exception std::bad_alloc if the memory for a new entry can't be
+     *   allocated.
+     * @return \e a12 arc length of between point 1 and point 2 (degrees).
+     *
+     * This is the same as Geodesic::GenInverse(\e lat1, \e lon1, \e lat2, \e
+     * lon2, \e outmask, ...) (with the positions quantized).  A solution
+     * computed with a larger \e outmask is not used to satisfy a request
+     * with a smaller \e outmask; \e outmask is part of the key.  If any of
+     * the positions is a NaN, the cache is bypassed.
+     **********************************************************************/
+    Math::real GenInverse(real lat1, real lon1, real lat2, real lon2,
+                          unsigned outmask,
+                          real& s12, real& azi1, real& azi2,
+                          real& m12, real& M12, real& M21, real& S12);
+
+    /**
+     * Solve the inverse geodesic problem using the cache.
+     *
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] lat2 latitude of point 2 (degrees).
+     * @param[in] lon2 longitude of point 2 (degrees).
+     * @param[out] s12 distance between point 1 and point 2 (meters).
+     * @param[out] azi1 azimuth at point 1 (degrees).
+     * @param[out] azi2 (forward) azimuth at point 2 (degrees).
+     * @return \e a12 arc length of between point 1 and point 2 (degrees).
+     **********************************************************************/
+    Math::real Inverse(real lat1, real lon1, real lat2, real lon2,
+                       real& s12, real& azi1, real& azi2) {
+      real t;
+      return GenInverse(lat1, lon1, lat2, lon2,
+                        Geodesic::DISTANCE | Geodesic::AZIMUTH,
+                        s12, azi1, azi2, t, t, t, t);
+    }
+
+    /**
+     * Solve the inverse geodesic problem for the distance using the cache.
+     *
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] lat2 latitude of point 2 (degrees).
+     * @param[in] lon2 longitude of point 2 (degrees).
+     * @param[out] s12 distance between point 1 and point 2 (meters).
+     * @return \e a12 arc length of between point 1 and point 2 (degrees).
+     **********************************************************************/
+    Math::real Inverse(real lat1, real lon1, real lat2, real lon2,
+                       real& s12) {
+      real t;
+      return GenInverse(lat1, lon1, lat2, lon2, Geodesic::DISTANCE,
+                        s12, t, t, t, t, t, t);
+    }
+
+    /**
+     * Remove all the solutions from the cache and reset the statistics.
+     **********************************************************************/
+    void Clear();
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return the number of solutions currently in the cache.
+     **********************************************************************/
+    size_t Size() const;
+
+    /**
+     * @return the maximum number of solutions retained.
+     **********************************************************************/
+    size_t MaxSize() const { return _maxsize; }
+
+    /**
+     * @return the quantum for the positions (degrees).
+     **********************************************************************/
+    Math::real Quantum() const { return _dq; }
+
+    /**
+     * @return whether the symmetry on interchanging the points is used.
+     **********************************************************************/
+    bool Symmetric() const { return _symmetric; }
+
+    /**
+     * @return the number of shards.
+     **********************************************************************/
+    int Shards() const { return int(_shards.size()); }
+
+    /**
+     * @return the number of calls to GenInverse satisfied from the cache.
+     **********************************************************************/
+    unsigned long long Hits() const;
+
+    /**
+     * @return the number of calls to GenInverse which solved a new problem.
+     **********************************************************************/
+    unsigned long long Misses() const;
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#if defined(_MSC_VER)
+#  pragma warning (pop)
+#endif
+
+#endif  // GEOGRAPHICLIB_GEODESICCACHE_HPP
@@ -109,6 +109,10 @@ namespace GeographicLib {
     real _a, _f, _f1, _e2, _ep2, _n, _b, _c2, _etol2;
     int _nC4;
     DST _fft;
+    // The elliptic integrals for k2 = alpha2 = -ep2 (used for meridional
+    // geodesics); GenInverse copies this instead of computing the complete
+    // integrals for each problem.
+    EllipticFunction _eEm;
 
     void Lengths(const EllipticFunction& E,
                  real sig12,
@@ -537,6 +541,51 @@ namespace GeographicLib {
                          real& lat2, real& lon2, real& azi2,
                          real& s12, real& m12, real& M12, real& M21,
                          real& S12) const;
+
+    /**
+     * Solve many direct geodesic problems given as structure-of-arrays.
+     *
+     * @param[in] n the number of problems to solve.
+     * @param[in] lat1 array of \e n latitudes of point 1 (degrees).
+     * @param[in] lon1 array of \e n longitudes of point 1 (degrees).
+     * @param[in] azi1 array of \e n azimuths at point 1 (degrees).
+     * @param[in] arcmode boolean flag determining the meaning of \e
+     *   s12_a12.
+     * @param[in] s12_a12 array of \e n distances (meters) or arc lengths
+     *   (degrees) between point 1 and point 2.
+     * @param[in] outmask a bitor'ed combination of GeodesicExact::mask values
+     *   specifying which of the following arrays should be set.
+     * @param[out] lat2 array of latitudes of point 2 (degrees).
+     * @param[out] lon2 array of longitudes of point 2 (degrees).
+     * @param[out] azi2 array of (forward) azimuths at point 2 (degrees).
+     * @param[out] s12 array of distances between point 1 and point 2
+     *   (meters).
+     * @param[out] m12 array of reduced lengths (meters).
+     * @param[out] M12 array of geodesic scales of point 2 relative to point 1
+     *   (dimensionless).
+     * @param[out] M21 array of geodesic scales of point 1 relative to point 2
+     *   (dimensionless).
+     * @param[out] S12 array of areas under the geodesics
+     *   (meters<sup>2</sup>).
+     * @param[out] a12 array of arc lengths between point 1 and point 2
+     *   (degrees); this may be a null pointer.
+     * @param[in] nthreads the number of threads to use (default 1).
+     *
+     * Element \e i of the output arrays is set to the result of
+     * GeodesicExact::GenDirect applied to element \e i of the input arrays.
+     * The output arrays need only be supplied for the quantities requested
+     * in \e outmask; the others may be null pointers.  The input and output
+     * arrays must not overlap.  With \e nthreads &gt; 1, blocks of problems
+     * are solved concurrently with Executor::Current.  The results are
+     * identical to those given by calling GeodesicExact::GenDirect for each
+     * problem.
+     **********************************************************************/
+    void GenDirect(size_t n,
+                   const real lat1[], const real lon1[], const real azi1[],
+                   bool arcmode, const real s12_a12[], unsigned outmask,
+                   real lat2[], real lon2[], real azi2[],
+                   real s12[], real m12[], real M12[], real M21[],
+                   real S12[], real a12[] = nullptr, int nthreads = 1) const;
     ///@}
 
     /** \name Inverse geodesic problem.
@@ -694,6 +743,48 @@ namespace GeographicLib {
                           unsigned outmask,
                           real& s12, real& azi1, real& azi2,
                           real& m12, real& M12, real& M21, real& S12) const;
+
+    /**
+     * Solve many inverse geodesic problems given as structure-of-arrays.
+     *
+     * @param[in] n the number of problems to solve.
+     * @param[in] lat1 array of \e n latitudes of point 1 (degrees).
+     * @param[in] lon1 array of \e n longitudes of point 1 (degrees).
+     * @param[in] lat2 array of \e n latitudes of point 2 (degrees).
+     * @param[in] lon2 array of \e n longitudes of point 2 (degrees).
+     * @param[in] outmask a bitor'ed combination of GeodesicExact::mask values
+     *   specifying which of the following arrays should be set.
+     * @param[out] s12 array of distances between point 1 and point 2
+     *   (meters).
+     * @param[out] azi1 array of azimuths at point 1 (degrees).
+     * @param[out] azi2 array of (forward) azimuths at point 2 (degrees).
+     * @param[out] m12 array of reduced lengths (meters).
+     * @param[out] M12 array of geodesic scales of point 2 relative to point 1
+     *   (dimensionless).
+     * @param[out] M21 array of geodesic scales of point 1 relative to point 2
+     *   (dimensionless).
+     * @param[out] S12 array of areas under the geodesics
+     *   (meters<sup>2</sup>).
+     * @param[out] a12 array of arc lengths between point 1 and point 2
+     *   (degrees); this may be a null pointer.
+     * @param[in] nthreads the number of threads to use (default 1).
+     *
+     * Element \e i of the output arrays is set to the result of
+     * GeodesicExact::GenInverse applied to element \e i of the input arrays.
+     * The output arrays need only be supplied for the quantities requested
+     * in \e outmask; the others may be null pointers.  The input and output
+     * arrays must not overlap.  With \e nthreads &gt; 1, blocks of problems
+     * are solved concurrently with Executor::Current.  The results are
+     * identical to those given by calling GeodesicExact::GenInverse for each
+     * problem.
+     **********************************************************************/
+    void GenInverse(size_t n,
+                    const real lat1[], const real lon1[],
+                    const real lat2[], const real lon2[],
+                    unsigned outmask,
+                    real s12[], real azi1[], real azi2[],
+                    real m12[], real M12[], real M21[], real S12[],
+                    real a12[] = nullptr, int nthreads = 1) const;
     ///@}
 
     /** \name Interface to GeodesicLineExact.
@@ -868,7 +959,7 @@ namespace GeographicLib {
 
     /**
      * A global instantiation of GeodesicExact with the parameters for the
-     * WGS84 ellipsoid.
+     * WGS84 ellipsoid.  See Geodesic::WGS84() for when this is constructed.
      **********************************************************************/
     static const GeodesicExact& WGS84();
 
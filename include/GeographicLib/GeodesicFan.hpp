@@ -0,0 +1,235 @@
+/**
+ * \file GeodesicFan.hpp
+ * \brief Header for GeographicLib::GeodesicFan class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_GEODESICFAN_HPP)
+#define GEOGRAPHICLIB_GEODESICFAN_HPP 1
+
+#include <vector>
+#include <GeographicLib/Constants.hpp>
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/GeodesicLine.hpp>
+
+#if defined(_MSC_VER)
+// Squelch warnings about dll vs vector
+#  pragma warning (push)
+#  pragma warning (disable: 4251)
+#endif
+
+namespace GeographicLib {
+
+  /**
+   * \brief A fan of geodesics from a common point
+   *
+   * GeodesicFan solves the direct geodesic problems for a fixed point 1 and
+   * a fixed set of azimuths (for example, every 0.1&deg;) at many ranges,
+   * e.g., for coverage or visibility calculations.  The GeodesicLine for each
+   * azimuth is constructed once in the constructor instead of for each
+   * problem (as Geodesic::Direct does).  In addition, the coefficients of
+   * the lines which are needed to compute positions are stored in
+   * "structure of arrays" form, so that GeodesicFan::Position computes the
+   * positions on all the geodesics at a given distance in one sweep; the
+   * loops over the azimuths are processed in groups of GeodesicFan::lanes
+   * so that the compiler can vectorize the arithmetic.  The results are
+   * identical to those given by GeodesicLine::Position for the individual
+   * lines.
+   *
+   * The class holds copies of the GeodesicLine objects; it is immutable and
+   * so it may be used by several threads at once.  If the Geodesic object
+   * was constructed with \e exact = true, GeodesicFan::Position evaluates
+   * the lines one by one.
+   *
+   * Example of use:
+   * \code
+   *   const Geodesic& geod = Geodesic::WGS84();
+   *   GeodesicFan fan(geod, 40.64, -73.78, 0, 0.1, 3600);
+   *   std::vector<double> lat(fan.Size()), lon(fan.Size());
+   *   for (double s12 : {10e3, 20e3, 50e3})
+   *     fan.Position(s12, lat.data(), lon.data());
+   * \endcode
+   **********************************************************************/
+
+  class GEOGRAPHICLIB_EXPORT GeodesicFan {
+  private:
+    typedef Math::real real;
+    std::vector<GeodesicLine> _lines;
+    real _lat1, _lon1;
+    bool _soa;
+    int _order;
+    real _f, _f1, _b, _tiny;
+    // The line parameters with _x[i] for line i
+    std::vector<real> _bA1, _aA1m1, _k2, _salp0, _calp0, _ssig1, _csig1,
+      _stau1, _ctau1, _somg1, _comg1, _aA3c, _bB11, _bB31;
+    // The coefficients with _cC1a[j * n + i] for coefficient j of line i
+    std::vector<real> _cC1a, _cC1pa, _cC3a;
+    void Init(const Geodesic& g, real lat1, real lon1,
+              size_t n, const real azi1[], unsigned caps);
+    // Position for lines [ib, ie); element i of the arrays is for line i.
+    void position(real s12, size_t ib, size_t ie,
+                  real lat2[], real lon2[], real azi2[]) const;
+  public:
+
+    /**
+     * The number of geodesics handled together by GeodesicFan::Position.
+     **********************************************************************/
+    static const int lanes = 8;
+
+    /**
+     * Constructor for a GeodesicFan with given azimuths.
+     *
+     * @param[in] g a Geodesic object used to compute the geodesics.
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] n the number of geodesics.
+     * @param[in] azi1 array of \e n azimuths at point 1 (degrees).
+     * @param[in] caps bitor'ed combination of Geodesic::mask values
+     *   specifying the capabilities the GeodesicLine objects should
+     *   possess, i.e., which quantities can be returned by
+     *   GeodesicFan::GenPosition.
+     * @exception std::bad_alloc if the memory for the lines can't be
+     *   allocated.
+     *
+     * The default value of \e caps is Geodesic::STANDARD |
+     * Geodesic::DISTANCE_IN, which is what is needed by
+     * GeodesicFan::Position.  \e lat1 should be in the range [&minus;90&deg;,
+     * 90&deg;].
+     **********************************************************************/
+    GeodesicFan(const Geodesic& g, real lat1, real lon1,
+                size_t n, const real azi1[],
+                unsigned caps = Geodesic::STANDARD | Geodesic::DISTANCE_IN);
+
+    /**
+     * Constructor for a GeodesicFan with equally spaced azimuths.
+     *
+     * @param[in] g a Geodesic object used to compute the geodesics.
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] azi0 the azimuth of the first geodesic (degrees).
+     * @param[in] dazi the spacing of the azimuths (degrees).
+     * @param[in] n the number of geodesics.
+     * @param[in] caps bitor'ed combination of Geodesic::mask values
+     *   specifying the capabilities the GeodesicLine objects should possess.
+     * @exception std::bad_alloc if the memory for the lines can't be
+     *   allocated.
+     *
+     * The azimuth of geodesic \e i is \e azi0 + \e i \e dazi.
+     **********************************************************************/
+    GeodesicFan(const Geodesic& g, real lat1, real lon1,
+                real azi0, real dazi, size_t n,
+                unsigned caps = Geodesic::STANDARD | Geodesic::DISTANCE_IN);
+
+    /**
+     * Compute the positions on all the geodesics at a given distance.
+     *
+     * @param[in] s12 distance from point 1 (meters).
+     * @param[out] lat2 array of \e n latitudes of the points (degrees).
+     * @param[out] lon2 array of \e n longitudes of the points (degrees).
+     * @param[out] azi2 array of \e n (forward) azimuths at the points
+     *   (degrees); this may be a null pointer.
+     *
+     * Element \e i of the output arrays is the result of Line(\e
+     * i).Position(\e s12, ...).  The output arrays are sized by Size().  If
+     * the lines lack the capabilities Geodesic::STANDARD |
+     * Geodesic::DISTANCE_IN, the results are NaNs.
+     **********************************************************************/
+    void Position(real s12, real lat2[], real lon2[],
+                  real azi2[] = nullptr) const;
+
+    /**
+     * Compute the positions on all the geodesics at many distances.
+     *
+     * @param[in] m the number of distances.
+     * @param[in] s12 array of \e m distances from point 1 (meters).
+     * @param[out] lat2 array of \e m &times; Size() latitudes of the points
+     *   (degrees); element \e j Size() + \e i is for distance \e j on
+     *   geodesic \e i.
+     * @param[out] lon2 array of \e m &times; Size() longitudes of the points
+     *   (degrees).
+     * @param[out] azi2 array of \e m &times; Size() (forward) azimuths at
+     *   the points (degrees); this may be a null pointer.
+     * @param[in] nthreads the number of threads to use (default 1).
+     *
+     * This fills rasters of positions (e.g., for a sensor footprint) with
+     * row \e j given by Position(\e s12[\e j], ...); the results are
+     * identical regardless of \e nthreads.  The geodesics are taken in
+     * blocks of a few hundred, each of which is evaluated at all the
+     * distances while their coefficients are in the cache; with \e nthreads
+     * &gt; 1 the blocks are distributed over the threads.  The input and
+     * output arrays must not overlap.
+     **********************************************************************/
+    void Grid(size_t m, const real s12[],
+              real lat2[], real lon2[], real azi2[] = nullptr,
+              int nthreads = 1) const;
+
+    /**
+     * The general position calculation on all the geodesics.
+     *
+     * @param[in] arcmode boolean flag determining the meaning of \e s12_a12.
+     * @param[in] s12_a12 if \e arcmode is false, the distance from point 1
+     *   (meters); otherwise the arc length from point 1 (degrees).
+     * @param[in] outmask a bitor'ed combination of Geodesic::mask values
+     *   specifying which of the following arrays should be set.
+     * @param[out] lat2 array of latitudes (degrees).
+     * @param[out] lon2 array of longitudes (degrees).
+     * @param[out] azi2 array of (forward) azimuths (degrees).
+     * @param[out] s12 array of distances (meters).
+     * @param[out] m12 array of reduced lengths (meters).
+     * @param[out] M12 array of geodesic scales of point 2 relative to point 1
+     *   (dimensionless).
+     * @param[out] M21 array of geodesic scales of point 1 relative to point 2
+     *   (dimensionless).
+     * @param[out] S12 array of areas under the geodesics
+     *   (meters<sup>2</sup>).
+     * @param[out] a12 array of arc lengths (degrees); this may be a null
+     *   pointer.
+     *
+     * Element \e i of the output arrays is set to the result of Line(\e
+     * i).GenPosition(\e arcmode, \e s12_a12, \e outmask, ...).  As with
+     * GeodesicLine::GenPosition(size_t, ...), the output arrays need only be
+     * supplied for the quantities requested in \e outmask.  This evaluates
+     * the lines one by one; use GeodesicFan::Position for the fast
+     * computation of the positions.
+     **********************************************************************/
+    void GenPosition(bool arcmode, real s12_a12, unsigned outmask,
+                     real lat2[], real lon2[], real azi2[],
+                     real s12[], real m12[], real M12[], real M21[],
+                     real S12[], real a12[] = nullptr) const;
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return the number of geodesics.
+     **********************************************************************/
+    size_t Size() const { return _lines.size(); }
+
+    /**
+     * @param[in] i the index of the geodesic.
+     * @return a reference to the GeodesicLine for geodesic \e i.
+     **********************************************************************/
+    const GeodesicLine& Line(size_t i) const { return _lines[i]; }
+
+    /**
+     * @return \e lat1 the latitude of point 1 (degrees).
+     **********************************************************************/
+    Math::real Latitude() const { return _lat1; }
+
+    /**
+     * @return \e lon1 the longitude of point 1 (degrees).
+     **********************************************************************/
+    Math::real Longitude() const { return _lon1; }
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#if defined(_MSC_VER)
+#  pragma warning (pop)
+#endif
+
+#endif  // GEOGRAPHICLIB_GEODESICFAN_HPP
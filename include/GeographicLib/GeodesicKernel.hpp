@@ -0,0 +1,1717 @@
+/**
+ * \file GeodesicKernel.hpp
+ * \brief Header for GeographicLib::GeodesicKernel class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ *
+ * This holds the calculations for Geodesic and GeodesicLine (with \e exact =
+ * false).  See Geodesic.cpp for the notation.
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_GEODESICKERNEL_HPP)
+#define GEOGRAPHICLIB_GEODESICKERNEL_HPP 1
+
+#include <cstddef>
+#include <cmath>
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/GeodesicLine.hpp>
+
+#if !defined(GEOGRAPHICLIB_HD)
+/**
+ * The annotation for the functions in GeodesicKernel.  This is
+ * <code>__host__ __device__</code> when compiling with a CUDA compiler (so
+ * the functions can be called in device code) and is empty otherwise.  It
+ * can be defined before this file is included to use another annotation.
+ **********************************************************************/
+#  if defined(__CUDACC__)
+#    define GEOGRAPHICLIB_HD __host__ __device__
+#  else
+#    define GEOGRAPHICLIB_HD
+#  endif
+#endif
+
+namespace GeographicLib {
+
+  /**
+   * \brief %Geodesic calculations which can be compiled for a GPU
+   *
+   * This holds the calculations of the direct and inverse geodesic problems
+   * made by Geodesic and GeodesicLine, as static functions of the parameters
+   * of these objects, GeodesicCoeffs and GeodesicLineCoeffs.  Geodesic and
+   * GeodesicLine (with \e exact = false) call these functions, so the
+   * results are the same.  The functions are defined in this header, they
+   * make no use of function-local statics, exceptions, or dynamic memory,
+   * and they are annotated with GEOGRAPHICLIB_HD; so they can be compiled as
+   * device code, e.g., by a CUDA compiler.  In device code, the Math
+   * functions they need are replaced by versions in this class; on the host,
+   * the Math functions are called.
+   *
+   * The GeodesicCoeffs struct is set on the host from a Geodesic object by
+   * GeodesicKernel::Coefficients.  The Geodesic object may have been
+   * constructed with a reduced order for the series, but not with \e exact =
+   * true.  The type Math::real must be supported in device code (i.e.,
+   * GEOGRAPHICLIB_PRECISION should be 1 or 2) if the functions are to be
+   * compiled for a GPU.
+   *
+   * No \c __global__ function is supplied.  The batch functions,
+   * GeodesicKernel::GenDirect and GeodesicKernel::GenInverse with an array
+   * length \e n, solve \e n problems in turn; on a GPU, each thread can call
+   * these for its own slice of the arrays.  E.g., a CUDA kernel might be
+   * \code
+   *   __global__ void inverse(GeodesicCoeffs c, size_t n,
+   *                           const double* lat1, const double* lon1,
+   *                           const double* lat2, const double* lon2,
+   *                           double* s12) {
+   *     size_t i = blockIdx.x * size_t(blockDim.x) + threadIdx.x;
+   *     if (i < n)
+   *       GeodesicKernel::GenInverse(c, 1, lat1 + i, lon1 + i,
+   *                                  lat2 + i, lon2 + i,
+   *                                  Geodesic::DISTANCE, s12 + i,
+   *                                  nullptr, nullptr, nullptr,
+   *                                  nullptr, nullptr, nullptr);
+   *   }
+   * \endcode
+   * with the struct given by
+   * \code
+   *   GeodesicCoeffs c = GeodesicKernel::Coefficients(Geodesic::WGS84());
+   * \endcode
+   **********************************************************************/
+  class GeodesicKernel {
+  private:
+    typedef Math::real real;
+    friend class Geodesic;
+    friend class GeodesicLine;
+    static const int N = GEOGRAPHICLIB_GEODESIC_ORDER;
+    static const unsigned NONE = Geodesic::NONE;
+    static const unsigned LATITUDE = Geodesic::LATITUDE;
+    static const unsigned LONGITUDE = Geodesic::LONGITUDE;
+    static const unsigned AZIMUTH = Geodesic::AZIMUTH;
+    static const unsigned DISTANCE = Geodesic::DISTANCE;
+    static const unsigned DISTANCE_IN = Geodesic::DISTANCE_IN;
+    static const unsigned REDUCEDLENGTH = Geodesic::REDUCEDLENGTH;
+    static const unsigned GEODESICSCALE = Geodesic::GEODESICSCALE;
+    static const unsigned AREA = Geodesic::AREA;
+    static const unsigned LONG_UNROLL = Geodesic::LONG_UNROLL;
+    static const unsigned SHORT_APPROX = Geodesic::SHORT_APPROX;
+    static const unsigned CAP_C1 = Geodesic::CAP_C1;
+    static const unsigned CAP_C1p = Geodesic::CAP_C1p;
+    static const unsigned CAP_C2 = Geodesic::CAP_C2;
+    static const unsigned CAP_C3 = Geodesic::CAP_C3;
+    static const unsigned CAP_C4 = Geodesic::CAP_C4;
+    static const unsigned OUT_MASK = Geodesic::OUT_MASK;
+
+    GEOGRAPHICLIB_HD static real sq(real x) { return x * x; }
+    template<typename T> GEOGRAPHICLIB_HD static void swap(T& x, T& y)
+    { T t = x; x = y; y = t; }
+    GEOGRAPHICLIB_HD static real polyval(int n, const real p[], real x) {
+      real y = n < 0 ? 0 : *p++;
+      while (--n >= 0) y = y * x + *p++;
+      return y;
+    }
+#if defined(__CUDA_ARCH__)
+    // Versions of the Math functions for device code; these avoid the
+    // function-local statics in Math.
+    GEOGRAPHICLIB_HD static real pi()
+    { return real(3.141592653589793238462643383279502884); }
+    GEOGRAPHICLIB_HD static real degree() { return pi() / Math::hd; }
+    GEOGRAPHICLIB_HD static real NaN() { return real(NAN); }
+    GEOGRAPHICLIB_HD static void norm(real& x, real& y) {
+      real h = std::hypot(x, y);
+      x /= h; y /= h;
+    }
+    GEOGRAPHICLIB_HD static real sum(real u, real v, real& t) {
+      GEOGRAPHICLIB_VOLATILE real s = u + v;
+      GEOGRAPHICLIB_VOLATILE real up = s - v;
+      GEOGRAPHICLIB_VOLATILE real vpp = s - up;
+      up -= u;
+      vpp -= v;
+      t = s != 0 ? real(0) - (up + vpp) : s;
+      return s;
+    }
+    GEOGRAPHICLIB_HD static real AngNormalize(real x) {
+      real y = std::remainder(x, real(Math::td));
+      return std::fabs(y) == Math::hd ? std::copysign(real(Math::hd), x) : y;
+    }
+    GEOGRAPHICLIB_HD static real AngDiff(real x, real y, real& e) {
+      real d = sum(std::remainder(-x, real(Math::td)),
+                   std::remainder( y, real(Math::td)), e);
+      d = sum(std::remainder(d, real(Math::td)), e, e);
+      if (d == 0 || std::fabs(d) == Math::hd)
+        d = std::copysign(d, e == 0 ? y - x : -e);
+      return d;
+    }
+    GEOGRAPHICLIB_HD static real AngRound(real x) {
+      const real z = real(1)/real(16);
+      GEOGRAPHICLIB_VOLATILE real y = std::fabs(x);
+      GEOGRAPHICLIB_VOLATILE real w = z - y;
+      y = w > 0 ? z - w : y;
+      return std::copysign(y, x);
+    }
+    GEOGRAPHICLIB_HD static real LatFix(real x)
+    { return std::fabs(x) > Math::qd ? NaN() : x; }
+    GEOGRAPHICLIB_HD static void sincosq(real r, int q,
+                                         real& sinx, real& cosx) {
+      real s = std::sin(r), c = std::cos(r);
+      switch (unsigned(q) & 3U) {
+      case 0U: sinx =  s; cosx =  c; break;
+      case 1U: sinx =  c; cosx = -s; break;
+      case 2U: sinx = -s; cosx = -c; break;
+      default: sinx = -c; cosx =  s; break; // case 3U
+      }
+      cosx += real(0);
+    }
+    GEOGRAPHICLIB_HD static void sincosd(real x, real& sinx, real& cosx) {
+      int q = 0;
+      real r = std::remquo(x, real(Math::qd), &q); // now abs(r) <= 45
+      sincosq(r * degree(), q, sinx, cosx);
+      if (sinx == 0) sinx = std::copysign(sinx, x);
+    }
+    GEOGRAPHICLIB_HD static void sincosde(real x, real t,
+                                          real& sinx, real& cosx) {
+      int q = 0;
+      real r = AngRound(std::remquo(x, real(Math::qd), &q) + t);
+      sincosq(r * degree(), q, sinx, cosx);
+      if (sinx == 0) sinx = std::copysign(sinx, x);
+    }
+    GEOGRAPHICLIB_HD static real atan2d(real y, real x) {
+      int q = 0;
+      if (std::fabs(y) > std::fabs(x)) { swap(x, y); q = 2; }
+      if (std::signbit(x)) { x = -x; ++q; }
+      real ang = std::atan2(y, x) / degree();
+      switch (q) {
+      case 1: ang = std::copysign(real(Math::hd), y) - ang; break;
+      case 2: ang =            Math::qd       - ang; break;
+      case 3: ang =           -Math::qd       + ang; break;
+      default: break;
+      }
+      return ang;
+    }
+#else
+    // On the host, use the Math functions.
+    static real pi() { return Math::pi(); }
+    static real degree() { return Math::degree(); }
+    static real NaN() { return Math::NaN(); }
+    static void norm(real& x, real& y) { Math::norm(x, y); }
+    static real AngNormalize(real x) { return Math::AngNormalize(x); }
+    static real AngDiff(real x, real y, real& e)
+    { return Math::AngDiff(x, y, e); }
+    static real AngRound(real x) { return Math::AngRound(x); }
+    static real LatFix(real x) { return Math::LatFix(x); }
+    static void sincosd(real x, real& sinx, real& cosx)
+    { Math::sincosd(x, sinx, cosx); }
+    static void sincosde(real x, real t, real& sinx, real& cosx)
+    { Math::sincosde(x, t, sinx, cosx); }
+    static real atan2d(real y, real x) { return Math::atan2d(y, x); }
+#endif
+
+    // This is a template so that DoubleStart can use it with doubles.
+    template<typename T>
+    GEOGRAPHICLIB_HD static T SinCosSeries(bool sinp, T sinx, T cosx,
+                                           const T c[], int n) {
+      // Evaluate
+      // y = sinp ? sum(c[i] * sin( 2*i    * x), i, 1, n) :
+      //            sum(c[i] * cos((2*i+1) * x), i, 0, n-1)
+      // using Clenshaw summation.  N.B. c[0] is unused for sin series
+      // Approx operation count = (n + 5) mult and (2 * n + 2) add
+      c += (n + sinp);            // Point to one beyond last element
+      T
+        ar = 2 * (cosx - sinx) * (cosx + sinx), // 2 * cos(2 * x)
+        y0 = n & 1 ? *--c : 0, y1 = 0;          // accumulators for sum
+      // Now n is even
+      n /= 2;
+      while (n--) {
+        // Unroll loop x 2, so accumulators return to their original role
+        y1 = ar * y0 - y1 + *--c;
+        y0 = ar * y1 - y0 + *--c;
+      }
+      return sinp
+        ? 2 * sinx * cosx * y0    // sin(2 * x) * y0
+        : cosx * (y0 - y1);       // cos(x) * (y0 - y1)
+    }
+
+    // The series for A1m1f, C1f, C1pf, A2m1f, and C2f with the coefficients
+    // coeff (see Geodesic.cpp for the layout).  Elements c[1] thru c[order]
+    // are set by CSeries.
+    GEOGRAPHICLIB_HD static real A1m1f(const real coeff[],
+                                       real eps, int order) {
+      // For order < N, drop the leading (highest order) terms
+      int m = N/2, mo = order/2;
+      real t = polyval(mo, coeff + (m - mo), sq(eps)) / coeff[m + 1];
+      return (t + eps) / (1 - eps);
+    }
+    GEOGRAPHICLIB_HD static real A2m1f(const real coeff[],
+                                       real eps, int order) {
+      int m = N/2, mo = order/2;
+      real t = polyval(mo, coeff + (m - mo), sq(eps)) / coeff[m + 1];
+      return (t - eps) / (1 + eps);
+    }
+    GEOGRAPHICLIB_HD static void CSeries(const real coeff[],
+                                         real eps, real c[], int order) {
+      real
+        eps2 = sq(eps),
+        d = eps;
+      int o = 0;
+      for (int l = 1; l <= order; ++l) { // l is index of c[l]  
+        int m = (N - l) / 2,         // order of polynomial in eps^2
+          mo = (order - l) / 2;      // ... truncated to order
+        c[l] = d * polyval(mo, coeff + o + (m - mo), eps2) / coeff[o + m + 1];
+        o += m + 2;
+        d *= eps;
+      }
+    }
+
+    // Set c[l] for l in [L, N) to the product of the running power of eps
+    // and the polynomial of degree N - l - 1 in eps whose coefficients start
+    // at p; the coefficients for successive l are consecutive.  If pre, the
+    // power is updated before each product (as in C3f), otherwise after it
+    // (as in C4f).  This is the untruncated case of the loops in C3f and C4f
+    // with the same operations; the recursion is expanded at compile time so
+    // that the independent Horner evaluations can be overlapped.
+    template<int M, int L, bool pre> struct EpsSeries {
+      GEOGRAPHICLIB_HD static void eval(const real p[], real mult, real eps,
+                                        real c[]) {
+        const int m = M - L - 1;
+        if (pre) mult *= eps;
+        c[L] = mult * polyval(m, p, eps);
+        if (!pre) mult *= eps;
+        EpsSeries<M, L + 1, pre>::eval(p + m + 1, mult, eps, c);
+      }
+    };
+    template<int M, bool pre> struct EpsSeries<M, M, pre> {
+      GEOGRAPHICLIB_HD static void eval(const real[], real, real, real[]) {}
+    };
+
+    GEOGRAPHICLIB_HD static real A3f(const GeodesicCoeffs& g, real eps) {
+      // Evaluate A3
+      return polyval(g._order - 1, g._aA3x + (N - g._order), eps);
+    }
+    GEOGRAPHICLIB_HD static void C3f(const GeodesicCoeffs& g,
+                                     real eps, real c[]) {
+      // Evaluate C3 coeffs
+      // Elements c[1] thru c[order - 1] are set
+      if (g._order == N) {
+        EpsSeries<N, 1, true>::eval(g._cC3x, real(1), eps, c);
+        return;
+      }
+      real mult = 1;
+      int o = 0;
+      for (int l = 1; l < g._order; ++l) { // l is index of C3[l]
+        int m = N - l - 1,                 // order of polynomial in eps
+          mo = g._order - l - 1;           // ... truncated to order
+        mult *= eps;
+        c[l] = mult * polyval(mo, g._cC3x + o + (m - mo), eps);
+        o += m + 1;
+      }
+    }
+    GEOGRAPHICLIB_HD static void C4f(const GeodesicCoeffs& g,
+                                     real eps, real c[]) {
+      // Evaluate C4 coeffs
+      // Elements c[0] thru c[order - 1] are set
+      if (g._order == N) {
+        EpsSeries<N, 0, false>::eval(g._cC4x, real(1), eps, c);
+        return;
+      }
+      real mult = 1;
+      int o = 0;
+      for (int l = 0; l < g._order; ++l) { // l is index of C4[l]
+        int m = N - l - 1,                 // order of polynomial in eps
+          mo = g._order - l - 1;           // ... truncated to order
+        c[l] = mult * polyval(mo, g._cC4x + o + (m - mo), eps);
+        o += m + 1;
+        mult *= eps;
+      }
+    }
+
+    GEOGRAPHICLIB_HD static void
+    Lengths(const GeodesicCoeffs& g, real eps, real sig12,
+            real ssig1, real csig1, real dn1,
+            real ssig2, real csig2, real dn2,
+            real cbet1, real cbet2, unsigned outmask,
+            real& s12b, real& m12b, real& m0,
+            real& M12, real& M21,
+            // Scratch area of the right size
+            real Ca[]) {
+      // Return m12b = (reduced length)/_b; also calculate s12b = distance/_b,
+      // and m0 = coefficient of secular term in expression for reduced length.
+
+      outmask &= OUT_MASK;
+      // outmask & DISTANCE: set s12b
+      // outmask & REDUCEDLENGTH: set m12b & m0
+      // outmask & GEODESICSCALE: set M12 & M21
+
+      real m0x = 0, J12 = 0, A1 = 0, A2 = 0;
+      real Cb[N + 1];
+      if (outmask & (DISTANCE | REDUCEDLENGTH | GEODESICSCALE)) {
+        A1 = A1m1f(g._aA1m1x, eps, g._order);
+        CSeries(g._cC1x, eps, Ca, g._order);
+        if (outmask & (REDUCEDLENGTH | GEODESICSCALE)) {
+          A2 = A2m1f(g._aA2m1x, eps, g._order);
+          CSeries(g._cC2x, eps, Cb, g._order);
+          m0x = A1 - A2;
+          A2 = 1 + A2;
+        }
+        A1 = 1 + A1;
+      }
+      if (outmask & DISTANCE) {
+        real B1 = SinCosSeries(true, ssig2, csig2, Ca, g._order) -
+          SinCosSeries(true, ssig1, csig1, Ca, g._order);
+        // Missing a factor of _b
+        s12b = A1 * (sig12 + B1);
+        if (outmask & (REDUCEDLENGTH | GEODESICSCALE)) {
+          real B2 = SinCosSeries(true, ssig2, csig2, Cb, g._order) -
+            SinCosSeries(true, ssig1, csig1, Cb, g._order);
+          J12 = m0x * sig12 + (A1 * B1 - A2 * B2);
+        }
+      } else if (outmask & (REDUCEDLENGTH | GEODESICSCALE)) {
+        for (int l = 1; l <= g._order; ++l)
+          Cb[l] = A1 * Ca[l] - A2 * Cb[l];
+        J12 = m0x * sig12 + (SinCosSeries(true, ssig2, csig2, Cb, g._order) -
+                             SinCosSeries(true, ssig1, csig1, Cb, g._order));
+      }
+      if (outmask & REDUCEDLENGTH) {
+        m0 = m0x;
+        // Missing a factor of _b.
+        // Add parens around (csig1 * ssig2) and (ssig1 * csig2) to ensure
+        // accurate cancellation in the case of coincident points.
+        m12b = dn2 * (csig1 * ssig2) - dn1 * (ssig1 * csig2) -
+          csig1 * csig2 * J12;
+      }
+      if (outmask & GEODESICSCALE) {
+        real csig12 = csig1 * csig2 + ssig1 * ssig2;
+        real t = g._ep2 * (cbet1 - cbet2) * (cbet1 + cbet2) / (dn1 + dn2);
+        M12 = csig12 + (t * ssig2 - csig2 * J12) * ssig1 / dn1;
+        M21 = csig12 - (t * ssig1 - csig1 * J12) * ssig2 / dn2;
+      }
+    }
+
+    GEOGRAPHICLIB_HD static real Astroid(real x, real y) {
+      using std::sqrt; using std::cbrt; using std::atan2; using std::cos;
+      // Solve k^4+2*k^3-(x^2+y^2-1)*k^2-2*y^2*k-y^2 = 0 for positive root k.
+      // This solution is adapted from Geocentric::Reverse.
+      real k;
+      real
+        p = sq(x),
+        q = sq(y),
+        r = (p + q - 1) / 6;
+      if ( !(q == 0 && r <= 0) ) {
+        real
+          // Avoid possible division by zero when r = 0 by multiplying equations
+          // for s and t by r^3 and r, resp.
+          S = p * q / 4,            // S = r^3 * s
+          r2 = sq(r),
+          r3 = r * r2,
+          // The discriminant of the quadratic equation for T3.  This is zero on
+          // the evolute curve p^(1/3)+q^(1/3) = 1
+          disc = S * (S + 2 * r3);
+        real u = r;
+        if (disc >= 0) {
+          real T3 = S + r3;
+          // Pick the sign on the sqrt to maximize abs(T3).  This minimizes loss
+          // of precision due to cancellation.  The result is unchanged because
+          // of the way the T is used in definition of u.
+          T3 += T3 < 0 ? -sqrt(disc) : sqrt(disc); // T3 = (r * t)^3
+          // N.B. cbrt always returns the real root.  cbrt(-8) = -2.
+          real T = cbrt(T3); // T = r * t
+          // T can be zero; but then r2 / T -> 0.
+          u += T + (T != 0 ? r2 / T : 0);
+        } else {
+          // T is complex, but the way u is defined the result is real.
+          real ang = atan2(sqrt(-disc), -(S + r3));
+          // There are three possible cube roots.  We choose the root which
+          // avoids cancellation.  Note that disc < 0 implies that r < 0.
+          u += 2 * r * cos(ang / 3);
+        }
+        real
+          v = sqrt(sq(u) + q),    // guaranteed positive
+          // Avoid loss of accuracy when u < 0.
+          uv = u < 0 ? q / (v - u) : u + v, // u+v, guaranteed positive
+          w = (uv - q) / (2 * v);           // positive?
+        // Rearrange expression for k to avoid loss of accuracy due to
+        // subtraction.  Division by 0 not possible because uv > 0, w >= 0.
+        k = uv / (sqrt(uv + sq(w)) + w);   // guaranteed positive
+      } else {               // q == 0 && r <= 0
+        // y = 0 with |x| <= 1.  Handle this case directly.
+        // for y small, positive root is k = abs(y)/sqrt(1-x^2)
+        k = 0;
+      }
+      return k;
+    }
+
+    GEOGRAPHICLIB_HD static real
+    InverseStart(const GeodesicCoeffs& g,
+                 real sbet1, real cbet1, real dn1,
+                 real sbet2, real cbet2, real dn2,
+                 real lam12, real slam12, real clam12,
+                 real& salp1, real& calp1,
+                 // Only updated if return val >= 0
+                 real& salp2, real& calp2,
+                 // Only updated for short lines
+                 real& dnm,
+                 // Scratch area of the right size
+                 real Ca[],
+                 // Use the SHORT_APPROX threshold
+                 bool approx,
+                 Geodesic::Stats* stats) {
+      using std::sqrt; using std::sin; using std::cos; using std::hypot;
+      using std::atan2; using std::fabs; using std::fmin; using std::fmax;
+      // Return a starting point for Newton's method in salp1 and calp1
+      // (function value is -1).  If Newton's method doesn't need to be used,
+      // return also salp2 and calp2 and function value is sig12.
+      real
+        sig12 = -1,               // Return value
+        // bet12 = bet2 - bet1 in [0, pi); bet12a = bet2 + bet1 in (-pi, 0]
+        sbet12 = sbet2 * cbet1 - cbet2 * sbet1,
+        cbet12 = cbet2 * cbet1 + sbet2 * sbet1;
+      real sbet12a = sbet2 * cbet1 + cbet2 * sbet1;
+      bool shortline = cbet12 >= 0 && sbet12 < real(0.5) &&
+        cbet2 * lam12 < real(0.5);
+      real somg12, comg12;
+      if (shortline) {
+        real sbetm2 = sq(sbet1 + sbet2);
+        // sin((bet1+bet2)/2)^2
+        // =  (sbet1 + sbet2)^2 / ((sbet1 + sbet2)^2 + (cbet1 + cbet2)^2)
+        sbetm2 /= sbetm2 + sq(cbet1 + cbet2);
+        dnm = sqrt(1 + g._ep2 * sbetm2);
+        real omg12 = lam12 / (g._f1 * dnm);
+        somg12 = sin(omg12); comg12 = cos(omg12);
+      } else {
+        somg12 = slam12; comg12 = clam12;
+      }
+
+      salp1 = cbet2 * somg12;
+      calp1 = comg12 >= 0 ?
+        sbet12 + cbet2 * sbet1 * sq(somg12) / (1 + comg12) :
+        sbet12a - cbet2 * sbet1 * sq(somg12) / (1 - comg12);
+
+      real
+        ssig12 = hypot(salp1, calp1),
+        csig12 = sbet1 * sbet2 + cbet1 * cbet2 * comg12;
+
+      if (shortline && ssig12 < (approx ? g._stol2 : g._etol2)) {
+        // really short lines
+        salp2 = cbet1 * somg12;
+        calp2 = sbet12 - cbet1 * sbet2 *
+          (comg12 >= 0 ? sq(somg12) / (1 + comg12) : 1 - comg12);
+        norm(salp2, calp2);
+        // Set return value
+        sig12 = atan2(ssig12, csig12);
+      } else if (fabs(g._n) > real(0.1) || // Skip astroid calc if too eccentric
+                 csig12 >= 0 ||
+                 ssig12 >= 6 * fabs(g._n) * pi() * sq(cbet1)) {
+        // Nothing to do, zeroth order spherical approximation is OK
+      } else {
+        // Scale lam12 and bet2 to x, y coordinate system where antipodal point
+        // is at origin and singular point is at y = 0, x = -1.
+        real x, y, lamscale, betscale;
+        real lam12x = atan2(-slam12, -clam12); // lam12 - pi
+        if (g._f >= 0) {            // In fact f == 0 does not get here
+          // x = dlong, y = dlat
+          {
+            real
+              k2 = sq(sbet1) * g._ep2,
+              eps = k2 / (2 * (1 + sqrt(1 + k2)) + k2);
+            lamscale = g._f * cbet1 * A3f(g, eps) * pi();
+          }
+          betscale = lamscale * cbet1;
+
+          x = lam12x / lamscale;
+          y = sbet12a / betscale;
+        } else {                  // _f < 0
+          // x = dlat, y = dlong
+          real
+            cbet12a = cbet2 * cbet1 - sbet2 * sbet1,
+            bet12a = atan2(sbet12a, cbet12a);
+          real m12b, m0, dummy;
+          // In the case of lon12 = 180, this repeats a calculation made in
+          // Inverse.
+          Lengths(g, g._n, pi() + bet12a,
+                  sbet1, -cbet1, dn1, sbet2, cbet2, dn2,
+                  cbet1, cbet2,
+                  REDUCEDLENGTH, dummy, m12b, m0, dummy, dummy, Ca);
+          x = -1 + m12b / (cbet1 * cbet2 * m0 * pi());
+          betscale = x < -real(0.01) ? sbet12a / x :
+            -g._f * sq(cbet1) * pi();
+          lamscale = betscale / cbet1;
+          y = lam12x / lamscale;
+        }
+
+        if (y > -g.tol1_ && x > -1 - g.xthresh_) {
+          // strip near cut
+          // Need real(x) here to cast away the volatility of x for min/max
+          if (g._f >= 0) {
+            salp1 = fmin(real(1), -x); calp1 = - sqrt(1 - sq(salp1));
+          } else {
+            calp1 = fmax(real(x > -g.tol1_ ? 0 : -1), x);
+            salp1 = sqrt(1 - sq(calp1));
+          }
+        } else {
+          // Estimate alp1, by solving the astroid problem.
+          //
+          // Could estimate alpha1 = theta + pi/2, directly, i.e.,
+          //   calp1 = y/k; salp1 = -x/(1+k);  for _f >= 0
+          //   calp1 = x/(1+k); salp1 = -y/k;  for _f < 0 (need to check)
+          //
+          // However, it's better to estimate omg12 from astroid and use
+          // spherical formula to compute alp1.  This reduces the mean number of
+          // Newton iterations for astroid cases from 2.24 (min 0, max 6) to
+          // 2.12 (min 0 max 5).  The changes in the number of iterations are as
+          // follows:
+          //
+          // change percent
+          //    1       5
+          //    0      78
+          //   -1      16
+          //   -2       0.6
+          //   -3       0.04
+          //   -4       0.002
+          //
+          // The histogram of iterations is (m = number of iterations estimating
+          // alp1 directly, n = number of iterations estimating via omg12, total
+          // number of trials = 148605):
+          //
+          //  iter    m      n
+          //    0   148    186
+          //    1 13046  13845
+          //    2 93315 102225
+          //    3 36189  32341
+          //    4  5396      7
+          //    5   455      1
+          //    6    56      0
+          //
+          // Because omg12 is near pi, estimate work with omg12a = pi - omg12
+          if (stats) ++stats->astroid;
+          real k = Astroid(x, y);
+          real
+            omg12a = lamscale * ( g._f >= 0 ? -x * k/(1 + k) : -y * (1 + k)/k );
+          somg12 = sin(omg12a); comg12 = -cos(omg12a);
+          // Update spherical estimate of alp1 using omg12 instead of lam12
+          salp1 = cbet2 * somg12;
+          calp1 = sbet12a - cbet2 * sbet1 * sq(somg12) / (1 - comg12);
+        }
+      }
+      // Sanity check on starting guess.  Backwards check allows NaN through.
+      if (!(salp1 <= 0))
+        norm(salp1, calp1);
+      else {
+        salp1 = 1; calp1 = 0;
+      }
+      return sig12;
+    }
+
+    GEOGRAPHICLIB_HD static real
+    Lambda12(const GeodesicCoeffs& g,
+             real sbet1, real cbet1, real dn1,
+             real sbet2, real cbet2, real dn2,
+             real salp1, real calp1,
+             real slam120, real clam120,
+             real& salp2, real& calp2,
+             real& sig12,
+             real& ssig1, real& csig1,
+             real& ssig2, real& csig2,
+             real& eps, real& domg12,
+             bool diffp, real& dlam12,
+             // Scratch area of the right size
+             real Ca[]) {
+      using std::sqrt; using std::hypot; using std::atan2; using std::fabs;
+      using std::fmax;
+      if (sbet1 == 0 && calp1 == 0)
+        // Break degeneracy of equatorial line.  This case has already been
+        // handled.
+        calp1 = -g.tiny_;
+
+      real
+        // sin(alp1) * cos(bet1) = sin(alp0)
+        salp0 = salp1 * cbet1,
+        calp0 = hypot(calp1, salp1 * sbet1); // calp0 > 0
+
+      real somg1, comg1, somg2, comg2, somg12, comg12, lam12;
+      // tan(bet1) = tan(sig1) * cos(alp1)
+      // tan(omg1) = sin(alp0) * tan(sig1) = tan(omg1)=tan(alp1)*sin(bet1)
+      ssig1 = sbet1; somg1 = salp0 * sbet1;
+      csig1 = comg1 = calp1 * cbet1;
+      norm(ssig1, csig1);
+      // Math::norm(somg1, comg1); -- don't need to normalize!
+
+      // Enforce symmetries in the case abs(bet2) = -bet1.  Need to be careful
+      // about this case, since this can yield singularities in the Newton
+      // iteration.
+      // sin(alp2) * cos(bet2) = sin(alp0)
+      salp2 = cbet2 != cbet1 ? salp0 / cbet2 : salp1;
+      // calp2 = sqrt(1 - sq(salp2))
+      //       = sqrt(sq(calp0) - sq(sbet2)) / cbet2
+      // and subst for calp0 and rearrange to give (choose positive sqrt
+      // to give alp2 in [0, pi/2]).
+      calp2 = cbet2 != cbet1 || fabs(sbet2) != -sbet1 ?
+        sqrt(sq(calp1 * cbet1) +
+             (cbet1 < -sbet1 ?
+              (cbet2 - cbet1) * (cbet1 + cbet2) :
+              (sbet1 - sbet2) * (sbet1 + sbet2))) / cbet2 :
+        fabs(calp1);
+      // tan(bet2) = tan(sig2) * cos(alp2)
+      // tan(omg2) = sin(alp0) * tan(sig2).
+      ssig2 = sbet2; somg2 = salp0 * sbet2;
+      csig2 = comg2 = calp2 * cbet2;
+      norm(ssig2, csig2);
+      // Math::norm(somg2, comg2); -- don't need to normalize!
+
+      // sig12 = sig2 - sig1, limit to [0, pi]
+      sig12 = atan2(fmax(real(0), csig1 * ssig2 - ssig1 * csig2) + real(0),
+                                  csig1 * csig2 + ssig1 * ssig2);
+
+      // omg12 = omg2 - omg1, limit to [0, pi]
+      somg12 = fmax(real(0), comg1 * somg2 - somg1 * comg2) + real(0);
+      comg12 =               comg1 * comg2 + somg1 * somg2;
+      // eta = omg12 - lam120
+      real eta = atan2(somg12 * clam120 - comg12 * slam120,
+                       comg12 * clam120 + somg12 * slam120);
+      real B312;
+      real k2 = sq(calp0) * g._ep2;
+      eps = k2 / (2 * (1 + sqrt(1 + k2)) + k2);
+      C3f(g, eps, Ca);
+      B312 = (SinCosSeries(true, ssig2, csig2, Ca, g._order-1) -
+              SinCosSeries(true, ssig1, csig1, Ca, g._order-1));
+      domg12 = -g._f * A3f(g, eps) * salp0 * (sig12 + B312);
+      lam12 = eta + domg12;
+
+      if (diffp) {
+        if (calp2 == 0)
+          dlam12 = - 2 * g._f1 * dn1 / sbet1;
+        else {
+          real dummy;
+          Lengths(g, eps, sig12, ssig1, csig1, dn1, ssig2, csig2, dn2,
+                  cbet1, cbet2, REDUCEDLENGTH,
+                  dummy, dlam12, dummy, dummy, dummy, Ca);
+          dlam12 *= g._f1 / (calp2 * cbet2);
+        }
+      }
+
+      return lam12;
+    }
+
+#if GEOGRAPHICLIB_PRECISION > 3
+    // Refine the starting guess for the solution of the inverse problem
+    // using doubles.  This is only used on the host.
+    static void DoubleStart(const GeodesicCoeffs& g,
+                            real sbet1, real cbet1, real dn1,
+                            real sbet2, real cbet2, real dn2,
+                            real slam120, real clam120,
+                            real& salp1, real& calp1) {
+      using std::sqrt; using std::sin; using std::cos; using std::hypot;
+      using std::atan2; using std::fabs; using std::fmax;
+      // Refine the starting guess for Newton's method by carrying out the
+      // iteration with doubles.  This follows Lambda12 except that the
+      // derivative is computed with J12 correct to first order in eps; this
+      // is still accurate to O(eps^2) and the resulting convergence is fast.
+      // The starting guess is only changed if the iteration converges.
+      typedef double T;
+      static const T
+        tiny = sqrt(std::numeric_limits<T>::min()),
+        tol = 8 * std::numeric_limits<T>::epsilon();
+      const T sb1 = T(sbet1), cb1 = T(cbet1), d1 = T(dn1),
+        sb2 = T(sbet2), cb2 = T(cbet2), d2 = T(dn2),
+        sl12 = T(slam120), cl12 = T(clam120),
+        f = T(g._f), f1 = T(g._f1), ep2 = T(g._ep2);
+      T sa1 = T(salp1), ca1 = T(calp1), Ca[N + 1];
+      const int maxit = 10;
+      for (int numit = 0; numit < maxit; ++numit) {
+        if (sb1 == 0 && ca1 == 0) ca1 = -tiny;
+        T
+          sa0 = sa1 * cb1,
+          ca0 = hypot(ca1, sa1 * sb1),
+          ss1 = sb1, cs1 = ca1 * cb1, so1 = sa0 * sb1, co1 = cs1,
+          ca2 = cb2 != cb1 || fabs(sb2) != -sb1 ?
+          sqrt(Math::sq(ca1 * cb1) +
+               (cb1 < -sb1 ?
+                (cb2 - cb1) * (cb1 + cb2) :
+                (sb1 - sb2) * (sb1 + sb2))) / cb2 :
+          fabs(ca1),
+          ss2 = sb2, cs2 = ca2 * cb2, so2 = sa0 * sb2, co2 = cs2;
+        Math::norm(ss1, cs1); Math::norm(ss2, cs2);
+        T
+          sig12 = atan2(fmax(T(0), cs1 * ss2 - ss1 * cs2) + T(0),
+                        cs1 * cs2 + ss1 * ss2),
+          so12 = fmax(T(0), co1 * so2 - so1 * co2) + T(0),
+          co12 = co1 * co2 + so1 * so2,
+          eta = atan2(so12 * cl12 - co12 * sl12, co12 * cl12 + so12 * sl12),
+          k2 = Math::sq(ca0) * ep2,
+          eps = k2 / (2 * (1 + sqrt(1 + k2)) + k2);
+        // C3f and A3f with the double copies of the coefficients
+        {
+          T mult = 1;
+          for (int l = 1, o = 0; l < g._order; ++l) {
+            int m = N - l - 1, mo = g._order - l - 1;
+            mult *= eps;
+            Ca[l] = mult * Math::polyval(mo, g._cC3xd + o + (m - mo), eps);
+            o += m + 1;
+          }
+        }
+        T
+          B312 = SinCosSeries(true, ss2, cs2, Ca, g._order-1) -
+          SinCosSeries(true, ss1, cs1, Ca, g._order-1),
+          v = eta - f *
+          Math::polyval(g._order - 1, g._aA3xd + (N - g._order), eps) *
+          sa0 * (sig12 + B312);
+        if (!(fabs(v) >= tol)) {
+          // Converged
+          salp1 = real(sa1); calp1 = real(ca1);
+          Math::norm(salp1, calp1);
+          return;
+        }
+        T dv;
+        if (ca2 == 0)
+          dv = - 2 * f1 * d1 / sb1;
+        else {
+          T
+            // J12 = 2*eps*sig12 - eps*(sin(2*sig2) - sin(2*sig1)) + O(eps^2)
+            J12 = 2 * eps * (sig12 - (ss2 * cs2 - ss1 * cs1)),
+            m12b = d2 * (cs1 * ss2) - d1 * (ss1 * cs2) - cs1 * cs2 * J12;
+          dv = m12b * f1 / (ca2 * cb2);
+        }
+        if (!(dv > 0)) break;
+        T dalp1 = -v/dv;
+        if (!(fabs(dalp1) < Math::pi<T>())) break;
+        T sdalp1 = sin(dalp1), cdalp1 = cos(dalp1),
+          nsa1 = sa1 * cdalp1 + ca1 * sdalp1;
+        if (!(nsa1 > 0)) break;
+        ca1 = ca1 * cdalp1 - sa1 * sdalp1;
+        sa1 = nsa1;
+        Math::norm(sa1, ca1);
+      }
+    }
+#endif
+
+    // The inverse calculation of Geodesic::GenInverse for exact = false,
+    // returning the sines and cosines of the azimuths.  If t1 (t2) is not
+    // null, it holds the terms for lat1 (lat2) computed by
+    // Geodesic::LatSetup.  If warm is not null and valid and its frame
+    // matches, its correction is applied to the starting guess for Newton's
+    // method; it is updated whenever Newton's method is used.  The counts of
+    // the paths taken are added to *stats if stats is not null.
+    GEOGRAPHICLIB_HD static real
+    GenInverse(const GeodesicCoeffs& g,
+               real lat1, real lon1, real lat2, real lon2,
+               unsigned outmask, real& s12,
+               real& salp1, real& calp1,
+               real& salp2, real& calp2,
+               real& m12, real& M12, real& M21,
+               real& S12, const Geodesic::LatTerms* t1,
+               const Geodesic::LatTerms* t2, Geodesic::WarmStart* warm,
+               Geodesic::Stats* stats) {
+      using std::sqrt; using std::sin; using std::cos; using std::hypot;
+      using std::atan2; using std::fabs; using std::fmax;
+      using std::copysign; using std::signbit; using std::isnan;
+      using std::isfinite;
+      // Compute longitude difference (AngDiff does this carefully).
+      real lon12s, lon12 = AngDiff(lon1, lon2, lon12s);
+      // Make longitude difference positive.
+      int lonsign = signbit(lon12) ? -1 : 1;
+      lon12 *= lonsign; lon12s *= lonsign;
+      real
+        lam12 = lon12 * degree(),
+        slam12, clam12;
+      // Calculate sincos of lon12 + error (this applies AngRound internally).
+      sincosde(lon12, lon12s, slam12, clam12);
+      // the supplementary longitude difference
+      lon12s = (Math::hd - lon12) - lon12s;
+
+      // If really close to the equator, treat as on equator.
+      lat1 = AngRound(LatFix(lat1));
+      lat2 = AngRound(LatFix(lat2));
+      // Swap points so that point with higher (abs) latitude is point 1.
+      // If one latitude is a nan, then it becomes lat1.
+      int swapp = fabs(lat1) < fabs(lat2) || isnan(lat2) ? -1 : 1;
+      if (swapp < 0) {
+        lonsign *= -1;
+        swap(lat1, lat2);
+        swap(t1, t2);
+      }
+      // Make lat1 <= -0
+      int latsign = signbit(lat1) ? 1 : -1;
+      lat1 *= latsign;
+      lat2 *= latsign;
+      // Now we have
+      //
+      //     0 <= lon12 <= 180
+      //     -90 <= lat1 <= -0
+      //     lat1 <= lat2 <= -lat1
+      //
+      // longsign, swapp, latsign register the transformation to bring the
+      // coordinates to this canonical form.  In all cases, 1 means no change
+      // was made.  We make these transformations so that there are few cases to
+      // check, e.g., on verifying quadrants in atan2.  In addition, this
+      // enforces some symmetries in the results returned.
+
+      real sbet1, cbet1, sbet2, cbet2, dn1, dn2, s12x, m12x;
+
+      if (t1) {
+        int k = signbit(lat1);
+        sbet1 = t1->sbet[k]; cbet1 = t1->cbet[k]; dn1 = t1->dn[k];
+      } else {
+        sincosd(lat1, sbet1, cbet1); sbet1 *= g._f1;
+        // Ensure cbet1 = +epsilon at poles; doing the fix on beta means that
+        // sig12 will be <= 2*tiny for two points at the same pole.
+        norm(sbet1, cbet1); cbet1 = fmax(g.tiny_, cbet1);
+        dn1 = sqrt(1 + g._ep2 * sq(sbet1));
+      }
+
+      if (t2) {
+        int k = signbit(lat2);
+        sbet2 = t2->sbet[k]; cbet2 = t2->cbet[k]; dn2 = t2->dn[k];
+      } else {
+        sincosd(lat2, sbet2, cbet2); sbet2 *= g._f1;
+        // Ensure cbet2 = +epsilon at poles
+        norm(sbet2, cbet2); cbet2 = fmax(g.tiny_, cbet2);
+        dn2 = sqrt(1 + g._ep2 * sq(sbet2));
+      }
+
+      // If cbet1 < -sbet1, then cbet2 - cbet1 is a sensitive measure of the
+      // |bet1| - |bet2|.  Alternatively (cbet1 >= -sbet1), abs(sbet2) + sbet1
+      // is a better measure.  This logic is used in assigning calp2 in
+      // Lambda12. Sometimes these quantities vanish and in that case we force
+      // bet2 = +/- bet1 exactly.  An example where is is necessary is the
+      // inverse problem 48.522876735459 0 -48.52287673545898293
+      // 179.599720456223079643 which failed with Visual Studio 10 (Release and
+      // Debug)
+
+      if (cbet1 < -sbet1) {
+        if (cbet2 == cbet1) {
+          sbet2 = copysign(sbet1, sbet2); dn2 = dn1;
+        }
+      } else {
+        if (fabs(sbet2) == -sbet1)
+          cbet2 = cbet1;
+      }
+
+      real a12, sig12;
+      // index zero element of this array is unused
+      real Ca[N + 1];
+
+      if (stats) ++stats->inverse;
+      bool meridian = lat1 == -Math::qd || slam12 == 0;
+
+      if (meridian) {
+
+        // Endpoints are on a single full meridian, so the geodesic might lie on
+        // a meridian.
+
+        calp1 = clam12; salp1 = slam12; // Head to the target longitude
+        calp2 = 1; salp2 = 0;           // At the target we're heading north
+
+        real
+          // tan(bet) = tan(sig) * cos(alp)
+          ssig1 = sbet1, csig1 = calp1 * cbet1,
+          ssig2 = sbet2, csig2 = calp2 * cbet2;
+
+        // sig12 = sig2 - sig1
+        sig12 = atan2(fmax(real(0), csig1 * ssig2 - ssig1 * csig2) + real(0),
+                                    csig1 * csig2 + ssig1 * ssig2);
+        {
+          real dummy;
+          Lengths(g, g._n, sig12, ssig1, csig1, dn1, ssig2, csig2, dn2,
+                  cbet1, cbet2, outmask | DISTANCE | REDUCEDLENGTH,
+                  s12x, m12x, dummy, M12, M21, Ca);
+        }
+        // Add the check for sig12 since zero length geodesics might yield m12 <
+        // 0.  Test case was
+        //
+        //    echo 20.001 0 20.001 0 | GeodSolve -i
+        //
+        // In fact, we will have sig12 > pi/2 for meridional geodesic which is
+        // not a shortest path.
+        // TODO: investigate m12 < 0 result for aarch/ppc (with -f -p 20)
+        // 20.001000000000001 0.000000000000000 180.000000000000000
+        // 20.001000000000001 0.000000000000000 180.000000000000000
+        // 0.0000000002 0.000000000000001 -0.0000000001
+        // 0.99999999999999989 0.99999999999999989 0.000
+        if (sig12 < 1 || m12x >= 0) {
+          // Need at least 2, to handle 90 0 90 180
+          if (sig12 < 3 * g.tiny_ ||
+              // Prevent negative s12 or m12 for short lines
+              (sig12 < g.tol0_ && (s12x < 0 || m12x < 0)))
+            sig12 = m12x = s12x = 0;
+          m12x *= g._b;
+          s12x *= g._b;
+          a12 = sig12 / degree();
+          if (stats) ++stats->meridional;
+        } else
+          // m12 < 0, i.e., prolate and too close to anti-podal
+          meridian = false;
+      }
+
+      // somg12 == 2 marks that it needs to be calculated
+      real omg12 = 0, somg12 = 2, comg12 = 0;
+      if (!meridian &&
+          sbet1 == 0 &&   // and sbet2 == 0
+          (g._f <= 0 || lon12s >= g._f * Math::hd)) {
+
+        // Geodesic runs along equator
+        calp1 = calp2 = 0; salp1 = salp2 = 1;
+        s12x = g._a * lam12;
+        sig12 = omg12 = lam12 / g._f1;
+        m12x = g._b * sin(sig12);
+        if (outmask & GEODESICSCALE)
+          M12 = M21 = cos(sig12);
+        a12 = lon12 / g._f1;
+        if (stats) ++stats->equatorial;
+
+      } else if (!meridian) {
+
+        // Now point1 and point2 belong within a hemisphere bounded by a
+        // meridian and geodesic is neither meridional or equatorial.
+
+        // Figure a starting point for Newton's method
+        real dnm;
+        sig12 = InverseStart(g, sbet1, cbet1, dn1, sbet2, cbet2, dn2,
+                             lam12, slam12, clam12,
+                             salp1, calp1, salp2, calp2, dnm,
+                             Ca,
+                             // The short line approximation to omg12 isn't
+                             // accurate enough for the area
+                             (outmask & (SHORT_APPROX | AREA)) == SHORT_APPROX,
+                             stats);
+
+        // Starting guess from InverseStart (used to find the correction
+        // carried to the next problem).
+        real salp1s = salp1, calp1s = calp1;
+        // A warm start from a neighboring problem in the same canonical frame
+        // is only used when Newton's method is needed: the correction to the
+        // starting guess found for that problem is applied to this one.  It
+        // is always safe because the root is bracketed.
+        bool warmp = sig12 < 0 && warm && warm->valid &&
+          warm->lonsign == lonsign && warm->swapp == swapp &&
+          warm->latsign == latsign;
+        if (warmp) {
+          real nsalp1 = salp1 * warm->cdalp1 + calp1 * warm->sdalp1;
+          if (nsalp1 > 0) {
+            calp1 = calp1 * warm->cdalp1 - salp1 * warm->sdalp1;
+            salp1 = nsalp1;
+            norm(salp1, calp1);
+          } else
+            warmp = false;
+        }
+#if GEOGRAPHICLIB_PRECISION > 3
+        if (sig12 < 0 && !warmp)
+          DoubleStart(g, sbet1, cbet1, dn1, sbet2, cbet2, dn2, slam12, clam12,
+                      salp1, calp1);
+#endif
+
+        if (sig12 >= 0) {
+          // Short lines (InverseStart sets salp2, calp2, dnm)
+          s12x = sig12 * g._b * dnm;
+          m12x = sq(dnm) * g._b * sin(sig12 / dnm);
+          if (outmask & GEODESICSCALE)
+            M12 = M21 = cos(sig12 / dnm);
+          a12 = sig12 / degree();
+          omg12 = lam12 / (g._f1 * dnm);
+          if (stats) ++stats->shortline;
+        } else {
+
+          // Newton's method.  This is a straightforward solution of f(alp1) =
+          // lambda12(alp1) - lam12 = 0 with one wrinkle.  f(alp) has exactly
+          // one root in the interval (0, pi) and its derivative is positive at
+          // the root.  Thus f(alp) is positive for alp > alp1 and negative for
+          // alp < alp1.  During the course of the iteration, a range (alp1a,
+          // alp1b) is maintained which brackets the root and with each
+          // evaluation of f(alp) the range is shrunk, if possible.  Newton's
+          // method is restarted whenever the derivative of f is negative
+          // (because the new value of alp1 is then further from the solution)
+          // or if the new estimate of alp1 lies outside (0,pi); in this case,
+          // the new starting guess is taken to be (alp1a + alp1b) / 2.
+          //
+          // initial values to suppress warnings (if loop is executed 0 times)
+          real ssig1 = 0, csig1 = 0, ssig2 = 0, csig2 = 0, eps = 0, domg12 = 0;
+          unsigned numit = 0;
+          // The derivative at the starting guess
+          real dv0 = 0;
+          // Bracketing range
+          real salp1a = g.tiny_, calp1a = 1, salp1b = g.tiny_, calp1b = -1;
+          for (bool tripn = false, tripb = false;; ++numit) {
+            // the WGS84 test set: mean = 1.47, sd = 1.25, max = 16
+            // WGS84 and random input: mean = 2.85, sd = 0.60
+            real dv = 0;
+            real v = Lambda12(g, sbet1, cbet1, dn1, sbet2, cbet2, dn2,
+                              salp1, calp1, slam12, clam12,
+                              salp2, calp2, sig12, ssig1, csig1, ssig2, csig2,
+                              eps, domg12, numit < g.maxit1_, dv, Ca);
+            if (numit == 0) dv0 = dv;
+            if (tripb ||
+                // Reversed test to allow escape with NaNs
+                !(fabs(v) >= (tripn ? 8 : 1) * g.tol0_) ||
+                // Enough bisections to get accurate result
+                numit == g.maxit2_)
+              break;
+            // Update bracketing values
+            if (v > 0 && (numit > g.maxit1_ || calp1/salp1 > calp1b/salp1b))
+              { salp1b = salp1; calp1b = calp1; }
+            else if (v < 0 &&
+                     (numit > g.maxit1_ || calp1/salp1 < calp1a/salp1a))
+              { salp1a = salp1; calp1a = calp1; }
+            if (numit < g.maxit1_ && dv > 0) {
+              real
+                dalp1 = -v/dv;
+              // |dalp1| < pi test moved earlier because GEOGRAPHICLIB_PRECISION
+              // = 5 can result in dalp1 = 10^(10^8).  Then sin(dalp1) takes
+              // ages (because of the need to do accurate range reduction).
+              if (fabs(dalp1) < pi()) {
+                real
+                  sdalp1 = sin(dalp1), cdalp1 = cos(dalp1),
+                  nsalp1 = salp1 * cdalp1 + calp1 * sdalp1;
+                if (nsalp1 > 0) {
+                  calp1 = calp1 * cdalp1 - salp1 * sdalp1;
+                  salp1 = nsalp1;
+                  norm(salp1, calp1);
+                  // In some regimes we don't get quadratic convergence because
+                  // slope -> 0.  So use convergence conditions based on epsilon
+                  // instead of sqrt(epsilon).
+                  tripn = fabs(v) <= 16 * g.tol0_;
+                  if (stats) ++stats->newton;
+                  continue;
+                }
+              }
+            }
+            // Either dv was not positive or updated value was outside legal
+            // range.  Use the midpoint of the bracket as the next estimate.
+            // This mechanism is not needed for the WGS84 ellipsoid, but it does
+            // catch problems with more eccentric ellipsoids.  Its efficacy is
+            // such for the WGS84 test set with the starting guess set to alp1 =
+            // 90deg:
+            // the WGS84 test set: mean = 5.21, sd = 3.93, max = 24
+            // WGS84 and random input: mean = 4.74, sd = 0.99
+            salp1 = (salp1a + salp1b)/2;
+            calp1 = (calp1a + calp1b)/2;
+            norm(salp1, calp1);
+            tripn = false;
+            tripb = (fabs(salp1a - salp1) + (calp1a - calp1) < g.tolb_ ||
+                     fabs(salp1 - salp1b) + (calp1 - calp1b) < g.tolb_);
+            if (stats) ++stats->bisection;
+          }
+          if (warm) {
+            // The correction alp1 - alp1s to the starting guess
+            warm->sdalp1 = salp1 * calp1s - calp1 * salp1s;
+            warm->cdalp1 = calp1 * calp1s + salp1 * salp1s;
+            warm->lonsign = lonsign; warm->swapp = swapp;
+            warm->latsign = latsign;
+            // The correction is only carried forward if it is significant
+            // compared to the tolerance on lam12; otherwise it is noise (and
+            // the starting guess is already good enough).
+            warm->valid = fabs(warm->sdalp1) * dv0 > 16 * g.tol0_ &&
+              isfinite(warm->cdalp1);
+          }
+          {
+            real dummy;
+            // Ensure that the reduced length and geodesic scale are computed in
+            // a "canonical" way, with the I2 integral.
+            unsigned lengthmask = outmask |
+              (outmask & (REDUCEDLENGTH | GEODESICSCALE) ? DISTANCE : NONE);
+            Lengths(g, eps, sig12, ssig1, csig1, dn1, ssig2, csig2, dn2,
+                    cbet1, cbet2, lengthmask, s12x, m12x, dummy, M12, M21, Ca);
+          }
+          m12x *= g._b;
+          s12x *= g._b;
+          a12 = sig12 / degree();
+          if (outmask & AREA) {
+            // omg12 = lam12 - domg12
+            real sdomg12 = sin(domg12), cdomg12 = cos(domg12);
+            somg12 = slam12 * cdomg12 - clam12 * sdomg12;
+            comg12 = clam12 * cdomg12 + slam12 * sdomg12;
+          }
+        }
+      }
+
+      if (outmask & DISTANCE)
+        s12 = real(0) + s12x;     // Convert -0 to 0
+
+      if (outmask & REDUCEDLENGTH)
+        m12 = real(0) + m12x;     // Convert -0 to 0
+
+      if (outmask & AREA) {
+        real
+          // From Lambda12: sin(alp1) * cos(bet1) = sin(alp0)
+          salp0 = salp1 * cbet1,
+          calp0 = hypot(calp1, salp1 * sbet1); // calp0 > 0
+        real alp12;
+        if (calp0 != 0 && salp0 != 0) {
+          real
+            // From Lambda12: tan(bet) = tan(sig) * cos(alp)
+            ssig1 = sbet1, csig1 = calp1 * cbet1,
+            ssig2 = sbet2, csig2 = calp2 * cbet2,
+            k2 = sq(calp0) * g._ep2,
+            eps = k2 / (2 * (1 + sqrt(1 + k2)) + k2),
+            // Multiplier = a^2 * e^2 * cos(alpha0) * sin(alpha0).
+            A4 = sq(g._a) * calp0 * salp0 * g._e2;
+          norm(ssig1, csig1);
+          norm(ssig2, csig2);
+          C4f(g, eps, Ca);
+          real
+            B41 = SinCosSeries(false, ssig1, csig1, Ca, g._order),
+            B42 = SinCosSeries(false, ssig2, csig2, Ca, g._order);
+          S12 = A4 * (B42 - B41);
+        } else
+          // Avoid problems with indeterminate sig1, sig2 on equator
+          S12 = 0;
+        if (!meridian && somg12 == 2) {
+          somg12 = sin(omg12); comg12 = cos(omg12);
+        }
+
+        if (!meridian &&
+            // omg12 < 3/4 * pi
+            comg12 > -real(0.7071) &&     // Long difference not too big
+            sbet2 - sbet1 < real(1.75)) { // Lat difference not too big
+          // Use tan(Gamma/2) = tan(omg12/2)
+          // * (tan(bet1/2)+tan(bet2/2))/(1+tan(bet1/2)*tan(bet2/2))
+          // with tan(x/2) = sin(x)/(1+cos(x))
+          real domg12 = 1 + comg12, dbet1 = 1 + cbet1, dbet2 = 1 + cbet2;
+          alp12 = 2 * atan2( somg12 * ( sbet1 * dbet2 + sbet2 * dbet1 ),
+                             domg12 * ( sbet1 * sbet2 + dbet1 * dbet2 ) );
+        } else {
+          // alp12 = alp2 - alp1, used in atan2 so no need to normalize
+          real
+            salp12 = salp2 * calp1 - calp2 * salp1,
+            calp12 = calp2 * calp1 + salp2 * salp1;
+          // The right thing appears to happen if alp1 = +/-180 and alp2 = 0,
+          // viz salp12 = -0 and alp12 = -180.  However this depends on the sign
+          // being attached to 0 correctly.  The following ensures the correct
+          // behavior.
+          if (salp12 == 0 && calp12 < 0) {
+            salp12 = g.tiny_ * calp1;
+            calp12 = -1;
+          }
+          alp12 = atan2(salp12, calp12);
+        }
+        S12 += g._c2 * alp12;
+        S12 *= swapp * lonsign * latsign;
+        // Convert -0 to 0
+        S12 += 0;
+      }
+
+      // Convert calp, salp to azimuth accounting for lonsign, swapp, latsign.
+      if (swapp < 0) {
+        swap(salp1, salp2);
+        swap(calp1, calp2);
+        if (outmask & GEODESICSCALE)
+          swap(M12, M21);
+      }
+
+      salp1 *= swapp * lonsign; calp1 *= swapp * latsign;
+      salp2 *= swapp * lonsign; calp2 *= swapp * latsign;
+      // Returned value in [0, 180]
+      return a12;
+    }
+
+    // The setup of GeodesicLine::LineInit; the series are skipped if
+    // g._exact.
+    GEOGRAPHICLIB_HD static void
+    LineInit(const GeodesicCoeffs& g, GeodesicLineCoeffs& l,
+             real lat1, real lon1,
+             real azi1, real salp1, real calp1,
+             unsigned caps) {
+      using std::sqrt; using std::sin; using std::cos; using std::hypot;
+      using std::fmax;
+      l.tiny_ = g.tiny_;
+      l._lat1 = LatFix(lat1);
+      l._lon1 = lon1;
+      l._azi1 = azi1;
+      l._salp1 = salp1;
+      l._calp1 = calp1;
+      l._a = g._a;
+      l._f = g._f;
+      l._b = g._b;
+      l._c2 = g._c2;
+      l._f1 = g._f1;
+      // Always allow latitude and azimuth and unrolling of longitude
+      l._caps = caps | LATITUDE | AZIMUTH | LONG_UNROLL;
+
+      real cbet1, sbet1;
+      sincosd(AngRound(l._lat1), sbet1, cbet1); sbet1 *= l._f1;
+      // Ensure cbet1 = +epsilon at poles
+      norm(sbet1, cbet1); cbet1 = fmax(l.tiny_, cbet1);
+      l._dn1 = sqrt(1 + g._ep2 * sq(sbet1));
+
+      // Evaluate alp0 from sin(alp1) * cos(bet1) = sin(alp0),
+      l._salp0 = l._salp1 * cbet1; // alp0 in [0, pi/2 - |bet1|]
+      // Alt: calp0 = hypot(sbet1, calp1 * cbet1).  The following
+      // is slightly better (consider the case salp1 = 0).
+      l._calp0 = hypot(l._calp1, l._salp1 * sbet1);
+      // Evaluate sig with tan(bet1) = tan(sig1) * cos(alp1).
+      // sig = 0 is nearest northward crossing of equator.
+      // With bet1 = 0, alp1 = pi/2, we have sig1 = 0 (equatorial line).
+      // With bet1 =  pi/2, alp1 = -pi, sig1 =  pi/2
+      // With bet1 = -pi/2, alp1 =  0 , sig1 = -pi/2
+      // Evaluate omg1 with tan(omg1) = sin(alp0) * tan(sig1).
+      // With alp0 in (0, pi/2], quadrants for sig and omg coincide.
+      // No atan2(0,0) ambiguity at poles since cbet1 = +epsilon.
+      // With alp0 = 0, omg1 = 0 for alp1 = 0, omg1 = pi for alp1 = pi.
+      l._ssig1 = sbet1; l._somg1 = l._salp0 * sbet1;
+      l._csig1 = l._comg1 = sbet1 != 0 || l._calp1 != 0 ? cbet1 * l._calp1 : 1;
+      norm(l._ssig1, l._csig1); // sig1 in (-pi, pi]
+      // Math::norm(_somg1, _comg1); -- don't need to normalize!
+
+      l._order = g._order;
+      // The series aren't used with exact = true (see GeodesicLine::LineInit)
+      if (g._exact) return;
+
+      l._k2 = sq(l._calp0) * g._ep2;
+      real eps = l._k2 / (2 * (1 + sqrt(1 + l._k2)) + l._k2);
+
+      if (l._caps & CAP_C1) {
+        l._aA1m1 = A1m1f(g._aA1m1x, eps, l._order);
+        CSeries(g._cC1x, eps, l._cC1a, l._order);
+        l._bB11 = SinCosSeries(true, l._ssig1, l._csig1, l._cC1a, l._order);
+        real s = sin(l._bB11), c = cos(l._bB11);
+        // tau1 = sig1 + B11
+        l._stau1 = l._ssig1 * c + l._csig1 * s;
+        l._ctau1 = l._csig1 * c - l._ssig1 * s;
+        // Not necessary because C1pa reverts C1a
+        //    _bB11 = -SinCosSeries(true, _stau1, _ctau1, _cC1pa, nC1p_);
+      }
+
+      if (l._caps & CAP_C1p)
+        CSeries(g._cC1px, eps, l._cC1pa, l._order);
+
+      if (l._caps & CAP_C2) {
+        l._aA2m1 = A2m1f(g._aA2m1x, eps, l._order);
+        CSeries(g._cC2x, eps, l._cC2a, l._order);
+        l._bB21 = SinCosSeries(true, l._ssig1, l._csig1, l._cC2a, l._order);
+      }
+
+      if (l._caps & CAP_C3) {
+        C3f(g, eps, l._cC3a);
+        l._aA3c = -l._f * l._salp0 * A3f(g, eps);
+        l._bB31 = SinCosSeries(true, l._ssig1, l._csig1, l._cC3a, l._order-1);
+      }
+
+      if (l._caps & CAP_C4) {
+        C4f(g, eps, l._cC4a);
+        // Multiplier = a^2 * e^2 * cos(alpha0) * sin(alpha0)
+        l._aA4 = sq(l._a) * l._calp0 * l._salp0 * g._e2;
+        l._bB41 = SinCosSeries(false, l._ssig1, l._csig1, l._cC4a, l._order);
+      }
+    }
+
+    // GeodesicLine::GenPosition for exact = false
+    GEOGRAPHICLIB_HD static real
+    GenPosition(const GeodesicLineCoeffs& l,
+                bool arcmode, real s12_a12, unsigned outmask,
+                real& lat2, real& lon2, real& azi2,
+                real& s12, real& m12, real& M12, real& M21,
+                real& S12) {
+      using std::sin; using std::cos;
+      outmask &= l._caps & OUT_MASK;
+      if (!( l._caps != 0U &&
+             (arcmode || (l._caps & (OUT_MASK & DISTANCE_IN))) ))
+        // Uninitialized or impossible distance calculation requested
+        return NaN();
+
+      // Avoid warning about uninitialized B12.
+      real sig12, ssig12, csig12, B12 = 0;
+      if (arcmode) {
+        // Interpret s12_a12 as spherical arc length
+        sig12 = s12_a12 * degree();
+        sincosd(s12_a12, ssig12, csig12);
+      } else {
+        // Interpret s12_a12 as distance
+        real tau12 = s12_a12 / (l._b * (1 + l._aA1m1));
+        DistanceSigma(l, s12_a12, tau12, sin(tau12), cos(tau12),
+                      sig12, ssig12, csig12, B12);
+      }
+      return SigmaPosition(l, arcmode, s12_a12, sig12, ssig12, csig12, B12,
+                           outmask, lat2, lon2, azi2,
+                           s12, m12, M12, M21, S12);
+    }
+
+    // The first half of GeodesicLine::GenPosition in distance mode: convert
+    // the distance s12 to the arc length sig12 (and its sine and cosine).
+    // tau12 = s12 / (b * (1 + A1m1)) with sine stau12 and cosine ctau12.
+    GEOGRAPHICLIB_HD static void
+    DistanceSigma(const GeodesicLineCoeffs& l, real s12, real tau12,
+                  real stau12, real ctau12,
+                  real& sig12, real& ssig12, real& csig12, real& B12) {
+      using std::sqrt; using std::sin; using std::cos; using std::fabs;
+      // tau2 = tau1 + tau12
+      B12 = - SinCosSeries(true,
+                           l._stau1 * ctau12 + l._ctau1 * stau12,
+                           l._ctau1 * ctau12 - l._stau1 * stau12,
+                           l._cC1pa, l._order);
+      sig12 = tau12 - (B12 - l._bB11);
+      ssig12 = sin(sig12); csig12 = cos(sig12);
+      if (fabs(l._f) > 0.01) {
+        // Reverted distance series is inaccurate for |f| > 1/100, so correct
+        // sig12 with 1 Newton iteration.  The following table shows the
+        // approximate maximum error for a = WGS_a() and various f relative to
+        // GeodesicExact.
+        //     erri = the error in the inverse solution (nm)
+        //     errd = the error in the direct solution (series only) (nm)
+        //     errda = the error in the direct solution
+        //             (series + 1 Newton) (nm)
+        //
+        //       f     erri  errd errda
+        //     -1/5    12e6 1.2e9  69e6
+        //     -1/10  123e3  12e6 765e3
+        //     -1/20   1110 108e3  7155
+        //     -1/50  18.63 200.9 27.12
+        //     -1/100 18.63 23.78 23.37
+        //     -1/150 18.63 21.05 20.26
+        //      1/150 22.35 24.73 25.83
+        //      1/100 22.35 25.03 25.31
+        //      1/50  29.80 231.9 30.44
+        //      1/20   5376 146e3  10e3
+        //      1/10  829e3  22e6 1.5e6
+        //      1/5   157e6 3.8e9 280e6
+        real
+          ssig2 = l._ssig1 * csig12 + l._csig1 * ssig12,
+          csig2 = l._csig1 * csig12 - l._ssig1 * ssig12;
+        B12 = SinCosSeries(true, ssig2, csig2, l._cC1a, l._order);
+        real serr = (1 + l._aA1m1) * (sig12 + (B12 - l._bB11)) - s12 / l._b;
+        sig12 = sig12 - serr / sqrt(1 + l._k2 * sq(ssig2));
+        ssig12 = sin(sig12); csig12 = cos(sig12);
+        // Update B12 in SigmaPosition
+      }
+    }
+
+    // The second half of GeodesicLine::GenPosition given the arc length
+    // sig12 (and its sine and cosine); outmask is already restricted to
+    // the capabilities of the line.
+    GEOGRAPHICLIB_HD static real
+    SigmaPosition(const GeodesicLineCoeffs& l, bool arcmode, real s12_a12,
+                  real sig12, real ssig12, real csig12, real B12,
+                  unsigned outmask,
+                  real& lat2, real& lon2, real& azi2,
+                  real& s12, real& m12, real& M12, real& M21,
+                  real& S12) {
+      using std::sqrt; using std::hypot;
+      using std::atan2; using std::fabs; using std::copysign;
+      real AB1 = 0;
+      real ssig2, csig2, sbet2, cbet2, salp2, calp2;
+      // sig2 = sig1 + sig12
+      ssig2 = l._ssig1 * csig12 + l._csig1 * ssig12;
+      csig2 = l._csig1 * csig12 - l._ssig1 * ssig12;
+      real dn2 = sqrt(1 + l._k2 * sq(ssig2));
+      if (outmask & (DISTANCE | REDUCEDLENGTH | GEODESICSCALE)) {
+        if (arcmode || fabs(l._f) > 0.01)
+          B12 = SinCosSeries(true, ssig2, csig2, l._cC1a, l._order);
+        AB1 = (1 + l._aA1m1) * (B12 - l._bB11);
+      }
+      // sin(bet2) = cos(alp0) * sin(sig2)
+      sbet2 = l._calp0 * ssig2;
+      // Alt: cbet2 = hypot(csig2, salp0 * ssig2);
+      cbet2 = hypot(l._salp0, l._calp0 * csig2);
+      if (cbet2 == 0)
+        // I.e., salp0 = 0, csig2 = 0.  Break the degeneracy in this case
+        cbet2 = csig2 = l.tiny_;
+      // tan(alp0) = cos(sig2)*tan(alp2)
+      salp2 = l._salp0; calp2 = l._calp0 * csig2; // No need to normalize
+
+      if (outmask & DISTANCE)
+        s12 = arcmode ? l._b * ((1 + l._aA1m1) * sig12 + AB1) : s12_a12;
+
+      if (outmask & LONGITUDE) {
+        // tan(omg2) = sin(alp0) * tan(sig2)
+        real somg2 = l._salp0 * ssig2, comg2 = csig2,  // No need to normalize
+          E = copysign(real(1), l._salp0);       // east-going?
+        // omg12 = omg2 - omg1
+        real omg12 = outmask & LONG_UNROLL
+          ? E * (sig12
+                 - (atan2(    ssig2, csig2) - atan2(    l._ssig1, l._csig1))
+                 + (atan2(E * somg2, comg2) - atan2(E * l._somg1, l._comg1)))
+          : atan2(somg2 * l._comg1 - comg2 * l._somg1,
+                  comg2 * l._comg1 + somg2 * l._somg1);
+        real lam12 = omg12 + l._aA3c *
+          ( sig12 + (SinCosSeries(true, ssig2, csig2, l._cC3a, l._order-1)
+                     - l._bB31));
+        real lon12 = lam12 / degree();
+        lon2 = outmask & LONG_UNROLL ? l._lon1 + lon12 :
+          AngNormalize(AngNormalize(l._lon1) + AngNormalize(lon12));
+      }
+
+      if (outmask & LATITUDE)
+        lat2 = atan2d(sbet2, l._f1 * cbet2);
+
+      if (outmask & AZIMUTH)
+        azi2 = atan2d(salp2, calp2);
+
+      if (outmask & (REDUCEDLENGTH | GEODESICSCALE)) {
+        real
+          B22 = SinCosSeries(true, ssig2, csig2, l._cC2a, l._order),
+          AB2 = (1 + l._aA2m1) * (B22 - l._bB21),
+          J12 = (l._aA1m1 - l._aA2m1) * sig12 + (AB1 - AB2);
+        if (outmask & REDUCEDLENGTH)
+          // Add parens around (_csig1 * ssig2) and (_ssig1 * csig2) to ensure
+          // accurate cancellation in the case of coincident points.
+          m12 = l._b * ((dn2 * (l._csig1 * ssig2) - l._dn1 * (l._ssig1 * csig2))
+                        - l._csig1 * csig2 * J12);
+        if (outmask & GEODESICSCALE) {
+          real t = l._k2 * (ssig2 - l._ssig1) * (ssig2 + l._ssig1) /
+            (l._dn1 + dn2);
+          M12 = csig12 + (t *    ssig2 -    csig2 * J12) * l._ssig1 / l._dn1;
+          M21 = csig12 - (t * l._ssig1 - l._csig1 * J12) *    ssig2 /    dn2;
+        }
+      }
+
+      if (outmask & AREA) {
+        real
+          B42 = SinCosSeries(false, ssig2, csig2, l._cC4a, l._order);
+        real salp12, calp12;
+        if (l._calp0 == 0 || l._salp0 == 0) {
+          // alp12 = alp2 - alp1, used in atan2 so no need to normalize
+          salp12 = salp2 * l._calp1 - calp2 * l._salp1;
+          calp12 = calp2 * l._calp1 + salp2 * l._salp1;
+          // We used to include here some patch up code that purported to deal
+          // with nearly meridional geodesics properly.  However, this turned
+          // out to be wrong once _salp1 = -0 was allowed (via
+          // Geodesic::InverseLine).  In fact, the calculation of {s,c}alp12
+          // was already correct (following the IEEE rules for handling signed
+          // zeros).  So the patch up code was unnecessary (as well as
+          // dangerous).
+        } else {
+          // tan(alp) = tan(alp0) * sec(sig)
+          // tan(alp2-alp1) = (tan(alp2) -tan(alp1)) / (tan(alp2)*tan(alp1)+1)
+          // = calp0 * salp0 * (csig1-csig2) / (salp0^2 + calp0^2 * csig1*csig2)
+          // If csig12 > 0, write
+          //   csig1 - csig2 = ssig12 * (csig1 * ssig12 / (1 + csig12) + ssig1)
+          // else
+          //   csig1 - csig2 = csig1 * (1 - csig12) + ssig12 * ssig1
+          // No need to normalize
+          salp12 = l._calp0 * l._salp0 *
+            (csig12 <= 0 ? l._csig1 * (1 - csig12) + ssig12 * l._ssig1 :
+             ssig12 * (l._csig1 * ssig12 / (1 + csig12) + l._ssig1));
+          calp12 = sq(l._salp0) + sq(l._calp0) * l._csig1 * csig2;
+        }
+        S12 = l._c2 * atan2(salp12, calp12) + l._aA4 * (B42 - l._bB41);
+      }
+
+      return arcmode ? s12_a12 : sig12 / degree();
+    }
+
+  public:
+
+    /**
+     * The parameters of a Geodesic object for GeodesicKernel.
+     *
+     * @param[in] g the Geodesic object.
+     * @exception GeographicErr if \e g was constructed with \e exact = true.
+     * @return the GeodesicCoeffs struct for \e g.
+     *
+     * This is a host function.
+     **********************************************************************/
+    static GeodesicCoeffs Coefficients(const Geodesic& g) {
+      if (g._exact)
+        throw GeographicErr("GeodesicKernel doesn't support exact = true");
+      return g;
+    }
+
+    /**
+     * The general direct geodesic problem.
+     *
+     * @param[in] c the coefficients from GeodesicKernel::Coefficients.
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] azi1 azimuth at point 1 (degrees).
+     * @param[in] arcmode boolean flag determining the meaning of the \e
+     *   s12_a12.
+     * @param[in] s12_a12 if \e arcmode is false, this is the distance between
+     *   point 1 and point 2 (meters); otherwise it is the arc length between
+     *   point 1 and point 2 (degrees); it can be negative.
+     * @param[in] outmask a bitor'ed combination of Geodesic::mask values
+     *   specifying which of the following parameters should be set.
+     * @param[out] lat2 latitude of point 2 (degrees).
+     * @param[out] lon2 longitude of point 2 (degrees).
+     * @param[out] azi2 (forward) azimuth at point 2 (degrees).
+     * @param[out] s12 distance from point 1 to point 2 (meters).
+     * @param[out] m12 reduced length of geodesic (meters).
+     * @param[out] M12 geodesic scale of point 2 relative to point 1
+     *   (dimensionless).
+     * @param[out] M21 geodesic scale of point 1 relative to point 2
+     *   (dimensionless).
+     * @param[out] S12 area under the geodesic (meters<sup>2</sup>).
+     * @return \e a12 arc length from point 1 to point 2 (degrees).
+     *
+     * This is the calculation made by Geodesic::GenDirect.
+     **********************************************************************/
+    GEOGRAPHICLIB_HD static real
+    GenDirect(const GeodesicCoeffs& c,
+              real lat1, real lon1, real azi1,
+              bool arcmode, real s12_a12, unsigned outmask,
+              real& lat2, real& lon2, real& azi2,
+              real& s12, real& m12, real& M12, real& M21, real& S12) {
+      azi1 = AngNormalize(azi1);
+      real salp1, calp1;
+      // Guard against underflow in salp0.  Also -0 is converted to +0.
+      sincosd(AngRound(azi1), salp1, calp1);
+      GeodesicLineCoeffs l;
+      // Automatically supply DISTANCE_IN if necessary
+      LineInit(c, l, lat1, lon1, azi1, salp1, calp1,
+               outmask | (arcmode ? NONE : DISTANCE_IN));
+      return GenPosition(l, arcmode, s12_a12, outmask,
+                         lat2, lon2, azi2, s12, m12, M12, M21, S12);
+    }
+
+    /**
+     * The general inverse geodesic problem.
+     *
+     * @param[in] c the coefficients from GeodesicKernel::Coefficients.
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] lat2 latitude of point 2 (degrees).
+     * @param[in] lon2 longitude of point 2 (degrees).
+     * @param[in] outmask a bitor'ed combination of Geodesic::mask values
+     *   specifying which of the following parameters should be set.
+     * @param[out] s12 distance from point 1 to point 2 (meters).
+     * @param[out] azi1 azimuth at point 1 (degrees).
+     * @param[out] azi2 (forward) azimuth at point 2 (degrees).
+     * @param[out] m12 reduced length of geodesic (meters).
+     * @param[out] M12 geodesic scale of point 2 relative to point 1
+     *   (dimensionless).
+     * @param[out] M21 geodesic scale of point 1 relative to point 2
+     *   (dimensionless).
+     * @param[out] S12 area under the geodesic (meters<sup>2</sup>).
+     * @return \e a12 arc length from point 1 to point 2 (degrees).
+     *
+     * This is the calculation made by Geodesic::GenInverse.  The counts for
+     * Geodesic::GetStats aren't collected.
+     **********************************************************************/
+    GEOGRAPHICLIB_HD static real
+    GenInverse(const GeodesicCoeffs& c,
+               real lat1, real lon1, real lat2, real lon2,
+               unsigned outmask,
+               real& s12, real& azi1, real& azi2,
+               real& m12, real& M12, real& M21, real& S12) {
+      outmask &= OUT_MASK;
+      real salp1, calp1, salp2, calp2,
+        a12 = GenInverse(c, lat1, lon1, lat2, lon2,
+                         outmask, s12, salp1, calp1, salp2, calp2,
+                         m12, M12, M21, S12,
+                         nullptr, nullptr, nullptr, nullptr);
+      if (outmask & AZIMUTH) {
+        azi1 = atan2d(salp1, calp1);
+        azi2 = atan2d(salp2, calp2);
+      }
+      return a12;
+    }
+
+    /**
+     * Solve several direct geodesic problems.
+     *
+     * @param[in] c the coefficients from GeodesicKernel::Coefficients.
+     * @param[in] n the number of problems.
+     * @param[in] lat1 array of \e n latitudes of point 1 (degrees).
+     * @param[in] lon1 array of \e n longitudes of point 1 (degrees).
+     * @param[in] azi1 array of \e n azimuths at point 1 (degrees).
+     * @param[in] arcmode boolean flag determining the meaning of \e s12_a12.
+     * @param[in] s12_a12 array of \e n distances (meters) or arc lengths
+     *   (degrees) from point 1 to point 2.
+     * @param[in] outmask a bitor'ed combination of Geodesic::mask values
+     *   specifying which of the following arrays should be set.
+     * @param[out] lat2 array of \e n latitudes of point 2 (degrees).
+     * @param[out] lon2 array of \e n longitudes of point 2 (degrees).
+     * @param[out] azi2 array of \e n (forward) azimuths at point 2
+     *   (degrees).
+     * @param[out] s12 array of \e n distances (meters).
+     * @param[out] m12 array of \e n reduced lengths (meters).
+     * @param[out] M12 array of \e n geodesic scales of point 2 relative to
+     *   point 1.
+     * @param[out] M21 array of \e n geodesic scales of point 1 relative to
+     *   point 2.
+     * @param[out] S12 array of \e n areas under the geodesics
+     *   (meters<sup>2</sup>).
+     * @param[out] a12 array of \e n arc lengths (degrees); this may be a null
+     *   pointer.
+     *
+     * The arrays which aren't selected by \e outmask aren't accessed and
+     * they may be null pointers.  This is a loop over the problems calling
+     * GeodesicKernel::GenDirect for each.
+     **********************************************************************/
+    GEOGRAPHICLIB_HD static void
+    GenDirect(const GeodesicCoeffs& c, std::size_t n,
+              const real lat1[], const real lon1[], const real azi1[],
+              bool arcmode, const real s12_a12[], unsigned outmask,
+              real lat2[], real lon2[], real azi2[], real s12[],
+              real m12[], real M12[], real M21[], real S12[],
+              real a12[] = nullptr) {
+      // The outputs requested (outmask itself is passed to GenDirect which
+      // needs the capabilities too).
+      unsigned out = outmask & OUT_MASK;
+      // Scratch outputs for the quantities not requested; these are never
+      // read.
+      real lat2x, lon2x, azi2x, s12x, m12x, M12x, M21x, S12x;
+      for (std::size_t i = 0; i < n; ++i) {
+        real a12x =
+          GenDirect(c, lat1[i], lon1[i], azi1[i], arcmode, s12_a12[i],
+                    outmask,
+                    out & LATITUDE ? lat2[i] : lat2x,
+                    out & LONGITUDE ? lon2[i] : lon2x,
+                    out & AZIMUTH ? azi2[i] : azi2x,
+                    out & DISTANCE ? s12[i] : s12x,
+                    out & REDUCEDLENGTH ? m12[i] : m12x,
+                    out & GEODESICSCALE ? M12[i] : M12x,
+                    out & GEODESICSCALE ? M21[i] : M21x,
+                    out & AREA ? S12[i] : S12x);
+        if (a12) a12[i] = a12x;
+      }
+    }
+
+    /**
+     * Solve several inverse geodesic problems.
+     *
+     * @param[in] c the coefficients from GeodesicKernel::Coefficients.
+     * @param[in] n the number of problems.
+     * @param[in] lat1 array of \e n latitudes of point 1 (degrees).
+     * @param[in] lon1 array of \e n longitudes of point 1 (degrees).
+     * @param[in] lat2 array of \e n latitudes of point 2 (degrees).
+     * @param[in] lon2 array of \e n longitudes of point 2 (degrees).
+     * @param[in] outmask a bitor'ed combination of Geodesic::mask values
+     *   specifying which of the following arrays should be set.
+     * @param[out] s12 array of \e n distances (meters).
+     * @param[out] azi1 array of \e n azimuths at point 1 (degrees).
+     * @param[out] azi2 array of \e n (forward) azimuths at point 2
+     *   (degrees).
+     * @param[out] m12 array of \e n reduced lengths (meters).
+     * @param[out] M12 array of \e n geodesic scales of point 2 relative to
+     *   point 1.
+     * @param[out] M21 array of \e n geodesic scales of point 1 relative to
+     *   point 2.
+     * @param[out] S12 array of \e n areas under the geodesics
+     *   (meters<sup>2</sup>).
+     * @param[out] a12 array of \e n arc lengths (degrees); this may be a null
+     *   pointer.
+     *
+     * The arrays which aren't selected by \e outmask aren't accessed and
+     * they may be null pointers.  This is a loop over the problems calling
+     * GeodesicKernel::GenInverse for each.
+     **********************************************************************/
+    GEOGRAPHICLIB_HD static void
+    GenInverse(const GeodesicCoeffs& c, std::size_t n,
+               const real lat1[], const real lon1[],
+               const real lat2[], const real lon2[],
+               unsigned outmask,
+               real s12[], real azi1[], real azi2[],
+               real m12[], real M12[], real M21[], real S12[],
+               real a12[] = nullptr) {
+      outmask &= OUT_MASK;
+      // Scratch outputs for the quantities not requested; these are never
+      // read.
+      real s12x, m12x, M12x, M21x, S12x;
+      for (std::size_t i = 0; i < n; ++i) {
+        real salp1, calp1, salp2, calp2,
+          a12x = GenInverse(c, lat1[i], lon1[i], lat2[i], lon2[i], outmask,
+                            outmask & DISTANCE ? s12[i] : s12x,
+                            salp1, calp1, salp2, calp2,
+                            outmask & REDUCEDLENGTH ? m12[i] : m12x,
+                            outmask & GEODESICSCALE ? M12[i] : M12x,
+                            outmask & GEODESICSCALE ? M21[i] : M21x,
+                            outmask & AREA ? S12[i] : S12x,
+                            nullptr, nullptr, nullptr, nullptr);
+        if (outmask & AZIMUTH) {
+          azi1[i] = atan2d(salp1, calp1);
+          azi2[i] = atan2d(salp2, calp2);
+        }
+        if (a12) a12[i] = a12x;
+      }
+    }
+
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_GEODESICKERNEL_HPP
@@ -16,6 +16,26 @@
 
 namespace GeographicLib {
 
+  /// \cond SKIP
+  // The parameters of a GeodesicLine object; GeodesicLine derives from this
+  // plain struct so that GeodesicKernel can make the same calculations.
+  struct GEOGRAPHICLIB_EXPORT GeodesicLineCoeffs {
+    typedef Math::real real;
+    static const int N_ = GEOGRAPHICLIB_GEODESIC_ORDER;
+    real tiny_;
+    real _lat1, _lon1, _azi1;
+    real _a, _f;
+    int _order;
+    real _b, _c2, _f1, _salp0, _calp0, _k2,
+      _salp1, _calp1, _ssig1, _csig1, _dn1, _stau1, _ctau1, _somg1, _comg1,
+      _aA1m1, _aA2m1, _aA3c, _bB11, _bB21, _bB31, _aA4, _bB41;
+    // index zero elements of _cC1a, _cC1pa, _cC2a, _cC3a are unused
+    real _cC1a[N_ + 1], _cC1pa[N_ + 1], _cC2a[N_ + 1], _cC3a[N_],
+      _cC4a[N_];                // all the elements of _cC4a are used
+    unsigned _caps;
+  };
+  /// \endcond
+
   /**
    * \brief A geodesic line
    *
@@ -71,38 +91,42 @@ namespace GeographicLib {
    * providing access to the functionality of Geodesic and GeodesicLine.
    **********************************************************************/
 
-  class GEOGRAPHICLIB_EXPORT GeodesicLine {
+  class GEOGRAPHICLIB_EXPORT GeodesicLine : private GeodesicLineCoeffs {
   private:
     typedef Math::real real;
     friend class Geodesic;
+    friend class GeodesicKernel;
+    friend class GeodesicFan;
     static const int nC1_ = Geodesic::nC1_;
     static const int nC1p_ = Geodesic::nC1p_;
     static const int nC2_ = Geodesic::nC2_;
     static const int nC3_ = Geodesic::nC3_;
     static const int nC4_ = Geodesic::nC4_;
 
-    real tiny_;
-    real _lat1, _lon1, _azi1;
-    real _a, _f;
     bool _exact;
-    real _b, _c2, _f1, _salp0, _calp0, _k2,
-      _salp1, _calp1, _ssig1, _csig1, _dn1, _stau1, _ctau1, _somg1, _comg1,
-      _aA1m1, _aA2m1, _aA3c, _bB11, _bB21, _bB31, _aA4, _bB41;
     real _a13, _s13;
-    // index zero elements of _cC1a, _cC1pa, _cC2a, _cC3a are unused
-    real _cC1a[nC1_ + 1], _cC1pa[nC1p_ + 1], _cC2a[nC2_ + 1], _cC3a[nC3_],
-      _cC4a[nC4_];              // all the elements of _cC4a are used
-    unsigned _caps;
     GeodesicLineExact _lineexact;
 
     void LineInit(const Geodesic& g,
                   real lat1, real lon1,
                   real azi1, real salp1, real calp1,
                   unsigned caps);
-    GeodesicLine(const Geodesic& g,
-                 real lat1, real lon1,
-                 real azi1, real salp1, real calp1,
-                 unsigned caps, bool arcmode, real s13_a13);
+    // The two halves of GenPosition.  DistanceSigma converts the distance
+    // s12, given tau12 = s12/(b*(1+A1)) and its sine and cosine, to sig12
+    // (with its sine and cosine) and B12.  SigmaPosition does the rest.
+    void DistanceSigma(real s12, real tau12, real stau12, real ctau12,
+                       real& sig12, real& ssig12, real& csig12,
+                       real& B12) const;
+    real SigmaPosition(bool arcmode, real s12_a12,
+                       real sig12, real ssig12, real csig12, real B12,
+                       unsigned outmask,
+                       real& lat2, real& lon2, real& azi2,
+                       real& s12, real& m12, real& M12, real& M21,
+                       real& S12) const;
+    // The batch GenPosition in arc mode with outmask a subset of LATITUDE |
+    // LONGITUDE | AZIMUTH; the points are processed in groups of 8.
+    void ArcPositions(size_t n, const real a12[], unsigned outmask,
+                      real lat2[], real lon2[], real azi2[]) const;
 
     static constexpr unsigned CAP_NONE = Geodesic::CAP_NONE;
     static constexpr unsigned CAP_C1   = Geodesic::CAP_C1;
@@ -245,10 +269,102 @@ namespace GeographicLib {
     /**
      * A default constructor.  If GeodesicLine::Position is called on the
      * resulting object, it returns immediately (without doing any
-     * calculations).  The object can be set with a call to Geodesic::Line.
+     * calculations).  The object can be set with a call to Geodesic::Line or
+     * with GeodesicLine::Reset.
      * Use Init() to test whether object is still in this uninitialized state.
      **********************************************************************/
-    GeodesicLine() : _caps(0U) {}
+    GeodesicLine() { _caps = 0U; }
+    ///@}
+
+    /** \name Resetting the line
+     **********************************************************************/
+    ///@{
+
+    /**
+     * Reset the object to a geodesic line staring at latitude \e lat1,
+     * longitude \e lon1, and azimuth \e azi1 (all in degrees).
+     *
+     * @param[in] g A Geodesic object used to compute the necessary
+     *   information about the GeodesicLine.
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] azi1 azimuth at point 1 (degrees).
+     * @param[in] caps bitor'ed combination of GeodesicLine::mask values
+     *   specifying the capabilities the GeodesicLine object should possess,
+     *   i.e., which quantities can be returned in calls to
+     *   GeodesicLine::Position.
+     *
+     * After this call, the object is the same as GeodesicLine(\e g, \e lat1,
+     * \e lon1, \e azi1, \e caps).  This avoids the construction and copying
+     * of a new object when many short-lived lines are needed; in addition,
+     * if \e g is exact, the storage allocated for the area coefficients is
+     * reused.  As with the constructor, only the coefficients needed for \e
+     * caps are computed, so a line used only for positions (\e caps =
+     * GeodesicLine::LONGITUDE, say) is considerably cheaper to set up than
+     * one with the default GeodesicLine::ALL.
+     **********************************************************************/
+    void Reset(const Geodesic& g, real lat1, real lon1, real azi1,
+               unsigned caps = ALL);
+
+    /**
+     * Reset the object to a geodesic line defined by the direct geodesic
+     * problem.
+     *
+     * @param[in] g A Geodesic object used to compute the necessary
+     *   information about the GeodesicLine.
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] azi1 azimuth at point 1 (degrees).
+     * @param[in] arcmode boolean flag determining the meaning of the \e
+     *   s12_a12.
+     * @param[in] s12_a12 if \e arcmode is false, this is the distance between
+     *   point 1 and point 2 (meters); otherwise it is the arc length between
+     *   point 1 and point 2 (degrees); it can be negative.
+     * @param[in] caps bitor'ed combination of GeodesicLine::mask values
+     *   specifying the capabilities the GeodesicLine object should possess.
+     *
+     * After this call, the object is the same as that returned by
+     * Geodesic::GenDirectLine(\e lat1, \e lon1, \e azi1, \e arcmode, \e
+     * s12_a12, \e caps) called on \e g.
+     **********************************************************************/
+    void GenResetDirect(const Geodesic& g, real lat1, real lon1, real azi1,
+                        bool arcmode, real s12_a12, unsigned caps = ALL);
+
+    /**
+     * Reset the object to a geodesic line defined by the direct geodesic
+     * problem specified in terms of distance.
+     *
+     * @param[in] g A Geodesic object.
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] azi1 azimuth at point 1 (degrees).
+     * @param[in] s12 distance between point 1 and point 2 (meters); it can be
+     *   negative.
+     * @param[in] caps bitor'ed combination of GeodesicLine::mask values.
+     *
+     * This is equivalent to *this = \e g.DirectLine(\e lat1, \e lon1, \e
+     * azi1, \e s12, \e caps).
+     **********************************************************************/
+    void ResetDirect(const Geodesic& g, real lat1, real lon1, real azi1,
+                     real s12, unsigned caps = ALL)
+    { GenResetDirect(g, lat1, lon1, azi1, false, s12, caps); }
+
+    /**
+     * Reset the object to a geodesic line defined by the inverse geodesic
+     * problem.
+     *
+     * @param[in] g A Geodesic object.
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] lat2 latitude of point 2 (degrees).
+     * @param[in] lon2 longitude of point 2 (degrees).
+     * @param[in] caps bitor'ed combination of GeodesicLine::mask values.
+     *
+     * This is equivalent to *this = \e g.InverseLine(\e lat1, \e lon1, \e
+     * lat2, \e lon2, \e caps).
+     **********************************************************************/
+    void ResetInverse(const Geodesic& g, real lat1, real lon1,
+                      real lat2, real lon2, unsigned caps = ALL);
     ///@}
 
     /** \name Position in terms of distance
@@ -554,6 +670,141 @@ namespace GeographicLib {
                            real& lat2, real& lon2, real& azi2,
                            real& s12, real& m12, real& M12, real& M21,
                            real& S12) const;
+
+    /**
+     * The batch position function, evaluating many points on the geodesic.
+     *
+     * @param[in] n the number of points to compute.
+     * @param[in] arcmode boolean flag determining the meaning of \e s12_a12;
+     *   if \e arcmode is false, then the GeodesicLine object must have been
+     *   constructed with \e caps |= GeodesicLine::DISTANCE_IN.
+     * @param[in] s12_a12 array of \e n distances (meters) if \e arcmode is
+     *   false, or arc lengths (degrees) if \e arcmode is true, from point 1
+     *   to the points to compute.
+     * @param[in] outmask a bitor'ed combination of GeodesicLine::mask values
+     *   specifying which of the following arrays should be set.
+     * @param[out] lat2 array of latitudes (degrees).
+     * @param[out] lon2 array of longitudes (degrees).
+     * @param[out] azi2 array of (forward) azimuths (degrees).
+     * @param[out] s12 array of distances from point 1 (meters).
+     * @param[out] m12 array of reduced lengths (meters).
+     * @param[out] M12 array of geodesic scales of the computed points relative
+     *   to point 1 (dimensionless).
+     * @param[out] M21 array of geodesic scales of point 1 relative to the
+     *   computed points (dimensionless).
+     * @param[out] S12 array of areas under the geodesic
+     *   (meters<sup>2</sup>).
+     * @param[out] a12 array of arc lengths from point 1 (degrees).
+     *
+     * Element \e i of the output arrays is set to the result of
+     * GeodesicLine::GenPosition applied to element \e i of \e s12_a12.  The
+     * arrays for quantities not included in both \e outmask and the
+     * capabilities of the object may be null pointers; \e a12 is set if it
+     * is non-null.  The input and output arrays must not overlap.
+     *
+     * This is a plain loop which calls GeodesicLine::GenPosition for each
+     * point, so the results are identical to those of the scalar calls.
+     * The exception is arc mode with \e outmask a combination of
+     * GeodesicLine::LATITUDE, GeodesicLine::LONGITUDE, and
+     * GeodesicLine::AZIMUTH (e.g., for ground tracks).  Then the points are
+     * processed in groups of 8 so that the compiler can vectorize the
+     * arithmetic; this is about 10% faster and the operations, and so the
+     * results, are the same as for the scalar calls.
+     **********************************************************************/
+    void GenPosition(size_t n, bool arcmode, const real s12_a12[],
+                     unsigned outmask,
+                     real lat2[], real lon2[], real azi2[],
+                     real s12[], real m12[], real M12[], real M21[],
+                     real S12[], real a12[] = nullptr) const;
+
+    /**
+     * The batch position function for equally spaced points.
+     *
+     * @param[in] arcmode boolean flag determining the meaning of \e s0_a0 and
+     *   \e ds_da; if \e arcmode is false, then the GeodesicLine object must
+     *   have been constructed with \e caps |= GeodesicLine::DISTANCE_IN.
+     * @param[in] s0_a0 the distance (meters) if \e arcmode is false, or the
+     *   arc length (degrees) if \e arcmode is true, from point 1 to the first
+     *   point to compute.
+     * @param[in] ds_da the spacing of the points, a distance (meters) if \e
+     *   arcmode is false, or an arc length (degrees) if \e arcmode is true;
+     *   it can be negative.
+     * @param[in] n the number of points to compute.
+     * @param[in] outmask a bitor'ed combination of GeodesicLine::mask values
+     *   specifying which of the following arrays should be set.
+     * @param[out] lat2 array of latitudes (degrees).
+     * @param[out] lon2 array of longitudes (degrees).
+     * @param[out] azi2 array of (forward) azimuths (degrees).
+     * @param[out] s12 array of distances from point 1 (meters).
+     * @param[out] m12 array of reduced lengths (meters).
+     * @param[out] M12 array of geodesic scales of the computed points relative
+     *   to point 1 (dimensionless).
+     * @param[out] M21 array of geodesic scales of point 1 relative to the
+     *   computed points (dimensionless).
+     * @param[out] S12 array of areas under the geodesic
+     *   (meters<sup>2</sup>).
+     * @param[out] a12 array of arc lengths from point 1 (degrees).
+     *
+     * This is equivalent to GeodesicLine::GenPosition(\e n, \e arcmode, \e
+     * s12_a12, ...) with \e s12_a12[\e i] = \e s0_a0 + \e i \e ds_da.
+     * The sine and cosine of the arc length (in arc mode) or of the
+     * corresponding quantity for the distance (in distance mode) are
+     * advanced by the angle addition formulas, which saves one evaluation of
+     * a sine and a cosine per point.  To limit the accumulation of roundoff
+     * errors, the sine and cosine are evaluated directly every 16 points.
+     * The results agree with GeodesicLine::GenPosition to within a few
+     * nanometers (not bitwise).  With exact geodesics, the points are
+     * computed with GeodesicLine::GenPosition.
+     **********************************************************************/
+    void GenWaypoints(bool arcmode, real s0_a0, real ds_da, size_t n,
+                      unsigned outmask,
+                      real lat2[], real lon2[], real azi2[],
+                      real s12[], real m12[], real M12[], real M21[],
+                      real S12[], real a12[] = nullptr) const;
+
+    /**
+     * Compute equally spaced points in terms of distance.
+     *
+     * @param[in] s0 distance from point 1 to the first point (meters).
+     * @param[in] ds the spacing of the points (meters); it can be negative.
+     * @param[in] n the number of points to compute.
+     * @param[out] lat2 array of latitudes (degrees).
+     * @param[out] lon2 array of longitudes (degrees).
+     * @param[out] azi2 array of (forward) azimuths (degrees); this may be a
+     *   null pointer.
+     *
+     * The GeodesicLine object must have been constructed with \e caps |=
+     * GeodesicLine::DISTANCE_IN; otherwise the arrays are left unset.  See
+     * GeodesicLine::GenWaypoints.
+     **********************************************************************/
+    void Waypoints(real s0, real ds, size_t n,
+                   real lat2[], real lon2[], real azi2[] = nullptr) const {
+      GenWaypoints(false, s0, ds, n,
+                   LATITUDE | LONGITUDE | (azi2 ? AZIMUTH : NONE),
+                   lat2, lon2, azi2,
+                   nullptr, nullptr, nullptr, nullptr, nullptr);
+    }
+
+    /**
+     * Compute equally spaced points in terms of arc length.
+     *
+     * @param[in] a0 arc length from point 1 to the first point (degrees).
+     * @param[in] da the spacing of the points (degrees); it can be negative.
+     * @param[in] n the number of points to compute.
+     * @param[out] lat2 array of latitudes (degrees).
+     * @param[out] lon2 array of longitudes (degrees).
+     * @param[out] azi2 array of (forward) azimuths (degrees); this may be a
+     *   null pointer.
+     *
+     * See GeodesicLine::GenWaypoints.
+     **********************************************************************/
+    void ArcWaypoints(real a0, real da, size_t n,
+                      real lat2[], real lon2[], real azi2[] = nullptr) const {
+      GenWaypoints(true, a0, da, n,
+                   LATITUDE | LONGITUDE | (azi2 ? AZIMUTH : NONE),
+                   lat2, lon2, azi2,
+                   nullptr, nullptr, nullptr, nullptr, nullptr);
+    }
     ///@}
 
     /** \name Setting point 3
@@ -0,0 +1,170 @@
+/**
+ * \file GeodesicOrigin.hpp
+ * \brief Header for GeographicLib::GeodesicOrigin class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_GEODESICORIGIN_HPP)
+#define GEOGRAPHICLIB_GEODESICORIGIN_HPP 1
+
+#include <GeographicLib/Constants.hpp>
+#include <GeographicLib/Geodesic.hpp>
+
+namespace GeographicLib {
+
+  /**
+   * \brief Inverse geodesic problems with a common first point
+   *
+   * GeodesicOrigin solves the inverse geodesic problem between a fixed point
+   * 1 (\e lat1, \e lon1) and many points 2, e.g., to find the nearest of a
+   * set of facilities.  It is created with Geodesic::InverseFrom or with the
+   * public constructor.  The reduced latitude of point 1 (together with the
+   * associated quantities) is computed once in the constructor instead of
+   * for each problem.  The results are identical to those given by
+   * Geodesic::GenInverse(\e lat1, \e lon1, \e lat2, \e lon2, ...).
+   *
+   * Most of the cost of the inverse problem lies in finding the azimuth at
+   * point 1 and this depends on both points; so the saving is only a few
+   * percent.  The main benefit of this class is the convenience of the array
+   * interface GeodesicOrigin::GenInverse(size_t, ...).  See also
+   * Geodesic::DistanceMatrix which handles many points 1 and which can use
+   * several threads.
+   *
+   * The class holds a copy of the Geodesic object; it is immutable and so it
+   * may be used by several threads at once.  If the Geodesic object was
+   * constructed with \e exact = true, the calculations are passed on to
+   * GeodesicExact and there is no saving.
+   *
+   * Example of use:
+   * \code
+   *   const Geodesic& geod = Geodesic::WGS84();
+   *   GeodesicOrigin orig = geod.InverseFrom(40.64, -73.78);
+   *   for (...)
+   *     orig.Inverse(lat2, lon2, s12, azi1, azi2);
+   * \endcode
+   **********************************************************************/
+
+  class GEOGRAPHICLIB_EXPORT GeodesicOrigin {
+  private:
+    typedef Math::real real;
+    Geodesic _geod;
+    real _lat1, _lon1;
+    Geodesic::LatTerms _t1;
+
+  public:
+
+    /**
+     * Constructor for a GeodesicOrigin.
+     *
+     * @param[in] g A Geodesic object used to compute the geodesics.
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     *
+     * \e lat1 should be in the range [&minus;90&deg;, 90&deg;].
+     **********************************************************************/
+    GeodesicOrigin(const Geodesic& g, real lat1, real lon1);
+
+    /**
+     * The general inverse geodesic calculation from point 1.
+     *
+     * @param[in] lat2 latitude of point 2 (degrees).
+     * @param[in] lon2 longitude of point 2 (degrees).
+     * @param[in] outmask a bitor'ed combination of Geodesic::mask values
+     *   specifying which of the following parameters should be set.
+     * @param[out] s12 distance between point 1 and point 2 (meters).
+     * @param[out] azi1 azimuth at point 1 (degrees).
+     * @param[out] azi2 (forward) azimuth at point 2 (degrees).
+     * @param[out] m12 reduced length of geodesic (meters).
+     * @param[out] M12 geodesic scale of point 2 relative to point 1
+     *   (dimensionless).
+     * @param[out] M21 geodesic scale of point 1 relative to point 2
+     *   (dimensionless).
+     * @param[out] S12 area under the geodesic (meters<sup>2</sup>).
+     * @return \e a12 arc length of between point 1 and point 2 (degrees).
+     *
+     * This is equivalent to Geodesic::GenInverse(\e lat1, \e lon1, \e lat2,
+     * \e lon2, \e outmask, ...).
+     **********************************************************************/
+    Math::real GenInverse(real lat2, real lon2, unsigned outmask,
+                          real& s12, real& azi1, real& azi2,
+                          real& m12, real& M12, real& M21, real& S12) const;
+
+    /**
+     * Solve the inverse geodesic problem from point 1 returning the distance
+     * and the azimuths.
+     *
+     * @param[in] lat2 latitude of point 2 (degrees).
+     * @param[in] lon2 longitude of point 2 (degrees).
+     * @param[out] s12 distance between point 1 and point 2 (meters).
+     * @param[out] azi1 azimuth at point 1 (degrees).
+     * @param[out] azi2 (forward) azimuth at point 2 (degrees).
+     * @return \e a12 arc length of between point 1 and point 2 (degrees).
+     **********************************************************************/
+    Math::real Inverse(real lat2, real lon2,
+                       real& s12, real& azi1, real& azi2) const {
+      real t;
+      return GenInverse(lat2, lon2, Geodesic::DISTANCE | Geodesic::AZIMUTH,
+                        s12, azi1, azi2, t, t, t, t);
+    }
+
+    /**
+     * Solve the inverse geodesic problem from point 1 to many points 2.
+     *
+     * @param[in] n the number of points 2.
+     * @param[in] lat2 array of \e n latitudes of point 2 (degrees).
+     * @param[in] lon2 array of \e n longitudes of point 2 (degrees).
+     * @param[in] outmask a bitor'ed combination of Geodesic::mask values
+     *   specifying which of the following arrays should be set.
+     * @param[out] s12 array of distances between point 1 and point 2
+     *   (meters).
+     * @param[out] azi1 array of azimuths at point 1 (degrees).
+     * @param[out] azi2 array of (forward) azimuths at point 2 (degrees).
+     * @param[out] m12 array of reduced lengths (meters).
+     * @param[out] M12 array of geodesic scales of point 2 relative to point 1
+     *   (dimensionless).
+     * @param[out] M21 array of geodesic scales of point 1 relative to point 2
+     *   (dimensionless).
+     * @param[out] S12 array of areas under the geodesics
+     *   (meters<sup>2</sup>).
+     * @param[out] a12 array of arc lengths between point 1 and point 2
+     *   (degrees).
+     *
+     * Element \e i of the output arrays is set to the result of
+     * GeodesicOrigin::GenInverse applied to element \e i of the input
+     * arrays.  As with Geodesic::GenInverse(size_t, ...), the output arrays
+     * need only be supplied for the quantities requested in \e outmask; \e
+     * a12 is set if it is non-null.  The input and output arrays must not
+     * overlap.
+     **********************************************************************/
+    void GenInverse(size_t n, const real lat2[], const real lon2[],
+                    unsigned outmask,
+                    real s12[], real azi1[], real azi2[],
+                    real m12[], real M12[], real M21[], real S12[],
+                    real a12[] = nullptr) const;
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return \e lat1 the latitude of point 1 (degrees).
+     **********************************************************************/
+    Math::real Latitude() const { return _lat1; }
+
+    /**
+     * @return \e lon1 the longitude of point 1 (degrees).
+     **********************************************************************/
+    Math::real Longitude() const { return _lon1; }
+
+    /**
+     * @return the Geodesic object used to compute the geodesics.
+     **********************************************************************/
+    const Geodesic& GeodesicObject() const { return _geod; }
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_GEODESICORIGIN_HPP
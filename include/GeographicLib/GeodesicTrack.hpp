@@ -0,0 +1,176 @@
+/**
+ * \file GeodesicTrack.hpp
+ * \brief Header for GeographicLib::GeodesicTrack class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_GEODESICTRACK_HPP)
+#define GEOGRAPHICLIB_GEODESICTRACK_HPP 1
+
+#include <GeographicLib/Constants.hpp>
+#include <GeographicLib/Geodesic.hpp>
+
+namespace GeographicLib {
+
+  /**
+   * \brief Inverse geodesic problems along a track
+   *
+   * GeodesicTrack solves a sequence of inverse geodesic problems in which
+   * neighboring problems are similar, e.g., the legs between successive
+   * fixes of a GPS track.  The solution of the inverse problem is found by
+   * Newton's method starting with an estimate of the azimuth at point 1
+   * given by Geodesic.  GeodesicTrack instead starts with the azimuth found
+   * for the previous problem (provided that this is a valid starting
+   * point); on a typical track this is closer to the solution and fewer
+   * iterations are needed.  Because Newton's method in Geodesic keeps the
+   * solution bracketed, a poor starting guess (e.g., at a sharp turn) only
+   * costs extra iterations.  In addition, if point 1 of a problem is point 2
+   * of the previous one, the setup of its reduced latitude is reused.
+   *
+   * The results agree with those given by Geodesic::GenInverse to round-off
+   * (they may differ in the last bits because Newton's method terminates at
+   * a slightly different point).  With the cmake option
+   * GEOGRAPHICLIB_GEODESIC_STATS, the reduction in the number of iterations
+   * can be seen with Geodesic::GetStats.
+   *
+   * The class holds a copy of the Geodesic object and the state carried from
+   * one problem to the next; so the member functions which solve the
+   * inverse problem are not const and a GeodesicTrack object should be used
+   * by only one thread at a time.  If the Geodesic object was constructed
+   * with \e exact = true, the calculations are passed on to GeodesicExact
+   * and there is no saving.
+   *
+   * Example of use:
+   * \code
+   *   GeodesicTrack track(Geodesic::WGS84());
+   *   for (size_t i = 1; i < n; ++i)
+   *     track.Inverse(lat[i-1], lon[i-1], lat[i], lon[i], s12, azi1, azi2);
+   * \endcode
+   **********************************************************************/
+
+  class GEOGRAPHICLIB_EXPORT GeodesicTrack {
+  private:
+    typedef Math::real real;
+    Geodesic _geod;
+    Geodesic::WarmStart _warm;
+    // The latitude of the last point 2 and its reduced latitude terms
+    real _lat2;
+    Geodesic::LatTerms _t2;
+
+  public:
+
+    /**
+     * Constructor for a GeodesicTrack.
+     *
+     * @param[in] g A Geodesic object used to compute the geodesics.
+     **********************************************************************/
+    GeodesicTrack(const Geodesic& g);
+
+    /**
+     * The general inverse geodesic calculation for the next problem of the
+     * track.
+     *
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] lat2 latitude of point 2 (degrees).
+     * @param[in] lon2 longitude of point 2 (degrees).
+     * @param[in] outmask a bitor'ed combination of Geodesic::mask values
+     *   specifying which of the following parameters should be set.
+     * @param[out] s12 distance between point 1 and point 2 (meters).
+     * @param[out] azi1 azimuth at point 1 (degrees).
+     * @param[out] azi2 (forward) azimuth at point 2 (degrees).
+     * @param[out] m12 reduced length of geodesic (meters).
+     * @param[out] M12 geodesic scale of point 2 relative to point 1
+     *   (dimensionless).
+     * @param[out] M21 geodesic scale of point 1 relative to point 2
+     *   (dimensionless).
+     * @param[out] S12 area under the geodesic (meters<sup>2</sup>).
+     * @return \e a12 arc length of between point 1 and point 2 (degrees).
+     *
+     * This is equivalent to Geodesic::GenInverse(\e lat1, \e lon1, \e lat2,
+     * \e lon2, \e outmask, ...) except that the solution of the previous
+     * problem is used to start the iteration.
+     **********************************************************************/
+    Math::real GenInverse(real lat1, real lon1, real lat2, real lon2,
+                          unsigned outmask,
+                          real& s12, real& azi1, real& azi2,
+                          real& m12, real& M12, real& M21, real& S12);
+
+    /**
+     * Solve the inverse geodesic problem for the next problem of the track
+     * returning the distance and the azimuths.
+     *
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] lat2 latitude of point 2 (degrees).
+     * @param[in] lon2 longitude of point 2 (degrees).
+     * @param[out] s12 distance between point 1 and point 2 (meters).
+     * @param[out] azi1 azimuth at point 1 (degrees).
+     * @param[out] azi2 (forward) azimuth at point 2 (degrees).
+     * @return \e a12 arc length of between point 1 and point 2 (degrees).
+     **********************************************************************/
+    Math::real Inverse(real lat1, real lon1, real lat2, real lon2,
+                       real& s12, real& azi1, real& azi2) {
+      real t;
+      return GenInverse(lat1, lon1, lat2, lon2,
+                        Geodesic::DISTANCE | Geodesic::AZIMUTH,
+                        s12, azi1, azi2, t, t, t, t);
+    }
+
+    /**
+     * Solve the inverse geodesic problems for the legs of a track.
+     *
+     * @param[in] n the number of points on the track.
+     * @param[in] lat array of \e n latitudes (degrees).
+     * @param[in] lon array of \e n longitudes (degrees).
+     * @param[in] outmask a bitor'ed combination of Geodesic::mask values
+     *   specifying which of the following arrays should be set.
+     * @param[out] s12 array of distances (meters).
+     * @param[out] azi1 array of azimuths at the starts of the legs
+     *   (degrees).
+     * @param[out] azi2 array of (forward) azimuths at the ends of the legs
+     *   (degrees).
+     * @param[out] m12 array of reduced lengths (meters).
+     * @param[out] M12 array of geodesic scales of the ends of the legs
+     *   relative to the starts (dimensionless).
+     * @param[out] M21 array of geodesic scales of the starts of the legs
+     *   relative to the ends (dimensionless).
+     * @param[out] S12 array of areas under the geodesics
+     *   (meters<sup>2</sup>).
+     * @param[out] a12 array of arc lengths (degrees).
+     *
+     * The track has \e n &minus; 1 legs and element \e i of the output
+     * arrays is set to the result of GeodesicTrack::GenInverse(\e lat[\e i],
+     * \e lon[\e i], \e lat[\e i+1], \e lon[\e i+1], ...).  As with
+     * Geodesic::GenInverse(size_t, ...), the output arrays need only be
+     * supplied for the quantities requested in \e outmask; \e a12 is set if
+     * it is non-null.  The input and output arrays must not overlap.
+     **********************************************************************/
+    void GenInverse(size_t n, const real lat[], const real lon[],
+                    unsigned outmask,
+                    real s12[], real azi1[], real azi2[],
+                    real m12[], real M12[], real M21[], real S12[],
+                    real a12[] = nullptr);
+
+    /**
+     * Forget the solution of the previous problem.  The next problem is
+     * solved exactly as by Geodesic::GenInverse.
+     **********************************************************************/
+    void Reset();
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return the Geodesic object used to compute the geodesics.
+     **********************************************************************/
+    const Geodesic& GeodesicObject() const { return _geod; }
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_GEODESICTRACK_HPP
@@ -45,9 +45,26 @@ namespace GeographicLib {
     static const char* const lcdigits_;
     static const char* const ucdigits_;
     Geohash() = delete;         // Disable constructor
+    static bool Interleave(real lat, real lon,
+                           unsigned long long& hi, unsigned long long& lo);
+    static void GenReverse(unsigned long long ulon, unsigned long long ulat,
+                           int len, bool centerp, real& lat, real& lon);
+    static void GenReverse(const char* geohash, int n, real& lat, real& lon,
+                           int& len, bool centerp);
 
   public:
 
+    /**
+     * The size of a char array which can hold any geohash produced by the
+     * char array versions of Forward, including the terminating null.
+     **********************************************************************/
+    enum { MAXBUF = 18 + 1 };
+
+    /**
+     * The maximum length of a geohash which can be represented by Key.
+     **********************************************************************/
+    enum { MAXKEYLEN = 12 };
+
     /**
      * Convert from geographic coordinates to a geohash.
      *
@@ -88,6 +105,128 @@ namespace GeographicLib {
     static void Reverse(const std::string& geohash, real& lat, real& lon,
                         int& len, bool centerp = true);
 
+    /**
+     * Convert from geographic coordinates to a geohash in a char array.
+     *
+     * @param[in] lat latitude of point (degrees).
+     * @param[in] lon longitude of point (degrees).
+     * @param[in] len the length of the resulting geohash.
+     * @param[out] geohash a char array of at least Geohash::MAXBUF
+     *   characters which receives the null-terminated geohash.
+     * @exception GeographicErr if \e lat is not in [&minus;90&deg;,
+     *   90&deg;].
+     *
+     * This is the same as the version returning a std::string, except that
+     * no memory is allocated.
+     **********************************************************************/
+    static void Forward(real lat, real lon, int len, char geohash[]);
+
+    /**
+     * Convert many geographic coordinates to geohashes.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of \e n latitudes (degrees).
+     * @param[in] lon array of \e n longitudes (degrees).
+     * @param[in] len the length of the resulting geohashes.
+     * @param[out] geohash a char array of \e n \e width characters;
+     *   geohash \e i is written null-terminated starting at
+     *   geohash[\e i \e width].
+     * @param[in] width the spacing of the geohashes; this must exceed both \e
+     *   len (after it is put in the range [0, 18]) and 7.
+     * @exception GeographicErr if \e width is too small or if any latitude
+     *   is not in [&minus;90&deg;, 90&deg;].
+     **********************************************************************/
+    static void Forward(size_t n, const real lat[], const real lon[], int len,
+                        char geohash[], size_t width);
+
+    /**
+     * Convert from geographic coordinates to a geohash packed into an
+     * integer.
+     *
+     * @param[in] lat latitude of point (degrees).
+     * @param[in] lon longitude of point (degrees).
+     * @param[in] len the length of the geohash.
+     * @exception GeographicErr if \e lat is not in [&minus;90&deg;,
+     *   90&deg;].
+     * @return the 5\e len bits of the geohash, most significant first.
+     *
+     * Internally, \e len is first put in the range [0, 12]; this allows the
+     * result to be stored in 64 bits.  The result is the concatenation of
+     * the 5-bit indices of the characters of the geohash returned by
+     * Forward; thus the values for a given \e len sort in the same order as
+     * the geohashes.  If \e lat or \e lon is NaN, the result is ~0ULL.
+     **********************************************************************/
+    static unsigned long long Key(real lat, real lon, int len);
+
+    /**
+     * Convert many geographic coordinates to integer geohash keys.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of \e n latitudes (degrees).
+     * @param[in] lon array of \e n longitudes (degrees).
+     * @param[in] len the length of the geohashes.
+     * @param[out] key array of \e n keys.
+     * @exception GeographicErr if any latitude is not in [&minus;90&deg;,
+     *   90&deg;].
+     **********************************************************************/
+    static void Key(size_t n, const real lat[], const real lon[], int len,
+                    unsigned long long key[]);
+
+    /**
+     * Convert from an integer geohash key to geographic coordinates.
+     *
+     * @param[in] key the key returned by Key.
+     * @param[in] len the length of the geohash used for \e key.
+     * @param[out] lat latitude of point (degrees).
+     * @param[out] lon longitude of point (degrees).
+     * @param[in] centerp if true (the default) return the center of the
+     *   geohash location, otherwise return the south-west corner.
+     *
+     * Internally, \e len is first put in the range [0, 12].  If \e key has
+     * bits set above the lowest 5\e len bits (e.g., for the key for NaNs),
+     * then \e lat and \e lon are set to NaN.  The result is the same as
+     * Reverse applied to the corresponding geohash.
+     **********************************************************************/
+    static void Reverse(unsigned long long key, int len,
+                        real& lat, real& lon, bool centerp = true);
+
+    /**
+     * Convert from a geohash given as a null-terminated char array to
+     * geographic coordinates.
+     *
+     * @param[in] geohash the geohash.
+     * @param[out] lat latitude of point (degrees).
+     * @param[out] lon longitude of point (degrees).
+     * @param[out] len the length of the geohash.
+     * @param[in] centerp if true (the default) return the center of the
+     *   geohash location, otherwise return the south-west corner.
+     * @exception GeographicErr if \e geohash contains illegal characters.
+     *
+     * This is the same as the version taking a std::string, except that no
+     * memory is allocated unless an error is thrown.
+     **********************************************************************/
+    static void Reverse(const char* geohash, real& lat, real& lon,
+                        int& len, bool centerp = true);
+
+    /**
+     * Convert many geohashes to geographic coordinates.
+     *
+     * @param[in] n the number of geohashes.
+     * @param[in] geohash a char array of \e n \e width characters; geohash
+     *   \e i starts at geohash[\e i \e width] and ends at the first null or
+     *   after \e width characters.
+     * @param[in] width the spacing of the geohashes.
+     * @param[out] lat array of \e n latitudes (degrees).
+     * @param[out] lon array of \e n longitudes (degrees).
+     * @param[out] len array of \e n lengths; this may be a null pointer.
+     * @param[in] centerp if true (the default) return the center of the
+     *   geohash location, otherwise return the south-west corner.
+     * @exception GeographicErr if any geohash contains illegal characters.
+     **********************************************************************/
+    static void Reverse(size_t n, const char geohash[], size_t width,
+                        real lat[], real lon[], int len[] = nullptr,
+                        bool centerp = true);
+
     /**
      * The latitude resolution of a geohash.
      *
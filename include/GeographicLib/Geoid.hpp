@@ -12,6 +12,9 @@
 
 #include <vector>
 #include <fstream>
+#include <future>
+#include <memory>
+#include <utility>
 #include <GeographicLib/Constants.hpp>
 
 #if defined(_MSC_VER)
@@ -67,10 +70,22 @@ namespace GeographicLib {
    * reads the data set and because it maintains a single-cell cache.  If
    * multiple threads need to calculate geoid heights they should all construct
    * thread-local instantiations.  Alternatively, set the optional \e
-   * threadsafe parameter to true in the constructor.  This causes the
-   * constructor to read all the data into memory and to turn off the
-   * single-cell caching which results in a Geoid object which \e is thread
-   * safe.
+   * threadsafe parameter to true in the constructor.  This turns off the
+   * single-cell caching and (unless the data file is memory mapped) causes
+   * the data to be read on demand, in tiles of 256 &times; 256 pixels, into
+   * a bounded cache which is shared by all threads; this results in a Geoid
+   * object which \e is thread safe.  Each thread may pass its own
+   * Geoid::Context to operator()(real, real, Context&) const to recover the
+   * benefit of the single-cell cache.
+   *
+   * On systems which support it (POSIX), the data file is memory mapped, so
+   * that random access to the data is cheap and the data is shared, via the
+   * page cache, with other processes using the same geoid.  If mapping the
+   * file fails, the object falls back to reading the file with a stream.
+   * Compile with GEOGRAPHICLIB_GEOID_MMAP = 0 to disable memory mapping.
+   * Alternatively, the data can be supplied by a Geoid::Source, e.g., one
+   * which fetches byte ranges of the file from remote storage; in this case
+   * only the tiles of data needed for the queries are fetched.
    *
    * Example of use:
    * \include example-Geoid.cpp
@@ -80,6 +95,8 @@ namespace GeographicLib {
    **********************************************************************/
 
   class GEOGRAPHICLIB_EXPORT Geoid {
+  public:
+    class Source;
   private:
     typedef Math::real real;
 #if GEOGRAPHICLIB_GEOID_PGM_PIXEL_WIDTH != 4
@@ -104,41 +121,214 @@ namespace GeographicLib {
     const bool _cubic;
     const real _a, _e2, _degree, _eps;
     mutable std::ifstream _file;
+    // Memory mapped data file (or nullptr if not mapped)
+    const unsigned char* _mmap;
+    unsigned long long _mmapsize;
+    // Tile cache used by a thread safe Geoid if the file isn't mapped
+    class TileCache;
+    std::unique_ptr<TileCache> _tiles;
+    // The source of the data (or nullptr if the data is read from _file)
+    std::unique_ptr<Source> _source;
+    // The tiled data format: the tiles are 2^tilebits_ pixels square and
+    // are located with _tileindex.
+    static const int tilebits_ = 8;
+    struct tileentry {
+      unsigned long long offset;
+      unsigned bytes, encoding;
+    };
+    bool _tiled;
+    std::vector<tileentry> _tileindex;
     real _rlonres, _rlatres;
     std::string _description, _datetime;
     real _offset, _scale, _maxerror, _rmserror;
+    // The maximum and RMS errors for bilinear and cubic interpolation
+    real _errors[4];
     int _width, _height;
     unsigned long long _datastart, _swidth;
     bool _threadsafe;
-    // Area cache
-    mutable std::vector< std::vector<pixel_t> > _data;
+    // A cached area stored in blocks of 16 x 16 pixels.  The pixels of a
+    // block are stored as the differences from the minimum value in the
+    // block, using the fewest bits which can hold the largest difference;
+    // block k starts at words[blocks[k].word].
+    struct packedarea {
+      struct block {
+        unsigned word;
+        pixel_t min;
+        unsigned char bits;
+      };
+      int nbx;                  // The number of blocks in a row of blocks
+      std::vector<block> blocks;
+      std::vector<unsigned long long> words;
+      packedarea() : nbx(0) {}
+      void swap(packedarea& p) {
+        std::swap(nbx, p.nbx); blocks.swap(p.blocks); words.swap(p.words);
+      }
+      // The pixel (x, y) relative to the NE corner of the area
+      unsigned value(int x, int y) const {
+        const block& b = blocks[size_t(y >> 4) * unsigned(nbx) + (x >> 4)];
+        if (b.bits == 0) return b.min;
+        unsigned long long pos =
+          (unsigned long long)(((y & 15) << 4) | (x & 15)) * b.bits;
+        const unsigned long long* w = &words[b.word + (pos >> 6)];
+        unsigned sh = unsigned(pos & 63);
+        unsigned long long v = w[0] >> sh;
+        if (sh + b.bits > 64) v |= w[1] << (64 - sh);
+        return b.min + unsigned(v & ((1ULL << b.bits) - 1));
+      }
+      // Append the blocks for ny (<= 16) rows of xsize pixels.
+      void addrows(const std::vector< std::vector<pixel_t> >& rows, int ny,
+                   int xsize);
+      size_t bytes() const {
+        return blocks.size() * sizeof(block) +
+          words.size() * sizeof(unsigned long long);
+      }
+    };
+    // Area cache.  The rows are stored contiguously in _data with a stride
+    // of _stride pixels; row 0 starts at _data[_data0].  The stride is a
+    // multiple of the cache line size and row 0 is aligned to a cache line.
+    static const unsigned linepixels_ = 64 / pixel_size_;
+    mutable std::vector<pixel_t> _data;
+    mutable size_t _stride, _data0;
     mutable bool _cache;
     // NE corner and extent of cache
     mutable int _xoffset, _yoffset, _xsize, _ysize;
+    // Is the area cache stored in _packed instead of _data?
+    mutable bool _compressed;
+    mutable packedarea _packed;
+    // The cubic interpolation coefficients for the cells of the current area
+    // whose stencils lie within the area, nterms_ values per cell; cell
+    // (ix, iy) is at index (iy - _yoffset - 1) * (_xsize - 3) + (ix -
+    // _xoffset - 1).  This is empty unless the coefficients are precomputed.
+    mutable std::vector<real> _table;
+    // The other cached areas, most recently used first, the limit on the
+    // memory used by all the cached areas, and whether to compress newly
+    // cached areas.
+    struct cachearea {
+      int xoffset, yoffset, xsize, ysize;
+      std::vector<pixel_t> data;
+      size_t stride, data0;
+      bool compressed;
+      packedarea packed;
+      std::vector<real> table;
+    };
+    mutable std::vector<cachearea> _areas;
+    mutable size_t _cachebudget;
+    mutable bool _compress, _precompute;
     // Cell cache
     mutable int _ix, _iy;
-    mutable real _v00, _v01, _v10, _v11;
+    // Interpolation coefficients (the first 4 are the corner values for
+    // bilinear interpolation)
     mutable real _t[nterms_];
+    // The byte offset of pixel (ix, iy) in the data file.
+    unsigned long long pixeloffset(int ix, int iy) const {
+      return _datastart +
+        pixel_size_ * (unsigned(iy)*_swidth + unsigned(ix));
+    }
     void filepos(int ix, int iy) const {
-      _file.seekg(std::streamoff
-                  (_datastart +
-                   pixel_size_ * (unsigned(iy)*_swidth + unsigned(ix))));
+      _file.seekg(std::streamoff(pixeloffset(ix, iy)));
+    }
+    // Read the n pixels of row iy starting at ix through the tile cache,
+    // if there is one; otherwise from _file.
+    void readrow(int ix, int iy, int n, pixel_t row[]) const;
+    // Convert n big-endian pixels, as read from the data file, in place.
+    static void frombigendian(pixel_t row[], size_t n);
+    // Decode the tile with the given entry in the tiled format, with nx x
+    // ny pixels, from buf to the rows of t (the row stride is the tile
+    // size).
+    static void decodetile(const tileentry& e, const char* buf,
+                           int nx, int ny, pixel_t t[]);
+    // Encode an nx x ny tile, whose rows are w pixels apart in t, in the
+    // tiled format, returning the encoding.
+    static unsigned encodetile(const pixel_t t[], size_t w, int nx, int ny,
+                               bool compress, std::string& buf);
+    // Parse the header of the data file (in PGM or tiled format).
+    void readheader(std::istream& hdr);
+    void readtiledheader(std::istream& hdr);
+    // Check that the data file has the given size and initialize the
+    // object.
+    void checksize(unsigned long long size);
+    // The pixel (ix, iy), with ix in [0, _width) and iy in [0, _height), from
+    // the memory mapped data file.
+    unsigned mappedval(int ix, int iy) const {
+      const unsigned char* p = _mmap + _datastart +
+        pixel_size_ * (unsigned(iy) * _swidth + unsigned(ix));
+      unsigned r = (unsigned(p[0]) << 8) | unsigned(p[1]);
+      if (pixel_size_ == 4)
+        r = (r << 16) | (unsigned(p[2]) << 8) | unsigned(p[3]);
+      return r;
+    }
+    // The pixel (ix, iy) from the tile cache.
+    unsigned tileval(int ix, int iy) const;
+    // Is the pixel (ix, iy), with ix in [0, _width), in the cached area with
+    // NE corner (xoffset, yoffset) and extent xsize x ysize?
+    bool inarea(int xoffset, int yoffset, int xsize, int ysize,
+                int ix, int iy) const {
+      return iy >= yoffset && iy < yoffset + ysize &&
+        ((ix >= xoffset && ix < xoffset + xsize) ||
+         (ix + _width >= xoffset && ix + _width < xoffset + xsize));
+    }
+    // Make the other cached area containing (ix, iy) the current one; return
+    // false if there's no such area.
+    bool switcharea(int ix, int iy) const;
+    static size_t rowstride(int xsize)
+    { return (size_t(xsize) + linepixels_ - 1) / linepixels_ * linepixels_; }
+    static size_t areabytes(int xsize, int ysize) {
+      return (size_t(ysize) * rowstride(xsize) + linepixels_) *
+        sizeof(pixel_t);
     }
+    static size_t areabytes(const cachearea& a) {
+      return (a.compressed ? a.packed.bytes() : areabytes(a.xsize, a.ysize)) +
+        a.table.size() * sizeof(real);
+    }
+    size_t areabytes() const {
+      return (_compressed ? _packed.bytes() : areabytes(_xsize, _ysize)) +
+        _table.size() * sizeof(real);
+    }
+    // The number of precomputed coefficients for an area.
+    size_t tablesize(int xsize, int ysize) const {
+      return _cubic && _precompute && xsize > 3 && ysize > 3 ?
+        size_t(xsize - 3) * size_t(ysize - 3) * nterms_ : 0;
+    }
+    // The precomputed coefficients for cell (ix, iy), with ix in [0,
+    // _width), or nullptr if they're not available.
+    const real* tablecoeffs(int ix, int iy) const {
+      if (!inarea(_xoffset, _yoffset, _xsize, _ysize, ix, iy) &&
+          !(!_areas.empty() && switcharea(ix, iy)))
+        return nullptr;
+      if (_table.empty())
+        return nullptr;
+      int x = ix - 1 - _xoffset, y = iy - 1 - _yoffset;
+      if (x < 0) x += _width;
+      return y >= 0 && y + 3 < _ysize && x + 3 < _xsize ?
+        &_table[(size_t(y) * unsigned(_xsize - 3) + unsigned(x)) * nterms_] :
+        nullptr;
+    }
+    // Exchange the current area with a.
+    void swaparea(cachearea& a) const;
+    // Read the area [iw, ie] x [in, is] into the current cached area.
+    void fillcache(int iw, int ie, int in, int is) const;
+    // Discard the least recently used areas to meet the memory budget.
+    void trimcache() const;
     real rawval(int ix, int iy) const {
       if (ix < 0)
         ix += _width;
       else if (ix >= _width)
         ix -= _width;
-      if (_cache && iy >= _yoffset && iy < _yoffset + _ysize &&
-          ((ix >= _xoffset && ix < _xoffset + _xsize) ||
-           (ix + _width >= _xoffset && ix + _width < _xoffset + _xsize))) {
-        return real(_data[iy - _yoffset]
-                    [ix >= _xoffset ? ix - _xoffset : ix + _width - _xoffset]);
+      if (_cache && (inarea(_xoffset, _yoffset, _xsize, _ysize, ix, iy) ||
+                     (!_areas.empty() && switcharea(ix, iy)))) {
+        int x = ix >= _xoffset ? ix - _xoffset : ix + _width - _xoffset,
+          y = iy - _yoffset;
+        return real(_compressed ? _packed.value(x, y) :
+                    _data[_data0 + size_t(y) * _stride + unsigned(x)]);
       } else {
         if (iy < 0 || iy >= _height) {
           iy = iy < 0 ? -iy : 2 * (_height - 1) - iy;
           ix += (ix < _width/2 ? 1 : -1) * _width/2;
         }
+        if (_mmap)
+          return real(mappedval(ix, iy));
+        if (_tiles)
+          return real(tileval(ix, iy));
         try {
           filepos(ix, iy);
           // initial values to suppress warnings in case get fails
@@ -166,6 +356,27 @@ namespace GeographicLib {
         }
       }
     }
+    // The range of pixels, [iw, ie] x [in, is], needed to interpolate
+    // within an area (iw in [0, _width), ie - iw in [0, _width), and in and
+    // is may extend beyond the poles).
+    void area(real south, real west, real north, real east,
+              int& iw, int& ie, int& in, int& is) const;
+    // Load the pixels [ix, ix + n) of row iy in the background.
+    void prefetchrow(int ix, int iy, int n) const;
+    // Find the cell containing (lat, lon) and the position within it;
+    // return false if lat or lon is NaN.
+    bool cell(real lat, real lon, int& ix, int& iy, real& fx, real& fy) const;
+    // Compute the interpolation coefficients for cell (ix, iy).
+    void coeffs(int ix, int iy, real t[]) const;
+    real evaluate(const real t[], real fx, real fy) const;
+    // Bilinear interpolation for n points, in blocks of lanes, reading the
+    // pixels directly from the memory mapped file or the cached area.
+    void bilinear(size_t n, const real lat[], const real lon[],
+                  real h[]) const;
+    // Evaluate the height in cell (ix, iy) using the coefficients t for cell
+    // (cx, cy), first updating these if necessary.
+    real height(int ix, int iy, real fx, real fy,
+                int& cx, int& cy, real t[]) const;
     real height(real lat, real lon) const;
     Geoid(const Geoid&) = delete;            // copy constructor not allowed
     Geoid& operator=(const Geoid&) = delete; // copy assignment not allowed
@@ -207,18 +418,106 @@ namespace GeographicLib {
      * @exception GeographicErr if the data file cannot be found, is
      *   unreadable, or is corrupt.
      * @exception GeographicErr if \e threadsafe is true but the memory
-     *   necessary for caching the data can't be allocated.
+     *   necessary for the tile cache can't be allocated.
      *
      * The data file is formed by appending ".pgm" to the name.  If \e path is
      * specified (and is non-empty), then the file is loaded from directory, \e
-     * path.  Otherwise the path is given by DefaultGeoidPath().  If the \e
-     * threadsafe parameter is true, the data set is read into memory, the data
-     * file is closed, and single-cell caching is turned off; this results in a
-     * Geoid object which \e is thread safe.
+     * path.  Otherwise the path is given by DefaultGeoidPath().  If there is
+     * no such file, the data file in the tiled format, given by appending
+     * ".tgm" to the name, is used; this is always read through the tile
+     * cache, independent of \e threadsafe.  If the \e
+     * threadsafe parameter is true, single-cell caching is turned off and,
+     * unless the data file is memory mapped, the data is read through a tile
+     * cache shared by all threads (this holds at most 64 MB of data, the
+     * least recently used tiles being discarded); this results in a Geoid
+     * object which \e is thread safe.
      **********************************************************************/
     explicit Geoid(const std::string& name, const std::string& path = "",
                    bool cubic = true, bool threadsafe = false);
 
+    /**
+     * A source of the bytes of a geoid data file.
+     *
+     * Implement this to supply the data from somewhere other than a local
+     * file, e.g., by HTTP range requests to an object store.  Read fetches
+     * a range of bytes of the .pgm file; the positions of the pixels in the
+     * file are given in \ref geoidformat.  Read may be called for ranges
+     * near to one another, so an implementation fetching the data over a
+     * network should override ReadRanges to combine the ranges needed for a
+     * tile into a single request.  Geoid serializes the calls, so the
+     * implementation need not be thread safe.  Errors should be signaled by
+     * throwing an exception.
+     **********************************************************************/
+    class GEOGRAPHICLIB_EXPORT Source {
+    public:
+      virtual ~Source() {}
+      /**
+       * @return the size of the data file (bytes).
+       **********************************************************************/
+      virtual unsigned long long Size() = 0;
+      /**
+       * Read a range of bytes.
+       *
+       * @param[in] offset the position of the first byte in the file.
+       * @param[in] n the number of bytes to read.
+       * @param[out] buf the bytes read.
+       **********************************************************************/
+      virtual void Read(unsigned long long offset, size_t n, char buf[]) = 0;
+      /**
+       * Read several ranges of bytes.
+       *
+       * @param[in] k the number of ranges.
+       * @param[in] offset the positions of the first bytes of the ranges.
+       * @param[in] n the numbers of bytes in the ranges.
+       * @param[out] buf the buffers for the ranges.
+       *
+       * The ranges are in increasing order of \e offset and don't overlap.
+       * The default implementation calls Read for each range.
+       **********************************************************************/
+      virtual void ReadRanges(size_t k, const unsigned long long offset[],
+                              const size_t n[], char* const buf[]) {
+        for (size_t i = 0; i < k; ++i)
+          Read(offset[i], n[i], buf[i]);
+      }
+    };
+
+    /**
+     * Construct a geoid whose data is read from a Source.
+     *
+     * @param[in] source the source of the bytes of the data file; the Geoid
+     *   takes ownership of it.
+     * @param[in] name the name of the geoid (this is used only in the
+     *   messages for errors and is returned by GeoidName() and
+     *   GeoidFile()).
+     * @param[in] cubic (optional) interpolation method; false means bilinear,
+     *   true (the default) means cubic.
+     * @param[in] threadsafe (optional), if true, construct a thread safe
+     *   object.  The default is false
+     * @exception GeographicErr if \e source is null or the data is corrupt.
+     * @exception GeographicErr if the memory necessary for the tile cache
+     *   can't be allocated.
+     * @exception any exception thrown by \e source in reading the header.
+     *
+     * This is the same as the constructor for a local file, except for the
+     * origin of the data.  The data may be in PGM or tiled format.  Only the
+     * header is read by the constructor.  Thereafter the pixels are read on
+     * demand, in tiles of 256 &times; 256 pixels, into the tile cache (which
+     * holds at most 64 MB of data); thus the data fetched is limited to the
+     * tiles covering the points where the geoid is evaluated.  CacheArea,
+     * CacheAddArea, and Prefetch work as usual (reading the data through
+     * the tile cache).  This is independent of the setting of \e
+     * threadsafe; however if \e threadsafe is false, the last cell used is
+     * cached as usual.  The errors in reading the data are reported as
+     * GeographicErr exceptions.
+     **********************************************************************/
+    Geoid(std::unique_ptr<Source> source, const std::string& name,
+          bool cubic = true, bool threadsafe = false);
+
+    /**
+     * The destructor unmaps the data file (if it is memory mapped).
+     **********************************************************************/
+    ~Geoid();
+
     /**
      * Set up a cache.
      *
@@ -229,8 +528,8 @@ namespace GeographicLib {
      *   area.
      * @param[in] east longitude (degrees) of the east edge of the cached area.
      * @exception GeographicErr if the memory necessary for caching the data
-     *   can't be allocated (in this case, you will have no cache and can try
-     *   again with a smaller area).
+     *   can't be allocated or exceeds the memory budget (in this case, you
+     *   will have no cache and can try again with a smaller area).
      * @exception GeographicErr if there's a problem reading the data.
      * @exception GeographicErr if this is called on a threadsafe Geoid.
      *
@@ -238,10 +537,90 @@ namespace GeographicLib {
      * parallels \e south and \e north and the meridians \e west and \e east.
      * \e east is always interpreted as being east of \e west, if necessary by
      * adding 360&deg; to its value.  \e south and \e north should be in
-     * the range [&minus;90&deg;, 90&deg;].
+     * the range [&minus;90&deg;, 90&deg;].  This replaces all the areas
+     * cached previously.
      **********************************************************************/
     void CacheArea(real south, real west, real north, real east) const;
 
+    /**
+     * Add an area to the cache.
+     *
+     * @param[in] south latitude (degrees) of the south edge of the cached
+     *   area.
+     * @param[in] west longitude (degrees) of the west edge of the cached area.
+     * @param[in] north latitude (degrees) of the north edge of the cached
+     *   area.
+     * @param[in] east longitude (degrees) of the east edge of the cached area.
+     * @exception GeographicErr if the memory necessary for caching the data
+     *   can't be allocated or exceeds the memory budget (in this case the
+     *   existing cache is unchanged).
+     * @exception GeographicErr if there's a problem reading the data.
+     * @exception GeographicErr if this is called on a threadsafe Geoid.
+     *
+     * This is the same as CacheArea except that the areas cached previously
+     * are retained, so that several areas, e.g., around cities, can be held
+     * in memory.  A lookup checks the area used most recently first.  If the
+     * memory used by the cached areas exceeds the budget set by
+     * SetCacheBudget, the least recently used areas are discarded.
+     **********************************************************************/
+    void CacheAddArea(real south, real west, real north, real east) const;
+
+    /**
+     * Set the memory budget for the cache.
+     *
+     * @param[in] maxbytes the maximum number of bytes of data held by the
+     *   cached areas.
+     *
+     * The default is unlimited.  Areas are discarded, least recently used
+     * first, to meet the new budget; the cache is cleared if the area used
+     * most recently doesn't fit.  A subsequent CacheArea or CacheAddArea
+     * throws an exception if the area doesn't fit into the budget.
+     **********************************************************************/
+    void SetCacheBudget(size_t maxbytes) const;
+
+    /**
+     * Set whether cached areas are compressed.
+     *
+     * @param[in] compress if true, the areas cached subsequently by
+     *   CacheArea, CacheAddArea, and CacheAll are held in compressed form.
+     *
+     * The default is false.  A compressed area is divided into blocks of 16
+     * &times; 16 pixels and the pixels of each block are stored as the
+     * differences from the smallest value in the block, packed into the
+     * fewest bits which can hold the differences.  Since the geoid is
+     * smooth, this substantially reduces the memory needed (the saving is
+     * larger for finer grids) and the pixels can still be accessed directly
+     * without decoding a whole block.  Looking up a pixel costs a few extra
+     * instructions.  The areas which are already cached are not changed.
+     **********************************************************************/
+    void SetCacheCompression(bool compress) const { _compress = compress; }
+
+    /**
+     * Set whether the interpolation coefficients are precomputed for cached
+     * areas.
+     *
+     * @param[in] precompute if true, the coefficients of the fit used for
+     *   cubic interpolation are computed for every cell of the areas cached
+     *   subsequently by CacheArea, CacheAddArea, and CacheAll.
+     *
+     * The default is false.  Normally the coefficients of the cubic fit to
+     * the 12 pixels surrounding a cell are only computed when a query falls
+     * in a different cell from the last one.  This is fast for queries
+     * which move smoothly over the grid, but random queries require the fit
+     * to be recomputed nearly every time.  Precomputing the coefficients
+     * means that a query only costs the evaluation of the cubic polynomial;
+     * however, the 10 coefficients for each cell take 40 times as much
+     * memory as the pixels (with double precision and 2-byte pixels) and
+     * this counts against the budget set by SetCacheBudget.
+     * This setting has no effect with bilinear interpolation.  The results
+     * are identical to those without precomputation.  The cells within a
+     * pixel of the edges of the area, and at longitude 0 when all the data
+     * is cached, are interpolated in the usual way.  The areas which are
+     * already cached are not changed.
+     **********************************************************************/
+    void SetCachePrecompute(bool precompute) const
+    { _precompute = precompute; }
+
     /**
      * Cache all the data.
      *
@@ -264,8 +643,124 @@ namespace GeographicLib {
      **********************************************************************/
     void CacheClear() const;
 
+    /**
+     * Interleave the cached areas across the NUMA nodes.
+     *
+     * @return whether the memory policy was applied to all the cached areas;
+     *   this is false if nothing is cached.
+     *
+     * On a multi-socket system, the pages of a cached area are normally
+     * allocated on the node of the thread which filled the cache, so that
+     * threads on the other nodes see a lower memory bandwidth.  This spreads
+     * the pages across all the nodes (see Utility::interleave) and should be
+     * called after the data is cached and before the Geoid is used by
+     * threads on several nodes; areas cached subsequently aren't affected.
+     * The memory mapped data file isn't affected; so, for example, call
+     * CacheAll first.  The results are unchanged.
+     **********************************************************************/
+    bool CacheInterleave() const;
+
+    /**
+     * Load the data for an area in the background.
+     *
+     * @param[in] south latitude (degrees) of the south edge of the area.
+     * @param[in] west longitude (degrees) of the west edge of the area.
+     * @param[in] north latitude (degrees) of the north edge of the area.
+     * @param[in] east longitude (degrees) of the east edge of the area.
+     * @exception GeographicErr if the Geoid is neither thread safe nor
+     *   memory mapped nor reading from a Source.
+     * @return a future which becomes ready when the data has been loaded;
+     *   its get() function rethrows any error in reading the data.
+     *
+     * This starts a thread which brings into memory the data needed for
+     * evaluating the geoid height within the specified area, which is given
+     * as for CacheArea, so that later queries there do not wait for the
+     * data to be read.  With a memory mapped data file, the pages of the
+     * file holding the data are read into the page cache.  Otherwise (for a
+     * thread safe Geoid or one reading from a Source), the tiles covering
+     * the area are loaded into the tile cache; this never evicts tiles which
+     * are already cached and so tiles which don't fit into the cache are
+     * skipped.  The area cache set up by CacheArea is not changed.  The
+     * geoid may be evaluated while the prefetch is running.  The Geoid must
+     * not be destroyed until the future is ready; note that the destructor
+     * of the future waits for the prefetch to finish, so the future should
+     * be kept until the data is needed.
+     **********************************************************************/
+    std::future<void> Prefetch(real south, real west,
+                               real north, real east) const;
+
+    /**
+     * Cache the data for an area in the background.
+     *
+     * @param[in] south latitude (degrees) of the south edge of the cached
+     *   area.
+     * @param[in] west longitude (degrees) of the west edge of the cached area.
+     * @param[in] north latitude (degrees) of the north edge of the cached
+     *   area.
+     * @param[in] east longitude (degrees) of the east edge of the cached area.
+     * @exception GeographicErr if this is called on a threadsafe Geoid.
+     * @return a future which becomes ready when the area has been cached;
+     *   its get() function rethrows any error thrown by CacheArea.
+     *
+     * This starts a thread which calls CacheArea(\e south, \e west, \e
+     * north, \e east), so that the calling thread (e.g., one running an
+     * event loop) doesn't wait for the data to be read.  Unlike Prefetch,
+     * this changes the state of the Geoid; so the Geoid must not be used in
+     * any other way until the future is ready.  The destructor of the
+     * future waits for the thread to finish.
+     **********************************************************************/
+    std::future<void> CacheAreaAsync(real south, real west,
+                                     real north, real east) const;
+
+    /**
+     * Write the data in the tiled format.
+     *
+     * @param[in] filename the name of the file to write.
+     * @param[in] compress (optional) if true (the default), compress the
+     *   tiles.
+     * @exception GeographicErr if the file can't be written or there's a
+     *   problem reading the data.
+     *
+     * This writes the data of the geoid, together with the metadata
+     * returned by Offset(), Scale(), Description(), DateTime(), and the
+     * errors for both methods of interpolation, in the tiled format
+     * described in \ref geoidformat.  The file should be given the name of
+     * the geoid with the suffix ".tgm" so that it is found by the
+     * constructor.  With \e compress, each tile is stored as the
+     * differences of consecutive pixels packed into the fewest bits (unless
+     * this is larger than the raw pixels); this typically halves the size
+     * of the file.  This is typically used to convert a PGM file; it must
+     * not be called while the geoid is being evaluated by other threads
+     * unless the Geoid is thread safe.
+     **********************************************************************/
+    void WriteTiled(const std::string& filename, bool compress = true) const;
+
     ///@}
 
+    /**
+     * \brief A single-cell cache owned by the caller
+     *
+     * A thread safe Geoid does not cache the interpolation coefficients for
+     * the last cell used, so consecutive calls to operator()(real, real)
+     * const in the same cell recompute them.  Instead, each thread can hold
+     * a Context and pass it to operator()(real, real, Context&) const; this
+     * caches the coefficients for the last cell used by that thread.  A
+     * Context remembers the Geoid it was last used with and is reset when it
+     * is used with a different one; it must not be shared between threads.
+     **********************************************************************/
+    class Context {
+    private:
+      friend class Geoid;
+      const Geoid* _geoid;
+      int _ix, _iy;
+      real _t[nterms_];
+    public:
+      /**
+       * Constructor for an empty Context.
+       **********************************************************************/
+      Context() : _geoid(nullptr), _ix(0), _iy(0), _t() {}
+    };
+
     /** \name Compute geoid heights
      **********************************************************************/
     ///@{
@@ -285,6 +780,136 @@ namespace GeographicLib {
       return height(lat, lon);
     }
 
+    /**
+     * Compute the geoid height at a point using a caller-owned cell cache.
+     *
+     * @param[in] lat latitude of the point (degrees).
+     * @param[in] lon longitude of the point (degrees).
+     * @param[in,out] ctx the Context holding the coefficients for the last
+     *   cell used.
+     * @exception GeographicErr if there's a problem reading the data; this
+     *   never happens if (\e lat, \e lon) is within a successfully cached
+     *   area.
+     * @return the height of the geoid above the ellipsoid (meters).
+     *
+     * The result is the same as operator()(\e lat, \e lon).  This function
+     * does not use or change the single-cell cache in the Geoid, so it may be
+     * called concurrently, with a separate \e ctx in each thread, if the
+     * Geoid is thread safe.
+     **********************************************************************/
+    Math::real operator()(real lat, real lon, Context& ctx) const;
+
+    /**
+     * Compute the geoid heights at an array of points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of latitudes of the points (degrees).
+     * @param[in] lon array of longitudes of the points (degrees).
+     * @param[out] h array of heights of the geoid above the ellipsoid
+     *   (meters).
+     * @exception GeographicErr if there's a problem reading the data; this
+     *   never happens if all the points are within a successfully cached
+     *   area.
+     * @exception std::bad_alloc if the memory for sorting the points can't be
+     *   allocated.
+     *
+     * The result is the same as calling operator()(\e lat[i], \e lon[i]) for
+     * each point.  However the points are processed in the order of the grid
+     * cells containing them, so that the interpolation coefficients for a
+     * cell are computed only once and the data is accessed in the order it is
+     * stored in the file.  This is much faster than the single point function
+     * for large numbers of scattered points.  This function does not use or
+     * change the single-cell cache, so it may be called concurrently if the
+     * Geoid is thread safe.  With bilinear interpolation, if the data file
+     * is memory mapped or an uncompressed area is cached, the points are
+     * instead processed in their original order in blocks whose pixels are
+     * read directly from memory; the results are the same.
+     **********************************************************************/
+    void operator()(size_t n, const real lat[], const real lon[],
+                    real h[]) const;
+
+    /**
+     * Compute the geoid height at a point in the background.
+     *
+     * @param[in] lat latitude of the point (degrees).
+     * @param[in] lon longitude of the point (degrees).
+     * @exception GeographicErr if the Geoid is not thread safe.
+     * @return a future holding the height of the geoid above the ellipsoid
+     *   (meters); its get() function rethrows any error in reading the data.
+     *
+     * This starts a thread which computes operator()(\e lat, \e lon), so
+     * that the calling thread doesn't wait for the data to be read from
+     * disk.  The Geoid must not be destroyed until the future is ready.
+     **********************************************************************/
+    std::future<Math::real> HeightAsync(real lat, real lon) const;
+
+    /**
+     * Compute the geoid heights at an array of points in the background.
+     *
+     * @param[in] lat the latitudes of the points (degrees).
+     * @param[in] lon the longitudes of the points (degrees).
+     * @exception GeographicErr if the Geoid is not thread safe or if \e lat
+     *   and \e lon have different sizes.
+     * @return a future holding the heights of the geoid above the ellipsoid
+     *   (meters); its get() function rethrows any error in computing them.
+     *
+     * This is the same as operator()(size_t, const real[], const real[],
+     * real[]) const evaluated on a separate thread.  The points are taken
+     * by value (so they can be moved into the call) and this is the
+     * preferred way of dealing with many points, since only one thread is
+     * started.  The Geoid must not be destroyed until the future is ready.
+     **********************************************************************/
+    std::future<std::vector<Math::real> >
+    HeightAsync(std::vector<real> lat, std::vector<real> lon) const;
+
+    /**
+     * Export the interpolating polynomials for the cells covering an area.
+     *
+     * @param[in] south latitude (degrees) of the south edge of the area.
+     * @param[in] west longitude (degrees) of the west edge of the area.
+     * @param[in] north latitude (degrees) of the north edge of the area.
+     * @param[in] east longitude (degrees) of the east edge of the area.
+     * @param[out] c the coefficients of the polynomials, 10 per cell.
+     * @param[out] lat0 the latitude of the north edge of the first row of
+     *   cells (degrees).
+     * @param[out] lon0 the longitude of the west edge of the first column of
+     *   cells (degrees).
+     * @param[out] dlat the latitude spacing of the cells (degrees).
+     * @param[out] dlon the longitude spacing of the cells (degrees).
+     * @param[out] nlat the number of rows of cells.
+     * @param[out] nlon the number of columns of cells.
+     * @exception GeographicErr if there's a problem reading the data.
+     * @exception std::bad_alloc if the memory for \e c can't be allocated.
+     *
+     * The area is specified as for CacheArea.  This allows the geoid to be
+     * evaluated elsewhere, e.g., by a kernel on a GPU which is given \e c
+     * as an array in device memory; the kernel just needs to locate the
+     * cell and evaluate a polynomial (with no branches for the method of
+     * interpolation).  Let \e x = (\e lon &minus; \e lon0) / \e dlon,
+     * with \e lon reduced to [\e lon0, \e lon0 + 360&deg;), and \e y =
+     * (\e lat0 &minus; \e lat) / \e dlat; let \e i = floor(\e x), \e j
+     * = min(floor(\e y), \e nlat &minus; 1), \e fx = \e x &minus; \e i,
+     * and \e fy = \e y &minus; \e j.  Then, with \e t = \e c + 10 (\e j
+     * \e nlon + \e i), the geoid height (in meters) is
+     * \code
+     t[0] + fx * (t[1] + fx * (t[3] + fx * t[6])) +
+     fy * (t[2] + fx * (t[4] + fx * t[7]) +
+           fy * (t[5] + fx * t[8] + fy * t[9]))
+     \endcode
+     * For points within the area, this reproduces the results of
+     * operator()(real, real) const, except for the rounding of \e c to
+     * floats (about 10 &mu;m for heights of 100 m, much less than the
+     * interpolation errors given by MaxError()).  With bilinear
+     * interpolation, only \e t[0], \e t[1], \e t[2], and \e t[4] are
+     * nonzero.  The coefficients take 40 bytes per cell, so the whole of
+     * the 5' grids needs 37 MB; for finer grids it is usually better to
+     * export just the areas covering the points.
+     **********************************************************************/
+    void CellCoefficients(real south, real west, real north, real east,
+                          std::vector<float>& c, real& lat0, real& lon0,
+                          real& dlat, real& dlon, int& nlat, int& nlon)
+      const;
+
     /**
      * Convert a height above the geoid to a height above the ellipsoid and
      * vice versa.
@@ -383,13 +1008,113 @@ namespace GeographicLib {
      **********************************************************************/
     bool ThreadSafe() const { return _threadsafe; }
 
+    /**
+     * @return true if the data file is memory mapped.
+     **********************************************************************/
+    bool MemoryMapped() const { return _mmap != nullptr; }
+
+    /**
+     * @return true if the data is in the tiled format.
+     **********************************************************************/
+    bool Tiled() const { return _tiled; }
+
     /**
      * @return true if a data cache is active.
      **********************************************************************/
     bool Cache() const { return _cache; }
 
+    /**
+     * @return the number of cached areas.
+     **********************************************************************/
+    size_t CacheAreas() const
+    { return _cache ? _areas.size() + 1 : 0; }
+
+    /**
+     * @return the memory budget for the cache set by SetCacheBudget.
+     **********************************************************************/
+    size_t CacheBudget() const { return _cachebudget; }
+
+    /**
+     * @return whether areas cached subsequently are compressed.
+     **********************************************************************/
+    bool CacheCompression() const { return _compress; }
+
+    /**
+     * @return whether the coefficients are precomputed for areas cached
+     *   subsequently.
+     **********************************************************************/
+    bool CachePrecompute() const { return _precompute; }
+
+    /**
+     * @return the number of bytes of data held by the cached areas.
+     **********************************************************************/
+    size_t CacheBytes() const {
+      size_t bytes = _cache ? areabytes() : 0;
+      for (const cachearea& a : _areas)
+        bytes += areabytes(a);
+      return bytes;
+    }
+
+    /**
+     * \brief The memory used by a Geoid
+     *
+     * The sizes are in bytes.  The memory used by the cached areas and by
+     * the tiles of a thread safe Geoid is limited by the corresponding
+     * budgets.
+     **********************************************************************/
+    struct Memory {
+      /**
+       * The cached areas (the same as CacheBytes).
+       **********************************************************************/
+      size_t cache;
+      /**
+       * The budget for \e cache (the same as CacheBudget).
+       **********************************************************************/
+      size_t cachebudget;
+      /**
+       * The tiles read by a thread safe Geoid or one using the tiled format.
+       **********************************************************************/
+      size_t tiles;
+      /**
+       * The budget for \e tiles (0 if there's no tile cache).
+       **********************************************************************/
+      size_t tilebudget;
+      /**
+       * The index of the tiles of a file in the tiled format.
+       **********************************************************************/
+      size_t index;
+      /**
+       * The size of the memory mapped data file (0 if it isn't mapped).  The
+       * pages of the file are shared with the operating system's file cache
+       * and only use memory once they have been read.
+       **********************************************************************/
+      size_t mapped;
+      /**
+       * Constructor, all sizes are zero.
+       **********************************************************************/
+      Memory()
+        : cache(0), cachebudget(0), tiles(0), tilebudget(0), index(0)
+        , mapped(0) {}
+      /**
+       * @return the memory allocated by the Geoid, \e cache + \e tiles +
+       *   \e index (this excludes \e mapped).
+       **********************************************************************/
+      size_t Total() const { return cache + tiles + index; }
+    };
+
+    /**
+     * @return the memory used by the Geoid.
+     *
+     * This doesn't count the fixed size of the Geoid object itself.  With a
+     * thread safe Geoid, this may be called while other threads are
+     * evaluating heights.
+     **********************************************************************/
+    Memory MemoryUsage() const;
+
     /**
      * @return west edge of the cached area; the cache includes this edge.
+     *   This and the following three functions refer to the area used most
+     *   recently, if several areas are cached.
      **********************************************************************/
     Math::real CacheWest() const {
       return _cache ? ((_xoffset + (_xsize == _width ? 0 : _cubic)
@@ -49,10 +49,18 @@ namespace GeographicLib {
     static constexpr int baselen_ = 4;
     static constexpr int maxprec_ = 11;        // approximately equivalent to MGRS class
     static constexpr int maxlen_ = baselen_ + 2 * maxprec_;
+    static void GenReverse(const char* georef, int len, real& lat, real& lon,
+                           int& prec, bool centerp);
     Georef() = delete;          // Disable constructor
 
   public:
 
+    /**
+     * The size of a char array which can hold any georef produced by the char
+     * array versions of Forward, including the terminating null.
+     **********************************************************************/
+    enum { MAXBUF = maxlen_ + 1 };
+
     /**
      * Convert from geographic coordinates to georef.
      *
@@ -108,6 +116,76 @@ namespace GeographicLib {
     static void Reverse(const std::string& georef, real& lat, real& lon,
                         int& prec, bool centerp = true);
 
+    /**
+     * Convert from geographic coordinates to georef in a char array.
+     *
+     * @param[in] lat latitude of point (degrees).
+     * @param[in] lon longitude of point (degrees).
+     * @param[in] prec the precision of the resulting georef.
+     * @param[out] georef a char array of at least Georef::MAXBUF characters
+     *   which receives the null-terminated georef.
+     * @exception GeographicErr if \e lat is not in [&minus;90&deg;,
+     *   90&deg;].
+     *
+     * This is the same as the version returning a std::string, except that
+     * no memory is allocated.
+     **********************************************************************/
+    static void Forward(real lat, real lon, int prec, char georef[]);
+
+    /**
+     * Convert many geographic coordinates to georef.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of \e n latitudes (degrees).
+     * @param[in] lon array of \e n longitudes (degrees).
+     * @param[in] prec the precision of the resulting georef.
+     * @param[out] georef a char array of \e n \e width characters; georef
+     *   \e i is written null-terminated starting at georef[\e i \e width].
+     * @param[in] width the spacing of the strings in \e georef; this must
+     *   be at least 8 and exceed the length of the georef for \e prec.
+     * @exception GeographicErr if \e width is too small or if any latitude
+     *   is not in [&minus;90&deg;, 90&deg;].
+     **********************************************************************/
+    static void Forward(size_t n, const real lat[], const real lon[],
+                        int prec, char georef[], size_t width);
+
+    /**
+     * Convert from georef given as a null-terminated char array to
+     * geographic coordinates.
+     *
+     * @param[in] georef the georef.
+     * @param[out] lat latitude of point (degrees).
+     * @param[out] lon longitude of point (degrees).
+     * @param[out] prec the precision of \e georef.
+     * @param[in] centerp if true (the default) return the center of the
+     *   \e georef, otherwise return the south-west corner.
+     * @exception GeographicErr if \e georef is illegal.
+     *
+     * This is the same as the version taking a std::string, except that no
+     * memory is allocated unless an error is thrown.
+     **********************************************************************/
+    static void Reverse(const char* georef, real& lat, real& lon,
+                        int& prec, bool centerp = true);
+
+    /**
+     * Convert many georef strings to geographic coordinates.
+     *
+     * @param[in] n the number of strings.
+     * @param[in] georef a char array of \e n \e width characters; string
+     *   \e i starts at georef[\e i \e width] and ends at the first null or
+     *   after \e width characters.
+     * @param[in] width the spacing of the strings in \e georef.
+     * @param[out] lat array of \e n latitudes (degrees).
+     * @param[out] lon array of \e n longitudes (degrees).
+     * @param[out] prec array of \e n precisions; this may be a null pointer.
+     * @param[in] centerp if true (the default) return the center of the
+     *   squares, otherwise return the south-west corners.
+     * @exception GeographicErr if any string is illegal.
+     **********************************************************************/
+    static void Reverse(size_t n, const char georef[], size_t width,
+                        real lat[], real lon[], int prec[] = nullptr,
+                        bool centerp = true);
+
     /**
      * The angular resolution of a Georef.
      *
@@ -114,6 +114,13 @@ namespace GeographicLib {
     // iterations, the convergence in the Reverse falls back to improvements in
     // each step by a constant (albeit small) factor.
     static const int numit_ = 20;
+    // The capabilities of the geodesic lines used by Reverse
+    static const unsigned caps_ = Geodesic::LATITUDE | Geodesic::LONGITUDE |
+      Geodesic::AZIMUTH | Geodesic::DISTANCE_IN |
+      Geodesic::REDUCEDLENGTH | Geodesic::GEODESICSCALE;
+    // Reverse for a point at distance rho along line from the center
+    void GenReverse(const GeodesicLine& line, real rho,
+                    real& lat, real& lon, real& azi, real& rk) const;
   public:
 
     /**
@@ -174,6 +181,58 @@ namespace GeographicLib {
     void Reverse(real lat0, real lon0, real x, real y,
                  real& lat, real& lon, real& azi, real& rk) const;
 
+    /**
+     * Forward projection of many points about a common center.
+     *
+     * @param[in] lat0 latitude of center point of projection (degrees).
+     * @param[in] lon0 longitude of center point of projection (degrees).
+     * @param[in] n the number of points.
+     * @param[in] lat array of \e n latitudes (degrees).
+     * @param[in] lon array of \e n longitudes (degrees).
+     * @param[out] x array of \e n eastings (meters).
+     * @param[out] y array of \e n northings (meters).
+     * @param[out] azi array of \e n azimuths of the geodesics at the points
+     *   (degrees); this may be a null pointer.
+     * @param[out] rk array of \e n reciprocals of the azimuthal scale; this
+     *   may be a null pointer.
+     *
+     * Element \e i of the output arrays is set to the result of
+     * Gnomonic::Forward applied to element \e i of the input arrays; the
+     * results are bitwise identical.  The quantities depending on the
+     * center are computed once, with Geodesic::InverseFrom; however, as
+     * noted for GeodesicOrigin, this only saves a few percent.  The input
+     * and output arrays must not overlap.
+     **********************************************************************/
+    void Forward(real lat0, real lon0, size_t n,
+                 const real lat[], const real lon[], real x[], real y[],
+                 real azi[] = nullptr, real rk[] = nullptr) const;
+
+    /**
+     * Reverse projection of many points about a common center.
+     *
+     * @param[in] lat0 latitude of center point of projection (degrees).
+     * @param[in] lon0 longitude of center point of projection (degrees).
+     * @param[in] n the number of points.
+     * @param[in] x array of \e n eastings (meters).
+     * @param[in] y array of \e n northings (meters).
+     * @param[out] lat array of \e n latitudes (degrees).
+     * @param[out] lon array of \e n longitudes (degrees).
+     * @param[out] azi array of \e n azimuths of the geodesics at the points
+     *   (degrees); this may be a null pointer.
+     * @param[out] rk array of \e n reciprocals of the azimuthal scale; this
+     *   may be a null pointer.
+     *
+     * Element \e i of the output arrays is set to the result of
+     * Gnomonic::Reverse applied to element \e i of the input arrays; the
+     * results are bitwise identical.  The GeodesicLine from the center is
+     * reused while the azimuth atan2(\e x, \e y) is unchanged, so it pays to
+     * order the points along radials.  The input and output arrays must not
+     * overlap.
+     **********************************************************************/
+    void Reverse(real lat0, real lon0, size_t n,
+                 const real x[], const real y[], real lat[], real lon[],
+                 real azi[] = nullptr, real rk[] = nullptr) const;
+
     /**
      * Gnomonic::Forward without returning the azimuth and scale.
      **********************************************************************/
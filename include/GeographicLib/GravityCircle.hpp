@@ -149,6 +149,43 @@ namespace GeographicLib {
     void SphericalAnomaly(real lon, real& Dg01, real& xi, real& eta)
       const;
 
+    /**
+     * Evaluate the geoid height for a row of equally spaced longitudes.
+     *
+     * @param[in] lon0 the first longitude (degrees).
+     * @param[in] dlon the longitude spacing (degrees).
+     * @param[in] n the number of longitudes.
+     * @param[out] N the heights of the geoid above the reference ellipsoid
+     *   (meters) at lon0 + \e i dlon for \e i = 0, 1, ..., \e n &minus; 1.
+     * @exception std::bad_alloc if the temporary storage can't be allocated.
+     *
+     * The results are identical to calling GeoidHeight(real) const for each
+     * longitude; however the sums are evaluated using
+     * CircularEngine::Values which is faster.
+     **********************************************************************/
+    void GeoidHeight(real lon0, real dlon, int n, real N[]) const;
+
+    /**
+     * Evaluate the components of the gravity anomaly vector using the
+     * spherical approximation for a row of equally spaced longitudes.
+     *
+     * @param[in] lon0 the first longitude (degrees).
+     * @param[in] dlon the longitude spacing (degrees).
+     * @param[in] n the number of longitudes.
+     * @param[out] Dg01 the gravity anomalies (m s<sup>&minus;2</sup>).
+     * @param[out] xi the northerly components of the deflection of the
+     *   vertical (degrees).
+     * @param[out] eta the easterly components of the deflection of the
+     *   vertical (degrees).
+     * @exception std::bad_alloc if the temporary storage can't be allocated.
+     *
+     * The results are identical to calling SphericalAnomaly(real, real&,
+     * real&, real&) const for each longitude.  \e xi and \e eta may be null,
+     * in which case they are not set.
+     **********************************************************************/
+    void SphericalAnomaly(real lon0, real dlon, int n,
+                          real Dg01[], real xi[], real eta[]) const;
+
     /**
      * Evaluate the components of the acceleration due to gravity and the
      * centrifugal acceleration in geocentric coordinates.
@@ -273,6 +310,15 @@ namespace GeographicLib {
     bool Capabilities(unsigned testcaps) const {
       return (_caps & testcaps) == testcaps;
     }
+
+    /**
+     * @return the memory (in bytes) used by the GravityCircle, including the
+     *   object itself.
+     **********************************************************************/
+    size_t MemoryUsage() const {
+      return sizeof(*this) + _gravitational.MemoryUsage() +
+        _disturbing.MemoryUsage() + _correction.MemoryUsage();
+    }
     ///@}
   };
 
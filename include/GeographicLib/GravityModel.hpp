@@ -10,6 +10,8 @@
 #if !defined(GEOGRAPHICLIB_GRAVITYMODEL_HPP)
 #define GEOGRAPHICLIB_GRAVITYMODEL_HPP 1
 
+#include <future>
+#include <memory>
 #include <GeographicLib/Constants.hpp>
 #include <GeographicLib/NormalGravity.hpp>
 #include <GeographicLib/SphericalHarmonic.hpp>
@@ -89,13 +91,41 @@ namespace GeographicLib {
     real _amodel, _gGMmodel, _zeta0, _corrmult;
     int _nmx, _mmx;
     SphericalHarmonic::normalization _norm;
+    // Memory mapped coefficient file (or nullptr if not mapped)
+    void* _mmap;
+    size_t _mmapsize;
     NormalGravity _earth;
     std::vector<real> _cCx, _sSx, _cCC, _cCS, _zonal;
+    // The coefficients if they are stored as floats
+    std::vector<float> _cCxf, _sSxf, _cCCf, _cCSf, _zonalf;
     real _dzonal0;              // A left over contribution to _zonal.
     SphericalHarmonic _gravitational;
     SphericalHarmonic1 _disturbing;
     SphericalHarmonic _correction;
     void ReadMetadata(const std::string& name);
+    // Finish the construction given the coefficients.
+    void Init(const SphericalEngine::coeff& cgrav,
+              const SphericalEngine::coeff& ccorr);
+    // Read the coefficients into C, S (the model) and CC, CS (the
+    // correction); CoeffT is real or float.
+    template<typename CoeffT>
+    void ReadCoefficients(std::istream& coeffstr, bool truncate,
+                          int Nmax, int Mmax,
+                          std::vector<CoeffT>& C, std::vector<CoeffT>& S,
+                          std::vector<CoeffT>& CC, std::vector<CoeffT>& CS,
+                          SphericalEngine::coeff& cgrav,
+                          SphericalEngine::coeff& ccorr);
+    bool MapCoefficients(const std::string& coeff, bool truncate,
+                         int Nmax, int Mmax,
+                         SphericalEngine::coeff& cgrav,
+                         SphericalEngine::coeff& ccorr);
+    // Construct the GravityCircle for lat, h (with geocentric coordinates
+    // X, 0, Z and rotation matrix M) given its CircularEngine objects.
+    GravityCircle MakeCircle(real lat, real h, unsigned caps,
+                             real X, real Z, const real M[],
+                             const CircularEngine& gravitational,
+                             const CircularEngine& disturbing,
+                             const CircularEngine& correction) const;
     Math::real InternalT(real X, real Y, real Z,
                          real& deltaX, real& deltaY, real& deltaZ,
                          bool gradp, bool correct) const;
@@ -171,6 +201,8 @@ namespace GeographicLib {
      *   model this value.
      * @param[in] Mmax (optional) if non-negative, truncate the order of the
      *   model this value.
+     * @param[in] single (optional) if true, store the coefficients as floats
+     *   (default false).
      * @exception GeographicErr if the data file cannot be found, is
      *   unreadable, or is corrupt, or if \e Mmax > \e Nmax.
      * @exception std::bad_alloc if the memory necessary for storing the model
@@ -189,10 +221,77 @@ namespace GeographicLib {
      * If \e Nmax &ge; 0 and \e Mmax < 0, then \e Mmax is set to \e Nmax.
      * After the model is loaded, the maximum degree and order of the model can
      * be found by the Degree() and Order() methods.
+     *
+     * On systems which support it (POSIX), if Math::real is \e double and the
+     * machine is little-endian, the coefficient file is memory mapped and the
+     * coefficients are used in place.  This makes constructing a high degree
+     * model nearly instantaneous and lets processes using the same model
+     * share its coefficients via the page cache.  Otherwise the coefficients
+     * are read into memory.  Compile with GEOGRAPHICLIB_GRAVITY_MMAP = 0 to
+     * disable memory mapping.
+     *
+     * If \e single is true, the coefficients are read into memory and
+     * rounded to floats (the sums are still accumulated as Math::real).  This
+     * halves the memory for the coefficients and the memory traffic in the
+     * sums (which can limit the speed when many threads evaluate a high
+     * degree model); for egm2008, this memory drops from 76 MB to 38 MB.
+     * Memory mapping is not used in this case.  The rounding changes
+     * the geoid height by less than 1 mm and the gravity disturbance by less
+     * than 1 &mu;Gal (10<sup>&minus;8</sup> m s<sup>&minus;2</sup>).  The
+     * biggest errors come from the rounding of \e C<sub>20</sub> and of the
+     * corresponding term for the normal potential; the errors from the many
+     * higher degree terms are small and random.
      **********************************************************************/
     explicit GravityModel(const std::string& name,
                           const std::string& path = "",
-                          int Nmax = -1, int Mmax = -1);
+                          int Nmax = -1, int Mmax = -1, bool single = false);
+
+    /**
+     * Construct a truncated view of a gravity model.
+     *
+     * @param[in] model the gravity model.
+     * @param[in] Nmax the maximum degree of the view.
+     * @param[in] Mmax the maximum order of the view (default &minus;1).
+     * @exception GeographicErr if \e Nmax and \e Mmax are not valid.
+     *
+     * The sums for the view are taken only up to degree \e Nmax and order
+     * \e Mmax.  The results are the same as those for a GravityModel
+     * constructed with the same name, \e Nmax, and \e Mmax, and the
+     * interpretation of \e Nmax and \e Mmax is the same (except that a
+     * view can't increase the degree and order of \e model).  The view
+     * shares the coefficients of \e model, so it is cheap to make, e.g.,
+     * for serving requests at different resolutions.  \e model must
+     * outlive the view.
+     **********************************************************************/
+    GravityModel(const GravityModel& model, int Nmax, int Mmax = -1);
+
+    /**
+     * Construct a gravity model in the background.
+     *
+     * @param[in] name the name of the model.
+     * @param[in] path (optional) directory for data file.
+     * @param[in] Nmax (optional) if non-negative, truncate the degree of the
+     *   model this value.
+     * @param[in] Mmax (optional) if non-negative, truncate the order of the
+     *   model this value.
+     * @param[in] single (optional) if true, store the coefficients as floats
+     *   (default false).
+     * @return a future holding the model.
+     *
+     * This constructs the model, with the same arguments as
+     * GravityModel(const std::string&, const std::string&, int, int, bool),
+     * on a new thread so that reading the coefficients can overlap other
+     * initialization.  Any exception thrown by the constructor is rethrown
+     * by the \e get() method of the future.
+     **********************************************************************/
+    static std::future< std::unique_ptr<GravityModel> >
+    Load(const std::string& name, const std::string& path = "",
+         int Nmax = -1, int Mmax = -1, bool single = false);
+
+    /**
+     * The destructor unmaps the coefficient file (if it is memory mapped).
+     **********************************************************************/
+    ~GravityModel();
     ///@}
 
     /** \name Compute gravity in geodetic coordinates
@@ -219,6 +318,32 @@ namespace GeographicLib {
     Math::real Gravity(real lat, real lon, real h,
                        real& gx, real& gy, real& gz) const;
 
+    /**
+     * Evaluate the gravity at several points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat the geographic latitudes (degrees).
+     * @param[in] lon the geographic longitudes (degrees).
+     * @param[in] h the heights above the ellipsoid (meters).
+     * @param[out] W the sums of the gravitational and centrifugal potentials
+     *   (m<sup>2</sup> s<sup>&minus;2</sup>).
+     * @param[out] gx the easterly components of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] gy the northerly components of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] gz the upward components of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     *
+     * This gives the same results as calling Gravity(real, real, real, real&,
+     * real&, real&) const for each point.  However the spherical harmonic
+     * sums are evaluated for several points together (see
+     * SphericalEngine::Values) which is substantially faster for high degree
+     * models such as EGM2008.  The output arrays may coincide with the input
+     * arrays.
+     **********************************************************************/
+    void Gravity(size_t n, const real lat[], const real lon[], const real h[],
+                 real W[], real gx[], real gy[], real gz[]) const;
+
     /**
      * Evaluate the gravity disturbance vector at an arbitrary point above (or
      * below) the ellipsoid.
@@ -273,6 +398,61 @@ namespace GeographicLib {
      **********************************************************************/
     void SphericalAnomaly(real lat, real lon, real h,
                           real& Dg01, real& xi, real& eta) const;
+
+    /**
+     * Evaluate several gravitational quantities at a point together.
+     *
+     * @param[in] lat the geographic latitude (degrees).
+     * @param[in] lon the geographic longitude (degrees).
+     * @param[in] h the height above the ellipsoid (meters).
+     * @param[in] caps bitor'ed combination of GravityModel::mask values
+     *   specifying the quantities to compute.
+     * @param[out] W the sum of the gravitational and centrifugal potentials
+     *   (m<sup>2</sup> s<sup>&minus;2</sup>).
+     * @param[out] gx the easterly component of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] gy the northerly component of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] gz the upward component of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] T the disturbing potential
+     *   (m<sup>2</sup> s<sup>&minus;2</sup>).
+     * @param[out] deltax the easterly component of the disturbance vector
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] deltay the northerly component of the disturbance vector
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] deltaz the upward component of the disturbance vector
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] Dg01 the gravity anomaly (m s<sup>&minus;2</sup>).
+     * @param[out] xi the northerly component of the deflection of the vertical
+     *  (degrees).
+     * @param[out] eta the easterly component of the deflection of the vertical
+     *  (degrees).
+     * @param[out] N the height of the geoid above the ReferenceEllipsoid()
+     *   (meters).
+     *
+     * The quantities are selected with \e caps as for Circle:
+     * - \e caps |= GravityModel::GRAVITY gives \e W, \e gx, \e gy, \e gz;
+     * - \e caps |= GravityModel::DISTURBANCE gives \e T, \e deltax, \e
+     *   deltay, \e deltaz;
+     * - \e caps |= GravityModel::DISTURBING_POTENTIAL gives \e T;
+     * - \e caps |= GravityModel::SPHERICAL_ANOMALY gives \e Dg01, \e xi, \e
+     *   eta;
+     * - \e caps |= GravityModel::GEOID_HEIGHT gives \e N.
+     * .
+     * The quantities which are not requested are set to NaN and, as with
+     * Circle, GravityModel::GEOID_HEIGHT is only honored if \e h = 0.  The
+     * results agree to within roundoff with those of Gravity, Disturbance,
+     * SphericalAnomaly, and GeoidHeight.  However, if anything other than
+     * GravityModel::GRAVITY is requested, all the quantities are derived from
+     * a single evaluation of the disturbing potential and its gradient (with
+     * \e W = \e T + \e U and \e g = &delta; + &gamma;), instead of one
+     * evaluation of the spherical harmonic sum for each quantity.
+     **********************************************************************/
+    void Evaluate(real lat, real lon, real h, unsigned caps,
+                  real& W, real& gx, real& gy, real& gz,
+                  real& T, real& deltax, real& deltay, real& deltaz,
+                  real& Dg01, real& xi, real& eta, real& N) const;
     ///@}
 
     /** \name Compute gravity in geocentric coordinates
@@ -429,6 +609,87 @@ namespace GeographicLib {
      * (together with OpenMP) to speed up the computation of geoid heights.
      **********************************************************************/
     GravityCircle Circle(real lat, real h, unsigned caps = ALL) const;
+
+    /**
+     * Create GravityCircle objects for several heights at one latitude.
+     *
+     * @param[in] lat latitude of the points (degrees).
+     * @param[in] n the number of heights.
+     * @param[in] h the heights of the points above the ellipsoid (meters).
+     * @param[in] caps bitor'ed combination of GravityModel::mask values
+     *   specifying the capabilities of the resulting GravityCircle objects.
+     * @param[out] circ the \e n GravityCircle objects.
+     * @exception std::bad_alloc if the memory necessary for creating the
+     *   GravityCircle objects can't be allocated.
+     *
+     * This sets \e circ[\e i] = Circle(\e lat, \e h[\e i], \e caps) for
+     * each \e i (and the results agree to within roundoff).  However the
+     * sums over degree for the circles are done together with
+     * SphericalHarmonic::Circles, so that the work which depends only on the
+     * degree and order, and the loading of the coefficients, is shared by
+     * several heights.  With egm2008 and 8 or more heights, this is about
+     * 25% faster than calling Circle for each height.
+     **********************************************************************/
+    void Circles(real lat, size_t n, const real h[], unsigned caps,
+                 GravityCircle circ[]) const;
+
+    /**
+     * Evaluate the geoid height or the gravity anomaly on a regular grid.
+     *
+     * @param[in] south the latitude of the first row (degrees).
+     * @param[in] north the latitude of the last row (degrees).
+     * @param[in] dlat the latitude spacing (degrees).
+     * @param[in] west the longitude of the first column (degrees).
+     * @param[in] east the longitude of the last column (degrees).
+     * @param[in] dlon the longitude spacing (degrees).
+     * @param[in] h the height above the ellipsoid (meters).
+     * @param[in] quantity either GravityModel::GEOID_HEIGHT (giving the geoid
+     *   height in meters) or GravityModel::SPHERICAL_ANOMALY (giving the
+     *   gravity anomaly \e Dg01 in m s<sup>&minus;2</sup>).
+     * @param[out] vals the values on the grid.
+     * @param[out] nlat the number of rows.
+     * @param[out] nlon the number of columns.
+     * @param[in] nthreads the number of threads to use (default 1).
+     * @exception GeographicErr if \e quantity is not supported or if the
+     *   grid specification is invalid.
+     * @exception std::bad_alloc if the memory for the grid can't be
+     *   allocated.
+     *
+     * The rows are at latitudes \e south + \e i \e dlat for \e i = 0, 1,
+     * ..., \e nlat &minus; 1 and the columns are at longitudes \e west + \e j
+     * \e dlon for \e j = 0, 1, ..., \e nlon &minus; 1, where \e nlat and \e
+     * nlon are chosen so that the last row and column are at (or just below)
+     * \e north and \e east.  The value at (\e i, \e j) is stored in
+     * vals[\e i \e nlon + \e j].  Each row is computed with a GravityCircle
+     * (using GravityCircle::GeoidHeight(real, real, int, real[]) const or
+     * GravityCircle::SphericalAnomaly(real, real, int, real[], real[],
+     * real[]) const) and the rows are distributed over \e nthreads threads.
+     * The results are independent of \e nthreads and are identical to those
+     * given by the single point functions of GravityCircle.  As with Circle,
+     * GravityModel::GEOID_HEIGHT is only honored if \e h = 0; otherwise NaNs
+     * are returned.
+     **********************************************************************/
+    void Grid(real south, real north, real dlat,
+              real west, real east, real dlon, real h, unsigned quantity,
+              std::vector<real>& vals, int& nlat, int& nlon,
+              int nthreads = 1) const;
+
+    /**
+     * Interleave the coefficients across the NUMA nodes.
+     *
+     * @return whether the memory policy was applied to all the
+     *   coefficients; this is false if the coefficients are memory mapped.
+     *
+     * On a multi-socket system, the coefficients are normally allocated on
+     * the node of the thread which constructed the GravityModel, so that
+     * threads on the other nodes (e.g., the workers of Grid and of the
+     * array functions) see a lower memory bandwidth.  This spreads the
+     * pages of the coefficients across all the nodes (see
+     * Utility::interleave).  It should be called once after construction
+     * and before the model is used by threads on several nodes.  The
+     * results are unchanged.
+     **********************************************************************/
+    bool Interleave() const;
     ///@}
 
     /** \name Inspector functions
@@ -508,6 +769,53 @@ namespace GeographicLib {
      * @return \e Mmax the maximum order of the components of the model.
      **********************************************************************/
     int Order() const { return _mmx; }
+
+    /**
+     * @return true if the coefficient file is memory mapped.
+     *
+     * In this case the coefficients are used in place and the pages of the
+     * file are shared (via the page cache) by all the processes which load
+     * the same model.
+     **********************************************************************/
+    bool MemoryMapped() const { return _mmap != nullptr; }
+
+    /**
+     * \brief The memory used by a GravityModel
+     *
+     * The sizes are in bytes.
+     **********************************************************************/
+    struct Memory {
+      /**
+       * The coefficients of the model and of the correction to the geoid
+       * height, together with the zonal coefficients of the disturbing
+       * potential.
+       **********************************************************************/
+      size_t coefficients;
+      /**
+       * The size of the memory mapped coefficient file (0 if it isn't
+       * mapped); in this case, the coefficients are used in place and
+       * aren't counted in \e coefficients.
+       **********************************************************************/
+      size_t mapped;
+      /**
+       * Constructor, all sizes are zero.
+       **********************************************************************/
+      Memory() : coefficients(0), mapped(0) {}
+      /**
+       * @return the memory allocated by the GravityModel, \e coefficients
+       *   (this excludes \e mapped).
+       **********************************************************************/
+      size_t Total() const { return coefficients; }
+    };
+
+    /**
+     * @return the memory used by the GravityModel.
+     *
+     * The table of square roots used by all the spherical harmonic sums is
+     * reported by SphericalEngine::RootTableBytes.  The GravityCircle
+     * objects are reported by GravityCircle::MemoryUsage.
+     **********************************************************************/
+    Memory MemoryUsage() const;
     ///@}
 
     /**
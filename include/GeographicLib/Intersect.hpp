@@ -12,6 +12,7 @@
 
 #include <vector>
 #include <set>
+#include <atomic>
 #include <GeographicLib/Math.hpp>
 #include <GeographicLib/Geodesic.hpp>
 #include <GeographicLib/GeodesicLine.hpp>
@@ -158,28 +159,77 @@ namespace GeographicLib {
           (p.x != q.x ? (p.x < q.x) : (p.y < q.y));
       }
     };
+    // The counts accumulated during one call to a public function
+    struct Counts {
+      long long cnt0, cnt1, cnt2, cnt3, cnt4;
+      Counts() : cnt0(0), cnt1(0), cnt2(0), cnt3(0), cnt4(0) {}
+    };
+    // A diagnostic counter which may be updated by several threads at once;
+    // the copy constructor allows Intersect objects to be copied.
+    class Counter {
+    private:
+      std::atomic<long long> _n;
+    public:
+      Counter() : _n(0) {}
+      Counter(const Counter& c) : _n(c._n.load(std::memory_order_relaxed)) {}
+      void add(long long n) { _n.fetch_add(n, std::memory_order_relaxed); }
+      long long get() const { return _n.load(std::memory_order_relaxed); }
+    };
+    // Add the counts from a call to the diagnostic counters
+    void addcounts(const Counts& cnt) const {
+      _cnt0.add(cnt.cnt0); _cnt1.add(cnt.cnt1); _cnt2.add(cnt.cnt2);
+      _cnt3.add(cnt.cnt3); _cnt4.add(cnt.cnt4);
+    }
     // The spherical solution
     XPoint Spherical(const GeodesicLine& lineX, const GeodesicLine& lineY,
                      const XPoint& p) const;
+    // The internal functions add to the counts in cnt instead of the member
+    // counters, so they may be called concurrently.
     // The basic algorithm
     XPoint Basic(const GeodesicLine& lineX, const GeodesicLine& lineY,
-                 const XPoint& p0) const;
+                 const XPoint& p0, Counts& cnt) const;
     // The closest intersecton
     XPoint ClosestInt(const GeodesicLine& lineX, const GeodesicLine& lineY,
-                  const XPoint& p0) const;
+                      const XPoint& p0, Counts& cnt) const;
+    // ClosestInt starting with a search from hint
+    XPoint ClosestInt(const GeodesicLine& lineX, const GeodesicLine& lineY,
+                      const XPoint& p0, const XPoint& hint, Counts& cnt)
+      const;
     // The next intersecton
-    XPoint NextInt(const GeodesicLine& lineX, const GeodesicLine& lineY) const;
+    XPoint NextInt(const GeodesicLine& lineX, const GeodesicLine& lineY,
+                   Counts& cnt) const;
     // Segment intersecton
     XPoint SegmentInt(const GeodesicLine& lineX, const GeodesicLine& lineY,
-                      int& segmode) const;
+                      int& segmode, Counts& cnt) const;
     // All intersectons
     std::vector<XPoint>
     AllInt0(const GeodesicLine& lineX, const GeodesicLine& lineY,
-           Math::real maxdist, const XPoint& p0) const;
+            Math::real maxdist, const XPoint& p0, int nthreads,
+            Counts& cnt) const;
+    // Concurrent evaluation of Basic for a batch of starting points
+    void BasicBatch(const GeodesicLine& lineX, const GeodesicLine& lineY,
+                    const std::vector<XPoint>& start,
+                    const std::vector<bool>& skip, int k0, int k1,
+                    int nthreads, std::vector<XPoint>& qs,
+                    std::vector<Counts>& cnts) const;
     std::vector<Point>
     AllInternal(const GeodesicLine& lineX, const GeodesicLine& lineY,
                 Math::real maxdist, const Point& p0,
-                std::vector<int>& c, bool cp) const;
+                std::vector<int>& c, bool cp, int nthreads) const;
+    std::vector<Point>
+    SegmentsInternal(const GeodesicLine& lineX,
+                     const std::vector<GeodesicLine>& linesY,
+                     std::vector<int>& ind,
+                     std::vector<int>& c, bool cp, int nthreads) const;
+    std::vector<Point>
+    SelfInternal(size_t n, const Math::real lat[], const Math::real lon[],
+                 std::vector<std::pair<int, int>>& ind,
+                 std::vector<int>& c, bool cp, int nthreads) const;
+    std::vector<Point>
+    AllSegInternal(const std::vector<GeodesicLine>& linesX,
+                   const std::vector<GeodesicLine>& linesY,
+                   std::vector<std::pair<int, int>>& ind,
+                   std::vector<int>& c, bool cp, int nthreads) const;
     // Find {semi-,}conjugate point which is close to s3.  Optional m12, M12,
     // M21 use {semi-,}conjugacy relative to point 2
     Math::real ConjugateDist(const GeodesicLine& line, Math::real s3, bool semi,
@@ -203,7 +253,7 @@ namespace GeographicLib {
       return (p.x < 0 ? -1 : p.x <= sx ? 0 : 1) * 3
         + (p.y < 0 ? -1 : p.y <= sy ? 0 : 1);
     }
-    mutable long long _cnt0, _cnt1, _cnt2, _cnt3, _cnt4;
+    mutable Counter _cnt0, _cnt1, _cnt2, _cnt3, _cnt4;
   public:
     /** \name Constructor
      **********************************************************************/
@@ -269,6 +319,47 @@ namespace GeographicLib {
      **********************************************************************/
     Point Closest(const GeodesicLine& lineX, const GeodesicLine& lineY,
                   const Point& p0 = Point(0, 0), int* c = nullptr) const;
+    /**
+     * Find the closest intersection point starting from a guess, with each
+     *   geodesic specified by position and azimuth.
+     *
+     * @param[in] latX latitude of starting point for geodesic \e X (degrees).
+     * @param[in] lonX longitude of starting point for geodesic \e X  (degrees).
+     * @param[in] aziX azimuth at starting point for geodesic \e X (degrees).
+     * @param[in] latY latitude of starting point for geodesic \e Y (degrees).
+     * @param[in] lonY longitude of starting point for geodesic \e Y  (degrees).
+     * @param[in] aziY azimuth at starting point for geodesic \e Y (degrees).
+     * @param[in] p0 an offset for the starting points (meters).
+     * @param[in] hint a guess for the intersection point (meters).
+     * @param[out] c optional pointer to an integer coincidence indicator.
+     * @return \e p the intersection point closest to \e p0.
+     *
+     * This returns the same intersection as Closest(\e latX, \e lonX, \e
+     * aziX, \e latY, \e lonY, \e aziY, \e p0, \e c) (to roundoff).  The
+     * search first iterates from \e hint; if this converges to an
+     * intersection sufficiently close to \e p0 that it must be the closest,
+     * the rest of the search is skipped.  So a good \e hint, e.g., the
+     * result for slightly different geodesics, speeds up the calculation.
+     **********************************************************************/
+    Point Closest(Math::real latX, Math::real lonX, Math::real aziX,
+                  Math::real latY, Math::real lonY, Math::real aziY,
+                  const Point& p0, const Point& hint, int* c = nullptr) const;
+    /**
+     * Find the closest intersection point starting from a guess, with each
+     *   geodesic given as a GeodesicLine.
+     *
+     * @param[in] lineX geodesic \e X.
+     * @param[in] lineY geodesic \e Y.
+     * @param[in] p0 an offset for the starting points (meters).
+     * @param[in] hint a guess for the intersection point (meters).
+     * @param[out] c optional pointer to an integer coincidence indicator.
+     * @return \e p the intersection point closest to \e p0.
+     *
+     * This returns the same intersection as Closest(\e lineX, \e lineY, \e
+     * p0, \e c) (to roundoff).
+     **********************************************************************/
+    Point Closest(const GeodesicLine& lineX, const GeodesicLine& lineY,
+                  const Point& p0, const Point& hint, int* c = nullptr) const;
     /**
      * Find the intersection of two geodesic segments defined by their
      *   endpoints.
@@ -401,16 +492,28 @@ namespace GeographicLib {
      * @param[out] c vector of coincidences.
      * @param[in] p0 an optional offset for the starting points (meters),
      *   default = [0,0].
+     * @param[in] nthreads the number of threads to use (default 1).
      * @return \e plist a vector for the intersections closest to \e p0.
      *
      * Each intersection point satisfies Intersect::Dist(\e p, \e p0) &le; \e
      * maxdist.  The vector of returned intersections is sorted on the distance
      * from \e p0.
+     *
+     * With \e nthreads &gt; 1, the searches from the starting points which
+     * cover the region within \e maxdist of \e p0 are carried out by \e
+     * nthreads threads, a batch of starting points at a time.  The results of
+     * these searches are merged in the same order as for the serial
+     * calculation, so the returned intersections (and the diagnostic
+     * counters) are the same for any \e nthreads.  Some searches, from
+     * starting points which the serial calculation would skip because of an
+     * intersection found in the same batch, are wasted.  Because of the
+     * overhead of starting the threads, this is only worthwhile for large
+     * \e maxdist (many times the circumference of the ellipsoid).
      **********************************************************************/
     std::vector<Point> All(Math::real latX, Math::real lonX, Math::real aziX,
                            Math::real latY, Math::real lonY, Math::real aziY,
                            Math::real maxdist, std::vector<int>& c,
-                           const Point& p0 = Point(0, 0))
+                           const Point& p0 = Point(0, 0), int nthreads = 1)
       const;
     /**
      * Find all intersections within a certain distance, with each geodesic
@@ -427,15 +530,17 @@ namespace GeographicLib {
      *   (meters).
      * @param[in] p0 an optional offset for the starting points (meters),
      *   default = [0,0].
+     * @param[in] nthreads the number of threads to use (default 1).
      * @return \e plist a vector for the intersections closest to \e p0.
      *
      * Each intersection point satisfies Intersect::Dist(\e p, \e p0) &le; \e
      * maxdist.  The vector of returned intersections is sorted on the distance
-     * from \e p0.
+     * from \e p0.  The results do not depend on \e nthreads.
      **********************************************************************/
     std::vector<Point> All(Math::real latX, Math::real lonX, Math::real aziX,
                            Math::real latY, Math::real lonY, Math::real aziY,
-                           Math::real maxdist, const Point& p0 = Point(0, 0))
+                           Math::real maxdist, const Point& p0 = Point(0, 0),
+                           int nthreads = 1)
       const;
     /**
      * Find all intersections within a certain distance, with each geodesic
@@ -448,11 +553,12 @@ namespace GeographicLib {
      * @param[out] c vector of coincidences.
      * @param[in] p0 an optional offset for the starting points (meters),
      *   default = [0,0].
+     * @param[in] nthreads the number of threads to use (default 1).
      * @return \e plist a vector for the intersections closest to \e p0.
      *
      * Each intersection point satisfies Intersect::Dist(\e p, \e p0) &le; \e
      * maxdist.  The vector of returned intersections is sorted on the distance
-     * from \e p0.
+     * from \e p0.  The results do not depend on \e nthreads.
      *
      * \note \e lineX and \e lineY should be created with minimum capabilities
      * Intersect::LineCaps.  The methods for creating a GeodesicLine include
@@ -460,7 +566,7 @@ namespace GeographicLib {
      **********************************************************************/
     std::vector<Point> All(const GeodesicLine& lineX, const GeodesicLine& lineY,
                            Math::real maxdist, std::vector<int>& c,
-                           const Point& p0 = Point(0, 0))
+                           const Point& p0 = Point(0, 0), int nthreads = 1)
       const;
     /**
      * Find all intersections within a certain distance, with each geodesic
@@ -472,21 +578,192 @@ namespace GeographicLib {
      *   (meters).
      * @param[in] p0 an optional offset for the starting points (meters),
      *   default = [0,0].
+     * @param[in] nthreads the number of threads to use (default 1).
      * @return \e plist a vector for the intersections closest to \e p0.
      *
      * Each intersection point satisfies Intersect::Dist(\e p, \e p0) &le; \e
      * maxdist.  The vector of returned intersections is sorted on the distance
-     * from \e p0.
+     * from \e p0.  The results do not depend on \e nthreads.
      *
      * \note \e lineX and \e lineY should be created with minimum capabilities
      * Intersect::LineCaps.  The methods for creating a GeodesicLine include
      * all these capabilities by default.
      **********************************************************************/
     std::vector<Point> All(const GeodesicLine& lineX, const GeodesicLine& lineY,
-                           Math::real maxdist, const Point& p0 = Point(0, 0))
+                           Math::real maxdist, const Point& p0 = Point(0, 0),
+                           int nthreads = 1)
       const;
     ///@}
 
+    /** \name Intersections of many segments
+     **********************************************************************/
+    ///@{
+    /**
+     * Find the intersections of one geodesic segment with many others.
+     *
+     * @param[in] lineX the segment \e X.
+     * @param[in] linesY the segments \e Y.
+     * @param[out] ind the indices \e j of the segments <i>linesY</i>[\e j]
+     *   which intersect \e X.
+     * @param[out] c vector of coincidences.
+     * @param[in] nthreads the number of threads to use (default 1).
+     * @return \e plist a vector of the corresponding intersection points.
+     *
+     * The results are the same as calling Intersect::Segment for \e lineX
+     * and each of the segments \e Y and retaining those results for which
+     * \e segmode = 0; they are sorted on \e j.  This is equivalent to
+     * Intersect::AllSegments with a single segment \e X, e.g., for checking
+     * a planned route segment against many others.  However, instead of
+     * organizing the segments \e Y into a tree, the bounding sphere of \e
+     * X (see Intersect::AllSegments) is computed once and the segments \e Y
+     * whose spheres don't overlap it are rejected in a single pass; only
+     * the remaining candidates are passed to Intersect::Segment.  With \e
+     * nthreads &gt; 1, the segments \e Y are divided amongst the threads
+     * (both for the rejection test and for the intersection calculations);
+     * the results do not depend on \e nthreads.  The diagnostic counters
+     * only reflect the calls to Intersect::Segment.
+     *
+     * \warning \e lineX and \e linesY must represent shortest geodesics,
+     * e.g., they can be created by Geodesic::InverseLine.  See
+     * Intersect::Segment.
+     **********************************************************************/
+    std::vector<Point>
+    Segments(const GeodesicLine& lineX,
+             const std::vector<GeodesicLine>& linesY,
+             std::vector<int>& ind, std::vector<int>& c,
+             int nthreads = 1) const;
+    /**
+     * Find the intersections of one geodesic segment with many others.
+     *   Don't return vector of coincidences.
+     *
+     * @param[in] lineX the segment \e X.
+     * @param[in] linesY the segments \e Y.
+     * @param[out] ind the indices \e j of the segments <i>linesY</i>[\e j]
+     *   which intersect \e X.
+     * @param[in] nthreads the number of threads to use (default 1).
+     * @return \e plist a vector of the corresponding intersection points.
+     *
+     * See previous definition of Intersect::Segments for more information.
+     **********************************************************************/
+    std::vector<Point>
+    Segments(const GeodesicLine& lineX,
+             const std::vector<GeodesicLine>& linesY,
+             std::vector<int>& ind, int nthreads = 1) const;
+    /**
+     * Find the intersections of all pairs of geodesic segments drawn from two
+     *   sets.
+     *
+     * @param[in] linesX the segments \e X.
+     * @param[in] linesY the segments \e Y.
+     * @param[out] ind the indices [\e i, \e j] of the pairs of segments
+     *   <i>linesX</i>[\e i] and <i>linesY</i>[\e j] which intersect.
+     * @param[out] c vector of coincidences.
+     * @param[in] nthreads the number of threads to use (default 1).
+     * @return \e plist a vector of the corresponding intersection points.
+     *
+     * The results are the same as calling Intersect::Segment for every pair
+     * of segments and retaining those results for which \e segmode = 0.  The
+     * results are sorted on \e i and then on \e j.
+     *
+     * Most pairs of segments are far apart and are rejected without calling
+     * Intersect::Segment.  Each segment lies within a sphere (in geocentric
+     * coordinates) centered at its midpoint with a radius equal to half its
+     * length.  The spheres for the segments \e Y are organized into a
+     * bounding volume hierarchy and Intersect::Segment is only called for the
+     * pairs whose spheres overlap.  The diagnostic counters only reflect these
+     * calls.  With \e nthreads &gt; 1, the segments \e X are divided amongst
+     * \e nthreads threads; the results do not depend on \e nthreads.
+     *
+     * \warning \e linesX and \e linesY must represent shortest geodesics,
+     * e.g., they can be created by Geodesic::InverseLine.  See
+     * Intersect::Segment.
+     **********************************************************************/
+    std::vector<Point>
+    AllSegments(const std::vector<GeodesicLine>& linesX,
+                const std::vector<GeodesicLine>& linesY,
+                std::vector<std::pair<int, int>>& ind, std::vector<int>& c,
+                int nthreads = 1) const;
+    /**
+     * Find the intersections of all pairs of geodesic segments drawn from two
+     *   sets.  Don't return vector of coincidences.
+     *
+     * @param[in] linesX the segments \e X.
+     * @param[in] linesY the segments \e Y.
+     * @param[out] ind the indices [\e i, \e j] of the pairs of segments
+     *   <i>linesX</i>[\e i] and <i>linesY</i>[\e j] which intersect.
+     * @param[in] nthreads the number of threads to use (default 1).
+     * @return \e plist a vector of the corresponding intersection points.
+     *
+     * See previous definition of Intersect::AllSegments for more information.
+     **********************************************************************/
+    std::vector<Point>
+    AllSegments(const std::vector<GeodesicLine>& linesX,
+                const std::vector<GeodesicLine>& linesY,
+                std::vector<std::pair<int, int>>& ind,
+                int nthreads = 1) const;
+    /**
+     * Find the self-intersections of a geodesic polyline.
+     *
+     * @param[in] n the number of vertices.
+     * @param[in] lat array of \e n latitudes of the vertices (degrees).
+     * @param[in] lon array of \e n longitudes of the vertices (degrees).
+     * @param[out] ind the indices [\e i, \e j], with \e i &lt; \e j, of
+     *   the pairs of segments which intersect.
+     * @param[out] c vector of coincidences.
+     * @param[in] nthreads the number of threads to use (default 1).
+     * @exception GeographicErr if \e n is too large.
+     * @exception std::bad_alloc if the memory for the bounding volumes
+     *   can't be allocated.
+     * @return \e plist a vector of the corresponding intersection points.
+     *
+     * Segment \e i of the polyline is the shortest geodesic from vertex \e
+     * i to vertex \e i + 1.  The results are the same as calling
+     * Intersect::Segment for segments \e i and \e j and retaining those
+     * results for which \e segmode = 0, for all pairs of nonadjacent
+     * segments; thus the point [\e x, \e y] is the displacement along
+     * segment \e i from vertex \e i and along segment \e j from vertex \e
+     * j.  Adjacent segments (which share a vertex) are not tested; if the
+     * polyline is closed (the last vertex equals the first), then the first
+     * and last segments are also considered to be adjacent.  The results
+     * are sorted on \e i and then on \e j.
+     *
+     * The pairs of segments are culled with the bounding spheres as in
+     * Intersect::AllSegments.  In order to handle polylines with millions of
+     * vertices, GeodesicLine objects are not kept for all the segments:
+     * the spheres are found by a first pass over the segments and the lines
+     * needed by Intersect::Segment are constructed (with
+     * Geodesic::InverseLine) only for the pairs which survive.  With \e
+     * nthreads &gt; 1, both passes are divided amongst the threads; the
+     * results do not depend on \e nthreads.
+     **********************************************************************/
+    std::vector<Point>
+    SelfIntersections(size_t n, const Math::real lat[],
+                      const Math::real lon[],
+                      std::vector<std::pair<int, int>>& ind,
+                      std::vector<int>& c, int nthreads = 1) const;
+    /**
+     * Find the self-intersections of a geodesic polyline.  Don't return
+     *   vector of coincidences.
+     *
+     * @param[in] n the number of vertices.
+     * @param[in] lat array of \e n latitudes of the vertices (degrees).
+     * @param[in] lon array of \e n longitudes of the vertices (degrees).
+     * @param[out] ind the indices [\e i, \e j], with \e i &lt; \e j, of
+     *   the pairs of segments which intersect.
+     * @param[in] nthreads the number of threads to use (default 1).
+     * @exception GeographicErr if \e n is too large.
+     * @return \e plist a vector of the corresponding intersection points.
+     *
+     * See previous definition of Intersect::SelfIntersections for more
+     * information.
+     **********************************************************************/
+    std::vector<Point>
+    SelfIntersections(size_t n, const Math::real lat[],
+                      const Math::real lon[],
+                      std::vector<std::pair<int, int>>& ind,
+                      int nthreads = 1) const;
+    ///@}
+
     /** \name Diagnostic counters
      **********************************************************************/
     ///@{
@@ -498,9 +775,10 @@ namespace GeographicLib {
      * metric for the overall cost. This counter is set to zero by the
      * constructor.
      *
-     * \warning The counter is a mutable variable and so is not thread safe.
+     * The counter is updated at the end of each call, so several threads may
+     * use the same Intersect object.
      **********************************************************************/
-    long long NumInverse() const { return _cnt0; }
+    long long NumInverse() const { return _cnt0.get(); }
     /**
      * @return the cumulative number of invocations of **b**.
      *
@@ -508,9 +786,10 @@ namespace GeographicLib {
      * which is used by all the intersection methods.  This counter is set to
      * zero by the constructor.
      *
-     * \warning The counter is a mutable variable and so is not thread safe.
+     * The counter is updated at the end of each call, so several threads may
+     * use the same Intersect object.
      **********************************************************************/
-    long long NumBasic() const { return _cnt1; }
+    long long NumBasic() const { return _cnt1.get(); }
     /**
      * @return the number of times intersection point was changed in
      *   Intersect::Closest and Intersect::Next.
@@ -522,18 +801,20 @@ namespace GeographicLib {
      * \note This counter is also incremented by Intersect::Segment, which
      * calls Intersect::Closest.
      *
-     * \warning The counter is a mutable variable and so is not thread safe.
+     * The counter is updated at the end of each call, so several threads may
+     * use the same Intersect object.
      **********************************************************************/
-    long long NumChange() const { return _cnt2; }
+    long long NumChange() const { return _cnt2.get(); }
     /**
      * @return the number of times a corner point is checked in
      *   Intersect::Segment.
      *
      * This counter is set to zero by the constructor.
      *
-     * \warning The counter is a mutable variable and so is not thread safe.
+     * The counter is updated at the end of each call, so several threads may
+     * use the same Intersect object.
      **********************************************************************/
-    long long NumCorner() const { return _cnt3; }
+    long long NumCorner() const { return _cnt3.get(); }
     /**
      * @return the number of times a corner point is returned by
      *   Intersect::Segment.
@@ -544,9 +825,10 @@ namespace GeographicLib {
      * intersection that overrides the intersection closest to the midpoints of
      * the segments; i.e., NumCorner() always returns 0.
      *
-     * \warning The counter is a mutable variable and so is not thread safe.
+     * The counter is updated at the end of each call, so several threads may
+     * use the same Intersect object.
      **********************************************************************/
-    long long NumOverride() const { return _cnt4; }
+    long long NumOverride() const { return _cnt4.get(); }
     ///@}
 
     /** \name Insepctor function
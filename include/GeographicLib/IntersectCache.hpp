@@ -0,0 +1,210 @@
+/**
+ * \file IntersectCache.hpp
+ * \brief Header for GeographicLib::IntersectCache class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_INTERSECTCACHE_HPP)
+#define GEOGRAPHICLIB_INTERSECTCACHE_HPP 1
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <GeographicLib/Constants.hpp>
+#include <GeographicLib/Intersect.hpp>
+
+#if defined(_MSC_VER)
+// Squelch warnings about dll vs std::list, std::unordered_map, and
+// std::vector
+#  pragma warning (push)
+#  pragma warning (disable: 4251)
+#endif
+
+namespace GeographicLib {
+
+  /**
+   * \brief A cache of closest intersections
+   *
+   * Applications which repeatedly find the closest intersection of the same
+   * pairs of geodesics (for example, conflict probing between airways as
+   * flight plans are amended) can use an IntersectCache in place of
+   * Intersect::Closest.  The results of the most recently used problems are
+   * retained.
+   *
+   * Each entry is filed under the positions and azimuths defining the two
+   * geodesics rounded to the nearest multiple of a quantum \e dq, together
+   * with the offset \e p0.  If a request matches the stored geodesics
+   * exactly, the stored intersection is returned.  Otherwise, if the
+   * request falls under the same entry (i.e., the geodesics are slightly
+   * perturbed), the stored intersection is used as the hint for
+   * Intersect::Closest(real, real, real, real, real, real, const Point&,
+   * const Point&, int*) const, and the entry is replaced by the new
+   * solution.  In all cases the result is the closest intersection for the
+   * requested geodesics (not the rounded ones); it is identical to that
+   * given by Intersect::Closest, except that seeded solutions may differ by
+   * roundoff.  With \e dq = 0, only exact repeats are found.
+   *
+   * The entries are held in several shards, each of which is a bounded hash
+   * map with its own lock and evicts its least recently used entries; the
+   * shard for a problem is selected by its key.  All the member functions
+   * are thread safe and a new problem is solved with the lock released, so
+   * that threads only contend when they access the same shard.  The cache
+   * holds a reference to the Intersect object which must therefore outlive
+   * it.
+   *
+   * Example of use:
+   * \code
+   *   Intersect inter(Geodesic::WGS84());
+   *   IntersectCache cache(inter, 10000);
+   *   int c;
+   *   for (...)
+   *     Intersect::Point p =
+   *       cache.Closest(latX, lonX, aziX, latY, lonY, aziY, Point(0, 0), &c);
+   * \endcode
+   **********************************************************************/
+  class GEOGRAPHICLIB_EXPORT IntersectCache {
+  private:
+    typedef Math::real real;
+    typedef Intersect::Point Point;
+    struct Key {
+      real latX, lonX, aziX, latY, lonY, aziY, x0, y0;
+      bool operator==(const Key& k) const;
+    };
+    struct Hash {
+      size_t operator()(const Key& k) const;
+    };
+    struct Value {
+      Key exact;                // the geodesics for this solution
+      Point p;
+      int c;
+    };
+    class Shard {
+    private:
+      typedef std::list<std::pair<Key, Value> > list;
+      list _list;               // most recently used at the front
+      std::unordered_map<Key, list::iterator, Hash> _map;
+      size_t _maxsize;
+      unsigned long long _hits, _seeded, _misses;
+      mutable std::mutex _lock;
+    public:
+      explicit Shard(size_t maxsize);
+      // Return 0 if k is not present, 1 if it is present for other exact
+      // geodesics, and 2 if the exact geodesics match.
+      int Find(const Key& k, const Key& exact, Value& v);
+      void Insert(const Key& k, const Value& v);
+      void Clear();
+      size_t Size() const;
+      unsigned long long Hits() const;
+      unsigned long long Seeded() const;
+      unsigned long long Misses() const;
+    };
+    const Intersect& _inter;
+    size_t _maxsize;
+    real _dq;
+    std::vector<std::unique_ptr<Shard> > _shards;
+    Shard& shard(const Key& k);
+  public:
+
+    /**
+     * Constructor for an IntersectCache.
+     *
+     * @param[in] inter the Intersect object used to solve the problems.
+     * @param[in] maxsize the maximum number of solutions to retain (default
+     *   65536); if this is 0, no solutions are retained.
+     * @param[in] dq the quantum for the latitudes, longitudes, and azimuths
+     *   used to file the solutions (degrees); default 1/64.
+     * @param[in] nshards the number of shards (default 16).
+     * @exception GeographicErr if \e dq is negative or not finite or if \e
+     *   nshards is not positive.
+     *
+     * The bound \e maxsize is divided evenly between the shards (rounding
+     * up).  The quantum \e dq only determines which geodesics are considered
+     * to be perturbations of one another; it does not affect the accuracy
+     * of the results.
+     **********************************************************************/
+    IntersectCache(const Intersect& inter, size_t maxsize = 65536,
+                   real dq = 1/real(64), int nshards = 16);
+
+    /**
+     * Find the closest intersection point using the cache.
+     *
+     * @param[in] latX latitude of starting point for geodesic \e X (degrees).
+     * @param[in] lonX longitude of starting point for geodesic \e X  (degrees).
+     * @param[in] aziX azimuth at starting point for geodesic \e X (degrees).
+     * @param[in] latY latitude of starting point for geodesic \e Y (degrees).
+     * @param[in] lonY longitude of starting point for geodesic \e Y  (degrees).
+     * @param[in] aziY azimuth at starting point for geodesic \e Y (degrees).
+     * @param[in] p0 an optional offset for the starting points (meters),
+     *   default = [0,0].
+     * @param[out] c optional pointer to an integer coincidence indicator.
+     * @exception std::bad_alloc if the memory for a new entry can't be
+     *   allocated.
+     * @return \e p the intersection point closest to \e p0.
+     *
+     * This is the same as Intersect::Closest(\e latX, \e lonX, \e aziX, \e
+     * latY, \e lonY, \e aziY, \e p0, \e c).  If any of the arguments is a
+     * NaN, the cache is bypassed.
+     **********************************************************************/
+    Point Closest(real latX, real lonX, real aziX,
+                  real latY, real lonY, real aziY,
+                  const Point& p0 = Point(0, 0), int* c = nullptr);
+
+    /**
+     * Remove all the solutions from the cache and reset the statistics.
+     **********************************************************************/
+    void Clear();
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return the number of solutions currently in the cache.
+     **********************************************************************/
+    size_t Size() const;
+
+    /**
+     * @return the maximum number of solutions retained.
+     **********************************************************************/
+    size_t MaxSize() const { return _maxsize; }
+
+    /**
+     * @return the quantum for the positions and azimuths (degrees).
+     **********************************************************************/
+    Math::real Quantum() const { return _dq; }
+
+    /**
+     * @return the number of shards.
+     **********************************************************************/
+    int Shards() const { return int(_shards.size()); }
+
+    /**
+     * @return the number of calls to Closest satisfied from the cache.
+     **********************************************************************/
+    unsigned long long Hits() const;
+
+    /**
+     * @return the number of calls to Closest solved starting from the
+     *   solution for perturbed geodesics.
+     **********************************************************************/
+    unsigned long long Seeded() const;
+
+    /**
+     * @return the number of calls to Closest which solved a new problem
+     *   from scratch.
+     **********************************************************************/
+    unsigned long long Misses() const;
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#if defined(_MSC_VER)
+#  pragma warning (pop)
+#endif
+
+#endif  // GEOGRAPHICLIB_INTERSECTCACHE_HPP
@@ -0,0 +1,247 @@
+/**
+ * \file JacobiConformal.hpp
+ * \brief Header for GeographicLib::JacobiConformal class
+ *
+ * Copyright (c) Charles Karney (2014-2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_JACOBICONFORMAL_HPP)
+#define GEOGRAPHICLIB_JACOBICONFORMAL_HPP 1
+
+#include <GeographicLib/Constants.hpp>
+#include <GeographicLib/EllipticFunction.hpp>
+
+namespace GeographicLib {
+
+  /**
+   * \brief Jacobi's conformal projection of a triaxial ellipsoid
+   *
+   * This is a conformal projection of the ellipsoid to a plane in which
+   * the grid lines are straight; see Jacobi,
+   * <a href="https://books.google.com/books?id=ryEOAAAAQAAJ&pg=PA212">
+   * Vorlesungen &uuml;ber Dynamik, &sect;28</a>.  The constructor takes the
+   * semi-axes of the ellipsoid (which must be in order).  Member functions map
+   * the ellipsoidal coordinates &omega; and &beta; separately to \e x and \e
+   * y.  Jacobi's coordinates have been multiplied by
+   * (<i>a</i><sup>2</sup>&minus;<i>c</i><sup>2</sup>)<sup>1/2</sup> /
+   * (2<i>b</i>) so that the customary results are returned in the cases of
+   * a sphere or an ellipsoid of revolution.
+   *
+   * The ellipsoid is oriented so that the large principal ellipse, \f$Z=0\f$,
+   * is the equator, \f$\beta=0\f$, while the small principal ellipse,
+   * \f$Y=0\f$, is the prime meridian, \f$\omega=0\f$.  The four umbilic
+   * points, \f$\left|\omega\right| = \left|\beta\right| = \frac12\pi\f$, lie
+   * on middle principal ellipse in the plane \f$X=0\f$.
+   *
+   * \e x and \e y are given by incomplete elliptic integrals of the third
+   * kind whose parameters depend only on the ellipsoid.  The two
+   * EllipticFunction objects and the quadrant lengths are computed once by
+   * the constructor, so that each call to Forward costs two incomplete
+   * integrals.  Reverse inverts the integrals with Newton's method which
+   * typically takes 3 or 4 iterations for each coordinate.  Forward and
+   * Reverse are also provided for arrays of points; these can process blocks
+   * of points concurrently with Executor::Current.  The object is immutable,
+   * so it may be accessed by several threads at once.
+   *
+   * For more information on this projection, see \ref jacobi.
+   *
+   * Example of use:
+   * \include example-JacobiConformal.cpp
+   **********************************************************************/
+
+  class GEOGRAPHICLIB_EXPORT JacobiConformal {
+  private:
+    typedef Math::real real;
+    real _a, _b, _c, _ab2, _bc2, _ac2, _xs, _ys, _xq, _yq;
+    EllipticFunction _ex, _ey;
+    void Init();
+    static void norm(real& x, real& y) {
+      using std::hypot;
+      real z = hypot(x, y); x /= z; y /= z;
+    }
+    // Solve Pi(phi) = p for the EllipticFunction ell returning the
+    // ellipsoidal coordinate atan2(u * sin(phi), v * cos(phi)) in degrees.
+    static real Invert(const EllipticFunction& ell, real p, real u, real v);
+  public:
+
+    /**
+     * Constructor for a triaxial ellipsoid with semi-axes.
+     *
+     * @param[in] a the largest semi-axis.
+     * @param[in] b the middle semi-axis.
+     * @param[in] c the smallest semi-axis.
+     * @exception GeographicErr if the axes are not in order or \e a = \e c.
+     *
+     * The semi-axes must satisfy \e a &ge; \e b &ge; \e c > 0 and \e a >
+     * \e c.  This form of the constructor cannot be used to specify a
+     * sphere (use the next constructor).
+     **********************************************************************/
+    JacobiConformal(real a, real b, real c);
+
+    /**
+     * Alternate constructor for a triaxial ellipsoid.
+     *
+     * @param[in] a the largest semi-axis.
+     * @param[in] b the middle semi-axis.
+     * @param[in] c the smallest semi-axis.
+     * @param[in] ab the relative magnitude of \e a &minus; \e b.
+     * @param[in] bc the relative magnitude of \e b &minus; \e c.
+     * @exception GeographicErr if the axes are not in order or if \e ab + \e
+     *   bc is not positive.
+     *
+     * This form can be used to specify a sphere.  The semi-axes must
+     * satisfy \e a &ge; \e b &ge; c > 0.  The ratio \e ab : \e bc must equal
+     * (<i>a</i>&minus;<i>b</i>) : (<i>b</i>&minus;<i>c</i>) with \e ab
+     * &ge; 0, \e bc &ge; 0, and \e ab + \e bc > 0.
+     **********************************************************************/
+    JacobiConformal(real a, real b, real c, real ab, real bc);
+
+    /**
+     * Forward projection.
+     *
+     * @param[in] omg the ellipsoidal longitude &omega; (degrees).
+     * @param[in] bet the ellipsoidal latitude &beta; (degrees).
+     * @param[out] x the \e x coordinate (degrees).
+     * @param[out] y the \e y coordinate (degrees).
+     *
+     * This is equivalent to \e x = x(\e omg), \e y = y(\e bet).
+     **********************************************************************/
+    void Forward(real omg, real bet, real& x, real& y) const
+    { x = this->x(omg); y = this->y(bet); }
+
+    /**
+     * Reverse projection.
+     *
+     * @param[in] x the \e x coordinate (degrees).
+     * @param[in] y the \e y coordinate (degrees).
+     * @param[out] omg the ellipsoidal longitude &omega; (degrees).
+     * @param[out] bet the ellipsoidal latitude &beta; (degrees).
+     *
+     * This inverts Forward for \e x in (&minus;2x(), 2x()] and \e y in
+     * (&minus;2y(), 2y()]; the corresponding ranges for \e omg and \e bet
+     * are (&minus;180&deg;, 180&deg;].  Outside these ranges the results are
+     * continued periodically, e.g., increasing \e x by 4x() increases \e omg
+     * by 360&deg;.
+     **********************************************************************/
+    void Reverse(real x, real y, real& omg, real& bet) const;
+
+    /**
+     * Forward projection of many points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] omg array of \e n values of &omega; (degrees).
+     * @param[in] bet array of \e n values of &beta; (degrees).
+     * @param[out] x array of \e n values of \e x (degrees).
+     * @param[out] y array of \e n values of \e y (degrees).
+     * @param[in] nthreads the number of threads to use (default 1).
+     *
+     * Element \e i of the output arrays is the result of Forward(\e omg[\e
+     * i], \e bet[\e i], ...).  With \e nthreads &gt; 1 blocks of points are
+     * processed concurrently with Executor::Current.
+     **********************************************************************/
+    void Forward(size_t n, const real omg[], const real bet[],
+                 real x[], real y[], int nthreads = 1) const;
+
+    /**
+     * Reverse projection of many points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] x array of \e n values of \e x (degrees).
+     * @param[in] y array of \e n values of \e y (degrees).
+     * @param[out] omg array of \e n values of &omega; (degrees).
+     * @param[out] bet array of \e n values of &beta; (degrees).
+     * @param[in] nthreads the number of threads to use (default 1).
+     *
+     * Element \e i of the output arrays is the result of Reverse(\e x[\e i],
+     * \e y[\e i], ...).
+     **********************************************************************/
+    void Reverse(size_t n, const real x[], const real y[],
+                 real omg[], real bet[], int nthreads = 1) const;
+
+    /**
+     * @return the quadrant length in the \e x direction.
+     **********************************************************************/
+    Math::real x() const { return _xq; }
+
+    /**
+     * The \e x projection.
+     *
+     * @param[in] somg sin(&omega;).
+     * @param[in] comg cos(&omega;).
+     * @return \e x.
+     **********************************************************************/
+    Math::real x(real somg, real comg) const {
+      real somg1 = _b * somg, comg1 = _a * comg; norm(somg1, comg1);
+      return _xs * _ex.Pi(somg1, comg1, _ex.Delta(somg1, comg1));
+    }
+
+    /**
+     * The \e x projection.
+     *
+     * @param[in] omg &omega; (in degrees).
+     * @return \e x (in degrees).
+     *
+     * &omega; must be in [&minus;180&deg;, 180&deg;].
+     **********************************************************************/
+    Math::real x(real omg) const {
+      real somg, comg;
+      Math::sincosd(omg, somg, comg);
+      return x(somg, comg) / Math::degree();
+    }
+
+    /**
+     * @return the quadrant length in the \e y direction.
+     **********************************************************************/
+    Math::real y() const { return _yq; }
+
+    /**
+     * The \e y projection.
+     *
+     * @param[in] sbet sin(&beta;).
+     * @param[in] cbet cos(&beta;).
+     * @return \e y.
+     **********************************************************************/
+    Math::real y(real sbet, real cbet) const {
+      real sbet1 = _b * sbet, cbet1 = _c * cbet; norm(sbet1, cbet1);
+      return _ys * _ey.Pi(sbet1, cbet1, _ey.Delta(sbet1, cbet1));
+    }
+
+    /**
+     * The \e y projection.
+     *
+     * @param[in] bet &beta; (in degrees).
+     * @return \e y (in degrees).
+     *
+     * &beta; must be in (&minus;180&deg;, 180&deg;].
+     **********************************************************************/
+    Math::real y(real bet) const {
+      real sbet, cbet;
+      Math::sincosd(bet, sbet, cbet);
+      return y(sbet, cbet) / Math::degree();
+    }
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return \e a the largest semi-axis.
+     **********************************************************************/
+    Math::real MajorRadius() const { return _a; }
+
+    /**
+     * @return \e b the middle semi-axis.
+     **********************************************************************/
+    Math::real MedianRadius() const { return _b; }
+
+    /**
+     * @return \e c the smallest semi-axis.
+     **********************************************************************/
+    Math::real MinorRadius() const { return _c; }
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_JACOBICONFORMAL_HPP
@@ -33,11 +33,19 @@ namespace GeographicLib {
    *
    * <a href="CartConvert.1.html">CartConvert</a> is a command-line utility
    * providing access to the functionality of Geocentric and LocalCartesian.
+   *
+   * The class is a template on the floating point type \e T.  It is
+   * instantiated for float, double, long double (if this is distinct from
+   * double), and Math::real.  LocalCartesian is the version using Math::real.
+   *
+   * @tparam T the floating point type.
    **********************************************************************/
 
-  class GEOGRAPHICLIB_EXPORT LocalCartesian {
+  template<typename T>
+  class GEOGRAPHICLIB_EXPORT LocalCartesianT {
   private:
-    typedef Math::real real;
+    typedef T real;
+    typedef GeocentricT<T> Geocentric;
     static const size_t dim_ = 3;
     static const size_t dim2_ = dim_ * dim_;
     Geocentric _earth;
@@ -61,8 +69,8 @@ namespace GeographicLib {
      *
      * \e lat0 should be in the range [&minus;90&deg;, 90&deg;].
      **********************************************************************/
-    LocalCartesian(real lat0, real lon0, real h0 = 0,
-                   const Geocentric& earth = Geocentric::WGS84())
+    LocalCartesianT(real lat0, real lon0, real h0 = 0,
+                    const Geocentric& earth = Geocentric::WGS84())
       : _earth(earth)
     { Reset(lat0, lon0, h0); }
 
@@ -74,7 +82,7 @@ namespace GeographicLib {
      *
      * Sets \e lat0 = 0, \e lon0 = 0, \e h0 = 0.
      **********************************************************************/
-    explicit LocalCartesian(const Geocentric& earth = Geocentric::WGS84())
+    explicit LocalCartesianT(const Geocentric& earth = Geocentric::WGS84())
       : _earth(earth)
     { Reset(real(0), real(0), real(0)); }
 
@@ -199,40 +207,150 @@ namespace GeographicLib {
         IntReverse(x, y, z, lat, lon, h, NULL);
     }
 
+    /**
+     * Convert many points from geodetic to local cartesian coordinates.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of \e n latitudes (degrees).
+     * @param[in] lon array of \e n longitudes (degrees).
+     * @param[in] h array of \e n heights above the ellipsoid (meters).
+     * @param[out] x array of \e n local cartesian coordinates (meters).
+     * @param[out] y array of \e n local cartesian coordinates (meters).
+     * @param[out] z array of \e n local cartesian coordinates (meters).
+     * @param[out] M array of 9\e n values; if this is not a null pointer,
+     *   the rotation matrix for point \e i is stored in row-major order in
+     *   elements 9\e i through 9\e i + 8.
+     *
+     * The results are bitwise identical to calling the scalar Forward for
+     * each point.  The rotation matrices are only computed if \e M is not a
+     * null pointer.  The input and output arrays must not overlap.
+     **********************************************************************/
+    void Forward(size_t n, const real lat[], const real lon[], const real h[],
+                 real x[], real y[], real z[], real M[] = nullptr) const;
+
+    /**
+     * Convert many points from geodetic to local cartesian coordinates
+     * returning the results in a different floating point type.
+     *
+     * @tparam U the type of the results, e.g., float.
+     * @param[in] n the number of points.
+     * @param[in] lat array of \e n latitudes (degrees).
+     * @param[in] lon array of \e n longitudes (degrees).
+     * @param[in] h array of \e n heights above the ellipsoid (meters).
+     * @param[out] x array of \e n local cartesian coordinates (meters).
+     * @param[out] y array of \e n local cartesian coordinates (meters).
+     * @param[out] z array of \e n local cartesian coordinates (meters).
+     *
+     * The coordinates are computed with type Math::real and then rounded to
+     * type \e U.  This saves a separate conversion pass when, for example,
+     * single precision results are needed.
+     **********************************************************************/
+    template<typename U>
+    void Forward(size_t n, const real lat[], const real lon[], const real h[],
+                 U x[], U y[], U z[]) const {
+      for (size_t i = 0; i < n; ++i) {
+        real x1, y1, z1;
+        IntForward(lat[i], lon[i], h[i], x1, y1, z1, NULL);
+        x[i] = U(x1); y[i] = U(y1); z[i] = U(z1);
+      }
+    }
+
+    /**
+     * Convert many points from local cartesian to geodetic coordinates.
+     *
+     * @param[in] n the number of points.
+     * @param[in] x array of \e n local cartesian coordinates (meters).
+     * @param[in] y array of \e n local cartesian coordinates (meters).
+     * @param[in] z array of \e n local cartesian coordinates (meters).
+     * @param[out] lat array of \e n latitudes (degrees).
+     * @param[out] lon array of \e n longitudes (degrees).
+     * @param[out] h array of \e n heights above the ellipsoid (meters).
+     * @param[out] M array of 9\e n values; if this is not a null pointer,
+     *   the rotation matrix for point \e i is stored in row-major order in
+     *   elements 9\e i through 9\e i + 8.
+     * @param[in] radius if positive, the radius (meters) of a sphere
+     *   centered at the origin within which a faster method is used (default
+     *   0).
+     *
+     * With \e radius = 0, the results are bitwise identical to calling the
+     * scalar Reverse for each point.  The rotation matrices are only
+     * computed if \e M is not a null pointer.  The input and output arrays
+     * must not overlap.
+     *
+     * With \e radius &gt; 0, the points within \e radius of the origin are
+     * converted by applying Newton's method to the geodetic latitude starting
+     * at the latitude of the origin.  This avoids the cube root and one of
+     * the two arctangents in the closed-form solution used by the scalar
+     * Reverse; it is about 1.3 times as fast for
+     * \e radius = 100 km and 1.7 times as fast for \e radius = 10 km.  The
+     * iteration is continued until the last correction to the latitude is
+     * less than \e epsilon<sup>1/2</sup>/4 radians, where \e epsilon is
+     * the machine precision; since the convergence is quadratic, the
+     * remaining error is dominated by roundoff, as it is for the scalar
+     * Reverse; with doubles and \e radius = 100 km, the errors in the
+     * position and the height are less than 5 nm.
+     *
+     * \e radius is reduced to \e a/64 (about 100 km for the earth) or to a
+     * quarter of the distance of the origin from the axis, if these are
+     * smaller; so this method is not used if the origin is at a pole.  Any
+     * point where the iteration fails to converge within 5 steps is
+     * converted by the scalar method.
+     **********************************************************************/
+    void Reverse(size_t n, const real x[], const real y[], const real z[],
+                 real lat[], real lon[], real h[], real M[] = nullptr,
+                 real radius = 0) const;
+
     /** \name Inspector functions
      **********************************************************************/
     ///@{
     /**
      * @return latitude of the origin (degrees).
      **********************************************************************/
-    Math::real LatitudeOrigin() const { return _lat0; }
+    real LatitudeOrigin() const { return _lat0; }
 
     /**
      * @return longitude of the origin (degrees).
      **********************************************************************/
-    Math::real LongitudeOrigin() const { return _lon0; }
+    real LongitudeOrigin() const { return _lon0; }
 
     /**
      * @return height of the origin (meters).
      **********************************************************************/
-    Math::real HeightOrigin() const { return _h0; }
+    real HeightOrigin() const { return _h0; }
 
     /**
      * @return \e a the equatorial radius of the ellipsoid (meters).  This is
      *   the value of \e a inherited from the Geocentric object used in the
      *   constructor.
      **********************************************************************/
-    Math::real EquatorialRadius() const { return _earth.EquatorialRadius(); }
+    real EquatorialRadius() const { return _earth.EquatorialRadius(); }
 
     /**
      * @return \e f the flattening of the ellipsoid.  This is the value
      *   inherited from the Geocentric object used in the constructor.
      **********************************************************************/
-    Math::real Flattening() const { return _earth.Flattening(); }
+    real Flattening() const { return _earth.Flattening(); }
     ///@}
 
   };
 
+  /**
+   * The LocalCartesian class using Math::real.
+   **********************************************************************/
+  typedef LocalCartesianT<Math::real> LocalCartesian;
+
+  /// \cond SKIP
+  // The instantiations are in LocalCartesian.cpp
+  extern template class LocalCartesianT<float>;
+  extern template class LocalCartesianT<double>;
+#if GEOGRAPHICLIB_HAVE_LONG_DOUBLE
+  extern template class LocalCartesianT<long double>;
+#endif
+#if GEOGRAPHICLIB_PRECISION > 3
+  extern template class LocalCartesianT<Math::real>;
+#endif
+  /// \endcond
+
 } // namespace GeographicLib
 
 #endif  // GEOGRAPHICLIB_LOCALCARTESIAN_HPP
@@ -101,6 +101,17 @@ namespace GeographicLib {
     static constexpr int mult_ = 1000000;
     static void CheckCoords(bool utmp, bool& northp, real& x, real& y);
     static int UTMRow(int iband, int icol, int irow);
+    static void GenReverse(const char* mgrs, int len,
+                           int& zone, bool& northp, real& x, real& y,
+                           int& prec, bool centerp);
+    // Parse mgrs into the zone, hemisphere, and integer indices of the
+    // square; this does all the checking for GenReverse.
+    static void GenDecode(const char* mgrs, int len,
+                          int& zone, bool& northp,
+                          long long& ix, long long& iy, int& prec);
+    // The position of the corner or center of square (ix, iy) at prec >= 0.
+    static void Position(long long ix, long long iy, int prec, bool centerp,
+                         real& x, real& y);
 
     friend class UTMUPS;        // UTMUPS::StandardZone calls LatitudeBand
     // Return latitude band number [-10, 10) for the given latitude (degrees).
@@ -155,6 +166,12 @@ namespace GeographicLib {
 
   public:
 
+    /**
+     * The size of a char array which can hold any MGRS string produced by
+     * the char array versions of Forward, including the terminating null.
+     **********************************************************************/
+    enum { MAXBUF = 2 + 3 + 2 * maxprec_ + 1 };
+
     /**
      * Convert UTM or UPS coordinate to an MGRS coordinate.
      *
@@ -263,6 +280,68 @@ namespace GeographicLib {
     static void Forward(int zone, bool northp, real x, real y, real lat,
                         int prec, std::string& mgrs);
 
+    /**
+     * Convert UTM or UPS coordinate to an MGRS coordinate in a char array.
+     *
+     * @param[in] zone UTM zone (zero means UPS).
+     * @param[in] northp hemisphere (true means north, false means south).
+     * @param[in] x easting of point (meters).
+     * @param[in] y northing of point (meters).
+     * @param[in] prec precision relative to 100 km.
+     * @param[out] mgrs a char array of at least MGRS::MAXBUF characters which
+     *   receives the null-terminated MGRS string.
+     * @exception GeographicErr if \e zone, \e x, or \e y is outside its
+     *   allowed range.
+     *
+     * This is the same as the version returning a std::string, except that
+     * no memory is allocated.  If an error is thrown, then \e mgrs is
+     * unchanged.
+     **********************************************************************/
+    static void Forward(int zone, bool northp, real x, real y,
+                        int prec, char mgrs[]);
+
+    /**
+     * Convert UTM or UPS coordinate to an MGRS coordinate in a char array
+     * when the latitude is known.
+     *
+     * @param[in] zone UTM zone (zero means UPS).
+     * @param[in] northp hemisphere (true means north, false means south).
+     * @param[in] x easting of point (meters).
+     * @param[in] y northing of point (meters).
+     * @param[in] lat latitude (degrees).
+     * @param[in] prec precision relative to 100 km.
+     * @param[out] mgrs a char array of at least MGRS::MAXBUF characters which
+     *   receives the null-terminated MGRS string.
+     * @exception GeographicErr if \e zone, \e x, or \e y is outside its
+     *   allowed range.
+     * @exception GeographicErr if \e lat is inconsistent with the given UTM
+     *   coordinates.
+     **********************************************************************/
+    static void Forward(int zone, bool northp, real x, real y, real lat,
+                        int prec, char mgrs[]);
+
+    /**
+     * Convert many UTM or UPS coordinates to MGRS coordinates.
+     *
+     * @param[in] n the number of points.
+     * @param[in] zone array of \e n UTM zones (zero means UPS).
+     * @param[in] northp array of \e n hemispheres.
+     * @param[in] x array of \e n eastings (meters).
+     * @param[in] y array of \e n northings (meters).
+     * @param[in] prec precision relative to 100 km.
+     * @param[out] mgrs a char array of \e n \e width characters; MGRS
+     *   string \e i is written null-terminated starting at mgrs[\e i
+     *   \e width].
+     * @param[in] width the spacing of the strings in \e mgrs; this must be
+     *   at least 8 and at least 6 + 2 \e prec.
+     * @exception GeographicErr if \e width is too small or if any point is
+     *   outside its allowed range; in the latter case, the message refers to
+     *   the first such point and the strings before it have been written.
+     **********************************************************************/
+    static void Forward(size_t n, const int zone[], const bool northp[],
+                        const real x[], const real y[],
+                        int prec, char mgrs[], size_t width);
+
     /**
      * Convert a MGRS coordinate to UTM or UPS coordinates.
      *
@@ -312,6 +391,51 @@ namespace GeographicLib {
                         int& zone, bool& northp, real& x, real& y,
                         int& prec, bool centerp = true);
 
+    /**
+     * Convert a MGRS coordinate given as a null-terminated char array to UTM
+     * or UPS coordinates.
+     *
+     * @param[in] mgrs MGRS string.
+     * @param[out] zone UTM zone (zero means UPS).
+     * @param[out] northp hemisphere (true means north, false means south).
+     * @param[out] x easting of point (meters).
+     * @param[out] y northing of point (meters).
+     * @param[out] prec precision relative to 100 km.
+     * @param[in] centerp if true (default), return center of the MGRS square,
+     *   else return SW (lower left) corner.
+     * @exception GeographicErr if \e mgrs is illegal.
+     *
+     * This is the same as the version taking a std::string, except that no
+     * memory is allocated unless an error is thrown.
+     **********************************************************************/
+    static void Reverse(const char* mgrs,
+                        int& zone, bool& northp, real& x, real& y,
+                        int& prec, bool centerp = true);
+
+    /**
+     * Convert many MGRS coordinates to UTM or UPS coordinates.
+     *
+     * @param[in] n the number of points.
+     * @param[in] mgrs a char array of \e n \e width characters; MGRS string
+     *   \e i starts at mgrs[\e i \e width] and ends at the first null or
+     *   after \e width characters.
+     * @param[in] width the spacing of the strings in \e mgrs.
+     * @param[out] zone array of \e n UTM zones (zero means UPS).
+     * @param[out] northp array of \e n hemispheres.
+     * @param[out] x array of \e n eastings (meters).
+     * @param[out] y array of \e n northings (meters).
+     * @param[out] prec array of \e n precisions relative to 100 km; this may
+     *   be a null pointer.
+     * @param[in] centerp if true (default), return center of the MGRS square,
+     *   else return SW (lower left) corner.
+     * @exception GeographicErr if any string is illegal; the message refers
+     *   to the first such string and the points before it have been
+     *   converted.
+     **********************************************************************/
+    static void Reverse(size_t n, const char mgrs[], size_t width,
+                        int zone[], bool northp[], real x[], real y[],
+                        int prec[] = nullptr, bool centerp = true);
+
     /**
      * Split a MGRS grid reference into its components.
      *
@@ -339,6 +463,58 @@ namespace GeographicLib {
                        std::string& gridzone, std::string& block,
                        std::string& easting, std::string& northing);
 
+    /**
+     * Decode a MGRS coordinate to integer indices of its square.
+     *
+     * @param[in] mgrs MGRS string as a null-terminated char array.
+     * @param[out] zone UTM zone (zero means UPS).
+     * @param[out] northp hemisphere (true means north, false means south).
+     * @param[out] ix the easting index of the square.
+     * @param[out] iy the northing index of the square.
+     * @param[out] prec precision relative to 100 km.
+     * @exception GeographicErr if \e mgrs is illegal.
+     *
+     * This performs the same checks as MGRS::Reverse but returns the square
+     * as a pair of integers without any floating point arithmetic.  The
+     * south-west corner of the square is at \e x = \e ix \e s, \e y = \e
+     * iy \e s, where \e s = 100 km / 10<sup><i>prec</i></sup> is the size
+     * of the square.  Thus, for example, \e ix / 10<sup><i>prec</i></sup>
+     * and \e iy / 10<sup><i>prec</i></sup> (with integer division) give the
+     * 100 km square.  If \e mgrs is a grid zone designation, \e prec is set
+     * to &minus;1 and (\e ix, \e iy) is the 100 km square containing the
+     * point returned by MGRS::Reverse.  If the first 3 characters of \e
+     * mgrs are "INV", then \e zone is set to UTMUPS::INVALID, \e ix and \e
+     * iy are set to 0, and \e prec is set to &minus;2.  No memory is
+     * allocated unless an error is thrown; if an exception is thrown, then
+     * the arguments are unchanged.
+     **********************************************************************/
+    static void Decode(const char* mgrs, int& zone, bool& northp,
+                       long long& ix, long long& iy, int& prec);
+
+    /**
+     * Decode many MGRS coordinates to integer indices of their squares.
+     *
+     * @param[in] n the number of points.
+     * @param[in] mgrs a char array of \e n \e width characters; MGRS string
+     *   \e i starts at mgrs[\e i \e width] and ends at the first null or
+     *   after \e width characters.
+     * @param[in] width the spacing of the strings in \e mgrs.
+     * @param[out] zone array of \e n UTM zones (zero means UPS).
+     * @param[out] northp array of \e n hemispheres.
+     * @param[out] ix array of \e n easting indices.
+     * @param[out] iy array of \e n northing indices.
+     * @param[out] prec array of \e n precisions relative to 100 km.
+     * @exception GeographicErr if any string is illegal; the message refers
+     *   to the first such string and the points before it have been
+     *   decoded.
+     *
+     * Element \e i of the output arrays is the result of MGRS::Decode applied
+     * to string \e i.
+     **********************************************************************/
+    static void Decode(size_t n, const char mgrs[], size_t width,
+                       int zone[], bool northp[],
+                       long long ix[], long long iy[], int prec[]);
+
     /** \name Inspector functions
      **********************************************************************/
     ///@{
@@ -0,0 +1,189 @@
+/**
+ * \file MGRSCache.hpp
+ * \brief Header for GeographicLib::MGRSCache class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_MGRSCACHE_HPP)
+#define GEOGRAPHICLIB_MGRSCACHE_HPP 1
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <GeographicLib/Constants.hpp>
+
+#if defined(_MSC_VER)
+// Squelch warnings about dll vs std::list, std::unordered_map, and
+// std::mutex
+#  pragma warning (push)
+#  pragma warning (disable: 4251)
+#endif
+
+namespace GeographicLib {
+
+  /**
+   * \brief A cache of the geographic positions of MGRS squares
+   *
+   * Converting an MGRS coordinate to geographic coordinates entails
+   * MGRS::Reverse, which merely decodes the string, followed by
+   * UTMUPS::Reverse, which evaluates the inverse transverse Mercator or polar
+   * stereographic projection.  Applications which convert the same squares
+   * repeatedly (for example, a tiling service which receives many queries
+   * for the same 1 km or 10 km squares) can use an MGRSCache to pay for the
+   * projection only once per square.  The string is decoded with
+   * MGRS::Decode to the zone, hemisphere, precision, and integer indices of
+   * the square, which form the key; the values are the latitude and
+   * longitude of the center (or the south-west corner) of the square.
+   *
+   * The results are identical to those from MGRS::Reverse followed by
+   * UTMUPS::Reverse.  Strings with different spellings of the same square
+   * (e.g., using lower case letters) share an entry.  The cache is a bounded
+   * hash map which evicts its least recently used entries.  All the member
+   * functions are thread safe and the projection for a new square is
+   * evaluated with the lock released.
+   *
+   * Example of use:
+   * \code
+   *   MGRSCache cache(10000);
+   *   double lat, lon; int prec;
+   *   for (...)
+   *     cache.Reverse(mgrs, lat, lon, prec);
+   * \endcode
+   **********************************************************************/
+  class GEOGRAPHICLIB_EXPORT MGRSCache {
+  private:
+    typedef Math::real real;
+    struct Key {
+      long long ix, iy;
+      int zone, prec;
+      bool northp;
+      bool operator==(const Key& k) const;
+    };
+    struct Hash {
+      size_t operator()(const Key& k) const;
+    };
+    typedef std::pair<real, real> Value;
+    typedef std::list<std::pair<Key, Value> > list;
+    list _list;                 // most recently used at the front
+    std::unordered_map<Key, list::iterator, Hash> _map;
+    size_t _maxsize;
+    bool _centerp;
+    unsigned long long _hits, _misses;
+    mutable std::mutex _lock;
+    void GenReverse(const char* mgrs, real& lat, real& lon, int& prec);
+  public:
+
+    /**
+     * Constructor for an MGRSCache.
+     *
+     * @param[in] maxsize the maximum number of squares to retain (default
+     *   65536); if this is 0, no squares are retained.
+     * @param[in] centerp if true (default), return the center of the MGRS
+     *   square, else return SW (lower left) corner.
+     **********************************************************************/
+    explicit MGRSCache(size_t maxsize = 65536, bool centerp = true);
+
+    /**
+     * Convert a MGRS coordinate to geographic coordinates using the cache.
+     *
+     * @param[in] mgrs MGRS string as a null-terminated char array.
+     * @param[out] lat latitude of the point (degrees).
+     * @param[out] lon longitude of the point (degrees).
+     * @param[out] prec precision relative to 100 km.
+     * @exception GeographicErr if \e mgrs is illegal.
+     * @exception std::bad_alloc if the memory for a new entry can't be
+     *   allocated.
+     *
+     * This is the same as MGRS::Reverse(\e mgrs, \e zone, \e northp, \e x,
+     * \e y, \e prec, \e centerp) followed by UTMUPS::Reverse(\e zone, \e
+     * northp, \e x, \e y, \e lat, \e lon).  If the first 3 characters of \e
+     * mgrs are "INV", then the cache is bypassed, \e lat and \e lon are set
+     * to NaN, and \e prec is set to &minus;2.
+     **********************************************************************/
+    void Reverse(const char* mgrs, real& lat, real& lon, int& prec)
+    { GenReverse(mgrs, lat, lon, prec); }
+
+    /**
+     * Convert a MGRS coordinate to geographic coordinates using the cache.
+     *
+     * @param[in] mgrs MGRS string.
+     * @param[out] lat latitude of the point (degrees).
+     * @param[out] lon longitude of the point (degrees).
+     * @param[out] prec precision relative to 100 km.
+     * @exception GeographicErr if \e mgrs is illegal.
+     * @exception std::bad_alloc if the memory for a new entry can't be
+     *   allocated.
+     **********************************************************************/
+    void Reverse(const std::string& mgrs, real& lat, real& lon, int& prec)
+    { GenReverse(mgrs.c_str(), lat, lon, prec); }
+
+    /**
+     * Convert many MGRS coordinates to geographic coordinates using the
+     * cache.
+     *
+     * @param[in] n the number of points.
+     * @param[in] mgrs a char array of \e n \e width characters; MGRS string
+     *   \e i starts at mgrs[\e i \e width] and ends at the first null or
+     *   after \e width characters.
+     * @param[in] width the spacing of the strings in \e mgrs.
+     * @param[out] lat array of \e n latitudes (degrees).
+     * @param[out] lon array of \e n longitudes (degrees).
+     * @param[out] prec array of \e n precisions relative to 100 km; this may
+     *   be a null pointer.
+     * @exception GeographicErr if any string is illegal; the message refers
+     *   to the first such string and the points before it have been
+     *   converted.
+     * @exception std::bad_alloc if the memory for a new entry can't be
+     *   allocated.
+     **********************************************************************/
+    void Reverse(size_t n, const char mgrs[], size_t width,
+                 real lat[], real lon[], int prec[] = nullptr);
+
+    /**
+     * Remove all the squares from the cache and reset the statistics.
+     **********************************************************************/
+    void Clear();
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return the number of squares currently in the cache.
+     **********************************************************************/
+    size_t Size() const;
+
+    /**
+     * @return the maximum number of squares retained.
+     **********************************************************************/
+    size_t MaxSize() const { return _maxsize; }
+
+    /**
+     * @return whether the center (instead of the corner) of the square is
+     *   returned.
+     **********************************************************************/
+    bool Centerp() const { return _centerp; }
+
+    /**
+     * @return the number of conversions satisfied from the cache.
+     **********************************************************************/
+    unsigned long long Hits() const;
+
+    /**
+     * @return the number of conversions which evaluated a projection.
+     **********************************************************************/
+    unsigned long long Misses() const;
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#if defined(_MSC_VER)
+#  pragma warning (pop)
+#endif
+
+#endif  // GEOGRAPHICLIB_MGRSCACHE_HPP
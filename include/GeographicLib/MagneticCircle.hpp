@@ -190,6 +190,14 @@ namespace GeographicLib {
      **********************************************************************/
     Math::real Time() const
     { return Init() ? _t : Math::NaN(); }
+    /**
+     * @return the memory (in bytes) used by the MagneticCircle, including
+     *   the object itself.
+     **********************************************************************/
+    size_t MemoryUsage() const {
+      return sizeof(*this) + _circ0.MemoryUsage() + _circ1.MemoryUsage() +
+        _circ2.MemoryUsage();
+    }
     ///@}
   };
 
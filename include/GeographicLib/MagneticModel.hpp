@@ -10,6 +10,8 @@
 #if !defined(GEOGRAPHICLIB_MAGNETICMODEL_HPP)
 #define GEOGRAPHICLIB_MAGNETICMODEL_HPP 1
 
+#include <future>
+#include <memory>
 #include <GeographicLib/Constants.hpp>
 #include <GeographicLib/Geocentric.hpp>
 #include <GeographicLib/SphericalHarmonic.hpp>
@@ -83,11 +85,24 @@ namespace GeographicLib {
     Geocentric _earth;
     std::vector< std::vector<real> > _gG;
     std::vector< std::vector<real> > _hH;
+    // The coefficients if they are stored as floats
+    std::vector< std::vector<float> > _gGf;
+    std::vector< std::vector<float> > _hHf;
     std::vector<SphericalHarmonic> _harm;
     void Field(real t, real lat, real lon, real h, bool diffp,
                real& Bx, real& By, real& Bz,
                real& Bxt, real& Byt, real& Bzt) const;
     void ReadMetadata(const std::string& name);
+    // Reduce t to the time since the start of its model interval and return
+    // the index of the interval.
+    int Interval(real& t) const;
+    // The sums for interval n at a geocentric point; S = [BX, BY, BZ] for
+    // model n, then for model n + 1, then for the constant model (or 0).
+    void FieldSums(int n, real X, real Y, real Z, real S[]) const;
+    // Combine the sums S for the reduced time t to give the field.
+    void FieldCombine(real t, bool interpolate, const real S[],
+                      real& BX, real& BY, real& BZ,
+                      real& BXt, real& BYt, real& BZt) const;
     // copy constructor not allowed
     MagneticModel(const MagneticModel&) = delete;
     // nor copy assignment
@@ -108,6 +123,8 @@ namespace GeographicLib {
      *   model this value.
      * @param[in] Mmax (optional) if non-negative, truncate the order of the
      *   model this value.
+     * @param[in] single (optional) if true, store the coefficients as floats
+     *   (default false).
      * @exception GeographicErr if the data file cannot be found, is
      *   unreadable, or is corrupt, or if \e Mmax > \e Nmax.
      * @exception std::bad_alloc if the memory necessary for storing the model
@@ -131,11 +148,42 @@ namespace GeographicLib {
      * If \e Nmax &ge; 0 and \e Mmax < 0, then \e Mmax is set to \e Nmax.
      * After the model is loaded, the maximum degree and order of the model can
      * be found by the Degree() and Order() methods.
+     *
+     * If \e single is true, the coefficients are rounded to floats (the sums
+     * are still accumulated as Math::real).  This halves the memory for the
+     * coefficients, which matters only for the high degree models, e.g.,
+     * emm2017.  The rounding changes the field by less than 0.01 nT.
      **********************************************************************/
     explicit MagneticModel(const std::string& name,
                            const std::string& path = "",
                            const Geocentric& earth = Geocentric::WGS84(),
-                           int Nmax = -1, int Mmax = -1);
+                           int Nmax = -1, int Mmax = -1, bool single = false);
+
+    /**
+     * Construct a magnetic model in the background.
+     *
+     * @param[in] name the name of the model.
+     * @param[in] path (optional) directory for data file.
+     * @param[in] earth (optional) Geocentric object for converting
+     *   coordinates; default Geocentric::WGS84().
+     * @param[in] Nmax (optional) if non-negative, truncate the degree of the
+     *   model this value.
+     * @param[in] Mmax (optional) if non-negative, truncate the order of the
+     *   model this value.
+     * @param[in] single (optional) if true, store the coefficients as floats
+     *   (default false).
+     * @return a future holding the model.
+     *
+     * This constructs the model, with the same arguments as
+     * MagneticModel(const std::string&, const std::string&, const
+     * Geocentric&, int, int, bool), on a new thread so that reading the
+     * coefficients can overlap other initialization.  Any exception thrown
+     * by the constructor is rethrown by the \e get() method of the future.
+     **********************************************************************/
+    static std::future< std::unique_ptr<MagneticModel> >
+    Load(const std::string& name, const std::string& path = "",
+         const Geocentric& earth = Geocentric::WGS84(),
+         int Nmax = -1, int Mmax = -1, bool single = false);
     ///@}
 
     /** \name Compute the magnetic field
@@ -189,6 +237,106 @@ namespace GeographicLib {
       Field(t, lat, lon, h, true, Bx, By, Bz, Bxt, Byt, Bzt);
     }
 
+    /**
+     * Evaluate the geomagnetic field at a fixed point for many times.
+     *
+     * @param[in] n the number of times.
+     * @param[in] t array of \e n times (fractional years).
+     * @param[in] lat latitude of the point (degrees).
+     * @param[in] lon longitude of the point (degrees).
+     * @param[in] h the height of the point above the ellipsoid (meters).
+     * @param[out] Bx array of easterly components of the magnetic field
+     *   (nanotesla).
+     * @param[out] By array of northerly components of the magnetic field
+     *   (nanotesla).
+     * @param[out] Bz array of vertical (up) components of the magnetic field
+     *   (nanotesla).
+     * @param[out] Bxt array of rates of change of \e Bx (nT/yr).
+     * @param[out] Byt array of rates of change of \e By (nT/yr).
+     * @param[out] Bzt array of rates of change of \e Bz (nT/yr).
+     *
+     * The spherical harmonic sums depend on the time only via the model
+     * interval that \e t lies in.  So they are evaluated once for each run
+     * of times in the same interval, and each time then costs only a linear
+     * combination of the sums.  The results are identical to those given by
+     * calling operator()() for each time.  \e Bxt, \e Byt, \e Bzt may be
+     * null pointers (they all must be, if one is).  The input and output
+     * arrays must not overlap.
+     **********************************************************************/
+    void operator()(size_t n, const real t[], real lat, real lon, real h,
+                    real Bx[], real By[], real Bz[],
+                    real Bxt[] = nullptr, real Byt[] = nullptr,
+                    real Bzt[] = nullptr) const;
+
+    /**
+     * Evaluate the geomagnetic field along a trajectory.
+     *
+     * @param[in] n the number of points.
+     * @param[in] t array of \e n times (fractional years).
+     * @param[in] lat array of \e n latitudes (degrees).
+     * @param[in] lon array of \e n longitudes (degrees).
+     * @param[in] h array of \e n heights above the ellipsoid (meters).
+     * @param[out] Bx array of easterly components of the magnetic field
+     *   (nanotesla).
+     * @param[out] By array of northerly components of the magnetic field
+     *   (nanotesla).
+     * @param[out] Bz array of vertical (up) components of the magnetic field
+     *   (nanotesla).
+     * @param[out] Bxt array of rates of change of \e Bx (nT/yr).
+     * @param[out] Byt array of rates of change of \e By (nT/yr).
+     * @param[out] Bzt array of rates of change of \e Bz (nT/yr).
+     *
+     * The points in each model interval are evaluated together with the
+     * multi-point version of SphericalHarmonic::operator()(), so that the
+     * coefficients are loaded once for several points.  The results are
+     * identical to those given by calling operator()() for each point.  \e
+     * Bxt, \e Byt, \e Bzt may be null pointers (they all must be, if one
+     * is).  The input and output arrays must not overlap.
+     **********************************************************************/
+    void operator()(size_t n, const real t[],
+                    const real lat[], const real lon[], const real h[],
+                    real Bx[], real By[], real Bz[],
+                    real Bxt[] = nullptr, real Byt[] = nullptr,
+                    real Bzt[] = nullptr) const;
+
+    /**
+     * Evaluate several magnetic models at a point.
+     *
+     * @param[in] n the number of models.
+     * @param[in] models array of \e n pointers to the models.
+     * @param[in] t the time (fractional years).
+     * @param[in] lat latitude of the point (degrees).
+     * @param[in] lon longitude of the point (degrees).
+     * @param[in] h the height of the point above the ellipsoid (meters).
+     * @param[out] Bx array of \e n easterly components of the magnetic field
+     *   (nanotesla).
+     * @param[out] By array of \e n northerly components of the magnetic field
+     *   (nanotesla).
+     * @param[out] Bz array of \e n vertical (up) components of the magnetic
+     *   field (nanotesla).
+     * @param[out] Bxt array of \e n rates of change of \e Bx (nT/yr).
+     * @param[out] Byt array of \e n rates of change of \e By (nT/yr).
+     * @param[out] Bzt array of \e n rates of change of \e Bz (nT/yr).
+     * @exception std::bad_alloc if the memory for the sums can't be
+     *   allocated.
+     *
+     * Element \e i of the results is the field given by \e models[\e
+     * i]->operator()(\e t, \e lat, \e lon, \e h, ...); the results are
+     * identical.  This is intended for comparing models, e.g., WMM, IGRF,
+     * and EMM, at the same points.  The models which are compatible with
+     * \e models[0] (they have the same reference radius, normalization, and
+     * ellipsoid) are evaluated with a single call to SphericalEngine::Sums,
+     * so that the work which depends only on the position is shared by all
+     * their spherical harmonic sums.  Any other models are evaluated
+     * separately.  \e Bxt, \e Byt, \e Bzt may be null pointers (they all
+     * must be, if one is).
+     **********************************************************************/
+    static void Ensemble(size_t n, const MagneticModel* const models[],
+                         real t, real lat, real lon, real h,
+                         real Bx[], real By[], real Bz[],
+                         real Bxt[] = nullptr, real Byt[] = nullptr,
+                         real Bzt[] = nullptr);
+
     /**
      * Create a MagneticCircle object to allow the geomagnetic field at many
      * points with constant \e lat, \e h, and \e t and varying \e lon to be
@@ -377,6 +525,35 @@ namespace GeographicLib {
      * @return \e Mmax the maximum order of the components of the model.
      **********************************************************************/
     int Order() const { return _mmx; }
+
+    /**
+     * \brief The memory used by a MagneticModel
+     *
+     * The sizes are in bytes.
+     **********************************************************************/
+    struct Memory {
+      /**
+       * The coefficients of the components of the model.
+       **********************************************************************/
+      size_t coefficients;
+      /**
+       * Constructor, all sizes are zero.
+       **********************************************************************/
+      Memory() : coefficients(0) {}
+      /**
+       * @return the memory allocated by the MagneticModel, \e coefficients.
+       **********************************************************************/
+      size_t Total() const { return coefficients; }
+    };
+
+    /**
+     * @return the memory used by the MagneticModel.
+     *
+     * The table of square roots used by all the spherical harmonic sums is
+     * reported by SphericalEngine::RootTableBytes.  The MagneticCircle
+     * objects are reported by MagneticCircle::MemoryUsage.
+     **********************************************************************/
+    Memory MemoryUsage() const;
     ///@}
 
     /**
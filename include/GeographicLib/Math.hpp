@@ -22,6 +22,17 @@
 #  define GEOGRAPHICLIB_HAVE_LONG_DOUBLE 0
 #endif
 
+#if !defined(GEOGRAPHICLIB_INLINE_MATH)
+/**
+ * If this is 1, the definitions of the most frequently called functions in
+ * Math (sum, AngNormalize, AngDiff, AngRound, sincosd, sincosde, and atan2d)
+ * are included in this header (from MathInline.hpp) so that they can be
+ * expanded inline.  Otherwise (the default) these functions are compiled
+ * into the library.
+ **********************************************************************/
+#  define GEOGRAPHICLIB_INLINE_MATH 0
+#endif
+
 #if !defined(GEOGRAPHICLIB_PRECISION)
 /**
  * The precision of floating point numbers used in %GeographicLib.  1 means
@@ -482,6 +493,91 @@ namespace GeographicLib {
      **********************************************************************/
     template<typename T> static T tauf(T taup, T es);
 
+    /** \name Array versions of the angle functions
+     **********************************************************************/
+    ///@{
+    /**
+     * Evaluate Math::sincosd for an array of angles.
+     *
+     * @tparam T the type of the arguments.
+     * @param[in] n the number of angles.
+     * @param[in] x array of \e n angles in degrees.
+     * @param[out] sinx array of \e n values of sin(<i>x</i>).
+     * @param[out] cosx array of \e n values of cos(<i>x</i>).
+     *
+     * The results, including the treatment of special values, are identical
+     * to those given by calling Math::sincosd for each element.  The output
+     * arrays must not overlap, but one of them may coincide with \e x.
+     **********************************************************************/
+    template<typename T> static void sincosd(size_t n, const T x[],
+                                             T sinx[], T cosx[]);
+
+    /**
+     * Evaluate Math::atan2d for arrays of arguments.
+     *
+     * @tparam T the type of the arguments.
+     * @param[in] n the number of elements.
+     * @param[in] y array of \e n values of \e y.
+     * @param[in] x array of \e n values of \e x.
+     * @param[out] ang array of \e n values of atan2(<i>y</i>, <i>x</i>) in
+     *   degrees.
+     *
+     * The results are identical to those given by calling Math::atan2d for
+     * each element.  \e ang may coincide with \e y or \e x.
+     **********************************************************************/
+    template<typename T> static void atan2d(size_t n, const T y[],
+                                            const T x[], T ang[]);
+
+    /**
+     * Evaluate Math::AngNormalize for an array of angles.
+     *
+     * @tparam T the type of the arguments.
+     * @param[in] n the number of angles.
+     * @param[in] x array of \e n angles in degrees.
+     * @param[out] y array of \e n angles reduced to the range
+     *   [&minus;180&deg;, 180&deg;].
+     *
+     * The results are identical to those given by calling Math::AngNormalize
+     * for each element.  \e y may coincide with \e x.
+     **********************************************************************/
+    template<typename T> static void AngNormalize(size_t n, const T x[],
+                                                  T y[]);
+
+    /**
+     * Evaluate Math::AngDiff for arrays of angles.
+     *
+     * @tparam T the type of the arguments.
+     * @param[in] n the number of elements.
+     * @param[in] x array of \e n first angles in degrees.
+     * @param[in] y array of \e n second angles in degrees.
+     * @param[out] d array of \e n truncated values of \e y &minus; \e x.
+     * @param[out] e array of \e n error terms in degrees; this may be a null
+     *   pointer if the error terms are not needed.
+     *
+     * The results are identical to those given by calling Math::AngDiff for
+     * each element.  \e d may coincide with \e x or \e y.
+     **********************************************************************/
+    template<typename T> static void AngDiff(size_t n, const T x[],
+                                             const T y[], T d[],
+                                             T e[] = nullptr);
+
+    /**
+     * Evaluate Math::tauf for an array of arguments.
+     *
+     * @tparam T the type of the arguments.
+     * @param[in] n the number of elements.
+     * @param[in] taup array of \e n values of &tau;&prime; = tan&chi;
+     * @param[in] es the signed eccentricity = sign(<i>e</i><sup>2</sup>)
+     *   sqrt(|<i>e</i><sup>2</sup>|)
+     * @param[out] tau array of \e n values of &tau; = tan&phi;
+     *
+     * The results are identical to those given by calling Math::tauf for each
+     * element.  \e tau may coincide with \e taup.
+     **********************************************************************/
+    template<typename T> static void tauf(size_t n, const T taup[], T es,
+                                          T tau[]);
+    ///@}
+
     /**
      * The NaN (not a number)
      *
@@ -516,8 +612,31 @@ namespace GeographicLib {
       return b.r;
     }
 
+    /**
+     * Swap the bytes of the elements of an array
+     *
+     * @tparam T the type of the elements.
+     * @param[in,out] x the array; on output each element has its bytes
+     *   swapped.
+     * @param[in] n the number of elements.
+     *
+     * This gives the same result as applying swab(T) to each element.  The
+     * bytes are swapped in place with a simple loop, which compilers
+     * vectorize.
+     **********************************************************************/
+    template<typename T> static void swab(T x[], size_t n) {
+      unsigned char* p = reinterpret_cast<unsigned char*>(x);
+      for (size_t k = 0; k < n; ++k, p += sizeof(T))
+        for (size_t i = 0; i < sizeof(T)/2; ++i)
+          std::swap(p[i], p[sizeof(T) - 1 - i]);
+    }
+
   };
 
 } // namespace GeographicLib
 
+#if GEOGRAPHICLIB_INLINE_MATH
+#include <GeographicLib/MathInline.hpp>
+#endif
+
 #endif  // GEOGRAPHICLIB_MATH_HPP
@@ -0,0 +1,145 @@
+/**
+ * \file MathInline.hpp
+ * \brief Definitions of the hot GeographicLib::Math primitives
+ *
+ * These are the definitions of Math::sum, Math::AngNormalize, Math::AngDiff,
+ * Math::AngRound, Math::sincosd, Math::sincosde, and Math::atan2d.  They are
+ * compiled into the library by Math.cpp (with explicit instantiations for
+ * the floating point types).  If GEOGRAPHICLIB_INLINE_MATH is 1, Math.hpp
+ * also includes this file so that the compiler can expand these functions
+ * inline in their callers.
+ *
+ * Copyright (c) Charles Karney (2015-2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_MATHINLINE_HPP)
+#define GEOGRAPHICLIB_MATHINLINE_HPP 1
+
+#include <GeographicLib/Math.hpp>
+
+namespace GeographicLib {
+
+  /// \cond SKIP
+  template<typename T> T Math::sum(T u, T v, T& t) {
+    GEOGRAPHICLIB_VOLATILE T s = u + v;
+    GEOGRAPHICLIB_VOLATILE T up = s - v;
+    GEOGRAPHICLIB_VOLATILE T vpp = s - up;
+    up -= u;
+    vpp -= v;
+    // if s = 0, then t = 0 and give t the same sign as s
+    // mpreal needs T(0) here
+    t = s != 0 ? T(0) - (up + vpp) : s;
+    // u + v =       s      + t
+    //       = round(u + v) + t
+    return s;
+  }
+
+  template<typename T> T Math::AngNormalize(T x) {
+    using std::remainder; using std::copysign; using std::fabs;
+    T y = remainder(x, T(td));
+#if GEOGRAPHICLIB_PRECISION == 4
+    // boost-quadmath doesn't set the sign of 0 correctly, see
+    // https://github.com/boostorg/multiprecision/issues/426
+    // Fixed by https://github.com/boostorg/multiprecision/pull/428
+    if (y == 0) y = copysign(y, x);
+#endif
+    return fabs(y) == T(hd) ? copysign(T(hd), x) : y;
+  }
+
+  template<typename T> T Math::AngDiff(T x, T y, T& e) {
+    using std::remainder; using std::copysign; using std::fabs;
+    // Use remainder instead of AngNormalize, since we treat boundary cases
+    // later taking account of the error
+    T d = sum(remainder(-x, T(td)), remainder( y, T(td)), e);
+    // This second sum can only change d if abs(d) < 128, so don't need to
+    // apply remainder yet again.
+    d = sum(remainder(d, T(td)), e, e);
+    // Fix the sign if d = -180, 0, 180.
+    if (d == 0 || fabs(d) == hd)
+      // If e == 0, take sign from y - x
+      // else (e != 0, implies d = +/-180), d and e must have opposite signs
+      d = copysign(d, e == 0 ? y - x : -e);
+    return d;
+  }
+
+  template<typename T> T Math::AngRound(T x) {
+    using std::copysign; using std::fabs;
+    static const T z = T(1)/T(16);
+    GEOGRAPHICLIB_VOLATILE T y = fabs(x);
+    GEOGRAPHICLIB_VOLATILE T w = z - y;
+    // The compiler mustn't "simplify" z - (z - y) to y
+    y = w > 0 ? z - w : y;
+    return copysign(y, x);
+  }
+
+  template<typename T> void Math::sincosd(T x, T& sinx, T& cosx) {
+    using std::remquo; using std::sin; using std::cos; using std::copysign;
+    // In order to minimize round-off errors, this function exactly reduces
+    // the argument to the range [-45, 45] before converting it to radians.
+    T r; int q = 0;
+    r = remquo(x, T(qd), &q);   // now abs(r) <= 45
+    r *= degree<T>();
+    // g++ -O turns these two function calls into a call to sincos
+    T s = sin(r), c = cos(r);
+    switch (unsigned(q) & 3U) {
+    case 0U: sinx =  s; cosx =  c; break;
+    case 1U: sinx =  c; cosx = -s; break;
+    case 2U: sinx = -s; cosx = -c; break;
+    default: sinx = -c; cosx =  s; break; // case 3U
+    }
+    // http://www.open-std.org/jtc1/sc22/wg14/www/docs/n1950.pdf
+    // mpreal needs T(0) here
+    cosx += T(0);                            // special values from F.10.1.12
+    if (sinx == 0) sinx = copysign(sinx, x); // special values from F.10.1.13
+  }
+
+  template<typename T> void Math::sincosde(T x, T t, T& sinx, T& cosx) {
+    using std::remquo; using std::sin; using std::cos; using std::copysign;
+    // In order to minimize round-off errors, this function exactly reduces
+    // the argument to the range [-45, 45] before converting it to radians.
+    // This implementation allows x outside [-180, 180], but implementations in
+    // other languages may not.
+    T r; int q = 0;
+    r = AngRound(remquo(x, T(qd), &q) + t); // now abs(r) <= 45
+    r *= degree<T>();
+    // g++ -O turns these two function calls into a call to sincos
+    T s = sin(r), c = cos(r);
+    switch (unsigned(q) & 3U) {
+    case 0U: sinx =  s; cosx =  c; break;
+    case 1U: sinx =  c; cosx = -s; break;
+    case 2U: sinx = -s; cosx = -c; break;
+    default: sinx = -c; cosx =  s; break; // case 3U
+    }
+    // http://www.open-std.org/jtc1/sc22/wg14/www/docs/n1950.pdf
+    // mpreal needs T(0) here
+    cosx += T(0);                            // special values from F.10.1.12
+    if (sinx == 0) sinx = copysign(sinx, x); // special values from F.10.1.13
+  }
+
+  template<typename T> T Math::atan2d(T y, T x) {
+    using std::atan2; using std::copysign; using std::fabs; using std::signbit;
+    // In order to minimize round-off errors, this function rearranges the
+    // arguments so that result of atan2 is in the range [-pi/4, pi/4] before
+    // converting it to degrees and mapping the result to the correct
+    // quadrant.
+    int q = 0;
+    if (fabs(y) > fabs(x)) { std::swap(x, y); q = 2; }
+    if (signbit(x)) { x = -x; ++q; }
+    // here x >= 0 and x >= abs(y), so angle is in [-pi/4, pi/4]
+    T ang = atan2(y, x) / degree<T>();
+    switch (q) {
+    case 1: ang = copysign(T(hd), y) - ang; break;
+    case 2: ang =            qd      - ang; break;
+    case 3: ang =           -qd      + ang; break;
+    default: break;
+    }
+    return ang;
+  }
+
+  /// \endcond
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_MATHINLINE_HPP
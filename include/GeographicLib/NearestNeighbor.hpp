@@ -10,16 +10,21 @@
 #if !defined(GEOGRAPHICLIB_NEARESTNEIGHBOR_HPP)
 #define GEOGRAPHICLIB_NEARESTNEIGHBOR_HPP 1
 
-#include <algorithm>            // for nth_element, max_element, etc.
+#include <algorithm>            // for nth_element, push_heap, etc.
 #include <vector>
-#include <queue>                // for priority_queue
 #include <utility>              // for swap + pair
 #include <cstring>
+#include <cstddef>
+#include <type_traits>
 #include <limits>
 #include <cmath>
 #include <sstream>
-// Only for GeographicLib::GeographicErr
+#include <atomic>
+// Only for GeographicLib::GeographicErr, GeographicLib::Executor, and
+// GeographicLib::Tracer
 #include <GeographicLib/Constants.hpp>
+#include <GeographicLib/Executor.hpp>
+#include <GeographicLib/Tracer.hpp>
 
 #if defined(GEOGRAPHICLIB_HAVE_BOOST_SERIALIZATION) && \
   GEOGRAPHICLIB_HAVE_BOOST_SERIALIZATION
@@ -70,10 +75,12 @@ namespace GeographicLib {
    * not satisfy the triangle inequality!
    *
    * \note This is a "header-only" implementation and, as such, depends in a
-   * minimal way on the rest of GeographicLib (the only dependency is through
+   * minimal way on the rest of GeographicLib (the dependencies are through
    * the use of GeographicLib::GeographicErr for handling and run-time
-   * exceptions).  Therefore, it is easy to extract this class from the rest of
-   * GeographicLib and use it as a stand-alone facility.
+   * exceptions and of GeographicLib::Executor, which is implemented in the
+   * library, to run the parallel work when \e nthreads &gt; 1).  Therefore,
+   * it is easy to extract this class from the rest of GeographicLib and use
+   * it as a stand-alone facility.
    *
    * The \e dist_t type must support numeric_limits queries (specifically:
    * is_signed, is_integer, max(), digits).
@@ -93,7 +100,9 @@ namespace GeographicLib {
    * object to an external file.  operator<<(), operator>>() and <a
    * href="https://www.boost.org/libs/serialization/doc"> Boost
    * serialization</a> can also be used to save and restore a NearestNeighbor
-   * object.  This is illustrated in the example.
+   * object.  This is illustrated in the example.  For very large sets of
+   * points, SaveMappable() writes a form which can be mapped into memory and
+   * used in place with Map(), avoiding the cost of loading the object.
    *
    * Example of use:
    * \include example-NearestNeighbor.cpp
@@ -107,6 +116,8 @@ namespace GeographicLib {
     static const int maxbucket =
       (2 + ((4 * sizeof(dist_t)) / sizeof(int) >= 2 ?
             (4 * sizeof(dist_t)) / sizeof(int) : 2));
+    // Don't build subtrees with fewer points than this on separate threads
+    static const int minsplit = 4096;
   public:
 
     /**
@@ -114,7 +125,10 @@ namespace GeographicLib {
      *
      * This is equivalent to specifying an empty set of points.
      **********************************************************************/
-    NearestNeighbor() : _numpoints(0), _bucket(0), _cost(0) {}
+    NearestNeighbor()
+      : _numpoints(0), _bucket(0), _cost(0), _map(nullptr), _mapsize(0)
+      , _ndead(0), _ninserted(0), _stats(false)
+    { ResetStatistics(); }
 
     /**
      * Constructor for NearestNeighbor.
@@ -123,6 +137,7 @@ namespace GeographicLib {
      * @param[in] dist the distance function object.
      * @param[in] bucket the size of the buckets at the leaf nodes; this must
      *   lie in [0, 2 + 4*sizeof(dist_t)/sizeof(int)] (default 4).
+     * @param[in] nthreads the number of threads to use (default 1).
      * @exception GeographicErr if the value of \e bucket is out of bounds or
      *   the size of \e pts is too big for an int.
      * @exception std::bad_alloc if memory for the tree can't be allocated.
@@ -137,6 +152,11 @@ namespace GeographicLib {
      * However each search then requires about bucket additional distance
      * calculations.
      *
+     * With \e nthreads &gt; 1, the two subtrees below each node near the root
+     * of the tree are constructed concurrently; in this case, \e dist must
+     * allow concurrent calls to its function call operator.  The resulting
+     * tree does not depend on \e nthreads.
+     *
      * \warning The distances computed by \e dist must satisfy the standard
      * metric conditions.  If not, the results are undefined.  Neither the data
      * in \e pts nor the query points should contain NaNs or infinities because
@@ -146,8 +166,9 @@ namespace GeographicLib {
      * to the Search() function.
      **********************************************************************/
     NearestNeighbor(const std::vector<pos_t>& pts, const distfun_t& dist,
-                    int bucket = 4) {
-      Initialize(pts, dist, bucket);
+                    int bucket = 4, int nthreads = 1)
+      : _stats(false) {
+      Initialize(pts, dist, bucket, nthreads);
     }
 
     /**
@@ -157,6 +178,7 @@ namespace GeographicLib {
      * @param[in] dist the distance function object.
      * @param[in] bucket the size of the buckets at the leaf nodes; this must
      *   lie in [0, 2 + 4*sizeof(dist_t)/sizeof(int)] (default 4).
+     * @param[in] nthreads the number of threads to use (default 1).
      * @exception GeographicErr if the value of \e bucket is out of bounds or
      *   the size of \e pts is too big for an int.
      * @exception std::bad_alloc if memory for the tree can't be allocated.
@@ -167,7 +189,7 @@ namespace GeographicLib {
      * unchanged.
      **********************************************************************/
     void Initialize(const std::vector<pos_t>& pts, const distfun_t& dist,
-                    int bucket = 4) {
+                    int bucket = 4, int nthreads = 1) {
       static_assert(std::numeric_limits<dist_t>::is_signed,
                     "dist_t must be a signed type");
       if (!( 0 <= bucket && bucket <= maxbucket ))
@@ -179,18 +201,113 @@ namespace GeographicLib {
       std::vector<item> ids(pts.size());
       for (int k = int(ids.size()); k--;)
         ids[k] = std::make_pair(dist_t(0), k);
-      int cost = 0;
-      std::vector<Node> tree;
-      init(pts, dist, bucket, tree, ids, cost,
-           0, int(ids.size()), int(ids.size()/2));
-      _tree.swap(tree);
-      _numpoints = int(pts.size());
-      _bucket = bucket;
-      _mc = _sc = 0;
-      _cost = cost; _c1 = _k = _cmax = 0;
-      _cmin = std::numeric_limits<int>::max();
+      build(pts, dist, bucket, nthreads, ids);
     }
 
+    /**
+     * Add points to NearestNeighbor.
+     *
+     * @param[in] pts the vector of points used for initialization with new
+     *   points appended.
+     * @param[in] dist the distance function object used for initialization.
+     * @exception GeographicErr if \e pts is smaller than the vector used
+     *   for initialization or is too big for an int.
+     * @exception std::bad_alloc if memory for the tree can't be allocated.
+     *
+     * The points <i>pts</i>[<i>i</i>] for \e i &ge; NumPoints() are added
+     * to the tree.  Each point is placed in a free slot of the bucket
+     * reached by descending the tree (widening the bounds of the nodes on
+     * the way); if the bucket is full, it is split.  The cost of adding a
+     * point is comparable to that of a search.  The tree is not rebalanced;
+     * see Rebuild().  The vector \e pts (now larger) must be supplied to
+     * subsequent calls to Search().
+     **********************************************************************/
+    void Insert(const std::vector<pos_t>& pts, const distfun_t& dist) {
+      if (pts.size() < size_t(_numpoints))
+        throw GeographicLib::GeographicErr("pts array has wrong size");
+      if (pts.size() > size_t(std::numeric_limits<int>::max()))
+        throw GeographicLib::GeographicErr("pts array too big");
+      int num = int(pts.size());
+      if (num == _numpoints) return;
+      if (_map) {
+        _tree.assign(_map, _map + _mapsize);
+        _map = nullptr; _mapsize = 0;
+      }
+      if (_tree.empty() || (_bucket > 0 && _tree.back().index < 0)) {
+        // The root is a leaf (or the tree is empty); just rebuild.
+        int ninserted = _ninserted + num - _numpoints;
+        std::vector<item> ids = members();
+        for (int i = _numpoints; i < num; ++i)
+          ids.push_back(std::make_pair(dist_t(0), i));
+        build(pts, dist, _bucket, 1, ids);
+        _ninserted = ninserted;
+        return;
+      }
+      if (!_dead.empty()) _dead.resize(num, 0);
+      for (int i = _numpoints; i < num; ++i)
+        insert(pts, dist, i);
+      _ninserted += num - _numpoints;
+      _numpoints = num;
+    }
+
+    /**
+     * Remove a point from NearestNeighbor.
+     *
+     * @param[in] i the index of the point to remove.
+     * @exception GeographicErr if \e i is not in [0, NumPoints()).
+     *
+     * The point is marked as removed and is no longer returned by Search().
+     * It remains in the tree (and in \e pts) and is still used to
+     * navigate the tree until the tree is rebuilt with Rebuild().
+     **********************************************************************/
+    void Remove(int i) {
+      if (!( 0 <= i && i < _numpoints ))
+        throw GeographicLib::GeographicErr("Index out of range");
+      if (_dead.empty()) _dead.assign(_numpoints, 0);
+      if (!_dead[i]) { _dead[i] = 1; ++_ndead; }
+    }
+
+    /**
+     * Rebuild NearestNeighbor from its current points.
+     *
+     * @param[in] pts the vector of points used for initialization (including
+     *   any added with Insert()).
+     * @param[in] dist the distance function object used for initialization.
+     * @param[in] nthreads the number of threads to use (default 1).
+     * @exception GeographicErr if \e pts has a different size from that used
+     *   to construct the object.
+     * @exception std::bad_alloc if memory for the tree can't be allocated.
+     *
+     * This builds a balanced tree from the points which have not been
+     * removed; the removed points are dropped from the tree (though they
+     * still count in NumPoints()).  The bucket size is unchanged and the
+     * counters for statistics are reset.  A simple policy is to rebuild once
+     * NumInserted() + NumRemoved() exceeds some fraction (e.g., 1/4) of
+     * NumPoints().  The rebuilding can be done in the background by
+     * rebuilding a copy of the object on another thread (using a copy of \e
+     * pts if this is also being changed), while searches continue with the
+     * original; the two can then be exchanged with swap().
+     **********************************************************************/
+    void Rebuild(const std::vector<pos_t>& pts, const distfun_t& dist,
+                 int nthreads = 1) {
+      if (_numpoints != int(pts.size()))
+          throw GeographicLib::GeographicErr("pts array has wrong size");
+      std::vector<item> ids = members();
+      build(pts, dist, _bucket, nthreads, ids);
+    }
+
+    /**
+     * @return the number of points added with Insert() since the tree was
+     *   built.
+     **********************************************************************/
+    int NumInserted() const { return _ninserted; }
+
+    /**
+     * @return the number of points removed with Remove() since the tree was
+     *   built.
+     **********************************************************************/
+    int NumRemoved() const { return _ndead; }
+
     /**
      * Search the NearestNeighbor.
      *
@@ -205,6 +322,11 @@ namespace GeographicLib {
      *   \e mindist from \e query (default = &minus;1).
      * @param[in] exhaustive whether to do an exhaustive search (default true).
      * @param[in] tol the tolerance on the results (default 0).
+     * @param[in] maxcost the maximum number of distance calculations
+     *   (default is the maximum int).
+     * @param[out] cost if not a null pointer (the default), set to the number
+     *   of distance calculations made by this search (&minus;1 if no search
+     *   was needed).
      * @return the distance to the closest point found (&minus;1 if no points
      *   are found).
      * @exception GeographicErr if \e pts has a different size from that used
@@ -238,6 +360,15 @@ namespace GeographicLib {
      * closer results with distances greater or equal to \e dk &minus; \e tol.
      * If less than \e k results are found, then the search is exact.
      *
+     * If \e maxcost is specified, the search stops once \e maxcost distance
+     * calculations have been made and returns the best results found so far.
+     * This bounds the time for a search.  The search is then approximate
+     * (and may return fewer than \e k results), unless the search finished
+     * anyway, which is the case if \e cost is set to less than \e maxcost.
+     * Setting \e exhaustive = false and \e
+     * maxdist = \e X finds "some point within \e X" with fewer distance
+     * calculations.
+     *
      * \e mindist should be used to exclude a "small" neighborhood of the query
      * point (relative to the average spacing of the data).  If \e mindist is
      * large, the efficiency of the search deteriorates.
@@ -261,98 +392,480 @@ namespace GeographicLib {
                   dist_t maxdist = std::numeric_limits<dist_t>::max(),
                   dist_t mindist = -1,
                   bool exhaustive = true,
-                  dist_t tol = 0) const {
+                  dist_t tol = 0,
+                  int maxcost = std::numeric_limits<int>::max(),
+                  int* cost = nullptr) const {
       if (_numpoints != int(pts.size()))
           throw GeographicLib::GeographicErr("pts array has wrong size");
-      std::priority_queue<item> results;
-      if (_numpoints > 0 && k > 0 && maxdist > mindist) {
-        // distance to the kth closest point so far
-        dist_t tau = maxdist;
-        // first is negative of how far query is outside boundary of node
-        // +1 if on boundary or inside
-        // second is node index
-        std::priority_queue<item> todo;
-        todo.push(std::make_pair(dist_t(1), int(_tree.size()) - 1));
-        int c = 0;
-        while (!todo.empty()) {
-          int n = todo.top().second;
-          dist_t d = -todo.top().first;
-          todo.pop();
-          dist_t tau1 = tau - tol;
-          // compare tau and d again since tau may have become smaller.
-          if (!( n >= 0 && tau1 >= d )) continue;
-          const Node& current = _tree[n];
-          dist_t dst = 0;   // to suppress warning about uninitialized variable
-          bool exitflag = false, leaf = current.index < 0;
-          for (int i = 0; i < (leaf ? _bucket : 1); ++i) {
-            int index = leaf ? current.leaves[i] : current.index;
-            if (index < 0) break;
-            dst = dist(pts[index], query);
-            ++c;
+      int c;
+      dist_t d = searchint(pts, dist, nobound(), nobatch(), query, ind, k,
+                           maxdist, mindist, exhaustive, tol, maxcost, c);
+      if (cost) *cost = c;
+      if (_stats && c >= 0) record(c);
+      return d;
+    }
 
-            if (dst > mindist && dst <= tau) {
-              if (int(results.size()) == k) results.pop();
-              results.push(std::make_pair(dst, index));
-              if (int(results.size()) == k) {
-                if (exhaustive)
-                  tau = results.top().first;
-                else {
-                  exitflag = true;
-                  break;
-                }
-                if (tau <= tol) {
-                  exitflag = true;
-                  break;
-                }
-              }
-            }
-          }
-          if (exitflag) break;
+    /**
+     * Search the NearestNeighbor using a lower bound on the distance to
+     * avoid distance calculations.
+     *
+     * @tparam boundfun_t the type of a function object which takes two
+     *   positions (of type \e pos_t) and returns a lower bound on the
+     *   distance between them.
+     * @param[in] pts the vector of points used for initialization.
+     * @param[in] dist the distance function object used for initialization.
+     * @param[in] bound the lower bound function object.
+     * @param[in] query the query point.
+     * @param[out] ind a vector of indices to the closest points found.
+     * @param[in] k the number of points to search for (default = 1).
+     * @param[in] maxdist only return points with distances of \e maxdist or
+     *   less from \e query (default is the maximum \e dist_t).
+     * @param[in] mindist only return points with distances of more than
+     *   \e mindist from \e query (default = &minus;1).
+     * @param[in] exhaustive whether to do an exhaustive search (default true).
+     * @param[in] tol the tolerance on the results (default 0).
+     * @param[in] maxcost the maximum number of distance calculations
+     *   (default is the maximum int).
+     * @param[out] cost if not a null pointer (the default), set to the number
+     *   of evaluations of \e dist made by this search (&minus;1 if no search
+     *   was needed).
+     * @return the distance to the closest point found (&minus;1 if no points
+     *   are found).
+     * @exception GeographicErr if \e pts has a different size from that used
+     *   to construct the object.
+     *
+     * This returns the same results as Search().  However before calculating
+     * the distance to a point, <i>bound</i>(<i>pts</i>[\e i], \e query) is
+     * evaluated.  If this shows that the point is further than the \e k
+     * closest points found so far (and, in the case of a vantage point, that
+     * the points in the subtree are also further away), the distance
+     * calculation is skipped.  This is worthwhile if \e bound is much cheaper
+     * than \e dist.  For geodesic distances, a suitable bound is the
+     * Euclidean distance between the points in geocentric coordinates
+     * (computed in advance).  The "cost" in the statistics only counts the
+     * evaluations of \e dist.
+     *
+     * \warning \e bound must never exceed \e dist; if it does, the results
+     * are undefined.
+     **********************************************************************/
+    template<class boundfun_t>
+    dist_t SearchBound(const std::vector<pos_t>& pts, const distfun_t& dist,
+                       const boundfun_t& bound,
+                       const pos_t& query,
+                       std::vector<int>& ind,
+                       int k = 1,
+                       dist_t maxdist = std::numeric_limits<dist_t>::max(),
+                       dist_t mindist = -1,
+                       bool exhaustive = true,
+                       dist_t tol = 0,
+                       int maxcost = std::numeric_limits<int>::max(),
+                       int* cost = nullptr) const {
+      if (_numpoints != int(pts.size()))
+          throw GeographicLib::GeographicErr("pts array has wrong size");
+      int c;
+      dist_t d = searchint(pts, dist, bound, nobatch(), query, ind, k,
+                           maxdist, mindist, exhaustive, tol, maxcost, c);
+      if (cost) *cost = c;
+      if (_stats && c >= 0) record(c);
+      return d;
+    }
 
-          if (current.index < 0) continue;
-          tau1 = tau - tol;
-          for (int l = 0; l < 2; ++l) {
-            if (current.data.child[l] >= 0 &&
-                dst + current.data.upper[l] >= mindist) {
-              if (dst < current.data.lower[l]) {
-                d = current.data.lower[l] - dst;
-                if (tau1 >= d)
-                  todo.push(std::make_pair(-d, current.data.child[l]));
-              } else if (dst > current.data.upper[l]) {
-                d = dst - current.data.upper[l];
-                if (tau1 >= d)
-                  todo.push(std::make_pair(-d, current.data.child[l]));
-              } else
-                todo.push(std::make_pair(dist_t(1), current.data.child[l]));
-            }
-          }
-        }
-        ++_k;
-        _c1 += c;
-        double omc = _mc;
-        _mc += (c - omc) / _k;
-        _sc += (c - omc) * (c - _mc);
-        if (c > _cmax) _cmax = c;
-        if (c < _cmin) _cmin = c;
-      }
+    /**
+     * Search the NearestNeighbor computing the distances to the points in a
+     * leaf with one call.
+     *
+     * @tparam batchfun_t the type of a function object which computes the
+     *   distances from a query point to several points.
+     * @param[in] pts the vector of points used for initialization.
+     * @param[in] dist the distance function object used for initialization.
+     * @param[in] distbatch the batch distance function object.
+     * @param[in] query the query point.
+     * @param[out] ind a vector of indices to the closest points found.
+     * @param[in] k the number of points to search for (default = 1).
+     * @param[in] maxdist only return points with distances of \e maxdist or
+     *   less from \e query (default is the maximum \e dist_t).
+     * @param[in] mindist only return points with distances of more than
+     *   \e mindist from \e query (default = &minus;1).
+     * @param[in] exhaustive whether to do an exhaustive search (default true).
+     * @param[in] tol the tolerance on the results (default 0).
+     * @param[in] maxcost the maximum number of distance calculations
+     *   (default is the maximum int).
+     * @param[out] cost if not a null pointer (the default), set to the number
+     *   of distances computed by this search (&minus;1 if no search was
+     *   needed).
+     * @return the distance to the closest point found (&minus;1 if no points
+     *   are found).
+     * @exception GeographicErr if \e pts has a different size from that used
+     *   to construct the object.
+     *
+     * This returns the same results as Search() provided that \e distbatch
+     * computes the same distances as \e dist.  The vantage points are
+     * handled with \e dist.  However, when the search reaches a leaf of the
+     * tree, the distances to all its points (up to \e bucket of them) are
+     * computed with a single call
+     * \code
+     *   distbatch(query, pts, index, n, d);
+     * \endcode
+     * which should set <i>d</i>[\e j] to the distance from \e query to
+     * <i>pts</i>[<i>index</i>[\e j]] for \e j in [0, \e n).  This lets
+     * the setup of the calculation for \e query be shared between the
+     * points, for example, with GeodesicOrigin:
+     * \code
+     *   struct GeodesicBatch {
+     *     void operator()(const pos& q, const std::vector<pos>& pts,
+     *                     const int index[], int n, double d[]) const {
+     *       GeodesicOrigin orig = Geodesic::WGS84().InverseFrom(q.lat, q.lon);
+     *       double lat2[10], lon2[10];
+     *       for (int j = 0; j < n; ++j) {
+     *         lat2[j] = pts[index[j]].lat; lon2[j] = pts[index[j]].lon;
+     *       }
+     *       orig.GenInverse(n, lat2, lon2, Geodesic::DISTANCE, d, nullptr,
+     *                       nullptr, nullptr, nullptr, nullptr, nullptr);
+     *     }
+     *   };
+     * \endcode
+     * (\e n never exceeds 2 + 4*sizeof(dist_t)/sizeof(int).)  Because the
+     * distances in a leaf are computed before the points are examined, an
+     * early exit from a leaf (when \e exhaustive is false or \e maxcost is
+     * reached) may leave a few computed distances unused; these are included
+     * in the cost.
+     **********************************************************************/
+    template<class batchfun_t>
+    dist_t SearchDistBatch(const std::vector<pos_t>& pts,
+                           const distfun_t& dist,
+                           const batchfun_t& distbatch,
+                           const pos_t& query,
+                           std::vector<int>& ind,
+                           int k = 1,
+                           dist_t maxdist =
+                           std::numeric_limits<dist_t>::max(),
+                           dist_t mindist = -1,
+                           bool exhaustive = true,
+                           dist_t tol = 0,
+                           int maxcost = std::numeric_limits<int>::max(),
+                           int* cost = nullptr) const {
+      if (_numpoints != int(pts.size()))
+          throw GeographicLib::GeographicErr("pts array has wrong size");
+      int c;
+      dist_t d = searchint(pts, dist, nobound(), distbatch, query, ind, k,
+                           maxdist, mindist, exhaustive, tol, maxcost, c);
+      if (cost) *cost = c;
+      if (_stats && c >= 0) record(c);
+      return d;
+    }
 
-      dist_t d = -1;
-      ind.resize(results.size());
+    /**
+     * Scratch space for searches.
+     *
+     * This holds the working storage for the versions of Search(),
+     * SearchBound(), and SearchDistBatch() which take a Workspace; it plays
+     * the role of a reusable query context.  Once it has grown to the size
+     * needed, repeated
+     * searches with the same Workspace don't allocate memory.  A Workspace
+     * may be used with any NearestNeighbor of the same type, but only by one
+     * thread at a time.
+     **********************************************************************/
+    class Workspace {
+    private:
+      friend class NearestNeighbor;
+      std::vector< std::pair<dist_t, int> > _results, _todo;
+      int _cost;
+    public:
+      Workspace() : _cost(-1) {}
+      /**
+       * @return the number of distance calculations made by the last search
+       *   using this Workspace (&minus;1 if no search was needed).
+       **********************************************************************/
+      int Cost() const { return _cost; }
+    };
 
-      for (int i = int(ind.size()); i--;) {
-        ind[i] = int(results.top().second);
-        if (i == 0) d = results.top().first;
-        results.pop();
-      }
+    /**
+     * Search the NearestNeighbor using caller supplied storage.
+     *
+     * @param[in] pts the vector of points used for initialization.
+     * @param[in] dist the distance function object used for initialization.
+     * @param[in] query the query point.
+     * @param[in,out] work the scratch space for the search.
+     * @param[out] ind an array of at least \e k elements; on return its
+     *   first \e num elements are the indices of the closest points found.
+     * @param[out] num the number of points found.
+     * @param[in] k the number of points to search for (default = 1).
+     * @param[in] maxdist only return points with distances of \e maxdist or
+     *   less from \e query (default is the maximum \e dist_t).
+     * @param[in] mindist only return points with distances of more than
+     *   \e mindist from \e query (default = &minus;1).
+     * @param[in] exhaustive whether to do an exhaustive search (default true).
+     * @param[in] tol the tolerance on the results (default 0).
+     * @param[in] maxcost the maximum number of distance calculations
+     *   (default is the maximum int).
+     * @param[out] dists if not a null pointer (the default), an array of at
+     *   least \e k elements; on return its first \e num elements are the
+     *   distances to the points in \e ind.
+     * @return the distance to the closest point found (&minus;1 if no points
+     *   are found).
+     * @exception GeographicErr if \e pts has a different size from that used
+     *   to construct the object.
+     *
+     * This returns the same results as Search().  However, the working
+     * storage is taken from \e work and the results are written to \e ind
+     * (and \e dists), so that, once \e work has been used for a previous
+     * search, there's no memory allocation.  The statistics are not updated
+     * (the cost of the search is given by Workspace::Cost()); thus this
+     * function modifies no state of the NearestNeighbor and may be called
+     * concurrently by several threads (e.g., from a parallel algorithm),
+     * each with its own Workspace, provided that \e dist allows concurrent
+     * calls.
+     **********************************************************************/
+    dist_t Search(const std::vector<pos_t>& pts, const distfun_t& dist,
+                  const pos_t& query, Workspace& work,
+                  int ind[], int& num,
+                  int k = 1,
+                  dist_t maxdist = std::numeric_limits<dist_t>::max(),
+                  dist_t mindist = -1,
+                  bool exhaustive = true,
+                  dist_t tol = 0,
+                  int maxcost = std::numeric_limits<int>::max(),
+                  dist_t dists[] = nullptr) const {
+      if (_numpoints != int(pts.size()))
+          throw GeographicLib::GeographicErr("pts array has wrong size");
+      dist_t d = searchint(pts, dist, nobound(), nobatch(), query, work, k,
+                           maxdist, mindist, exhaustive, tol, maxcost,
+                           work._cost);
+      results(work, ind, num, dists);
       return d;
+    }
 
+    /**
+     * Search the NearestNeighbor using a lower bound on the distance and
+     * caller supplied storage.
+     *
+     * @tparam boundfun_t the type of a function object which takes two
+     *   positions (of type \e pos_t) and returns a lower bound on the
+     *   distance between them.
+     * @param[in] pts the vector of points used for initialization.
+     * @param[in] dist the distance function object used for initialization.
+     * @param[in] bound the lower bound function object.
+     * @param[in] query the query point.
+     * @param[in,out] work the scratch space for the search.
+     * @param[out] ind an array of at least \e k elements; on return its
+     *   first \e num elements are the indices of the closest points found.
+     * @param[out] num the number of points found.
+     * @param[in] k the number of points to search for (default = 1).
+     * @param[in] maxdist only return points with distances of \e maxdist or
+     *   less from \e query (default is the maximum \e dist_t).
+     * @param[in] mindist only return points with distances of more than
+     *   \e mindist from \e query (default = &minus;1).
+     * @param[in] exhaustive whether to do an exhaustive search (default true).
+     * @param[in] tol the tolerance on the results (default 0).
+     * @param[in] maxcost the maximum number of distance calculations
+     *   (default is the maximum int).
+     * @param[out] dists if not a null pointer (the default), an array of at
+     *   least \e k elements; on return its first \e num elements are the
+     *   distances to the points in \e ind.
+     * @return the distance to the closest point found (&minus;1 if no points
+     *   are found).
+     * @exception GeographicErr if \e pts has a different size from that used
+     *   to construct the object.
+     *
+     * This combines SearchBound() with the allocation-free interface of the
+     * previous function.
+     **********************************************************************/
+    template<class boundfun_t>
+    dist_t SearchBound(const std::vector<pos_t>& pts, const distfun_t& dist,
+                       const boundfun_t& bound,
+                       const pos_t& query, Workspace& work,
+                       int ind[], int& num,
+                       int k = 1,
+                       dist_t maxdist = std::numeric_limits<dist_t>::max(),
+                       dist_t mindist = -1,
+                       bool exhaustive = true,
+                       dist_t tol = 0,
+                       int maxcost = std::numeric_limits<int>::max(),
+                       dist_t dists[] = nullptr) const {
+      if (_numpoints != int(pts.size()))
+          throw GeographicLib::GeographicErr("pts array has wrong size");
+      dist_t d = searchint(pts, dist, bound, nobatch(), query, work, k,
+                           maxdist, mindist, exhaustive, tol, maxcost,
+                           work._cost);
+      results(work, ind, num, dists);
+      return d;
     }
 
     /**
-     * @return the total number of points in the set.
+     * Search the NearestNeighbor using a batch distance function and caller
+     * supplied storage.
+     *
+     * @tparam batchfun_t the type of a function object which computes the
+     *   distances from a query point to several points.
+     * @param[in] pts the vector of points used for initialization.
+     * @param[in] dist the distance function object used for initialization.
+     * @param[in] distbatch the batch distance function object.
+     * @param[in] query the query point.
+     * @param[in,out] work the scratch space for the search.
+     * @param[out] ind an array of at least \e k elements; on return its
+     *   first \e num elements are the indices of the closest points found.
+     * @param[out] num the number of points found.
+     * @param[in] k the number of points to search for (default = 1).
+     * @param[in] maxdist only return points with distances of \e maxdist or
+     *   less from \e query (default is the maximum \e dist_t).
+     * @param[in] mindist only return points with distances of more than
+     *   \e mindist from \e query (default = &minus;1).
+     * @param[in] exhaustive whether to do an exhaustive search (default true).
+     * @param[in] tol the tolerance on the results (default 0).
+     * @param[in] maxcost the maximum number of distance calculations
+     *   (default is the maximum int).
+     * @param[out] dists if not a null pointer (the default), an array of at
+     *   least \e k elements; on return its first \e num elements are the
+     *   distances to the points in \e ind.
+     * @return the distance to the closest point found (&minus;1 if no points
+     *   are found).
+     * @exception GeographicErr if \e pts has a different size from that used
+     *   to construct the object.
+     *
+     * This combines SearchDistBatch() with the allocation-free interface.
+     **********************************************************************/
+    template<class batchfun_t>
+    dist_t SearchDistBatch(const std::vector<pos_t>& pts,
+                           const distfun_t& dist,
+                           const batchfun_t& distbatch,
+                           const pos_t& query, Workspace& work,
+                           int ind[], int& num,
+                           int k = 1,
+                           dist_t maxdist =
+                           std::numeric_limits<dist_t>::max(),
+                           dist_t mindist = -1,
+                           bool exhaustive = true,
+                           dist_t tol = 0,
+                           int maxcost = std::numeric_limits<int>::max(),
+                           dist_t dists[] = nullptr) const {
+      if (_numpoints != int(pts.size()))
+          throw GeographicLib::GeographicErr("pts array has wrong size");
+      dist_t d = searchint(pts, dist, nobound(), distbatch, query, work, k,
+                           maxdist, mindist, exhaustive, tol, maxcost,
+                           work._cost);
+      results(work, ind, num, dists);
+      return d;
+    }
+
+    /**
+     * Search the NearestNeighbor for several query points.
+     *
+     * @param[in] pts the vector of points used for initialization.
+     * @param[in] dist the distance function object used for initialization.
+     * @param[in] queries the query points.
+     * @param[out] ind a vector of vectors of indices to the closest points
+     *   found; <i>ind</i>[\e j] gives the results for
+     *   <i>queries</i>[\e j].
+     * @param[in] k the number of points to search for (default = 1).
+     * @param[in] maxdist only return points with distances of \e maxdist or
+     *   less from \e query (default is the maximum \e dist_t).
+     * @param[in] mindist only return points with distances of more than
+     *   \e mindist from \e query (default = &minus;1).
+     * @param[in] exhaustive whether to do an exhaustive search (default true).
+     * @param[in] tol the tolerance on the results (default 0).
+     * @param[in] maxcost the maximum number of distance calculations for
+     *   each query (default is the maximum int).
+     * @param[in] nthreads the number of threads to use (default 1).
+     * @param[out] cost if not a null pointer (the default), an array of
+     *   queries.size() elements which is set to the costs of the searches.
+     * @return a vector of the distances to the closest points found
+     *   (&minus;1 if no points are found).
+     * @exception GeographicErr if \e pts has a different size from that used
+     *   to construct the object.
+     *
+     * This is equivalent to calling Search() for each element of \e queries
+     * (in order) and the accumulated statistics, if enabled, are updated in
+     * the same way.
+     * With \e nthreads &gt; 1, the searches are carried out concurrently on
+     * \e nthreads threads; in this case, \e dist must allow concurrent
+     * calls to its function call operator.
+     **********************************************************************/
+    std::vector<dist_t>
+    SearchBatch(const std::vector<pos_t>& pts, const distfun_t& dist,
+                const std::vector<pos_t>& queries,
+                std::vector<std::vector<int>>& ind,
+                int k = 1,
+                dist_t maxdist = std::numeric_limits<dist_t>::max(),
+                dist_t mindist = -1,
+                bool exhaustive = true,
+                dist_t tol = 0,
+                int maxcost = std::numeric_limits<int>::max(),
+                int nthreads = 1, int cost[] = nullptr) const {
+      if (_numpoints != int(pts.size()))
+          throw GeographicLib::GeographicErr("pts array has wrong size");
+      const int nq = int(queries.size());
+      std::vector<dist_t> d(nq);
+      std::vector<int> c(nq);
+      ind.resize(nq);
+      // Each thread takes the next unclaimed query.  The statistics are
+      // recorded at the end in the order of the queries.
+      std::atomic<int> next(0);
+      nthreads = (std::max)(1, (std::min)(nthreads, nq));
+      auto work = [&](int) -> void {
+        // The scratch space is reused for the queries of a thread
+        Workspace ws;
+        for (int j; (j = next++) < nq;)
+          d[j] = searchint(pts, dist, nobound(), nobatch(), queries[j], ws,
+                           ind[j], k, maxdist, mindist, exhaustive, tol,
+                           maxcost, c[j]);
+      };
+      Executor::RunGuarded(nthreads, work, [&]() -> void { next = nq; });
+      if (cost)
+        std::copy(c.begin(), c.end(), cost);
+      if (_stats)
+        for (int j = 0; j < nq; ++j)
+          if (c[j] >= 0) record(c[j]);
+      return d;
+    }
+
+    /**
+     * @return the total number of points in the set (including any which
+     *   have been removed).
      **********************************************************************/
     int NumPoints() const { return _numpoints; }
 
+    /**
+     * \brief The memory used by a NearestNeighbor
+     *
+     * The sizes are in bytes.  The memory for the points themselves, which
+     * are held by the caller, is not counted.
+     **********************************************************************/
+    struct Memory {
+      /**
+       * The nodes of the tree.
+       **********************************************************************/
+      size_t tree;
+      /**
+       * The flags for the removed points.
+       **********************************************************************/
+      size_t dead;
+      /**
+       * The size of the tree held in memory supplied to Map() (which is not
+       * owned by the NearestNeighbor).
+       **********************************************************************/
+      size_t mapped;
+      /**
+       * Constructor, all sizes are zero.
+       **********************************************************************/
+      Memory() : tree(0), dead(0), mapped(0) {}
+      /**
+       * @return the memory allocated by the NearestNeighbor, \e tree + \e
+       *   dead (this excludes \e mapped).
+       **********************************************************************/
+      size_t Total() const { return tree + dead; }
+    };
+
+    /**
+     * @return the memory used by the NearestNeighbor.
+     **********************************************************************/
+    Memory MemoryUsage() const {
+      Memory m;
+      m.tree = _tree.capacity() * sizeof(Node);
+      m.dead = _dead.capacity() * sizeof(char);
+      m.mapped = _map ? size_t(_mapsize) * sizeof(Node) : 0;
+      return m;
+    }
+
     /**
      * Write the object to an I/O stream.
      *
@@ -371,6 +884,7 @@ namespace GeographicLib {
      * GEOGRAPHICLIB_HAVE_BOOST_SERIALIZATION macro be defined.
      **********************************************************************/
     void Save(std::ostream& os, bool bin = true) const {
+      checkdead();
       int realspec = std::numeric_limits<dist_t>::digits *
         (std::numeric_limits<dist_t>::is_integer ? -1 : 1);
       if (bin) {
@@ -381,11 +895,11 @@ namespace GeographicLib {
         buf[1] = realspec;
         buf[2] = _bucket;
         buf[3] = _numpoints;
-        buf[4] = int(_tree.size());
+        buf[4] = treesize();
         buf[5] = _cost;
         os.write(reinterpret_cast<const char *>(buf), 6 * sizeof(int));
-        for (int i = 0; i < int(_tree.size()); ++i) {
-          const Node& node = _tree[i];
+        for (int i = 0; i < treesize(); ++i) {
+          const Node& node = nodes()[i];
           os.write(reinterpret_cast<const char *>(&node.index), sizeof(int));
           if (node.index >= 0) {
             os.write(reinterpret_cast<const char *>(node.data.lower),
@@ -410,9 +924,9 @@ namespace GeographicLib {
           ostring.precision(prec);
         }
         ostring << version << " " << realspec << " " << _bucket << " "
-                << _numpoints << " " << _tree.size() << " " << _cost;
-        for (int i = 0; i < int(_tree.size()); ++i) {
-          const Node& node = _tree[i];
+                << _numpoints << " " << treesize() << " " << _cost;
+        for (int i = 0; i < treesize(); ++i) {
+          const Node& node = nodes()[i];
           ostring << "\n" << node.index;
           if (node.index >= 0) {
             for (int l = 0; l < 2; ++l)
@@ -522,6 +1036,8 @@ namespace GeographicLib {
         tree.push_back(node);
       }
       _tree.swap(tree);
+      _map = nullptr; _mapsize = 0;
+      _dead.clear(); _ndead = _ninserted = 0;
       _numpoints = numpoints;
       _bucket = bucket;
       _mc = _sc = 0;
@@ -529,6 +1045,100 @@ namespace GeographicLib {
       _cmin = std::numeric_limits<int>::max();
     }
 
+    /**
+     * Write the object to an I/O stream in a form which can be used in place
+     * by Map().
+     *
+     * @param[in,out] os the stream to write to.
+     *
+     * The data consists of a header of 64 bytes followed by an image of the
+     * nodes of the tree.  As with the binary mode of Save(), the counters
+     * tracking the statistics of searches are not saved and the format is \e
+     * not portable.
+     **********************************************************************/
+    void SaveMappable(std::ostream& os) const {
+      checkdead();
+      char head[mapheader];
+      std::memset(head, 0, mapheader);
+      std::memcpy(head, "NearestNeighborM", 16);
+      int buf[7];
+      buf[0] = version;
+      buf[1] = std::numeric_limits<dist_t>::digits *
+        (std::numeric_limits<dist_t>::is_integer ? -1 : 1);
+      buf[2] = _bucket;
+      buf[3] = _numpoints;
+      buf[4] = treesize();
+      buf[5] = _cost;
+      buf[6] = int(sizeof(Node));
+      std::memcpy(head + 16, buf, 7 * sizeof(int));
+      os.write(head, mapheader);
+      os.write(reinterpret_cast<const char *>(nodes()),
+               std::streamsize(treesize()) * sizeof(Node));
+    }
+
+    /**
+     * Use the tree held in memory in the format written by SaveMappable().
+     *
+     * @param[in] data a pointer to the start of the data.
+     * @param[in] size the size of the data in bytes.
+     * @param[in] check whether to check all the nodes of the tree (default
+     *   true).
+     * @exception GeographicErr if the data is illegal.
+     *
+     * Typically \e data is obtained by mapping a file written by
+     * SaveMappable() into memory, e.g., with <code>mmap</code> on POSIX
+     * systems or <code>MapViewOfFile</code> on Windows.  The tree is not
+     * copied; so many processes can share the same read-only mapping and the
+     * startup cost is small.  \e data must be suitably aligned (as is the
+     * start of a mapped file) and must remain valid until the object is
+     * re-initialized or destroyed.  Copies of the object refer to the same
+     * data.  If \e check is false, only the header is checked and the pages
+     * of the data are only read when they are needed by Search(); use this
+     * only for trusted data.  The counters tracking the statistics of
+     * searches are reset by this operation.  If an exception is thrown, the
+     * state of the NearestNeighbor is unchanged.
+     *
+     * \warning The same arguments \e pts and \e dist used for
+     * initialization must be provided to the Search() function.
+     **********************************************************************/
+    void Map(const void* data, std::size_t size, bool check = true) {
+      const char* head = static_cast<const char*>(data);
+      if (!( size >= std::size_t(mapheader) &&
+             std::memcmp(head, "NearestNeighborM", 16) == 0 ))
+        throw GeographicLib::GeographicErr("Bad ID");
+      if (!( reinterpret_cast<std::size_t>(head) %
+             std::alignment_of<Node>::value == 0 ))
+        throw GeographicLib::GeographicErr("Data is not aligned");
+      int buf[7];
+      std::memcpy(buf, head + 16, 7 * sizeof(int));
+      if (!( buf[0] == version ))
+        throw GeographicLib::GeographicErr("Incompatible version");
+      if (!( buf[1] == std::numeric_limits<dist_t>::digits *
+             (std::numeric_limits<dist_t>::is_integer ? -1 : 1) ))
+        throw GeographicLib::GeographicErr("Different dist_t types");
+      if (!( 0 <= buf[2] && buf[2] <= maxbucket ))
+        throw GeographicLib::GeographicErr("Bad bucket size");
+      if (!( 0 <= buf[4] && buf[4] <= buf[3] ))
+        throw
+          GeographicLib::GeographicErr("Bad number of points or tree size");
+      if (!( buf[6] == int(sizeof(Node)) &&
+             size - mapheader >= std::size_t(buf[4]) * sizeof(Node) ))
+        throw GeographicLib::GeographicErr("Bad data size");
+      const Node* tree = reinterpret_cast<const Node*>(head + mapheader);
+      if (check) {
+        for (int i = 0; i < buf[4]; ++i)
+          tree[i].Check(buf[3], buf[4], buf[2]);
+      }
+      std::vector<Node>().swap(_tree);
+      _map = tree; _mapsize = buf[4];
+      _dead.clear(); _ndead = _ninserted = 0;
+      _numpoints = buf[3];
+      _bucket = buf[2];
+      _mc = _sc = 0;
+      _cost = buf[5]; _c1 = _k = _cmax = 0;
+      _cmin = std::numeric_limits<int>::max();
+    }
+
     /**
      * Write the object to stream \e os as text.
      *
@@ -561,12 +1171,18 @@ namespace GeographicLib {
       std::swap(_bucket, t._bucket);
       std::swap(_cost, t._cost);
       _tree.swap(t._tree);
+      std::swap(_map, t._map);
+      std::swap(_mapsize, t._mapsize);
+      _dead.swap(t._dead);
+      std::swap(_ndead, t._ndead);
+      std::swap(_ninserted, t._ninserted);
       std::swap(_mc, t._mc);
       std::swap(_sc, t._sc);
       std::swap(_c1, t._c1);
       std::swap(_k, t._k);
       std::swap(_cmin, t._cmin);
       std::swap(_cmax, t._cmax);
+      std::swap(_stats, t._stats);
     }
 
     /**
@@ -580,8 +1196,9 @@ namespace GeographicLib {
      * @param[out] mean the mean cost of a Search().
      * @param[out] sd the standard deviation in the cost of a Search().
      *
-     * Here "cost" measures the number of distance calculations needed.  Note
-     * that the accumulation of statistics is \e not thread safe.
+     * Here "cost" measures the number of distance calculations needed.  The
+     * statistics are only accumulated if they have been enabled with
+     * EnableStatistics().
      **********************************************************************/
     void Statistics(int& setupcost, int& numsearches, int& searchcost,
                     int& mincost, int& maxcost,
@@ -601,6 +1218,29 @@ namespace GeographicLib {
       _cmin = std::numeric_limits<int>::max();
     }
 
+    /**
+     * Enable or disable the accumulation of statistics.
+     *
+     * @param[in] enable whether Search(), SearchBound(), and SearchBatch()
+     *   should update the statistics (default true).
+     *
+     * The statistics are disabled initially so that the searches, which are
+     * const member functions, modify no state of the NearestNeighbor; several
+     * threads may then search the same object concurrently (provided that \e
+     * dist allows concurrent calls) without contending for the counters.  The
+     * accumulation of statistics is \e not thread safe; however SearchBatch()
+     * only updates the statistics after its concurrent searches are complete.
+     * The cost of an individual search is available via the \e cost argument
+     * of the search functions regardless of this setting.  This setting is
+     * not saved with the object.
+     **********************************************************************/
+    void EnableStatistics(bool enable = true) { _stats = enable; }
+
+    /**
+     * @return whether the accumulation of statistics is enabled.
+     **********************************************************************/
+    bool StatisticsEnabled() const { return _stats; }
+
   private:
     // Package up a dist_t and an int.  We will want to sort on the dist_t so
     // put it first.
@@ -695,12 +1335,16 @@ namespace GeographicLib {
       // Need to use version1, otherwise load error in debug mode on Linux:
       // undefined reference to GeographicLib::NearestNeighbor<...>::version.
       int version1 = version;
+      checkdead();
+      // A tree supplied to Map() needs to be copied.
+      std::vector<Node> tree;
+      if (_map) tree.assign(_map, _map + _mapsize);
       ar & boost::serialization::make_nvp("version", version1)
         & boost::serialization::make_nvp("realspec", realspec)
         & boost::serialization::make_nvp("bucket", _bucket)
         & boost::serialization::make_nvp("numpoints", _numpoints)
         & boost::serialization::make_nvp("cost", _cost)
-        & boost::serialization::make_nvp("tree", _tree);
+        & boost::serialization::make_nvp("tree", _map ? tree : _tree);
     }
     template<class Archive> void load(Archive& ar, const unsigned) {
       int version1, realspec, bucket, numpoints, cost;
@@ -724,6 +1368,8 @@ namespace GeographicLib {
       for (int i = 0; i < int(tree.size()); ++i)
         tree[i].Check(numpoints, int(tree.size()), bucket);
       _tree.swap(tree);
+      _map = nullptr; _mapsize = 0;
+      _dead.clear(); _ndead = _ninserted = 0;
       _numpoints = numpoints;
       _bucket = bucket;
       _mc = _sc = 0;
@@ -736,14 +1382,333 @@ namespace GeographicLib {
 #endif
 
     int _numpoints, _bucket, _cost;
+    // The nodes are stored in the order in which init creates them, i.e.,
+    // depth-first with the children before their parent, and the root is the
+    // last node.  So every subtree occupies a contiguous block of _tree and
+    // the nodes visited in the lower levels of a search are close together.
+    // (Breadth-first and van Emde Boas layouts were tried; neither improved
+    // the speed of searches, which is limited by the access to pts.)
     std::vector<Node> _tree;
+    // If not null, the tree is held in memory supplied to Map()
+    const Node* _map;
+    int _mapsize;
+    // Points which have been removed from the set (empty if none)
+    std::vector<char> _dead;
+    int _ndead, _ninserted;
+    void checkdead() const {
+      if (_ndead)
+        throw GeographicLib::GeographicErr
+          ("Points have been removed; call Rebuild before saving");
+    }
+    const Node* nodes() const { return _map ? _map : _tree.data(); }
+    int treesize() const { return _map ? _mapsize : int(_tree.size()); }
+    // The size of the header for SaveMappable()
+    static const int mapheader = 64;
     // Counters to track stastistics on the cost of searches
     mutable double _mc, _sc;
     mutable int _c1, _k, _cmin, _cmax;
+    bool _stats;                // Whether to accumulate the statistics
+
+    // The trivial lower bound on the distance
+    struct nobound {
+      dist_t operator()(const pos_t&, const pos_t&) const { return 0; }
+    };
+
+    // The absence of a batch distance function
+    struct nobatch {
+      void operator()(const pos_t&, const std::vector<pos_t>&,
+                      const int[], int, dist_t[]) const {}
+    };
+
+    // The search without updating the statistics; c is set to the cost, or
+    // -1 if no search was needed.  bound gives a lower bound on dist.  If
+    // batchfun_t isn't nobatch, batch is used to compute the distances to
+    // the points in a leaf (and bound is not used).  The results are left in
+    // work._results sorted by distance.
+    template<class boundfun_t, class batchfun_t>
+    dist_t searchint(const std::vector<pos_t>& pts, const distfun_t& dist,
+                     const boundfun_t& bound, const batchfun_t& batch,
+                     const pos_t& query, Workspace& work, int k,
+                     dist_t maxdist, dist_t mindist, bool exhaustive,
+                     dist_t tol, int maxcost, int& c) const {
+      c = -1;
+      // results and todo are maintained as heaps in the same way as by
+      // std::priority_queue.
+      std::vector<item>& results = work._results;
+      std::vector<item>& todo = work._todo;
+      results.clear();
+      todo.clear();
+      if (_numpoints > 0 && k > 0 && maxdist > mindist) {
+        // distance to the kth closest point so far
+        dist_t tau = maxdist;
+        // first is negative of how far query is outside boundary of node
+        // +1 if on boundary or inside
+        // second is node index
+        const Node* tree = nodes();
+        const bool batched = !std::is_same<batchfun_t, nobatch>::value;
+        push(todo, std::make_pair(dist_t(1), treesize() - 1));
+        c = 0;
+        while (!todo.empty()) {
+          int n = todo.front().second;
+          dist_t d = -todo.front().first;
+          pop(todo);
+          dist_t tau1 = tau - tol;
+          // compare tau and d again since tau may have become smaller.
+          if (!( n >= 0 && tau1 >= d )) continue;
+          const Node& current = tree[n];
+          dist_t dst = 0;   // to suppress warning about uninitialized variable
+          bool exitflag = false, skipnode = false, leaf = current.index < 0;
+          // With a batch distance function, compute the distances to the live
+          // points in a leaf with one call; these are then consumed in order
+          // by the loop below.  The points are limited by maxcost and the
+          // distances not consumed because of an early exit are included in
+          // the cost.  With nobound, lb > tau only if tau < 0 in which case
+          // no distances are needed.
+          int bidx[maxbucket], nb = 0, jb = 0;
+          dist_t bdst[maxbucket];
+          if (batched && leaf && !(tau < 0)) {
+            for (int i = 0; i < _bucket && nb < maxcost - c; ++i) {
+              int index = current.leaves[i];
+              if (index < 0) break;
+              if (_dead.empty() || !_dead[index]) bidx[nb++] = index;
+            }
+            if (nb) batch(query, pts, bidx, nb, bdst);
+          }
+          for (int i = 0; i < (leaf ? _bucket : 1); ++i) {
+            int index = leaf ? current.leaves[i] : current.index;
+            if (index < 0) break;
+            // If the lower bound shows that the point isn't wanted, skip the
+            // distance calculation.  In the case of a vantage point, this is
+            // only possible if the children can also be skipped.
+            dist_t lb = bound(pts[index], query);
+            if (lb > tau &&
+                (leaf || lb - current.data.upper[1] > tau - tol)) {
+              skipnode = !leaf;
+              continue;
+            }
+            bool dead = !_dead.empty() && _dead[index];
+            if (leaf && dead) continue;
+            dst = batched && leaf ? bdst[jb++] : dist(pts[index], query);
+            ++c;
+
+            if (!dead && dst > mindist && dst <= tau) {
+              if (int(results.size()) == k) pop(results);
+              push(results, std::make_pair(dst, index));
+              if (int(results.size()) == k) {
+                if (exhaustive)
+                  tau = results.front().first;
+                else {
+                  exitflag = true;
+                  break;
+                }
+                if (tau <= tol) {
+                  exitflag = true;
+                  break;
+                }
+              }
+            }
+            if (c >= maxcost) {
+              exitflag = true;
+              break;
+            }
+          }
+          c += nb - jb;
+          if (exitflag) break;
+
+          if (leaf || skipnode) continue;
+          tau1 = tau - tol;
+          for (int l = 0; l < 2; ++l) {
+            if (current.data.child[l] >= 0 &&
+                dst + current.data.upper[l] >= mindist) {
+              if (dst < current.data.lower[l]) {
+                d = current.data.lower[l] - dst;
+                if (tau1 >= d)
+                  push(todo, std::make_pair(-d, current.data.child[l]));
+              } else if (dst > current.data.upper[l]) {
+                d = dst - current.data.upper[l];
+                if (tau1 >= d)
+                  push(todo, std::make_pair(-d, current.data.child[l]));
+              } else
+                push(todo, std::make_pair(dist_t(1), current.data.child[l]));
+            }
+          }
+        }
+      }
+
+      // Popping the heap would give the results in decreasing order.
+      std::sort_heap(results.begin(), results.end());
+      return results.empty() ? dist_t(-1) : results.front().first;
+    }
+
+    // As above, returning the indices of the results in ind.
+    template<class boundfun_t, class batchfun_t>
+    dist_t searchint(const std::vector<pos_t>& pts, const distfun_t& dist,
+                     const boundfun_t& bound, const batchfun_t& batch,
+                     const pos_t& query, std::vector<int>& ind, int k,
+                     dist_t maxdist, dist_t mindist, bool exhaustive,
+                     dist_t tol, int maxcost, int& c) const {
+      Workspace work;
+      return searchint(pts, dist, bound, batch, query, work, ind, k,
+                       maxdist, mindist, exhaustive, tol, maxcost, c);
+    }
+
+    template<class boundfun_t, class batchfun_t>
+    dist_t searchint(const std::vector<pos_t>& pts, const distfun_t& dist,
+                     const boundfun_t& bound, const batchfun_t& batch,
+                     const pos_t& query, Workspace& work,
+                     std::vector<int>& ind, int k,
+                     dist_t maxdist, dist_t mindist, bool exhaustive,
+                     dist_t tol, int maxcost, int& c) const {
+      dist_t d = searchint(pts, dist, bound, batch, query, work, k,
+                           maxdist, mindist, exhaustive, tol, maxcost, c);
+      ind.resize(work._results.size());
+      for (size_t i = 0; i < ind.size(); ++i)
+        ind[i] = work._results[i].second;
+      return d;
+    }
+
+    // Copy the results of a search out of work
+    static void results(const Workspace& work, int ind[], int& num,
+                        dist_t dists[]) {
+      num = int(work._results.size());
+      for (int i = 0; i < num; ++i) {
+        ind[i] = work._results[i].second;
+        if (dists) dists[i] = work._results[i].first;
+      }
+    }
+
+    static void push(std::vector<item>& heap, const item& x) {
+      heap.push_back(x);
+      std::push_heap(heap.begin(), heap.end());
+    }
+    static void pop(std::vector<item>& heap) {
+      std::pop_heap(heap.begin(), heap.end());
+      heap.pop_back();
+    }
+
+
+    // Record the cost of a search in the statistics
+    void record(int c) const {
+      ++_k;
+      _c1 += c;
+      double omc = _mc;
+      _mc += (c - omc) / _k;
+      _sc += (c - omc) * (c - _mc);
+      if (c > _cmax) _cmax = c;
+      if (c < _cmin) _cmin = c;
+    }
+
+    // Build the tree for the points in ids.
+    void build(const std::vector<pos_t>& pts, const distfun_t& dist,
+               int bucket, int nthreads, std::vector<item>& ids) {
+      static_assert(std::numeric_limits<dist_t>::is_signed,
+                    "dist_t must be a signed type");
+      if (!( 0 <= bucket && bucket <= maxbucket ))
+        throw GeographicLib::GeographicErr
+          ("bucket must lie in [0, 2 + 4*sizeof(dist_t)/sizeof(int)]");
+      GeographicLib::Tracer::Span span("NearestNeighbor::build");
+      int cost = 0;
+      std::vector<Node> tree;
+      init(pts, dist, bucket, tree, ids, cost,
+           0, int(ids.size()), int(ids.size()/2), nthreads);
+      _tree.swap(tree);
+      _map = nullptr; _mapsize = 0;
+      _dead.clear(); _ndead = _ninserted = 0;
+      _numpoints = int(pts.size());
+      _bucket = bucket;
+      _mc = _sc = 0;
+      _cost = cost; _c1 = _k = _cmax = 0;
+      _cmin = std::numeric_limits<int>::max();
+    }
+
+    // The points in the tree which have not been removed
+    std::vector<item> members() const {
+      std::vector<item> ids;
+      const Node* tree = nodes();
+      for (int n = 0; n < treesize(); ++n) {
+        const Node& node = tree[n];
+        for (int j = 0; j < (node.index < 0 ? _bucket : 1); ++j) {
+          int k = node.index < 0 ? node.leaves[j] : node.index;
+          if (k >= 0 && (_dead.empty() || !_dead[k]))
+            ids.push_back(std::make_pair(dist_t(0), k));
+        }
+      }
+      // Use the original order, so that the tree is reproducible
+      std::sort(ids.begin(), ids.end());
+      return ids;
+    }
+
+    // Insert point i into a tree whose root is not a leaf.  New nodes are
+    // placed just before the root, which remains the last node.
+    void insert(const std::vector<pos_t>& pts, const distfun_t& dist, int i) {
+      int n = int(_tree.size()) - 1;
+      while (_tree[n].index >= 0) {
+        dist_t d = dist(pts[_tree[n].index], pts[i]);
+        ++_cost;
+        // Maintain lower[0] <= upper[0] <= lower[1] <= upper[1]
+        int l = d < _tree[n].data.lower[1] ? 0 : 1,
+          kid = _tree[n].data.child[l];
+        if (kid < 0) {
+          Node leaf;
+          if (_bucket == 0)
+            leaf.index = i;
+          else {
+            leaf.index = -1;
+            leaf.leaves[0] = i;
+            for (int j = 1; j < _bucket; ++j)
+              leaf.leaves[j] = -1;
+            for (int j = _bucket; j < maxbucket; ++j)
+              leaf.leaves[j] = 0;
+          }
+          bool root = n == int(_tree.size()) - 1;
+          _tree.push_back(_tree.back());
+          _tree[_tree.size() - 2] = leaf;
+          if (root) ++n;
+          _tree[n].data.child[l] = int(_tree.size()) - 2;
+          _tree[n].data.lower[l] = _tree[n].data.upper[l] = d;
+          return;
+        }
+        _tree[n].data.lower[l] = (std::min)(_tree[n].data.lower[l], d);
+        _tree[n].data.upper[l] = (std::max)(_tree[n].data.upper[l], d);
+        n = kid;
+      }
+      for (int j = 0; j < _bucket; ++j)
+        if (_tree[n].leaves[j] < 0) {
+          _tree[n].leaves[j] = i;
+          return;
+        }
+      // The bucket is full; replace it by a subtree for its points and i
+      // (dropping any removed points).
+      std::vector<item> ids(1, std::make_pair(dist_t(0), i));
+      for (int j = 0; j < _bucket; ++j) {
+        int k = _tree[n].leaves[j];
+        if (_dead.empty() || !_dead[k])
+          ids.push_back(std::make_pair(dist_t(0), k));
+      }
+      std::vector<Node> sub;
+      init(pts, dist, _bucket, sub, ids, _cost,
+           0, int(ids.size()), int(ids.size()/2), 1);
+      // The root of sub (its last node) goes into the slot for the leaf;
+      // the rest of sub goes before the root of the tree.
+      Node root = _tree.back();
+      _tree.pop_back();
+      int offset = int(_tree.size());
+      for (int j = 0; j < int(sub.size()); ++j) {
+        Node& node = sub[j];
+        if (node.index >= 0)
+          for (int l = 0; l < 2; ++l)
+            if (node.data.child[l] >= 0) node.data.child[l] += offset;
+        if (j + 1 < int(sub.size()))
+          _tree.push_back(node);
+        else
+          _tree[n] = node;
+      }
+      _tree.push_back(root);
+    }
 
     int init(const std::vector<pos_t>& pts, const distfun_t& dist, int bucket,
              std::vector<Node>& tree, std::vector<item>& ids, int& cost,
-             int l, int u, int vp) {
+             int l, int u, int vp, int nthreads) {
 
       if (u == l)
         return -1;
@@ -766,6 +1731,7 @@ namespace GeographicLib {
                          ids.begin() + m,
                          ids.begin() + u);
         node.index = ids[l].second;
+        int vp0 = -1;
         if (m > l + 1) {        // node.child[0] is possibly empty
           typename std::vector<item>::iterator
             t = std::min_element(ids.begin() + l + 1, ids.begin() + m);
@@ -774,16 +1740,40 @@ namespace GeographicLib {
           node.data.upper[0] = t->first;
           // Use point with max distance as vantage point; this point act as a
           // "corner" point and leads to a good partition.
-          node.data.child[0] = init(pts, dist, bucket, tree, ids, cost,
-                                    l + 1, m, int(t - ids.begin()));
+          vp0 = int(t - ids.begin());
         }
         typename std::vector<item>::iterator
           t = std::max_element(ids.begin() + m, ids.begin() + u);
         node.data.lower[1] = ids[m].first;
         node.data.upper[1] = t->first;
         // Use point with max distance as vantage point here too
-        node.data.child[1] = init(pts, dist, bucket, tree, ids, cost,
-                                  m, u, int(t - ids.begin()));
+        int vp1 = int(t - ids.begin());
+        if (nthreads > 1 && u - l >= minsplit) {
+          // The subtrees only involve ids[l+1:m) and ids[m:u), so they can be
+          // built concurrently, each in its own vector.  These are then
+          // appended to tree in the same order as in the serial case.
+          std::vector<Node> tree0, tree1;
+          int cost0 = 0, cost1 = 0, nthreads0 = nthreads / 2;
+          auto subtree = [&](int i) -> void {
+            if (i == 0) {
+              if (vp0 >= 0)
+                init(pts, dist, bucket, tree0, ids, cost0,
+                     l + 1, m, vp0, nthreads0);
+            } else
+              init(pts, dist, bucket, tree1, ids, cost1,
+                   m, u, vp1, nthreads - nthreads0);
+          };
+          Executor::RunGuarded(2, subtree, []() -> void {});
+          node.data.child[0] = splice(tree, tree0);
+          node.data.child[1] = splice(tree, tree1);
+          cost += cost0 + cost1;
+        } else {
+          if (vp0 >= 0)
+            node.data.child[0] = init(pts, dist, bucket, tree, ids, cost,
+                                      l + 1, m, vp0, 1);
+          node.data.child[1] = init(pts, dist, bucket, tree, ids, cost,
+                                    m, u, vp1, 1);
+        }
       } else {
         if (bucket == 0)
           node.index = ids[l].second;
@@ -805,6 +1795,19 @@ namespace GeographicLib {
       return int(tree.size()) - 1;
     }
 
+    // Append a subtree to tree, adjusting its child pointers, and return the
+    // index of its root (the last node), or -1 if it is empty.
+    static int splice(std::vector<Node>& tree, const std::vector<Node>& sub) {
+      int offset = int(tree.size());
+      for (Node node : sub) {
+        if (node.index >= 0)
+          for (int l = 0; l < 2; ++l)
+            if (node.data.child[l] >= 0) node.data.child[l] += offset;
+        tree.push_back(node);
+      }
+      return sub.empty() ? -1 : int(tree.size()) - 1;
+    }
+
   };
 
 } // namespace GeographicLib
@@ -169,6 +169,22 @@ namespace GeographicLib {
      **********************************************************************/
     Math::real SurfaceGravity(real lat) const;
 
+    /**
+     * Evaluate the gravity on the surface of the ellipsoid at several
+     * latitudes.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat the geographic latitudes (degrees).
+     * @param[out] gamma the accelerations due to gravity, positive downwards
+     *   (m s<sup>&minus;2</sup>).
+     *
+     * This gives the same results as calling SurfaceGravity(real) const for
+     * each point.  A run of equal latitudes (as in the rows of a grid) is
+     * only evaluated once.  The output array may coincide with the input
+     * array.
+     **********************************************************************/
+    void SurfaceGravity(size_t n, const real lat[], real gamma[]) const;
+
     /**
      * Evaluate the gravity at an arbitrary point above (or below) the
      * ellipsoid.
@@ -191,6 +207,28 @@ namespace GeographicLib {
     Math::real Gravity(real lat, real h, real& gammay, real& gammaz)
       const;
 
+    /**
+     * Evaluate the gravity at several points above (or below) the ellipsoid.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat the geographic latitudes (degrees).
+     * @param[in] h the heights above the ellipsoid (meters).
+     * @param[out] U the normal potentials
+     *   (m<sup>2</sup> s<sup>&minus;2</sup>).
+     * @param[out] gammay the northerly components of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] gammaz the upward components of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     *
+     * This gives the same results as calling Gravity(real, real, real&,
+     * real&) const for each point.  Since the normal field is independent of
+     * the longitude, the points of a grid or a profile often share their
+     * latitude and height; a run of points with equal \e lat and \e h is only
+     * evaluated once.  The output arrays may coincide with the input arrays.
+     **********************************************************************/
+    void Gravity(size_t n, const real lat[], const real h[],
+                 real U[], real gammay[], real gammaz[]) const;
+
     /**
      * Evaluate the components of the acceleration due to gravity and the
      * centrifugal acceleration in geocentric coordinates.
@@ -343,12 +381,14 @@ namespace GeographicLib {
     ///@}
 
     /**
-     * A global instantiation of NormalGravity for the WGS84 ellipsoid.
+     * A global instantiation of NormalGravity for the WGS84 ellipsoid.  See
+     * Geodesic::WGS84() for when this is constructed.
      **********************************************************************/
     static const NormalGravity& WGS84();
 
     /**
-     * A global instantiation of NormalGravity for the GRS80 ellipsoid.
+     * A global instantiation of NormalGravity for the GRS80 ellipsoid.  See
+     * Geodesic::WGS84() for when this is constructed.
      **********************************************************************/
     static const NormalGravity& GRS80();
 
@@ -64,6 +64,13 @@ namespace GeographicLib {
     OSGB() = delete;            // Disable constructor
   public:
 
+    /**
+     * The size of a char array which can hold any grid reference produced by
+     * the char array versions of GridReference, including the terminating
+     * null.
+     **********************************************************************/
+    enum { MAXBUF = 2 + 2 * maxprec_ + 1 };
+
     /**
      * Forward projection, from geographic to OSGB coordinates.
      *
@@ -120,6 +127,54 @@ namespace GeographicLib {
       Reverse(x, y, lat, lon, gamma, k);
     }
 
+    /**
+     * Forward projection of many points from geographic to OSGB.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of \e n latitudes (degrees).
+     * @param[in] lon array of \e n longitudes (degrees).
+     * @param[out] x array of \e n eastings (meters).
+     * @param[out] y array of \e n northings (meters).
+     * @param[out] gamma array of \e n meridian convergences (degrees); this
+     *   may be a null pointer.
+     * @param[out] k array of \e n scales; this may be a null pointer.
+     * @param[in] nthreads the number of threads to use (default 1).
+     *
+     * Element \e i of the output arrays is set to the result of
+     * OSGB::Forward applied to element \e i of the input arrays; the results
+     * are bitwise identical.  The points are projected by the array version
+     * of TransverseMercator::Forward.  If \e gamma and \e k are both null
+     * pointers, their calculation is skipped.  The input and output arrays
+     * must not overlap.
+     **********************************************************************/
+    static void Forward(size_t n, const real lat[], const real lon[],
+                        real x[], real y[], real gamma[] = nullptr,
+                        real k[] = nullptr, int nthreads = 1);
+
+    /**
+     * Reverse projection of many points from OSGB to geographic.
+     *
+     * @param[in] n the number of points.
+     * @param[in] x array of \e n eastings (meters).
+     * @param[in] y array of \e n northings (meters).
+     * @param[out] lat array of \e n latitudes (degrees).
+     * @param[out] lon array of \e n longitudes (degrees).
+     * @param[out] gamma array of \e n meridian convergences (degrees); this
+     *   may be a null pointer.
+     * @param[out] k array of \e n scales; this may be a null pointer.
+     * @param[in] nthreads the number of threads to use (default 1).
+     *
+     * Element \e i of the output arrays is set to the result of
+     * OSGB::Reverse applied to element \e i of the input arrays; the results
+     * are bitwise identical.  The false origin is removed from the
+     * coordinates in chunks of 65536 points which are then passed to the
+     * array version of TransverseMercator::Reverse.  The input and output
+     * arrays must not overlap.
+     **********************************************************************/
+    static void Reverse(size_t n, const real x[], const real y[],
+                        real lat[], real lon[], real gamma[] = nullptr,
+                        real k[] = nullptr, int nthreads = 1);
+
     /**
      * Convert OSGB coordinates to a grid reference.
      *
@@ -151,6 +206,43 @@ namespace GeographicLib {
      **********************************************************************/
     static void GridReference(real x, real y, int prec, std::string& gridref);
 
+    /**
+     * Convert OSGB coordinates to a grid reference in a char array.
+     *
+     * @param[in] x easting of point (meters).
+     * @param[in] y northing of point (meters).
+     * @param[in] prec precision relative to 100 km.
+     * @param[out] gridref a char array of at least OSGB::MAXBUF characters
+     *   which receives the null-terminated grid reference.
+     * @exception GeographicErr if \e prec, \e x, or \e y is outside its
+     *   allowed range.
+     *
+     * This is the same as the version returning a std::string, except that
+     * no memory is allocated.  If an error is thrown, then \e gridref is
+     * unchanged.
+     **********************************************************************/
+    static void GridReference(real x, real y, int prec, char gridref[]);
+
+    /**
+     * Convert many OSGB coordinates to grid references.
+     *
+     * @param[in] n the number of points.
+     * @param[in] x array of \e n eastings (meters).
+     * @param[in] y array of \e n northings (meters).
+     * @param[in] prec precision relative to 100 km.
+     * @param[out] gridref a char array of \e n \e width characters; grid
+     *   reference \e i is written null-terminated starting at gridref[\e i
+     *   \e width].
+     * @param[in] width the spacing of the strings in \e gridref; this must
+     *   be at least 8 and at least 3 + 2 \e prec.
+     * @exception GeographicErr if \e prec or \e width is illegal or if any
+     *   point is outside its allowed range; in the latter case, the message
+     *   refers to the first such point and the strings before it have been
+     *   written.
+     **********************************************************************/
+    static void GridReference(size_t n, const real x[], const real y[],
+                              int prec, char gridref[], size_t width);
+
     /**
      * Convert OSGB grid reference to coordinates.
      *
@@ -30,14 +30,29 @@ namespace GeographicLib {
    * The meridian convergence is the bearing of grid north (the \e y axis)
    * measured clockwise from true north.
    *
+   * The class is a template on the floating point type \e T.  It is
+   * instantiated for float, double, long double (if this is distinct from
+   * double), and Math::real.  PolarStereographic is the version using
+   * Math::real.  Thus, for example, PolarStereographicT<float> may be used
+   * where speed is more important than accuracy even if Math::real is
+   * double.
+   *
+   * @tparam T the floating point type.
+   *
    * Example of use:
    * \include example-PolarStereographic.cpp
    **********************************************************************/
-  class GEOGRAPHICLIB_EXPORT PolarStereographic {
+  template<typename T>
+  class GEOGRAPHICLIB_EXPORT PolarStereographicT {
   private:
-    typedef Math::real real;
+    typedef T real;
     real _a, _f, _e2, _es, _e2m, _c;
     real _k0;
+    // The projections; the scale is only computed if wantk is true.
+    void GenForward(bool northp, real lat, real lon, bool wantk,
+                    real& x, real& y, real& gamma, real& k) const;
+    void GenReverse(bool northp, real x, real y, bool wantk,
+                    real& lat, real& lon, real& gamma, real& k) const;
   public:
 
     /**
@@ -50,7 +65,7 @@ namespace GeographicLib {
      * @exception GeographicErr if \e a, (1 &minus; \e f) \e a, or \e k0 is
      *   not positive.
      **********************************************************************/
-    PolarStereographic(real a, real f, real k0);
+    PolarStereographicT(real a, real f, real k0);
 
     /**
      * Set the scale for the projection.
@@ -80,7 +95,8 @@ namespace GeographicLib {
      * [&minus;90&deg;, 90&deg;) for \e northp = false.
      **********************************************************************/
     void Forward(bool northp, real lat, real lon,
-                 real& x, real& y, real& gamma, real& k) const;
+                 real& x, real& y, real& gamma, real& k) const
+    { GenForward(northp, lat, lon, true, x, y, gamma, k); }
 
     /**
      * Reverse projection, from polar stereographic to geographic.
@@ -98,7 +114,60 @@ namespace GeographicLib {
      * in the range [&minus;180&deg;, 180&deg;].
      **********************************************************************/
     void Reverse(bool northp, real x, real y,
-                 real& lat, real& lon, real& gamma, real& k) const;
+                 real& lat, real& lon, real& gamma, real& k) const
+    { GenReverse(northp, x, y, true, lat, lon, gamma, k); }
+
+    /**
+     * Forward projection of many points about the same pole.
+     *
+     * @param[in] northp the pole which is the center of projection (true means
+     *   north, false means south).
+     * @param[in] n the number of points.
+     * @param[in] lat array of \e n latitudes (degrees).
+     * @param[in] lon array of \e n longitudes (degrees).
+     * @param[out] x array of \e n eastings (meters).
+     * @param[out] y array of \e n northings (meters).
+     * @param[out] gamma array of \e n meridian convergences (degrees); this
+     *   may be a null pointer.
+     * @param[out] k array of \e n scales; this may be a null pointer.
+     *
+     * Element \e i of the output arrays is set to the result of
+     * PolarStereographic::Forward applied to element \e i of the input
+     * arrays; the results are bitwise identical.  If \e k is a null
+     * pointer, the calculation of the scale is skipped.  The input and
+     * output arrays must not overlap.
+     *
+     * The per-point cost is dominated by Math::taupf and Math::sincosd,
+     * which don't depend on the other points, so this interface chiefly
+     * saves the call overhead and, if \e k is null, the scale.
+     **********************************************************************/
+    void Forward(bool northp, size_t n, const real lat[], const real lon[],
+                 real x[], real y[],
+                 real gamma[] = nullptr, real k[] = nullptr) const;
+
+    /**
+     * Reverse projection of many points about the same pole.
+     *
+     * @param[in] northp the pole which is the center of projection (true means
+     *   north, false means south).
+     * @param[in] n the number of points.
+     * @param[in] x array of \e n eastings (meters).
+     * @param[in] y array of \e n northings (meters).
+     * @param[out] lat array of \e n latitudes (degrees).
+     * @param[out] lon array of \e n longitudes (degrees).
+     * @param[out] gamma array of \e n meridian convergences (degrees); this
+     *   may be a null pointer.
+     * @param[out] k array of \e n scales; this may be a null pointer.
+     *
+     * Element \e i of the output arrays is set to the result of
+     * PolarStereographic::Reverse applied to element \e i of the input
+     * arrays; the results are bitwise identical.  If \e k is a null
+     * pointer, the calculation of the scale is skipped.  The input and
+     * output arrays must not overlap.
+     **********************************************************************/
+    void Reverse(bool northp, size_t n, const real x[], const real y[],
+                 real lat[], real lon[],
+                 real gamma[] = nullptr, real k[] = nullptr) const;
 
     /**
      * PolarStereographic::Forward without returning the convergence and scale.
@@ -125,30 +194,48 @@ namespace GeographicLib {
      * @return \e a the equatorial radius of the ellipsoid (meters).  This is
      *   the value used in the constructor.
      **********************************************************************/
-    Math::real EquatorialRadius() const { return _a; }
+    real EquatorialRadius() const { return _a; }
 
     /**
      * @return \e f the flattening of the ellipsoid.  This is the value used in
      *   the constructor.
      **********************************************************************/
-    Math::real Flattening() const { return _f; }
+    real Flattening() const { return _f; }
 
     /**
      * The central scale for the projection.  This is the value of \e k0 used
      * in the constructor and is the scale at the pole unless overridden by
      * PolarStereographic::SetScale.
      **********************************************************************/
-    Math::real CentralScale() const { return _k0; }
+    real CentralScale() const { return _k0; }
     ///@}
 
     /**
      * A global instantiation of PolarStereographic with the WGS84 ellipsoid
      * and the UPS scale factor.  However, unlike UPS, no false easting or
-     * northing is added.
+     * northing is added.  See Geodesic::WGS84() for when this is
+     * constructed.
      **********************************************************************/
-    static const PolarStereographic& UPS();
+    static const PolarStereographicT& UPS();
   };
 
+  /**
+   * The PolarStereographic class using Math::real.
+   **********************************************************************/
+  typedef PolarStereographicT<Math::real> PolarStereographic;
+
+  /// \cond SKIP
+  // The instantiations are in PolarStereographic.cpp
+  extern template class PolarStereographicT<float>;
+  extern template class PolarStereographicT<double>;
+#if GEOGRAPHICLIB_HAVE_LONG_DOUBLE
+  extern template class PolarStereographicT<long double>;
+#endif
+#if GEOGRAPHICLIB_PRECISION > 3
+  extern template class PolarStereographicT<Math::real>;
+#endif
+  /// \endcond
+
 } // namespace GeographicLib
 
 #endif  // GEOGRAPHICLIB_POLARSTEREOGRAPHIC_HPP
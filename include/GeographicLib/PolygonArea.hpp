@@ -17,6 +17,9 @@
 
 namespace GeographicLib {
 
+  template<class GeodType> class PolygonEditT;
+  template<class GeodType> class PolygonWindowT;
+
   /**
    * \brief Polygon areas
    *
@@ -116,6 +119,12 @@ namespace GeographicLib {
     }
     template<typename T>
     void AreaReduce(T& area, int crossings, bool reverse, bool sign) const;
+    // Return the length, the area contribution, and the crossings of the
+    // edge from the current point to (lat, lon).
+    int Edge(real lat, real lon, real& s12, real& S12) const;
+    // PolygonEditT and PolygonWindowT update the sums directly.
+    friend class PolygonEditT<GeodType>;
+    friend class PolygonWindowT<GeodType>;
   public:
 
     /**
@@ -166,6 +175,57 @@ namespace GeographicLib {
      **********************************************************************/
     void AddEdge(real azi, real s);
 
+    /**
+     * Add many points to the polygon or polyline.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of \e n latitudes of the points (degrees).
+     * @param[in] lon array of \e n longitudes of the points (degrees).
+     * @param[in] nthreads the number of threads to use (default 1).
+     * @param[in] reproducible if true, make the results independent of \e
+     *   nthreads (default false).
+     *
+     * This is equivalent to calling PolygonAreaT::AddPoint for each point in
+     * turn.  With \e nthreads &gt; 1, the points are split into contiguous
+     * pieces, the edges within each piece are accumulated concurrently into
+     * separate PolygonAreaT objects, and these are combined in order with
+     * PolygonAreaT::Merge.  The number of points, the perimeter, and the
+     * area agree with the serial result to the accuracy of the accumulators
+     * (they may differ in the last bit).
+     *
+     * Normally the number of pieces is \e nthreads, so the last bits of the
+     * results depend on \e nthreads.  If \e reproducible is true, the
+     * pieces instead consist of 1024 points each (regardless of \e
+     * nthreads) and they are merged in order; the results are then bitwise
+     * identical for any \e nthreads, including 1.  The cost of this is
+     * small: one PolygonAreaT object is accumulated and merged for every
+     * 1024 points and, with \e nthreads = 1, a polygon with more than 1024
+     * points is processed in pieces instead of by a simple loop over
+     * PolygonAreaT::AddPoint.
+     **********************************************************************/
+    void AddPoints(size_t n, const real lat[], const real lon[],
+                   int nthreads = 1, bool reproducible = false);
+
+    /**
+     * Append another polygon or polyline to this one.
+     *
+     * @param[in] p the PolygonAreaT object to append.
+     * @exception GeographicErr if \e p is for a different ellipsoid or if its
+     *   \e polyline setting differs from this object's.
+     *
+     * The vertices of \e p are appended to those of this object, i.e., the
+     * edge from the current point of this object to the first vertex of \e
+     * p is added followed by the edges of \e p.  Any edges added to \e p
+     * with PolygonAreaT::AddEdge are included.  This allows a polygon with
+     * very many vertices to be handled by splitting its vertices into
+     * contiguous pieces, accumulating each piece independently (e.g., on
+     * separate threads), and merging the pieces in order.  The operation is
+     * associative, so the pieces can be merged pairwise in a tree.  The
+     * perimeter and area sums are combined without loss of accuracy and the
+     * count of crossings of the prime meridian is combined exactly.
+     **********************************************************************/
+    void Merge(const PolygonAreaT& p);
+
     /**
      * Return the results so far.
      *
@@ -239,6 +299,83 @@ namespace GeographicLib {
     unsigned TestEdge(real azi, real s, bool reverse, bool sign,
                       real& perimeter, real& area) const;
 
+    /**
+     * Return the results for many tentative final test points.
+     *
+     * @param[in] n the number of test points.
+     * @param[in] lat array of \e n latitudes of the test points (degrees).
+     * @param[in] lon array of \e n longitudes of the test points (degrees).
+     * @param[in] reverse if true then clockwise (instead of counter-clockwise)
+     *   traversal counts as a positive area.
+     * @param[in] sign if true then return a signed result for the area if
+     *   the polygon is traversed in the "wrong" direction instead of returning
+     *   the area for the rest of the earth.
+     * @param[out] perimeter array of \e n approximate perimeters of the
+     *   polygon or lengths of the polyline (meters).
+     * @param[out] area array of \e n approximate areas of the polygon
+     *   (meters<sup>2</sup>); only set if \e polyline is false in the
+     *   constructor, in which case it may be a null pointer.
+     * @param[in] nthreads the number of threads to use (default 1).
+     *
+     * Element \e i of the output arrays is the result of
+     * PolygonAreaT::TestPoint(\e lat[\e i], \e lon[\e i], ...), to within
+     * roundoff, e.g., for choosing the next vertex among many candidates.
+     * The edges from the current point and from the first point to the test
+     * points are computed with the one-to-many solvers
+     * (GeodesicOrigin::GenInverse for Geodesic and the array versions of
+     * GenInverse for GeodesicExact and Rhumb), so the setup for these two
+     * points is done once for all the test points.  (The contribution of
+     * the closing edge is given by that of the reversed edge from the first
+     * point.)  The saving from this is modest because most of the cost of
+     * an inverse problem depends on both points; however, with \e nthreads
+     * &gt; 1, blocks of test points are processed concurrently with
+     * Executor::Current.
+     **********************************************************************/
+    void TestPoints(size_t n, const real lat[], const real lon[],
+                    bool reverse, bool sign,
+                    real perimeter[], real area[], int nthreads = 1) const;
+
+    /**
+     * Compute the perimeters and areas of many polygons or polylines.
+     *
+     * @param[in] n the number of polygons.
+     * @param[in] offsets array of \e n + 1 offsets into \e lat and \e lon;
+     *   the vertices of polygon \e k are given by the elements with indices
+     *   in [\e offsets[\e k], \e offsets[\e k + 1]).
+     * @param[in] lat array of the latitudes of the vertices (degrees).
+     * @param[in] lon array of the longitudes of the vertices (degrees).
+     * @param[in] reverse if true then clockwise (instead of counter-clockwise)
+     *   traversal counts as a positive area.
+     * @param[in] sign if true then return a signed result for the area if
+     *   the polygon is traversed in the "wrong" direction instead of returning
+     *   the area for the rest of the earth.
+     * @param[out] perimeter array of \e n perimeters of the polygons or
+     *   lengths of the polylines (meters).
+     * @param[out] area array of \e n areas of the polygons
+     *   (meters<sup>2</sup>); only set if \e polyline is false in the
+     *   constructor, in which case it may be a null pointer.
+     * @param[in] nthreads the number of threads to use (default 1).
+     *
+     * Only the ellipsoid and the \e polyline setting of this object are
+     * used; the vertices added to it are ignored.  The results are identical
+     * to those obtained by adding the vertices of each polygon to a fresh
+     * PolygonAreaT with PolygonAreaT::AddPoint and calling
+     * PolygonAreaT::Compute.  This interface avoids constructing a
+     * PolygonAreaT object for each polygon and, with \e nthreads &gt; 1,
+     * processes the polygons concurrently.  It is intended for large
+     * collections of polygons with a few vertices each; for a single polygon
+     * with very many vertices use PolygonAreaT::AddPoints.  For
+     * PolygonAreaRhumb, the edges of each polygon (except the closing edge)
+     * are solved with a single call to the array version of
+     * Rhumb::GenInverse, which evaluates the area terms for several edges
+     * together and converts each shared vertex only once.
+     **********************************************************************/
+    void ComputeMany(size_t n, const size_t offsets[],
+                     const real lat[], const real lon[],
+                     bool reverse, bool sign,
+                     real perimeter[], real area[],
+                     int nthreads = 1) const;
+
     /** \name Inspector functions
      **********************************************************************/
     ///@{
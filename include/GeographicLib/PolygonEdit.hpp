@@ -0,0 +1,237 @@
+/**
+ * \file PolygonEdit.hpp
+ * \brief Header for GeographicLib::PolygonEditT class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_POLYGONEDIT_HPP)
+#define GEOGRAPHICLIB_POLYGONEDIT_HPP 1
+
+#include <vector>
+#include <GeographicLib/PolygonArea.hpp>
+
+#if defined(_MSC_VER)
+// Squelch warnings about dll vs vector
+#  pragma warning (push)
+#  pragma warning (disable: 4251)
+#endif
+
+namespace GeographicLib {
+
+  /**
+   * \brief The area of a polygon whose vertices can be edited
+   *
+   * This maintains a polygon (or polyline) whose vertices may be moved,
+   * inserted, and removed anywhere, e.g., in an interactive editor where
+   * the area is redisplayed while a vertex is being dragged.
+   *
+   * As with PolygonWindowT, the vertices are held together with the
+   * contributions of the edge joining each vertex to its predecessor to the
+   * perimeter, the area, and the count of crossings of the prime meridian,
+   * and the sums of these are held in a PolygonAreaT object.  An edit
+   * subtracts the contributions of the edges which are removed and adds
+   * those of the new edges.  So moving a vertex needs two inverse geodesic
+   * calculations, inserting a vertex two, and removing a vertex one,
+   * regardless of the number of vertices \e n; PolygonEditT::Compute needs
+   * one more (for the edge closing the polygon).  Inserting and removing a
+   * vertex shifts the stored data for the following vertices; this is an
+   * O(\e n) memory move which is much faster than solving the geodesics for
+   * polygons with up to a few hundred thousand vertices.  The sums are held
+   * at twice the standard precision (see Accumulator), so the errors
+   * incurred by removing edges don't accumulate appreciably; the results
+   * agree with those of a PolygonAreaT to which the vertices have been
+   * added in order.
+   *
+   * The vertices are indexed from 0 to PolygonEditT::NumberPoints() &minus;
+   * 1.  The member functions throw GeographicErr if an index is out of
+   * range; in that case the polygon is unchanged.
+   *
+   * @tparam GeodType the geodesic class to use.
+   *
+   * Example of use:
+   * \code
+   *   PolygonEdit poly(Geodesic::WGS84());
+   *   for (...)
+   *     poly.AddPoint(lat, lon);
+   *   // as vertex i is dragged
+   *   poly.MovePoint(i, lat, lon);
+   *   double perimeter, area;
+   *   poly.Compute(false, true, perimeter, area);
+   * \endcode
+   **********************************************************************/
+
+  template<class GeodType = Geodesic>
+  class PolygonEditT {
+  private:
+    typedef Math::real real;
+    // The polygon for the vertices; its sums are updated here (so
+    // PolygonAreaT::AddPoint isn't used).
+    PolygonAreaT<GeodType> _poly;
+    // The vertices and, for each vertex, the contributions of the edge from
+    // the previous vertex (these are 0 for vertex 0).
+    std::vector<real> _lat, _lon, _s12, _S12;
+    std::vector<int> _cross;
+    void check(unsigned i, unsigned n) const;
+    // Solve for the edge to vertex k from its predecessor and add its
+    // contributions to the sums.
+    void addedge(unsigned k);
+    // Subtract the contributions of the edge to vertex k from the sums.
+    void subedge(unsigned k);
+    // Set the first and last points and the number of points of _poly.
+    void ends();
+  public:
+
+    /**
+     * Constructor for PolygonEditT.
+     *
+     * @param[in] earth the Geodesic object to use for geodesic calculations.
+     * @param[in] polyline if true that treat the points as defining a polyline
+     *   instead of a polygon (default = false).
+     **********************************************************************/
+    PolygonEditT(const GeodType& earth, bool polyline = false)
+      : _poly(earth, polyline)
+    {}
+
+    /**
+     * Remove all the points.
+     **********************************************************************/
+    void Clear();
+
+    /**
+     * Add a point at the end of the polygon.
+     *
+     * @param[in] lat the latitude of the point (degrees).
+     * @param[in] lon the longitude of the point (degrees).
+     * @exception std::bad_alloc if the memory for the point can't be
+     *   allocated.
+     *
+     * \e lat should be in the range [&minus;90&deg;, 90&deg;].
+     **********************************************************************/
+    void AddPoint(real lat, real lon)
+    { InsertPoint(NumberPoints(), lat, lon); }
+
+    /**
+     * Insert a point.
+     *
+     * @param[in] i the index of the new point.
+     * @param[in] lat the latitude of the point (degrees).
+     * @param[in] lon the longitude of the point (degrees).
+     * @exception GeographicErr if \e i &gt; NumberPoints().
+     * @exception std::bad_alloc if the memory for the point can't be
+     *   allocated.
+     *
+     * The new point becomes point \e i and the points previously numbered
+     * \e i and higher are renumbered by adding 1.  \e i = NumberPoints()
+     * adds the point at the end.  \e lat should be in the range
+     * [&minus;90&deg;, 90&deg;].
+     **********************************************************************/
+    void InsertPoint(unsigned i, real lat, real lon);
+
+    /**
+     * Move a point.
+     *
+     * @param[in] i the index of the point.
+     * @param[in] lat the new latitude of the point (degrees).
+     * @param[in] lon the new longitude of the point (degrees).
+     * @exception GeographicErr if \e i &ge; NumberPoints().
+     *
+     * \e lat should be in the range [&minus;90&deg;, 90&deg;].
+     **********************************************************************/
+    void MovePoint(unsigned i, real lat, real lon);
+
+    /**
+     * Remove a point.
+     *
+     * @param[in] i the index of the point.
+     * @exception GeographicErr if \e i &ge; NumberPoints().
+     *
+     * The points previously numbered \e i + 1 and higher are renumbered by
+     * subtracting 1.
+     **********************************************************************/
+    void RemovePoint(unsigned i);
+
+    /**
+     * Return the results for the polygon.
+     *
+     * @param[in] reverse if true then clockwise (instead of counter-clockwise)
+     *   traversal counts as a positive area.
+     * @param[in] sign if true then return a signed result for the area if
+     *   the polygon is traversed in the "wrong" direction instead of returning
+     *   the area for the rest of the earth.
+     * @param[out] perimeter the perimeter of the polygon or length of the
+     *   polyline (meters).
+     * @param[out] area the area of the polygon (meters<sup>2</sup>); only set
+     *   if \e polyline is false in the constructor.
+     * @return the number of points.
+     *
+     * This is the same as PolygonAreaT::Compute for the polygon formed by
+     * the points in order.
+     **********************************************************************/
+    unsigned Compute(bool reverse, bool sign,
+                     real& perimeter, real& area) const
+    { return _poly.Compute(reverse, sign, perimeter, area); }
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return \e a the equatorial radius of the ellipsoid (meters).  This is
+     *   the value inherited from the Geodesic object used in the constructor.
+     **********************************************************************/
+    Math::real EquatorialRadius() const { return _poly.EquatorialRadius(); }
+
+    /**
+     * @return \e f the flattening of the ellipsoid.  This is the value
+     *   inherited from the Geodesic object used in the constructor.
+     **********************************************************************/
+    Math::real Flattening() const { return _poly.Flattening(); }
+
+    /**
+     * Report a point.
+     *
+     * @param[in] i the index of the point.
+     * @param[out] lat the latitude of the point (degrees).
+     * @param[out] lon the longitude of the point (degrees).
+     * @exception GeographicErr if \e i &ge; NumberPoints().
+     **********************************************************************/
+    void Point(unsigned i, real& lat, real& lon) const
+    { check(i, NumberPoints()); lat = _lat[i]; lon = _lon[i]; }
+
+    /**
+     * @return the number of points.
+     **********************************************************************/
+    unsigned NumberPoints() const { return unsigned(_lat.size()); }
+
+    /**
+     * Report whether the current object is a polygon or a polyline.
+     *
+     * @return true if the object is a polyline.
+     **********************************************************************/
+    bool Polyline() const { return _poly.Polyline(); }
+    ///@}
+  };
+
+  /**
+   * @relates PolygonEditT
+   *
+   * Editable polygon areas using Geodesic.
+   **********************************************************************/
+  typedef PolygonEditT<Geodesic> PolygonEdit;
+
+  /**
+   * @relates PolygonEditT
+   *
+   * Editable polygon areas using Rhumb.
+   **********************************************************************/
+  typedef PolygonEditT<Rhumb> PolygonEditRhumb;
+
+} // namespace GeographicLib
+
+#if defined(_MSC_VER)
+#  pragma warning (pop)
+#endif
+
+#endif  // GEOGRAPHICLIB_POLYGONEDIT_HPP
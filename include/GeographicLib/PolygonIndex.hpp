@@ -0,0 +1,166 @@
+/**
+ * \file PolygonIndex.hpp
+ * \brief Header for GeographicLib::PolygonIndex class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_POLYGONINDEX_HPP)
+#define GEOGRAPHICLIB_POLYGONINDEX_HPP 1
+
+#include <vector>
+#include <GeographicLib/Constants.hpp>
+#include <GeographicLib/Geodesic.hpp>
+
+#if defined(_MSC_VER)
+// Squelch warnings about dll vs vector
+#  pragma warning (push)
+#  pragma warning (disable: 4251)
+#endif
+
+namespace GeographicLib {
+
+  /**
+   * \brief Point in polygon tests for geodesic polygons
+   *
+   * PolygonIndex preprocesses a polygon whose edges are geodesics so that
+   * many points can be tested for containment quickly (PolygonArea::TestPoint
+   * computes the area of the polygon with an additional vertex, which does not
+   * answer this question).  The interior of the polygon is the region to the
+   * left of the edges as they are traversed (the region whose area is given
+   * as positive by PolygonArea::Compute with \e reverse = false); polygons
+   * which encircle a pole are allowed.
+   *
+   * A point is inside the polygon if the meridian from the point to the north
+   * pole crosses the edges an even number of times and the north pole is
+   * inside or an odd number of times and the north pole is outside.  The
+   * constructor
+   * - computes, for each edge, its range of longitudes and latitudes;
+   * - divides the range of longitudes of the polygon into bins (as many as
+   *   there are edges, up to 65536) and lists the edges which overlap each
+   *   bin;
+   * - determines whether the north pole is inside the polygon by counting
+   *   the crossings for a point just inside the longest edge.
+   * .
+   * A test then only examines the edges listed in the bin for the longitude
+   * of the point.  An edge only needs to be examined closely if the point
+   * lies within its range of latitudes; in that case, the side of the edge
+   * on which point lies is found from the azimuths at the first vertex of
+   * the edge with Geodesic::GenInverse.  Typically, each test takes a few
+   * comparisons and, occasionally, one inverse geodesic calculation.
+   *
+   * The result for a point on an edge is either inside or outside.  The
+   * vertices should not be at a pole.  The object is immutable, so it may be
+   * accessed by several threads at once.
+   *
+   * Example of use:
+   * \code
+   *   const Geodesic& geod = Geodesic::WGS84();
+   *   std::vector<double> lat{...}, lon{...};
+   *   PolygonIndex fence(geod, lat.size(), lat.data(), lon.data());
+   *   if (fence.Contains(40.64, -73.78))
+   *     ...;
+   * \endcode
+   **********************************************************************/
+
+  class GEOGRAPHICLIB_EXPORT PolygonIndex {
+  private:
+    typedef Math::real real;
+    struct Edge {
+      real lat1, lon1, lat2, lon2, azi1, latmin, latmax;
+      bool east;                // does the edge head east?
+    };
+    Geodesic _geod;
+    std::vector<Edge> _edges;
+    // Bin k covers longitudes _lon0 + [k, k + 1) * _width and lists the
+    // edges _index[_start[k]] through _index[_start[k + 1] - 1].
+    std::vector<unsigned> _start, _index;
+    real _lon0, _span, _width;
+    bool _reverse, _northinside;
+    bool Crosses(const Edge& e, real lat, real lon) const;
+    bool Parity(const unsigned* first, const unsigned* last,
+                real lat, real lon) const;
+  public:
+
+    /**
+     * Constructor for a PolygonIndex.
+     *
+     * @param[in] g the Geodesic object used to compute the edges.
+     * @param[in] n the number of vertices.
+     * @param[in] lat array of \e n latitudes of the vertices (degrees).
+     * @param[in] lon array of \e n longitudes of the vertices (degrees).
+     * @param[in] reverse if true the interior is to the right of the edges
+     *   (default false).
+     * @exception GeographicErr if the polygon has fewer than 3 distinct
+     *   vertices or if a latitude is not in [&minus;90&deg;, 90&deg;].
+     * @exception std::bad_alloc if the memory for the index can't be
+     *   allocated.
+     *
+     * The polygon is closed by a final edge from vertex \e n &minus; 1 to
+     * vertex 0.  Consecutive vertices which coincide are ignored.
+     **********************************************************************/
+    PolygonIndex(const Geodesic& g, size_t n,
+                 const real lat[], const real lon[], bool reverse = false);
+
+    /**
+     * Test whether a point is inside the polygon.
+     *
+     * @param[in] lat the latitude of the point (degrees).
+     * @param[in] lon the longitude of the point (degrees).
+     * @return whether the point is inside the polygon; this is false if \e
+     *   lat or \e lon is a NaN.
+     *
+     * \e lat should be in the range [&minus;90&deg;, 90&deg;].
+     **********************************************************************/
+    bool Contains(real lat, real lon) const;
+
+    /**
+     * Test whether many points are inside the polygon.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of \e n latitudes of the points (degrees).
+     * @param[in] lon array of \e n longitudes of the points (degrees).
+     * @param[out] inside array of \e n results.
+     * @param[in] nthreads the number of threads to use (default 1).
+     *
+     * Element \e i of \e inside is set to Contains(\e lat[\e i], \e lon[\e
+     * i]).  With \e nthreads &gt; 1 blocks of points are tested concurrently
+     * with Executor::Current.
+     **********************************************************************/
+    void Contains(size_t n, const real lat[], const real lon[],
+                  bool inside[], int nthreads = 1) const;
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return the number of edges of the polygon.
+     **********************************************************************/
+    size_t NumberEdges() const { return _edges.size(); }
+
+    /**
+     * @return the number of longitude bins.
+     **********************************************************************/
+    size_t NumberBins() const { return _start.size() - 1; }
+
+    /**
+     * @return whether the north pole is inside the polygon.
+     **********************************************************************/
+    bool NorthPoleInside() const { return _northinside; }
+
+    /**
+     * @return \e reverse the value used in the constructor.
+     **********************************************************************/
+    bool Reverse() const { return _reverse; }
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#if defined(_MSC_VER)
+#  pragma warning (pop)
+#endif
+
+#endif  // GEOGRAPHICLIB_POLYGONINDEX_HPP
@@ -0,0 +1,204 @@
+/**
+ * \file PolygonWindow.hpp
+ * \brief Header for GeographicLib::PolygonWindowT class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_POLYGONWINDOW_HPP)
+#define GEOGRAPHICLIB_POLYGONWINDOW_HPP 1
+
+#include <vector>
+#include <GeographicLib/PolygonArea.hpp>
+
+#if defined(_MSC_VER)
+// Squelch warnings about dll vs vector
+#  pragma warning (push)
+#  pragma warning (disable: 4251)
+#endif
+
+namespace GeographicLib {
+
+  /**
+   * \brief The area of the polygon given by the last few points of a track
+   *
+   * This maintains the polygon (or polyline) given by the last \e n points
+   * added, e.g., the area swept out by the recent positions of a moving
+   * vessel.  Once \e n points have been added, PolygonWindowT::AddPoint
+   * drops the oldest point before adding the new one.
+   *
+   * The points are held in a ring buffer together with the contributions
+   * of the edge joining each point to its predecessor to the perimeter, the
+   * area, and the count of crossings of the prime meridian.  The sums of
+   * these are held in a PolygonAreaT object; dropping the oldest point
+   * subtracts the contributions of its outgoing edge.  So each update
+   * needs just one inverse geodesic calculation (for the new edge) and
+   * PolygonWindowT::Compute needs one more (for the edge closing the
+   * polygon), regardless of \e n.  The sums are held at twice the standard
+   * precision (see Accumulator), so the errors incurred by removing edges
+   * don't accumulate appreciably; the results agree with those of a
+   * PolygonAreaT to which the points in the window have been added.
+   *
+   * @tparam GeodType the geodesic class to use.
+   *
+   * Example of use:
+   * \code
+   *   PolygonWindow track(Geodesic::WGS84(), 100);
+   *   // for each fix
+   *   track.AddPoint(lat, lon);
+   *   double perimeter, area;
+   *   track.Compute(false, true, perimeter, area);
+   * \endcode
+   **********************************************************************/
+
+  template<class GeodType = Geodesic>
+  class PolygonWindowT {
+  private:
+    typedef Math::real real;
+    // The polygon for the points in the window; its sums are updated here
+    // (so PolygonAreaT::AddPoint isn't used).
+    PolygonAreaT<GeodType> _poly;
+    unsigned _n, _first;
+    // The vertices and, for each vertex, the contributions of the edge from
+    // the previous vertex.
+    std::vector<real> _lat, _lon, _s12, _S12;
+    std::vector<int> _cross;
+  public:
+
+    /**
+     * Constructor for PolygonWindowT.
+     *
+     * @param[in] earth the Geodesic object to use for geodesic calculations.
+     * @param[in] n the maximum number of points in the window.
+     * @param[in] polyline if true that treat the points as defining a polyline
+     *   instead of a polygon (default = false).
+     * @exception GeographicErr if \e n is zero.
+     * @exception std::bad_alloc if the memory for the window can't be
+     *   allocated.
+     **********************************************************************/
+    PolygonWindowT(const GeodType& earth, unsigned n, bool polyline = false);
+
+    /**
+     * Remove all the points.
+     **********************************************************************/
+    void Clear() { _poly.Clear(); _first = 0; }
+
+    /**
+     * Add a point to the window.
+     *
+     * @param[in] lat the latitude of the point (degrees).
+     * @param[in] lon the longitude of the point (degrees).
+     *
+     * If the window is full, the oldest point is removed first.  \e lat
+     * should be in the range [&minus;90&deg;, 90&deg;].
+     **********************************************************************/
+    void AddPoint(real lat, real lon);
+
+    /**
+     * Remove the oldest point from the window.
+     *
+     * This does nothing if the window is empty.  This allows the window to
+     * be defined by a time span instead of by a number of points.
+     **********************************************************************/
+    void RemovePoint();
+
+    /**
+     * Return the results for the points in the window.
+     *
+     * @param[in] reverse if true then clockwise (instead of counter-clockwise)
+     *   traversal counts as a positive area.
+     * @param[in] sign if true then return a signed result for the area if
+     *   the polygon is traversed in the "wrong" direction instead of returning
+     *   the area for the rest of the earth.
+     * @param[out] perimeter the perimeter of the polygon or length of the
+     *   polyline (meters).
+     * @param[out] area the area of the polygon (meters<sup>2</sup>); only set
+     *   if \e polyline is false in the constructor.
+     * @return the number of points.
+     *
+     * This is the same as PolygonAreaT::Compute for the polygon formed by
+     * the points in the window, oldest first.
+     **********************************************************************/
+    unsigned Compute(bool reverse, bool sign,
+                     real& perimeter, real& area) const
+    { return _poly.Compute(reverse, sign, perimeter, area); }
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return \e a the equatorial radius of the ellipsoid (meters).  This is
+     *   the value inherited from the Geodesic object used in the constructor.
+     **********************************************************************/
+    Math::real EquatorialRadius() const { return _poly.EquatorialRadius(); }
+
+    /**
+     * @return \e f the flattening of the ellipsoid.  This is the value
+     *   inherited from the Geodesic object used in the constructor.
+     **********************************************************************/
+    Math::real Flattening() const { return _poly.Flattening(); }
+
+    /**
+     * Report the newest point in the window.
+     *
+     * @param[out] lat the latitude of the point (degrees).
+     * @param[out] lon the longitude of the point (degrees).
+     *
+     * If the window is empty, then NaNs are returned.
+     **********************************************************************/
+    void CurrentPoint(real& lat, real& lon) const
+    { _poly.CurrentPoint(lat, lon); }
+
+    /**
+     * Report the oldest point in the window.
+     *
+     * @param[out] lat the latitude of the point (degrees).
+     * @param[out] lon the longitude of the point (degrees).
+     *
+     * If the window is empty, then NaNs are returned.
+     **********************************************************************/
+    void OldestPoint(real& lat, real& lon) const
+    { lat = _poly._lat0; lon = _poly._lon0; }
+
+    /**
+     * @return the number of points in the window.
+     **********************************************************************/
+    unsigned NumberPoints() const { return _poly.NumberPoints(); }
+
+    /**
+     * @return \e n the maximum number of points in the window.
+     **********************************************************************/
+    unsigned Capacity() const { return _n; }
+
+    /**
+     * Report whether the current object is a polygon or a polyline.
+     *
+     * @return true if the object is a polyline.
+     **********************************************************************/
+    bool Polyline() const { return _poly.Polyline(); }
+    ///@}
+  };
+
+  /**
+   * @relates PolygonWindowT
+   *
+   * Sliding window polygon areas using Geodesic.
+   **********************************************************************/
+  typedef PolygonWindowT<Geodesic> PolygonWindow;
+
+  /**
+   * @relates PolygonWindowT
+   *
+   * Sliding window polygon areas using Rhumb.
+   **********************************************************************/
+  typedef PolygonWindowT<Rhumb> PolygonWindowRhumb;
+
+} // namespace GeographicLib
+
+#if defined(_MSC_VER)
+#  pragma warning (pop)
+#endif
+
+#endif  // GEOGRAPHICLIB_POLYGONWINDOW_HPP
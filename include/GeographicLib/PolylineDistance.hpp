@@ -0,0 +1,195 @@
+/**
+ * \file PolylineDistance.hpp
+ * \brief Header for GeographicLib::PolylineDistance class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_POLYLINEDISTANCE_HPP)
+#define GEOGRAPHICLIB_POLYLINEDISTANCE_HPP 1
+
+#include <vector>
+#include <GeographicLib/Constants.hpp>
+#include <GeographicLib/Geocentric.hpp>
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/GeodesicLine.hpp>
+
+#if defined(_MSC_VER)
+// Squelch warnings about dll vs vector
+#  pragma warning (push)
+#  pragma warning (disable: 4251)
+#endif
+
+namespace GeographicLib {
+
+  /**
+   * \brief The distance from points to a geodesic polyline
+   *
+   * PolylineDistance preprocesses a polyline whose segments are geodesics so
+   * that the shortest distance from many points to the polyline (e.g., the
+   * cross-track error of an aircraft following a route) can be found
+   * quickly.
+   *
+   * The constructor computes a GeodesicLine for each segment and a bounding
+   * ball (in geocentric coordinates) for the segment: it is centered at the
+   * midpoint of the segment and its radius is half the length of the
+   * segment.  Consecutive segments are grouped into a binary tree of
+   * bounding balls.  Because the geodesic distance is no less than the
+   * chord, the distance from a point to a ball bounds the distance to the
+   * segments within it.  A query searches the tree nearest ball first
+   * skipping the balls which cannot contain a closer segment, so that the
+   * closest point is computed for only a few segments.  Before this is
+   * done for a segment, a tighter bound is found from the distance to its
+   * chord: the segment deviates from the chord by no more than \e
+   * L<sup>2</sup>/(8&rho;), where \e L is the length of the segment and
+   * &rho; is the smallest radius of curvature of the ellipsoid (\e
+   * b<sup>2</sup>/\e a for an oblate ellipsoid).  The closest point on the
+   * chord also gives the starting point for the iteration described below.
+   *
+   * The closest point on a segment is found as in the solution of the
+   * "interception problem" using the gnomonic projection (see Gnomonic):
+   * with the projection centered at a point \e C on the segment, the
+   * segment is a straight line and the foot of the perpendicular from the
+   * projected point gives the next estimate of the closest point.  When \e
+   * C is on the segment, the perpendicular distance in the projection
+   * follows from Geodesic::GenInverse and the azimuth of the segment at \e
+   * C; so each iteration is one inverse calculation and one call to
+   * GeodesicLine::GenPosition.  The iteration converges quadratically and
+   * typically takes 3 or 4 iterations.  The estimate is confined to the
+   * segment, so the result may be an end point of the segment.
+   *
+   * The object is immutable, so it may be accessed by several threads at
+   * once.
+   *
+   * Example of use:
+   * \code
+   *   const Geodesic& geod = Geodesic::WGS84();
+   *   std::vector<double> lat{...}, lon{...};
+   *   PolylineDistance route(geod, lat.size(), lat.data(), lon.data());
+   *   double d = route.Distance(40.64, -73.78);
+   * \endcode
+   **********************************************************************/
+
+  class GEOGRAPHICLIB_EXPORT PolylineDistance {
+  private:
+    typedef Math::real real;
+    struct Node {
+      real X, Y, Z, r;          // the bounding ball
+      // For a leaf, left is the index of the segment and right = -1;
+      // otherwise these are the indices of the child nodes.
+      int left, right;
+    };
+    struct Chord {
+      // The geocentric coordinates of the end points of a segment and a
+      // bound on the distance of the segment from the chord joining them.
+      real X1, Y1, Z1, X2, Y2, Z2, h;
+    };
+    Geodesic _geod;
+    Geocentric _earth;
+    std::vector<GeodesicLine> _lines;
+    std::vector<Node> _nodes;
+    std::vector<Chord> _chords;
+    int _root;
+    real _tol;
+    int Build(int lo, int hi);
+    real Bound(const Node& b, real X, real Y, real Z) const;
+    real Bound(const Chord& c, real X, real Y, real Z,
+               real& t) const;
+    // On input s is the starting guess
+    real Segment(int i, real lat, real lon, real& s, real& latc, real& lonc)
+      const;
+  public:
+
+    /**
+     * Constructor for a PolylineDistance.
+     *
+     * @param[in] g the Geodesic object used to compute the segments.
+     * @param[in] n the number of vertices.
+     * @param[in] lat array of \e n latitudes of the vertices (degrees).
+     * @param[in] lon array of \e n longitudes of the vertices (degrees).
+     * @exception GeographicErr if \e n &lt; 2 or a vertex is invalid.
+     * @exception std::bad_alloc if the memory for the index can't be
+     *   allocated.
+     *
+     * Segment \e i is the shortest geodesic from vertex \e i to vertex \e i
+     * + 1.
+     **********************************************************************/
+    PolylineDistance(const Geodesic& g, size_t n,
+                     const real lat[], const real lon[]);
+
+    /**
+     * The shortest distance from a point to the polyline.
+     *
+     * @param[in] lat the latitude of the point (degrees).
+     * @param[in] lon the longitude of the point (degrees).
+     * @param[out] seg the index of the segment containing the closest point.
+     * @param[out] s the distance along segment \e seg from its first vertex
+     *   to the closest point (meters).
+     * @param[out] latc the latitude of the closest point (degrees).
+     * @param[out] lonc the longitude of the closest point (degrees).
+     * @return the shortest distance from the point to the polyline (meters).
+     *
+     * If several points on the polyline are equally close, any of them may
+     * be returned.  \e lat should be in the range [&minus;90&deg;, 90&deg;].
+     **********************************************************************/
+    Math::real Distance(real lat, real lon,
+                        int& seg, real& s, real& latc, real& lonc) const;
+
+    /**
+     * The shortest distance from a point to the polyline.
+     *
+     * @param[in] lat the latitude of the point (degrees).
+     * @param[in] lon the longitude of the point (degrees).
+     * @return the shortest distance from the point to the polyline (meters).
+     **********************************************************************/
+    Math::real Distance(real lat, real lon) const {
+      int seg; real s, latc, lonc;
+      return Distance(lat, lon, seg, s, latc, lonc);
+    }
+
+    /**
+     * The shortest distances from many points to the polyline.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of \e n latitudes of the points (degrees).
+     * @param[in] lon array of \e n longitudes of the points (degrees).
+     * @param[out] dist array of \e n shortest distances (meters).
+     * @param[out] seg array of \e n segment indices; this may be a null
+     *   pointer.
+     * @param[out] s array of \e n distances along the segments (meters); this
+     *   may be a null pointer.
+     * @param[in] nthreads the number of threads to use (default 1).
+     *
+     * Element \e i of the output arrays is the result of Distance(\e lat[\e
+     * i], \e lon[\e i], ...).  With \e nthreads &gt; 1 blocks of points are
+     * processed concurrently with Executor::Current.
+     **********************************************************************/
+    void Distance(size_t n, const real lat[], const real lon[],
+                  real dist[], int seg[] = nullptr, real s[] = nullptr,
+                  int nthreads = 1) const;
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return the number of segments of the polyline.
+     **********************************************************************/
+    size_t NumberSegments() const { return _lines.size(); }
+
+    /**
+     * @param[in] i the index of the segment.
+     * @return a reference to the GeodesicLine for segment \e i.
+     **********************************************************************/
+    const GeodesicLine& Line(size_t i) const { return _lines[i]; }
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#if defined(_MSC_VER)
+#  pragma warning (pop)
+#endif
+
+#endif  // GEOGRAPHICLIB_POLYLINEDISTANCE_HPP
@@ -0,0 +1,163 @@
+/**
+ * \file Registry.hpp
+ * \brief Header for GeographicLib::Registry class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_REGISTRY_HPP)
+#define GEOGRAPHICLIB_REGISTRY_HPP 1
+
+#include <algorithm>            // for lower_bound
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>              // for pair
+#include <vector>
+
+namespace GeographicLib {
+
+  /**
+   * \brief A shared registry of immutable precomputed objects
+   *
+   * Several classes precompute objects which depend only on a few
+   * parameters (e.g., the flattening of the ellipsoid and the precision)
+   * and which are expensive to set up, for example, the coefficients for
+   * the exact rhumb area in Rhumb and the FFT plans in DST.  A Registry
+   * allows such objects to be shared between instances and threads.
+   *
+   * The registry is a table of entries sorted by key which is published
+   * through an atomic pointer.  A table is never modified once published;
+   * Insert publishes a copy of the table with the new entry added.  The
+   * superseded tables are kept (until the registry is destroyed) so that
+   * threads which are still reading them aren't affected.  Thus Find is
+   * lock-free and only Insert takes a lock.  Entries are never removed;
+   * once the registry holds \e maxsize entries, further objects are not
+   * registered (Insert then just returns its argument) in case many
+   * different keys are used.  Because a table with \e m entries is only
+   * superseded when the (\e m + 1)th entry is inserted, the superseded
+   * tables hold at most \e maxsize<sup>2</sup>/2 entries in total.
+   *
+   * @tparam key the type of the key; this must be copyable and be ordered
+   *   by <code>operator<</code>.
+   * @tparam T the type of the registered objects; this is normally const
+   *   qualified, e.g., <code>const std::vector<Math::real></code>.
+   *
+   * The objects are held by <code>std::shared_ptr<T></code> and so remain
+   * valid while any instance refers to them.  If two threads construct the
+   * object for the same key at the same time, the object inserted first is
+   * registered and returned to both.  The key should include Math::digits()
+   * if the object depends on the precision (GEOGRAPHICLIB_PRECISION = 5).
+   *
+   * Example of use:
+   * \code
+   *   static Registry<std::pair<real, int>, const std::vector<real>>
+   *     registry;
+   *   const std::pair<real, int> key(f, Math::digits());
+   *   std::shared_ptr<const std::vector<real>> coeffs = registry.Find(key);
+   *   if (!coeffs)
+   *     coeffs = registry.Insert
+   *       (key, std::make_shared<const std::vector<real>>(Compute(f)));
+   * \endcode
+   **********************************************************************/
+  template<typename key, typename T>
+  class Registry {
+  private:
+    typedef std::pair<key, std::shared_ptr<T>> entry;
+    typedef std::vector<entry> table;
+    std::atomic<const table*> _table;
+    // All the tables which have been published, guarded by _lock.
+    std::vector<std::unique_ptr<const table>> _tables;
+    std::mutex _lock;
+    std::size_t _maxsize;
+    static typename table::const_iterator
+    search(const table& t, const key& k) {
+      return std::lower_bound(t.begin(), t.end(), k,
+                              [](const entry& e, const key& k2) -> bool
+                              { return e.first < k2; });
+    }
+    static bool match(const table& t, typename table::const_iterator p,
+                      const key& k)
+    { return p != t.end() && !(k < p->first); }
+  public:
+
+    /**
+     * Constructor for a Registry.
+     *
+     * @param[in] maxsize the maximum number of objects to register (default
+     *   64).
+     **********************************************************************/
+    explicit Registry(std::size_t maxsize = 64)
+      : _table(nullptr)
+      , _maxsize(maxsize)
+    {}
+
+    Registry(const Registry&) = delete;
+    Registry& operator=(const Registry&) = delete;
+
+    /**
+     * Look up an object.
+     *
+     * @param[in] k the key.
+     * @return the object registered under \e k or nullptr if there is none.
+     *
+     * This does not take a lock.
+     **********************************************************************/
+    std::shared_ptr<T> Find(const key& k) const {
+      const table* t = _table.load(std::memory_order_acquire);
+      if (!t) return nullptr;
+      auto p = search(*t, k);
+      return match(*t, p, k) ? p->second : nullptr;
+    }
+
+    /**
+     * Register an object.
+     *
+     * @param[in] k the key.
+     * @param[in] v the object.
+     * @exception std::bad_alloc if the memory for the new table can't be
+     *   allocated.
+     * @return the object registered under \e k.
+     *
+     * If an object has already been registered under \e k, that object is
+     * returned and \e v is discarded.  Otherwise \e v is registered (unless
+     * the registry is full) and returned.
+     **********************************************************************/
+    std::shared_ptr<T> Insert(const key& k, std::shared_ptr<T> v) {
+      std::lock_guard<std::mutex> guard(_lock);
+      static const table empty;
+      const table* t = _table.load(std::memory_order_relaxed);
+      if (!t) t = &empty;
+      auto p = search(*t, k);
+      if (match(*t, p, k)) return p->second;
+      if (t->size() >= _maxsize) return v;
+      std::unique_ptr<table> u(new table());
+      u->reserve(t->size() + 1);
+      u->insert(u->end(), t->begin(), p);
+      u->push_back(entry(k, v));
+      u->insert(u->end(), p, t->end());
+      _tables.push_back(std::unique_ptr<const table>(u.release()));
+      _table.store(_tables.back().get(), std::memory_order_release);
+      return v;
+    }
+
+    /**
+     * @return the number of registered objects.
+     **********************************************************************/
+    std::size_t Size() const {
+      const table* t = _table.load(std::memory_order_acquire);
+      return t ? t->size() : 0;
+    }
+
+    /**
+     * @return the maximum number of objects registered.
+     **********************************************************************/
+    std::size_t MaxSize() const { return _maxsize; }
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_REGISTRY_HPP
@@ -95,7 +95,36 @@ namespace GeographicLib {
       real operator()(real chi) const;
     };
 
-    real MeanSinXi(const AuxAngle& chix, const AuxAngle& chiy) const;
+    // If pbx is not null, it holds the phi and beta values for chix computed
+    // by MeanSinXiAux.
+    real MeanSinXi(const AuxAngle& chix, const AuxAngle& chiy,
+                   const AuxAngle* pbx = nullptr) const;
+    void MeanSinXiAux(const AuxAngle& chix, AuxAngle pbx[2]) const;
+    // The conformal, geographic, and parametric latitudes at one end of a
+    // group of up to AuxLatitude::lanes rhumb lines held as separate arrays
+    // of their components; used by the batch versions of GenInverse and
+    // RhumbLine::GenPosition.
+    struct AuxLanes {
+      static const int K = AuxLatitude::lanes;
+      real chiy[K], chix[K], phiy[K], phix[K], betay[K], betax[K], t[K];
+      void Set(int i, const AuxAngle& chi, const AuxAngle* pb) {
+        chiy[i] = chi.y(); chix[i] = chi.x(); t[i] = chi.tan();
+        if (pb) {
+          phiy[i] = pb[0].y(); phix[i] = pb[0].x();
+          betay[i] = pb[1].y(); betax[i] = pb[1].x();
+        }
+      }
+    };
+    // MeanSinXi for the first n lanes of x and y; dlam holds the results of
+    // DAuxLatitude::Dlam for the lanes (not referenced if _exact).
+    void MeanSinXi(int n, const AuxLanes& x, const AuxLanes& y,
+                   const real dlam[], real M[]) const;
+    // GenInverse with the auxiliary latitudes of point 1 given; pbx is passed
+    // to MeanSinXi.
+    void IntInverse(const AuxAngle& phi1, const AuxAngle& chi1,
+                    const AuxAngle* pbx, real lon1, real lat2, real lon2,
+                    unsigned outmask,
+                    real& s12, real& azi12, real& S12) const;
 
     // The following two functions (with lots of ignored arguments) mimic the
     // interface to the corresponding Geodesic function.  These are needed by
@@ -172,6 +201,11 @@ namespace GeographicLib {
      *   0.01) [default false].
      * @exception GeographicErr if \e a or (1 &minus; \e f) \e a is not
      *   positive.
+     *
+     * With \e exact = true, the Fourier coefficients for the area are
+     * computed numerically.  These depend only on \e f and are cached (in
+     * a Registry, for up to 64 values of \e f), so that constructing further
+     * objects with the same \e f is cheap.
      **********************************************************************/
     Rhumb(real a, real f, bool exact = false);
 
@@ -303,6 +337,43 @@ namespace GeographicLib {
                     unsigned outmask,
                     real& s12, real& azi12, real& S12) const;
 
+    /**
+     * The general inverse rhumb problem for many pairs of points.
+     *
+     * @param[in] n the number of problems.
+     * @param[in] lat1 array of \e n latitudes of point 1 (degrees).
+     * @param[in] lon1 array of \e n longitudes of point 1 (degrees).
+     * @param[in] lat2 array of \e n latitudes of point 2 (degrees).
+     * @param[in] lon2 array of \e n longitudes of point 2 (degrees).
+     * @param[in] outmask a bitor'ed combination of Rhumb::mask values
+     *   specifying which of the following arrays should be set.
+     * @param[out] s12 array of rhumb distances (meters).
+     * @param[out] azi12 array of azimuths of the rhumb lines (degrees).
+     * @param[out] S12 array of areas under the rhumb lines
+     *   (meters<sup>2</sup>).
+     *
+     * Element \e i of the output arrays is set to the result of
+     * Rhumb::GenInverse applied to element \e i of the input arrays.  The
+     * output arrays need only be supplied for the quantities requested in \e
+     * outmask; the others may be null pointers.  The input and output arrays
+     * must not overlap.
+     *
+     * The conversions of \e lat1 to auxiliary latitudes are reused while \e
+     * lat1 is unchanged, so it pays to group the problems by the first
+     * point, e.g., for the distances from one point to many others.  They
+     * are also reused when \e lat1 equals the previous \e lat2, as it does
+     * for the successive edges of a polyline.  The problems are processed
+     * in groups of AuxLatitude::lanes with the divided differences for a
+     * group evaluated together by the array versions of the DAuxLatitude
+     * functions.  The results are identical to those given by calling
+     * Rhumb::GenInverse for each problem.
+     **********************************************************************/
+    void GenInverse(size_t n,
+                    const real lat1[], const real lon1[],
+                    const real lat2[], const real lon2[],
+                    unsigned outmask,
+                    real s12[], real azi12[], real S12[]) const;
+
     /**
      * Typedef for the class for computing multiple points on a rhumb line.
      **********************************************************************/
@@ -355,7 +426,7 @@ namespace GeographicLib {
 
     /**
      * A global instantiation of Rhumb with the parameters for the WGS84
-     * ellipsoid.
+     * ellipsoid.  See Geodesic::WGS84() for when this is constructed.
      **********************************************************************/
     static const Rhumb& WGS84();
   };
@@ -388,6 +459,9 @@ namespace GeographicLib {
     // copy assignment not allowed
     RhumbLine& operator=(const RhumbLine&) = delete;
     RhumbLine(const Rhumb& rh, real lat1, real lon1, real azi12);
+    // GenPosition with pbx passed to Rhumb::MeanSinXi.
+    void IntPosition(real s12, unsigned outmask, const AuxAngle* pbx,
+                     real& lat2, real& lon2, real& S12) const;
 
   public:
 
@@ -507,6 +581,34 @@ namespace GeographicLib {
     void GenPosition(real s12, unsigned outmask,
                      real& lat2, real& lon2, real& S12) const;
 
+    /**
+     * The general position routine for many points on the rhumb line.
+     *
+     * @param[in] n the number of points.
+     * @param[in] s12 array of \e n distances from point 1 (meters).
+     * @param[in] outmask a bitor'ed combination of RhumbLine::mask values
+     *   specifying which of the following arrays should be set.
+     * @param[out] lat2 array of latitudes (degrees).
+     * @param[out] lon2 array of longitudes (degrees).
+     * @param[out] S12 array of areas under the rhumb line
+     *   (meters<sup>2</sup>).
+     *
+     * Element \e i of the output arrays is set to the result of
+     * RhumbLine::GenPosition applied to element \e i of \e s12.  The output
+     * arrays need only be supplied for the quantities requested in \e
+     * outmask; the others may be null pointers.  The input and output arrays
+     * must not overlap.
+     *
+     * The auxiliary latitudes of point 1 needed for the area are computed
+     * once for the whole batch.  The points are processed in groups of
+     * AuxLatitude::lanes with the divided differences for a group evaluated
+     * together by the array versions of the DAuxLatitude functions.  The
+     * results are identical to those given by calling RhumbLine::GenPosition
+     * for each point.
+     **********************************************************************/
+    void GenPosition(size_t n, const real s12[], unsigned outmask,
+                     real lat2[], real lon2[], real S12[]) const;
+
     /** \name Inspector functions
      **********************************************************************/
     ///@{
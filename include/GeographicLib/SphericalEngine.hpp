@@ -42,8 +42,9 @@ namespace GeographicLib {
     typedef Math::real real;
     // CircularEngine needs access to sqrttable, scale
     friend class CircularEngine;
-    // Return the table of the square roots of integers
-    static std::vector<real>& sqrttable();
+    // Return the table of the square roots of integers; the table is
+    // immutable and remains valid when RootTable enlarges it.
+    static const std::vector<real>& sqrttable();
     // An internal scaling of the coefficients to avoid overflow in
     // intermediate calculations.
     static real scale() {
@@ -56,6 +57,8 @@ namespace GeographicLib {
                      / 5));
       return s;
     }
+    // The number of threads to use for a sum of degree N and order M.
+    static int sumthreads(int N, int M);
     // Move latitudes near the pole off the axis by this amount.
     static real eps() {
       using std::sqrt;
@@ -95,17 +98,60 @@ namespace GeographicLib {
      *
      * The storage layout of the coefficients is documented in
      * SphericalHarmonic and SphericalHarmonic::SphericalHarmonic.
+     *
+     * The coefficients may also be held as floats (with the constructors
+     * taking float arrays).  This halves the memory needed for the
+     * coefficients and the memory traffic in the sums which, for high degree
+     * models, can limit the speed of the evaluation.  The sums are still
+     * accumulated as Math::real; so the only loss of accuracy is the
+     * rounding of the coefficients to floats, a relative error of at most
+     * 2<sup>&minus;24</sup> = 6 &times; 10<sup>&minus;8</sup> in each term.
+     * This is usually well below the errors of the model; see
+     * GravityModel::GravityModel and MagneticModel::MagneticModel.
+     *
+     * Alternatively, \e C and \e S can be interleaved in a single array (see
+     * coeff::interleave) so that the sums read the two coefficients for each
+     * (\e n, \e m) from the same cache line.
      **********************************************************************/
     class GEOGRAPHICLIB_EXPORT coeff {
     private:
+      // SphericalEngine::InnerSum needs access to Cr, Cf, Ci, Sr, Sf, Si
+      friend class SphericalEngine;
       int _nNx, _nmx, _mmx;
-      std::vector<real>::const_iterator _cCnm;
-      std::vector<real>::const_iterator _sSnm;
+      const real* _cCnm;
+      const real* _sSnm;
+      // The coefficients held as floats; these are used if _cCnm is null.
+      const float* _cCf;
+      const float* _sSf;
+      // The coefficients interleaved, C[k] at 2*k and S[k] at 2*k + 1; this
+      // is used if _cCnm and _cCf are null.
+      const real* _cCSnm;
+      void Check() const {
+        if (!((_nNx >= _nmx && _nmx >= _mmx && _mmx >= 0) ||
+              // If mmx = -1 then the sums are empty so require nmx = -1 also.
+              (_nmx == -1 && _mmx == -1)))
+          throw GeographicErr("Bad indices for coeff");
+      }
+      void CheckSize(size_t Csize, size_t Ssize) const {
+        if (!(index(_nmx, _mmx) < int(Csize) &&
+              index(_nmx, _mmx) < int(Ssize) + (_nNx + 1)))
+          throw GeographicErr("Arrays too small in coeff");
+      }
+      // Elements of C and S held as reals, as floats, or interleaved; these
+      // don't check how the coefficients are held.
+      real Cr(int k) const { return *(_cCnm + k); }
+      real Cf(int k) const { return real(*(_cCf + k)); }
+      real Ci(int k) const { return *(_cCSnm + 2 * k); }
+      real Sr(int k) const { return *(_sSnm + (k - (_nNx + 1))); }
+      real Sf(int k) const { return real(*(_sSf + (k - (_nNx + 1)))); }
+      real Si(int k) const { return *(_cCSnm + 2 * k + 1); }
     public:
       /**
        * A default constructor
        **********************************************************************/
-      coeff() : _nNx(-1) , _nmx(-1) , _mmx(-1) {}
+      coeff() : _nNx(-1) , _nmx(-1) , _mmx(-1)
+              , _cCnm(nullptr), _sSnm(nullptr)
+              , _cCf(nullptr), _sSf(nullptr), _cCSnm(nullptr) {}
       /**
        * The general constructor.
        *
@@ -127,16 +173,45 @@ namespace GeographicLib {
         : _nNx(N)
         , _nmx(nmx)
         , _mmx(mmx)
-        , _cCnm(C.begin())
-        , _sSnm(S.begin())
+        , _cCnm(C.data())
+        , _sSnm(S.data())
+        , _cCf(nullptr)
+        , _sSf(nullptr)
+        , _cCSnm(nullptr)
       {
-        if (!((_nNx >= _nmx && _nmx >= _mmx && _mmx >= 0) ||
-              // If mmx = -1 then the sums are empty so require nmx = -1 also.
-              (_nmx == -1 && _mmx == -1)))
-          throw GeographicErr("Bad indices for coeff");
-        if (!(index(_nmx, _mmx) < int(C.size()) &&
-              index(_nmx, _mmx) < int(S.size()) + (_nNx + 1)))
-          throw GeographicErr("Arrays too small in coeff");
+        Check();
+        CheckSize(C.size(), S.size());
+        SphericalEngine::RootTable(_nmx);
+      }
+      /**
+       * The general constructor for coefficients held in arrays.
+       *
+       * @param[in] C an array of coefficients for the cosine terms.
+       * @param[in] S an array of coefficients for the sine terms.
+       * @param[in] N the degree giving storage layout for \e C and \e S.
+       * @param[in] nmx the maximum degree to be used.
+       * @param[in] mmx the maximum order to be used.
+       * @exception GeographicErr if \e N, \e nmx, and \e mmx do not satisfy
+       *   \e N &ge; \e nmx &ge; \e mmx &ge; &minus;1.
+       * @exception std::bad_alloc if the memory for the square root table
+       *   can't be allocated.
+       *
+       * This allows the coefficients to be supplied from storage other than a
+       * std::vector, e.g., a memory mapped file.  \e C and \e S must contain
+       * at least Csize(\e nmx, \e mmx) and Ssize(\e nmx, \e mmx) elements,
+       * respectively, laid out with degree \e N; this is not checked.
+       **********************************************************************/
+      coeff(const real* C, const real* S, int N, int nmx, int mmx)
+        : _nNx(N)
+        , _nmx(nmx)
+        , _mmx(mmx)
+        , _cCnm(C)
+        , _sSnm(S)
+        , _cCf(nullptr)
+        , _sSf(nullptr)
+        , _cCSnm(nullptr)
+      {
+        Check();
         SphericalEngine::RootTable(_nmx);
       }
       /**
@@ -157,16 +232,138 @@ namespace GeographicLib {
         : _nNx(N)
         , _nmx(N)
         , _mmx(N)
-        , _cCnm(C.begin())
-        , _sSnm(S.begin())
+        , _cCnm(C.data())
+        , _sSnm(S.data())
+        , _cCf(nullptr)
+        , _sSf(nullptr)
+        , _cCSnm(nullptr)
       {
         if (!(_nNx >= -1))
           throw GeographicErr("Bad indices for coeff");
-        if (!(index(_nmx, _mmx) < int(C.size()) &&
-              index(_nmx, _mmx) < int(S.size()) + (_nNx + 1)))
-          throw GeographicErr("Arrays too small in coeff");
+        CheckSize(C.size(), S.size());
         SphericalEngine::RootTable(_nmx);
       }
+#if GEOGRAPHICLIB_PRECISION != 1
+      /**
+       * The general constructor for coefficients held as floats.
+       *
+       * @param[in] C a vector of coefficients for the cosine terms.
+       * @param[in] S a vector of coefficients for the sine terms.
+       * @param[in] N the degree giving storage layout for \e C and \e S.
+       * @param[in] nmx the maximum degree to be used.
+       * @param[in] mmx the maximum order to be used.
+       * @exception GeographicErr if \e N, \e nmx, and \e mmx do not satisfy
+       *   \e N &ge; \e nmx &ge; \e mmx &ge; &minus;1.
+       * @exception GeographicErr if \e C or \e S is not big enough to hold the
+       *   coefficients.
+       * @exception std::bad_alloc if the memory for the square root table
+       *   can't be allocated.
+       *
+       * The coefficients are converted to Math::real as they are used.  (If
+       * Math::real is float, this is the same as the constructor for vectors
+       * of Math::real.)
+       **********************************************************************/
+      coeff(const std::vector<float>& C,
+            const std::vector<float>& S,
+            int N, int nmx, int mmx)
+        : _nNx(N)
+        , _nmx(nmx)
+        , _mmx(mmx)
+        , _cCnm(nullptr)
+        , _sSnm(nullptr)
+        , _cCf(C.data())
+        , _sSf(S.data())
+        , _cCSnm(nullptr)
+      {
+        Check();
+        CheckSize(C.size(), S.size());
+        SphericalEngine::RootTable(_nmx);
+      }
+      /**
+       * The general constructor for coefficients held as floats in arrays.
+       *
+       * @param[in] C an array of coefficients for the cosine terms.
+       * @param[in] S an array of coefficients for the sine terms.
+       * @param[in] N the degree giving storage layout for \e C and \e S.
+       * @param[in] nmx the maximum degree to be used.
+       * @param[in] mmx the maximum order to be used.
+       * @exception GeographicErr if \e N, \e nmx, and \e mmx do not satisfy
+       *   \e N &ge; \e nmx &ge; \e mmx &ge; &minus;1.
+       * @exception std::bad_alloc if the memory for the square root table
+       *   can't be allocated.
+       *
+       * As for the constructor for arrays of Math::real, the sizes of \e C
+       * and \e S are not checked.
+       **********************************************************************/
+      coeff(const float* C, const float* S, int N, int nmx, int mmx)
+        : _nNx(N)
+        , _nmx(nmx)
+        , _mmx(mmx)
+        , _cCnm(nullptr)
+        , _sSnm(nullptr)
+        , _cCf(C)
+        , _sSf(S)
+        , _cCSnm(nullptr)
+      {
+        Check();
+        SphericalEngine::RootTable(_nmx);
+      }
+#endif
+      /**
+       * The general constructor for interleaved coefficients.
+       *
+       * @param[in] CS a vector of the interleaved coefficients for the cosine
+       *   and sine terms.
+       * @param[in] N the degree giving storage layout for \e CS.
+       * @param[in] nmx the maximum degree to be used.
+       * @param[in] mmx the maximum order to be used.
+       * @exception GeographicErr if \e N, \e nmx, and \e mmx do not satisfy
+       *   \e N &ge; \e nmx &ge; \e mmx &ge; &minus;1.
+       * @exception GeographicErr if \e CS is not big enough to hold the
+       *   coefficients.
+       * @exception std::bad_alloc if the memory for the square root table
+       *   can't be allocated.
+       *
+       * \e CS is usually set by interleave.
+       **********************************************************************/
+      coeff(const std::vector<real>& CS, int N, int nmx, int mmx)
+        : _nNx(N)
+        , _nmx(nmx)
+        , _mmx(mmx)
+        , _cCnm(nullptr)
+        , _sSnm(nullptr)
+        , _cCf(nullptr)
+        , _sSf(nullptr)
+        , _cCSnm(CS.data())
+      {
+        Check();
+        CheckSize(CS.size() / 2, CS.size() / 2);
+        SphericalEngine::RootTable(_nmx);
+      }
+      /**
+       * Interleave the coefficients for the cosine and sine terms.
+       *
+       * @param[in] C a vector of coefficients for the cosine terms.
+       * @param[in] S a vector of coefficients for the sine terms.
+       * @param[in] N the degree giving storage layout for \e C and \e S.
+       * @param[in] M the maximum order of the coefficients.
+       * @param[out] CS the vector of interleaved coefficients.
+       * @exception GeographicErr if \e N and \e M do not satisfy \e N &ge;
+       *   \e M &ge; &minus;1.
+       * @exception GeographicErr if \e C or \e S is not big enough to hold the
+       *   coefficients.
+       * @exception std::bad_alloc if the memory for \e CS can't be
+       *   allocated.
+       *
+       * \e CS is resized to 2 Csize(\e N, \e M) and the element of \e C
+       * with index \e k is placed at 2\e k and the corresponding element of
+       * \e S at 2\e k + 1; the entries for <i>S</i><sub><i>n</i>0</sub> are
+       * set to zero.  This doubles the storage needed for the \e m = 0
+       * terms, a negligible amount for \e N > 1.
+       **********************************************************************/
+      static void interleave(const std::vector<real>& C,
+                             const std::vector<real>& S,
+                             int N, int M, std::vector<real>& CS);
       /**
        * @return \e N the degree giving storage layout for \e C and \e S.
        **********************************************************************/
@@ -179,6 +376,35 @@ namespace GeographicLib {
        * @return \e mmx the maximum order to be used.
        **********************************************************************/
       int mmx() const { return _mmx; }
+      /**
+       * @return true if the coefficients are held as floats.
+       **********************************************************************/
+      bool Single() const { return !_cCnm && _cCf; }
+      /**
+       * @return true if the coefficients are interleaved.
+       **********************************************************************/
+      bool Interleaved() const { return !_cCnm && !_cCf && _cCSnm; }
+      /**
+       * Truncate the sums.
+       *
+       * @param[in] nmx the maximum degree to be used.
+       * @param[in] mmx the maximum order to be used.
+       * @exception GeographicErr if \e nmx and \e mmx are such that the
+       *   resulting maximum degree and order are not valid.
+       * @return a coeff object which refers to the same coefficients with
+       *   the maximum degree and order reduced to at most \e nmx and \e mmx.
+       *
+       * No data is copied, so the storage for the coefficients must outlive
+       * the returned object.
+       **********************************************************************/
+      coeff Truncate(int nmx, int mmx) const {
+        nmx = (std::min)(nmx, _nmx);
+        mmx = (std::min)((std::min)(mmx, _mmx), nmx);
+        coeff c(*this);
+        c._nmx = nmx; c._mmx = mmx;
+        c.Check();
+        return c;
+      }
       /**
        * The one-dimensional index into \e C and \e S.
        *
@@ -194,14 +420,16 @@ namespace GeographicLib {
        * @param[in] k the one-dimensional index.
        * @return the value of the \e C coefficient.
        **********************************************************************/
-      Math::real Cv(int k) const { return *(_cCnm + k); }
+      Math::real Cv(int k) const
+      { return _cCnm ? Cr(k) : _cCf ? Cf(k) : Ci(k); }
       /**
        * An element of \e S.
        *
        * @param[in] k the one-dimensional index.
        * @return the value of the \e S coefficient.
        **********************************************************************/
-      Math::real Sv(int k) const { return *(_sSnm + (k - (_nNx + 1))); }
+      Math::real Sv(int k) const
+      { return _cCnm ? Sr(k) : _cCf ? Sf(k) : Si(k); }
       /**
        * An element of \e C with checking.
        *
@@ -213,7 +441,7 @@ namespace GeographicLib {
        *   and \e m are in range else 0.
        **********************************************************************/
       Math::real Cv(int k, int n, int m, real f) const
-      { return m > _mmx || n > _nmx ? 0 : *(_cCnm + k) * f; }
+      { return m > _mmx || n > _nmx ? 0 : Cv(k) * f; }
       /**
        * An element of \e S with checking.
        *
@@ -225,7 +453,7 @@ namespace GeographicLib {
        *   and \e m are in range else 0.
        **********************************************************************/
       Math::real Sv(int k, int n, int m, real f) const
-      { return m > _mmx || n > _nmx ? 0 : *(_sSnm + (k - (_nNx + 1))) * f; }
+      { return m > _mmx || n > _nmx ? 0 : Sv(k) * f; }
 
       /**
        * The size of the coefficient vector for the cosine terms.
@@ -277,8 +505,88 @@ namespace GeographicLib {
       static void readcoeffs(std::istream& stream, int& N, int& M,
                              std::vector<real>& C, std::vector<real>& S,
                              bool truncate = false);
+#if GEOGRAPHICLIB_PRECISION != 1
+      /**
+       * Load coefficients from a binary stream storing them as floats.
+       *
+       * @param[in] stream the input stream.
+       * @param[in,out] N The maximum degree of the coefficients.
+       * @param[in,out] M The maximum order of the coefficients.
+       * @param[out] C The vector of cosine coefficients.
+       * @param[out] S The vector of sine coefficients.
+       * @param[in] truncate if false (the default) then \e N and \e M are
+       *   determined by the values in the binary stream; otherwise, the input
+       *   values of \e N and \e M are used to truncate the coefficients read
+       *   from the stream at the given degree and order.
+       * @exception GeographicErr if \e N and \e M do not satisfy \e N &ge;
+       *   \e M &ge; &minus;1.
+       * @exception GeographicErr if there's an error reading the data.
+       * @exception std::bad_alloc if the memory for \e C or \e S can't be
+       *   allocated.
+       *
+       * This is the same as the previous function except that the 8-byte
+       * doubles in the stream are rounded to floats.
+       **********************************************************************/
+      static void readcoeffs(std::istream& stream, int& N, int& M,
+                             std::vector<float>& C, std::vector<float>& S,
+                             bool truncate = false);
+#endif
     };
 
+  private:
+    // How the coefficients c[0..L-1] are held: all as reals, all as floats,
+    // all interleaved, or a mixture.  This is made a template parameter of
+    // InnerSum so that it's not tested for every coefficient.
+    enum storage { REALS, FLOATS, INTERLEAVED, MIXED };
+    template<int L> static storage Storage(const coeff c[]) {
+      int nsingle = 0, ninter = 0;
+      for (int l = 0; l < L; ++l) {
+        nsingle += c[l].Single() ? 1 : 0;
+        ninter += c[l].Interleaved() ? 1 : 0;
+      }
+      return nsingle == L ? FLOATS : ninter == L ? INTERLEAVED :
+        nsingle + ninter == 0 ? REALS : MIXED;
+    }
+    template<storage stor> static real Cv(const coeff& c, int k) {
+      return stor == REALS ? c.Cr(k) : stor == FLOATS ? c.Cf(k) :
+        stor == INTERLEAVED ? c.Ci(k) : c.Cv(k);
+    }
+    template<storage stor> static real Sv(const coeff& c, int k) {
+      return stor == REALS ? c.Sr(k) : stor == FLOATS ? c.Sf(k) :
+        stor == INTERLEAVED ? c.Si(k) : c.Sv(k);
+    }
+    template<storage stor>
+    static real Cv(const coeff& c, int k, int n, int m, real f)
+    { return m > c.mmx() || n > c.nmx() ? 0 : Cv<stor>(c, k) * f; }
+    template<storage stor>
+    static real Sv(const coeff& c, int k, int n, int m, real f)
+    { return m > c.mmx() || n > c.nmx() ? 0 : Sv<stor>(c, k) * f; }
+    // The inner (over n) Clenshaw sums for order m.  Set w[0..5] to the sums
+    // for the cosine and sine terms: wc, ws, wrc, wrs, wtc, wts.
+    template<bool gradp, normalization norm, int L, storage stor>
+      static void InnerSum(const coeff c[], const real f[], int m,
+                           real q, real q2, real t, real u, real w[]);
+    template<bool gradp, normalization norm, storage stor>
+    static void Sums(int K, const coeff c[],
+                     real x, real y, real z, real a, real V[],
+                     real gradx[], real grady[], real gradz[]);
+    template<bool gradp, normalization norm, int L>
+    static void InnerSum(storage stor, const coeff c[], const real f[], int m,
+                         real q, real q2, real t, real u, real w[]) {
+      switch (stor) {
+      case REALS:
+        InnerSum<gradp, norm, L, REALS> (c, f, m, q, q2, t, u, w); break;
+      case FLOATS:
+        InnerSum<gradp, norm, L, FLOATS>(c, f, m, q, q2, t, u, w); break;
+      case INTERLEAVED:
+        InnerSum<gradp, norm, L, INTERLEAVED>
+          (c, f, m, q, q2, t, u, w); break;
+      default:
+        InnerSum<gradp, norm, L, MIXED> (c, f, m, q, q2, t, u, w); break;
+      }
+    }
+  public:
+
     /**
      * Evaluate a spherical harmonic sum and its gradient.
      *
@@ -307,12 +615,96 @@ namespace GeographicLib {
      * Clenshaw summation is used which permits the evaluation of the sum
      * without the need to allocate temporary arrays.  Thus this function never
      * throws an exception.
+     *
+     * If set_threads() has been called with \e nthreads &gt; 1, high degree
+     * sums are evaluated in parallel (the inner sums over \e n for the
+     * various orders \e m are computed concurrently, followed by the outer
+     * sum over \e m).  The result is identical to that of the serial
+     * evaluation.  If the threads cannot be started, the sum is evaluated
+     * serially.
      **********************************************************************/
     template<bool gradp, normalization norm, int L>
       static Math::real Value(const coeff c[], const real f[],
                               real x, real y, real z, real a,
                               real& gradx, real& grady, real& gradz);
 
+    /**
+     * Evaluate a spherical harmonic sum and its gradient at several points.
+     *
+     * @tparam gradp should the gradient be calculated.
+     * @tparam norm the normalization for the associated Legendre polynomials.
+     * @tparam L the number of terms in the coefficients.
+     * @param[in] c an array of coeff objects.
+     * @param[in] f array of coefficient multipliers.  f[0] should be 1.
+     * @param[in] n the number of points.
+     * @param[in] x the \e x components of the cartesian positions.
+     * @param[in] y the \e y components of the cartesian positions.
+     * @param[in] z the \e z components of the cartesian positions.
+     * @param[in] a the normalizing radius.
+     * @param[out] V the spherical harmonic sums.
+     * @param[out] gradx the \e x components of the gradients.
+     * @param[out] grady the \e y components of the gradients.
+     * @param[out] gradz the \e z components of the gradients.
+     *
+     * This is equivalent to calling Value for each of the \e n points; the
+     * results are identical.  However, the points are processed in groups of
+     * SphericalEngine::lanes so that each coefficient is loaded once per
+     * group of points instead of once per point.  For high degree models,
+     * this substantially reduces the memory traffic.  If \e gradp is false,
+     * \e gradx, \e grady, and \e gradz are not referenced and may be null.
+     * The output arrays may coincide with the input arrays.  This function
+     * never throws an exception.  The sums are always evaluated serially,
+     * i.e., set_threads() does not apply to this function.
+     **********************************************************************/
+    template<bool gradp, normalization norm, int L>
+      static void Values(const coeff c[], const real f[], size_t n,
+                         const real x[], const real y[], const real z[],
+                         real a, real V[],
+                         real gradx[], real grady[], real gradz[]);
+
+    /**
+     * The number of points handled together by Values.
+     **********************************************************************/
+    static const int lanes = 8;
+
+    /**
+     * Evaluate several spherical harmonic sums and their gradients at a
+     * point.
+     *
+     * @tparam gradp should the gradients be calculated.
+     * @tparam norm the normalization for the associated Legendre polynomials.
+     * @param[in] K the number of sums.
+     * @param[in] c an array of \e K coeff objects, one for each sum.
+     * @param[in] x the \e x component of the cartesian position.
+     * @param[in] y the \e y component of the cartesian position.
+     * @param[in] z the \e z component of the cartesian position.
+     * @param[in] a the normalizing radius.
+     * @param[out] V the \e K spherical harmonic sums.
+     * @param[out] gradx the \e x components of the \e K gradients.
+     * @param[out] grady the \e y components of the \e K gradients.
+     * @param[out] gradz the \e z components of the \e K gradients.
+     * @exception std::bad_alloc if the memory for the state of the sums
+     *   can't be allocated.
+     *
+     * Element \e j of the results is the same as given by Value<\e gradp,
+     * \e norm, 1>(&\e c[\e j], ...); the results are identical.  Each sum
+     * has its own degree and order.  However the factors in the recurrences
+     * for the associated Legendre functions and the trigonometric terms
+     * depend only on the position, the degree, and the order; these are
+     * computed once and are shared by all the sums.  This is useful for
+     * evaluating several models with the same normalizing radius and
+     * normalization, e.g., the models for different epochs of a magnetic
+     * model or several different magnetic models (see
+     * MagneticModel::Ensemble).  If \e gradp is false, \e gradx, \e grady,
+     * and \e gradz are not referenced and may be null.  The sums are always
+     * evaluated serially, i.e., set_threads() does not apply to this
+     * function.
+     **********************************************************************/
+    template<bool gradp, normalization norm>
+      static void Sums(int K, const coeff c[],
+                       real x, real y, real z, real a, real V[],
+                       real gradx[], real grady[], real gradz[]);
+
     /**
      * Create a CircularEngine object
      *
@@ -339,6 +731,57 @@ namespace GeographicLib {
     template<bool gradp, normalization norm, int L>
       static CircularEngine Circle(const coeff c[], const real f[],
                                    real p, real z, real a);
+
+    /**
+     * Create several CircularEngine objects.
+     *
+     * @tparam gradp should the gradient be calculated.
+     * @tparam norm the normalization for the associated Legendre polynomials.
+     * @tparam L the number of terms in the coefficients.
+     * @param[in] c an array of coeff objects.
+     * @param[in] f array of coefficient multipliers.  f[0] should be 1.
+     * @param[in] n the number of circles.
+     * @param[in] p the radii of the circles.
+     * @param[in] z the heights of the circles.
+     * @param[in] a the normalizing radius.
+     * @param[out] circ the \e n CircularEngine objects.
+     * @exception std::bad_alloc if the memory for the CircularEngine objects
+     *   can't be allocated.
+     *
+     * This is equivalent to setting \e circ[\e i] = Circle(\e c, \e f, \e
+     * p[\e i], \e z[\e i], \e a) for each \e i; the results agree to
+     * within roundoff.  However, as with Values, the circles are processed
+     * in groups of SphericalEngine::lanes.  The factors in the recurrence
+     * for the associated Legendre functions which depend only on the degree
+     * and order are then computed, and the coefficients are loaded, once per
+     * group instead of once per circle.  This is useful, for example, when a
+     * model is needed at a given latitude for several heights.
+     **********************************************************************/
+    template<bool gradp, normalization norm, int L>
+      static void Circles(const coeff c[], const real f[], size_t n,
+                          const real p[], const real z[], real a,
+                          CircularEngine circ[]);
+    /**
+     * Set the number of threads used by Value.
+     *
+     * @param[in] nthreads the number of threads; if \e nthreads &le; 1 (the
+     *   default), sums are evaluated serially.
+     *
+     * Only sums with at least 2<sup>15</sup> terms (e.g., degree and order
+     * 255 and above) are evaluated in parallel; each thread handles at least
+     * 32 orders.  This is a global setting and it may be changed at any time
+     * (including while other threads are calling Value).  It is useful for
+     * evaluating high degree models at a small number of points; when many
+     * points need to be evaluated, it is usually better to distribute the
+     * points among threads.
+     **********************************************************************/
+    static void set_threads(int nthreads);
+
+    /**
+     * @return the number of threads used by Value.
+     **********************************************************************/
+    static int threads();
+
     /**
      * Check that the static table of square roots is big enough and enlarge it
      * if necessary.
@@ -348,18 +791,29 @@ namespace GeographicLib {
      *   be allocated.
      *
      * Typically, there's no need for an end-user to call this routine, because
-     * the constructors for SphericalEngine::coeff do so.  However, since this
-     * updates a static table, there's a possible race condition in a
-     * multi-threaded environment.  Because this routine does nothing if the
-     * table is already large enough, one way to avoid race conditions is to
-     * call this routine at program start up (when it's still single threaded),
-     * supplying the largest degree that your program will use.  E.g., \code
+     * the constructors for SphericalEngine::coeff do so.  This routine is
+     * thread safe: the table is enlarged by publishing a larger copy through
+     * an atomic pointer (under a lock) and the tables seen by other threads,
+     * which may be evaluating sums, are never modified or freed.  So models
+     * of different degrees may be constructed concurrently and the sums take
+     * no locks.  Calling this routine at program start up, e.g., \code
      GeographicLib::SphericalEngine::RootTable(2190);
      \endcode
-     * suffices to accommodate extant magnetic and gravity models.
+     * (which suffices to accommodate extant magnetic and gravity models),
+     * avoids the (small) memory overhead of enlarging the table several
+     * times.
      **********************************************************************/
     static void RootTable(int N);
 
+    /**
+     * @return the memory (in bytes) used by the static table of square roots,
+     *   including the superseded tables retained by RootTable.
+     *
+     * This table is shared by all the spherical harmonic sums, e.g., those
+     * of GravityModel and MagneticModel.
+     **********************************************************************/
+    static size_t RootTableBytes();
+
     /**
      * Clear the static table of square roots and release the memory.  Call
      * this only when you are sure you no longer will be using SphericalEngine.
@@ -367,12 +821,10 @@ namespace GeographicLib {
      * routine.
      *
      * \warning It's safest not to call this routine at all.  (The space used
-     * by the table is modest.)
+     * by the table is modest.)  This routine is not thread safe with respect
+     * to concurrent evaluations of sums.
      **********************************************************************/
-    static void ClearRootTable() {
-      std::vector<real> temp(0);
-      sqrttable().swap(temp);
-    }
+    static void ClearRootTable();
   };
 
 } // namespace GeographicLib
@@ -205,6 +205,25 @@ namespace GeographicLib {
       , _norm(norm)
     { _c[0] = SphericalEngine::coeff(C, S, N, nmx, mmx); }
 
+    /**
+     * Constructor with the coefficients packaged as a SphericalEngine::coeff.
+     *
+     * @param[in] c the coefficients.
+     * @param[in] a the reference radius appearing in the definition of the
+     *   sum.
+     * @param[in] norm the normalization for the associated Legendre
+     *   polynomials, either SphericalHarmonic::FULL (the default) or
+     *   SphericalHarmonic::SCHMIDT.
+     *
+     * The coefficients referenced by \e c should not be altered or destroyed
+     * during the lifetime of a SphericalHarmonic object.
+     **********************************************************************/
+    SphericalHarmonic(const SphericalEngine::coeff& c,
+                      real a, unsigned norm = FULL)
+      : _a(a)
+      , _norm(norm)
+    { _c[0] = c; }
+
     /**
      * A default constructor so that the object can be created when the
      * constructor for another object is initialized.  This default object can
@@ -275,6 +294,69 @@ namespace GeographicLib {
       return v;
     }
 
+    /**
+     * Compute the spherical harmonic sum at several points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] x the cartesian \e x coordinates.
+     * @param[in] y the cartesian \e y coordinates.
+     * @param[in] z the cartesian \e z coordinates.
+     * @param[out] v the spherical harmonic sums.
+     *
+     * This is equivalent to calling operator()(real, real, real) for each
+     * point (and the results are identical), but it is faster for high
+     * degree sums because the coefficients are loaded once for several
+     * points; see SphericalEngine::Values.  The output array may coincide
+     * with one of the input arrays.  This routine never throws an exception.
+     **********************************************************************/
+    void operator()(size_t n, const real x[], const real y[], const real z[],
+                    real v[]) const {
+      real f[] = {1};
+      switch (_norm) {
+      case FULL:
+        SphericalEngine::Values<false, SphericalEngine::FULL, 1>
+          (_c, f, n, x, y, z, _a, v, NULL, NULL, NULL);
+        break;
+      case SCHMIDT:
+      default:                  // To avoid compiler warnings
+        SphericalEngine::Values<false, SphericalEngine::SCHMIDT, 1>
+          (_c, f, n, x, y, z, _a, v, NULL, NULL, NULL);
+        break;
+      }
+    }
+
+    /**
+     * Compute a spherical harmonic sum and its gradient at several points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] x the cartesian \e x coordinates.
+     * @param[in] y the cartesian \e y coordinates.
+     * @param[in] z the cartesian \e z coordinates.
+     * @param[out] v the spherical harmonic sums.
+     * @param[out] gradx the \e x components of the gradients.
+     * @param[out] grady the \e y components of the gradients.
+     * @param[out] gradz the \e z components of the gradients.
+     *
+     * This is the same as the previous function, except that the components of
+     * the gradients of the sums are also computed.
+     **********************************************************************/
+    void operator()(size_t n, const real x[], const real y[], const real z[],
+                    real v[], real gradx[], real grady[], real gradz[])
+      const {
+      real f[] = {1};
+      switch (_norm) {
+      case FULL:
+        SphericalEngine::Values<true, SphericalEngine::FULL, 1>
+          (_c, f, n, x, y, z, _a, v, gradx, grady, gradz);
+        break;
+      case SCHMIDT:
+      default:                  // To avoid compiler warnings
+        SphericalEngine::Values<true, SphericalEngine::SCHMIDT, 1>
+          (_c, f, n, x, y, z, _a, v, gradx, grady, gradz);
+        break;
+      }
+    }
+
     /**
      * Create a CircularEngine to allow the efficient evaluation of several
      * points on a circle of latitude.
@@ -346,6 +428,47 @@ namespace GeographicLib {
       }
     }
 
+    /**
+     * Create CircularEngine objects for several circles of latitude.
+     *
+     * @param[in] n the number of circles.
+     * @param[in] p the radii of the circles.
+     * @param[in] z the heights of the circles above the equatorial plane.
+     * @param[in] gradp if true the returned objects will be able to compute
+     *   the gradient of the sum.
+     * @param[out] circ the \e n CircularEngine objects.
+     * @exception std::bad_alloc if the memory for the CircularEngine objects
+     *   can't be allocated.
+     *
+     * This sets \e circ[\e i] = Circle(\e p[\e i], \e z[\e i], \e
+     * gradp) for each \e i (and the results agree to within roundoff), but
+     * it is faster because the work which depends only on the degree and
+     * order is shared by several circles; see SphericalEngine::Circles.
+     **********************************************************************/
+    void Circles(size_t n, const real p[], const real z[], bool gradp,
+                 CircularEngine circ[]) const {
+      real f[] = {1};
+      switch (_norm) {
+      case FULL:
+        if (gradp)
+          SphericalEngine::Circles<true, SphericalEngine::FULL, 1>
+            (_c, f, n, p, z, _a, circ);
+        else
+          SphericalEngine::Circles<false, SphericalEngine::FULL, 1>
+            (_c, f, n, p, z, _a, circ);
+        break;
+      case SCHMIDT:
+      default:                  // To avoid compiler warnings
+        if (gradp)
+          SphericalEngine::Circles<true, SphericalEngine::SCHMIDT, 1>
+            (_c, f, n, p, z, _a, circ);
+        else
+          SphericalEngine::Circles<false, SphericalEngine::SCHMIDT, 1>
+            (_c, f, n, p, z, _a, circ);
+        break;
+      }
+    }
+
     /**
      * @return the zeroth SphericalEngine::coeff object.
      **********************************************************************/
@@ -148,6 +148,38 @@ namespace GeographicLib {
       _c[1] = SphericalEngine::coeff(C1, S1, N1, nmx1, mmx1);
     }
 
+    /**
+     * Constructor with the coefficients packaged as SphericalEngine::coeff
+     * objects.
+     *
+     * @param[in] c the coefficients <i>C</i><sub><i>nm</i></sub> and
+     *   <i>S</i><sub><i>nm</i></sub>.
+     * @param[in] c1 the coefficients <i>C'</i><sub><i>nm</i></sub> and
+     *   <i>S'</i><sub><i>nm</i></sub>.
+     * @param[in] a the reference radius appearing in the definition of the
+     *   sum.
+     * @param[in] norm the normalization for the associated Legendre
+     *   polynomials, either SphericalHarmonic1::FULL (the default) or
+     *   SphericalHarmonic1::SCHMIDT.
+     * @exception GeographicErr if \e c1 has a larger maximum degree or order
+     *   than \e c.
+     *
+     * The coefficients referenced by \e c and \e c1 should not be altered or
+     * destroyed during the lifetime of a SphericalHarmonic1 object.
+     **********************************************************************/
+    SphericalHarmonic1(const SphericalEngine::coeff& c,
+                       const SphericalEngine::coeff& c1,
+                       real a, unsigned norm = FULL)
+      : _a(a)
+      , _norm(norm) {
+      if (!(c1.nmx() <= c.nmx()))
+        throw GeographicErr("nmx1 cannot be larger that nmx");
+      if (!(c1.mmx() <= c.mmx()))
+        throw GeographicErr("mmx1 cannot be larger that mmx");
+      _c[0] = c;
+      _c[1] = c1;
+    }
+
     /**
      * A default constructor so that the object can be created when the
      * constructor for another object is initialized.  This default object can
@@ -266,6 +298,49 @@ namespace GeographicLib {
       }
     }
 
+    /**
+     * Create CircularEngine objects for several circles of latitude.
+     *
+     * @param[in] tau multiplier for correction coefficients \e C' and \e S'.
+     * @param[in] n the number of circles.
+     * @param[in] p the radii of the circles.
+     * @param[in] z the heights of the circles above the equatorial plane.
+     * @param[in] gradp if true the returned objects will be able to compute
+     *   the gradient of the sum.
+     * @param[out] circ the \e n CircularEngine objects.
+     * @exception std::bad_alloc if the memory for the CircularEngine objects
+     *   can't be allocated.
+     *
+     * This sets \e circ[\e i] = Circle(\e tau, \e p[\e i], \e z[\e i], \e
+     * gradp) for each \e i (and the results agree to within roundoff), but
+     * it is faster because the work which depends only on the degree and
+     * order is shared by several circles; see SphericalEngine::Circles.
+     **********************************************************************/
+    void Circles(real tau, size_t n,
+                 const real p[], const real z[], bool gradp,
+                 CircularEngine circ[]) const {
+      real f[] = {1, tau};
+      switch (_norm) {
+      case FULL:
+        if (gradp)
+          SphericalEngine::Circles<true, SphericalEngine::FULL, 2>
+            (_c, f, n, p, z, _a, circ);
+        else
+          SphericalEngine::Circles<false, SphericalEngine::FULL, 2>
+            (_c, f, n, p, z, _a, circ);
+        break;
+      case SCHMIDT:
+      default:                  // To avoid compiler warnings
+        if (gradp)
+          SphericalEngine::Circles<true, SphericalEngine::SCHMIDT, 2>
+            (_c, f, n, p, z, _a, circ);
+        else
+          SphericalEngine::Circles<false, SphericalEngine::SCHMIDT, 2>
+            (_c, f, n, p, z, _a, circ);
+        break;
+      }
+    }
+
     /**
      * @return the zeroth SphericalEngine::coeff object.
      **********************************************************************/
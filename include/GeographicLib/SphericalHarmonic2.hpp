@@ -298,6 +298,52 @@ namespace GeographicLib {
       }
     }
 
+    /**
+     * Create CircularEngine objects for several circles of latitude.
+     *
+     * @param[in] tau1 multiplier for correction coefficients \e C' and \e S'.
+     * @param[in] tau2 multiplier for correction coefficients \e C'' and
+     *   \e S''.
+     * @param[in] n the number of circles.
+     * @param[in] p the radii of the circles.
+     * @param[in] z the heights of the circles above the equatorial plane.
+     * @param[in] gradp if true the returned objects will be able to compute
+     *   the gradient of the sum.
+     * @param[out] circ the \e n CircularEngine objects.
+     * @exception std::bad_alloc if the memory for the CircularEngine objects
+     *   can't be allocated.
+     *
+     * This sets \e circ[\e i] = Circle(\e tau1, \e tau2, \e p[\e i], \e
+     * z[\e i], \e gradp) for each \e i (and the results agree to within
+     * roundoff), but it is faster because the work which depends only on the
+     * degree and order is shared by several circles; see
+     * SphericalEngine::Circles.
+     **********************************************************************/
+    void Circles(real tau1, real tau2, size_t n,
+                 const real p[], const real z[], bool gradp,
+                 CircularEngine circ[]) const {
+      real f[] = {1, tau1, tau2};
+      switch (_norm) {
+      case FULL:
+        if (gradp)
+          SphericalEngine::Circles<true, SphericalEngine::FULL, 3>
+            (_c, f, n, p, z, _a, circ);
+        else
+          SphericalEngine::Circles<false, SphericalEngine::FULL, 3>
+            (_c, f, n, p, z, _a, circ);
+        break;
+      case SCHMIDT:
+      default:                  // To avoid compiler warnings
+        if (gradp)
+          SphericalEngine::Circles<true, SphericalEngine::SCHMIDT, 3>
+            (_c, f, n, p, z, _a, circ);
+        else
+          SphericalEngine::Circles<false, SphericalEngine::SCHMIDT, 3>
+            (_c, f, n, p, z, _a, circ);
+        break;
+      }
+    }
+
     /**
      * @return the zeroth SphericalEngine::coeff object.
      **********************************************************************/
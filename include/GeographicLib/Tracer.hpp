@@ -0,0 +1,158 @@
+/**
+ * \file Tracer.hpp
+ * \brief Header for GeographicLib::Tracer class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_TRACER_HPP)
+#define GEOGRAPHICLIB_TRACER_HPP 1
+
+#include <GeographicLib/Constants.hpp>
+
+#if !defined(GEOGRAPHICLIB_TRACE)
+/**
+ * Whether the library reports spans to the Tracer.  This is set by the
+ * cmake option of the same name.  See Tracer.
+ **********************************************************************/
+#  define GEOGRAPHICLIB_TRACE 0
+#endif
+
+namespace GeographicLib {
+
+  /**
+   * \brief The interface used to trace the expensive operations
+   *
+   * If the library is built with the cmake option GEOGRAPHICLIB_TRACE = ON,
+   * the operations which read files or build large data structures report
+   * their start and end to the Tracer given to Tracer::Set; these spans
+   * can then be passed on to a profiler.  The spans are
+   * - "Geoid::Geoid", opening a geoid file and reading its header;
+   * - "Geoid::readtile", reading a tile of a thread safe Geoid;
+   * - "Geoid::fillcache", filling the cache of a Geoid (Geoid::CacheArea,
+   *   Geoid::CacheAddArea, and Geoid::CacheAll);
+   * - "GravityModel::GravityModel" and "MagneticModel::MagneticModel",
+   *   loading a model;
+   * - "GravityModel::ReadMetadata" and "MagneticModel::ReadMetadata",
+   *   reading the metadata file of a model;
+   * - "SphericalEngine::coeff::readcoeffs", reading a set of spherical
+   *   harmonic coefficients;
+   * - "NearestNeighbor::build", building the vantage-point tree for
+   *   NearestNeighbor::Initialize or NearestNeighbor::Rebuild.
+   *
+   * The \e detail argument of Tracer::Begin gives the file name (the
+   * model name for the model spans), where there is one, and is otherwise
+   * null.  The spans on a given thread are properly nested; spans may be
+   * reported concurrently on several threads (e.g., with
+   * GravityModel::Load), so the Tracer must be thread safe.
+   *
+   * By default, GEOGRAPHICLIB_TRACE = OFF and the library contains no
+   * tracing code; Tracer::Set may still be called but it has no effect.
+   *
+   * Here are adapters for Intel's ITT API and Perfetto:
+   * \code
+   *   class ITTTracer : public GeographicLib::Tracer {
+   *     __itt_domain* _domain = __itt_domain_create("GeographicLib");
+   *   public:
+   *     void Begin(const char* name, const char*) override {
+   *       __itt_task_begin(_domain, __itt_null, __itt_null,
+   *                        __itt_string_handle_create(name));
+   *     }
+   *     void End(const char*) override { __itt_task_end(_domain); }
+   *   };
+   *
+   *   class PerfettoTracer : public GeographicLib::Tracer {
+   *   public:
+   *     void Begin(const char* name, const char* detail) override {
+   *       TRACE_EVENT_BEGIN("geographiclib", perfetto::DynamicString(name),
+   *                         "detail", detail ? detail : "");
+   *     }
+   *     void End(const char*) override {
+   *       TRACE_EVENT_END("geographiclib");
+   *     }
+   *   };
+   *
+   *   static ITTTracer itttracer;
+   *   GeographicLib::Tracer::Set(&itttracer);
+   * \endcode
+   **********************************************************************/
+  class GEOGRAPHICLIB_EXPORT Tracer {
+  public:
+    virtual ~Tracer() {}
+
+    /**
+     * Report the start of a span.
+     *
+     * @param[in] name the name of the span.
+     * @param[in] detail the file or model being read (or null).
+     *
+     * \e name is a string literal and so remains valid; \e detail is only
+     * valid during the call.  Implementations should not throw exceptions.
+     **********************************************************************/
+    virtual void Begin(const char* name, const char* detail) = 0;
+
+    /**
+     * Report the end of a span.
+     *
+     * @param[in] name the name of the span (the same as for the matching
+     *   call to Begin).
+     *
+     * This is called even if the operation throws an exception.
+     **********************************************************************/
+    virtual void End(const char* name) = 0;
+
+    /**
+     * @return the Tracer used by the library (null if there is none).
+     **********************************************************************/
+    static Tracer* Current();
+
+    /**
+     * Set the Tracer used by the library.
+     *
+     * @param[in] tracer a pointer to the Tracer; if it is null (the
+     *   default), stop tracing.
+     *
+     * \e tracer must remain valid until it is replaced and until any calls
+     * into the library which may use it have returned.
+     **********************************************************************/
+    static void Set(Tracer* tracer = nullptr);
+
+    /**
+     * @return true if the library was built with GEOGRAPHICLIB_TRACE = ON.
+     **********************************************************************/
+    static bool Enabled() { return GEOGRAPHICLIB_TRACE != 0; }
+
+    /**
+     * \brief A span reported to the current Tracer
+     *
+     * The constructor calls Tracer::Begin and the destructor calls
+     * Tracer::End.  If GEOGRAPHICLIB_TRACE = 0, this does nothing and is
+     * optimized away.
+     **********************************************************************/
+    class Span {
+    private:
+      Tracer* _tracer;
+      const char* _name;
+    public:
+      /**
+       * Start a span.
+       *
+       * @param[in] name the name of the span; this must be a string
+       *   literal.
+       * @param[in] detail the file or model being read (default null).
+       **********************************************************************/
+      explicit Span(const char* name, const char* detail = nullptr)
+        : _tracer(GEOGRAPHICLIB_TRACE ? Current() : nullptr)
+        , _name(name)
+      { if (_tracer) _tracer->Begin(_name, detail); }
+      ~Span() { if (_tracer) _tracer->End(_name); }
+      Span(const Span&) = delete;
+      Span& operator=(const Span&) = delete;
+    };
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_TRACER_HPP
@@ -102,6 +102,18 @@ namespace GeographicLib {
     // _alp[0] and _bet[0] unused
     real _a1, _b1, _alp[maxpow_ + 1], _bet[maxpow_ + 1];
     TransverseMercatorExact _tmexact;
+    // The projections; the convergence and scale are only computed if gk is
+    // true.
+    void GenForward(real lon0, real lat, real lon, bool gk,
+                    real& x, real& y, real& gamma, real& k) const;
+    void GenReverse(real lon0, real x, real y, bool gk,
+                    real& lat, real& lon, real& gamma, real& k) const;
+    // Sum the series with coefficients sgn * c[j] at xi + i*eta; see
+    // TransverseMercator.cpp.
+    static void Series(const real c[], real sgn, bool gk,
+                       real& xi, real& eta, real& gam, real& kap);
+    // Call work(b, e) for blocks [b, e) covering [0, n) on nthreads threads.
+    template<class F> static void Blocks(size_t n, int nthreads, F work);
   public:
 
     /**
@@ -161,22 +173,98 @@ namespace GeographicLib {
 
     /**
      * TransverseMercator::Forward without returning the convergence and scale.
+     * The calculation of the convergence and scale is skipped, which saves
+     * about a quarter of the time.
      **********************************************************************/
     void Forward(real lon0, real lat, real lon,
                  real& x, real& y) const {
       real gamma, k;
-      Forward(lon0, lat, lon, x, y, gamma, k);
+      GenForward(lon0, lat, lon, false, x, y, gamma, k);
     }
 
     /**
      * TransverseMercator::Reverse without returning the convergence and scale.
+     * The calculation of the convergence and scale is skipped.
      **********************************************************************/
     void Reverse(real lon0, real x, real y,
                  real& lat, real& lon) const {
       real gamma, k;
-      Reverse(lon0, x, y, lat, lon, gamma, k);
+      GenReverse(lon0, x, y, false, lat, lon, gamma, k);
     }
 
+    /**
+     * Forward projection of many points with a common central meridian.
+     *
+     * @param[in] lon0 central meridian of the projection (degrees).
+     * @param[in] n the number of points.
+     * @param[in] lat array of \e n latitudes (degrees).
+     * @param[in] lon array of \e n longitudes (degrees).
+     * @param[out] x array of \e n eastings (meters).
+     * @param[out] y array of \e n northings (meters).
+     * @param[out] gamma array of \e n meridian convergences (degrees); this
+     *   may be a null pointer.
+     * @param[out] k array of \e n scales; this may be a null pointer.
+     * @param[in] nthreads the number of threads to use (default 1).
+     *
+     * Element \e i of the output arrays is set to the result of
+     * TransverseMercator::Forward applied to element \e i of the input
+     * arrays.  The results are bitwise identical to the scalar function
+     * regardless of \e nthreads.  If \e gamma and \e k are both null
+     * pointers, their calculation is skipped.  With \e nthreads &gt; 1 the
+     * points are handled in blocks of 1024 which are distributed over the
+     * threads.  The input and output arrays must not overlap.
+     **********************************************************************/
+    void Forward(real lon0, size_t n, const real lat[], const real lon[],
+                 real x[], real y[], real gamma[] = nullptr,
+                 real k[] = nullptr, int nthreads = 1) const;
+
+    /**
+     * Reverse projection of many points with a common central meridian.
+     *
+     * @param[in] lon0 central meridian of the projection (degrees).
+     * @param[in] n the number of points.
+     * @param[in] x array of \e n eastings (meters).
+     * @param[in] y array of \e n northings (meters).
+     * @param[out] lat array of \e n latitudes (degrees).
+     * @param[out] lon array of \e n longitudes (degrees).
+     * @param[out] gamma array of \e n meridian convergences (degrees); this
+     *   may be a null pointer.
+     * @param[out] k array of \e n scales; this may be a null pointer.
+     * @param[in] nthreads the number of threads to use (default 1).
+     *
+     * Element \e i of the output arrays is set to the result of
+     * TransverseMercator::Reverse applied to element \e i of the input
+     * arrays.  The results are bitwise identical to the scalar function
+     * regardless of \e nthreads.  If \e gamma and \e k are both null
+     * pointers, their calculation is skipped.  The input and output arrays
+     * must not overlap.
+     **********************************************************************/
+    void Reverse(real lon0, size_t n, const real x[], const real y[],
+                 real lat[], real lon[], real gamma[] = nullptr,
+                 real k[] = nullptr, int nthreads = 1) const;
+
+    /**
+     * Transfer a point from one central meridian to another.
+     *
+     * @param[in] lon0in central meridian of the input projection (degrees).
+     * @param[in] xin easting of point in the input projection (meters).
+     * @param[in] yin northing of point in the input projection (meters).
+     * @param[in] lon0out central meridian of the output projection (degrees).
+     * @param[out] xout easting of point in the output projection (meters).
+     * @param[out] yout northing of point in the output projection (meters).
+     * @return the longitude of the point relative to \e lon0out (degrees).
+     *
+     * This is equivalent to TransverseMercator::Reverse with \e lon0in
+     * followed by TransverseMercator::Forward with \e lon0out, without
+     * returning the convergence and scale.  The conformal latitude is
+     * carried from one projection to the other, which skips the solution
+     * for the geographic latitude and its conversion back; as a result the
+     * output may differ from the two-step calculation by a few units in the
+     * last place.
+     **********************************************************************/
+    Math::real Transfer(real lon0in, real xin, real yin, real lon0out,
+                        real& xout, real& yout) const;
+
     /** \name Inspector functions
      **********************************************************************/
     ///@{
@@ -208,7 +296,8 @@ namespace GeographicLib {
     /**
      * A global instantiation of TransverseMercator with the WGS84 ellipsoid
      * and the UTM scale factor.  However, unlike UTM, no false easting or
-     * northing is added.
+     * northing is added.  See Geodesic::WGS84() for when this is
+     * constructed.
      **********************************************************************/
     static const TransverseMercator& UTM();
   };
@@ -103,7 +103,10 @@ namespace GeographicLib {
                  real& du, real& dv) const;
 
     bool zetainv0(real psi, real lam, real& u, real& v) const;
-    void zetainv(real taup, real lam, real& u, real& v) const;
+    // If seeded, u and v hold the starting guess.  Return the number of
+    // iterations.
+    int zetainv(real taup, real lam, real& u, real& v,
+                bool seeded = false) const;
 
     void sigma(real u, real snu, real cnu, real dnu,
                real v, real snv, real cnv, real dnv,
@@ -114,7 +117,8 @@ namespace GeographicLib {
                   real& du, real& dv) const;
 
     bool sigmainv0(real xi, real eta, real& u, real& v) const;
-    void sigmainv(real xi, real eta, real& u, real& v) const;
+    int sigmainv(real xi, real eta, real& u, real& v,
+                 bool seeded = false) const;
 
     void Scale(real tau, real lam,
                real snu, real cnu, real dnu,
@@ -227,6 +231,129 @@ namespace GeographicLib {
       Reverse(lon0, x, y, lat, lon, gamma, k);
     }
 
+    /**
+     * \brief The state used to speed up the projection of nearby points
+     *
+     * Each projection solves for the Thompson coordinates of the point by
+     * Newton's method.  A Hint records the solution for the previous point
+     * together with the derivative of the mapping there.  When the next point
+     * is nearby, this gives a starting guess which is accurate to second
+     * order in the separation, so Newton's method converges in 2 iterations
+     * instead of about 4.  A Hint may be used for calls to either Forward or
+     * Reverse (but only calls of the same type benefit).  A Hint must not be
+     * shared between threads.
+     **********************************************************************/
+    class Hint {
+    private:
+      friend class TransverseMercatorExact;
+      // _dir = 1 for Forward, -1 for Reverse, 0 if there's no data
+      int _dir, _iter;
+      real _s1, _s2, _u, _v, _du, _dv;
+    public:
+      /**
+       * Constructor for an empty Hint; this is used to start a sequence of
+       * points.
+       **********************************************************************/
+      Hint() : _dir(0), _iter(0) {}
+      /**
+       * @return the number of iterations of Newton's method used for the
+       *   last projection.
+       **********************************************************************/
+      int Iterations() const { return _iter; }
+    };
+
+    /**
+     * Forward projection using a Hint.
+     *
+     * @param[in] lon0 central meridian of the projection (degrees).
+     * @param[in] lat latitude of point (degrees).
+     * @param[in] lon longitude of point (degrees).
+     * @param[out] x easting of point (meters).
+     * @param[out] y northing of point (meters).
+     * @param[out] gamma meridian convergence at point (degrees).
+     * @param[out] k scale of projection at point.
+     * @param[in,out] hint the data from the previous projection which is
+     *   updated with the data for this point.
+     *
+     * This gives the same results as TransverseMercatorExact::Forward (to
+     * within roundoff), but is faster if successive points are close to one
+     * another (i.e., within a few tens of kilometers).  If the point is far
+     * from the previous one, the hint is ignored.
+     **********************************************************************/
+    void Forward(real lon0, real lat, real lon,
+                 real& x, real& y, real& gamma, real& k, Hint& hint) const;
+
+    /**
+     * Reverse projection using a Hint.
+     *
+     * @param[in] lon0 central meridian of the projection (degrees).
+     * @param[in] x easting of point (meters).
+     * @param[in] y northing of point (meters).
+     * @param[out] lat latitude of point (degrees).
+     * @param[out] lon longitude of point (degrees).
+     * @param[out] gamma meridian convergence at point (degrees).
+     * @param[out] k scale of projection at point.
+     * @param[in,out] hint the data from the previous projection which is
+     *   updated with the data for this point.
+     *
+     * This gives the same results as TransverseMercatorExact::Reverse (to
+     * within roundoff), but is faster if successive points are close to one
+     * another (i.e., within a few tens of kilometers).  If the point is far
+     * from the previous one, the hint is ignored.
+     **********************************************************************/
+    void Reverse(real lon0, real x, real y,
+                 real& lat, real& lon, real& gamma, real& k, Hint& hint) const;
+
+    /**
+     * Forward projection of many points with a common central meridian.
+     *
+     * @param[in] lon0 central meridian of the projection (degrees).
+     * @param[in] n the number of points.
+     * @param[in] lat array of \e n latitudes (degrees).
+     * @param[in] lon array of \e n longitudes (degrees).
+     * @param[out] x array of \e n eastings (meters).
+     * @param[out] y array of \e n northings (meters).
+     * @param[out] gamma array of \e n meridian convergences (degrees); this
+     *   may be a null pointer.
+     * @param[out] k array of \e n scales; this may be a null pointer.
+     * @param[in] nthreads the number of threads to use (default 1).
+     *
+     * Element \e i of the output arrays is set to the result of
+     * TransverseMercatorExact::Forward applied to element \e i of the input
+     * arrays (to within roundoff).  The points are handled in blocks of
+     * 1024 and, within a block, each point is projected with a Hint from the
+     * previous one; so it pays to order the points along a path or a grid.
+     * The results don't depend on \e nthreads; with \e nthreads &gt; 1 the
+     * blocks are distributed over the threads.  The input and output arrays
+     * must not overlap.
+     **********************************************************************/
+    void Forward(real lon0, size_t n, const real lat[], const real lon[],
+                 real x[], real y[], real gamma[] = nullptr,
+                 real k[] = nullptr, int nthreads = 1) const;
+
+    /**
+     * Reverse projection of many points with a common central meridian.
+     *
+     * @param[in] lon0 central meridian of the projection (degrees).
+     * @param[in] n the number of points.
+     * @param[in] x array of \e n eastings (meters).
+     * @param[in] y array of \e n northings (meters).
+     * @param[out] lat array of \e n latitudes (degrees).
+     * @param[out] lon array of \e n longitudes (degrees).
+     * @param[out] gamma array of \e n meridian convergences (degrees); this
+     *   may be a null pointer.
+     * @param[out] k array of \e n scales; this may be a null pointer.
+     * @param[in] nthreads the number of threads to use (default 1).
+     *
+     * Element \e i of the output arrays is set to the result of
+     * TransverseMercatorExact::Reverse applied to element \e i of the input
+     * arrays (to within roundoff).  The points are handled as for the array
+     * version of TransverseMercatorExact::Forward.
+     **********************************************************************/
+    void Reverse(real lon0, size_t n, const real x[], const real y[],
+                 real lat[], real lon[], real gamma[] = nullptr,
+                 real k[] = nullptr, int nthreads = 1) const;
+
     /** \name Inspector functions
      **********************************************************************/
     ///@{
@@ -252,9 +379,17 @@ namespace GeographicLib {
     /**
      * A global instantiation of TransverseMercatorExact with the WGS84
      * ellipsoid and the UTM scale factor.  However, unlike UTM, no false
-     * easting or northing is added.
+     * easting or northing is added.  See Geodesic::WGS84() for when this is
+     * constructed.
      **********************************************************************/
     static const TransverseMercatorExact& UTM();
+
+  private:
+    // Set the starting guess u, v from hint; return true if this was done.
+    bool Seed(int dir, real s1, real s2, const Hint& hint,
+              real& u, real& v) const;
+    // Call work(b, e) for blocks [b, e) covering [0, n) on nthreads threads.
+    template<class F> static void Blocks(size_t n, int nthreads, F work);
   };
 
 } // namespace GeographicLib
@@ -0,0 +1,324 @@
+/**
+ * \file TriaxialGeodesic.hpp
+ * \brief Header for GeographicLib::TriaxialGeodesic class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_TRIAXIALGEODESIC_HPP)
+#define GEOGRAPHICLIB_TRIAXIALGEODESIC_HPP 1
+
+#include <GeographicLib/Constants.hpp>
+
+namespace GeographicLib {
+
+  /**
+   * \brief Geodesics on a triaxial ellipsoid
+   *
+   * This class solves the direct and inverse geodesic problems on a triaxial
+   * ellipsoid with semi-axes \e a &ge; \e b &ge; \e c.  Points are given by
+   * their ellipsoidal latitude &beta; and longitude &omega; (the same
+   * coordinates as JacobiConformal):
+   * - \e X = \e a cos&omega; ((<i>a</i><sup>2</sup> &minus;
+   *   <i>b</i><sup>2</sup> + (<i>b</i><sup>2</sup> &minus;
+   *   <i>c</i><sup>2</sup>) cos<sup>2</sup>&beta;) /
+   *   (<i>a</i><sup>2</sup> &minus; <i>c</i><sup>2</sup>))<sup>1/2</sup>,
+   * - \e Y = \e b cos&beta; sin&omega;,
+   * - \e Z = \e c sin&beta; ((<i>b</i><sup>2</sup> &minus;
+   *   <i>c</i><sup>2</sup> + (<i>a</i><sup>2</sup> &minus;
+   *   <i>b</i><sup>2</sup>) sin<sup>2</sup>&omega;) /
+   *   (<i>a</i><sup>2</sup> &minus; <i>c</i><sup>2</sup>))<sup>1/2</sup>.
+   * .
+   * The equator &beta; = 0 is the principal ellipse \e Z = 0 and the prime
+   * meridian &omega; = 0 is half of the principal ellipse \e Y = 0.  The
+   * azimuth &alpha; is measured clockwise from the direction of increasing
+   * &beta; (north) to the direction of increasing &omega; (east).  When \e a
+   * = \e b, &beta; is the parametric latitude and &omega; is the longitude.
+   * The coordinates are singular at the four umbilic points, |&beta;| =
+   * 90&deg; and &omega; = 0&deg; or 180&deg;, where the azimuth is not
+   * defined; the end points of a geodesic should not be umbilics.
+   *
+   * There are no closed-form series for a triaxial ellipsoid comparable to
+   * those used by Geodesic, so the geodesic and its Jacobi fields (giving the
+   * reduced length \e m12 and the geodesic scales \e M12 and \e M21) are
+   * found by integrating the equations of motion in Cartesian coordinates.
+   * The integrator is a fixed-step Gragg-Bulirsch-Stoer extrapolation of the
+   * modified midpoint method.  The steps are half the smallest radius of
+   * curvature, <i>c</i><sup>2</sup>/\e a, so that a geodesic which encircles
+   * a moderately flattened ellipsoid takes about 20 steps.  After each step the
+   * position is returned to the surface and the velocity to the tangent
+   * plane.  The error is a few parts in 10<sup>14</sup> of \e b for double
+   * precision.  Because none of the logic depends on the data, geodesics
+   * are integrated in blocks of 32 with the state held as a structure of
+   * arrays; each geodesic takes the number of steps for its own length, so
+   * that the results do not depend on which other geodesics are in its
+   * block.
+   *
+   * The inverse problem is solved by shooting: Newton's method adjusts the
+   * initial azimuth and the length using the tangent and the reduced length
+   * at the end of the trial geodesic.  The starting guess is given by the
+   * chord joining the points; this typically converges in 4 or 5 iterations
+   * (i.e., 4 or 5 integrations) to the shortest geodesic.  If this fails to
+   * give a geodesic with \e m12 > 0, the iteration is restarted with the
+   * azimuth rotated by multiples of 45&deg; and the shortest such geodesic is
+   * returned.  However, for points which are nearly antipodal, there are
+   * several geodesics and this may not be the shortest one.
+   *
+   * The array versions of Direct and Inverse process blocks of geodesics
+   * concurrently with Executor::Current.  The object is immutable, so it may
+   * be accessed by several threads at once.
+   *
+   * For more information on triaxial geodesics, see \ref triaxial.
+   *
+   * Example of use:
+   * \code
+   *   // A triaxial model of Vesta (km)
+   *   TriaxialGeodesic t(286.3, 278.6, 223.2);
+   *   double s12, alp1, alp2;
+   *   t.Inverse(10, 20, -30, 150, s12, alp1, alp2);
+   * \endcode
+   **********************************************************************/
+
+  class GEOGRAPHICLIB_EXPORT TriaxialGeodesic {
+  private:
+    typedef Math::real real;
+    // The number of components of the state of a geodesic (position,
+    // velocity, and the two Jacobi fields with their derivatives) and the
+    // number of geodesics integrated together.
+    enum { nv = 10, nb = 32 };
+    real _a, _b, _c, _ab2, _bc2, _ac2, _ia2, _ib2, _ic2, _kK0, _hmax;
+    int _nlev;
+    void Cart(real sbet, real cbet, real somg, real comg, real r[]) const;
+    // The unit vectors in the directions of increasing beta and omega.
+    void Frame(real sbet, real cbet, real somg, real comg,
+               real N[], real E[]) const;
+    void Ellipsoidal(const real r[], real& sbet, real& cbet,
+                     real& somg, real& comg) const;
+    // The state of geodesic i is y[k * nb + i] for k in [0, nv).
+    void Deriv(int n, const real y[], real f[]) const;
+    // work has room for (4 + _nlev) * nv * nb reals.
+    void Step(int n, const real h[], real y[], real work[]) const;
+    void Integrate(int n, const real s12[], real y[]) const;
+    void DirectBlock(int n, const real bet1[], const real omg1[],
+                     const real alp1[], const real s12[],
+                     real bet2[], real omg2[], real alp2[],
+                     real m12[], real M12[], real M21[]) const;
+    void InverseBlock(int n, const real bet1[], const real omg1[],
+                      const real bet2[], const real omg2[],
+                      real s12[], real alp1[], real alp2[],
+                      real m12[], real M12[], real M21[]) const;
+  public:
+
+    /**
+     * Constructor for a triaxial ellipsoid with semi-axes.
+     *
+     * @param[in] a the largest semi-axis.
+     * @param[in] b the middle semi-axis.
+     * @param[in] c the smallest semi-axis.
+     * @exception GeographicErr if the axes are not in order or \e a = \e c.
+     *
+     * The semi-axes must satisfy \e a &ge; \e b &ge; \e c > 0 and \e a >
+     * \e c.  Either \e a = \e b (an oblate ellipsoid) or \e b = \e c (a
+     * prolate ellipsoid) is allowed.
+     **********************************************************************/
+    TriaxialGeodesic(real a, real b, real c);
+
+    /**
+     * Solve the direct geodesic problem.
+     *
+     * @param[in] bet1 the ellipsoidal latitude of point 1 (degrees).
+     * @param[in] omg1 the ellipsoidal longitude of point 1 (degrees).
+     * @param[in] alp1 the azimuth at point 1 (degrees).
+     * @param[in] s12 the distance from point 1 to point 2 (meters); it can
+     *   be negative.
+     * @param[out] bet2 the ellipsoidal latitude of point 2 (degrees).
+     * @param[out] omg2 the ellipsoidal longitude of point 2 (degrees).
+     * @param[out] alp2 the (forward) azimuth at point 2 (degrees).
+     * @param[out] m12 the reduced length of the geodesic (meters).
+     * @param[out] M12 the geodesic scale of point 2 relative to point 1
+     *   (dimensionless).
+     * @param[out] M21 the geodesic scale of point 1 relative to point 2
+     *   (dimensionless).
+     *
+     * \e bet1 should be in [&minus;90&deg;, 90&deg;].  \e bet2 is in
+     * [&minus;90&deg;, 90&deg;] and \e omg2 and \e alp2 are in
+     * [&minus;180&deg;, 180&deg;].  The distance is measured in the units
+     * of the semi-axes.
+     **********************************************************************/
+    void Direct(real bet1, real omg1, real alp1, real s12,
+                real& bet2, real& omg2, real& alp2,
+                real& m12, real& M12, real& M21) const {
+      DirectBlock(1, &bet1, &omg1, &alp1, &s12, &bet2, &omg2, &alp2,
+                  &m12, &M12, &M21);
+    }
+
+    /**
+     * Solve the direct geodesic problem.
+     *
+     * @param[in] bet1 the ellipsoidal latitude of point 1 (degrees).
+     * @param[in] omg1 the ellipsoidal longitude of point 1 (degrees).
+     * @param[in] alp1 the azimuth at point 1 (degrees).
+     * @param[in] s12 the distance from point 1 to point 2 (meters).
+     * @param[out] bet2 the ellipsoidal latitude of point 2 (degrees).
+     * @param[out] omg2 the ellipsoidal longitude of point 2 (degrees).
+     * @param[out] alp2 the (forward) azimuth at point 2 (degrees).
+     **********************************************************************/
+    void Direct(real bet1, real omg1, real alp1, real s12,
+                real& bet2, real& omg2, real& alp2) const {
+      DirectBlock(1, &bet1, &omg1, &alp1, &s12, &bet2, &omg2, &alp2,
+                  nullptr, nullptr, nullptr);
+    }
+
+    /**
+     * Solve the inverse geodesic problem.
+     *
+     * @param[in] bet1 the ellipsoidal latitude of point 1 (degrees).
+     * @param[in] omg1 the ellipsoidal longitude of point 1 (degrees).
+     * @param[in] bet2 the ellipsoidal latitude of point 2 (degrees).
+     * @param[in] omg2 the ellipsoidal longitude of point 2 (degrees).
+     * @param[out] s12 the distance from point 1 to point 2 (meters).
+     * @param[out] alp1 the azimuth at point 1 (degrees).
+     * @param[out] alp2 the (forward) azimuth at point 2 (degrees).
+     * @param[out] m12 the reduced length of the geodesic (meters).
+     * @param[out] M12 the geodesic scale of point 2 relative to point 1
+     *   (dimensionless).
+     * @param[out] M21 the geodesic scale of point 1 relative to point 2
+     *   (dimensionless).
+     *
+     * \e bet1 and \e bet2 should be in [&minus;90&deg;, 90&deg;].  If the
+     * points coincide, \e s12 = 0 and the azimuths are 0.
+     **********************************************************************/
+    void Inverse(real bet1, real omg1, real bet2, real omg2,
+                 real& s12, real& alp1, real& alp2,
+                 real& m12, real& M12, real& M21) const {
+      InverseBlock(1, &bet1, &omg1, &bet2, &omg2, &s12, &alp1, &alp2,
+                   &m12, &M12, &M21);
+    }
+
+    /**
+     * Solve the inverse geodesic problem.
+     *
+     * @param[in] bet1 the ellipsoidal latitude of point 1 (degrees).
+     * @param[in] omg1 the ellipsoidal longitude of point 1 (degrees).
+     * @param[in] bet2 the ellipsoidal latitude of point 2 (degrees).
+     * @param[in] omg2 the ellipsoidal longitude of point 2 (degrees).
+     * @param[out] s12 the distance from point 1 to point 2 (meters).
+     * @param[out] alp1 the azimuth at point 1 (degrees).
+     * @param[out] alp2 the (forward) azimuth at point 2 (degrees).
+     **********************************************************************/
+    void Inverse(real bet1, real omg1, real bet2, real omg2,
+                 real& s12, real& alp1, real& alp2) const {
+      InverseBlock(1, &bet1, &omg1, &bet2, &omg2, &s12, &alp1, &alp2,
+                   nullptr, nullptr, nullptr);
+    }
+
+    /**
+     * Solve many direct geodesic problems.
+     *
+     * @param[in] n the number of geodesics.
+     * @param[in] bet1 array of \e n latitudes of point 1 (degrees).
+     * @param[in] omg1 array of \e n longitudes of point 1 (degrees).
+     * @param[in] alp1 array of \e n azimuths at point 1 (degrees).
+     * @param[in] s12 array of \e n distances (meters).
+     * @param[out] bet2 array of \e n latitudes of point 2 (degrees).
+     * @param[out] omg2 array of \e n longitudes of point 2 (degrees).
+     * @param[out] alp2 array of \e n azimuths at point 2 (degrees).
+     * @param[out] m12 array of \e n reduced lengths (meters); this may be a
+     *   null pointer.
+     * @param[out] M12 array of \e n geodesic scales; this may be a null
+     *   pointer.
+     * @param[out] M21 array of \e n geodesic scales; this may be a null
+     *   pointer.
+     * @param[in] nthreads the number of threads to use (default 1).
+     *
+     * Element \e i of the output arrays is the result of Direct(\e bet1[\e
+     * i], \e omg1[\e i], \e alp1[\e i], \e s12[\e i], ...).  With \e nthreads
+     * &gt; 1 blocks of geodesics are processed concurrently with
+     * Executor::Current.
+     **********************************************************************/
+    void Direct(size_t n, const real bet1[], const real omg1[],
+                const real alp1[], const real s12[],
+                real bet2[], real omg2[], real alp2[],
+                real m12[] = nullptr, real M12[] = nullptr,
+                real M21[] = nullptr, int nthreads = 1) const;
+
+    /**
+     * Solve many inverse geodesic problems.
+     *
+     * @param[in] n the number of geodesics.
+     * @param[in] bet1 array of \e n latitudes of point 1 (degrees).
+     * @param[in] omg1 array of \e n longitudes of point 1 (degrees).
+     * @param[in] bet2 array of \e n latitudes of point 2 (degrees).
+     * @param[in] omg2 array of \e n longitudes of point 2 (degrees).
+     * @param[out] s12 array of \e n distances (meters).
+     * @param[out] alp1 array of \e n azimuths at point 1 (degrees).
+     * @param[out] alp2 array of \e n azimuths at point 2 (degrees).
+     * @param[out] m12 array of \e n reduced lengths (meters); this may be a
+     *   null pointer.
+     * @param[out] M12 array of \e n geodesic scales; this may be a null
+     *   pointer.
+     * @param[out] M21 array of \e n geodesic scales; this may be a null
+     *   pointer.
+     * @param[in] nthreads the number of threads to use (default 1).
+     *
+     * Element \e i of the output arrays is the result of Inverse(\e bet1[\e
+     * i], \e omg1[\e i], \e bet2[\e i], \e omg2[\e i], ...).  The Newton
+     * iterations for the geodesics in a block proceed together, dropping
+     * each geodesic as it converges.
+     **********************************************************************/
+    void Inverse(size_t n, const real bet1[], const real omg1[],
+                 const real bet2[], const real omg2[],
+                 real s12[], real alp1[], real alp2[],
+                 real m12[] = nullptr, real M12[] = nullptr,
+                 real M21[] = nullptr, int nthreads = 1) const;
+
+    /**
+     * Convert ellipsoidal coordinates to Cartesian coordinates.
+     *
+     * @param[in] bet the ellipsoidal latitude (degrees).
+     * @param[in] omg the ellipsoidal longitude (degrees).
+     * @param[out] X the \e X coordinate (meters).
+     * @param[out] Y the \e Y coordinate (meters).
+     * @param[out] Z the \e Z coordinate (meters).
+     **********************************************************************/
+    void ToCartesian(real bet, real omg, real& X, real& Y, real& Z) const;
+
+    /**
+     * Convert Cartesian coordinates to ellipsoidal coordinates.
+     *
+     * @param[in] X the \e X coordinate (meters).
+     * @param[in] Y the \e Y coordinate (meters).
+     * @param[in] Z the \e Z coordinate (meters).
+     * @param[out] bet the ellipsoidal latitude (degrees).
+     * @param[out] omg the ellipsoidal longitude (degrees).
+     *
+     * The point should lie on the ellipsoid.  \e bet is in [&minus;90&deg;,
+     * 90&deg;] and \e omg is in [&minus;180&deg;, 180&deg;].
+     **********************************************************************/
+    void FromCartesian(real X, real Y, real Z, real& bet, real& omg) const;
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return \e a the largest semi-axis.
+     **********************************************************************/
+    Math::real MajorRadius() const { return _a; }
+
+    /**
+     * @return \e b the middle semi-axis.
+     **********************************************************************/
+    Math::real MedianRadius() const { return _b; }
+
+    /**
+     * @return \e c the smallest semi-axis.
+     **********************************************************************/
+    Math::real MinorRadius() const { return _c; }
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_TRIAXIALGEODESIC_HPP
@@ -222,6 +222,44 @@ namespace GeographicLib {
                         real& gamma, real& k,
                         int setzone = STANDARD, bool mgrslimits = false);
 
+    /**
+     * Forward projection of many points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of \e n latitudes (degrees).
+     * @param[in] lon array of \e n longitudes (degrees).
+     * @param[out] zone array of \e n UTM zones (zero means UPS).
+     * @param[out] northp array of \e n hemispheres (true means north, false
+     *   means south).
+     * @param[out] x array of \e n eastings (meters).
+     * @param[out] y array of \e n northings (meters).
+     * @param[out] gamma array of \e n meridian convergences (degrees); this
+     *   may be a null pointer.
+     * @param[out] k array of \e n scales; this may be a null pointer.
+     * @param[in] setzone zone override (optional).
+     * @param[in] mgrslimits if true enforce the stricter MGRS limits on the
+     *   coordinates (default = false).
+     * @param[in] nthreads the number of threads to use for the UTM
+     *   projections (default 1).
+     * @exception GeographicErr if any point would cause the scalar version
+     *   of Forward to throw; the message refers to the first such point and
+     *   the contents of the output arrays are unspecified.
+     *
+     * Element \e i of the output arrays is set to the result of
+     * UTMUPS::Forward applied to element \e i of the input arrays; the
+     * results are bitwise identical.  The UTM points in all zones are
+     * projected by a single call to the array version of
+     * TransverseMercator::Forward, using the longitudes relative to the
+     * central meridians of their zones.  If \e gamma and \e k are both null
+     * pointers, their calculation is skipped.  The input and output arrays
+     * must not overlap.
+     **********************************************************************/
+    static void Forward(size_t n, const real lat[], const real lon[],
+                        int zone[], bool northp[], real x[], real y[],
+                        real gamma[] = nullptr, real k[] = nullptr,
+                        int setzone = STANDARD, bool mgrslimits = false,
+                        int nthreads = 1);
+
     /**
      * Reverse projection, from  UTM/UPS to geographic.
      *
@@ -314,11 +352,50 @@ namespace GeographicLib {
      * the actual zone used for output.
      *
      * (\e xout, \e yout) can overlap with (\e xin, \e yin).
+     *
+     * A transfer between two different UTM zones carries the conformal
+     * latitude from one projection to the other instead of computing the
+     * geographic latitude (see TransverseMercator::Transfer).  The results
+     * then differ from UTMUPS::Reverse followed by UTMUPS::Forward by at
+     * most a few nanometers.
      **********************************************************************/
     static void Transfer(int zonein, bool northpin, real xin, real yin,
                          int zoneout, bool northpout, real& xout, real& yout,
                          int& zone);
 
+    /**
+     * Transfer many points from their zones to a common zone.
+     *
+     * @param[in] n the number of points.
+     * @param[in] zonein array of \e n input UTM zones (or zero for UPS).
+     * @param[in] northpin array of \e n input hemispheres.
+     * @param[in] xin array of \e n input eastings (meters).
+     * @param[in] yin array of \e n input northings (meters).
+     * @param[in] zoneout the requested UTM zone for the output (or zero for
+     *   UPS).
+     * @param[in] northpout hemisphere for the output.
+     * @param[out] xout array of \e n output eastings (meters).
+     * @param[out] yout array of \e n output northings (meters).
+     * @param[out] zone array of \e n actual output zones.
+     * @param[in] nthreads the number of threads to use (default 1).
+     * @exception GeographicErr under the conditions given for
+     *   UTMUPS::Transfer.
+     *
+     * Element \e i of the output arrays is the result of
+     * UTMUPS::Transfer(\e zonein[\e i], \e northpin[\e i], \e xin[\e
+     * i], \e yin[\e i], \e zoneout, \e northpout, ...).  The results are
+     * bitwise identical to the scalar function regardless of \e nthreads.
+     * With \e nthreads &gt; 1 blocks of points are processed concurrently
+     * with Executor::Current; if several points are illegal, which of the
+     * errors is reported is then unspecified.  The output arrays may be the
+     * same as \e xin and \e yin.
+     **********************************************************************/
+    static void Transfer(size_t n, const int zonein[], const bool northpin[],
+                         const real xin[], const real yin[],
+                         int zoneout, bool northpout,
+                         real xout[], real yout[], int zone[],
+                         int nthreads = 1);
+
     /**
      * Decode a UTM/UPS zone string.
      *
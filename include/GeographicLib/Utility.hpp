@@ -17,6 +17,8 @@
 #include <cctype>
 #include <ctime>
 #include <cstring>
+#include <cstdio>
+#include <clocale>
 
 #if defined(_MSC_VER)
 // Squelch warnings about constant conditional expressions and unsafe gmtime
@@ -46,6 +48,9 @@ namespace GeographicLib {
     static bool gregorian(int s) {
       return s >= 639799;       // 1752-09-14
     }
+    // Exact fixed format conversion of x with p decimals for moderate values;
+    // returns false (and leaves s alone) if x * 10^p is too large.
+    static bool fixedstr(double x, int p, std::string& s);
   public:
 
     /**
@@ -130,13 +135,18 @@ namespace GeographicLib {
      * if this is successful, the value is returned.  Otherwise the string
      * should be of the form yyyy-mm or yyyy-mm-dd and this is converted to a
      * number with 2010-01-01 giving 2010.0 and 2012-07-03 giving 2012.5.  The
-     * string "now" is interpreted as the present date.
+     * string "now" is interpreted as the present date.  A string with a
+     * hyphen after the first character and no exponent is taken to be a
+     * date without first trying (and failing) to read it as a number.
      **********************************************************************/
     template<typename T> static T fractionalyear(const std::string& s) {
-      try {
-        return val<T>(s);
+      if (s.find('-', 1) == std::string::npos ||
+          s.find_first_of("eE") != std::string::npos) {
+        try {
+          return val<T>(s);
+        }
+        catch (const std::exception&) {}
       }
-      catch (const std::exception&) {}
       int y, m, d;
       date(s, y, m, d);
       int t = day(y, m, d, true);
@@ -319,8 +329,11 @@ namespace GeographicLib {
      **********************************************************************/
     template<typename ExtT, typename IntT, bool bigendp>
       static void readarray(std::istream& str, IntT array[], size_t num) {
-#if GEOGRAPHICLIB_PRECISION < 4
       if (sizeof(IntT) == sizeof(ExtT) &&
+#if GEOGRAPHICLIB_PRECISION >= 4
+          // Only integers are plain data with this precision
+          std::numeric_limits<IntT>::is_integer &&
+#endif
           std::numeric_limits<IntT>::is_integer ==
           std::numeric_limits<ExtT>::is_integer)
         {
@@ -328,13 +341,10 @@ namespace GeographicLib {
           str.read(reinterpret_cast<char*>(array), num * sizeof(ExtT));
           if (!str.good())
             throw GeographicErr("Failure reading data");
-          if (bigendp != Math::bigendian) { // endian mismatch -> swap bytes
-            for (size_t i = num; i--;)
-              array[i] = Math::swab<IntT>(array[i]);
-          }
+          if (bigendp != Math::bigendian) // endian mismatch -> swap bytes
+            Math::swab(array, num);
         }
       else
-#endif
         {
           const int bufsize = 1024; // read this many values at a time
           ExtT buffer[bufsize];     // temporary buffer
@@ -345,10 +355,11 @@ namespace GeographicLib {
             str.read(reinterpret_cast<char*>(buffer), n * sizeof(ExtT));
             if (!str.good())
               throw GeographicErr("Failure reading data");
+            if (bigendp != Math::bigendian) // fix endian-ness
+              Math::swab(buffer, size_t(n));
             for (int j = 0; j < n; ++j)
-              // fix endian-ness and cast to IntT
-              array[i++] = IntT(bigendp == Math::bigendian ? buffer[j] :
-                                Math::swab<ExtT>(buffer[j]));
+              // cast to IntT
+              array[i++] = IntT(buffer[j]);
             k -= n;
           }
         }
@@ -410,9 +421,10 @@ namespace GeographicLib {
           while (k) {
             int n = (std::min)(k, bufsize);
             for (int j = 0; j < n; ++j)
-              // cast to ExtT and fix endian-ness
-              buffer[j] = bigendp == Math::bigendian ? ExtT(array[i++]) :
-                Math::swab<ExtT>(ExtT(array[i++]));
+              // cast to ExtT
+              buffer[j] = ExtT(array[i++]);
+            if (bigendp != Math::bigendian) // fix endian-ness
+              Math::swab(buffer, size_t(n));
             str.write(reinterpret_cast<const char*>(buffer), n * sizeof(ExtT));
             if (!str.good())
               throw GeographicErr("Failure writing data");
@@ -486,6 +498,24 @@ namespace GeographicLib {
      **********************************************************************/
     static int set_digits(int ndigits = 0);
 
+    /**
+     * Interleave a block of memory across the NUMA nodes.
+     *
+     * @param[in] p the start of the block.
+     * @param[in] bytes the size of the block.
+     * @return whether the memory policy was applied.
+     *
+     * On multi-socket Linux systems, this sets the memory policy of the
+     * pages containing the block to MPOL_INTERLEAVE across all the allowed
+     * nodes and moves the pages which have already been allocated, so that
+     * threads on every node see the same average memory bandwidth when
+     * reading the block.  The contents of the block are unchanged.  The
+     * policy is ignored for memory mapped files (which are allocated in the
+     * page cache).  This returns false on other systems or if the system
+     * call fails.  Compile with GEOGRAPHICLIB_NUMA = 0 to disable this.
+     **********************************************************************/
+    static bool interleave(const void* p, size_t bytes);
+
   };
 
   /**
@@ -562,12 +592,55 @@ namespace GeographicLib {
    * If \e p &ge; 0, then the number fixed format is used with p bits of
    * precision.  With p < 0, there is no manipulation of the format.  This is
    * an overload of str<T> which deals with inf and nan.
+   *
+   * For the standard floating point types, the conversion is done without
+   * an ostringstream.  In fixed format, a float or double whose scaled value
+   * |<i>x</i>| 10<sup><i>p</i></sup> is less than 2<sup>52</sup> is
+   * converted by exactly rounding the scaled value to an integer; otherwise
+   * snprintf is used.  The results are identical to those of an
+   * ostringstream (the C++ library uses the C conversion for these types)
+   * but are obtained several times faster.  The result always uses '.' as
+   * the decimal point.
    **********************************************************************/
   template<> inline std::string Utility::str<Math::real>(Math::real x, int p) {
     using std::isfinite;
     if (!isfinite(x))
       return x < 0 ? std::string("-inf") :
         (x > 0 ? std::string("inf") : std::string("nan"));
+#if GEOGRAPHICLIB_PRECISION <= 3
+    {
+#if GEOGRAPHICLIB_PRECISION <= 2
+      std::string f;
+      if (p >= 0 && fixedstr(double(x), p, f)) return f;
+#endif
+#if GEOGRAPHICLIB_PRECISION == 3
+      typedef long double fmt_t;
+      const char *ffmt = "%.*Lf", *gfmt = "%Lg";
+#else
+      typedef double fmt_t;
+      const char *ffmt = "%.*f", *gfmt = "%g";
+#endif
+      char buf[64];
+      int n = p >= 0 ? std::snprintf(buf, sizeof(buf), ffmt, p, fmt_t(x)) :
+        std::snprintf(buf, sizeof(buf), gfmt, fmt_t(x));
+      std::string r;
+      if (n < int(sizeof(buf)))
+        r.assign(buf, n);
+      else {
+        // Only needed for very large numbers in fixed format
+        std::vector<char> big(n + 1);
+        std::snprintf(big.data(), big.size(), ffmt, p, fmt_t(x));
+        r.assign(big.data(), n);
+      }
+      // snprintf uses the decimal point of the C locale; ostringstream uses
+      // that of the default C++ locale which is "."
+      char dp = *std::localeconv()->decimal_point;
+      if (dp != '.')
+        for (char& c : r)
+          if (c == dp) c = '.';
+      return r;
+    }
+#else
     std::ostringstream s;
 #if GEOGRAPHICLIB_PRECISION == 4
     // boost-quadmath treats precision == 0 as "use as many digits as
@@ -589,6 +662,7 @@ namespace GeographicLib {
 #endif
     if (p >= 0) s << std::fixed << std::setprecision(p);
     s << x; return s.str();
+#endif
   }
 
 } // namespace GeographicLib
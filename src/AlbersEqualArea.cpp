@@ -520,6 +520,13 @@ namespace GeographicLib {
   void AlbersEqualArea::Reverse(real lon0, real x, real y,
                                 real& lat, real& lon,
                                 real& gamma, real& k) const {
+    GenReverse(Math::AngNormalize(lon0), x, y, lat, lon, gamma, k);
+  }
+
+  void AlbersEqualArea::GenReverse(real lon0, real x, real y,
+                                   real& lat, real& lon,
+                                   real& gamma, real& k) const {
+    // lon0 has been reduced with Math::AngNormalize.
     y *= _sign;
     real
       nx = _k0 * _n0 * x, ny = _k0 * _n0 * y, y1 =  _nrho0 - ny,
@@ -535,10 +542,35 @@ namespace GeographicLib {
     gamma = _sign * theta / Math::degree();
     lat = Math::atand(_sign * tphi);
     lon = lam / Math::degree();
-    lon = Math::AngNormalize(lon + Math::AngNormalize(lon0));
+    lon = Math::AngNormalize(lon + lon0);
     k = _k0 * (den != 0 ? (_nrho0 + _n0 * drho) * hyp(_fm * tphi) / _a : 1);
   }
 
+  void AlbersEqualArea::Forward(real lon0, size_t n,
+                                const real lat[], const real lon[],
+                                real x[], real y[],
+                                real gamma[], real k[]) const {
+    real g, kk;
+    for (size_t i = 0; i < n; ++i) {
+      Forward(lon0, lat[i], lon[i], x[i], y[i], g, kk);
+      if (gamma) gamma[i] = g;
+      if (k) k[i] = kk;
+    }
+  }
+
+  void AlbersEqualArea::Reverse(real lon0, size_t n,
+                                const real x[], const real y[],
+                                real lat[], real lon[],
+                                real gamma[], real k[]) const {
+    lon0 = Math::AngNormalize(lon0);
+    real g, kk;
+    for (size_t i = 0; i < n; ++i) {
+      GenReverse(lon0, x[i], y[i], lat[i], lon[i], g, kk);
+      if (gamma) gamma[i] = g;
+      if (k) k[i] = kk;
+    }
+  }
+
   void AlbersEqualArea::SetScale(real lat, real k) {
     if (!(isfinite(k) && k > 0))
       throw GeographicErr("Scale is not positive");
@@ -44,6 +44,21 @@ namespace GeographicLib {
     return AuxAngle(y, x);
   }
 
+  void AuxAngle::normalize(size_t n, real y[], real x[]) {
+    using std::isfinite;        // Needed for Centos 7, ubuntu 14
+    for (size_t i = 0; i < n; ++i) {
+      real r = hypot(y[i], x[i]);
+      if (isfinite(r) && r > 0) {
+        // Then tan() is not a NaN and at most one of y, x is too big, so this
+        // matches the general case of normalized()
+        y[i] /= r; x[i] /= r;
+      } else {
+        AuxAngle p(AuxAngle(y[i], x[i]).normalized());
+        y[i] = p._y; x[i] = p._x;
+      }
+    }
+  }
+
   AuxAngle AuxAngle::copyquadrant(const AuxAngle& p) const {
     return AuxAngle(copysign(y(), p.y()), copysign(x(), p.x()));
   }
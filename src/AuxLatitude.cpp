@@ -51,8 +51,11 @@ namespace GeographicLib {
       throw GeographicErr("Equatorial radius is not positive");
     if (!(isfinite(_b) && _b > 0))
       throw GeographicErr("Polar semi-axis is not positive");
-    fill(_c, _c + Lmax * AUXNUMBER * AUXNUMBER,
-         numeric_limits<real>::quiet_NaN());
+    // Compute all the series coefficients here (this is cheap) so that
+    // const member functions don't modify the object.
+    for (int auxout = 0; auxout < AUXNUMBER; ++auxout)
+      for (int auxin = 0; auxin < AUXNUMBER; ++auxin)
+        fillcoeff(auxin, auxout, ind(auxout, auxin));
   }
 
   /// \cond SKIP
@@ -78,8 +81,11 @@ namespace GeographicLib {
       throw GeographicErr("Equatorial radius is not positive");
     if (!(isfinite(_b) && _b > 0))
       throw GeographicErr("Polar semi-axis is not positive");
-    fill(_c, _c + Lmax * AUXNUMBER * AUXNUMBER,
-         numeric_limits<real>::quiet_NaN());
+    // Compute all the series coefficients here (this is cheap) so that
+    // const member functions don't modify the object.
+    for (int auxout = 0; auxout < AUXNUMBER; ++auxout)
+      for (int auxin = 0; auxin < AUXNUMBER; ++auxin)
+        fillcoeff(auxin, auxout, ind(auxout, auxin));
   }
   /// \endcond
 
@@ -88,6 +94,14 @@ namespace GeographicLib {
     return wgs84;
   }
 
+#if GEOGRAPHICLIB_EAGER_SINGLETONS && GEOGRAPHICLIB_PRECISION != 5
+  namespace {
+    // Construct AuxLatitude::WGS84() when the library is loaded (see
+    // Geodesic.cpp).
+    const AuxLatitude& wgs84init_ = AuxLatitude::WGS84();
+  }
+#endif
+
   AuxAngle AuxLatitude::Parametric(const AuxAngle& phi, real* diff) const {
     if (diff) *diff = _fm1;
     return AuxAngle(phi.y() * _fm1, phi.x());
@@ -303,7 +317,6 @@ namespace GeographicLib {
 
   AuxAngle AuxLatitude::Convert(int auxin, int auxout, const AuxAngle& zeta,
                                 bool exact) const {
-    using std::isnan;           // Needed for Centos 7, ubuntu 14
     int k = ind(auxout, auxin);
     if (k < 0) return AuxAngle::NaN();
     if (auxin == auxout) return zeta;
@@ -314,7 +327,6 @@ namespace GeographicLib {
       else
         return ToAuxiliary(auxout, FromAuxiliary(auxin, zeta));
     } else {
-      if ( isnan(_c[Lmax * (k + 1) - 1]) ) fillcoeff(auxin, auxout, k);
       AuxAngle zetan(zeta.normalized());
       real d = Clenshaw(true, zetan.y(), zetan.x(), _c + Lmax * k, Lmax);
       zetan += AuxAngle::radians(d);
@@ -329,6 +341,48 @@ namespace GeographicLib {
     return Math::td * m + Convert(auxin, auxout, zetaa, exact).degrees();
   }
 
+  void AuxLatitude::Convert(int auxin, int auxout, size_t n,
+                            const real zeta[], real eta[], bool exact) const {
+    int k = ind(auxout, auxin);
+    if (exact || k < 0 || auxin == auxout) {
+      for (size_t i = 0; i < n; ++i)
+        eta[i] = Convert(auxin, auxout, zeta[i], exact);
+      return;
+    }
+    const real* c = _c + Lmax * k;
+    const int K = lanes;
+    for (size_t i0 = 0; i0 < n; i0 += K) {
+      // Process the latitudes [i0, i0 + nk) as K lanes; the unused lanes
+      // duplicate the last latitude.  The steps are the same as in the scalar
+      // version so that the results are identical.
+      int nk = int(min(size_t(K), n - i0));
+      real m[K], szeta[K], czeta[K], x[K], u0[K], u1[K];
+      for (int i = 0; i < K; ++i) {
+        real z = zeta[i0 + min(i, nk - 1)];
+        AuxAngle zetaa(AuxAngle::degrees(z)), zetan(zetaa.normalized());
+        m[i] = round((z - zetaa.degrees()) / Math::td);
+        szeta[i] = zetan.y(); czeta[i] = zetan.x();
+        x[i] = 2 * (czeta[i] - szeta[i]) * (czeta[i] + szeta[i]);
+        u0[i] = u1[i] = 0;
+      }
+      // Clenshaw summation for all the lanes
+      for (int l = Lmax; l > 0;) {
+        real cl = c[--l];
+        for (int i = 0; i < K; ++i) {
+          real t = x[i] * u0[i] - u1[i] + cl;
+          u1[i] = u0[i]; u0[i] = t;
+        }
+      }
+      for (int i = 0; i < nk; ++i) {
+        // The final step of Clenshaw with sinp = true
+        real d = 2 * szeta[i] * czeta[i] * u0[i] - real(0) * u1[i];
+        AuxAngle zetan(szeta[i], czeta[i]);
+        zetan += AuxAngle::radians(d);
+        eta[i0 + i] = Math::td * m[i] + zetan.degrees();
+      }
+    }
+  }
+
   Math::real AuxLatitude::RectifyingRadius(bool exact) const {
     if (exact) {
       return EllipticFunction::RG(Math::sq(_a), Math::sq(_b)) * 4 / Math::pi();
@@ -439,7 +493,7 @@ namespace GeographicLib {
   }
 
   /// \cond SKIP
-  void AuxLatitude::fillcoeff(int auxin, int auxout, int k) const {
+  void AuxLatitude::fillcoeff(int auxin, int auxout, int k) {
 #if GEOGRAPHICLIB_AUXLATITUDE_ORDER == 4
     static const real coeffs[] = {
       // C[phi,phi] skipped
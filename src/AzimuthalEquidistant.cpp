@@ -8,6 +8,8 @@
  **********************************************************************/
 
 #include <GeographicLib/AzimuthalEquidistant.hpp>
+#include <GeographicLib/GeodesicLine.hpp>
+#include <GeographicLib/GeodesicOrigin.hpp>
 
 namespace GeographicLib {
 
@@ -38,4 +40,54 @@ namespace GeographicLib {
     rk = !(sig <= eps_) ? m / s : 1;
   }
 
+  void AzimuthalEquidistant::Forward(real lat0, real lon0, size_t n,
+                                     const real lat[], const real lon[],
+                                     real x[], real y[],
+                                     real azi[], real rk[]) const {
+    unsigned outmask = Geodesic::DISTANCE | Geodesic::AZIMUTH |
+      (rk ? unsigned(Geodesic::REDUCEDLENGTH) : 0U);
+    // The quantities depending on the center are computed once.
+    const GeodesicOrigin orig = _earth.InverseFrom(lat0, lon0);
+    for (size_t i = 0; i < n; ++i) {
+      real s, azi0, azi2, m, t,
+        sig = orig.GenInverse(lat[i], lon[i], outmask,
+                              s, azi0, azi2, m, t, t, t);
+      Math::sincosd(azi0, x[i], y[i]);
+      x[i] *= s; y[i] *= s;
+      if (azi) azi[i] = azi2;
+      if (rk) rk[i] = !(sig <= eps_) ? m / s : 1;
+    }
+  }
+
+  void AzimuthalEquidistant::Reverse(real lat0, real lon0, size_t n,
+                                     const real x[], const real y[],
+                                     real lat[], real lon[],
+                                     real azi[], real rk[]) const {
+    // The caps match those used by Geodesic::Direct in the scalar version;
+    // the outmask omits the quantities which aren't needed.
+    const unsigned caps = Geodesic::LATITUDE | Geodesic::LONGITUDE |
+      Geodesic::AZIMUTH | Geodesic::REDUCEDLENGTH | Geodesic::DISTANCE_IN,
+      outmask = Geodesic::LATITUDE | Geodesic::LONGITUDE |
+      (azi ? unsigned(Geodesic::AZIMUTH) : 0U) |
+      (rk ? unsigned(Geodesic::REDUCEDLENGTH) : 0U);
+    GeodesicLine line;
+    real azi0l = Math::NaN();
+    for (size_t i = 0; i < n; ++i) {
+      real
+        azi0 = Math::atan2d(x[i], y[i]),
+        s = hypot(x[i], y[i]);
+      // Reuse the geodesic line while the azimuth is unchanged, e.g., for
+      // successive points along a radial.
+      if (!(azi0 == azi0l && signbit(azi0) == signbit(azi0l))) {
+        line = _earth.Line(lat0, lon0, azi0, caps);
+        azi0l = azi0;
+      }
+      real azi2, m, t,
+        sig = line.GenPosition(false, s, outmask,
+                               lat[i], lon[i], azi2, t, m, t, t, t);
+      if (azi) azi[i] = azi2;
+      if (rk) rk[i] = !(sig <= eps_) ? m / s : 1;
+    }
+  }
+
 } // namespace GeographicLib
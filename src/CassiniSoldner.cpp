@@ -38,6 +38,12 @@ namespace GeographicLib {
 
   void CassiniSoldner::Forward(real lat, real lon, real& x, real& y,
                                real& azi, real& rk) const {
+    GenForward(lat, lon, true, x, y, azi, rk);
+  }
+
+  void CassiniSoldner::GenForward(real lat, real lon, bool wantrk,
+                                  real& x, real& y,
+                                  real& azi, real& rk) const {
     if (!Init())
       return;
     real dlon = Math::AngDiff(LongitudeOrigin(), lon);
@@ -62,11 +68,16 @@ namespace GeographicLib {
     }
     x = s12;
     azi = Math::AngNormalize(azi2);
-    GeodesicLine perp(_earth.Line(lat, dlon, azi, Geodesic::GEODESICSCALE));
+    // The perpendicular geodesic is needed for its equatorial azimuth even
+    // if the scale is not requested.
+    GeodesicLine perp(_earth.Line(lat, dlon, azi,
+                                  wantrk ? Geodesic::GEODESICSCALE :
+                                  Geodesic::NONE));
     real t;
-    perp.GenPosition(true, -sig12,
-                     Geodesic::GEODESICSCALE,
-                     t, t, t, t, t, t, rk, t);
+    if (wantrk)
+      perp.GenPosition(true, -sig12,
+                       Geodesic::GEODESICSCALE,
+                       t, t, t, t, t, t, rk, t);
 
     real salp0, calp0;
     Math::sincosd(perp.EquatorialAzimuth(), salp0, calp0);
@@ -91,4 +102,42 @@ namespace GeographicLib {
     _earth.Direct(lat1, lon1, azi0 + Math::qd, x, lat, lon, azi, rk, t);
   }
 
+  void CassiniSoldner::Forward(size_t n, const real lat[], const real lon[],
+                               real x[], real y[],
+                               real azi[], real rk[]) const {
+    if (!Init())
+      return;
+    real azi2, rk2;
+    for (size_t i = 0; i < n; ++i) {
+      GenForward(lat[i], lon[i], rk != nullptr, x[i], y[i], azi2, rk2);
+      if (azi) azi[i] = azi2;
+      if (rk) rk[i] = rk2;
+    }
+  }
+
+  void CassiniSoldner::Reverse(size_t n, const real x[], const real y[],
+                               real lat[], real lon[],
+                               real azi[], real rk[]) const {
+    if (!Init())
+      return;
+    unsigned outmask = Geodesic::LATITUDE | Geodesic::LONGITUDE |
+      (azi ? unsigned(Geodesic::AZIMUTH) : 0U) |
+      (rk ? unsigned(Geodesic::GEODESICSCALE) : 0U);
+    real lat1 = Math::NaN(), lon1 = Math::NaN(), azi0 = Math::NaN(),
+      yl = Math::NaN();
+    for (size_t i = 0; i < n; ++i) {
+      // Reuse the point on the central meridian while y is unchanged, e.g.,
+      // for the points in a row of a grid.
+      if (!(y[i] == yl && signbit(y[i]) == signbit(yl))) {
+        _meridian.Position(y[i], lat1, lon1, azi0);
+        yl = y[i];
+      }
+      real azi2, rk2, t;
+      _earth.GenDirect(lat1, lon1, azi0 + Math::qd, false, x[i], outmask,
+                       lat[i], lon[i], azi2, t, t, rk2, t, t);
+      if (azi) azi[i] = azi2;
+      if (rk) rk[i] = rk2;
+    }
+  }
+
 } // namespace GeographicLib
@@ -0,0 +1,81 @@
+/**
+ * \file CircleCache.cpp
+ * \brief Implementation for GeographicLib::GravityCircleCache and
+ *   GeographicLib::MagneticCircleCache classes
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/CircleCache.hpp>
+#include <GeographicLib/GravityModel.hpp>
+#include <GeographicLib/MagneticModel.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  namespace {
+    // Round x to the nearest multiple of d (a no-op if d == 0)
+    Math::real Quantize(Math::real x, Math::real d)
+    { return d > 0 ? d * round(x / d) : x; }
+    bool ValidQuantum(Math::real d)
+    { return isfinite(d) && d >= 0; }
+  }
+
+  GravityCircleCache::GravityCircleCache(const GravityModel& model,
+                                         size_t maxsize, real dlat, real dh)
+    : _model(model)
+    , _dlat(dlat)
+    , _dh(dh)
+    , _cache(maxsize)
+  {
+    if (!(ValidQuantum(_dlat) && ValidQuantum(_dh)))
+      throw GeographicErr("Quanta for latitude and height must be "
+                          "nonnegative");
+  }
+
+  shared_ptr<const GravityCircle>
+  GravityCircleCache::Circle(real lat, real h, unsigned caps) {
+    lat = Quantize(lat, _dlat); h = Quantize(h, _dh);
+    if (isnan(lat) || isnan(h))
+      return make_shared<const GravityCircle>(_model.Circle(lat, h, caps));
+    auto k = CircleLRU<GravityCircle>::Key(lat, h, 0, caps);
+    auto c = _cache.Find(k);
+    if (c) return c;
+    // Build the circle with the lock released so that other threads can
+    // consult the cache in the meantime.
+    return _cache.Insert(k,
+                         make_shared<const GravityCircle>
+                         (_model.Circle(lat, h, caps)));
+  }
+
+  MagneticCircleCache::MagneticCircleCache(const MagneticModel& model,
+                                           size_t maxsize,
+                                           real dt, real dlat, real dh)
+    : _model(model)
+    , _dt(dt)
+    , _dlat(dlat)
+    , _dh(dh)
+    , _cache(maxsize)
+  {
+    if (!(ValidQuantum(_dt) && ValidQuantum(_dlat) && ValidQuantum(_dh)))
+      throw GeographicErr("Quanta for time, latitude, and height must be "
+                          "nonnegative");
+  }
+
+  shared_ptr<const MagneticCircle>
+  MagneticCircleCache::Circle(real t, real lat, real h) {
+    t = Quantize(t, _dt); lat = Quantize(lat, _dlat); h = Quantize(h, _dh);
+    if (isnan(t) || isnan(lat) || isnan(h))
+      return make_shared<const MagneticCircle>(_model.Circle(t, lat, h));
+    auto k = CircleLRU<MagneticCircle>::Key(t, lat, h, 0U);
+    auto c = _cache.Find(k);
+    if (c) return c;
+    return _cache.Insert(k,
+                         make_shared<const MagneticCircle>
+                         (_model.Circle(t, lat, h)));
+  }
+
+} // namespace GeographicLib
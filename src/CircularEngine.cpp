@@ -93,4 +93,101 @@ namespace GeographicLib {
     return vc;
   }
 
+  void CircularEngine::Values(bool gradp, real lon0, real dlon, int n,
+                              real V[],
+                              real gradx[], real grady[], real gradz[]) const
+  {
+    gradp = _gradp && gradp;
+    const int K = SphericalEngine::lanes;
+    const vector<real>& root( SphericalEngine::sqrttable() );
+    for (int i0 = 0; i0 < n; i0 += K) {
+      // Process the longitudes [i0, i0 + nk) as K lanes; the unused lanes
+      // duplicate the last longitude.
+      int nk = min(K, n - i0);
+      real sl[K], cl[K];
+      for (int i = 0; i < K; ++i)
+        Math::sincosd(lon0 + (i0 + min(i, nk - 1)) * dlon, sl[i], cl[i]);
+      // Initialize outer sums
+      real vc [K] = {}, vc2 [K] = {}, vs [K] = {}, vs2 [K] = {},
+        vrc[K] = {}, vrc2[K] = {}, vrs[K] = {}, vrs2[K] = {},
+        vtc[K] = {}, vtc2[K] = {}, vts[K] = {}, vts2[K] = {},
+        vlc[K] = {}, vlc2[K] = {}, vls[K] = {}, vls2[K] = {};
+      for (int m = _mM; m >= 0; --m) {           // m = M .. 0
+        if (m) {
+          real v, B;            // The longitude independent parts
+          switch (_norm) {
+          case FULL:
+            v = root[2] * root[2 * m + 3] / root[m + 1];
+            B = - v * root[2 * m + 5] / (root[8] * root[m + 2]) * _uq2;
+            break;
+          case SCHMIDT:
+            v = root[2] * root[2 * m + 1] / root[m + 1];
+            B = - v * root[2 * m + 3] / (root[8] * root[m + 2]) * _uq2;
+            break;
+          default:
+            v = B = 0;
+          }
+          for (int i = 0; i < K; ++i) {
+            real A = cl[i] * v * _uq, w;
+            w = A * vc [i] + B * vc2 [i] +  _wc[m] ;
+            vc2 [i] = vc [i]; vc [i] = w;
+            w = A * vs [i] + B * vs2 [i] +  _ws[m] ;
+            vs2 [i] = vs [i]; vs [i] = w;
+            if (gradp) {
+              w = A * vrc[i] + B * vrc2[i] +  _wrc[m];
+              vrc2[i] = vrc[i]; vrc[i] = w;
+              w = A * vrs[i] + B * vrs2[i] +  _wrs[m];
+              vrs2[i] = vrs[i]; vrs[i] = w;
+              w = A * vtc[i] + B * vtc2[i] +  _wtc[m];
+              vtc2[i] = vtc[i]; vtc[i] = w;
+              w = A * vts[i] + B * vts2[i] +  _wts[m];
+              vts2[i] = vts[i]; vts[i] = w;
+              w = A * vlc[i] + B * vlc2[i] + m*_ws[m];
+              vlc2[i] = vlc[i]; vlc[i] = w;
+              w = A * vls[i] + B * vls2[i] - m*_wc[m];
+              vls2[i] = vls[i]; vls[i] = w;
+            }
+          }
+        } else {
+          real A, B, qs;
+          switch (_norm) {
+          case FULL:
+            A = root[3] * _uq;       // F[1]/(q*cl) or F[1]/(q*sl)
+            B = - root[15]/2 * _uq2; // beta[1]/q
+            break;
+          case SCHMIDT:
+            A = _uq;
+            B = - root[3]/2 * _uq2;
+            break;
+          default:
+            A = B = 0;
+          }
+          qs = _q / SphericalEngine::scale();
+          real qr = qs / _r, qu = qr / _u;
+          for (int i = 0; i < K; ++i) {
+            vc[i] = qs * (_wc[m] + A * (cl[i] * vc[i] + sl[i] * vs[i]) +
+                          B * vc2[i]);
+            if (gradp) {
+              vrc[i] =  - qr * (_wrc[m] + A * (cl[i] * vrc[i] + sl[i] * vrs[i])
+                                + B * vrc2[i]);
+              vtc[i] =    qr * (_wtc[m] + A * (cl[i] * vtc[i] + sl[i] * vts[i])
+                                + B * vtc2[i]);
+              vlc[i] =    qu * (          A * (cl[i] * vlc[i] + sl[i] * vls[i])
+                                + B * vlc2[i]);
+            }
+          }
+        }
+      }
+      for (int i = 0; i < nk; ++i) {
+        V[i0 + i] = vc[i];
+        if (gradp) {
+          // Rotate into cartesian (geocentric) coordinates
+          gradx[i0 + i] = cl[i] * (_u * vrc[i] + _t * vtc[i]) - sl[i] * vlc[i];
+          grady[i0 + i] = sl[i] * (_u * vrc[i] + _t * vtc[i]) + cl[i] * vlc[i];
+          gradz[i0 + i] =           _t * vrc[i] - _u * vtc[i]                ;
+        }
+      }
+    }
+  }
+
 } // namespace GeographicLib
@@ -203,18 +203,103 @@ namespace GeographicLib {
                                     const AuxAngle& zeta1,
                                     const AuxAngle& zeta2)
     const {
-    using std::isnan;           // Needed for Centos 7, ubuntu 14
     int k = base::ind(auxout, auxin);
     if (k < 0) return numeric_limits<real>::quiet_NaN();
     if (auxin == auxout) return 1;
-    if ( isnan(base::_c[base::Lmax * (k + 1) - 1]) )
-      base::fillcoeff(auxin, auxout, k);
     AuxAngle zeta1n(zeta1.normalized()), zeta2n(zeta2.normalized());
     return 1 + DClenshaw(true, zeta2n.radians() - zeta1n.radians(),
                          zeta1n.y(), zeta1n.x(), zeta2n.y(), zeta2n.x(),
                          base::_c + base::Lmax * k, base::Lmax);
   }
 
+  void DAuxLatitude::DConvert(int auxin, int auxout, size_t n,
+                              const real zeta1y[], const real zeta1x[],
+                              const real zeta2y[], const real zeta2x[],
+                              real D[]) const {
+    int k = base::ind(auxout, auxin);
+    if (k < 0 || auxin == auxout) {
+      for (size_t i = 0; i < n; ++i)
+        D[i] = k < 0 ? numeric_limits<real>::quiet_NaN() : 1;
+      return;
+    }
+    const int K = base::lanes;
+    for (size_t i0 = 0; i0 < n; i0 += K) {
+      // The normalization of all the angles in a group is done together, as
+      // are the Clenshaw sums.
+      int nk = int(min(size_t(K), n - i0));
+      real s1[K], c1[K], s2[K], c2[K], Delta[K];
+      copy(zeta1y + i0, zeta1y + i0 + nk, s1);
+      copy(zeta1x + i0, zeta1x + i0 + nk, c1);
+      copy(zeta2y + i0, zeta2y + i0 + nk, s2);
+      copy(zeta2x + i0, zeta2x + i0 + nk, c2);
+      AuxAngle::normalize(nk, s1, c1);
+      AuxAngle::normalize(nk, s2, c2);
+      for (int i = 0; i < nk; ++i)
+        Delta[i] = atan2(s2[i], c2[i]) - atan2(s1[i], c1[i]);
+      DClenshaw(true, nk, Delta, s1, c1, s2, c2,
+                base::_c + base::Lmax * k, base::Lmax, D + i0);
+      for (int i = 0; i < nk; ++i)
+        D[i0 + i] = 1 + D[i0 + i];
+    }
+  }
+
+  void DAuxLatitude::DClenshaw(bool sinp, size_t n, const real Delta[],
+                               const real szeta1[], const real czeta1[],
+                               const real szeta2[], const real czeta2[],
+                               const real c[], int K, real D[]) {
+    // The steps are the same as in the scalar version, so that the results
+    // are identical.
+    const int L = base::lanes;
+    for (size_t i0 = 0; i0 < n; i0 += L) {
+      // Process the pairs [i0, i0 + nl) as L lanes; the unused lanes
+      // duplicate the last pair.
+      int nl = int(min(size_t(L), n - i0));
+      real D2[L], czetap[L], szetap[L], czetam[L], szetamd[L], Xa[L], Xb[L],
+        u0a[L], u0b[L], u1a[L], u1b[L];
+      for (int i = 0; i < L; ++i) {
+        size_t j = i0 + min(i, nl - 1);
+        real d = Delta[j],
+          s1 = szeta1[j], c1 = czeta1[j], s2 = szeta2[j], c2 = czeta2[j];
+        D2[i] = d * d;
+        czetap[i] = c2 * c1 - s2 * s1;
+        szetap[i] = s2 * c1 + c2 * s1;
+        czetam[i] = c2 * c1 + s2 * s1;
+        szetamd[i] = (d == 1 ? s2 * c1 - c2 * s1 :
+                      (d != 0 ? sin(d) / d : 1));
+        Xa[i] =  2 * czetap[i] * czetam[i];
+        Xb[i] = -2 * szetap[i] * szetamd[i];
+        u0a[i] = u0b[i] = u1a[i] = u1b[i] = 0;
+      }
+      for (int k = K - 1; k >= 0; --k) {
+        real ck = c[k];
+        for (int i = 0; i < L; ++i) {
+          real ta = Xa[i] * u0a[i] + D2[i] * Xb[i] * u0b[i] - u1a[i] + ck,
+            tb = Xb[i] * u0a[i] +         Xa[i] * u0b[i] - u1b[i];
+          u1a[i] = u0a[i]; u0a[i] = ta;
+          u1b[i] = u0b[i]; u0b[i] = tb;
+        }
+      }
+      for (int i = 0; i < nl; ++i) {
+        real F0a = (sinp ? szetap[i] :  czetap[i]) * czetam[i],
+          F0b = (sinp ? czetap[i] : -szetap[i]) * szetamd[i],
+          Fm1a = sinp ? 0 : 1;
+        D[i0 + i] = 2 * (F0a * u0b[i] + F0b * u0a[i]  - Fm1a * u1b[i]);
+      }
+    }
+  }
+
+  void DAuxLatitude::Dlam(size_t n, const real x[], const real y[],
+                          real D[]) {
+    for (size_t i = 0; i < n; ++i)
+      D[i] = Dlam(x[i], y[i]);
+  }
+
+  void DAuxLatitude::Dp0Dpsi(size_t n, const real x[], const real y[],
+                             real D[]) {
+    for (size_t i = 0; i < n; ++i)
+      D[i] = Dp0Dpsi(x[i], y[i]);
+  }
+
   Math::real DAuxLatitude::DClenshaw(bool sinp, real Delta,
                                      real szeta1, real czeta1,
                                      real szeta2, real czeta2,
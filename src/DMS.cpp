@@ -100,6 +100,13 @@ namespace GeographicLib {
     // « U+00ab    171  c2 ab      left guillemot (for cgi-bin)
     // » U+00bb    187  c2 bb      right guillemot (for cgi-bin)
 
+    {
+      real v;
+      if (DecodeDecimal(dms, v)) {
+        ind = NONE;
+        return v;
+      }
+    }
     string dmsa = dms;
     replace(dmsa, "\xc2\xb0",     'd' ); // U+00b0 degree symbol
     replace(dmsa, "\xc2\xba",     'd' ); // U+00ba alt symbol
@@ -194,6 +201,46 @@ namespace GeographicLib {
     return v;
   }
 
+  bool DMS::DecodeDecimal(const string& dms, real& v) {
+    // Decode [+-]ddd.ddd, possibly surrounded by white space.  Return false
+    // if dms has any other form or if the conversion might not be correctly
+    // rounded.  The significand M and the number of fractional digits f are
+    // limited so that M and 10^f are exact; then M / 10^f is correctly
+    // rounded and so agrees with the result of the full parser.
+    static const int maxdig = Math::digits10();
+    const char* p = dms.data();
+    const char* end = p + dms.size();
+    while (p < end && isspace(*p)) ++p;
+    while (p < end && isspace(end[-1])) --end;
+    bool neg = false;
+    if (p < end && (*p == '-' || *p == '+'))
+      neg = *p++ == '-';
+    real m = 0;
+    int ndig = 0, nfrac = 0, sig = 0;
+    bool pointseen = false;
+    for (; p < end; ++p) {
+      char c = *p;
+      if (c >= '0' && c <= '9') {
+        ++ndig;
+        if (pointseen) ++nfrac;
+        if (sig > 0 || c != '0') ++sig;
+        m = 10 * m + (c - '0');
+      } else if (c == '.' && !pointseen)
+        pointseen = true;
+      else
+        return false;
+    }
+    if (ndig == 0 || sig > maxdig || nfrac > maxdig)
+      return false;
+    if (nfrac > 0) {
+      real d = 1;
+      for (int i = 0; i < nfrac; ++i) d *= 10;
+      m /= d;
+    }
+    v = neg ? -m : m;
+    return true;
+  }
+
   Math::real DMS::InternalDecode(const string& dmsa, flag& ind) {
     string errormsg;
     do {                       // Executed once (provides the ability to break)
@@ -476,40 +523,40 @@ namespace GeographicLib {
     }
     // No glue together degree+minute+second with
     // sign + zero-fill + delimiters + hemisphere
-    ostringstream str;
+    string str;
+    // Append t zero-filled to width w
+    auto pad = [&str] (const string& t, size_t w) -> void {
+      if (t.size() < w) str.append(w - t.size(), '0');
+      str += t;
+    };
     if (prec) ++prec;           // Extra width for decimal point
     if (ind == NONE && sign < 0)
-      str << '-';
-    str << setfill('0');
+      str += '-';
     switch (trailing) {
     case DEGREE:
-      if (ind != NONE)
-        str << setw(1 + min(int(ind), 2) + prec);
-      str << degree;
+      pad(degree, ind != NONE ? 1 + min(int(ind), 2) + prec : 0);
       // Don't include degree designator (d) if it is the trailing component.
       break;
     case MINUTE:
-      if (ind != NONE)
-        str << setw(1 + min(int(ind), 2));
-      str << degree << (dmssep ? dmssep : char(tolower(dmsindicators_[0])))
-          << setw(2 + prec) << minute;
+      pad(degree, ind != NONE ? 1 + min(int(ind), 2) : 0);
+      str += dmssep ? dmssep : char(tolower(dmsindicators_[0]));
+      pad(minute, 2 + prec);
       if (!dmssep)
-        str << char(tolower(dmsindicators_[1]));
+        str += char(tolower(dmsindicators_[1]));
       break;
     default:                    // case SECOND:
-      if (ind != NONE)
-        str << setw(1 + min(int(ind), 2));
-      str << degree << (dmssep ? dmssep : char(tolower(dmsindicators_[0])))
-          << setw(2)
-          << minute << (dmssep ? dmssep : char(tolower(dmsindicators_[1])))
-          << setw(2 + prec) << second;
+      pad(degree, ind != NONE ? 1 + min(int(ind), 2) : 0);
+      str += dmssep ? dmssep : char(tolower(dmsindicators_[0]));
+      pad(minute, 2);
+      str += dmssep ? dmssep : char(tolower(dmsindicators_[1]));
+      pad(second, 2 + prec);
       if (!dmssep)
-        str << char(tolower(dmsindicators_[2]));
+        str += char(tolower(dmsindicators_[2]));
       break;
     }
     if (ind != NONE && ind != AZIMUTH)
-      str << hemispheres_[(ind == LATITUDE ? 0 : 2) + (sign < 0 ? 0 : 1)];
-    return str.str();
+      str += hemispheres_[(ind == LATITUDE ? 0 : 2) + (sign < 0 ? 0 : 1)];
+    return str;
   }
 
 } // namespace GeographicLib
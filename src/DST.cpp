@@ -8,6 +8,8 @@
  **********************************************************************/
 
 #include <GeographicLib/DST.hpp>
+#include <GeographicLib/Registry.hpp>
+#include <complex>
 #include <vector>
 
 #include "kissfft.hh"
@@ -18,22 +20,45 @@ namespace GeographicLib {
 
   DST::DST(int N)
     : _N(N < 0 ? 0 : N)
-    , _fft(make_shared<fft_t>(fft_t(2 * _N, false)))
+    , _fft(plan(_N))
   {}
 
   void DST::reset(int N) {
     N = N < 0 ? 0 : N;
     if (N == _N) return;
     _N = N;
-    _fft->assign(2 * _N, false);
+    // Replace (instead of modifying) _fft since the plan may be shared.
+    _fft = plan(_N);
   }
 
-  void DST::fft_transform(real data[], real F[], bool centerp) const {
+  shared_ptr<DST::fft_t> DST::plan(int N) {
+    // The FFT has size 2*N.  kissfft uses a mutable scratch buffer for
+    // factors other than 2, 3, 4, and 5, so such plans can't be shared
+    // between threads; these are rare and aren't cached.
+    int m = 2 * N;
+    for (int p = 2; p <= 5; ++p)
+      while (m > 1 && m % p == 0) m /= p;
+    if (m > 1)
+      return make_shared<fft_t>(fft_t(2 * N, false));
+    // The twiddle factors depend on the precision with
+    // GEOGRAPHICLIB_PRECISION = 5, so include this in the key.
+    const pair<int, int> key(N, Math::digits());
+    // Looking up a plan doesn't take a lock.
+    static Registry<pair<int, int>, fft_t> cache(256);
+    shared_ptr<fft_t> fft = cache.Find(key);
+    return fft ? fft :
+      cache.Insert(key, make_shared<fft_t>(fft_t(2 * N, false)));
+  }
+
+  void DST::fft_transform(real data[], real F[], bool centerp,
+                          complex<real> ctemp[],
+                          const complex<real> twist[]) const {
     // Implement DST-III (centerp = false) or DST-IV (centerp = true).
 
     // Elements (0,N], resp. [0,N), of data should be set on input for centerp
     // = false, resp. true.  F must have a size of at least N and on output
-    // elements [0,N) of F contain the transform.
+    // elements [0,N) of F contain the transform.  ctemp is a scratch array of
+    // size 2*N and, for centerp = true, twist is the array given by twists.
     if (_N == 0) return;
     if (centerp) {
       for (int i = 0; i < _N; ++i) {
@@ -46,24 +71,23 @@ namespace GeographicLib {
       for (int i = 1; i < _N; ++i) data[_N+i] = data[_N-i]; // set [N+1,2*N-1]
       for (int i = 0; i < 2*_N; ++i) data[2*_N+i] = -data[i]; // [2*N, 4*N-1]
     }
-    vector<complex<real>> ctemp(2*_N);
-    _fft->transform_real(data, ctemp.data());
+    _fft->transform_real(data, ctemp);
     if (centerp) {
-      real d = -Math::pi()/(4*_N);
       for (int i = 0, j = 1; i < _N; ++i, j+=2)
-        ctemp[j] *= exp(complex<real>(0, j*d));
+        ctemp[j] *= twist[i];
     }
     for (int i = 0, j = 1; i < _N; ++i, j+=2) {
       F[i] = -ctemp[j].imag() / (2*_N);
     }
   }
 
-  void DST::fft_transform2(real data[], real F[]) const {
+  void DST::fft_transform2(real data[], real F[], complex<real> ctemp[],
+                           const complex<real> twist[]) const {
     // Elements [0,N), of data should be set to the N grid center values and F
     // should have size of at least 2*N.  On input elements [0,N) of F contain
     // the size N transform; on output elements [0,2*N) of F contain the size
     // 2*N transform.
-    fft_transform(data, F+_N, true);
+    fft_transform(data, F+_N, true, ctemp, twist);
     // Copy DST-IV order N tx to [0,N) elements of data
     for (int i = 0; i < _N; ++i) data[i] = F[i+_N];
     for (int i = _N; i < 2*_N; ++i)
@@ -74,20 +98,65 @@ namespace GeographicLib {
       F[i] = (data[i] + F[i])/2;
   }
 
+  vector<complex<Math::real>> DST::twists() const {
+    // The factors exp(-i*pi*(2*i+1)/(4*N)) applied to the odd elements of the
+    // FFT for the DST-IV.
+    vector<complex<real>> twist(_N);
+    real d = -Math::pi()/(4*_N);
+    for (int i = 0, j = 1; i < _N; ++i, j+=2)
+      twist[i] = exp(complex<real>(0, j*d));
+    return twist;
+  }
+
   void DST::transform(function<real(real)> f, real F[]) const {
     vector<real> data(4 * _N);
+    vector<complex<real>> ctemp(2 * _N);
     real d = Math::pi()/(2 * _N);
     for (int i = 1; i <= _N; ++i)
       data[i] = f( i * d );
-    fft_transform(data.data(), F, false);
+    fft_transform(data.data(), F, false, ctemp.data(), nullptr);
   }
 
   void DST::refine(function<real(real)> f, real F[]) const {
     vector<real> data(4 * _N);
+    vector<complex<real>> ctemp(2 * _N);
     real d = Math::pi()/(4 * _N);
     for (int i = 0; i < _N; ++i)
       data[i] = f( (2*i + 1) * d );
-    fft_transform2(data.data(), F);
+    fft_transform2(data.data(), F, ctemp.data(), twists().data());
+  }
+
+  void DST::transform(int M, function<void(real, real[])> f,
+                      real* const F[]) const {
+    if (M <= 0 || _N == 0) return;
+    // Sample all the functions into y (row i holds the values at point i)
+    // and then transform them one at a time using a single 4*N scratch
+    // array, which stays in the cache.
+    vector<real> y(size_t(_N) * M), data(4 * _N);
+    vector<complex<real>> ctemp(2 * _N);
+    real d = Math::pi()/(2 * _N);
+    for (int i = 1; i <= _N; ++i)
+      f( i * d, y.data() + size_t(i - 1) * M );
+    for (int k = 0; k < M; ++k) {
+      for (int i = 1; i <= _N; ++i)
+        data[i] = y[size_t(i - 1) * M + k];
+      fft_transform(data.data(), F[k], false, ctemp.data(), nullptr);
+    }
+  }
+
+  void DST::refine(int M, function<void(real, real[])> f,
+                   real* const F[]) const {
+    if (M <= 0 || _N == 0) return;
+    vector<real> y(size_t(_N) * M), data(4 * _N);
+    vector<complex<real>> ctemp(2 * _N), twist(twists());
+    real d = Math::pi()/(4 * _N);
+    for (int i = 0; i < _N; ++i)
+      f( (2*i + 1) * d, y.data() + size_t(i) * M );
+    for (int k = 0; k < M; ++k) {
+      for (int i = 0; i < _N; ++i)
+        data[i] = y[size_t(i) * M + k];
+      fft_transform2(data.data(), F[k], ctemp.data(), twist.data());
+    }
   }
 
   Math::real DST::eval(real sinx, real cosx, const real F[], int N) {
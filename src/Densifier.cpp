@@ -0,0 +1,146 @@
+/**
+ * \file Densifier.cpp
+ * \brief Implementation for GeographicLib::DensifierT class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/Densifier.hpp>
+#include <GeographicLib/GeodesicLine.hpp>
+#include <GeographicLib/GeodesicLineExact.hpp>
+#include <GeographicLib/Utility.hpp>
+#include <GeographicLib/Executor.hpp>
+#include <atomic>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  namespace {
+
+    typedef Math::real real;
+
+    // The line for a segment together with its length.
+    GeodesicLine SegmentLine(const Geodesic& g,
+                             real lat1, real lon1, real lat2, real lon2,
+                             real& s12) {
+      GeodesicLine l = g.InverseLine(lat1, lon1, lat2, lon2,
+                                     Geodesic::LATITUDE | Geodesic::LONGITUDE |
+                                     Geodesic::DISTANCE_IN);
+      s12 = l.Distance();
+      return l;
+    }
+
+    GeodesicLineExact SegmentLine(const GeodesicExact& g,
+                                  real lat1, real lon1, real lat2, real lon2,
+                                  real& s12) {
+      GeodesicLineExact l =
+        g.InverseLine(lat1, lon1, lat2, lon2,
+                      GeodesicExact::LATITUDE | GeodesicExact::LONGITUDE |
+                      GeodesicExact::DISTANCE_IN);
+      s12 = l.Distance();
+      return l;
+    }
+
+    RhumbLine SegmentLine(const Rhumb& r,
+                          real lat1, real lon1, real lat2, real lon2,
+                          real& s12) {
+      real azi12;
+      r.Inverse(lat1, lon1, lat2, lon2, s12, azi12);
+      return r.Line(lat1, lon1, azi12);
+    }
+
+    // Append to pts the points to be inserted between s12 = sa and sb whose
+    // projections are (xa, ya) and (xb, yb).
+    template<class Line, class Proj>
+    void Bisect(const Line& line, const Proj& proj, real tol, int depth,
+                real sa, real xa, real ya, real sb, real xb, real yb,
+                vector<real>& pts) {
+      if (depth <= 0) return;
+      real sm = (sa + sb) / 2, lat, lon, xm, ym;
+      line.Position(sm, lat, lon);
+      proj(lat, lon, xm, ym);
+      // The distance of m from the chord ab
+      real dx = xb - xa, dy = yb - ya, l = hypot(dx, dy),
+        dev = l > 0 ? fabs(dx * (ym - ya) - dy * (xm - xa)) / l :
+        hypot(xm - xa, ym - ya);
+      if (!(dev > tol)) return;
+      Bisect(line, proj, tol, depth - 1, sa, xa, ya, sm, xm, ym, pts);
+      pts.push_back(lat); pts.push_back(lon);
+      Bisect(line, proj, tol, depth - 1, sm, xm, ym, sb, xb, yb, pts);
+    }
+
+  } // namespace
+
+  template<class GeodType>
+  DensifierT<GeodType>::DensifierT(const GeodType& earth, int maxdepth)
+    : _earth(earth)
+    , _maxdepth(maxdepth)
+  {
+    if (!(maxdepth >= 0 && maxdepth <= 30))
+      throw GeographicErr("Maximum depth " + Utility::str(maxdepth)
+                          + " not in [0, 30]");
+  }
+
+  template<class GeodType>
+  void DensifierT<GeodType>::Densify(size_t n,
+                                     const real lat[], const real lon[],
+                                     real tol, const projection& proj,
+                                     const callback& out,
+                                     int nthreads) const {
+    if (!(tol > 0))
+      throw GeographicErr("Tolerance " + Utility::str(tol)
+                          + " is not positive");
+    if (n == 0) return;
+    // The segments are processed in batches so that the memory needed is
+    // bounded; within a batch, the threads claim blocks of segments.
+    const size_t nseg = n - 1, block = 16,
+      nthr = min(size_t(max(1, nthreads)), (nseg + block - 1) / block),
+      batch = 16 * block * max(size_t(1), nthr);
+    // The points inserted into each segment of the current batch as (lat,
+    // lon) pairs
+    vector<vector<real> > pts(min(nseg, batch));
+    auto segment = [&](size_t i, vector<real>& p) -> void {
+      p.clear();
+      real s12, xa, ya, xb, yb;
+      auto line =
+        SegmentLine(_earth, lat[i], lon[i], lat[i+1], lon[i+1], s12);
+      proj(lat[i], lon[i], xa, ya);
+      proj(lat[i+1], lon[i+1], xb, yb);
+      Bisect(line, proj, tol, _maxdepth, real(0), xa, ya, s12, xb, yb, p);
+    };
+    for (size_t b0 = 0; b0 < nseg; b0 += batch) {
+      const size_t b1 = min(nseg, b0 + batch),
+        nblocks = (b1 - b0 + block - 1) / block,
+        nt = min(nthr, nblocks);
+      if (nt <= 1) {
+        for (size_t i = b0; i < b1; ++i)
+          segment(i, pts[i - b0]);
+      } else {
+        // The segments are claimed in blocks with an atomic counter.
+        atomic<size_t> next(0);
+        auto work = [&](int) -> void {
+          for (size_t k; (k = next++) < nblocks;)
+            for (size_t i = b0 + k * block;
+                 i < min(b1, b0 + (k + 1) * block); ++i)
+              segment(i, pts[i - b0]);
+        };
+        Executor::RunGuarded(int(nt), work, [&]() -> void { next = nblocks; });
+      }
+      for (size_t i = b0; i < b1; ++i) {
+        const vector<real>& p = pts[i - b0];
+        out(i, lat[i], lon[i]);
+        for (size_t k = 0; k < p.size(); k += 2)
+          out(i, p[k], p[k+1]);
+      }
+    }
+    out(n - 1, lat[n - 1], lon[n - 1]);
+  }
+
+  template class GEOGRAPHICLIB_EXPORT DensifierT<Geodesic>;
+  template class GEOGRAPHICLIB_EXPORT DensifierT<GeodesicExact>;
+  template class GEOGRAPHICLIB_EXPORT DensifierT<Rhumb>;
+
+} // namespace GeographicLib
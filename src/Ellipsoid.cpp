@@ -8,6 +8,7 @@
  **********************************************************************/
 
 #include <GeographicLib/Ellipsoid.hpp>
+#include <algorithm>
 
 #if defined(_MSC_VER)
 // Squelch warnings about enum-float expressions
@@ -18,6 +19,68 @@ namespace GeographicLib {
 
   using namespace std;
 
+  namespace {
+
+    typedef Math::real real;
+
+    // Sum the Chebyshev series c[0] + sum(c[k] * T_k(t), k, 1, n-1) using
+    // Clenshaw summation.
+    inline real ChebSum(const real c[], int n, real t) {
+      real b1 = 0, b2 = 0, t2 = 2 * t;
+      for (int k = n; --k > 0;) {
+        real b0 = t2 * b1 - b2 + c[k];
+        b2 = b1; b1 = b0;
+      }
+      return c[0] + t * b1 - b2;
+    }
+
+    // The rectifying latitude (degrees) for the meridian distance s with
+    // quarter meridian l.  This is clamped to [-90, 90] if it lies outside
+    // this range because of roundoff (e.g., with s = 90 * (l / 90)); larger
+    // values of |s| still give NaN in the conversion to phi.
+    inline real MeridianMu(real s, real l) {
+      real mu = Math::qd * (s / l);
+      return fabs(mu) > Math::qd &&
+        fabs(mu) <= Math::qd * (1 + 4 * numeric_limits<real>::epsilon()) ?
+        copysign(real(Math::qd), mu) : mu;
+    }
+
+    // Fit h(x) = (exact(x) - x) / (x * (q - x)) on [a, b] with n Chebyshev
+    // coefficients and append to x and c; bisect [a, b] if the error at 3*n
+    // test points exceeds tol.  Return the maximum error.
+    template<class Exact>
+    real TabFit(Exact exact, int n, real q, real a, real b, real tol,
+                vector<real>& x, vector<real>& c) {
+      real m = (a + b) / 2, r = (b - a) / 2, pn = Math::pi() / n;
+      vector<real> h(n), cc(n, 0);
+      for (int j = 0; j < n; ++j) {
+        real xx = m + r * cos(pn * (j + real(0.5)));
+        h[j] = (exact(xx) - xx) / (xx * (q - xx));
+      }
+      for (int k = 0; k < n; ++k) {
+        for (int j = 0; j < n; ++j)
+          cc[k] += h[j] * cos(pn * k * (j + real(0.5)));
+        cc[k] *= (k == 0 ? 1 : 2) / real(n);
+      }
+      real err = 0;
+      for (int i = 0, nt = 3 * n; i < nt; ++i) {
+        real t = -1 + 2 * (i + real(0.5)) / nt, xx = m + r * t;
+        err = fmax(err, fabs(xx + xx * (q - xx) * ChebSum(cc.data(), n, t)
+                             - exact(xx)));
+      }
+      if (err <= tol) {
+        x.push_back(b);
+        c.insert(c.end(), cc.begin(), cc.end());
+        return err;
+      }
+      if (!(r > q * numeric_limits<real>::epsilon() * (1 << 16)))
+        throw GeographicErr("Tolerance too small in Ellipsoid::Tabulate");
+      real err1 = TabFit(exact, n, q, a, m, tol, x, c);
+      return fmax(err1, TabFit(exact, n, q, m, b, tol, x, c));
+    }
+
+  } // namespace
+
   /// \cond SKIP
   Ellipsoid::Ellipsoid(real a, real f)
     : stol_(real(0.01) * sqrt(numeric_limits<real>::epsilon()))
@@ -30,6 +93,8 @@ namespace GeographicLib {
     , _aux(_a, _f)
     , _rm(_aux.RectifyingRadius(true))
     , _c2(_aux.AuthalicRadiusSquared(true))
+    , _tabn(0)
+    , _taberr(0)
   {}
   /// \endcond
 
@@ -38,61 +103,134 @@ namespace GeographicLib {
     return wgs84;
   }
 
+#if GEOGRAPHICLIB_EAGER_SINGLETONS && GEOGRAPHICLIB_PRECISION != 5
+  namespace {
+    // Construct Ellipsoid::WGS84() when the library is loaded (see
+    // Geodesic.cpp).
+    const Ellipsoid& wgs84init_ = Ellipsoid::WGS84();
+  }
+#endif
+
   Math::real Ellipsoid::QuarterMeridian() const
   { return Math::pi()/2 * _rm; }
 
   Math::real Ellipsoid::Area() const
   { return 4 * Math::pi() * _c2; }
 
-  Math::real Ellipsoid::ParametricLatitude(real phi) const {
-    return _aux.Convert(AuxLatitude::PHI, AuxLatitude::BETA,
-                        Math::LatFix(phi), true);
+  int Ellipsoid::tabindex(int auxin, int auxout) {
+    // -1 if the conversion is not tabulated
+    int aux = auxin == AuxLatitude::PHI ? auxout :
+      (auxout == AuxLatitude::PHI ? auxin : -1),
+      k = aux == AuxLatitude::MU ? 0 :
+      (aux == AuxLatitude::CHI ? 1 : (aux == AuxLatitude::XI ? 2 : -1));
+    return k < 0 ? -1 : 2 * k + (auxin == AuxLatitude::PHI ? 0 : 1);
   }
 
-  Math::real Ellipsoid::InverseParametricLatitude(real beta) const {
-    return _aux.Convert(AuxLatitude::BETA, AuxLatitude::PHI,
-                        Math::LatFix(beta), true);
+  void Ellipsoid::Tabulate(real tol) {
+    if (tol == 0) tol = 8 * numeric_limits<real>::epsilon();
+    if (!(tol >= 2 * numeric_limits<real>::epsilon()))
+      throw GeographicErr("Tolerance too small in Ellipsoid::Tabulate");
+    // Number of coefficients in each piece, as for EllipticFunction::Tabulate
+    int n = max(8, Math::digits() / 5);
+    real q = Math::qd * Math::degree(), err = 0;
+    vector<real> tab[6];
+    const int aux[3] = {AuxLatitude::MU, AuxLatitude::CHI, AuxLatitude::XI};
+    for (int k = 0; k < 6; ++k) {
+      int auxin = k & 1 ? aux[k/2] : int(AuxLatitude::PHI),
+        auxout = k & 1 ? int(AuxLatitude::PHI) : aux[k/2];
+      vector<real> x(1, 0), c;
+      err = fmax(err, TabFit([this, auxin, auxout] (real zeta) -> real
+                             { return _aux.Convert(auxin, auxout,
+                                                   AuxAngle(sin(zeta),
+                                                            cos(zeta)),
+                                                   true).radians(); },
+                             n, q, 0, q, tol, x, c));
+      x.insert(x.end(), c.begin(), c.end());
+      tab[tabindex(auxin, auxout)].swap(x);
+    }
+    for (int k = 0; k < 6; ++k)
+      _tab[k].swap(tab[k]);
+    _tabn = n;
+    _taberr = err;
   }
 
-  Math::real Ellipsoid::GeocentricLatitude(real phi) const {
-    return _aux.Convert(AuxLatitude::PHI, AuxLatitude::THETA,
-                        Math::LatFix(phi), true);
+  Math::real Ellipsoid::tabeval(const vector<real>& t, real zeta,
+                                size_t& i) const {
+    // t holds the m + 1 breakpoints followed by _tabn coefficients for each
+    // of the m pieces.  The conversions are odd functions of zeta.  On input
+    // i is a guess for the piece, e.g., the one used for the previous
+    // element of a sorted array; it's checked in O(1) before resorting to a
+    // binary search.  On output i is the piece used.
+    real z = fabs(zeta);
+    if (!(z <= Math::qd)) return Math::NaN();
+    real x = z * Math::degree(), q = Math::qd * Math::degree();
+    size_t m = (t.size() - 1) / (_tabn + 1);
+    if (!(i < m && t[i] <= x && (x < t[i + 1] || i + 1 == m))) {
+      if (i + 1 < m && t[i + 1] <= x && (i + 2 == m || x < t[i + 2]))
+        ++i;                    // the next piece
+      else if (i > 0 && i < m && t[i - 1] <= x && x < t[i])
+        --i;                    // the previous piece
+      else
+        i = upper_bound(t.begin() + 1, t.begin() + m, x) - (t.begin() + 1);
+    }
+    real a = t[i], b = t[i + 1],
+      h = ChebSum(t.data() + m + 1 + i * _tabn, _tabn,
+                  (2 * x - a - b) / (b - a));
+    return copysign(z + x * (q - x) * h / Math::degree(), zeta);
   }
 
-  Math::real Ellipsoid::InverseGeocentricLatitude(real theta) const {
-    return _aux.Convert(AuxLatitude::THETA, AuxLatitude::PHI,
-                        Math::LatFix(theta), true);
+  Math::real Ellipsoid::convert(int auxin, int auxout, real zeta) const {
+    int k = _tabn ? tabindex(auxin, auxout) : -1;
+    zeta = Math::LatFix(zeta);
+    size_t i = 0;
+    return k >= 0 ? tabeval(_tab[k], zeta, i) :
+      _aux.Convert(auxin, auxout, zeta, true);
   }
 
-  Math::real Ellipsoid::RectifyingLatitude(real phi) const {
-    return _aux.Convert(AuxLatitude::PHI, AuxLatitude::MU,
-                        Math::LatFix(phi), true);
+  void Ellipsoid::convert(int auxin, int auxout,
+                          size_t n, const real zeta[], real eta[]) const {
+    int k = _tabn ? tabindex(auxin, auxout) : -1;
+    if (k >= 0) {
+      // Because the piece found for each element is the starting guess for
+      // the next one, sorted (or slowly varying) inputs don't need a search.
+      size_t j = 0;
+      for (size_t i = 0; i < n; ++i)
+        eta[i] = tabeval(_tab[k], Math::LatFix(zeta[i]), j);
+    }
+    else
+      for (size_t i = 0; i < n; ++i)
+        eta[i] = _aux.Convert(auxin, auxout, Math::LatFix(zeta[i]), true);
   }
 
-  Math::real Ellipsoid::InverseRectifyingLatitude(real mu) const {
-    return _aux.Convert(AuxLatitude::MU, AuxLatitude::PHI,
-                        Math::LatFix(mu), true);
-  }
+  Math::real Ellipsoid::ParametricLatitude(real phi) const
+  { return convert(AuxLatitude::PHI, AuxLatitude::BETA, phi); }
 
-  Math::real Ellipsoid::AuthalicLatitude(real phi) const {
-    return _aux.Convert(AuxLatitude::PHI, AuxLatitude::XI,
-                        Math::LatFix(phi), true);
-  }
+  Math::real Ellipsoid::InverseParametricLatitude(real beta) const
+  { return convert(AuxLatitude::BETA, AuxLatitude::PHI, beta); }
 
-  Math::real Ellipsoid::InverseAuthalicLatitude(real xi) const {
-    return _aux.Convert(AuxLatitude::XI, AuxLatitude::PHI,
-                        Math::LatFix(xi), true);
-  }
+  Math::real Ellipsoid::GeocentricLatitude(real phi) const
+  { return convert(AuxLatitude::PHI, AuxLatitude::THETA, phi); }
 
-  Math::real Ellipsoid::ConformalLatitude(real phi) const {
-    return _aux.Convert(AuxLatitude::PHI, AuxLatitude::CHI,
-                        Math::LatFix(phi), true);
-  }
+  Math::real Ellipsoid::InverseGeocentricLatitude(real theta) const
+  { return convert(AuxLatitude::THETA, AuxLatitude::PHI, theta); }
 
-  Math::real Ellipsoid::InverseConformalLatitude(real chi) const {
-    return _aux.Convert(AuxLatitude::CHI, AuxLatitude::PHI,
-                        Math::LatFix(chi), true);
-  }
+  Math::real Ellipsoid::RectifyingLatitude(real phi) const
+  { return convert(AuxLatitude::PHI, AuxLatitude::MU, phi); }
+
+  Math::real Ellipsoid::InverseRectifyingLatitude(real mu) const
+  { return convert(AuxLatitude::MU, AuxLatitude::PHI, mu); }
+
+  Math::real Ellipsoid::AuthalicLatitude(real phi) const
+  { return convert(AuxLatitude::PHI, AuxLatitude::XI, phi); }
+
+  Math::real Ellipsoid::InverseAuthalicLatitude(real xi) const
+  { return convert(AuxLatitude::XI, AuxLatitude::PHI, xi); }
+
+  Math::real Ellipsoid::ConformalLatitude(real phi) const
+  { return convert(AuxLatitude::PHI, AuxLatitude::CHI, phi); }
+
+  Math::real Ellipsoid::InverseConformalLatitude(real chi) const
+  { return convert(AuxLatitude::CHI, AuxLatitude::PHI, chi); }
 
   Math::real Ellipsoid::IsometricLatitude(real phi) const {
     return _aux.Convert(AuxLatitude::PHI, AuxLatitude::CHI,
@@ -104,6 +242,68 @@ namespace GeographicLib {
                          AuxAngle::lamd(psi), true).degrees();
   }
 
+  void Ellipsoid::ParametricLatitude(size_t n, const real phi[], real beta[])
+    const {
+    convert(AuxLatitude::PHI, AuxLatitude::BETA, n, phi, beta);
+  }
+
+  void Ellipsoid::InverseParametricLatitude(size_t n, const real beta[],
+                                            real phi[]) const {
+    convert(AuxLatitude::BETA, AuxLatitude::PHI, n, beta, phi);
+  }
+
+  void Ellipsoid::GeocentricLatitude(size_t n, const real phi[], real theta[])
+    const {
+    convert(AuxLatitude::PHI, AuxLatitude::THETA, n, phi, theta);
+  }
+
+  void Ellipsoid::InverseGeocentricLatitude(size_t n, const real theta[],
+                                            real phi[]) const {
+    convert(AuxLatitude::THETA, AuxLatitude::PHI, n, theta, phi);
+  }
+
+  void Ellipsoid::RectifyingLatitude(size_t n, const real phi[], real mu[])
+    const {
+    convert(AuxLatitude::PHI, AuxLatitude::MU, n, phi, mu);
+  }
+
+  void Ellipsoid::InverseRectifyingLatitude(size_t n, const real mu[],
+                                            real phi[]) const {
+    convert(AuxLatitude::MU, AuxLatitude::PHI, n, mu, phi);
+  }
+
+  void Ellipsoid::AuthalicLatitude(size_t n, const real phi[], real xi[])
+    const {
+    convert(AuxLatitude::PHI, AuxLatitude::XI, n, phi, xi);
+  }
+
+  void Ellipsoid::InverseAuthalicLatitude(size_t n, const real xi[], real phi[])
+    const {
+    convert(AuxLatitude::XI, AuxLatitude::PHI, n, xi, phi);
+  }
+
+  void Ellipsoid::ConformalLatitude(size_t n, const real phi[], real chi[])
+    const {
+    convert(AuxLatitude::PHI, AuxLatitude::CHI, n, phi, chi);
+  }
+
+  void Ellipsoid::InverseConformalLatitude(size_t n, const real chi[],
+                                           real phi[]) const {
+    convert(AuxLatitude::CHI, AuxLatitude::PHI, n, chi, phi);
+  }
+
+  void Ellipsoid::IsometricLatitude(size_t n, const real phi[], real psi[])
+    const {
+    for (size_t i = 0; i < n; ++i)
+      psi[i] = IsometricLatitude(phi[i]);
+  }
+
+  void Ellipsoid::InverseIsometricLatitude(size_t n, const real psi[],
+                                           real phi[]) const {
+    for (size_t i = 0; i < n; ++i)
+      phi[i] = InverseIsometricLatitude(psi[i]);
+  }
+
   Math::real Ellipsoid::CircleRadius(real phi) const {
     // a * cos(beta)
     AuxAngle beta(_aux.Convert(AuxLatitude::PHI, AuxLatitude::BETA,
@@ -121,9 +321,36 @@ namespace GeographicLib {
   }
 
   Math::real Ellipsoid::MeridianDistance(real phi) const {
-    return _rm * _aux.Convert(AuxLatitude::PHI, AuxLatitude::MU,
-                              AuxAngle::degrees(Math::LatFix(phi)),
-                              true).radians();
+    return _tabn ?
+      _rm * Math::degree() * convert(AuxLatitude::PHI, AuxLatitude::MU, phi) :
+      _rm * _aux.Convert(AuxLatitude::PHI, AuxLatitude::MU,
+                         AuxAngle::degrees(Math::LatFix(phi)),
+                         true).radians();
+  }
+
+  Math::real Ellipsoid::InverseMeridianDistance(real s) const {
+    // Dividing by the QuarterMeridian ensures that s = L gives mu = 90.
+    return convert(AuxLatitude::MU, AuxLatitude::PHI,
+                   MeridianMu(s, QuarterMeridian()));
+  }
+
+  void Ellipsoid::MeridianDistance(size_t n, const real phi[], real s[])
+    const {
+    if (_tabn) {
+      convert(AuxLatitude::PHI, AuxLatitude::MU, n, phi, s);
+      for (size_t i = 0; i < n; ++i)
+        s[i] *= _rm * Math::degree();
+    } else
+      for (size_t i = 0; i < n; ++i)
+        s[i] = MeridianDistance(phi[i]);
+  }
+
+  void Ellipsoid::InverseMeridianDistance(size_t n, const real s[],
+                                          real phi[]) const {
+    const real l = QuarterMeridian();
+    for (size_t i = 0; i < n; ++i)
+      phi[i] = MeridianMu(s[i], l);
+    convert(AuxLatitude::MU, AuxLatitude::PHI, n, phi, phi);
   }
 
   Math::real Ellipsoid::MeridionalCurvatureRadius(real phi) const {
@@ -8,6 +8,7 @@
  **********************************************************************/
 
 #include <GeographicLib/EllipticFunction.hpp>
+#include <algorithm>
 
 #if defined(_MSC_VER)
 // Squelch warnings about constant conditional and enum-float expressions
@@ -18,6 +19,21 @@ namespace GeographicLib {
 
   using namespace std;
 
+  namespace {
+
+    // Sum the Chebyshev series c[0] + sum(c[k] * T_k(t), k, 1, n-1) using
+    // Clenshaw summation.
+    inline Math::real ChebSum(const Math::real c[], int n, Math::real t) {
+      Math::real b1 = 0, b2 = 0, t2 = 2 * t;
+      for (int k = n; --k > 0;) {
+        Math::real b0 = t2 * b1 - b2 + c[k];
+        b2 = b1; b1 = b0;
+      }
+      return c[0] + t * b1 - b2;
+    }
+
+  } // namespace
+
   /*
    * Implementation of methods given in
    *
@@ -234,6 +250,9 @@ namespace GeographicLib {
       throw GeographicErr("Parameter kp2 is not in [0, inf)");
     if (alphap2 < 0)
       throw GeographicErr("Parameter alphap2 is not in [0, inf)");
+    _tabn = 0;
+    _taberr = 0;
+    _tabE.clear();
     _k2 = k2;
     _kp2 = kp2;
     _alpha2 = alpha2;
@@ -274,6 +293,13 @@ namespace GeographicLib {
     } else {
       _kKc = _eEc = Math::pi()/2; _dDc = _kKc/2;
     }
+    // The integrals of the third kind are computed by ThirdKindGet when
+    // needed.
+    _third.state.store(0, memory_order_relaxed);
+  }
+
+  void EllipticFunction::ThirdKindCalc(real& pPic, real& gGc, real& hHc,
+                                       real& rjc) const {
     if (_alpha2 != 0) {
       // https://dlmf.nist.gov/19.25.E2
       real rj = (_kp2 != 0 && _alphap2 != 0) ? RJ(0, _kp2, 1, _alphap2) :
@@ -282,13 +308,15 @@ namespace GeographicLib {
         rc = _kp2 != 0 ? 0 :
         (_alphap2 != 0 ? RC(1, _alphap2) : Math::infinity());
       // Pi(alpha^2, k)
-      _pPic = _kp2 != 0 ? _kKc + _alpha2 * rj / 3 : Math::infinity();
+      pPic = _kp2 != 0 ? _kKc + _alpha2 * rj / 3 : Math::infinity();
       // G(alpha^2, k)
-      _gGc = _kp2 != 0 ? _kKc + (_alpha2 - _k2) * rj / 3 :  rc;
+      gGc = _kp2 != 0 ? _kKc + (_alpha2 - _k2) * rj / 3 :  rc;
       // H(alpha^2, k)
-      _hHc = _kp2 != 0 ? _kKc - (_alphap2 != 0 ? _alphap2 * rj : 0) / 3 : rc;
+      hHc = _kp2 != 0 ? _kKc - (_alphap2 != 0 ? _alphap2 * rj : 0) / 3 : rc;
+      rjc = rj;
     } else {
-      _pPic = _kKc; _gGc = _eEc;
+      rjc = 0;
+      pPic = _kKc; gGc = _eEc;
       // Hc = Kc - Dc but this involves large cancellations if k2 is close to
       // 1.  So write (for alpha2 = 0)
       //   Hc = int(cos(phi)^2/sqrt(1-k2*sin(phi)^2),phi,0,pi/2)
@@ -304,11 +332,155 @@ namespace GeographicLib {
       //   Hc = int(cos(phi)^2,...) = pi/4
       // For k2 = 1 and alpha2 = 0, we have
       //   Hc = int(cos(phi),...) = 1
-      _hHc = _kp2 == 1 ? Math::pi()/4 :
+      hHc = _kp2 == 1 ? Math::pi()/4 :
         (_kp2 == 0 ? 1 : _kp2 * RD(0, 1, _kp2) / 3);
     }
   }
 
+  Math::real EllipticFunction::ThirdKindGet(int i) const {
+    real v[4];
+    ThirdKindCalc(v[0], v[1], v[2], v[3]);
+    // The first thread to get here stores the values; the others (which
+    // may arrive while the values are being stored) just return theirs.
+    int unset = 0;
+    if (_third.state.compare_exchange_strong(unset, 1,
+                                             memory_order_acquire)) {
+      _third.pPic = v[0]; _third.gGc = v[1]; _third.hHc = v[2];
+      _third.rjc = v[3];
+      _third.state.store(2, memory_order_release);
+    }
+    return v[i];
+  }
+
+  void EllipticFunction::Update(real k2, real kp2) {
+    real dk2 = k2 - _k2,
+      scale = fmin(fmin(kp2, _kp2), fabs(_k2));
+    if (_alpha2 != 0) scale = fmin(scale, fabs(_k2 - _alpha2));
+    // If the integrals of the third kind haven't been computed, leave them
+    // to be computed for the new k2 when needed.
+    const bool third = _third.state.load(memory_order_relaxed) == 2;
+    if (!(k2 <= 1 && kp2 >= 0 && isfinite(_kKc) && isfinite(_dDc) &&
+          (!third || (isfinite(_third.hHc) && isfinite(_third.rjc))) &&
+          fabs(dk2) < sqrt(numeric_limits<real>::epsilon()) / 8 * scale)) {
+      Reset(k2, _alpha2, kp2, _alphap2);
+      return;
+    }
+    // The derivatives with respect to k2 at fixed alpha2, see
+    // https://dlmf.nist.gov/19.4.E1 and https://dlmf.nist.gov/19.4.E4.
+    // With rj = RJ(0, kp2, 1, alphap2) = 3*(Pi - K)/alpha2, these are
+    //   dK/dk2 = (K - D)/(2*kp2)
+    //   dE/dk2 = -D/2
+    //   dD/dk2 = (E - 2*kp2*D)/(2*k2*kp2)
+    //   drj/dk2 = (3*(K - D) - kp2*rj)/(2*kp2*(k2 - alpha2))
+    // The factors 1/k2 and 1/(k2 - alpha2) amplify the roundoff errors in
+    // the numerators; these are controlled by the limit on dk2.  Pi, G, and
+    // H are stepped with their own derivatives since their expressions in
+    // terms of K and rj suffer from cancellation when k2 is close to 1.
+    real
+      kKd = (_kKc - _dDc) / (2 * _kp2),
+      eEd = -_dDc / 2,
+      dDd = (_eEc - 2 * _kp2 * _dDc) / (2 * _k2 * _kp2);
+    if (third) {
+      ThirdKind& t = _third;
+      if (_alpha2 != 0) {
+        real rjd = (3 * (_kKc - _dDc) - _kp2 * t.rjc) /
+          (2 * _kp2 * (_k2 - _alpha2));
+        t.pPic += dk2 * (kKd + _alpha2 * rjd / 3);
+        t.gGc += dk2 * (kKd + ((_alpha2 - _k2) * rjd - t.rjc) / 3);
+        t.hHc += dk2 * (kKd - _alphap2 * rjd / 3);
+        t.rjc += dk2 * rjd;
+      } else {
+        // Pi = K, G = E, H = K - D
+        t.pPic += dk2 * kKd; t.gGc += dk2 * eEd; t.hHc += dk2 * (kKd - dDd);
+      }
+    }
+    _kKc += dk2 * kKd; _eEc += dk2 * eEd; _dDc += dk2 * dDd;
+    _k2 = k2;
+    _kp2 = kp2;
+    _eps = _k2/Math::sq(sqrt(_kp2) + 1);
+    _tabn = 0;
+    _taberr = 0;
+    _tabE.clear();
+  }
+
+  void EllipticFunction::Tabulate(real tol) {
+    // E(phi) on [0, q], q = pi/2, is written as
+    //   E(phi) = E * phi/q + phi * (q - phi) * h(phi)
+    // using E(0) = 0 and E(q - phi) + E(q + phi) = 2*E.  Thus the endpoints
+    // are exact and h(phi) is smooth; a piecewise Chebyshev approximation is
+    // found for h(phi).
+    if (!(_kp2 > 0 && isfinite(_k2)))
+      throw GeographicErr("Parameter k2 is not in (-inf, 1) in "
+                          "EllipticFunction::Tabulate");
+    if (tol == 0) tol = 8 * numeric_limits<real>::epsilon();
+    if (!(tol >= 2 * numeric_limits<real>::epsilon()))
+      throw GeographicErr("Tolerance too small in EllipticFunction::Tabulate");
+    Reset(_k2, _alpha2, _kp2, _alphap2);
+    vector<real> x(1, 0), c;
+    real q = Math::pi()/2, eE = _eEc;
+    _taberr = TabFit([this] (real phi) -> real
+                     { real sn = sin(phi), cn = cos(phi);
+                       return E(sn, cn, Delta(sn, cn)); },
+                     [q, eE] (real phi) -> real { return eE * (phi/q); },
+                     [q] (real phi) -> real { return phi * (q - phi); },
+                     eE, 0, q, tol, x, c);
+    x.insert(x.end(), c.begin(), c.end()); _tabE.swap(x);
+    _tabn = TabOrder();
+  }
+
+  int EllipticFunction::TabOrder() {
+    // Number of coefficients in each piece; for doubles, this gives between
+    // 2 and 20 pieces for the moduli in geodesic applications.
+    return max(8, Math::digits() / 5);
+  }
+
+  template<class Exact, class Lin, class Wt>
+  Math::real EllipticFunction::TabFit(Exact exact, Lin lin, Wt wt,
+                                      real scale, real a, real b, real tol,
+                                      vector<real>& x, vector<real>& c)
+    const {
+    // Fit h(x) = (exact(x) - lin(x)) / wt(x) on [a, b] with n Chebyshev
+    // coefficients and append to x and c; bisect [a, b] if the error at 3*n
+    // test points exceeds tol * scale.  Return the maximum relative error.
+    int n = TabOrder();
+    real m = (a + b) / 2, r = (b - a) / 2, pn = Math::pi() / n;
+    vector<real> h(n), cc(n, 0);
+    for (int j = 0; j < n; ++j) {
+      real xx = m + r * cos(pn * (j + real(0.5)));
+      h[j] = (exact(xx) - lin(xx)) / wt(xx);
+    }
+    for (int k = 0; k < n; ++k) {
+      for (int j = 0; j < n; ++j)
+        cc[k] += h[j] * cos(pn * k * (j + real(0.5)));
+      cc[k] *= (k == 0 ? 1 : 2) / real(n);
+    }
+    real err = 0;
+    for (int i = 0, nt = 3 * n; i < nt; ++i) {
+      real t = -1 + 2 * (i + real(0.5)) / nt, xx = m + r * t;
+      err = fmax(err, fabs(lin(xx) + wt(xx) * ChebSum(cc.data(), n, t)
+                           - exact(xx)) / scale);
+    }
+    if (err <= tol) {
+      x.push_back(b);
+      c.insert(c.end(), cc.begin(), cc.end());
+      return err;
+    }
+    if (!(r > b * numeric_limits<real>::epsilon() * (1 << 16)))
+      throw GeographicErr("Tolerance too small in EllipticFunction::Tabulate");
+    real err1 = TabFit(exact, lin, wt, scale, a, m, tol, x, c);
+    return fmax(err1, TabFit(exact, lin, wt, scale, m, b, tol, x, c));
+  }
+
+  Math::real EllipticFunction::TabEval(const vector<real>& t, real x) const {
+    // t holds the m + 1 breakpoints followed by _tabn coefficients for each
+    // of the m pieces.
+    size_t m = (t.size() - 1) / (_tabn + 1),
+      i = upper_bound(t.begin() + 1, t.begin() + m, x) - (t.begin() + 1);
+    real a = t[i], b = t[i + 1];
+    return ChebSum(t.data() + m + 1 + i * _tabn, _tabn,
+                   (2 * x - a - b) / (b - a));
+  }
+
   /*
    * Implementation of methods given in
    *
@@ -384,6 +556,14 @@ namespace GeographicLib {
   }
 
   Math::real EllipticFunction::E(real sn, real cn, real dn) const {
+    if (_tabn) {
+      real q = Math::pi()/2, phi = atan2(fabs(sn), fabs(cn)),
+        ei = E() * (phi / q) + phi * (q - phi) * TabEval(_tabE, phi);
+      // Enforce usual trig-like symmetries
+      if (signbit(cn))
+        ei = 2 * E() - ei;
+      return copysign(ei, sn);
+    }
     real
       cn2 = cn*cn, dn2 = dn*dn, sn2 = sn*sn,
       ei = cn2 != 0 ?
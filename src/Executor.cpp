@@ -0,0 +1,169 @@
+/**
+ * \file Executor.cpp
+ * \brief Implementation for GeographicLib::Executor class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/Executor.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  namespace {
+
+    class SerialExecutor : public Executor {
+    public:
+      void Run(int n, const function<void(int)>& task) override {
+        for (int i = 0; i < n; ++i)
+          task(i);
+      }
+    };
+
+    class PoolExecutor : public Executor {
+    private:
+      // The tasks of one call to Run.  The workers hold a shared_ptr to it,
+      // so it outlives the call; task is only used while tasks remain to be
+      // claimed.
+      struct Job {
+        const function<void(int)>* task;
+        int n;
+        atomic<int> next, done;
+        mutex m;
+        condition_variable cv;
+        Job(const function<void(int)>& t, int num)
+          : task(&t), n(num), next(0), done(0) {}
+      };
+      mutex _m;
+      condition_variable _cv;
+      deque<shared_ptr<Job> > _jobs;
+      // The number of workers which are not running tasks
+      int _idle;
+
+      // Claim and run the tasks of j until there are none left.
+      static void Drain(Job& j) {
+        for (int i; (i = j.next++) < j.n;) {
+          (*j.task)(i);
+          if (++j.done == j.n) {
+            lock_guard<mutex> lock(j.m);
+            j.cv.notify_all();
+          }
+        }
+      }
+      void Worker() {
+        unique_lock<mutex> lock(_m);
+        for (;;) {
+          _cv.wait(lock, [this]() -> bool { return !_jobs.empty(); });
+          shared_ptr<Job> j = _jobs.front();
+          if (j->next >= j->n) {
+            // All the tasks have been claimed
+            _jobs.pop_front();
+            continue;
+          }
+          --_idle;
+          lock.unlock();
+          Drain(*j);
+          lock.lock();
+          ++_idle;
+        }
+      }
+    public:
+      PoolExecutor() : _idle(0) {}
+      void Run(int n, const function<void(int)>& task) override {
+        if (n <= 1) {
+          if (n == 1) task(0);
+          return;
+        }
+        shared_ptr<Job> j;
+        try {
+          j = make_shared<Job>(task, n);
+          lock_guard<mutex> lock(_m);
+          // Make sure that there are enough idle workers for the job.  The
+          // pool is never destroyed, so the workers are detached.
+          for (; _idle < n - 1; ++_idle)
+            thread(&PoolExecutor::Worker, this).detach();
+        }
+        catch (const exception&) {
+          // Continue with the workers which could be started or, if the job
+          // couldn't be allocated, run the tasks here.
+          if (!j) {
+            for (int i = 0; i < n; ++i)
+              task(i);
+            return;
+          }
+        }
+        {
+          lock_guard<mutex> lock(_m);
+          _jobs.push_back(j);
+        }
+        _cv.notify_all();
+        // The calling thread does its share of the work and then waits for
+        // the tasks claimed by the workers to finish.
+        Drain(*j);
+        {
+          lock_guard<mutex> lock(_m);
+          for (auto k = _jobs.begin(); k != _jobs.end(); ++k)
+            if (*k == j) { _jobs.erase(k); break; }
+        }
+        unique_lock<mutex> lock(j->m);
+        j->cv.wait(lock, [&j]() -> bool { return j->done == j->n; });
+      }
+    };
+
+    atomic<Executor*>& current() {
+      static atomic<Executor*> exec(nullptr);
+      return exec;
+    }
+
+  } // namespace
+
+  Executor& Executor::Default() {
+    // This is deliberately not deleted, so that it remains usable while the
+    // program exits.
+    static PoolExecutor* pool = new PoolExecutor();
+    return *pool;
+  }
+
+  Executor& Executor::Serial() {
+    static SerialExecutor serial;
+    return serial;
+  }
+
+  Executor& Executor::Current() {
+    Executor* exec = current();
+    return exec ? *exec : Default();
+  }
+
+  void Executor::Set(Executor* exec) { current() = exec; }
+
+  void Executor::RunGuarded(int n, const function<void(int)>& task,
+                            const function<void()>& stop) {
+    const int ndigits = Math::digits();
+    vector<exception_ptr> errs(max(0, n));
+    Current().Run(n, [&](int i) -> void {
+      try {
+        Math::set_digits(ndigits);
+        task(i);
+      }
+      catch (...) {
+        errs[i] = current_exception();
+        stop();
+      }
+    });
+    for (auto& e : errs)
+      if (e) rethrow_exception(e);
+  }
+
+} // namespace GeographicLib
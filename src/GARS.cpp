@@ -9,6 +9,7 @@
 
 #include <GeographicLib/GARS.hpp>
 #include <GeographicLib/Utility.hpp>
+#include <cstring>
 
 #if defined(_MSC_VER)
 // Squelch warnings about enum-float expressions
@@ -23,13 +24,28 @@ namespace GeographicLib {
   const char* const GARS::letters_ = "ABCDEFGHJKLMNPQRSTUVWXYZ";
 
   void GARS::Forward(real lat, real lon, int prec, string& gars) {
+    char gars1[MAXBUF];
+    Forward(lat, lon, prec, gars1);
+    gars = gars1;
+  }
+
+  void GARS::Forward(size_t n, const real lat[], const real lon[],
+                     int prec, char gars[], size_t width) {
+    if (!(width >= 8))
+      throw GeographicErr("Width " + Utility::str(width)
+                          + " too small for GARS");
+    for (size_t i = 0; i < n; ++i)
+      Forward(lat[i], lon[i], prec, gars + i * width);
+  }
+
+  void GARS::Forward(real lat, real lon, int prec, char gars[]) {
     using std::isnan;           // Needed for Centos 7, ubuntu 14
     if (fabs(lat) > Math::qd)
       throw GeographicErr("Latitude " + Utility::str(lat)
                           + "d not in [-" + to_string(Math::qd)
                           + "d, " + to_string(Math::qd) + "d]");
     if (isnan(lat) || isnan(lon)) {
-      gars = "INVALID";
+      copy_n("INVALID", 8, gars);
       return;
     }
     lon = Math::AngNormalize(lon);
@@ -42,29 +58,48 @@ namespace GeographicLib {
       ilon = x * mult1_ / m_,
       ilat = y * mult1_ / m_;
     x -= ilon * m_ / mult1_; y -= ilat * m_ / mult1_;
-    char gars1[maxlen_];
     ++ilon;
     for (int c = lonlen_; c--;) {
-      gars1[c] = digits_[ ilon % baselon_]; ilon /= baselon_;
+      gars[c] = digits_[ ilon % baselon_]; ilon /= baselon_;
     }
     for (int c = latlen_; c--;) {
-      gars1[lonlen_ + c] = letters_[ilat % baselat_]; ilat /= baselat_;
+      gars[lonlen_ + c] = letters_[ilat % baselat_]; ilat /= baselat_;
     }
     if (prec > 0) {
       ilon = x / mult3_; ilat = y / mult3_;
-      gars1[baselen_] = digits_[mult2_ * (mult2_ - 1 - ilat) + ilon + 1];
+      gars[baselen_] = digits_[mult2_ * (mult2_ - 1 - ilat) + ilon + 1];
       if (prec > 1) {
         ilon = x % mult3_; ilat = y % mult3_;
-        gars1[baselen_ + 1] = digits_[mult3_ * (mult3_ - 1 - ilat) + ilon + 1];
+        gars[baselen_ + 1] = digits_[mult3_ * (mult3_ - 1 - ilat) + ilon + 1];
       }
     }
-    gars.resize(baselen_ + prec);
-    copy(gars1, gars1 + baselen_ + prec, gars.begin());
+    gars[baselen_ + prec] = '\0';
   }
 
   void GARS::Reverse(const string& gars, real& lat, real& lon,
                      int& prec, bool centerp) {
-    int len = int(gars.length());
+    GenReverse(gars.data(), int(gars.length()), lat, lon, prec, centerp);
+  }
+
+  void GARS::Reverse(const char* gars, real& lat, real& lon,
+                     int& prec, bool centerp) {
+    GenReverse(gars, int(strlen(gars)), lat, lon, prec, centerp);
+  }
+
+  void GARS::Reverse(size_t n, const char gars[], size_t width,
+                     real lat[], real lon[], int prec[], bool centerp) {
+    for (size_t i = 0; i < n; ++i) {
+      const char* g = gars + i * width;
+      int len = 0, prec1;
+      while (len < int(width) && g[len]) ++len;
+      GenReverse(g, len, lat[i], lon[i], prec ? prec[i] : prec1, centerp);
+    }
+  }
+
+  void GARS::GenReverse(const char* gars, int len, real& lat, real& lon,
+                        int& prec, bool centerp) {
+    // Only construct a string when reporting an error
+    auto str = [gars, len] () -> string { return string(gars, len); };
     if (len >= 3 &&
         toupper(gars[0]) == 'I' &&
         toupper(gars[1]) == 'N' &&
@@ -73,30 +108,30 @@ namespace GeographicLib {
       return;
     }
     if (len < baselen_)
-      throw GeographicErr("GARS must have at least 5 characters " + gars);
+      throw GeographicErr("GARS must have at least 5 characters " + str());
     if (len > maxlen_)
-      throw GeographicErr("GARS can have at most 7 characters " + gars);
+      throw GeographicErr("GARS can have at most 7 characters " + str());
     int prec1 = len - baselen_;
     int ilon = 0;
     for (int c = 0; c < lonlen_; ++c) {
       int k = Utility::lookup(digits_, gars[c]);
       if (k < 0)
-        throw GeographicErr("GARS must start with 3 digits " + gars);
+        throw GeographicErr("GARS must start with 3 digits " + str());
       ilon = ilon * baselon_ + k;
     }
     if (!(ilon >= 1 && ilon <= 2 * Math::td))
         throw GeographicErr("Initial digits in GARS must lie in [1, 720] " +
-                            gars);
+                            str());
     --ilon;
     int ilat = 0;
     for (int c = 0; c < latlen_; ++c) {
       int k = Utility::lookup(letters_, gars[lonlen_ + c]);
       if (k < 0)
-        throw GeographicErr("Illegal letters in GARS " + gars.substr(3,2));
+        throw GeographicErr("Illegal letters in GARS " + str().substr(3,2));
       ilat = ilat * baselat_ + k;
     }
     if (!(ilat < Math::td))
-      throw  GeographicErr("GARS letters must lie in [AA, QZ] " + gars);
+      throw  GeographicErr("GARS letters must lie in [AA, QZ] " + str());
     real
       unit = mult1_,
       lat1 = ilat + latorig_ * unit,
@@ -104,7 +139,7 @@ namespace GeographicLib {
     if (prec1 > 0) {
       int k = Utility::lookup(digits_, gars[baselen_]);
       if (!(k >= 1 && k <= mult2_ * mult2_))
-        throw GeographicErr("6th character in GARS must [1, 4] " + gars);
+        throw GeographicErr("6th character in GARS must [1, 4] " + str());
       --k;
       unit *= mult2_;
       lat1 = mult2_ * lat1 + (mult2_ - 1 - k / mult2_);
@@ -112,7 +147,7 @@ namespace GeographicLib {
       if (prec1 > 1) {
         k = Utility::lookup(digits_, gars[baselen_ + 1]);
         if (!(k >= 1 /* && k <= mult3_ * mult3_ */))
-          throw GeographicErr("7th character in GARS must [1, 9] " + gars);
+          throw GeographicErr("7th character in GARS must [1, 9] " + str());
         --k;
         unit *= mult3_;
         lat1 = mult3_ * lat1 + (mult3_ - 1 - k / mult3_);
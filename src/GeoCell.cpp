@@ -0,0 +1,312 @@
+/**
+ * \file GeoCell.cpp
+ * \brief Implementation for GeographicLib::GeoCell class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/GeoCell.hpp>
+#include <GeographicLib/Geohash.hpp>
+#include <GeographicLib/Utility.hpp>
+#include <algorithm>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  namespace {
+
+    typedef Math::real real;
+    typedef unsigned long long ull;
+    const ull invalid = ~0ULL;
+    const int levelshift = 60;
+    const ull valmask = (1ULL << levelshift) - 1;
+
+    // The number of cells in longitude at each level for GARS and Georef;
+    // the number in latitude is half this.
+    const ull garslon[] = { 720ULL, 1440ULL, 4320ULL };
+    const ull georeflon[] = { 24ULL, 360ULL, 21600ULL, 216000ULL,
+                              2160000ULL, 21600000ULL, 216000000ULL };
+
+    // The levels run from 0 to GeoCell::MaxPrecision(s)
+    inline int MaxLevel(GeoCell::scheme s)
+    { return GeoCell::MaxPrecision(s); }
+
+    inline int Level(GeoCell::scheme s, int prec) {
+      prec = max(GeoCell::MinPrecision(s),
+                 min(GeoCell::MaxPrecision(s), prec));
+      if (s != GeoCell::GEOREF) return prec;
+      // Georef precisions -1, 0, 2, 3, ... map to levels 0, 1, 2, 3, ...
+      return prec <= 0 ? prec + 1 : max(2, prec);
+    }
+
+    inline int Prec(GeoCell::scheme s, int level)
+    { return s == GeoCell::GEOREF && level <= 1 ? level - 1 : level; }
+
+    inline void Size(GeoCell::scheme s, int level, ull& nlon, ull& nlat) {
+      if (s == GeoCell::GEOHASH) {
+        nlon = 1ULL << ((5 * level + 1) / 2);
+        nlat = 1ULL << (5 * level / 2);
+      } else {
+        nlon = (s == GeoCell::GARS ? garslon : georeflon)[level];
+        nlat = nlon / 2;
+      }
+    }
+
+    // Spread the low 32 bits of x into the even bits of the result.
+    inline ull Spread(ull x) {
+      x &= 0xffffffffULL;
+      x = (x | (x << 16)) & 0x0000ffff0000ffffULL;
+      x = (x | (x <<  8)) & 0x00ff00ff00ff00ffULL;
+      x = (x | (x <<  4)) & 0x0f0f0f0f0f0f0f0fULL;
+      x = (x | (x <<  2)) & 0x3333333333333333ULL;
+      x = (x | (x <<  1)) & 0x5555555555555555ULL;
+      return x;
+    }
+
+    // The inverse of Spread, collecting the even bits of x.
+    inline ull Compact(ull x) {
+      x &= 0x5555555555555555ULL;
+      x = (x | (x >>  1)) & 0x3333333333333333ULL;
+      x = (x | (x >>  2)) & 0x0f0f0f0f0f0f0f0fULL;
+      x = (x | (x >>  4)) & 0x00ff00ff00ff00ffULL;
+      x = (x | (x >>  8)) & 0x0000ffff0000ffffULL;
+      x = (x | (x >> 16)) & 0x00000000ffffffffULL;
+      return x;
+    }
+
+    // Return the cell number at level for the cell indices ilon, ilat.
+    ull Encode(GeoCell::scheme s, int level, ull ilon, ull ilat) {
+      if (s == GeoCell::GEOHASH) {
+        if (level == 0) return 0;
+        // Left justify the indices and interleave them, longitude first.
+        int nl = 5 * level, nlon = (nl + 1) / 2, nlat = nl / 2;
+        ull hi = (Spread(ilon << (32 - nlon)) << 1) |
+          Spread(ilat << (32 - nlat));
+        return hi >> (64 - nl);
+      }
+      ull val = 0, place = 1, nlon, nlat, plon, plat;
+      Size(s, level, nlon, nlat);
+      for (int k = level; k > 0; --k) {
+        Size(s, k - 1, plon, plat);
+        ull mlon = nlon / plon, mlat = nlat / plat;
+        val += ((ilon % mlon) * mlat + ilat % mlat) * place;
+        place *= mlon * mlat;
+        ilon /= mlon; ilat /= mlat;
+        nlon = plon; nlat = plat;
+      }
+      return val + (ilon * nlat + ilat) * place;
+    }
+
+    // The inverse of Encode.
+    void Decode(GeoCell::scheme s, int level, ull val, ull& ilon, ull& ilat) {
+      if (s == GeoCell::GEOHASH) {
+        int nl = 5 * level, nlon = (nl + 1) / 2, nlat = nl / 2;
+        ull hi = level ? val << (64 - nl) : 0;
+        ilon = nlon ? Compact(hi >> 1) >> (32 - nlon) : 0;
+        ilat = nlat ? Compact(hi) >> (32 - nlat) : 0;
+        return;
+      }
+      ull lonplace = 1, latplace = 1, nlon, nlat, plon, plat;
+      ilon = ilat = 0;
+      Size(s, level, nlon, nlat);
+      for (int k = level; k > 0; --k) {
+        Size(s, k - 1, plon, plat);
+        ull mlon = nlon / plon, mlat = nlat / plat, m = mlon * mlat,
+          digit = val % m;
+        val /= m;
+        ilon += (digit / mlat) * lonplace; lonplace *= mlon;
+        ilat += (digit % mlat) * latplace; latplace *= mlat;
+        nlon = plon; nlat = plat;
+      }
+      ilon += (val / nlat) * lonplace;
+      ilat += (val % nlat) * latplace;
+    }
+
+    // Split an identifier into the level and the cell number; return false
+    // if the identifier is invalid.
+    inline bool Split(GeoCell::scheme s, ull id, int& level, ull& val) {
+      level = int(id >> levelshift);
+      val = id & valmask;
+      if (level > MaxLevel(s)) return false;
+      ull nlon, nlat;
+      Size(s, level, nlon, nlat);
+      return val < nlon * nlat;
+    }
+
+    inline ull Join(int level, ull val)
+    { return (ull(level) << levelshift) | val; }
+
+    // Find the cell indices of a point at level.  lat and lon must not be
+    // NaN and lat must be in [-90, 90].
+    void Indices(GeoCell::scheme s, int level, real lat, real lon,
+                 ull& ilon, ull& ilat) {
+      if (s == GeoCell::GEOHASH) {
+        Decode(s, level, Geohash::Key(lat, lon, level), ilon, ilat);
+        return;
+      }
+      // Follow the recipes in GARS::Forward and Georef::Forward
+      lon = Math::AngNormalize(lon);
+      if (lon == Math::hd) lon = -Math::hd; // lon now in [-180,180)
+      if (lat == Math::qd) lat *= (1 - numeric_limits<real>::epsilon() / 2);
+      ull nlon, nlat;
+      Size(s, level, nlon, nlat);
+      // The multiplier giving the finest integer coordinates
+      const long long m = s == GeoCell::GARS ? 12LL : 60000000000LL;
+      ull
+        x = ull((long long)(floor(lon * real(m))) + Math::hd * m),
+        y = ull((long long)(floor(lat * real(m))) + Math::qd * m);
+      ilon = x / (ull(Math::td * m) / nlon);
+      ilat = y / (ull(Math::hd * m) / nlat);
+    }
+
+    inline void CheckLatitude(real lat) {
+      if (fabs(lat) > Math::qd)
+        throw GeographicErr("Latitude " + Utility::str(lat)
+                            + "d not in [-" + to_string(Math::qd)
+                            + "d, " + to_string(Math::qd) + "d]");
+    }
+
+  } // namespace
+
+  unsigned long long GeoCell::Forward(scheme s, real lat, real lon,
+                                      int prec) {
+    using std::isnan;           // Needed for Centos 7, ubuntu 14
+    CheckLatitude(lat);
+    if (isnan(lat) || isnan(lon))
+      return invalid;
+    int level = Level(s, prec);
+    ull ilon, ilat;
+    if (s == GEOHASH)
+      return Join(level, Geohash::Key(lat, lon, level));
+    Indices(s, level, lat, lon, ilon, ilat);
+    return Join(level, Encode(s, level, ilon, ilat));
+  }
+
+  void GeoCell::Forward(scheme s, size_t n, const real lat[], const real lon[],
+                        int prec, unsigned long long id[]) {
+    for (size_t i = 0; i < n; ++i)
+      id[i] = Forward(s, lat[i], lon[i], prec);
+  }
+
+  void GeoCell::Reverse(scheme s, unsigned long long id,
+                        real& lat, real& lon, int& prec, bool centerp) {
+    int level; ull val;
+    if (!Split(s, id, level, val)) {
+      lat = lon = Math::NaN();
+      return;
+    }
+    prec = Prec(s, level);
+    if (s == GEOHASH) {
+      Geohash::Reverse(val, level, lat, lon, centerp);
+      return;
+    }
+    ull ilon, ilat, nlon, nlat;
+    Decode(s, level, val, ilon, ilat);
+    Size(s, level, nlon, nlat);
+    int c = centerp ? 1 : 0;
+    lon = real(2 * ilon + c) * Math::hd / real(nlon) - Math::hd;
+    lat = real(2 * ilat + c) * Math::qd / real(nlat) - Math::qd;
+  }
+
+  int GeoCell::Precision(scheme s, unsigned long long id) {
+    int level; ull val;
+    return Split(s, id, level, val) ? Prec(s, level) : MinPrecision(s) - 1;
+  }
+
+  unsigned long long GeoCell::Parent(scheme s, unsigned long long id) {
+    int level; ull val;
+    if (!Split(s, id, level, val) || level == 0)
+      return invalid;
+    ull nlon, nlat, plon, plat;
+    Size(s, level, nlon, nlat);
+    Size(s, level - 1, plon, plat);
+    return Join(level - 1, val / ((nlon / plon) * (nlat / plat)));
+  }
+
+  unsigned long long GeoCell::Children(scheme s, unsigned long long id,
+                                       unsigned long long& first) {
+    int level; ull val;
+    if (!Split(s, id, level, val) || level == MaxLevel(s)) {
+      first = invalid;
+      return 0;
+    }
+    ull nlon, nlat, clon, clat;
+    Size(s, level, nlon, nlat);
+    Size(s, level + 1, clon, clat);
+    ull m = (clon / nlon) * (clat / nlat);
+    first = Join(level + 1, val * m);
+    return m;
+  }
+
+  int GeoCell::Neighbors(scheme s, unsigned long long id,
+                         unsigned long long nbrs[8]) {
+    int level; ull val;
+    if (!Split(s, id, level, val))
+      return 0;
+    ull ilon, ilat, nlon, nlat;
+    Decode(s, level, val, ilon, ilat);
+    Size(s, level, nlon, nlat);
+    int n = 0;
+    for (int dy = -1; dy <= 1; ++dy) {
+      // No wrapping over the poles
+      if ((dy < 0 && ilat == 0) || (dy > 0 && ilat + 1 == nlat)) continue;
+      ull y = ilat + dy;
+      for (int dx = -1; dx <= 1; ++dx) {
+        ull x = (ilon + nlon + dx) % nlon,
+          nbr = Join(level, Encode(s, level, x, y));
+        if (nbr == id || find(nbrs, nbrs + n, nbr) != nbrs + n) continue;
+        nbrs[n++] = nbr;
+      }
+    }
+    return n;
+  }
+
+  void GeoCell::Cover(scheme s, real latmin, real lonmin,
+                      real latmax, real lonmax, int prec,
+                      std::vector<unsigned long long>& ids) {
+    using std::isnan;           // Needed for Centos 7, ubuntu 14
+    ids.clear();
+    CheckLatitude(latmin);
+    CheckLatitude(latmax);
+    if (latmin > latmax)
+      throw GeographicErr("Latitude range " + Utility::str(latmin) + "d to "
+                          + Utility::str(latmax) + "d is inverted");
+    if (isnan(latmin) || isnan(latmax) || isnan(lonmin) || isnan(lonmax))
+      return;
+    int level = Level(s, prec);
+    ull nlon, nlat, xmin, ymin, xmax, ymax;
+    Size(s, level, nlon, nlat);
+    Indices(s, level, latmin, lonmin, xmin, ymin);
+    Indices(s, level, latmax, lonmax, xmax, ymax);
+    // The eastward extent of the range in [0, 360)
+    real e = lonmax - lonmin;
+    ull mlon;
+    if (e >= Math::td - Math::td / real(nlon))
+      mlon = nlon;
+    else {
+      e = fmod(e, real(Math::td));
+      if (e < 0) e += Math::td;
+      mlon = e >= Math::td - Math::td / real(nlon) ? nlon :
+        (xmax + nlon - xmin) % nlon + 1;
+    }
+    if (mlon == nlon) xmin = 0;
+    ids.reserve(size_t(mlon * (ymax - ymin + 1)));
+    for (ull i = 0; i < mlon; ++i) {
+      ull x = (xmin + i) % nlon;
+      for (ull y = ymin; y <= ymax; ++y)
+        ids.push_back(Join(level, Encode(s, level, x, y)));
+    }
+    sort(ids.begin(), ids.end());
+  }
+
+  void GeoCell::Resolution(scheme s, int prec, real& latres, real& lonres) {
+    ull nlon, nlat;
+    Size(s, Level(s, prec), nlon, nlat);
+    lonres = Math::td / real(nlon);
+    latres = Math::hd / real(nlat);
+  }
+
+} // namespace GeographicLib
@@ -33,8 +33,9 @@ namespace GeographicLib {
                       _lat, _long, _gamma, _k);
     } else if (sa.size() == 2) {
       DMS::DecodeLatLon(sa[0], sa[1], _lat, _long, longfirst);
-      UTMUPS::Forward( _lat, _long,
-                       _zone, _northp, _easting, _northing, _gamma, _k);
+      // The UTM/UPS coordinates are computed by UTM() when needed.
+      _utm = false;
+      return;
     } else if (sa.size() == 3) {
       unsigned zoneind, coordind;
       if (sa[0].size() > 0 && isalpha(sa[0][sa[0].size() - 1])) {
@@ -55,6 +56,7 @@ namespace GeographicLib {
       FixHemisphere();
     } else
       throw GeographicErr("Coordinate requires 1, 2, or 3 elements");
+    _utm = true;
     CopyToAlt();
   }
 
@@ -75,6 +77,7 @@ namespace GeographicLib {
   }
 
   string GeoCoords::MGRSRepresentation(int prec) const {
+    UTM();
     // Max precision is um
     prec = max(-1, min(6, prec) + 5);
     string mgrs;
@@ -83,6 +86,7 @@ namespace GeographicLib {
   }
 
   string GeoCoords::AltMGRSRepresentation(int prec) const {
+    UTM();
     // Max precision is um
     prec = max(-1, min(6, prec) + 5);
     string mgrs;
@@ -115,6 +119,7 @@ namespace GeographicLib {
   }
 
   string GeoCoords::UTMUPSRepresentation(int prec, bool abbrev) const {
+    UTM();
     string utm;
     UTMUPSString(_zone, _northp, _easting, _northing, prec, abbrev, utm);
     return utm;
@@ -122,6 +127,7 @@ namespace GeographicLib {
 
   string GeoCoords::UTMUPSRepresentation(bool northp, int prec,
                                          bool abbrev) const {
+    UTM();
     real e, n;
     int z;
     UTMUPS::Transfer(_zone, _northp, _easting, _northing,
@@ -132,6 +138,7 @@ namespace GeographicLib {
   }
 
   string GeoCoords::AltUTMUPSRepresentation(int prec, bool abbrev) const {
+    UTM();
     string utm;
     UTMUPSString(_alt_zone, _northp, _alt_easting, _alt_northing, prec,
                  abbrev, utm);
@@ -140,6 +147,7 @@ namespace GeographicLib {
 
   string GeoCoords::AltUTMUPSRepresentation(bool northp, int prec,
                                             bool abbrev) const {
+    UTM();
     real e, n;
     int z;
     UTMUPS::Transfer(_alt_zone, _northp, _alt_easting, _alt_northing,
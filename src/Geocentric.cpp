@@ -13,7 +13,8 @@ namespace GeographicLib {
 
   using namespace std;
 
-  Geocentric::Geocentric(real a, real f)
+  template<typename T>
+  GeocentricT<T>::GeocentricT(real a, real f)
     : _a(a)
     , _f(f)
     , _e2(_f * (2 - _f))
@@ -28,14 +29,17 @@ namespace GeographicLib {
       throw GeographicErr("Polar semi-axis is not positive");
   }
 
-  const Geocentric& Geocentric::WGS84() {
-    static const Geocentric wgs84(Constants::WGS84_a(), Constants::WGS84_f());
+  template<typename T>
+  const GeocentricT<T>& GeocentricT<T>::WGS84() {
+    static const GeocentricT wgs84(Constants::WGS84_a<real>(),
+                                   Constants::WGS84_f<real>());
     return wgs84;
   }
 
-  void Geocentric::IntForward(real lat, real lon, real h,
-                              real& X, real& Y, real& Z,
-                              real M[dim2_]) const {
+  template<typename T>
+  void GeocentricT<T>::IntForward(real lat, real lon, real h,
+                                  real& X, real& Y, real& Z,
+                                  real M[dim2_]) const {
     real sphi, cphi, slam, clam;
     Math::sincosd(Math::LatFix(lat), sphi, cphi);
     Math::sincosd(lon, slam, clam);
@@ -48,9 +52,10 @@ namespace GeographicLib {
       Rotation(sphi, cphi, slam, clam, M);
   }
 
-  void Geocentric::IntReverse(real X, real Y, real Z,
-                              real& lat, real& lon, real& h,
-                              real M[dim2_]) const {
+  template<typename T>
+  void GeocentricT<T>::IntReverse(real X, real Y, real Z,
+                                  real& lat, real& lon, real& h,
+                                  real M[dim2_]) const {
     real
       R = hypot(X, Y),
       slam = R != 0 ? Y / R : 0,
@@ -99,12 +104,12 @@ namespace GeographicLib {
           real T3 = S + r3;
           // Pick the sign on the sqrt to maximize abs(T3).  This minimizes
           // loss of precision due to cancellation.  The result is unchanged
-          // because of the way the T is used in definition of u.
+          // because of the way that T1 is used in definition of u.
           T3 += T3 < 0 ? -sqrt(disc) : sqrt(disc); // T3 = (r * t)^3
           // N.B. cbrt always returns the real root.  cbrt(-8) = -2.
-          real T = cbrt(T3); // T = r * t
-          // T can be zero; but then r2 / T -> 0.
-          u += T + (T != 0 ? r2 / T : 0);
+          real T1 = cbrt(T3); // T1 = r * t
+          // T1 can be zero; but then r2 / T1 -> 0.
+          u += T1 + (T1 != 0 ? r2 / T1 : 0);
         } else {
           // T is complex, but the way u is defined the result is real.
           real ang = atan2(sqrt(-disc), -(S + r3));
@@ -152,8 +157,33 @@ namespace GeographicLib {
       Rotation(sphi, cphi, slam, clam, M);
   }
 
-  void Geocentric::Rotation(real sphi, real cphi, real slam, real clam,
-                            real M[dim2_]) {
+  template<typename T>
+  void GeocentricT<T>::Forward(size_t n,
+                               const real lat[], const real lon[],
+                               const real h[],
+                               real X[], real Y[], real Z[], real M[]) const {
+    if (!Init())
+      return;
+    for (size_t i = 0; i < n; ++i)
+      IntForward(lat[i], lon[i], h[i], X[i], Y[i], Z[i],
+                 M ? M + dim2_ * i : NULL);
+  }
+
+  template<typename T>
+  void GeocentricT<T>::Reverse(size_t n,
+                               const real X[], const real Y[], const real Z[],
+                               real lat[], real lon[], real h[],
+                               real M[]) const {
+    if (!Init())
+      return;
+    for (size_t i = 0; i < n; ++i)
+      IntReverse(X[i], Y[i], Z[i], lat[i], lon[i], h[i],
+                 M ? M + dim2_ * i : NULL);
+  }
+
+  template<typename T>
+  void GeocentricT<T>::Rotation(real sphi, real cphi, real slam, real clam,
+                                real M[dim2_]) {
     // This rotation matrix is given by the following quaternion operations
     // qrot(lam, [0,0,1]) * qrot(phi, [0,-1,0]) * [1,1,1,1]/2
     // or
@@ -168,5 +198,26 @@ namespace GeographicLib {
     // Local Z axis (up) in geocentric coords
     M[2] =  clam * cphi; M[5] =  slam * cphi; M[8] = sphi;
   }
+  /// \cond SKIP
+  // Instantiate with the standard floating types
+  template class GEOGRAPHICLIB_EXPORT GeocentricT<float>;
+  template class GEOGRAPHICLIB_EXPORT GeocentricT<double>;
+#if GEOGRAPHICLIB_HAVE_LONG_DOUBLE
+  // Instantiate if long double is distinct from double
+  template class GEOGRAPHICLIB_EXPORT GeocentricT<long double>;
+#endif
+#if GEOGRAPHICLIB_PRECISION > 3
+  // Instantiate with the high precision type
+  template class GEOGRAPHICLIB_EXPORT GeocentricT<Math::real>;
+#endif
+  /// \endcond
+
+#if GEOGRAPHICLIB_EAGER_SINGLETONS && GEOGRAPHICLIB_PRECISION != 5
+  namespace {
+    // Construct Geocentric::WGS84() when the library is loaded (see
+    // Geodesic.cpp).
+    const Geocentric& wgs84init_ = Geocentric::WGS84();
+  }
+#endif
 
 } // namespace GeographicLib
@@ -0,0 +1,210 @@
+/**
+ * \file GeodesicCache.cpp
+ * \brief Implementation for GeographicLib::GeodesicCache class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/GeodesicCache.hpp>
+#include <cstdint>
+#include <cstring>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  namespace {
+    typedef Math::real real;
+    // Round x to the nearest multiple of d (a no-op if d == 0)
+    real Quantize(real x, real d)
+    { return d > 0 ? d * round(x / d) : x; }
+    // Equality and ordering which distinguish 0 and -0
+    bool Same(real x, real y)
+    { return x == y && signbit(x) == signbit(y); }
+    bool Before(real x, real y)
+    { return x < y || (x == y && signbit(x) && !signbit(y)); }
+    // Reverse an azimuth; the result is in (-180, 180].
+    real Reverse(real azi)
+    { return azi > 0 ? azi - Math::hd : azi + Math::hd; }
+    // The splitmix64 finalizer; every bit of x affects every bit of the
+    // result.
+    uint64_t Mix(uint64_t x) {
+      x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+      return x ^ (x >> 31);
+    }
+    // A hash of the bit patterns of the positions (converted to double; this
+    // is consistent with Same) and outmask.
+    uint64_t Hash64(real lat1, real lon1, real lat2, real lon2,
+                    unsigned outmask) {
+      const double x[4] = {double(lat1), double(lon1),
+                           double(lat2), double(lon2)};
+      uint64_t h = outmask;
+      for (int i = 0; i < 4; ++i) {
+        uint64_t b;
+        memcpy(&b, &x[i], sizeof(b));
+        h = Mix(h ^ b);
+      }
+      return h;
+    }
+    // Whether outmask includes the (public) mask value m
+    bool Has(unsigned outmask, unsigned m)
+    { return (outmask & m) == m; }
+  }
+
+  bool GeodesicCache::Key::operator==(const Key& k) const {
+    return outmask == k.outmask &&
+      Same(lat1, k.lat1) && Same(lon1, k.lon1) &&
+      Same(lat2, k.lat2) && Same(lon2, k.lon2);
+  }
+
+  size_t GeodesicCache::Hash::operator()(const Key& k) const
+  { return size_t(Hash64(k.lat1, k.lon1, k.lat2, k.lon2, k.outmask)); }
+
+  GeodesicCache::Shard::Shard(size_t maxsize)
+    : _maxsize(maxsize)
+    , _hits(0)
+    , _misses(0)
+  {}
+
+  bool GeodesicCache::Shard::Find(const Key& k, Value& v) {
+    lock_guard<mutex> guard(_lock);
+    auto p = _map.find(k);
+    if (p == _map.end()) {
+      ++_misses;
+      return false;
+    }
+    ++_hits;
+    _list.splice(_list.begin(), _list, p->second);
+    v = p->second->second;
+    return true;
+  }
+
+  void GeodesicCache::Shard::Insert(const Key& k, const Value& v) {
+    lock_guard<mutex> guard(_lock);
+    if (_maxsize == 0) return;
+    auto p = _map.find(k);
+    if (p != _map.end()) {
+      // Another thread inserted this solution while we were computing ours
+      _list.splice(_list.begin(), _list, p->second);
+      return;
+    }
+    _list.emplace_front(k, v);
+    _map[k] = _list.begin();
+    while (_list.size() > _maxsize) {
+      _map.erase(_list.back().first);
+      _list.pop_back();
+    }
+  }
+
+  void GeodesicCache::Shard::Clear() {
+    lock_guard<mutex> guard(_lock);
+    _list.clear(); _map.clear();
+    _hits = _misses = 0;
+  }
+
+  size_t GeodesicCache::Shard::Size() const
+  { lock_guard<mutex> guard(_lock); return _list.size(); }
+
+  unsigned long long GeodesicCache::Shard::Hits() const
+  { lock_guard<mutex> guard(_lock); return _hits; }
+
+  unsigned long long GeodesicCache::Shard::Misses() const
+  { lock_guard<mutex> guard(_lock); return _misses; }
+
+  GeodesicCache::GeodesicCache(const Geodesic& geod, size_t maxsize,
+                               real dq, bool symmetric, int nshards)
+    : _geod(geod)
+    , _maxsize(maxsize)
+    , _dq(dq)
+    , _symmetric(symmetric)
+  {
+    if (!(isfinite(_dq) && _dq >= 0))
+      throw GeographicErr("Quantum for positions must be nonnegative");
+    if (!(nshards > 0))
+      throw GeographicErr("Number of shards must be positive");
+    const size_t n = size_t(nshards), shardsize = (maxsize + n - 1) / n;
+    _shards.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+      _shards.push_back(unique_ptr<Shard>(new Shard(shardsize)));
+  }
+
+  GeodesicCache::Shard& GeodesicCache::shard(const Key& k) {
+    // Use the high bits of the hash so that the selection of the shard is
+    // independent of the selection of the bucket within the shard.
+    uint64_t h = Hash64(k.lat1, k.lon1, k.lat2, k.lon2, k.outmask);
+    return *_shards[size_t((h >> 40) % _shards.size())];
+  }
+
+  Math::real GeodesicCache::GenInverse(real lat1, real lon1,
+                                       real lat2, real lon2,
+                                       unsigned outmask,
+                                       real& s12, real& azi1, real& azi2,
+                                       real& m12, real& M12, real& M21,
+                                       real& S12) {
+    lat1 = Quantize(lat1, _dq); lon1 = Quantize(lon1, _dq);
+    lat2 = Quantize(lat2, _dq); lon2 = Quantize(lon2, _dq);
+    if (isnan(lat1) || isnan(lon1) || isnan(lat2) || isnan(lon2))
+      return _geod.GenInverse(lat1, lon1, lat2, lon2, outmask,
+                              s12, azi1, azi2, m12, M12, M21, S12);
+    // With symmetric, the key has the points in a canonical order.
+    const bool swap = _symmetric &&
+      (Before(lat2, lat1) || (Same(lat2, lat1) && Before(lon2, lon1)));
+    Key k = swap ? Key{lat2, lon2, lat1, lon1, outmask} :
+      Key{lat1, lon1, lat2, lon2, outmask};
+    Shard& s = shard(k);
+    Value v = Value();
+    if (!s.Find(k, v)) {
+      // Solve the problem with the lock released so that other threads can
+      // consult the shard in the meantime.
+      v.a12 = _geod.GenInverse(k.lat1, k.lon1, k.lat2, k.lon2, outmask,
+                               v.s12, v.azi1, v.azi2,
+                               v.m12, v.M12, v.M21, v.S12);
+      s.Insert(k, v);
+    }
+    if (Has(outmask, Geodesic::DISTANCE))
+      s12 = v.s12;
+    if (Has(outmask, Geodesic::AZIMUTH)) {
+      azi1 = swap ? Reverse(v.azi2) : v.azi1;
+      azi2 = swap ? Reverse(v.azi1) : v.azi2;
+    }
+    if (Has(outmask, Geodesic::REDUCEDLENGTH))
+      m12 = v.m12;
+    if (Has(outmask, Geodesic::GEODESICSCALE)) {
+      M12 = swap ? v.M21 : v.M12;
+      M21 = swap ? v.M12 : v.M21;
+    }
+    if (Has(outmask, Geodesic::AREA))
+      S12 = swap ? -v.S12 : v.S12;
+    return v.a12;
+  }
+
+  void GeodesicCache::Clear() {
+    for (auto& s : _shards)
+      s->Clear();
+  }
+
+  size_t GeodesicCache::Size() const {
+    size_t n = 0;
+    for (const auto& s : _shards)
+      n += s->Size();
+    return n;
+  }
+
+  unsigned long long GeodesicCache::Hits() const {
+    unsigned long long n = 0;
+    for (const auto& s : _shards)
+      n += s->Hits();
+    return n;
+  }
+
+  unsigned long long GeodesicCache::Misses() const {
+    unsigned long long n = 0;
+    for (const auto& s : _shards)
+      n += s->Misses();
+    return n;
+  }
+
+} // namespace GeographicLib
@@ -28,7 +28,9 @@
 
 #include <GeographicLib/GeodesicExact.hpp>
 #include <GeographicLib/GeodesicLineExact.hpp>
+#include <atomic>
 #include <vector>
+#include <GeographicLib/Executor.hpp>
 
 #if defined(_MSC_VER)
 // Squelch warnings about potentially uninitialized local variables,
@@ -40,6 +42,30 @@ namespace GeographicLib {
 
   using namespace std;
 
+  namespace {
+
+    // Call work(i) for i in [0, n) on nthreads threads.  The indices are
+    // claimed in blocks with an atomic counter.
+    template<class F> void Blocks(size_t n, int nthreads, F work) {
+      const size_t block = 256, nblocks = (n + block - 1) / block;
+      auto run = [&](size_t b) -> void {
+        for (size_t i = b * block; i < min(n, (b + 1) * block); ++i)
+          work(i);
+      };
+      nthreads = int(min(size_t(max(1, nthreads)), nblocks));
+      if (nthreads <= 1) {
+        for (size_t b = 0; b < nblocks; ++b) run(b);
+        return;
+      }
+      atomic<size_t> next(0);
+      Executor::RunGuarded(nthreads, [&](int) -> void {
+        for (size_t b; (b = next++) < nblocks;)
+          run(b);
+      }, [&]() -> void { next = nblocks; });
+    }
+
+  } // namespace
+
   GeodesicExact::GeodesicExact(real a, real f)
     : maxit2_(maxit1_ + Math::digits() + 10)
       // Underflow guard.  We require
@@ -80,6 +106,8 @@ namespace GeographicLib {
       // spherical case.
     , _etol2(real(0.1) * tol2_ /
              sqrt( fmax(real(0.001), fabs(_f)) * fmin(real(1), 1 - _f/2) / 2 ))
+      // alpha2 = -ep2 as required by Lambda12 which calls E.Update
+    , _eEm(-_ep2, -_ep2, 1 + _ep2, 1 + _ep2)
   {
     if (!(isfinite(_a) && _a > 0))
       throw GeographicErr("Equatorial radius is not positive");
@@ -395,6 +423,14 @@ namespace GeographicLib {
     return wgs84;
   }
 
+#if GEOGRAPHICLIB_EAGER_SINGLETONS && GEOGRAPHICLIB_PRECISION != 5
+  namespace {
+    // Construct GeodesicExact::WGS84() when the library is loaded (see
+    // Geodesic.cpp).
+    const GeodesicExact& wgs84init_ = GeodesicExact::WGS84();
+  }
+#endif
+
   GeodesicLineExact GeodesicExact::Line(real lat1, real lon1, real azi1,
                                         unsigned caps) const {
     return GeodesicLineExact(*this, lat1, lon1, azi1, caps);
@@ -415,6 +451,35 @@ namespace GeographicLib {
                   lat2, lon2, azi2, s12, m12, M12, M21, S12);
   }
 
+  void GeodesicExact::GenDirect(size_t n,
+                                const real lat1[], const real lon1[],
+                                const real azi1[],
+                                bool arcmode, const real s12_a12[],
+                                unsigned outmask,
+                                real lat2[], real lon2[], real azi2[],
+                                real s12[], real m12[], real M12[], real M21[],
+                                real S12[], real a12[], int nthreads) const {
+    // The capabilities in outmask are needed by GenDirect; the output bits
+    // determine which arrays are set.
+    const unsigned out = outmask & OUT_MASK;
+    Blocks(n, nthreads, [&](size_t i) -> void {
+      // Scratch outputs for the quantities not requested; these are never
+      // read.
+      real t;
+      real a12x = GenDirect(lat1[i], lon1[i], azi1[i], arcmode, s12_a12[i],
+                            outmask,
+                            out & LATITUDE ? lat2[i] : t,
+                            out & LONGITUDE ? lon2[i] : t,
+                            out & AZIMUTH ? azi2[i] : t,
+                            out & DISTANCE ? s12[i] : t,
+                            out & REDUCEDLENGTH ? m12[i] : t,
+                            out & GEODESICSCALE ? M12[i] : t,
+                            out & GEODESICSCALE ? M21[i] : t,
+                            out & AREA ? S12[i] : t);
+      if (a12) a12[i] = a12x;
+    });
+  }
+
   GeodesicLineExact GeodesicExact::GenDirectLine(real lat1, real lon1,
                                                  real azi1,
                                                  bool arcmode, real s12_a12,
@@ -493,7 +558,7 @@ namespace GeographicLib {
     real sbet1, cbet1, sbet2, cbet2, s12x, m12x;
     // Initialize for the meridian.  No longitude calculation is done in this
     // case to let the parameter default to 0.
-    EllipticFunction E(-_ep2);
+    EllipticFunction E(_eEm);
 
     Math::sincosd(lat1, sbet1, cbet1); sbet1 *= _f1;
     // Ensure cbet1 = +epsilon at poles; doing the fix on beta means that sig12
@@ -816,6 +881,33 @@ namespace GeographicLib {
     return a12;
   }
 
+  void GeodesicExact::GenInverse(size_t n,
+                                 const real lat1[], const real lon1[],
+                                 const real lat2[], const real lon2[],
+                                 unsigned outmask,
+                                 real s12[], real azi1[], real azi2[],
+                                 real m12[], real M12[], real M21[],
+                                 real S12[], real a12[], int nthreads) const {
+    outmask &= OUT_MASK;
+    Blocks(n, nthreads, [&](size_t i) -> void {
+      // Scratch outputs for the quantities not requested; these are never
+      // read.
+      real t, salp1, calp1, salp2, calp2,
+        a12x = GenInverse(lat1[i], lon1[i], lat2[i], lon2[i], outmask,
+                          outmask & DISTANCE ? s12[i] : t,
+                          salp1, calp1, salp2, calp2,
+                          outmask & REDUCEDLENGTH ? m12[i] : t,
+                          outmask & GEODESICSCALE ? M12[i] : t,
+                          outmask & GEODESICSCALE ? M21[i] : t,
+                          outmask & AREA ? S12[i] : t);
+      if (outmask & AZIMUTH) {
+        azi1[i] = Math::atan2d(salp1, calp1);
+        azi2[i] = Math::atan2d(salp2, calp2);
+      }
+      if (a12) a12[i] = a12x;
+    });
+  }
+
   GeodesicLineExact GeodesicExact::InverseLine(real lat1, real lon1,
                                                real lat2, real lon2,
                                                unsigned caps) const {
@@ -1144,7 +1236,9 @@ namespace GeographicLib {
     somg12 = fmax(real(0), comg1 * somg2 - somg1 * comg2);
     comg12 =               comg1 * comg2 + somg1 * somg2;
     real k2 = Math::sq(calp0) * _ep2;
-    E.Reset(-k2, -_ep2, 1 + k2, 1 + _ep2);
+    // E has alpha2 = -ep2; during the Newton iterations k2 changes only
+    // slightly so the complete integrals can often be updated cheaply.
+    E.Update(-k2, 1 + k2);
     // chi12 = chi2 - chi1, limit to [0, pi]
     real
       schi12 = fmax(real(0), cchi1 * somg2 - somg1 * cchi2),
@@ -0,0 +1,232 @@
+/**
+ * \file GeodesicFan.cpp
+ * \brief Implementation for GeographicLib::GeodesicFan class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/GeodesicFan.hpp>
+#include <algorithm>
+#include <atomic>
+#include <GeographicLib/Executor.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  namespace {
+    typedef Math::real real;
+    const int L = GeodesicFan::lanes;
+
+    // The lane version of Geodesic::SinCosSeries(true, sinx[k], cosx[k], c,
+    // n) for k in [0, m) where element j of c for lane k is cc[j * stride +
+    // k].  The operations are the same as for the scalar version, so the
+    // results are identical.
+    void SinSeries(int m, const real sinx[], const real cosx[],
+                   const real cc[], size_t stride, int n, real y[]) {
+      real ar[L], y0[L], y1[L];
+      for (int k = 0; k < m; ++k) {
+        ar[k] = 2 * (cosx[k] - sinx[k]) * (cosx[k] + sinx[k]);
+        y0[k] = n & 1 ? cc[n * stride + k] : 0; y1[k] = 0;
+      }
+      for (int j = n - (n & 1); j > 0; j -= 2) {
+        const real *c1 = cc + j * stride, *c0 = cc + (j - 1) * stride;
+        for (int k = 0; k < m; ++k) {
+          y1[k] = ar[k] * y0[k] - y1[k] + c1[k];
+          y0[k] = ar[k] * y1[k] - y0[k] + c0[k];
+        }
+      }
+      for (int k = 0; k < m; ++k)
+        y[k] = 2 * sinx[k] * cosx[k] * y0[k];
+    }
+  }
+
+  GeodesicFan::GeodesicFan(const Geodesic& g, real lat1, real lon1,
+                           size_t n, const real azi1[], unsigned caps)
+  {
+    Init(g, lat1, lon1, n, azi1, caps);
+  }
+
+  GeodesicFan::GeodesicFan(const Geodesic& g, real lat1, real lon1,
+                           real azi0, real dazi, size_t n, unsigned caps)
+  {
+    vector<real> azi1(n);
+    for (size_t i = 0; i < n; ++i)
+      azi1[i] = azi0 + real(i) * dazi;
+    Init(g, lat1, lon1, n, azi1.data(), caps);
+  }
+
+  void GeodesicFan::Init(const Geodesic& g, real lat1, real lon1,
+                         size_t n, const real azi1[], unsigned caps) {
+    _lat1 = Math::LatFix(lat1);
+    _lon1 = lon1;
+    _lines.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+      _lines.push_back(g.Line(lat1, lon1, azi1[i], caps));
+    _soa = n > 0 && !g.Exact() &&
+      _lines[0].Capabilities(Geodesic::LATITUDE | Geodesic::LONGITUDE |
+                             Geodesic::AZIMUTH | Geodesic::DISTANCE_IN);
+    if (!_soa) return;
+    const GeodesicLine& l0 = _lines[0];
+    _order = l0._order; _f = l0._f; _f1 = l0._f1; _b = l0._b;
+    _tiny = l0.tiny_;
+    vector<real>* v[] = {&_bA1, &_aA1m1, &_k2, &_salp0, &_calp0, &_ssig1,
+                         &_csig1, &_stau1, &_ctau1, &_somg1, &_comg1,
+                         &_aA3c, &_bB11, &_bB31};
+    for (auto p : v)
+      p->resize(n);
+    _cC1a.resize((_order + 1) * n);
+    _cC1pa.resize((_order + 1) * n);
+    _cC3a.resize(_order * n);
+    for (size_t i = 0; i < n; ++i) {
+      const GeodesicLine& l = _lines[i];
+      // This is the denominator for tau12 in GeodesicLine::GenPosition.
+      _bA1[i] = l._b * (1 + l._aA1m1);
+      _aA1m1[i] = l._aA1m1; _k2[i] = l._k2;
+      _salp0[i] = l._salp0; _calp0[i] = l._calp0;
+      _ssig1[i] = l._ssig1; _csig1[i] = l._csig1;
+      _stau1[i] = l._stau1; _ctau1[i] = l._ctau1;
+      _somg1[i] = l._somg1; _comg1[i] = l._comg1;
+      _aA3c[i] = l._aA3c; _bB11[i] = l._bB11; _bB31[i] = l._bB31;
+      for (int j = 0; j <= _order; ++j) {
+        _cC1a[j * n + i] = l._cC1a[j];
+        _cC1pa[j * n + i] = l._cC1pa[j];
+      }
+      for (int j = 0; j < _order; ++j)
+        _cC3a[j * n + i] = l._cC3a[j];
+    }
+  }
+
+  void GeodesicFan::Position(real s12, real lat2[], real lon2[],
+                             real azi2[]) const {
+    position(s12, 0, _lines.size(), lat2, lon2, azi2);
+  }
+
+  void GeodesicFan::position(real s12, size_t ib, size_t ie,
+                             real lat2[], real lon2[], real azi2[]) const {
+    const size_t n = _lines.size();
+    if (!_soa) {
+      for (size_t i = ib; i < ie; ++i) {
+        real t;
+        // GenPosition doesn't set the outputs if the line lacks the
+        // capabilities.
+        lat2[i] = lon2[i] = t = Math::NaN();
+        real& azi = azi2 ? azi2[i] : t;
+        azi = Math::NaN();
+        _lines[i].GenPosition(false, s12,
+                              Geodesic::LATITUDE | Geodesic::LONGITUDE |
+                              Geodesic::AZIMUTH,
+                              lat2[i], lon2[i], azi, t, t, t, t, t);
+      }
+      return;
+    }
+    // This follows GeodesicLine::DistanceSigma and
+    // GeodesicLine::SigmaPosition with outmask = LATITUDE | LONGITUDE |
+    // AZIMUTH, with each step applied to a group of lines.
+    const real lon1 = Math::AngNormalize(_lon1);
+    for (size_t i0 = ib; i0 < ie; i0 += L) {
+      const int m = int(min(size_t(L), ie - i0));
+      const size_t i = i0;
+      real tau12[L], sx[L], cx[L], B12[L], sig12[L], ssig12[L], csig12[L],
+        ssig2[L], csig2[L], S3[L];
+      for (int k = 0; k < m; ++k) {
+        tau12[k] = s12 / _bA1[i + k];
+        real stau12 = sin(tau12[k]), ctau12 = cos(tau12[k]);
+        // tau2 = tau1 + tau12
+        sx[k] = _stau1[i + k] * ctau12 + _ctau1[i + k] * stau12;
+        cx[k] = _ctau1[i + k] * ctau12 - _stau1[i + k] * stau12;
+      }
+      SinSeries(m, sx, cx, &_cC1pa[i], n, _order, B12);
+      for (int k = 0; k < m; ++k) {
+        sig12[k] = tau12[k] - (-B12[k] - _bB11[i + k]);
+        ssig12[k] = sin(sig12[k]); csig12[k] = cos(sig12[k]);
+      }
+      if (fabs(_f) > 0.01) {
+        // Correct sig12 with 1 Newton iteration
+        for (int k = 0; k < m; ++k) {
+          ssig2[k] = _ssig1[i + k] * csig12[k] + _csig1[i + k] * ssig12[k];
+          csig2[k] = _csig1[i + k] * csig12[k] - _ssig1[i + k] * ssig12[k];
+        }
+        SinSeries(m, ssig2, csig2, &_cC1a[i], n, _order, B12);
+        for (int k = 0; k < m; ++k) {
+          real serr = (1 + _aA1m1[i + k]) *
+            (sig12[k] + (B12[k] - _bB11[i + k])) - s12 / _b;
+          sig12[k] = sig12[k] -
+            serr / sqrt(1 + _k2[i + k] * Math::sq(ssig2[k]));
+          ssig12[k] = sin(sig12[k]); csig12[k] = cos(sig12[k]);
+        }
+      }
+      for (int k = 0; k < m; ++k) {
+        // sig2 = sig1 + sig12
+        ssig2[k] = _ssig1[i + k] * csig12[k] + _csig1[i + k] * ssig12[k];
+        csig2[k] = _csig1[i + k] * csig12[k] - _ssig1[i + k] * ssig12[k];
+        // sin(bet2) = cos(alp0) * sin(sig2)
+        real sbet2 = _calp0[i + k] * ssig2[k],
+          cbet2 = hypot(_salp0[i + k], _calp0[i + k] * csig2[k]);
+        if (cbet2 == 0)
+          // I.e., salp0 = 0, csig2 = 0.  Break the degeneracy in this case
+          cbet2 = csig2[k] = _tiny;
+        lat2[i + k] = Math::atan2d(sbet2, _f1 * cbet2);
+        if (azi2)
+          azi2[i + k] = Math::atan2d(_salp0[i + k],
+                                     _calp0[i + k] * csig2[k]);
+      }
+      SinSeries(m, ssig2, csig2, &_cC3a[i], n, _order - 1, S3);
+      for (int k = 0; k < m; ++k) {
+        // tan(omg2) = sin(alp0) * tan(sig2)
+        real somg2 = _salp0[i + k] * ssig2[k], comg2 = csig2[k],
+          omg12 = atan2(somg2 * _comg1[i + k] - comg2 * _somg1[i + k],
+                        comg2 * _comg1[i + k] + somg2 * _somg1[i + k]),
+          lam12 = omg12 + _aA3c[i + k] *
+          ( sig12[k] + (S3[k] - _bB31[i + k]) ),
+          lon12 = lam12 / Math::degree();
+        lon2[i + k] = Math::AngNormalize(lon1 + Math::AngNormalize(lon12));
+      }
+    }
+  }
+
+  void GeodesicFan::Grid(size_t m, const real s12[],
+                         real lat2[], real lon2[], real azi2[],
+                         int nthreads) const {
+    const size_t n = _lines.size();
+    // Each block of lines is evaluated at all the distances, so that its
+    // coefficients stay in the cache.  The blocks are claimed with an atomic
+    // counter.
+    const size_t block = 32 * L, nblocks = (n + block - 1) / block;
+    auto work = [&](size_t b) -> void {
+      const size_t ib = b * block, ie = min(n, ib + block);
+      for (size_t j = 0; j < m; ++j)
+        position(s12[j], ib, ie, lat2 + j * n, lon2 + j * n,
+                 azi2 ? azi2 + j * n : nullptr);
+    };
+    nthreads = int(min(size_t(max(1, nthreads)), nblocks));
+    if (nthreads <= 1) {
+      for (size_t b = 0; b < nblocks; ++b) work(b);
+      return;
+    }
+    atomic<size_t> next(0);
+    auto task = [&](int) -> void {
+      for (size_t b; (b = next++) < nblocks;)
+        work(b);
+    };
+    Executor::RunGuarded(nthreads, task, [&]() -> void { next = nblocks; });
+  }
+
+  void GeodesicFan::GenPosition(bool arcmode, real s12_a12,
+                                unsigned outmask,
+                                real lat2[], real lon2[], real azi2[],
+                                real s12[], real m12[],
+                                real M12[], real M21[],
+                                real S12[], real a12[]) const {
+    // Offset the output arrays to line i; null arrays stay null.
+    for (size_t i = 0; i < _lines.size(); ++i) {
+      auto at = [i](real* p) -> real* { return p ? p + i : nullptr; };
+      _lines[i].GenPosition(1, arcmode, &s12_a12, outmask,
+                            at(lat2), at(lon2), at(azi2), at(s12), at(m12),
+                            at(M12), at(M21), at(S12), at(a12));
+    }
+  }
+
+} // namespace GeographicLib
@@ -27,6 +27,7 @@
  **********************************************************************/
 
 #include <GeographicLib/GeodesicLine.hpp>
+#include <GeographicLib/GeodesicKernel.hpp>
 
 #if defined(_MSC_VER)
 // Squelch warnings about mixing enums
@@ -41,94 +42,22 @@ namespace GeographicLib {
                               real lat1, real lon1,
                               real azi1, real salp1, real calp1,
                               unsigned caps) {
-    tiny_ = g.tiny_;
-    _lat1 = Math::LatFix(lat1);
-    _lon1 = lon1;
-    _azi1 = azi1;
-    _salp1 = salp1;
-    _calp1 = calp1;
-    _a = g._a;
-    _f = g._f;
-    _b = g._b;
-    _c2 = g._c2;
-    _f1 = g._f1;
-    // Always allow latitude and azimuth and unrolling of longitude
-    _caps = caps | LATITUDE | AZIMUTH | LONG_UNROLL;
-
-    real cbet1, sbet1;
-    Math::sincosd(Math::AngRound(_lat1), sbet1, cbet1); sbet1 *= _f1;
-    // Ensure cbet1 = +epsilon at poles
-    Math::norm(sbet1, cbet1); cbet1 = fmax(tiny_, cbet1);
-    _dn1 = sqrt(1 + g._ep2 * Math::sq(sbet1));
-
-    // Evaluate alp0 from sin(alp1) * cos(bet1) = sin(alp0),
-    _salp0 = _salp1 * cbet1; // alp0 in [0, pi/2 - |bet1|]
-    // Alt: calp0 = hypot(sbet1, calp1 * cbet1).  The following
-    // is slightly better (consider the case salp1 = 0).
-    _calp0 = hypot(_calp1, _salp1 * sbet1);
-    // Evaluate sig with tan(bet1) = tan(sig1) * cos(alp1).
-    // sig = 0 is nearest northward crossing of equator.
-    // With bet1 = 0, alp1 = pi/2, we have sig1 = 0 (equatorial line).
-    // With bet1 =  pi/2, alp1 = -pi, sig1 =  pi/2
-    // With bet1 = -pi/2, alp1 =  0 , sig1 = -pi/2
-    // Evaluate omg1 with tan(omg1) = sin(alp0) * tan(sig1).
-    // With alp0 in (0, pi/2], quadrants for sig and omg coincide.
-    // No atan2(0,0) ambiguity at poles since cbet1 = +epsilon.
-    // With alp0 = 0, omg1 = 0 for alp1 = 0, omg1 = pi for alp1 = pi.
-    _ssig1 = sbet1; _somg1 = _salp0 * sbet1;
-    _csig1 = _comg1 = sbet1 != 0 || _calp1 != 0 ? cbet1 * _calp1 : 1;
-    Math::norm(_ssig1, _csig1); // sig1 in (-pi, pi]
-    // Math::norm(_somg1, _comg1); -- don't need to normalize!
-
+    GeodesicKernel::LineInit(g, *this, lat1, lon1, azi1, salp1, calp1, caps);
     _a13 = _s13 = Math::NaN();
     _exact = g._exact;
-    if (_exact) {
+    if (_exact)
       _lineexact.LineInit(g._geodexact, lat1, lon1, azi1, salp1, calp1, caps);
-      return;
-    }
-
-    _k2 = Math::sq(_calp0) * g._ep2;
-    real eps = _k2 / (2 * (1 + sqrt(1 + _k2)) + _k2);
-
-    if (_caps & CAP_C1) {
-      _aA1m1 = Geodesic::A1m1f(eps);
-      Geodesic::C1f(eps, _cC1a);
-      _bB11 = Geodesic::SinCosSeries(true, _ssig1, _csig1, _cC1a, nC1_);
-      real s = sin(_bB11), c = cos(_bB11);
-      // tau1 = sig1 + B11
-      _stau1 = _ssig1 * c + _csig1 * s;
-      _ctau1 = _csig1 * c - _ssig1 * s;
-      // Not necessary because C1pa reverts C1a
-      //    _bB11 = -SinCosSeries(true, _stau1, _ctau1, _cC1pa, nC1p_);
-    }
-
-    if (_caps & CAP_C1p)
-      Geodesic::C1pf(eps, _cC1pa);
-
-    if (_caps & CAP_C2) {
-      _aA2m1 = Geodesic::A2m1f(eps);
-      Geodesic::C2f(eps, _cC2a);
-      _bB21 = Geodesic::SinCosSeries(true, _ssig1, _csig1, _cC2a, nC2_);
-    }
-
-    if (_caps & CAP_C3) {
-      g.C3f(eps, _cC3a);
-      _aA3c = -_f * _salp0 * g.A3f(eps);
-      _bB31 = Geodesic::SinCosSeries(true, _ssig1, _csig1, _cC3a, nC3_-1);
-    }
-
-    if (_caps & CAP_C4) {
-      g.C4f(eps, _cC4a);
-      // Multiplier = a^2 * e^2 * cos(alpha0) * sin(alpha0)
-      _aA4 = Math::sq(_a) * _calp0 * _salp0 * g._e2;
-      _bB41 = Geodesic::SinCosSeries(false, _ssig1, _csig1, _cC4a, nC4_);
-    }
-
   }
 
   GeodesicLine::GeodesicLine(const Geodesic& g,
                              real lat1, real lon1, real azi1,
                              unsigned caps) {
+    Reset(g, lat1, lon1, azi1, caps);
+  }
+
+  void GeodesicLine::Reset(const Geodesic& g,
+                           real lat1, real lon1, real azi1,
+                           unsigned caps) {
     azi1 = Math::AngNormalize(azi1);
     real salp1, calp1;
     // Guard against underflow in salp0.  Also -0 is converted to +0.
@@ -136,12 +65,30 @@ namespace GeographicLib {
     LineInit(g, lat1, lon1, azi1, salp1, calp1, caps);
   }
 
-  GeodesicLine::GeodesicLine(const Geodesic& g,
-                             real lat1, real lon1,
-                             real azi1, real salp1, real calp1,
-                             unsigned caps, bool arcmode, real s13_a13) {
+  void GeodesicLine::GenResetDirect(const Geodesic& g,
+                                    real lat1, real lon1, real azi1,
+                                    bool arcmode, real s12_a12,
+                                    unsigned caps) {
+    // Automatically supply DISTANCE_IN if necessary
+    if (!arcmode) caps |= DISTANCE_IN;
+    Reset(g, lat1, lon1, azi1, caps);
+    GenSetDistance(arcmode, s12_a12);
+  }
+
+  void GeodesicLine::ResetInverse(const Geodesic& g,
+                                  real lat1, real lon1,
+                                  real lat2, real lon2,
+                                  unsigned caps) {
+    real t, salp1, calp1, salp2, calp2,
+      a12 = g.GenInverse(lat1, lon1, lat2, lon2,
+                         // No need to specify AZIMUTH here
+                         0u, t, salp1, calp1, salp2, calp2,
+                         t, t, t, t),
+      azi1 = Math::atan2d(salp1, calp1);
+    // Ensure that a12 can be converted to a distance
+    if (caps & (OUT_MASK & DISTANCE_IN)) caps |= DISTANCE;
     LineInit(g, lat1, lon1, azi1, salp1, calp1, caps);
-    GenSetDistance(arcmode, s13_a13);
+    GenSetDistance(true, a12);
   }
 
   Math::real GeodesicLine::GenPosition(bool arcmode, real s12_a12,
@@ -154,163 +101,186 @@ namespace GeographicLib {
       return _lineexact.GenPosition(arcmode, s12_a12, outmask,
                                     lat2, lon2, azi2,
                                     s12, m12, M12, M21, S12);
-    outmask &= _caps & OUT_MASK;
-    if (!( Init() && (arcmode || (_caps & (OUT_MASK & DISTANCE_IN))) ))
-      // Uninitialized or impossible distance calculation requested
-      return Math::NaN();
-
-    // Avoid warning about uninitialized B12.
-    real sig12, ssig12, csig12, B12 = 0, AB1 = 0;
-    if (arcmode) {
-      // Interpret s12_a12 as spherical arc length
-      sig12 = s12_a12 * Math::degree();
-      Math::sincosd(s12_a12, ssig12, csig12);
-    } else {
-      // Interpret s12_a12 as distance
-      real
-        tau12 = s12_a12 / (_b * (1 + _aA1m1)),
-        s = sin(tau12),
-        c = cos(tau12);
-      // tau2 = tau1 + tau12
-      B12 = - Geodesic::SinCosSeries(true,
-                                     _stau1 * c + _ctau1 * s,
-                                     _ctau1 * c - _stau1 * s,
-                                     _cC1pa, nC1p_);
-      sig12 = tau12 - (B12 - _bB11);
-      ssig12 = sin(sig12); csig12 = cos(sig12);
-      if (fabs(_f) > 0.01) {
-        // Reverted distance series is inaccurate for |f| > 1/100, so correct
-        // sig12 with 1 Newton iteration.  The following table shows the
-        // approximate maximum error for a = WGS_a() and various f relative to
-        // GeodesicExact.
-        //     erri = the error in the inverse solution (nm)
-        //     errd = the error in the direct solution (series only) (nm)
-        //     errda = the error in the direct solution
-        //             (series + 1 Newton) (nm)
-        //
-        //       f     erri  errd errda
-        //     -1/5    12e6 1.2e9  69e6
-        //     -1/10  123e3  12e6 765e3
-        //     -1/20   1110 108e3  7155
-        //     -1/50  18.63 200.9 27.12
-        //     -1/100 18.63 23.78 23.37
-        //     -1/150 18.63 21.05 20.26
-        //      1/150 22.35 24.73 25.83
-        //      1/100 22.35 25.03 25.31
-        //      1/50  29.80 231.9 30.44
-        //      1/20   5376 146e3  10e3
-        //      1/10  829e3  22e6 1.5e6
-        //      1/5   157e6 3.8e9 280e6
-        real
-          ssig2 = _ssig1 * csig12 + _csig1 * ssig12,
-          csig2 = _csig1 * csig12 - _ssig1 * ssig12;
-        B12 = Geodesic::SinCosSeries(true, ssig2, csig2, _cC1a, nC1_);
-        real serr = (1 + _aA1m1) * (sig12 + (B12 - _bB11)) - s12_a12 / _b;
-        sig12 = sig12 - serr / sqrt(1 + _k2 * Math::sq(ssig2));
-        ssig12 = sin(sig12); csig12 = cos(sig12);
-        // Update B12 below
-      }
-    }
+    return GeodesicKernel::GenPosition(*this, arcmode, s12_a12, outmask,
+                                       lat2, lon2, azi2,
+                                       s12, m12, M12, M21, S12);
+  }
 
-    real ssig2, csig2, sbet2, cbet2, salp2, calp2;
-    // sig2 = sig1 + sig12
-    ssig2 = _ssig1 * csig12 + _csig1 * ssig12;
-    csig2 = _csig1 * csig12 - _ssig1 * ssig12;
-    real dn2 = sqrt(1 + _k2 * Math::sq(ssig2));
-    if (outmask & (DISTANCE | REDUCEDLENGTH | GEODESICSCALE)) {
-      if (arcmode || fabs(_f) > 0.01)
-        B12 = Geodesic::SinCosSeries(true, ssig2, csig2, _cC1a, nC1_);
-      AB1 = (1 + _aA1m1) * (B12 - _bB11);
-    }
-    // sin(bet2) = cos(alp0) * sin(sig2)
-    sbet2 = _calp0 * ssig2;
-    // Alt: cbet2 = hypot(csig2, salp0 * ssig2);
-    cbet2 = hypot(_salp0, _calp0 * csig2);
-    if (cbet2 == 0)
-      // I.e., salp0 = 0, csig2 = 0.  Break the degeneracy in this case
-      cbet2 = csig2 = tiny_;
-    // tan(alp0) = cos(sig2)*tan(alp2)
-    salp2 = _salp0; calp2 = _calp0 * csig2; // No need to normalize
+  void GeodesicLine::DistanceSigma(real s12, real tau12,
+                                   real stau12, real ctau12,
+                                   real& sig12, real& ssig12, real& csig12,
+                                   real& B12) const {
+    GeodesicKernel::DistanceSigma(*this, s12, tau12, stau12, ctau12,
+                                  sig12, ssig12, csig12, B12);
+  }
 
-    if (outmask & DISTANCE)
-      s12 = arcmode ? _b * ((1 + _aA1m1) * sig12 + AB1) : s12_a12;
+  Math::real GeodesicLine::SigmaPosition(bool arcmode, real s12_a12,
+                                         real sig12,
+                                         real ssig12, real csig12, real B12,
+                                         unsigned outmask,
+                                         real& lat2, real& lon2, real& azi2,
+                                         real& s12, real& m12,
+                                         real& M12, real& M21,
+                                         real& S12) const {
+    return GeodesicKernel::SigmaPosition(*this, arcmode, s12_a12,
+                                         sig12, ssig12, csig12, B12,
+                                         outmask, lat2, lon2, azi2,
+                                         s12, m12, M12, M21, S12);
+  }
 
-    if (outmask & LONGITUDE) {
-      // tan(omg2) = sin(alp0) * tan(sig2)
-      real somg2 = _salp0 * ssig2, comg2 = csig2,  // No need to normalize
-        E = copysign(real(1), _salp0);       // east-going?
-      // omg12 = omg2 - omg1
-      real omg12 = outmask & LONG_UNROLL
-        ? E * (sig12
-               - (atan2(    ssig2, csig2) - atan2(    _ssig1, _csig1))
-               + (atan2(E * somg2, comg2) - atan2(E * _somg1, _comg1)))
-        : atan2(somg2 * _comg1 - comg2 * _somg1,
-                comg2 * _comg1 + somg2 * _somg1);
-      real lam12 = omg12 + _aA3c *
-        ( sig12 + (Geodesic::SinCosSeries(true, ssig2, csig2, _cC3a, nC3_-1)
-                   - _bB31));
-      real lon12 = lam12 / Math::degree();
-      lon2 = outmask & LONG_UNROLL ? _lon1 + lon12 :
-        Math::AngNormalize(Math::AngNormalize(_lon1) +
-                           Math::AngNormalize(lon12));
+  void GeodesicLine::GenPosition(size_t n, bool arcmode,
+                                 const real s12_a12[], unsigned outmask,
+                                 real lat2[], real lon2[], real azi2[],
+                                 real s12[], real m12[],
+                                 real M12[], real M21[],
+                                 real S12[], real a12[]) const {
+    outmask &= _caps & OUT_MASK;
+    if (arcmode && !_exact && Init() &&
+        !(outmask & ~(LATITUDE | LONGITUDE | AZIMUTH))) {
+      ArcPositions(n, s12_a12, outmask, lat2, lon2, azi2);
+      if (a12)
+        for (size_t i = 0; i < n; ++i) a12[i] = s12_a12[i];
+      return;
     }
+    // Scratch outputs for the quantities not requested; these are never read.
+    real lat2x, lon2x, azi2x, s12x, m12x, M12x, M21x, S12x;
+    for (size_t i = 0; i < n; ++i) {
+      real a12x = GenPosition(arcmode, s12_a12[i], outmask,
+                              outmask & LATITUDE ? lat2[i] : lat2x,
+                              outmask & LONGITUDE ? lon2[i] : lon2x,
+                              outmask & AZIMUTH ? azi2[i] : azi2x,
+                              outmask & DISTANCE ? s12[i] : s12x,
+                              outmask & REDUCEDLENGTH ? m12[i] : m12x,
+                              outmask & GEODESICSCALE ? M12[i] : M12x,
+                              outmask & GEODESICSCALE ? M21[i] : M21x,
+                              outmask & AREA ? S12[i] : S12x);
+      if (a12) a12[i] = a12x;
+    }
+  }
 
-    if (outmask & LATITUDE)
-      lat2 = Math::atan2d(sbet2, _f1 * cbet2);
-
-    if (outmask & AZIMUTH)
-      azi2 = Math::atan2d(salp2, calp2);
-
-    if (outmask & (REDUCEDLENGTH | GEODESICSCALE)) {
-      real
-        B22 = Geodesic::SinCosSeries(true, ssig2, csig2, _cC2a, nC2_),
-        AB2 = (1 + _aA2m1) * (B22 - _bB21),
-        J12 = (_aA1m1 - _aA2m1) * sig12 + (AB1 - AB2);
-      if (outmask & REDUCEDLENGTH)
-        // Add parens around (_csig1 * ssig2) and (_ssig1 * csig2) to ensure
-        // accurate cancellation in the case of coincident points.
-        m12 = _b * ((dn2 * (_csig1 * ssig2) - _dn1 * (_ssig1 * csig2))
-                    - _csig1 * csig2 * J12);
-      if (outmask & GEODESICSCALE) {
-        real t = _k2 * (ssig2 - _ssig1) * (ssig2 + _ssig1) / (_dn1 + dn2);
-        M12 = csig12 + (t *  ssig2 -  csig2 * J12) * _ssig1 / _dn1;
-        M21 = csig12 - (t * _ssig1 - _csig1 * J12) *  ssig2 /  dn2;
+  void GeodesicLine::ArcPositions(size_t n, const real a12[],
+                                  unsigned outmask,
+                                  real lat2[], real lon2[],
+                                  real azi2[]) const {
+    // This follows SigmaPosition with arcmode = true, with each step applied
+    // to a group of points.  The operations are the same as for the scalar
+    // version, so the results are identical.
+    const int L = 8, nc = _order - 1;
+    const real lon1 = Math::AngNormalize(_lon1);
+    for (size_t i0 = 0; i0 < n; i0 += L) {
+      const int m = int(min(size_t(L), n - i0));
+      real sig12[L], ssig2[L], csig2[L];
+      for (int k = 0; k < m; ++k) {
+        real ssig12, csig12;
+        sig12[k] = a12[i0 + k] * Math::degree();
+        Math::sincosd(a12[i0 + k], ssig12, csig12);
+        // sig2 = sig1 + sig12
+        ssig2[k] = _ssig1 * csig12 + _csig1 * ssig12;
+        csig2[k] = _csig1 * csig12 - _ssig1 * ssig12;
+      }
+      for (int k = 0; k < m; ++k) {
+        // sin(bet2) = cos(alp0) * sin(sig2)
+        real sbet2 = _calp0 * ssig2[k],
+          cbet2 = hypot(_salp0, _calp0 * csig2[k]);
+        if (cbet2 == 0)
+          // I.e., salp0 = 0, csig2 = 0.  Break the degeneracy in this case
+          cbet2 = csig2[k] = tiny_;
+        if (outmask & LATITUDE)
+          lat2[i0 + k] = Math::atan2d(sbet2, _f1 * cbet2);
+        if (outmask & AZIMUTH)
+          azi2[i0 + k] = Math::atan2d(_salp0, _calp0 * csig2[k]);
+      }
+      if (!(outmask & LONGITUDE))
+        continue;
+      // Geodesic::SinCosSeries(true, ssig2, csig2, _cC3a, _order-1) for each
+      // point.
+      real ar[L], y0[L], y1[L];
+      for (int k = 0; k < m; ++k) {
+        ar[k] = 2 * (csig2[k] - ssig2[k]) * (csig2[k] + ssig2[k]);
+        y0[k] = nc & 1 ? _cC3a[nc] : 0; y1[k] = 0;
+      }
+      for (int j = nc - (nc & 1); j > 0; j -= 2)
+        for (int k = 0; k < m; ++k) {
+          y1[k] = ar[k] * y0[k] - y1[k] + _cC3a[j];
+          y0[k] = ar[k] * y1[k] - y0[k] + _cC3a[j - 1];
+        }
+      for (int k = 0; k < m; ++k) {
+        // tan(omg2) = sin(alp0) * tan(sig2)
+        real somg2 = _salp0 * ssig2[k], comg2 = csig2[k],
+          omg12 = atan2(somg2 * _comg1 - comg2 * _somg1,
+                        comg2 * _comg1 + somg2 * _somg1),
+          lam12 = omg12 + _aA3c *
+          ( sig12[k] + (2 * ssig2[k] * csig2[k] * y0[k] - _bB31) ),
+          lon12 = lam12 / Math::degree();
+        lon2[i0 + k] = Math::AngNormalize(lon1 + Math::AngNormalize(lon12));
       }
     }
+  }
 
-    if (outmask & AREA) {
-      real
-        B42 = Geodesic::SinCosSeries(false, ssig2, csig2, _cC4a, nC4_);
-      real salp12, calp12;
-      if (_calp0 == 0 || _salp0 == 0) {
-        // alp12 = alp2 - alp1, used in atan2 so no need to normalize
-        salp12 = salp2 * _calp1 - calp2 * _salp1;
-        calp12 = calp2 * _calp1 + salp2 * _salp1;
-        // We used to include here some patch up code that purported to deal
-        // with nearly meridional geodesics properly.  However, this turned out
-        // to be wrong once _salp1 = -0 was allowed (via
-        // Geodesic::InverseLine).  In fact, the calculation of {s,c}alp12
-        // was already correct (following the IEEE rules for handling signed
-        // zeros).  So the patch up code was unnecessary (as well as
-        // dangerous).
+  void GeodesicLine::GenWaypoints(bool arcmode, real s0_a0, real ds_da,
+                                  size_t n, unsigned outmask,
+                                  real lat2[], real lon2[], real azi2[],
+                                  real s12[], real m12[],
+                                  real M12[], real M21[],
+                                  real S12[], real a12[]) const {
+    outmask &= _caps & OUT_MASK;
+    // Scratch outputs for the quantities not requested; these are never read.
+    real lat2x, lon2x, azi2x, s12x, m12x, M12x, M21x, S12x;
+    if (_exact ||
+        !( Init() && (arcmode || (_caps & (OUT_MASK & DISTANCE_IN))) )) {
+      for (size_t i = 0; i < n; ++i) {
+        real a12x = GenPosition(arcmode, s0_a0 + real(i) * ds_da, outmask,
+                                outmask & LATITUDE ? lat2[i] : lat2x,
+                                outmask & LONGITUDE ? lon2[i] : lon2x,
+                                outmask & AZIMUTH ? azi2[i] : azi2x,
+                                outmask & DISTANCE ? s12[i] : s12x,
+                                outmask & REDUCEDLENGTH ? m12[i] : m12x,
+                                outmask & GEODESICSCALE ? M12[i] : M12x,
+                                outmask & GEODESICSCALE ? M21[i] : M21x,
+                                outmask & AREA ? S12[i] : S12x);
+        if (a12) a12[i] = a12x;
+      }
+      return;
+    }
+    // The angle which is advanced: sig12 in arc mode, tau12 in distance mode
+    // (in both cases, in radians).
+    const int nrestart = 16;
+    const real bA1 = _b * (1 + _aA1m1);
+    real sd, cd;
+    if (arcmode)
+      Math::sincosd(ds_da, sd, cd);
+    else {
+      sd = sin(ds_da / bA1); cd = cos(ds_da / bA1);
+    }
+    real s = 0, c = 1;
+    for (size_t i = 0; i < n; ++i) {
+      real x = s0_a0 + real(i) * ds_da,
+        ang = arcmode ? x * Math::degree() : x / bA1;
+      if (i % nrestart == 0) {
+        if (arcmode)
+          Math::sincosd(x, s, c);
+        else {
+          s = sin(ang); c = cos(ang);
+        }
       } else {
-        // tan(alp) = tan(alp0) * sec(sig)
-        // tan(alp2-alp1) = (tan(alp2) -tan(alp1)) / (tan(alp2)*tan(alp1)+1)
-        // = calp0 * salp0 * (csig1-csig2) / (salp0^2 + calp0^2 * csig1*csig2)
-        // If csig12 > 0, write
-        //   csig1 - csig2 = ssig12 * (csig1 * ssig12 / (1 + csig12) + ssig1)
-        // else
-        //   csig1 - csig2 = csig1 * (1 - csig12) + ssig12 * ssig1
-        // No need to normalize
-        salp12 = _calp0 * _salp0 *
-          (csig12 <= 0 ? _csig1 * (1 - csig12) + ssig12 * _ssig1 :
-           ssig12 * (_csig1 * ssig12 / (1 + csig12) + _ssig1));
-        calp12 = Math::sq(_salp0) + Math::sq(_calp0) * _csig1 * csig2;
+        real t = s * cd + c * sd;
+        c = c * cd - s * sd; s = t;
       }
-      S12 = _c2 * atan2(salp12, calp12) + _aA4 * (B42 - _bB41);
+      real sig12 = ang, ssig12 = s, csig12 = c, B12 = 0;
+      if (!arcmode)
+        DistanceSigma(x, ang, s, c, sig12, ssig12, csig12, B12);
+      real a12x =
+        SigmaPosition(arcmode, x, sig12, ssig12, csig12, B12, outmask,
+                      outmask & LATITUDE ? lat2[i] : lat2x,
+                      outmask & LONGITUDE ? lon2[i] : lon2x,
+                      outmask & AZIMUTH ? azi2[i] : azi2x,
+                      outmask & DISTANCE ? s12[i] : s12x,
+                      outmask & REDUCEDLENGTH ? m12[i] : m12x,
+                      outmask & GEODESICSCALE ? M12[i] : M12x,
+                      outmask & GEODESICSCALE ? M21[i] : M21x,
+                      outmask & AREA ? S12[i] : S12x);
+      if (a12) a12[i] = a12x;
     }
-
-    return arcmode ? s12_a12 : sig12 / Math::degree();
   }
 
   void GeodesicLine::SetDistance(real s13) {
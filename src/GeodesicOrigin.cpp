@@ -0,0 +1,71 @@
+/**
+ * \file GeodesicOrigin.cpp
+ * \brief Implementation for GeographicLib::GeodesicOrigin class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/GeodesicOrigin.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  GeodesicOrigin::GeodesicOrigin(const Geodesic& g, real lat1, real lon1)
+    : _geod(g)
+    , _lat1(Math::LatFix(lat1))
+    , _lon1(lon1)
+  {
+    _geod.LatSetup(_lat1, _t1);
+  }
+
+  Math::real GeodesicOrigin::GenInverse(real lat2, real lon2,
+                                        unsigned outmask,
+                                        real& s12, real& azi1, real& azi2,
+                                        real& m12, real& M12, real& M21,
+                                        real& S12) const {
+    outmask &= Geodesic::OUT_MASK;
+    real salp1, calp1, salp2, calp2,
+      a12 = _geod.GenInverse(_lat1, _lon1, lat2, lon2,
+                             outmask, s12, salp1, calp1, salp2, calp2,
+                             m12, M12, M21, S12, &_t1);
+    if (outmask & Geodesic::AZIMUTH) {
+      azi1 = Math::atan2d(salp1, calp1);
+      azi2 = Math::atan2d(salp2, calp2);
+    }
+    return a12;
+  }
+
+  void GeodesicOrigin::GenInverse(size_t n,
+                                  const real lat2[], const real lon2[],
+                                  unsigned outmask,
+                                  real s12[], real azi1[], real azi2[],
+                                  real m12[], real M12[], real M21[],
+                                  real S12[], real a12[]) const {
+    outmask &= Geodesic::OUT_MASK;
+    // Scratch outputs for the quantities not requested; these are never read.
+    real s12x, m12x, M12x, M21x, S12x;
+    for (size_t i = 0; i < n; ++i) {
+      real salp1, calp1, salp2, calp2,
+        a12x = _geod.GenInverse(_lat1, _lon1, lat2[i], lon2[i], outmask,
+                                outmask & Geodesic::DISTANCE ? s12[i] : s12x,
+                                salp1, calp1, salp2, calp2,
+                                outmask & Geodesic::REDUCEDLENGTH ?
+                                m12[i] : m12x,
+                                outmask & Geodesic::GEODESICSCALE ?
+                                M12[i] : M12x,
+                                outmask & Geodesic::GEODESICSCALE ?
+                                M21[i] : M21x,
+                                outmask & Geodesic::AREA ? S12[i] : S12x,
+                                &_t1);
+      if (outmask & Geodesic::AZIMUTH) {
+        azi1[i] = Math::atan2d(salp1, calp1);
+        azi2[i] = Math::atan2d(salp2, calp2);
+      }
+      if (a12) a12[i] = a12x;
+    }
+  }
+
+} // namespace GeographicLib
@@ -0,0 +1,77 @@
+/**
+ * \file GeodesicTrack.cpp
+ * \brief Implementation for GeographicLib::GeodesicTrack class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/GeodesicTrack.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  GeodesicTrack::GeodesicTrack(const Geodesic& g)
+    : _geod(g)
+  {
+    Reset();
+  }
+
+  void GeodesicTrack::Reset() {
+    _warm = Geodesic::WarmStart();
+    _lat2 = Math::NaN();
+  }
+
+  Math::real GeodesicTrack::GenInverse(real lat1, real lon1,
+                                       real lat2, real lon2,
+                                       unsigned outmask,
+                                       real& s12, real& azi1, real& azi2,
+                                       real& m12, real& M12, real& M21,
+                                       real& S12) {
+    outmask &= Geodesic::OUT_MASK;
+    // Reuse the terms for point 2 of the previous problem if this is point
+    // 1 (the terms only depend on the latitude).
+    Geodesic::LatTerms t1;
+    if (lat1 == _lat2)
+      t1 = _t2;
+    else
+      _geod.LatSetup(lat1, t1);
+    _lat2 = lat2;
+    _geod.LatSetup(_lat2, _t2);
+    real salp1, calp1, salp2, calp2,
+      a12 = _geod.GenInverse(lat1, lon1, lat2, lon2,
+                             outmask, s12, salp1, calp1, salp2, calp2,
+                             m12, M12, M21, S12, &t1, &_t2, &_warm);
+    if (outmask & Geodesic::AZIMUTH) {
+      azi1 = Math::atan2d(salp1, calp1);
+      azi2 = Math::atan2d(salp2, calp2);
+    }
+    return a12;
+  }
+
+  void GeodesicTrack::GenInverse(size_t n,
+                                 const real lat[], const real lon[],
+                                 unsigned outmask,
+                                 real s12[], real azi1[], real azi2[],
+                                 real m12[], real M12[], real M21[],
+                                 real S12[], real a12[]) {
+    outmask &= Geodesic::OUT_MASK;
+    // Scratch outputs for the quantities not requested; these are never read.
+    real s12x, azi1x, azi2x, m12x, M12x, M21x, S12x;
+    for (size_t i = 0; i + 1 < n; ++i) {
+      real a12x =
+        GenInverse(lat[i], lon[i], lat[i+1], lon[i+1], outmask,
+                   outmask & Geodesic::DISTANCE ? s12[i] : s12x,
+                   outmask & Geodesic::AZIMUTH ? azi1[i] : azi1x,
+                   outmask & Geodesic::AZIMUTH ? azi2[i] : azi2x,
+                   outmask & Geodesic::REDUCEDLENGTH ? m12[i] : m12x,
+                   outmask & Geodesic::GEODESICSCALE ? M12[i] : M12x,
+                   outmask & Geodesic::GEODESICSCALE ? M21[i] : M21x,
+                   outmask & Geodesic::AREA ? S12[i] : S12x);
+      if (a12) a12[i] = a12x;
+    }
+  }
+
+} // namespace GeographicLib
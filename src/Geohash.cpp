@@ -9,6 +9,7 @@
 
 #include <GeographicLib/Geohash.hpp>
 #include <GeographicLib/Utility.hpp>
+#include <cstring>
 
 #if defined(_MSC_VER)
 // Squelch warnings about enum-float expressions
@@ -22,7 +23,38 @@ namespace GeographicLib {
   const char* const Geohash::lcdigits_ = "0123456789bcdefghjkmnpqrstuvwxyz";
   const char* const Geohash::ucdigits_ = "0123456789BCDEFGHJKMNPQRSTUVWXYZ";
 
-  void Geohash::Forward(real lat, real lon, int len, string& geohash) {
+  namespace {
+
+    // Spread the low 32 bits of x into the even bits of the result.
+    inline unsigned long long Spread(unsigned long long x) {
+      x &= 0xffffffffULL;
+      x = (x | (x << 16)) & 0x0000ffff0000ffffULL;
+      x = (x | (x <<  8)) & 0x00ff00ff00ff00ffULL;
+      x = (x | (x <<  4)) & 0x0f0f0f0f0f0f0f0fULL;
+      x = (x | (x <<  2)) & 0x3333333333333333ULL;
+      x = (x | (x <<  1)) & 0x5555555555555555ULL;
+      return x;
+    }
+
+    // The inverse of Spread, collecting the even bits of x.
+    inline unsigned long long Compact(unsigned long long x) {
+      x &= 0x5555555555555555ULL;
+      x = (x | (x >>  1)) & 0x3333333333333333ULL;
+      x = (x | (x >>  2)) & 0x0f0f0f0f0f0f0f0fULL;
+      x = (x | (x >>  4)) & 0x00ff00ff00ff00ffULL;
+      x = (x | (x >>  8)) & 0x0000ffff0000ffffULL;
+      x = (x | (x >> 16)) & 0x00000000ffffffffULL;
+      return x;
+    }
+
+  } // namespace
+
+  bool Geohash::Interleave(real lat, real lon,
+                           unsigned long long& hi, unsigned long long& lo) {
+    // Set hi and lo to the 92 bits obtained by interleaving the 46-bit
+    // integer longitude and latitude, longitude first.  hi holds the first
+    // 64 bits and lo holds the last 28 bits left-justified.  Return false if
+    // lat or lon is NaN.
     using std::isnan;           // Needed for Centos 7, ubuntu 14
     static const real shift = ldexp(real(1), 45);
     static const real loneps = Math::hd / shift;
@@ -31,45 +63,127 @@ namespace GeographicLib {
       throw GeographicErr("Latitude " + Utility::str(lat)
                           + "d not in [-" + to_string(Math::qd)
                           + "d, " + to_string(Math::qd) + "d]");
-    if (isnan(lat) || isnan(lon)) {
-      geohash = "invalid";
-      return;
-    }
+    if (isnan(lat) || isnan(lon))
+      return false;
     if (lat == Math::qd) lat -= lateps / 2;
     lon = Math::AngNormalize(lon);
     if (lon == Math::hd) lon = -Math::hd; // lon now in [-180,180)
     // lon/loneps in [-2^45,2^45); lon/loneps + shift in [0,2^46)
     // similarly for lat
-    len = max(0, min(int(maxlen_), len));
     unsigned long long
       ulon = (unsigned long long)(floor(lon/loneps) + shift),
       ulat = (unsigned long long)(floor(lat/lateps) + shift);
-    char geohash1[maxlen_];
-    unsigned byte = 0;
-    for (unsigned i = 0; i < 5 * unsigned(len);) {
-      if ((i & 1) == 0) {
-        byte = (byte << 1) + unsigned((ulon & mask_) != 0);
-        ulon <<= 1;
-      } else {
-        byte = (byte << 1) + unsigned((ulat & mask_) != 0);
-        ulat <<= 1;
-      }
-      ++i;
-      if (i % 5 == 0) {
-        geohash1[(i/5)-1] = lcdigits_[byte];
-        byte = 0;
-      }
+    static_assert(mask_ == 1ULL << 45, "Interleave assumes 46-bit integers");
+    hi = (Spread(ulon >> 14) << 1) | Spread(ulat >> 14);
+    lo = ((Spread(ulon & 0x3fffU) << 1) | Spread(ulat & 0x3fffU)) << 36;
+    return true;
+  }
+
+  void Geohash::Forward(real lat, real lon, int len, string& geohash) {
+    char geohash1[MAXBUF];
+    Forward(lat, lon, len, geohash1);
+    geohash = geohash1;
+  }
+
+  void Geohash::Forward(real lat, real lon, int len, char geohash[]) {
+    unsigned long long hi, lo;
+    if (!Interleave(lat, lon, hi, lo)) {
+      copy_n("invalid", 8, geohash);
+      return;
+    }
+    len = max(0, min(int(maxlen_), len));
+    // Character i is given by bits [5*i, 5*i+5) of hi:lo
+    for (int i = 0; i < len; ++i) {
+      int o = 5 * i;
+      unsigned byte = unsigned(o + 5 <= 64 ? hi >> (59 - o) :
+                               o >= 64 ? lo >> (59 - (o - 64)) :
+                               (hi << (o - 59)) | (lo >> (123 - o))) & 31U;
+      geohash[i] = lcdigits_[byte];
     }
-    geohash.resize(len);
-    copy(geohash1, geohash1 + len, geohash.begin());
+    geohash[len] = '\0';
   }
 
-  void Geohash::Reverse(const string& geohash, real& lat, real& lon,
-                        int& len, bool centerp) {
+  void Geohash::Forward(size_t n, const real lat[], const real lon[], int len,
+                        char geohash[], size_t width) {
+    int len1 = max(7, max(0, min(int(maxlen_), len)));
+    if (!(int(width) > len1))
+      throw GeographicErr("Width " + Utility::str(width)
+                          + " too small for geohash length "
+                          + Utility::str(len));
+    for (size_t i = 0; i < n; ++i)
+      Forward(lat[i], lon[i], len, geohash + i * width);
+  }
+
+  unsigned long long Geohash::Key(real lat, real lon, int len) {
+    unsigned long long hi, lo;
+    if (!Interleave(lat, lon, hi, lo))
+      return ~0ULL;
+    len = max(0, min(int(MAXKEYLEN), len));
+    return len ? hi >> (64 - 5 * len) : 0;
+  }
+
+  void Geohash::Key(size_t n, const real lat[], const real lon[], int len,
+                    unsigned long long key[]) {
+    for (size_t i = 0; i < n; ++i)
+      key[i] = Key(lat[i], lon[i], len);
+  }
+
+  void Geohash::GenReverse(unsigned long long ulon, unsigned long long ulat,
+                           int len, bool centerp, real& lat, real& lon) {
+    // ulon and ulat hold the leading bits of the integer longitude and
+    // latitude given by a geohash of length len.
     static const real shift = ldexp(real(1), 45);
     static const real loneps = Math::hd / shift;
     static const real lateps = Math::qd / shift;
-    int len1 = min(int(maxlen_), int(geohash.length()));
+    ulon <<= 1; ulat <<= 1;
+    if (centerp) {
+      ulon += 1;
+      ulat += 1;
+    }
+    int s = 5 * (maxlen_ - len);
+    ulon <<=     (s / 2);
+    ulat <<= s - (s / 2);
+    lon = ulon * loneps - Math::hd;
+    lat = ulat * lateps - Math::qd;
+  }
+
+  void Geohash::Reverse(unsigned long long key, int len,
+                        real& lat, real& lon, bool centerp) {
+    len = max(0, min(int(MAXKEYLEN), len));
+    if ((key >> (5 * len)) != 0) {
+      lat = lon = Math::NaN();
+      return;
+    }
+    int nlon = (5 * len + 1) / 2, nlat = 5 * len / 2;
+    unsigned long long hi = len ? key << (64 - 5 * len) : 0,
+      ulon = nlon ? Compact(hi >> 1) >> (32 - nlon) : 0,
+      ulat = nlat ? Compact(hi) >> (32 - nlat) : 0;
+    GenReverse(ulon, ulat, len, centerp, lat, lon);
+  }
+
+  void Geohash::Reverse(const string& geohash, real& lat, real& lon,
+                        int& len, bool centerp) {
+    GenReverse(geohash.data(), int(geohash.length()), lat, lon, len, centerp);
+  }
+
+  void Geohash::Reverse(const char* geohash, real& lat, real& lon,
+                        int& len, bool centerp) {
+    GenReverse(geohash, int(strlen(geohash)), lat, lon, len, centerp);
+  }
+
+  void Geohash::Reverse(size_t n, const char geohash[], size_t width,
+                        real lat[], real lon[], int len[], bool centerp) {
+    for (size_t i = 0; i < n; ++i) {
+      const char* g = geohash + i * width;
+      int m = 0, len1;
+      while (m < int(width) && g[m]) ++m;
+      GenReverse(g, m, lat[i], lon[i], len ? len[i] : len1, centerp);
+    }
+  }
+
+  void Geohash::GenReverse(const char* geohash, int n, real& lat, real& lon,
+                           int& len, bool centerp) {
+    int len1 = min(int(maxlen_), n);
     if (len1 >= 3 &&
         ((toupper(geohash[0]) == 'I' &&
           toupper(geohash[1]) == 'N' &&
@@ -85,7 +199,8 @@ namespace GeographicLib {
     for (unsigned k = 0, j = 0; k < unsigned(len1); ++k) {
       int byte = Utility::lookup(ucdigits_, geohash[k]);
       if (byte < 0)
-        throw GeographicErr("Illegal character in geohash " + geohash);
+        throw GeographicErr("Illegal character in geohash "
+                            + string(geohash, n));
       for (unsigned m = 16; m; m >>= 1) {
         if (j == 0)
           ulon = (ulon << 1) + unsigned((byte & m) != 0);
@@ -94,16 +209,7 @@ namespace GeographicLib {
         j ^= 1;
       }
     }
-    ulon <<= 1; ulat <<= 1;
-    if (centerp) {
-      ulon += 1;
-      ulat += 1;
-    }
-    int s = 5 * (maxlen_ - len1);
-    ulon <<=     (s / 2);
-    ulat <<= s - (s / 2);
-    lon = ulon * loneps - Math::hd;
-    lat = ulat * lateps - Math::qd;
+    GenReverse(ulon, ulat, len1, centerp, lat, lon);
     len = len1;
   }
 
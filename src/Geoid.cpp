@@ -10,7 +10,13 @@
 #include <GeographicLib/Geoid.hpp>
 // For getenv
 #include <cstdlib>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
 #include <GeographicLib/Utility.hpp>
+#include <GeographicLib/Tracer.hpp>
 
 #if !defined(GEOGRAPHICLIB_DATA)
 #  if defined(_WIN32)
@@ -24,6 +30,20 @@
 #  define GEOGRAPHICLIB_GEOID_DEFAULT_NAME "egm96-5"
 #endif
 
+#if !defined(GEOGRAPHICLIB_GEOID_MMAP)
+#  if defined(__unix__) || defined(__APPLE__)
+#    define GEOGRAPHICLIB_GEOID_MMAP 1
+#  else
+#    define GEOGRAPHICLIB_GEOID_MMAP 0
+#  endif
+#endif
+
+#if GEOGRAPHICLIB_GEOID_MMAP
+#  include <sys/mman.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
 #if defined(_MSC_VER)
 // Squelch warnings about unsafe use of getenv and enum-float expressions
 #  pragma warning (disable: 4996 5055)
@@ -33,6 +53,11 @@ namespace GeographicLib {
 
   using namespace std;
 
+  namespace {
+    // The identifier at the start of a data file in the tiled format
+    const char tiledid[] = "GEOIDTGM";
+  }
+
   // This is the transfer matrix for a 3rd order fit with a 12-point stencil
   // with weights
   //
@@ -198,6 +223,184 @@ namespace GeographicLib {
      18,  -36,    2,   0,  -66,  -51, 0,   0,  102,  31,
   };
 
+  /**
+   * \brief A tile cache for a thread safe Geoid
+   *
+   * The grid is divided into square tiles which are read from the data file
+   * (or from the tiles of a file in the tiled format) on demand.  The tiles
+   * are distributed over several shards, each with its own lock and least
+   * recently used list, so that threads looking up pixels in different tiles
+   * rarely contend.  Reading the file is serialized by a separate lock.
+   **********************************************************************/
+  class Geoid::TileCache {
+  private:
+    static const int tilebits_ = Geoid::tilebits_, tilesize_ = 1 << tilebits_,
+      nshards_ = 16;
+    // Total size of the cached data and the size of a tile
+    static const size_t maxbytes_ = size_t(64) << 20,
+      tilebytes_ = sizeof(pixel_t) * tilesize_ * tilesize_;
+    typedef unsigned key_t;
+    typedef vector<pixel_t> tile;
+    struct Shard {
+      mutex lock;
+      // Most recently used tiles at the front
+      list< pair<key_t, tile> > lru;
+      unordered_map< key_t, list< pair<key_t, tile> >::iterator > index;
+    };
+    const Geoid& _g;
+    const size_t _maxtiles;     // per shard
+    Shard _shards[nshards_];
+    mutex _filelock;
+    void readtile(int tx, int ty, tile& t) {
+      int x0 = tx << tilebits_, y0 = ty << tilebits_,
+        nx = min(tilesize_, _g._width - x0),
+        ny = min(tilesize_, _g._height - y0);
+      t.resize(size_t(tilesize_) * tilesize_);
+      lock_guard<mutex> guard(_filelock);
+      Tracer::Span span("Geoid::readtile", _g._filename.c_str());
+      try {
+        if (_g._tiled) {
+          // The tile is stored contiguously
+          const tileentry& e =
+            _g._tileindex[size_t(ty) * ((_g._width + tilesize_ - 1)
+                                        >> tilebits_) + unsigned(tx)];
+          vector<char> buf(e.bytes);
+          if (_g._source)
+            _g._source->Read(e.offset, e.bytes, buf.data());
+          else {
+            _g._file.seekg(streamoff(e.offset));
+            _g._file.read(buf.data(), streamsize(e.bytes));
+          }
+          decodetile(e, buf.data(), nx, ny, t.data());
+        } else if (_g._source) {
+          // Fetch the rows of the tile with a single call
+          unsigned long long offset[tilesize_];
+          size_t n[tilesize_];
+          char* buf[tilesize_];
+          for (int iy = 0; iy < ny; ++iy) {
+            offset[iy] = _g.pixeloffset(x0, y0 + iy);
+            n[iy] = size_t(nx) * pixel_size_;
+            buf[iy] = reinterpret_cast<char*>(&t[size_t(iy) << tilebits_]);
+          }
+          _g._source->ReadRanges(size_t(ny), offset, n, buf);
+          for (int iy = 0; iy < ny; ++iy)
+            frombigendian(&t[size_t(iy) << tilebits_], size_t(nx));
+        } else {
+          for (int iy = 0; iy < ny; ++iy) {
+            _g.filepos(x0, y0 + iy);
+            Utility::readarray<pixel_t, pixel_t, true>
+              (_g._file, &t[size_t(iy) << tilebits_], nx);
+          }
+        }
+      }
+      catch (const exception& e) {
+        string err("Error reading ");
+        err += _g._filename;
+        err += ": ";
+        err += e.what();
+        throw GeographicErr(err);
+      }
+    }
+    key_t key(int tx, int ty) const {
+      return key_t(ty) * key_t((_g._width >> tilebits_) + 1) + key_t(tx);
+    }
+    // Call f(t) for the tile (tx, ty), reading it if necessary; f is called
+    // with the lock for the shard held.
+    template<class F> void access(int tx, int ty, F f) {
+      key_t k = key(tx, ty);
+      Shard& sh = _shards[k % nshards_];
+      {
+        lock_guard<mutex> guard(sh.lock);
+        auto it = sh.index.find(k);
+        if (it != sh.index.end()) {
+          sh.lru.splice(sh.lru.begin(), sh.lru, it->second);
+          f(it->second->second);
+          return;
+        }
+      }
+      // Read the tile without holding the shard lock.  Another thread may
+      // read the same tile concurrently; whichever inserts it second just
+      // uses the existing copy.
+      tile t;
+      readtile(tx, ty, t);
+      lock_guard<mutex> guard(sh.lock);
+      auto it = sh.index.find(k);
+      if (it == sh.index.end()) {
+        if (sh.lru.size() >= _maxtiles) {
+          sh.index.erase(sh.lru.back().first);
+          sh.lru.pop_back();
+        }
+        sh.lru.emplace_front(k, tile());
+        sh.lru.front().second.swap(t);
+        sh.index[k] = sh.lru.begin();
+        f(sh.lru.front().second);
+      } else
+        f(it->second->second);
+    }
+  public:
+    explicit TileCache(const Geoid& g)
+      : _g(g)
+      , _maxtiles(max(size_t(1), maxbytes_ / (nshards_ * tilebytes_)))
+    {}
+    // The memory used by the cached tiles and the limit on this
+    size_t Bytes() {
+      size_t n = 0;
+      for (Shard& sh : _shards) {
+        lock_guard<mutex> guard(sh.lock);
+        n += sh.lru.size();
+      }
+      return n * tilebytes_;
+    }
+    size_t MaxBytes() const { return _maxtiles * nshards_ * tilebytes_; }
+    unsigned operator()(int ix, int iy) {
+      size_t p = (size_t(iy & (tilesize_ - 1)) << tilebits_) +
+        size_t(ix & (tilesize_ - 1));
+      unsigned r = 0;
+      access(ix >> tilebits_, iy >> tilebits_,
+             [p, &r](const tile& t) -> void { r = t[p]; });
+      return r;
+    }
+    // Copy the pixels [ix, ix + n) of row iy to row.
+    void Row(int ix, int iy, int n, pixel_t row[]) {
+      const size_t y = size_t(iy & (tilesize_ - 1)) << tilebits_;
+      for (int x = ix; x < ix + n;) {
+        int tx = x >> tilebits_, x0 = tx << tilebits_,
+          x1 = min(ix + n, x0 + tilesize_);
+        access(tx, iy >> tilebits_, [&](const tile& t) -> void {
+            copy(t.begin() + (y + unsigned(x - x0)),
+                 t.begin() + (y + unsigned(x1 - x0)), row + (x - ix));
+          });
+        x = x1;
+      }
+    }
+    // Load the tiles containing the pixels [ix0, ix1] of row iy unless they
+    // are already cached or their shards are full.
+    void Load(int ix0, int ix1, int iy) {
+      int ty = iy >> tilebits_;
+      for (int tx = ix0 >> tilebits_; tx <= ix1 >> tilebits_; ++tx) {
+        key_t k = key(tx, ty);
+        Shard& sh = _shards[k % nshards_];
+        {
+          lock_guard<mutex> guard(sh.lock);
+          if (sh.lru.size() >= _maxtiles || sh.index.find(k) != sh.index.end())
+            continue;
+        }
+        tile t;
+        readtile(tx, ty, t);
+        lock_guard<mutex> guard(sh.lock);
+        if (sh.lru.size() < _maxtiles && sh.index.find(k) == sh.index.end()) {
+          sh.lru.emplace_front(k, tile());
+          sh.lru.front().second.swap(t);
+          sh.index[k] = sh.lru.begin();
+        }
+      }
+    }
+  };
+
+  unsigned Geoid::tileval(int ix, int iy) const {
+    return (*_tiles)(ix, iy);
+  }
+
   Geoid::Geoid(const std::string& name, const std::string& path, bool cubic,
                bool threadsafe)
     : _name(name)
@@ -207,24 +410,130 @@ namespace GeographicLib {
     , _e2( (2 - Constants::WGS84_f()) * Constants::WGS84_f() )
     , _degree( Math::degree() )
     , _eps( sqrt(numeric_limits<real>::epsilon()) )
+    , _mmap(nullptr)
+    , _mmapsize(0)
+    , _tiled(false)
     , _threadsafe(false)        // Set after cache is read
   {
     static_assert(sizeof(pixel_t) == pixel_size_, "pixel_t has the wrong size");
     if (_dir.empty())
       _dir = DefaultGeoidPath();
     _filename = _dir + "/" + _name + (pixel_size_ != 4 ? ".pgm" : ".pgm4");
+    Tracer::Span span("Geoid::Geoid", _filename.c_str());
     _file.open(_filename.c_str(), ios::binary);
-    if (!(_file.good()))
-      throw GeographicErr("File not readable " + _filename);
-    string s;
-    if (!(getline(_file, s) && s == "P5"))
-      throw GeographicErr("File not in PGM format " + _filename);
+    if (!(_file.good())) {
+      // Fall back to the file in the tiled format
+      string tiled = _dir + "/" + _name + ".tgm";
+      _file.clear();
+      _file.open(tiled.c_str(), ios::binary);
+      if (!(_file.good()))
+        throw GeographicErr("File not readable " + _filename);
+      _filename = tiled;
+    }
+    readheader(_file);
+    _file.seekg(0, ios::end);
+    checksize(_file.good() ? (unsigned long long)(_file.tellg()) : 0ULL);
+    // Ensure that file errors throw exceptions
+    _file.exceptions(ifstream::eofbit | ifstream::failbit | ifstream::badbit);
+#if GEOGRAPHICLIB_GEOID_MMAP
+    if (!_tiled) {
+      // If the mapping fails, silently fall back to reading the stream.
+      int fd = open(_filename.c_str(), O_RDONLY);
+      if (fd >= 0) {
+        size_t size = size_t(_datastart + pixel_size_ * _swidth *
+                             (unsigned long long)(_height));
+        void* p = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (p != MAP_FAILED) {
+          _mmap = static_cast<const unsigned char*>(p);
+          _mmapsize = size;
+          _file.close();
+        }
+      }
+    }
+#endif
+    if (threadsafe || _tiled) {
+      // Access to the memory mapped data is thread safe, so only need the
+      // tile cache if the file isn't mapped.  The tiled format is always
+      // read through the tile cache.
+      if (!_mmap) {
+        try {
+          _tiles.reset(new TileCache(*this));
+        }
+        catch (const bad_alloc&) {
+          throw GeographicErr("Insufficient memory for caching " + _filename);
+        }
+      }
+      _threadsafe = threadsafe;
+    }
+  }
+
+  Geoid::Geoid(unique_ptr<Source> source, const std::string& name,
+               bool cubic, bool threadsafe)
+    : _name(name)
+    , _cubic(cubic)
+    , _a( Constants::WGS84_a() )
+    , _e2( (2 - Constants::WGS84_f()) * Constants::WGS84_f() )
+    , _degree( Math::degree() )
+    , _eps( sqrt(numeric_limits<real>::epsilon()) )
+    , _mmap(nullptr)
+    , _mmapsize(0)
+    , _source(std::move(source))
+    , _tiled(false)
+    , _threadsafe(false)        // Set after cache is read
+  {
+    static_assert(sizeof(pixel_t) == pixel_size_, "pixel_t has the wrong size");
+    _filename = _name + (pixel_size_ != 4 ? ".pgm" : ".pgm4");
+    Tracer::Span span("Geoid::Geoid", _filename.c_str());
+    if (!_source)
+      throw GeographicErr("No source for " + _filename);
+    unsigned long long size = _source->Size();
+    // Read enough of the start of the file to hold the header (which is
+    // typically a few hundred bytes).
+    for (size_t len = 1024;; len *= 2) {
+      len = size_t(min((unsigned long long)(len), size));
+      string head(len, '\0');
+      if (len) _source->Read(0, len, &head[0]);
+      istringstream is(head);
+      try {
+        readheader(is);
+        break;
+      }
+      catch (const GeographicErr&) {
+        if (len == size)
+          throw;
+      }
+    }
+    checksize(size);
+    try {
+      _tiles.reset(new TileCache(*this));
+    }
+    catch (const bad_alloc&) {
+      throw GeographicErr("Insufficient memory for caching " + _filename);
+    }
+    _threadsafe = threadsafe;
+  }
+
+  void Geoid::readheader(std::istream& hdr) {
     _offset = numeric_limits<real>::max();
     _scale = 0;
     _maxerror = _rmserror = -1;
+    for (int i = 0; i < 4; ++i) _errors[i] = -1;
     _description = "NONE";
     _datetime = "UNKNOWN";
-    while (getline(_file, s)) {
+    {
+      char id[8];
+      if (hdr.read(id, 8) && string(id, 8) == tiledid) {
+        readtiledheader(hdr);
+        return;
+      }
+      hdr.clear();
+      hdr.seekg(0);
+    }
+    string s;
+    if (!(getline(hdr, s) && s == "P5"))
+      throw GeographicErr("File not in PGM format " + _filename);
+    while (getline(hdr, s)) {
       if (s.empty())
         continue;
       if (s[0] == '#') {
@@ -243,12 +552,14 @@ namespace GeographicLib {
         } else if (key == "Scale") {
           if (!(is >> _scale))
             throw GeographicErr("Error reading scale " + _filename);
-        } else if (key == (_cubic ? "MaxCubicError" : "MaxBilinearError")) {
-          // It's not an error if the error can't be read
-          is >> _maxerror;
-        } else if (key == (_cubic ? "RMSCubicError" : "RMSBilinearError")) {
-          // It's not an error if the error can't be read
-          is >> _rmserror;
+        } else {
+          // It's not an error if the errors can't be read
+          static const char* const errorkeys[] = {
+            "MaxBilinearError", "RMSBilinearError",
+            "MaxCubicError", "RMSCubicError",
+          };
+          for (int i = 0; i < 4; ++i)
+            if (key == errorkeys[i]) is >> _errors[i];
         }
       } else {
         istringstream is(s);
@@ -259,12 +570,15 @@ namespace GeographicLib {
     }
     {
       unsigned maxval;
-      if (!(_file >> maxval))
+      if (!(hdr >> maxval))
         throw GeographicErr("Error reading maxval " + _filename);
       if (maxval != pixel_max_)
         throw GeographicErr("Incorrect value of maxval " + _filename);
+      // The header is incomplete unless maxval is followed by whitespace
+      if (hdr.peek() == char_traits<char>::eof())
+        throw GeographicErr("Error reading maxval " + _filename);
       // Add 1 for whitespace after maxval
-      _datastart = (unsigned long long)(_file.tellg()) + 1ULL;
+      _datastart = (unsigned long long)(hdr.tellg()) + 1ULL;
       _swidth = (unsigned long long)(_width);
     }
     if (_offset == numeric_limits<real>::max())
@@ -282,147 +596,597 @@ namespace GeographicLib {
     if (!(_height & 1))
       // This is so that latitude grid includes the equator.
       throw GeographicErr("Raster height is even " + _filename);
-    _file.seekg(0, ios::end);
-    if (!_file.good() ||
-        _datastart + pixel_size_ * _swidth * (unsigned long long)(_height) !=
-        (unsigned long long)(_file.tellg()))
+    _maxerror = _errors[_cubic ? 2 : 0];
+    _rmserror = _errors[_cubic ? 3 : 1];
+  }
+
+  void Geoid::readtiledheader(std::istream& hdr) {
+    // The layout of the header is described in Geoid::WriteTiled.
+    int v[5];
+    Utility::readarray<int32_t, int, false>(hdr, v, 5);
+    if (v[0] != 1)
+      throw GeographicErr("Unknown version of tiled format " + _filename);
+    if (v[1] != int(pixel_size_))
+      throw GeographicErr("Incorrect pixel size " + _filename);
+    if (v[4] != tilebits_)
+      throw GeographicErr("Unsupported tile size " + _filename);
+    _width = v[2]; _height = v[3];
+    real d[6];
+    Utility::readarray<double, real, false>(hdr, d, 6);
+    _offset = d[0]; _scale = d[1];
+    for (int i = 0; i < 4; ++i) _errors[i] = d[i + 2];
+    for (int k = 0; k < 2; ++k) {
+      int32_t len;
+      Utility::readarray<int32_t, int32_t, false>(hdr, &len, 1);
+      if (!(len >= 0 && len < 4096))
+        throw GeographicErr("Bad string length " + _filename);
+      string str(size_t(len), '\0');
+      if (len && !hdr.read(&str[0], len))
+        throw GeographicErr("Failure reading data");
+      (k == 0 ? _description : _datetime) = str;
+    }
+    if (!(_scale > 0 && _height >= 2 && _width >= 2 &&
+          !(_width & 1) && (_height & 1)))
+      throw GeographicErr("Bad raster or scaling " + _filename);
+    const size_t ntiles =
+      size_t((_width + (1 << tilebits_) - 1) >> tilebits_) *
+      size_t((_height + (1 << tilebits_) - 1) >> tilebits_);
+    // The index is a sequence of (uint64 offset, uint32 bytes, uint32
+    // encoding) entries
+    _tileindex.resize(ntiles);
+    for (size_t i = 0; i < ntiles; ++i) {
+      Utility::readarray<uint64_t, unsigned long long, false>
+        (hdr, &_tileindex[i].offset, 1);
+      unsigned be[2];
+      Utility::readarray<uint32_t, unsigned, false>(hdr, be, 2);
+      _tileindex[i].bytes = be[0]; _tileindex[i].encoding = be[1];
+    }
+    _datastart = (unsigned long long)(hdr.tellg());
+    _swidth = (unsigned long long)(_width);
+    _tiled = true;
+    _maxerror = _errors[_cubic ? 2 : 0];
+    _rmserror = _errors[_cubic ? 3 : 1];
+  }
+
+  void Geoid::checksize(unsigned long long size) {
+    if (_tiled) {
+      for (const tileentry& e : _tileindex)
+        if (!(e.offset >= _datastart && e.offset <= size &&
+              e.bytes <= size - e.offset))
+          throw GeographicErr("Tile beyond the end of " + _filename);
+    } else if (_datastart + pixel_size_ * _swidth *
+               (unsigned long long)(_height) != size)
       // Possibly this test should be "<" because the file contains, e.g., a
       // second image.  However, for now we are more strict.
       throw GeographicErr("File has the wrong length " + _filename);
     _rlonres = _width / real(Math::td);
     _rlatres = (_height - 1) / real(Math::hd);
     _cache = false;
+    _cachebudget = numeric_limits<size_t>::max();
+    _compressed = _compress = _precompute = false;
+    _stride = _data0 = 0;
     _ix = _width;
     _iy = _height;
-    // Ensure that file errors throw exceptions
-    _file.exceptions(ifstream::eofbit | ifstream::failbit | ifstream::badbit);
-    if (threadsafe) {
-      CacheAll();
-      _file.close();
-      _threadsafe = true;
+  }
+
+  void Geoid::frombigendian(pixel_t row[], size_t n) {
+    // Each pixel is replaced by its value in the same storage.
+    unsigned char* p = reinterpret_cast<unsigned char*>(row);
+    for (size_t i = 0; i < n; ++i, p += pixel_size_) {
+      unsigned r = (unsigned(p[0]) << 8) | unsigned(p[1]);
+      if (pixel_size_ == 4)
+        r = (r << 16) | (unsigned(p[2]) << 8) | unsigned(p[3]);
+      row[i] = pixel_t(r);
     }
   }
 
-  Math::real Geoid::height(real lat, real lon) const {
+  void Geoid::readrow(int ix, int iy, int n, pixel_t row[]) const {
+    if (_tiles)
+      _tiles->Row(ix, iy, n, row);
+    else {
+      filepos(ix, iy);
+      Utility::readarray<pixel_t, pixel_t, true>(_file, row, n);
+    }
+  }
+
+  // In the tiled format, a tile with encoding 0 holds the pixels as
+  // little-endian integers.  With encoding 1, the tile is a byte giving the
+  // number of bits, b, and the first pixel (as a little-endian integer),
+  // followed by the differences of the pixels from their predictions,
+  // packed into b bits each (least significant bit first).  The prediction
+  // is the pixel to the west or, for the first pixel of a row, the first
+  // pixel of the previous row (the first pixel for the first row).  The
+  // differences are taken modulo 2^(8 * pixel_size_) and mapped to
+  // unsigned integers with 0, -1, 1, -2, ... -> 0, 1, 2, 3, ...
+  void Geoid::decodetile(const tileentry& e, const char* buf,
+                         int nx, int ny, pixel_t t[]) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(buf);
+    const size_t npix = size_t(nx) * unsigned(ny);
+    if (e.encoding == 0) {
+      if (e.bytes != npix * pixel_size_)
+        throw GeographicErr("Corrupt tile");
+      for (int iy = 0; iy < ny; ++iy) {
+        pixel_t* row = t + (size_t(iy) << tilebits_);
+        for (int ix = 0; ix < nx; ++ix, p += pixel_size_) {
+          unsigned r = unsigned(p[0]) | (unsigned(p[1]) << 8);
+          if (pixel_size_ == 4)
+            r |= (unsigned(p[2]) << 16) | (unsigned(p[3]) << 24);
+          row[ix] = pixel_t(r);
+        }
+      }
+    } else if (e.encoding == 1) {
+      const int b = e.bytes > pixel_size_ ? p[0] : -1;
+      if (!(b >= 0 && b <= int(8 * pixel_size_) &&
+            e.bytes == 1 + pixel_size_ + (npix * unsigned(b) + 7) / 8))
+        throw GeographicErr("Corrupt tile");
+      unsigned r = unsigned(p[1]) | (unsigned(p[2]) << 8);
+      if (pixel_size_ == 4)
+        r |= (unsigned(p[3]) << 16) | (unsigned(p[4]) << 24);
+      p += 1 + pixel_size_;
+      const unsigned long long mask = b ? ~0ULL >> (64 - b) : 0;
+      unsigned long long acc = 0;
+      int nacc = 0;
+      pixel_t first = pixel_t(r);
+      for (int iy = 0; iy < ny; ++iy) {
+        pixel_t* row = t + (size_t(iy) << tilebits_), prev = first;
+        for (int ix = 0; ix < nx; ++ix) {
+          while (nacc < b) {
+            acc |= (unsigned long long)(*p++) << nacc;
+            nacc += 8;
+          }
+          unsigned long long z = acc & mask;
+          acc >>= b; nacc -= b;
+          // Undo the mapping to unsigned and add the prediction; the
+          // arithmetic wraps around as for the differences.
+          unsigned long long d = z & 1 ? ~(z >> 1) : z >> 1;
+          prev = row[ix] = pixel_t((unsigned long long)(prev) + d);
+        }
+        first = row[0];
+      }
+    } else
+      throw GeographicErr("Unknown tile encoding");
+  }
+
+  unsigned Geoid::encodetile(const pixel_t t[], size_t w, int nx, int ny,
+                             bool compress, string& buf) {
+    const size_t npix = size_t(nx) * unsigned(ny);
+    buf.clear();
+    if (compress) {
+      // The mapped differences, as decoded by decodetile
+      vector<unsigned> z(npix);
+      unsigned zmax = 0;
+      pixel_t first = t[0];
+      for (int iy = 0, k = 0; iy < ny; ++iy) {
+        const pixel_t* row = t + size_t(iy) * w;
+        pixel_t prev = first;
+        for (int ix = 0; ix < nx; ++ix, ++k) {
+          // Difference modulo 2^(8 * pixel_size_) as a signed number
+          pixel_t u = pixel_t(row[ix] - prev);
+          bool neg = u > pixel_t(pixel_max_ >> 1);
+          z[k] = neg ? unsigned(pixel_t(~u)) * 2 + 1 : unsigned(u) * 2;
+          zmax = max(zmax, z[k]);
+          prev = row[ix];
+        }
+        first = row[0];
+      }
+      int b = 0;
+      while (b < 32 && (zmax >> b)) ++b;
+      const size_t bytes = 1 + pixel_size_ + (npix * unsigned(b) + 7) / 8;
+      if (bytes < npix * pixel_size_) {
+        buf.reserve(bytes);
+        buf.push_back(char(b));
+        for (unsigned j = 0; j < pixel_size_; ++j)
+          buf.push_back(char((unsigned(t[0]) >> (8 * j)) & 0xffu));
+        unsigned long long acc = 0;
+        int nacc = 0;
+        for (size_t k = 0; k < npix; ++k) {
+          acc |= (unsigned long long)(z[k]) << nacc;
+          nacc += b;
+          for (; nacc >= 8; nacc -= 8, acc >>= 8)
+            buf.push_back(char(acc & 0xffu));
+        }
+        if (nacc)
+          buf.push_back(char(acc & 0xffu));
+        return 1;
+      }
+    }
+    buf.reserve(npix * pixel_size_);
+    for (int iy = 0; iy < ny; ++iy) {
+      const pixel_t* row = t + size_t(iy) * w;
+      for (int ix = 0; ix < nx; ++ix)
+        for (unsigned j = 0; j < pixel_size_; ++j)
+          buf.push_back(char((unsigned(row[ix]) >> (8 * j)) & 0xffu));
+    }
+    return 0;
+  }
+
+  void Geoid::WriteTiled(const std::string& filename, bool compress) const {
+    // The file is
+    //   the 8 characters GEOIDTGM;
+    //   int32: version = 1, pixel size, width, height, tile bits;
+    //   float64: offset, scale, max bilinear error, RMS bilinear error,
+    //     max cubic error, RMS cubic error;
+    //   the description and the date time, each as an int32 length
+    //     followed by the characters;
+    //   the index of the tiles in row-major order, each entry being uint64
+    //     offset, uint32 bytes, uint32 encoding;
+    //   the tiles (see decodetile).
+    // All the numbers are little-endian.
+    const int ts = 1 << tilebits_,
+      ntx = (_width + ts - 1) >> tilebits_,
+      nty = (_height + ts - 1) >> tilebits_;
+    vector<tileentry> index(size_t(ntx) * unsigned(nty));
+    ofstream file(filename.c_str(), ios::binary);
+    if (!file.good())
+      throw GeographicErr("Failed to open " + filename);
+    try {
+      file.write(tiledid, 8);
+      int v[5] = {1, int(pixel_size_), _width, _height, tilebits_};
+      Utility::writearray<int32_t, int, false>(file, v, 5);
+      real d[6] = {_offset, _scale,
+                   _errors[0], _errors[1], _errors[2], _errors[3]};
+      Utility::writearray<double, real, false>(file, d, 6);
+      for (const string* str : {&_description, &_datetime}) {
+        int32_t len = int32_t(str->size());
+        Utility::writearray<int32_t, int32_t, false>(file, &len, 1);
+        file.write(str->data(), len);
+      }
+      streamoff indexpos = file.tellp();
+      // Write the index once the tiles are written
+      vector<char> zeros(index.size() * 16);
+      file.write(zeros.data(), streamsize(zeros.size()));
+      // The rows of the tiles of one row of tiles
+      vector<pixel_t> band(size_t(_width) * ts);
+      string buf;
+      for (int ty = 0; ty < nty; ++ty) {
+        int y0 = ty << tilebits_, ny = min(ts, _height - y0);
+        for (int iy = 0; iy < ny; ++iy) {
+          pixel_t* row = &band[size_t(iy) * unsigned(_width)];
+          if (_mmap)
+            for (int ix = 0; ix < _width; ++ix)
+              row[ix] = pixel_t(mappedval(ix, y0 + iy));
+          else
+            readrow(0, y0 + iy, _width, row);
+        }
+        for (int tx = 0; tx < ntx; ++tx) {
+          int x0 = tx << tilebits_, nx = min(ts, _width - x0);
+          tileentry& e = index[size_t(ty) * unsigned(ntx) + unsigned(tx)];
+          e.encoding = encodetile(&band[unsigned(x0)], size_t(_width),
+                                  nx, ny, compress, buf);
+          e.offset = (unsigned long long)(file.tellp());
+          e.bytes = unsigned(buf.size());
+          file.write(buf.data(), streamsize(buf.size()));
+        }
+      }
+      file.seekp(indexpos);
+      for (const tileentry& e : index) {
+        Utility::writearray<uint64_t, unsigned long long, false>
+          (file, &e.offset, 1);
+        unsigned be[2] = {e.bytes, e.encoding};
+        Utility::writearray<uint32_t, unsigned, false>(file, be, 2);
+      }
+      file.close();
+      if (file.fail())
+        throw GeographicErr("Failure writing data");
+    }
+    catch (const exception& e) {
+      string err("Error writing ");
+      err += filename;
+      err += ": ";
+      err += e.what();
+      throw GeographicErr(err);
+    }
+  }
+
+  Geoid::~Geoid() {
+#if GEOGRAPHICLIB_GEOID_MMAP
+    if (_mmap)
+      munmap(const_cast<unsigned char*>(_mmap), size_t(_mmapsize));
+#endif
+  }
+
+  bool Geoid::cell(real lat, real lon, int& ix, int& iy,
+                   real& fx, real& fy) const {
     using std::isnan;           // Needed for Centos 7, ubuntu 14
     lat = Math::LatFix(lat);
-    if (isnan(lat) || isnan(lon)) {
-      return Math::NaN();
-    }
+    if (isnan(lat) || isnan(lon))
+      return false;
     lon = Math::AngNormalize(lon);
-    real
-      fx =  lon * _rlonres,
-      fy = -lat * _rlatres;
-    int
-      ix = int(floor(fx)),
-      iy = min((_height - 1)/2 - 1, int(floor(fy)));
+    fx =  lon * _rlonres;
+    fy = -lat * _rlatres;
+    ix = int(floor(fx));
+    iy = min((_height - 1)/2 - 1, int(floor(fy)));
     fx -= ix;
     fy -= iy;
     iy += (_height - 1)/2;
     ix += ix < 0 ? _width : (ix >= _width ? -_width : 0);
-    real v00 = 0, v01 = 0, v10 = 0, v11 = 0;
-    real t[nterms_];
+    return true;
+  }
 
-    if (_threadsafe || !(ix == _ix && iy == _iy)) {
-      if (!_cubic) {
-        v00 = rawval(ix    , iy    );
-        v01 = rawval(ix + 1, iy    );
-        v10 = rawval(ix    , iy + 1);
-        v11 = rawval(ix + 1, iy + 1);
-      } else {
-        real v[stencilsize_];
-        int k = 0;
-        v[k++] = rawval(ix    , iy - 1);
-        v[k++] = rawval(ix + 1, iy - 1);
-        v[k++] = rawval(ix - 1, iy    );
-        v[k++] = rawval(ix    , iy    );
-        v[k++] = rawval(ix + 1, iy    );
-        v[k++] = rawval(ix + 2, iy    );
-        v[k++] = rawval(ix - 1, iy + 1);
-        v[k++] = rawval(ix    , iy + 1);
-        v[k++] = rawval(ix + 1, iy + 1);
-        v[k++] = rawval(ix + 2, iy + 1);
-        v[k++] = rawval(ix    , iy + 2);
-        v[k++] = rawval(ix + 1, iy + 2);
-
-        const int* c3x = iy == 0 ? c3n_ : (iy == _height - 2 ? c3s_ : c3_);
-        int c0x = iy == 0 ? c0n_ : (iy == _height - 2 ? c0s_ : c0_);
-        for (unsigned i = 0; i < nterms_; ++i) {
-          t[i] = 0;
-          for (unsigned j = 0; j < stencilsize_; ++j)
-            t[i] += v[j] * c3x[nterms_ * j + i];
-          t[i] /= c0x;
-        }
+  void Geoid::coeffs(int ix, int iy, real t[]) const {
+    if (!_cubic) {
+      t[0] = rawval(ix    , iy    );
+      t[1] = rawval(ix + 1, iy    );
+      t[2] = rawval(ix    , iy + 1);
+      t[3] = rawval(ix + 1, iy + 1);
+    } else {
+      real v[stencilsize_];
+      int k = 0;
+      v[k++] = rawval(ix    , iy - 1);
+      v[k++] = rawval(ix + 1, iy - 1);
+      v[k++] = rawval(ix - 1, iy    );
+      v[k++] = rawval(ix    , iy    );
+      v[k++] = rawval(ix + 1, iy    );
+      v[k++] = rawval(ix + 2, iy    );
+      v[k++] = rawval(ix - 1, iy + 1);
+      v[k++] = rawval(ix    , iy + 1);
+      v[k++] = rawval(ix + 1, iy + 1);
+      v[k++] = rawval(ix + 2, iy + 1);
+      v[k++] = rawval(ix    , iy + 2);
+      v[k++] = rawval(ix + 1, iy + 2);
+
+      const int* c3x = iy == 0 ? c3n_ : (iy == _height - 2 ? c3s_ : c3_);
+      int c0x = iy == 0 ? c0n_ : (iy == _height - 2 ? c0s_ : c0_);
+      for (unsigned i = 0; i < nterms_; ++i) {
+        t[i] = 0;
+        for (unsigned j = 0; j < stencilsize_; ++j)
+          t[i] += v[j] * c3x[nterms_ * j + i];
+        t[i] /= c0x;
       }
-    } else { // same cell; used cached coefficients
-      if (!_cubic) {
-        v00 = _v00;
-        v01 = _v01;
-        v10 = _v10;
-        v11 = _v11;
-      } else
-        copy(_t, _t + nterms_, t);
     }
+  }
+
+  Math::real Geoid::evaluate(const real t[], real fx, real fy) const {
     if (!_cubic) {
       real
-        a = (1 - fx) * v00 + fx * v01,
-        b = (1 - fx) * v10 + fx * v11,
-        c = (1 - fy) * a + fy * b,
-        h = _offset + _scale * c;
-      if (!_threadsafe) {
-        _ix = ix;
-        _iy = iy;
-        _v00 = v00;
-        _v01 = v01;
-        _v10 = v10;
-        _v11 = v11;
-      }
-      return h;
+        a = (1 - fx) * t[0] + fx * t[1],
+        b = (1 - fx) * t[2] + fx * t[3],
+        c = (1 - fy) * a + fy * b;
+      return _offset + _scale * c;
     } else {
       real h = t[0] + fx * (t[1] + fx * (t[3] + fx * t[6])) +
         fy * (t[2] + fx * (t[4] + fx * t[7]) +
              fy * (t[5] + fx * t[8] + fy * t[9]));
-      h = _offset + _scale * h;
-      if (!_threadsafe) {
-        _ix = ix;
-        _iy = iy;
-        copy(t, t + nterms_, _t);
+      return _offset + _scale * h;
+    }
+  }
+
+  Math::real Geoid::height(real lat, real lon) const {
+    int ix, iy;
+    real fx, fy;
+    if (!cell(lat, lon, ix, iy, fx, fy))
+      return Math::NaN();
+    if (_threadsafe) {
+      real t[nterms_];
+      coeffs(ix, iy, t);
+      return evaluate(t, fx, fy);
+    }
+    if (_cache && _cubic) {
+      const real* t = tablecoeffs(ix, iy);
+      if (t)
+        return evaluate(t, fx, fy);
+    }
+    return height(ix, iy, fx, fy, _ix, _iy, _t);
+  }
+
+  Math::real Geoid::height(int ix, int iy, real fx, real fy,
+                           int& cx, int& cy, real t[]) const {
+    if (!(ix == cx && iy == cy)) {
+      // Invalidate the cell cache first in case coeffs throws an exception
+      cx = _width;
+      coeffs(ix, iy, t);
+      cx = ix;
+      cy = iy;
+    } // else same cell; use cached coefficients
+    return evaluate(t, fx, fy);
+  }
+
+  Math::real Geoid::operator()(real lat, real lon, Context& ctx) const {
+    int ix, iy;
+    real fx, fy;
+    if (!cell(lat, lon, ix, iy, fx, fy))
+      return Math::NaN();
+    if (!_threadsafe && _cache && _cubic) {
+      const real* t = tablecoeffs(ix, iy);
+      if (t)
+        return evaluate(t, fx, fy);
+    }
+    if (ctx._geoid != this) {
+      ctx._geoid = this;
+      ctx._ix = _width;
+      ctx._iy = _height;
+    }
+    return height(ix, iy, fx, fy, ctx._ix, ctx._iy, ctx._t);
+  }
+
+  void Geoid::bilinear(size_t n, const real lat[], const real lon[],
+                       real h[]) const {
+    const int K = 8;
+    int ix[K], iy[K];
+    real fx[K] = {}, fy[K] = {}, v[4][K] = {};
+    bool ok[K];
+    for (size_t i0 = 0; i0 < n; i0 += K) {
+      const int k = int(min(size_t(K), n - i0));
+      for (int l = 0; l < k; ++l)
+        ok[l] = cell(lat[i0 + l], lon[i0 + l], ix[l], iy[l], fx[l], fy[l]);
+      // Gather the corners of the cells; iy + 1 < _height and ix + 1 may
+      // need to wrap.
+      for (int l = 0; l < k; ++l) {
+        if (!ok[l]) {
+          fx[l] = fy[l] = v[0][l] = v[1][l] = v[2][l] = v[3][l] = 0;
+          continue;
+        }
+        int x0 = ix[l], x1 = x0 + 1 == _width ? 0 : x0 + 1, y = iy[l];
+        if (_cache && !_compressed) {
+          int x = x0 >= _xoffset ? x0 - _xoffset : x0 + _width - _xoffset,
+            yc = y - _yoffset;
+          if (x + 1 < _xsize && yc >= 0 && yc + 1 < _ysize) {
+            const pixel_t* p = &_data[_data0 + size_t(yc) * _stride +
+                                      unsigned(x)];
+            v[0][l] = real(p[0]); v[1][l] = real(p[1]);
+            v[2][l] = real(p[_stride]); v[3][l] = real(p[_stride + 1]);
+            continue;
+          }
+        }
+        if (_mmap) {
+          v[0][l] = real(mappedval(x0, y    ));
+          v[1][l] = real(mappedval(x1, y    ));
+          v[2][l] = real(mappedval(x0, y + 1));
+          v[3][l] = real(mappedval(x1, y + 1));
+        } else {
+          v[0][l] = rawval(x0, y    );
+          v[1][l] = rawval(x1, y    );
+          v[2][l] = rawval(x0, y + 1);
+          v[3][l] = rawval(x1, y + 1);
+        }
       }
-      return h;
+      // As in evaluate
+      real c[K];
+      for (int l = 0; l < K; ++l) {
+        real
+          a = (1 - fx[l]) * v[0][l] + fx[l] * v[1][l],
+          b = (1 - fx[l]) * v[2][l] + fx[l] * v[3][l];
+        c[l] = _offset + _scale * ((1 - fy[l]) * a + fy[l] * b);
+      }
+      for (int l = 0; l < k; ++l)
+        h[i0 + l] = ok[l] ? c[l] : Math::NaN();
     }
   }
 
+  void Geoid::operator()(size_t n, const real lat[], const real lon[],
+                         real h[]) const {
+    if (!_cubic && (_mmap || (_cache && !_compressed))) {
+      bilinear(n, lat, lon, h);
+      return;
+    }
+    // Sort the points by grid cell in the order the cells are stored in the
+    // data file (ties are broken by the position in the input).
+    vector< pair<unsigned long long, size_t> > order;
+    order.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+      int ix, iy;
+      real fx, fy;
+      if (cell(lat[i], lon[i], ix, iy, fx, fy))
+        order.push_back(make_pair((unsigned long long)(iy) * _swidth +
+                                  (unsigned long long)(ix), i));
+      else
+        h[i] = Math::NaN();
+    }
+    sort(order.begin(), order.end());
+    real t[nterms_];
+    const real* tp = t;
+    unsigned long long key = numeric_limits<unsigned long long>::max();
+    for (const auto& p : order) {
+      int ix, iy;
+      real fx, fy;
+      cell(lat[p.second], lon[p.second], ix, iy, fx, fy);
+      if (p.first != key) {
+        tp = _cache && _cubic ? tablecoeffs(ix, iy) : nullptr;
+        if (!tp) {
+          coeffs(ix, iy, t);
+          tp = t;
+        }
+        key = p.first;
+      }
+      h[p.second] = evaluate(tp, fx, fy);
+    }
+  }
+
+  void Geoid::CellCoefficients(real south, real west,
+                               real north, real east,
+                               vector<float>& c, real& lat0, real& lon0,
+                               real& dlat, real& dlon, int& nlat, int& nlon)
+    const {
+    // The cells [iw, iw + nlon) x [in, is] which contain the area (these
+    // are determined as for the points in cell)
+    south = Math::LatFix(south);
+    north = Math::LatFix(north);
+    west = Math::AngNormalize(west); // west in [-180, 180)
+    east = Math::AngNormalize(east);
+    if (east <= west)
+      east += Math::td;         // east - west in (0, 360]
+    const int ny2 = (_height - 1)/2;
+    int iw = int(floor(west * _rlonres)),
+      in = min(ny2 - 1, int(floor(-north * _rlatres))) + ny2,
+      is = min(ny2 - 1, int(floor(-south * _rlatres))) + ny2;
+    nlon = min(_width, int(floor(east * _rlonres)) - iw + 1);
+    nlat = max(0, is - in + 1);
+    dlat = 1 / _rlatres;
+    dlon = 1 / _rlonres;
+    lat0 = Math::qd - in * dlat;
+    lon0 = iw * dlon;
+    c.assign(size_t(nlat) * unsigned(nlon) * nterms_, 0.0f);
+    real t[nterms_];
+    float* p = c.data();
+    for (int iy = in; iy <= is; ++iy)
+      for (int i = 0; i < nlon; ++i, p += nterms_) {
+        int ix = iw + i;
+        ix += ix < 0 ? _width : (ix >= _width ? -_width : 0);
+        coeffs(ix, iy, t);
+        // The polynomial for the height in meters (see evaluate)
+        p[0] = float(_offset + _scale * t[0]);
+        if (_cubic)
+          for (unsigned k = 1; k < nterms_; ++k)
+            p[k] = float(_scale * t[k]);
+        else {
+          // Write the bilinear interpolant as a polynomial in fx and fy
+          p[1] = float(_scale * (t[1] - t[0]));
+          p[2] = float(_scale * (t[2] - t[0]));
+          p[4] = float(_scale * ((t[3] - t[2]) - (t[1] - t[0])));
+        }
+      }
+  }
+
   void Geoid::CacheClear() const {
     if (!_threadsafe) {
       _cache = false;
       try {
         _data.clear();
         // Use swap to release memory back to system
-        vector< vector<pixel_t> >().swap(_data);
+        vector<pixel_t>().swap(_data);
+        vector<cachearea>().swap(_areas);
+        packedarea().swap(_packed);
+        vector<real>().swap(_table);
       }
       catch (const exception&) {
       }
     }
   }
 
-  void Geoid::CacheArea(real south, real west, real north, real east) const {
-    if (_threadsafe)
-      throw GeographicErr("Attempt to change cache of threadsafe Geoid");
-    if (south > north) {
-      CacheClear();
-      return;
-    }
+  bool Geoid::CacheInterleave() const {
+    if (!_cache) return false;
+    bool ok = true;
+    auto interleave = [&ok](const vector<pixel_t>& data,
+                            const vector<real>& table,
+                            const packedarea& packed) {
+      if (!data.empty())
+        ok = Utility::interleave(data.data(),
+                                 data.size() * sizeof(pixel_t)) && ok;
+      if (!table.empty())
+        ok = Utility::interleave(table.data(),
+                                 table.size() * sizeof(real)) && ok;
+      if (!packed.words.empty())
+        ok = Utility::interleave(packed.words.data(), packed.words.size() *
+                                 sizeof(unsigned long long)) && ok;
+    };
+    interleave(_data, _table, _packed);
+    for (const cachearea& a : _areas)
+      interleave(a.data, a.table, a.packed);
+    return ok;
+  }
+
+  void Geoid::area(real south, real west, real north, real east,
+                   int& iw, int& ie, int& in, int& is) const {
     south = Math::LatFix(south);
     north = Math::LatFix(north);
     west = Math::AngNormalize(west); // west in [-180, 180)
     east = Math::AngNormalize(east);
     if (east <= west)
       east += Math::td;         // east - west in (0, 360]
-    int
-      iw = int(floor(west * _rlonres)),
-      ie = int(floor(east * _rlonres)),
-      in = int(floor(-north * _rlatres)) + (_height - 1)/2,
-      is = int(floor(-south * _rlatres)) + (_height - 1)/2;
+    iw = int(floor(west * _rlonres));
+    ie = int(floor(east * _rlonres));
+    in = int(floor(-north * _rlatres)) + (_height - 1)/2;
+    is = int(floor(-south * _rlatres)) + (_height - 1)/2;
     in = max(0, min(_height - 2, in));
     is = max(0, min(_height - 2, is));
     is += 1;
@@ -441,24 +1205,87 @@ namespace GeographicLib {
       ie += iw < 0 ? _width : (iw >= _width ? -_width : 0);
       iw += iw < 0 ? _width : (iw >= _width ? -_width : 0);
     }
-    int oysize = int(_data.size());
+  }
+
+  void Geoid::packedarea::addrows(const vector< vector<pixel_t> >& rows,
+                                  int ny, int xsize) {
+    unsigned long long acc = 0;
+    unsigned nacc = 0;
+    for (int x0 = 0; x0 < xsize; x0 += 16) {
+      const int nx = min(16, xsize - x0);
+      unsigned lo = pixel_max_, hi = 0;
+      for (int y = 0; y < ny; ++y)
+        for (int x = x0; x < x0 + nx; ++x) {
+          lo = min(lo, unsigned(rows[y][x]));
+          hi = max(hi, unsigned(rows[y][x]));
+        }
+      block b;
+      b.word = unsigned(words.size());
+      b.min = pixel_t(lo);
+      b.bits = 0;
+      while (b.bits < 32 && ((hi - lo) >> b.bits) != 0) ++b.bits;
+      blocks.push_back(b);
+      if (b.bits == 0) continue;
+      // The pixels outside the area are padded with the minimum value.
+      for (int y = 0; y < 16; ++y)
+        for (int x = x0; x < x0 + 16; ++x) {
+          unsigned long long v = y < ny && x < x0 + nx ? rows[y][x] - lo : 0;
+          acc |= v << nacc;
+          nacc += b.bits;
+          if (nacc >= 64) {
+            words.push_back(acc);
+            nacc -= 64;
+            acc = nacc ? v >> (b.bits - nacc) : 0;
+          }
+        }
+      if (nacc) {
+        words.push_back(acc);
+        acc = 0; nacc = 0;
+      }
+    }
+  }
+
+  void Geoid::fillcache(int iw, int ie, int in, int is) const {
+    Tracer::Span span("Geoid::fillcache", _filename.c_str());
+    const size_t tablen = tablesize(ie - iw + 1, is - in + 1);
+    if ((_compress ? 0 : areabytes(ie - iw + 1, is - in + 1)) +
+        tablen * sizeof(real) > _cachebudget)
+      throw GeographicErr("Area exceeds the cache budget for " + _filename);
     _xsize = ie - iw + 1;
     _ysize = is - in + 1;
     _xoffset = iw;
     _yoffset = in;
+    _cache = false;
+    _compressed = _compress;
+    // With compression, the data is read 16 rows at a time into rows.
+    vector< vector<pixel_t> > rows;
 
     try {
-      _data.resize(_ysize, vector<pixel_t>(_xsize));
-      for (int iy = min(oysize, _ysize); iy--;)
-        _data[iy].resize(_xsize);
+      packedarea().swap(_packed);
+      vector<real>().swap(_table);
+      _table.resize(tablen);
+      if (_compressed) {
+        vector<pixel_t>().swap(_data);
+        rows.resize(16, vector<pixel_t>(_xsize));
+        _packed.nbx = (_xsize + 15) / 16;
+        _packed.blocks.reserve(size_t(_packed.nbx) * ((_ysize + 15) / 16));
+      } else {
+        // Allow for aligning row 0 to a cache line
+        _stride = rowstride(_xsize);
+        _data.resize(size_t(_ysize) * _stride + linepixels_);
+        _data0 = (linepixels_ -
+                  size_t(reinterpret_cast<uintptr_t>(_data.data()) % 64) /
+                  sizeof(pixel_t)) % linepixels_;
+      }
     }
     catch (const bad_alloc&) {
-      CacheClear();
       throw GeographicErr("Insufficient memory for caching " + _filename);
     }
 
     try {
       for (int iy = in; iy <= is; ++iy) {
+        pixel_t* row = _compressed ? &rows[(iy - in) & 15][0] :
+          &_data[_data0 + size_t(iy - in) * _stride];
         int iy1 = iy, iw1 = iw;
         if (iy < 0 || iy >= _height) {
           // Allow points "beyond" the poles to support interpolation
@@ -468,22 +1295,218 @@ namespace GeographicLib {
             iw1 -= _width;
         }
         int xs1 = min(_width - iw1, _xsize);
-        filepos(iw1, iy1);
-        Utility::readarray<pixel_t, pixel_t, true>
-          (_file, &(_data[iy - in][0]), xs1);
-        if (xs1 < _xsize) {
-          // Wrap around longitude = 0
-          filepos(0, iy1);
-          Utility::readarray<pixel_t, pixel_t, true>
-            (_file, &(_data[iy - in][xs1]), _xsize - xs1);
+        if (_mmap) {
+          for (int ix = 0; ix < _xsize; ++ix)
+            row[ix] = pixel_t(mappedval(ix < xs1 ? iw1 + ix : ix - xs1, iy1));
+        } else {
+          readrow(iw1, iy1, xs1, row);
+          if (xs1 < _xsize)
+            // Wrap around longitude = 0
+            readrow(0, iy1, _xsize - xs1, row + xs1);
         }
+        if (_compressed && ((iy - in) % 16 == 15 || iy == is))
+          _packed.addrows(rows, (iy - in) % 16 + 1, _xsize);
       }
-      _cache = true;
     }
     catch (const exception& e) {
-      CacheClear();
       throw GeographicErr(string("Error filling cache ") + e.what());
     }
+    if (_compressed) {
+      _packed.words.shrink_to_fit();
+      if (_packed.bytes() + tablen * sizeof(real) > _cachebudget)
+        throw GeographicErr("Area exceeds the cache budget for " + _filename);
+    }
+    _cache = true;
+    if (tablen) {
+      // The stencils of these cells lie within the area, so coeffs only
+      // uses the pixels just cached.
+      real* t = &_table[0];
+      for (int iy = in + 1; iy + 2 <= is; ++iy)
+        for (int x = 1; x + 2 < _xsize; ++x, t += nterms_)
+          coeffs(iw + x < _width ? iw + x : iw + x - _width, iy, t);
+    }
+  }
+
+  void Geoid::CacheArea(real south, real west, real north, real east) const {
+    if (_threadsafe)
+      throw GeographicErr("Attempt to change cache of threadsafe Geoid");
+    if (south > north) {
+      CacheClear();
+      return;
+    }
+    int iw, ie, in, is;
+    area(south, west, north, east, iw, ie, in, is);
+    try {
+      _areas.clear();
+      fillcache(iw, ie, in, is);
+    }
+    catch (const exception&) {
+      CacheClear();
+      throw;
+    }
+  }
+
+  void Geoid::CacheAddArea(real south, real west, real north, real east)
+    const {
+    if (_threadsafe)
+      throw GeographicErr("Attempt to change cache of threadsafe Geoid");
+    if (!_cache) {
+      CacheArea(south, west, north, east);
+      return;
+    }
+    if (south > north)
+      return;
+    int iw, ie, in, is;
+    area(south, west, north, east, iw, ie, in, is);
+    // The current area becomes the most recently used of the other areas and
+    // the new area is read into the current area.
+    _areas.insert(_areas.begin(), cachearea());
+    swaparea(_areas.front());
+    try {
+      fillcache(iw, ie, in, is);
+    }
+    catch (const exception&) {
+      // Restore the previous current area
+      swaparea(_areas.front());
+      _areas.erase(_areas.begin());
+      _cache = true;
+      throw;
+    }
+    trimcache();
+  }
+
+  bool Geoid::switcharea(int ix, int iy) const {
+    for (size_t k = 0; k < _areas.size(); ++k) {
+      cachearea& a = _areas[k];
+      if (inarea(a.xoffset, a.yoffset, a.xsize, a.ysize, ix, iy)) {
+        swaparea(a);
+        // The previous current area is now the most recently used of the
+        // others.
+        rotate(_areas.begin(), _areas.begin() + k, _areas.begin() + k + 1);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void Geoid::swaparea(cachearea& a) const {
+    swap(a.xoffset, _xoffset); swap(a.yoffset, _yoffset);
+    swap(a.xsize, _xsize); swap(a.ysize, _ysize);
+    a.data.swap(_data);
+    swap(a.stride, _stride); swap(a.data0, _data0);
+    swap(a.compressed, _compressed);
+    a.packed.swap(_packed);
+    a.table.swap(_table);
+  }
+
+  void Geoid::trimcache() const {
+    size_t bytes = CacheBytes();
+    while (!_areas.empty() && bytes > _cachebudget) {
+      bytes -= areabytes(_areas.back());
+      _areas.pop_back();
+    }
+  }
+
+  Geoid::Memory Geoid::MemoryUsage() const {
+    Memory m;
+    m.cache = CacheBytes();
+    m.cachebudget = _cachebudget;
+    if (_tiles) {
+      m.tiles = _tiles->Bytes();
+      m.tilebudget = _tiles->MaxBytes();
+    }
+    m.index = _tileindex.capacity() * sizeof(tileentry);
+    m.mapped = _mmapsize;
+    return m;
+  }
+
+  void Geoid::SetCacheBudget(size_t maxbytes) const {
+    _cachebudget = maxbytes;
+    if (_cache && areabytes() > _cachebudget)
+      CacheClear();
+    else
+      trimcache();
+  }
+
+  void Geoid::prefetchrow(int ix, int iy, int n) const {
+    if (_mmap) {
+      // Touch each page of the row
+      const unsigned char* p = _mmap + _datastart +
+        pixel_size_ * (unsigned(iy) * _swidth + unsigned(ix));
+      const size_t len = size_t(pixel_size_) * unsigned(n), pagesize = 4096;
+      unsigned char c = p[len - 1];
+      for (size_t k = 0; k < len; k += pagesize)
+        c ^= p[k];
+      volatile unsigned char sink = c;
+      (void)sink;
+    } else
+      _tiles->Load(ix, ix + n - 1, iy);
+  }
+
+  future<void> Geoid::Prefetch(real south, real west,
+                               real north, real east) const {
+    if (!(_mmap || _tiles))
+      throw GeographicErr("Prefetch needs a thread safe or memory mapped "
+                          "Geoid");
+    if (!(south <= north)) {
+      promise<void> done;
+      done.set_value();
+      return done.get_future();
+    }
+    int iw, ie, in, is;
+    area(south, west, north, east, iw, ie, in, is);
+    return async(launch::async, [this, iw, ie, in, is]() -> void {
+        for (int iy = in; iy <= is; ++iy) {
+          // The rows beyond the poles are mapped as in CacheArea
+          int iy1 = iy, iw1 = iw;
+          if (iy < 0 || iy >= _height) {
+            iy1 = iy1 < 0 ? -iy1 : 2 * (_height - 1) - iy1;
+            iw1 += _width/2;
+            if (iw1 >= _width)
+              iw1 -= _width;
+          }
+          int n = ie - iw + 1, n1 = min(n, _width - iw1);
+          prefetchrow(iw1, iy1, n1);
+          if (n1 < n)
+            // Wrap around longitude = 0
+            prefetchrow(0, iy1, n - n1);
+        }
+      });
+  }
+
+  future<void> Geoid::CacheAreaAsync(real south, real west,
+                                     real north, real east) const {
+    if (_threadsafe)
+      throw GeographicErr("Attempt to change cache of threadsafe Geoid");
+    return async(launch::async, [this, south, west, north, east]() -> void {
+        CacheArea(south, west, north, east);
+      });
+  }
+
+  future<Math::real> Geoid::HeightAsync(real lat, real lon) const {
+    if (!_threadsafe)
+      throw GeographicErr("HeightAsync needs a thread safe Geoid");
+    return async(launch::async, [this, lat, lon]() -> real {
+        Context ctx;
+        return (*this)(lat, lon, ctx);
+      });
+  }
+
+  future<vector<Math::real> >
+  Geoid::HeightAsync(vector<real> lat, vector<real> lon) const {
+    if (!_threadsafe)
+      throw GeographicErr("HeightAsync needs a thread safe Geoid");
+    if (lat.size() != lon.size())
+      throw GeographicErr("HeightAsync needs equal numbers of latitudes "
+                          "and longitudes");
+    // Move the points into the lambda (C++11 has no init-captures)
+    shared_ptr<pair<vector<real>, vector<real> > >
+      pts(new pair<vector<real>, vector<real> >(move(lat), move(lon)));
+    return async(launch::async, [this, pts]() -> vector<real> {
+        vector<real> h(pts->first.size());
+        (*this)(h.size(), pts->first.data(), pts->second.data(), h.data());
+        return h;
+      });
   }
 
   string Geoid::DefaultGeoidPath() {
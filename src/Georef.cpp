@@ -9,6 +9,7 @@
 
 #include <GeographicLib/Georef.hpp>
 #include <GeographicLib/Utility.hpp>
+#include <cstring>
 
 #if defined(_MSC_VER)
 // Squelch warnings about enum-float expressions
@@ -25,16 +26,35 @@ namespace GeographicLib {
   const char* const Georef::degrees_ = "ABCDEFGHJKLMNPQ";
 
   void Georef::Forward(real lat, real lon, int prec, string& georef) {
+    char georef1[MAXBUF];
+    Forward(lat, lon, prec, georef1);
+    georef = georef1;
+  }
+
+  void Georef::Forward(size_t n, const real lat[], const real lon[],
+                       int prec, char georef[], size_t width) {
+    int prec1 = max(-1, min(int(maxprec_), prec));
+    if (prec1 == 1) ++prec1;
+    if (!(width >= 8 && int(width) > baselen_ + 2 * prec1))
+      throw GeographicErr("Width " + Utility::str(width)
+                          + " too small for georef precision "
+                          + Utility::str(prec));
+    for (size_t i = 0; i < n; ++i)
+      Forward(lat[i], lon[i], prec, georef + i * width);
+  }
+
+  void Georef::Forward(real lat, real lon, int prec, char georef[]) {
     using std::isnan;           // Needed for Centos 7, ubuntu 14
     if (fabs(lat) > Math::qd)
       throw GeographicErr("Latitude " + Utility::str(lat)
                           + "d not in [-" + to_string(Math::qd)
                           + "d, " + to_string(Math::qd) + "d]");
     if (isnan(lat) || isnan(lon)) {
-      georef = "INVALID";
+      copy_n("INVALID", 8, georef);
       return;
     }
-    lon = Math::AngNormalize(lon); // lon in [-180,180)
+    lon = Math::AngNormalize(lon);
+    if (lon == Math::hd) lon = -Math::hd; // lon now in [-180,180)
     if (lat == Math::qd) lat *= (1 - numeric_limits<real>::epsilon() / 2);
     prec = max(-1, min(int(maxprec_), prec));
     if (prec == 1) ++prec;      // Disallow prec = 1
@@ -47,29 +67,49 @@ namespace GeographicLib {
       x = (long long)(floor(lon * real(m))) - lonorig_ * m,
       y = (long long)(floor(lat * real(m))) - latorig_ * m;
     int ilon = int(x / m); int ilat = int(y / m);
-    char georef1[maxlen_];
-    georef1[0] = lontile_[ilon / tile_];
-    georef1[1] = lattile_[ilat / tile_];
+    georef[0] = lontile_[ilon / tile_];
+    georef[1] = lattile_[ilat / tile_];
     if (prec >= 0) {
-      georef1[2] = degrees_[ilon % tile_];
-      georef1[3] = degrees_[ilat % tile_];
+      georef[2] = degrees_[ilon % tile_];
+      georef[3] = degrees_[ilat % tile_];
       if (prec > 0) {
         x -= m * ilon; y -= m * ilat;
-        long long d = (long long)pow(real(base_), maxprec_ - prec);
+        long long d = 1;
+        for (int c = prec; c < maxprec_; ++c) d *= base_;
         x /= d; y /= d;
         for (int c = prec; c--;) {
-          georef1[baselen_ + c       ] = digits_[x % base_]; x /= base_;
-          georef1[baselen_ + c + prec] = digits_[y % base_]; y /= base_;
+          georef[baselen_ + c       ] = digits_[x % base_]; x /= base_;
+          georef[baselen_ + c + prec] = digits_[y % base_]; y /= base_;
         }
       }
     }
-    georef.resize(baselen_ + 2 * prec);
-    copy(georef1, georef1 + baselen_ + 2 * prec, georef.begin());
+    georef[baselen_ + 2 * prec] = '\0';
   }
 
   void Georef::Reverse(const string& georef, real& lat, real& lon,
                        int& prec, bool centerp) {
-    int len = int(georef.length());
+    GenReverse(georef.data(), int(georef.length()), lat, lon, prec, centerp);
+  }
+
+  void Georef::Reverse(const char* georef, real& lat, real& lon,
+                       int& prec, bool centerp) {
+    GenReverse(georef, int(strlen(georef)), lat, lon, prec, centerp);
+  }
+
+  void Georef::Reverse(size_t n, const char georef[], size_t width,
+                       real lat[], real lon[], int prec[], bool centerp) {
+    for (size_t i = 0; i < n; ++i) {
+      const char* g = georef + i * width;
+      int len = 0, prec1;
+      while (len < int(width) && g[len]) ++len;
+      GenReverse(g, len, lat[i], lon[i], prec ? prec[i] : prec1, centerp);
+    }
+  }
+
+  void Georef::GenReverse(const char* georef, int len, real& lat, real& lon,
+                          int& prec, bool centerp) {
+    // Only construct a string when reporting an error
+    auto str = [georef, len] () -> string { return string(georef, len); };
     if (len >= 3 &&
         toupper(georef[0]) == 'I' &&
         toupper(georef[1]) == 'N' &&
@@ -79,45 +119,48 @@ namespace GeographicLib {
     }
     if (len < baselen_ - 2)
       throw GeographicErr("Georef must start with at least 2 letters "
-                          + georef);
+                          + str());
     int prec1 = (2 + len - baselen_) / 2 - 1;
     int k;
     k = Utility::lookup(lontile_, georef[0]);
     if (k < 0)
-      throw GeographicErr("Bad longitude tile letter in georef " + georef);
+      throw GeographicErr("Bad longitude tile letter in georef " + str());
     real lon1 = k + lonorig_ / tile_;
     k = Utility::lookup(lattile_, georef[1]);
     if (k < 0)
-      throw GeographicErr("Bad latitude tile letter in georef " + georef);
+      throw GeographicErr("Bad latitude tile letter in georef " + str());
     real lat1 = k + latorig_ / tile_;
     real unit = 1;
     if (len > 2) {
       unit *= tile_;
       k = Utility::lookup(degrees_, georef[2]);
       if (k < 0)
-        throw GeographicErr("Bad longitude degree letter in georef " + georef);
+        throw GeographicErr("Bad longitude degree letter in georef " + str());
       lon1 = lon1 * tile_ + k;
       if (len < 4)
         throw GeographicErr("Missing latitude degree letter in georef "
-                            + georef);
+                            + str());
       k = Utility::lookup(degrees_, georef[3]);
       if (k < 0)
-        throw GeographicErr("Bad latitude degree letter in georef " + georef);
+        throw GeographicErr("Bad latitude degree letter in georef " + str());
       lat1 = lat1 * tile_ + k;
       if (prec1 > 0) {
-        if (georef.find_first_not_of(digits_, baselen_) != string::npos)
+        bool digitsp = true;
+        for (int i = baselen_; i < len; ++i)
+          digitsp = digitsp && georef[i] >= '0' && georef[i] <= '9';
+        if (!digitsp)
           throw GeographicErr("Non digits in trailing portion of georef "
-                              + georef.substr(baselen_));
+                              + str().substr(baselen_));
         if (len % 2)
           throw GeographicErr("Georef must end with an even number of digits "
-                              + georef.substr(baselen_));
+                              + str().substr(baselen_));
         if (prec1 == 1)
           throw GeographicErr("Georef needs at least 4 digits for minutes "
-                              + georef.substr(baselen_));
+                              + str().substr(baselen_));
         if (prec1 > maxprec_)
           throw GeographicErr("More than " + Utility::str(2*maxprec_)
                               + " digits in georef "
-                              + georef.substr(baselen_));
+                              + str().substr(baselen_));
         for (int i = 0; i < prec1; ++i) {
           int m = i ? base_ : 6;
           unit *= m;
@@ -126,7 +169,7 @@ namespace GeographicLib {
             y = Utility::lookup(digits_, georef[baselen_ + i + prec1]);
           if (!(i || (x < m && y < m)))
             throw GeographicErr("Minutes terms in georef must be less than 60 "
-                                + georef.substr(baselen_));
+                                + str().substr(baselen_));
           lon1 = m * lon1 + x;
           lat1 = m * lat1 + y;
         }
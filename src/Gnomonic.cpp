@@ -8,6 +8,7 @@
  **********************************************************************/
 
 #include <GeographicLib/Gnomonic.hpp>
+#include <GeographicLib/GeodesicOrigin.hpp>
 
 #if defined(_MSC_VER)
 // Squelch warnings about potentially uninitialized local variables and
@@ -46,18 +47,17 @@ namespace GeographicLib {
 
   void Gnomonic::Reverse(real lat0, real lon0, real x, real y,
                          real& lat, real& lon, real& azi, real& rk) const {
-    real
-      azi0 = Math::atan2d(x, y),
-      rho = hypot(x, y),
-      s = _a * atan(rho/_a);
+    real azi0 = Math::atan2d(x, y);
+    GenReverse(_earth.Line(lat0, lon0, azi0, caps_), hypot(x, y),
+               lat, lon, azi, rk);
+  }
+
+  void Gnomonic::GenReverse(const GeodesicLine& line, real rho,
+                            real& lat, real& lon, real& azi, real& rk) const {
+    real s = _a * atan(rho/_a);
     bool little = rho <= _a;
     if (!little)
       rho = 1/rho;
-    GeodesicLine line(_earth.Line(lat0, lon0, azi0,
-                                  Geodesic::LATITUDE | Geodesic::LONGITUDE |
-                                  Geodesic::AZIMUTH | Geodesic::DISTANCE_IN |
-                                  Geodesic::REDUCEDLENGTH |
-                                  Geodesic::GEODESICSCALE));
     int count = numit_, trip = 0;
     real lat1, lon1, azi1, M;
     while (count-- || GEOGRAPHICLIB_PANIC) {
@@ -80,4 +80,45 @@ namespace GeographicLib {
     return;
   }
 
+  void Gnomonic::Forward(real lat0, real lon0, size_t n,
+                         const real lat[], const real lon[],
+                         real x[], real y[], real azi[], real rk[]) const {
+    // The quantities depending on the center are computed once.
+    const GeodesicOrigin orig = _earth.InverseFrom(lat0, lon0);
+    for (size_t i = 0; i < n; ++i) {
+      real azi0, azi2, m, M, t;
+      orig.GenInverse(lat[i], lon[i],
+                      Geodesic::AZIMUTH | Geodesic::REDUCEDLENGTH |
+                      Geodesic::GEODESICSCALE,
+                      t, azi0, azi2, m, M, t, t);
+      if (M <= 0)
+        x[i] = y[i] = Math::NaN();
+      else {
+        real rho = m/M;
+        Math::sincosd(azi0, x[i], y[i]);
+        x[i] *= rho; y[i] *= rho;
+      }
+      if (azi) azi[i] = azi2;
+      if (rk) rk[i] = M;
+    }
+  }
+
+  void Gnomonic::Reverse(real lat0, real lon0, size_t n,
+                         const real x[], const real y[],
+                         real lat[], real lon[], real azi[], real rk[]) const {
+    GeodesicLine line;
+    real azi0l = Math::NaN(), azi2, rk2;
+    for (size_t i = 0; i < n; ++i) {
+      real azi0 = Math::atan2d(x[i], y[i]);
+      // Reuse the geodesic line while the azimuth is unchanged
+      if (!(azi0 == azi0l && signbit(azi0) == signbit(azi0l))) {
+        line = _earth.Line(lat0, lon0, azi0, caps_);
+        azi0l = azi0;
+      }
+      GenReverse(line, hypot(x[i], y[i]), lat[i], lon[i], azi2, rk2);
+      if (azi) azi[i] = azi2;
+      if (rk) rk[i] = rk2;
+    }
+  }
+
 } // namespace GeographicLib
@@ -99,6 +99,56 @@ namespace GeographicLib {
     eta = -(deltax/_gamma) / Math::degree();
   }
 
+  void GravityCircle::GeoidHeight(real lon0, real dlon, int n, real N[])
+    const {
+    if ((_caps & GEOID_HEIGHT) != GEOID_HEIGHT) {
+      for (int i = 0; i < n; ++i)
+        N[i] = Math::NaN();
+      return;
+    }
+    vector<real> correction(n);
+    _disturbing.Values(lon0, dlon, n, N);
+    _correction.Values(lon0, dlon, n, correction.data());
+    for (int i = 0; i < n; ++i) {
+      // Same as InternalT with gradp = correct = false
+      real T = N[i] / _amodel * _gGMmodel;
+      N[i] = T/_gamma0 + _corrmult * correction[i];
+    }
+  }
+
+  void GravityCircle::SphericalAnomaly(real lon0, real dlon, int n,
+                                       real Dg01[], real xi[], real eta[])
+    const {
+    if ((_caps & SPHERICAL_ANOMALY) != SPHERICAL_ANOMALY) {
+      for (int i = 0; i < n; ++i) {
+        Dg01[i] = Math::NaN();
+        if (xi) xi[i] = Math::NaN();
+        if (eta) eta[i] = Math::NaN();
+      }
+      return;
+    }
+    vector<real> grad(3 * size_t(n));
+    real *dX = grad.data(), *dY = dX + n, *dZ = dY + n;
+    _disturbing.Values(lon0, dlon, n, Dg01, dX, dY, dZ);
+    real f = _gGMmodel / _amodel;
+    for (int i = 0; i < n; ++i) {
+      // Same as InternalT with gradp = true and correct = false followed by
+      // the steps in SphericalAnomaly(lon, ...)
+      real slam, clam;
+      Math::sincosd(lon0 + i * dlon, slam, clam);
+      real
+        T = Dg01[i] / _amodel * _gGMmodel,
+        deltax = dX[i] * f, deltay = dY[i] * f, deltaz = dZ[i] * f,
+        MC[Geocentric::dim2_];
+      Geocentric::Rotation(_spsi, _cpsi, slam, clam, MC);
+      Geocentric::Unrotate(MC, deltax, deltay, deltaz,
+                           deltax, deltay, deltaz);
+      Dg01[i] = - deltaz - 2 * T * _invR;
+      if (xi) xi[i] = -(deltay/_gamma) / Math::degree();
+      if (eta) eta[i] = -(deltax/_gamma) / Math::degree();
+    }
+  }
+
   Math::real GravityCircle::W(real slam, real clam,
                               real& gX, real& gY, real& gZ) const {
     real Wres = V(slam, clam, gX, gY, gZ) + _frot * _pPx / 2;
@@ -10,9 +10,12 @@
 #include <GeographicLib/GravityModel.hpp>
 #include <fstream>
 #include <limits>
+#include <atomic>
 #include <GeographicLib/SphericalEngine.hpp>
 #include <GeographicLib/GravityCircle.hpp>
 #include <GeographicLib/Utility.hpp>
+#include <GeographicLib/Executor.hpp>
+#include <GeographicLib/Tracer.hpp>
 
 #if !defined(GEOGRAPHICLIB_DATA)
 #  if defined(_WIN32)
@@ -26,6 +29,23 @@
 #  define GEOGRAPHICLIB_GRAVITY_DEFAULT_NAME "egm96"
 #endif
 
+#if !defined(GEOGRAPHICLIB_GRAVITY_MMAP)
+#  if defined(__unix__) || defined(__APPLE__)
+#    define GEOGRAPHICLIB_GRAVITY_MMAP 1
+#  else
+#    define GEOGRAPHICLIB_GRAVITY_MMAP 0
+#  endif
+#endif
+
+#if GEOGRAPHICLIB_GRAVITY_MMAP
+#  include <cstring>
+#  include <type_traits>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
 #if defined(_MSC_VER)
 // Squelch warnings about unsafe use of getenv
 #  pragma warning (disable: 4996)
@@ -36,7 +56,7 @@ namespace GeographicLib {
   using namespace std;
 
   GravityModel::GravityModel(const std::string& name, const std::string& path,
-                             int Nmax, int Mmax)
+                             int Nmax, int Mmax, bool single)
     : _name(name)
     , _dir(path)
     , _description("NONE")
@@ -48,7 +68,10 @@ namespace GeographicLib {
     , _nmx(-1)
     , _mmx(-1)
     , _norm(SphericalHarmonic::FULL)
+    , _mmap(nullptr)
+    , _mmapsize(0)
   {
+    Tracer::Span span("GravityModel::GravityModel", _name.c_str());
     if (_dir.empty())
       _dir = DefaultGravityPath();
     bool truncate = Nmax >= 0 || Mmax >= 0;
@@ -58,8 +81,10 @@ namespace GeographicLib {
       if (Mmax < 0) Mmax = numeric_limits<int>::max();
     }
     ReadMetadata(_name);
-    {
-      string coeff = _filename + ".cof";
+    SphericalEngine::coeff cgrav, ccorr;
+    string coeff = _filename + ".cof";
+    if (single ||
+        !MapCoefficients(coeff, truncate, Nmax, Mmax, cgrav, ccorr)) {
       ifstream coeffstr(coeff.c_str(), ios::binary);
       if (!coeffstr.good())
         throw GeographicErr("Error opening " + coeff);
@@ -70,28 +95,90 @@ namespace GeographicLib {
       id[idlength_] = '\0';
       if (_id != string(id))
         throw GeographicErr("ID mismatch: " + _id + " vs " + id);
-      int N, M;
-      if (truncate) { N = Nmax; M = Mmax; }
-      SphericalEngine::coeff::readcoeffs(coeffstr, N, M, _cCx, _sSx, truncate);
-      if (!(N >= 0 && M >= 0))
-        throw GeographicErr("Degree and order must be at least 0");
-      if (_cCx[0] != 0)
-        throw GeographicErr("The degree 0 term should be zero");
-      _cCx[0] = 1;              // Include the 1/r term in the sum
-      _gravitational = SphericalHarmonic(_cCx, _sSx, N, N, M, _amodel, _norm);
-      if (truncate) { N = Nmax; M = Mmax; }
-      SphericalEngine::coeff::readcoeffs(coeffstr, N, M, _cCC, _cCS, truncate);
-      if (N < 0) {
-        N = M = 0;
-        _cCC.resize(1, real(0));
-      }
-      _cCC[0] += _zeta0 / _corrmult;
-      _correction = SphericalHarmonic(_cCC, _cCS, N, N, M, real(1), _norm);
+      if (single)
+        ReadCoefficients(coeffstr, truncate, Nmax, Mmax,
+                         _cCxf, _sSxf, _cCCf, _cCSf, cgrav, ccorr);
+      else
+        ReadCoefficients(coeffstr, truncate, Nmax, Mmax,
+                         _cCx, _sSx, _cCC, _cCS, cgrav, ccorr);
       int pos = int(coeffstr.tellg());
       coeffstr.seekg(0, ios::end);
       if (pos != coeffstr.tellg())
         throw GeographicErr("Extra data in " + coeff);
     }
+    Init(cgrav, ccorr);
+  }
+
+  template<typename CoeffT>
+  void GravityModel::ReadCoefficients(istream& coeffstr, bool truncate,
+                                      int Nmax, int Mmax,
+                                      vector<CoeffT>& C, vector<CoeffT>& S,
+                                      vector<CoeffT>& CC, vector<CoeffT>& CS,
+                                      SphericalEngine::coeff& cgrav,
+                                      SphericalEngine::coeff& ccorr) {
+    int N, M;
+    if (truncate) { N = Nmax; M = Mmax; }
+    SphericalEngine::coeff::readcoeffs(coeffstr, N, M, C, S, truncate);
+    if (!(N >= 0 && M >= 0))
+      throw GeographicErr("Degree and order must be at least 0");
+    if (C[0] != 0)
+      throw GeographicErr("The degree 0 term should be zero");
+    C[0] = 1;                   // Include the 1/r term in the sum
+    cgrav = SphericalEngine::coeff(C, S, N, N, M);
+    if (truncate) { N = Nmax; M = Mmax; }
+    SphericalEngine::coeff::readcoeffs(coeffstr, N, M, CC, CS, truncate);
+    if (N < 0) {
+      N = M = 0;
+      CC.resize(1, CoeffT(0));
+    }
+    CC[0] += CoeffT(_zeta0 / _corrmult);
+    ccorr = SphericalEngine::coeff(CC, CS, N, N, M);
+  }
+
+  future< unique_ptr<GravityModel> >
+  GravityModel::Load(const string& name, const string& path,
+                     int Nmax, int Mmax, bool single) {
+    const int ndigits = Math::digits();
+    return async(launch::async, [name, path, Nmax, Mmax, single, ndigits]()
+                 -> unique_ptr<GravityModel> {
+                   Math::set_digits(ndigits);
+                   return unique_ptr<GravityModel>
+                     (new GravityModel(name, path, Nmax, Mmax, single));
+                 });
+  }
+
+  GravityModel::GravityModel(const GravityModel& model, int Nmax, int Mmax)
+    : _name(model._name)
+    , _dir(model._dir)
+    , _description(model._description)
+    , _date(model._date)
+    , _filename(model._filename)
+    , _id(model._id)
+    , _amodel(model._amodel)
+    , _gGMmodel(model._gGMmodel)
+    , _zeta0(model._zeta0)
+    , _corrmult(model._corrmult)
+    , _nmx(-1)
+    , _mmx(-1)
+    , _norm(model._norm)
+    , _mmap(nullptr)            // the view doesn't own the mapping
+    , _mmapsize(0)
+    , _earth(model._earth)
+  {
+    if (Nmax >= 0 && Mmax < 0) Mmax = Nmax;
+    if (Nmax < 0) Nmax = numeric_limits<int>::max();
+    if (Mmax < 0) Mmax = numeric_limits<int>::max();
+    if (!(Nmax >= Mmax && Mmax >= 0))
+      throw GeographicErr("Bad requested degree and order " +
+                          Utility::str(Nmax) + " " + Utility::str(Mmax));
+    Init(model._gravitational.Coefficients().Truncate(Nmax, Mmax),
+         model._correction.Coefficients().Truncate(Nmax, Mmax));
+  }
+
+  void GravityModel::Init(const SphericalEngine::coeff& cgrav,
+                          const SphericalEngine::coeff& ccorr) {
+    _gravitational = SphericalHarmonic(cgrav, _amodel, _norm);
+    _correction = SphericalHarmonic(ccorr, real(1), _norm);
     int nmx = _gravitational.Coefficients().nmx();
     _nmx = max(nmx, _correction.Coefficients().nmx());
     _mmx = max(_gravitational.Coefficients().mmx(),
@@ -112,7 +199,7 @@ namespace GeographicLib {
       // goes out to n = 18.
       mult *= amult;
       real
-        r = _cCx[n],                                       // the model term
+        r = cgrav.Cv(n),                                   // the model term
         s = - mult * _earth.Jn(n) / sqrt(real(2 * n + 1)), // the normal term
         t = r - s;                                         // the difference
       if (t == r)               // the normal term is negligible
@@ -121,19 +208,154 @@ namespace GeographicLib {
       _zonal.push_back(s);
     }
     int nmx1 = int(_zonal.size()) - 1;
-    _disturbing = SphericalHarmonic1(_cCx, _sSx,
-                                     _gravitational.Coefficients().N(),
-                                     nmx, _gravitational.Coefficients().mmx(),
-                                     _zonal,
-                                     _zonal, // This is not accessed!
-                                     nmx1, nmx1, 0,
+    // If the model is held as floats, hold _zonal as floats too so that the
+    // sums for the disturbing potential can use a single storage type.
+    _zonalf.clear();
+    if (cgrav.Single())
+      _zonalf.assign(_zonal.begin(), _zonal.end());
+    _disturbing = SphericalHarmonic1(cgrav,
+                                     cgrav.Single() ?
+                                     SphericalEngine::coeff
+                                     (_zonalf,
+                                      _zonalf, // This is not accessed!
+                                      nmx1, nmx1, 0) :
+                                     SphericalEngine::coeff
+                                     (_zonal,
+                                      _zonal, // This is not accessed!
+                                      nmx1, nmx1, 0),
                                      _amodel,
                                      SphericalHarmonic1::normalization(_norm));
   }
 
+  GravityModel::~GravityModel() {
+#if GEOGRAPHICLIB_GRAVITY_MMAP
+    if (_mmap)
+      munmap(_mmap, _mmapsize);
+#endif
+  }
+
+  bool GravityModel::MapCoefficients(const string& coeff, bool truncate,
+                                     int Nmax, int Mmax,
+                                     SphericalEngine::coeff& cgrav,
+                                     SphericalEngine::coeff& ccorr) {
+#if GEOGRAPHICLIB_GRAVITY_MMAP
+    // The coefficients can only be used in place if they are stored in the
+    // native representation of real.
+    if (!(is_same<real, double>::value && !Math::bigendian))
+      return false;
+    if (truncate && !((Nmax >= Mmax && Mmax >= 0) ||
+                      (Nmax == -1 && Mmax == -1)))
+      throw GeographicErr("Bad requested degree and order " +
+                          Utility::str(Nmax) + " " + Utility::str(Mmax));
+    int fd = open(coeff.c_str(), O_RDONLY);
+    if (fd < 0)
+      return false;
+    struct stat st;
+    void* p = MAP_FAILED;
+    // Map the file privately and writable so that the adjustments to the
+    // (0,0) coefficients below only copy the page they are on.
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+      p = mmap(nullptr, size_t(st.st_size), PROT_READ | PROT_WRITE,
+               MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED)
+      return false;
+    _mmap = p;
+    _mmapsize = size_t(st.st_size);
+    try {
+      char* data = static_cast<char*>(_mmap);
+      size_t pos = idlength_;
+      if (_mmapsize < pos)
+        throw GeographicErr("No header in " + coeff);
+      string id(data, idlength_);
+      if (_id != id)
+        throw GeographicErr("ID mismatch: " + _id + " vs " + id);
+      real* cC[2]; const real* sS[2];
+      int L[2], N[2], M[2];
+      for (int k = 0; k < 2; ++k) {
+        int nm[2];
+        if (_mmapsize < pos + sizeof(nm))
+          throw GeographicErr("Error reading " + coeff);
+        memcpy(nm, data + pos, sizeof(nm));
+        pos += sizeof(nm);
+        int N0 = nm[0], M0 = nm[1];
+        if (!((N0 >= M0 && M0 >= 0) || (N0 == -1 && M0 == -1)))
+          // The last condition is that M0 = -1 implies N0 = -1.
+          throw GeographicErr("Bad degree and order " +
+                              Utility::str(N0) + " " + Utility::str(M0));
+        size_t
+          nC = size_t(SphericalEngine::coeff::Csize(N0, M0)),
+          nS = size_t(SphericalEngine::coeff::Ssize(N0, M0));
+        if (_mmapsize < pos + (nC + nS) * sizeof(double))
+          throw GeographicErr("Error reading " + coeff);
+        // pos is a multiple of 8, so the coefficients are aligned.
+        cC[k] = reinterpret_cast<real*>(data + pos);
+        pos += nC * sizeof(double);
+        sS[k] = reinterpret_cast<const real*>(data + pos);
+        pos += nS * sizeof(double);
+        // Truncation is achieved by limiting the degree and order of the sums
+        // while retaining the storage layout of the file.
+        L[k] = N0;
+        N[k] = truncate ? min(Nmax, N0) : N0;
+        M[k] = truncate ? min(Mmax, M0) : M0;
+      }
+      if (pos != _mmapsize)
+        throw GeographicErr("Extra data in " + coeff);
+      if (!(N[0] >= 0 && M[0] >= 0))
+        throw GeographicErr("Degree and order must be at least 0");
+      if (cC[0][0] != 0)
+        throw GeographicErr("The degree 0 term should be zero");
+      cC[0][0] = 1;             // Include the 1/r term in the sum
+      cgrav = SphericalEngine::coeff(cC[0], sS[0], L[0], N[0], M[0]);
+      if (N[1] < 0) {
+        _cCC.resize(1, real(0));
+        _cCC[0] += _zeta0 / _corrmult;
+        ccorr = SphericalEngine::coeff(_cCC, _cCS, 0, 0, 0);
+      } else {
+        cC[1][0] += _zeta0 / _corrmult;
+        ccorr = SphericalEngine::coeff(cC[1], sS[1], L[1], N[1], M[1]);
+      }
+    }
+    catch (...) {
+      munmap(_mmap, _mmapsize);
+      _mmap = nullptr;
+      _mmapsize = 0;
+      throw;
+    }
+    return true;
+#else
+    (void)coeff; (void)truncate; (void)Nmax; (void)Mmax;
+    (void)cgrav; (void)ccorr;
+    return false;
+#endif
+  }
+
+  GravityModel::Memory GravityModel::MemoryUsage() const {
+    Memory m;
+    for (const vector<real>* v : {&_cCx, &_sSx, &_cCC, &_cCS, &_zonal})
+      m.coefficients += v->capacity() * sizeof(real);
+    for (const vector<float>* v : {&_cCxf, &_sSxf, &_cCCf, &_cCSf, &_zonalf})
+      m.coefficients += v->capacity() * sizeof(float);
+    m.mapped = _mmapsize;
+    return m;
+  }
+
+  bool GravityModel::Interleave() const {
+    if (_mmap) return false;
+    bool ok = true;
+    for (const vector<real>* v : {&_cCx, &_sSx, &_cCC, &_cCS, &_zonal})
+      if (!v->empty())
+        ok = Utility::interleave(v->data(), v->size() * sizeof(real)) && ok;
+    for (const vector<float>* v : {&_cCxf, &_sSxf, &_cCCf, &_cCSf, &_zonalf})
+      if (!v->empty())
+        ok = Utility::interleave(v->data(), v->size() * sizeof(float)) && ok;
+    return ok;
+  }
+
   void GravityModel::ReadMetadata(const string& name) {
     const char* spaces = " \t\n\v\f\r";
     _filename = _dir + "/" + name + ".egm";
+    Tracer::Span span("GravityModel::ReadMetadata", _filename.c_str());
     ifstream metastr(_filename.c_str());
     if (!metastr.good())
       throw GeographicErr("Cannot open " + _filename);
@@ -229,10 +451,10 @@ namespace GeographicLib {
       deltaY *= f;
       deltaZ *= f;
       if (correct) {
-        invR = _gGMmodel * _dzonal0 * invR * invR * invR;
-        deltaX += X * invR;
-        deltaY += Y * invR;
-        deltaZ += Z * invR;
+        real c = _gGMmodel * _dzonal0 * invR * invR * invR;
+        deltaX += X * c;
+        deltaY += Y * c;
+        deltaZ += Z * c;
       }
     } else
       T = _disturbing(-1, X, Y, Z);
@@ -287,6 +509,80 @@ namespace GeographicLib {
     eta = -(deltax/gamma) / Math::degree();
   }
 
+  void GravityModel::Evaluate(real lat, real lon, real h, unsigned caps,
+                              real& W, real& gx, real& gy, real& gz,
+                              real& T, real& deltax, real& deltay,
+                              real& deltaz, real& Dg01, real& xi, real& eta,
+                              real& N) const {
+    W = gx = gy = gz = T = deltax = deltay = deltaz = Dg01 = xi = eta = N =
+      Math::NaN();
+    if (h != 0)
+      // Disallow the geoid height unless h is zero.
+      caps &= ~(CAP_GAMMA0 | CAP_C);
+    real X, Y, Z, M[Geocentric::dim2_];
+    _earth.Earth().IntForward(lat, lon, h, X, Y, Z, M);
+    if ((caps & CAP_ALL) == CAP_G) {
+      W = this->W(X, Y, Z, gx, gy, gz);
+      Geocentric::Unrotate(M, gx, gy, gz, gx, gy, gz);
+      return;
+    }
+    if (!(caps & (CAP_ALL & ~CAP_G)))
+      return;
+    bool gradp = (caps & (CAP_G | (CAP_DELTA & ~CAP_T))) != 0;
+    // One evaluation of the sum; T0 and dX0, ... are the disturbing
+    // potential and its gradient without the n = 0 correction (as needed for
+    // the spherical anomaly and the geoid height), T1 and dX1, ... include the
+    // correction (as needed for the disturbance and for W).
+    real dX0 = 0, dY0 = 0, dZ0 = 0,
+      T0 = gradp ? _disturbing(-1, X, Y, Z, dX0, dY0, dZ0) :
+      _disturbing(-1, X, Y, Z),
+      f = _gGMmodel / _amodel,
+      P = hypot(X, Y),
+      R = hypot(P, Z),
+      invR = 1 / R;
+    T0 *= f; dX0 *= f; dY0 *= f; dZ0 *= f;
+    real T1 = T0, dX1 = dX0, dY1 = dY0, dZ1 = dZ0;
+    if (_dzonal0 != 0) {
+      T1 -= _gGMmodel * _dzonal0 * invR;
+      if (gradp) {
+        real c = _gGMmodel * _dzonal0 * invR * invR * invR;
+        dX1 += X * c; dY1 += Y * c; dZ1 += Z * c;
+      }
+    }
+    if (caps & CAP_T)
+      T = T1;
+    if ((caps & CAP_DELTA) == CAP_DELTA)
+      Geocentric::Unrotate(M, dX1, dY1, dZ1, deltax, deltay, deltaz);
+    real gammaX = 0, gammaY = 0, gammaZ = 0;
+    if (caps & (CAP_G | CAP_GAMMA)) {
+      // W = T + U and g = delta + gamma
+      real Ures = _earth.U(X, Y, Z, gammaX, gammaY, gammaZ);
+      if (caps & CAP_G) {
+        W = T1 + Ures;
+        Geocentric::Unrotate(M, dX1 + gammaX, dY1 + gammaY, dZ1 + gammaZ,
+                             gx, gy, gz);
+      }
+    }
+    if ((caps & SPHERICAL_ANOMALY) == SPHERICAL_ANOMALY) {
+      // As in SphericalAnomaly
+      real
+        clam = M[3], slam = -M[0],
+        ctheta = R != 0 ? P / R : M[7],
+        stheta = R != 0 ? Z / R : M[8],
+        MC[Geocentric::dim2_], dx, dy, dz;
+      Geocentric::Rotation(stheta, ctheta, slam, clam, MC);
+      Geocentric::Unrotate(MC, dX0, dY0, dZ0, dx, dy, dz);
+      Dg01 = - dz - 2 * T0 / R;
+      real gamma = hypot( hypot(gammaX, gammaY), gammaZ);
+      xi  = -(dy/gamma) / Math::degree();
+      eta = -(dx/gamma) / Math::degree();
+    }
+    if ((caps & GEOID_HEIGHT) == GEOID_HEIGHT)
+      // As in GeoidHeight; _zeta0 has been included in _correction
+      N = T0 / _earth.SurfaceGravity(lat) +
+        _corrmult * _correction(invR * X, invR * Y, invR * Z);
+  }
+
   Math::real GravityModel::GeoidHeight(real lat, real lon) const
   {
     real X, Y, Z;
@@ -309,6 +605,33 @@ namespace GeographicLib {
     Geocentric::Unrotate(M, gx, gy, gz, gx, gy, gz);
     return Wres;
   }
+  void GravityModel::Gravity(size_t n, const real lat[], const real lon[],
+                             const real h[], real W[],
+                             real gx[], real gy[], real gz[]) const {
+    // Process the points in blocks to bound the temporary storage.
+    const size_t blk = 16 * SphericalEngine::lanes;
+    real X[blk], Y[blk], Z[blk], M[blk * Geocentric::dim2_];
+    real f = _gGMmodel / _amodel;
+    for (size_t i0 = 0; i0 < n; i0 += blk) {
+      size_t k = min(blk, n - i0);
+      for (size_t i = 0; i < k; ++i)
+        _earth.Earth().IntForward(lat[i0 + i], lon[i0 + i], h[i0 + i],
+                                  X[i], Y[i], Z[i], M + i * Geocentric::dim2_);
+      _gravitational(k, X, Y, Z, W + i0, gx + i0, gy + i0, gz + i0);
+      for (size_t i = 0; i < k; ++i) {
+        size_t j = i0 + i;
+        // Same as the V and W steps in the single point Gravity
+        W[j] *= f; gx[j] *= f; gy[j] *= f; gz[j] *= f;
+        real fX, fY;
+        W[j] += _earth.Phi(X[i], Y[i], fX, fY);
+        gx[j] += fX;
+        gy[j] += fY;
+        Geocentric::Unrotate(M + i * Geocentric::dim2_,
+                             gx[j], gy[j], gz[j], gx[j], gy[j], gz[j]);
+      }
+    }
+  }
+
   Math::real GravityModel::Disturbance(real lat, real lon, real h,
                                        real& deltax, real& deltay,
                                        real& deltaz) const {
@@ -325,32 +648,117 @@ namespace GeographicLib {
       caps &= ~(CAP_GAMMA0 | CAP_C);
     real X, Y, Z, M[Geocentric::dim2_];
     _earth.Earth().IntForward(lat, 0, h, X, Y, Z, M);
+    real invR = 1 / hypot(X, Z);
+    return MakeCircle(lat, h, caps, X, Z, M,
+                      caps & CAP_G ?
+                      _gravitational.Circle(X, Z, true) :
+                      CircularEngine(),
+                      // N.B. If CAP_DELTA is set then CAP_T should be too.
+                      caps & CAP_T ?
+                      _disturbing.Circle(-1, X, Z, (caps&CAP_DELTA) != 0) :
+                      CircularEngine(),
+                      caps & CAP_C ?
+                      _correction.Circle(invR * X, invR * Z, false) :
+                      CircularEngine());
+  }
+
+  void GravityModel::Circles(real lat, size_t n, const real h[],
+                             unsigned caps, GravityCircle circ[]) const {
+    vector<real> X(n), Z(n), M(n * Geocentric::dim2_);
+    bool h0 = false;
+    for (size_t i = 0; i < n; ++i) {
+      real Y;
+      _earth.Earth().IntForward(lat, 0, h[i], X[i], Y, Z[i],
+                                &M[i * Geocentric::dim2_]);
+      h0 = h0 || h[i] == 0;
+    }
+    vector<CircularEngine> grav(caps & CAP_G ? n : 0),
+      dist(caps & CAP_T ? n : 0);
+    if (caps & CAP_G)
+      _gravitational.Circles(n, X.data(), Z.data(), true, grav.data());
+    if (caps & CAP_T)
+      _disturbing.Circles(-1, n, X.data(), Z.data(), (caps&CAP_DELTA) != 0,
+                          dist.data());
+    // The correction is evaluated on the unit sphere, so it only depends on
+    // the latitude; it's only needed for the circles with h = 0.
+    CircularEngine corr;
+    if (caps & CAP_C && h0) {
+      size_t i = 0;
+      while (h[i] != 0) ++i;
+      real invR = 1 / hypot(X[i], Z[i]);
+      corr = _correction.Circle(invR * X[i], invR * Z[i], false);
+    }
+    for (size_t i = 0; i < n; ++i) {
+      unsigned capsi = h[i] != 0 ? caps & ~(CAP_GAMMA0 | CAP_C) : caps;
+      circ[i] = MakeCircle(lat, h[i], capsi, X[i], Z[i],
+                           &M[i * Geocentric::dim2_],
+                           caps & CAP_G ? grav[i] : CircularEngine(),
+                           caps & CAP_T ? dist[i] : CircularEngine(),
+                           capsi & CAP_C ? corr : CircularEngine());
+    }
+  }
+
+  GravityCircle GravityModel::MakeCircle(real lat, real h, unsigned caps,
+                                         real X, real Z, const real M[],
+                                         const CircularEngine& gravitational,
+                                         const CircularEngine& disturbing,
+                                         const CircularEngine& correction)
+    const {
     // Y = 0, cphi = M[7], sphi = M[8];
     real
-      invR = 1 / hypot(X, Z),
       gamma0 = (caps & CAP_GAMMA0 ?_earth.SurfaceGravity(lat)
                 : Math::NaN()),
       fx, fy, fz, gamma;
     if (caps & CAP_GAMMA) {
-      _earth.U(X, Y, Z, fx, fy, fz); // fy = 0
+      _earth.U(X, 0, Z, fx, fy, fz); // fy = 0
       gamma = hypot(fx, fz);
     } else
       gamma = Math::NaN();
-    _earth.Phi(X, Y, fx, fy);
+    _earth.Phi(X, 0, fx, fy);
     return GravityCircle(GravityCircle::mask(caps),
                          _earth._a, _earth._f, lat, h, Z, X, M[7], M[8],
                          _amodel, _gGMmodel, _dzonal0, _corrmult,
                          gamma0, gamma, fx,
-                         caps & CAP_G ?
-                         _gravitational.Circle(X, Z, true) :
-                         CircularEngine(),
-                         // N.B. If CAP_DELTA is set then CAP_T should be too.
-                         caps & CAP_T ?
-                         _disturbing.Circle(-1, X, Z, (caps&CAP_DELTA) != 0) :
-                         CircularEngine(),
-                         caps & CAP_C ?
-                         _correction.Circle(invR * X, invR * Z, false) :
-                         CircularEngine());
+                         gravitational, disturbing, correction);
+  }
+
+  void GravityModel::Grid(real south, real north, real dlat,
+                          real west, real east, real dlon, real h,
+                          unsigned quantity, vector<real>& vals,
+                          int& nlat, int& nlon, int nthreads) const {
+    if (!(quantity == GEOID_HEIGHT || quantity == SPHERICAL_ANOMALY))
+      throw GeographicErr("Grid only supports GEOID_HEIGHT and "
+                          "SPHERICAL_ANOMALY");
+    if (!(isfinite(south) && isfinite(north) && south <= north &&
+          dlat > 0 && isfinite(dlat)))
+      throw GeographicErr("Bad latitude range for grid");
+    if (!(isfinite(west) && isfinite(east) && west <= east &&
+          dlon > 0 && isfinite(dlon)))
+      throw GeographicErr("Bad longitude range for grid");
+    // Allow for roundoff in the division so that, e.g., a range of 180 with
+    // a spacing of 1/60 gives 10801 points.
+    static const real tol = sqrt(numeric_limits<real>::epsilon());
+    real nx = floor((north - south) / dlat + tol) + 1,
+      ny = floor((east - west) / dlon + tol) + 1;
+    if (!(nx * ny <= real(numeric_limits<int>::max())))
+      throw GeographicErr("Grid is too large");
+    nlat = int(nx); nlon = int(ny);
+    vals.resize(size_t(nlat) * size_t(nlon));
+    nthreads = max(1, min(nthreads, nlat));
+    // Rows are handed out one at a time to balance the load.
+    atomic<int> next(0);
+    auto work = [&](int) -> void {
+      for (int i; (i = next++) < nlat;) {
+        real lat = south + i * dlat;
+        real* row = vals.data() + size_t(i) * size_t(nlon);
+        if (quantity == GEOID_HEIGHT)
+          Circle(lat, h, GEOID_HEIGHT).GeoidHeight(west, dlon, nlon, row);
+        else
+          Circle(lat, h, SPHERICAL_ANOMALY)
+            .SphericalAnomaly(west, dlon, nlon, row, NULL, NULL);
+      }
+    };
+    Executor::RunGuarded(nthreads, work, [&]() -> void { next = nlat; });
   }
 
   string GravityModel::DefaultGravityPath() {
@@ -8,15 +8,123 @@
  **********************************************************************/
 
 #include <GeographicLib/Intersect.hpp>
+#include <GeographicLib/Geocentric.hpp>
+#include <GeographicLib/Executor.hpp>
 #include <limits>
 #include <utility>
 #include <algorithm>
 #include <set>
+#include <array>
+#include <atomic>
+#include <memory>
 
 using namespace std;
 
 namespace GeographicLib {
 
+  namespace {
+    // The geocentric distance between two points doesn't exceed the geodesic
+    // distance, so a segment lies within a ball centered at its midpoint
+    // with a radius of half its length.  Return the ball [x, y, z, r]
+    // padding the radius by tol to allow for roundoff.
+    array<Math::real, 4> SegmentBall(const Geocentric& earth,
+                                     const GeodesicLine& line,
+                                     Math::real tol) {
+      Math::real s = line.Distance(), lat, lon;
+      array<Math::real, 4> q;
+      line.Position(s/2, lat, lon);
+      earth.Forward(lat, lon, 0, q[0], q[1], q[2]);
+      q[3] = fabs(s)/2 + tol;
+      return q;
+    }
+
+    // A bounding volume hierarchy for a set of balls in three dimensions,
+    // each given by [x, y, z, r].  The nodes are axis-aligned boxes
+    // containing their balls; the balls are split at the median of the
+    // longest dimension of the spread of their centers.
+    class BallTree {
+    private:
+      typedef Math::real real;
+      typedef std::array<real, 4> ball;
+      static const int leaf_ = 8;
+      struct Node {
+        real lo[3], hi[3];
+        int b, e, kid;          // balls _ind[b:e), children kid, kid+1
+        Node(int b, int e) : b(b), e(e), kid(-1) {}
+      };
+      const vector<ball>& _balls;
+      vector<int> _ind;
+      vector<Node> _nodes;
+      void build(int n) {
+        int b = _nodes[n].b, e = _nodes[n].e;
+        real clo[3], chi[3];
+        for (int k = 0; k < 3; ++k) {
+          _nodes[n].lo[k] = clo[k] = Math::infinity();
+          _nodes[n].hi[k] = chi[k] = -Math::infinity();
+        }
+        for (int i = b; i < e; ++i) {
+          const ball& q = _balls[_ind[i]];
+          for (int k = 0; k < 3; ++k) {
+            _nodes[n].lo[k] = fmin(_nodes[n].lo[k], q[k] - q[3]);
+            _nodes[n].hi[k] = fmax(_nodes[n].hi[k], q[k] + q[3]);
+            clo[k] = fmin(clo[k], q[k]); chi[k] = fmax(chi[k], q[k]);
+          }
+        }
+        if (e - b <= leaf_) return;
+        int a = 0;
+        for (int k = 1; k < 3; ++k)
+          if (chi[k] - clo[k] > chi[a] - clo[a]) a = k;
+        int m = (b + e) / 2, kid = int(_nodes.size());
+        nth_element(_ind.begin() + b, _ind.begin() + m, _ind.begin() + e,
+                    [this, a](int i, int j) -> bool
+                    { return _balls[i][a] < _balls[j][a]; });
+        _nodes[n].kid = kid;
+        _nodes.push_back(Node(b, m));
+        _nodes.push_back(Node(m, e));
+        build(kid);
+        build(kid + 1);
+      }
+    public:
+      // Balls with NaN components are excluded.
+      BallTree(const vector<ball>& balls)
+        : _balls(balls)
+      {
+        for (int i = 0; i < int(balls.size()); ++i)
+          if (isfinite(balls[i][0] + balls[i][1] + balls[i][2]) &&
+              balls[i][3] >= 0)
+            _ind.push_back(i);
+        if (_ind.empty()) return;
+        _nodes.reserve(2 * (_ind.size() / (leaf_/2) + 1));
+        _nodes.push_back(Node(0, int(_ind.size())));
+        build(0);
+      }
+      // Call f(i) for each ball i which overlaps q.
+      template<class F> void Query(const ball& q, F f) const {
+        if (_nodes.empty() || !(q[3] >= 0)) return;
+        vector<int> stack(1, 0);
+        while (!stack.empty()) {
+          const Node& nd = _nodes[stack.back()]; stack.pop_back();
+          real d2 = 0;
+          for (int k = 0; k < 3; ++k) {
+            real t = fmax(real(0), fmax(nd.lo[k] - q[k], q[k] - nd.hi[k]));
+            d2 += t * t;
+          }
+          if (!(d2 <= q[3] * q[3])) continue;
+          if (nd.kid >= 0) {
+            stack.push_back(nd.kid + 1); stack.push_back(nd.kid);
+            continue;
+          }
+          for (int i = nd.b; i < nd.e; ++i) {
+            const ball& p = _balls[_ind[i]];
+            real dx = p[0] - q[0], dy = p[1] - q[1], dz = p[2] - q[2],
+              r = p[3] + q[3];
+            if (dx * dx + dy * dy + dz * dz <= r * r) f(_ind[i]);
+          }
+        }
+      }
+    };
+  }
+
   Intersect::Intersect(const Geodesic& geod)
     : _geod(geod)
     , _a(_geod.EquatorialRadius())
@@ -27,11 +135,6 @@ namespace GeographicLib {
     , _tol(_d * pow(numeric_limits<real>::epsilon(), 3/real(4)))
     , _delta(_d * pow(numeric_limits<real>::epsilon(), 1/real(5)))
     , _comp(_delta)
-    , _cnt0(0)
-    , _cnt1(0)
-    , _cnt2(0)
-    , _cnt3(0)
-    , _cnt4(0)
   {
     _t1 = _t4 = _a * (1 - _f) * Math::pi();
     _t2 = 2 * distpolar(90);
@@ -63,7 +166,30 @@ namespace GeographicLib {
   Intersect::Point
   Intersect::Closest(const GeodesicLine& lineX, const GeodesicLine& lineY,
                      const Intersect::Point& p0, int* c) const {
-    XPoint p = ClosestInt(lineX, lineY, XPoint(p0));
+    Counts cnt;
+    XPoint p = ClosestInt(lineX, lineY, XPoint(p0), cnt);
+    addcounts(cnt);
+    if (c) *c = p.c;
+    return p.data();
+  }
+
+  Intersect::Point
+  Intersect::Closest(Math::real latX, Math::real lonX, Math::real aziX,
+                     Math::real latY, Math::real lonY, Math::real aziY,
+                     const Intersect::Point& p0, const Intersect::Point& hint,
+                     int* c) const {
+    return Closest(_geod.Line(latX, lonX, aziX, LineCaps),
+                   _geod.Line(latY, lonY, aziY, LineCaps),
+                   p0, hint, c);
+  }
+
+  Intersect::Point
+  Intersect::Closest(const GeodesicLine& lineX, const GeodesicLine& lineY,
+                     const Intersect::Point& p0, const Intersect::Point& hint,
+                     int* c) const {
+    Counts cnt;
+    XPoint p = ClosestInt(lineX, lineY, XPoint(p0), XPoint(hint), cnt);
+    addcounts(cnt);
     if (c) *c = p.c;
     return p.data();
   }
@@ -82,7 +208,9 @@ namespace GeographicLib {
   Intersect::Point
   Intersect::Segment(const GeodesicLine& lineX,
                      const GeodesicLine& lineY, int& segmode, int* c) const {
-    XPoint p = SegmentInt(lineX, lineY, segmode);
+    Counts cnt;
+    XPoint p = SegmentInt(lineX, lineY, segmode, cnt);
+    addcounts(cnt);
     if (c) *c = p.c;
     return p.data();
   }
@@ -97,7 +225,9 @@ namespace GeographicLib {
   Intersect::Point
   Intersect::Next(const GeodesicLine& lineX, const GeodesicLine& lineY,
                   int* c) const {
-    XPoint p = NextInt(lineX, lineY);
+    Counts cnt;
+    XPoint p = NextInt(lineX, lineY, cnt);
+    addcounts(cnt);
     if (c) *c = p.c;
     return p.data();
   }
@@ -105,34 +235,34 @@ namespace GeographicLib {
   std::vector<Intersect::Point>
   Intersect::All(Math::real latX, Math::real lonX, Math::real aziX,
                  Math::real latY, Math::real lonY, Math::real aziY,
-                 Math::real maxdist, const Point& p0) const {
+                 Math::real maxdist, const Point& p0, int nthreads) const {
     return All(_geod.Line(latX, lonX, aziX, LineCaps),
                _geod.Line(latY, lonY, aziY, LineCaps),
-               maxdist, p0);
+               maxdist, p0, nthreads);
   }
 
   std::vector<Intersect::Point>
   Intersect::All(Math::real latX, Math::real lonX, Math::real aziX,
                  Math::real latY, Math::real lonY, Math::real aziY,
-                 Math::real maxdist, std::vector<int>& c, const Point& p0)
-    const {
+                 Math::real maxdist, std::vector<int>& c, const Point& p0,
+                 int nthreads) const {
     return All(_geod.Line(latX, lonX, aziX, LineCaps),
                _geod.Line(latY, lonY, aziY, LineCaps),
-               maxdist, c, p0);
+               maxdist, c, p0, nthreads);
   }
 
   std::vector<Intersect::Point>
   Intersect::All(const GeodesicLine& lineX, const GeodesicLine& lineY,
-                 Math::real maxdist, const Point& p0) const {
+                 Math::real maxdist, const Point& p0, int nthreads) const {
     vector<int> c;
-    return AllInternal(lineX, lineY, maxdist, p0, c, false);
+    return AllInternal(lineX, lineY, maxdist, p0, c, false, nthreads);
   }
 
   std::vector<Intersect::Point>
   Intersect::All(const GeodesicLine& lineX, const GeodesicLine& lineY,
-                 Math::real maxdist, std::vector<int>& c, const Point& p0)
-    const {
-    return AllInternal(lineX, lineY, maxdist, p0, c, true);
+                 Math::real maxdist, std::vector<int>& c, const Point& p0,
+                 int nthreads) const {
+    return AllInternal(lineX, lineY, maxdist, p0, c, true, nthreads);
   }
 
   Intersect::XPoint
@@ -190,11 +320,11 @@ namespace GeographicLib {
 
   Intersect::XPoint
   Intersect::Basic(const GeodesicLine& lineX, const GeodesicLine& lineY,
-                   const Intersect::XPoint& p0) const {
-    ++_cnt1;
+                   const Intersect::XPoint& p0, Counts& cnt) const {
+    ++cnt.cnt1;
     XPoint q = p0;
     for (int n = 0; n < numit_ || GEOGRAPHICLIB_PANIC; ++n) {
-      ++_cnt0;
+      ++cnt.cnt0;
       XPoint dq = Spherical(lineX, lineY, q);
       q += dq;
       if (q.c || !(dq.Dist() > _tol)) break; // break if nan
@@ -204,7 +334,7 @@ namespace GeographicLib {
 
   Intersect::XPoint
   Intersect::ClosestInt(const GeodesicLine& lineX, const GeodesicLine& lineY,
-                        const Intersect::XPoint& p0) const {
+                        const Intersect::XPoint& p0, Counts& cnt) const {
     const int num = 5;
     const int ix[num] = { 0,  1, -1,  0,  0 };
     const int iy[num] = { 0,  0,  0,  1, -1 };
@@ -212,11 +342,12 @@ namespace GeographicLib {
     XPoint q;                    // Best intersection so far
     for (int n = 0; n < num; ++n) {
       if (skip[n]) continue;
-      XPoint qx = Basic(lineX, lineY, p0 + XPoint(ix[n] * _d1, iy[n] * _d1));
+      XPoint qx = Basic(lineX, lineY, p0 + XPoint(ix[n] * _d1, iy[n] * _d1),
+                        cnt);
       qx = fixcoincident(p0, qx);
       if (_comp.eq(q, qx)) continue;
-      if (qx.Dist(p0) < _t1) { q = qx; ++_cnt2; break; }
-      if (n == 0 || qx.Dist(p0) < q.Dist(p0)) { q = qx; ++_cnt2; }
+      if (qx.Dist(p0) < _t1) { q = qx; ++cnt.cnt2; break; }
+      if (n == 0 || qx.Dist(p0) < q.Dist(p0)) { q = qx; ++cnt.cnt2; }
       for (int m = n + 1; m < num; ++m)
         skip[m] = skip[m] ||
           qx.Dist(p0 + XPoint(ix[m]*_d1, iy[m]*_d1)) < 2*_t1 - _d1 - _delta;
@@ -225,8 +356,18 @@ namespace GeographicLib {
   }
 
   Intersect::XPoint
-  Intersect::NextInt(const GeodesicLine& lineX, const GeodesicLine& lineY)
-    const {
+  Intersect::ClosestInt(const GeodesicLine& lineX, const GeodesicLine& lineY,
+                        const Intersect::XPoint& p0,
+                        const Intersect::XPoint& hint, Counts& cnt) const {
+    // As in ClosestInt, an intersection within _t1 of p0 is the closest.
+    XPoint q = fixcoincident(p0, Basic(lineX, lineY, hint, cnt));
+    if (q.Dist(p0) < _t1) { ++cnt.cnt2; return q; }
+    return ClosestInt(lineX, lineY, p0, cnt);
+  }
+
+  Intersect::XPoint
+  Intersect::NextInt(const GeodesicLine& lineX, const GeodesicLine& lineY,
+                     Counts& cnt) const {
     const int num = 8;
     const int ix[num] = { -1, -1,  1,  1, -2,  0,  2,  0 };
     const int iy[num] = { -1,  1, -1,  1,  0,  2,  0, -2 };
@@ -235,7 +376,7 @@ namespace GeographicLib {
       q(Math::infinity(), 0);   // Best intersection so far
     for (int n = 0; n < num; ++n) {
       if (skip[n]) continue;
-      XPoint qx = Basic(lineX, lineY, XPoint(ix[n] * _d2, iy[n] * _d2));
+      XPoint qx = Basic(lineX, lineY, XPoint(ix[n] * _d2, iy[n] * _d2), cnt);
       qx = fixcoincident(z, qx);
       bool zerop = _comp.eq(z, qx);
       if (qx.c == 0 && zerop) continue;
@@ -243,10 +384,10 @@ namespace GeographicLib {
         for (int sgn = -1; sgn <= 1; sgn+=2) {
           real s = ConjugateDist(lineX, sgn * _d, false);
           XPoint qa(s, qx.c*s, qx.c);
-          if (qa.Dist() < q.Dist()) { q = qa; ++_cnt2; }
+          if (qa.Dist() < q.Dist()) { q = qa; ++cnt.cnt2; }
         }
       } else {
-        if (qx.Dist() < q.Dist()) { q = qx; ++_cnt2; }
+        if (qx.Dist() < q.Dist()) { q = qx; ++cnt.cnt2; }
       }
       for (int sgn = -1; sgn <= 1; ++sgn) {
         // if qx.c == 0 only process sgn == 0
@@ -263,14 +404,14 @@ namespace GeographicLib {
 
   Intersect::XPoint
   Intersect::SegmentInt(const GeodesicLine& lineX, const GeodesicLine& lineY,
-                        int& segmode) const {
+                        int& segmode, Counts& cnt) const {
     // The conjecture is that whenever two geodesic segments intersect, the
     // intersection is the one that is closest to the midpoints of segments.
     // If this is proven, set conjectureproved to true.
     const bool conjectureproved = false;
     real sx = lineX.Distance(), sy = lineY.Distance();
     // p0 is center of [sx,sy] rectangle, q is intersection closest to p0
-    XPoint p0 = XPoint(sx/2, sy/2), q = ClosestInt(lineX, lineY, p0);
+    XPoint p0 = XPoint(sx/2, sy/2), q = ClosestInt(lineX, lineY, p0, cnt);
     q = fixsegment(sx, sy, q);
     segmode = segmentmode(sx, sy, q);
     // Are corners of [sx,sy] rectangle further from p0 than q?
@@ -283,8 +424,8 @@ namespace GeographicLib {
           XPoint t(ix * sx, iy * sy); // corner point
           // Is corner outside next intersection exclusion circle?
           if (q.Dist(t) >= 2 * _t1) {
-            ++_cnt3;
-            qx = Basic(lineX, lineY, t);
+            ++cnt.cnt3;
+            qx = Basic(lineX, lineY, t, cnt);
             // fixsegment is not needed because the coincidence line must just
             // slice off a corner of the sx x sy rectangle.
             qx = fixcoincident(t, qx);
@@ -294,7 +435,7 @@ namespace GeographicLib {
           }
         }
       }
-      if (segmodex == 0) { ++_cnt4; segmode = 0; q = qx; }
+      if (segmodex == 0) { ++cnt.cnt4; segmode = 0; q = qx; }
     }
     return q;
   }
@@ -302,7 +443,8 @@ namespace GeographicLib {
   std::vector<Intersect::XPoint>
   Intersect::AllInt0(const GeodesicLine& lineX,
                      const GeodesicLine& lineY,
-                     Math::real maxdist, const XPoint& p0) const {
+                     Math::real maxdist, const XPoint& p0, int nthreads,
+                     Counts& cnt) const {
     real maxdistx = maxdist + _delta;
     const int m = int(ceil(maxdistx / _d3)), // process m x m set of tiles
       m2 = m*m + (m - 1) % 2,                // add center tile if m is even
@@ -321,9 +463,31 @@ namespace GeographicLib {
     set<XPoint, SetComp> r(_comp); // Intersections found
     set<XPoint, SetComp> c(_comp); // Closest coincident intersections
     vector<XPoint> added;
+    // With nthreads > 1, the tiles are processed in batches.  The searches
+    // from the tiles in a batch which are not already skipped are done
+    // concurrently (each thread takes the next unclaimed tile) and the
+    // results are then merged serially in the order of the tiles.  This
+    // results in the same intersections as the serial algorithm.  Searches
+    // from tiles which are skipped because of an intersection found in the
+    // same batch are wasted; this is rare except for coincident geodesics.
+    // The batches are large because starting the threads costs about as
+    // much as several searches.
+    nthreads = max(1, min(nthreads, m2));
+    const int batch = nthreads == 1 ? 1 : 16 * nthreads;
+    vector<XPoint> qs(nthreads == 1 ? 0 : m2);
+    vector<Counts> cnts(nthreads == 1 ? 0 : m2);
     for (int k = 0; k < m2; ++k) {
+      if (nthreads > 1 && k % batch == 0)
+        BasicBatch(lineX, lineY, start, skip, k, min(m2, k + batch),
+                   nthreads, qs, cnts);
       if (skip[k]) continue;
-      XPoint q = Basic(lineX, lineY, start[k]);
+      XPoint q;
+      if (nthreads == 1)
+        q = Basic(lineX, lineY, start[k], cnt);
+      else {
+        cnt.cnt0 += cnts[k].cnt0; cnt.cnt1 += cnts[k].cnt1;
+        q = qs[k];
+      }
       if (r.find(q) != r.end()  // intersection already found
           // or it's on a line of coincident intersections already processed
           || (c0 != 0 && c.find(fixcoincident(p0, q)) != c.end()))
@@ -386,12 +550,35 @@ namespace GeographicLib {
     return v;
   }
 
+  void Intersect::BasicBatch(const GeodesicLine& lineX,
+                             const GeodesicLine& lineY,
+                             const vector<XPoint>& start,
+                             const vector<bool>& skip, int k0, int k1,
+                             int nthreads, vector<XPoint>& qs,
+                             vector<Counts>& cnts) const {
+    // Set qs[k] = Basic(lineX, lineY, start[k]) for k in [k0, k1) unless
+    // skip[k].  cnts[k] is set to the corresponding counts.
+    atomic<int> next(k0);
+    auto work = [&](int) -> void {
+      for (int k; (k = next++) < k1;) {
+        if (skip[k]) continue;
+        cnts[k] = Counts();
+        qs[k] = Basic(lineX, lineY, start[k], cnts[k]);
+      }
+    };
+    nthreads = min(nthreads, k1 - k0);
+    Executor::RunGuarded(nthreads, work, [&]() -> void { next = k1; });
+  }
+
   std::vector<Intersect::Point>
   Intersect::AllInternal(const GeodesicLine& lineX, const GeodesicLine& lineY,
                          Math::real maxdist, const Point& p0,
-                         std::vector<int>& c, bool cp) const {
+                         std::vector<int>& c, bool cp, int nthreads) const {
+    Counts cnt;
     const vector<XPoint>
-      v = AllInt0(lineX, lineY, fmax(real(0), maxdist), XPoint(p0));
+      v = AllInt0(lineX, lineY, fmax(real(0), maxdist), XPoint(p0),
+                  nthreads, cnt);
+    addcounts(cnt);
     int i = int(v.size());
     vector<Point> u(i);
     if (cp) c.resize(i);
@@ -402,6 +589,236 @@ namespace GeographicLib {
     return u;
   }
 
+  std::vector<Intersect::Point>
+  Intersect::Segments(const GeodesicLine& lineX,
+                      const std::vector<GeodesicLine>& linesY,
+                      std::vector<int>& ind, std::vector<int>& c,
+                      int nthreads) const {
+    return SegmentsInternal(lineX, linesY, ind, c, true, nthreads);
+  }
+
+  std::vector<Intersect::Point>
+  Intersect::Segments(const GeodesicLine& lineX,
+                      const std::vector<GeodesicLine>& linesY,
+                      std::vector<int>& ind, int nthreads) const {
+    vector<int> c;
+    return SegmentsInternal(lineX, linesY, ind, c, false, nthreads);
+  }
+
+  std::vector<Intersect::Point>
+  Intersect::AllSegments(const std::vector<GeodesicLine>& linesX,
+                         const std::vector<GeodesicLine>& linesY,
+                         std::vector<std::pair<int, int>>& ind,
+                         std::vector<int>& c, int nthreads) const {
+    return AllSegInternal(linesX, linesY, ind, c, true, nthreads);
+  }
+
+  std::vector<Intersect::Point>
+  Intersect::AllSegments(const std::vector<GeodesicLine>& linesX,
+                         const std::vector<GeodesicLine>& linesY,
+                         std::vector<std::pair<int, int>>& ind,
+                         int nthreads) const {
+    vector<int> c;
+    return AllSegInternal(linesX, linesY, ind, c, false, nthreads);
+  }
+
+  std::vector<Intersect::Point>
+  Intersect::SegmentsInternal(const GeodesicLine& lineX,
+                              const std::vector<GeodesicLine>& linesY,
+                              std::vector<int>& ind,
+                              std::vector<int>& c, bool cp, int nthreads)
+    const {
+    const Geocentric earth(_a, _f);
+    const array<real, 4> ballX = SegmentBall(earth, lineX, _tol);
+    struct Hit {
+      int j;
+      XPoint p;
+      bool operator<(const Hit& h) const { return j < h.j; }
+    };
+    // Each thread takes the next unclaimed chunk of the segments Y, rejects
+    // those whose balls don't overlap the ball for X, and intersects the
+    // rest with X.  A NaN ball is rejected.
+    const int ny = int(linesY.size()), chunk = 64;
+    nthreads = max(1, min(nthreads, (ny + chunk - 1) / chunk));
+    vector<vector<Hit>> hits(nthreads);
+    vector<Counts> cnts(nthreads);
+    atomic<int> next(0);
+    auto work = [&](int t) -> void {
+      for (int j0; (j0 = next.fetch_add(chunk)) < ny;) {
+        for (int j = j0; j < min(ny, j0 + chunk); ++j) {
+          const array<real, 4> ballY = SegmentBall(earth, linesY[j], _tol);
+          if (!(Math::sq(ballX[0] - ballY[0]) + Math::sq(ballX[1] - ballY[1])
+                + Math::sq(ballX[2] - ballY[2]) <=
+                Math::sq(ballX[3] + ballY[3])))
+            continue;
+          int segmode;
+          XPoint p = SegmentInt(lineX, linesY[j], segmode, cnts[t]);
+          if (segmode == 0) hits[t].push_back(Hit{j, p});
+        }
+      }
+    };
+    Executor::RunGuarded(nthreads, work, [&]() -> void { next = ny; });
+    for (const auto& cnt : cnts)
+      addcounts(cnt);
+    vector<Hit> h;
+    for (auto& v : hits)
+      h.insert(h.end(), v.begin(), v.end());
+    sort(h.begin(), h.end());
+    int n = int(h.size());
+    vector<Point> u(n);
+    ind.resize(n);
+    if (cp) c.resize(n);
+    for (int k = 0; k < n; ++k) {
+      u[k] = h[k].p.data();
+      ind[k] = h[k].j;
+      if (cp) c[k] = h[k].p.c;
+    }
+    return u;
+  }
+
+  std::vector<Intersect::Point>
+  Intersect::AllSegInternal(const std::vector<GeodesicLine>& linesX,
+                            const std::vector<GeodesicLine>& linesY,
+                            std::vector<std::pair<int, int>>& ind,
+                            std::vector<int>& c, bool cp, int nthreads)
+    const {
+    const Geocentric earth(_a, _f);
+    vector<array<real, 4>> ballsY(linesY.size());
+    for (size_t j = 0; j < linesY.size(); ++j)
+      ballsY[j] = SegmentBall(earth, linesY[j], _tol);
+    const BallTree tree(ballsY);
+    struct Hit {
+      int i, j;
+      XPoint p;
+      bool operator<(const Hit& h) const
+      { return i != h.i ? i < h.i : j < h.j; }
+    };
+    // Each thread takes the next unclaimed chunk of the segments X and
+    // intersects them with the candidate segments Y.
+    const int nx = int(linesX.size()), chunk = 64;
+    nthreads = max(1, min(nthreads, (nx + chunk - 1) / chunk));
+    vector<vector<Hit>> hits(nthreads);
+    vector<Counts> cnts(nthreads);
+    atomic<int> next(0);
+    auto work = [&](int t) -> void {
+      for (int i0; (i0 = next.fetch_add(chunk)) < nx;) {
+        for (int i = i0; i < min(nx, i0 + chunk); ++i) {
+          const GeodesicLine& lineX = linesX[i];
+          tree.Query(SegmentBall(earth, lineX, _tol), [&](int j) -> void {
+            int segmode;
+            XPoint p = SegmentInt(lineX, linesY[j], segmode, cnts[t]);
+            if (segmode == 0) hits[t].push_back(Hit{i, j, p});
+          });
+        }
+      }
+    };
+    Executor::RunGuarded(nthreads, work, [&]() -> void { next = nx; });
+    for (const auto& cnt : cnts)
+      addcounts(cnt);
+    vector<Hit> h;
+    for (auto& v : hits)
+      h.insert(h.end(), v.begin(), v.end());
+    sort(h.begin(), h.end());
+    int n = int(h.size());
+    vector<Point> u(n);
+    ind.resize(n);
+    if (cp) c.resize(n);
+    for (int k = 0; k < n; ++k) {
+      u[k] = h[k].p.data();
+      ind[k] = make_pair(h[k].i, h[k].j);
+      if (cp) c[k] = h[k].p.c;
+    }
+    return u;
+  }
+
+  std::vector<Intersect::Point>
+  Intersect::SelfIntersections(size_t n,
+                               const Math::real lat[], const Math::real lon[],
+                               std::vector<std::pair<int, int>>& ind,
+                               std::vector<int>& c, int nthreads) const {
+    return SelfInternal(n, lat, lon, ind, c, true, nthreads);
+  }
+
+  std::vector<Intersect::Point>
+  Intersect::SelfIntersections(size_t n,
+                               const Math::real lat[], const Math::real lon[],
+                               std::vector<std::pair<int, int>>& ind,
+                               int nthreads) const {
+    vector<int> c;
+    return SelfInternal(n, lat, lon, ind, c, false, nthreads);
+  }
+
+  std::vector<Intersect::Point>
+  Intersect::SelfInternal(size_t n,
+                          const Math::real lat[], const Math::real lon[],
+                          std::vector<std::pair<int, int>>& ind,
+                          std::vector<int>& c, bool cp, int nthreads) const {
+    if (n > size_t(numeric_limits<int>::max()))
+      throw GeographicErr("Too many vertices for Intersect::SelfIntersections");
+    const int ns = n < 2 ? 0 : int(n - 1); // the number of segments
+    // The first and last segments are adjacent for a closed polyline.
+    const bool closed = ns > 2 &&
+      lat[0] == lat[ns] && Math::AngDiff(lon[0], lon[ns]) == 0;
+    const Geocentric earth(_a, _f);
+    auto line = [&lat, &lon, this](int i) -> GeodesicLine {
+      return _geod.InverseLine(lat[i], lon[i], lat[i + 1], lon[i + 1],
+                               LineCaps);
+    };
+    const int chunk = 64;
+    nthreads = max(1, min(nthreads, (ns + chunk - 1) / chunk));
+    // The first pass computes the bounding balls.
+    vector<array<real, 4>> balls(ns);
+    atomic<int> next(0);
+    Executor::RunGuarded(nthreads, [&](int) -> void {
+      for (int i0; (i0 = next.fetch_add(chunk)) < ns;)
+        for (int i = i0; i < min(ns, i0 + chunk); ++i)
+          balls[i] = SegmentBall(earth, line(i), _tol);
+    }, [&]() -> void { next = ns; });
+    const BallTree tree(balls);
+    struct Hit {
+      int i, j;
+      XPoint p;
+      bool operator<(const Hit& h) const
+      { return i != h.i ? i < h.i : j < h.j; }
+    };
+    // The second pass intersects each segment i with the later nonadjacent
+    // segments j whose balls overlap; the line for i is constructed when
+    // the first such j is found.
+    vector<vector<Hit>> hits(nthreads);
+    vector<Counts> cnts(nthreads);
+    next = 0;
+    Executor::RunGuarded(nthreads, [&](int t) -> void {
+      for (int i0; (i0 = next.fetch_add(chunk)) < ns;) {
+        for (int i = i0; i < min(ns, i0 + chunk); ++i) {
+          unique_ptr<GeodesicLine> lineX;
+          tree.Query(balls[i], [&](int j) -> void {
+            if (j <= i + 1 || (closed && i == 0 && j == ns - 1)) return;
+            if (!lineX) lineX.reset(new GeodesicLine(line(i)));
+            int segmode;
+            XPoint p = SegmentInt(*lineX, line(j), segmode, cnts[t]);
+            if (segmode == 0) hits[t].push_back(Hit{i, j, p});
+          });
+        }
+      }
+    }, [&]() -> void { next = ns; });
+    for (const auto& cnt : cnts)
+      addcounts(cnt);
+    vector<Hit> h;
+    for (auto& v : hits)
+      h.insert(h.end(), v.begin(), v.end());
+    sort(h.begin(), h.end());
+    int m = int(h.size());
+    vector<Point> u(m);
+    ind.resize(m);
+    if (cp) c.resize(m);
+    for (int k = 0; k < m; ++k) {
+      u[k] = h[k].p.data();
+      ind[k] = make_pair(h[k].i, h[k].j);
+      if (cp) c[k] = h[k].p.c;
+    }
+    return u;
+  }
+
   Math::real Intersect::distpolar(Math::real lat1, Math::real* lat2)
     const {
     GeodesicLine line = _geod.Line(lat1, 0, 0,
@@ -481,7 +898,9 @@ namespace GeographicLib {
     GeodesicLine line = _geod.Line(0, 0, azi, LineCaps);
     real s = ConjugateDist(line, _d, false);
     if (ds) {
-      XPoint p = Basic(line, line, XPoint(s/2, -3*s/2));
+      Counts cnt;
+      XPoint p = Basic(line, line, XPoint(s/2, -3*s/2), cnt);
+      addcounts(cnt);
       if (sp) *sp = p.x;
       if (sm) *sm = p.y;
       *ds = p.Dist() - 2*s;
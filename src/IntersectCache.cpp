@@ -0,0 +1,206 @@
+/**
+ * \file IntersectCache.cpp
+ * \brief Implementation for GeographicLib::IntersectCache class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/IntersectCache.hpp>
+#include <cstdint>
+#include <cstring>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  namespace {
+    typedef Math::real real;
+    // Round x to the nearest multiple of d (a no-op if d == 0); adding 0
+    // merges -0 with 0.
+    real Quantize(real x, real d)
+    { return d > 0 ? d * round(x / d) + real(0) : x; }
+    // Equality which distinguishes 0 and -0
+    bool Same(real x, real y)
+    { return x == y && signbit(x) == signbit(y); }
+    // The splitmix64 finalizer; every bit of x affects every bit of the
+    // result.
+    uint64_t Mix(uint64_t x) {
+      x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+      return x ^ (x >> 31);
+    }
+    // A hash of the bit patterns of n values (converted to double; this is
+    // consistent with Same).
+    uint64_t Hash64(const real v[], int n) {
+      uint64_t h = 0;
+      for (int i = 0; i < n; ++i) {
+        const double x = double(v[i]);
+        uint64_t b;
+        memcpy(&b, &x, sizeof(b));
+        h = Mix(h ^ b);
+      }
+      return h;
+    }
+  }
+
+  bool IntersectCache::Key::operator==(const Key& k) const {
+    return Same(latX, k.latX) && Same(lonX, k.lonX) && Same(aziX, k.aziX) &&
+      Same(latY, k.latY) && Same(lonY, k.lonY) && Same(aziY, k.aziY) &&
+      Same(x0, k.x0) && Same(y0, k.y0);
+  }
+
+  size_t IntersectCache::Hash::operator()(const Key& k) const {
+    const real v[8] = {k.latX, k.lonX, k.aziX, k.latY, k.lonY, k.aziY,
+                       k.x0, k.y0};
+    return size_t(Hash64(v, 8));
+  }
+
+  IntersectCache::Shard::Shard(size_t maxsize)
+    : _maxsize(maxsize)
+    , _hits(0)
+    , _seeded(0)
+    , _misses(0)
+  {}
+
+  int IntersectCache::Shard::Find(const Key& k, const Key& exact, Value& v) {
+    lock_guard<mutex> guard(_lock);
+    auto p = _map.find(k);
+    if (p == _map.end()) {
+      ++_misses;
+      return 0;
+    }
+    _list.splice(_list.begin(), _list, p->second);
+    v = p->second->second;
+    if (v.exact == exact) {
+      ++_hits;
+      return 2;
+    }
+    ++_seeded;
+    return 1;
+  }
+
+  void IntersectCache::Shard::Insert(const Key& k, const Value& v) {
+    lock_guard<mutex> guard(_lock);
+    if (_maxsize == 0) return;
+    auto p = _map.find(k);
+    if (p != _map.end()) {
+      // Replace the solution for perturbed geodesics (or one inserted by
+      // another thread while we were computing ours)
+      p->second->second = v;
+      _list.splice(_list.begin(), _list, p->second);
+      return;
+    }
+    _list.emplace_front(k, v);
+    _map[k] = _list.begin();
+    while (_list.size() > _maxsize) {
+      _map.erase(_list.back().first);
+      _list.pop_back();
+    }
+  }
+
+  void IntersectCache::Shard::Clear() {
+    lock_guard<mutex> guard(_lock);
+    _list.clear(); _map.clear();
+    _hits = _seeded = _misses = 0;
+  }
+
+  size_t IntersectCache::Shard::Size() const
+  { lock_guard<mutex> guard(_lock); return _list.size(); }
+
+  unsigned long long IntersectCache::Shard::Hits() const
+  { lock_guard<mutex> guard(_lock); return _hits; }
+
+  unsigned long long IntersectCache::Shard::Seeded() const
+  { lock_guard<mutex> guard(_lock); return _seeded; }
+
+  unsigned long long IntersectCache::Shard::Misses() const
+  { lock_guard<mutex> guard(_lock); return _misses; }
+
+  IntersectCache::IntersectCache(const Intersect& inter, size_t maxsize,
+                                 real dq, int nshards)
+    : _inter(inter)
+    , _maxsize(maxsize)
+    , _dq(dq)
+  {
+    if (!(isfinite(_dq) && _dq >= 0))
+      throw GeographicErr("Quantum for positions must be nonnegative");
+    if (!(nshards > 0))
+      throw GeographicErr("Number of shards must be positive");
+    const size_t n = size_t(nshards), shardsize = (maxsize + n - 1) / n;
+    _shards.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+      _shards.push_back(unique_ptr<Shard>(new Shard(shardsize)));
+  }
+
+  IntersectCache::Shard& IntersectCache::shard(const Key& k) {
+    // Use the high bits of the hash so that the selection of the shard is
+    // independent of the selection of the bucket within the shard.
+    uint64_t h = Hash()(k);
+    return *_shards[size_t((h >> 40) % _shards.size())];
+  }
+
+  IntersectCache::Point
+  IntersectCache::Closest(real latX, real lonX, real aziX,
+                          real latY, real lonY, real aziY,
+                          const Point& p0, int* c) {
+    const Key exact{latX, lonX, aziX, latY, lonY, aziY, p0.first, p0.second};
+    if (isnan(latX) || isnan(lonX) || isnan(aziX) ||
+        isnan(latY) || isnan(lonY) || isnan(aziY) ||
+        isnan(p0.first) || isnan(p0.second))
+      return _inter.Closest(latX, lonX, aziX, latY, lonY, aziY, p0, c);
+    const Key k{Quantize(latX, _dq), Quantize(lonX, _dq),
+                Quantize(aziX, _dq), Quantize(latY, _dq),
+                Quantize(lonY, _dq), Quantize(aziY, _dq),
+                p0.first, p0.second};
+    Shard& s = shard(k);
+    Value v = Value();
+    int found = s.Find(k, exact, v);
+    if (found < 2) {
+      // Solve the problem with the lock released so that other threads can
+      // consult the shard in the meantime.
+      v.p = found ?
+        _inter.Closest(latX, lonX, aziX, latY, lonY, aziY, p0, v.p, &v.c) :
+        _inter.Closest(latX, lonX, aziX, latY, lonY, aziY, p0, &v.c);
+      v.exact = exact;
+      s.Insert(k, v);
+    }
+    if (c) *c = v.c;
+    return v.p;
+  }
+
+  void IntersectCache::Clear() {
+    for (auto& s : _shards)
+      s->Clear();
+  }
+
+  size_t IntersectCache::Size() const {
+    size_t n = 0;
+    for (const auto& s : _shards)
+      n += s->Size();
+    return n;
+  }
+
+  unsigned long long IntersectCache::Hits() const {
+    unsigned long long n = 0;
+    for (const auto& s : _shards)
+      n += s->Hits();
+    return n;
+  }
+
+  unsigned long long IntersectCache::Seeded() const {
+    unsigned long long n = 0;
+    for (const auto& s : _shards)
+      n += s->Seeded();
+    return n;
+  }
+
+  unsigned long long IntersectCache::Misses() const {
+    unsigned long long n = 0;
+    for (const auto& s : _shards)
+      n += s->Misses();
+    return n;
+  }
+
+} // namespace GeographicLib
@@ -0,0 +1,132 @@
+/**
+ * \file JacobiConformal.cpp
+ * \brief Implementation for GeographicLib::JacobiConformal class
+ *
+ * Copyright (c) Charles Karney (2014-2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/JacobiConformal.hpp>
+#include <atomic>
+#include <GeographicLib/Executor.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  namespace {
+    // Call work(b) for the blocks b in [0, nblocks) on nthreads threads.
+    // The blocks are claimed with an atomic counter.
+    template<class F> void Blocks(size_t nblocks, int nthreads, F work) {
+      nthreads = int(min(size_t(max(1, nthreads)), nblocks));
+      if (nthreads <= 1) {
+        for (size_t b = 0; b < nblocks; ++b) work(b);
+        return;
+      }
+      atomic<size_t> next(0);
+      Executor::RunGuarded(nthreads, [&](int) -> void {
+        for (size_t b; (b = next++) < nblocks;)
+          work(b);
+      }, [&]() -> void { next = nblocks; });
+    }
+  }
+
+  JacobiConformal::JacobiConformal(real a, real b, real c)
+    : _a(a), _b(b), _c(c)
+    , _ab2((_a - _b) * (_a + _b))
+    , _bc2((_b - _c) * (_b + _c))
+    , _ac2((_a - _c) * (_a + _c))
+    , _ex(_ab2 / _ac2 * Math::sq(_c / _b), -_ab2 / Math::sq(_b),
+          _bc2 / _ac2 * Math::sq(_a / _b), Math::sq(_a / _b))
+    , _ey(_bc2 / _ac2 * Math::sq(_a / _b), +_bc2 / Math::sq(_b),
+          _ab2 / _ac2 * Math::sq(_c / _b), Math::sq(_c / _b))
+  {
+    if (!(isfinite(_a) && _a >= _b && _b >= _c && _c > 0))
+      throw GeographicErr("JacobiConformal: axes are not in order");
+    if (!(_a > _c))
+      throw GeographicErr
+        ("JacobiConformal: use alternate constructor for sphere");
+    Init();
+  }
+
+  JacobiConformal::JacobiConformal(real a, real b, real c, real ab, real bc)
+    : _a(a), _b(b), _c(c)
+    , _ab2(ab * (_a + _b))
+    , _bc2(bc * (_b + _c))
+    , _ac2(_ab2 + _bc2)
+    , _ex(_ab2 / _ac2 * Math::sq(_c / _b),
+          -(_a - _b) * (_a + _b) / Math::sq(_b),
+          _bc2 / _ac2 * Math::sq(_a / _b), Math::sq(_a / _b))
+    , _ey(_bc2 / _ac2 * Math::sq(_a / _b),
+          +(_b - _c) * (_b + _c) / Math::sq(_b),
+          _ab2 / _ac2 * Math::sq(_c / _b), Math::sq(_c / _b))
+  {
+    if (!(isfinite(_a) && _a >= _b && _b >= _c && _c > 0 &&
+          ab >= 0 && bc >= 0))
+      throw GeographicErr("JacobiConformal: axes are not in order");
+    if (!(ab + bc > 0 && isfinite(_ac2)))
+      throw GeographicErr("JacobiConformal: ab + bc must be positive");
+    Init();
+  }
+
+  void JacobiConformal::Init() {
+    // The scale factors and the quadrant lengths; evaluating Pi() here also
+    // computes the complete integrals of the third kind, which are needed
+    // by every call to the incomplete ones, once per ellipsoid.
+    _xs = Math::sq(_a / _b);
+    _ys = Math::sq(_c / _b);
+    _xq = _xs * _ex.Pi();
+    _yq = _ys * _ey.Pi();
+  }
+
+  Math::real JacobiConformal::Invert(const EllipticFunction& ell, real p,
+                                     real u, real v) {
+    static const real tolJAC =
+      sqrt(numeric_limits<real>::epsilon() * real(0.01));
+    const real pPic = ell.Pi(), kK = ell.K(), alpha2 = ell.alpha2();
+    // Pi(phi + pi) = Pi(phi) + 2 * Pi()
+    real n = round(p / (2 * pPic));
+    p -= 2 * pPic * n;                      // p now in [-Pi(), Pi()]
+    // Solve for w = F(phi), phi = am(w).  Newton's method converges quickly
+    // because d Pi / d w = 1 / (1 - alpha2 * sn^2) lies between 1 and 1 / (1
+    // - alpha2), even when k2 is close to 1 (when d Pi / d phi is nearly
+    // singular at phi = pi/2).
+    real w = kK * p / pPic, sn, cn, dn;     // Linear approximation
+    for (int i = 0; i < 10 || GEOGRAPHICLIB_PANIC; ++i) {
+      ell.sncndn(w, sn, cn, dn);
+      real err = (ell.Pi(sn, cn, dn) - p) * (1 - alpha2 * Math::sq(sn));
+      w -= err;
+      if (!(fabs(err) > tolJAC))
+        break;
+    }
+    ell.sncndn(w, sn, cn, dn);
+    return n * Math::hd + Math::atan2d(u * sn, v * cn);
+  }
+
+  void JacobiConformal::Reverse(real x, real y, real& omg, real& bet) const {
+    omg = Invert(_ex, x * Math::degree() / _xs, _a, _b);
+    bet = Invert(_ey, y * Math::degree() / _ys, _c, _b);
+  }
+
+  void JacobiConformal::Forward(size_t n, const real omg[], const real bet[],
+                                real x[], real y[], int nthreads) const {
+    // The points are processed in blocks of this size, claimed with an
+    // atomic counter.
+    const size_t block = 256;
+    Blocks((n + block - 1) / block, nthreads, [&](size_t b) -> void {
+      for (size_t i = b * block; i < min(n, (b + 1) * block); ++i)
+        Forward(omg[i], bet[i], x[i], y[i]);
+    });
+  }
+
+  void JacobiConformal::Reverse(size_t n, const real x[], const real y[],
+                                real omg[], real bet[], int nthreads) const {
+    const size_t block = 256;
+    Blocks((n + block - 1) / block, nthreads, [&](size_t b) -> void {
+      for (size_t i = b * block; i < min(n, (b + 1) * block); ++i)
+        Reverse(x[i], y[i], omg[i], bet[i]);
+    });
+  }
+
+} // namespace GeographicLib
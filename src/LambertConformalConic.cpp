@@ -18,11 +18,21 @@ namespace GeographicLib {
 
   using namespace std;
 
-  LambertConformalConic::LambertConformalConic(real a, real f,
-                                               real stdlat, real k0)
+  namespace {
+    // The number of bits of precision of T
+    template<typename T> int Digits() { return numeric_limits<T>::digits; }
+#if GEOGRAPHICLIB_PRECISION == 5
+    // The precision of mpreal is set at run time
+    template<> int Digits<Math::real>() { return Math::digits(); }
+#endif
+  }
+
+  template<typename T>
+  LambertConformalConicT<T>::LambertConformalConicT(real a, real f,
+                                                    real stdlat, real k0)
     : eps_(numeric_limits<real>::epsilon())
     , epsx_(Math::sq(eps_))
-    , ahypover_(Math::digits() * log(real(numeric_limits<real>::radix)) + 2)
+    , ahypover_(Digits<real>() * log(real(numeric_limits<real>::radix)) + 2)
     , _a(a)
     , _f(f)
     , _fm(1 - _f)
@@ -43,12 +53,14 @@ namespace GeographicLib {
     Init(sphi, cphi, sphi, cphi, k0);
   }
 
-  LambertConformalConic::LambertConformalConic(real a, real f,
-                                               real stdlat1, real stdlat2,
-                                               real k1)
+  template<typename T>
+  LambertConformalConicT<T>::LambertConformalConicT(real a, real f,
+                                                    real stdlat1,
+                                                    real stdlat2,
+                                                    real k1)
     : eps_(numeric_limits<real>::epsilon())
     , epsx_(Math::sq(eps_))
-    , ahypover_(Math::digits() * log(real(numeric_limits<real>::radix)) + 2)
+    , ahypover_(Digits<real>() * log(real(numeric_limits<real>::radix)) + 2)
     , _a(a)
     , _f(f)
     , _fm(1 - _f)
@@ -75,13 +87,16 @@ namespace GeographicLib {
     Init(sphi1, cphi1, sphi2, cphi2, k1);
   }
 
-  LambertConformalConic::LambertConformalConic(real a, real f,
-                                               real sinlat1, real coslat1,
-                                               real sinlat2, real coslat2,
-                                               real k1)
+  template<typename T>
+  LambertConformalConicT<T>::LambertConformalConicT(real a, real f,
+                                                    real sinlat1,
+                                                    real coslat1,
+                                                    real sinlat2,
+                                                    real coslat2,
+                                                    real k1)
     : eps_(numeric_limits<real>::epsilon())
     , epsx_(Math::sq(eps_))
-    , ahypover_(Math::digits() * log(real(numeric_limits<real>::radix)) + 2)
+    , ahypover_(Digits<real>() * log(real(numeric_limits<real>::radix)) + 2)
     , _a(a)
     , _f(f)
     , _fm(1 - _f)
@@ -113,8 +128,9 @@ namespace GeographicLib {
     Init(sinlat1, coslat1, sinlat2, coslat2, k1);
   }
 
-  void LambertConformalConic::Init(real sphi1, real cphi1,
-                                   real sphi2, real cphi2, real k1) {
+  template<typename T>
+  void LambertConformalConicT<T>::Init(real sphi1, real cphi1,
+                                       real sphi2, real cphi2, real k1) {
     {
       real r;
       r = hypot(sphi1, cphi1);
@@ -300,7 +316,7 @@ namespace GeographicLib {
     _tchi0 = tphi0 * hyp(shxi0) - shxi0 * hyp(tphi0); _scchi0 = hyp(_tchi0);
     _psi0 = asinh(_tchi0);
 
-    _lat0 = atan(_sign * tphi0) / Math::degree();
+    _lat0 = atan(_sign * tphi0) / Math::degree<real>();
     _t0nm1 = expm1(- _n * _psi0); // Snyder's t0^n - 1
     // a * k1 * m1/t1^n = a * k1 * m2/t2^n = a * k1 * n * (Snyder's F)
     // = a * k1 / (scbet1 * exp(-n * psi1))
@@ -335,16 +351,32 @@ namespace GeographicLib {
     }
   }
 
-  const LambertConformalConic& LambertConformalConic::Mercator() {
-    static const LambertConformalConic mercator(Constants::WGS84_a(),
-                                                Constants::WGS84_f(),
-                                                real(0), real(1));
+  template<typename T>
+  const LambertConformalConicT<T>& LambertConformalConicT<T>::Mercator() {
+    static const LambertConformalConicT mercator(Constants::WGS84_a<real>(),
+                                                 Constants::WGS84_f<real>(),
+                                                 real(0), real(1));
     return mercator;
   }
 
-  void LambertConformalConic::Forward(real lon0, real lat, real lon,
-                                      real& x, real& y,
-                                      real& gamma, real& k) const {
+  template<typename T>
+  void LambertConformalConicT<T>::Forward(real lon0, real lat, real lon,
+                                          real& x, real& y,
+                                          real& gamma, real& k) const {
+    GenForward(lon0, lat, lon, true, x, y, gamma, k);
+  }
+
+  template<typename T>
+  void LambertConformalConicT<T>::Reverse(real lon0, real x, real y,
+                                          real& lat, real& lon,
+                                          real& gamma, real& k) const {
+    GenReverse(Math::AngNormalize(lon0), x, y, true, lat, lon, gamma, k);
+  }
+
+  template<typename T>
+  void LambertConformalConicT<T>::GenForward(real lon0, real lat, real lon,
+                                             bool wantk, real& x, real& y,
+                                             real& gamma, real& k) const {
     lon = Math::AngDiff(lon0, lon);
     // From Snyder, we have
     //
@@ -360,9 +392,8 @@ namespace GeographicLib {
     Math::sincosd(Math::LatFix(lat) * _sign, sphi, cphi);
     cphi = fmax(epsx_, cphi);
     real
-      lam = lon * Math::degree(),
-      tphi = sphi/cphi, scbet = hyp(_fm * tphi),
-      scphi = 1/cphi, shxi = sinh(Math::eatanhe(sphi, _es)),
+      lam = lon * Math::degree<real>(),
+      tphi = sphi/cphi, scphi = 1/cphi, shxi = sinh(Math::eatanhe(sphi, _es)),
       tchi = hyp(shxi) * tphi - shxi * scphi, scchi = hyp(tchi),
       psi = asinh(tchi),
       theta = _n * lam, stheta = sin(theta), ctheta = cos(theta),
@@ -377,16 +408,25 @@ namespace GeographicLib {
       (_n != 0 ?
        (ctheta < 0 ? 1 - ctheta : Math::sq(stheta)/(1 + ctheta)) / _n : 0)
       - drho * ctheta;
-    k = _k0 * (scbet/_scbet0) /
-      (exp( - (Math::sq(_nc)/(1 + _n)) * dpsi )
-       * (tchi >= 0 ? scchi + tchi : 1 / (scchi - tchi)) / (_scchi0 + _tchi0));
+    if (wantk) {
+      real scbet = hyp(_fm * tphi);
+      k = _k0 * (scbet/_scbet0) /
+        (exp( - (Math::sq(_nc)/(1 + _n)) * dpsi )
+         * (tchi >= 0 ? scchi + tchi : 1 / (scchi - tchi))
+         / (_scchi0 + _tchi0));
+    } else
+      k = 0;
     y *= _sign;
-    gamma = _sign * theta / Math::degree();
+    gamma = _sign * theta / Math::degree<real>();
   }
 
-  void LambertConformalConic::Reverse(real lon0, real x, real y,
-                                      real& lat, real& lon,
-                                      real& gamma, real& k) const {
+  template<typename T>
+  void LambertConformalConicT<T>::GenReverse(real lon0, real x, real y,
+                                             bool wantk,
+                                             real& lat, real& lon,
+                                             real& gamma, real& k) const {
+    // lon0 has been reduced with Math::AngNormalize.
+    //
     // From Snyder, we have
     //
     //        x = rho * sin(theta)
@@ -441,18 +481,50 @@ namespace GeographicLib {
     gamma = atan2(nx, y1);
     real
       tphi = Math::tauf(tchi, _es),
-      scbet = hyp(_fm * tphi), scchi = hyp(tchi),
       lam = _n != 0 ? gamma / _n : x / y1;
     lat = Math::atand(_sign * tphi);
-    lon = lam / Math::degree();
-    lon = Math::AngNormalize(lon + Math::AngNormalize(lon0));
-    k = _k0 * (scbet/_scbet0) /
-      (exp(_nc != 0 ? - (Math::sq(_nc)/(1 + _n)) * dpsi : 0)
-       * (tchi >= 0 ? scchi + tchi : 1 / (scchi - tchi)) / (_scchi0 + _tchi0));
-    gamma /= _sign * Math::degree();
+    lon = lam / Math::degree<real>();
+    lon = Math::AngNormalize(lon + lon0);
+    if (wantk) {
+      real scbet = hyp(_fm * tphi), scchi = hyp(tchi);
+      k = _k0 * (scbet/_scbet0) /
+        (exp(_nc != 0 ? - (Math::sq(_nc)/(1 + _n)) * dpsi : 0)
+         * (tchi >= 0 ? scchi + tchi : 1 / (scchi - tchi))
+         / (_scchi0 + _tchi0));
+    } else
+      k = 0;
+    gamma /= _sign * Math::degree<real>();
   }
 
-  void LambertConformalConic::SetScale(real lat, real k) {
+  template<typename T>
+  void LambertConformalConicT<T>::Forward(real lon0, size_t n,
+                                          const real lat[], const real lon[],
+                                          real x[], real y[],
+                                          real gamma[], real k[]) const {
+    real g, kk;
+    for (size_t i = 0; i < n; ++i) {
+      GenForward(lon0, lat[i], lon[i], k != nullptr, x[i], y[i], g, kk);
+      if (gamma) gamma[i] = g;
+      if (k) k[i] = kk;
+    }
+  }
+
+  template<typename T>
+  void LambertConformalConicT<T>::Reverse(real lon0, size_t n,
+                                          const real x[], const real y[],
+                                          real lat[], real lon[],
+                                          real gamma[], real k[]) const {
+    lon0 = Math::AngNormalize(lon0);
+    real g, kk;
+    for (size_t i = 0; i < n; ++i) {
+      GenReverse(lon0, x[i], y[i], k != nullptr, lat[i], lon[i], g, kk);
+      if (gamma) gamma[i] = g;
+      if (k) k[i] = kk;
+    }
+  }
+
+  template<typename T>
+  void LambertConformalConicT<T>::SetScale(real lat, real k) {
     if (!(isfinite(k) && k > 0))
       throw GeographicErr("Scale is not positive");
     if (!(fabs(lat) <= Math::qd))
@@ -468,4 +540,18 @@ namespace GeographicLib {
     _k0 *= k;
   }
 
+  /// \cond SKIP
+  // Instantiate with the standard floating types
+  template class GEOGRAPHICLIB_EXPORT LambertConformalConicT<float>;
+  template class GEOGRAPHICLIB_EXPORT LambertConformalConicT<double>;
+#if GEOGRAPHICLIB_HAVE_LONG_DOUBLE
+  // Instantiate if long double is distinct from double
+  template class GEOGRAPHICLIB_EXPORT LambertConformalConicT<long double>;
+#endif
+#if GEOGRAPHICLIB_PRECISION > 3
+  // Instantiate with the high precision type
+  template class GEOGRAPHICLIB_EXPORT LambertConformalConicT<Math::real>;
+#endif
+  /// \endcond
+
 } // namespace GeographicLib
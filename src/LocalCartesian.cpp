@@ -13,7 +13,8 @@ namespace GeographicLib {
 
   using namespace std;
 
-  void LocalCartesian::Reset(real lat0, real lon0, real h0) {
+  template<typename T>
+  void LocalCartesianT<T>::Reset(real lat0, real lon0, real h0) {
     _lat0 = Math::LatFix(lat0);
     _lon0 = Math::AngNormalize(lon0);
     _h0 = h0;
@@ -24,7 +25,8 @@ namespace GeographicLib {
     Geocentric::Rotation(sphi, cphi, slam, clam, _r);
   }
 
-  void LocalCartesian::MatrixMultiply(real M[dim2_]) const {
+  template<typename T>
+  void LocalCartesianT<T>::MatrixMultiply(real M[dim2_]) const {
     // M = r' . M
     real t[dim2_];
     copy(M, M + dim2_, t);
@@ -34,9 +36,10 @@ namespace GeographicLib {
     }
   }
 
-  void LocalCartesian::IntForward(real lat, real lon, real h,
-                                  real& x, real& y, real& z,
-                                  real M[dim2_]) const {
+  template<typename T>
+  void LocalCartesianT<T>::IntForward(real lat, real lon, real h,
+                                      real& x, real& y, real& z,
+                                      real M[dim2_]) const {
     real xc, yc, zc;
     _earth.IntForward(lat, lon, h, xc, yc, zc, M);
     xc -= _x0; yc -= _y0; zc -= _z0;
@@ -47,9 +50,10 @@ namespace GeographicLib {
       MatrixMultiply(M);
   }
 
-  void LocalCartesian::IntReverse(real x, real y, real z,
-                                  real& lat, real& lon, real& h,
-                                  real M[dim2_]) const {
+  template<typename T>
+  void LocalCartesianT<T>::IntReverse(real x, real y, real z,
+                                      real& lat, real& lon, real& h,
+                                      real M[dim2_]) const {
     real
       xc = _x0 + _r[0] * x + _r[1] * y + _r[2] * z,
       yc = _y0 + _r[3] * x + _r[4] * y + _r[5] * z,
@@ -59,4 +63,112 @@ namespace GeographicLib {
       MatrixMultiply(M);
   }
 
+  template<typename T>
+  void LocalCartesianT<T>::Forward(size_t n, const real lat[],
+                                   const real lon[], const real h[],
+                                   real x[], real y[], real z[],
+                                   real M[]) const {
+    for (size_t i = 0; i < n; ++i)
+      IntForward(lat[i], lon[i], h[i], x[i], y[i], z[i],
+                 M ? M + dim2_ * i : NULL);
+  }
+
+  template<typename T>
+  void LocalCartesianT<T>::Reverse(size_t n, const real x[], const real y[],
+                                   const real z[], real lat[], real lon[],
+                                   real h[], real M[], real radius) const {
+    // Points within radius of the origin are converted by Newton's method
+    // for the geodetic latitude phi starting at the origin.  With R and Z
+    // the distances of the point from the axis and the equatorial plane and
+    // W = sqrt(1 - e2 * sin(phi)^2), phi is the root of
+    //   f(phi) = R * sin(phi) - Z * cos(phi) - a * e2 * sin(phi) * cos(phi)/W
+    // and then h = R * cos(phi) + Z * sin(phi) - a * W.  The quantities for
+    // the origin are those used by the first step, which therefore doesn't
+    // need a sqrt.  The other points are handled by IntReverse.
+    const real
+      a = _earth._a, e2 = _earth._e2, ae2 = a * e2,
+      // sin and cos of the latitude and longitude of the origin
+      s0 = _r[8], c0 = _r[7], slam0 = -_r[0], clam0 = _r[3],
+      iW0 = 1 / sqrt(1 - e2 * Math::sq(s0)),
+      // A correction larger than dmax indicates a failure to converge
+      dmax = 1/real(16),
+      eps = numeric_limits<real>::epsilon(),
+      // The convergence is cubic for a sphere and quadratic with a small
+      // coefficient, roughly e2, otherwise
+      tol = sqrt(eps) / 4,
+      // The truncation error for the Taylor series for sin(d) and cos(d)
+      // below is less than eps * d for d < dtaylor
+      dtaylor = pow(362880 * eps, 1/real(8)),
+      r2 = Math::sq(fmin(radius, fmin(a / 64, hypot(_x0, _y0) / 4)));
+    const int maxit = 5;
+    for (size_t i = 0; i < n; ++i) {
+      real* Mi = M ? M + dim2_ * i : NULL;
+      if (!(Math::sq(x[i]) + Math::sq(y[i]) + Math::sq(z[i]) <= r2)) {
+        IntReverse(x[i], y[i], z[i], lat[i], lon[i], h[i], Mi);
+        continue;
+      }
+      real
+        xc = _x0 + _r[0] * x[i] + _r[1] * y[i] + _r[2] * z[i],
+        yc = _y0 + _r[3] * x[i] + _r[4] * y[i] + _r[5] * z[i],
+        Z  = _z0 + _r[6] * x[i] + _r[7] * y[i] + _r[8] * z[i],
+        // The geocentric coordinates with respect to the meridian of the
+        // origin
+        X = clam0 * xc + slam0 * yc, Y = clam0 * yc - slam0 * xc,
+        R = hypot(X, Y),
+        s = s0, c = c0, iW = iW0, dphi = 0;
+      bool conv = false;
+      for (int it = 0; it < maxit; ++it) {
+        if (it > 0) iW = 1 / sqrt(1 - e2 * Math::sq(s));
+        real
+          f = R * s - Z * c - ae2 * s * c * iW,
+          fp = R * c + Z * s - ae2 * iW * ((c - s) * (c + s) +
+                                           e2 * Math::sq(s * c * iW)),
+          d = -f / fp;
+        if (!(fabs(d) <= dmax)) break;
+        // Rotate (s, c) by d, using the Taylor series for sin(d) and cos(d)
+        // if d is small enough
+        real sd, cd;
+        if (fabs(d) <= dtaylor) {
+          real d2 = Math::sq(d);
+          sd = d * (1 - d2/6 * (1 - d2/20 * (1 - d2/42)));
+          cd = 1 - d2/2 * (1 - d2/12 * (1 - d2/30 * (1 - d2/56)));
+        } else {
+          sd = sin(d); cd = cos(d);
+        }
+        real t = s * cd + c * sd;
+        c = c * cd - s * sd; s = t;
+        dphi += d;
+        // The next step would change phi by O(d^2), which is negligible
+        if (fabs(d) <= tol) { conv = true; break; }
+      }
+      if (!conv) {
+        IntReverse(x[i], y[i], z[i], lat[i], lon[i], h[i], Mi);
+        continue;
+      }
+      h[i] = R * c + Z * s - a * sqrt(1 - e2 * Math::sq(s));
+      lat[i] = _lat0 + dphi / Math::degree<real>();
+      real lam = _lon0 + atan2(Y, X) / Math::degree<real>();
+      lon[i] = lam > Math::hd ? lam - Math::td :
+        (lam <= -Math::hd ? lam + Math::td : lam);
+      if (Mi) {
+        Geocentric::Rotation(s, c, yc / R, xc / R, Mi);
+        MatrixMultiply(Mi);
+      }
+    }
+  }
+
+  /// \cond SKIP
+  // Instantiate with the standard floating types
+  template class GEOGRAPHICLIB_EXPORT LocalCartesianT<float>;
+  template class GEOGRAPHICLIB_EXPORT LocalCartesianT<double>;
+#if GEOGRAPHICLIB_HAVE_LONG_DOUBLE
+  // Instantiate if long double is distinct from double
+  template class GEOGRAPHICLIB_EXPORT LocalCartesianT<long double>;
+#endif
+#if GEOGRAPHICLIB_PRECISION > 3
+  // Instantiate with the high precision type
+  template class GEOGRAPHICLIB_EXPORT LocalCartesianT<Math::real>;
+#endif
+  /// \endcond
+
 } // namespace GeographicLib
@@ -9,6 +9,7 @@
 
 #include <GeographicLib/MGRS.hpp>
 #include <GeographicLib/Utility.hpp>
+#include <cstring>
 
 #if defined(_MSC_VER)
 // Squelch warnings about enum-float expressions and mixing enums
@@ -45,13 +46,20 @@ namespace GeographicLib {
 
   void MGRS::Forward(int zone, bool northp, real x, real y, real lat,
                      int prec, std::string& mgrs) {
+    char mgrs1[MAXBUF];
+    Forward(zone, northp, x, y, lat, prec, mgrs1);
+    mgrs = mgrs1;
+  }
+
+  void MGRS::Forward(int zone, bool northp, real x, real y, real lat,
+                     int prec, char mgrs[]) {
     using std::isnan;           // Needed for Centos 7, ubuntu 14
     // The smallest angle s.t., 90 - angeps() < 90 (approx 50e-12 arcsec)
     // 7 = ceil(log_2(90))
     static const real angeps = ldexp(real(1), -(Math::digits() - 7));
     if (zone == UTMUPS::INVALID ||
         isnan(x) || isnan(y) || isnan(lat)) {
-      mgrs = "INVALID";
+      copy_n("INVALID", 8, mgrs);
       return;
     }
     bool utmp = zone != 0;
@@ -115,19 +123,38 @@ namespace GeographicLib {
     }
     if (prec > 0) {
       ix -= m * xh; iy -= m * yh;
-      long long d = (long long)(pow(real(base_), maxprec_ - prec));
+      long long d = 1;
+      for (int c = prec; c < maxprec_; ++c) d *= base_;
       ix /= d; iy /= d;
       for (int c = prec; c--;) {
         mgrs1[z + c       ] = digits_[ix % base_]; ix /= base_;
         mgrs1[z + c + prec] = digits_[iy % base_]; iy /= base_;
       }
     }
-    mgrs.resize(mlen);
-    copy(mgrs1, mgrs1 + mlen, mgrs.begin());
+    copy(mgrs1, mgrs1 + mlen, mgrs);
+    mgrs[mlen] = '\0';
   }
 
   void MGRS::Forward(int zone, bool northp, real x, real y,
                      int prec, std::string& mgrs) {
+    char mgrs1[MAXBUF];
+    Forward(zone, northp, x, y, prec, mgrs1);
+    mgrs = mgrs1;
+  }
+
+  void MGRS::Forward(size_t n, const int zone[], const bool northp[],
+                     const real x[], const real y[],
+                     int prec, char mgrs[], size_t width) {
+    if (width < 8 || int(width) < 6 + 2 * prec)
+      throw GeographicErr("Width " + Utility::str(width)
+                          + " too small for MGRS precision "
+                          + Utility::str(prec));
+    for (size_t i = 0; i < n; ++i)
+      Forward(zone[i], northp[i], x[i], y[i], prec, mgrs + i * width);
+  }
+
+  void MGRS::Forward(int zone, bool northp, real x, real y,
+                     int prec, char mgrs[]) {
     real lat, lon;
     if (zone > 0) {
       // Does a rough estimate for latitude determine the latitude band?
@@ -164,22 +191,67 @@ namespace GeographicLib {
   void MGRS::Reverse(const string& mgrs,
                      int& zone, bool& northp, real& x, real& y,
                      int& prec, bool centerp) {
-    int
-      p = 0,
-      len = int(mgrs.length());
+    GenReverse(mgrs.data(), int(mgrs.length()),
+               zone, northp, x, y, prec, centerp);
+  }
+
+  void MGRS::Reverse(const char* mgrs,
+                     int& zone, bool& northp, real& x, real& y,
+                     int& prec, bool centerp) {
+    GenReverse(mgrs, int(strlen(mgrs)), zone, northp, x, y, prec, centerp);
+  }
+
+  void MGRS::Reverse(size_t n, const char mgrs[], size_t width,
+                     int zone[], bool northp[], real x[], real y[],
+                     int prec[], bool centerp) {
+    for (size_t i = 0; i < n; ++i) {
+      const char* m = mgrs + i * width;
+      int len = 0, prec1;
+      while (len < int(width) && m[len]) ++len;
+      GenReverse(m, len, zone[i], northp[i], x[i], y[i], prec1, centerp);
+      if (prec) prec[i] = prec1;
+    }
+  }
+
+  void MGRS::Decode(const char* mgrs, int& zone, bool& northp,
+                    long long& ix, long long& iy, int& prec) {
+    GenDecode(mgrs, int(strlen(mgrs)), zone, northp, ix, iy, prec);
+  }
+
+  void MGRS::Decode(size_t n, const char mgrs[], size_t width,
+                    int zone[], bool northp[],
+                    long long ix[], long long iy[], int prec[]) {
+    for (size_t i = 0; i < n; ++i) {
+      const char* m = mgrs + i * width;
+      int len = 0;
+      while (len < int(width) && m[len]) ++len;
+      GenDecode(m, len, zone[i], northp[i], ix[i], iy[i], prec[i]);
+    }
+  }
+
+  void MGRS::GenDecode(const char* mgrs, int len,
+                       int& zone, bool& northp,
+                       long long& ix, long long& iy, int& prec) {
+    // Only construct a string when reporting an error
+    auto sub = [mgrs, len] (int beg, int num) -> string
+      { return string(mgrs + beg, min(num, len - beg)); };
+    // Equivalent to digit(c), but faster
+    auto digit = [] (char c) -> int
+      { return c >= '0' && c <= '9' ? c - '0' : -1; };
+    int p = 0;
     if (len >= 3 &&
         toupper(mgrs[0]) == 'I' &&
         toupper(mgrs[1]) == 'N' &&
         toupper(mgrs[2]) == 'V') {
       zone = UTMUPS::INVALID;
       northp = false;
-      x = y = Math::NaN();
+      ix = iy = 0;
       prec = -2;
       return;
     }
     int zone1 = 0;
     while (p < len) {
-      int i = Utility::lookup(digits_, mgrs[p]);
+      int i = digit(mgrs[p]);
       if (i < 0)
         break;
       zone1 = 10 * zone1 + i;
@@ -189,9 +261,9 @@ namespace GeographicLib {
       throw GeographicErr("Zone " + Utility::str(zone1) + " not in [1,60]");
     if (p > 2)
       throw GeographicErr("More than 2 digits at start of MGRS "
-                          + mgrs.substr(0, p));
+                          + sub(0, p));
     if (len - p < 1)
-      throw GeographicErr("MGRS string too short " + mgrs);
+      throw GeographicErr("MGRS string too short " + sub(0, len));
     bool utmp = zone1 != UTMUPS::UPS;
     int zonem1 = zone1 - 1;
     const char* band = utmp ? latband_ : upsband_;
@@ -207,28 +279,28 @@ namespace GeographicLib {
       northp = northp1;
       if (utmp) {
         // Pick central meridian except for 31V
-        x = ((zone == 31 && iband == 17) ? 4 : 5) * tile_;
+        ix = (zone == 31 && iband == 17) ? 4 : 5;
         // Pick center of 8deg latitude bands
-        y = floor(8 * (iband - real(9.5)) * deg + real(0.5)) * tile_
-          + (northp ? 0 : utmNshift_);
+        iy = (long long)(floor(8 * (iband - real(9.5)) * deg + real(0.5)))
+          + (northp ? 0 : utmNshift_ / tile_);
       } else {
         // Pick point at lat 86N or 86S
-        x = ((iband & 1 ? 1 : -1) * floor(4 * deg + real(0.5))
-             + upseasting_) * tile_;
+        ix = (iband & 1 ? 1 : -1) * (long long)(floor(4 * deg + real(0.5)))
+          + upseasting_;
         // Pick point at lon 90E or 90W.
-        y = upseasting_ * tile_;
+        iy = upseasting_;
       }
       prec = -1;
       return;
     } else if (len - p < 2)
-      throw GeographicErr("Missing row letter in " + mgrs);
+      throw GeographicErr("Missing row letter in " + sub(0, len));
     const char* col = utmp ? utmcols_[zonem1 % 3] : upscols_[iband];
     const char* row = utmp ? utmrow_ : upsrows_[northp1];
     int icol = Utility::lookup(col, mgrs[p++]);
     if (icol < 0)
       throw GeographicErr("Column letter " + Utility::str(mgrs[p-1])
                           + " not in "
-                          + (utmp ? "zone " + mgrs.substr(0, p-2) :
+                          + (utmp ? "zone " + sub(0, p-2) :
                              "UPS band " + Utility::str(mgrs[p-2]))
                           + " set " + col );
     int irow = Utility::lookup(row, mgrs[p++]);
@@ -243,8 +315,8 @@ namespace GeographicLib {
       iband -= 10;
       irow = UTMRow(iband, icol, irow);
       if (irow == maxutmSrow_)
-        throw GeographicErr("Block " + mgrs.substr(p-2, 2)
-                            + " not in zone/band " + mgrs.substr(0, p-2));
+        throw GeographicErr("Block " + sub(p-2, 2)
+                            + " not in zone/band " + sub(0, p-2));
 
       irow = northp1 ? irow : irow + 100;
       icol = icol + minutmcol_;
@@ -254,38 +326,66 @@ namespace GeographicLib {
       irow += northp1 ? minupsNind_ : minupsSind_;
     }
     int prec1 = (len - p)/2;
-    real
-      unit = 1,
+    long long
       x1 = icol,
       y1 = irow;
     for (int i = 0; i < prec1; ++i) {
-      unit *= base_;
       int
-        ix = Utility::lookup(digits_, mgrs[p + i]),
-        iy = Utility::lookup(digits_, mgrs[p + i + prec1]);
-      if (ix < 0 || iy < 0)
-        throw GeographicErr("Encountered a non-digit in " + mgrs.substr(p));
-      x1 = base_ * x1 + ix;
-      y1 = base_ * y1 + iy;
+        dx = digit(mgrs[p + i]),
+        dy = digit(mgrs[p + i + prec1]);
+      if (dx < 0 || dy < 0)
+        throw GeographicErr("Encountered a non-digit in " + sub(p, len));
+      if (i < maxprec_) {     // Excess digits are an error (see below)
+        x1 = base_ * x1 + dx;
+        y1 = base_ * y1 + dy;
+      }
     }
     if ((len - p) % 2) {
-      if (Utility::lookup(digits_, mgrs[len - 1]) < 0)
-        throw GeographicErr("Encountered a non-digit in " + mgrs.substr(p));
+      if (digit(mgrs[len - 1]) < 0)
+        throw GeographicErr("Encountered a non-digit in " + sub(p, len));
       else
         throw GeographicErr("Not an even number of digits in "
-                            + mgrs.substr(p));
+                            + sub(p, len));
     }
     if (prec1 > maxprec_)
       throw GeographicErr("More than " + Utility::str(2*maxprec_)
-                          + " digits in " + mgrs.substr(p));
+                          + " digits in " + sub(p, len));
+    zone = zone1;
+    northp = northp1;
+    ix = x1;
+    iy = y1;
+    prec = prec1;
+  }
+
+  void MGRS::GenReverse(const char* mgrs, int len,
+                        int& zone, bool& northp, real& x, real& y,
+                        int& prec, bool centerp) {
+    long long ix, iy;
+    int zone1, prec1;
+    bool northp1;
+    GenDecode(mgrs, len, zone1, northp1, ix, iy, prec1);
+    zone = zone1;
+    northp = northp1;
+    prec = prec1;
+    if (prec1 == -2)
+      x = y = Math::NaN();
+    else if (prec1 == -1) {
+      x = real(ix) * tile_;
+      y = real(iy) * tile_;
+    } else
+      Position(ix, iy, prec1, centerp, x, y);
+  }
+
+  void MGRS::Position(long long ix, long long iy, int prec, bool centerp,
+                      real& x, real& y) {
+    real unit = 1, x1 = real(ix), y1 = real(iy);
+    for (int i = 0; i < prec; ++i)
+      unit *= base_;
     if (centerp) {
       unit *= 2; x1 = 2 * x1 + 1; y1 = 2 * y1 + 1;
     }
-    zone = zone1;
-    northp = northp1;
     x = (tile_ * x1) / unit;
     y = (tile_ * y1) / unit;
-    prec = prec1;
   }
 
   void MGRS::CheckCoords(bool utmp, bool& northp, real& x, real& y) {
@@ -0,0 +1,126 @@
+/**
+ * \file MGRSCache.cpp
+ * \brief Implementation for GeographicLib::MGRSCache class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/MGRSCache.hpp>
+#include <cstdint>
+#include <cstring>
+#include <GeographicLib/MGRS.hpp>
+#include <GeographicLib/UTMUPS.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  namespace {
+    // The splitmix64 finalizer; every bit of x affects every bit of the
+    // result.
+    uint64_t Mix(uint64_t x) {
+      x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+      return x ^ (x >> 31);
+    }
+  }
+
+  bool MGRSCache::Key::operator==(const Key& k) const {
+    return ix == k.ix && iy == k.iy &&
+      zone == k.zone && prec == k.prec && northp == k.northp;
+  }
+
+  size_t MGRSCache::Hash::operator()(const Key& k) const {
+    uint64_t h = uint64_t(k.zone) << 8 | uint64_t(k.prec + 2) << 1 |
+      uint64_t(k.northp);
+    h = Mix(h ^ uint64_t(k.ix));
+    return size_t(Mix(h ^ uint64_t(k.iy)));
+  }
+
+  MGRSCache::MGRSCache(size_t maxsize, bool centerp)
+    : _maxsize(maxsize)
+    , _centerp(centerp)
+    , _hits(0)
+    , _misses(0)
+  {}
+
+  void MGRSCache::GenReverse(const char* mgrs,
+                             real& lat, real& lon, int& prec) {
+    Key k;
+    MGRS::Decode(mgrs, k.zone, k.northp, k.ix, k.iy, k.prec);
+    if (k.zone == UTMUPS::INVALID) {
+      lat = lon = Math::NaN();
+      prec = k.prec;
+      return;
+    }
+    {
+      lock_guard<mutex> guard(_lock);
+      auto p = _map.find(k);
+      if (p != _map.end()) {
+        ++_hits;
+        _list.splice(_list.begin(), _list, p->second);
+        lat = p->second->second.first;
+        lon = p->second->second.second;
+        prec = k.prec;
+        return;
+      }
+      ++_misses;
+    }
+    // Evaluate the projection with the lock released so that other threads
+    // can consult the cache in the meantime.
+    int zone, prec1; bool northp; real x, y, lat1, lon1;
+    MGRS::Reverse(mgrs, zone, northp, x, y, prec1, _centerp);
+    UTMUPS::Reverse(zone, northp, x, y, lat1, lon1);
+    {
+      lock_guard<mutex> guard(_lock);
+      if (_maxsize > 0 && _map.find(k) == _map.end()) {
+        _list.emplace_front(k, Value(lat1, lon1));
+        _map[k] = _list.begin();
+        while (_list.size() > _maxsize) {
+          _map.erase(_list.back().first);
+          _list.pop_back();
+        }
+      }
+    }
+    lat = lat1;
+    lon = lon1;
+    prec = prec1;
+  }
+
+  void MGRSCache::Reverse(size_t n, const char mgrs[], size_t width,
+                          real lat[], real lon[], int prec[]) {
+    // GenReverse needs a null-terminated string
+    char buf[MGRS::MAXBUF];
+    for (size_t i = 0; i < n; ++i) {
+      const char* m = mgrs + i * width;
+      size_t len = 0;
+      while (len < width && m[len]) ++len;
+      int prec1;
+      if (len < sizeof(buf)) {
+        memcpy(buf, m, len); buf[len] = '\0';
+        GenReverse(buf, lat[i], lon[i], prec1);
+      } else
+        // Too long to be legal (unless it starts with INV)
+        GenReverse(string(m, len).c_str(), lat[i], lon[i], prec1);
+      if (prec) prec[i] = prec1;
+    }
+  }
+
+  void MGRSCache::Clear() {
+    lock_guard<mutex> guard(_lock);
+    _list.clear(); _map.clear();
+    _hits = _misses = 0;
+  }
+
+  size_t MGRSCache::Size() const
+  { lock_guard<mutex> guard(_lock); return _list.size(); }
+
+  unsigned long long MGRSCache::Hits() const
+  { lock_guard<mutex> guard(_lock); return _hits; }
+
+  unsigned long long MGRSCache::Misses() const
+  { lock_guard<mutex> guard(_lock); return _misses; }
+
+} // namespace GeographicLib
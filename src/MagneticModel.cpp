@@ -12,6 +12,7 @@
 #include <GeographicLib/SphericalEngine.hpp>
 #include <GeographicLib/MagneticCircle.hpp>
 #include <GeographicLib/Utility.hpp>
+#include <GeographicLib/Tracer.hpp>
 
 #if !defined(GEOGRAPHICLIB_DATA)
 #  if defined(_WIN32)
@@ -35,7 +36,8 @@ namespace GeographicLib {
   using namespace std;
 
   MagneticModel::MagneticModel(const std::string& name, const std::string& path,
-                               const Geocentric& earth, int Nmax, int Mmax)
+                               const Geocentric& earth, int Nmax, int Mmax,
+                               bool single)
     : _name(name)
     , _dir(path)
     , _description("NONE")
@@ -54,6 +56,7 @@ namespace GeographicLib {
     , _norm(SphericalHarmonic::SCHMIDT)
     , _earth(earth)
   {
+    Tracer::Span span("MagneticModel::MagneticModel", _name.c_str());
     if (_dir.empty())
       _dir = DefaultMagneticPath();
     bool truncate = Nmax >= 0 || Mmax >= 0;
@@ -65,6 +68,10 @@ namespace GeographicLib {
     ReadMetadata(_name);
     _gG.resize(_nNmodels + 1 + _nNconstants);
     _hH.resize(_nNmodels + 1 + _nNconstants);
+    if (single) {
+      _gGf.resize(_nNmodels + 1 + _nNconstants);
+      _hHf.resize(_nNmodels + 1 + _nNconstants);
+    }
     {
       string coeff = _filename + ".cof";
       ifstream coeffstr(coeff.c_str(), ios::binary);
@@ -80,11 +87,19 @@ namespace GeographicLib {
       for (int i = 0; i < _nNmodels + 1 + _nNconstants; ++i) {
         int N, M;
         if (truncate) { N = Nmax; M = Mmax; }
-        SphericalEngine::coeff::readcoeffs(coeffstr, N, M, _gG[i], _hH[i],
-                                           truncate);
-        if (!(M < 0 || _gG[i][0] == 0))
+        SphericalEngine::coeff c;
+        if (single) {
+          SphericalEngine::coeff::readcoeffs(coeffstr, N, M, _gGf[i], _hHf[i],
+                                             truncate);
+          c = SphericalEngine::coeff(_gGf[i], _hHf[i], N, N, M);
+        } else {
+          SphericalEngine::coeff::readcoeffs(coeffstr, N, M, _gG[i], _hH[i],
+                                             truncate);
+          c = SphericalEngine::coeff(_gG[i], _hH[i], N, N, M);
+        }
+        if (!(M < 0 || c.Cv(0) == 0))
           throw GeographicErr("A degree 0 term is not permitted");
-        _harm.push_back(SphericalHarmonic(_gG[i], _hH[i], N, N, M, _a, _norm));
+        _harm.push_back(SphericalHarmonic(c, _a, _norm));
         _nmx = max(_nmx, _harm.back().Coefficients().nmx());
         _mmx = max(_mmx, _harm.back().Coefficients().mmx());
       }
@@ -95,9 +110,33 @@ namespace GeographicLib {
     }
   }
 
+  future< unique_ptr<MagneticModel> >
+  MagneticModel::Load(const string& name, const string& path,
+                      const Geocentric& earth, int Nmax, int Mmax,
+                      bool single) {
+    const int ndigits = Math::digits();
+    return async(launch::async,
+                 [name, path, earth, Nmax, Mmax, single, ndigits]()
+                 -> unique_ptr<MagneticModel> {
+                   Math::set_digits(ndigits);
+                   return unique_ptr<MagneticModel>
+                     (new MagneticModel(name, path, earth, Nmax, Mmax, single));
+                 });
+  }
+
+  MagneticModel::Memory MagneticModel::MemoryUsage() const {
+    Memory m;
+    for (const auto& v : _gG) m.coefficients += v.capacity() * sizeof(real);
+    for (const auto& v : _hH) m.coefficients += v.capacity() * sizeof(real);
+    for (const auto& v : _gGf) m.coefficients += v.capacity() * sizeof(float);
+    for (const auto& v : _hHf) m.coefficients += v.capacity() * sizeof(float);
+    return m;
+  }
+
   void MagneticModel::ReadMetadata(const string& name) {
     const char* spaces = " \t\n\v\f\r";
     _filename = _dir + "/" + name + ".wmm";
+    Tracer::Span span("MagneticModel::ReadMetadata", _filename.c_str());
     ifstream metastr(_filename.c_str());
     if (!metastr.good())
       throw GeographicErr("Cannot open " + _filename);
@@ -182,29 +221,49 @@ namespace GeographicLib {
     }
   }
 
-  void MagneticModel::FieldGeocentric(real t, real X, real Y, real Z,
-                                      real& BX, real& BY, real& BZ,
-                                      real& BXt, real& BYt, real& BZt) const {
+  int MagneticModel::Interval(real& t) const {
     t -= _t0;
     int n = max(min(int(floor(t / _dt0)), _nNmodels - 1), 0);
-    bool interpolate = n + 1 < _nNmodels;
     t -= n * _dt0;
-    // Components in geocentric basis
+    return n;
+  }
+
+  void MagneticModel::FieldSums(int n, real X, real Y, real Z, real S[])
+    const {
     // initial values to suppress warning
-    real BXc = 0, BYc = 0, BZc = 0;
-    _harm[n](X, Y, Z, BX, BY, BZ);
-    _harm[n + 1](X, Y, Z, BXt, BYt, BZt);
-    if (_nNconstants)
-      _harm[_nNmodels + 1](X, Y, Z, BXc, BYc, BZc);
+    S[6] = S[7] = S[8] = 0;
+    // The two or three sums share the recurrence factors
+    const SphericalEngine::coeff c[] = {
+      _harm[n].Coefficients(), _harm[n + 1].Coefficients(),
+      _harm[_nNconstants ? _nNmodels + 1 : n].Coefficients()
+    };
+    const int K = _nNconstants ? 3 : 2;
+    real V[3], gx[3], gy[3], gz[3];
+    if (_norm == SphericalHarmonic::FULL)
+      SphericalEngine::Sums<true, SphericalEngine::FULL>
+        (K, c, X, Y, Z, _a, V, gx, gy, gz);
+    else
+      SphericalEngine::Sums<true, SphericalEngine::SCHMIDT>
+        (K, c, X, Y, Z, _a, V, gx, gy, gz);
+    for (int k = 0; k < K; ++k) {
+      S[3 * k] = gx[k]; S[3 * k + 1] = gy[k]; S[3 * k + 2] = gz[k];
+    }
+  }
+
+  void MagneticModel::FieldCombine(real t, bool interpolate, const real S[],
+                                   real& BX, real& BY, real& BZ,
+                                   real& BXt, real& BYt, real& BZt) const {
+    BX = S[0]; BY = S[1]; BZ = S[2];
+    BXt = S[3]; BYt = S[4]; BZt = S[5];
     if (interpolate) {
       // Convert to a time derivative
       BXt = (BXt - BX) / _dt0;
       BYt = (BYt - BY) / _dt0;
       BZt = (BZt - BZ) / _dt0;
     }
-    BX += t * BXt + BXc;
-    BY += t * BYt + BYc;
-    BZ += t * BZt + BZc;
+    BX += t * BXt + S[6];
+    BY += t * BYt + S[7];
+    BZ += t * BZt + S[8];
 
     BXt = BXt * - _a;
     BYt = BYt * - _a;
@@ -215,6 +274,16 @@ namespace GeographicLib {
     BZ *= - _a;
   }
 
+  void MagneticModel::FieldGeocentric(real t, real X, real Y, real Z,
+                                      real& BX, real& BY, real& BZ,
+                                      real& BXt, real& BYt, real& BZt) const {
+    int n = Interval(t);
+    // Components in geocentric basis
+    real S[9];
+    FieldSums(n, X, Y, Z, S);
+    FieldCombine(t, n + 1 < _nNmodels, S, BX, BY, BZ, BXt, BYt, BZt);
+  }
+
   void MagneticModel::Field(real t, real lat, real lon, real h, bool diffp,
                             real& Bx, real& By, real& Bz,
                             real& Bxt, real& Byt, real& Bzt) const {
@@ -230,6 +299,138 @@ namespace GeographicLib {
     Geocentric::Unrotate(M, BX, BY, BZ, Bx, By, Bz);
   }
 
+  void MagneticModel::operator()(size_t n, const real t[],
+                                 real lat, real lon, real h,
+                                 real Bx[], real By[], real Bz[],
+                                 real Bxt[], real Byt[], real Bzt[]) const {
+    real X, Y, Z;
+    real M[Geocentric::dim2_];
+    _earth.IntForward(lat, lon, h, X, Y, Z, M);
+    real S[9];
+    int k0 = -1;
+    for (size_t i = 0; i < n; ++i) {
+      real t1 = t[i];
+      int k = Interval(t1);
+      if (k != k0) {
+        FieldSums(k, X, Y, Z, S);
+        k0 = k;
+      }
+      real BX, BY, BZ, BXt, BYt, BZt;
+      FieldCombine(t1, k + 1 < _nNmodels, S, BX, BY, BZ, BXt, BYt, BZt);
+      if (Bxt)
+        Geocentric::Unrotate(M, BXt, BYt, BZt, Bxt[i], Byt[i], Bzt[i]);
+      Geocentric::Unrotate(M, BX, BY, BZ, Bx[i], By[i], Bz[i]);
+    }
+  }
+
+  void MagneticModel::operator()(size_t n, const real t[],
+                                 const real lat[], const real lon[],
+                                 const real h[],
+                                 real Bx[], real By[], real Bz[],
+                                 real Bxt[], real Byt[], real Bzt[]) const {
+    const size_t dim2 = Geocentric::dim2_;
+    vector<real> X(n), Y(n), Z(n), M(dim2 * n), t1(t, t + n), S(9 * n, 0);
+    vector<int> k(n);
+    for (size_t i = 0; i < n; ++i) {
+      _earth.IntForward(lat[i], lon[i], h[i], X[i], Y[i], Z[i],
+                        M.data() + dim2 * i);
+      k[i] = Interval(t1[i]);
+    }
+    // Evaluate the sums for the points in each interval together.
+    vector<size_t> ind;
+    vector<real> x, y, z, v, gx, gy, gz;
+    for (int m = 0; m < _nNmodels; ++m) {
+      ind.clear();
+      for (size_t i = 0; i < n; ++i)
+        if (k[i] == m) ind.push_back(i);
+      size_t l = ind.size();
+      if (l == 0) continue;
+      x.resize(l); y.resize(l); z.resize(l);
+      v.resize(l); gx.resize(l); gy.resize(l); gz.resize(l);
+      for (size_t j = 0; j < l; ++j) {
+        x[j] = X[ind[j]]; y[j] = Y[ind[j]]; z[j] = Z[ind[j]];
+      }
+      for (int j = 0; j < (_nNconstants ? 3 : 2); ++j) {
+        _harm[j < 2 ? m + j : _nNmodels + 1]
+          (l, x.data(), y.data(), z.data(),
+           v.data(), gx.data(), gy.data(), gz.data());
+        for (size_t i = 0; i < l; ++i) {
+          real* Si = S.data() + 9 * ind[i] + 3 * j;
+          Si[0] = gx[i]; Si[1] = gy[i]; Si[2] = gz[i];
+        }
+      }
+    }
+    for (size_t i = 0; i < n; ++i) {
+      real BX, BY, BZ, BXt, BYt, BZt;
+      const real* Mi = M.data() + dim2 * i;
+      FieldCombine(t1[i], k[i] + 1 < _nNmodels, S.data() + 9 * i,
+                   BX, BY, BZ, BXt, BYt, BZt);
+      if (Bxt)
+        Geocentric::Unrotate(Mi, BXt, BYt, BZt, Bxt[i], Byt[i], Bzt[i]);
+      Geocentric::Unrotate(Mi, BX, BY, BZ, Bx[i], By[i], Bz[i]);
+    }
+  }
+
+  void MagneticModel::Ensemble(size_t n, const MagneticModel* const models[],
+                               real t, real lat, real lon, real h,
+                               real Bx[], real By[], real Bz[],
+                               real Bxt[], real Byt[], real Bzt[]) {
+    if (n == 0) return;
+    const MagneticModel& m0 = *models[0];
+    real X, Y, Z;
+    real M[Geocentric::dim2_];
+    m0._earth.IntForward(lat, lon, h, X, Y, Z, M);
+    // The models evaluated together, their reduced times and intervals, and
+    // the coefficients of their sums (two or three for each model).
+    vector<size_t> ind;
+    vector<real> t1;
+    vector<int> k;
+    vector<SphericalEngine::coeff> c;
+    for (size_t i = 0; i < n; ++i) {
+      const MagneticModel& mi = *models[i];
+      if (!(mi._a == m0._a && mi._norm == m0._norm &&
+            mi._earth.EquatorialRadius() == m0._earth.EquatorialRadius() &&
+            mi._earth.Flattening() == m0._earth.Flattening())) {
+        real bxt, byt, bzt;
+        mi.Field(t, lat, lon, h, Bxt != nullptr, Bx[i], By[i], Bz[i],
+                 Bxt ? Bxt[i] : bxt, Byt ? Byt[i] : byt, Bzt ? Bzt[i] : bzt);
+        continue;
+      }
+      real ti = t;
+      int ki = mi.Interval(ti);
+      ind.push_back(i); t1.push_back(ti); k.push_back(ki);
+      c.push_back(mi._harm[ki].Coefficients());
+      c.push_back(mi._harm[ki + 1].Coefficients());
+      if (mi._nNconstants)
+        c.push_back(mi._harm[mi._nNmodels + 1].Coefficients());
+    }
+    if (ind.empty()) return;
+    const int K = int(c.size());
+    vector<real> V(K), gx(K), gy(K), gz(K);
+    if (m0._norm == SphericalHarmonic::FULL)
+      SphericalEngine::Sums<true, SphericalEngine::FULL>
+        (K, c.data(), X, Y, Z, m0._a, V.data(),
+         gx.data(), gy.data(), gz.data());
+    else
+      SphericalEngine::Sums<true, SphericalEngine::SCHMIDT>
+        (K, c.data(), X, Y, Z, m0._a, V.data(),
+         gx.data(), gy.data(), gz.data());
+    for (size_t l = 0, j = 0; l < ind.size(); ++l) {
+      const MagneticModel& mi = *models[ind[l]];
+      real S[9] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+      for (int q = 0; q < (mi._nNconstants ? 3 : 2); ++q, ++j) {
+        S[3 * q] = gx[j]; S[3 * q + 1] = gy[j]; S[3 * q + 2] = gz[j];
+      }
+      real BX, BY, BZ, BXt, BYt, BZt;
+      mi.FieldCombine(t1[l], k[l] + 1 < mi._nNmodels, S,
+                      BX, BY, BZ, BXt, BYt, BZt);
+      const size_t i = ind[l];
+      if (Bxt)
+        Geocentric::Unrotate(M, BXt, BYt, BZt, Bxt[i], Byt[i], Bzt[i]);
+      Geocentric::Unrotate(M, BX, BY, BZ, Bx[i], By[i], Bz[i]);
+    }
+  }
+
   MagneticCircle MagneticModel::Circle(real t, real lat, real h) const {
     real t1 = t - _t0;
     int n = max(min(int(floor(t1 / _dt0)), _nNmodels - 1), 0);
@@ -8,6 +8,7 @@
  **********************************************************************/
 
 #include <GeographicLib/Math.hpp>
+#include <GeographicLib/MathInline.hpp>
 
 #if defined(_MSC_VER)
 // Squelch warnings about constant conditional and enum-float expressions
@@ -54,97 +55,6 @@ namespace GeographicLib {
       digits10() - numeric_limits<double>::digits10 : 0;
   }
 
-  template<typename T> T Math::sum(T u, T v, T& t) {
-    GEOGRAPHICLIB_VOLATILE T s = u + v;
-    GEOGRAPHICLIB_VOLATILE T up = s - v;
-    GEOGRAPHICLIB_VOLATILE T vpp = s - up;
-    up -= u;
-    vpp -= v;
-    // if s = 0, then t = 0 and give t the same sign as s
-    // mpreal needs T(0) here
-    t = s != 0 ? T(0) - (up + vpp) : s;
-    // u + v =       s      + t
-    //       = round(u + v) + t
-    return s;
-  }
-
-  template<typename T> T Math::AngNormalize(T x) {
-    T y = remainder(x, T(td));
-#if GEOGRAPHICLIB_PRECISION == 4
-    // boost-quadmath doesn't set the sign of 0 correctly, see
-    // https://github.com/boostorg/multiprecision/issues/426
-    // Fixed by https://github.com/boostorg/multiprecision/pull/428
-    if (y == 0) y = copysign(y, x);
-#endif
-    return fabs(y) == T(hd) ? copysign(T(hd), x) : y;
-  }
-
-  template<typename T> T Math::AngDiff(T x, T y, T& e) {
-    // Use remainder instead of AngNormalize, since we treat boundary cases
-    // later taking account of the error
-    T d = sum(remainder(-x, T(td)), remainder( y, T(td)), e);
-    // This second sum can only change d if abs(d) < 128, so don't need to
-    // apply remainder yet again.
-    d = sum(remainder(d, T(td)), e, e);
-    // Fix the sign if d = -180, 0, 180.
-    if (d == 0 || fabs(d) == hd)
-      // If e == 0, take sign from y - x
-      // else (e != 0, implies d = +/-180), d and e must have opposite signs
-      d = copysign(d, e == 0 ? y - x : -e);
-    return d;
-  }
-
-  template<typename T> T Math::AngRound(T x) {
-    static const T z = T(1)/T(16);
-    GEOGRAPHICLIB_VOLATILE T y = fabs(x);
-    GEOGRAPHICLIB_VOLATILE T w = z - y;
-    // The compiler mustn't "simplify" z - (z - y) to y
-    y = w > 0 ? z - w : y;
-    return copysign(y, x);
-  }
-
-  template<typename T> void Math::sincosd(T x, T& sinx, T& cosx) {
-    // In order to minimize round-off errors, this function exactly reduces
-    // the argument to the range [-45, 45] before converting it to radians.
-    T r; int q = 0;
-    r = remquo(x, T(qd), &q);   // now abs(r) <= 45
-    r *= degree<T>();
-    // g++ -O turns these two function calls into a call to sincos
-    T s = sin(r), c = cos(r);
-    switch (unsigned(q) & 3U) {
-    case 0U: sinx =  s; cosx =  c; break;
-    case 1U: sinx =  c; cosx = -s; break;
-    case 2U: sinx = -s; cosx = -c; break;
-    default: sinx = -c; cosx =  s; break; // case 3U
-    }
-    // http://www.open-std.org/jtc1/sc22/wg14/www/docs/n1950.pdf
-    // mpreal needs T(0) here
-    cosx += T(0);                            // special values from F.10.1.12
-    if (sinx == 0) sinx = copysign(sinx, x); // special values from F.10.1.13
-  }
-
-  template<typename T> void Math::sincosde(T x, T t, T& sinx, T& cosx) {
-    // In order to minimize round-off errors, this function exactly reduces
-    // the argument to the range [-45, 45] before converting it to radians.
-    // This implementation allows x outside [-180, 180], but implementations in
-    // other languages may not.
-    T r; int q = 0;
-    r = AngRound(remquo(x, T(qd), &q) + t); // now abs(r) <= 45
-    r *= degree<T>();
-    // g++ -O turns these two function calls into a call to sincos
-    T s = sin(r), c = cos(r);
-    switch (unsigned(q) & 3U) {
-    case 0U: sinx =  s; cosx =  c; break;
-    case 1U: sinx =  c; cosx = -s; break;
-    case 2U: sinx = -s; cosx = -c; break;
-    default: sinx = -c; cosx =  s; break; // case 3U
-    }
-    // http://www.open-std.org/jtc1/sc22/wg14/www/docs/n1950.pdf
-    // mpreal needs T(0) here
-    cosx += T(0);                            // special values from F.10.1.12
-    if (sinx == 0) sinx = copysign(sinx, x); // special values from F.10.1.13
-  }
-
   template<typename T> T Math::sind(T x) {
     // See sincosd
     T r; int q = 0;
@@ -180,25 +90,6 @@ namespace GeographicLib {
     return min(max(r, -overflow), overflow);
   }
 
-  template<typename T> T Math::atan2d(T y, T x) {
-    // In order to minimize round-off errors, this function rearranges the
-    // arguments so that result of atan2 is in the range [-pi/4, pi/4] before
-    // converting it to degrees and mapping the result to the correct
-    // quadrant.
-    int q = 0;
-    if (fabs(y) > fabs(x)) { swap(x, y); q = 2; }
-    if (signbit(x)) { x = -x; ++q; }
-    // here x >= 0 and x >= abs(y), so angle is in [-pi/4, pi/4]
-    T ang = atan2(y, x) / degree<T>();
-    switch (q) {
-    case 1: ang = copysign(T(hd), y) - ang; break;
-    case 2: ang =            qd      - ang; break;
-    case 3: ang =           -qd      + ang; break;
-    default: break;
-    }
-    return ang;
-  }
-
   template<typename T> T Math::atand(T x)
   { return atan2d(x, T(1)); }
 
@@ -247,6 +138,48 @@ namespace GeographicLib {
     return tau;
   }
 
+  // The array versions loop over the scalar functions; these are defined in
+  // this file and so are expanded inline.  The exact reduction of the
+  // arguments (via remquo and remainder) and the treatment of the special
+  // cases preclude the use of vector instructions for the whole calculation,
+  // but keeping the loop in the library avoids a call per element and lets
+  // the compiler schedule the independent evaluations together.
+  template<typename T> void Math::sincosd(size_t n, const T x[],
+                                          T sinx[], T cosx[]) {
+    for (size_t i = 0; i < n; ++i) {
+      T s, c;
+      sincosd(x[i], s, c);
+      sinx[i] = s; cosx[i] = c;
+    }
+  }
+
+  template<typename T> void Math::atan2d(size_t n, const T y[],
+                                         const T x[], T ang[]) {
+    for (size_t i = 0; i < n; ++i)
+      ang[i] = atan2d(y[i], x[i]);
+  }
+
+  template<typename T> void Math::AngNormalize(size_t n, const T x[],
+                                               T y[]) {
+    for (size_t i = 0; i < n; ++i)
+      y[i] = AngNormalize(x[i]);
+  }
+
+  template<typename T> void Math::AngDiff(size_t n, const T x[],
+                                          const T y[], T d[], T e[]) {
+    for (size_t i = 0; i < n; ++i) {
+      T t;
+      d[i] = AngDiff(x[i], y[i], t);
+      if (e) e[i] = t;
+    }
+  }
+
+  template<typename T> void Math::tauf(size_t n, const T taup[], T es,
+                                       T tau[]) {
+    for (size_t i = 0; i < n; ++i)
+      tau[i] = tauf(taup[i], es);
+  }
+
   template<typename T> T Math::NaN() {
 #if defined(_MSC_VER)
     return numeric_limits<T>::has_quiet_NaN ?
@@ -289,7 +222,17 @@ namespace GeographicLib {
   template T    GEOGRAPHICLIB_EXPORT Math::taupf        <T>(T, T);         \
   template T    GEOGRAPHICLIB_EXPORT Math::tauf         <T>(T, T);         \
   template T    GEOGRAPHICLIB_EXPORT Math::NaN          <T>();             \
-  template T    GEOGRAPHICLIB_EXPORT Math::infinity     <T>();
+  template T    GEOGRAPHICLIB_EXPORT Math::infinity     <T>();             \
+  template void GEOGRAPHICLIB_EXPORT Math::sincosd                         \
+  <T>(size_t, const T[], T[], T[]);                                        \
+  template void GEOGRAPHICLIB_EXPORT Math::atan2d                          \
+  <T>(size_t, const T[], const T[], T[]);                                  \
+  template void GEOGRAPHICLIB_EXPORT Math::AngNormalize                    \
+  <T>(size_t, const T[], T[]);                                             \
+  template void GEOGRAPHICLIB_EXPORT Math::AngDiff                         \
+  <T>(size_t, const T[], const T[], T[], T[]);                             \
+  template void GEOGRAPHICLIB_EXPORT Math::tauf                            \
+  <T>(size_t, const T[], T, T[]);
 
   // Instantiate with the standard floating type
   GEOGRAPHICLIB_MATH_INSTANTIATE(float)
@@ -79,6 +79,15 @@ namespace GeographicLib {
     return grs80;
   }
 
+#if GEOGRAPHICLIB_EAGER_SINGLETONS && GEOGRAPHICLIB_PRECISION != 5
+  namespace {
+    // Construct NormalGravity::WGS84() and NormalGravity::GRS80() when the
+    // library is loaded (see Geodesic.cpp).
+    const NormalGravity& wgs84init_ = NormalGravity::WGS84();
+    const NormalGravity& grs80init_ = NormalGravity::GRS80();
+  }
+#endif
+
   Math::real NormalGravity::atan7series(real x) {
     // compute -sum( (-x)^n/(2*n+7), n, 0, inf)
     //   = -1/7 + x/9 - x^2/11 + x^3/13 ...
@@ -162,6 +171,19 @@ namespace GeographicLib {
     return (_gammae + _k * Math::sq(sphi)) / sqrt(1 - _e2 * Math::sq(sphi));
   }
 
+  void NormalGravity::SurfaceGravity(size_t n, const real lat[],
+                                     real gamma[]) const {
+    real lat0 = Math::NaN(), gamma0 = Math::NaN();
+    for (size_t i = 0; i < n; ++i) {
+      real la = lat[i];
+      // NaNs never compare equal and so are passed on to SurfaceGravity.
+      if (!(i > 0 && la == lat0)) {
+        lat0 = la; gamma0 = SurfaceGravity(la);
+      }
+      gamma[i] = gamma0;
+    }
+  }
+
   Math::real NormalGravity::V0(real X, real Y, real Z,
                                real& GammaX, real& GammaY, real& GammaZ) const
   {
@@ -247,6 +269,24 @@ namespace GeographicLib {
     return Ures;
   }
 
+  void NormalGravity::Gravity(size_t n, const real lat[], const real h[],
+                              real U[], real gammay[], real gammaz[]) const {
+    real lat0 = Math::NaN(), h0 = Math::NaN(),
+      U0 = Math::NaN(), gammay0 = Math::NaN(), gammaz0 = Math::NaN();
+    for (size_t i = 0; i < n; ++i) {
+      // Copy the inputs in case the outputs coincide with them.  The signs
+      // are compared too since the results for lat = +0 and -0 may include
+      // zeros of opposite sign.
+      real la = lat[i], hi = h[i];
+      if (!(i > 0 && la == lat0 && hi == h0 &&
+            signbit(la) == signbit(lat0) && signbit(hi) == signbit(h0))) {
+        lat0 = la; h0 = hi;
+        U0 = Gravity(la, hi, gammay0, gammaz0);
+      }
+      U[i] = U0; gammay[i] = gammay0; gammaz[i] = gammaz0;
+    }
+  }
+
   Math::real NormalGravity::J2ToFlattening(real a, real GM,
                                            real omega, real J2) {
     // Solve
@@ -9,6 +9,8 @@
 
 #include <GeographicLib/OSGB.hpp>
 #include <GeographicLib/Utility.hpp>
+#include <cstring>
+#include <vector>
 
 #if defined(_MSC_VER)
 // Squelch warnings about enum-float expressions
@@ -36,7 +38,58 @@ namespace GeographicLib {
     return northoffset;
   }
 
+  void OSGB::Forward(size_t n, const real lat[], const real lon[],
+                     real x[], real y[], real gamma[], real k[],
+                     int nthreads) {
+    OSGBTM().Forward(OriginLongitude(), n, lat, lon, x, y, gamma, k,
+                     nthreads);
+    const real x0 = FalseEasting(), y0 = computenorthoffset();
+    for (size_t i = 0; i < n; ++i) {
+      x[i] += x0;
+      y[i] += y0;
+    }
+  }
+
+  void OSGB::Reverse(size_t n, const real x[], const real y[],
+                     real lat[], real lon[], real gamma[], real k[],
+                     int nthreads) {
+    // The inputs are const, so shift them to the TM origin in chunks.
+    const size_t chunk = 65536;
+    const real x0 = FalseEasting(), y0 = computenorthoffset();
+    vector<real> xt(min(n, chunk)), yt(min(n, chunk));
+    for (size_t i0 = 0; i0 < n; i0 += chunk) {
+      size_t m = min(chunk, n - i0);
+      for (size_t i = 0; i < m; ++i) {
+        xt[i] = x[i0 + i] - x0;
+        yt[i] = y[i0 + i] - y0;
+      }
+      OSGBTM().Reverse(OriginLongitude(), m, xt.data(), yt.data(),
+                       lat + i0, lon + i0,
+                       gamma ? gamma + i0 : gamma, k ? k + i0 : k, nthreads);
+    }
+  }
+
   void OSGB::GridReference(real x, real y, int prec, std::string& gridref) {
+    char grid[MAXBUF];
+    GridReference(x, y, prec, grid);
+    gridref = grid;
+  }
+
+  void OSGB::GridReference(size_t n, const real x[], const real y[],
+                           int prec, char gridref[], size_t width) {
+    if (!(prec >= 0 && prec <= maxprec_))
+      throw GeographicErr("OSGB precision " + Utility::str(prec)
+                          + " not in [0, "
+                          + Utility::str(int(maxprec_)) + "]");
+    if (width < 8 || int(width) < 3 + 2 * prec)
+      throw GeographicErr("Width " + Utility::str(width)
+                          + " too small for OSGB precision "
+                          + Utility::str(prec));
+    for (size_t i = 0; i < n; ++i)
+      GridReference(x[i], y[i], prec, gridref + i * width);
+  }
+
+  void OSGB::GridReference(real x, real y, int prec, char gridref[]) {
     using std::isnan;           // Needed for Centos 7, ubuntu 14
     CheckCoords(x, y);
     if (!(prec >= 0 && prec <= maxprec_))
@@ -44,7 +97,7 @@ namespace GeographicLib {
                           + " not in [0, "
                           + Utility::str(int(maxprec_)) + "]");
     if (isnan(x) || isnan(y)) {
-      gridref = "INVALID";
+      strcpy(gridref, "INVALID");
       return;
     }
     char grid[2 + 2 * maxprec_];
@@ -86,8 +139,8 @@ namespace GeographicLib {
       }
     }
     int mlen = z + 2 * prec;
-    gridref.resize(mlen);
-    copy(grid, grid + mlen, gridref.begin());
+    copy(grid, grid + mlen, gridref);
+    gridref[mlen] = '\0';
   }
 
   void OSGB::GridReference(const std::string& gridref,
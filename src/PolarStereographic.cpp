@@ -18,7 +18,8 @@ namespace GeographicLib {
 
   using namespace std;
 
-  PolarStereographic::PolarStereographic(real a, real f, real k0)
+  template<typename T>
+  PolarStereographicT<T>::PolarStereographicT(real a, real f, real k0)
     : _a(a)
     , _f(f)
     , _e2(_f * (2 - _f))
@@ -35,10 +36,11 @@ namespace GeographicLib {
       throw GeographicErr("Scale is not positive");
   }
 
-  const PolarStereographic& PolarStereographic::UPS() {
-    static const PolarStereographic ups(Constants::WGS84_a(),
-                                        Constants::WGS84_f(),
-                                        Constants::UPS_k0());
+  template<typename T>
+  const PolarStereographicT<T>& PolarStereographicT<T>::UPS() {
+    static const PolarStereographicT ups(Constants::WGS84_a<real>(),
+                                         Constants::WGS84_f<real>(),
+                                         Constants::UPS_k0<real>());
     return ups;
   }
 
@@ -63,44 +65,77 @@ namespace GeographicLib {
   // In limit rho -> 0, tau -> inf, taup -> inf, secphi -> inf, secphip -> inf
   //   secphip = taup = exp(-e * atanh(e)) * tau = exp(-e * atanh(e)) * secphi
 
-  void PolarStereographic::Forward(bool northp, real lat, real lon,
-                                   real& x, real& y,
-                                   real& gamma, real& k) const {
+  template<typename T>
+  void PolarStereographicT<T>::GenForward(bool northp, real lat, real lon,
+                                          bool wantk, real& x, real& y,
+                                          real& gamma, real& k) const {
     lat = Math::LatFix(lat);
     lat *= northp ? 1 : -1;
     real
       tau = Math::tand(lat),
-      secphi = hypot(real(1), tau),
       taup = Math::taupf(tau, _es),
       rho = hypot(real(1), taup) + fabs(taup);
     rho = taup >= 0 ? (lat != Math::qd ? 1/rho : 0) : rho;
     rho *= 2 * _k0 * _a / _c;
-    k = lat != Math::qd ?
-      (rho / _a) * secphi * sqrt(_e2m + _e2 / Math::sq(secphi)) : _k0;
+    if (wantk) {
+      real secphi = hypot(real(1), tau);
+      k = lat != Math::qd ?
+        (rho / _a) * secphi * sqrt(_e2m + _e2 / Math::sq(secphi)) : _k0;
+    }
     Math::sincosd(lon, x, y);
     x *= rho;
     y *= (northp ? -rho : rho);
     gamma = Math::AngNormalize(northp ? lon : -lon);
   }
 
-  void PolarStereographic::Reverse(bool northp, real x, real y,
-                                   real& lat, real& lon,
-                                   real& gamma, real& k) const {
+  template<typename T>
+  void PolarStereographicT<T>::GenReverse(bool northp, real x, real y,
+                                          bool wantk, real& lat, real& lon,
+                                          real& gamma, real& k) const {
     real
       rho = hypot(x, y),
       t = rho != 0 ? rho / (2 * _k0 * _a / _c) :
       Math::sq(numeric_limits<real>::epsilon()),
       taup = (1 / t - t) / 2,
-      tau = Math::tauf(taup, _es),
-      secphi = hypot(real(1), tau);
-    k = rho != 0 ? (rho / _a) * secphi * sqrt(_e2m + _e2 / Math::sq(secphi)) :
-      _k0;
+      tau = Math::tauf(taup, _es);
+    if (wantk) {
+      real secphi = hypot(real(1), tau);
+      k = rho != 0 ?
+        (rho / _a) * secphi * sqrt(_e2m + _e2 / Math::sq(secphi)) : _k0;
+    }
     lat = (northp ? 1 : -1) * Math::atand(tau);
     lon = Math::atan2d(x, northp ? -y : y );
     gamma = Math::AngNormalize(northp ? lon : -lon);
   }
 
-  void PolarStereographic::SetScale(real lat, real k) {
+  template<typename T>
+  void PolarStereographicT<T>::Forward(bool northp, size_t n,
+                                       const real lat[], const real lon[],
+                                       real x[], real y[],
+                                       real gamma[], real k[]) const {
+    real g, kk;
+    for (size_t i = 0; i < n; ++i) {
+      GenForward(northp, lat[i], lon[i], k != nullptr, x[i], y[i], g, kk);
+      if (gamma) gamma[i] = g;
+      if (k) k[i] = kk;
+    }
+  }
+
+  template<typename T>
+  void PolarStereographicT<T>::Reverse(bool northp, size_t n,
+                                       const real x[], const real y[],
+                                       real lat[], real lon[],
+                                       real gamma[], real k[]) const {
+    real g, kk;
+    for (size_t i = 0; i < n; ++i) {
+      GenReverse(northp, x[i], y[i], k != nullptr, lat[i], lon[i], g, kk);
+      if (gamma) gamma[i] = g;
+      if (k) k[i] = kk;
+    }
+  }
+
+  template<typename T>
+  void PolarStereographicT<T>::SetScale(real lat, real k) {
     if (!(isfinite(k) && k > 0))
       throw GeographicErr("Scale is not positive");
     if (!(-Math::qd < lat && lat <= Math::qd))
@@ -112,4 +147,26 @@ namespace GeographicLib {
     _k0 *= k/kold;
   }
 
+  /// \cond SKIP
+  // Instantiate with the standard floating types
+  template class GEOGRAPHICLIB_EXPORT PolarStereographicT<float>;
+  template class GEOGRAPHICLIB_EXPORT PolarStereographicT<double>;
+#if GEOGRAPHICLIB_HAVE_LONG_DOUBLE
+  // Instantiate if long double is distinct from double
+  template class GEOGRAPHICLIB_EXPORT PolarStereographicT<long double>;
+#endif
+#if GEOGRAPHICLIB_PRECISION > 3
+  // Instantiate with the high precision type
+  template class GEOGRAPHICLIB_EXPORT PolarStereographicT<Math::real>;
+#endif
+  /// \endcond
+
+#if GEOGRAPHICLIB_EAGER_SINGLETONS && GEOGRAPHICLIB_PRECISION != 5
+  namespace {
+    // Construct PolarStereographic::UPS() when the library is loaded (see
+    // Geodesic.cpp).
+    const PolarStereographic& upsinit_ = PolarStereographic::UPS();
+  }
+#endif
+
 } // namespace GeographicLib
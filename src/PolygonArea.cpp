@@ -8,6 +8,10 @@
  **********************************************************************/
 
 #include <GeographicLib/PolygonArea.hpp>
+#include <GeographicLib/Executor.hpp>
+#include <GeographicLib/GeodesicOrigin.hpp>
+#include <vector>
+#include <atomic>
 
 #if defined(_MSC_VER)
 // Squelch warnings about enum-float expressions
@@ -18,6 +22,54 @@ namespace GeographicLib {
 
   using namespace std;
 
+  namespace {
+    typedef Math::real real;
+    // Solve the inverse problems from point 1 to n points 2 for s12 and S12
+    // with the one-to-many solvers.
+    void InverseFrom(const Geodesic& g, real lat1, real lon1, size_t n,
+                     const real lat2[], const real lon2[], unsigned mask,
+                     real s12[], real S12[]) {
+      g.InverseFrom(lat1, lon1).GenInverse(n, lat2, lon2, mask, s12,
+                                           nullptr, nullptr, nullptr,
+                                           nullptr, nullptr, S12);
+    }
+    void InverseFrom(const GeodesicExact& g, real lat1, real lon1, size_t n,
+                     const real lat2[], const real lon2[], unsigned mask,
+                     real s12[], real S12[]) {
+      vector<real> lat1v(n, lat1), lon1v(n, lon1);
+      g.GenInverse(n, lat1v.data(), lon1v.data(), lat2, lon2, mask, s12,
+                   nullptr, nullptr, nullptr, nullptr, nullptr, S12);
+    }
+    void InverseFrom(const Rhumb& r, real lat1, real lon1, size_t n,
+                     const real lat2[], const real lon2[], unsigned mask,
+                     real s12[], real S12[]) {
+      vector<real> lat1v(n, lat1), lon1v(n, lon1);
+      r.GenInverse(n, lat1v.data(), lon1v.data(), lat2, lon2, mask, s12,
+                   nullptr, S12);
+    }
+    // Whether ComputeMany solves the inverse problems for all the edges of a
+    // polygon with one call to the array version of GenInverse.  This is done
+    // for Rhumb, whose array version evaluates the divided differences for
+    // the area in lanes and reuses the auxiliary latitudes at the shared
+    // vertices; its results are identical to those of the scalar version.
+    template<class GeodType> struct BatchEdges {
+      static const bool value = false;
+      static void Inverse(const GeodType&, size_t,
+                          const real[], const real[],
+                          const real[], const real[], unsigned,
+                          real[], real[]) {}
+    };
+    template<> struct BatchEdges<Rhumb> {
+      static const bool value = true;
+      static void Inverse(const Rhumb& r, size_t n,
+                          const real lat1[], const real lon1[],
+                          const real lat2[], const real lon2[], unsigned mask,
+                          real s12[], real S12[]) {
+        r.GenInverse(n, lat1, lon1, lat2, lon2, mask, s12, nullptr, S12);
+      }
+    };
+  }
+
   template<class GeodType>
   int PolygonAreaT<GeodType>::transit(real lon1, real lon2) {
     // Return 1 or -1 if crossing prime meridian in east or west direction.
@@ -71,19 +123,28 @@ namespace GeographicLib {
       _lat0 = _lat1 = lat;
       _lon0 = _lon1 = lon;
     } else {
-      real s12, S12, t;
-      _earth.GenInverse(_lat1, _lon1, lat, lon, _mask,
-                        s12, t, t, t, t, t, S12);
+      real s12, S12;
+      int crossings = Edge(lat, lon, s12, S12);
       _perimetersum += s12;
       if (!_polyline) {
         _areasum += S12;
-        _crossings += transit(_lon1, lon);
+        _crossings += crossings;
       }
       _lat1 = lat; _lon1 = lon;
     }
     ++_num;
   }
 
+  template<class GeodType>
+  int PolygonAreaT<GeodType>::Edge(real lat, real lon,
+                                   real& s12, real& S12) const {
+    real t;
+    S12 = 0;
+    _earth.GenInverse(_lat1, _lon1, lat, lon, _mask,
+                      s12, t, t, t, t, t, S12);
+    return _polyline ? 0 : transit(_lon1, lon);
+  }
+
   template<class GeodType>
   void PolygonAreaT<GeodType>::AddEdge(real azi, real s) {
     if (_num) {                 // Do nothing if _num is zero
@@ -100,6 +161,79 @@ namespace GeographicLib {
     }
   }
 
+  template<class GeodType>
+  void PolygonAreaT<GeodType>::AddPoints(size_t n,
+                                         const real lat[], const real lon[],
+                                         int nthreads, bool reproducible) {
+    // Split the points into contiguous pieces, accumulate each piece into its
+    // own PolygonAreaT, and merge the pieces in order.  The pieces are large
+    // because starting a thread costs about as much as a few hundred inverse
+    // geodesic calculations.  In reproducible mode, the pieces depend only
+    // on n.
+    const size_t minpiece = 1024,
+      nthr = size_t((max)(1, nthreads));
+    size_t np = reproducible ? (n + minpiece - 1) / minpiece :
+      (min)(n / minpiece, nthr);
+    np = (max)(size_t(1), np);
+    if (np == 1) {
+      for (size_t i = 0; i < n; ++i)
+        AddPoint(lat[i], lon[i]);
+      return;
+    }
+    // The pieces are processed in batches to bound the memory needed.  The
+    // batches don't affect the results since the pieces are merged in order.
+    const size_t batch = 16 * nthr;
+    PolygonAreaT empty(*this);
+    empty.Clear();
+    vector<PolygonAreaT> parts((min)(np, batch), empty);
+    for (size_t b0 = 0; b0 < np; b0 += batch) {
+      const int m = int((min)(np, b0 + batch) - b0),
+        nt = int((min)(nthr, size_t(m)));
+      atomic<int> next(0);
+      auto work = [&](int) -> void {
+        for (int k; (k = next++) < m;) {
+          size_t b = n * (b0 + k) / np, e = n * (b0 + k + 1) / np;
+          parts[k] = empty;
+          for (size_t i = b; i < e; ++i)
+            parts[k].AddPoint(lat[i], lon[i]);
+        }
+      };
+      Executor::RunGuarded(nt, work, [&]() -> void { next = m; });
+      for (int k = 0; k < m; ++k)
+        Merge(parts[k]);
+    }
+  }
+
+  template<class GeodType>
+  void PolygonAreaT<GeodType>::Merge(const PolygonAreaT& p) {
+    if (!(p._area0 == _area0 && p._polyline == _polyline))
+      throw GeographicErr("Incompatible polygons in PolygonAreaT::Merge");
+    if (p._num == 0) return;
+    if (_num == 0) {
+      _num = p._num;
+      _crossings = p._crossings;
+      _areasum = p._areasum;
+      _perimetersum = p._perimetersum;
+      _lat0 = p._lat0; _lon0 = p._lon0;
+      _lat1 = p._lat1; _lon1 = p._lon1;
+      return;
+    }
+    // Save the data for p in case p is *this.
+    const unsigned num = p._num;
+    const int crossings = p._crossings;
+    const Accumulator<> areasum(p._areasum), perimetersum(p._perimetersum);
+    const real lat0 = p._lat0, lon0 = p._lon0, lat1 = p._lat1, lon1 = p._lon1;
+    // Add the edge joining the two pieces; this increments _num.
+    AddPoint(lat0, lon0);
+    _num += num - 1;
+    _perimetersum += perimetersum;
+    if (!_polyline) {
+      _areasum += areasum;
+      _crossings += crossings;
+    }
+    _lat1 = lat1; _lon1 = lon1;
+  }
+
   template<class GeodType>
   unsigned PolygonAreaT<GeodType>::Compute(bool reverse, bool sign,
                                            real& perimeter, real& area) const
@@ -198,6 +332,101 @@ namespace GeographicLib {
     return num;
   }
 
+  template<class GeodType>
+  void PolygonAreaT<GeodType>::TestPoints(size_t n,
+                                          const real lat[], const real lon[],
+                                          bool reverse, bool sign,
+                                          real perimeter[], real area[],
+                                          int nthreads) const {
+    if (_num == 0) {
+      for (size_t i = 0; i < n; ++i) {
+        perimeter[i] = 0;
+        if (!_polyline)
+          area[i] = 0;
+      }
+      return;
+    }
+    // The test points are handled in blocks which bound the scratch space
+    // and which are claimed by the threads with an atomic counter.
+    const size_t block = 256, nblocks = (n + block - 1) / block;
+    nthreads = int((min)(size_t((max)(1, nthreads)), nblocks));
+    if (nthreads == 0) return;
+    atomic<size_t> next(0);
+    auto work = [&](int) -> void {
+      vector<real> s1(block), S1(block), s0(block), S0(block);
+      for (size_t k; (k = next++) < nblocks;) {
+        const size_t b = k * block, m = (min)(block, n - b);
+        // The edges from the current point and from the first point
+        InverseFrom(_earth, _lat1, _lon1, m, lat + b, lon + b, _mask,
+                    s1.data(), S1.data());
+        if (!_polyline)
+          InverseFrom(_earth, _lat0, _lon0, m, lat + b, lon + b, _mask,
+                      s0.data(), S0.data());
+        for (size_t i = 0; i < m; ++i) {
+          perimeter[b + i] = _perimetersum() + s1[i];
+          if (_polyline)
+            continue;
+          perimeter[b + i] += s0[i];
+          real tempsum = _areasum() + S1[i] - S0[i];
+          int crossings = _crossings + transit(_lon1, lon[b + i]) +
+            transit(lon[b + i], _lon0);
+          AreaReduce(tempsum, crossings, reverse, sign);
+          area[b + i] = real(0) + tempsum;
+        }
+      }
+    };
+    Executor::RunGuarded(nthreads, work, [&]() -> void { next = nblocks; });
+  }
+
+  template<class GeodType>
+  void PolygonAreaT<GeodType>::ComputeMany(size_t n, const size_t offsets[],
+                                           const real lat[], const real lon[],
+                                           bool reverse, bool sign,
+                                           real perimeter[], real area[],
+                                           int nthreads) const {
+    // The polygons are claimed in blocks so that the cost of the atomic
+    // counter is negligible.  Each thread uses its own copy of *this for the
+    // accumulation.  If BatchEdges applies, the open edges of a polygon are
+    // solved together and the sums are then accumulated in the same order as
+    // by AddPoint.
+    const size_t block = 256, nblocks = (n + block - 1) / block;
+    nthreads = int((min)(size_t((max)(1, nthreads)), nblocks));
+    if (nthreads == 0) return;
+    atomic<size_t> next(0);
+    auto work = [&](int) -> void {
+      PolygonAreaT p(*this);
+      vector<real> s12, S12;
+      real a;
+      for (size_t k; (k = next++) < nblocks;) {
+        for (size_t j = k * block; j < (min)(n, (k + 1) * block); ++j) {
+          p.Clear();
+          size_t b = offsets[j], e = offsets[j + 1];
+          if (BatchEdges<GeodType>::value && e - b >= 2) {
+            size_t m = e - b - 1;
+            if (s12.size() < m) { s12.resize(m); S12.resize(m); }
+            BatchEdges<GeodType>::Inverse(_earth, m, lat + b, lon + b,
+                                          lat + b + 1, lon + b + 1, _mask,
+                                          s12.data(), S12.data());
+            for (size_t i = 0; i < m; ++i) {
+              p._perimetersum += s12[i];
+              if (!_polyline) {
+                p._areasum += S12[i];
+                p._crossings += transit(lon[b + i], lon[b + i + 1]);
+              }
+            }
+            p._num = unsigned(e - b);
+            p._lat0 = lat[b]; p._lon0 = lon[b];
+            p._lat1 = lat[e - 1]; p._lon1 = lon[e - 1];
+          } else
+            for (size_t i = b; i < e; ++i)
+              p.AddPoint(lat[i], lon[i]);
+          p.Compute(reverse, sign, perimeter[j], _polyline ? a : area[j]);
+        }
+      }
+    };
+    Executor::RunGuarded(nthreads, work, [&]() -> void { next = nblocks; });
+  }
+
   template<class GeodType>
   template<typename T>
   void PolygonAreaT<GeodType>::AreaReduce(T& area, int crossings,
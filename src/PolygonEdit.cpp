@@ -0,0 +1,110 @@
+/**
+ * \file PolygonEdit.cpp
+ * \brief Implementation for GeographicLib::PolygonEditT class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/PolygonEdit.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  template<class GeodType>
+  void PolygonEditT<GeodType>::check(unsigned i, unsigned n) const {
+    if (i >= n)
+      throw GeographicErr("Point index out of range for PolygonEditT");
+  }
+
+  template<class GeodType>
+  void PolygonEditT<GeodType>::addedge(unsigned k) {
+    // PolygonAreaT::Edge solves for the edge from its current point; this
+    // is reset by ends().
+    _poly._lat1 = _lat[k-1]; _poly._lon1 = _lon[k-1];
+    _cross[k] = _poly.Edge(_lat[k], _lon[k], _s12[k], _S12[k]);
+    _poly._perimetersum += _s12[k];
+    if (!_poly._polyline) {
+      _poly._areasum += _S12[k];
+      _poly._crossings += _cross[k];
+    }
+  }
+
+  template<class GeodType>
+  void PolygonEditT<GeodType>::subedge(unsigned k) {
+    _poly._perimetersum -= _s12[k];
+    if (!_poly._polyline) {
+      _poly._areasum -= _S12[k];
+      _poly._crossings -= _cross[k];
+    }
+    _s12[k] = _S12[k] = 0; _cross[k] = 0;
+  }
+
+  template<class GeodType>
+  void PolygonEditT<GeodType>::ends() {
+    unsigned n = NumberPoints();
+    // With at most one point there are no edges, so start the sums afresh.
+    if (n <= 1) _poly.Clear();
+    _poly._num = n;
+    if (n) {
+      _poly._lat0 = _lat[0]; _poly._lon0 = _lon[0];
+      _poly._lat1 = _lat[n-1]; _poly._lon1 = _lon[n-1];
+    }
+  }
+
+  template<class GeodType>
+  void PolygonEditT<GeodType>::Clear() {
+    _lat.clear(); _lon.clear(); _s12.clear(); _S12.clear(); _cross.clear();
+    ends();
+  }
+
+  template<class GeodType>
+  void PolygonEditT<GeodType>::InsertPoint(unsigned i, real lat, real lon) {
+    unsigned n = NumberPoints();
+    check(i, n + 1);
+    // Reserve the space first so that the insertions can't throw.
+    _lat.reserve(n + 1); _lon.reserve(n + 1);
+    _s12.reserve(n + 1); _S12.reserve(n + 1); _cross.reserve(n + 1);
+    _lat.insert(_lat.begin() + i, lat); _lon.insert(_lon.begin() + i, lon);
+    _s12.insert(_s12.begin() + i, real(0));
+    _S12.insert(_S12.begin() + i, real(0));
+    _cross.insert(_cross.begin() + i, 0);
+    // The edge from point i - 1 to the old point i (now i + 1) is replaced
+    // by the edges to and from the new point.
+    if (i > 0 && i < n) subedge(i + 1);
+    if (i > 0) addedge(i);
+    if (i < n) addedge(i + 1);
+    ends();
+  }
+
+  template<class GeodType>
+  void PolygonEditT<GeodType>::MovePoint(unsigned i, real lat, real lon) {
+    unsigned n = NumberPoints();
+    check(i, n);
+    _lat[i] = lat; _lon[i] = lon;
+    if (i > 0) { subedge(i); addedge(i); }
+    if (i + 1 < n) { subedge(i + 1); addedge(i + 1); }
+    ends();
+  }
+
+  template<class GeodType>
+  void PolygonEditT<GeodType>::RemovePoint(unsigned i) {
+    unsigned n = NumberPoints();
+    check(i, n);
+    if (i > 0) subedge(i);
+    if (i + 1 < n) subedge(i + 1);
+    _lat.erase(_lat.begin() + i); _lon.erase(_lon.begin() + i);
+    _s12.erase(_s12.begin() + i); _S12.erase(_S12.begin() + i);
+    _cross.erase(_cross.begin() + i);
+    // Join the points on either side of the removed one.
+    if (i > 0 && i + 1 < n) addedge(i);
+    ends();
+  }
+
+  template class GEOGRAPHICLIB_EXPORT PolygonEditT<Geodesic>;
+  template class GEOGRAPHICLIB_EXPORT PolygonEditT<GeodesicExact>;
+  template class GEOGRAPHICLIB_EXPORT PolygonEditT<Rhumb>;
+
+} // namespace GeographicLib
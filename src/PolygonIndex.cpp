@@ -0,0 +1,203 @@
+/**
+ * \file PolygonIndex.cpp
+ * \brief Implementation for GeographicLib::PolygonIndex class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/PolygonIndex.hpp>
+#include <atomic>
+#include <GeographicLib/Executor.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  namespace {
+    typedef Math::real real;
+    // The margin (degrees) added to the ranges of the edges to allow for
+    // roundoff errors
+    inline real margin()
+    { return 1000 * numeric_limits<real>::epsilon() * Math::qd; }
+  }
+
+  PolygonIndex::PolygonIndex(const Geodesic& g, size_t n,
+                             const real lat[], const real lon[],
+                             bool reverse)
+    : _geod(g)
+    , _reverse(reverse)
+  {
+    // The distinct vertices
+    vector<real> vlat, vlon;
+    vlat.reserve(n); vlon.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+      real la = Math::LatFix(lat[i]), lo = lon[i];
+      if (!(isfinite(la) && isfinite(lo)))
+        throw GeographicErr("Bad vertex for PolygonIndex");
+      if (!vlat.empty() && la == vlat.back() &&
+          Math::AngDiff(vlon.back(), lo) == 0)
+        continue;
+      vlat.push_back(la); vlon.push_back(lo);
+    }
+    while (vlat.size() > 1 && vlat.back() == vlat[0] &&
+           Math::AngDiff(vlon[0], vlon.back()) == 0) {
+      vlat.pop_back(); vlon.pop_back();
+    }
+    const size_t m = vlat.size();
+    if (m < 3)
+      throw GeographicErr("PolygonIndex needs at least 3 vertices");
+    if (m > size_t(numeric_limits<unsigned>::max()))
+      throw GeographicErr("Too many vertices for PolygonIndex");
+
+    const real f1 = 1 - _geod.Flattening(), eps = margin();
+    _edges.resize(m);
+    // The unrolled longitudes of the vertices relative to vertex 0
+    vector<real> ulon(m + 1);
+    ulon[0] = 0;
+    size_t longest = 0;
+    real smax = -1;
+    for (size_t i = 0; i < m; ++i) {
+      const size_t j = i + 1 < m ? i + 1 : 0;
+      Edge& e = _edges[i];
+      e.lat1 = vlat[i]; e.lon1 = vlon[i]; e.lat2 = vlat[j]; e.lon2 = vlon[j];
+      real s12, azi2, t;
+      _geod.GenInverse(e.lat1, e.lon1, e.lat2, e.lon2,
+                       Geodesic::DISTANCE | Geodesic::AZIMUTH,
+                       s12, e.azi1, azi2, t, t, t, t);
+      real lon12 = Math::AngDiff(e.lon1, e.lon2);
+      e.east = lon12 > 0;
+      ulon[i + 1] = ulon[i] + lon12;
+      e.latmin = fmin(e.lat1, e.lat2); e.latmax = fmax(e.lat1, e.lat2);
+      real salp1, calp1, salp2, calp2;
+      Math::sincosd(e.azi1, salp1, calp1);
+      Math::sincosd(azi2, salp2, calp2);
+      if (signbit(calp1) != signbit(calp2) && calp1 != 0 && calp2 != 0) {
+        // The edge includes a vertex of the geodesic
+        real sbet1, cbet1;
+        Math::sincosd(e.lat1, sbet1, cbet1); sbet1 *= f1;
+        Math::norm(sbet1, cbet1);
+        real salp0 = salp1 * cbet1, calp0 = hypot(calp1, salp1 * sbet1),
+          latv = Math::atan2d(calp0, f1 * fabs(salp0));
+        if (calp1 > 0)
+          e.latmax = latv;
+        else
+          e.latmin = -latv;
+      }
+      e.latmin -= eps; e.latmax += eps;
+      if (s12 > smax) { smax = s12; longest = i; }
+    }
+
+    // Bin the edges by longitude
+    real umin = ulon[0], umax = ulon[0];
+    for (size_t i = 1; i <= m; ++i) {
+      umin = fmin(umin, ulon[i]); umax = fmax(umax, ulon[i]);
+    }
+    _lon0 = vlon[0] + umin;
+    _span = fmin(real(Math::td), umax - umin);
+    const size_t nb = min(m, size_t(65536));
+    _width = _span > 0 ? _span / nb : 1;
+    _start.assign(nb + 1, 0);
+    for (int pass = 0; pass < 2; ++pass) {
+      vector<unsigned> next;
+      if (pass) next.assign(_start.begin(), _start.end() - 1);
+      for (size_t i = 0; i < m; ++i) {
+        real a = fmin(ulon[i], ulon[i + 1]) - umin - eps,
+          b = fmax(ulon[i], ulon[i + 1]) - umin + eps;
+        long long k0 = (long long)(floor(a / _width)),
+          k1 = (long long)(floor(b / _width));
+        if (k1 - k0 >= (long long)(nb)) { k0 = 0; k1 = nb - 1; }
+        for (long long k = k0; k <= k1; ++k) {
+          size_t bin = size_t(((k % (long long)(nb)) + nb) % nb);
+          if (pass)
+            _index[next[bin]++] = unsigned(i);
+          else
+            ++_start[bin + 1];
+        }
+      }
+      if (!pass) {
+        for (size_t k = 0; k < nb; ++k)
+          _start[k + 1] += _start[k];
+        _index.resize(_start[nb]);
+      }
+    }
+
+    // A point just inside the midpoint of the longest edge is inside the
+    // polygon; count its crossings with all the edges to determine whether
+    // the north pole is inside.
+    const Edge& e = _edges[longest];
+    real latm, lonm, azim, latp, lonp;
+    _geod.Direct(e.lat1, e.lon1, e.azi1, smax/2, latm, lonm, azim);
+    _geod.Direct(latm, lonm, azim + (reverse ? Math::qd : -Math::qd),
+                 fmin(real(1)/1000, smax/1000), latp, lonp);
+    _northinside = false;
+    for (const Edge& x : _edges)
+      _northinside ^= Crosses(x, latp, lonp);
+    _northinside = !_northinside;
+  }
+
+  bool PolygonIndex::Crosses(const Edge& e, real lat, real lon) const {
+    // Does the meridian from (lat, lon) to the north pole cross edge e?  The
+    // longitudes of the vertices relative to lon; a vertex on the meridian
+    // counts as being to the east.
+    real t1 = Math::AngDiff(lon, e.lon1), t2 = Math::AngDiff(lon, e.lon2);
+    if (signbit(t1) == signbit(t2) || !(fabs(t2 - t1) < Math::hd))
+      return false;
+    if (lat < e.latmin) return true;
+    if (lat > e.latmax) return false;
+    // The point is on the right of the edge if its azimuth from the first
+    // vertex is clockwise from that of the edge.  The edge is north of the
+    // point if it is on the right of an eastward edge or on the left of a
+    // westward one.
+    real s12, azi1, azi2, t;
+    _geod.GenInverse(e.lat1, e.lon1, lat, lon, Geodesic::AZIMUTH,
+                     s12, azi1, azi2, t, t, t, t);
+    bool right = Math::AngDiff(e.azi1, azi1) > 0;
+    return t2 > t1 ? right : !right;
+  }
+
+  bool PolygonIndex::Parity(const unsigned* first, const unsigned* last,
+                            real lat, real lon) const {
+    bool p = false;
+    for (; first < last; ++first)
+      p ^= Crosses(_edges[*first], lat, lon);
+    return p;
+  }
+
+  bool PolygonIndex::Contains(real lat, real lon) const {
+    lat = Math::LatFix(lat);
+    if (isnan(lat) || !isfinite(lon)) return false;
+    real t = Math::AngDiff(_lon0, lon);
+    if (t < 0) t += Math::td;
+    if (t > _span + margin())
+      // No edges cross the meridian
+      return _northinside;
+    size_t k = min(size_t(t / _width), _start.size() - 2);
+    return _northinside !=
+      Parity(_index.data() + _start[k], _index.data() + _start[k + 1],
+             lat, lon);
+  }
+
+  void PolygonIndex::Contains(size_t n, const real lat[], const real lon[],
+                              bool inside[], int nthreads) const {
+    // The points are tested in blocks of this size, claimed with an atomic
+    // counter.
+    const size_t block = 1024, nblocks = (n + block - 1) / block;
+    nthreads = int(min(size_t(max(1, nthreads)), nblocks));
+    auto work = [&](size_t b) -> void {
+      for (size_t i = b * block; i < min(n, (b + 1) * block); ++i)
+        inside[i] = Contains(lat[i], lon[i]);
+    };
+    if (nthreads <= 1) {
+      for (size_t b = 0; b < nblocks; ++b) work(b);
+      return;
+    }
+    atomic<size_t> next(0);
+    Executor::RunGuarded(nthreads, [&](int) -> void {
+      for (size_t b; (b = next++) < nblocks;)
+        work(b);
+    }, [&]() -> void { next = nblocks; });
+  }
+
+} // namespace GeographicLib
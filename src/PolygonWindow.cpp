@@ -0,0 +1,73 @@
+/**
+ * \file PolygonWindow.cpp
+ * \brief Implementation for GeographicLib::PolygonWindowT class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/PolygonWindow.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  template<class GeodType>
+  PolygonWindowT<GeodType>::PolygonWindowT(const GeodType& earth, unsigned n,
+                                           bool polyline)
+    : _poly(earth, polyline)
+    , _n(n)
+    , _first(0)
+  {
+    if (_n == 0)
+      throw GeographicErr("PolygonWindowT needs room for at least 1 point");
+    _lat.resize(_n); _lon.resize(_n);
+    _s12.resize(_n); _S12.resize(_n); _cross.resize(_n);
+  }
+
+  template<class GeodType>
+  void PolygonWindowT<GeodType>::AddPoint(real lat, real lon) {
+    if (_poly._num == _n) RemovePoint();
+    unsigned k = (_first + _poly._num) % _n;
+    _lat[k] = lat; _lon[k] = lon;
+    if (_poly._num == 0) {
+      _first = k;
+      _s12[k] = _S12[k] = 0; _cross[k] = 0;
+      _poly._lat0 = lat; _poly._lon0 = lon;
+    } else {
+      _cross[k] = _poly.Edge(lat, lon, _s12[k], _S12[k]);
+      _poly._perimetersum += _s12[k];
+      if (!_poly._polyline) {
+        _poly._areasum += _S12[k];
+        _poly._crossings += _cross[k];
+      }
+    }
+    _poly._lat1 = lat; _poly._lon1 = lon;
+    ++_poly._num;
+  }
+
+  template<class GeodType>
+  void PolygonWindowT<GeodType>::RemovePoint() {
+    if (_poly._num <= 1) {
+      Clear();
+      return;
+    }
+    // Remove the edge from the oldest point to the next one, which becomes
+    // the oldest point.
+    unsigned k = (_first + 1) % _n;
+    _poly._perimetersum -= _s12[k];
+    if (!_poly._polyline) {
+      _poly._areasum -= _S12[k];
+      _poly._crossings -= _cross[k];
+    }
+    _poly._lat0 = _lat[k]; _poly._lon0 = _lon[k];
+    _first = k;
+    --_poly._num;
+  }
+
+  template class GEOGRAPHICLIB_EXPORT PolygonWindowT<Geodesic>;
+  template class GEOGRAPHICLIB_EXPORT PolygonWindowT<GeodesicExact>;
+  template class GEOGRAPHICLIB_EXPORT PolygonWindowT<Rhumb>;
+
+} // namespace GeographicLib
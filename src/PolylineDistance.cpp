@@ -0,0 +1,195 @@
+/**
+ * \file PolylineDistance.cpp
+ * \brief Implementation for GeographicLib::PolylineDistance class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/PolylineDistance.hpp>
+#include <atomic>
+#include <GeographicLib/Executor.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  PolylineDistance::PolylineDistance(const Geodesic& g, size_t n,
+                                     const real lat[], const real lon[])
+    : _geod(g)
+    , _earth(g.EquatorialRadius(), g.Flattening())
+    , _tol(1000 * numeric_limits<real>::epsilon() * g.EquatorialRadius())
+  {
+    if (n < 2)
+      throw GeographicErr("PolylineDistance needs at least 2 vertices");
+    if (n - 1 > size_t(numeric_limits<int>::max() / 2))
+      throw GeographicErr("Too many vertices for PolylineDistance");
+    for (size_t i = 0; i < n; ++i)
+      if (!(isfinite(Math::LatFix(lat[i])) && isfinite(lon[i])))
+        throw GeographicErr("Bad vertex for PolylineDistance");
+    _lines.reserve(n - 1);
+    for (size_t i = 0; i + 1 < n; ++i)
+      _lines.push_back(_geod.InverseLine(lat[i], lon[i], lat[i+1], lon[i+1],
+                                         Geodesic::LATITUDE |
+                                         Geodesic::LONGITUDE |
+                                         Geodesic::AZIMUTH |
+                                         Geodesic::DISTANCE_IN));
+    // The smallest radius of curvature of the ellipsoid
+    const real a = _geod.EquatorialRadius(),
+      b = a * (1 - _geod.Flattening()),
+      rho = Math::sq(fmin(a, b)) / fmax(a, b);
+    _chords.resize(n - 1);
+    for (size_t i = 0; i + 1 < n; ++i) {
+      Chord& c = _chords[i];
+      const GeodesicLine& l = _lines[i];
+      real lat2, lon2, len = l.Distance();
+      l.Position(len, lat2, lon2);
+      _earth.Forward(l.Latitude(), l.Longitude(), 0, c.X1, c.Y1, c.Z1);
+      _earth.Forward(lat2, lon2, 0, c.X2, c.Y2, c.Z2);
+      // The bound L^2/(8*rho) on the deviation from the chord only applies
+      // for arcs less than a half turn.
+      c.h = len < Math::pi() * rho ? Math::sq(len) / (8 * rho) :
+        Math::infinity();
+    }
+    _nodes.reserve(2 * (n - 1));
+    _root = Build(0, int(n - 1));
+  }
+
+  int PolylineDistance::Build(int lo, int hi) {
+    Node b;
+    if (hi - lo == 1) {
+      // A segment is inside the ball centered at its midpoint with radius
+      // half its length.
+      const GeodesicLine& l = _lines[lo];
+      real latm, lonm;
+      l.Position(l.Distance() / 2, latm, lonm);
+      _earth.Forward(latm, lonm, 0, b.X, b.Y, b.Z);
+      b.r = l.Distance() / 2;
+      b.left = lo; b.right = -1;
+    } else {
+      int mid = lo + (hi - lo) / 2;
+      b.left = Build(lo, mid); b.right = Build(mid, hi);
+      const Node &l = _nodes[b.left], &r = _nodes[b.right];
+      b.X = (l.X + r.X) / 2; b.Y = (l.Y + r.Y) / 2; b.Z = (l.Z + r.Z) / 2;
+      b.r = fmax(hypot(hypot(l.X - b.X, l.Y - b.Y), l.Z - b.Z) + l.r,
+                 hypot(hypot(r.X - b.X, r.Y - b.Y), r.Z - b.Z) + r.r);
+    }
+    _nodes.push_back(b);
+    return int(_nodes.size() - 1);
+  }
+
+  Math::real PolylineDistance::Bound(const Node& b,
+                                     real X, real Y, real Z) const {
+    // The distance to the ball, a lower bound on the geodesic distance to the
+    // segments within it.
+    return fmax(real(0), hypot(hypot(X - b.X, Y - b.Y), Z - b.Z) - b.r);
+  }
+
+  Math::real PolylineDistance::Bound(const Chord& c, real X, real Y, real Z,
+                                     real& t) const {
+    // The distance to the chord less the bound on the deviation of the
+    // segment from it; t is the fractional position of the closest point on
+    // the chord.
+    real vx = c.X2 - c.X1, vy = c.Y2 - c.Y1, vz = c.Z2 - c.Z1,
+      wx = X - c.X1, wy = Y - c.Y1, wz = Z - c.Z1,
+      v2 = vx * vx + vy * vy + vz * vz;
+    t = v2 > 0 ? fmin(real(1), fmax(real(0), (wx*vx + wy*vy + wz*vz) / v2)) :
+      0;
+    return fmax(real(0),
+                hypot(hypot(wx - t * vx, wy - t * vy), wz - t * vz) - c.h);
+  }
+
+  Math::real PolylineDistance::Segment(int i, real lat, real lon,
+                                       real& s, real& latc, real& lonc)
+    const {
+    const GeodesicLine& l = _lines[i];
+    const real len = l.Distance();
+    const int maxit = 20;
+    const unsigned outmask = Geodesic::DISTANCE | Geodesic::AZIMUTH |
+      Geodesic::REDUCEDLENGTH | Geodesic::GEODESICSCALE;
+    real d = Math::NaN();
+    for (int it = 0; it < maxit; ++it) {
+      real azil, aziq, azi2, m12, M12, M21, t;
+      l.Position(s, latc, lonc, azil);
+      _geod.GenInverse(latc, lonc, lat, lon, outmask,
+                       d, aziq, azi2, m12, M12, M21, t);
+      // In the gnomonic projection centered at (latc, lonc), the point is
+      // at radius m12/M12 and the segment is the line with azimuth azil.
+      // The gnomonic radius of a point on the segment at distance ds is ds
+      // to first order.  Beyond the horizon of the projection (M12 <= 0),
+      // use the distance instead.
+      real ds = (M12 > 0 ? m12 / M12 : d) *
+        Math::cosd(Math::AngDiff(azil, aziq)),
+        s1 = fmin(len, fmax(real(0), s + ds));
+      if (fabs(s1 - s) <= _tol) break;
+      s = s1;
+    }
+    return d;
+  }
+
+  Math::real PolylineDistance::Distance(real lat, real lon,
+                                        int& seg, real& s,
+                                        real& latc, real& lonc) const {
+    real X, Y, Z;
+    _earth.Forward(lat, lon, 0, X, Y, Z);
+    // Depth first search visiting the nearer child first.  The tree is
+    // balanced, so the stack holds at most 2 entries per level.
+    int stack[2 * 64];
+    real bound[2 * 64];
+    int sp = 0;
+    real best = Math::infinity();
+    seg = -1; s = latc = lonc = Math::NaN();
+    stack[sp] = _root; bound[sp] = Bound(_nodes[_root], X, Y, Z); ++sp;
+    while (sp > 0) {
+      --sp;
+      if (!(bound[sp] < best)) continue;
+      const Node& b = _nodes[stack[sp]];
+      if (b.right < 0) {
+        real t;
+        if (!(Bound(_chords[b.left], X, Y, Z, t) < best)) continue;
+        real s1 = t * _lines[b.left].Distance(), lat1, lon1,
+          d = Segment(b.left, lat, lon, s1, lat1, lon1);
+        if (d < best) {
+          best = d; seg = b.left; s = s1; latc = lat1; lonc = lon1;
+        }
+      } else {
+        real bl = Bound(_nodes[b.left], X, Y, Z),
+          br = Bound(_nodes[b.right], X, Y, Z);
+        bool leftfirst = bl <= br;
+        stack[sp] = leftfirst ? b.right : b.left;
+        bound[sp] = leftfirst ? br : bl; ++sp;
+        stack[sp] = leftfirst ? b.left : b.right;
+        bound[sp] = leftfirst ? bl : br; ++sp;
+      }
+    }
+    return seg < 0 ? Math::NaN() : best;
+  }
+
+  void PolylineDistance::Distance(size_t n, const real lat[], const real lon[],
+                                  real dist[], int seg[], real s[],
+                                  int nthreads) const {
+    // The points are processed in blocks of this size, claimed with an
+    // atomic counter.
+    const size_t block = 256, nblocks = (n + block - 1) / block;
+    nthreads = int(min(size_t(max(1, nthreads)), nblocks));
+    auto work = [&](size_t b) -> void {
+      for (size_t i = b * block; i < min(n, (b + 1) * block); ++i) {
+        int segx; real sx, latc, lonc;
+        dist[i] = Distance(lat[i], lon[i], segx, sx, latc, lonc);
+        if (seg) seg[i] = segx;
+        if (s) s[i] = sx;
+      }
+    };
+    if (nthreads <= 1) {
+      for (size_t b = 0; b < nblocks; ++b) work(b);
+      return;
+    }
+    atomic<size_t> next(0);
+    Executor::RunGuarded(nthreads, [&](int) -> void {
+      for (size_t b; (b = next++) < nblocks;)
+        work(b);
+    }, [&]() -> void { next = nblocks; });
+  }
+
+} // namespace GeographicLib
@@ -10,6 +10,7 @@
 
 #include <GeographicLib/Rhumb.hpp>
 #include <GeographicLib/DST.hpp>
+#include <GeographicLib/Registry.hpp>
 
 #if defined(_MSC_VER)
 // Squelch warnings about enum-float expressions
@@ -40,9 +41,29 @@ namespace GeographicLib {
     return wgs84;
   }
 
+#if GEOGRAPHICLIB_EAGER_SINGLETONS && GEOGRAPHICLIB_PRECISION != 5
+  namespace {
+    // Construct Rhumb::WGS84() when the library is loaded (see Geodesic.cpp).
+    const Rhumb& wgs84init_ = Rhumb::WGS84();
+  }
+#endif
+
   void Rhumb::AreaCoeffs() {
     // Set up coefficients for area calculation
     if (_exact) {
+      // The coefficients depend only on f (and the precision with
+      // GEOGRAPHICLIB_PRECISION = 5) and they are expensive to compute, so
+      // cache them.  Limit the size of the cache in case many ellipsoids are
+      // used.  Looking up the coefficients doesn't take a lock.
+      const pair<real, int> key(_f, Math::digits());
+      static Registry<pair<real, int>, const vector<real>> cache(64);
+      {
+        auto p = cache.Find(key);
+        if (p) {
+          _pP = *p; _lL = int(_pP.size());
+          return;
+        }
+      }
       // Compute coefficients by Fourier transform of integrand
       static const real eps = numeric_limits<real>::epsilon()/2;
       qIntegrand f(_aux);
@@ -75,6 +96,7 @@ namespace GeographicLib {
       }
       if (_lL == 0)          // Hasn't converged -- just use the values we have
         _lL = int(_pP.size());
+      cache.Insert(key, make_shared<const vector<real>>(_pP));
     } else {
       // Use series expansions in n for Fourier coeffients of the integral
       // See "Series expansions for computing rhumb areas"
@@ -210,9 +232,102 @@ namespace GeographicLib {
   void Rhumb::GenInverse(real lat1, real lon1, real lat2, real lon2,
                          unsigned outmask,
                          real& s12, real& azi12, real& S12) const {
+    AuxAngle phi1(AuxAngle::degrees(lat1)),
+      chi1(_aux.Convert(_aux.PHI, _aux.CHI, phi1, _exact));
+    IntInverse(phi1, chi1, nullptr, lon1, lat2, lon2, outmask,
+               s12, azi12, S12);
+  }
+
+  void Rhumb::GenInverse(size_t n,
+                         const real lat1[], const real lon1[],
+                         const real lat2[], const real lon2[],
+                         unsigned outmask,
+                         real s12[], real azi12[], real S12[]) const {
     using std::isinf;           // Needed for Centos 7, ubuntu 14
-    AuxAngle phi1(AuxAngle::degrees(lat1)), phi2(AuxAngle::degrees(lat2)),
-      chi1(_aux.Convert(_aux.PHI, _aux.CHI, phi1, _exact)),
+    // The problems are handled in groups of AuxLatitude::lanes.  The
+    // auxiliary latitudes are found for each problem in turn and the divided
+    // differences are then evaluated for the whole group.  The steps are the
+    // same as in IntInverse, so that the results are identical.
+    const int K = AuxLanes::K;
+    bool area = outmask & AREA, dist = outmask & DISTANCE;
+    AuxAngle phi1, chi1, pb1[2], phi2, chi2, pb2[2];
+    AuxLanes l1, l2;
+    real lon12[K], h[K], dl[K], dmu[K], M[K];
+    bool batch[K];              // is s12 to be found for the whole group?
+    for (size_t i0 = 0; i0 < n; i0 += K) {
+      int nk = int(min(size_t(K), n - i0));
+      for (int i = 0; i < nk; ++i) {
+        size_t j = i0 + i;
+        if (j == 0 || !(lat1[j] == lat1[j-1] &&
+                        signbit(lat1[j]) == signbit(lat1[j-1]))) {
+          if (j > 0 && lat1[j] == lat2[j-1] &&
+              signbit(lat1[j]) == signbit(lat2[j-1])) {
+            // A polyline: reuse the conversions for the previous point 2
+            phi1 = phi2; chi1 = chi2;
+            if (area) { pb1[0] = pb2[0]; pb1[1] = pb2[1]; }
+          } else {
+            phi1 = AuxAngle::degrees(lat1[j]);
+            chi1 = _aux.Convert(_aux.PHI, _aux.CHI, phi1, _exact);
+            if (area) MeanSinXiAux(chi1, pb1);
+          }
+        }
+        phi2 = AuxAngle::degrees(lat2[j]);
+        chi2 = _aux.Convert(_aux.PHI, _aux.CHI, phi2, _exact);
+        if (area) MeanSinXiAux(chi2, pb2);
+        l1.Set(i, chi1, area ? pb1 : nullptr);
+        l2.Set(i, chi2, area ? pb2 : nullptr);
+        lon12[i] = Math::AngDiff(lon1[j], lon2[j]);
+        real
+          lam12 = lon12[i] * Math::degree<real>(),
+          psi1 = chi1.lam(),
+          psi2 = chi2.lam(),
+          psi12 = psi2 - psi1;
+        if (outmask & AZIMUTH)
+          azi12[j] = Math::atan2d(lam12, psi12);
+        batch[i] = false;
+        if (dist) {
+          if (isinf(psi1) || isinf(psi2))
+            s12[j] = fabs(_aux.Convert(AuxLatitude::PHI, AuxLatitude::MU,
+                                       phi2, _exact).radians() -
+                          _aux.Convert(AuxLatitude::PHI, AuxLatitude::MU,
+                                       phi1, _exact).radians()) * _rm;
+          else {
+            h[i] = hypot(lam12, psi12);
+            if (_exact) {
+              real dmudpsi =
+                _aux.DRectifying(phi1, phi2) / _aux.DIsometric(phi1, phi2);
+              s12[j] = h[i] * dmudpsi * _rm;
+            } else
+              batch[i] = true;
+          }
+        }
+      }
+      if (!_exact && (dist || area))
+        DAuxLatitude::Dlam(nk, l1.t, l2.t, dl);
+      if (dist && !_exact) {
+        _aux.DConvert(AuxLatitude::CHI, AuxLatitude::MU, nk,
+                      l1.chiy, l1.chix, l2.chiy, l2.chix, dmu);
+        for (int i = 0; i < nk; ++i) {
+          if (batch[i]) {
+            real dmudpsi = dmu[i] / dl[i];
+            s12[i0 + i] = h[i] * dmudpsi * _rm;
+          }
+        }
+      }
+      if (area) {
+        MeanSinXi(nk, l1, l2, dl, M);
+        for (int i = 0; i < nk; ++i)
+          S12[i0 + i] = _c2 * lon12[i] * M[i];
+      }
+    }
+  }
+
+  void Rhumb::IntInverse(const AuxAngle& phi1, const AuxAngle& chi1,
+                         const AuxAngle* pbx, real lon1, real lat2, real lon2,
+                         unsigned outmask,
+                         real& s12, real& azi12, real& S12) const {
+    using std::isinf;           // Needed for Centos 7, ubuntu 14
+    AuxAngle phi2(AuxAngle::degrees(lat2)),
       chi2(_aux.Convert(_aux.PHI, _aux.CHI, phi2, _exact));
     real
       lon12 = Math::AngDiff(lon1, lon2),
@@ -239,7 +354,7 @@ namespace GeographicLib {
       }
     }
     if (outmask & AREA)
-      S12 = _c2 * lon12 * MeanSinXi(chi1, chi2);
+      S12 = _c2 * lon12 * MeanSinXi(chi1, chi2, pbx);
   }
 
   RhumbLine Rhumb::Line(real lat1, real lon1, real azi12) const
@@ -250,12 +365,21 @@ namespace GeographicLib {
                         real& lat2, real& lon2, real& S12) const
   { Line(lat1, lon1, azi12).GenPosition(s12, outmask, lat2, lon2, S12); }
 
-  Math::real Rhumb::MeanSinXi(const AuxAngle& chix, const AuxAngle& chiy)
-    const {
+  void Rhumb::MeanSinXiAux(const AuxAngle& chix, AuxAngle pbx[2]) const {
+    pbx[0] = _aux.Convert(_aux.CHI, _aux.PHI , chix, _exact);
+    pbx[1] = _aux.Convert(_aux.PHI, _aux.BETA, pbx[0], _exact).normalized();
+  }
+
+  Math::real Rhumb::MeanSinXi(const AuxAngle& chix, const AuxAngle& chiy,
+                              const AuxAngle* pbx) const {
+    AuxAngle pbxt[2];
+    if (!pbx) {
+      MeanSinXiAux(chix, pbxt);
+      pbx = pbxt;
+    }
+    const AuxAngle& phix = pbx[0], & betax = pbx[1];
     AuxAngle
-      phix (_aux.Convert(_aux.CHI, _aux.PHI , chix, _exact)),
       phiy (_aux.Convert(_aux.CHI, _aux.PHI , chiy, _exact)),
-      betax(_aux.Convert(_aux.PHI, _aux.BETA, phix, _exact).normalized()),
       betay(_aux.Convert(_aux.PHI, _aux.BETA, phiy, _exact).normalized());
     real DpbetaDbeta =
       DAuxLatitude::DClenshaw(false,
@@ -270,6 +394,33 @@ namespace GeographicLib {
     return DAuxLatitude::Dp0Dpsi(tx, ty) + DpbetaDbeta * DbetaDpsi;
   }
 
+  void Rhumb::MeanSinXi(int n, const AuxLanes& x, const AuxLanes& y,
+                        const real dlam[], real M[]) const {
+    // The lanes version of MeanSinXi(const AuxAngle&, const AuxAngle&,
+    // const AuxAngle*)
+    const int K = AuxLanes::K;
+    real Delta[K] = {}, DpbetaDbeta[K], DbetaDpsi[K];
+    for (int i = 0; i < n; ++i)
+      Delta[i] = atan2(y.betay[i], y.betax[i]) - atan2(x.betay[i], x.betax[i]);
+    DAuxLatitude::DClenshaw(false, n, Delta, x.betay, x.betax,
+                            y.betay, y.betax, _pP.data(), _lL, DpbetaDbeta);
+    if (_exact) {
+      for (int i = 0; i < n; ++i) {
+        AuxAngle phix(x.phiy[i], x.phix[i]), phiy(y.phiy[i], y.phix[i]);
+        DbetaDpsi[i] =
+          _aux.DParametric(phix, phiy) / _aux.DIsometric(phix, phiy);
+      }
+    } else {
+      _aux.DConvert(AuxLatitude::CHI, AuxLatitude::BETA, n,
+                    x.chiy, x.chix, y.chiy, y.chix, DbetaDpsi);
+      for (int i = 0; i < n; ++i)
+        DbetaDpsi[i] /= dlam[i];
+    }
+    DAuxLatitude::Dp0Dpsi(n, x.t, y.t, M);
+    for (int i = 0; i < n; ++i)
+      M[i] += DpbetaDbeta[i] * DbetaDpsi[i];
+  }
+
   RhumbLine::RhumbLine(const Rhumb& rh, real lat1, real lon1, real azi12)
     : _rh(rh)
     , _lat1(Math::LatFix(lat1))
@@ -286,6 +437,84 @@ namespace GeographicLib {
   }
 
   void RhumbLine::GenPosition(real s12, unsigned outmask,
+                              real& lat2, real& lon2, real& S12) const
+  { IntPosition(s12, outmask, nullptr, lat2, lon2, S12); }
+
+  void RhumbLine::GenPosition(size_t n, const real s12[], unsigned outmask,
+                              real lat2[], real lon2[], real S12[]) const {
+    // The points are handled in groups of AuxLatitude::lanes.  The auxiliary
+    // latitudes are found for each point in turn and the divided differences
+    // are then evaluated for the whole group.  The steps are the same as in
+    // IntPosition, so that the results are identical.
+    typedef Rhumb::AuxLanes AuxLanes;
+    const int K = AuxLanes::K;
+    bool area = outmask & AREA;
+    AuxAngle pbx[2], pb2[2];
+    if (area) _rh.MeanSinXiAux(_chi1, pbx);
+    AuxLanes l1, l2;
+    for (int i = 0; i < K; ++i)
+      l1.Set(i, _chi1, area ? pbx : nullptr);
+    real r12[K], dl[K], dmudpsi[K], M[K];
+    bool inrange[K];
+    for (size_t i0 = 0; i0 < n; i0 += K) {
+      int nk = int(min(size_t(K), n - i0));
+      for (int i = 0; i < nk; ++i) {
+        size_t j = i0 + i;
+        r12[i] = s12[j] / (_rh._rm * Math::degree()); // in degrees
+        real
+          mu12 = r12[i] * _calp,
+          mu2 = _mu1 + mu12;
+        inrange[i] = fabs(mu2) <= Math::qd;
+        if (inrange[i]) {
+          AuxAngle mu2a(AuxAngle::degrees(mu2)),
+            phi2(_rh._aux.Convert(AuxLatitude::MU, AuxLatitude::PHI,
+                                  mu2a, _rh._exact)),
+            chi2(_rh._aux.Convert(AuxLatitude::PHI, AuxLatitude::CHI,
+                                  phi2, _rh._exact));
+          if (outmask & LATITUDE) lat2[j] = phi2.degrees();
+          if (area) _rh.MeanSinXiAux(chi2, pb2);
+          l2.Set(i, chi2, area ? pb2 : nullptr);
+          if (_rh._exact)
+            dmudpsi[i] = _rh._aux.DRectifying(_phi1, phi2) /
+              _rh._aux.DIsometric(_phi1, phi2);
+        } else {
+          // Reduce to the interval [-180, 180)
+          mu2 = Math::AngNormalize(mu2);
+          // Deal with points on the anti-meridian
+          if (fabs(mu2) > Math::qd) mu2 = Math::AngNormalize(Math::hd - mu2);
+          if (outmask & LATITUDE)
+            lat2[j] = _rh._aux.Convert(AuxLatitude::MU, AuxLatitude::PHI,
+                                       AuxAngle::degrees(mu2),
+                                       _rh._exact).degrees();
+          // A placeholder for the lane
+          l2.Set(i, _chi1, area ? pbx : nullptr);
+        }
+      }
+      if (!_rh._exact) {
+        DAuxLatitude::Dlam(nk, l1.t, l2.t, dl);
+        _rh._aux.DConvert(AuxLatitude::CHI, AuxLatitude::MU, nk,
+                          l1.chiy, l1.chix, l2.chiy, l2.chix, dmudpsi);
+        for (int i = 0; i < nk; ++i)
+          dmudpsi[i] /= dl[i];
+      }
+      if (area) _rh.MeanSinXi(nk, l1, l2, dl, M);
+      for (int i = 0; i < nk; ++i) {
+        size_t j = i0 + i;
+        if (inrange[i]) {
+          real lon2x = r12[i] * _salp / dmudpsi[i];
+          if (area) S12[j] = _rh._c2 * lon2x * M[i];
+          if (outmask & LONGITUDE)
+            lon2[j] = outmask & LONG_UNROLL ? _lon1 + lon2x :
+              Math::AngNormalize(Math::AngNormalize(_lon1) + lon2x);
+        } else {
+          if (outmask & LONGITUDE) lon2[j] = Math::NaN();
+          if (area) S12[j] = Math::NaN();
+        }
+      }
+    }
+  }
+
+  void RhumbLine::IntPosition(real s12, unsigned outmask, const AuxAngle* pbx,
                               real& lat2, real& lon2, real& S12) const {
     real
       r12 = s12 / (_rh._rm * Math::degree()), // scaled distance in degrees
@@ -305,7 +534,7 @@ namespace GeographicLib {
         / DAuxLatitude::Dlam(_chi1.tan(), chi2.tan());
       lon2x = r12 * _salp / dmudpsi;
       if (outmask & AREA)
-        S12 = _rh._c2 * lon2x * _rh.MeanSinXi(_chi1, chi2);
+        S12 = _rh._c2 * lon2x * _rh.MeanSinXi(_chi1, chi2, pbx);
       lon2x = outmask & LONG_UNROLL ? _lon1 + lon2x :
         Math::AngNormalize(Math::AngNormalize(_lon1) + lon2x);
     } else {
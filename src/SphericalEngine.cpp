@@ -133,6 +133,11 @@
 #include <GeographicLib/SphericalEngine.hpp>
 #include <GeographicLib/CircularEngine.hpp>
 #include <GeographicLib/Utility.hpp>
+#include <GeographicLib/Executor.hpp>
+#include <GeographicLib/Tracer.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
 
 #if defined(_MSC_VER)
 // Squelch warnings about constant conditional expressions and potentially
@@ -144,9 +149,105 @@ namespace GeographicLib {
 
   using namespace std;
 
-  vector<Math::real>& SphericalEngine::sqrttable() {
-    static vector<real> sqrttable(0);
-    return sqrttable;
+  namespace {
+    // The table of square roots is published through an atomic pointer.  A
+    // table is never modified once published; RootTable replaces it with a
+    // larger copy.  The superseded tables are kept (until ClearRootTable is
+    // called) because other threads may still be reading them.
+    atomic<const vector<Math::real>*>& roottable() {
+      static const vector<Math::real> empty(0);
+      static atomic<const vector<Math::real>*> p(&empty);
+      return p;
+    }
+    // All the tables which have been published, guarded by roottablelock.
+    vector<unique_ptr<const vector<Math::real>>>& roottables() {
+      static vector<unique_ptr<const vector<Math::real>>> tables;
+      return tables;
+    }
+    mutex& roottablelock() {
+      static mutex lock;
+      return lock;
+    }
+  }
+
+  const vector<Math::real>& SphericalEngine::sqrttable()
+  { return *roottable().load(memory_order_acquire); }
+
+  namespace {
+    // The number of threads set by set_threads.
+    atomic<int>& threadcount() {
+      static atomic<int> n(1);
+      return n;
+    }
+  }
+
+  void SphericalEngine::set_threads(int nthreads)
+  { threadcount() = max(1, nthreads); }
+
+  int SphericalEngine::threads() { return threadcount(); }
+
+  int SphericalEngine::sumthreads(int N, int M) {
+    // Parallelize sums with at least 2^15 terms giving each thread at least
+    // 32 orders.
+    int nt = threadcount();
+    return nt <= 1 || M < 0 || coeff::Csize(N, M) < (1 << 15) ? 1 :
+      max(1, min(nt, (M + 1) / 32));
+  }
+
+  template<bool gradp, SphericalEngine::normalization norm, int L,
+           SphericalEngine::storage stor>
+  void SphericalEngine::InnerSum(const coeff c[], const real f[], int m,
+                                 real q, real q2, real t, real u, real w[]) {
+    int N = c[0].nmx();
+    // Initialize inner sum
+    real
+      wc  = 0, wc2  = 0, ws  = 0, ws2  = 0, // w [N - m + 1], w [N - m + 2]
+      wrc = 0, wrc2 = 0, wrs = 0, wrs2 = 0, // wr[N - m + 1], wr[N - m + 2]
+      wtc = 0, wtc2 = 0, wts = 0, wts2 = 0; // wt[N - m + 1], wt[N - m + 2]
+    int k[L];
+    const vector<real>& root( sqrttable() );
+    for (int l = 0; l < L; ++l)
+      k[l] = c[l].index(N, m) + 1;
+    for (int n = N; n >= m; --n) {             // n = N .. m; l = N - m .. 0
+      real v, A, Ax, B, R;    // alpha[l], beta[l + 1]
+      switch (norm) {
+      case FULL:
+        v = root[2 * n + 1] / (root[n - m + 1] * root[n + m + 1]);
+        Ax = q * v * root[2 * n + 3];
+        A = t * Ax;
+        B = - q2 * root[2 * n + 5] /
+          (v * root[n - m + 2] * root[n + m + 2]);
+        break;
+      case SCHMIDT:
+        v = root[n - m + 1] * root[n + m + 1];
+        Ax = q * (2 * n + 1) / v;
+        A = t * Ax;
+        B = - q2 * v / (root[n - m + 2] * root[n + m + 2]);
+        break;
+      default: break;       // To suppress warning message from Visual Studio
+      }
+      R = Cv<stor>(c[0], --k[0]);
+      for (int l = 1; l < L; ++l)
+        R += Cv<stor>(c[l], --k[l], n, m, f[l]);
+      R *= scale();
+      v = A * wc + B * wc2 + R; wc2 = wc; wc = v;
+      if (gradp) {
+        v = A * wrc + B * wrc2 + (n + 1) * R; wrc2 = wrc; wrc = v;
+        v = A * wtc + B * wtc2 -  u*Ax * wc2; wtc2 = wtc; wtc = v;
+      }
+      if (m) {
+        R = Sv<stor>(c[0], k[0]);
+        for (int l = 1; l < L; ++l)
+          R += Sv<stor>(c[l], k[l], n, m, f[l]);
+        R *= scale();
+        v = A * ws + B * ws2 + R; ws2 = ws; ws = v;
+        if (gradp) {
+          v = A * wrs + B * wrs2 + (n + 1) * R; wrs2 = wrs; wrs = v;
+          v = A * wts + B * wts2 -  u*Ax * ws2; wts2 = wts; wts = v;
+        }
+      }
+    }
+    w[0] = wc; w[1] = ws; w[2] = wrc; w[3] = wrs; w[4] = wtc; w[5] = wts;
   }
 
   template<bool gradp, SphericalEngine::normalization norm, int L>
@@ -157,6 +258,7 @@ namespace GeographicLib {
     static_assert(L > 0, "L must be positive");
     static_assert(norm == FULL || norm == SCHMIDT, "Unknown normalization");
     int N = c[0].nmx(), M = c[0].mmx();
+    const storage stor = Storage<L>(c);
 
     real
       p = hypot(x, y),
@@ -171,6 +273,25 @@ namespace GeographicLib {
       uq = u * q,
       uq2 = Math::sq(uq),
       tu = t / u;
+    // With multiple threads, first compute all the inner sums concurrently.
+    // Thread j handles orders m = M - j, M - j - nt, ....
+    vector<real> wsum;
+    int nt = sumthreads(N, M);
+    if (nt > 1) {
+      try {
+        wsum.resize(6 * size_t(M + 1));
+        auto work = [&](int j) -> void {
+          for (int m = M - j; m >= 0; m -= nt)
+            InnerSum<gradp, norm, L>(stor, c, f, m, q, q2, t, u,
+                                     &wsum[6 * m]);
+        };
+        Executor::RunGuarded(nt, work, []() -> void {});
+      }
+      catch (const exception&) {
+        // Fall back to serial evaluation
+        wsum.clear();
+      }
+    }
     // Initialize outer sum
     real vc  = 0, vc2  = 0, vs  = 0, vs2  = 0;   // v [N + 1], v [N + 2]
     // vr, vt, vl and similar w variable accumulate the sums for the
@@ -178,55 +299,17 @@ namespace GeographicLib {
     real vrc = 0, vrc2 = 0, vrs = 0, vrs2 = 0;   // vr[N + 1], vr[N + 2]
     real vtc = 0, vtc2 = 0, vts = 0, vts2 = 0;   // vt[N + 1], vt[N + 2]
     real vlc = 0, vlc2 = 0, vls = 0, vls2 = 0;   // vl[N + 1], vl[N + 2]
-    int k[L];
     const vector<real>& root( sqrttable() );
     for (int m = M; m >= 0; --m) {   // m = M .. 0
-      // Initialize inner sum
+      real w[6];
+      if (wsum.empty())
+        InnerSum<gradp, norm, L>(stor, c, f, m, q, q2, t, u, w);
+      else
+        copy(wsum.begin() + 6 * m, wsum.begin() + 6 * (m + 1), w);
       real
-        wc  = 0, wc2  = 0, ws  = 0, ws2  = 0, // w [N - m + 1], w [N - m + 2]
-        wrc = 0, wrc2 = 0, wrs = 0, wrs2 = 0, // wr[N - m + 1], wr[N - m + 2]
-        wtc = 0, wtc2 = 0, wts = 0, wts2 = 0; // wt[N - m + 1], wt[N - m + 2]
-      for (int l = 0; l < L; ++l)
-        k[l] = c[l].index(N, m) + 1;
-      for (int n = N; n >= m; --n) {             // n = N .. m; l = N - m .. 0
-        real w, A, Ax, B, R;    // alpha[l], beta[l + 1]
-        switch (norm) {
-        case FULL:
-          w = root[2 * n + 1] / (root[n - m + 1] * root[n + m + 1]);
-          Ax = q * w * root[2 * n + 3];
-          A = t * Ax;
-          B = - q2 * root[2 * n + 5] /
-            (w * root[n - m + 2] * root[n + m + 2]);
-          break;
-        case SCHMIDT:
-          w = root[n - m + 1] * root[n + m + 1];
-          Ax = q * (2 * n + 1) / w;
-          A = t * Ax;
-          B = - q2 * w / (root[n - m + 2] * root[n + m + 2]);
-          break;
-        default: break;       // To suppress warning message from Visual Studio
-        }
-        R = c[0].Cv(--k[0]);
-        for (int l = 1; l < L; ++l)
-          R += c[l].Cv(--k[l], n, m, f[l]);
-        R *= scale();
-        w = A * wc + B * wc2 + R; wc2 = wc; wc = w;
-        if (gradp) {
-          w = A * wrc + B * wrc2 + (n + 1) * R; wrc2 = wrc; wrc = w;
-          w = A * wtc + B * wtc2 -  u*Ax * wc2; wtc2 = wtc; wtc = w;
-        }
-        if (m) {
-          R = c[0].Sv(k[0]);
-          for (int l = 1; l < L; ++l)
-            R += c[l].Sv(k[l], n, m, f[l]);
-          R *= scale();
-          w = A * ws + B * ws2 + R; ws2 = ws; ws = w;
-          if (gradp) {
-            w = A * wrs + B * wrs2 + (n + 1) * R; wrs2 = wrs; wrs = w;
-            w = A * wts + B * wts2 -  u*Ax * ws2; wts2 = wts; wts = w;
-          }
-        }
-      }
+        wc  = w[0], ws  = w[1],
+        wrc = w[2], wrs = w[3],
+        wtc = w[4], wts = w[5];
       // Now Sc[m] = wc, Ss[m] = ws
       // Sc'[m] = wtc, Ss'[m] = wtc
       if (m) {
@@ -293,6 +376,372 @@ namespace GeographicLib {
     return vc;
   }
 
+  template<bool gradp, SphericalEngine::normalization norm, int L>
+  void SphericalEngine::Values(const coeff c[], const real f[], size_t n,
+                               const real x[], const real y[], const real z[],
+                               real a, real V[],
+                               real gradx[], real grady[], real gradz[]) {
+    static_assert(L > 0, "L must be positive");
+    static_assert(norm == FULL || norm == SCHMIDT, "Unknown normalization");
+    const int K = lanes;
+    int N = c[0].nmx(), M = c[0].mmx();
+    const vector<real>& root( sqrttable() );
+    for (size_t i0 = 0; i0 < n; i0 += K) {
+      // Process the points [i0, i0 + nk) as K lanes; the unused lanes
+      // duplicate the last point.
+      int nk = int(min(size_t(K), n - i0));
+      real cl[K], sl[K], r[K], t[K], u[K], q[K], q2[K], uq[K], uq2[K], tu[K];
+      for (int i = 0; i < K; ++i) {
+        size_t j = i0 + min(i, nk - 1);
+        real p = hypot(x[j], y[j]);
+        cl[i] = p != 0 ? x[j] / p : 1;
+        sl[i] = p != 0 ? y[j] / p : 0;
+        r[i] = hypot(z[j], p);
+        t[i] = r[i] != 0 ? z[j] / r[i] : 0;
+        u[i] = r[i] != 0 ? fmax(p / r[i], eps()) : 1;
+        q[i] = a / r[i];
+        q2[i] = Math::sq(q[i]);
+        uq[i] = u[i] * q[i];
+        uq2[i] = Math::sq(uq[i]);
+        tu[i] = t[i] / u[i];
+      }
+      // Initialize outer sums
+      real vc [K] = {}, vc2 [K] = {}, vs [K] = {}, vs2 [K] = {},
+        vrc[K] = {}, vrc2[K] = {}, vrs[K] = {}, vrs2[K] = {},
+        vtc[K] = {}, vtc2[K] = {}, vts[K] = {}, vts2[K] = {},
+        vlc[K] = {}, vlc2[K] = {}, vls[K] = {}, vls2[K] = {};
+      for (int m = M; m >= 0; --m) {   // m = M .. 0
+        // Initialize inner sums
+        real wc [K] = {}, wc2 [K] = {}, ws [K] = {}, ws2 [K] = {},
+          wrc[K] = {}, wrc2[K] = {}, wrs[K] = {}, wrs2[K] = {},
+          wtc[K] = {}, wtc2[K] = {}, wts[K] = {}, wts2[K] = {};
+        int k[L];
+        for (int l = 0; l < L; ++l)
+          k[l] = c[l].index(N, m) + 1;
+        for (int nn = N; nn >= m; --nn) {      // n = N .. m
+          // The lane independent parts of alpha[l], beta[l + 1]
+          real v, Av, Bv, Bd;
+          switch (norm) {
+          case FULL:
+            v = root[2 * nn + 1] / (root[nn - m + 1] * root[nn + m + 1]);
+            Av = root[2 * nn + 3];
+            Bv = root[2 * nn + 5];
+            Bd = v * root[nn - m + 2] * root[nn + m + 2];
+            break;
+          case SCHMIDT:
+            v = root[nn - m + 1] * root[nn + m + 1];
+            Av = 2 * nn + 1;
+            Bv = v;
+            Bd = root[nn - m + 2] * root[nn + m + 2];
+            break;
+          default: break;     // To suppress warning message from Visual Studio
+          }
+          // Load the coefficients once for all the lanes
+          real Rc = c[0].Cv(--k[0]), Rs = 0;
+          for (int l = 1; l < L; ++l)
+            Rc += c[l].Cv(--k[l], nn, m, f[l]);
+          Rc *= scale();
+          if (m) {
+            Rs = c[0].Sv(k[0]);
+            for (int l = 1; l < L; ++l)
+              Rs += c[l].Sv(k[l], nn, m, f[l]);
+            Rs *= scale();
+          }
+          for (int i = 0; i < K; ++i) {
+            real
+              Ax = norm == FULL ? q[i] * v * Av : q[i] * Av / v,
+              A = t[i] * Ax,
+              B = - q2[i] * Bv / Bd,
+              w;
+            w = A * wc[i] + B * wc2[i] + Rc; wc2[i] = wc[i]; wc[i] = w;
+            if (gradp) {
+              w = A * wrc[i] + B * wrc2[i] + (nn + 1) * Rc;
+              wrc2[i] = wrc[i]; wrc[i] = w;
+              w = A * wtc[i] + B * wtc2[i] -  u[i]*Ax * wc2[i];
+              wtc2[i] = wtc[i]; wtc[i] = w;
+            }
+            if (m) {
+              w = A * ws[i] + B * ws2[i] + Rs; ws2[i] = ws[i]; ws[i] = w;
+              if (gradp) {
+                w = A * wrs[i] + B * wrs2[i] + (nn + 1) * Rs;
+                wrs2[i] = wrs[i]; wrs[i] = w;
+                w = A * wts[i] + B * wts2[i] -  u[i]*Ax * ws2[i];
+                wts2[i] = wts[i]; wts[i] = w;
+              }
+            }
+          }
+        }
+        if (m) {
+          real v, Bv;           // The lane independent parts of alpha, beta
+          switch (norm) {
+          case FULL:
+            v = root[2] * root[2 * m + 3] / root[m + 1];
+            Bv = - v * root[2 * m + 5] / (root[8] * root[m + 2]);
+            break;
+          case SCHMIDT:
+            v = root[2] * root[2 * m + 1] / root[m + 1];
+            Bv = - v * root[2 * m + 3] / (root[8] * root[m + 2]);
+            break;
+          default: break;     // To suppress warning message from Visual Studio
+          }
+          for (int i = 0; i < K; ++i) {
+            real A = cl[i] * v * uq[i], B = Bv * uq2[i], w;
+            w = A * vc [i] + B * vc2 [i] +  wc [i];
+            vc2 [i] = vc [i]; vc [i] = w;
+            w = A * vs [i] + B * vs2 [i] +  ws [i];
+            vs2 [i] = vs [i]; vs [i] = w;
+            if (gradp) {
+              wtc[i] += m * tu[i] * wc[i]; wts[i] += m * tu[i] * ws[i];
+              w = A * vrc[i] + B * vrc2[i] +  wrc[i];
+              vrc2[i] = vrc[i]; vrc[i] = w;
+              w = A * vrs[i] + B * vrs2[i] +  wrs[i];
+              vrs2[i] = vrs[i]; vrs[i] = w;
+              w = A * vtc[i] + B * vtc2[i] +  wtc[i];
+              vtc2[i] = vtc[i]; vtc[i] = w;
+              w = A * vts[i] + B * vts2[i] +  wts[i];
+              vts2[i] = vts[i]; vts[i] = w;
+              w = A * vlc[i] + B * vlc2[i] + m*ws[i];
+              vlc2[i] = vlc[i]; vlc[i] = w;
+              w = A * vls[i] + B * vls2[i] - m*wc[i];
+              vls2[i] = vls[i]; vls[i] = w;
+            }
+          }
+        } else {
+          real Av, Bv;
+          switch (norm) {
+          case FULL:
+            Av = root[3];
+            Bv = - root[15]/2;
+            break;
+          case SCHMIDT:
+            Av = 1;
+            Bv = - root[3]/2;
+            break;
+          default: break;     // To suppress warning message from Visual Studio
+          }
+          for (int i = 0; i < K; ++i) {
+            real
+              A = Av * uq[i],
+              B = Bv * uq2[i],
+              qs = q[i] / scale();
+            vc[i] = qs * (wc[i] + A * (cl[i] * vc[i] + sl[i] * vs[i]) +
+                          B * vc2[i]);
+            if (gradp) {
+              qs /= r[i];
+              vrc[i] =   - qs * (wrc[i] + A * (cl[i] * vrc[i] + sl[i] * vrs[i])
+                                 + B * vrc2[i]);
+              vtc[i] =     qs * (wtc[i] + A * (cl[i] * vtc[i] + sl[i] * vts[i])
+                                 + B * vtc2[i]);
+              vlc[i] = qs / u[i] * (      A * (cl[i] * vlc[i] + sl[i] * vls[i])
+                                       + B * vlc2[i]);
+            }
+          }
+        }
+      }
+      for (int i = 0; i < nk; ++i) {
+        size_t j = i0 + i;
+        V[j] = vc[i];
+        if (gradp) {
+          // Rotate into cartesian (geocentric) coordinates
+          gradx[j] = cl[i] * (u[i] * vrc[i] + t[i] * vtc[i]) - sl[i] * vlc[i];
+          grady[j] = sl[i] * (u[i] * vrc[i] + t[i] * vtc[i]) + cl[i] * vlc[i];
+          gradz[j] =          t[i] * vrc[i] - u[i] * vtc[i]                  ;
+        }
+      }
+    }
+  }
+
+  template<bool gradp, SphericalEngine::normalization norm,
+           SphericalEngine::storage stor>
+  void SphericalEngine::Sums(int K, const coeff c[],
+                             real x, real y, real z, real a, real V[],
+                             real gradx[], real grady[], real gradz[]) {
+    real
+      p = hypot(x, y),
+      cl = p != 0 ? x / p : 1,  // cos(lambda); at pole, pick lambda = 0
+      sl = p != 0 ? y / p : 0,  // sin(lambda)
+      r = hypot(z, p),
+      t = r != 0 ? z / r : 0,   // cos(theta); at origin, pick theta = pi/2
+      u = r != 0 ? fmax(p / r, eps()) : 1, // sin(theta); but avoid the pole
+      q = a / r;
+    real
+      q2 = Math::sq(q),
+      uq = u * q,
+      uq2 = Math::sq(uq),
+      tu = t / u;
+    // The state of the outer sums for each of the K sums and the results of
+    // the inner sums for the current order; the names are those used in
+    // Value.  Sum j only takes part for orders m <= c[j].mmx(); otherwise
+    // its terms would vanish and its state remains zero.
+    struct state {
+      real wc, ws, wrc, wrs, wtc, wts,
+        vc, vc2, vs, vs2, vrc, vrc2, vrs, vrs2, vtc, vtc2, vts, vts2,
+        vlc, vlc2, vls, vls2;
+    };
+    vector<state> st(K, state());
+    int M = -1, N = -1;
+    for (int j = 0; j < K; ++j) {
+      M = max(M, c[j].mmx());
+      N = max(N, c[j].nmx());
+    }
+    // The factors alpha[l], beta[l + 1], and u * alpha[l] / t in the
+    // recurrence for the inner sums, indexed by n.
+    vector<real> fA(N + 1), fB(N + 1), fuAx(N + 1);
+    const vector<real>& root( sqrttable() );
+    for (int m = M; m >= 0; --m) {   // m = M .. 0
+      // The inner sums over n for order m.  The factors in the recurrence
+      // depend only on n and m and so are computed once for all the sums.
+      int Nm = -1;
+      for (int j = 0; j < K; ++j)
+        if (m <= c[j].mmx()) Nm = max(Nm, c[j].nmx());
+      for (int n = Nm; n >= m; --n) {
+        real v, A, Ax, B;
+        switch (norm) {
+        case FULL:
+          v = root[2 * n + 1] / (root[n - m + 1] * root[n + m + 1]);
+          Ax = q * v * root[2 * n + 3];
+          A = t * Ax;
+          B = - q2 * root[2 * n + 5] /
+            (v * root[n - m + 2] * root[n + m + 2]);
+          break;
+        case SCHMIDT:
+          v = root[n - m + 1] * root[n + m + 1];
+          Ax = q * (2 * n + 1) / v;
+          A = t * Ax;
+          B = - q2 * v / (root[n - m + 2] * root[n + m + 2]);
+          break;
+        default: break;     // To suppress warning message from Visual Studio
+        }
+        fA[n] = A; fB[n] = B; fuAx[n] = u*Ax;
+      }
+      for (int j = 0; j < K; ++j) {
+        if (m > c[j].mmx()) continue;
+        const int Nj = c[j].nmx();
+        real
+          wc  = 0, wc2  = 0, ws  = 0, ws2  = 0, // w [N - m + 1], w [N - m + 2]
+          wrc = 0, wrc2 = 0, wrs = 0, wrs2 = 0, // wr[N - m + 1], wr[N - m + 2]
+          wtc = 0, wtc2 = 0, wts = 0, wts2 = 0; // wt[N - m + 1], wt[N - m + 2]
+        int k = c[j].index(Nj, m) + 1;
+        for (int n = Nj; n >= m; --n) {
+          real v, R, A = fA[n], B = fB[n];
+          R = Cv<stor>(c[j], --k);
+          R *= scale();
+          v = A * wc + B * wc2 + R; wc2 = wc; wc = v;
+          if (gradp) {
+            v = A * wrc + B * wrc2 + (n + 1) * R; wrc2 = wrc; wrc = v;
+            v = A * wtc + B * wtc2 -  fuAx[n] * wc2; wtc2 = wtc; wtc = v;
+          }
+          if (m) {
+            R = Sv<stor>(c[j], k);
+            R *= scale();
+            v = A * ws + B * ws2 + R; ws2 = ws; ws = v;
+            if (gradp) {
+              v = A * wrs + B * wrs2 + (n + 1) * R; wrs2 = wrs; wrs = v;
+              v = A * wts + B * wts2 -  fuAx[n] * ws2; wts2 = wts; wts = v;
+            }
+          }
+        }
+        state& s = st[j];
+        s.wc = wc; s.ws = ws;
+        s.wrc = wrc; s.wrs = wrs;
+        s.wtc = wtc; s.wts = wts;
+      }
+      // The step of the outer sums for order m; as with the inner sums, the
+      // factors are computed once.
+      if (m) {
+        real v, A, B;           // alpha[m], beta[m + 1]
+        switch (norm) {
+        case FULL:
+          v = root[2] * root[2 * m + 3] / root[m + 1];
+          A = cl * v * uq;
+          B = - v * root[2 * m + 5] / (root[8] * root[m + 2]) * uq2;
+          break;
+        case SCHMIDT:
+          v = root[2] * root[2 * m + 1] / root[m + 1];
+          A = cl * v * uq;
+          B = - v * root[2 * m + 3] / (root[8] * root[m + 2]) * uq2;
+          break;
+        default: break;       // To suppress warning message from Visual Studio
+        }
+        for (int j = 0; j < K; ++j) {
+          if (m > c[j].mmx()) continue;
+          state& s = st[j];
+          v = A * s.vc  + B * s.vc2  +  s.wc ; s.vc2  = s.vc ; s.vc  = v;
+          v = A * s.vs  + B * s.vs2  +  s.ws ; s.vs2  = s.vs ; s.vs  = v;
+          if (gradp) {
+            // Include the terms Sc[m] * P'[m,m](t) and Ss[m] * P'[m,m](t)
+            s.wtc += m * tu * s.wc; s.wts += m * tu * s.ws;
+            v = A * s.vrc + B * s.vrc2 +  s.wrc; s.vrc2 = s.vrc; s.vrc = v;
+            v = A * s.vrs + B * s.vrs2 +  s.wrs; s.vrs2 = s.vrs; s.vrs = v;
+            v = A * s.vtc + B * s.vtc2 +  s.wtc; s.vtc2 = s.vtc; s.vtc = v;
+            v = A * s.vts + B * s.vts2 +  s.wts; s.vts2 = s.vts; s.vts = v;
+            v = A * s.vlc + B * s.vlc2 + m*s.ws; s.vlc2 = s.vlc; s.vlc = v;
+            v = A * s.vls + B * s.vls2 - m*s.wc; s.vls2 = s.vls; s.vls = v;
+          }
+        }
+      } else {
+        real A, B, qs;
+        switch (norm) {
+        case FULL:
+          A = root[3] * uq;       // F[1]/(q*cl) or F[1]/(q*sl)
+          B = - root[15]/2 * uq2; // beta[1]/q
+          break;
+        case SCHMIDT:
+          A = uq;
+          B = - root[3]/2 * uq2;
+          break;
+        default: break;       // To suppress warning message from Visual Studio
+        }
+        for (int j = 0; j < K; ++j) {
+          if (m > c[j].mmx()) continue;
+          state& s = st[j];
+          qs = q / scale();
+          s.vc = qs * (s.wc + A * (cl * s.vc + sl * s.vs ) + B * s.vc2);
+          if (gradp) {
+            qs /= r;
+            s.vrc = - qs *
+              (s.wrc + A * (cl * s.vrc + sl * s.vrs) + B * s.vrc2);
+            s.vtc =   qs *
+              (s.wtc + A * (cl * s.vtc + sl * s.vts) + B * s.vtc2);
+            s.vlc = qs / u *
+              (        A * (cl * s.vlc + sl * s.vls) + B * s.vlc2);
+          }
+        }
+      }
+    }
+    for (int j = 0; j < K; ++j) {
+      const state& s = st[j];
+      V[j] = s.vc;
+      if (gradp) {
+        // Rotate into cartesian (geocentric) coordinates
+        gradx[j] = cl * (u * s.vrc + t * s.vtc) - sl * s.vlc;
+        grady[j] = sl * (u * s.vrc + t * s.vtc) + cl * s.vlc;
+        gradz[j] =       t * s.vrc - u * s.vtc              ;
+      }
+    }
+  }
+
+  template<bool gradp, SphericalEngine::normalization norm>
+  void SphericalEngine::Sums(int K, const coeff c[],
+                             real x, real y, real z, real a, real V[],
+                             real gradx[], real grady[], real gradz[]) {
+    static_assert(norm == FULL || norm == SCHMIDT, "Unknown normalization");
+    int nsingle = 0, ninter = 0;
+    for (int j = 0; j < K; ++j) {
+      nsingle += c[j].Single() ? 1 : 0;
+      ninter += c[j].Interleaved() ? 1 : 0;
+    }
+    if (nsingle == K)
+      Sums<gradp, norm, FLOATS>(K, c, x, y, z, a, V, gradx, grady, gradz);
+    else if (ninter == K)
+      Sums<gradp, norm, INTERLEAVED>
+        (K, c, x, y, z, a, V, gradx, grady, gradz);
+    else if (nsingle + ninter == 0)
+      Sums<gradp, norm, REALS>(K, c, x, y, z, a, V, gradx, grady, gradz);
+    else
+      Sums<gradp, norm, MIXED>(K, c, x, y, z, a, V, gradx, grady, gradz);
+  }
+
   template<bool gradp, SphericalEngine::normalization norm, int L>
   CircularEngine SphericalEngine::Circle(const coeff c[], const real f[],
                                          real p, real z, real a) {
@@ -371,60 +820,226 @@ namespace GeographicLib {
     return circ;
   }
 
+  template<bool gradp, SphericalEngine::normalization norm, int L>
+  void SphericalEngine::Circles(const coeff c[], const real f[], size_t n,
+                                const real p[], const real z[], real a,
+                                CircularEngine circ[]) {
+    static_assert(L > 0, "L must be positive");
+    static_assert(norm == FULL || norm == SCHMIDT, "Unknown normalization");
+    const int K = lanes;
+    int N = c[0].nmx(), M = c[0].mmx();
+    const vector<real>& root( sqrttable() );
+    for (size_t i0 = 0; i0 < n; i0 += K) {
+      // Process the circles [i0, i0 + nk) as nk lanes.
+      int nk = int(min(size_t(K), n - i0));
+      if (nk == 1) {
+        // A lone circle is cheaper with the scalar recursion.
+        circ[i0] = Circle<gradp, norm, L>(c, f, p[i0], z[i0], a);
+        continue;
+      }
+      real t[K], u[K], q[K], q2[K], tu[K];
+      for (int i = 0; i < nk; ++i) {
+        size_t j = i0 + i;
+        real r = hypot(z[j], p[j]);
+        t[i] = r != 0 ? z[j] / r : 0;
+        u[i] = r != 0 ? fmax(p[j] / r, eps()) : 1;
+        q[i] = a / r;
+        q2[i] = Math::sq(q[i]);
+        tu[i] = t[i] / u[i];
+        circ[j] = CircularEngine(M, gradp, norm, a, r, u[i], t[i]);
+      }
+      for (int m = M; m >= 0; --m) {   // m = M .. 0
+        // Initialize inner sums
+        real wc [K] = {}, wc2 [K] = {}, ws [K] = {}, ws2 [K] = {},
+          wrc[K] = {}, wrc2[K] = {}, wrs[K] = {}, wrs2[K] = {},
+          wtc[K] = {}, wtc2[K] = {}, wts[K] = {}, wts2[K] = {};
+        int k[L];
+        for (int l = 0; l < L; ++l)
+          k[l] = c[l].index(N, m) + 1;
+        for (int nn = N; nn >= m; --nn) {      // n = N .. m
+          // The lane independent parts of alpha[l], beta[l + 1]; unlike
+          // Values, these are combined, so that the lanes don't need a
+          // division.
+          real v, Av, Bv;
+          switch (norm) {
+          case FULL:
+            v = root[2 * nn + 1] / (root[nn - m + 1] * root[nn + m + 1]);
+            Av = v * root[2 * nn + 3];
+            Bv = - root[2 * nn + 5] /
+              (v * root[nn - m + 2] * root[nn + m + 2]);
+            break;
+          case SCHMIDT:
+            v = root[nn - m + 1] * root[nn + m + 1];
+            Av = (2 * nn + 1) / v;
+            Bv = - v / (root[nn - m + 2] * root[nn + m + 2]);
+            break;
+          default: break;     // To suppress warning message from Visual Studio
+          }
+          // Load the coefficients once for all the lanes
+          real Rc = c[0].Cv(--k[0]), Rs = 0;
+          for (int l = 1; l < L; ++l)
+            Rc += c[l].Cv(--k[l], nn, m, f[l]);
+          Rc *= scale();
+          if (m) {
+            Rs = c[0].Sv(k[0]);
+            for (int l = 1; l < L; ++l)
+              Rs += c[l].Sv(k[l], nn, m, f[l]);
+            Rs *= scale();
+          }
+          for (int i = 0; i < nk; ++i) {
+            real
+              Ax = q[i] * Av,
+              A = t[i] * Ax,
+              B = q2[i] * Bv,
+              w;
+            w = A * wc[i] + B * wc2[i] + Rc; wc2[i] = wc[i]; wc[i] = w;
+            if (gradp) {
+              w = A * wrc[i] + B * wrc2[i] + (nn + 1) * Rc;
+              wrc2[i] = wrc[i]; wrc[i] = w;
+              w = A * wtc[i] + B * wtc2[i] -  u[i]*Ax * wc2[i];
+              wtc2[i] = wtc[i]; wtc[i] = w;
+            }
+            if (m) {
+              w = A * ws[i] + B * ws2[i] + Rs; ws2[i] = ws[i]; ws[i] = w;
+              if (gradp) {
+                w = A * wrs[i] + B * wrs2[i] + (nn + 1) * Rs;
+                wrs2[i] = wrs[i]; wrs[i] = w;
+                w = A * wts[i] + B * wts2[i] -  u[i]*Ax * ws2[i];
+                wts2[i] = wts[i]; wts[i] = w;
+              }
+            }
+          }
+        }
+        for (int i = 0; i < nk; ++i) {
+          if (!gradp)
+            circ[i0 + i].SetCoeff(m, wc[i], ws[i]);
+          else {
+            // Include the terms Sc[m] * P'[m,m](t) and  Ss[m] * P'[m,m](t)
+            wtc[i] += m * tu[i] * wc[i]; wts[i] += m * tu[i] * ws[i];
+            circ[i0 + i].SetCoeff(m, wc[i], ws[i],
+                                  wrc[i], wrs[i], wtc[i], wts[i]);
+          }
+        }
+      }
+    }
+  }
+
   void SphericalEngine::RootTable(int N) {
     // Need square roots up to max(2 * N + 5, 15).
-    vector<real>& root( sqrttable() );
-    int L = max(2 * N + 5, 15) + 1, oldL = int(root.size());
+    int L = max(2 * N + 5, 15) + 1;
+    if (int(sqrttable().size()) >= L)
+      return;
+    lock_guard<mutex> guard(roottablelock());
+    const vector<real>& old( *roottable().load(memory_order_relaxed) );
+    int oldL = int(old.size());
     if (oldL >= L)
       return;
-    root.resize(L);
+    // Grow geometrically so that the superseded tables use at most as much
+    // memory as the current one.
+    L = max(L, 2 * oldL);
+    unique_ptr<vector<real>> root(new vector<real>(L));
+    copy(old.begin(), old.end(), root->begin());
     for (int l = oldL; l < L; ++l)
-      root[l] = sqrt(real(l));
+      (*root)[l] = sqrt(real(l));
+    roottables().push_back(unique_ptr<const vector<real>>(root.release()));
+    roottable().store(roottables().back().get(), memory_order_release);
+  }
+
+  size_t SphericalEngine::RootTableBytes() {
+    lock_guard<mutex> guard(roottablelock());
+    size_t bytes = 0;
+    for (const auto& t : roottables())
+      bytes += t->capacity() * sizeof(real);
+    return bytes;
+  }
+
+  void SphericalEngine::ClearRootTable() {
+    lock_guard<mutex> guard(roottablelock());
+    static const vector<real> empty(0);
+    roottable().store(&empty, memory_order_release);
+    roottables().clear();
+  }
+
+  namespace {
+    // Read the coefficients into vectors of T (real or float).
+    template<typename T>
+    void ReadCoeffs(istream& stream, int& N, int& M,
+                    vector<T>& C, vector<T>& S, bool truncate) {
+      if (truncate) {
+        if (!((N >= M && M >= 0) || (N == -1 && M == -1)))
+          // The last condition is that M = -1 implies N = -1.
+          throw GeographicErr("Bad requested degree and order " +
+                              Utility::str(N) + " " + Utility::str(M));
+      }
+      int nm[2];
+      Utility::readarray<int, int, false>(stream, nm, 2);
+      int N0 = nm[0], M0 = nm[1];
+      if (!((N0 >= M0 && M0 >= 0) || (N0 == -1 && M0 == -1)))
+        // The last condition is that M0 = -1 implies N0 = -1.
+        throw GeographicErr("Bad degree and order " +
+                            Utility::str(N0) + " " + Utility::str(M0));
+      N = truncate ? min(N, N0) : N0;
+      M = truncate ? min(M, M0) : M0;
+      C.resize(SphericalEngine::coeff::Csize(N, M));
+      S.resize(SphericalEngine::coeff::Ssize(N, M));
+      int skip = (SphericalEngine::coeff::Csize(N0, M0) -
+                  SphericalEngine::coeff::Csize(N0, M )) * sizeof(double);
+      if (N == N0) {
+        Utility::readarray<double, T, false>(stream, C);
+        if (skip) stream.seekg(streamoff(skip), ios::cur);
+        Utility::readarray<double, T, false>(stream, S);
+        if (skip) stream.seekg(streamoff(skip), ios::cur);
+      } else {
+        for (int m = 0, k = 0; m <= M; ++m) {
+          Utility::readarray<double, T, false>(stream, &C[k], N + 1 - m);
+          stream.seekg((N0 - N) * sizeof(double), ios::cur);
+          k += N + 1 - m;
+        }
+        if (skip) stream.seekg(streamoff(skip), ios::cur);
+        for (int m = 1, k = 0; m <= M; ++m) {
+          Utility::readarray<double, T, false>(stream, &S[k], N + 1 - m);
+          stream.seekg((N0 - N) * sizeof(double), ios::cur);
+          k += N + 1 - m;
+        }
+        if (skip) stream.seekg(streamoff(skip), ios::cur);
+      }
+      return;
+    }
   }
 
   void SphericalEngine::coeff::readcoeffs(istream& stream, int& N, int& M,
                                           vector<real>& C,
                                           vector<real>& S,
                                           bool truncate) {
-    if (truncate) {
-      if (!((N >= M && M >= 0) || (N == -1 && M == -1)))
-        // The last condition is that M = -1 implies N = -1.
-        throw GeographicErr("Bad requested degree and order " +
-                            Utility::str(N) + " " + Utility::str(M));
-    }
-    int nm[2];
-    Utility::readarray<int, int, false>(stream, nm, 2);
-    int N0 = nm[0], M0 = nm[1];
-    if (!((N0 >= M0 && M0 >= 0) || (N0 == -1 && M0 == -1)))
-      // The last condition is that M0 = -1 implies N0 = -1.
+    Tracer::Span span("SphericalEngine::coeff::readcoeffs");
+    ReadCoeffs(stream, N, M, C, S, truncate);
+  }
+
+#if GEOGRAPHICLIB_PRECISION != 1
+  void SphericalEngine::coeff::readcoeffs(istream& stream, int& N, int& M,
+                                          vector<float>& C,
+                                          vector<float>& S,
+                                          bool truncate) {
+    Tracer::Span span("SphericalEngine::coeff::readcoeffs");
+    ReadCoeffs(stream, N, M, C, S, truncate);
+  }
+#endif
+
+  void SphericalEngine::coeff::interleave(const vector<real>& C,
+                                          const vector<real>& S,
+                                          int N, int M, vector<real>& CS) {
+    if (!((N >= M && M >= 0) || (N == -1 && M == -1)))
       throw GeographicErr("Bad degree and order " +
-                          Utility::str(N0) + " " + Utility::str(M0));
-    N = truncate ? min(N, N0) : N0;
-    M = truncate ? min(M, M0) : M0;
-    C.resize(SphericalEngine::coeff::Csize(N, M));
-    S.resize(SphericalEngine::coeff::Ssize(N, M));
-    int skip = (SphericalEngine::coeff::Csize(N0, M0) -
-                SphericalEngine::coeff::Csize(N0, M )) * sizeof(double);
-    if (N == N0) {
-      Utility::readarray<double, real, false>(stream, C);
-      if (skip) stream.seekg(streamoff(skip), ios::cur);
-      Utility::readarray<double, real, false>(stream, S);
-      if (skip) stream.seekg(streamoff(skip), ios::cur);
-    } else {
-      for (int m = 0, k = 0; m <= M; ++m) {
-        Utility::readarray<double, real, false>(stream, &C[k], N + 1 - m);
-        stream.seekg((N0 - N) * sizeof(double), ios::cur);
-        k += N + 1 - m;
-      }
-      if (skip) stream.seekg(streamoff(skip), ios::cur);
-      for (int m = 1, k = 0; m <= M; ++m) {
-        Utility::readarray<double, real, false>(stream, &S[k], N + 1 - m);
-        stream.seekg((N0 - N) * sizeof(double), ios::cur);
-        k += N + 1 - m;
-      }
-      if (skip) stream.seekg(streamoff(skip), ios::cur);
+                          Utility::str(N) + " " + Utility::str(M));
+    int nC = Csize(N, M), nS = Ssize(N, M);
+    if (!(nC <= int(C.size()) && nS <= int(S.size())))
+      throw GeographicErr("Arrays too small in interleave");
+    CS.resize(2 * size_t(nC));
+    // The m = 0 terms have no S coefficient
+    for (int k = 0; k < nC; ++k) {
+      CS[2 * k] = C[k];
+      CS[2 * k + 1] = k < N + 1 ? 0 : S[k - (N + 1)];
     }
-    return;
   }
 
   /// \cond SKIP
@@ -467,6 +1082,57 @@ namespace GeographicLib {
   SphericalEngine::Value<false, SphericalEngine::SCHMIDT, 3>
   (const coeff[], const real[], real, real, real, real, real&, real&, real&);
 
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Values<true, SphericalEngine::FULL, 1>
+  (const coeff[], const real[], size_t, const real[], const real[],
+   const real[], real, real[], real[], real[], real[]);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Values<false, SphericalEngine::FULL, 1>
+  (const coeff[], const real[], size_t, const real[], const real[],
+   const real[], real, real[], real[], real[], real[]);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Values<true, SphericalEngine::SCHMIDT, 1>
+  (const coeff[], const real[], size_t, const real[], const real[],
+   const real[], real, real[], real[], real[], real[]);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Values<false, SphericalEngine::SCHMIDT, 1>
+  (const coeff[], const real[], size_t, const real[], const real[],
+   const real[], real, real[], real[], real[], real[]);
+
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Values<true, SphericalEngine::FULL, 2>
+  (const coeff[], const real[], size_t, const real[], const real[],
+   const real[], real, real[], real[], real[], real[]);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Values<false, SphericalEngine::FULL, 2>
+  (const coeff[], const real[], size_t, const real[], const real[],
+   const real[], real, real[], real[], real[], real[]);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Values<true, SphericalEngine::SCHMIDT, 2>
+  (const coeff[], const real[], size_t, const real[], const real[],
+   const real[], real, real[], real[], real[], real[]);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Values<false, SphericalEngine::SCHMIDT, 2>
+  (const coeff[], const real[], size_t, const real[], const real[],
+   const real[], real, real[], real[], real[], real[]);
+
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Values<true, SphericalEngine::FULL, 3>
+  (const coeff[], const real[], size_t, const real[], const real[],
+   const real[], real, real[], real[], real[], real[]);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Values<false, SphericalEngine::FULL, 3>
+  (const coeff[], const real[], size_t, const real[], const real[],
+   const real[], real, real[], real[], real[], real[]);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Values<true, SphericalEngine::SCHMIDT, 3>
+  (const coeff[], const real[], size_t, const real[], const real[],
+   const real[], real, real[], real[], real[], real[]);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Values<false, SphericalEngine::SCHMIDT, 3>
+  (const coeff[], const real[], size_t, const real[], const real[],
+   const real[], real, real[], real[], real[], real[]);
+
   template CircularEngine GEOGRAPHICLIB_EXPORT
   SphericalEngine::Circle<true, SphericalEngine::FULL, 1>
   (const coeff[], const real[], real, real, real);
@@ -505,6 +1171,75 @@ namespace GeographicLib {
   template CircularEngine GEOGRAPHICLIB_EXPORT
   SphericalEngine::Circle<false, SphericalEngine::SCHMIDT, 3>
   (const coeff[], const real[], real, real, real);
+
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Circles<true, SphericalEngine::FULL, 1>
+  (const coeff[], const real[], size_t, const real[], const real[], real,
+   CircularEngine[]);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Circles<false, SphericalEngine::FULL, 1>
+  (const coeff[], const real[], size_t, const real[], const real[], real,
+   CircularEngine[]);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Circles<true, SphericalEngine::SCHMIDT, 1>
+  (const coeff[], const real[], size_t, const real[], const real[], real,
+   CircularEngine[]);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Circles<false, SphericalEngine::SCHMIDT, 1>
+  (const coeff[], const real[], size_t, const real[], const real[], real,
+   CircularEngine[]);
+
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Circles<true, SphericalEngine::FULL, 2>
+  (const coeff[], const real[], size_t, const real[], const real[], real,
+   CircularEngine[]);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Circles<false, SphericalEngine::FULL, 2>
+  (const coeff[], const real[], size_t, const real[], const real[], real,
+   CircularEngine[]);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Circles<true, SphericalEngine::SCHMIDT, 2>
+  (const coeff[], const real[], size_t, const real[], const real[], real,
+   CircularEngine[]);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Circles<false, SphericalEngine::SCHMIDT, 2>
+  (const coeff[], const real[], size_t, const real[], const real[], real,
+   CircularEngine[]);
+
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Circles<true, SphericalEngine::FULL, 3>
+  (const coeff[], const real[], size_t, const real[], const real[], real,
+   CircularEngine[]);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Circles<false, SphericalEngine::FULL, 3>
+  (const coeff[], const real[], size_t, const real[], const real[], real,
+   CircularEngine[]);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Circles<true, SphericalEngine::SCHMIDT, 3>
+  (const coeff[], const real[], size_t, const real[], const real[], real,
+   CircularEngine[]);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Circles<false, SphericalEngine::SCHMIDT, 3>
+  (const coeff[], const real[], size_t, const real[], const real[], real,
+   CircularEngine[]);
+
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Sums<true, SphericalEngine::FULL>
+  (int, const coeff[], real, real, real, real, real[], real[], real[],
+   real[]);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Sums<false, SphericalEngine::FULL>
+  (int, const coeff[], real, real, real, real, real[], real[], real[],
+   real[]);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Sums<true, SphericalEngine::SCHMIDT>
+  (int, const coeff[], real, real, real, real, real[], real[], real[],
+   real[]);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Sums<false, SphericalEngine::SCHMIDT>
+  (int, const coeff[], real, real, real, real, real[], real[], real[],
+   real[]);
+
   /// \endcond
 
 } // namespace GeographicLib
@@ -0,0 +1,30 @@
+/**
+ * \file Tracer.cpp
+ * \brief Implementation for GeographicLib::Tracer class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/Tracer.hpp>
+#include <atomic>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  namespace {
+
+    atomic<Tracer*>& current() {
+      static atomic<Tracer*> tracer(nullptr);
+      return tracer;
+    }
+
+  } // namespace
+
+  Tracer* Tracer::Current() { return current(); }
+
+  void Tracer::Set(Tracer* tracer) { current() = tracer; }
+
+} // namespace GeographicLib
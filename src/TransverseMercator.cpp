@@ -35,7 +35,9 @@
  **********************************************************************/
 
 #include <complex>
+#include <atomic>
 #include <GeographicLib/TransverseMercator.hpp>
+#include <GeographicLib/Executor.hpp>
 
 #if defined(_MSC_VER)
 // Squelch warnings about enum-float expressions
@@ -46,6 +48,18 @@ namespace GeographicLib {
 
   using namespace std;
 
+  namespace {
+    // The product of two complex numbers.  Without -ffast-math, compilers
+    // implement complex multiplication with a library call (e.g., __muldc3)
+    // to handle infinities and NaNs, which is not needed for the bounded
+    // quantities in Series.  For finite arguments the result is the same.
+    template<typename T>
+    inline complex<T> mul(const complex<T>& a, const complex<T>& b) {
+      return complex<T>(a.real() * b.real() - a.imag() * b.imag(),
+                        a.real() * b.imag() + a.imag() * b.real());
+    }
+  }
+
   TransverseMercator::TransverseMercator(real a, real f, real k0,
                                          bool exact, bool extendp)
     : _a(a)
@@ -291,6 +305,14 @@ namespace GeographicLib {
     return utm;
   }
 
+#if GEOGRAPHICLIB_EAGER_SINGLETONS && GEOGRAPHICLIB_PRECISION != 5
+  namespace {
+    // Construct TransverseMercator::UTM() when the library is loaded (see
+    // Geodesic.cpp).
+    const TransverseMercator& utminit_ = TransverseMercator::UTM();
+  }
+#endif
+
   // Engsager and Poder (2007) use trigonometric series to convert between phi
   // and phip.  Here are the series...
   //
@@ -360,6 +382,61 @@ namespace GeographicLib {
   void TransverseMercator::Forward(real lon0, real lat, real lon,
                                    real& x, real& y,
                                    real& gamma, real& k) const {
+    GenForward(lon0, lat, lon, true, x, y, gamma, k);
+  }
+
+  void TransverseMercator::Reverse(real lon0, real x, real y,
+                                   real& lat, real& lon,
+                                   real& gamma, real& k) const {
+    GenReverse(lon0, x, y, true, lat, lon, gamma, k);
+  }
+
+  void TransverseMercator::Series(const real c[], real sgn, bool gk,
+                                  real& xi, real& eta,
+                                  real& gam, real& kap) {
+    // Replace zeta = xi + i*eta by zeta + sum(sgn * c[j] * sin(2*j*zeta), j
+    // = 1..maxpow_) using Clenshaw summation as described in GenForward.  If
+    // gk, also set gam and kap to the argument (in degrees) and the magnitude
+    // of the derivative of the map.
+    real
+      c0 = cos(2 * xi), ch0 = cosh(2 * eta),
+      s0 = sin(2 * xi), sh0 = sinh(2 * eta);
+    complex<real> a(2 * c0 * ch0, -2 * s0 * sh0); // 2 * cos(2*zeta)
+    int n = maxpow_;
+    complex<real>
+      y0(n & 1 ?       sgn * c[n] : 0), y1, // default initializer is 0+i0
+      z0(n & 1 ? 2*n * sgn * c[n] : 0), z1;
+    if (n & 1) --n;
+    if (gk) {
+      while (n) {
+        y1 = mul(a, y0) - y1 +       sgn * c[n];
+        z1 = mul(a, z0) - z1 + 2*n * sgn * c[n];
+        --n;
+        y0 = mul(a, y1) - y0 +       sgn * c[n];
+        z0 = mul(a, z1) - z0 + 2*n * sgn * c[n];
+        --n;
+      }
+      a /= real(2);             // cos(2*zeta)
+      z1 = real(1) - z1 + mul(a, z0);
+      gam = Math::atan2d(z1.imag(), z1.real());
+      kap = abs(z1);
+    } else {
+      // Skip the series for the derivative
+      while (n) {
+        y1 = mul(a, y0) - y1 +       sgn * c[n];
+        --n;
+        y0 = mul(a, y1) - y0 +       sgn * c[n];
+        --n;
+      }
+    }
+    a = complex<real>(s0 * ch0, c0 * sh0); // sin(2*zeta)
+    y1 = complex<real>(xi, eta) + mul(a, y0);
+    xi = y1.real(); eta = y1.imag();
+  }
+
+  void TransverseMercator::GenForward(real lon0, real lat, real lon, bool gk,
+                                      real& x, real& y,
+                                      real& gamma, real& k) const {
     if (_exact)
       return _tmexact.Forward(lon0, lat, lon, x, y, gamma, k);
     lat = Math::LatFix(lat);
@@ -409,7 +486,7 @@ namespace GeographicLib {
       // atan(tan(xip) * tanh(etap)) = atan(tan(lam) * sin(phi'));
       // sin(phi') = tau'/sqrt(1 + tau'^2)
       // Krueger p 22 (44)
-      gamma = Math::atan2d(slam * taup, clam * hypot(real(1), taup));
+      //
       // k0 = sqrt(1 - _e2 * sin(phi)^2) * (cos(phi') / cos(phi)) * cosh(etap)
       // Note 1/cos(phi) = cosh(psip);
       // and cos(phi') * cosh(etap) = 1/hypot(sinh(psi), cos(lam))
@@ -417,8 +494,11 @@ namespace GeographicLib {
       // This form has cancelling errors.  This property is lost if cosh(psip)
       // is replaced by 1/cos(phi), even though it's using "primary" data (phi
       // instead of psip).
-      k = sqrt(_e2m + _e2 * Math::sq(cphi)) * hypot(real(1), tau)
-        / hypot(taup, clam);
+      if (gk) {
+        gamma = Math::atan2d(slam * taup, clam * hypot(real(1), taup));
+        k = sqrt(_e2m + _e2 * Math::sq(cphi)) * hypot(real(1), tau)
+          / hypot(taup, clam);
+      }
     } else {
       xip = Math::pi()/2;
       etap = 0;
@@ -490,34 +570,15 @@ namespace GeographicLib {
     //    S = (a[0] + beta[1](x) * b[2]) * phi[0](x) + b[1] * phi[1](x)
     //    phi[0](x) = [0; 0]
     //    phi[1](x) = [sin(x); cos(x)]
-    real
-      c0 = cos(2 * xip), ch0 = cosh(2 * etap),
-      s0 = sin(2 * xip), sh0 = sinh(2 * etap);
-    complex<real> a(2 * c0 * ch0, -2 * s0 * sh0); // 2 * cos(2*zeta')
-    int n = maxpow_;
-    complex<real>
-      y0(n & 1 ?       _alp[n] : 0), y1, // default initializer is 0+i0
-      z0(n & 1 ? 2*n * _alp[n] : 0), z1;
-    if (n & 1) --n;
-    while (n) {
-      y1 = a * y0 - y1 +       _alp[n];
-      z1 = a * z0 - z1 + 2*n * _alp[n];
-      --n;
-      y0 = a * y1 - y0 +       _alp[n];
-      z0 = a * z1 - z0 + 2*n * _alp[n];
-      --n;
-    }
-    a /= real(2);               // cos(2*zeta')
-    z1 = real(1) - z1 + a * z0;
-    a = complex<real>(s0 * ch0, c0 * sh0); // sin(2*zeta')
-    y1 = complex<real>(xip, etap) + a * y0;
-    // Fold in change in convergence and scale for Gauss-Schreiber TM to
-    // Gauss-Krueger TM.
-    gamma -= Math::atan2d(z1.imag(), z1.real());
-    k *= _b1 * abs(z1);
-    real xi = y1.real(), eta = y1.imag();
+    real xi = xip, eta = etap, gam, kap;
+    Series(_alp, 1, gk, xi, eta, gam, kap);
     y = _a1 * _k0 * (backside ? Math::pi() - xi : xi) * latsign;
     x = _a1 * _k0 * eta * lonsign;
+    if (!gk) return;
+    // Fold in change in convergence and scale for Gauss-Schreiber TM to
+    // Gauss-Krueger TM.
+    gamma -= gam;
+    k *= _b1 * kap;
     if (backside)
       gamma = Math::hd - gamma;
     gamma *= latsign * lonsign;
@@ -525,9 +586,9 @@ namespace GeographicLib {
     k *= _k0;
   }
 
-  void TransverseMercator::Reverse(real lon0, real x, real y,
-                                   real& lat, real& lon,
-                                   real& gamma, real& k) const {
+  void TransverseMercator::GenReverse(real lon0, real x, real y, bool gk,
+                                      real& lat, real& lon,
+                                      real& gamma, real& k) const {
     if (_exact)
       return _tmexact.Reverse(lon0, x, y, lat, lon, gamma, k);
     // This undoes the steps in Forward.  The wrinkles are: (1) Use of the
@@ -545,37 +606,16 @@ namespace GeographicLib {
     bool backside = xi > Math::pi()/2;
     if (backside)
       xi = Math::pi() - xi;
-    real
-      c0 = cos(2 * xi), ch0 = cosh(2 * eta),
-      s0 = sin(2 * xi), sh0 = sinh(2 * eta);
-    complex<real> a(2 * c0 * ch0, -2 * s0 * sh0); // 2 * cos(2*zeta)
-    int n = maxpow_;
-    complex<real>
-      y0(n & 1 ?       -_bet[n] : 0), y1, // default initializer is 0+i0
-      z0(n & 1 ? -2*n * _bet[n] : 0), z1;
-    if (n & 1) --n;
-    while (n) {
-      y1 = a * y0 - y1 -       _bet[n];
-      z1 = a * z0 - z1 - 2*n * _bet[n];
-      --n;
-      y0 = a * y1 - y0 -       _bet[n];
-      z0 = a * z1 - z0 - 2*n * _bet[n];
-      --n;
-    }
-    a /= real(2);               // cos(2*zeta)
-    z1 = real(1) - z1 + a * z0;
-    a = complex<real>(s0 * ch0, c0 * sh0); // sin(2*zeta)
-    y1 = complex<real>(xi, eta) + a * y0;
+    real xip = xi, etap = eta, kap;
+    Series(_bet, -1, gk, xip, etap, gamma, kap);
     // Convergence and scale for Gauss-Schreiber TM to Gauss-Krueger TM.
-    gamma = Math::atan2d(z1.imag(), z1.real());
-    k = _b1 / abs(z1);
+    if (gk) k = _b1 / kap;
     // JHS 154 has
     //
     //   phi' = asin(sin(xi') / cosh(eta')) (Krueger p 17 (25))
     //   lam = asin(tanh(eta') / cos(phi')
     //   psi = asinh(tan(phi'))
     real
-      xip = y1.real(), etap = y1.imag(),
       s = sinh(etap),
       c = fmax(real(0), cos(xip)), // cos(pi/2) might be negative
       r = hypot(s, c);
@@ -585,21 +625,24 @@ namespace GeographicLib {
       real
         sxip = sin(xip),
         tau = Math::tauf(sxip/r, _es);
-      gamma += Math::atan2d(sxip * tanh(etap), c); // Krueger p 19 (31)
       lat = Math::atand(tau);
-      // Note cos(phi') * cosh(eta') = r
-      k *= sqrt(_e2m + _e2 / (1 + Math::sq(tau))) *
-        hypot(real(1), tau) * r;
+      if (gk) {
+        gamma += Math::atan2d(sxip * tanh(etap), c); // Krueger p 19 (31)
+        // Note cos(phi') * cosh(eta') = r
+        k *= sqrt(_e2m + _e2 / (1 + Math::sq(tau))) *
+          hypot(real(1), tau) * r;
+      }
     } else {
       lat = Math::qd;
       lon = 0;
-      k *= _c;
+      if (gk) k *= _c;
     }
     lat *= xisign;
     if (backside)
       lon = Math::hd - lon;
     lon *= etasign;
     lon = Math::AngNormalize(lon + lon0);
+    if (!gk) return;
     if (backside)
       gamma = Math::hd - gamma;
     gamma *= xisign * etasign;
@@ -607,4 +650,122 @@ namespace GeographicLib {
     k *= _k0;
   }
 
+  Math::real TransverseMercator::Transfer(real lon0in, real xin, real yin,
+                                          real lon0out,
+                                          real& xout, real& yout) const {
+    if (_exact) {
+      real lat, lon;
+      _tmexact.Reverse(lon0in, xin, yin, lat, lon);
+      _tmexact.Forward(lon0out, lat, lon, xout, yout);
+      return Math::AngDiff(lon0out, lon);
+    }
+    // This is GenReverse followed by GenForward except that the conformal
+    // latitude, tau' = tan(phi'), is passed from one to the other.  This
+    // skips the Newton's method in Math::tauf, the conversion back with
+    // Math::taupf, and the trigonometric functions of the latitude.
+    real
+      xi = yin / (_a1 * _k0),
+      eta = xin / (_a1 * _k0);
+    int
+      xisign = signbit(xi) ? -1 : 1,
+      etasign = signbit(eta) ? -1 : 1;
+    xi *= xisign;
+    eta *= etasign;
+    bool backside = xi > Math::pi()/2;
+    if (backside)
+      xi = Math::pi() - xi;
+    real xip = xi, etap = eta, gam, kap;
+    Series(_bet, -1, false, xip, etap, gam, kap);
+    real
+      s = sinh(etap),
+      c = fmax(real(0), cos(xip)), // cos(pi/2) might be negative
+      r = hypot(s, c),
+      // The conformal latitude is not changed by the transfer
+      taup = r != 0 ? sin(xip) / r : Math::infinity(),
+      lon = r != 0 ? Math::atan2d(s, c) : 0;
+    taup *= xisign;
+    if (backside)
+      lon = Math::hd - lon;
+    lon *= etasign;
+    lon = Math::AngNormalize(lon + lon0in);
+    // Now the first part of GenForward
+    lon = Math::AngDiff(lon0out, lon);
+    const real dlon = lon;
+    int
+      latsign = signbit(taup) ? -1 : 1,
+      lonsign = signbit(lon) ? -1 : 1;
+    lon *= lonsign;
+    taup *= latsign;
+    backside = lon > Math::qd;
+    if (backside) {
+      if (taup == 0)
+        latsign = -1;
+      lon = Math::hd - lon;
+    }
+    real slam, clam;
+    Math::sincosd(lon, slam, clam);
+    if (isfinite(taup)) {
+      xip = atan2(taup, clam);
+      etap = asinh(slam / hypot(taup, clam));
+    } else {
+      xip = Math::pi()/2;
+      etap = 0;
+    }
+    xi = xip; eta = etap;
+    Series(_alp, 1, false, xi, eta, gam, kap);
+    yout = _a1 * _k0 * (backside ? Math::pi() - xi : xi) * latsign;
+    xout = _a1 * _k0 * eta * lonsign;
+    return dlon;
+  }
+
+  template<class F>
+  void TransverseMercator::Blocks(size_t n, int nthreads, F work) {
+    // The blocks are claimed with an atomic counter.  They are large enough
+    // that the cost of the counter is negligible.
+    const size_t block = 1024, nblocks = (n + block - 1) / block;
+    nthreads = int(min(size_t(max(1, nthreads)), nblocks));
+    if (nthreads <= 1) {
+      work(0, n);
+      return;
+    }
+    atomic<size_t> next(0);
+    auto task = [&](int) -> void {
+      for (size_t b; (b = next++) < nblocks;)
+        work(b * block, min(n, (b + 1) * block));
+    };
+    Executor::RunGuarded(nthreads, task, [&]() -> void { next = nblocks; });
+  }
+
+  void TransverseMercator::Forward(real lon0, size_t n,
+                                   const real lat[], const real lon[],
+                                   real x[], real y[],
+                                   real gamma[], real k[],
+                                   int nthreads) const {
+    const bool gk = gamma || k;
+    Blocks(n, nthreads, [&](size_t b, size_t e) -> void {
+        real g, kk;
+        for (size_t i = b; i < e; ++i) {
+          GenForward(lon0, lat[i], lon[i], gk, x[i], y[i], g, kk);
+          if (gamma) gamma[i] = g;
+          if (k) k[i] = kk;
+        }
+      });
+  }
+
+  void TransverseMercator::Reverse(real lon0, size_t n,
+                                   const real x[], const real y[],
+                                   real lat[], real lon[],
+                                   real gamma[], real k[],
+                                   int nthreads) const {
+    const bool gk = gamma || k;
+    Blocks(n, nthreads, [&](size_t b, size_t e) -> void {
+        real g, kk;
+        for (size_t i = b; i < e; ++i) {
+          GenReverse(lon0, x[i], y[i], gk, lat[i], lon[i], g, kk);
+          if (gamma) gamma[i] = g;
+          if (k) k[i] = kk;
+        }
+      });
+  }
+
 } // namespace GeographicLib
@@ -41,7 +41,9 @@
  * are noted in the code.
  **********************************************************************/
 
+#include <atomic>
 #include <GeographicLib/TransverseMercatorExact.hpp>
+#include <GeographicLib/Executor.hpp>
 
 #if defined(_MSC_VER)
 // Squelch warnings about constant conditional and enum-float expressions
@@ -84,6 +86,15 @@ namespace GeographicLib {
     return utm;
   }
 
+#if GEOGRAPHICLIB_EAGER_SINGLETONS && GEOGRAPHICLIB_PRECISION != 5
+  namespace {
+    // Construct TransverseMercatorExact::UTM() when the library is loaded (see
+    // Geodesic.cpp).
+    const TransverseMercatorExact& utminit_ =
+      TransverseMercatorExact::UTM();
+  }
+#endif
+
   void TransverseMercatorExact::zeta(real /*u*/, real snu, real cnu, real dnu,
                                      real /*v*/, real snv, real cnv, real dnv,
                                      real& taup, real& lam) const {
@@ -186,16 +197,19 @@ namespace GeographicLib {
   }
 
   // Invert zeta using Newton's method
-  void TransverseMercatorExact::zetainv(real taup, real lam,
-                                        real& u, real& v) const  {
+  int TransverseMercatorExact::zetainv(real taup, real lam,
+                                       real& u, real& v, bool seeded) const {
     real
       psi = asinh(taup),
       scal = 1/hypot(real(1), taup);
-    if (zetainv0(psi, lam, u, v))
-      return;
+    if (!seeded && zetainv0(psi, lam, u, v))
+      return 0;
     real stol2 = tol2_ / Math::sq(fmax(psi, real(1)));
     // min iterations = 2, max iterations = 6; mean = 4.0
+    int nit = 0;
+    bool conv = false;
     for (int i = 0, trip = 0; i < numit_ || GEOGRAPHICLIB_PANIC; ++i) {
+      ++nit;
       real snu, cnu, dnu, snv, cnv, dnv;
       _eEu.sncndn(u, snu, cnu, dnu);
       _eEv.sncndn(v, snv, cnv, dnv);
@@ -210,12 +224,17 @@ namespace GeographicLib {
         delv = tau1 * dv1 + lam1 * du1;
       u -= delu;
       v -= delv;
-      if (trip)
+      if (trip) {
+        conv = true;
         break;
+      }
       real delw2 = Math::sq(delu) + Math::sq(delv);
       if (!(delw2 >= stol2))
         ++trip;
     }
+    // If the seeded iteration failed to converge, start again with the
+    // standard starting guess.
+    return seeded && !conv ? nit + zetainv(taup, lam, u, v) : nit;
   }
 
   void TransverseMercatorExact::sigma(real /*u*/, real snu, real cnu, real dnu,
@@ -294,12 +313,15 @@ namespace GeographicLib {
   }
 
   // Invert sigma using Newton's method
-  void TransverseMercatorExact::sigmainv(real xi, real eta,
-                                         real& u, real& v) const {
-    if (sigmainv0(xi, eta, u, v))
-      return;
+  int TransverseMercatorExact::sigmainv(real xi, real eta,
+                                        real& u, real& v, bool seeded) const {
+    if (!seeded && sigmainv0(xi, eta, u, v))
+      return 0;
     // min iterations = 2, max iterations = 7; mean = 3.9
+    int nit = 0;
+    bool conv = false;
     for (int i = 0, trip = 0; i < numit_ || GEOGRAPHICLIB_PANIC; ++i) {
+      ++nit;
       real snu, cnu, dnu, snv, cnv, dnv;
       _eEu.sncndn(u, snu, cnu, dnu);
       _eEv.sncndn(v, snv, cnv, dnv);
@@ -313,12 +335,17 @@ namespace GeographicLib {
         delv = xi1 * dv1 + eta1 * du1;
       u -= delu;
       v -= delv;
-      if (trip)
+      if (trip) {
+        conv = true;
         break;
+      }
       real delw2 = Math::sq(delu) + Math::sq(delv);
       if (!(delw2 >= tol2_))
         ++trip;
     }
+    // If the seeded iteration failed to converge, start again with the
+    // standard starting guess.
+    return seeded && !conv ? nit + sigmainv(xi, eta, u, v) : nit;
   }
 
   void TransverseMercatorExact::Scale(real tau, real /*lam*/,
@@ -347,9 +374,37 @@ namespace GeographicLib {
             (_mu * Math::sq(cnu) + _mv * Math::sq(cnv)) );
   }
 
+  bool TransverseMercatorExact::Seed(int dir, real s1, real s2,
+                                     const Hint& hint,
+                                     real& u, real& v) const {
+    // Extrapolate from the solution in hint to give the starting guess for
+    // Newton's method.  (s1, s2) = (psi, lam) for Forward and (xi, eta) for
+    // Reverse.
+    if (hint._dir != dir) return false;
+    real ds1 = s1 - hint._s1, ds2 = s2 - hint._s2;
+    // Only use the hint if the points are within about 60 km of each other.
+    static const real maxsep = real(0.01);
+    if (!(fabs(ds1) <= maxsep && fabs(ds2) <= maxsep)) return false;
+    real
+      du = ds1 * hint._du - ds2 * hint._dv,
+      dv = ds1 * hint._dv + ds2 * hint._du;
+    if (!(fabs(du) <= 10 * maxsep && fabs(dv) <= 10 * maxsep)) return false;
+    u = hint._u + du;
+    v = hint._v + dv;
+    return true;
+  }
+
   void TransverseMercatorExact::Forward(real lon0, real lat, real lon,
                                         real& x, real& y,
                                         real& gamma, real& k) const {
+    Hint hint;
+    Forward(lon0, lat, lon, x, y, gamma, k, hint);
+  }
+
+  void TransverseMercatorExact::Forward(real lon0, real lat, real lon,
+                                        real& x, real& y,
+                                        real& gamma, real& k,
+                                        Hint& hint) const {
     lat = Math::LatFix(lat);
     lon = Math::AngDiff(lon0, lon);
     // Explicitly enforce the parity
@@ -370,19 +425,31 @@ namespace GeographicLib {
 
     // u,v = coordinates for the Thompson TM, Lee 54
     real u, v;
+    bool special = true;
     if (lat == Math::qd) {
       u = _eEu.K();
       v = 0;
     } else if (lat == 0 && lon == Math::qd * (1 - _e)) {
       u = 0;
       v = _eEv.K();
-    } else
+    } else {
       // tau = tan(phi), taup = sinh(psi)
-      zetainv(Math::taupf(tau, _e), lam, u, v);
+      real taup = Math::taupf(tau, _e), psi = asinh(taup);
+      bool seeded = Seed(1, psi, lam, hint, u, v);
+      hint._iter = zetainv(taup, lam, u, v, seeded);
+      hint._s1 = psi; hint._s2 = lam;
+      special = false;
+    }
 
     real snu, cnu, dnu, snv, cnv, dnv;
     _eEu.sncndn(u, snu, cnu, dnu);
     _eEv.sncndn(v, snv, cnv, dnv);
+    if (special) {
+      hint._dir = hint._iter = 0;
+    } else {
+      hint._dir = 1; hint._u = u; hint._v = v;
+      dwdzeta(u, snu, cnu, dnu, v, snv, cnv, dnv, hint._du, hint._dv);
+    }
 
     real xi, eta;
     sigma(u, snu, cnu, dnu, v, snv, cnv, dnv, xi, eta);
@@ -410,6 +477,14 @@ namespace GeographicLib {
   void TransverseMercatorExact::Reverse(real lon0, real x, real y,
                                         real& lat, real& lon,
                                         real& gamma, real& k) const {
+    Hint hint;
+    Reverse(lon0, x, y, lat, lon, gamma, k, hint);
+  }
+
+  void TransverseMercatorExact::Reverse(real lon0, real x, real y,
+                                        real& lat, real& lon,
+                                        real& gamma, real& k,
+                                        Hint& hint) const {
     // This undoes the steps in Forward.
     real
       xi = y / (_a * _k0),
@@ -426,15 +501,25 @@ namespace GeographicLib {
 
     // u,v = coordinates for the Thompson TM, Lee 54
     real u, v;
-    if (xi == 0 && eta == _eEv.KE()) {
+    bool special = xi == 0 && eta == _eEv.KE();
+    if (special) {
       u = 0;
       v = _eEv.K();
-    } else
-      sigmainv(xi, eta, u, v);
+    } else {
+      bool seeded = Seed(-1, xi, eta, hint, u, v);
+      hint._iter = sigmainv(xi, eta, u, v, seeded);
+      hint._s1 = xi; hint._s2 = eta;
+    }
 
     real snu, cnu, dnu, snv, cnv, dnv;
     _eEu.sncndn(u, snu, cnu, dnu);
     _eEv.sncndn(v, snv, cnv, dnv);
+    if (special) {
+      hint._dir = hint._iter = 0;
+    } else {
+      hint._dir = -1; hint._u = u; hint._v = v;
+      dwdsigma(u, snu, cnu, dnu, v, snv, cnv, dnv, hint._du, hint._dv);
+    }
     real phi, lam, tau;
     if (v != 0 || u != _eEu.K()) {
       zeta(u, snu, cnu, dnu, v, snv, cnv, dnv, tau, lam);
@@ -461,4 +546,55 @@ namespace GeographicLib {
     k *= _k0;
   }
 
+  template<class F>
+  void TransverseMercatorExact::Blocks(size_t n, int nthreads, F work) {
+    // The blocks are fixed (so that the chains of hints don't depend on
+    // nthreads) and are claimed with an atomic counter.
+    const size_t block = 1024, nblocks = (n + block - 1) / block;
+    nthreads = int(min(size_t(max(1, nthreads)), nblocks));
+    if (nthreads <= 1) {
+      for (size_t b = 0; b < nblocks; ++b)
+        work(b * block, min(n, (b + 1) * block));
+      return;
+    }
+    atomic<size_t> next(0);
+    auto task = [&](int) -> void {
+      for (size_t b; (b = next++) < nblocks;)
+        work(b * block, min(n, (b + 1) * block));
+    };
+    Executor::RunGuarded(nthreads, task, [&]() -> void { next = nblocks; });
+  }
+
+  void TransverseMercatorExact::Forward(real lon0, size_t n,
+                                        const real lat[], const real lon[],
+                                        real x[], real y[],
+                                        real gamma[], real k[],
+                                        int nthreads) const {
+    Blocks(n, nthreads, [&](size_t b, size_t e) -> void {
+        Hint hint;
+        real g, kk;
+        for (size_t i = b; i < e; ++i) {
+          Forward(lon0, lat[i], lon[i], x[i], y[i], g, kk, hint);
+          if (gamma) gamma[i] = g;
+          if (k) k[i] = kk;
+        }
+      });
+  }
+
+  void TransverseMercatorExact::Reverse(real lon0, size_t n,
+                                        const real x[], const real y[],
+                                        real lat[], real lon[],
+                                        real gamma[], real k[],
+                                        int nthreads) const {
+    Blocks(n, nthreads, [&](size_t b, size_t e) -> void {
+        Hint hint;
+        real g, kk;
+        for (size_t i = b; i < e; ++i) {
+          Reverse(lon0, x[i], y[i], lat[i], lon[i], g, kk, hint);
+          if (gamma) gamma[i] = g;
+          if (k) k[i] = kk;
+        }
+      });
+  }
+
 } // namespace GeographicLib
@@ -0,0 +1,434 @@
+/**
+ * \file TriaxialGeodesic.cpp
+ * \brief Implementation for GeographicLib::TriaxialGeodesic class
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/TriaxialGeodesic.hpp>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include <GeographicLib/Executor.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  namespace {
+    // Call work(b) for the blocks b in [0, nblocks) on nthreads threads.
+    // The blocks are claimed with an atomic counter.
+    template<class F> void Blocks(size_t nblocks, int nthreads, F work) {
+      nthreads = int(min(size_t(max(1, nthreads)), nblocks));
+      if (nthreads <= 1) {
+        for (size_t b = 0; b < nblocks; ++b) work(b);
+        return;
+      }
+      atomic<size_t> next(0);
+      Executor::RunGuarded(nthreads, [&](int) -> void {
+        for (size_t b; (b = next++) < nblocks;)
+          work(b);
+      }, [&]() -> void { next = nblocks; });
+    }
+
+    typedef Math::real real;
+    real dot(const real u[], const real v[])
+    { return u[0] * v[0] + u[1] * v[1] + u[2] * v[2]; }
+    void normvec(real u[]) {
+      real h = sqrt(dot(u, u));
+      u[0] /= h; u[1] /= h; u[2] /= h;
+    }
+    real* offset(real* p, size_t k) { return p ? p + k : p; }
+  }
+
+  TriaxialGeodesic::TriaxialGeodesic(real a, real b, real c)
+    : _a(a), _b(b), _c(c)
+    , _ab2((_a - _b) * (_a + _b))
+    , _bc2((_b - _c) * (_b + _c))
+    , _ac2(_ab2 + _bc2)
+    , _ia2(1 / Math::sq(_a))
+    , _ib2(1 / Math::sq(_b))
+    , _ic2(1 / Math::sq(_c))
+    , _kK0(_ia2 * _ib2 * _ic2)
+      // Steps of half the smallest radius of curvature with 7 levels of
+      // extrapolation (order 14) give errors of about 1e-14 in double
+      // precision; add levels for the higher precisions.
+    , _hmax(Math::sq(_c) / _a / 2)
+    , _nlev(min(16, max(4, 7 + (Math::digits() - 53) / 12)))
+  {
+    if (!(isfinite(_a) && _a >= _b && _b >= _c && _c > 0))
+      throw GeographicErr("TriaxialGeodesic: axes are not in order");
+    if (!(_a > _c))
+      throw GeographicErr("TriaxialGeodesic: the ellipsoid is a sphere");
+  }
+
+  void TriaxialGeodesic::Cart(real sbet, real cbet, real somg, real comg,
+                              real r[]) const {
+    real e = sqrt(_ac2);
+    r[0] = _a * comg * sqrt(_ab2 + _bc2 * Math::sq(cbet)) / e;
+    r[1] = _b * cbet * somg;
+    r[2] = _c * sbet * sqrt(_bc2 + _ab2 * Math::sq(somg)) / e;
+  }
+
+  void TriaxialGeodesic::Frame(real sbet, real cbet, real somg, real comg,
+                               real N[], real E[]) const {
+    real e = sqrt(_ac2),
+      px = sqrt(_ab2 + _bc2 * Math::sq(cbet)),
+      pz = sqrt(_bc2 + _ab2 * Math::sq(somg)),
+      // bc2 * cbet / px and ab2 * somg / pz with their limits when px = 0
+      // (a = b and cbet = 0) or pz = 0 (b = c and somg = 0)
+      tx = px > 0 ? _bc2 * cbet / px : sqrt(_bc2),
+      tz = pz > 0 ? _ab2 * somg / pz : sqrt(_ab2);
+    N[0] = -_a * comg * sbet * tx / e;
+    N[1] = -_b * sbet * somg;
+    N[2] =  _c * cbet * pz / e;
+    E[0] = -_a * somg * px / e;
+    E[1] =  _b * cbet * comg;
+    E[2] =  _c * sbet * comg * tz / e;
+    normvec(N); normvec(E);
+  }
+
+  void TriaxialGeodesic::Ellipsoidal(const real r[], real& sbet, real& cbet,
+                                     real& somg, real& comg) const {
+    real X = r[0], Y = r[1], Z = r[2];
+    if (_ab2 == 0) {
+      // Oblate: beta is the parametric latitude
+      sbet = Z / _c; cbet = hypot(X / _a, Y / _b);
+      somg = Y / _b; comg = X / _a;
+    } else if (_bc2 == 0) {
+      // Prolate: X is the axis of symmetry
+      sbet = Z / _c; cbet = fabs(Y / _b);
+      somg = copysign(hypot(Y / _b, Z / _c), Y); comg = X / _a;
+    } else {
+      // The confocal quadrics through the point are given by the roots t =
+      // b^2 + q of X^2/(a^2-t) + Y^2/(b^2-t) + Z^2/(c^2-t) = 1 other than t
+      // = 0, namely the roots of q^2 + B*q + C = 0 with q1 in [-(b^2-c^2),
+      // 0] and q2 in [0, a^2-b^2].  Then cbet^2 = -q1/(b^2-c^2) and somg^2 =
+      // q2/(a^2-b^2).  The roots are found avoiding cancellation.
+      real
+        B = Math::sq(X) + Math::sq(Y) + Math::sq(Z) - _ab2 - Math::sq(_c),
+        C = -Math::sq(Y) * _ab2 * _bc2 * _ib2,
+        d = sqrt(Math::sq(B) - 4 * C), q1, q2;
+      if (B >= 0) {
+        q1 = -(B + d) / 2; q2 = q1 != 0 ? C / q1 : 0;
+      } else {
+        q2 = (d - B) / 2; q1 = C / q2;
+      }
+      real e = sqrt(_ac2);
+      cbet = sqrt(fmax(real(0), fmin(real(1), -q1 / _bc2)));
+      somg = copysign(sqrt(fmax(real(0), fmin(real(1), q2 / _ab2))), Y);
+      // The other components follow more accurately from X and Z.
+      sbet = Z * e / (_c * sqrt(_bc2 + _ab2 * Math::sq(somg)));
+      comg = X * e / (_a * sqrt(_ab2 + _bc2 * Math::sq(cbet)));
+    }
+    Math::norm(sbet, cbet); Math::norm(somg, comg);
+  }
+
+  void TriaxialGeodesic::ToCartesian(real bet, real omg,
+                                     real& X, real& Y, real& Z) const {
+    real sbet, cbet, somg, comg, r[3];
+    Math::sincosd(bet, sbet, cbet); Math::sincosd(omg, somg, comg);
+    Cart(sbet, cbet, somg, comg, r);
+    X = r[0]; Y = r[1]; Z = r[2];
+  }
+
+  void TriaxialGeodesic::FromCartesian(real X, real Y, real Z,
+                                       real& bet, real& omg) const {
+    real sbet, cbet, somg, comg, r[3] = {X, Y, Z};
+    Ellipsoidal(r, sbet, cbet, somg, comg);
+    bet = Math::atan2d(sbet, cbet); omg = Math::atan2d(somg, comg);
+  }
+
+  void TriaxialGeodesic::Deriv(int n, const real y[], real f[]) const {
+    // The geodesic with unit speed satisfies r'' = -kappa * g where g =
+    // (X/a^2, Y/b^2, Z/c^2) is normal to the surface and kappa is fixed by
+    // r'' . g = - r' . (r' / (a^2, b^2, c^2)).  The Jacobi fields satisfy
+    // m'' = -K * m where K = 1 / (a^2 b^2 c^2 (g . g)^2) is the Gaussian
+    // curvature.
+    const real *X = y, *Y = y + nb, *Z = y + 2*nb,
+      *U = y + 3*nb, *V = y + 4*nb, *W = y + 5*nb,
+      *m = y + 6*nb, *mp = y + 7*nb, *M = y + 8*nb, *Mp = y + 9*nb;
+    for (int i = 0; i < n; ++i) {
+      real
+        gx = X[i] * _ia2, gy = Y[i] * _ib2, gz = Z[i] * _ic2,
+        g2 = Math::sq(gx) + Math::sq(gy) + Math::sq(gz),
+        kap = (Math::sq(U[i]) * _ia2 + Math::sq(V[i]) * _ib2 +
+               Math::sq(W[i]) * _ic2) / g2,
+        K = _kK0 / Math::sq(g2);
+      f[i] = U[i]; f[nb + i] = V[i]; f[2*nb + i] = W[i];
+      f[3*nb + i] = -kap * gx; f[4*nb + i] = -kap * gy;
+      f[5*nb + i] = -kap * gz;
+      f[6*nb + i] = mp[i]; f[7*nb + i] = -K * m[i];
+      f[8*nb + i] = Mp[i]; f[9*nb + i] = -K * M[i];
+    }
+  }
+
+  void TriaxialGeodesic::Step(int n, const real h[], real y[], real work[])
+    const {
+    // One Gragg-Bulirsch-Stoer step of length h[i] for geodesic i.  At level
+    // j the modified midpoint method with 2*(j+1) substeps is applied and
+    // the results are extrapolated to zero substep (the error is a series in
+    // the square of the substep).  A step of length 0 leaves the state
+    // unchanged.
+    const int ns = nv * nb;
+    real *f0 = work, *zp = f0 + ns, *zc = zp + ns, *fz = zc + ns,
+      *tab = fz + ns;
+    Deriv(n, y, f0);
+    for (int j = 0; j < _nlev; ++j) {
+      const int m = 2 * (j + 1);
+      for (int k = 0; k < nv; ++k)
+        for (int i = 0; i < n; ++i) {
+          int l = k * nb + i;
+          zp[l] = y[l]; zc[l] = y[l] + h[i] / m * f0[l];
+        }
+      for (int s = 1; s < m; ++s) {
+        Deriv(n, zc, fz);
+        for (int k = 0; k < nv; ++k)
+          for (int i = 0; i < n; ++i) {
+            int l = k * nb + i;
+            real z = zp[l] + 2 * h[i] / m * fz[l];
+            zp[l] = zc[l]; zc[l] = z;
+          }
+      }
+      Deriv(n, zc, fz);
+      for (int k = 0; k < nv; ++k)
+        for (int i = 0; i < n; ++i) {
+          int l = k * nb + i;
+          real t = (zc[l] + zp[l] + h[i] / m * fz[l]) / 2;
+          // Neville's algorithm in place: row q of tab holds the estimate
+          // of order 2*(q+1) from the previous level.
+          for (int q = 0; q < j; ++q) {
+            real fac = Math::sq(real(m) / (2 * (j - q))) - 1,
+              d = (t - tab[q * ns + l]) / fac;
+            tab[q * ns + l] = t; t += d;
+          }
+          tab[j * ns + l] = t;
+        }
+    }
+    real *X = y, *Y = y + nb, *Z = y + 2*nb,
+      *U = y + 3*nb, *V = y + 4*nb, *W = y + 5*nb;
+    const real* t = tab + (_nlev - 1) * ns;
+    for (int i = 0; i < n; ++i) {
+      if (h[i] == 0) continue;
+      for (int k = 0; k < nv; ++k)
+        y[k * nb + i] = t[k * nb + i];
+      // Return the position to the surface and the velocity to a unit
+      // tangent vector; these corrections are of the order of the
+      // truncation error.
+      real p = sqrt(Math::sq(X[i]) * _ia2 + Math::sq(Y[i]) * _ib2 +
+                    Math::sq(Z[i]) * _ic2);
+      X[i] /= p; Y[i] /= p; Z[i] /= p;
+      real g[3] = {X[i] * _ia2, Y[i] * _ib2, Z[i] * _ic2},
+        v[3] = {U[i], V[i], W[i]},
+        vg = dot(v, g) / dot(g, g);
+      for (int k = 0; k < 3; ++k) v[k] -= vg * g[k];
+      normvec(v);
+      U[i] = v[0]; V[i] = v[1]; W[i] = v[2];
+    }
+  }
+
+  void TriaxialGeodesic::Integrate(int n, const real s12[], real y[]) const
+  {
+    // Geodesic i takes steps[i] equal steps no longer than _hmax.  The
+    // geodesics are integrated in order of decreasing steps so that those
+    // which are still being integrated at step k form a prefix of the block.
+    int steps[nb], ord[nb];
+    for (int i = 0; i < n; ++i) {
+      steps[i] = s12[i] == 0 ? 0 :
+        !isfinite(s12[i]) ? 1 : int(ceil(fabs(s12[i]) / _hmax));
+      ord[i] = i;
+    }
+    stable_sort(ord, ord + n,
+                [&steps](int i, int j) -> bool
+                { return steps[i] > steps[j]; });
+    real h[nb], z[nv * nb];
+    for (int j = 0; j < n; ++j) {
+      h[j] = steps[ord[j]] ? s12[ord[j]] / steps[ord[j]] : 0;
+      for (int k = 0; k < nv; ++k)
+        z[k * nb + j] = y[k * nb + ord[j]];
+    }
+    vector<real> work((4 + _nlev) * nv * nb);
+    for (int k = 0, na = n; ; ++k) {
+      while (na > 0 && steps[ord[na - 1]] <= k) --na;
+      if (na == 0) break;
+      Step(na, h, z, work.data());
+    }
+    for (int j = 0; j < n; ++j)
+      for (int k = 0; k < nv; ++k)
+        y[k * nb + ord[j]] = z[k * nb + j];
+  }
+
+  void TriaxialGeodesic::DirectBlock(int n,
+                                     const real bet1[], const real omg1[],
+                                     const real alp1[], const real s12[],
+                                     real bet2[], real omg2[], real alp2[],
+                                     real m12[], real M12[], real M21[])
+    const {
+    real y[nv * nb];
+    for (int i = 0; i < n; ++i) {
+      real sbet, cbet, somg, comg, salp, calp, r[3], N[3], E[3];
+      Math::sincosd(bet1[i], sbet, cbet); Math::sincosd(omg1[i], somg, comg);
+      Math::sincosd(alp1[i], salp, calp);
+      Cart(sbet, cbet, somg, comg, r);
+      Frame(sbet, cbet, somg, comg, N, E);
+      for (int k = 0; k < 3; ++k) {
+        y[k * nb + i] = r[k];
+        y[(k + 3) * nb + i] = calp * N[k] + salp * E[k];
+      }
+      y[6*nb + i] = 0; y[7*nb + i] = 1; y[8*nb + i] = 1; y[9*nb + i] = 0;
+    }
+    Integrate(n, s12, y);
+    for (int i = 0; i < n; ++i) {
+      real sbet, cbet, somg, comg, N[3], E[3],
+        r[3] = {y[i], y[nb + i], y[2*nb + i]},
+        v[3] = {y[3*nb + i], y[4*nb + i], y[5*nb + i]};
+      Ellipsoidal(r, sbet, cbet, somg, comg);
+      Frame(sbet, cbet, somg, comg, N, E);
+      bet2[i] = Math::atan2d(sbet, cbet); omg2[i] = Math::atan2d(somg, comg);
+      alp2[i] = Math::atan2d(dot(v, E), dot(v, N));
+      if (m12) m12[i] = y[6*nb + i];
+      if (M12) M12[i] = y[8*nb + i];
+      if (M21) M21[i] = y[7*nb + i];
+    }
+  }
+
+  void TriaxialGeodesic::InverseBlock(int n,
+                                      const real bet1[], const real omg1[],
+                                      const real bet2[], const real omg2[],
+                                      real s12[], real alp1[], real alp2[],
+                                      real m12[], real M12[], real M21[])
+    const {
+    static const int maxit = 20, nstart = 8;
+    static const real eps = numeric_limits<real>::epsilon();
+    // Stop when the miss distance is tol or when it is less than tol2 and
+    // is no longer decreasing quadratically (because of roundoff).
+    const real tol = 100 * eps * _b, tol2 = sqrt(eps) * _b;
+    real y[nv * nb], r1[3 * nb], N1[3 * nb], E1[3 * nb],
+      r2[3 * nb], N2[3 * nb], E2[3 * nb], alp0[nb], s0[nb],
+      alp[nb], s[nb], miss[nb], ss[nb], mM[3 * nb];
+    // The status of the best solution so far for geodesic i: 0, none; 1,
+    // not converged; 2, converged with m12 <= 0 (so that point 2 lies beyond
+    // the conjugate point and the geodesic is not the shortest); 3,
+    // converged with m12 > 0.
+    int act[nb], stat[nb];
+    for (int i = 0; i < n; ++i) {
+      real sbet, cbet, somg, comg;
+      Math::sincosd(bet1[i], sbet, cbet); Math::sincosd(omg1[i], somg, comg);
+      Cart(sbet, cbet, somg, comg, r1 + 3*i);
+      Frame(sbet, cbet, somg, comg, N1 + 3*i, E1 + 3*i);
+      Math::sincosd(bet2[i], sbet, cbet); Math::sincosd(omg2[i], somg, comg);
+      Cart(sbet, cbet, somg, comg, r2 + 3*i);
+      Frame(sbet, cbet, somg, comg, N2 + 3*i, E2 + 3*i);
+      // Start with the direction of the chord and the arc of the circle
+      // through the points centered at the origin.
+      const real *p1 = r1 + 3*i, *p2 = r2 + 3*i;
+      real d[3] = {p2[0] - p1[0], p2[1] - p1[1], p2[2] - p1[2]},
+        x[3] = {p1[1] * p2[2] - p1[2] * p2[1],
+                p1[2] * p2[0] - p1[0] * p2[2],
+                p1[0] * p2[1] - p1[1] * p2[0]};
+      alp0[i] = atan2(dot(d, E1 + 3*i), dot(d, N1 + 3*i));
+      s0[i] = (sqrt(dot(p1, p1)) + sqrt(dot(p2, p2))) / 2 *
+        atan2(sqrt(dot(x, x)), dot(p1, p2));
+      stat[i] = 0;
+    }
+    // If the iteration starting from the chord fails to give a geodesic with
+    // m12 > 0 (this happens for some nearly antipodal points), start again
+    // with the azimuth rotated by multiples of 45 deg.
+    for (int p = 0; p < nstart; ++p) {
+      int na = 0;
+      for (int i = 0; i < n; ++i) {
+        if (stat[i] == 3) continue;
+        alp[i] = alp0[i] + p * Math::pi() / 4; s[i] = s0[i];
+        miss[i] = Math::infinity();
+        act[na++] = i;
+      }
+      for (int it = 0; na > 0; ++it) {
+        for (int j = 0; j < na; ++j) {
+          int i = act[j];
+          real salp = sin(alp[i]), calp = cos(alp[i]);
+          for (int k = 0; k < 3; ++k) {
+            y[k * nb + j] = r1[3*i + k];
+            y[(k + 3) * nb + j] = calp * N1[3*i + k] + salp * E1[3*i + k];
+          }
+          y[6*nb + j] = 0; y[7*nb + j] = 1;
+          y[8*nb + j] = 1; y[9*nb + j] = 0;
+          ss[j] = s[i];
+        }
+        Integrate(na, ss, y);
+        int na1 = 0;
+        for (int j = 0; j < na; ++j) {
+          int i = act[j];
+          real
+            r[3] = {y[j], y[nb + j], y[2*nb + j]},
+            v[3] = {y[3*nb + j], y[4*nb + j], y[5*nb + j]},
+            e[3] = {r2[3*i] - r[0], r2[3*i + 1] - r[1], r2[3*i + 2] - r[2]},
+            de = sqrt(dot(e, e));
+          if (!(de > tol) || (de < tol2 && de > miss[i] / 2) ||
+              it == maxit - 1) {
+            int st = !(de < tol2) ? 1 :
+              (y[6*nb + j] > 0 || s[i] == 0) ? 3 : 2;
+            if (st > stat[i] || (st == stat[i] && st > 1 && s[i] < s12[i])) {
+              stat[i] = st;
+              s12[i] = s[i];
+              alp1[i] = Math::atan2d(sin(alp[i]), cos(alp[i]));
+              alp2[i] = Math::atan2d(dot(v, E2 + 3*i), dot(v, N2 + 3*i));
+              mM[3*i] = y[6*nb + j]; mM[3*i + 1] = y[8*nb + j];
+              mM[3*i + 2] = y[7*nb + j];
+            }
+            continue;
+          }
+          // The end point moves by ds along v and by m12 * dalp along v x
+          // g, where g is the outward normal.
+          real g[3] = {r[0] * _ia2, r[1] * _ib2, r[2] * _ic2};
+          normvec(g);
+          real w[3] = {v[1] * g[2] - v[2] * g[1],
+                       v[2] * g[0] - v[0] * g[2],
+                       v[0] * g[1] - v[1] * g[0]},
+            ds = dot(e, v),
+            dalp = dot(e, w) / y[6*nb + j];
+          s[i] = fmax(s[i] + ds, s[i] / 2);
+          alp[i] += fmax(-1/real(2), fmin(1/real(2), dalp));
+          miss[i] = de;
+          act[na1++] = i;
+        }
+        na = na1;
+      }
+    }
+    for (int i = 0; i < n; ++i) {
+      if (m12) m12[i] = mM[3*i];
+      if (M12) M12[i] = mM[3*i + 1];
+      if (M21) M21[i] = mM[3*i + 2];
+    }
+  }
+
+  void TriaxialGeodesic::Direct(size_t n, const real bet1[],
+                                const real omg1[], const real alp1[],
+                                const real s12[],
+                                real bet2[], real omg2[], real alp2[],
+                                real m12[], real M12[], real M21[],
+                                int nthreads) const {
+    Blocks((n + nb - 1) / nb, nthreads, [&](size_t b) -> void {
+      size_t k = b * nb;
+      DirectBlock(int(min(size_t(nb), n - k)), bet1 + k, omg1 + k,
+                  alp1 + k, s12 + k, bet2 + k, omg2 + k, alp2 + k,
+                  offset(m12, k), offset(M12, k), offset(M21, k));
+    });
+  }
+
+  void TriaxialGeodesic::Inverse(size_t n, const real bet1[],
+                                 const real omg1[], const real bet2[],
+                                 const real omg2[],
+                                 real s12[], real alp1[], real alp2[],
+                                 real m12[], real M12[], real M21[],
+                                 int nthreads) const {
+    Blocks((n + nb - 1) / nb, nthreads, [&](size_t b) -> void {
+      size_t k = b * nb;
+      InverseBlock(int(min(size_t(nb), n - k)), bet1 + k, omg1 + k,
+                   bet2 + k, omg2 + k, s12 + k, alp1 + k, alp2 + k,
+                   offset(m12, k), offset(M12, k), offset(M21, k));
+    });
+  }
+
+} // namespace GeographicLib
@@ -12,6 +12,9 @@
 #include <GeographicLib/PolarStereographic.hpp>
 #include <GeographicLib/TransverseMercator.hpp>
 #include <GeographicLib/Utility.hpp>
+#include <GeographicLib/Executor.hpp>
+#include <atomic>
+#include <vector>
 
 #if defined(_MSC_VER)
 // Squelch warnings about enum-float expressions
@@ -121,6 +124,76 @@ namespace GeographicLib {
     k = k1;
   }
 
+  void UTMUPS::Forward(size_t n, const real lat[], const real lon[],
+                       int zone[], bool northp[], real x[], real y[],
+                       real gamma[], real k[],
+                       int setzone, bool mgrslimits, int nthreads) {
+    // Pick the zones, project the UPS points, and collect the UTM points
+    // with their longitudes relative to the central meridian.  Since
+    // TransverseMercator::Forward only uses AngDiff(lon0, lon) and
+    // AngDiff(0, dlon) = dlon, the results match the scalar version.
+    vector<size_t> ind;
+    vector<real> ulat, ulon;
+    for (size_t i = 0; i < n; ++i) {
+      if (fabs(lat[i]) > Math::qd)
+        throw GeographicErr("Latitude " + Utility::str(lat[i])
+                            + "d not in [-" + to_string(Math::qd)
+                            + "d, " + to_string(Math::qd) + "d]");
+      northp[i] = !(signbit(lat[i]));
+      zone[i] = StandardZone(lat[i], lon[i], setzone);
+      if (zone[i] == INVALID) {
+        x[i] = y[i] = Math::NaN();
+        if (gamma) gamma[i] = Math::NaN();
+        if (k) k[i] = Math::NaN();
+      } else if (zone[i] != UPS) {
+        real dlon = Math::AngDiff(CentralMeridian(zone[i]), lon[i]);
+        if (!(dlon <= 60))
+          throw GeographicErr("Longitude " + Utility::str(lon[i])
+                              + "d more than 60d from center of UTM zone "
+                              + Utility::str(zone[i]));
+        ind.push_back(i); ulat.push_back(lat[i]); ulon.push_back(dlon);
+      } else {
+        if (fabs(lat[i]) < 70)
+          throw GeographicErr("Latitude " + Utility::str(lat[i])
+                              + "d more than 20d from "
+                              + (northp[i] ? "N" : "S") + " pole");
+        real gamma1, k1;
+        PolarStereographic::UPS().Forward(northp[i], lat[i], lon[i],
+                                          x[i], y[i], gamma1, k1);
+        if (gamma) gamma[i] = gamma1;
+        if (k) k[i] = k1;
+      }
+    }
+    size_t m = ind.size();
+    if (m) {
+      bool gk = gamma || k;
+      vector<real> ux(m), uy(m), ugamma(gk ? m : 0), uk(gk ? m : 0);
+      TransverseMercator::UTM().Forward(real(0), m, ulat.data(), ulon.data(),
+                                        ux.data(), uy.data(),
+                                        gk ? ugamma.data() : nullptr,
+                                        gk ? uk.data() : nullptr, nthreads);
+      for (size_t j = 0; j < m; ++j) {
+        size_t i = ind[j];
+        x[i] = ux[j]; y[i] = uy[j];
+        if (gamma) gamma[i] = ugamma[j];
+        if (k) k[i] = uk[j];
+      }
+    }
+    for (size_t i = 0; i < n; ++i) {
+      if (zone[i] == INVALID) continue;
+      bool utmp = zone[i] != UPS;
+      int j = (utmp ? 2 : 0) + (northp[i] ? 1 : 0);
+      x[i] += falseeasting_[j];
+      y[i] += falsenorthing_[j];
+      if (! CheckCoords(utmp, northp[i], x[i], y[i], mgrslimits, false) )
+        throw GeographicErr("Latitude " + Utility::str(lat[i])
+                            + ", longitude " + Utility::str(lon[i])
+                            + " out of legal range for "
+                            + (utmp ? "UTM zone " + Utility::str(zone[i]) :
+                               "UPS"));
+    }
+  }
+
   void UTMUPS::Reverse(int zone, bool northp, real x, real y,
                        real& lat, real& lon, real& gamma, real& k,
                        bool mgrslimits) {
@@ -178,13 +251,41 @@ namespace GeographicLib {
   void UTMUPS::Transfer(int zonein, bool northpin, real xin, real yin,
                         int zoneout, bool northpout, real& xout, real& yout,
                         int& zone) {
+    using std::isnan;
     bool northp = northpin;
+    real x, y;
+    if (zonein != zoneout &&
+        zonein > UPS && zonein <= MAXZONE &&
+        zoneout > UPS && zoneout <= MAXZONE &&
+        !(isnan(xin) || isnan(yin))) {
+      // Transfer between UTM zones without going through the geographic
+      // latitude.  The range checks are those of Reverse and Forward; if the
+      // output checks fail, take the general route to get its error message.
+      CheckCoords(true, northpin, xin, yin, false);
+      int ind = 2 + (northpin ? 1 : 0);
+      real dlon = TransverseMercator::UTM().Transfer
+        (CentralMeridian(zonein),
+         xin - falseeasting_[ind], yin - falsenorthing_[ind],
+         CentralMeridian(zoneout), x, y);
+      northp = !signbit(y);
+      ind = 2 + (northp ? 1 : 0);
+      x += falseeasting_[ind];
+      y += falsenorthing_[ind];
+      if (fabs(dlon) <= 60 && CheckCoords(true, northp, x, y, false, false)) {
+        zone = zoneout;
+        xout = x;
+        yout = y;
+        if (northp != northpout)
+          yout += (northpout ? -1 : 1) * MGRS::utmNshift_;
+        return;
+      }
+      northp = northpin;
+    }
     if (zonein != zoneout) {
       // Determine lat, lon
       real lat, lon;
       GeographicLib::UTMUPS::Reverse(zonein, northpin, xin, yin, lat, lon);
       // Try converting to zoneout
-      real x, y;
       int zone1;
       GeographicLib::UTMUPS::Forward(lat, lon, zone1, northp, x, y,
                                      zoneout == UTMUPS::MATCH
@@ -209,6 +310,30 @@ namespace GeographicLib {
     return;
   }
 
+  void UTMUPS::Transfer(size_t n, const int zonein[], const bool northpin[],
+                        const real xin[], const real yin[],
+                        int zoneout, bool northpout,
+                        real xout[], real yout[], int zone[], int nthreads) {
+    // The points are processed in blocks of this size, claimed with an
+    // atomic counter.
+    const size_t block = 1024, nblocks = (n + block - 1) / block;
+    auto work = [&](size_t b) -> void {
+      for (size_t i = b * block; i < min(n, (b + 1) * block); ++i)
+        Transfer(zonein[i], northpin[i], xin[i], yin[i], zoneout, northpout,
+                 xout[i], yout[i], zone[i]);
+    };
+    nthreads = int(min(size_t(max(1, nthreads)), nblocks));
+    if (nthreads <= 1) {
+      for (size_t b = 0; b < nblocks; ++b) work(b);
+      return;
+    }
+    atomic<size_t> next(0);
+    Executor::RunGuarded(nthreads, [&](int) -> void {
+      for (size_t b; (b = next++) < nblocks;)
+        work(b);
+    }, [&]() -> void { next = nblocks; });
+  }
+
   void UTMUPS::DecodeZone(const string& zonestr, int& zone, bool& northp)
   {
     unsigned zlen = unsigned(zonestr.size());
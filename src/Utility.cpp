@@ -8,6 +8,7 @@
  **********************************************************************/
 
 #include <cstdlib>
+#include <cmath>
 #include <GeographicLib/Utility.hpp>
 
 #if defined(_MSC_VER)
@@ -15,6 +16,21 @@
 #  pragma warning (disable: 4996)
 #endif
 
+#if !defined(GEOGRAPHICLIB_NUMA)
+#  if defined(__linux__)
+#    define GEOGRAPHICLIB_NUMA 1
+#  else
+#    define GEOGRAPHICLIB_NUMA 0
+#  endif
+#endif
+
+#if GEOGRAPHICLIB_NUMA
+// Call mbind directly to avoid a dependency on libnuma
+#  include <cstdint>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
 namespace GeographicLib {
 
   using namespace std;
@@ -107,6 +123,19 @@ namespace GeographicLib {
     m = (m + 2) % 12 + 1;     // Renumber the months so January = 1
   }
 
+  namespace {
+    // The value of the digits s[b, e), which are known to be decimal
+    // digits; long fields are passed to Utility::val to check for overflow.
+    int digitsval(const string& s, string::size_type b,
+                  string::size_type e) {
+      if (e == string::npos) e = s.size();
+      if (e - b > 9) return Utility::val<int>(s.substr(b, e - b));
+      int v = 0;
+      for (; b < e; ++b) v = 10 * v + (s[b] - '0');
+      return v;
+    }
+  }
+
   void Utility::date(const std::string& s, int& y, int& m, int& d) {
     if (s == "now") {
       time_t t = time(0);
@@ -126,21 +155,22 @@ namespace GeographicLib {
     else if (p1 == 0)
       throw GeographicErr("Empty year field in date " + s);
     else {
-      y1 = val<int>(s.substr(0, p1));
+      y1 = digitsval(s, 0, p1);
       if (++p1 == s.size())
         throw GeographicErr("Empty month field in date " + s);
       string::size_type p2 = s.find_first_not_of(digits, p1);
       if (p2 == string::npos)
-        m1 = val<int>(s.substr(p1));
+        m1 = digitsval(s, p1, p2);
       else if (s[p2] != '-')
         throw GeographicErr("Delimiter not hyphen in date " + s);
       else if (p2 == p1)
         throw GeographicErr("Empty month field in date " + s);
       else {
-        m1 = val<int>(s.substr(p1, p2 - p1));
+        m1 = digitsval(s, p1, p2);
         if (++p2 == s.size())
           throw GeographicErr("Empty day field in date " + s);
-        d1 = val<int>(s.substr(p2));
+        d1 = s.find_first_not_of(digits, p2) == string::npos ?
+          digitsval(s, p2, string::npos) : val<int>(s.substr(p2));
       }
     }
     y = y1; m = m1; d = d1;
@@ -181,6 +211,43 @@ namespace GeographicLib {
     return true;
   }
 
+  bool Utility::fixedstr(double x, int p, std::string& s) {
+    // Powers of 10 which are exactly representable as doubles
+    static const double pow10[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    };
+    if (!(p >= 0 && p <= 22)) return false;
+    double P = pow10[p], y = x * P;
+    // For |y| < 2^52, y - r is exact and, unless it is a half integer, the
+    // rounding error in y can't change the nearest integer.
+    if (!(fabs(y) < 4503599627370496.0)) return false;
+    double
+      err = fma(x, P, -y),      // x * 10^p = y + err exactly
+      r = nearbyint(y),         // half integers round to even
+      t = y - r;
+    // Resolve apparent ties (the result is a true tie only if err == 0)
+    if (t == 0.5 && err > 0)
+      r += 1;
+    else if (t == -0.5 && err < 0)
+      r -= 1;
+    unsigned long long n = (unsigned long long)(fabs(r));
+    char dig[24];               // digits of n, least significant first
+    int k = 0;
+    do {
+      dig[k++] = char('0' + n % 10); n /= 10;
+    } while (n || k <= p);      // ensure at least one digit before the point
+    char buf[32];
+    int m = 0;
+    if (signbit(x)) buf[m++] = '-'; // -0.0 and small negative x give -0.00
+    while (k > 0) {
+      buf[m++] = dig[--k];
+      if (k == p && p > 0) buf[m++] = '.';
+    }
+    s.assign(buf, m);
+    return true;
+  }
+
   int Utility::set_digits(int ndigits) {
 #if GEOGRAPHICLIB_PRECISION == 5
     if (ndigits <= 0) {
@@ -194,4 +261,30 @@ namespace GeographicLib {
     return Math::set_digits(ndigits);
   }
 
+  bool Utility::interleave(const void* p, size_t bytes) {
+#if GEOGRAPHICLIB_NUMA && defined(SYS_mbind)
+    if (!(p && bytes)) return false;
+    // The values from <linux/mempolicy.h>
+    const int MPOL_INTERLEAVE = 3;
+    const unsigned MPOL_MF_MOVE = 1U << 1;
+    const unsigned long MPOL_F_MEMS_ALLOWED = 1UL << 2;
+    long page = sysconf(_SC_PAGESIZE);
+    if (page <= 0) return false;
+    // Interleave across the nodes allowed for the process (up to 1024).
+    unsigned long nodes[16] = {};
+    const unsigned long maxnode = 8 * sizeof(nodes);
+    if (syscall(SYS_get_mempolicy, nullptr, nodes, maxnode, nullptr,
+                MPOL_F_MEMS_ALLOWED) != 0)
+      return false;
+    // mbind needs a page aligned start.
+    uintptr_t start = uintptr_t(p) & ~uintptr_t(page - 1),
+      end = uintptr_t(p) + bytes;
+    return syscall(SYS_mbind, start, end - start, MPOL_INTERLEAVE,
+                   nodes, maxnode, MPOL_MF_MOVE) == 0;
+#else
+    (void)p; (void)bytes;
+    return false;
+#endif
+  }
+
 } // namespace GeographicLib
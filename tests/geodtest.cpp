@@ -8,8 +8,12 @@
  **********************************************************************/
 
 #include <iostream>
+#include <limits>
+#include <thread>
+#include <vector>
 #include <GeographicLib/Geodesic.hpp>
 #include <GeographicLib/GeodesicExact.hpp>
+#include <GeographicLib/GeodesicLine.hpp>
 
 using namespace std;
 using namespace GeographicLib;
@@ -192,6 +196,249 @@ static int testarcdirect(T f = 1) {
   return result;
 }
 
+static int testbatchinverse() {
+  T lat1[ncases], lon1[ncases], lat2[ncases], lon2[ncases],
+    azi1[ncases], azi2[ncases], s12[ncases], a12[ncases],
+    m12[ncases], M12[ncases], M21[ncases], S12[ncases];
+  const Geodesic& g = Geodesic::WGS84();
+  for (int i = 0; i < ncases; ++i) {
+    lat1[i] = testcases[i][0]; lon1[i] = testcases[i][1];
+    lat2[i] = testcases[i][3]; lon2[i] = testcases[i][4];
+  }
+  g.GenInverse(ncases, lat1, lon1, lat2, lon2, Geodesic::ALL,
+               s12, azi1, azi2, m12, M12, M21, S12, a12);
+  int result = 0;
+  for (int i = 0; i < ncases; ++i) {
+    T azi1a, azi2a, s12a, a12a, m12a, M12a, M21a, S12a;
+    int k = 0;
+    a12a = g.GenInverse(lat1[i], lon1[i], lat2[i], lon2[i], Geodesic::ALL,
+                        s12a, azi1a, azi2a, m12a, M12a, M21a, S12a);
+    // The batch results should be identical to the scalar ones
+    k += checkEquals(azi1[i], azi1a, 0);
+    k += checkEquals(azi2[i], azi2a, 0);
+    k += checkEquals(s12[i], s12a, 0);
+    k += checkEquals(a12[i], a12a, 0);
+    k += checkEquals(m12[i], m12a, 0);
+    k += checkEquals(M12[i], M12a, 0);
+    k += checkEquals(M21[i], M21a, 0);
+    k += checkEquals(S12[i], S12a, 0);
+    if (k) cout << "testbatchinverse failure: case " << i << "\n";
+    result += k;
+  }
+  // Only request the distance; the other outputs may be null
+  g.GenInverse(ncases, lat1, lon1, lat2, lon2, Geodesic::DISTANCE,
+               s12, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
+  for (int i = 0; i < ncases; ++i)
+    result += checkEquals(s12[i], testcases[i][6], 1e-8);
+  return result;
+}
+
+static int testbatchposition() {
+  // Sample the line given by case 0 at the distances of all the cases
+  const Geodesic& g = Geodesic::WGS84();
+  GeodesicLine l = g.Line(testcases[0][0], testcases[0][1], testcases[0][2]);
+  T s12[ncases], lat2[ncases], lon2[ncases], azi2[ncases], s12b[ncases],
+    m12[ncases], M12[ncases], M21[ncases], S12[ncases], a12[ncases];
+  for (int i = 0; i < ncases; ++i)
+    s12[i] = testcases[i][6];
+  unsigned mask = GeodesicLine::ALL | GeodesicLine::LONG_UNROLL;
+  l.GenPosition(ncases, false, s12, mask,
+                lat2, lon2, azi2, s12b, m12, M12, M21, S12, a12);
+  int result = 0;
+  for (int i = 0; i < ncases; ++i) {
+    T lat2a, lon2a, azi2a, s12a, m12a, M12a, M21a, S12a, a12a;
+    int k = 0;
+    a12a = l.GenPosition(false, s12[i], mask,
+                         lat2a, lon2a, azi2a, s12a, m12a, M12a, M21a, S12a);
+    k += checkEquals(lat2[i], lat2a, 0);
+    k += checkEquals(lon2[i], lon2a, 0);
+    k += checkEquals(azi2[i], azi2a, 0);
+    k += checkEquals(s12b[i], s12a, 0);
+    k += checkEquals(m12[i], m12a, 0);
+    k += checkEquals(M12[i], M12a, 0);
+    k += checkEquals(M21[i], M21a, 0);
+    k += checkEquals(S12[i], S12a, 0);
+    k += checkEquals(a12[i], a12a, 0);
+    if (k) cout << "testbatchposition failure: case " << i << "\n";
+    result += k;
+  }
+  return result;
+}
+
+static int testshortinverse() {
+  // Compare the SHORT_APPROX inverse solution with the full one for short
+  // lines starting at the points of the test cases (and near the pole)
+  const Geodesic& g = Geodesic::WGS84();
+  const T tol = 1e-13 * g.EquatorialRadius(),
+    dists[] = {1, 10, 100, 1000, 2000, 3000, 10000};
+  int result = 0;
+  for (int i = 0; i <= ncases; ++i) {
+    T lat1 = i < ncases ? testcases[i][0] : T(89.999),
+      lon1 = i < ncases ? testcases[i][1] : T(0),
+      azi1 = i < ncases ? testcases[i][2] : T(30);
+    for (T d : dists) {
+      T lat2, lon2;
+      g.Direct(lat1, lon1, azi1, d, lat2, lon2);
+      T s12[2], azi1a[2], azi2a[2], m12[2], M12[2], M21[2], S12[2];
+      for (int j = 0; j < 2; ++j)
+        g.GenInverse(lat1, lon1, lat2, lon2,
+                     j ? (Geodesic::ALL & ~Geodesic::AREA) |
+                     Geodesic::SHORT_APPROX : Geodesic::ALL,
+                     s12[j], azi1a[j], azi2a[j], m12[j], M12[j], M21[j],
+                     S12[j]);
+      // With AREA, SHORT_APPROX is ignored
+      T s12b, S12b, t;
+      g.GenInverse(lat1, lon1, lat2, lon2,
+                   Geodesic::ALL | Geodesic::SHORT_APPROX,
+                   s12b, t, t, t, t, t, S12b);
+      int k = 0;
+      k += checkEquals(s12[1], s12[0], tol);
+      k += checkEquals(m12[1], m12[0], tol);
+      k += checkEquals(s12[0] * Math::AngDiff(azi1a[0], azi1a[1]) *
+                       Math::degree<T>(), T(0), tol);
+      k += checkEquals(s12[0] * Math::AngDiff(azi2a[0], azi2a[1]) *
+                       Math::degree<T>(), T(0), tol);
+      k += checkEquals(M12[1], M12[0], T(1e-14));
+      k += checkEquals(M21[1], M21[0], T(1e-14));
+      k += checkEquals(s12b, s12[0], T(0));
+      k += checkEquals(S12b, S12[0], T(0));
+      if (d > 5000)
+        // Long lines use the full solution
+        k += checkEquals(s12[1], s12[0], T(0));
+      if (k) cout << "testshortinverse failure: case " << i
+                  << " distance " << d << "\n";
+      result += k;
+    }
+  }
+  return result;
+}
+
+static int testorder() {
+  // Check the accuracy of the lower order series expansions against the test
+  // cases and that the full order matches the default constructor
+  const Geodesic& g0 = Geodesic::WGS84();
+  // Tolerances (meters) for orders 3, 4, 5, ...
+  const T tols[] = {1e-3, 2e-6, 5e-7, 5e-8, 5e-8};
+  int result = 0;
+  for (int order = 3; order <= GEOGRAPHICLIB_GEODESIC_ORDER; ++order) {
+    Geodesic g(g0.EquatorialRadius(), g0.Flattening(), false, order);
+    bool full = order == GEOGRAPHICLIB_GEODESIC_ORDER;
+    T tol = full ? T(0) : tols[order - 3],
+      tola = tol / (g0.EquatorialRadius() * Math::degree<T>());
+    for (int i = 0; i < ncases; ++i) {
+      T lat1 = testcases[i][0], lon1 = testcases[i][1],
+        azi1 = testcases[i][2], lat2 = testcases[i][3],
+        lon2 = testcases[i][4], s12 = testcases[i][6];
+      T s12a, azi1a, azi2a, m12a, M12a, M21a, S12a,
+        s12b, azi1b, azi2b, m12b, M12b, M21b, S12b;
+      g.GenInverse(lat1, lon1, lat2, lon2, Geodesic::ALL,
+                   s12a, azi1a, azi2a, m12a, M12a, M21a, S12a);
+      int k = 0;
+      if (full) {
+        g0.GenInverse(lat1, lon1, lat2, lon2, Geodesic::ALL,
+                      s12b, azi1b, azi2b, m12b, M12b, M21b, S12b);
+        k += checkEquals(s12a, s12b, 0);
+        k += checkEquals(azi1a, azi1b, 0);
+        k += checkEquals(azi2a, azi2b, 0);
+        k += checkEquals(m12a, m12b, 0);
+        k += checkEquals(M12a, M12b, 0);
+        k += checkEquals(M21a, M21b, 0);
+        k += checkEquals(S12a, S12b, 0);
+      } else {
+        k += checkEquals(s12a, s12, tol);
+        k += checkEquals(s12 * Math::AngDiff(azi1, azi1a) *
+                         Math::degree<T>(), T(0), tol);
+        T lat2a, lon2a;
+        g.Direct(lat1, lon1, azi1, s12, lat2a, lon2a);
+        k += checkEquals(lat2a, lat2, tola);
+        k += checkEquals(Math::AngDiff(lon2, lon2a) *
+                         cos(lat2 * Math::degree<T>()), T(0), tola);
+      }
+      if (k) cout << "testorder failure: order " << order
+                  << " case " << i << "\n";
+      result += k;
+    }
+  }
+  try {
+    Geodesic g(g0.EquatorialRadius(), g0.Flattening(), false, 2);
+    cout << "testorder failure: order 2 accepted\n";
+    ++result;
+  }
+  catch (const GeographicErr&) {}
+  return result;
+}
+
+static int teststats() {
+  // Check the counts of the paths taken by the inverse calculation; these
+  // are kept per thread.
+  const Geodesic& g = Geodesic::WGS84();
+  int result = 0;
+  Geodesic::Stats st;
+  // The short line path is taken if the separation (in radians) is less than
+  // about sqrt(epsilon)/10; so scale the separation (in degrees) accordingly.
+  const T dlon = sqrt(numeric_limits<T>::epsilon()) / 100;
+  thread t([&g, &st, dlon]() {
+      T s12, azi1, azi2;
+      Geodesic::ResetStats();
+      g.Inverse(10, 0, 20, 0, s12, azi1, azi2);       // meridional
+      g.Inverse(0, 0, 0, 10, s12, azi1, azi2);        // equatorial
+      g.Inverse(10, 0, 10, dlon, s12, azi1, azi2);    // short
+      g.Inverse(-30, 0, T(29.9), T(179.8), s12, azi1, azi2); // antipodal
+      st = Geodesic::GetStats();
+    });
+  t.join();
+  Geodesic::Stats st0 = Geodesic::GetStats(), sum;
+  // Aggregate the counts for two threads
+  sum += st0; sum += st;
+  if (Geodesic::StatsEnabled()) {
+    result += checkEquals(T(st.inverse), 4, 0);
+    result += checkEquals(T(st.meridional), 1, 0);
+    result += checkEquals(T(st.equatorial), 1, 0);
+    result += checkEquals(T(st.shortline), 1, 0);
+    result += checkEquals(T(st.astroid), 1, 0);
+    result += checkEquals(T(st.newton > 0), 1, 0);
+    result += checkEquals(T(sum.inverse), T(st0.inverse + 4), 0);
+  } else {
+    result += checkEquals(T(st.inverse + st.newton + st.bisection), 0, 0);
+    result += checkEquals(T(sum.inverse), 0, 0);
+  }
+  return result;
+}
+
+static int testexactthreads() {
+  // Construct GeodesicExact objects for several ellipsoids concurrently
+  // (these share the cached FFT plans) and check the results against those
+  // for objects constructed serially.
+  const T fs[] = {T(1)/298, T(1)/10, T(1)/3, -T(1)/3, -1, T(0.9), -9};
+  const int nf = sizeof(fs) / sizeof(T), nthreads = 4;
+  vector<T> S12(nf);
+  for (int j = 0; j < nf; ++j) {
+    GeodesicExact g(1, fs[j]);
+    T s12, azi1, azi2, m12, M12, M21;
+    g.GenInverse(10, 20, -30, 160, GeodesicExact::ALL,
+                 s12, azi1, azi2, m12, M12, M21, S12[j]);
+  }
+  vector<int> fails(nthreads);
+  vector<thread> threads;
+  for (int t = 0; t < nthreads; ++t)
+    threads.push_back(thread([&fs, &S12, &fails, t]() {
+          for (int k = 0; k < 10; ++k)
+            for (int j = 0; j < nf; ++j) {
+              GeodesicExact g(1, fs[(j + t) % nf]);
+              T s12, azi1, azi2, m12, M12, M21, S;
+              g.GenInverse(10, 20, -30, 160, GeodesicExact::ALL,
+                           s12, azi1, azi2, m12, M12, M21, S);
+              if (!(S == S12[(j + t) % nf])) ++fails[t];
+            }
+        }));
+  int result = 0;
+  for (int t = 0; t < nthreads; ++t) {
+    threads[t].join();
+    result += fails[t];
+  }
+  return result;
+}
+
 int main() {
   int n = 0, i;
 
@@ -204,6 +451,21 @@ int main() {
   i = testarcdirect<Geodesic>(); n += i;
   if (i) cout << "testarcdirect<Geodesic> failure\n";
 
+  i = testbatchinverse(); n += i;
+  if (i) cout << "testbatchinverse failure\n";
+
+  i = testbatchposition(); n += i;
+  if (i) cout << "testbatchposition failure\n";
+
+  i = testshortinverse(); n += i;
+  if (i) cout << "testshortinverse failure\n";
+
+  i = testorder(); n += i;
+  if (i) cout << "testorder failure\n";
+
+  i = teststats(); n += i;
+  if (i) cout << "teststats failure\n";
+
   // Allow 2x error with GeodesicExact calcuations (for WGS84)
   i = testinverse<GeodesicExact>(2); n += i;
   if (i) cout << "testinverse<GeodesicExact> failure\n";
@@ -214,6 +476,9 @@ int main() {
   i = testarcdirect<GeodesicExact>(2); n += i;
   if (i) cout << "testarcdirect<GeodesicExact> failure\n";
 
+  i = testexactthreads(); n += i;
+  if (i) cout << "testexactthreads failure\n";
+
   if (n) {
     cout << n << " failure" << (n > 1 ? "s" : "") << "\n";
     return 1;
@@ -10,8 +10,12 @@
 #include <iostream>
 #include <limits>
 #include <string>
+#include <vector>
+#include <thread>
+#include <functional>
 #include <GeographicLib/Math.hpp>
 #include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/GeodesicLine.hpp>
 #include <GeographicLib/Intersect.hpp>
 
 using namespace std;
@@ -75,9 +79,206 @@ int checkcoincident1() {
   return n;
 }
 
+int checkallthreads() {
+  // Intersect::All should give the same results (including the coincidence
+  // indicators and the diagnostic counters) for any number of threads.
+  int n = 0;
+  const Geodesic& geod = Geodesic::WGS84();
+  const T lines[][6] = {
+    {0, 0, 45, 0, 0, 135},      // start at an intersection
+    {10, 20, 30, -5, 40, 100},
+    {0, 0, 90, 0, 30, 90},      // coincident equatorial lines
+    {-60, 10, 0, 20, 30, 0},    // coincident meridians
+  };
+  for (const auto& l : lines) {
+    for (T maxdist : {T(1e7), T(6e7)}) {
+      vector<Intersect::Point> p[2];
+      vector<int> c[2];
+      long long num[2];
+      for (int j = 0; j < 2; ++j) {
+        Intersect inter(geod);
+        p[j] = inter.All(l[0], l[1], l[2], l[3], l[4], l[5],
+                         maxdist, c[j], Intersect::Point(0, 0), j ? 4 : 1);
+        num[j] = inter.NumInverse();
+      }
+      int i = checkEquals(T(p[1].size()), T(p[0].size()), 0) +
+        checkEquals(T(num[1]), T(num[0]), 0);
+      for (size_t k = 0; i == 0 && k < p[0].size(); ++k)
+        i += checkEquals(p[1][k].first, p[0][k].first, 0) +
+          checkEquals(p[1][k].second, p[0][k].second, 0) +
+          checkEquals(T(c[1][k]), T(c[0][k]), 0);
+      if (i) cout << "ERROR in checkallthreads, maxdist " << maxdist << "\n";
+      n += i;
+    }
+  }
+  return n;
+}
+
+int checkallsegments() {
+  // Intersect::AllSegments should find the same intersections as calling
+  // Intersect::Segment for all the pairs of segments, for any number of
+  // threads.
+  int n = 0;
+  const Geodesic& geod = Geodesic::WGS84();
+  vector<GeodesicLine> lines[2];
+  // A deterministic set of segments with a range of sizes and positions,
+  // including some long ones and a pair of coincident ones.
+  for (int k = 0; k < 2; ++k) {
+    for (int i = 0; i < 120; ++i) {
+      T lat = T((i * 37 + k * 11) % 161 - 80),
+        lon = T((i * 53 + k * 29) % 361 - 180),
+        len = T(i % 7 == 0 ? 60 : i % 3 == 0 ? 5 : 1),
+        azi = T((i * 71 + k * 13) % 360);
+      lines[k].push_back(geod.DirectLine(lat, lon, azi, 1e5 * len,
+                                         Intersect::LineCaps));
+    }
+    lines[k].push_back(geod.InverseLine(0, 10 + k, 0, 20 + k,
+                                        Intersect::LineCaps));
+  }
+  vector<pair<int, int>> ind0;
+  vector<Intersect::Point> p0;
+  vector<int> c0;
+  {
+    Intersect inter(geod);
+    for (int i = 0; i < int(lines[0].size()); ++i)
+      for (int j = 0; j < int(lines[1].size()); ++j) {
+        int segmode, c;
+        Intersect::Point p = inter.Segment(lines[0][i], lines[1][j],
+                                           segmode, &c);
+        if (segmode == 0) {
+          ind0.push_back(make_pair(i, j)); p0.push_back(p); c0.push_back(c);
+        }
+      }
+  }
+  for (int nthreads : {1, 3}) {
+    Intersect inter(geod);
+    vector<pair<int, int>> ind;
+    vector<int> c;
+    vector<Intersect::Point> p = inter.AllSegments(lines[0], lines[1],
+                                                   ind, c, nthreads);
+    int i = checkEquals(T(p.size()), T(p0.size()), 0);
+    for (size_t k = 0; i == 0 && k < p0.size(); ++k)
+      i += checkEquals(T(ind[k].first), T(ind0[k].first), 0) +
+        checkEquals(T(ind[k].second), T(ind0[k].second), 0) +
+        checkEquals(p[k].first, p0[k].first, 0) +
+        checkEquals(p[k].second, p0[k].second, 0) +
+        checkEquals(T(c[k]), T(c0[k]), 0);
+    if (i) cout << "ERROR in checkallsegments, nthreads " << nthreads << "\n";
+    n += i;
+  }
+  // Intersect::Segments for each segment X gives the same results.
+  for (int nthreads : {1, 3}) {
+    Intersect inter(geod);
+    vector<int> ind, c;
+    size_t k = 0;
+    int i = 0;
+    for (int ix = 0; i == 0 && ix < int(lines[0].size()); ++ix) {
+      vector<Intersect::Point> p = inter.Segments(lines[0][ix], lines[1],
+                                                  ind, c, nthreads);
+      for (size_t l = 0; i == 0 && l < p.size(); ++l, ++k)
+        i += k >= p0.size() ? 1 :
+          checkEquals(T(ix), T(ind0[k].first), 0) +
+          checkEquals(T(ind[l]), T(ind0[k].second), 0) +
+          checkEquals(p[l].first, p0[k].first, 0) +
+          checkEquals(p[l].second, p0[k].second, 0) +
+          checkEquals(T(c[l]), T(c0[k]), 0);
+    }
+    i += checkEquals(T(k), T(p0.size()), 0);
+    if (i) cout << "ERROR in Segments, nthreads " << nthreads << "\n";
+    n += i;
+  }
+  return n;
+}
+
+int checkselfintersections() {
+  // Intersect::SelfIntersections should find the same intersections as
+  // calling Intersect::Segment for all the pairs of nonadjacent segments,
+  // for any number of threads.  The polyline is a closed random walk which
+  // crosses itself many times.
+  int n = 0;
+  const Geodesic& geod = Geodesic::WGS84();
+  const int nv = 301;
+  vector<T> lat(nv), lon(nv);
+  for (int i = 0; i < nv - 1; ++i) {
+    lat[i] = T(40 + 3 * Math::sind(T(i * 47)) + Math::cosd(T(i * 131)));
+    lon[i] = T(10 + 4 * Math::cosd(T(i * 59)) + Math::sind(T(i * 173)));
+  }
+  lat[nv - 1] = lat[0]; lon[nv - 1] = lon[0];
+  vector<pair<int, int>> ind0;
+  vector<Intersect::Point> p0;
+  vector<int> c0;
+  {
+    Intersect inter(geod);
+    for (int i = 0; i < nv - 1; ++i)
+      for (int j = i + 2; j < nv - 1; ++j) {
+        if (i == 0 && j == nv - 2) continue;
+        int segmode, c;
+        Intersect::Point p =
+          inter.Segment(lat[i], lon[i], lat[i + 1], lon[i + 1],
+                        lat[j], lon[j], lat[j + 1], lon[j + 1], segmode, &c);
+        if (segmode == 0) {
+          ind0.push_back(make_pair(i, j)); p0.push_back(p); c0.push_back(c);
+        }
+      }
+  }
+  int i = p0.size() < 100;      // Check that the test is nontrivial
+  for (int nthreads : {1, 3}) {
+    Intersect inter(geod);
+    vector<pair<int, int>> ind;
+    vector<int> c;
+    vector<Intersect::Point> p =
+      inter.SelfIntersections(nv, lat.data(), lon.data(), ind, c, nthreads);
+    i += checkEquals(T(p.size()), T(p0.size()), 0);
+    for (size_t k = 0; i == 0 && k < p0.size(); ++k)
+      i += checkEquals(T(ind[k].first), T(ind0[k].first), 0) +
+        checkEquals(T(ind[k].second), T(ind0[k].second), 0) +
+        checkEquals(p[k].first, p0[k].first, 0) +
+        checkEquals(p[k].second, p0[k].second, 0) +
+        checkEquals(T(c[k]), T(c0[k]), 0);
+  }
+  if (i) cout << "ERROR in checkselfintersections\n";
+  n += i;
+  return n;
+}
+
+int checksharedthreads() {
+  // Several threads may use the same Intersect object; the diagnostic
+  // counters should end up the same as for serial use.
+  int n = 0;
+  const Geodesic& geod = Geodesic::WGS84();
+  const int nt = 4, num = 50;
+  Intersect inter(geod), interser(geod);
+  vector<Intersect::Point> p(nt * num), pser(nt * num);
+  auto work = [&](const Intersect& x, vector<Intersect::Point>& v, int t) {
+    for (int i = t * num; i < (t + 1) * num; ++i)
+      v[i] = x.Closest(T(i % 90), T(i), T(3 * i), T(-i % 60), T(2 * i),
+                       T(90 + i));
+  };
+  for (int t = 0; t < nt; ++t)
+    work(interser, pser, t);
+  vector<thread> threads;
+  for (int t = 0; t < nt; ++t)
+    threads.push_back(thread(work, cref(inter), ref(p), t));
+  for (auto& t : threads)
+    t.join();
+  int i = checkEquals(T(inter.NumInverse()), T(interser.NumInverse()), 0) +
+    checkEquals(T(inter.NumBasic()), T(interser.NumBasic()), 0) +
+    checkEquals(T(inter.NumChange()), T(interser.NumChange()), 0);
+  for (int k = 0; i == 0 && k < nt * num; ++k)
+    i += checkEquals(p[k].first, pser[k].first, 0) +
+      checkEquals(p[k].second, pser[k].second, 0);
+  if (i) cout << "ERROR in checksharedthreads\n";
+  n += i;
+  return n;
+}
+
 int main() {
   int n = 0;
   n += checkcoincident1();
+  n += checkallthreads();
+  n += checkallsegments();
+  n += checkselfintersections();
+  n += checksharedthreads();
   if (n) {
     cout << n << " failure" << (n > 1 ? "s" : "") << "\n";
     return 1;
@@ -10,6 +10,7 @@
 #include <iostream>
 #include <limits>
 #include <string>
+#include <vector>
 #include <GeographicLib/Math.hpp>
 #include <GeographicLib/Utility.hpp>
 #include <GeographicLib/DMS.hpp>
@@ -18,6 +19,10 @@
 #include <GeographicLib/UTMUPS.hpp>
 #include <GeographicLib/MGRS.hpp>
 #include <GeographicLib/PolygonArea.hpp>
+#include <GeographicLib/PolygonEdit.hpp>
+#include <GeographicLib/PolygonIndex.hpp>
+#include <GeographicLib/PolygonWindow.hpp>
+#include <GeographicLib/PolylineDistance.hpp>
 
 using namespace std;
 using namespace GeographicLib;
@@ -183,6 +188,340 @@ static int Planimeter29() {
   return result;
 }
 
+static int PlanimeterMerge() {
+  // Check that accumulating pieces of a polygon separately and merging them
+  // agrees with the serial result.  The polygon encircles the north pole so
+  // that the count of crossings of the prime meridian matters.
+  const Geodesic& g = Geodesic::WGS84();
+  const int n = 5000;
+  vector<T> lat(n), lon(n);
+  for (int i = 0; i < n; ++i) {
+    lat[i] = 60 + 10 * Math::sind(T(7 * i));
+    lon[i] = -180 + T(360 * i) / n;
+  }
+  T perim0, area0, perim, area;
+  int result = 0;
+  for (int l = 0; l < 2; ++l) {
+    bool polyline = l != 0;
+    PolygonArea serial(g, polyline);
+    for (int i = 0; i < n; ++i)
+      serial.AddPoint(lat[i], lon[i]);
+    serial.Compute(false, true, perim0, area0);
+    PolygonArea batch(g, polyline);
+    batch.AddPoints(n, lat.data(), lon.data(), 4);
+    result += batch.Compute(false, true, perim, area) != unsigned(n);
+    result += checkEquals(perim, perim0, perim0 * 1e-14);
+    if (!polyline)
+      result += checkEquals(area, area0, 0.01);
+    // In reproducible mode, the results don't depend on the thread count.
+    T perim1 = 0, area1 = 0;
+    for (int nthreads = 1; nthreads <= 4; nthreads += 3) {
+      PolygonArea rep(g, polyline);
+      rep.AddPoints(n, lat.data(), lon.data(), nthreads, true);
+      result += rep.Compute(false, true, perim, area) != unsigned(n);
+      if (nthreads == 1) {
+        perim1 = perim; area1 = area;
+        result += checkEquals(perim, perim0, perim0 * 1e-14);
+      } else {
+        result += checkEquals(perim, perim1, 0);
+        if (!polyline)
+          result += checkEquals(area, area1, 0);
+      }
+    }
+    // Merge three pieces pairwise, including one added with AddEdge.
+    PolygonArea a(g, polyline), b(g, polyline), c(g, polyline);
+    for (int i = 0; i < n - 1; ++i)
+      (i < 1000 ? a : i < 3000 ? b : c).AddPoint(lat[i], lon[i]);
+    T s12, azi1, azi2;
+    g.Inverse(lat[n-2], lon[n-2], lat[n-1], lon[n-1], s12, azi1, azi2);
+    c.AddEdge(azi1, s12);
+    b.Merge(c);
+    a.Merge(b);
+    result += a.Compute(false, true, perim, area) != unsigned(n);
+    result += checkEquals(perim, perim0, perim0 * 1e-14);
+    if (!polyline)
+      result += checkEquals(area, area0, 0.01);
+  }
+  return result;
+}
+
+template<class G>
+static int PlanimeterMany(const G& g) {
+  // Check ComputeMany against separate PolygonArea objects for a collection
+  // of small quadrilaterals and triangles.
+  typedef PolygonAreaT<G> PolygonArea;
+  const int n = 1000;
+  vector<size_t> offsets(1, 0);
+  vector<T> lat, lon;
+  for (int k = 0; k < n; ++k) {
+    // Include some polygons with more vertices than AuxLatitude::lanes
+    int m = 3 + k % 2 + (k % 7 == 0 ? 20 : 0);
+    T lat0 = -80 + T(160 * k) / n, lon0 = -180 + T(7 * k % 360);
+    for (int i = 0; i < m; ++i) {
+      lat.push_back(lat0 + Math::sind(T(360 * i) / m));
+      lon.push_back(lon0 + Math::cosd(T(360 * i) / m));
+    }
+    offsets.push_back(lat.size());
+  }
+  int result = 0;
+  for (int l = 0; l < 2; ++l) {
+    bool polyline = l != 0;
+    PolygonArea poly(g, polyline);
+    vector<T> perim(n), area(n);
+    poly.ComputeMany(n, offsets.data(), lat.data(), lon.data(), false, true,
+                     perim.data(), polyline ? nullptr : area.data(), 3);
+    for (int k = 0; k < n; ++k) {
+      PolygonArea p(g, polyline);
+      for (size_t i = offsets[k]; i < offsets[k + 1]; ++i)
+        p.AddPoint(lat[i], lon[i]);
+      T perim0, area0;
+      p.Compute(false, true, perim0, area0);
+      result += checkEquals(perim[k], perim0, 0);
+      if (!polyline)
+        result += checkEquals(area[k], area0, 0);
+    }
+  }
+  return result;
+}
+
+template<class P>
+static int TestPointsCheck(const P& p) {
+  // Compare TestPoints with TestPoint for a grid of test points.
+  int result = 0;
+  vector<T> lat, lon;
+  for (int i = -8; i <= 8; ++i)
+    for (int j = -18; j < 18; ++j) {
+      lat.push_back(T(10 * i) + T(0.5)); lon.push_back(T(10 * j) + T(0.25));
+    }
+  const size_t n = lat.size();
+  vector<T> perim(n), area(n);
+  p.TestPoints(n, lat.data(), lon.data(), false, true, perim.data(),
+               p.Polyline() ? nullptr : area.data(), 2);
+  for (size_t i = 0; i < n; ++i) {
+    T perim0, area0;
+    p.TestPoint(lat[i], lon[i], false, true, perim0, area0);
+    result += checkEquals(perim[i], perim0, T(1e-6));
+    if (!p.Polyline())
+      result += checkEquals(area[i], area0, T(0.5));
+  }
+  return result;
+}
+
+static int PlanimeterTestPoints() {
+  // Check TestPoints for polygons and polylines with 0 to 3 points
+  // using Geodesic and Rhumb.
+  const T lat[] = {T(40.6), T(51.5), T(64.1)},
+    lon[] = {T(-73.8), T(-0.5), T(-21.9)};
+  int result = 0;
+  for (int l = 0; l < 2; ++l) {
+    bool polyline = l != 0;
+    PolygonArea p(Geodesic::WGS84(), polyline);
+    PolygonAreaRhumb r(Rhumb::WGS84(), polyline);
+    for (int k = 0; k <= 3; ++k) {
+      result += TestPointsCheck(p);
+      result += TestPointsCheck(r);
+      if (k < 3) {
+        p.AddPoint(lat[k], lon[k]);
+        r.AddPoint(lat[k], lon[k]);
+      }
+    }
+  }
+  return result;
+}
+
+static int PlanimeterWindow() {
+  // Check PolygonWindow against PolygonArea objects holding the points in
+  // the window for a track which circles the north pole several times (so
+  // that the window sometimes encloses the pole) and crosses the prime
+  // meridian and the antimeridian.
+  const Geodesic& g = Geodesic::WGS84();
+  const unsigned n = 7;
+  int result = 0;
+  for (int l = 0; l < 2; ++l) {
+    bool polyline = l != 0;
+    PolygonWindow w(g, n, polyline);
+    vector<T> lat, lon;
+    size_t first = 0;           // the index of the oldest point in w
+    for (int k = 0; k < 100; ++k) {
+      lat.push_back(75 + 10 * Math::sind(T(37 * k)));
+      lon.push_back(Math::AngNormalize(T(55 * k)));
+      w.AddPoint(lat.back(), lon.back());
+      if (lat.size() - first > n) ++first;
+      if (k % 10 == 9) {
+        // Test RemovePoint too
+        w.RemovePoint(); w.RemovePoint(); first += 2;
+      }
+      PolygonArea p(g, polyline);
+      for (size_t i = first; i < lat.size(); ++i)
+        p.AddPoint(lat[i], lon[i]);
+      T perim, area, perim0, area0;
+      result += w.Compute(false, true, perim, area) !=
+        p.Compute(false, true, perim0, area0);
+      result += checkEquals(perim, perim0, T(1e-6));
+      if (!polyline)
+        result += checkEquals(area, area0, T(0.01));
+    }
+  }
+  return result;
+}
+
+static int PlanimeterEdit() {
+  // Check PolygonEdit against PolygonArea objects holding the same points
+  // after a sequence of insertions, moves, and removals at the ends and in
+  // the middle of a polygon which sometimes encloses the north pole and
+  // crosses the prime meridian and the antimeridian.
+  const Geodesic& g = Geodesic::WGS84();
+  int result = 0;
+  for (int l = 0; l < 2; ++l) {
+    bool polyline = l != 0;
+    PolygonEdit e(g, polyline);
+    vector<T> lat, lon;
+    for (int k = 0; k < 120; ++k) {
+      T la = 75 + 10 * Math::sind(T(37 * k)),
+        lo = Math::AngNormalize(T(55 * k));
+      unsigned n = unsigned(lat.size()), i = (7 * k) % (n + 1);
+      if (k < 40 || k % 3 == 0) {
+        e.InsertPoint(i, la, lo);
+        lat.insert(lat.begin() + i, la); lon.insert(lon.begin() + i, lo);
+      } else if (k % 3 == 1) {
+        i = i % n;
+        e.MovePoint(i, la, lo);
+        lat[i] = la; lon[i] = lo;
+      } else {
+        i = i % n;
+        e.RemovePoint(i);
+        lat.erase(lat.begin() + i); lon.erase(lon.begin() + i);
+      }
+      PolygonArea p(g, polyline);
+      for (size_t j = 0; j < lat.size(); ++j)
+        p.AddPoint(lat[j], lon[j]);
+      T perim, area, perim0, area0, la1, lo1;
+      result += e.Compute(false, true, perim, area) !=
+        p.Compute(false, true, perim0, area0);
+      result += checkEquals(perim, perim0, T(1e-6));
+      if (!polyline)
+        result += checkEquals(area, area0, T(0.01));
+      e.Point(i % unsigned(lat.size()), la1, lo1);
+      result += la1 != lat[i % lat.size()] || lo1 != lon[i % lon.size()];
+    }
+    try {
+      e.MovePoint(e.NumberPoints(), 0, 0); ++result;
+    } catch (const GeographicErr&) {}
+    // Remove all but one point from the start
+    while (e.NumberPoints() > 1) e.RemovePoint(0);
+    T perim, area;
+    result += e.Compute(false, true, perim, area) != 1 || perim != 0;
+  }
+  return result;
+}
+
+static int PlanimeterIndex() {
+  // Check PolygonIndex for geodesic circles (compared with the distance from
+  // the center) and for an L-shaped polygon.
+  const Geodesic& g = Geodesic::WGS84();
+  int result = 0;
+  vector<T> lat, lon;
+  const T lat0[] = {T(40.6), T(89), T(-30)},
+    radius[] = {T(3e5), T(5e5), T(1.2e7)};
+  for (int l = 0; l < 3; ++l) {
+    int m = g.CircleVertices(lat0[l], 10, radius[l], 1);
+    lat.resize(m); lon.resize(m);
+    // The circle is traversed clockwise.
+    g.Circle(lat0[l], 10, radius[l], m, lat.data(), lon.data());
+    PolygonIndex in(g, m, lat.data(), lon.data(), true),
+      out(g, m, lat.data(), lon.data(), false);
+    T s12, npdist;
+    g.Inverse(lat0[l], 10, 90, 0, npdist);
+    result += in.NorthPoleInside() != (npdist < radius[l]);
+    result += out.NorthPoleInside() == in.NorthPoleInside();
+    const int k = 2000;
+    vector<T> plat(k), plon(k);
+    vector<char> inside(k);
+    bool batch[k];
+    for (int i = 0; i < k; ++i) {
+      // Points on a spiral around the center
+      g.Direct(lat0[l], 10, T(137.5) * i, radius[l] * 2 * (i + T(0.5)) / k,
+               plat[i], plon[i]);
+      g.Inverse(lat0[l], 10, plat[i], plon[i], s12);
+      inside[i] = fabs(s12 - radius[l]) > 2 ? s12 < radius[l] : -1;
+    }
+    in.Contains(k, plat.data(), plon.data(), batch, 3);
+    for (int i = 0; i < k; ++i) {
+      bool c = in.Contains(plat[i], plon[i]);
+      result += c != batch[i];
+      result += out.Contains(plat[i], plon[i]) == c;
+      if (inside[i] >= 0)
+        result += c != bool(inside[i]);
+    }
+  }
+  {
+    // Counter-clockwise around an L
+    const T llat[] = {10, 10, 11, 11, 12, 12},
+      llon[] = {20, 22, 22, 21, 21, 20},
+      plat[] = {T(10.5), T(10.5), T(11.5), T(11.5), T(9.5), T(10.5)},
+      plon[] = {T(20.5), T(21.5), T(20.5), T(21.5), T(21), T(19.5)};
+    const bool inside[] = {true, true, true, false, false, false};
+    PolygonIndex poly(g, 6, llat, llon);
+    for (int i = 0; i < 6; ++i)
+      result += poly.Contains(plat[i], plon[i]) != inside[i];
+    result += poly.NorthPoleInside() || poly.NumberEdges() != 6;
+  }
+  return result;
+}
+
+static int PolylineDistanceTest() {
+  // Check PolylineDistance against the minimum distance to points sampled
+  // every 1 km along the route.  The closest point is either a vertex or a
+  // point where the azimuth to the point is perpendicular to the segment.
+  const Geodesic& g = Geodesic::WGS84();
+  const T lat[] = {T(40.6), T(51.5), T(64.1), T(35.7), T(-33.9), T(1.4)},
+    lon[] = {T(-73.8), T(-0.5), T(-21.9), T(139.8), T(18.6), T(103.9)};
+  const int nv = 6;
+  PolylineDistance route(g, nv, lat, lon);
+  vector<T> slat, slon;
+  for (int i = 0; i + 1 < nv; ++i) {
+    const GeodesicLine& l = route.Line(i);
+    int m = int(ceil(l.Distance() / 1000));
+    for (int j = 0; j <= m; ++j) {
+      T la, lo;
+      l.Position(l.Distance() * j / m, la, lo);
+      slat.push_back(la); slon.push_back(lo);
+    }
+  }
+  int result = 0;
+  const int k = 50;
+  vector<T> plat(k), plon(k), dist(k);
+  vector<int> seg(k);
+  for (int i = 0; i < k; ++i) {
+    plat[i] = -60 + T(121 * i % 150);
+    plon[i] = -180 + T(7.3) * i;
+  }
+  route.Distance(k, plat.data(), plon.data(), dist.data(), seg.data(),
+                 nullptr, 3);
+  for (int i = 0; i < k; ++i) {
+    int sg; T s, latc, lonc, s12, azi1, azi2;
+    T d = route.Distance(plat[i], plon[i], sg, s, latc, lonc);
+    result += d != dist[i] || sg != seg[i];
+    T dmin = Math::infinity();
+    for (size_t j = 0; j < slat.size(); ++j) {
+      g.Inverse(plat[i], plon[i], slat[j], slon[j], s12);
+      dmin = fmin(dmin, s12);
+    }
+    // The sampling is 1 km, so dmin exceeds d by at most 125 km^2 / d.
+    result += !(d <= dmin + T(1e-6) && d >= dmin - T(125e3) / d - 1);
+    g.Inverse(plat[i], plon[i], latc, lonc, s12);
+    result += checkEquals(s12, d, T(1e-6));
+    const GeodesicLine& l = route.Line(sg);
+    if (s > 0 && s < l.Distance()) {
+      T la, lo;
+      l.Position(s, la, lo, azi1);
+      g.Inverse(latc, lonc, plat[i], plon[i], s12, azi2, la);
+      result += checkEquals(fabs(Math::AngDiff(azi1, azi2)), T(90), T(1e-6));
+    }
+  }
+  return result;
+}
+
 int main() {
   int n = 0, i;
 
@@ -202,6 +541,38 @@ int main() {
   if (i)
     cout << "Planimeter29 failure\n";
 
+  i = PlanimeterMerge(); n += i;
+  if (i)
+    cout << "PlanimeterMerge failure\n";
+
+  i = PlanimeterMany(Geodesic::WGS84()); n += i;
+  if (i)
+    cout << "PlanimeterMany failure\n";
+
+  i = PlanimeterMany(Rhumb::WGS84()); n += i;
+  if (i)
+    cout << "PlanimeterMany (rhumb) failure\n";
+
+  i = PlanimeterTestPoints(); n += i;
+  if (i)
+    cout << "PlanimeterTestPoints failure\n";
+
+  i = PlanimeterWindow(); n += i;
+  if (i)
+    cout << "PlanimeterWindow failure\n";
+
+  i = PlanimeterEdit(); n += i;
+  if (i)
+    cout << "PlanimeterEdit failure\n";
+
+  i = PlanimeterIndex(); n += i;
+  if (i)
+    cout << "PlanimeterIndex failure\n";
+
+  i = PolylineDistanceTest(); n += i;
+  if (i)
+    cout << "PolylineDistance failure\n";
+
   if (n) {
     cout << n << " failure" << (n > 1 ? "s" : "") << "\n";
     return 1;
@@ -7,17 +7,64 @@
  * https://geographiclib.sourceforge.io/
  **********************************************************************/
 
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 #include <GeographicLib/Math.hpp>
 #include <GeographicLib/Utility.hpp>
+#include <GeographicLib/Accumulator.hpp>
+#include <GeographicLib/AuxLatitude.hpp>
 #include <GeographicLib/DMS.hpp>
+#include <GeographicLib/Densifier.hpp>
 #include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/GeodesicCache.hpp>
+#include <GeographicLib/IntersectCache.hpp>
+#include <GeographicLib/GeodesicFan.hpp>
+#include <GeographicLib/CompactGeodesicLine.hpp>
 #include <GeographicLib/GeodesicExact.hpp>
+#include <GeographicLib/GeodesicKernel.hpp>
+#include <GeographicLib/GeodesicLine.hpp>
+#include <GeographicLib/GeodesicOrigin.hpp>
+#include <GeographicLib/GeodesicTrack.hpp>
 #include <GeographicLib/UTMUPS.hpp>
+#include <GeographicLib/TransverseMercator.hpp>
+#include <GeographicLib/TransverseMercatorExact.hpp>
+#include <GeographicLib/EllipticFunction.hpp>
+#include <GeographicLib/Ellipsoid.hpp>
+#include <GeographicLib/Executor.hpp>
 #include <GeographicLib/MGRS.hpp>
+#include <GeographicLib/MGRSCache.hpp>
+#include <GeographicLib/OSGB.hpp>
+#include <GeographicLib/NormalGravity.hpp>
+#include <GeographicLib/Geohash.hpp>
+#include <GeographicLib/GARS.hpp>
+#include <GeographicLib/Georef.hpp>
+#include <GeographicLib/GeoCell.hpp>
+#include <GeographicLib/Geoid.hpp>
+#include <GeographicLib/NearestNeighbor.hpp>
 #include <GeographicLib/PolygonArea.hpp>
+#include <GeographicLib/Geocentric.hpp>
+#include <GeographicLib/LocalCartesian.hpp>
+#include <GeographicLib/PolarStereographic.hpp>
+#include <GeographicLib/LambertConformalConic.hpp>
+#include <GeographicLib/AlbersEqualArea.hpp>
+#include <GeographicLib/Registry.hpp>
+#include <GeographicLib/Rhumb.hpp>
+#include <GeographicLib/SphericalEngine.hpp>
+#include <GeographicLib/AzimuthalEquidistant.hpp>
+#include <GeographicLib/CassiniSoldner.hpp>
+#include <GeographicLib/Gnomonic.hpp>
+#include <GeographicLib/JacobiConformal.hpp>
+#include <GeographicLib/TriaxialGeodesic.hpp>
 
 // On Centos 7, remquo(810.0, 90.0 &q) returns 90.0 with q=8.  Rather than
 // lousing up Math.cpp with this problem we just skip the failing tests.
@@ -98,6 +145,59 @@ static int checkEquals(T x, T y, T d) {
     }                                              \
   } while (false)
 
+// A Geoid::Source holding the data file in memory; reads counts the calls
+// to Read.
+class MemorySource : public Geoid::Source {
+private:
+  string _data;
+  int* _reads;
+public:
+  MemorySource(const string& data, int* reads = nullptr)
+    : _data(data), _reads(reads) {}
+  unsigned long long Size() override { return _data.size(); }
+  void Read(unsigned long long offset, size_t n, char buf[]) override {
+    if (!(offset <= _data.size() && n <= _data.size() - offset))
+      throw GeographicErr("Read beyond the end of the data");
+    memcpy(buf, _data.data() + offset, n);
+    if (_reads) ++*_reads;
+  }
+};
+
+// A synthetic geoid in PGM format with a 0.5 degree grid (720 x 361 pixels,
+// so that it spans several tiles); pixel (ix, iy) is at longitude ix/2 and
+// latitude 90 - iy/2.  The offset and scale are exact in any precision.  The
+// pixels are also returned in pix.
+static string synthgeoid(vector<unsigned>& pix, T& offset, T& scale) {
+  const int nx = 720, ny = 361, w = GEOGRAPHICLIB_GEOID_PGM_PIXEL_WIDTH;
+  const unsigned maxval = w == 4 ? 0xffffffffu : 0xffffu;
+  offset = -128; scale = w == 4 ? 1 / T(1 << 24) : 1 / T(1 << 8);
+  string data = string("P5\n# Description Synthetic geoid\n# Offset -128\n") +
+    "# Scale " + (w == 4 ? "5.9604644775390625e-08" : "0.00390625") +
+    "\n720 361\n" + (w == 4 ? "4294967295" : "65535") + "\n";
+  pix.resize(size_t(nx) * ny);
+  for (int iy = 0; iy < ny; ++iy)
+    for (int ix = 0; ix < nx; ++ix) {
+      double lat = (90 - iy / 2.0) * Math::pi<double>() / 180,
+        lon = ix / 2.0 * Math::pi<double>() / 180,
+        f = 0.5 + 0.3 * std::sin(3 * lat) * std::cos(2 * lon) +
+        0.1 * std::cos(lat) * std::sin(5 * lon + 1) +
+        0.01 * ((7 * ix + 13 * iy) % 17) / 17.0;
+      unsigned v = unsigned(f * maxval);
+      pix[size_t(iy) * nx + ix] = v;
+      for (int k = w - 1; k >= 0; --k)
+        data += char((v >> (8 * k)) & 0xffu);
+    }
+  return data;
+}
+
+// The Manhattan distance between points of an integer grid; this is a
+// metric whose values are exact, so that NearestNeighbor can be checked
+// against a brute force search.
+struct GridDist {
+  int operator()(const pair<int, int>& a, const pair<int, int>& b) const
+  { return abs(a.first - b.first) + abs(a.second - b.second); }
+};
+
 int main() {
   T inf = Math::infinity(),
     nan = Math::NaN(),
@@ -545,6 +645,88 @@ int main() {
     }
   }
 
+  {
+    // Check the batch GeodesicKernel functions against Geodesic::GenDirect
+    // and Geodesic::GenInverse for oblate and prolate ellipsoids (|f| > 1/100
+    // uses the Newton correction in the direct problem) and a reduced order.
+    // Geodesic calls the same functions, so the results are identical.  The
+    // cases include coincident, meridional, equatorial, polar, and nearly
+    // antipodal points.
+    const T ta[][4] = {
+      {0, 0, 0, 0}, {20, 30, 20, 30}, {-30, 10, 40, 10}, {90, 0, -90, 0},
+      {0, 0, 0, 180}, {0, 0, T(0.5), T(179.5)}, {-T(0.5), 0, T(0.5), T(179.7)},
+      {0, -10, 0, 60}, {45, 170, -45, -170}, {-90, 0, 10, 20},
+    };
+    const size_t m = sizeof(ta) / sizeof(ta[0]) + 40;
+    vector<T> lat1(m), lon1(m), lat2(m), lon2(m), azi(m), s(m), sa(m),
+      lat3(m), lon3(m), azi3(m), azi4(m), s3(m), mm(m), MM(m), MM2(m),
+      SS(m), a(m);
+    for (size_t i = 0; i < m; ++i) {
+      if (i < m - 40) {
+        lat1[i] = ta[i][0]; lon1[i] = ta[i][1];
+        lat2[i] = ta[i][2]; lon2[i] = ta[i][3];
+      } else {
+        lat1[i] = T(int(37 * i % 181)) - 90;
+        lon1[i] = T(int(53 * i % 361)) - 180;
+        lat2[i] = T(int(61 * i % 181)) - 90 + T(0.3);
+        lon2[i] = T(int(71 * i % 359)) - 179;
+      }
+      azi[i] = T(int(43 * i % 361)) - 180;
+      s[i] = T(int(97 * i % 400)) * 50000 - 10000000;
+      sa[i] = s[i] / 100000;    // arc lengths in (-100, 100)
+    }
+    const unsigned all = Geodesic::ALL;
+    int k = 0;
+    for (int e = 0; e < 4; ++e) {
+      const Geodesic g = e == 0 ? Geodesic(Constants::WGS84_a(),
+                                           Constants::WGS84_f()) :
+        e == 1 ? Geodesic(T(6.4e6), T(1)/10) :
+        e == 2 ? Geodesic(T(6.4e6), -T(1)/10) :
+        Geodesic(Constants::WGS84_a(), Constants::WGS84_f(), false, 3);
+      const GeodesicCoeffs c = GeodesicKernel::Coefficients(g);
+      GeodesicKernel::GenInverse(c, m, lat1.data(), lon1.data(),
+                                 lat2.data(), lon2.data(), all,
+                                 s3.data(), azi4.data(), azi3.data(),
+                                 mm.data(), MM.data(), MM2.data(), SS.data(),
+                                 a.data());
+      for (size_t i = 0; i < m; ++i) {
+        T s12, azi1, azi2, m12, M12, M21, S12,
+          a12 = g.GenInverse(lat1[i], lon1[i], lat2[i], lon2[i], all,
+                             s12, azi1, azi2, m12, M12, M21, S12);
+        k += equiv(s3[i], s12) + equiv(azi4[i], azi1) +
+          equiv(azi3[i], azi2) + equiv(mm[i], m12) + equiv(MM[i], M12) +
+          equiv(MM2[i], M21) + equiv(SS[i], S12) + equiv(a[i], a12);
+      }
+      for (int arcmode = 0; arcmode < 2; ++arcmode) {
+        unsigned outmask = all |
+          (arcmode ? unsigned(Geodesic::LONG_UNROLL) : 0U);
+        const vector<T>& s12_a12 = arcmode ? sa : s;
+        GeodesicKernel::GenDirect(c, m, lat1.data(), lon1.data(), azi.data(),
+                                  arcmode != 0, s12_a12.data(), outmask,
+                                  lat3.data(), lon3.data(), azi3.data(),
+                                  s3.data(), mm.data(), MM.data(),
+                                  MM2.data(), SS.data(), a.data());
+        for (size_t i = 0; i < m; ++i) {
+          T lat, lon, azi2, s12, m12, M12, M21, S12,
+            a12 = g.GenDirect(lat1[i], lon1[i], azi[i], arcmode != 0,
+                              s12_a12[i], outmask, lat, lon, azi2,
+                              s12, m12, M12, M21, S12);
+          k += equiv(lat3[i], lat) + equiv(lon3[i], lon) +
+            equiv(azi3[i], azi2) + equiv(s3[i], s12) + equiv(mm[i], m12) +
+            equiv(MM[i], M12) + equiv(MM2[i], M21) + equiv(SS[i], S12) +
+            equiv(a[i], a12);
+        }
+      }
+    }
+    try {
+      GeodesicKernel::Coefficients(Geodesic(T(6.4e6), T(1)/10, true)); ++k;
+    } catch (const GeographicErr&) {}
+    if (k) {
+      cout << "Line " << __LINE__ << ": GeodesicKernel fail\n";
+      ++n;
+    }
+  }
+
   {
     // lat = +/-0 in UTMUPS::Forward
     // lat y northp
@@ -595,6 +777,1910 @@ int main() {
     }
   }
 
+  {
+    // Check that the array versions of the angle functions treat the special
+    // values the same as the scalar versions.
+    const int m = 20;
+    T x[m] = { -inf, -T(810), -T(540), -T(360), -T(180), -T(90), -T(0),
+               +T(0), +T(90), +T(180), +T(270), +T(360), +T(540), +inf, nan,
+               -T(1)/3, T(30), -T(135), T(123456789), eps/1000 },
+      y[m], s[m], c[m], d[m], e[m];
+    for (int k = 0; k < m; ++k) y[k] = x[(7 * k + 3) % m];
+    Math::sincosd(m, x, s, c);
+    for (int k = 0; k < m; ++k) {
+      T sx, cx;
+      Math::sincosd(x[k], sx, cx);
+      if (equiv(s[k], sx) || equiv(c[k], cx)) {
+        cout << "Line " << __LINE__ << ": array sincosd(" << x[k]
+             << ") fail\n";
+        ++n;
+      }
+    }
+    Math::atan2d(m, y, x, d);
+    for (int k = 0; k < m; ++k)
+      if (equiv(d[k], Math::atan2d(y[k], x[k]))) {
+        cout << "Line " << __LINE__ << ": array atan2d(" << y[k] << ", "
+             << x[k] << ") fail\n";
+        ++n;
+      }
+    Math::AngNormalize(m, x, d);
+    for (int k = 0; k < m; ++k)
+      if (equiv(d[k], Math::AngNormalize(x[k]))) {
+        cout << "Line " << __LINE__ << ": array AngNormalize(" << x[k]
+             << ") fail\n";
+        ++n;
+      }
+    Math::AngDiff(m, x, y, d, e);
+    for (int k = 0; k < m; ++k) {
+      T ek, dk = Math::AngDiff(x[k], y[k], ek);
+      if (equiv(d[k], dk) || equiv(e[k], ek)) {
+        cout << "Line " << __LINE__ << ": array AngDiff(" << x[k] << ", "
+             << y[k] << ") fail\n";
+        ++n;
+      }
+    }
+    T es = T(0.08);
+    Math::tauf(m, x, es, d);
+    for (int k = 0; k < m; ++k)
+      if (equiv(d[k], Math::tauf(x[k], es))) {
+        cout << "Line " << __LINE__ << ": array tauf(" << x[k]
+             << ") fail\n";
+        ++n;
+      }
+  }
+
+  {
+    // Check that the array versions of TransverseMercator::Forward and
+    // Reverse agree with the scalar versions, including at the poles, on
+    // the equator, and on the backside of the projection.
+    const TransverseMercator& tm = TransverseMercator::UTM();
+    const int m = 3000;
+    vector<T> lat(m), lon(m), x(m), y(m), gam(m), k(m),
+      lat1(m), lon1(m), gam1(m), k1(m);
+    for (int i = 0; i < m; ++i) {
+      lat[i] = i % 7 == 0 ? T(90 * (i % 3 - 1)) : T((i * 37) % 181 - 90);
+      lon[i] = T((i * 53) % 361 - 180) + (i % 5 == 0 ? -T(0) : T(i % 4) / 3);
+    }
+    tm.Forward(T(3), m, lat.data(), lon.data(), x.data(), y.data(),
+               gam.data(), k.data(), 3);
+    tm.Reverse(T(3), m, x.data(), y.data(), lat1.data(), lon1.data(),
+               gam1.data(), k1.data(), 3);
+    for (int i = 0; i < m; ++i) {
+      T xs, ys, gs, ks, lats, lons;
+      tm.Forward(T(3), lat[i], lon[i], xs, ys, gs, ks);
+      if (equiv(x[i], xs) || equiv(y[i], ys) ||
+          equiv(gam[i], gs) || equiv(k[i], ks)) {
+        cout << "Line " << __LINE__ << ": array TM Forward(" << lat[i]
+             << ", " << lon[i] << ") fail\n";
+        ++n;
+      }
+      tm.Reverse(T(3), xs, ys, lats, lons, gs, ks);
+      if (equiv(lat1[i], lats) || equiv(lon1[i], lons) ||
+          equiv(gam1[i], gs) || equiv(k1[i], ks)) {
+        cout << "Line " << __LINE__ << ": array TM Reverse(" << xs
+             << ", " << ys << ") fail\n";
+        ++n;
+      }
+    }
+  }
+
+  {
+    // Check that TransverseMercatorExact with a Hint agrees with the plain
+    // projection for a sequence of nearby points and that the hint reduces
+    // the number of iterations.  The number of iterations depends on the
+    // precision, so compare with the number used with an empty Hint.
+    const TransverseMercatorExact& tm = TransverseMercatorExact::UTM();
+    TransverseMercatorExact::Hint hf, hr;
+    int maxit = 0, minit0 = numeric_limits<int>::max();
+    for (int i = 0; i < 100; ++i) {
+      T lat = T(-30) + T(i) / 200, lon = T(2) + T(i) / 400,
+        x, y, gam, k, x1, y1, gam1, k1;
+      tm.Forward(T(3), lat, lon, x, y, gam, k);
+      tm.Forward(T(3), lat, lon, x1, y1, gam1, k1, hf);
+      if (i) maxit = max(maxit, hf.Iterations());
+      {
+        TransverseMercatorExact::Hint h0;
+        T x0, y0, gam0, k0;
+        tm.Forward(T(3), lat, lon, x0, y0, gam0, k0, h0);
+        minit0 = min(minit0, h0.Iterations());
+      }
+      if (checkEquals(x1, x, T(1e-8)) + checkEquals(y1, y, T(1e-8)) +
+          checkEquals(gam1, gam, T(1e-12)) + checkEquals(k1, k, T(1e-14))) {
+        cout << "Line " << __LINE__ << ": TM exact Forward with hint ("
+             << lat << ", " << lon << ") fail\n";
+        ++n;
+      }
+      tm.Reverse(T(3), x, y, lat, lon, gam, k);
+      tm.Reverse(T(3), x, y, x1, y1, gam1, k1, hr);
+      if (i) maxit = max(maxit, hr.Iterations());
+      {
+        TransverseMercatorExact::Hint h0;
+        T lat0, lon0, gam0, k0;
+        tm.Reverse(T(3), x, y, lat0, lon0, gam0, k0, h0);
+        minit0 = min(minit0, h0.Iterations());
+      }
+      if (checkEquals(x1, lat, T(1e-13)) + checkEquals(y1, lon, T(1e-13)) +
+          checkEquals(gam1, gam, T(1e-12)) + checkEquals(k1, k, T(1e-14))) {
+        cout << "Line " << __LINE__ << ": TM exact Reverse with hint ("
+             << x << ", " << y << ") fail\n";
+        ++n;
+      }
+    }
+    if (!(maxit < minit0)) {
+      cout << "Line " << __LINE__ << ": TM exact hint uses " << maxit
+           << " iterations vs " << minit0 << " without\n";
+      ++n;
+    }
+  }
+
+  {
+    // Check that the array TransverseMercatorExact agrees with the scalar
+    // version and doesn't depend on the number of threads.  Use enough
+    // points for several blocks, including some far from the central
+    // meridian.
+    const TransverseMercatorExact& tm = TransverseMercatorExact::UTM();
+    const size_t m = 2500;
+    vector<T> lat(m), lon(m), x(m), y(m), gam(m), k(m), x3(m), y3(m),
+      lat1(m), lon1(m), lat3(m), lon3(m);
+    for (size_t i = 0; i < m; ++i) {
+      lat[i] = T(-80) + T(i) * T(0.064); lon[i] = T(i % 500) * T(0.1) - 20;
+    }
+    tm.Forward(T(3), m, lat.data(), lon.data(), x.data(), y.data(),
+               gam.data(), k.data());
+    tm.Forward(T(3), m, lat.data(), lon.data(), x3.data(), y3.data(),
+               nullptr, nullptr, 3);
+    tm.Reverse(T(3), m, x.data(), y.data(), lat1.data(), lon1.data());
+    tm.Reverse(T(3), m, x.data(), y.data(), lat3.data(), lon3.data(),
+               nullptr, nullptr, 3);
+    for (size_t i = 0; i < m; ++i) {
+      T x2, y2, gam2, k2, lat2, lon2;
+      tm.Forward(T(3), lat[i], lon[i], x2, y2, gam2, k2);
+      tm.Reverse(T(3), x[i], y[i], lat2, lon2);
+      if (checkEquals(x[i], x2, T(1e-8)) + checkEquals(y[i], y2, T(1e-8)) +
+          checkEquals(gam[i], gam2, T(1e-12)) +
+          checkEquals(k[i], k2, T(1e-14)) +
+          checkEquals(lat1[i], lat2, T(1e-12)) +
+          checkEquals(lon1[i], lon2, T(1e-12)) +
+          equiv(x3[i], x[i]) + equiv(y3[i], y[i]) +
+          equiv(lat3[i], lat1[i]) + equiv(lon3[i], lon1[i])) {
+        cout << "Line " << __LINE__ << ": TM exact array ("
+             << lat[i] << ", " << lon[i] << ") fail\n";
+        ++n;
+        break;
+      }
+    }
+  }
+
+  {
+    // Check that the array UTMUPS::Forward agrees with the scalar version
+    // for points in many zones, in UPS, and with invalid coordinates.
+    vector<T> lat, lon;
+    for (int i = 0; i < 400; ++i) {
+      lat.push_back(T(87) * sin(T(i)) + (i % 7 == 0 ? T(2) : T(0)));
+      lon.push_back(T(179) * cos(T(3) * i));
+    }
+    lat.push_back(Math::NaN<T>()); lon.push_back(T(3));
+    const size_t m = 401;
+    vector<int> zone(m);
+    vector<T> x(m), y(m), gam(m), k(m);
+    bool northp[m];
+    UTMUPS::Forward(m, lat.data(), lon.data(), zone.data(), northp,
+                    x.data(), y.data(), gam.data(), k.data());
+    for (size_t i = 0; i < m; ++i) {
+      int zone1; bool northp1; T x1, y1, gam1, k1;
+      UTMUPS::Forward(lat[i], lon[i], zone1, northp1, x1, y1, gam1, k1);
+      if (zone1 != zone[i] || northp1 != northp[i] ||
+          equiv(x[i], x1) + equiv(y[i], y1) +
+          equiv(gam[i], gam1) + equiv(k[i], k1)) {
+        cout << "Line " << __LINE__ << ": UTMUPS array Forward ("
+             << lat[i] << ", " << lon[i] << ") fail\n";
+        ++n;
+      }
+    }
+  }
+
+  {
+    // Check that UTMUPS::Transfer between adjacent UTM zones agrees with
+    // Reverse followed by Forward and that the array version agrees with
+    // the scalar one.
+    const size_t m = 200;
+    vector<int> zin(m), zout(m);
+    vector<T> xin(m), yin(m), xout(m), yout(m);
+    bool nin[m];
+    for (size_t i = 0; i < m; ++i) {
+      T lat = T(79) * sin(T(i)), lon = T(3) + T(4) * cos(T(3) * i);
+      UTMUPS::Forward(lat, lon, zin[i], nin[i], xin[i], yin[i]);
+      int zone1, zoneout = zin[i] % 60 + 1; bool northp1;
+      T x1, y1, x2 = 0, y2 = 0, lat1, lon1;
+      bool ok1 = true, ok2 = true;
+      try {
+        UTMUPS::Transfer(zin[i], nin[i], xin[i], yin[i], zoneout, true,
+                         x1, y1, zone1);
+      }
+      catch (const exception&) {
+        ok1 = false;
+      }
+      try {
+        UTMUPS::Reverse(zin[i], nin[i], xin[i], yin[i], lat1, lon1);
+        UTMUPS::Forward(lat1, lon1, zone1, northp1, x2, y2, zoneout);
+        if (!northp1) y2 -= 10000000;
+      }
+      catch (const exception&) {
+        ok2 = false;
+      }
+      if (ok1 != ok2 ||
+          (ok1 && !(fabs(x1 - x2) < T(1e-8) && fabs(y1 - y2) < T(1e-8)))) {
+        cout << "Line " << __LINE__ << ": UTMUPS::Transfer("
+             << lat << ", " << lon << ") fail\n";
+        ++n;
+      }
+    }
+    UTMUPS::Transfer(m, zin.data(), nin, xin.data(), yin.data(), 31, false,
+                     xout.data(), yout.data(), zout.data());
+    for (size_t i = 0; i < m; ++i) {
+      T x1, y1; int zone1;
+      UTMUPS::Transfer(zin[i], nin[i], xin[i], yin[i], 31, false,
+                       x1, y1, zone1);
+      if (zone1 != zout[i] || equiv(x1, xout[i]) + equiv(y1, yout[i])) {
+        cout << "Line " << __LINE__ << ": UTMUPS array Transfer fail\n";
+        ++n;
+      }
+    }
+  }
+
+  {
+    // Check that the char array versions of MGRS::Forward and
+    // MGRS::Reverse agree with the std::string versions.
+    const size_t m = 6, w = 20;
+    int zone[m] = {38, 38, 0, 0, 1, UTMUPS::INVALID}, zone1[m], prec1[m];
+    bool northp[m] = {true, false, true, false, false, true}, northp1[m];
+    T x[m] = {T(444140.6), T(500000), T(2000000), T(1500000), T(123456.7),
+              Math::NaN<T>()},
+      y[m] = {T(3684706.3), T(1e7 - 1), T(1876543.2), T(2100000), T(4e6), 0},
+      x1[m], y1[m];
+    char buf[m * w];
+    MGRS::Forward(m, zone, northp, x, y, 5, buf, w);
+    MGRS::Reverse(m, buf, w, zone1, northp1, x1, y1, prec1);
+    for (size_t i = 0; i < m; ++i) {
+      string mgrs; int zone2, prec2; bool northp2; T x2, y2;
+      MGRS::Forward(zone[i], northp[i], x[i], y[i], 5, mgrs);
+      MGRS::Reverse(mgrs, zone2, northp2, x2, y2, prec2);
+      if (mgrs != string(buf + i * w) || zone1[i] != zone2 ||
+          northp1[i] != northp2 || equiv(x1[i], x2) + equiv(y1[i], y2) ||
+          prec1[i] != prec2) {
+        cout << "Line " << __LINE__ << ": MGRS array conversion " << mgrs
+             << " fail\n";
+        ++n;
+      }
+    }
+  }
+
+  {
+    // Check that MGRS::Decode agrees with MGRS::Reverse and that MGRSCache
+    // agrees with MGRS::Reverse followed by UTMUPS::Reverse.
+    const size_t m = 8, w = 24;
+    const char* mgrs[m] = {"38SMB4488", "38smb4488", "38SMB", "31V", "ZGC12",
+                           "BAN0123456789", "INV", "38SMB4488"};
+    char buf[m * w];
+    for (size_t i = 0; i < m; ++i)
+      strncpy(buf + i * w, mgrs[i], w);
+    int zone[m], prec[m];
+    bool northp[m];
+    long long ix[m], iy[m];
+    MGRS::Decode(m, buf, w, zone, northp, ix, iy, prec);
+    MGRSCache cache(4);
+    T lat[m], lon[m];
+    int prec1[m];
+    cache.Reverse(m, buf, w, lat, lon, prec1);
+    for (size_t i = 0; i < m; ++i) {
+      int zone2, prec2; bool northp2; T x2, y2, lat2, lon2, s = 100000;
+      MGRS::Reverse(mgrs[i], zone2, northp2, x2, y2, prec2, false);
+      UTMUPS::Reverse(zone2, northp2, x2, y2, lat2, lon2);
+      for (int j = 0; j < prec2; ++j) s /= 10;
+      if (zone[i] != zone2 || northp[i] != northp2 || prec[i] != prec2 ||
+          (prec2 >= -1 &&
+           equiv(T(ix[i]) * s, x2) + equiv(T(iy[i]) * s, y2))) {
+        cout << "Line " << __LINE__ << ": MGRS::Decode " << mgrs[i]
+             << " fail\n";
+        ++n;
+      }
+      MGRS::Reverse(mgrs[i], zone2, northp2, x2, y2, prec2);
+      UTMUPS::Reverse(zone2, northp2, x2, y2, lat2, lon2);
+      if (equiv(lat[i], lat2) + equiv(lon[i], lon2) || prec1[i] != prec2) {
+        cout << "Line " << __LINE__ << ": MGRSCache " << mgrs[i]
+             << " fail\n";
+        ++n;
+      }
+    }
+    // The second string is the same square as the first; the first square
+    // was evicted before the last.
+    if (!(cache.Hits() == 1 && cache.Misses() == 6 && cache.Size() == 4)) {
+      cout << "Line " << __LINE__ << ": MGRSCache statistics fail\n";
+      ++n;
+    }
+  }
+
+  {
+    // Check that the array versions of OSGB::Forward, OSGB::Reverse, and
+    // OSGB::GridReference agree with the scalar versions.
+    const size_t m = 5, w = 16;
+    T lat[m] = {T(52.5), T(49.9), T(60.8), T(55.123456), Math::NaN<T>()},
+      lon[m] = {T(-1.5), T(-6.3), T(-0.8), T(-4.987654), T(-2)},
+      x[m], y[m], gam[m], k[m], lat1[m], lon1[m], gam1[m], k1[m];
+    char buf[m * w];
+    for (int nthreads : {1, 3}) {
+      OSGB::Forward(m, lat, lon, x, y, gam, k, nthreads);
+      OSGB::Reverse(m, x, y, lat1, lon1, gam1, k1, nthreads);
+      OSGB::GridReference(m, x, y, 6, buf, w);
+      for (size_t i = 0; i < m; ++i) {
+        T x2, y2, gam2, k2, lat2, lon2, gam3, k3;
+        string gridref;
+        OSGB::Forward(lat[i], lon[i], x2, y2, gam2, k2);
+        OSGB::Reverse(x2, y2, lat2, lon2, gam3, k3);
+        OSGB::GridReference(x2, y2, 6, gridref);
+        if (equiv(x[i], x2) + equiv(y[i], y2) +
+            equiv(gam[i], gam2) + equiv(k[i], k2) +
+            equiv(lat1[i], lat2) + equiv(lon1[i], lon2) +
+            equiv(gam1[i], gam3) + equiv(k1[i], k3) ||
+            gridref != string(buf + i * w)) {
+          cout << "Line " << __LINE__ << ": OSGB array conversion "
+               << gridref << " fail\n";
+          ++n;
+        }
+      }
+    }
+    try {
+      OSGB::GridReference(m, x, y, 7, buf, w); ++n;
+      cout << "Line " << __LINE__ << ": OSGB width check fail\n";
+    } catch (const GeographicErr&) {}
+  }
+
+  {
+    // Check that the char array and integer versions of Geohash, GARS, and
+    // Georef agree with the std::string versions.
+    const size_t m = 5, w = 32;
+    T lat[m] = {T(33.3), T(-90), T(90), T(-12.3456789), Math::NaN<T>()},
+      lon[m] = {T(44.4), T(-180), T(180), T(179.999999), T(3)},
+      lat1[m], lon1[m];
+    char buf[m * w];
+    int prec1[m];
+    unsigned long long key[m];
+    for (int prec = 0; prec <= 18; ++prec) {
+      Geohash::Forward(m, lat, lon, prec, buf, w);
+      Geohash::Reverse(m, buf, w, lat1, lon1, prec1);
+      Geohash::Key(m, lat, lon, prec, key);
+      for (size_t i = 0; i < m; ++i) {
+        string s; T lat2, lon2, lat3, lon3; int prec2 = -1;
+        Geohash::Forward(lat[i], lon[i], prec, s);
+        Geohash::Reverse(s, lat2, lon2, prec2);
+        lat3 = lat2; lon3 = lon2;
+        if (prec <= Geohash::MAXKEYLEN)
+          Geohash::Reverse(key[i], prec, lat3, lon3);
+        if (s != string(buf + i * w) ||
+            equiv(lat1[i], lat2) + equiv(lon1[i], lon2) +
+            equiv(lat3, lat2) + equiv(lon3, lon2) ||
+            (prec2 >= 0 && prec1[i] != prec2)) {
+          cout << "Line " << __LINE__ << ": Geohash array conversion " << s
+               << " fail\n";
+          ++n;
+        }
+      }
+    }
+    for (int prec = -1; prec <= 11; ++prec) {
+      for (int k = 0; k < 2; ++k) {
+        if (k == 0 && prec > 2) continue;
+        if (k == 0) {
+          GARS::Forward(m, lat, lon, prec, buf, w);
+          GARS::Reverse(m, buf, w, lat1, lon1, prec1);
+        } else {
+          Georef::Forward(m, lat, lon, prec, buf, w);
+          Georef::Reverse(m, buf, w, lat1, lon1, prec1);
+        }
+        for (size_t i = 0; i < m; ++i) {
+          string s; T lat2, lon2; int prec2 = -2;
+          if (k == 0) {
+            GARS::Forward(lat[i], lon[i], prec, s);
+            GARS::Reverse(s, lat2, lon2, prec2);
+          } else {
+            Georef::Forward(lat[i], lon[i], prec, s);
+            Georef::Reverse(s, lat2, lon2, prec2);
+          }
+          if (s != string(buf + i * w) ||
+              equiv(lat1[i], lat2) + equiv(lon1[i], lon2) ||
+              (prec2 >= -1 && prec1[i] != prec2)) {
+            cout << "Line " << __LINE__ << ": " << (k ? "Georef" : "GARS")
+                 << " array conversion " << s << " fail\n";
+            ++n;
+          }
+        }
+      }
+    }
+  }
+
+  {
+    // Check that the GeoCell identifiers give the same cells as Geohash,
+    // GARS, and Georef and that the hierarchy and neighbors are consistent.
+    const size_t m = 5;
+    T lat[m] = {T(33.3), T(-90), T(90), T(-12.3456789), Math::NaN<T>()},
+      lon[m] = {T(44.4), T(-180), T(180), T(179.999999), T(3)};
+    const GeoCell::scheme S[] = {GeoCell::GEOHASH, GeoCell::GARS,
+                                 GeoCell::GEOREF};
+    const char* const N[] = {"Geohash", "GARS", "Georef"};
+    for (int k = 0; k < 3; ++k) {
+      GeoCell::scheme sc = S[k];
+      for (int prec = GeoCell::MinPrecision(sc);
+           prec <= GeoCell::MaxPrecision(sc); ++prec) {
+        unsigned long long id[m];
+        GeoCell::Forward(sc, m, lat, lon, prec, id);
+        if (id[m-1] != ~0ULL) {
+          cout << "Line " << __LINE__ << ": GeoCell " << N[k]
+               << " NaN fail\n";
+          ++n;
+        }
+        for (size_t i = 0; i + 1 < m; ++i) {
+          string s; T lat1, lon1, lat2, lon2, latres, lonres;
+          int prec1 = -2, prec2 = -2;
+          if (k == 0) {
+            Geohash::Forward(lat[i], lon[i], prec, s);
+            Geohash::Reverse(s, lat2, lon2, prec2, false);
+          } else if (k == 1) {
+            GARS::Forward(lat[i], lon[i], prec, s);
+            GARS::Reverse(s, lat2, lon2, prec2, false);
+          } else {
+            Georef::Forward(lat[i], lon[i], prec, s);
+            Georef::Reverse(s, lat2, lon2, prec2, false);
+          }
+          GeoCell::Reverse(sc, id[i], lat1, lon1, prec1, false);
+          GeoCell::Resolution(sc, prec, latres, lonres);
+          bool top = prec2 == GeoCell::MinPrecision(sc);
+          unsigned long long nbrs[8], first,
+            parent = GeoCell::Parent(sc, id[i]),
+            nchild = GeoCell::Children(sc, parent, first);
+          int nn = GeoCell::Neighbors(sc, id[i], nbrs), bad = 0;
+          for (int j = 0; j < nn; ++j) {
+            unsigned long long nbrs1[8];
+            int nn1 = GeoCell::Neighbors(sc, nbrs[j], nbrs1);
+            if (find(nbrs1, nbrs1 + nn1, id[i]) == nbrs1 + nn1) ++bad;
+          }
+          if (top)
+            bad += parent != ~0ULL;
+          else
+            // The parent is the cell at the next lower precision (skipping
+            // Georef precision 1) and contains this cell.
+            bad += parent != GeoCell::Forward(sc, lat[i], lon[i],
+                                              k == 2 && prec == 2 ? 0 :
+                                              prec - 1) ||
+              !(id[i] >= first && id[i] < first + nchild);
+          if (prec1 != prec2 || GeoCell::Precision(sc, id[i]) != prec2 ||
+              checkEquals(lat1, lat2, T(1e-12)) +
+              checkEquals(lon1, lon2, T(1e-12)) ||
+              (i == 0 && nn != (top && k == 0 ? 0 : 8)) ||
+              (i == 1 && !top && nn != 5) || bad) {
+            cout << "Line " << __LINE__ << ": GeoCell " << N[k]
+                 << " conversion " << s << " fail\n";
+            ++n;
+          }
+          // A box around the point covers the 3 x 3 block of cells
+          if (prec2 != GeoCell::MinPrecision(sc) && i == 0) {
+            vector<unsigned long long> ids;
+            GeoCell::Cover(sc, lat1 - latres/2, lon1 - lonres/2,
+                           lat1 + 3*latres/2, lon1 + 3*lonres/2, prec, ids);
+            vector<unsigned long long> ids1(nbrs, nbrs + nn);
+            ids1.push_back(id[i]);
+            sort(ids1.begin(), ids1.end());
+            if (ids != ids1) {
+              cout << "Line " << __LINE__ << ": GeoCell " << N[k]
+                   << " cover " << s << " fail\n";
+              ++n;
+            }
+          }
+        }
+      }
+      vector<unsigned long long> ids;
+      T latres, lonres;
+      int prec = GeoCell::MinPrecision(sc) + 1;
+      GeoCell::Resolution(sc, prec, latres, lonres);
+      // A box across the antimeridian straddling 2 cells in longitude
+      GeoCell::Cover(sc, -90, 180 - lonres/2, 90, -180 + lonres/2, prec, ids);
+      if (ids.size() != 2 * size_t(round(180/latres)) ||
+          GeoCell::Parent(sc, ~0ULL) != ~0ULL ||
+          GeoCell::Precision(sc, ~0ULL) != GeoCell::MinPrecision(sc) - 1) {
+        cout << "Line " << __LINE__ << ": GeoCell " << N[k]
+             << " global cover fail\n";
+        ++n;
+      }
+    }
+  }
+
+  {
+    // Check that the fast path for plain decimal numbers in DMS::Decode
+    // agrees with the full parser (invoked by appending "d").
+    const char* const C[] = {
+      "-0", "0", "+0", "5.", ".5", "-.5", "0.000000000000001",
+      "123456789012345", "-179.99999999999", "+89.123456789012",
+      "0.1", "-33.3", "1.0000000000001", "12345678901234567.8",
+    };
+    for (const char* c : C) {
+      DMS::flag ind1, ind2;
+      T v1 = DMS::Decode(string(c), ind1),
+        v2 = DMS::Decode(string(c) + "d", ind2);
+      if (equiv(v1, v2) || ind1 != DMS::NONE) {
+        cout << "Line " << __LINE__ << ": DMS::Decode(" << c << ") = "
+             << v1 << " != " << v2 << "\n";
+        ++n;
+      }
+    }
+  }
+
+  {
+    // Check that the tabulated E(phi) agrees with the direct evaluation
+    // to within the stated error.
+    T e2 = T(0.0066943799901413165);
+    for (T k2 : {e2, 1 - e2, T(-0.1)}) {
+      EllipticFunction ell(k2), ellt(k2);
+      ellt.Tabulate();
+      T tol = ellt.TabulationError() * ellt.E() +
+        8 * numeric_limits<T>::epsilon();
+      for (int i = -40; i <= 40; ++i) {
+        T phi = T(i) / 8, sn = sin(phi), cn = cos(phi);
+        if (checkEquals(ellt.E(sn, cn, ellt.Delta(sn, cn)),
+                        ell.E(sn, cn, ell.Delta(sn, cn)), tol)) {
+          cout << "Line " << __LINE__ << ": tabulated E(" << phi
+               << ") fails for k2 = " << k2 << "\n";
+          ++n;
+        }
+      }
+    }
+  }
+
+  {
+    // Check that EllipticFunction::Update agrees with Reset for small
+    // changes in k2 (where a Taylor step is taken) and large ones (where
+    // it's equivalent to Reset).
+    const T eps = numeric_limits<T>::epsilon();
+    int k = 0;
+    for (T a2 : {T(-0.0067394967422764341), T(0), T(0.3)}) {
+      for (T k2 : {T(-0.005), T(-0.2), T(0.6)}) {
+        for (T dk2 : {T(0), T(1e-12), T(-3e-10), T(1e-3)}) {
+          EllipticFunction ell(k2, a2, 1 - k2, 1 - a2),
+            ellu(k2 + dk2, a2, 1 - (k2 + dk2), 1 - a2);
+          ell.Update(k2 + dk2, 1 - (k2 + dk2));
+          const T tol = 8 * eps;
+          k += checkEquals(ell.K() / ellu.K(), 1, tol) +
+            checkEquals(ell.E() / ellu.E(), 1, tol) +
+            checkEquals(ell.D() / ellu.D(), 1, tol) +
+            checkEquals(ell.Pi() / ellu.Pi(), 1, tol) +
+            checkEquals(ell.G() / ellu.G(), 1, tol) +
+            checkEquals(ell.H() / ellu.H(), 1, tol) +
+            equiv(ell.k2(), ellu.k2()) + equiv(ell.alpha2(), ellu.alpha2());
+        }
+      }
+    }
+    if (k) {
+      cout << "Line " << __LINE__ << ": EllipticFunction::Update fail\n";
+      ++n;
+    }
+  }
+
+  {
+    // Check the lazy evaluation of the integrals of the third kind: copies
+    // made before and after they are computed and concurrent first uses
+    // should all give the values for a fresh object.
+    int k = 0;
+    for (T a2 : {T(0), T(-0.3), T(0.6)}) {
+      const EllipticFunction ref(T(0.4), a2);
+      const T pi = ref.Pi(), g = ref.G(), h = ref.H();
+      EllipticFunction ell(T(0.4), a2), before(ell);
+      vector<T> hs(4);
+      Executor::Current().Run(4, [&](int t) -> void { hs[t] = ell.H(); });
+      EllipticFunction after(ell);
+      for (T x : hs) k += equiv(x, h);
+      for (const EllipticFunction* e : {&ell, &before, &after})
+        k += equiv(e->Pi(), pi) + equiv(e->G(), g) + equiv(e->H(), h);
+      before = ref;
+      k += equiv(before.H(), h);
+    }
+    if (k) {
+      cout << "Line " << __LINE__ << ": EllipticFunction lazy fail\n";
+      ++n;
+    }
+  }
+
+  {
+    // Check Utility::readarray and Utility::writearray with both byte
+    // orders against the byte swapping done by Math::swab.
+    vector<unsigned short> p, q;
+    for (int i = 0; i < 3000; ++i)
+      p.push_back((unsigned short)(i * 40503u));
+    unsigned short p1 = Math::swab<unsigned short>(p[1]);
+    for (bool big : {false, true}) {
+      ostringstream out;
+      if (big)
+        Utility::writearray<unsigned short, unsigned short, true>(out, p);
+      else
+        Utility::writearray<unsigned short, unsigned short, false>(out, p);
+      const string bytes = out.str();
+      unsigned short r1;
+      bytes.copy(reinterpret_cast<char*>(&r1), 2, 2);
+      istringstream in(bytes);
+      q.assign(p.size(), 0);
+      // Read back both directly and via a conversion to int
+      vector<int> qi(p.size());
+      if (big) {
+        Utility::readarray<unsigned short, unsigned short, true>(in, q);
+        in.seekg(0);
+        Utility::readarray<unsigned short, int, true>(in, qi);
+      } else {
+        Utility::readarray<unsigned short, unsigned short, false>(in, q);
+        in.seekg(0);
+        Utility::readarray<unsigned short, int, false>(in, qi);
+      }
+      bool swapped = big != Math::bigendian;
+      if (q != p || r1 != (swapped ? p1 : p[1]) ||
+          !equal(qi.begin(), qi.end(), p.begin())) {
+        cout << "Line " << __LINE__ << ": readarray/writearray fails for "
+             << (big ? "big" : "little") << "-endian data\n";
+        ++n;
+      }
+    }
+  }
+
+  {
+    // Check that the array version of AuxLatitude::Convert gives the same
+    // results as the scalar version, including for signed zeros, NaNs, and
+    // latitudes outside [-90, 90].
+    AuxLatitude aux(1, 1/T(298.257223563));
+    vector<T> zeta, eta;
+    for (int i = -200; i <= 200; ++i)
+      zeta.push_back(T(i) + (i % 3 ? T(0.7) : 0));
+    zeta.push_back(-T(0)); zeta.push_back(Math::NaN());
+    eta.resize(zeta.size());
+    for (bool exact : {false, true})
+      for (int auxin = 0; auxin < AuxLatitude::AUXNUMBER; ++auxin)
+        for (int auxout = 0; auxout < AuxLatitude::AUXNUMBER; ++auxout) {
+          aux.Convert(auxin, auxout, zeta.size(), zeta.data(), eta.data(),
+                      exact);
+          for (size_t i = 0; i < zeta.size(); ++i)
+            if (equiv(eta[i], aux.Convert(auxin, auxout, zeta[i], exact))) {
+              cout << "Line " << __LINE__ << ": AuxLatitude::Convert("
+                   << auxin << ", " << auxout << ", " << zeta[i]
+                   << ") array version differs\n";
+              ++n;
+            }
+        }
+  }
+
+  {
+    // Check that the tabulated latitude conversions of Ellipsoid agree with
+    // the direct ones to within the stated error, that the poles and the
+    // equator are exact, and that the array versions match the scalar ones.
+    for (T f : {1/T(298.257223563), T(-0.1)}) {
+      Ellipsoid ell(1, f), ellt(1, f);
+      ellt.Tabulate();
+      T tol = ellt.TabulationError() / Math::degree() +
+        2 * Math::qd * numeric_limits<T>::epsilon();
+      vector<T> phi, mu(1), mut;
+      for (int i = -90; i <= 90; ++i)
+        phi.push_back(T(i) + (i % 2 ? T(0.3) : 0));
+      mut.resize(phi.size());
+      ellt.RectifyingLatitude(phi.size(), phi.data(), mut.data());
+      for (size_t i = 0; i < phi.size(); ++i) {
+        int k = checkEquals(mut[i], ell.RectifyingLatitude(phi[i]), tol) +
+          checkEquals(ellt.InverseRectifyingLatitude(mut[i]), phi[i], tol) +
+          checkEquals(ellt.ConformalLatitude(phi[i]),
+                      ell.ConformalLatitude(phi[i]), tol) +
+          checkEquals(ellt.InverseConformalLatitude(phi[i]),
+                      ell.InverseConformalLatitude(phi[i]), tol) +
+          checkEquals(ellt.AuthalicLatitude(phi[i]),
+                      ell.AuthalicLatitude(phi[i]), tol) +
+          checkEquals(ellt.InverseAuthalicLatitude(phi[i]),
+                      ell.InverseAuthalicLatitude(phi[i]), tol) +
+          equiv(mut[i], ellt.RectifyingLatitude(phi[i]));
+        ell.RectifyingLatitude(1, &phi[i], mu.data());
+        k += equiv(mu[0], ell.RectifyingLatitude(phi[i]));
+        if (k) {
+          cout << "Line " << __LINE__ << ": tabulated latitude " << phi[i]
+               << " fails for f = " << f << "\n";
+          ++n;
+        }
+      }
+      check( ellt.ConformalLatitude(T(90)), 90 );
+      check( ellt.InverseAuthalicLatitude(T(-90)), -90 );
+      check( ellt.RectifyingLatitude(T(-0.0)), -0.0 );
+      check( ellt.InverseRectifyingLatitude(T(0)), 0 );
+    }
+  }
+
+  {
+    // Check the meridian distance and its inverse, scalar and array
+    // versions, with and without the tables.
+    for (bool tab : {false, true}) {
+      Ellipsoid ell(1, 1/T(298.257223563));
+      if (tab) ell.Tabulate();
+      T L = ell.QuarterMeridian(),
+        tol = (tab ? ell.TabulationError() : 0) + 8 *
+        numeric_limits<T>::epsilon();
+      vector<T> s, phi, s2;
+      for (int i = -90; i <= 90; i += 3)
+        s.push_back(L * T(i) / 90 + (i % 2 ? T(0.001) : 0));
+      phi.resize(s.size()); s2.resize(s.size());
+      ell.InverseMeridianDistance(s.size(), s.data(), phi.data());
+      ell.MeridianDistance(phi.size(), phi.data(), s2.data());
+      for (size_t i = 0; i < s.size(); ++i) {
+        if (checkEquals(s2[i], s[i], tol) +
+            equiv(phi[i], ell.InverseMeridianDistance(s[i])) +
+            equiv(s2[i], ell.MeridianDistance(phi[i]))) {
+          cout << "Line " << __LINE__ << ": meridian distance " << s[i]
+               << " fails for tab = " << tab << "\n";
+          ++n;
+        }
+      }
+      check( ell.InverseMeridianDistance(L), 90 );
+      check( ell.InverseMeridianDistance(-L), -90 );
+      if (tab) check( ell.InverseMeridianDistance(T(-0.0)), -0.0 );
+      check( ell.InverseMeridianDistance(2 * L), nan );
+    }
+  }
+
+  {
+    // Check that the array versions of Geocentric::Forward and
+    // Geocentric::Reverse agree with the scalar versions, including points
+    // near the center and the poles.
+    const Geocentric& earth = Geocentric::WGS84();
+    vector<T> lat, lon, h;
+    for (int i = 0; i < 100; ++i) {
+      lat.push_back(T(90) * sin(T(i)));
+      lon.push_back(T(180) * cos(T(3) * i));
+      h.push_back(T(1e4) * i * cos(T(5) * i));
+    }
+    lat.push_back(T(90)); lon.push_back(T(0)); h.push_back(T(10));
+    lat.push_back(T(0)); lon.push_back(T(0)); h.push_back(-T(6378137));
+    const size_t m = lat.size();
+    vector<T> X(m), Y(m), Z(m), M(9 * m), lat1(m), lon1(m), h1(m), M1(9 * m);
+    earth.Forward(m, lat.data(), lon.data(), h.data(),
+                  X.data(), Y.data(), Z.data(), M.data());
+    earth.Reverse(m, X.data(), Y.data(), Z.data(),
+                  lat1.data(), lon1.data(), h1.data(), M1.data());
+    for (size_t i = 0; i < m; ++i) {
+      T X2, Y2, Z2, lat2, lon2, h2;
+      vector<T> M2(9), M3(9);
+      int k = 0;
+      earth.Forward(lat[i], lon[i], h[i], X2, Y2, Z2, M2);
+      earth.Reverse(X[i], Y[i], Z[i], lat2, lon2, h2, M3);
+      k += equiv(X[i], X2) + equiv(Y[i], Y2) + equiv(Z[i], Z2) +
+        equiv(lat1[i], lat2) + equiv(lon1[i], lon2) + equiv(h1[i], h2);
+      for (int j = 0; j < 9; ++j)
+        k += equiv(M[9 * i + j], M2[j]) + equiv(M1[9 * i + j], M3[j]);
+      if (k) {
+        cout << "Line " << __LINE__ << ": Geocentric array ("
+             << lat[i] << ", " << lon[i] << ", " << h[i] << ") fail\n";
+        ++n;
+      }
+    }
+  }
+
+  {
+    // Check that the array versions of LocalCartesian::Forward and
+    // LocalCartesian::Reverse agree with the scalar versions.
+    LocalCartesian proj(T(33), T(44), T(20));
+    const size_t m = 50;
+    T lat[m], lon[m], h[m], x[m], y[m], z[m], M[9 * m],
+      lat1[m], lon1[m], h1[m], M1[9 * m];
+    float xf[m], yf[m], zf[m];
+    for (size_t i = 0; i < m; ++i) {
+      lat[i] = T(33) + sin(T(i)); lon[i] = T(44) + 2 * cos(T(3) * i);
+      h[i] = T(100) * i;
+    }
+    proj.Forward(m, lat, lon, h, x, y, z, M);
+    proj.Forward(m, lat, lon, h, xf, yf, zf);
+    proj.Reverse(m, x, y, z, lat1, lon1, h1, M1);
+    for (size_t i = 0; i < m; ++i) {
+      T x2, y2, z2, lat2, lon2, h2;
+      vector<T> M2(9), M3(9);
+      int k = 0;
+      proj.Forward(lat[i], lon[i], h[i], x2, y2, z2, M2);
+      proj.Reverse(x[i], y[i], z[i], lat2, lon2, h2, M3);
+      k += equiv(x[i], x2) + equiv(y[i], y2) + equiv(z[i], z2) +
+        equiv(lat1[i], lat2) + equiv(lon1[i], lon2) + equiv(h1[i], h2) +
+        (xf[i] == float(x2) && yf[i] == float(y2) && zf[i] == float(z2) ?
+         0 : 1);
+      for (int j = 0; j < 9; ++j)
+        k += equiv(M[9 * i + j], M2[j]) + equiv(M1[9 * i + j], M3[j]);
+      if (k) {
+        cout << "Line " << __LINE__ << ": LocalCartesian array ("
+             << lat[i] << ", " << lon[i] << ", " << h[i] << ") fail\n";
+        ++n;
+      }
+    }
+  }
+
+  {
+    // Check the array version of LocalCartesian::Reverse with the Newton's
+    // method for points near the origin against the scalar version; the
+    // points more than 100 km from the origin use the scalar method.
+    LocalCartesian proj(T(33), T(44), T(20));
+    const size_t m = 50;
+    T lat[m], lon[m], h[m], x[m], y[m], z[m], M[9 * m];
+    for (size_t i = 0; i < m; ++i) {
+      x[i] = T(4000) * i * cos(T(7) * i); y[i] = T(3000) * i * sin(T(i));
+      z[i] = T(100) * i - T(2000);
+    }
+    proj.Reverse(m, x, y, z, lat, lon, h, M, T(300000));
+    T eps = numeric_limits<T>::epsilon(),
+      tdeg = 64 * eps / Math::degree<T>(),
+      tm = 64 * eps * proj.EquatorialRadius();
+    for (size_t i = 0; i < m; ++i) {
+      T lat2, lon2, h2;
+      vector<T> M2(9);
+      proj.Reverse(x[i], y[i], z[i], lat2, lon2, h2, M2);
+      int k = checkEquals(lat[i], lat2, tdeg) +
+        checkEquals(lon[i], lon2, tdeg) + checkEquals(h[i], h2, tm);
+      for (int j = 0; j < 9; ++j)
+        k += checkEquals(M[9 * i + j], M2[j], 16 * eps);
+      if (k) {
+        cout << "Line " << __LINE__ << ": LocalCartesian radius ("
+             << x[i] << ", " << y[i] << ", " << z[i] << ") fail\n";
+        ++n;
+      }
+    }
+  }
+
+  {
+    // Check that the single precision versions of the projections agree
+    // with the Math::real versions to within the expected accuracy.
+    float x, y, gam, k, lat, lon, h;
+    T xt, yt, gamt, kt;
+    PolarStereographicT<float>::UPS().Forward(true, 85.f, 30.f,
+                                              x, y, gam, k);
+    PolarStereographic::UPS().Forward(true, T(85), T(30), xt, yt, gamt, kt);
+    int i = checkEquals(x, xt, T(0.1)) + checkEquals(y, yt, T(0.1)) +
+      checkEquals(k, kt, T(1e-6));
+    LambertConformalConicT<float> lccf(6378137.f, 1/298.257223563f,
+                                       30.f, 40.f, 1.f);
+    LambertConformalConic lcc(T(6378137), 1/T(298.257223563),
+                              T(30), T(40), T(1));
+    lccf.Forward(0.f, 35.f, 3.f, x, y, gam, k);
+    lcc.Forward(T(0), T(35), T(3), xt, yt, gamt, kt);
+    i += checkEquals(x, xt, T(1)) + checkEquals(y, yt, T(1)) +
+      checkEquals(k, kt, T(1e-6));
+    LocalCartesianT<float> lcf(33.f, 44.f);
+    lcf.Forward(33.1f, 44.1f, 10.f, x, y, h);
+    lcf.Reverse(x, y, h, lat, lon, h);
+    i += checkEquals(lat, T(33.1), T(1e-5)) +
+      checkEquals(lon, T(44.1), T(1e-5)) + checkEquals(h, T(10), T(2));
+    if (i) {
+      cout << "Line " << __LINE__ << ": float projections fail\n";
+      ++n;
+    }
+  }
+
+  {
+    // Check that the array versions of RhumbLine::GenPosition and
+    // Rhumb::GenInverse agree with the scalar versions; the line crosses
+    // the pole so some of the results are NaNs.
+    const Rhumb& rh = Rhumb::WGS84();
+    RhumbLine line = rh.Line(T(10), T(20), T(3));
+    const size_t m = 60;
+    T s12[m], lat2[m], lon2[m], S12[m], lat1[m], lon1[m], d12[m], azi12[m],
+      A12[m];
+    for (size_t i = 0; i < m; ++i) {
+      s12[i] = T(2e5) * i - T(1e6);
+      lat1[i] = i < m/2 ? T(10) : T(-30); lon1[i] = T(20);
+    }
+    line.GenPosition(m, s12, Rhumb::ALL, lat2, lon2, S12);
+    rh.GenInverse(m, lat1, lon1, lat2, lon2, Rhumb::ALL, d12, azi12, A12);
+    for (size_t i = 0; i < m; ++i) {
+      T lat2x, lon2x, S12x, d12x, azi12x, A12x;
+      line.GenPosition(s12[i], Rhumb::ALL, lat2x, lon2x, S12x);
+      rh.GenInverse(lat1[i], lon1[i], lat2[i], lon2[i], Rhumb::ALL,
+                    d12x, azi12x, A12x);
+      if (equiv(lat2[i], lat2x) + equiv(lon2[i], lon2x) +
+          equiv(S12[i], S12x) + equiv(d12[i], d12x) +
+          equiv(azi12[i], azi12x) + equiv(A12[i], A12x)) {
+        cout << "Line " << __LINE__ << ": Rhumb array (" << s12[i]
+             << ") fail\n";
+        ++n;
+      }
+    }
+  }
+
+  {
+    // Check that the array versions of the LambertConformalConic and
+    // AlbersEqualArea projections agree with the scalar versions, including
+    // the poles.
+    LambertConformalConic lcc(T(6378137), 1/T(298.257223563),
+                              T(33), T(45), T(1));
+    AlbersEqualArea alb(T(6378137), 1/T(298.257223563),
+                        T(29.5), T(45.5), T(1));
+    const size_t m = 40;
+    T lat[m], lon[m], x[m], y[m], gam[m], k[m],
+      xa[m], ya[m], gama[m], ka[m], lat1[m], lon1[m], lata[m], lona[m];
+    for (size_t i = 0; i < m; ++i) {
+      lat[i] = T(4.5) * i - T(90); lon[i] = T(97) + T(13.5) * i;
+    }
+    lcc.Forward(T(-97), m, lat, lon, x, y, gam, k);
+    alb.Forward(T(-97), m, lat, lon, xa, ya, gama, ka);
+    for (size_t i = 0; i < m; ++i) {
+      T x2, y2, gam2, k2, xa2, ya2, gama2, ka2;
+      lcc.Forward(T(-97), lat[i], lon[i], x2, y2, gam2, k2);
+      alb.Forward(T(-97), lat[i], lon[i], xa2, ya2, gama2, ka2);
+      if (equiv(x[i], x2) + equiv(y[i], y2) + equiv(gam[i], gam2) +
+          equiv(k[i], k2) + equiv(xa[i], xa2) + equiv(ya[i], ya2) +
+          equiv(gama[i], gama2) + equiv(ka[i], ka2)) {
+        cout << "Line " << __LINE__ << ": conic array forward ("
+             << lat[i] << ", " << lon[i] << ") fail\n";
+        ++n;
+      }
+    }
+    lcc.Reverse(T(263), m, x, y, lat1, lon1, gam, k);
+    alb.Reverse(T(263), m, xa, ya, lata, lona);
+    for (size_t i = 0; i < m; ++i) {
+      T lat2, lon2, gam2, k2, lata2, lona2;
+      lcc.Reverse(T(263), x[i], y[i], lat2, lon2, gam2, k2);
+      alb.Reverse(T(263), xa[i], ya[i], lata2, lona2);
+      if (equiv(lat1[i], lat2) + equiv(lon1[i], lon2) + equiv(gam[i], gam2) +
+          equiv(k[i], k2) + equiv(lata[i], lata2) + equiv(lona[i], lona2)) {
+        cout << "Line " << __LINE__ << ": conic array reverse ("
+             << x[i] << ", " << y[i] << ") fail\n";
+        ++n;
+      }
+    }
+  }
+
+  {
+    // Check that the array versions of the PolarStereographic projection
+    // and the array forward CassiniSoldner projection agree with the scalar
+    // versions, including the poles.
+    const PolarStereographic& ups = PolarStereographic::UPS();
+    CassiniSoldner cs(T(40), T(-100));
+    const size_t m = 41;
+    T lat[m], lon[m], x[m], y[m], gam[m], k[m], lat1[m], lon1[m],
+      xc[m], yc[m], azic[m], rkc[m];
+    for (size_t i = 0; i < m; ++i) {
+      lat[i] = T(4.5) * i - T(90); lon[i] = T(13.5) * i - T(180);
+    }
+    for (int northp = 0; northp < 2; ++northp) {
+      ups.Forward(northp != 0, m, lat, lon, x, y, gam, k);
+      ups.Reverse(northp != 0, m, x, y, lat1, lon1);
+      for (size_t i = 0; i < m; ++i) {
+        T x2, y2, gam2, k2, lat2, lon2, gam3, k3;
+        ups.Forward(northp != 0, lat[i], lon[i], x2, y2, gam2, k2);
+        ups.Reverse(northp != 0, x2, y2, lat2, lon2, gam3, k3);
+        if (equiv(x[i], x2) + equiv(y[i], y2) + equiv(gam[i], gam2) +
+            equiv(k[i], k2) + equiv(lat1[i], lat2) + equiv(lon1[i], lon2)) {
+          cout << "Line " << __LINE__ << ": polar stereographic array ("
+               << northp << ", " << lat[i] << ", " << lon[i] << ") fail\n";
+          ++n;
+        }
+      }
+    }
+    cs.Forward(m, lat, lon, xc, yc, azic, rkc);
+    for (size_t i = 0; i < m; ++i) {
+      T x2, y2, azi2, rk2;
+      cs.Forward(lat[i], lon[i], x2, y2, azi2, rk2);
+      if (equiv(xc[i], x2) + equiv(yc[i], y2) + equiv(azic[i], azi2) +
+          equiv(rkc[i], rk2)) {
+        cout << "Line " << __LINE__ << ": cassini array forward ("
+             << lat[i] << ", " << lon[i] << ") fail\n";
+        ++n;
+      }
+    }
+  }
+
+  {
+    // Check that the array versions of the AzimuthalEquidistant, Gnomonic,
+    // and CassiniSoldner projections agree with the scalar versions.  The
+    // points lie on radials (for AzimuthalEquidistant and Gnomonic) and rows
+    // (for CassiniSoldner) so that the reuse of the geodesics is exercised.
+    AzimuthalEquidistant az;
+    Gnomonic gn;
+    CassiniSoldner cs(T(40), T(-100));
+    const size_t m = 48;
+    T x[m], y[m], lat[m], lon[m], azi[m], rk[m], xa[m], ya[m],
+      latg[m], lng[m], azig[m], rkg[m], latc[m], lonc[m], azic[m], rkc[m],
+      xg[m], yg[m], azf[m], rkf[m];
+    for (size_t i = 0; i < m; ++i) {
+      T d = T(2e5) * (i % 8 + 1) - (i == 9 ? 0 : T(1e5));
+      x[i] = d * sin(T(i / 8)); y[i] = d * cos(T(i / 8));
+    }
+    az.Reverse(T(40), T(-100), m, x, y, lat, lon, azi, rk);
+    az.Forward(T(40), T(-100), m, lat, lon, xa, ya);
+    gn.Reverse(T(40), T(-100), m, x, y, latg, lng, azig, rkg);
+    gn.Forward(T(40), T(-100), m, lat, lon, xg, yg, azf, rkf);
+    cs.Reverse(m, x, y, latc, lonc, azic, rkc);
+    for (size_t i = 0; i < m; ++i) {
+      T lat2, lon2, azi2, rk2, x2, y2, azi3, rk3,
+        latg2, lng2, azig2, rkg2, latc2, lonc2, azic2, rkc2,
+        xg2, yg2, azf2, rkf2;
+      az.Reverse(T(40), T(-100), x[i], y[i], lat2, lon2, azi2, rk2);
+      az.Forward(T(40), T(-100), lat[i], lon[i], x2, y2, azi3, rk3);
+      gn.Reverse(T(40), T(-100), x[i], y[i], latg2, lng2, azig2, rkg2);
+      gn.Forward(T(40), T(-100), lat[i], lon[i], xg2, yg2, azf2, rkf2);
+      cs.Reverse(x[i], y[i], latc2, lonc2, azic2, rkc2);
+      if (equiv(lat[i], lat2) + equiv(lon[i], lon2) + equiv(azi[i], azi2) +
+          equiv(rk[i], rk2) + equiv(xa[i], x2) + equiv(ya[i], y2) +
+          equiv(latg[i], latg2) + equiv(lng[i], lng2) +
+          equiv(azig[i], azig2) + equiv(rkg[i], rkg2) +
+          equiv(latc[i], latc2) + equiv(lonc[i], lonc2) +
+          equiv(azic[i], azic2) + equiv(rkc[i], rkc2) +
+          equiv(xg[i], xg2) + equiv(yg[i], yg2) + equiv(azf[i], azf2) +
+          equiv(rkf[i], rkf2)) {
+        cout << "Line " << __LINE__ << ": azimuthal array (" << x[i] << ", "
+             << y[i] << ") fail\n";
+        ++n;
+      }
+    }
+  }
+
+  {
+    // Check that GeodesicOrigin and both versions of Geodesic::DistanceMatrix
+    // agree with Geodesic::Inverse.  The points include the poles, the
+    // equator (with both signs of zero), and pairs with latitudes of equal
+    // magnitude.
+    const Geodesic& g = Geodesic::WGS84();
+    const size_t m = 8;
+    const T lat[m] = {90, -90, 0, -T(0), 45, -45, 30, -30},
+      lon[m] = {0, 10, -T(0), 179, 180, -40, 30, 150};
+    T s12[m * m], azi1[m * m], azi2[m * m], sa[m], aa1[m], aa2[m],
+      ss12[m * m];
+    g.DistanceMatrix(m, lat, lon, m, lat, lon, s12, azi1, azi2, 2);
+    g.DistanceMatrix(m, lat, lon, ss12, 2);
+    for (size_t i = 0; i < m; ++i) {
+      GeodesicOrigin orig = g.InverseFrom(lat[i], lon[i]);
+      orig.GenInverse(m, lat, lon, Geodesic::DISTANCE | Geodesic::AZIMUTH,
+                      sa, aa1, aa2, nullptr, nullptr, nullptr, nullptr);
+      for (size_t j = 0; j < m; ++j) {
+        T s, a1, a2, so, ao1, ao2;
+        g.Inverse(lat[i], lon[i], lat[j], lon[j], s, a1, a2);
+        orig.Inverse(lat[j], lon[j], so, ao1, ao2);
+        size_t k = i * m + j;
+        if (equiv(s12[k], s) + equiv(azi1[k], a1) + equiv(azi2[k], a2) +
+            equiv(sa[j], s) + equiv(aa1[j], a1) + equiv(aa2[j], a2) +
+            equiv(so, s) + equiv(ao1, a1) + equiv(ao2, a2) +
+            equiv(ss12[k], s)) {
+          cout << "Line " << __LINE__ << ": distance matrix (" << lat[i]
+               << ", " << lon[i] << ", " << lat[j] << ", " << lon[j]
+               << ") fail\n";
+          ++n;
+        }
+      }
+    }
+  }
+
+  {
+    // Check that GeodesicTrack agrees with Geodesic::Inverse to round-off on
+    // a track with legs of 100 to 700 km (which crosses the equator and the
+    // antimeridian) followed by a meridional, an equatorial, and a nearly
+    // antipodal leg.  The array version gives the same results as the
+    // scalar one.
+    const Geodesic& g = Geodesic::WGS84();
+    const size_t m = 64;
+    T lat[m], lon[m];
+    {
+      T la = -2, lo = 175, az = 10;
+      for (size_t i = 0; i < m - 4; ++i) {
+        lat[i] = la; lon[i] = lo;
+        g.Direct(la, lo, az, T(100e3) * (i % 7 + 1), la, lo, az);
+        az += T(i % 5) - 2;
+      }
+      lat[m-4] = 10; lon[m-4] = 3;
+      lat[m-3] = 0; lon[m-3] = 3;
+      lat[m-2] = 0; lon[m-2] = 40;
+      lat[m-1] = T(0.5); lon[m-1] = T(-140.5);
+    }
+    GeodesicTrack track(g);
+    T sa[m - 1], aa1[m - 1], aa2[m - 1];
+    track.GenInverse(m, lat, lon, Geodesic::DISTANCE | Geodesic::AZIMUTH,
+                     sa, aa1, aa2, nullptr, nullptr, nullptr, nullptr);
+    track.Reset();
+    for (size_t i = 0; i + 1 < m; ++i) {
+      T s, a1, a2, st, at1, at2;
+      g.Inverse(lat[i], lon[i], lat[i+1], lon[i+1], s, a1, a2);
+      track.Inverse(lat[i], lon[i], lat[i+1], lon[i+1], st, at1, at2);
+      if (!(fabs(st - s) <= T(1e-8) && fabs(at1 - a1) <= T(1e-10) &&
+            fabs(at2 - a2) <= T(1e-10)) ||
+          equiv(sa[i], st) + equiv(aa1[i], at1) + equiv(aa2[i], at2)) {
+        cout << "Line " << __LINE__ << ": GeodesicTrack " << i
+             << " fail\n";
+        ++n;
+      }
+    }
+  }
+
+  {
+    // Check that a GeodesicLine which is reset agrees with a newly
+    // constructed one.
+    const Geodesic& g = Geodesic::WGS84();
+    GeodesicLine line;
+    for (int i = 0; i < 3; ++i) {
+      T lat2, lon2, lat3, lon3;
+      GeodesicLine l;
+      if (i == 0) {
+        l = g.Line(T(40), T(-75), T(30)); line.Reset(g, T(40), T(-75), T(30));
+      } else if (i == 1) {
+        l = g.DirectLine(T(-30), T(10), T(-120), T(5e6));
+        line.ResetDirect(g, T(-30), T(10), T(-120), T(5e6));
+      } else {
+        l = g.InverseLine(T(0), T(0), T(0.5), T(179.5));
+        line.ResetInverse(g, T(0), T(0), T(0.5), T(179.5));
+      }
+      l.Position(T(2e6), lat2, lon2);
+      line.Position(T(2e6), lat3, lon3);
+      if (equiv(lat2, lat3) + equiv(lon2, lon3) +
+          equiv(l.Distance(), line.Distance())) {
+        cout << "Line " << __LINE__ << ": GeodesicLine::Reset " << i
+             << " fail\n";
+        ++n;
+      }
+    }
+  }
+
+  {
+    // Check that CompactGeodesicLine agrees with GeodesicLine.
+    const Geodesic& g = Geodesic::WGS84();
+    const unsigned caps = Geodesic::LONGITUDE | Geodesic::DISTANCE_IN;
+    CompactGeodesicLine<caps> c(g, T(90), T(30), T(0));
+    GeodesicLine l(g, T(90), T(30), T(0), caps);
+    for (int i = -2; i <= 2; ++i) {
+      T lat2, lon2, lat3, lon3;
+      c.Position(T(1e7) * i, lat2, lon2);
+      l.Position(T(1e7) * i, lat3, lon3);
+      if (equiv(lat2, lat3) + equiv(lon2, lon3)) {
+        cout << "Line " << __LINE__ << ": CompactGeodesicLine " << i
+             << " fail\n";
+        ++n;
+      }
+    }
+  }
+
+  {
+    // Check that GeodesicLine::Waypoints and ArcWaypoints agree with
+    // GeodesicLine::Position and ArcPosition; the match is not exact because
+    // the sines and cosines are found by recurrence.
+    GeodesicLine l(Geodesic::WGS84(), T(-40), T(20), T(70));
+    const size_t m = 40;
+    const T tol = 10000 * numeric_limits<T>::epsilon();
+    T lat[m], lon[m], lata[m], lona[m];
+    l.Waypoints(T(-1e6), T(3e5), m, lat, lon);
+    l.ArcWaypoints(T(5), T(7), m, lata, lona);
+    for (size_t i = 0; i < m; ++i) {
+      T lat2, lon2, lata2, lona2;
+      l.Position(T(-1e6) + T(i) * T(3e5), lat2, lon2);
+      l.ArcPosition(T(5) + T(i) * T(7), lata2, lona2);
+      if (checkEquals(lat[i], lat2, tol) + checkEquals(lon[i], lon2, tol) +
+          checkEquals(lata[i], lata2, tol) + checkEquals(lona[i], lona2, tol)) {
+        cout << "Line " << __LINE__ << ": waypoints " << i << " fail\n";
+        ++n;
+      }
+    }
+    // The batch GenPosition in arc mode for latitude, longitude, and azimuth
+    // should match ArcPosition exactly, including for a meridian through the
+    // poles and signed zeros.
+    GeodesicLine lm(Geodesic::WGS84(), T(0), T(-0.0), T(0));
+    const T a12[11] = {0, -T(0), 90, -90, 180, 270, T(1e-3), 45, -135, 360,
+                       T(1234.5)};
+    T latb[11], lonb[11], azib[11], latc[11], lonc[11];
+    const unsigned mask = Geodesic::LATITUDE | Geodesic::LONGITUDE |
+      Geodesic::AZIMUTH;
+    for (int k = 0; k < 2; ++k) {
+      const GeodesicLine& lk = k ? lm : l;
+      lk.GenPosition(11, true, a12, mask, latb, lonb, azib,
+                     nullptr, nullptr, nullptr, nullptr, nullptr);
+      lk.GenPosition(11, true, a12, Geodesic::LATITUDE | Geodesic::LONGITUDE,
+                     latc, lonc, nullptr,
+                     nullptr, nullptr, nullptr, nullptr, nullptr);
+      for (size_t i = 0; i < 11; ++i) {
+        T lat2, lon2, azi2;
+        lk.ArcPosition(a12[i], lat2, lon2, azi2);
+        if (equiv(latb[i], lat2) + equiv(lonb[i], lon2) +
+            equiv(azib[i], azi2) + equiv(latc[i], lat2) +
+            equiv(lonc[i], lon2)) {
+          cout << "Line " << __LINE__ << ": arc batch " << k << " "
+               << a12[i] << " fail\n";
+          ++n;
+        }
+      }
+    }
+  }
+
+  {
+    // Check that Densifier keeps the vertices and gives the same results
+    // with several threads.
+    Densifier dens(Geodesic::WGS84());
+    const size_t m = 3;
+    const T lat[m] = {10, 60, -20}, lon[m] = {-30, 40, 100};
+    auto proj = [](T la, T lo, T& x, T& y) -> void { x = lo; y = la; };
+    vector<T> pts[2];
+    for (int k = 0; k < 2; ++k)
+      dens.Densify(m, lat, lon, T(0.01), proj,
+                   [&](size_t, T la, T lo) -> void
+                   { pts[k].push_back(la); pts[k].push_back(lo); },
+                   k ? 4 : 1);
+    if (pts[0].size() < 4 * m || pts[0] != pts[1] ||
+        equiv(pts[0][0], lat[0]) + equiv(pts[0][1], lon[0]) +
+        equiv(pts[0][pts[0].size() - 2], lat[m - 1]) +
+        equiv(pts[0].back(), lon[m - 1])) {
+      cout << "Line " << __LINE__ << ": Densifier fail\n";
+      ++n;
+    }
+  }
+
+  {
+    // Check that adding an array to an Accumulator matches adding the
+    // elements one at a time.
+    const size_t m = 4;
+    const T y[m] = {T(1e20), T(3), T(-1e20), T(0.25)};
+    Accumulator<T> a(T(0.5)), b(T(0.5));
+    a.Add(m, y);
+    for (size_t i = 0; i < m; ++i) b += y[i];
+    if (equiv(a(), T(3.75)) + equiv(a(), b())) {
+      cout << "Line " << __LINE__ << ": Accumulator::Add fail\n";
+      ++n;
+    }
+  }
+
+  {
+    // Check that the batch NormalGravity functions match the single point
+    // ones.
+    const NormalGravity& grav = NormalGravity::WGS84();
+    const size_t m = 5;
+    const T lat[m] = {-30, -30, 0, -0.0, 90}, h[m] = {100, 100, 0, 0, -1e3};
+    T U[m], gy[m], gz[m], g0[m];
+    grav.Gravity(m, lat, h, U, gy, gz);
+    grav.SurfaceGravity(m, lat, g0);
+    for (size_t i = 0; i < m; ++i) {
+      T gyx, gzx, Ux = grav.Gravity(lat[i], h[i], gyx, gzx);
+      if (equiv(U[i], Ux) + equiv(gy[i], gyx) + equiv(gz[i], gzx) +
+          equiv(g0[i], grav.SurfaceGravity(lat[i]))) {
+        cout << "Line " << __LINE__ << ": NormalGravity batch " << i
+             << " fail\n";
+        ++n;
+      }
+    }
+  }
+
+  {
+    // Check that the parallel functions use the Executor which has been set
+    // and that the results don't depend on it.
+    class CountingExecutor : public Executor {
+    public:
+      int calls;
+      CountingExecutor() : calls(0) {}
+      void Run(int num, const std::function<void(int)>& task) override {
+        ++calls;
+        Executor::Serial().Run(num, task);
+      }
+    } counting;
+    const Geodesic& g = Geodesic::WGS84();
+    const size_t m = 20;
+    T lat[m], lon[m], s0[m * m], s1[m * m], s2[m * m];
+    for (size_t i = 0; i < m; ++i) {
+      lat[i] = T(7 * int(i) % 170) - 85; lon[i] = T(37 * int(i) % 360) - 180;
+    }
+    g.DistanceMatrix(m, lat, lon, m, lat, lon, s0, nullptr, nullptr, 4);
+    Executor::Set(&counting);
+    g.DistanceMatrix(m, lat, lon, m, lat, lon, s1, nullptr, nullptr, 4);
+    Executor::Set();
+    g.DistanceMatrix(m, lat, lon, m, lat, lon, s2);
+    int k = counting.calls == 0 || &Executor::Current() != &Executor::Default();
+    for (size_t i = 0; i < m * m; ++i)
+      k += equiv(s0[i], s2[i]) + equiv(s1[i], s2[i]);
+    if (k) {
+      cout << "Line " << __LINE__ << ": Executor fail\n";
+      ++n;
+    }
+  }
+
+  {
+    // Check GeodesicCache against Geodesic::GenInverse with the points in
+    // both orders.
+    const Geodesic& g = Geodesic::WGS84();
+    const unsigned mask = Geodesic::ALL;
+    GeodesicCache exact(g, 100, 0, false), sym(g, 100, 0, true, 3);
+    const T lat[] = {0, -T(0), 30, -30, 89.5, 45}, lon[] = {0, 10, -T(0),
+                                                            179, 0, 135};
+    const int m = 6;
+    int k = 0;
+    for (int rep = 0; rep < 2; ++rep) {
+      for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < m; ++j) {
+          T s, a1, a2, m12, M12, M21, S12, a12 =
+            g.GenInverse(lat[i], lon[i], lat[j], lon[j], mask,
+                         s, a1, a2, m12, M12, M21, S12);
+          T sc, a1c, a2c, m12c, M12c, M21c, S12c, a12c =
+            exact.GenInverse(lat[i], lon[i], lat[j], lon[j], mask,
+                             sc, a1c, a2c, m12c, M12c, M21c, S12c);
+          k += equiv(a12c, a12) + equiv(sc, s) +
+            equiv(a1c, a1) + equiv(a2c, a2) + equiv(m12c, m12) +
+            equiv(M12c, M12) + equiv(M21c, M21) + equiv(S12c, S12);
+          a12c = sym.GenInverse(lat[i], lon[i], lat[j], lon[j], mask,
+                                sc, a1c, a2c, m12c, M12c, M21c, S12c);
+          k += checkEquals(a12c, a12, T(1e-13)) +
+            checkEquals(sc, s, T(1e-8)) +
+            checkEquals(Math::AngDiff(a1, a1c), T(0), T(1e-12)) +
+            checkEquals(Math::AngDiff(a2, a2c), T(0), T(1e-12)) +
+            checkEquals(m12c, m12, T(1e-8)) +
+            checkEquals(M12c, M12, T(1e-14)) +
+            checkEquals(M21c, M21, T(1e-14)) +
+            checkEquals(S12c, S12, T(1e-1));
+        }
+      }
+    }
+    // The second pass hits the cache; sym stores each unordered pair once.
+    k += exact.Hits() != unsigned(m * m) || exact.Misses() != unsigned(m * m)
+      || sym.Size() != unsigned(m * (m + 1) / 2) || sym.Shards() != 3;
+    if (k) {
+      cout << "Line " << __LINE__ << ": GeodesicCache fail\n";
+      ++n;
+    }
+  }
+
+  {
+    // Check IntersectCache and the hinted Intersect::Closest against
+    // Intersect::Closest for repeated and perturbed geodesics.
+    Intersect inter(Geodesic::WGS84());
+    IntersectCache cache(inter, 100, 1/T(64), 3);
+    const T L[][6] = {{0, 0, 45, 10, 0, 135}, {50, -30, 80, 40, -20, -60},
+                      {-20, 170, 10, -25, -175, 100}, {0, 0, 90, 0, 10, -90},
+                      {30, 0, 0, 30, 0, 0}};
+    const int m = 5;
+    const Intersect::Point p0(0, 0), far(T(2e7), T(-1e7));
+    int k = 0;
+    for (int rep = 0; rep < 3; ++rep) {
+      for (int i = 0; i < m; ++i) {
+        // The third pass perturbs geodesic X.
+        const T* l = L[i], dazi = rep < 2 ? 0 : T(1e-3);
+        int c, cc, ch = 2;
+        Intersect::Point
+          p = inter.Closest(l[0], l[1], l[2] + dazi, l[3], l[4], l[5], p0, &c),
+          pc = cache.Closest(l[0], l[1], l[2] + dazi, l[3], l[4], l[5], p0,
+                             &cc),
+          ph = inter.Closest(l[0], l[1], l[2] + dazi, l[3], l[4], l[5], p0,
+                             rep ? p : far, &ch);
+        k += (rep < 2 ? equiv(pc.first, p.first) + equiv(pc.second, p.second)
+              : checkEquals(pc.first, p.first, T(1e-6)) +
+              checkEquals(pc.second, p.second, T(1e-6))) +
+          checkEquals(ph.first, p.first, T(1e-6)) +
+          checkEquals(ph.second, p.second, T(1e-6)) + (cc != c) + (ch != c);
+      }
+    }
+    k += cache.Hits() != unsigned(m) || cache.Misses() != unsigned(m) ||
+      cache.Seeded() != unsigned(m) || cache.Size() != unsigned(m);
+    if (k) {
+      cout << "Line " << __LINE__ << ": IntersectCache fail\n";
+      ++n;
+    }
+  }
+
+  {
+    // Check GeodesicFan::Position against GeodesicLine::Position; the results
+    // should be identical.  Include a prolate ellipsoid with |f| > 0.01 (for
+    // the Newton correction) and an exact Geodesic (for the fallback).
+    const Geodesic g[3] = {Geodesic(Constants::WGS84_a(),
+                                    Constants::WGS84_f()),
+                           Geodesic(T(6.4e6), T(-1)/10),
+                           Geodesic(Constants::WGS84_a(),
+                                    Constants::WGS84_f(), true)};
+    int k = 0;
+    for (int e = 0; e < 3; ++e) {
+      GeodesicFan fan(g[e], T(40.64), T(-73.78), T(-180), T(7.3), 50);
+      vector<T> lat(fan.Size()), lon(fan.Size()), azi(fan.Size());
+      for (T s12 : {T(0), T(1e3), T(2e5), T(1e7), T(-3e6)}) {
+        fan.Position(s12, lat.data(), lon.data(), azi.data());
+        for (size_t i = 0; i < fan.Size(); ++i) {
+          T lat2, lon2, azi2;
+          fan.Line(i).Position(s12, lat2, lon2, azi2);
+          k += equiv(lat[i], lat2) + equiv(lon[i], lon2) +
+            equiv(azi[i], azi2);
+        }
+      }
+    }
+    // GeodesicFan::Grid should match Position row by row; use enough
+    // azimuths for several blocks.
+    GeodesicFan fan(g[0], T(-33.9), T(151.2), T(0), T(0.6), 600);
+    const T s12[4] = {T(5e3), T(0), T(3e6), T(1.9e7)};
+    const size_t nf = fan.Size();
+    vector<T> lat(4 * nf), lon(4 * nf), azi(4 * nf), lat1(nf), lon1(nf),
+      azi1(nf);
+    fan.Grid(4, s12, lat.data(), lon.data(), azi.data(), 3);
+    for (size_t j = 0; j < 4; ++j) {
+      fan.Position(s12[j], lat1.data(), lon1.data(), azi1.data());
+      for (size_t i = 0; i < nf; ++i)
+        k += equiv(lat[j * nf + i], lat1[i]) +
+          equiv(lon[j * nf + i], lon1[i]) + equiv(azi[j * nf + i], azi1[i]);
+    }
+    if (k) {
+      cout << "Line " << __LINE__ << ": GeodesicFan fail\n";
+      ++n;
+    }
+  }
+
+  {
+    // Check Geodesic::Circle: the vertices lie on the circle and the
+    // midpoints of the edges are inside it by no more than the tolerance
+    // (and by more than a quarter of it, so n isn't too conservative).
+    const Geodesic& g = Geodesic::WGS84();
+    int k = 0;
+    vector<T> lat, lon;
+    for (T radius : {T(1e3), T(1e5), T(2e6), T(1.5e7)}) {
+      const T lat1 = T(51.47), lon1 = T(-0.45), tol = T(1);
+      int m = g.CircleVertices(lat1, lon1, radius, tol);
+      lat.resize(m); lon.resize(m);
+      g.Circle(lat1, lon1, radius, m, lat.data(), lon.data());
+      T dmax = 0, s12;
+      for (int i = 0; i < m; ++i) {
+        g.Inverse(lat1, lon1, lat[i], lon[i], s12);
+        k += checkEquals(s12, radius, T(1e-8));
+        int j = (i + 1) % m;
+        T latm, lonm, azi1, a12 = g.Inverse(lat[i], lon[i], lat[j], lon[j],
+                                           s12, azi1, latm);
+        g.ArcDirect(lat[i], lon[i], azi1, a12/2, latm, lonm);
+        g.Inverse(lat1, lon1, latm, lonm, s12);
+        dmax = fmax(dmax, fabs(radius - s12));
+      }
+      k += !(dmax <= tol && (m == 8 || dmax > tol/4));
+    }
+    try {
+      g.CircleVertices(0, 0, -1, 1); ++k;
+    } catch (const GeographicErr&) {}
+    try {
+      g.CircleVertices(0, 0, 1e3, 0); ++k;
+    } catch (const GeographicErr&) {}
+    if (k) {
+      cout << "Line " << __LINE__ << ": Geodesic::Circle fail\n";
+      ++n;
+    }
+  }
+
+  {
+    // Check the batch GeodesicExact::GenInverse and GenDirect against the
+    // scalar versions for an ellipsoid with a large flattening; the results
+    // should be identical.  Include meridional and nearly antipodal points.
+    const GeodesicExact g(T(6.4e6), T(1)/10);
+    const unsigned mask = GeodesicExact::ALL;
+    const size_t m = 600;
+    vector<T> lat1(m), lon1(m), lat2(m), lon2(m), s12(m), azi1(m), azi2(m),
+      m12(m), M12(m), M21(m), S12(m), a12(m), lat3(m), lon3(m), azi3(m),
+      s13(m);
+    for (size_t i = 0; i < m; ++i) {
+      lat1[i] = T(int(7 * i % 179)) - 89; lon1[i] = 0;
+      lat2[i] = T(int(13 * i % 179)) - 89;
+      lon2[i] = i % 5 ? T(int(37 * i % 360)) - 180 : 0;
+    }
+    lat2[1] = -lat1[1]; lon2[1] = T(179.5);
+    int k = 0;
+    for (int nthreads : {1, 3}) {
+      g.GenInverse(m, lat1.data(), lon1.data(), lat2.data(), lon2.data(),
+                   mask, s12.data(), azi1.data(), azi2.data(), m12.data(),
+                   M12.data(), M21.data(), S12.data(), a12.data(), nthreads);
+      g.GenDirect(m, lat1.data(), lon1.data(), azi1.data(), false,
+                  s12.data(), GeodesicExact::LATITUDE |
+                  GeodesicExact::LONGITUDE | GeodesicExact::AZIMUTH,
+                  lat3.data(), lon3.data(), azi3.data(), nullptr, nullptr,
+                  nullptr, nullptr, nullptr, s13.data(), nthreads);
+      for (size_t i = 0; i < m; ++i) {
+        T s, a1, a2, mm, MM12, MM21, SS, a =
+          g.GenInverse(lat1[i], lon1[i], lat2[i], lon2[i], mask,
+                       s, a1, a2, mm, MM12, MM21, SS);
+        k += equiv(s12[i], s) + equiv(azi1[i], a1) + equiv(azi2[i], a2) +
+          equiv(m12[i], mm) + equiv(M12[i], MM12) + equiv(M21[i], MM21) +
+          equiv(S12[i], SS) + equiv(a12[i], a);
+        T lat, lon, azi;
+        a = g.Direct(lat1[i], lon1[i], azi1[i], s12[i], lat, lon, azi);
+        k += equiv(lat3[i], lat) + equiv(lon3[i], lon) +
+          equiv(azi3[i], azi) + equiv(s13[i], a);
+      }
+    }
+    if (k) {
+      cout << "Line " << __LINE__ << ": GeodesicExact batch fail\n";
+      ++n;
+    }
+  }
+
+  {
+    // Check that JacobiConformal::Reverse inverts Forward and that the batch
+    // versions match the scalar ones.  For an ellipsoid of revolution (a =
+    // b), x = omg.
+    const JacobiConformal jc(T(6378172), T(6378102), T(6356752)),
+      jr(T(6378137), T(6378137), T(6356752), 0, T(21385));
+    const size_t m = 400;
+    vector<T> omg(m), bet(m), x(m), y(m), omg1(m), bet1(m);
+    for (size_t i = 0; i < m; ++i) {
+      omg[i] = T(int(37 * i % 359)) - 179 + T(0.25);
+      bet[i] = T(int(13 * i % 359)) - 179 + T(0.5);
+    }
+    omg[0] = 180; bet[0] = 90; omg[1] = -90; bet[1] = 0;
+    int k = 0;
+    const T tol = 1000 * numeric_limits<T>::epsilon() * Math::hd;
+    for (int nthreads : {1, 3}) {
+      jc.Forward(m, omg.data(), bet.data(), x.data(), y.data(), nthreads);
+      jc.Reverse(m, x.data(), y.data(), omg1.data(), bet1.data(), nthreads);
+      for (size_t i = 0; i < m; ++i) {
+        T xx, yy, o, b;
+        jc.Forward(omg[i], bet[i], xx, yy);
+        jc.Reverse(xx, yy, o, b);
+        k += equiv(x[i], xx) + equiv(y[i], yy) +
+          equiv(omg1[i], o) + equiv(bet1[i], b) +
+          !(fabs(o - omg[i]) <= tol && fabs(b - bet[i]) <= tol);
+      }
+    }
+    for (size_t i = 0; i < m; ++i)
+      k += !(fabs(jr.x(omg[i]) - omg[i]) <= tol);
+    k += !(fabs(jr.x() - Math::pi()/2) <= tol);
+    try {
+      JacobiConformal(1, 2, 1); ++k;
+    } catch (const GeographicErr&) {}
+    if (k) {
+      cout << "Line " << __LINE__ << ": JacobiConformal fail\n";
+      ++n;
+    }
+  }
+
+  {
+    // Check TriaxialGeodesic.  For an ellipsoid of revolution, beta is the
+    // parametric latitude and the results should match GeodesicExact.  For a
+    // triaxial ellipsoid, Direct should invert Inverse, the batch versions
+    // should match the scalar ones, and FromCartesian should invert
+    // ToCartesian.
+    const T a = Constants::WGS84_a<T>(), f = Constants::WGS84_f<T>();
+    const TriaxialGeodesic tr(a, a, a * (1 - f)),
+      tv(T(286.3), T(278.6), T(223.2));
+    const GeodesicExact& ge = GeodesicExact::WGS84();
+    const size_t m = 40;
+    vector<T> bet1(m), omg1(m), bet2(m), omg2(m),
+      s12(m), alp1(m), alp2(m), m12(m), bet3(m), omg3(m), alp3(m);
+    for (size_t i = 0; i < m; ++i) {
+      bet1[i] = T(int(37 * i % 179)) - 89 + T(0.25);
+      omg1[i] = T(int(13 * i % 359)) - 179 + T(0.5);
+      bet2[i] = T(int(53 * i % 179)) - 89 + T(0.75);
+      omg2[i] = T(int(71 * i % 359)) - 179;
+    }
+    int k = 0;
+    for (size_t i = 0; i < 10; ++i) {
+      T s, a1, a2, mm, MM, MM2, s0, azi1, azi2, m0, M0, M20;
+      tr.Inverse(bet1[i], omg1[i], bet2[i], omg2[i], s, a1, a2, mm, MM, MM2);
+      ge.Inverse(Math::atand(Math::tand(bet1[i]) / (1 - f)), omg1[i],
+                 Math::atand(Math::tand(bet2[i]) / (1 - f)), omg2[i],
+                 s0, azi1, azi2, m0, M0, M20);
+      k += !(fabs(s - s0) <= T(1e-6) && fabs(mm - m0) <= T(1e-6) &&
+             fabs(Math::AngDiff(a1, azi1)) <= T(1e-10) &&
+             fabs(Math::AngDiff(a2, azi2)) <= T(1e-10) &&
+             fabs(MM - M0) <= T(1e-12) && fabs(MM2 - M20) <= T(1e-12));
+    }
+    for (int nthreads : {1, 3}) {
+      tv.Inverse(m, bet1.data(), omg1.data(), bet2.data(), omg2.data(),
+                 s12.data(), alp1.data(), alp2.data(), m12.data(),
+                 nullptr, nullptr, nthreads);
+      tv.Direct(m, bet1.data(), omg1.data(), alp1.data(), s12.data(),
+                bet3.data(), omg3.data(), alp3.data(),
+                nullptr, nullptr, nullptr, nthreads);
+      for (size_t i = 0; i < m; ++i) {
+        T s, a1, a2, mm, b3, o3, a3, X, Y, Z, X3, Y3, Z3, b, o;
+        tv.Inverse(bet1[i], omg1[i], bet2[i], omg2[i], s, a1, a2, mm, b, o);
+        tv.Direct(bet1[i], omg1[i], a1, s, b3, o3, a3);
+        tv.ToCartesian(bet2[i], omg2[i], X, Y, Z);
+        tv.ToCartesian(b3, o3, X3, Y3, Z3);
+        tv.FromCartesian(X, Y, Z, b, o);
+        k += equiv(s12[i], s) + equiv(alp1[i], a1) + equiv(alp2[i], a2) +
+          equiv(m12[i], mm) + equiv(bet3[i], b3) + equiv(omg3[i], o3) +
+          equiv(alp3[i], a3) + !(mm > 0) +
+          !(fabs(X3 - X) + fabs(Y3 - Y) + fabs(Z3 - Z) <= T(1e-9)) +
+          !(fabs(b - bet2[i]) <= T(1e-10) &&
+            fabs(Math::AngDiff(o, omg2[i])) <= T(1e-10));
+      }
+    }
+    try {
+      TriaxialGeodesic(1, 2, 1); ++k;
+    } catch (const GeographicErr&) {}
+    try {
+      TriaxialGeodesic(1, 1, 1); ++k;
+    } catch (const GeographicErr&) {}
+    if (k) {
+      cout << "Line " << __LINE__ << ": TriaxialGeodesic fail\n";
+      ++n;
+    }
+  }
+
+  {
+    // Check Geoid with a synthetic geoid read from a Source.  With bilinear
+    // interpolation, the heights at the grid points and at the centers of
+    // the cells are given by the pixels; the second pass over these points
+    // is served by the tile cache.  The batch operator(), Context, the
+    // compressed and the precomputed cached areas, and the tiled format
+    // written by WriteTiled should give the same results as the scalar
+    // operator(); CellCoefficients should agree to float precision.
+    vector<unsigned> pix;
+    T offset, scale;
+    const string pgm = synthgeoid(pix, offset, scale);
+    auto height = [&pix, offset, scale](int ix, int iy) -> T {
+      return offset + scale * T(pix[size_t(iy) * 720 + size_t(ix % 720)]);
+    };
+    auto source = [](const string& data, int* reads)
+      -> unique_ptr<Geoid::Source> {
+      return unique_ptr<Geoid::Source>(new MemorySource(data, reads));
+    };
+    const T tol = 4096 * numeric_limits<T>::epsilon();
+    int k = 0, reads = 0;
+    {
+      const Geoid g(source(pgm, &reads), "synth", false);
+      k += !(g.Offset() == offset && g.Scale() == scale &&
+             g.Description() == "Synthetic geoid");
+      for (int pass = 0; pass < 2; ++pass) {
+        const int r = reads;
+        for (int iy = 0; iy < 361; iy += 7)
+          for (int ix = 0; ix < 720; ix += 11) {
+            T lat = 90 - T(iy) / 2, lon = T(ix) / 2 - (ix < 360 ? 0 : 360);
+            k += checkEquals(g(lat, lon), height(ix, iy), tol);
+            if (iy < 360)
+              k += checkEquals(g(lat - T(0.25), lon + T(0.25)),
+                               (height(ix, iy) + height(ix + 1, iy) +
+                                height(ix, iy + 1) +
+                                height(ix + 1, iy + 1)) / 4, tol);
+          }
+        if (pass == 1) k += reads != r;
+      }
+    }
+    // The points straddle the tile boundary at longitude 0.
+    const size_t m = 500;
+    const T south = -42, west = -45, north = 45, east = 70;
+    vector<T> lat(m), lon(m), h(m), h0(m);
+    for (size_t i = 0; i < m; ++i) {
+      lat[i] = T(int(37 * i % 1000)) * T(0.0795) - T(39.5);
+      lon[i] = T(int(61 * i % 1000)) * T(0.1031) - T(40.3);
+    }
+    for (bool cubic : {false, true}) {
+      const Geoid g(source(pgm, nullptr), "synth", cubic);
+      for (size_t i = 0; i < m; ++i)
+        h0[i] = g(lat[i], lon[i]);
+      g(m, lat.data(), lon.data(), h.data());
+      for (size_t i = 0; i < m; ++i)
+        k += equiv(h[i], h0[i]);
+      {
+        // ctx is first used with g and then reset by gt.
+        const Geoid gt(source(pgm, nullptr), "synth", cubic, true);
+        Geoid::Context ctx;
+        k += equiv(g(lat[1], lon[1], ctx), h0[1]);
+        for (size_t i = 0; i < m; ++i)
+          k += equiv(gt(lat[i], lon[i], ctx), h0[i]);
+        gt(m, lat.data(), lon.data(), h.data());
+        for (size_t i = 0; i < m; ++i)
+          k += equiv(h[i], h0[i]);
+      }
+      for (int c = 0; c < 4; ++c) {
+        const Geoid gc(source(pgm, nullptr), "synth", cubic);
+        gc.SetCacheCompression((c & 1) != 0);
+        gc.SetCachePrecompute((c & 2) != 0);
+        gc.CacheArea(south, west, north, east);
+        for (size_t i = 0; i < m; ++i)
+          k += equiv(gc(lat[i], lon[i]), h0[i]);
+        gc(m, lat.data(), lon.data(), h.data());
+        for (size_t i = 0; i < m; ++i)
+          k += equiv(h[i], h0[i]);
+      }
+      for (bool compress : {false, true}) {
+        const char* file = "signtest-synth.tgm";
+        g.WriteTiled(file, compress);
+        string tgm;
+        {
+          ifstream f(file, ios::binary);
+          ostringstream os;
+          os << f.rdbuf();
+          tgm = os.str();
+        }
+        remove(file);
+        const Geoid gw(source(tgm, nullptr), "synth", cubic);
+        k += !(gw.Offset() == offset && gw.Scale() == scale &&
+               gw.Description() == "Synthetic geoid");
+        for (size_t i = 0; i < m; ++i)
+          k += equiv(gw(lat[i], lon[i]), h0[i]);
+      }
+      vector<float> cc;
+      T lat0, lon0, dlat, dlon;
+      int nlat, nlon;
+      g.CellCoefficients(south, west, north, east, cc,
+                         lat0, lon0, dlat, dlon, nlat, nlon);
+      for (size_t i = 0; i < m; ++i) {
+        T dl = lon[i] - lon0;
+        dl -= 360 * floor(dl / 360);
+        T x = dl / dlon, y = (lat0 - lat[i]) / dlat;
+        int ix = int(floor(x)), iy = min(int(floor(y)), nlat - 1);
+        if (!(ix >= 0 && ix < nlon && iy >= 0)) {
+          ++k;
+          continue;
+        }
+        T fx = x - ix, fy = y - iy, t[10];
+        for (int j = 0; j < 10; ++j)
+          t[j] = T(cc[10 * (size_t(iy) * size_t(nlon) + size_t(ix)) +
+                      size_t(j)]);
+        k += checkEquals(t[0] + fx * (t[1] + fx * (t[3] + fx * t[6])) +
+                         fy * (t[2] + fx * (t[4] + fx * t[7]) +
+                               fy * (t[5] + fx * t[8] + fy * t[9])),
+                         h0[i], T(1e-4));
+      }
+    }
+    if (k) {
+      cout << "Line " << __LINE__ << ": Geoid fail\n";
+      ++n;
+    }
+  }
+
+  {
+    // Check SphericalEngine on synthetic models.  Coefficients held as
+    // floats should give the same sums and gradients as their values
+    // (rounded to floats) held as reals and interleaved coefficients should
+    // give the same results as separate ones; with two sets of coefficients,
+    // the sets may be held differently.  The rounding to floats changes the
+    // sums by about float precision.  The batch sums and the sums for N =
+    // 260 evaluated on several threads should be unchanged.
+    typedef SphericalEngine::coeff coeff;
+    const int nt0 = SphericalEngine::threads();
+    const T a = 1, f1[] = {1}, f2[] = {1, T(0.5)};
+    int k = 0;
+    unsigned r = 1;
+    auto rnd = [&r]() -> T {
+      r = r * 1103515245u + 12345u;
+      return T(int((r >> 8) & 0xffffu) - 0x8000) / 0x8000;
+    };
+    for (int N : {40, 260}) {
+      const size_t nc = size_t(coeff::Csize(N, N)),
+        ns = size_t(coeff::Ssize(N, N));
+      vector<T> C(nc), S(ns), Cr(nc), Sr(ns), CS;
+      vector<float> Cf(nc), Sf(ns);
+      for (int m = 0; m <= N; ++m)
+        for (int l = m; l <= N; ++l) {
+          size_t i = size_t(m * N - m * (m - 1) / 2 + l);
+          C[i] = rnd() / T((l + 1) * (l + 1));
+          if (m) S[i - size_t(N + 1)] = rnd() / T((l + 1) * (l + 1));
+        }
+      for (size_t i = 0; i < nc; ++i) {
+        Cf[i] = float(C[i]); Cr[i] = T(Cf[i]);
+      }
+      for (size_t i = 0; i < ns; ++i) {
+        Sf[i] = float(S[i]); Sr[i] = T(Sf[i]);
+      }
+      coeff::interleave(C, S, N, N, CS);
+      const coeff cd(C, S, N, N, N), cr(Cr, Sr, N, N, N),
+        cf(Cf, Sf, N, N, N), ci(CS, N, N, N),
+        c2[] = {ci, cf}, c2r[] = {cd, cr};
+      k += !ci.Interleaved();
+      const size_t np = 11;
+      vector<T> x(np), y(np), z(np), V(np), gx(np), gy(np), gz(np);
+      for (size_t j = 0; j < np; ++j) {
+        x[j] = T(0.3) + T(0.2) * T(j); y[j] = T(1.1) - T(0.15) * T(j);
+        z[j] = T(0.3) * T(j) - T(0.7);
+      }
+      SphericalEngine::Values<true, SphericalEngine::FULL, 1>
+        (&cf, f1, np, x.data(), y.data(), z.data(), a,
+         V.data(), gx.data(), gy.data(), gz.data());
+      for (size_t j = 0; j < np; ++j) {
+        T g[5][3];
+        auto value = [&](const coeff c[], int L, T gr[]) -> T {
+          return L == 1 ?
+            SphericalEngine::Value<true, SphericalEngine::FULL, 1>
+            (c, f1, x[j], y[j], z[j], a, gr[0], gr[1], gr[2]) :
+            SphericalEngine::Value<true, SphericalEngine::FULL, 2>
+            (c, f2, x[j], y[j], z[j], a, gr[0], gr[1], gr[2]);
+        };
+        T vd = value(&cd, 1, g[0]), vr = value(&cr, 1, g[1]),
+          vf = value(&cf, 1, g[2]), vi = value(&ci, 1, g[3]);
+        k += equiv(vf, vr) + equiv(vi, vd) + equiv(V[j], vf) +
+          equiv(gx[j], g[2][0]) + equiv(gy[j], g[2][1]) +
+          equiv(gz[j], g[2][2]) + checkEquals(vf, vd, T(1e-5));
+        for (int i = 0; i < 3; ++i)
+          k += equiv(g[2][i], g[1][i]) + equiv(g[3][i], g[0][i]) +
+            checkEquals(g[2][i], g[0][i], T(1e-4));
+        k += equiv(value(c2, 2, g[3]), value(c2r, 2, g[4]));
+        for (int i = 0; i < 3; ++i)
+          k += equiv(g[3][i], g[4][i]);
+        SphericalEngine::set_threads(3);
+        k += equiv(value(&cd, 1, g[4]), vd);
+        SphericalEngine::set_threads(nt0);
+        for (int i = 0; i < 3; ++i)
+          k += equiv(g[4][i], g[0][i]);
+      }
+    }
+    if (k) {
+      cout << "Line " << __LINE__ << ": SphericalEngine fail\n";
+      ++n;
+    }
+  }
+
+  {
+    // Check NearestNeighbor after Insert, Remove, and Rebuild against a
+    // brute force search: the distances to the k closest points which
+    // haven't been removed should match.  SearchBatch on several threads
+    // should match Search.
+    typedef pair<int, int> pos;
+    typedef NearestNeighbor<int, pos, GridDist> NN;
+    const GridDist dist;
+    unsigned r = 7;
+    auto rnd = [&r]() -> int {
+      r = r * 1103515245u + 12345u;
+      return int((r >> 8) % 1000u);
+    };
+    vector<pos> pts, queries;
+    for (int i = 0; i < 3000; ++i)
+      pts.push_back(pos(rnd(), rnd()));
+    for (int i = 0; i < 100; ++i)
+      queries.push_back(pos(rnd(), rnd()));
+    vector<char> alive(pts.size(), 1);
+    const int kk = 5;
+    int k = 0;
+    auto brute = [&](const NN& tree) -> int {
+      int e = 0;
+      vector<vector<int>> inds;
+      vector<int> d0 = tree.SearchBatch(pts, dist, queries, inds, kk,
+                                        numeric_limits<int>::max(), -1,
+                                        true, 0,
+                                        numeric_limits<int>::max(), 3);
+      for (size_t q = 0; q < queries.size(); ++q) {
+        vector<int> ind, dd, bd;
+        int d = tree.Search(pts, dist, queries[q], ind, kk);
+        e += d != d0[q] || ind != inds[q];
+        for (int i : ind) {
+          e += !alive[i];
+          dd.push_back(dist(pts[i], queries[q]));
+        }
+        for (size_t i = 0; i < pts.size(); ++i)
+          if (alive[i]) bd.push_back(dist(pts[i], queries[q]));
+        sort(bd.begin(), bd.end());
+        bd.resize(min(bd.size(), size_t(kk)));
+        e += dd != bd || (!dd.empty() && d != dd[0]);
+      }
+      return e;
+    };
+    NN tree(pts, dist);
+    k += brute(tree);
+    for (int i = 0; i < 1000; ++i)
+      pts.push_back(pos(rnd(), rnd()));
+    alive.resize(pts.size(), 1);
+    tree.Insert(pts, dist);
+    k += tree.NumPoints() != int(pts.size()) || tree.NumInserted() != 1000;
+    k += brute(tree);
+    for (int i = 0; i < int(pts.size()); i += 3) {
+      tree.Remove(i); alive[i] = 0;
+    }
+    k += brute(tree);
+    tree.Rebuild(pts, dist, 2);
+    k += tree.NumInserted() != 0 || tree.NumRemoved() != 0;
+    k += brute(tree);
+    for (int i = 1; i < int(pts.size()); i += 5) {
+      tree.Remove(i); alive[i] = 0;
+    }
+    k += brute(tree);
+    if (k) {
+      cout << "Line " << __LINE__ << ": NearestNeighbor fail\n";
+      ++n;
+    }
+  }
+
+  {
+    // Check Registry: the first object inserted under a key is returned by
+    // Find and by later calls to Insert and objects beyond the maximum size
+    // aren't registered.  Rhumb objects with the same f should give the same
+    // areas whether or not the coefficients are found in the registry.
+    int k = 0;
+    Registry<int, const int> r(2);
+    k += r.Find(1) != nullptr;
+    auto p1 = r.Insert(1, make_shared<const int>(10));
+    k += r.Insert(1, make_shared<const int>(11)) != p1;
+    k += r.Find(1) != p1 || *p1 != 10;
+    r.Insert(0, make_shared<const int>(20));
+    auto p3 = r.Insert(3, make_shared<const int>(30));
+    k += r.Size() != 2 || *p3 != 30 || r.Find(3) != nullptr ||
+      *r.Find(0) != 20 || *r.Find(1) != 10;
+    T S1, S2, lat2, lon2;
+    Rhumb rh1(6.4e6, T(1)/10, true), rh2(6.3e6, T(1)/10, true);
+    rh1.Direct(30, 10, 70, 5e6, lat2, lon2, S1);
+    rh2.Direct(30, 10, 70, 5e6 * T(0.63)/T(0.64), lat2, lon2, S2);
+    k += !(fabs(S2 / (T(0.63)*T(0.63)) - S1 / (T(0.64)*T(0.64))) <=
+           1e-6 * fabs(S1));
+    if (k) {
+      cout << "Line " << __LINE__ << ": Registry fail\n";
+      ++n;
+    }
+  }
+
   if (n) {
     cout << n << " failure" << (n > 1 ? "s" : "") << "\n";
     return 1;
@@ -0,0 +1,352 @@
+/**
+ * \file ArrowProcessor.hpp
+ * \brief Header for the Apache Arrow input and output of the utilities
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_ARROWPROCESSOR_HPP)
+#define GEOGRAPHICLIB_ARROWPROCESSOR_HPP 1
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "LineProcessor.hpp"
+
+#if GEOGRAPHICLIB_HAVE_ARROW
+#include <arrow/api.h>
+#include <arrow/io/api.h>
+#include <arrow/ipc/api.h>
+#if GEOGRAPHICLIB_HAVE_PARQUET
+#include <parquet/arrow/reader.h>
+#include <parquet/arrow/writer.h>
+#endif
+#endif
+
+namespace GeographicLib {
+
+  /**
+   * \brief Apache Arrow input and output for the command line utilities
+   *
+   * With the --arrow option, the utilities read their input from, and write
+   * their output to, tables of Apache Arrow, either in the IPC streaming
+   * format or, if the file name ends in ".parquet", in Parquet format.  The
+   * columns of the input table are the numbers which would appear on an
+   * input line (the first \e nin columns are used and they must be of type
+   * float64); the output table has a float64 column for each number on an
+   * output line.  Null input values are treated as NaNs.  Each record batch
+   * of the input gives a record batch of the output.
+   *
+   * The records of a batch are converted by the same function objects as
+   * for LineProcessor::ProcessBinaryBlocks.  The columns of each batch are
+   * read directly from the buffers of the Arrow arrays (which are not
+   * copied when reading the IPC format) and gathered into records, and the
+   * output records are scattered into newly allocated Arrow buffers.
+   *
+   * This is only available if GeographicLib was configured with
+   * GEOGRAPHICLIB_ARROW = ON (and, for Parquet files,
+   * GEOGRAPHICLIB_PARQUET = ON); otherwise the functions throw an error.
+   **********************************************************************/
+  class ArrowProcessor {
+  private:
+    typedef Math::real real;
+    ArrowProcessor() = delete;  // Disable constructor
+
+    static bool IsParquet(const std::string& file) {
+      const std::string suff = ".parquet";
+      return file.size() > suff.size() &&
+        file.compare(file.size() - suff.size(), suff.size(), suff) == 0;
+    }
+
+#if GEOGRAPHICLIB_HAVE_ARROW
+    static void Check(const arrow::Status& s) {
+      if (!s.ok()) throw GeographicErr("Arrow: " + s.ToString());
+    }
+    template<class T> static T Value(arrow::Result<T> r) {
+      Check(r.status());
+      return std::move(r).ValueOrDie();
+    }
+#endif
+
+  public:
+
+    /**
+     * \brief A reader of the record batches of an Arrow table.
+     **********************************************************************/
+    class Reader {
+#if GEOGRAPHICLIB_HAVE_ARROW
+      std::shared_ptr<arrow::RecordBatchReader> _reader;
+#if GEOGRAPHICLIB_HAVE_PARQUET
+      std::unique_ptr<parquet::arrow::FileReader> _parquet;
+#endif
+#endif
+    public:
+      /**
+       * Constructor.
+       *
+       * @param[in] file the name of the file ("" or "-" for the standard
+       *   input, which must be in IPC streaming format).
+       * @exception GeographicErr if the file can't be opened or read.
+       **********************************************************************/
+      explicit Reader(const std::string& file) {
+#if GEOGRAPHICLIB_HAVE_ARROW
+        bool stdinp = file.empty() || file == "-";
+        if (!stdinp && IsParquet(file)) {
+#if GEOGRAPHICLIB_HAVE_PARQUET
+          auto in = Value(arrow::io::ReadableFile::Open(file));
+          Check(parquet::arrow::OpenFile(in, arrow::default_memory_pool(),
+                                         &_parquet));
+          std::unique_ptr<arrow::RecordBatchReader> r;
+          Check(_parquet->GetRecordBatchReader(&r));
+          _reader = std::move(r);
+#else
+          throw GeographicErr("Parquet support is not available");
+#endif
+        } else {
+          std::shared_ptr<arrow::io::InputStream> in;
+          if (stdinp)
+            in = std::make_shared<arrow::io::StdinStream>();
+          else
+            in = Value(arrow::io::ReadableFile::Open(file));
+          _reader = Value(arrow::ipc::RecordBatchStreamReader::Open(in));
+        }
+#else
+        (void)file;
+        throw GeographicErr("Arrow support is not available");
+#endif
+      }
+
+      /**
+       * Read the next record batch.
+       *
+       * @param[in] nin the number of columns to use.
+       * @param[out] in the records for the batch; record \e i consists of
+       *   elements [\e i \e nin, (\e i + 1) \e nin).
+       * @return the number of records or 0 at the end of the table.
+       * @exception GeographicErr if the table has fewer than \e nin columns
+       *   or if these aren't float64.
+       **********************************************************************/
+      size_t Next(int nin, std::vector<real>& in) {
+#if GEOGRAPHICLIB_HAVE_ARROW
+        const size_t ni = size_t(nin);
+        std::shared_ptr<arrow::RecordBatch> batch;
+        do {
+          Check(_reader->ReadNext(&batch));
+          if (!batch) return 0;
+        } while (batch->num_rows() == 0);
+        if (size_t(batch->num_columns()) < ni)
+          throw GeographicErr("Arrow input has "
+                              + std::to_string(batch->num_columns())
+                              + " columns instead of "
+                              + std::to_string(nin));
+        const size_t n = size_t(batch->num_rows());
+        in.resize(n * ni);
+        for (size_t j = 0; j < ni; ++j) {
+          auto col = batch->column(int(j));
+          if (col->type_id() != arrow::Type::DOUBLE)
+            throw GeographicErr("Arrow input column "
+                                + batch->schema()->field(int(j))->name()
+                                + " is not float64");
+          auto d = std::static_pointer_cast<arrow::DoubleArray>(col);
+          const double* v = d->raw_values();
+          if (d->null_count() == 0)
+            for (size_t i = 0; i < n; ++i)
+              in[i * ni + j] = real(v[i]);
+          else
+            for (size_t i = 0; i < n; ++i)
+              in[i * ni + j] = d->IsNull(int64_t(i)) ? Math::NaN() :
+                real(v[i]);
+        }
+        return n;
+#else
+        (void)nin; (void)in;
+        return 0;
+#endif
+      }
+    };
+
+    /**
+     * \brief A writer of the record batches of an Arrow table.
+     **********************************************************************/
+    class Writer {
+#if GEOGRAPHICLIB_HAVE_ARROW
+      std::shared_ptr<arrow::Schema> _schema;
+      std::shared_ptr<arrow::io::OutputStream> _out;
+      std::shared_ptr<arrow::ipc::RecordBatchWriter> _writer;
+#if GEOGRAPHICLIB_HAVE_PARQUET
+      std::unique_ptr<parquet::arrow::FileWriter> _parquet;
+#endif
+#endif
+    public:
+      /**
+       * Constructor.
+       *
+       * @param[in] file the name of the file ("" or "-" for the standard
+       *   output, which is written in IPC streaming format).
+       * @param[in] names the names of the columns.
+       * @exception GeographicErr if the file can't be opened.
+       **********************************************************************/
+      Writer(const std::string& file, const std::vector<std::string>& names)
+      {
+#if GEOGRAPHICLIB_HAVE_ARROW
+        std::vector<std::shared_ptr<arrow::Field>> fields;
+        for (const auto& name : names)
+          fields.push_back(arrow::field(name, arrow::float64()));
+        _schema = arrow::schema(fields);
+        bool stdoutp = file.empty() || file == "-";
+        if (stdoutp)
+          _out = std::make_shared<arrow::io::StdoutStream>();
+        else
+          _out = Value(arrow::io::FileOutputStream::Open(file));
+        if (!stdoutp && IsParquet(file)) {
+#if GEOGRAPHICLIB_HAVE_PARQUET
+          _parquet = Value(parquet::arrow::FileWriter::Open
+                           (*_schema, arrow::default_memory_pool(), _out));
+#else
+          throw GeographicErr("Parquet support is not available");
+#endif
+        } else
+          _writer = Value(arrow::ipc::MakeStreamWriter(_out, _schema));
+#else
+        (void)file; (void)names;
+        throw GeographicErr("Arrow support is not available");
+#endif
+      }
+
+      /**
+       * Write a record batch.
+       *
+       * @param[in] n the number of records.
+       * @param[in] out the records; record \e i consists of elements [\e i
+       *   \e nout, (\e i + 1) \e nout), where \e nout is the number of
+       *   columns.
+       * @exception GeographicErr if the output can't be written.
+       **********************************************************************/
+      void Write(size_t n, const real out[]) {
+#if GEOGRAPHICLIB_HAVE_ARROW
+        const size_t no = size_t(_schema->num_fields());
+        std::vector<std::shared_ptr<arrow::Array>> cols;
+        for (size_t j = 0; j < no; ++j) {
+          std::shared_ptr<arrow::Buffer> buf =
+            Value(arrow::AllocateBuffer(int64_t(n * sizeof(double))));
+          double* v = reinterpret_cast<double*>(buf->mutable_data());
+          for (size_t i = 0; i < n; ++i)
+            v[i] = double(out[i * no + j]);
+          cols.push_back(std::make_shared<arrow::DoubleArray>(int64_t(n),
+                                                              buf));
+        }
+        auto batch = arrow::RecordBatch::Make(_schema, int64_t(n), cols);
+#if GEOGRAPHICLIB_HAVE_PARQUET
+        if (_parquet) {
+          Check(_parquet->WriteRecordBatch(*batch));
+          return;
+        }
+#endif
+        Check(_writer->WriteRecordBatch(*batch));
+#else
+        (void)n; (void)out;
+#endif
+      }
+
+      /**
+       * Finish the table and close the file.
+       *
+       * @exception GeographicErr if the output can't be written.
+       **********************************************************************/
+      void Close() {
+#if GEOGRAPHICLIB_HAVE_ARROW
+#if GEOGRAPHICLIB_HAVE_PARQUET
+        if (_parquet) Check(_parquet->Close());
+#endif
+        if (_writer) Check(_writer->Close());
+        Check(_out->Close());
+#endif
+      }
+    };
+
+    /**
+     * Process the records of an Arrow table.
+     *
+     * @tparam F the type of the function object.
+     * @param[in] ifile the name of the input file.
+     * @param[in] ofile the name of the output file.
+     * @param[in] nin the number of values in each input record.
+     * @param[in] names the names of the output columns; the size of this
+     *   gives the number of values in each output record.
+     * @param[in] nthreads the number of threads to use; if \e nthreads
+     *   &le; 1 all the work is done on the calling thread.
+     * @param[in] process the function object converting a group of
+     *   records, as for LineProcessor::ProcessBinaryBlocks.
+     * @return 0 if all the records were converted successfully, otherwise 1.
+     * @exception GeographicErr if Arrow support is not available or if there
+     *   are errors in reading or writing the tables.
+     * @exception any exception thrown by \e process.
+     *
+     * Each record batch is split into pieces which are converted
+     * concurrently.
+     **********************************************************************/
+    template<class F>
+    static int Process(const std::string& ifile, const std::string& ofile,
+                       int nin, const std::vector<std::string>& names,
+                       int nthreads, F process) {
+      int retval = 0;
+      const size_t nt = size_t((std::max)(1, nthreads)),
+        ni = size_t(nin), no = names.size();
+      Reader reader(ifile);
+      Writer writer(ofile, names);
+      std::vector<real> in, out;
+      std::vector<int> rets(nt);
+      for (size_t k; (k = reader.Next(nin, in)) > 0;) {
+        out.resize(k * no);
+        size_t nused = LineProcessor::Dispatch
+          (k, nt, [&](size_t t, size_t b, size_t e) {
+            F f(process);
+            rets[t] = f(e - b, &in[b * ni], &out[b * no]) ? 1 : 0;
+          });
+        for (size_t t = 0; t < nused; ++t)
+          retval |= rets[t];
+        writer.Write(k, out.data());
+      }
+      writer.Close();
+      return retval;
+    }
+
+    /**
+     * Process the records of an Arrow table one at a time.
+     *
+     * @tparam F the type of the function object.
+     * @param[in] ifile the name of the input file.
+     * @param[in] ofile the name of the output file.
+     * @param[in] nin the number of values in each input record.
+     * @param[in] names the names of the output columns.
+     * @param[in] nthreads the number of threads to use.
+     * @param[in] process the function object converting a single record,
+     *   as for LineProcessor::ProcessBinary.
+     * @return 0 if all the records were converted successfully, otherwise 1.
+     * @exception GeographicErr if Arrow support is not available or if there
+     *   are errors in reading or writing the tables.
+     * @exception any exception thrown by \e process.
+     **********************************************************************/
+    template<class F>
+    static int ProcessRecords(const std::string& ifile,
+                              const std::string& ofile, int nin,
+                              const std::vector<std::string>& names,
+                              int nthreads, F process) {
+      const size_t ni = size_t(nin), no = names.size();
+      auto group = [process, ni, no](size_t n, const real in[], real out[])
+        mutable -> int {
+        int r = 0;
+        for (size_t i = 0; i < n; ++i)
+          r |= process(in + i * ni, out + i * no) ? 1 : 0;
+        return r;
+      };
+      return Process(ifile, ofile, nin, names, nthreads, group);
+    }
+
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_ARROWPROCESSOR_HPP
@@ -13,10 +13,13 @@
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <cmath>
 #include <GeographicLib/Geocentric.hpp>
 #include <GeographicLib/LocalCartesian.hpp>
 #include <GeographicLib/DMS.hpp>
 #include <GeographicLib/Utility.hpp>
+#include "LineProcessor.hpp"
+#include "ArrowProcessor.hpp"
 
 #if defined(_MSC_VER)
 // Squelch warnings about constant conditional expressions and potentially
@@ -31,11 +34,12 @@ int main(int argc, const char* const argv[]) {
     using namespace GeographicLib;
     typedef Math::real real;
     Utility::set_digits();
-    bool localcartesian = false, reverse = false, longfirst = false;
+    bool localcartesian = false, reverse = false, longfirst = false,
+      binary = false, arrow = false;
     real
       a = Constants::WGS84_a(),
       f = Constants::WGS84_f();
-    int prec = 6;
+    int prec = 6, nthreads = 1;
     real lat0 = 0, lon0 = 0, h0 = 0;
     std::string istring, ifile, ofile, cdelim;
     char lsep = ';';
@@ -79,7 +83,20 @@ int main(int argc, const char* const argv[]) {
           std::cerr << "Precision " << argv[m] << " is not a number\n";
           return 1;
         }
-      }  else if (arg == "--input-string") {
+      } else if (arg == "-j") {
+        if (++m == argc) return usage(1, true);
+        try {
+          nthreads = LineProcessor::NumThreads(std::string(argv[m]));
+        }
+        catch (const std::exception& e) {
+          std::cerr << "Error decoding argument of -j: " << e.what() << "\n";
+          return 1;
+        }
+      } else if (arg == "--binary")
+        binary = true;
+      else if (arg == "--arrow")
+        arrow = binary = true;
+      else if (arg == "--input-string") {
         if (++m == argc) return usage(1, true);
         istring = argv[m];
       } else if (arg == "--input-file") {
@@ -110,11 +127,21 @@ int main(int argc, const char* const argv[]) {
       std::cerr << "Cannot specify --input-string and --input-file together\n";
       return 1;
     }
+    if (arrow && !istring.empty()) {
+      std::cerr << "Cannot specify --input-string and --arrow together\n";
+      return 1;
+    }
+    if (binary && !istring.empty()) {
+      std::cerr << "Cannot specify --input-string and --binary together\n";
+      return 1;
+    }
     if (ifile == "-") ifile.clear();
     std::ifstream infile;
     std::istringstream instring;
-    if (!ifile.empty()) {
-      infile.open(ifile.c_str());
+    // With --arrow, the files are opened by ArrowProcessor.
+    if (!ifile.empty() && !arrow) {
+      infile.open(ifile.c_str(), binary ? std::ios::in | std::ios::binary :
+                  std::ios::in);
       if (!infile.is_open()) {
         std::cerr << "Cannot open " << ifile << " for reading\n";
         return 1;
@@ -134,8 +161,9 @@ int main(int argc, const char* const argv[]) {
 
     std::ofstream outfile;
     if (ofile == "-") ofile.clear();
-    if (!ofile.empty()) {
-      outfile.open(ofile.c_str());
+    if (!ofile.empty() && !arrow) {
+      outfile.open(ofile.c_str(), binary ? std::ios::out | std::ios::binary :
+                   std::ios::out);
       if (!outfile.is_open()) {
         std::cerr << "Cannot open " << ofile << " for writing\n";
         return 1;
@@ -146,13 +174,59 @@ int main(int argc, const char* const argv[]) {
     const Geocentric ec(a, f);
     const LocalCartesian lc(lat0, lon0, h0, ec);
 
+    if (binary) {
+      // Each record contains the numbers which would appear on an input or
+      // output line; angles are in degrees and the output is not rounded.
+      auto process = [=, &ec, &lc](const real in[], real out[]) -> int {
+        real lat, lon, h, x, y, z;
+        try {
+          if (reverse) {
+            x = in[0]; y = in[1]; z = in[2];
+            if (localcartesian)
+              lc.Reverse(x, y, z, lat, lon, h);
+            else
+              ec.Reverse(x, y, z, lat, lon, h);
+            out[0] = longfirst ? lon : lat; out[1] = longfirst ? lat : lon;
+            out[2] = h;
+          } else {
+            lat = in[longfirst ? 1 : 0]; lon = in[longfirst ? 0 : 1];
+            h = in[2];
+            if (!(std::fabs(lat) <= Math::qd))
+              throw GeographicErr("Latitude not in [-" + std::to_string(Math::qd)
+                                  + "d, " + std::to_string(Math::qd) + "d]");
+            if (localcartesian)
+              lc.Forward(lat, lon, h, x, y, z);
+            else
+              ec.Forward(lat, lon, h, x, y, z);
+            out[0] = x; out[1] = y; out[2] = z;
+          }
+        }
+        catch (const std::exception&) {
+          out[0] = out[1] = out[2] = Math::NaN();
+          return 1;
+        }
+        return 0;
+      };
+      if (arrow) {
+        // The column names for the output records
+        std::vector<std::string> names;
+        if (reverse)
+          names = {longfirst ? "lon" : "lat", longfirst ? "lat" : "lon", "h"};
+        else
+          names = {"x", "y", "z"};
+        return ArrowProcessor::ProcessRecords(ifile, ofile, 3, names,
+                                              nthreads, process);
+      }
+      return LineProcessor::ProcessBinary(*input, *output, 3, 3, nthreads,
+                                          process);
+    }
+
     // Max precision = 10: 0.1 nm in distance, 10^-15 deg (= 0.11 nm),
     // 10^-11 sec (= 0.3 nm).
     prec = std::min(10 + Math::extra_digits(), std::max(0, prec));
-    std::string s, eol, stra, strb, strc, strd;
-    std::istringstream str;
-    int retval = 0;
-    while (std::getline(*input, s)) {
+    auto process = [=, &ec, &lc](std::string s, std::ostream& out) -> int {
+      std::string eol, stra, strb, strc, strd;
+      std::istringstream str;
       try {
         eol = "\n";
         if (!cdelim.empty()) {
@@ -182,25 +256,26 @@ int main(int argc, const char* const argv[]) {
             lc.Reverse(x, y, z, lat, lon, h);
           else
             ec.Reverse(x, y, z, lat, lon, h);
-          *output << Utility::str(longfirst ? lon : lat, prec + 5) << " "
-                  << Utility::str(longfirst ? lat : lon, prec + 5) << " "
-                  << Utility::str(h, prec) << eol;
+          out << Utility::str(longfirst ? lon : lat, prec + 5) << " "
+              << Utility::str(longfirst ? lat : lon, prec + 5) << " "
+              << Utility::str(h, prec) << eol;
         } else {
           if (localcartesian)
             lc.Forward(lat, lon, h, x, y, z);
           else
             ec.Forward(lat, lon, h, x, y, z);
-          *output << Utility::str(x, prec) << " "
-                  << Utility::str(y, prec) << " "
-                  << Utility::str(z, prec) << eol;
+          out << Utility::str(x, prec) << " "
+              << Utility::str(y, prec) << " "
+              << Utility::str(z, prec) << eol;
         }
       }
       catch (const std::exception& e) {
-        *output << "ERROR: " << e.what() << "\n";
-        retval = 1;
+        out << "ERROR: " << e.what() << "\n";
+        return 1;
       }
-    }
-    return retval;
+      return 0;
+    };
+    return LineProcessor::Process(*input, *output, nthreads, process);
   }
   catch (const std::exception& e) {
     std::cerr << "Caught exception: " << e.what() << "\n";
@@ -17,6 +17,8 @@
 #include <GeographicLib/DMS.hpp>
 #include <GeographicLib/Utility.hpp>
 #include <GeographicLib/MGRS.hpp>
+#include "LineProcessor.hpp"
+#include "ArrowProcessor.hpp"
 
 #if defined(_MSC_VER)
 // Squelch warnings about constant conditional expressions
@@ -33,8 +35,9 @@ int main(int argc, const char* const argv[]) {
     enum { GEOGRAPHIC, DMS, UTMUPS, MGRS, CONVERGENCE };
     int outputmode = GEOGRAPHIC;
     int prec = 0;
-    int zone = UTMUPS::MATCH;
-    bool centerp = true, longfirst = false;
+    int zone = UTMUPS::MATCH, nthreads = 1;
+    bool centerp = true, longfirst = false, binary = false,
+      arrow = false;
     std::string istring, ifile, ofile, cdelim;
     char lsep = ';', dmssep = char(0);
     bool sethemisphere = false, northp = false, abbrev = true, latch = false;
@@ -110,6 +113,19 @@ int main(int argc, const char* const argv[]) {
         abbrev = false;
       else if (arg == "-a")
         abbrev = true;
+      else if (arg == "-j") {
+        if (++m == argc) return usage(1, true);
+        try {
+          nthreads = LineProcessor::NumThreads(std::string(argv[m]));
+        }
+        catch (const std::exception& e) {
+          std::cerr << "Error decoding argument of -j: " << e.what() << "\n";
+          return 1;
+        }
+      } else if (arg == "--binary")
+        binary = true;
+      else if (arg == "--arrow")
+        arrow = binary = true;
       else if (arg == "--input-string") {
         if (++m == argc) return usage(1, true);
         istring = argv[m];
@@ -142,11 +158,25 @@ int main(int argc, const char* const argv[]) {
       std::cerr << "Cannot specify --input-string and --input-file together\n";
       return 1;
     }
+    if (arrow && !istring.empty()) {
+      std::cerr << "Cannot specify --input-string and --arrow together\n";
+      return 1;
+    }
+    if (binary && !istring.empty()) {
+      std::cerr << "Cannot specify --input-string and --binary together\n";
+      return 1;
+    }
+    if (binary && outputmode == MGRS) {
+      std::cerr << "Cannot specify -m and --binary together\n";
+      return 1;
+    }
     if (ifile == "-") ifile.clear();
     std::ifstream infile;
     std::istringstream instring;
-    if (!ifile.empty()) {
-      infile.open(ifile.c_str());
+    // With --arrow, the files are opened by ArrowProcessor.
+    if (!ifile.empty() && !arrow) {
+      infile.open(ifile.c_str(), binary ? std::ios::in | std::ios::binary :
+                  std::ios::in);
       if (!infile.is_open()) {
         std::cerr << "Cannot open " << ifile << " for reading\n";
         return 1;
@@ -166,8 +196,9 @@ int main(int argc, const char* const argv[]) {
 
     std::ofstream outfile;
     if (ofile == "-") ofile.clear();
-    if (!ofile.empty()) {
-      outfile.open(ofile.c_str());
+    if (!ofile.empty() && !arrow) {
+      outfile.open(ofile.c_str(), binary ? std::ios::out | std::ios::binary :
+                   std::ios::out);
       if (!outfile.is_open()) {
         std::cerr << "Cannot open " << ofile << " for writing\n";
         return 1;
@@ -175,13 +206,73 @@ int main(int argc, const char* const argv[]) {
     }
     std::ostream* output = !ofile.empty() ? &outfile : &std::cout;
 
-    GeoCoords p;
-    std::string s, eol;
-    std::string os;
-    int retval = 0;
+    // The latching of the zone makes the results depend on the order of the
+    // records, so do this on one thread.  Otherwise the zone, northp, and
+    // sethemisphere are only read by the threads.
+    if (latch) nthreads = 1;
+    if (binary) {
+      // The input records are geographic coordinates, latitude and longitude
+      // (swapped with -w) in degrees.  The output records are latitude and
+      // longitude (-g, -d, -:), zone, hemisphere (1 = north, 0 = south),
+      // easting, and northing (-u), or convergence and scale (-c).
+      const int nout = outputmode == UTMUPS ? 4 : 2;
+      auto process = [&](const real in[], real out[]) -> int {
+        try {
+          GeoCoords p;
+          p.Reset(in[longfirst ? 1 : 0], in[longfirst ? 0 : 1]);
+          p.SetAltZone(zone);
+          switch (outputmode) {
+          case UTMUPS:
+            {
+              real x = p.AltEasting(), y = p.AltNorthing();
+              int zonex = p.AltZone();
+              bool northpx = sethemisphere ? northp : p.Northp();
+              UTMUPS::Transfer(zonex, p.Northp(), x, y,
+                               zonex, northpx, x, y, zonex);
+              out[0] = real(zonex); out[1] = northpx ? 1 : 0;
+              out[2] = x; out[3] = y;
+            }
+            break;
+          case CONVERGENCE:
+            out[0] = p.AltConvergence(); out[1] = p.AltScale();
+            break;
+          default:
+            out[0] = longfirst ? p.Longitude() : p.Latitude();
+            out[1] = longfirst ? p.Latitude() : p.Longitude();
+          }
+          if (latch &&
+              zone < UTMUPS::MINZONE && p.AltZone() >= UTMUPS::MINZONE) {
+            zone = p.AltZone();
+            northp = p.Northp();
+            sethemisphere = true;
+            latch = false;
+          }
+        }
+        catch (const std::exception&) {
+          for (int i = 0; i < nout; ++i) out[i] = Math::NaN();
+          return 1;
+        }
+        return 0;
+      };
+      if (arrow) {
+        // The column names for the output records
+        std::vector<std::string> names;
+        if (outputmode == UTMUPS)
+          names = {"zone", "northp", "easting", "northing"};
+        else if (outputmode == CONVERGENCE)
+          names = {"gamma", "k"};
+        else
+          names = {longfirst ? "lon" : "lat", longfirst ? "lat" : "lon"};
+        return ArrowProcessor::ProcessRecords(ifile, ofile, 2, names,
+                                              nthreads, process);
+      }
+      return LineProcessor::ProcessBinary(*input, *output, 2, nout,
+                                          nthreads, process);
+    }
 
-    while (std::getline(*input, s)) {
-      eol = "\n";
+    auto process = [&](std::string s, std::ostream& out) -> int {
+      std::string eol("\n"), os;
+      int retval = 0;
       try {
         if (!cdelim.empty()) {
           std::string::size_type m = s.find(cdelim);
@@ -190,7 +281,7 @@ int main(int argc, const char* const argv[]) {
             s = s.substr(0, m);
           }
         }
-        p.Reset(s, centerp, longfirst);
+        GeoCoords p(s, centerp, longfirst);
         p.SetAltZone(zone);
         switch (outputmode) {
         case GEOGRAPHIC:
@@ -230,9 +321,10 @@ int main(int argc, const char* const argv[]) {
         os = std::string("ERROR: ") + e.what();
         retval = 1;
       }
-      *output << os << eol;
-    }
-    return retval;
+      out << os << eol;
+      return retval;
+    };
+    return LineProcessor::Process(*input, *output, nthreads, process);
   }
   catch (const std::exception& e) {
     std::cerr << "Caught exception: " << e.what() << "\n";
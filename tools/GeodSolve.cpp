@@ -17,6 +17,8 @@
 #include <GeographicLib/GeodesicLine.hpp>
 #include <GeographicLib/DMS.hpp>
 #include <GeographicLib/Utility.hpp>
+#include "LineProcessor.hpp"
+#include "ArrowProcessor.hpp"
 
 #if defined(_MSC_VER)
 // Squelch warnings about constant conditional expressions and potentially
@@ -73,13 +75,17 @@ int main(int argc, const char* const argv[]) {
     bool inverse = false, arcmode = false,
       dms = false, full = false, exact = false, unroll = false,
       longfirst = false, azi2back = false, fraction = false,
-      arcmodeline = false;
+      arcmodeline = false, binary = false, arrow = false;
     real
       a = Constants::WGS84_a(),
       f = Constants::WGS84_f();
     real lat1, lon1, azi1, lat2, lon2, azi2, s12, m12, a12, M12, M21, S12,
       mult = 1;
-    int linecalc = NONE, prec = 3;
+    // These are captured by value by the line-processing function below, so
+    // initialize them to avoid copying uninitialized values.
+    lat1 = lon1 = azi1 = lat2 = lon2 = azi2 = s12 = m12 = a12 =
+      M12 = M21 = S12 = Math::NaN();
+    int linecalc = NONE, prec = 3, nthreads = 1;
     std::string istring, ifile, ofile, cdelim;
     char lsep = ';', dmssep = char(0);
 
@@ -173,6 +179,19 @@ int main(int argc, const char* const argv[]) {
         }
       } else if (arg == "-E")
         exact = true;
+      else if (arg == "-j") {
+        if (++m == argc) return usage(1, true);
+        try {
+          nthreads = LineProcessor::NumThreads(std::string(argv[m]));
+        }
+        catch (const std::exception& e) {
+          std::cerr << "Error decoding argument of -j: " << e.what() << "\n";
+          return 1;
+        }
+      } else if (arg == "--binary")
+        binary = true;
+      else if (arg == "--arrow")
+        arrow = binary = true;
       else if (arg == "--input-string") {
         if (++m == argc) return usage(1, true);
         istring = argv[m];
@@ -204,11 +223,21 @@ int main(int argc, const char* const argv[]) {
       std::cerr << "Cannot specify --input-string and --input-file together\n";
       return 1;
     }
+    if (arrow && !istring.empty()) {
+      std::cerr << "Cannot specify --input-string and --arrow together\n";
+      return 1;
+    }
+    if (binary && !istring.empty()) {
+      std::cerr << "Cannot specify --input-string and --binary together\n";
+      return 1;
+    }
     if (ifile == "-") ifile.clear();
     std::ifstream infile;
     std::istringstream instring;
-    if (!ifile.empty()) {
-      infile.open(ifile.c_str());
+    // With --arrow, the files are opened by ArrowProcessor.
+    if (!ifile.empty() && !arrow) {
+      infile.open(ifile.c_str(), binary ? std::ios::in | std::ios::binary :
+                  std::ios::in);
       if (!infile.is_open()) {
         std::cerr << "Cannot open " << ifile << " for reading\n";
         return 1;
@@ -228,8 +257,9 @@ int main(int argc, const char* const argv[]) {
 
     std::ofstream outfile;
     if (ofile == "-") ofile.clear();
-    if (!ofile.empty()) {
-      outfile.open(ofile.c_str());
+    if (!ofile.empty() && !arrow) {
+      outfile.open(ofile.c_str(), binary ? std::ios::out | std::ios::binary :
+                   std::ios::out);
       if (!outfile.is_open()) {
         std::cerr << "Cannot open " << ofile << " for writing\n";
         return 1;
@@ -262,13 +292,92 @@ int main(int argc, const char* const argv[]) {
       if (linecalc == INVERSE) azi1 = ls.Azimuth();
     }
 
+    if (binary) {
+      // Each record contains the numbers which would appear on an input or
+      // output line; angles are in degrees and the output is not rounded.
+      // Latitudes outside [-90d, 90d] give NaN results (instead of errors).
+      const int nin = !inverse && linecalc ? 1 : 4, nout = full ? 12 : 3;
+      auto process = [=, &geods, &ls](const real in[], real out[])
+        mutable -> int {
+        try {
+          if (inverse) {
+            lat1 = in[longfirst ? 1 : 0]; lon1 = in[longfirst ? 0 : 1];
+            lat2 = in[longfirst ? 3 : 2]; lon2 = in[longfirst ? 2 : 3];
+            a12 = geods.GenInverse(lat1, lon1, lat2, lon2, outmask,
+                                   s12, azi1, azi2, m12, M12, M21, S12);
+            if (unroll) {
+              real e;
+              lon2 = lon1 + Math::AngDiff(lon1, lon2, e);
+              lon2 += e;
+            } else {
+              lon1 = Math::AngNormalize(lon1);
+              lon2 = Math::AngNormalize(lon2);
+            }
+          } else if (linecalc) {
+            s12 = in[0] * mult;
+            a12 = ls.GenPosition(arcmode, s12, outmask,
+                                 lat2, lon2, azi2, s12, m12, M12, M21, S12);
+          } else {
+            lat1 = in[longfirst ? 1 : 0]; lon1 = in[longfirst ? 0 : 1];
+            azi1 = in[2]; s12 = in[3];
+            a12 = geods.GenDirect(lat1, lon1, azi1, arcmode, s12, outmask,
+                                  lat2, lon2, azi2, s12, m12, M12, M21, S12);
+            if (!unroll) lon1 = Math::AngNormalize(lon1);
+          }
+          if (azi2back) {
+            using std::copysign;
+            azi2 = copysign(azi2 + copysign(real(Math::hd), -azi2), -azi2);
+          }
+          if (full) {
+            out[0] = longfirst ? lon1 : lat1; out[1] = longfirst ? lat1 : lon1;
+            out[2] = azi1;
+            out[3] = longfirst ? lon2 : lat2; out[4] = longfirst ? lat2 : lon2;
+            out[5] = azi2;
+            out[6] = s12; out[7] = a12; out[8] = m12;
+            out[9] = M12; out[10] = M21; out[11] = S12;
+          } else if (inverse) {
+            out[0] = azi1; out[1] = azi2; out[2] = arcmode ? a12 : s12;
+          } else {
+            out[0] = longfirst ? lon2 : lat2; out[1] = longfirst ? lat2 : lon2;
+            out[2] = azi2;
+          }
+        }
+        catch (const std::exception&) {
+          for (int i = 0; i < nout; ++i) out[i] = Math::NaN();
+          return 1;
+        }
+        return 0;
+      };
+      if (arrow) {
+        // The column names for the output records
+        std::vector<std::string> names;
+        if (full)
+          names = {longfirst ? "lon1" : "lat1", longfirst ? "lat1" : "lon1",
+                   "azi1",
+                   longfirst ? "lon2" : "lat2", longfirst ? "lat2" : "lon2",
+                   "azi2", "s12", "a12", "m12", "M12", "M21", "S12"};
+        else if (inverse)
+          names = {"azi1", "azi2", arcmode ? "a12" : "s12"};
+        else
+          names = {longfirst ? "lon2" : "lat2", longfirst ? "lat2" : "lon2",
+                   "azi2"};
+        return ArrowProcessor::ProcessRecords(ifile, ofile, nin, names,
+                                              nthreads, process);
+      }
+      return LineProcessor::ProcessBinary(*input, *output, nin, nout,
+                                          nthreads, process);
+    }
+
     // Max precision = 10: 0.1 nm in distance, 10^-15 deg (= 0.11 nm),
     // 10^-11 sec (= 0.3 nm).
     prec = std::min(10 + Math::extra_digits(), std::max(0, prec));
-    std::string s, eol, slat1, slon1, slat2, slon2, sazi1, ss12, strc;
-    std::istringstream str;
-    int retval = 0;
-    while (std::getline(*input, s)) {
+    std::string eol, slat1, slon1, slat2, slon2, sazi1, ss12, strc;
+    // Each thread works on its own copy of this function object (with its own
+    // copies of the scratch variables captured by value).
+    auto process = [=, &geods, &ls](const std::string& line,
+                                    std::ostream& out) mutable -> int {
+      std::string s(line);
+      std::istringstream str;
       try {
         eol = "\n";
         if (!cdelim.empty()) {
@@ -297,27 +406,27 @@ int main(int argc, const char* const argv[]) {
               lon1 = Math::AngNormalize(lon1);
               lon2 = Math::AngNormalize(lon2);
             }
-            *output << LatLonString(lat1, lon1, prec, dms, dmssep, longfirst)
-                    << " ";
+            out << LatLonString(lat1, lon1, prec, dms, dmssep, longfirst)
+                << " ";
           }
-          *output << AzimuthString(azi1, prec, dms, dmssep) << " ";
+          out << AzimuthString(azi1, prec, dms, dmssep) << " ";
           if (full)
-            *output << LatLonString(lat2, lon2, prec, dms, dmssep, longfirst)
-                    << " ";
+            out << LatLonString(lat2, lon2, prec, dms, dmssep, longfirst)
+                << " ";
           if (azi2back) {
             using std::copysign;
             // map +/-0 -> -/+180; +/-180 -> -/+0
             // this depends on abs(azi2) <= 180
             azi2 = copysign(azi2 + copysign(real(Math::hd), -azi2), -azi2);
           }
-          *output << AzimuthString(azi2, prec, dms, dmssep) << " "
-                  << DistanceStrings(s12, a12, full, arcmode, prec, dms);
+          out << AzimuthString(azi2, prec, dms, dmssep) << " "
+              << DistanceStrings(s12, a12, full, arcmode, prec, dms);
           if (full)
-            *output << " " << Utility::str(m12, prec)
-                    << " " << Utility::str(M12, prec+7)
-                    << " " << Utility::str(M21, prec+7)
-                    << " " << Utility::str(S12, std::max(prec-7, 0));
-          *output << eol;
+            out << " " << Utility::str(m12, prec)
+                << " " << Utility::str(M12, prec+7)
+                << " " << Utility::str(M21, prec+7)
+                << " " << Utility::str(S12, std::max(prec-7, 0));
+          out << eol;
         } else {
           if (linecalc) {
             if (!(str >> ss12))
@@ -340,7 +449,7 @@ int main(int argc, const char* const argv[]) {
                                   lat2, lon2, azi2, s12, m12, M12, M21, S12);
           }
           if (full)
-            *output
+            out
               << LatLonString(lat1, unroll ? lon1 : Math::AngNormalize(lon1),
                               prec, dms, dmssep, longfirst)
               << " " << AzimuthString(azi1, prec, dms, dmssep) << " ";
@@ -350,25 +459,26 @@ int main(int argc, const char* const argv[]) {
             // this depends on abs(azi2) <= 180
             azi2 = copysign(azi2 + copysign(real(Math::hd), -azi2), -azi2);
           }
-          *output << LatLonString(lat2, lon2, prec, dms, dmssep, longfirst)
-                  << " " << AzimuthString(azi2, prec, dms, dmssep);
+          out << LatLonString(lat2, lon2, prec, dms, dmssep, longfirst)
+              << " " << AzimuthString(azi2, prec, dms, dmssep);
           if (full)
-            *output << " "
-                    << DistanceStrings(s12, a12, full, arcmode, prec, dms)
-                    << " " << Utility::str(m12, prec)
-                    << " " << Utility::str(M12, prec+7)
-                    << " " << Utility::str(M21, prec+7)
-                    << " " << Utility::str(S12, std::max(prec-7, 0));
-          *output << eol;
+            out << " "
+                << DistanceStrings(s12, a12, full, arcmode, prec, dms)
+                << " " << Utility::str(m12, prec)
+                << " " << Utility::str(M12, prec+7)
+                << " " << Utility::str(M21, prec+7)
+                << " " << Utility::str(S12, std::max(prec-7, 0));
+          out << eol;
         }
       }
       catch (const std::exception& e) {
         // Write error message cout so output lines match input lines
-        *output << "ERROR: " << e.what() << "\n";
-        retval = 1;
+        out << "ERROR: " << e.what() << "\n";
+        return 1;
       }
-    }
-    return retval;
+      return 0;
+    };
+    return LineProcessor::Process(*input, *output, nthreads, process);
   }
   catch (const std::exception& e) {
     std::cerr << "Caught exception: " << e.what() << "\n";
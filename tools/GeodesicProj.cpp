@@ -13,12 +13,14 @@
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <vector>
 #include <GeographicLib/Geodesic.hpp>
 #include <GeographicLib/AzimuthalEquidistant.hpp>
 #include <GeographicLib/CassiniSoldner.hpp>
 #include <GeographicLib/Gnomonic.hpp>
 #include <GeographicLib/DMS.hpp>
 #include <GeographicLib/Utility.hpp>
+#include "LineProcessor.hpp"
 
 #if defined(_MSC_VER)
 // Squelch warnings about constant conditional expressions and potentially
@@ -34,12 +36,13 @@ int main(int argc, const char* const argv[]) {
     typedef Math::real real;
     Utility::set_digits();
     bool azimuthal = false, cassini = false, gnomonic = false, reverse = false,
-      longfirst = false;
+      longfirst = false,
+      binary = false;
     real lat0 = 0, lon0 = 0;
     real
       a = Constants::WGS84_a(),
       f = Constants::WGS84_f();
-    int prec = 6;
+    int prec = 6, nthreads = 1;
     std::string istring, ifile, ofile, cdelim;
     char lsep = ';';
 
@@ -85,7 +88,18 @@ int main(int argc, const char* const argv[]) {
           std::cerr << "Precision " << argv[m] << " is not a number\n";
           return 1;
         }
-      } else if (arg == "--input-string") {
+      } else if (arg == "-j") {
+        if (++m == argc) return usage(1, true);
+        try {
+          nthreads = LineProcessor::NumThreads(std::string(argv[m]));
+        }
+        catch (const std::exception& e) {
+          std::cerr << "Error decoding argument of -j: " << e.what() << "\n";
+          return 1;
+        }
+      } else if (arg == "--binary")
+        binary = true;
+      else if (arg == "--input-string") {
         if (++m == argc) return usage(1, true);
         istring = argv[m];
       } else if (arg == "--input-file") {
@@ -116,11 +130,16 @@ int main(int argc, const char* const argv[]) {
       std::cerr << "Cannot specify --input-string and --input-file together\n";
       return 1;
     }
+    if (binary && !istring.empty()) {
+      std::cerr << "Cannot specify --input-string and --binary together\n";
+      return 1;
+    }
     if (ifile == "-") ifile.clear();
     std::ifstream infile;
     std::istringstream instring;
     if (!ifile.empty()) {
-      infile.open(ifile.c_str());
+      infile.open(ifile.c_str(), binary ? std::ios::in | std::ios::binary :
+                  std::ios::in);
       if (!infile.is_open()) {
         std::cerr << "Cannot open " << ifile << " for reading\n";
         return 1;
@@ -141,7 +160,8 @@ int main(int argc, const char* const argv[]) {
     std::ofstream outfile;
     if (ofile == "-") ofile.clear();
     if (!ofile.empty()) {
-      outfile.open(ofile.c_str());
+      outfile.open(ofile.c_str(), binary ? std::ios::out | std::ios::binary :
+                   std::ios::out);
       if (!outfile.is_open()) {
         std::cerr << "Cannot open " << ofile << " for writing\n";
         return 1;
@@ -161,14 +181,61 @@ int main(int argc, const char* const argv[]) {
     const AzimuthalEquidistant az(geod);
     const Gnomonic gn(geod);
 
+    if (binary) {
+      // Each record contains the 2 numbers which would appear on an input
+      // line and the 4 numbers which would appear on an output line; angles
+      // are in degrees and the output is not rounded.  The records of a
+      // block are passed to the array versions of Forward and Reverse.
+      auto process = [=, &cs, &az, &gn](size_t n, const real in[], real out[])
+        -> int {
+        std::vector<real> u(n), v(n), p(n), q(n), azi(n), rk(n);
+        int retval = 0;
+        const bool swap = longfirst && !reverse;
+        for (size_t i = 0; i < n; ++i) {
+          u[i] = in[2*i + (swap ? 1 : 0)]; v[i] = in[2*i + (swap ? 0 : 1)];
+          // Latitudes outside [-90d, 90d] give NaN results (and an error).
+          if (!reverse && std::fabs(u[i]) > Math::qd) {
+            u[i] = Math::NaN(); retval = 1;
+          }
+        }
+        if (reverse)
+          (cassini ? cs.Reverse(n, u.data(), v.data(), p.data(), q.data(),
+                                azi.data(), rk.data()) :
+           azimuthal ? az.Reverse(lat0, lon0, n, u.data(), v.data(),
+                                  p.data(), q.data(), azi.data(), rk.data()) :
+           gn.Reverse(lat0, lon0, n, u.data(), v.data(),
+                      p.data(), q.data(), azi.data(), rk.data()));
+        else
+          (cassini ? cs.Forward(n, u.data(), v.data(), p.data(), q.data(),
+                                azi.data(), rk.data()) :
+           azimuthal ? az.Forward(lat0, lon0, n, u.data(), v.data(),
+                                  p.data(), q.data(), azi.data(), rk.data()) :
+           gn.Forward(lat0, lon0, n, u.data(), v.data(),
+                      p.data(), q.data(), azi.data(), rk.data()));
+        for (size_t i = 0; i < n; ++i) {
+          real* o = out + 4*i;
+          if (!reverse && std::isnan(u[i]))
+            o[0] = o[1] = o[2] = o[3] = Math::NaN();
+          else {
+            const bool swapo = longfirst && reverse;
+            o[0] = swapo ? q[i] : p[i]; o[1] = swapo ? p[i] : q[i];
+            o[2] = azi[i]; o[3] = rk[i];
+          }
+        }
+        return retval;
+      };
+      return LineProcessor::ProcessBinaryBlocks(*input, *output, 2, 4,
+                                                nthreads, process);
+    }
+
     // Max precision = 10: 0.1 nm in distance, 10^-15 deg (= 0.11 nm),
     // 10^-11 sec (= 0.3 nm).
     prec = std::min(10 + Math::extra_digits(), std::max(0, prec));
-    std::string s, eol, stra, strb, strc;
-    std::istringstream str;
-    int retval = 0;
     std::cout << std::fixed;
-    while (std::getline(*input, s)) {
+    auto process = [=, &cs, &az, &gn](std::string s, std::ostream& out)
+      -> int {
+      std::string eol, stra, strb, strc;
+      std::istringstream str;
       try {
         eol = "\n";
         if (!cdelim.empty()) {
@@ -196,10 +263,10 @@ int main(int argc, const char* const argv[]) {
             az.Reverse(lat0, lon0, x, y, lat, lon, azi, rk);
           else
             gn.Reverse(lat0, lon0, x, y, lat, lon, azi, rk);
-          *output << Utility::str(longfirst ? lon : lat, prec + 5) << " "
-                  << Utility::str(longfirst ? lat : lon, prec + 5) << " "
-                  << Utility::str(azi, prec + 5) << " "
-                  << Utility::str(rk, prec + 6) << eol;
+          out << Utility::str(longfirst ? lon : lat, prec + 5) << " "
+              << Utility::str(longfirst ? lat : lon, prec + 5) << " "
+              << Utility::str(azi, prec + 5) << " "
+              << Utility::str(rk, prec + 6) << eol;
         } else {
           if (cassini)
             cs.Forward(lat, lon, x, y, azi, rk);
@@ -207,18 +274,19 @@ int main(int argc, const char* const argv[]) {
             az.Forward(lat0, lon0, lat, lon, x, y, azi, rk);
           else
             gn.Forward(lat0, lon0, lat, lon, x, y, azi, rk);
-          *output << Utility::str(x, prec) << " "
-                  << Utility::str(y, prec) << " "
-                  << Utility::str(azi, prec + 5) << " "
-                  << Utility::str(rk, prec + 6) << eol;
+          out << Utility::str(x, prec) << " "
+              << Utility::str(y, prec) << " "
+              << Utility::str(azi, prec + 5) << " "
+              << Utility::str(rk, prec + 6) << eol;
         }
       }
       catch (const std::exception& e) {
-        *output << "ERROR: " << e.what() << "\n";
-        retval = 1;
+        out << "ERROR: " << e.what() << "\n";
+        return 1;
       }
-    }
-    return retval;
+      return 0;
+    };
+    return LineProcessor::Process(*input, *output, nthreads, process);
   }
   catch (const std::exception& e) {
     std::cerr << "Caught exception: " << e.what() << "\n";
@@ -13,10 +13,13 @@
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <vector>
 #include <GeographicLib/Geoid.hpp>
 #include <GeographicLib/DMS.hpp>
 #include <GeographicLib/Utility.hpp>
 #include <GeographicLib/GeoCoords.hpp>
+#include "LineProcessor.hpp"
+#include "ArrowProcessor.hpp"
 
 #if defined(_MSC_VER)
 // Squelch warnings about constant conditional expressions and potentially
@@ -31,37 +34,78 @@ int main(int argc, const char* const argv[]) {
     using namespace GeographicLib;
     typedef Math::real real;
     Utility::set_digits();
-    bool cacheall = false, cachearea = false, verbose = false, cubic = true;
-    real caches, cachew, cachen, cachee;
+    bool cacheall = false, verbose = false, cubic = true;
+    // The areas specified with -c as south, west, north, east
+    std::vector<real> cacheareas;
     std::string dir;
     std::string geoid = Geoid::DefaultGeoidName();
     Geoid::convertflag heightmult = Geoid::NONE;
-    std::string istring, ifile, ofile, cdelim;
+    std::string istring, ifile, ofile, cdelim, server, tiledfile;
     char lsep = ';';
     bool northp = false, longfirst = false;
-    int zonenum = UTMUPS::INVALID;
+    int zonenum = UTMUPS::INVALID, nthreads = 1;
+    bool grid = false, arrow = false;
+    // The grid specification for --grid
+    real south = 0, west = 0, north = 0, east = 0, dlat = 0, dlon = 0;
+    LineProcessor::gridformat gridfmt = LineProcessor::GTX;
 
     for (int m = 1; m < argc; ++m) {
       std::string arg(argv[m]);
       if (arg == "-a") {
         cacheall = true;
-        cachearea = false;
+        cacheareas.clear();
       }
       else if (arg == "-c") {
         if (m + 4 >= argc) return usage(1, true);
         cacheall = false;
-        cachearea = true;
         try {
+          real caches, cachew, cachen, cachee;
           DMS::DecodeLatLon(std::string(argv[m + 1]), std::string(argv[m + 2]),
                             caches, cachew, longfirst);
           DMS::DecodeLatLon(std::string(argv[m + 3]), std::string(argv[m + 4]),
                             cachen, cachee, longfirst);
+          cacheareas.push_back(caches); cacheareas.push_back(cachew);
+          cacheareas.push_back(cachen); cacheareas.push_back(cachee);
         }
         catch (const std::exception& e) {
           std::cerr << "Error decoding argument of -c: " << e.what() << "\n";
           return 1;
         }
         m += 4;
+      } else if (arg == "--grid") {
+        if (m + 6 >= argc) return usage(1, true);
+        try {
+          DMS::DecodeLatLon(std::string(argv[m + 1]), std::string(argv[m + 2]),
+                            south, west, longfirst);
+          DMS::DecodeLatLon(std::string(argv[m + 3]), std::string(argv[m + 4]),
+                            north, east, longfirst);
+          dlat = Utility::fract<real>(std::string(argv[m + 5]));
+          dlon = Utility::fract<real>(std::string(argv[m + 6]));
+          if (!(dlat > 0 && dlon > 0))
+            throw GeographicErr("Grid spacings must be positive");
+          if (!(south <= north))
+            throw GeographicErr("South edge is north of north edge");
+          grid = true;
+        }
+        catch (const std::exception& e) {
+          std::cerr << "Error decoding argument of " << arg << ": "
+                    << e.what() << "\n";
+          return 1;
+        }
+        m += 6;
+      } else if (arg == "--grid-format") {
+        if (++m == argc) return usage(1, true);
+        try {
+          gridfmt = LineProcessor::GridFormat(std::string(argv[m]));
+        }
+        catch (const std::exception& e) {
+          std::cerr << "Error decoding argument of " << arg << ": "
+                    << e.what() << "\n";
+          return 1;
+        }
+      } else if (arg == "--write-tiled") {
+        if (++m == argc) return usage(1, true);
+        tiledfile = argv[m];
       } else if (arg == "--msltohae")
         heightmult = Geoid::GEOIDTOELLIPSOID;
       else if (arg == "--haetomsl")
@@ -92,6 +136,18 @@ int main(int argc, const char* const argv[]) {
         cubic = false;
       else if (arg == "-v")
         verbose = true;
+      else if (arg == "-j") {
+        if (++m == argc) return usage(1, true);
+        try {
+          nthreads = LineProcessor::NumThreads(std::string(argv[m]));
+        }
+        catch (const std::exception& e) {
+          std::cerr << "Error decoding argument of -j: " << e.what() << "\n";
+          return 1;
+        }
+      }
+      else if (arg == "--arrow")
+        arrow = true;
       else if (arg == "--input-string") {
         if (++m == argc) return usage(1, true);
         istring = argv[m];
@@ -101,6 +157,9 @@ int main(int argc, const char* const argv[]) {
       } else if (arg == "--output-file") {
         if (++m == argc) return usage(1, true);
         ofile = argv[m];
+      } else if (arg == "--server") {
+        if (++m == argc) return usage(1, true);
+        server = argv[m];
       } else if (arg == "--line-separator") {
         if (++m == argc) return usage(1, true);
         if (std::string(argv[m]).size() != 1) {
@@ -130,10 +189,26 @@ int main(int argc, const char* const argv[]) {
       std::cerr << "Cannot specify --input-string and --input-file together\n";
       return 1;
     }
+    if (!server.empty() &&
+        (grid || !istring.empty() || !ifile.empty() || !ofile.empty())) {
+      std::cerr << "Cannot specify --server with --grid, --input-string,\n"
+                << "--input-file, or --output-file\n";
+      return 1;
+    }
+    if (arrow && (grid || zonenum != UTMUPS::INVALID || !istring.empty())) {
+      std::cerr << "Cannot specify --arrow with --grid, -z, or "
+                << "--input-string\n";
+      return 1;
+    }
+    if (grid && heightmult) {
+      std::cerr << "Cannot specify --msltohae or --haetomsl with --grid\n";
+      return 1;
+    }
     if (ifile == "-") ifile.clear();
     std::ifstream infile;
     std::istringstream instring;
-    if (!ifile.empty()) {
+    // With --arrow, the files are opened by ArrowProcessor.
+    if (!ifile.empty() && !arrow) {
       infile.open(ifile.c_str());
       if (!infile.is_open()) {
         std::cerr << "Cannot open " << ifile << " for reading\n";
@@ -154,8 +229,9 @@ int main(int argc, const char* const argv[]) {
 
     std::ofstream outfile;
     if (ofile == "-") ofile.clear();
-    if (!ofile.empty()) {
-      outfile.open(ofile.c_str());
+    if (!ofile.empty() && !arrow) {
+      outfile.open(ofile.c_str(), grid && gridfmt == LineProcessor::GTX ?
+                   std::ios::out | std::ios::binary : std::ios::out);
       if (!outfile.is_open()) {
         std::cerr << "Cannot open " << ofile << " for writing\n";
         return 1;
@@ -165,12 +241,22 @@ int main(int argc, const char* const argv[]) {
 
     int retval = 0;
     try {
-      const Geoid g(geoid, dir, cubic);
+      // A thread safe Geoid is needed for concurrent evaluation; this has no
+      // area cache.
+      const Geoid g(geoid, dir, cubic, nthreads > 1);
+      if (!tiledfile.empty()) {
+        g.WriteTiled(tiledfile);
+        return 0;
+      }
       try {
-        if (cacheall)
-          g.CacheAll();
-        else if (cachearea)
-          g.CacheArea(caches, cachew, cachen, cachee);
+        if (!g.ThreadSafe()) {
+          if (cacheall)
+            g.CacheAll();
+          else
+            for (size_t k = 0; k < cacheareas.size(); k += 4)
+              g.CacheAddArea(cacheareas[k], cacheareas[k + 1],
+                             cacheareas[k + 2], cacheareas[k + 3]);
+        }
       }
       catch (const std::exception& e) {
         std::cerr << "ERROR: " << e.what() << "\nProceeding without a cache\n";
@@ -189,78 +275,207 @@ int main(int argc, const char* const argv[]) {
             << "Caching:"
             << "\n SW Corner: " << g.CacheSouth() << " " << g.CacheWest()
             << "\n NE Corner: " << g.CacheNorth() << " " << g.CacheEast()
+            << "\n Number of areas: " << g.CacheAreas()
             << "\n";
       }
 
-      GeoCoords p;
-      std::string s, eol, suff;
+      if (grid) {
+        // Compute the grid a row at a time with the array version of
+        // Geoid::operator().
+        using std::floor; using std::fmin;
+        if (east < west) east += Math::td;
+        // Allow for roundoff in the number of intervals
+        const real eps = 8 * std::numeric_limits<real>::epsilon();
+        const size_t
+          nlat = size_t(floor((north - south) / dlat * (1 + eps))) + 1,
+          nlon = size_t(floor((east - west) / dlon * (1 + eps))) + 1;
+        std::vector<real> lats(nlon), lons(nlon);
+        for (size_t j = 0; j < nlon; ++j)
+          lons[j] = west + j * dlon;
+        auto row = [=, &g](size_t i, real vals[]) mutable -> void {
+          lats.assign(nlon, fmin(north, south + i * dlat));
+          g(nlon, lats.data(), lons.data(), vals);
+        };
+        LineProcessor::ProcessGrid(*output, south, west, dlat, dlon,
+                                   nlat, nlon, 1, nthreads, row, gridfmt, 4);
+        return retval;
+      }
+
+      if (arrow) {
+        // The input columns are latitude and longitude (swapped with -w) and,
+        // with --msltohae or --haetomsl, the height; the output column is
+        // the geoid height or the converted height.  The heights for each
+        // group of records are evaluated with a single call to the array
+        // version of Geoid::operator().
+        const int nin = heightmult ? 3 : 2;
+        std::vector<real> lats, lons;
+        auto group = [=, &g](size_t n, const real in[], real out[])
+          mutable -> int {
+          lats.resize(n); lons.resize(n);
+          for (size_t i = 0; i < n; ++i) {
+            lats[i] = in[i * nin + (longfirst ? 1 : 0)];
+            lons[i] = in[i * nin + (longfirst ? 0 : 1)];
+          }
+          g(n, lats.data(), lons.data(), out);
+          if (heightmult)
+            for (size_t i = 0; i < n; ++i)
+              out[i] = in[i * nin + 2] + real(heightmult) * out[i];
+          return 0;
+        };
+        return ArrowProcessor::Process(ifile, ofile, nin, {"height"},
+                                       nthreads, group);
+      }
+
+      // The parsed form of an input line: the position, the height, and the
+      // text echoed before and after the converted height
+      struct record {
+        real lat, lon, height;
+        std::string s, suff, eol;
+      };
       const char* spaces = " \t\n\v\f\r,"; // Include comma as space
-      while (std::getline(*input, s)) {
-        try {
-          eol = "\n";
-          if (!cdelim.empty()) {
-            std::string::size_type m = s.find(cdelim);
-            if (m != std::string::npos) {
-              eol = " " + s.substr(m) + "\n";
-              std::string::size_type m1 =
-                m > 0 ? s.find_last_not_of(spaces, m - 1) : std::string::npos;
-              s = s.substr(0, m1 != std::string::npos ? m1 + 1 : m);
-            }
+      // Parse line s into r; this throws if the line is invalid.
+      auto parse = [&](std::string s, GeoCoords& p, record& r) -> void {
+        r.eol = "\n";
+        r.suff.clear();
+        if (!cdelim.empty()) {
+          std::string::size_type m = s.find(cdelim);
+          if (m != std::string::npos) {
+            r.eol = " " + s.substr(m) + "\n";
+            std::string::size_type m1 =
+              m > 0 ? s.find_last_not_of(spaces, m - 1) : std::string::npos;
+            s = s.substr(0, m1 != std::string::npos ? m1 + 1 : m);
           }
-          real height = 0;
-          if (zonenum != UTMUPS::INVALID) {
-            // Expect "easting northing" if heightmult == 0, or
-            // "easting northing height" if heightmult != 0.
-            std::string::size_type pa = 0, pb = 0;
-            real easting = 0, northing = 0;
-            for (int i = 0; i < (heightmult ? 3 : 2); ++i) {
-              if (pb == std::string::npos)
-                throw GeographicErr("Incomplete input: " + s);
-              // Start of i'th token
-              pa = s.find_first_not_of(spaces, pb);
-              if (pa == std::string::npos)
-                throw GeographicErr("Incomplete input: " + s);
-              // End of i'th token
-              pb = s.find_first_of(spaces, pa);
-              (i == 2 ? height : (i == 0 ? easting : northing)) =
-                Utility::val<real>(s.substr(pa, (pb == std::string::npos ?
-                                                 pb : pb - pa)));
-            }
-            p.Reset(zonenum, northp, easting, northing);
-            if (heightmult) {
-              suff = pb == std::string::npos ? "" : s.substr(pb);
-              s = s.substr(0, pa);
+        }
+        r.height = 0;
+        if (zonenum != UTMUPS::INVALID) {
+          // Expect "easting northing" if heightmult == 0, or
+          // "easting northing height" if heightmult != 0.
+          std::string::size_type pa = 0, pb = 0;
+          real easting = 0, northing = 0;
+          for (int i = 0; i < (heightmult ? 3 : 2); ++i) {
+            if (pb == std::string::npos)
+              throw GeographicErr("Incomplete input: " + s);
+            // Start of i'th token
+            pa = s.find_first_not_of(spaces, pb);
+            if (pa == std::string::npos)
+              throw GeographicErr("Incomplete input: " + s);
+            // End of i'th token
+            pb = s.find_first_of(spaces, pa);
+            (i == 2 ? r.height : (i == 0 ? easting : northing)) =
+              Utility::val<real>(s.substr(pa, (pb == std::string::npos ?
+                                               pb : pb - pa)));
+          }
+          p.Reset(zonenum, northp, easting, northing);
+          if (heightmult) {
+            r.suff = pb == std::string::npos ? "" : s.substr(pb);
+            s = s.substr(0, pa);
+          }
+        } else {
+          if (heightmult) {
+            // Treat last token as height
+            // pb = last char of last token
+            // pa = last char preceding white space
+            // px = last char of 2nd last token
+            std::string::size_type pb = s.find_last_not_of(spaces);
+            std::string::size_type pa = s.find_last_of(spaces, pb);
+            if (pa == std::string::npos || pb == std::string::npos)
+              throw GeographicErr("Incomplete input: " + s);
+            r.height = Utility::val<real>(s.substr(pa + 1, pb - pa));
+            s = s.substr(0, pa + 1);
+          }
+          p.Reset(s, true, longfirst);
+        }
+        r.lat = p.Latitude();
+        r.lon = p.Longitude();
+        r.s = heightmult ? s : std::string();
+      };
+      // Write the output line for r given the geoid height h.
+      auto print = [&](const record& r, real h, std::ostream& out) -> void {
+        if (heightmult)
+          out << r.s << Utility::str(r.height + real(heightmult) * h, 4)
+              << r.suff << r.eol;
+        else
+          out << Utility::str(h, 4) << r.eol;
+      };
+
+      // With multiple threads, each thread parses its piece of a block of
+      // lines and then evaluates the heights of all its points with a single
+      // call to the array version of Geoid::operator().  This visits the grid
+      // cells in the order they are stored, so the data is read sequentially,
+      // and reuses the interpolation coefficients for points in the same
+      // cell.  The output is the same as with the serial loop.
+      GeoCoords p;
+      record r;
+      std::vector<record> recs;
+      std::vector<std::string> errs;
+      std::vector<real> lats, lons, hs;
+      auto process = [=, &g](const std::string lines[], size_t n,
+                             std::ostream& out) mutable -> int {
+        int ret = 0;
+        if (n == 1) {
+          try {
+            parse(lines[0], p, r);
+            print(r, g(r.lat, r.lon), out);
+          }
+          catch (const std::exception& e) {
+            out << "ERROR: " << e.what() << "\n";
+            ret = 1;
+          }
+          return ret;
+        }
+        recs.resize(n); errs.assign(n, std::string());
+        lats.resize(n); lons.resize(n); hs.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+          try {
+            parse(lines[i], p, recs[i]);
+            lats[i] = recs[i].lat; lons[i] = recs[i].lon;
+          }
+          catch (const std::exception& e) {
+            errs[i] = e.what();
+            // A NaN position is skipped by the array version of operator()
+            lats[i] = lons[i] = Math::NaN();
+          }
+        }
+        try {
+          g(n, lats.data(), lons.data(), hs.data());
+        }
+        catch (const std::exception&) {
+          // Fall back to evaluating the points one at a time so that the
+          // errors are reported for the lines that caused them.
+          for (size_t i = 0; i < n; ++i) {
+            if (!errs[i].empty()) continue;
+            try {
+              hs[i] = g(lats[i], lons[i]);
             }
-          } else {
-            if (heightmult) {
-              // Treat last token as height
-              // pb = last char of last token
-              // pa = last char preceding white space
-              // px = last char of 2nd last token
-              std::string::size_type pb = s.find_last_not_of(spaces);
-              std::string::size_type pa = s.find_last_of(spaces, pb);
-              if (pa == std::string::npos || pb == std::string::npos)
-                throw GeographicErr("Incomplete input: " + s);
-              height = Utility::val<real>(s.substr(pa + 1, pb - pa));
-              s = s.substr(0, pa + 1);
+            catch (const std::exception& e) {
+              errs[i] = e.what();
             }
-            p.Reset(s, true, longfirst);
           }
-          if (heightmult) {
-            real h = g(p.Latitude(), p.Longitude());
-            *output << s
-                    << Utility::str(height + real(heightmult) * h, 4)
-                    << suff << eol;
-          } else {
-            real h = g(p.Latitude(), p.Longitude());
-            *output << Utility::str(h, 4) << eol;
+        }
+        for (size_t i = 0; i < n; ++i) {
+          if (errs[i].empty())
+            print(recs[i], hs[i], out);
+          else {
+            out << "ERROR: " << errs[i] << "\n";
+            ret = 1;
           }
         }
+        return ret;
+      };
+      if (!server.empty()) {
+        try {
+          LineProcessor::Serve(server, nthreads,
+                               [process](const std::string& s,
+                                         std::ostream& out) mutable -> int
+                               { return process(&s, 1, out); });
+        }
         catch (const std::exception& e) {
-          *output << "ERROR: " << e.what() << "\n";
-          retval = 1;
+          std::cerr << "Server error: " << e.what() << "\n";
         }
+        return 1;
       }
+      retval = LineProcessor::ProcessBlocks(*input, *output, nthreads,
+                                            process);
     }
     catch (const std::exception& e) {
       std::cerr << "Error reading " << geoid << ": " << e.what() << "\n";
@@ -13,10 +13,12 @@
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <vector>
 #include <GeographicLib/GravityModel.hpp>
 #include <GeographicLib/GravityCircle.hpp>
 #include <GeographicLib/DMS.hpp>
 #include <GeographicLib/Utility.hpp>
+#include "LineProcessor.hpp"
 
 #if defined(_MSC_VER)
 // Squelch warnings about constant conditional and enum-float expressions
@@ -34,11 +36,14 @@ int main(int argc, const char* const argv[]) {
     bool verbose = false, longfirst = false;
     std::string dir;
     std::string model = GravityModel::DefaultGravityName();
-    std::string istring, ifile, ofile, cdelim;
+    std::string istring, ifile, ofile, cdelim, server;
     char lsep = ';';
     real lat = 0, h = 0;
-    bool circle = false;
-    int prec = -1, Nmax = -1, Mmax = -1;
+    bool circle = false, grid = false;
+    // The grid specification for --grid
+    real south = 0, west = 0, north = 0, east = 0, dlat = 0, dlon = 0;
+    LineProcessor::gridformat gridfmt = LineProcessor::GTX;
+    int prec = -1, Nmax = -1, Mmax = -1, nthreads = 1;
     enum {
       GRAVITY = 0,
       DISTURBANCE = 1,
@@ -107,6 +112,56 @@ int main(int argc, const char* const argv[]) {
                     << e.what() << "\n";
           return 1;
         }
+      } else if (arg == "--grid") {
+        if (m + 6 >= argc) return usage(1, true);
+        try {
+          DMS::DecodeLatLon(std::string(argv[m + 1]), std::string(argv[m + 2]),
+                            south, west, longfirst);
+          DMS::DecodeLatLon(std::string(argv[m + 3]), std::string(argv[m + 4]),
+                            north, east, longfirst);
+          dlat = Utility::fract<real>(std::string(argv[m + 5]));
+          dlon = Utility::fract<real>(std::string(argv[m + 6]));
+          if (!(dlat > 0 && dlon > 0))
+            throw GeographicErr("Grid spacings must be positive");
+          if (!(south <= north))
+            throw GeographicErr("South edge is north of north edge");
+          grid = true;
+        }
+        catch (const std::exception& e) {
+          std::cerr << "Error decoding argument of " << arg << ": "
+                    << e.what() << "\n";
+          return 1;
+        }
+        m += 6;
+      } else if (arg == "--grid-format") {
+        if (++m == argc) return usage(1, true);
+        try {
+          gridfmt = LineProcessor::GridFormat(std::string(argv[m]));
+        }
+        catch (const std::exception& e) {
+          std::cerr << "Error decoding argument of " << arg << ": "
+                    << e.what() << "\n";
+          return 1;
+        }
+      } else if (arg == "--height") {
+        if (++m == argc) return usage(1, true);
+        try {
+          h = Utility::val<real>(std::string(argv[m]));
+        }
+        catch (const std::exception& e) {
+          std::cerr << "Error decoding argument of " << arg << ": "
+                    << e.what() << "\n";
+          return 1;
+        }
+      } else if (arg == "-j") {
+        if (++m == argc) return usage(1, true);
+        try {
+          nthreads = LineProcessor::NumThreads(std::string(argv[m]));
+        }
+        catch (const std::exception& e) {
+          std::cerr << "Error decoding argument of -j: " << e.what() << "\n";
+          return 1;
+        }
       } else if (arg == "-w")
         longfirst = !longfirst;
       else if (arg == "-p") {
@@ -129,6 +184,9 @@ int main(int argc, const char* const argv[]) {
       } else if (arg == "--output-file") {
         if (++m == argc) return usage(1, true);
         ofile = argv[m];
+      } else if (arg == "--server") {
+        if (++m == argc) return usage(1, true);
+        server = argv[m];
       } else if (arg == "--line-separator") {
         if (++m == argc) return usage(1, true);
         if (std::string(argv[m]).size() != 1) {
@@ -159,6 +217,16 @@ int main(int argc, const char* const argv[]) {
       std::cerr << "Cannot specify --input-string and --input-file together\n";
       return 1;
     }
+    if (!server.empty() &&
+        (grid || !istring.empty() || !ifile.empty() || !ofile.empty())) {
+      std::cerr << "Cannot specify --server with --grid, --input-string,\n"
+                << "--input-file, or --output-file\n";
+      return 1;
+    }
+    if (grid && circle) {
+      std::cerr << "Cannot specify -c and --grid together\n";
+      return 1;
+    }
     if (ifile == "-") ifile.clear();
     std::ifstream infile;
     std::istringstream instring;
@@ -184,7 +252,8 @@ int main(int argc, const char* const argv[]) {
     std::ofstream outfile;
     if (ofile == "-") ofile.clear();
     if (!ofile.empty()) {
-      outfile.open(ofile.c_str());
+      outfile.open(ofile.c_str(), grid && gridfmt == LineProcessor::GTX ?
+                   std::ios::out | std::ios::binary : std::ios::out);
       if (!outfile.is_open()) {
         std::cerr << "Cannot open " << ofile << " for writing\n";
         return 1;
@@ -209,7 +278,7 @@ int main(int argc, const char* const argv[]) {
     try {
       using std::isfinite;
       const GravityModel g(model, dir, Nmax, Mmax);
-      if (circle) {
+      if (circle || grid) {
         if (!isfinite(h))
           throw GeographicErr("Bad height");
         else if (mode == UNDULATION && h != 0)
@@ -225,10 +294,73 @@ int main(int argc, const char* const argv[]) {
                        (mode == DISTURBANCE ? GravityModel::DISTURBANCE :
                         (mode == ANOMALY ? GravityModel::SPHERICAL_ANOMALY :
                          GravityModel::GEOID_HEIGHT))); // mode == UNDULATION
+      if (grid) {
+        // Compute the grid a row at a time using a GravityCircle.  The
+        // values at each node are those which would be printed.
+        const int nval = mode == UNDULATION ? 1 : 3;
+        using std::floor; using std::fmin;
+        if (east < west) east += Math::td;
+        // Allow for roundoff in the number of intervals
+        const real eps = 8 * std::numeric_limits<real>::epsilon();
+        const size_t
+          nlat = size_t(floor((north - south) / dlat * (1 + eps))) + 1,
+          nlon = size_t(floor((east - west) / dlon * (1 + eps))) + 1;
+        // Scratch space for the anomalies (each thread uses its own copy)
+        std::vector<real> dg, xi, eta;
+        auto row = [=, &g](size_t i, real vals[]) mutable -> void {
+          const GravityCircle circ(g.Circle(fmin(north, south + i * dlat),
+                                            h, mask));
+          // Compute geoid heights and anomalies for the whole row at once
+          if (mode == UNDULATION) {
+            circ.GeoidHeight(west, dlon, int(nlon), vals);
+            return;
+          } else if (mode == ANOMALY) {
+            dg.resize(nlon); xi.resize(nlon); eta.resize(nlon);
+            circ.SphericalAnomaly(west, dlon, int(nlon),
+                                  dg.data(), xi.data(), eta.data());
+            for (size_t j = 0; j < nlon; ++j) {
+              vals[3 * j    ] = dg[j] * 100000;   // Convert to mGals
+              vals[3 * j + 1] = xi[j] * Math::ds; // Convert to arcsecs
+              vals[3 * j + 2] = eta[j] * Math::ds;
+            }
+            return;
+          }
+          for (size_t j = 0; j < nlon; ++j) {
+            real lon = west + j * dlon, v[3];
+            switch (mode) {
+            case GRAVITY:
+              circ.Gravity(lon, v[0], v[1], v[2]);
+              break;
+            case DISTURBANCE:
+              circ.Disturbance(lon, v[0], v[1], v[2]);
+              for (int k = 0; k < 3; ++k)
+                v[k] *= 100000; // Convert to mGals
+              break;
+            case ANOMALY:
+              circ.SphericalAnomaly(lon, v[0], v[1], v[2]);
+              v[0] *= 100000;   // Convert to mGals
+              v[1] *= Math::ds; // Convert to arcsecs
+              v[2] *= Math::ds;
+              break;
+            case UNDULATION:
+            default:
+              v[0] = circ.GeoidHeight(lon);
+              break;
+            }
+            for (int k = 0; k < nval; ++k)
+              vals[j * nval + k] = v[k];
+          }
+        };
+        LineProcessor::ProcessGrid(*output, south, west, dlat, dlon,
+                                   nlat, nlon, nval, nthreads, row,
+                                   gridfmt, prec);
+        return retval;
+      }
       const GravityCircle c(circle ? g.Circle(lat, h, mask) : GravityCircle());
-      std::string s, eol, stra, strb;
-      std::istringstream str;
-      while (std::getline(*input, s)) {
+      auto process = [=, &g, &c](std::string s, std::ostream& out)
+        mutable -> int {
+        std::string eol, stra, strb;
+        std::istringstream str;
         try {
           eol = "\n";
           if (!cdelim.empty()) {
@@ -268,9 +400,9 @@ int main(int argc, const char* const argv[]) {
               } else {
                 g.Gravity(lat, lon, h, gx, gy, gz);
               }
-              *output << Utility::str(gx, prec) << " "
-                      << Utility::str(gy, prec) << " "
-                      << Utility::str(gz, prec) << eol;
+              out << Utility::str(gx, prec) << " "
+                  << Utility::str(gy, prec) << " "
+                  << Utility::str(gz, prec) << eol;
             }
             break;
           case DISTURBANCE:
@@ -282,10 +414,10 @@ int main(int argc, const char* const argv[]) {
                 g.Disturbance(lat, lon, h, deltax, deltay, deltaz);
               }
               // Convert to mGals
-              *output << Utility::str(deltax * 100000, prec) << " "
-                      << Utility::str(deltay * 100000, prec) << " "
-                      << Utility::str(deltaz * 100000, prec)
-                      << eol;
+              out << Utility::str(deltax * 100000, prec) << " "
+                  << Utility::str(deltay * 100000, prec) << " "
+                  << Utility::str(deltaz * 100000, prec)
+                  << eol;
             }
             break;
           case ANOMALY:
@@ -298,25 +430,36 @@ int main(int argc, const char* const argv[]) {
               Dg01 *= 100000;   // Convert to mGals
               xi *= Math::ds;   // Convert to arcsecs
               eta *= Math::ds;
-              *output << Utility::str(Dg01, prec) << " "
-                      << Utility::str(xi, prec) << " "
-                      << Utility::str(eta, prec) << eol;
+              out << Utility::str(Dg01, prec) << " "
+                  << Utility::str(xi, prec) << " "
+                  << Utility::str(eta, prec) << eol;
             }
             break;
           case UNDULATION:
           default:
             {
               real N = circle ? c.GeoidHeight(lon) : g.GeoidHeight(lat, lon);
-              *output << Utility::str(N, prec) << eol;
+              out << Utility::str(N, prec) << eol;
             }
             break;
           }
         }
         catch (const std::exception& e) {
-          *output << "ERROR: " << e.what() << "\n";
-          retval = 1;
+          out << "ERROR: " << e.what() << "\n";
+          return 1;
         }
+        return 0;
+      };
+      if (!server.empty()) {
+        try {
+          LineProcessor::Serve(server, nthreads, process);
+        }
+        catch (const std::exception& e) {
+          std::cerr << "Server error: " << e.what() << "\n";
+        }
+        return 1;
       }
+      retval = LineProcessor::Process(*input, *output, nthreads, process);
     }
     catch (const std::exception& e) {
       std::cerr << "Error reading " << model << ": " << e.what() << "\n";
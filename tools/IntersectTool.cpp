@@ -18,6 +18,7 @@
 #include <GeographicLib/DMS.hpp>
 #include <GeographicLib/Utility.hpp>
 #include <GeographicLib/Intersect.hpp>
+#include "LineProcessor.hpp"
 
 #include "IntersectTool.usage"
 using namespace GeographicLib;
@@ -31,8 +32,8 @@ int main(int argc, const char* const argv[]) {
       a = Constants::WGS84_a(),
       f = Constants::WGS84_f(),
       maxdist = -1;
-    bool exact = false, check = false, longfirst = false;
-    int prec = 3, mode = CLOSE;
+    bool exact = false, check = false, longfirst = false, binary = false;
+    int prec = 3, mode = CLOSE, nthreads = 1;
     std::string istring, ifile, ofile, cdelim;
     char lsep = ';';
 
@@ -85,6 +86,17 @@ int main(int argc, const char* const argv[]) {
         check = true;
       else if (arg == "-w")
         longfirst = true;
+      else if (arg == "-j") {
+        if (++m == argc) return usage(1, true);
+        try {
+          nthreads = LineProcessor::NumThreads(std::string(argv[m]));
+        }
+        catch (const std::exception& e) {
+          std::cerr << "Error decoding argument of -j: " << e.what() << "\n";
+          return 1;
+        }
+      } else if (arg == "--binary")
+        binary = true;
       else if (arg == "--input-string") {
         if (++m == argc) return usage(1, true);
         istring = argv[m];
@@ -116,11 +128,24 @@ int main(int argc, const char* const argv[]) {
       std::cerr << "Cannot specify --input-string and --input-file together\n";
       return 1;
     }
+    if (binary && !istring.empty()) {
+      std::cerr << "Cannot specify --input-string and --binary together\n";
+      return 1;
+    }
+    if (binary && maxdist >= 0) {
+      std::cerr << "Cannot specify -R and --binary together\n";
+      return 1;
+    }
+    if (binary && check) {
+      std::cerr << "Cannot specify -C and --binary together\n";
+      return 1;
+    }
     if (ifile == "-") ifile.clear();
     std::ifstream infile;
     std::istringstream instring;
     if (!ifile.empty()) {
-      infile.open(ifile.c_str());
+      infile.open(ifile.c_str(), binary ? std::ios::in | std::ios::binary :
+                  std::ios::in);
       if (!infile.is_open()) {
         std::cerr << "Cannot open " << ifile << " for reading\n";
         return 1;
@@ -141,7 +166,8 @@ int main(int argc, const char* const argv[]) {
     std::ofstream outfile;
     if (ofile == "-") ofile.clear();
     if (!ofile.empty()) {
-      outfile.open(ofile.c_str());
+      outfile.open(ofile.c_str(), binary ? std::ios::out | std::ios::binary :
+                   std::ios::out);
       if (!outfile.is_open()) {
         std::cerr << "Cannot open " << ofile << " for writing\n";
         return 1;
@@ -149,18 +175,60 @@ int main(int argc, const char* const argv[]) {
     }
     std::ostream* output = !ofile.empty() ? &outfile : &std::cout;
 
-    Geodesic geod(a, f, exact);
-    Intersect intersect(geod);
-    real latX1, lonX1, aziX, latY1, lonY1, aziY, latX2, lonX2, latY2, lonY2,
-      x0 = 0, y0 = 0, x, y;
-    std::string inp[8], s, sc, eol;
-    std::istringstream str;
-    int retval = 0,
-      ninp = mode == CLOSE ? 6 : (mode == NEXT ? 4 :
-                                  8); // mode == OFFSET || mode == SEGMENT
-    GeodesicLine lineX, lineY;
-    unsigned caps = Intersect::LineCaps;
-    while (std::getline(*input, s)) {
+    const Geodesic geod(a, f, exact);
+    const Intersect intersect(geod);
+    // ninp = 8 for mode == OFFSET || mode == SEGMENT
+    const int ninp = mode == CLOSE ? 6 : (mode == NEXT ? 4 : 8);
+    const unsigned caps = Intersect::LineCaps;
+
+    if (binary) {
+      // Each record contains the numbers which would appear on an input or
+      // output line; angles are in degrees and the output is not rounded.
+      const int nout = mode == SEGMENT ? 4 : 3;
+      auto process = [=, &geod, &intersect](const real in[], real out[])
+        -> int {
+        const int i = longfirst ? 1 : 0;
+        GeodesicLine lineX, lineY;
+        real x0 = 0, y0 = 0;
+        if (mode == CLOSE || mode == OFFSET) {
+          lineX = geod.Line(in[i], in[1-i], in[2], caps);
+          lineY = geod.Line(in[3+i], in[4-i], in[5], caps);
+          if (mode == OFFSET) {
+            x0 = in[6]; y0 = in[7];
+          }
+        } else if (mode == NEXT) {
+          lineX = geod.Line(in[i], in[1-i], in[2], caps);
+          lineY = geod.Line(in[i], in[1-i], in[3], caps);
+        } else {                // mode == SEGMENT
+          lineX = geod.InverseLine(in[i], in[1-i], in[2+i], in[3-i], caps);
+          lineY = geod.InverseLine(in[4+i], in[5-i], in[6+i], in[7-i], caps);
+          x0 = lineX.Distance()/2;
+          y0 = lineY.Distance()/2;
+        }
+        std::pair<real, real> p0(x0, y0);
+        int segmode = 0, c;
+        auto p = mode == CLOSE || mode == OFFSET ?
+          intersect.Closest(lineX, lineY, p0, &c) :
+          mode == NEXT ? intersect.Next(lineX, lineY, &c) :
+          intersect.Segment(lineX, lineY, segmode, &c);
+        out[0] = p.first; out[1] = p.second; out[2] = real(c);
+        if (mode == SEGMENT) out[3] = real(segmode);
+        return 0;
+      };
+      return LineProcessor::ProcessBinary(*input, *output, ninp, nout,
+                                          nthreads, process);
+    }
+
+    // The check output is written to standard error as each line is
+    // processed, so do this on one thread.
+    if (check) nthreads = 1;
+    auto process = [=, &geod, &intersect](std::string s, std::ostream& out)
+      -> int {
+      real latX1, lonX1, aziX, latY1, lonY1, aziY, latX2, lonX2, latY2, lonY2,
+        x0 = 0, y0 = 0, x, y;
+      std::string inp[8], sc, eol;
+      std::istringstream str;
+      GeodesicLine lineX, lineY;
       try {
         eol = "\n";
         if (!cdelim.empty()) {
@@ -215,11 +283,11 @@ int main(int argc, const char* const argv[]) {
             mode == NEXT ? intersect.Next(lineX, lineY, &c) :
             intersect.Segment(lineX, lineY, segmode, &c);
           x = p.first; y = p.second;
-          *output << Utility::str(x, prec) << " "
-                  << Utility::str(y, prec) << " " << c;
+          out << Utility::str(x, prec) << " "
+              << Utility::str(y, prec) << " " << c;
           if (mode == SEGMENT)
-            *output << " " << segmode;
-          *output << eol;
+            out << " " << segmode;
+          out << eol;
           if (check) {
             lineX.Position(x, latX2, lonX2);
             lineY.Position(y, latY2, lonY2);
@@ -237,10 +305,10 @@ int main(int argc, const char* const argv[]) {
           unsigned n = unsigned(v.size());
           for (unsigned i = 0; i < n; ++i) {
             x = v[i].first; y = v[i].second;
-            *output << Utility::str(x, prec) << " " << Utility::str(y, prec)
-                    << " " << c[i] << " "
-                    << Utility::str(Intersect::Dist(v[i], p0), prec)
-                    << eol;
+            out << Utility::str(x, prec) << " " << Utility::str(y, prec)
+                << " " << c[i] << " "
+                << Utility::str(Intersect::Dist(v[i], p0), prec)
+                << eol;
             if (check) {
               lineX.Position(x, latX2, lonX2);
               lineY.Position(y, latY2, lonY2);
@@ -253,18 +321,19 @@ int main(int argc, const char* const argv[]) {
                         << Utility::str(sXY, prec) << eol;
             }
           }
-          *output << "nan nan 0 nan" << eol;
+          out << "nan nan 0 nan" << eol;
           if (check)
             std::cerr << "nan nan nan nan nan" << eol;
         }
       }
       catch (const std::exception& e) {
         // Write error message cout so output lines match input lines
-        *output << "ERROR: " << e.what() << "\n";
-        retval = 1;
+        out << "ERROR: " << e.what() << "\n";
+        return 1;
       }
-    }
-    return retval;
+      return 0;
+    };
+    return LineProcessor::Process(*input, *output, nthreads, process);
   }
   catch (const std::exception& e) {
     std::cerr << "Caught exception: " << e.what() << "\n";
@@ -0,0 +1,578 @@
+/**
+ * \file LineProcessor.hpp
+ * \brief Header for the LineProcessor helper used by the utilities
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_LINEPROCESSOR_HPP)
+#define GEOGRAPHICLIB_LINEPROCESSOR_HPP 1
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <exception>
+#include <algorithm>
+#include <GeographicLib/Math.hpp>
+#include <GeographicLib/Utility.hpp>
+#include <GeographicLib/Executor.hpp>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace GeographicLib {
+
+  /**
+   * \brief Line-oriented driver for the command line utilities
+   *
+   * The utilities read their input one line at a time, convert each line
+   * independently, and write one output line per input line.  This class
+   * runs such a conversion either serially or, with \e nthreads &gt; 1, on
+   * several threads.  In the parallel case the input is read in blocks of
+   * lines, each block is split into contiguous pieces which are converted
+   * concurrently, and the results are written out in the original order.
+   * The output is therefore identical to that of the serial mode.
+   *
+   * The conversion is supplied as a function object called as
+   * \code
+   *   int process(const std::string& line, std::ostream& out);
+   * \endcode
+   * which writes the output for \e line (including the terminating newline)
+   * to \e out and returns non-zero if there was an error.  Each thread works
+   * on its own copy of the function object, so per-line scratch variables
+   * can be kept in the function object (e.g., as the captured variables of a
+   * mutable lambda).  Any state shared by reference must be safe for
+   * concurrent const access; this is true of the GeographicLib classes.
+   **********************************************************************/
+  class LineProcessor {
+  private:
+    typedef Math::real real;
+    LineProcessor() = delete;   // Disable constructor
+
+#if !defined(_WIN32)
+    // Write all of s to the file descriptor c; return false on failure.
+    static bool WriteAll(int c, const std::string& s) {
+      for (size_t k = 0; k < s.size();) {
+        ssize_t r = ::write(c, s.data() + k, s.size() - k);
+        if (r < 0) {
+          if (errno == EINTR) continue;
+          return false;
+        }
+        k += size_t(r);
+      }
+      return true;
+    }
+
+    // Convert the lines received on the connection c with f.  A final line
+    // without a terminating newline is converted when the client closes its
+    // end of the connection.
+    template<class F>
+    static void Connection(int c, F& f) {
+      std::string buf, line;
+      std::ostringstream out;
+      char chunk[4096];
+      for (bool eof = false; !eof;) {
+        ssize_t r = ::read(c, chunk, sizeof(chunk));
+        if (r < 0) {
+          if (errno == EINTR) continue;
+          return;
+        }
+        eof = r == 0;
+        buf.append(chunk, size_t(r));
+        out.str("");
+        size_t b = 0;
+        for (size_t e; (e = buf.find('\n', b)) != std::string::npos;
+             b = e + 1) {
+          line.assign(buf, b, e - b);
+          f(line, out);
+        }
+        buf.erase(0, b);
+        if (eof && !buf.empty())
+          f(buf, out);
+        if (!WriteAll(c, out.str())) return;
+      }
+    }
+#endif
+
+  public:
+
+    /**
+     * Split a range of items among threads.
+     *
+     * @tparam G the type of the function object.
+     * @param[in] k the number of items (must be positive).
+     * @param[in] nt the number of threads (must be positive).
+     * @param[in] work the function object.
+     * @return the number of pieces.
+     * @exception any exception thrown by \e work.
+     *
+     * The items [0, \e k) are split into contiguous pieces, one per thread,
+     * and \e work(\e t, \e b, \e e) is called for piece \e t = [\e b, \e
+     * e) as task \e t of the library's Executor (so the pieces may run
+     * concurrently).  If there is only one piece, the work is done on the
+     * calling thread.  This is the building block of the other
+     * functions; it is public so that the utilities can use it for work
+     * which is not line oriented.
+     **********************************************************************/
+    template<class G>
+    static size_t Dispatch(size_t k, size_t nt, G work) {
+      size_t chunk = (k + nt - 1) / nt, nused = (k + chunk - 1) / chunk;
+      if (nused == 1) {
+        work(0, 0, k);
+        return nused;
+      }
+      // The precision of multiprecision types may be per-thread state, so
+      // propagate it to the workers.
+      const int ndigits = Math::digits();
+      std::vector<std::exception_ptr> errs(nused);
+      Executor::Current().Run(int(nused), [&](int i) -> void {
+        const size_t t = size_t(i);
+        try {
+          Math::set_digits(ndigits);
+          work(t, t * chunk, (std::min)(k, (t + 1) * chunk));
+        }
+        catch (...) {
+          errs[t] = std::current_exception();
+        }
+      });
+      for (size_t t = 0; t < nused; ++t)
+        if (errs[t]) std::rethrow_exception(errs[t]);
+      return nused;
+    }
+
+    /**
+     * The number of lines handled by each thread in one block.
+     **********************************************************************/
+    static const size_t blocksize = 8192;
+
+    /**
+     * Process the lines of a stream.
+     *
+     * @tparam F the type of the function object.
+     * @param[in] input the input stream.
+     * @param[out] output the output stream.
+     * @param[in] nthreads the number of threads to use; if \e nthreads
+     *   &le; 1 all the work is done on the calling thread.
+     * @param[in] process the function object converting a single line.
+     * @return 0 if all the lines were converted successfully, otherwise 1.
+     * @exception any exception thrown by \e process.
+     **********************************************************************/
+    template<class F>
+    static int Process(std::istream& input, std::ostream& output,
+                       int nthreads, F process) {
+      return ProcessBlocks(input, output, nthreads,
+                           [process](const std::string lines[], size_t n,
+                                     std::ostream& out) mutable -> int {
+                             int r = 0;
+                             for (size_t i = 0; i < n; ++i)
+                               r |= process(lines[i], out) ? 1 : 0;
+                             return r;
+                           });
+    }
+
+    /**
+     * Process the lines of a stream in groups.
+     *
+     * @tparam F the type of the function object.
+     * @param[in] input the input stream.
+     * @param[out] output the output stream.
+     * @param[in] nthreads the number of threads to use; if \e nthreads
+     *   &le; 1 all the work is done on the calling thread.
+     * @param[in] process the function object converting a group of lines.
+     * @param[in] interactive if true (the default), the lines are passed
+     *   one at a time in the serial case.
+     * @return 0 if all the lines were converted successfully, otherwise 1.
+     * @exception any exception thrown by \e process.
+     *
+     * This is the same as Process except that the function object is called
+     * as
+     * \code
+     *   int process(const std::string lines[], size_t n, std::ostream& out);
+     * \endcode
+     * with a group of \e n consecutive lines and it writes the output for
+     * all of them.  This allows a function object to treat the lines of a
+     * group together, e.g., by reordering the calculations.  In the serial
+     * case, the lines are passed one at a time (so that interactive use is
+     * possible), unless \e interactive is false, in which case they are
+     * passed in groups of #blocksize lines; otherwise each thread receives
+     * its piece of a block as a single group.
+     **********************************************************************/
+    template<class F>
+    static int ProcessBlocks(std::istream& input, std::ostream& output,
+                             int nthreads, F process,
+                             bool interactive = true) {
+      int retval = 0;
+      std::string s;
+      if (nthreads <= 1 && interactive) {
+        while (std::getline(input, s))
+          retval |= process(&s, 1, output) ? 1 : 0;
+        return retval;
+      }
+      const size_t nt = size_t((std::max)(nthreads, 1));
+      std::vector<std::string> lines(nt * blocksize);
+      std::vector<std::ostringstream> outs(nt);
+      std::vector<int> rets(nt);
+      for (bool more = true; more;) {
+        size_t k = 0;
+        while (k < lines.size() && std::getline(input, lines[k])) ++k;
+        more = k == lines.size();
+        if (k == 0) break;
+        size_t nused = Dispatch(k, nt, [&](size_t t, size_t b, size_t e) {
+            F f(process);
+            outs[t].str(""); outs[t].clear();
+            rets[t] = f(&lines[b], e - b, outs[t]) ? 1 : 0;
+          });
+        for (size_t t = 0; t < nused; ++t) {
+          output << outs[t].str();
+          retval |= rets[t];
+        }
+      }
+      return retval;
+    }
+
+    /**
+     * Process the records of a binary stream.
+     *
+     * @tparam F the type of the function object.
+     * @param[in] input the input stream.
+     * @param[out] output the output stream.
+     * @param[in] nin the number of values in each input record.
+     * @param[in] nout the number of values in each output record.
+     * @param[in] nthreads the number of threads to use; if \e nthreads
+     *   &le; 1 all the work is done on the calling thread.
+     * @param[in] process the function object converting a single record.
+     * @return 0 if all the records were converted successfully, otherwise 1.
+     * @exception GeographicErr if the input ends with an incomplete record or
+     *   if the output cannot be written.
+     * @exception any exception thrown by \e process.
+     *
+     * The records consist of IEEE double precision numbers in little-endian
+     * byte order.  The function object is called as
+     * \code
+     *   int process(const real in[], real out[]);
+     * \endcode
+     * where \e in holds the \e nin values of the input record and \e out
+     * receives the \e nout values of the output record.  It should return
+     * non-zero if there was an error (in which case it should set the output
+     * values to NaN).
+     **********************************************************************/
+    template<class F>
+    static int ProcessBinary(std::istream& input, std::ostream& output,
+                             int nin, int nout, int nthreads, F process) {
+      const size_t ni = size_t(nin), no = size_t(nout);
+      // Each copy of group holds its own copy of process.
+      auto group = [process, ni, no](size_t n, const real in[], real out[])
+        mutable -> int {
+        int r = 0;
+        for (size_t i = 0; i < n; ++i)
+          r |= process(in + i * ni, out + i * no) ? 1 : 0;
+        return r;
+      };
+      return ProcessBinaryBlocks(input, output, nin, nout, nthreads, group);
+    }
+
+    /**
+     * Process the records of a binary stream in groups.
+     *
+     * @tparam F the type of the function object.
+     * @param[in] input the input stream.
+     * @param[out] output the output stream.
+     * @param[in] nin the number of values in each input record.
+     * @param[in] nout the number of values in each output record.
+     * @param[in] nthreads the number of threads to use; if \e nthreads
+     *   &le; 1 all the work is done on the calling thread.
+     * @param[in] process the function object converting a group of records.
+     * @return 0 if all the records were converted successfully, otherwise 1.
+     * @exception GeographicErr if the input ends with an incomplete record or
+     *   if the output cannot be written.
+     * @exception any exception thrown by \e process.
+     *
+     * This is the same as ProcessBinary except that the function object is
+     * called as
+     * \code
+     *   int process(size_t n, const real in[], real out[]);
+     * \endcode
+     * with a group of \e n consecutive records; \e in holds \e n &times; \e
+     * nin values and \e out receives \e n &times; \e nout values.  This
+     * allows the records of a group to be passed to the array versions of
+     * the library functions.
+     **********************************************************************/
+    template<class F>
+    static int ProcessBinaryBlocks(std::istream& input, std::ostream& output,
+                                   int nin, int nout, int nthreads,
+                                   F process) {
+      int retval = 0;
+      const size_t nt = size_t((std::max)(1, nthreads)),
+        nrec = nt * blocksize, ni = size_t(nin), no = size_t(nout);
+      std::vector<double> buf(nrec * ni);
+      std::vector<real> in(nrec * ni), out(nrec * no);
+      std::vector<int> rets(nt);
+      for (bool more = true; more;) {
+        input.read(reinterpret_cast<char*>(buf.data()),
+                   buf.size() * sizeof(double));
+        size_t nbytes = size_t(input.gcount()),
+          k = nbytes / (ni * sizeof(double));
+        if (k * ni * sizeof(double) != nbytes)
+          throw GeographicErr("Incomplete record at end of binary input");
+        more = k == nrec;
+        if (k == 0) break;
+        for (size_t i = 0; i < k * ni; ++i)
+          in[i] = real(Math::bigendian ? Math::swab<double>(buf[i]) : buf[i]);
+        size_t nused = Dispatch(k, nt, [&](size_t t, size_t b, size_t e) {
+            F f(process);
+            rets[t] = f(e - b, &in[b * ni], &out[b * no]) ? 1 : 0;
+          });
+        for (size_t t = 0; t < nused; ++t)
+          retval |= rets[t];
+        Utility::writearray<double, real, false>(output, out.data(), k * no);
+      }
+      return retval;
+    }
+
+    /**
+     * Serve requests on a Unix-domain socket.
+     *
+     * @tparam F the type of the function object.
+     * @param[in] path the name of the socket.
+     * @param[in] nthreads the number of threads serving connections; if \e
+     *   nthreads &le; 1 a single thread is used.
+     * @param[in] process the function object converting a single line, as
+     *   for Process.
+     * @exception GeographicErr if the socket cannot be created, if \e path
+     *   exists and is not a socket, or if accepting a connection fails.
+     *
+     * This listens on the socket \e path (an existing socket of that name is
+     * replaced) and never returns normally; the server is stopped by killing
+     * it.  Each connection is treated like the standard input of the
+     * utility: it receives lines of input and the results are written back,
+     * one line for each input line, in order.  The results are sent as soon
+     * as the complete lines received so far have been converted, so a client
+     * may send a line and wait for its answer.  A pool of \e nthreads threads
+     * accepts the connections and each connection is handled by one thread;
+     * so up to \e nthreads connections are served concurrently and the
+     * others wait until a thread is free.  Each thread works on its own copy
+     * of \e process.  This function is not available on Windows.
+     **********************************************************************/
+    template<class F>
+    static void Serve(const std::string& path, int nthreads, F process) {
+#if defined(_WIN32)
+      (void)nthreads; (void)process;
+      throw GeographicErr("Cannot serve " + path
+                          + ": Unix-domain sockets are not supported");
+#else
+      sockaddr_un addr;
+      std::memset(&addr, 0, sizeof(addr));
+      addr.sun_family = AF_UNIX;
+      if (path.empty() || path.size() >= sizeof(addr.sun_path))
+        throw GeographicErr("Bad socket name \"" + path + "\"");
+      path.copy(addr.sun_path, path.size());
+      struct stat st;
+      if (::lstat(path.c_str(), &st) == 0) {
+        if (!S_ISSOCK(st.st_mode))
+          throw GeographicErr(path + " exists and is not a socket");
+        ::unlink(path.c_str());
+      }
+      int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+      if (fd < 0)
+        throw GeographicErr(std::string("Cannot create socket: ")
+                            + std::strerror(errno));
+      if (::bind(fd, reinterpret_cast<const sockaddr*>(&addr),
+                 sizeof(addr)) < 0 ||
+          ::listen(fd, SOMAXCONN) < 0) {
+        std::string err(std::strerror(errno));
+        ::close(fd);
+        throw GeographicErr("Cannot listen on " + path + ": " + err);
+      }
+      // A client which disconnects before reading its results must not
+      // terminate the server.
+      std::signal(SIGPIPE, SIG_IGN);
+      const size_t nt = size_t((std::max)(1, nthreads));
+      const int ndigits = Math::digits();
+      std::vector<int> errs(nt, 0);
+      auto work = [&](size_t t) -> void {
+        Math::set_digits(ndigits);
+        F f(process);
+        for (;;) {
+          int c = ::accept(fd, nullptr, nullptr);
+          if (c < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            errs[t] = errno;
+            return;
+          }
+          try {
+            Connection(c, f);
+          }
+          catch (const std::exception&) {
+            // Drop this connection and carry on with the next one
+          }
+          ::close(c);
+        }
+      };
+      std::vector<std::thread> threads;
+      threads.reserve(nt - 1);
+      for (size_t t = 1; t < nt; ++t)
+        threads.push_back(std::thread(work, t));
+      work(0);
+      for (auto& t : threads)
+        t.join();
+      ::close(fd);
+      for (size_t t = 0; t < nt; ++t)
+        if (errs[t])
+          throw GeographicErr(std::string("Error accepting connection: ")
+                              + std::strerror(errs[t]));
+      throw GeographicErr("Server on " + path + " stopped");
+#endif
+    }
+
+    /**
+     * The formats for ProcessGrid.
+     **********************************************************************/
+    enum gridformat {
+      /**
+       * A GTX file (with several values at each node if necessary).
+       * @hideinitializer
+       **********************************************************************/
+      GTX = 0,
+      /**
+       * Lines of text consisting of the longitude, the latitude, and the
+       * values at each node ("XYZ" format).
+       * @hideinitializer
+       **********************************************************************/
+      XYZ = 1,
+    };
+
+    /**
+     * Decode the argument of the --grid-format option.
+     *
+     * @param[in] s the argument, "gtx" or "xyz".
+     * @return the format.
+     * @exception GeographicErr if \e s isn't recognized.
+     **********************************************************************/
+    static gridformat GridFormat(const std::string& s) {
+      if (s == "gtx")
+        return GTX;
+      else if (s == "xyz")
+        return XYZ;
+      else
+        throw GeographicErr("Unknown grid format " + s);
+    }
+
+    /**
+     * Compute a grid of values and write it out.
+     *
+     * @tparam F the type of the function object.
+     * @param[out] output the output stream.
+     * @param[in] south the latitude of the southern row (degrees).
+     * @param[in] west the longitude of the western column (degrees).
+     * @param[in] dlat the latitude spacing (degrees).
+     * @param[in] dlon the longitude spacing (degrees).
+     * @param[in] nlat the number of rows.
+     * @param[in] nlon the number of columns.
+     * @param[in] nval the number of values at each node.
+     * @param[in] nthreads the number of threads to use; if \e nthreads
+     *   &le; 1 all the work is done on the calling thread.
+     * @param[in] row the function object computing a row of the grid.
+     * @param[in] format the output format (default GTX).
+     * @param[in] prec the precision of the values for the XYZ format
+     *   (default 4).
+     * @exception GeographicErr if the output cannot be written.
+     * @exception any exception thrown by \e row.
+     *
+     * The function object is called as
+     * \code
+     *   void row(size_t i, real vals[]);
+     * \endcode
+     * and should set the \e nlon &times; \e nval values for row \e i (at
+     * latitude \e south + \e i \e dlat).  The rows are computed in blocks,
+     * each thread computing (and formatting) a contiguous set of rows with
+     * its own copy of the function object, and written in order, south
+     * first.
+     *
+     * With \e format = GTX, the output consists of the header of a GTX file
+     * (\e south, \e west, \e dlat, \e dlon as doubles and \e nlat, \e nlon as
+     * 32-bit integers) followed by the rows, each consisting of \e nlon
+     * nodes of \e nval floats; all numbers are big-endian.  With \e nval =
+     * 1, this is a GTX file.  With \e format = XYZ, there is a line for each
+     * node giving the longitude and latitude (with 9 decimal places) and
+     * the values (with \e prec decimal places).
+     **********************************************************************/
+    template<class F>
+    static void ProcessGrid(std::ostream& output,
+                            real south, real west, real dlat, real dlon,
+                            size_t nlat, size_t nlon, int nval,
+                            int nthreads, F row,
+                            gridformat format = GTX, int prec = 4) {
+      if (format == GTX) {
+        real transform[] = {south, west, dlat, dlon};
+        unsigned sizes[] = {unsigned(nlat), unsigned(nlon)};
+        Utility::writearray<double, real, true>(output, transform, 4);
+        Utility::writearray<unsigned, unsigned, true>(output, sizes, 2);
+      }
+      const size_t nt = size_t((std::max)(1, nthreads)),
+        rowsize = nlon * size_t(nval),
+        // About 1M values for each thread in a block
+        nrow = nt * (std::max)(size_t(1), (size_t(1) << 20) / rowsize);
+      std::vector<real> vals((std::min)(nrow, nlat) * rowsize);
+      std::vector<std::ostringstream> outs(format == XYZ ? nt : 0);
+      for (size_t i0 = 0; i0 < nlat; i0 += nrow) {
+        size_t k = (std::min)(nrow, nlat - i0);
+        size_t nused = Dispatch(k, nt, [&](size_t t, size_t b, size_t e) {
+            F f(row);
+            for (size_t i = b; i < e; ++i)
+              f(i0 + i, &vals[i * rowsize]);
+            if (format != XYZ) return;
+            std::ostringstream& out = outs[t];
+            out.str(""); out.clear();
+            for (size_t i = b; i < e; ++i) {
+              std::string lat = Utility::str(south + (i0 + i) * dlat, 9);
+              for (size_t j = 0; j < nlon; ++j) {
+                out << Utility::str(west + j * dlon, 9) << " " << lat;
+                for (int l = 0; l < nval; ++l)
+                  out << " " << Utility::str(vals[i * rowsize + j * nval + l],
+                                             prec);
+                out << "\n";
+              }
+            }
+          });
+        if (format == GTX)
+          Utility::writearray<float, real, true>(output, vals.data(),
+                                                 k * rowsize);
+        else
+          for (size_t t = 0; t < nused; ++t)
+            output << outs[t].str();
+      }
+    }
+
+    /**
+     * Decode the argument of the -j option.
+     *
+     * @param[in] s the argument.
+     * @return the number of threads; if \e s is 0, this is the number of
+     *   hardware threads.
+     * @exception GeographicErr if \e s is not a non-negative integer.
+     **********************************************************************/
+    static int NumThreads(const std::string& s) {
+      int n = Utility::val<int>(s);
+      if (n < 0)
+        throw GeographicErr("Number of threads " + s + " is negative");
+      if (n == 0)
+        n = (std::max)(1, int(std::thread::hardware_concurrency()));
+      return n;
+    }
+
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_LINEPROCESSOR_HPP
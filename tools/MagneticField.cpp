@@ -17,6 +17,7 @@
 #include <GeographicLib/MagneticCircle.hpp>
 #include <GeographicLib/DMS.hpp>
 #include <GeographicLib/Utility.hpp>
+#include "LineProcessor.hpp"
 
 #if defined(_MSC_VER)
 // Squelch warnings about constant conditional and enum-float expressions
@@ -33,12 +34,15 @@ int main(int argc, const char* const argv[]) {
     bool verbose = false, longfirst = false;
     std::string dir;
     std::string model = MagneticModel::DefaultMagneticName();
-    std::string istring, ifile, ofile, cdelim;
+    std::string istring, ifile, ofile, cdelim, server;
     char lsep = ';';
     real time = 0, lat = 0, h = 0;
-    bool timeset = false, circle = false, rate = false;
+    bool timeset = false, circle = false, rate = false, grid = false;
+    // The grid specification for --grid
+    real south = 0, west = 0, north = 0, east = 0, dlat = 0, dlon = 0;
+    LineProcessor::gridformat gridfmt = LineProcessor::GTX;
     real hguard = 500000, tguard = 50;
-    int prec = 1, Nmax = -1, Mmax = -1;
+    int prec = 1, Nmax = -1, Mmax = -1, nthreads = 1;
 
     for (int m = 1; m < argc; ++m) {
       std::string arg(argv[m]);
@@ -107,6 +111,56 @@ int main(int argc, const char* const argv[]) {
                     << e.what() << "\n";
           return 1;
         }
+      } else if (arg == "--grid") {
+        if (m + 6 >= argc) return usage(1, true);
+        try {
+          DMS::DecodeLatLon(std::string(argv[m + 1]), std::string(argv[m + 2]),
+                            south, west, longfirst);
+          DMS::DecodeLatLon(std::string(argv[m + 3]), std::string(argv[m + 4]),
+                            north, east, longfirst);
+          dlat = Utility::fract<real>(std::string(argv[m + 5]));
+          dlon = Utility::fract<real>(std::string(argv[m + 6]));
+          if (!(dlat > 0 && dlon > 0))
+            throw GeographicErr("Grid spacings must be positive");
+          if (!(south <= north))
+            throw GeographicErr("South edge is north of north edge");
+          grid = true;
+        }
+        catch (const std::exception& e) {
+          std::cerr << "Error decoding argument of " << arg << ": "
+                    << e.what() << "\n";
+          return 1;
+        }
+        m += 6;
+      } else if (arg == "--grid-format") {
+        if (++m == argc) return usage(1, true);
+        try {
+          gridfmt = LineProcessor::GridFormat(std::string(argv[m]));
+        }
+        catch (const std::exception& e) {
+          std::cerr << "Error decoding argument of " << arg << ": "
+                    << e.what() << "\n";
+          return 1;
+        }
+      } else if (arg == "--height") {
+        if (++m == argc) return usage(1, true);
+        try {
+          h = Utility::val<real>(std::string(argv[m]));
+        }
+        catch (const std::exception& e) {
+          std::cerr << "Error decoding argument of " << arg << ": "
+                    << e.what() << "\n";
+          return 1;
+        }
+      } else if (arg == "-j") {
+        if (++m == argc) return usage(1, true);
+        try {
+          nthreads = LineProcessor::NumThreads(std::string(argv[m]));
+        }
+        catch (const std::exception& e) {
+          std::cerr << "Error decoding argument of -j: " << e.what() << "\n";
+          return 1;
+        }
       } else if (arg == "-r")
         rate = !rate;
       else if (arg == "-w")
@@ -151,6 +205,9 @@ int main(int argc, const char* const argv[]) {
       } else if (arg == "--output-file") {
         if (++m == argc) return usage(1, true);
         ofile = argv[m];
+      } else if (arg == "--server") {
+        if (++m == argc) return usage(1, true);
+        server = argv[m];
       } else if (arg == "--line-separator") {
         if (++m == argc) return usage(1, true);
         if (std::string(argv[m]).size() != 1) {
@@ -181,6 +238,20 @@ int main(int argc, const char* const argv[]) {
       std::cerr << "Cannot specify --input-string and --input-file together\n";
       return 1;
     }
+    if (!server.empty() &&
+        (grid || !istring.empty() || !ifile.empty() || !ofile.empty())) {
+      std::cerr << "Cannot specify --server with --grid, --input-string,\n"
+                << "--input-file, or --output-file\n";
+      return 1;
+    }
+    if (grid && circle) {
+      std::cerr << "Cannot specify -c and --grid together\n";
+      return 1;
+    }
+    if (grid && !timeset) {
+      std::cerr << "Must specify the time with -t for --grid\n";
+      return 1;
+    }
     if (ifile == "-") ifile.clear();
     std::ifstream infile;
     std::istringstream instring;
@@ -206,7 +277,8 @@ int main(int argc, const char* const argv[]) {
     std::ofstream outfile;
     if (ofile == "-") ofile.clear();
     if (!ofile.empty()) {
-      outfile.open(ofile.c_str());
+      outfile.open(ofile.c_str(), grid && gridfmt == LineProcessor::GTX ?
+                   std::ios::out | std::ios::binary : std::ios::out);
       if (!outfile.is_open()) {
         std::cerr << "Cannot open " << ofile << " for writing\n";
         return 1;
@@ -230,7 +302,7 @@ int main(int argc, const char* const argv[]) {
                             " too far outside allowed range [" +
                             Utility::str(m.MinTime()) + "," +
                             Utility::str(m.MaxTime()) + "]");
-      if (circle
+      if ((circle || grid)
           && (!isfinite(h) ||
               h < m.MinHeight() - hguard ||
               h > m.MaxHeight() + hguard))
@@ -254,101 +326,244 @@ int main(int argc, const char* const argv[]) {
         std::cerr << "WARNING: Time " << time
                   << " outside allowed range ["
                   << m.MinTime() << "," << m.MaxTime() << "]\n";
-      if (circle && (h < m.MinHeight() || h > m.MaxHeight()))
+      if ((circle || grid) && (h < m.MinHeight() || h > m.MaxHeight()))
         std::cerr << "WARNING: Height " << h/1000
                   << "km outside allowed range ["
                   << m.MinHeight()/1000 << "km,"
                   << m.MaxHeight()/1000 << "km]\n";
+      if (grid) {
+        // Compute the grid a row at a time using a MagneticCircle.  The
+        // values at each node are those which would be printed.
+        const int nval = rate ? 14 : 7;
+        using std::floor; using std::fmin;
+        if (east < west) east += Math::td;
+        // Allow for roundoff in the number of intervals
+        const real eps = 8 * std::numeric_limits<real>::epsilon();
+        const size_t
+          nlat = size_t(floor((north - south) / dlat * (1 + eps))) + 1,
+          nlon = size_t(floor((east - west) / dlon * (1 + eps))) + 1;
+        auto row = [&](size_t i, real vals[]) -> void {
+          const MagneticCircle circ(m.Circle(time,
+                                             fmin(north, south + i * dlat),
+                                             h));
+          for (size_t j = 0; j < nlon; ++j) {
+            real bx, by, bz, bxt, byt, bzt;
+            circ(west + j * dlon, bx, by, bz, bxt, byt, bzt);
+            real H, F, D, I, Ht, Ft, Dt, It;
+            MagneticModel::FieldComponents(bx, by, bz, bxt, byt, bzt,
+                                           H, F, D, I, Ht, Ft, Dt, It);
+            const real v[] = {D, I, H, by, bx, -bz, F,
+                              Dt, It, Ht, byt, bxt, -bzt, Ft};
+            for (int k = 0; k < nval; ++k)
+              vals[j * nval + k] = v[k];
+          }
+        };
+        LineProcessor::ProcessGrid(*output, south, west, dlat, dlon,
+                                   nlat, nlon, nval, nthreads, row,
+                                   gridfmt, prec + 1);
+        return retval;
+      }
       const MagneticCircle c(circle ? m.Circle(time, lat, h) :
                              MagneticCircle());
-      std::string s, eol, stra, strb;
-      std::istringstream str;
-      while (std::getline(*input, s)) {
-        try {
-          eol = "\n";
-          if (!cdelim.empty()) {
-            std::string::size_type n = s.find(cdelim);
-            if (n != std::string::npos) {
-              eol = " " + s.substr(n) + "\n";
-              s = s.substr(0, n);
-            }
+      // A parsed input line
+      struct record {
+        real time, lat, lon, h;
+        std::string eol;
+      };
+      // The last time string and its value; input which sweeps the positions
+      // at a fixed time repeats the time string.
+      std::string laststr;
+      real lasttime = Math::NaN();
+      // Parse the line s into r (the time, lat, and h fields default to the
+      // values given on the command line).
+      auto parse = [=, &m](std::string s, record& r,
+                           std::string& lstr, real& ltime) -> void {
+        std::string stra, strb;
+        std::istringstream str;
+        r.eol = "\n";
+        if (!cdelim.empty()) {
+          std::string::size_type n = s.find(cdelim);
+          if (n != std::string::npos) {
+            r.eol = " " + s.substr(n) + "\n";
+            s = s.substr(0, n);
           }
-          str.clear(); str.str(s);
-          if (!(timeset || circle)) {
-            if (!(str >> stra))
-              throw GeographicErr("Incomplete input: " + s);
-            time = Utility::fractionalyear<real>(stra);
-            if (time < m.MinTime() - tguard || time > m.MaxTime() + tguard)
-              throw GeographicErr("Time " + Utility::str(time) +
-                                  " too far outside allowed range [" +
-                                  Utility::str(m.MinTime()) + "," +
-                                  Utility::str(m.MaxTime()) +
-                                  "]");
-            if (time < m.MinTime() || time > m.MaxTime())
-              std::cerr << "WARNING: Time " << time
-                        << " outside allowed range ["
-                        << m.MinTime() << "," << m.MaxTime() << "]\n";
+        }
+        str.str(s);
+        r.time = time; r.lat = lat; r.h = h;
+        if (!(timeset || circle)) {
+          if (!(str >> stra))
+            throw GeographicErr("Incomplete input: " + s);
+          if (stra != lstr) {
+            ltime = Utility::fractionalyear<real>(stra);
+            lstr = stra;
           }
-          real lon;
-          if (circle) {
-            if (!(str >> strb))
-              throw GeographicErr("Incomplete input: " + s);
-            DMS::flag ind;
-            lon = DMS::Decode(strb, ind);
-            if (ind == DMS::LATITUDE)
-              throw GeographicErr("Bad hemisphere letter on " + strb);
-          } else {
-            if (!(str >> stra >> strb))
-              throw GeographicErr("Incomplete input: " + s);
-            DMS::DecodeLatLon(stra, strb, lat, lon, longfirst);
-            h = 0;              // h is optional
-            if (str >> h) {
-              if (h < m.MinHeight() - hguard || h > m.MaxHeight() + hguard)
-                throw GeographicErr("Height " + Utility::str(h/1000) +
-                                    "km too far outside allowed range [" +
-                                    Utility::str(m.MinHeight()/1000) + "km," +
-                                    Utility::str(m.MaxHeight()/1000) + "km]");
-              if (h < m.MinHeight() || h > m.MaxHeight())
-                std::cerr << "WARNING: Height " << h/1000
-                          << "km outside allowed range ["
-                          << m.MinHeight()/1000 << "km,"
-                          << m.MaxHeight()/1000 << "km]\n";
-            }
-            else
-              str.clear();
+          r.time = ltime;
+          if (r.time < m.MinTime() - tguard || r.time > m.MaxTime() + tguard)
+            throw GeographicErr("Time " + Utility::str(r.time) +
+                                " too far outside allowed range [" +
+                                Utility::str(m.MinTime()) + "," +
+                                Utility::str(m.MaxTime()) +
+                                "]");
+          if (r.time < m.MinTime() || r.time > m.MaxTime())
+            std::cerr << "WARNING: Time " << r.time
+                      << " outside allowed range ["
+                      << m.MinTime() << "," << m.MaxTime() << "]\n";
+        }
+        if (circle) {
+          if (!(str >> strb))
+            throw GeographicErr("Incomplete input: " + s);
+          DMS::flag ind;
+          r.lon = DMS::Decode(strb, ind);
+          if (ind == DMS::LATITUDE)
+            throw GeographicErr("Bad hemisphere letter on " + strb);
+        } else {
+          if (!(str >> stra >> strb))
+            throw GeographicErr("Incomplete input: " + s);
+          DMS::DecodeLatLon(stra, strb, r.lat, r.lon, longfirst);
+          r.h = 0;              // h is optional
+          if (str >> r.h) {
+            if (r.h < m.MinHeight() - hguard || r.h > m.MaxHeight() + hguard)
+              throw GeographicErr("Height " + Utility::str(r.h/1000) +
+                                  "km too far outside allowed range [" +
+                                  Utility::str(m.MinHeight()/1000) + "km," +
+                                  Utility::str(m.MaxHeight()/1000) + "km]");
+            if (r.h < m.MinHeight() || r.h > m.MaxHeight())
+              std::cerr << "WARNING: Height " << r.h/1000
+                        << "km outside allowed range ["
+                        << m.MinHeight()/1000 << "km,"
+                        << m.MaxHeight()/1000 << "km]\n";
           }
-          if (str >> stra)
-            throw GeographicErr("Extra junk in input: " + s);
-          real bx, by, bz, bxt, byt, bzt;
-          if (circle)
-            c(lon, bx, by, bz, bxt, byt, bzt);
           else
-            m(time, lat, lon, h, bx, by, bz, bxt, byt, bzt);
-          real H, F, D, I, Ht, Ft, Dt, It;
-          MagneticModel::FieldComponents(bx, by, bz, bxt, byt, bzt,
-                                         H, F, D, I, Ht, Ft, Dt, It);
+            str.clear();
+        }
+        if (str >> stra)
+          throw GeographicErr("Extra junk in input: " + s);
+      };
+      // Write the output for the field B and its rate of change Bt.
+      auto print = [=](const record& r, const real B[], const real Bt[],
+                       std::ostream& out) -> void {
+        real H, F, D, I, Ht, Ft, Dt, It;
+        MagneticModel::FieldComponents(B[0], B[1], B[2], Bt[0], Bt[1], Bt[2],
+                                       H, F, D, I, Ht, Ft, Dt, It);
+        out << DMS::Encode(D, prec + 1, DMS::NUMBER) << " "
+            << DMS::Encode(I, prec + 1, DMS::NUMBER) << " "
+            << Utility::str(H, prec) << " "
+            << Utility::str(B[1], prec) << " "
+            << Utility::str(B[0], prec) << " "
+            << Utility::str(-B[2], prec) << " "
+            << Utility::str(F, prec) << r.eol;
+        if (rate)
+          out << DMS::Encode(Dt, prec + 1, DMS::NUMBER) << " "
+              << DMS::Encode(It, prec + 1, DMS::NUMBER) << " "
+              << Utility::str(Ht, prec) << " "
+              << Utility::str(Bt[1], prec) << " "
+              << Utility::str(Bt[0], prec) << " "
+              << Utility::str(-Bt[2], prec) << " "
+              << Utility::str(Ft, prec) << r.eol;
+      };
 
-          *output << DMS::Encode(D, prec + 1, DMS::NUMBER) << " "
-                  << DMS::Encode(I, prec + 1, DMS::NUMBER) << " "
-                  << Utility::str(H, prec) << " "
-                  << Utility::str(by, prec) << " "
-                  << Utility::str(bx, prec) << " "
-                  << Utility::str(-bz, prec) << " "
-                  << Utility::str(F, prec) << eol;
-          if (rate)
-            *output << DMS::Encode(Dt, prec + 1, DMS::NUMBER) << " "
-                    << DMS::Encode(It, prec + 1, DMS::NUMBER) << " "
-                    << Utility::str(Ht, prec) << " "
-                    << Utility::str(byt, prec) << " "
-                    << Utility::str(bxt, prec) << " "
-                    << Utility::str(-bzt, prec) << " "
-                    << Utility::str(Ft, prec) << eol;
+      // The lines of a group are parsed and then evaluated together.  A run
+      // of consecutive points at the same position (a station sampled at
+      // several times) uses the multi-time version of
+      // MagneticModel::operator(), which evaluates the spherical harmonic
+      // sums once for each model interval; the remaining points are
+      // evaluated with the trajectory version, which loads the coefficients
+      // once for several points.  The results are identical to evaluating
+      // the points one at a time.  Unless the input is the standard input,
+      // the serial case also handles the lines in groups.
+      std::vector<record> recs;
+      std::vector<std::string> errs;
+      std::vector<size_t> idx;
+      std::vector<real> ts, lats, lons, hs, B, Bt, Ba, Bta;
+      auto process = [=, &m, &c](const std::string lines[], size_t n,
+                                 std::ostream& out) mutable -> int {
+        recs.resize(n); errs.assign(n, std::string());
+        for (size_t i = 0; i < n; ++i) {
+          try {
+            parse(lines[i], recs[i], laststr, lasttime);
+          }
+          catch (const std::exception& e) {
+            errs[i] = e.what();
+          }
+        }
+        B.resize(3 * n); Bt.resize(3 * n);
+        ts.resize(n);
+        idx.clear();
+        for (size_t i = 0; i < n;) {
+          size_t j = i + 1;
+          if (!errs[i].empty()) { i = j; continue; }
+          const record& r = recs[i];
+          if (circle) {
+            c(r.lon, B[3*i], B[3*i+1], B[3*i+2],
+              Bt[3*i], Bt[3*i+1], Bt[3*i+2]);
+            i = j; continue;
+          }
+          while (j < n && errs[j].empty() && recs[j].lat == r.lat &&
+                 recs[j].lon == r.lon && recs[j].h == r.h)
+            ++j;
+          if (j - i == 1)
+            idx.push_back(i);
+          else {
+            const size_t k = j - i;
+            Ba.resize(3 * k); Bta.resize(3 * k);
+            for (size_t l = 0; l < k; ++l) ts[l] = recs[i + l].time;
+            m(k, ts.data(), r.lat, r.lon, r.h,
+              Ba.data(), Ba.data() + k, Ba.data() + 2 * k,
+              Bta.data(), Bta.data() + k, Bta.data() + 2 * k);
+            for (size_t l = 0; l < k; ++l)
+              for (int q = 0; q < 3; ++q) {
+                B[3 * (i + l) + q] = Ba[q * k + l];
+                Bt[3 * (i + l) + q] = Bta[q * k + l];
+              }
+          }
+          i = j;
+        }
+        if (!idx.empty()) {
+          const size_t k = idx.size();
+          lats.resize(k); lons.resize(k); hs.resize(k);
+          Ba.resize(3 * k); Bta.resize(3 * k);
+          for (size_t l = 0; l < k; ++l) {
+            const record& r = recs[idx[l]];
+            ts[l] = r.time; lats[l] = r.lat; lons[l] = r.lon; hs[l] = r.h;
+          }
+          if (k == 1)
+            m(ts[0], lats[0], lons[0], hs[0], Ba[0], Ba[1], Ba[2],
+              Bta[0], Bta[1], Bta[2]);
+          else
+            m(k, ts.data(), lats.data(), lons.data(), hs.data(),
+              Ba.data(), Ba.data() + k, Ba.data() + 2 * k,
+              Bta.data(), Bta.data() + k, Bta.data() + 2 * k);
+          for (size_t l = 0; l < k; ++l)
+            for (int q = 0; q < 3; ++q) {
+              B[3 * idx[l] + q] = Ba[q * k + l];
+              Bt[3 * idx[l] + q] = Bta[q * k + l];
+            }
+        }
+        int ret = 0;
+        for (size_t i = 0; i < n; ++i) {
+          if (errs[i].empty())
+            print(recs[i], &B[3 * i], &Bt[3 * i], out);
+          else {
+            out << "ERROR: " << errs[i] << "\n";
+            ret = 1;
+          }
+        }
+        return ret;
+      };
+      if (!server.empty()) {
+        try {
+          LineProcessor::Serve(server, nthreads,
+                               [process](const std::string& s,
+                                         std::ostream& out) mutable -> int
+                               { return process(&s, 1, out); });
         }
         catch (const std::exception& e) {
-          *output << "ERROR: " << e.what() << "\n";
-          retval = 1;
+          std::cerr << "Server error: " << e.what() << "\n";
         }
+        return 1;
       }
+      retval = LineProcessor::ProcessBlocks(*input, *output, nthreads,
+                                            process, input == &std::cin);
     }
     catch (const std::exception& e) {
       std::cerr << "Error reading " << model << ": " << e.what() << "\n";
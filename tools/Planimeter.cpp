@@ -13,11 +13,14 @@
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <vector>
 #include <GeographicLib/PolygonArea.hpp>
 #include <GeographicLib/DMS.hpp>
 #include <GeographicLib/Utility.hpp>
 #include <GeographicLib/GeoCoords.hpp>
 #include <GeographicLib/AuxLatitude.hpp>
+#include "LineProcessor.hpp"
+#include "ArrowProcessor.hpp"
 
 #if defined(_MSC_VER)
 // Squelch warnings about constant conditional expressions
@@ -36,9 +39,9 @@ int main(int argc, const char* const argv[]) {
       a = Constants::WGS84_a(),
       f = Constants::WGS84_f();
     bool reverse = false, sign = true, polyline = false, longfirst = false,
-      exact = false, geoconvert_compat = false;
+      exact = false, geoconvert_compat = false, arrow = false;
     int linetype = GEODESIC;
-    int prec = 6;
+    int prec = 6, nthreads = 1;
     std::string istring, ifile, ofile, cdelim;
     char lsep = ';';
 
@@ -80,6 +83,17 @@ int main(int argc, const char* const argv[]) {
         linetype = RHUMB;
       else if (arg == "-E")
         exact = true;
+      else if (arg == "-j") {
+        if (++m == argc) return usage(1, true);
+        try {
+          nthreads = LineProcessor::NumThreads(std::string(argv[m]));
+        }
+        catch (const std::exception& e) {
+          std::cerr << "Error decoding argument of -j: " << e.what() << "\n";
+          return 1;
+        }
+      } else if (arg == "--arrow")
+        arrow = true;
       else if (arg == "--geoconvert-input")
         geoconvert_compat = true;
       else if (arg == "--input-string") {
@@ -113,10 +127,16 @@ int main(int argc, const char* const argv[]) {
       std::cerr << "Cannot specify --input-string and --input-file together\n";
       return 1;
     }
+    if (arrow && (geoconvert_compat || !istring.empty())) {
+      std::cerr << "Cannot specify --arrow with --geoconvert-input or "
+                << "--input-string\n";
+      return 1;
+    }
     if (ifile == "-") ifile.clear();
     std::ifstream infile;
     std::istringstream instring;
-    if (!ifile.empty()) {
+    // With --arrow, the files are opened by ArrowProcessor.
+    if (!ifile.empty() && !arrow) {
       infile.open(ifile.c_str());
       if (!infile.is_open()) {
         std::cerr << "Cannot open " << ifile << " for reading\n";
@@ -137,7 +157,7 @@ int main(int argc, const char* const argv[]) {
 
     std::ofstream outfile;
     if (ofile == "-") ofile.clear();
-    if (!ofile.empty()) {
+    if (!ofile.empty() && !arrow) {
       outfile.open(ofile.c_str());
       if (!outfile.is_open()) {
         std::cerr << "Cannot open " << ofile << " for writing\n";
@@ -158,82 +178,210 @@ int main(int argc, const char* const argv[]) {
                         exact && linetype != RHUMB);
     const Rhumb rhumb(a, linetype == RHUMB ? f : 0,
                       exact && linetype == RHUMB);
-    PolygonArea poly(geod, polyline);
-    PolygonAreaRhumb polyr(rhumb, polyline);
-    GeoCoords p;
 
     // Max precision = 10: 0.1 nm in distance, 10^-15 deg (= 0.11 nm),
     // 10^-11 sec (= 0.3 nm).
     prec = std::min(10 + Math::extra_digits(), std::max(0, prec));
-    std::string s, eol("\n");
-    real perimeter, area;
-    unsigned num;
-    std::istringstream str;
-    std::string slat, slon, junk;
-    real lat = 0, lon = 0;
-    while (std::getline(*input, s)) {
+
+    // The parsed form of an input line; endpoly is set if the line ends a
+    // polygon and eol is the comment (if any) to append to its output.
+    struct vertex {
+      real lat, lon;
+      bool endpoly;
+      std::string eol;
+    };
+    // A polygon under construction
+    struct ring {
+      PolygonArea poly;
+      PolygonAreaRhumb polyr;
+      std::string eol;
+    };
+    auto parse = [&](std::string s, GeoCoords& p, std::istringstream& str,
+                     vertex& v) -> void {
+      v.eol.clear();
       if (!cdelim.empty()) {
         std::string::size_type m = s.find(cdelim);
         if (m != std::string::npos) {
-          eol = " " + s.substr(m) + "\n";
+          v.eol = " " + s.substr(m) + "\n";
           s = s.substr(0, m);
         }
       }
-      bool endpoly = s.empty();
-      if (!endpoly) {
+      v.endpoly = s.empty();
+      if (!v.endpoly) {
         try {
           using std::isnan;
           if (geoconvert_compat) {
             p.Reset(s, true, longfirst);
-            lat = p.Latitude(); lon = p.Longitude();
+            v.lat = p.Latitude(); v.lon = p.Longitude();
           } else {
+            std::string slat, slon, junk;
             str.clear(); str.str(s);
             if (!(str >> slat >> slon))
               throw GeographicErr("incomplete input");
             if (str >> junk)
               throw GeographicErr("extra input");
-            DMS::DecodeLatLon(slat, slon, lat, lon, longfirst);
+            DMS::DecodeLatLon(slat, slon, v.lat, v.lon, longfirst);
           }
-          if (isnan(lat) || isnan(lon))
-            endpoly = true;
+          if (isnan(v.lat) || isnan(v.lon))
+            v.endpoly = true;
         }
         catch (const GeographicErr&) {
-          endpoly = true;
+          v.endpoly = true;
         }
       }
-      if (endpoly) {
-        num =
-          linetype == RHUMB ? polyr.Compute(reverse, sign, perimeter, area) :
-          poly.Compute(reverse, sign, perimeter, area); // geodesic + authalic
-        if (num > 0) {
-          *output << num << " " << Utility::str(perimeter, prec);
-          if (!polyline) {
-            *output << " " << Utility::str(area, std::max(0, prec - 5));
-          }
-          *output << eol;
+    };
+    // Write the result for polygon r (if it has any vertices) and clear it.
+    auto flush = [&](ring& r, std::ostream& out) -> void {
+      real perimeter, area;
+      unsigned num =
+        linetype == RHUMB ? r.polyr.Compute(reverse, sign, perimeter, area) :
+        r.poly.Compute(reverse, sign, perimeter, area); // geodesic + authalic
+      if (num > 0) {
+        out << num << " " << Utility::str(perimeter, prec);
+        if (!polyline) {
+          out << " " << Utility::str(area, std::max(0, prec - 5));
         }
-        linetype == RHUMB ? polyr.Clear() : poly.Clear();
-        eol = "\n";
-      } else {
-        linetype == RHUMB ? polyr.AddPoint(lat, lon) :
-          poly.AddPoint
+        out << r.eol;
+      }
+      linetype == RHUMB ? r.polyr.Clear() : r.poly.Clear();
+      r.eol = "\n";
+    };
+    auto add = [&](const vertex& v, ring& r, std::ostream& out) -> void {
+      if (!v.eol.empty())
+        r.eol = v.eol;
+      if (v.endpoly)
+        flush(r, out);
+      else
+        linetype == RHUMB ? r.polyr.AddPoint(v.lat, v.lon) :
+          r.poly.AddPoint
           (linetype == AUTHALIC ?
-           ellip.Convert(AuxLatitude::PHI, AuxLatitude::XI, lat, exact) : lat,
-           lon);
+           ellip.Convert(AuxLatitude::PHI, AuxLatitude::XI, v.lat, exact) :
+           v.lat, v.lon);
+    };
+    const ring empty{PolygonArea(geod, polyline),
+                     PolygonAreaRhumb(rhumb, polyline), "\n"};
+
+    if (arrow) {
+      // The input columns are latitude and longitude (swapped with -w); a
+      // row with a NaN (or a null) ends a polygon.  The output has a row for
+      // each polygon giving the number of vertices, the perimeter, and
+      // (without -l) the area.  The complete polygons of each record batch
+      // are computed with PolygonAreaT::ComputeMany; the vertices of a
+      // polygon which continues into the next batch are carried over.
+      std::vector<std::string> names{"number", "perimeter"};
+      if (!polyline) names.push_back("area");
+      const size_t no = names.size();
+      ArrowProcessor::Reader reader(ifile);
+      ArrowProcessor::Writer writer(ofile, names);
+      std::vector<real> in, lats, lons, perimeters, areas, out;
+      std::vector<size_t> offsets(1, 0);
+      for (bool more = true; more;) {
+        const size_t k = reader.Next(2, in);
+        more = k > 0;
+        for (size_t i = 0; i < k; ++i) {
+          using std::isnan;
+          real lat = in[2 * i + (longfirst ? 1 : 0)],
+            lon = in[2 * i + (longfirst ? 0 : 1)];
+          if (isnan(lat) || isnan(lon)) {
+            if (lats.size() > offsets.back()) offsets.push_back(lats.size());
+          } else {
+            lats.push_back(linetype == AUTHALIC ?
+                           ellip.Convert(AuxLatitude::PHI, AuxLatitude::XI,
+                                         lat, exact) : lat);
+            lons.push_back(lon);
+          }
+        }
+        if (!more && lats.size() > offsets.back())
+          offsets.push_back(lats.size());
+        const size_t n = offsets.size() - 1;
+        if (n == 0) continue;
+        perimeters.resize(n); areas.resize(n); out.resize(n * no);
+        if (linetype == RHUMB)
+          empty.polyr.ComputeMany(n, offsets.data(), lats.data(), lons.data(),
+                                  reverse, sign, perimeters.data(),
+                                  areas.data(), nthreads);
+        else
+          empty.poly.ComputeMany(n, offsets.data(), lats.data(), lons.data(),
+                                 reverse, sign, perimeters.data(),
+                                 areas.data(), nthreads);
+        for (size_t j = 0; j < n; ++j) {
+          out[j * no] = real(offsets[j + 1] - offsets[j]);
+          out[j * no + 1] = perimeters[j];
+          if (!polyline) out[j * no + 2] = areas[j];
+        }
+        writer.Write(n, out.data());
+        lats.erase(lats.begin(), lats.begin() + offsets.back());
+        lons.erase(lons.begin(), lons.begin() + offsets.back());
+        offsets.assign(1, 0);
       }
+      writer.Close();
+      return 0;
     }
-    num =
-      linetype == RHUMB ? polyr.Compute(reverse, sign, perimeter, area) :
-      poly.Compute(reverse, sign, perimeter, area);
-    if (num > 0) {
-      *output << num << " " << Utility::str(perimeter, prec);
-      if (!polyline) {
-        *output << " " << Utility::str(area, std::max(0, prec - 5));
+
+    std::string s;
+    if (nthreads <= 1) {
+      GeoCoords p;
+      std::istringstream str;
+      vertex v;
+      ring r(empty);
+      while (std::getline(*input, s)) {
+        parse(s, p, str, v);
+        add(v, r, *output);
+      }
+      flush(r, *output);
+      return 0;
+    }
+
+    // Multi-threaded processing.  The input is read in blocks of lines.  The
+    // lines of a block are parsed concurrently.  The block then consists of
+    // the end of the polygon carried over from the previous block, a set of
+    // complete polygons, and the start of a polygon which is carried over to
+    // the next block.  The complete polygons are split at polygon boundaries
+    // into pieces which are computed concurrently.  The carried polygon is
+    // accumulated on the calling thread, so a single polygon of any size is
+    // handled in constant memory.
+    const size_t nt = size_t(nthreads), nblock = nt * LineProcessor::blocksize;
+    std::vector<std::string> lines(nblock);
+    std::vector<vertex> verts(nblock);
+    std::vector<std::ostringstream> outs(nt);
+    std::vector<size_t> bounds(nt + 1);
+    ring carry(empty);
+    for (bool more = true; more;) {
+      size_t k = 0;
+      while (k < nblock && std::getline(*input, lines[k])) ++k;
+      more = k == nblock;
+      if (k == 0) break;
+      LineProcessor::Dispatch(k, nt, [&](size_t, size_t b, size_t e) {
+          GeoCoords p;
+          std::istringstream str;
+          for (size_t i = b; i < e; ++i)
+            parse(lines[i], p, str, verts[i]);
+        });
+      // [0, i0) ends the carried polygon, [i0, i1) are complete polygons
+      size_t i0 = 0, i1 = k;
+      while (i0 < k && !verts[i0++].endpoly) {}
+      while (i1 > i0 && !verts[i1 - 1].endpoly) --i1;
+      for (size_t i = 0; i < i0; ++i)
+        add(verts[i], carry, *output);
+      // Split [i0, i1) into nt pieces, each ending with a polygon boundary
+      bounds[0] = i0; bounds[nt] = i1;
+      for (size_t t = 1; t < nt; ++t) {
+        size_t i = std::max(bounds[t - 1], i0 + (i1 - i0) * t / nt);
+        while (i < i1 && i > i0 && !verts[i - 1].endpoly) ++i;
+        bounds[t] = i;
       }
-      *output << eol;
+      LineProcessor::Dispatch(nt, nt, [&](size_t t, size_t, size_t) {
+          ring r(empty);
+          outs[t].str(""); outs[t].clear();
+          for (size_t i = bounds[t]; i < bounds[t + 1]; ++i)
+            add(verts[i], r, outs[t]);
+        });
+      for (size_t t = 0; t < nt; ++t)
+        *output << outs[t].str();
+      for (size_t i = i1; i < k; ++i)
+        add(verts[i], carry, *output);
     }
-      linetype == RHUMB ? polyr.Clear() : poly.Clear();
-    eol = "\n";
+    flush(carry, *output);
     return 0;
   }
   catch (const std::exception& e) {
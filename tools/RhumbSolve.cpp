@@ -18,6 +18,7 @@
 #include <GeographicLib/Rhumb.hpp>
 #include <GeographicLib/DMS.hpp>
 #include <GeographicLib/Utility.hpp>
+#include "LineProcessor.hpp"
 
 #if defined(_MSC_VER)
 // Squelch warnings about constant conditional expressions and potentially
@@ -50,12 +51,12 @@ int main(int argc, const char* const argv[]) {
   try {
     Utility::set_digits();
     bool linecalc = false, inverse = false, dms = false, exact = false,
-      unroll = false, longfirst = false;
+      unroll = false, longfirst = false, binary = false;
     real
       a = Constants::WGS84_a(),
       f = Constants::WGS84_f();
-    real lat1, lon1, azi12 = Math::NaN(), lat2, lon2, s12, S12;
-    int prec = 3;
+    real lat1, lon1, azi12 = Math::NaN();
+    int prec = 3, nthreads = 1;
     std::string istring, ifile, ofile, cdelim;
     char lsep = ';', dmssep = char(0);
 
@@ -110,6 +111,17 @@ int main(int argc, const char* const argv[]) {
         }
       } else if (arg == "-E")
         exact = true;
+      else if (arg == "-j") {
+        if (++m == argc) return usage(1, true);
+        try {
+          nthreads = LineProcessor::NumThreads(std::string(argv[m]));
+        }
+        catch (const std::exception& e) {
+          std::cerr << "Error decoding argument of -j: " << e.what() << "\n";
+          return 1;
+        }
+      } else if (arg == "--binary")
+        binary = true;
       else if (arg == "--input-string") {
         if (++m == argc) return usage(1, true);
         istring = argv[m];
@@ -141,11 +153,16 @@ int main(int argc, const char* const argv[]) {
       std::cerr << "Cannot specify --input-string and --input-file together\n";
       return 1;
     }
+    if (binary && !istring.empty()) {
+      std::cerr << "Cannot specify --input-string and --binary together\n";
+      return 1;
+    }
     if (ifile == "-") ifile.clear();
     std::ifstream infile;
     std::istringstream instring;
     if (!ifile.empty()) {
-      infile.open(ifile.c_str());
+      infile.open(ifile.c_str(), binary ? std::ios::in | std::ios::binary :
+                  std::ios::in);
       if (!infile.is_open()) {
         std::cerr << "Cannot open " << ifile << " for reading\n";
         return 1;
@@ -166,7 +183,8 @@ int main(int argc, const char* const argv[]) {
     std::ofstream outfile;
     if (ofile == "-") ofile.clear();
     if (!ofile.empty()) {
-      outfile.open(ofile.c_str());
+      outfile.open(ofile.c_str(), binary ? std::ios::out | std::ios::binary :
+                   std::ios::out);
       if (!outfile.is_open()) {
         std::cerr << "Cannot open " << ofile << " for writing\n";
         return 1;
@@ -177,13 +195,43 @@ int main(int argc, const char* const argv[]) {
     const Rhumb rh(a, f, exact);
     const RhumbLine rhl(linecalc ? rh.Line(lat1, lon1, azi12) :
                         rh.Line(0, 0, Math::qd));
+    if (binary) {
+      // Each record contains the numbers which would appear on an input or
+      // output line; angles are in degrees and the output is not rounded.
+      // Latitudes outside [-90d, 90d] give NaN results (instead of errors).
+      const unsigned outmask = Rhumb::ALL | (unroll ? Rhumb::LONG_UNROLL : 0);
+      auto process = [=, &rh, &rhl](const real in[], real out[]) -> int {
+        real lat1x, lon1x, lat2x, lon2x, azi12x, s12x, S12x;
+        if (linecalc) {
+          rhl.GenPosition(in[0], outmask, lat2x, lon2x, S12x);
+          out[0] = longfirst ? lon2x : lat2x; out[1] = longfirst ? lat2x : lon2x;
+          out[2] = S12x;
+        } else if (inverse) {
+          lat1x = in[longfirst ? 1 : 0]; lon1x = in[longfirst ? 0 : 1];
+          lat2x = in[longfirst ? 3 : 2]; lon2x = in[longfirst ? 2 : 3];
+          rh.Inverse(lat1x, lon1x, lat2x, lon2x, s12x, azi12x, S12x);
+          out[0] = azi12x; out[1] = s12x; out[2] = S12x;
+        } else {                // direct
+          lat1x = in[longfirst ? 1 : 0]; lon1x = in[longfirst ? 0 : 1];
+          rh.GenDirect(lat1x, lon1x, in[2], in[3], outmask,
+                       lat2x, lon2x, S12x);
+          out[0] = longfirst ? lon2x : lat2x; out[1] = longfirst ? lat2x : lon2x;
+          out[2] = S12x;
+        }
+        return 0;
+      };
+      return LineProcessor::ProcessBinary(*input, *output,
+                                          linecalc ? 1 : 4, 3, nthreads,
+                                          process);
+    }
+
     // Max precision = 10: 0.1 nm in distance, 10^-15 deg (= 0.11 nm),
     // 10^-11 sec (= 0.3 nm).
     prec = std::min(10 + Math::extra_digits(), std::max(0, prec));
-    std::string s, eol, slat1, slon1, slat2, slon2, sazi, ss12, strc;
-    std::istringstream str;
-    int retval = 0;
-    while (std::getline(*input, s)) {
+    auto process = [=, &rh, &rhl](std::string s, std::ostream& out) -> int {
+      std::string eol, slat1, slon1, slat2, slon2, sazi, ss12, strc;
+      std::istringstream str;
+      real lat1x, lon1x, azi12x, lat2x, lon2x, s12x, S12x;
       try {
         eol = "\n";
         if (!cdelim.empty()) {
@@ -199,44 +247,45 @@ int main(int argc, const char* const argv[]) {
             throw GeographicErr("Incomplete input: " + s);
           if (str >> strc)
             throw GeographicErr("Extraneous input: " + strc);
-          s12 = Utility::val<real>(ss12);
-          rhl.GenPosition(s12, Rhumb::ALL | (unroll ? Rhumb::LONG_UNROLL : 0),
-                          lat2, lon2, S12);
-          *output << LatLonString(lat2, lon2, prec, dms, dmssep, longfirst)
-                  << " " << Utility::str(S12, std::max(prec-7, 0)) << eol;
+          s12x = Utility::val<real>(ss12);
+          rhl.GenPosition(s12x, Rhumb::ALL | (unroll ? Rhumb::LONG_UNROLL : 0),
+                          lat2x, lon2x, S12x);
+          out << LatLonString(lat2x, lon2x, prec, dms, dmssep, longfirst)
+              << " " << Utility::str(S12x, std::max(prec-7, 0)) << eol;
         } else if (inverse) {
           if (!(str >> slat1 >> slon1 >> slat2 >> slon2))
             throw GeographicErr("Incomplete input: " + s);
           if (str >> strc)
             throw GeographicErr("Extraneous input: " + strc);
-          DMS::DecodeLatLon(slat1, slon1, lat1, lon1, longfirst);
-          DMS::DecodeLatLon(slat2, slon2, lat2, lon2, longfirst);
-          rh.Inverse(lat1, lon1, lat2, lon2, s12, azi12, S12);
-          *output << AzimuthString(azi12, prec, dms, dmssep) << " "
-                  << Utility::str(s12, prec) << " "
-                  << Utility::str(S12, std::max(prec-7, 0)) << eol;
+          DMS::DecodeLatLon(slat1, slon1, lat1x, lon1x, longfirst);
+          DMS::DecodeLatLon(slat2, slon2, lat2x, lon2x, longfirst);
+          rh.Inverse(lat1x, lon1x, lat2x, lon2x, s12x, azi12x, S12x);
+          out << AzimuthString(azi12x, prec, dms, dmssep) << " "
+              << Utility::str(s12x, prec) << " "
+              << Utility::str(S12x, std::max(prec-7, 0)) << eol;
         } else {                // direct
           if (!(str >> slat1 >> slon1 >> sazi >> ss12))
             throw GeographicErr("Incomplete input: " + s);
           if (str >> strc)
             throw GeographicErr("Extraneous input: " + strc);
-          DMS::DecodeLatLon(slat1, slon1, lat1, lon1, longfirst);
-          azi12 = DMS::DecodeAzimuth(sazi);
-          s12 = Utility::val<real>(ss12);
-          rh.GenDirect(lat1, lon1, azi12, s12,
+          DMS::DecodeLatLon(slat1, slon1, lat1x, lon1x, longfirst);
+          azi12x = DMS::DecodeAzimuth(sazi);
+          s12x = Utility::val<real>(ss12);
+          rh.GenDirect(lat1x, lon1x, azi12x, s12x,
                        Rhumb::ALL | (unroll ? Rhumb::LONG_UNROLL : 0),
-                       lat2, lon2, S12);
-          *output << LatLonString(lat2, lon2, prec, dms, dmssep, longfirst)
-                  << " " << Utility::str(S12, std::max(prec-7, 0)) << eol;
+                       lat2x, lon2x, S12x);
+          out << LatLonString(lat2x, lon2x, prec, dms, dmssep, longfirst)
+              << " " << Utility::str(S12x, std::max(prec-7, 0)) << eol;
         }
       }
       catch (const std::exception& e) {
         // Write error message cout so output lines match input lines
-        *output << "ERROR: " << e.what() << "\n";
-        retval = 1;
+        out << "ERROR: " << e.what() << "\n";
+        return 1;
       }
-    }
-    return retval;
+      return 0;
+    };
+    return LineProcessor::Process(*input, *output, nthreads, process);
   }
   catch (const std::exception& e) {
     std::cerr << "Caught exception: " << e.what() << "\n";
@@ -14,9 +14,11 @@
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <vector>
 #include <GeographicLib/TransverseMercator.hpp>
 #include <GeographicLib/DMS.hpp>
 #include <GeographicLib/Utility.hpp>
+#include "LineProcessor.hpp"
 
 #if defined(_MSC_VER)
 // Squelch warnings about constant conditional expressions and potentially
@@ -31,13 +33,14 @@ int main(int argc, const char* const argv[]) {
     using namespace GeographicLib;
     typedef Math::real real;
     Utility::set_digits();
-    bool exact = true, extended = false, reverse = false, longfirst = false;
+    bool exact = true, extended = false, reverse = false, longfirst = false,
+      binary = false;
     real
       a = Constants::WGS84_a(),
       f = Constants::WGS84_f(),
       k0 = Constants::UTM_k0(),
       lon0 = 0;
-    int prec = 6;
+    int prec = 6, nthreads = 1;
     std::string istring, ifile, ofile, cdelim;
     char lsep = ';';
 
@@ -97,7 +100,18 @@ int main(int argc, const char* const argv[]) {
           std::cerr << "Precision " << argv[m] << " is not a number\n";
           return 1;
         }
-      } else if (arg == "--input-string") {
+      } else if (arg == "-j") {
+        if (++m == argc) return usage(1, true);
+        try {
+          nthreads = LineProcessor::NumThreads(std::string(argv[m]));
+        }
+        catch (const std::exception& e) {
+          std::cerr << "Error decoding argument of -j: " << e.what() << "\n";
+          return 1;
+        }
+      } else if (arg == "--binary")
+        binary = true;
+      else if (arg == "--input-string") {
         if (++m == argc) return usage(1, true);
         istring = argv[m];
       } else if (arg == "--input-file") {
@@ -128,11 +142,16 @@ int main(int argc, const char* const argv[]) {
       std::cerr << "Cannot specify --input-string and --input-file together\n";
       return 1;
     }
+    if (binary && !istring.empty()) {
+      std::cerr << "Cannot specify --input-string and --binary together\n";
+      return 1;
+    }
     if (ifile == "-") ifile.clear();
     std::ifstream infile;
     std::istringstream instring;
     if (!ifile.empty()) {
-      infile.open(ifile.c_str());
+      infile.open(ifile.c_str(), binary ? std::ios::in | std::ios::binary :
+                  std::ios::in);
       if (!infile.is_open()) {
         std::cerr << "Cannot open " << ifile << " for reading\n";
         return 1;
@@ -153,7 +172,8 @@ int main(int argc, const char* const argv[]) {
     std::ofstream outfile;
     if (ofile == "-") ofile.clear();
     if (!ofile.empty()) {
-      outfile.open(ofile.c_str());
+      outfile.open(ofile.c_str(), binary ? std::ios::out | std::ios::binary :
+                   std::ios::out);
       if (!outfile.is_open()) {
         std::cerr << "Cannot open " << ofile << " for writing\n";
         return 1;
@@ -163,14 +183,53 @@ int main(int argc, const char* const argv[]) {
 
     const TransverseMercator TM(a, f, k0, exact, extended);
 
+    if (binary) {
+      // Each record contains the 2 numbers which would appear on an input
+      // line and the 4 numbers which would appear on an output line; angles
+      // are in degrees and the output is not rounded.  The records of a
+      // block are passed to the array versions of Forward and Reverse.
+      auto process = [=, &TM](size_t n, const real in[], real out[])
+        -> int {
+        std::vector<real> u(n), v(n), p(n), q(n), gamma(n), k(n);
+        int retval = 0;
+        const bool swap = longfirst && !reverse;
+        for (size_t i = 0; i < n; ++i) {
+          u[i] = in[2*i + (swap ? 1 : 0)]; v[i] = in[2*i + (swap ? 0 : 1)];
+          // Latitudes outside [-90d, 90d] give NaN results (and an error).
+          if (!reverse && std::fabs(u[i]) > Math::qd) {
+            u[i] = Math::NaN(); retval = 1;
+          }
+        }
+        if (reverse)
+          TM.Reverse(lon0, n, u.data(), v.data(), p.data(), q.data(),
+                     gamma.data(), k.data());
+        else
+          TM.Forward(lon0, n, u.data(), v.data(), p.data(), q.data(),
+                     gamma.data(), k.data());
+        for (size_t i = 0; i < n; ++i) {
+          real* o = out + 4*i;
+          if (!reverse && std::isnan(u[i]))
+            o[0] = o[1] = o[2] = o[3] = Math::NaN();
+          else {
+            const bool swapo = longfirst && reverse;
+            o[0] = swapo ? q[i] : p[i]; o[1] = swapo ? p[i] : q[i];
+            o[2] = gamma[i]; o[3] = k[i];
+          }
+        }
+        return retval;
+      };
+      return LineProcessor::ProcessBinaryBlocks(*input, *output, 2, 4,
+                                                nthreads, process);
+    }
+
     // Max precision = 10: 0.1 nm in distance, 10^-15 deg (= 0.11 nm),
     // 10^-11 sec (= 0.3 nm).
     prec = std::min(10 + Math::extra_digits(), std::max(0, prec));
-    std::string s, eol, stra, strb, strc;
-    std::istringstream str;
-    int retval = 0;
     std::cout << std::fixed;
-    while (std::getline(*input, s)) {
+    auto process = [=, &TM](std::string s, std::ostream& out)
+      -> int {
+      std::string eol, stra, strb, strc;
+      std::istringstream str;
       try {
         eol = "\n";
         if (!cdelim.empty()) {
@@ -194,24 +253,25 @@ int main(int argc, const char* const argv[]) {
         real gamma, k;
         if (reverse) {
           TM.Reverse(lon0, x, y, lat, lon, gamma, k);
-          *output << Utility::str(longfirst ? lon : lat, prec + 5) << " "
-                  << Utility::str(longfirst ? lat : lon, prec + 5) << " "
-                  << Utility::str(gamma, prec + 6) << " "
-                  << Utility::str(k, prec + 6) << eol;
+          out << Utility::str(longfirst ? lon : lat, prec + 5) << " "
+              << Utility::str(longfirst ? lat : lon, prec + 5) << " "
+              << Utility::str(gamma, prec + 6) << " "
+              << Utility::str(k, prec + 6) << eol;
         } else {
           TM.Forward(lon0, lat, lon, x, y, gamma, k);
-          *output << Utility::str(x, prec) << " "
-                  << Utility::str(y, prec) << " "
-                  << Utility::str(gamma, prec + 6) << " "
-                  << Utility::str(k, prec + 6) << eol;
+          out << Utility::str(x, prec) << " "
+              << Utility::str(y, prec) << " "
+              << Utility::str(gamma, prec + 6) << " "
+              << Utility::str(k, prec + 6) << eol;
         }
       }
       catch (const std::exception& e) {
-        *output << "ERROR: " << e.what() << "\n";
-        retval = 1;
+        out << "ERROR: " << e.what() << "\n";
+        return 1;
       }
-    }
-    return retval;
+      return 0;
+    };
+    return LineProcessor::Process(*input, *output, nthreads, process);
   }
   catch (const std::exception& e) {
     std::cerr << "Caught exception: " << e.what() << "\n";
@@ -0,0 +1,162 @@
+#include "cgeodesic.h"
+#include <exception>
+#include <string>
+#include <vector>
+#include "GeographicLib/Geodesic.hpp"
+#include "GeographicLib/Rhumb.hpp"
+
+using GeographicLib::Geodesic;
+using GeographicLib::Rhumb;
+using GeographicLib::GeographicErr;
+
+namespace {
+  thread_local std::string lasterror;
+
+  void SetError(const std::exception& e) { lasterror = e.what(); }
+  void SetError() { lasterror = "Unknown exception"; }
+}
+
+struct geodesic_handle {
+  Geodesic geod;
+  geodesic_handle(double a, double f) : geod(a, f) {}
+};
+
+struct rhumb_handle {
+  Rhumb rhumb;
+  rhumb_handle(double a, double f, int exact) : rhumb(a, f, exact != 0) {}
+};
+
+extern "C"
+geodesic_handle* geodesic_open(double a, double f) {
+  try {
+    lasterror.clear();
+    return new geodesic_handle(a, f);
+  }
+  catch (const std::exception& e) { SetError(e); }
+  catch (...) { SetError(); }
+  return nullptr;
+}
+
+extern "C"
+rhumb_handle* rhumb_open(double a, double f, int exact) {
+  try {
+    lasterror.clear();
+    return new rhumb_handle(a, f, exact);
+  }
+  catch (const std::exception& e) { SetError(e); }
+  catch (...) { SetError(); }
+  return nullptr;
+}
+
+extern "C"
+void geodesic_close(geodesic_handle* g) {
+  delete g;
+}
+
+extern "C"
+void rhumb_close(rhumb_handle* r) {
+  delete r;
+}
+
+extern "C"
+int geodesic_direct_batch(const geodesic_handle* g, size_t n,
+                          const double lat1[], const double lon1[],
+                          const double azi1[], const double s12[],
+                          double lat2[], double lon2[], double azi2[]) {
+  try {
+    lasterror.clear();
+    if (!g) throw GeographicErr("Null geodesic handle");
+    unsigned outmask =
+      (lat2 ? unsigned(Geodesic::LATITUDE) : 0U) |
+      (lon2 ? unsigned(Geodesic::LONGITUDE) : 0U) |
+      (azi2 ? unsigned(Geodesic::AZIMUTH) : 0U);
+    double t, lat2x, lon2x, azi2x;
+    for (size_t i = 0; i < n; ++i) {
+      g->geod.GenDirect(lat1[i], lon1[i], azi1[i], false, s12[i], outmask,
+                        lat2x, lon2x, azi2x, t, t, t, t, t);
+      if (lat2) lat2[i] = lat2x;
+      if (lon2) lon2[i] = lon2x;
+      if (azi2) azi2[i] = azi2x;
+    }
+    return 0;
+  }
+  catch (const std::exception& e) { SetError(e); }
+  catch (...) { SetError(); }
+  return -1;
+}
+
+extern "C"
+int geodesic_inverse_batch(const geodesic_handle* g, size_t n,
+                           const double lat1[], const double lon1[],
+                           const double lat2[], const double lon2[],
+                           double s12[], double azi1[], double azi2[]) {
+  try {
+    lasterror.clear();
+    if (!g) throw GeographicErr("Null geodesic handle");
+    unsigned outmask =
+      (s12 ? unsigned(Geodesic::DISTANCE) : 0U) |
+      (azi1 || azi2 ? unsigned(Geodesic::AZIMUTH) : 0U);
+    // GenInverse sets both azimuths, so supply scratch space for a missing
+    // one.
+    std::vector<double> scratch((azi1 == nullptr) != (azi2 == nullptr) ?
+                                n : 0);
+    g->geod.GenInverse(n, lat1, lon1, lat2, lon2, outmask, s12,
+                       azi1 ? azi1 : scratch.data(),
+                       azi2 ? azi2 : scratch.data(),
+                       nullptr, nullptr, nullptr, nullptr);
+    return 0;
+  }
+  catch (const std::exception& e) { SetError(e); }
+  catch (...) { SetError(); }
+  return -1;
+}
+
+extern "C"
+int rhumb_direct_batch(const rhumb_handle* r, size_t n,
+                       const double lat1[], const double lon1[],
+                       const double azi12[], const double s12[],
+                       double lat2[], double lon2[]) {
+  try {
+    lasterror.clear();
+    if (!r) throw GeographicErr("Null rhumb handle");
+    unsigned outmask =
+      (lat2 ? unsigned(Rhumb::LATITUDE) : 0U) |
+      (lon2 ? unsigned(Rhumb::LONGITUDE) : 0U);
+    double t, lat2x, lon2x;
+    for (size_t i = 0; i < n; ++i) {
+      r->rhumb.GenDirect(lat1[i], lon1[i], azi12[i], s12[i], outmask,
+                         lat2x, lon2x, t);
+      if (lat2) lat2[i] = lat2x;
+      if (lon2) lon2[i] = lon2x;
+    }
+    return 0;
+  }
+  catch (const std::exception& e) { SetError(e); }
+  catch (...) { SetError(); }
+  return -1;
+}
+
+extern "C"
+int rhumb_inverse_batch(const rhumb_handle* r, size_t n,
+                        const double lat1[], const double lon1[],
+                        const double lat2[], const double lon2[],
+                        double s12[], double azi12[]) {
+  try {
+    lasterror.clear();
+    if (!r) throw GeographicErr("Null rhumb handle");
+    unsigned outmask =
+      (s12 ? unsigned(Rhumb::DISTANCE) : 0U) |
+      (azi12 ? unsigned(Rhumb::AZIMUTH) : 0U);
+    r->rhumb.GenInverse(n, lat1, lon1, lat2, lon2, outmask,
+                        s12, azi12, nullptr);
+    return 0;
+  }
+  catch (const std::exception& e) { SetError(e); }
+  catch (...) { SetError(); }
+  return -1;
+}
+
+extern "C"
+const char* geodesic_last_error(void) {
+  return lasterror.c_str();
+}
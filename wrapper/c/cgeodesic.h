@@ -0,0 +1,61 @@
+#if !defined(CGEODESIC_H)
+#define CGEODESIC_H 1
+
+#include <stddef.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+  /* Handles to geodesic and rhumb line calculators for a given ellipsoid.
+     These may be used concurrently by several threads. */
+  typedef struct geodesic_handle geodesic_handle;
+  typedef struct rhumb_handle rhumb_handle;
+
+  /* Set up the calculator for the ellipsoid with equatorial radius a
+     (meters) and flattening f.  Returns NULL on error; the reason is given
+     by geodesic_last_error(). */
+  geodesic_handle* geodesic_open(double a, double f);
+  rhumb_handle* rhumb_open(double a, double f, int exact);
+
+  /* Release the resources associated with a handle (NULL is allowed). */
+  void geodesic_close(geodesic_handle* g);
+  void rhumb_close(rhumb_handle* r);
+
+  /* Solve n direct geodesic problems: given (lat1[i], lon1[i], azi1[i],
+     s12[i]) set (lat2[i], lon2[i], azi2[i]).  Any of the output arrays
+     may be NULL.  Returns 0 on success and -1 on error (the reason is given
+     by geodesic_last_error()). */
+  int geodesic_direct_batch(const geodesic_handle* g, size_t n,
+                            const double lat1[], const double lon1[],
+                            const double azi1[], const double s12[],
+                            double lat2[], double lon2[], double azi2[]);
+
+  /* Solve n inverse geodesic problems: given (lat1[i], lon1[i], lat2[i],
+     lon2[i]) set (s12[i], azi1[i], azi2[i]).  Any of the output arrays may
+     be NULL.  The return value is as for geodesic_direct_batch. */
+  int geodesic_inverse_batch(const geodesic_handle* g, size_t n,
+                             const double lat1[], const double lon1[],
+                             const double lat2[], const double lon2[],
+                             double s12[], double azi1[], double azi2[]);
+
+  /* The rhumb line analogs of geodesic_direct_batch and
+     geodesic_inverse_batch. */
+  int rhumb_direct_batch(const rhumb_handle* r, size_t n,
+                         const double lat1[], const double lon1[],
+                         const double azi12[], const double s12[],
+                         double lat2[], double lon2[]);
+  int rhumb_inverse_batch(const rhumb_handle* r, size_t n,
+                          const double lat1[], const double lon1[],
+                          const double lat2[], const double lon2[],
+                          double s12[], double azi12[]);
+
+  /* The message for the last error in the calling thread (an empty
+     string if there has been no error). */
+  const char* geodesic_last_error(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif  /* CGEODESIC_H */
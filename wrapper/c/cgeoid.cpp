@@ -1,6 +1,24 @@
 #include "cgeoid.h"
+#include <exception>
+#include <string>
+#include <vector>
 #include "GeographicLib/Geoid.hpp"
 
+namespace {
+  thread_local std::string lasterror;
+
+  void SetError(const std::exception& e) { lasterror = e.what(); }
+  void SetError() { lasterror = "Unknown exception"; }
+}
+
+struct geoid_handle {
+  GeographicLib::Geoid geoid;
+  geoid_handle(const char* name, const char* path, int cubic,
+               int threadsafe)
+    : geoid(name, path ? path : "", cubic != 0, threadsafe != 0)
+  {}
+};
+
 extern "C"
 double HeightAboveEllipsoid(double lat, double lon, double h) {
   try {
@@ -12,3 +30,63 @@ double HeightAboveEllipsoid(double lat, double lon, double h) {
     return GeographicLib::Math::NaN();
   }
 }
+
+extern "C"
+geoid_handle* geoid_open(const char* name, const char* path, int cubic,
+                         int threadsafe) {
+  try {
+    lasterror.clear();
+    return new geoid_handle(name ? name : "", path, cubic, threadsafe);
+  }
+  catch (const std::exception& e) { SetError(e); }
+  catch (...) { SetError(); }
+  return nullptr;
+}
+
+extern "C"
+void geoid_close(geoid_handle* g) {
+  delete g;
+}
+
+extern "C"
+int geoid_eval_batch(const geoid_handle* g, size_t n,
+                     const double lat[], const double lon[], double N[]) {
+  try {
+    lasterror.clear();
+    if (!g) throw GeographicLib::GeographicErr("Null geoid handle");
+    g->geoid(n, lat, lon, N);
+    return 0;
+  }
+  catch (const std::exception& e) { SetError(e); }
+  catch (...) { SetError(); }
+  for (size_t i = 0; i < n; ++i) N[i] = GeographicLib::Math::NaN();
+  return -1;
+}
+
+extern "C"
+int geoid_height_above_ellipsoid_batch(const geoid_handle* g, size_t n,
+                                       const double lat[],
+                                       const double lon[],
+                                       const double hmsl[],
+                                       double hell[]) {
+  try {
+    // hell may coincide with hmsl, so compute the geoid heights separately
+    std::vector<double> N(n);
+    if (geoid_eval_batch(g, n, lat, lon, N.data()) != 0) {
+      for (size_t i = 0; i < n; ++i) hell[i] = GeographicLib::Math::NaN();
+      return -1;
+    }
+    for (size_t i = 0; i < n; ++i)
+      hell[i] = hmsl[i] + GeographicLib::Geoid::GEOIDTOELLIPSOID * N[i];
+    return 0;
+  }
+  catch (const std::exception& e) { SetError(e); }
+  catch (...) { SetError(); }
+  for (size_t i = 0; i < n; ++i) hell[i] = GeographicLib::Math::NaN();
+  return -1;
+}
+
+extern "C"
+const char* geoid_last_error(void) {
+  return lasterror.c_str();
+}
@@ -1,9 +1,54 @@
 #if !defined(CGEOID_H)
 #define CGEOID_H 1
 
+#include <stddef.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+  /* Convert a height above the egm2008-1 geoid to a height above the
+     ellipsoid.  The geoid is loaded on the first call. */
+  double HeightAboveEllipsoid(double lat, double lon, double h);
+
+  /* A handle to a geoid model which persists between calls. */
+  typedef struct geoid_handle geoid_handle;
+
+  /* Load the geoid model with the given name (e.g., "egm96-5") from path
+     (NULL or "" means use the default directory).  cubic selects cubic
+     (nonzero) or bilinear (zero) interpolation.  If threadsafe is
+     nonzero, the whole data set is read into memory and the handle may be
+     used concurrently by several threads; otherwise the data is read from
+     the file as needed and the handle must only be used by one thread at
+     a time.  Returns NULL on error; the reason is given by
+     geoid_last_error(). */
+  geoid_handle* geoid_open(const char* name, const char* path, int cubic,
+                           int threadsafe);
+
+  /* Release the resources associated with a handle (NULL is allowed). */
+  void geoid_close(geoid_handle* g);
+
+  /* Set N[i] to the geoid height at (lat[i], lon[i]) for i in [0, n).
+     Returns 0 on success and -1 on error, in which case N is filled with
+     NaNs and the reason is given by geoid_last_error(). */
+  int geoid_eval_batch(const geoid_handle* g, size_t n,
+                       const double lat[], const double lon[], double N[]);
+
+  /* Set hell[i] = hmsl[i] + N[i] for i in [0, n), i.e., convert heights
+     above the geoid to heights above the ellipsoid.  hell may coincide
+     with hmsl.  The return value is as for geoid_eval_batch. */
+  int geoid_height_above_ellipsoid_batch(const geoid_handle* g, size_t n,
+                                         const double lat[],
+                                         const double lon[],
+                                         const double hmsl[],
+                                         double hell[]);
+
+  /* The message for the last error in the calling thread (an empty
+     string if there has been no error). */
+  const char* geoid_last_error(void);
+
 #if defined(__cplusplus)
-extern "C"
+}
 #endif
-double HeightAboveEllipsoid(double lat, double lon, double h);
 
 #endif  /* CGEOID_H */
@@ -0,0 +1,40 @@
+#include <stdio.h>
+#include "cgeodesic.h"
+
+#if defined(_MSC_VER)
+/* Squelch warnings about scanf */
+#  pragma warning (disable: 4996)
+#endif
+
+/* Read lines of lat1 lon1 lat2 lon2 and print s12 azi1 azi2, solving the
+   inverse problems in batches. */
+int main() {
+  enum { batch = 1000 };
+  static double lat1[batch], lon1[batch], lat2[batch], lon2[batch],
+    s12[batch], azi1[batch], azi2[batch];
+  size_t n = 0, i;
+  int more = 1;
+  geodesic_handle* g = geodesic_open(6378137, 1/298.257223563);
+  if (!g) {
+    fprintf(stderr, "Error: %s\n", geodesic_last_error());
+    return 1;
+  }
+  while (more) {
+    more = scanf("%lf %lf %lf %lf",
+                 lat1 + n, lon1 + n, lat2 + n, lon2 + n) == 4;
+    if (more) ++n;
+    if (n == batch || (!more && n > 0)) {
+      if (geodesic_inverse_batch(g, n, lat1, lon1, lat2, lon2,
+                                 s12, azi1, azi2) != 0) {
+        fprintf(stderr, "Error: %s\n", geodesic_last_error());
+        geodesic_close(g);
+        return 1;
+      }
+      for (i = 0; i < n; ++i)
+        printf("%.3f %.8f %.8f\n", s12[i], azi1[i], azi2[i]);
+      n = 0;
+    }
+  }
+  geodesic_close(g);
+  return 0;
+}
@@ -23,6 +23,33 @@ Private Declare PtrSafe Sub rinverse Lib "cgeodesic.dll" _
  ByVal lat2 As Double, ByVal lon2 As Double, _
  ByRef s12 As Double, ByRef azi12 As Double)
 
+'   The array versions; the arrays are passed by giving their first
+'   elements ByRef
+
+Private Declare PtrSafe Function gdirect_array Lib "cgeodesic.dll" _
+(ByVal n As Long, ByRef lat1 As Double, ByRef lon1 As Double, _
+ ByRef azi1 As Double, ByRef s12 As Double, _
+ ByRef lat2 As Double, ByRef lon2 As Double, ByRef azi2 As Double, _
+ ByVal nthreads As Long) As Long
+
+Private Declare PtrSafe Function ginverse_array Lib "cgeodesic.dll" _
+(ByVal n As Long, ByRef lat1 As Double, ByRef lon1 As Double, _
+ ByRef lat2 As Double, ByRef lon2 As Double, _
+ ByRef s12 As Double, ByRef azi1 As Double, ByRef azi2 As Double, _
+ ByVal nthreads As Long) As Long
+
+Private Declare PtrSafe Function rdirect_array Lib "cgeodesic.dll" _
+(ByVal n As Long, ByRef lat1 As Double, ByRef lon1 As Double, _
+ ByRef azi12 As Double, ByRef s12 As Double, _
+ ByRef lat2 As Double, ByRef lon2 As Double, _
+ ByVal nthreads As Long) As Long
+
+Private Declare PtrSafe Function rinverse_array Lib "cgeodesic.dll" _
+(ByVal n As Long, ByRef lat1 As Double, ByRef lon1 As Double, _
+ ByRef lat2 As Double, ByRef lon2 As Double, _
+ ByRef s12 As Double, ByRef azi12 As Double, _
+ ByVal nthreads As Long) As Long
+
 '   Define the custom worksheet functions that call the DLL functions
 
 Function geodesic_direct_lat2(lat1 As Double, lon1 As Double, _
@@ -130,3 +157,171 @@ Function rhumb_inverse_azi12(lat1 As Double, lon1 As Double, _
   Call rinverse(lat1, lon1, lat2, lon2, s12, azi12)
   rhumb_inverse_azi12 = azi12
 End Function
+
+'   Helpers for the array functions
+
+'   The number of dimensions of the array v
+Private Function ArrayDims(v As Variant) As Long
+  Dim n As Long
+  Dim t As Long
+  On Error GoTo Done
+  Do
+    t = UBound(v, n + 1)
+    n = n + 1
+  Loop
+Done:
+  ArrayDims = n
+End Function
+
+'   The values of a range, an array, or a number as an array of doubles
+'   (in row-major order for two-dimensional ranges)
+Private Function ToDoubles(x As Variant) As Double()
+  Dim v As Variant
+  Dim d() As Double
+  Dim i As Long
+  Dim j As Long
+  Dim k As Long
+  If TypeName(x) = "Range" Then
+    v = x.Value2
+  Else
+    v = x
+  End If
+  Select Case ArrayDims(v)
+  Case 0
+    ReDim d(0 To 0)
+    d(0) = v
+  Case 1
+    ReDim d(0 To UBound(v) - LBound(v))
+    For i = LBound(v) To UBound(v)
+      d(i - LBound(v)) = v(i)
+    Next i
+  Case Else
+    ReDim d(0 To (UBound(v, 1) - LBound(v, 1) + 1) * _
+                 (UBound(v, 2) - LBound(v, 2) + 1) - 1)
+    k = 0
+    For i = LBound(v, 1) To UBound(v, 1)
+      For j = LBound(v, 2) To UBound(v, 2)
+        d(k) = v(i, j)
+        k = k + 1
+      Next j
+    Next i
+  End Select
+  ToDoubles = d
+End Function
+
+'   Check that the four input arrays have the same size and return it
+Private Function CommonSize(a() As Double, b() As Double, _
+                            c() As Double, d() As Double) As Long
+  CommonSize = UBound(a) + 1
+  If UBound(b) + 1 <> CommonSize Or UBound(c) + 1 <> CommonSize Or _
+     UBound(d) + 1 <> CommonSize Then
+    Err.Raise 5, "Geodesic", "Input ranges must have the same size"
+  End If
+End Function
+
+'   Put the columns of results into an n x m array for returning to a
+'   worksheet
+Private Function Columns2(n As Long, a() As Double, b() As Double) _
+  As Variant
+  Dim r() As Variant
+  Dim i As Long
+  ReDim r(1 To n, 1 To 2)
+  For i = 1 To n
+    r(i, 1) = a(i - 1)
+    r(i, 2) = b(i - 1)
+  Next i
+  Columns2 = r
+End Function
+
+Private Function Columns3(n As Long, a() As Double, b() As Double, _
+                          c() As Double) As Variant
+  Dim r() As Variant
+  Dim i As Long
+  ReDim r(1 To n, 1 To 3)
+  For i = 1 To n
+    r(i, 1) = a(i - 1)
+    r(i, 2) = b(i - 1)
+    r(i, 3) = c(i - 1)
+  Next i
+  Columns3 = r
+End Function
+
+'   The array worksheet functions; these take ranges (or arrays) of
+'   inputs and return an n x 3 (or n x 2) array of results which spills
+'   into the neighboring cells as a dynamic array formula
+
+Function geodesic_direct_array(lat1 As Variant, lon1 As Variant, _
+                               azi1 As Variant, s12 As Variant, _
+                               Optional nthreads As Long = 1) As Variant
+  Attribute geodesic_direct_array.VB_Description = _
+    "Solves direct geodesic problems for lat2, lon2, azi2."
+  Dim a() As Double, b() As Double, c() As Double, d() As Double
+  Dim lat2() As Double, lon2() As Double, azi2() As Double
+  Dim n As Long
+  a = ToDoubles(lat1): b = ToDoubles(lon1)
+  c = ToDoubles(azi1): d = ToDoubles(s12)
+  n = CommonSize(a, b, c, d)
+  ReDim lat2(0 To n - 1): ReDim lon2(0 To n - 1): ReDim azi2(0 To n - 1)
+  If gdirect_array(n, a(0), b(0), c(0), d(0), _
+                   lat2(0), lon2(0), azi2(0), nthreads) <> 0 Then
+    Err.Raise 5, "Geodesic", "geodesic_direct_array failed"
+  End If
+  geodesic_direct_array = Columns3(n, lat2, lon2, azi2)
+End Function
+
+Function geodesic_inverse_array(lat1 As Variant, lon1 As Variant, _
+                                lat2 As Variant, lon2 As Variant, _
+                                Optional nthreads As Long = 1) As Variant
+  Attribute geodesic_inverse_array.VB_Description = _
+    "Solves inverse geodesic problems for s12, azi1, azi2."
+  Dim a() As Double, b() As Double, c() As Double, d() As Double
+  Dim s12() As Double, azi1() As Double, azi2() As Double
+  Dim n As Long
+  a = ToDoubles(lat1): b = ToDoubles(lon1)
+  c = ToDoubles(lat2): d = ToDoubles(lon2)
+  n = CommonSize(a, b, c, d)
+  ReDim s12(0 To n - 1): ReDim azi1(0 To n - 1): ReDim azi2(0 To n - 1)
+  If ginverse_array(n, a(0), b(0), c(0), d(0), _
+                    s12(0), azi1(0), azi2(0), nthreads) <> 0 Then
+    Err.Raise 5, "Geodesic", "geodesic_inverse_array failed"
+  End If
+  geodesic_inverse_array = Columns3(n, s12, azi1, azi2)
+End Function
+
+Function rhumb_direct_array(lat1 As Variant, lon1 As Variant, _
+                            azi12 As Variant, s12 As Variant, _
+                            Optional nthreads As Long = 1) As Variant
+  Attribute rhumb_direct_array.VB_Description = _
+    "Solves direct rhumb problems for lat2, lon2."
+  Dim a() As Double, b() As Double, c() As Double, d() As Double
+  Dim lat2() As Double, lon2() As Double
+  Dim n As Long
+  a = ToDoubles(lat1): b = ToDoubles(lon1)
+  c = ToDoubles(azi12): d = ToDoubles(s12)
+  n = CommonSize(a, b, c, d)
+  ReDim lat2(0 To n - 1): ReDim lon2(0 To n - 1)
+  If rdirect_array(n, a(0), b(0), c(0), d(0), _
+                   lat2(0), lon2(0), nthreads) <> 0 Then
+    Err.Raise 5, "Geodesic", "rhumb_direct_array failed"
+  End If
+  rhumb_direct_array = Columns2(n, lat2, lon2)
+End Function
+
+Function rhumb_inverse_array(lat1 As Variant, lon1 As Variant, _
+                             lat2 As Variant, lon2 As Variant, _
+                             Optional nthreads As Long = 1) As Variant
+  Attribute rhumb_inverse_array.VB_Description = _
+    "Solves inverse rhumb problems for s12, azi12."
+  Dim a() As Double, b() As Double, c() As Double, d() As Double
+  Dim s12() As Double, azi12() As Double
+  Dim n As Long
+  a = ToDoubles(lat1): b = ToDoubles(lon1)
+  c = ToDoubles(lat2): d = ToDoubles(lon2)
+  n = CommonSize(a, b, c, d)
+  ReDim s12(0 To n - 1): ReDim azi12(0 To n - 1)
+  If rinverse_array(n, a(0), b(0), c(0), d(0), _
+                    s12(0), azi12(0), nthreads) <> 0 Then
+    Err.Raise 5, "Geodesic", "rhumb_inverse_array failed"
+  End If
+  rhumb_inverse_array = Columns2(n, s12, azi12)
+End Function
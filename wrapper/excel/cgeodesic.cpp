@@ -1,7 +1,42 @@
 #include "cgeodesic.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <vector>
+#include "GeographicLib/Executor.hpp"
 #include "GeographicLib/Geodesic.hpp"
 #include "GeographicLib/Rhumb.hpp"
 
+namespace {
+
+  // Call work(b, e) for blocks of points [b, e) covering [0, n) on
+  // nthreads threads.  An exception thrown by work is rethrown after all
+  // the threads have finished.
+  template<class F> void blocks(int n, int nthreads, F work) {
+    const int blocksize = 4096, nb = (std::max(n, 0) + blocksize - 1) /
+      blocksize;
+    nthreads = std::min(std::max(nthreads, 1), nb);
+    if (nthreads <= 1) {
+      for (int b = 0; b < n; b += blocksize)
+        work(b, std::min(n, b + blocksize));
+      return;
+    }
+    std::atomic<int> next(0);
+    std::vector<std::exception_ptr> errs(nthreads);
+    GeographicLib::Executor::Current().Run
+      (nthreads, [&](int t) -> void {
+        try {
+          for (int b; (b = next++) < nb;)
+            work(b * blocksize, std::min(n, (b + 1) * blocksize));
+        }
+        catch (...) { errs[t] = std::current_exception(); }
+      });
+    for (auto& e : errs)
+      if (e) std::rethrow_exception(e);
+  }
+
+}
+
 extern "C" {
 
   void gdirect(double lat1, double lon1, double azi1, double s12,
@@ -28,4 +63,72 @@ extern "C" {
                                           s12, azi12);
   }
 
+  int gdirect_array(int n, const double lat1[], const double lon1[],
+                    const double azi1[], const double s12[],
+                    double lat2[], double lon2[], double azi2[],
+                    int nthreads) {
+    try {
+      const GeographicLib::Geodesic& g = GeographicLib::Geodesic::WGS84();
+      blocks(n, nthreads, [&](int b, int e) -> void {
+        for (int i = b; i < e; ++i)
+          g.Direct(lat1[i], lon1[i], azi1[i], s12[i],
+                   lat2[i], lon2[i], azi2[i]);
+      });
+      return 0;
+    }
+    catch (...) {}
+    return -1;
+  }
+
+  int ginverse_array(int n, const double lat1[], const double lon1[],
+                     const double lat2[], const double lon2[],
+                     double s12[], double azi1[], double azi2[],
+                     int nthreads) {
+    try {
+      using GeographicLib::Geodesic;
+      const Geodesic& g = Geodesic::WGS84();
+      blocks(n, nthreads, [&](int b, int e) -> void {
+        g.GenInverse(e - b, lat1 + b, lon1 + b, lat2 + b, lon2 + b,
+                     Geodesic::DISTANCE | Geodesic::AZIMUTH,
+                     s12 + b, azi1 + b, azi2 + b,
+                     nullptr, nullptr, nullptr, nullptr);
+      });
+      return 0;
+    }
+    catch (...) {}
+    return -1;
+  }
+
+  int rdirect_array(int n, const double lat1[], const double lon1[],
+                    const double azi12[], const double s12[],
+                    double lat2[], double lon2[], int nthreads) {
+    try {
+      const GeographicLib::Rhumb& r = GeographicLib::Rhumb::WGS84();
+      blocks(n, nthreads, [&](int b, int e) -> void {
+        for (int i = b; i < e; ++i)
+          r.Direct(lat1[i], lon1[i], azi12[i], s12[i], lat2[i], lon2[i]);
+      });
+      return 0;
+    }
+    catch (...) {}
+    return -1;
+  }
+
+  int rinverse_array(int n, const double lat1[], const double lon1[],
+                     const double lat2[], const double lon2[],
+                     double s12[], double azi12[], int nthreads) {
+    try {
+      using GeographicLib::Rhumb;
+      const Rhumb& r = Rhumb::WGS84();
+      blocks(n, nthreads, [&](int b, int e) -> void {
+        r.GenInverse(e - b, lat1 + b, lon1 + b, lat2 + b, lon2 + b,
+                     Rhumb::DISTANCE | Rhumb::AZIMUTH,
+                     s12 + b, azi12 + b, nullptr);
+      });
+      return 0;
+    }
+    catch (...) {}
+    return -1;
+  }
+
 }
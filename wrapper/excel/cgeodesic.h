@@ -17,6 +17,27 @@ extern "C" {
   void rinverse(double lat1, double lon1, double lat2, double lon2,
                 double& s12, double& azi12);
 
+  /* Array versions of these for n points; these process whole columns of
+     a worksheet in one call.  The work is split into blocks of points over
+     nthreads threads.  Return 0 on success and -1 on error. */
+  int gdirect_array(int n, const double lat1[], const double lon1[],
+                    const double azi1[], const double s12[],
+                    double lat2[], double lon2[], double azi2[],
+                    int nthreads);
+
+  int ginverse_array(int n, const double lat1[], const double lon1[],
+                     const double lat2[], const double lon2[],
+                     double s12[], double azi1[], double azi2[],
+                     int nthreads);
+
+  int rdirect_array(int n, const double lat1[], const double lon1[],
+                    const double azi12[], const double s12[],
+                    double lat2[], double lon2[], int nthreads);
+
+  int rinverse_array(int n, const double lat1[], const double lon1[],
+                     const double lat2[], const double lon2[],
+                     double s12[], double azi12[], int nthreads);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -0,0 +1,50 @@
+// Solve inverse geodesic problems read from standard input, e.g.,
+//   echo 40.6 -73.8 1.4 104 |
+//     java -Djava.library.path=. -cp geographiclib-jni.jar:JNIExample.jar \
+//     JNIExample
+// The input is read in batches of 1000 lines, each of which is solved by
+// a single native call.
+
+import java.io.BufferedReader;
+import java.io.IOException;
+import java.io.InputStreamReader;
+import net.sf.geographiclib.jni.Geodesic;
+
+public class JNIExample {
+  public static void main(String[] args) throws IOException {
+    final int batch = 1000;
+    double[] lat1 = new double[batch], lon1 = new double[batch],
+      lat2 = new double[batch], lon2 = new double[batch],
+      s12 = new double[batch], azi1 = new double[batch],
+      azi2 = new double[batch];
+    BufferedReader in =
+      new BufferedReader(new InputStreamReader(System.in));
+    try (Geodesic g = new Geodesic()) {
+      boolean done = false;
+      while (!done) {
+        int n = 0;
+        String line;
+        while (n < batch && (line = in.readLine()) != null) {
+          String[] f = line.trim().split("\\s+");
+          lat1[n] = Double.parseDouble(f[0]);
+          lon1[n] = Double.parseDouble(f[1]);
+          lat2[n] = Double.parseDouble(f[2]);
+          lon2[n] = Double.parseDouble(f[3]);
+          ++n;
+        }
+        done = n < batch;
+        if (n == 0) break;
+        if (n < batch) {
+          // The methods process whole arrays, so trim them.
+          lat1 = java.util.Arrays.copyOf(lat1, n);
+          lon1 = java.util.Arrays.copyOf(lon1, n);
+          lat2 = java.util.Arrays.copyOf(lat2, n);
+          lon2 = java.util.Arrays.copyOf(lon2, n);
+        }
+        g.inverse(lat1, lon1, lat2, lon2, s12, azi1, azi2);
+        for (int i = 0; i < n; ++i)
+          System.out.printf("%.3f %.8f %.8f%n", s12[i], azi1[i], azi2[i]);
+      }
+    }
+  }
+}
@@ -0,0 +1,308 @@
+// JNI implementation of the native methods of the classes in
+// net.sf.geographiclib.jni.  The Java arrays are accessed with
+// GetPrimitiveArrayCritical, so they are normally not copied; the
+// calculations are carried out without any other JNI calls.
+
+#include <jni.h>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+#include "GeographicLib/Executor.hpp"
+#include "GeographicLib/Geodesic.hpp"
+#include "GeographicLib/Geoid.hpp"
+#include "GeographicLib/PolygonArea.hpp"
+#include "GeographicLib/UTMUPS.hpp"
+
+using namespace GeographicLib;
+
+namespace {
+
+  // Thrown for a bad argument; this becomes an IllegalArgumentException.
+  struct BadArgument : public GeographicErr {
+    explicit BadArgument(const std::string& msg) : GeographicErr(msg) {}
+  };
+
+  // Convert the current C++ exception into a Java exception.
+  void Rethrow(JNIEnv* env) {
+    const char* cls = "net/sf/geographiclib/jni/GeographicErr";
+    std::string msg = "Unknown exception";
+    try { throw; }
+    catch (const BadArgument& e) {
+      cls = "java/lang/IllegalArgumentException"; msg = e.what();
+    }
+    catch (const std::bad_alloc&) {
+      cls = "java/lang/OutOfMemoryError"; msg = "GeographicLib";
+    }
+    catch (const std::exception& e) { msg = e.what(); }
+    catch (...) {}
+    jclass c = env->FindClass(cls);
+    if (c) env->ThrowNew(c, msg.c_str());
+  }
+
+  // Access to the elements of a Java array for the lifetime of the object.
+  // If the array is an input the changes are discarded on release.  A null
+  // array is allowed if optional is true.
+  template<class T> class Critical {
+    JNIEnv* _env;
+    jarray _a;
+    T* _p;
+    jint _mode;
+  public:
+    Critical(JNIEnv* env, jarray a, jsize n, bool input,
+             bool optional = false)
+      : _env(env), _a(a), _p(nullptr), _mode(input ? JNI_ABORT : 0) {
+      if (!_a) {
+        if (optional) return;
+        throw BadArgument("Null array");
+      }
+      if (_env->GetArrayLength(_a) < n)
+        throw BadArgument("Array too short");
+      _p = static_cast<T*>(_env->GetPrimitiveArrayCritical(_a, nullptr));
+      if (!_p) throw std::bad_alloc();
+    }
+    ~Critical()
+    { if (_p) _env->ReleasePrimitiveArrayCritical(_a, _p, _mode); }
+    Critical(const Critical&) = delete;
+    Critical& operator=(const Critical&) = delete;
+    T* get() const { return _p; }
+  };
+
+  // Call work(b, e) for blocks of points [b, e) covering [0, n) on
+  // nthreads threads.  An exception thrown by work is rethrown after all
+  // the threads have finished.
+  template<class F> void Blocks(jsize n, int nthreads, F work) {
+    const jsize blocksize = 4096, nb = (n + blocksize - 1) / blocksize;
+    nthreads = int(std::min(jsize(std::max(nthreads, 1)), nb));
+    if (nthreads <= 1) {
+      for (jsize b = 0; b < n; b += blocksize)
+        work(b, std::min(n, b + blocksize));
+      return;
+    }
+    std::atomic<jsize> next(0);
+    std::vector<std::exception_ptr> errs(nthreads);
+    Executor::Current().Run
+      (nthreads, [&](int t) -> void {
+        try {
+          for (jsize b; (b = next++) < nb;)
+            work(b * blocksize, std::min(n, (b + 1) * blocksize));
+        }
+        catch (...) { errs[t] = std::current_exception(); }
+      });
+    for (auto& e : errs)
+      if (e) std::rethrow_exception(e);
+  }
+
+  jsize Length(JNIEnv* env, jarray a) {
+    if (!a) throw BadArgument("Null array");
+    return env->GetArrayLength(a);
+  }
+
+  template<class T> T* Handle(jlong h) {
+    if (!h) throw BadArgument("Object has been closed");
+    return reinterpret_cast<T*>(h);
+  }
+
+}
+
+extern "C" {
+
+  JNIEXPORT jlong JNICALL
+  Java_net_sf_geographiclib_jni_Geodesic_open
+  (JNIEnv* env, jclass, jdouble a, jdouble f) {
+    try { return reinterpret_cast<jlong>(new Geodesic(a, f)); }
+    catch (...) { Rethrow(env); }
+    return 0;
+  }
+
+  JNIEXPORT void JNICALL
+  Java_net_sf_geographiclib_jni_Geodesic_close
+  (JNIEnv*, jclass, jlong h) {
+    delete reinterpret_cast<Geodesic*>(h);
+  }
+
+  JNIEXPORT void JNICALL
+  Java_net_sf_geographiclib_jni_Geodesic_inverse
+  (JNIEnv* env, jclass, jlong h,
+   jdoubleArray lat1, jdoubleArray lon1,
+   jdoubleArray lat2, jdoubleArray lon2,
+   jdoubleArray s12, jdoubleArray azi1, jdoubleArray azi2, jint nthreads) {
+    try {
+      const Geodesic& g = *Handle<Geodesic>(h);
+      jsize n = Length(env, lat1);
+      // azi1 and azi2 are either both present or both null.
+      if (!azi1 != !azi2)
+        throw BadArgument("azi1 and azi2 must both be given");
+      Critical<double>
+        la1(env, lat1, n, true), lo1(env, lon1, n, true),
+        la2(env, lat2, n, true), lo2(env, lon2, n, true),
+        s(env, s12, n, false), az1(env, azi1, n, false, true),
+        az2(env, azi2, n, false, true);
+      unsigned outmask = Geodesic::DISTANCE |
+        (azi1 ? unsigned(Geodesic::AZIMUTH) : 0U);
+      Blocks(n, nthreads, [&](jsize b, jsize e) -> void {
+        g.GenInverse(e - b, la1.get() + b, lo1.get() + b,
+                     la2.get() + b, lo2.get() + b, outmask, s.get() + b,
+                     azi1 ? az1.get() + b : nullptr,
+                     azi1 ? az2.get() + b : nullptr,
+                     nullptr, nullptr, nullptr, nullptr);
+      });
+    }
+    catch (...) { Rethrow(env); }
+  }
+
+  JNIEXPORT void JNICALL
+  Java_net_sf_geographiclib_jni_Geodesic_direct
+  (JNIEnv* env, jclass, jlong h,
+   jdoubleArray lat1, jdoubleArray lon1,
+   jdoubleArray azi1, jdoubleArray s12,
+   jdoubleArray lat2, jdoubleArray lon2, jdoubleArray azi2, jint nthreads) {
+    try {
+      const Geodesic& g = *Handle<Geodesic>(h);
+      jsize n = Length(env, lat1);
+      Critical<double>
+        la1(env, lat1, n, true), lo1(env, lon1, n, true),
+        az1(env, azi1, n, true), s(env, s12, n, true),
+        la2(env, lat2, n, false), lo2(env, lon2, n, false),
+        az2(env, azi2, n, false, true);
+      Blocks(n, nthreads, [&](jsize b, jsize e) -> void {
+        double azi2x;
+        for (jsize i = b; i < e; ++i) {
+          g.Direct(la1.get()[i], lo1.get()[i], az1.get()[i], s.get()[i],
+                   la2.get()[i], lo2.get()[i], azi2x);
+          if (azi2) az2.get()[i] = azi2x;
+        }
+      });
+    }
+    catch (...) { Rethrow(env); }
+  }
+
+  JNIEXPORT void JNICALL
+  Java_net_sf_geographiclib_jni_PolygonArea_compute
+  (JNIEnv* env, jclass, jlong h, jboolean polyline, jintArray offsets,
+   jdoubleArray lat, jdoubleArray lon, jboolean reverse, jboolean sign,
+   jdoubleArray perimeter, jdoubleArray area, jint nthreads) {
+    try {
+      const Geodesic& g = *Handle<Geodesic>(h);
+      jsize n = Length(env, offsets) - 1, m = Length(env, lat);
+      if (n < 0) throw BadArgument("offsets must have at least 1 element");
+      std::vector<size_t> off(n + 1);
+      {
+        Critical<jint> o(env, offsets, n + 1, true);
+        for (jsize k = 0; k <= n; ++k) {
+          if (o.get()[k] < (k ? o.get()[k - 1] : 0) || o.get()[k] > m)
+            throw BadArgument("Bad offsets");
+          off[k] = size_t(o.get()[k]);
+        }
+      }
+      PolygonArea poly(g, polyline != JNI_FALSE);
+      Critical<double>
+        la(env, lat, m, true), lo(env, lon, m, true),
+        p(env, perimeter, n, false), a(env, area, n, false, true);
+      poly.ComputeMany(n, off.data(), la.get(), lo.get(),
+                       reverse != JNI_FALSE, sign != JNI_FALSE,
+                       p.get(), a.get(), nthreads);
+    }
+    catch (...) { Rethrow(env); }
+  }
+
+  JNIEXPORT void JNICALL
+  Java_net_sf_geographiclib_jni_UTMUPS_forward
+  (JNIEnv* env, jclass, jdoubleArray lat, jdoubleArray lon,
+   jintArray zone, jbooleanArray northp, jdoubleArray x, jdoubleArray y,
+   jint nthreads) {
+    try {
+      jsize n = Length(env, lat);
+      std::unique_ptr<bool[]> north(new bool[n]);
+      {
+        Critical<double>
+          la(env, lat, n, true), lo(env, lon, n, true),
+          xx(env, x, n, false), yy(env, y, n, false);
+        Critical<jint> z(env, zone, n, false);
+        static_assert(sizeof(jint) == sizeof(int), "jint isn't int");
+        UTMUPS::Forward(n, la.get(), lo.get(),
+                        reinterpret_cast<int*>(z.get()), north.get(),
+                        xx.get(), yy.get(), nullptr, nullptr,
+                        UTMUPS::STANDARD, false, nthreads);
+      }
+      Critical<jboolean> np(env, northp, n, false);
+      for (jsize i = 0; i < n; ++i)
+        np.get()[i] = north[i] ? JNI_TRUE : JNI_FALSE;
+    }
+    catch (...) { Rethrow(env); }
+  }
+
+  JNIEXPORT void JNICALL
+  Java_net_sf_geographiclib_jni_UTMUPS_reverse
+  (JNIEnv* env, jclass, jintArray zone, jbooleanArray northp,
+   jdoubleArray x, jdoubleArray y, jdoubleArray lat, jdoubleArray lon,
+   jint nthreads) {
+    try {
+      jsize n = Length(env, zone);
+      Critical<jint> z(env, zone, n, true);
+      Critical<jboolean> np(env, northp, n, true);
+      Critical<double>
+        xx(env, x, n, true), yy(env, y, n, true),
+        la(env, lat, n, false), lo(env, lon, n, false);
+      Blocks(n, nthreads, [&](jsize b, jsize e) -> void {
+        for (jsize i = b; i < e; ++i)
+          UTMUPS::Reverse(z.get()[i], np.get()[i] != JNI_FALSE,
+                          xx.get()[i], yy.get()[i],
+                          la.get()[i], lo.get()[i]);
+      });
+    }
+    catch (...) { Rethrow(env); }
+  }
+
+  JNIEXPORT jlong JNICALL
+  Java_net_sf_geographiclib_jni_Geoid_open
+  (JNIEnv* env, jclass, jstring name, jstring path, jboolean cubic,
+   jboolean threadsafe) {
+    try {
+      if (!name) throw BadArgument("Null geoid name");
+      std::string sname, spath;
+      const char* s = env->GetStringUTFChars(name, nullptr);
+      if (!s) throw std::bad_alloc();
+      sname = s; env->ReleaseStringUTFChars(name, s);
+      if (path) {
+        s = env->GetStringUTFChars(path, nullptr);
+        if (!s) throw std::bad_alloc();
+        spath = s; env->ReleaseStringUTFChars(path, s);
+      }
+      return reinterpret_cast<jlong>
+        (new Geoid(sname, spath, cubic != JNI_FALSE,
+                   threadsafe != JNI_FALSE));
+    }
+    catch (...) { Rethrow(env); }
+    return 0;
+  }
+
+  JNIEXPORT void JNICALL
+  Java_net_sf_geographiclib_jni_Geoid_close
+  (JNIEnv*, jclass, jlong h) {
+    delete reinterpret_cast<Geoid*>(h);
+  }
+
+  JNIEXPORT void JNICALL
+  Java_net_sf_geographiclib_jni_Geoid_height
+  (JNIEnv* env, jclass, jlong h, jdoubleArray lat, jdoubleArray lon,
+   jdoubleArray height) {
+    try {
+      const Geoid& g = *Handle<Geoid>(h);
+      jsize n = Length(env, lat);
+      // The geoid data may need to be read from the file, so copy the
+      // arrays instead of holding them as critical.
+      std::vector<double> la(n), lo(n), hh(n);
+      if (Length(env, lon) < n || Length(env, height) < n)
+        throw BadArgument("Array too short");
+      env->GetDoubleArrayRegion(lat, 0, n, la.data());
+      env->GetDoubleArrayRegion(lon, 0, n, lo.data());
+      g(n, la.data(), lo.data(), hh.data());
+      env->SetDoubleArrayRegion(height, 0, n, hh.data());
+    }
+    catch (...) { Rethrow(env); }
+  }
+
+}
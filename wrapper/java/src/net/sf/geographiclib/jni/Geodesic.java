@@ -0,0 +1,84 @@
+package net.sf.geographiclib.jni;
+
+/**
+ * Geodesic calculations using the GeographicLib C++ library.
+ * <p>
+ * The methods solve many problems in a single call, which amortizes the
+ * cost of the JNI call.  The inputs are arrays of the same length; the
+ * output arrays are supplied by the caller and must be at least as long.
+ * Latitudes, longitudes, and azimuths are in degrees; distances are in
+ * meters.  The points are processed in blocks of 4096 which are spread
+ * over <code>nthreads</code> threads.  An object may be used concurrently
+ * by several threads.
+ */
+public class Geodesic implements AutoCloseable {
+  static { Native.load(); }
+
+  long handle;
+
+  /**
+   * Constructor for an ellipsoid with equatorial radius <code>a</code>
+   * (meters) and flattening <code>f</code>.
+   */
+  public Geodesic(double a, double f) { handle = open(a, f); }
+
+  /**
+   * Constructor for the WGS84 ellipsoid.
+   */
+  public Geodesic() { this(6378137, 1/298.257223563); }
+
+  /**
+   * Release the native resources.
+   */
+  @Override public synchronized void close() {
+    close(handle); handle = 0;
+  }
+
+  /**
+   * Solve the inverse problems for (lat1[i], lon1[i]) and
+   * (lat2[i], lon2[i]), setting s12[i], azi1[i], and azi2[i].
+   * azi1 and azi2 may both be null.
+   */
+  public void inverse(double[] lat1, double[] lon1,
+                      double[] lat2, double[] lon2,
+                      double[] s12, double[] azi1, double[] azi2,
+                      int nthreads) {
+    inverse(handle, lat1, lon1, lat2, lon2, s12, azi1, azi2, nthreads);
+  }
+
+  public void inverse(double[] lat1, double[] lon1,
+                      double[] lat2, double[] lon2,
+                      double[] s12, double[] azi1, double[] azi2) {
+    inverse(lat1, lon1, lat2, lon2, s12, azi1, azi2, 1);
+  }
+
+  /**
+   * Solve the direct problems for (lat1[i], lon1[i]), azi1[i], and
+   * s12[i], setting lat2[i], lon2[i], and azi2[i].  azi2 may be null.
+   */
+  public void direct(double[] lat1, double[] lon1,
+                     double[] azi1, double[] s12,
+                     double[] lat2, double[] lon2, double[] azi2,
+                     int nthreads) {
+    direct(handle, lat1, lon1, azi1, s12, lat2, lon2, azi2, nthreads);
+  }
+
+  public void direct(double[] lat1, double[] lon1,
+                     double[] azi1, double[] s12,
+                     double[] lat2, double[] lon2, double[] azi2) {
+    direct(lat1, lon1, azi1, s12, lat2, lon2, azi2, 1);
+  }
+
+  private static native long open(double a, double f);
+  private static native void close(long h);
+  private static native void inverse(long h,
+                                     double[] lat1, double[] lon1,
+                                     double[] lat2, double[] lon2,
+                                     double[] s12, double[] azi1,
+                                     double[] azi2, int nthreads);
+  private static native void direct(long h,
+                                    double[] lat1, double[] lon1,
+                                    double[] azi1, double[] s12,
+                                    double[] lat2, double[] lon2,
+                                    double[] azi2, int nthreads);
+}
@@ -0,0 +1,9 @@
+package net.sf.geographiclib.jni;
+
+/**
+ * An error reported by the GeographicLib C++ library.
+ */
+public class GeographicErr extends RuntimeException {
+  private static final long serialVersionUID = 1L;
+  public GeographicErr(String msg) { super(msg); }
+}
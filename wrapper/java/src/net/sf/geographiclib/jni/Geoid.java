@@ -0,0 +1,43 @@
+package net.sf.geographiclib.jni;
+
+/**
+ * Geoid heights using the GeographicLib C++ library.
+ */
+public class Geoid implements AutoCloseable {
+  static { Native.load(); }
+
+  private long handle;
+
+  /**
+   * Constructor for the geoid <code>name</code>, e.g., "egm96-5", with
+   * the data in directory <code>path</code> (null for the default).  If
+   * <code>threadsafe</code> is true, the data is read into memory and the
+   * object may be used concurrently by several threads.
+   */
+  public Geoid(String name, String path, boolean cubic,
+               boolean threadsafe) {
+    handle = open(name, path, cubic, threadsafe);
+  }
+
+  public Geoid(String name) { this(name, null, true, false); }
+
+  @Override public synchronized void close() {
+    close(handle); handle = 0;
+  }
+
+  /**
+   * Set h[i] to the height of the geoid above the ellipsoid (meters) at
+   * (lat[i], lon[i]).  The points are visited in the order of the data
+   * in the file, so this is much faster than separate calls for
+   * scattered points.
+   */
+  public void height(double[] lat, double[] lon, double[] h) {
+    height(handle, lat, lon, h);
+  }
+
+  private static native long open(String name, String path, boolean cubic,
+                                  boolean threadsafe);
+  private static native void close(long h);
+  private static native void height(long h, double[] lat, double[] lon,
+                                    double[] height);
+}
@@ -0,0 +1,10 @@
+package net.sf.geographiclib.jni;
+
+/**
+ * Load the native library jnigeographiclib.
+ */
+final class Native {
+  private Native() {}
+  static { System.loadLibrary("jnigeographiclib"); }
+  static void load() {}
+}
@@ -0,0 +1,35 @@
+package net.sf.geographiclib.jni;
+
+/**
+ * Polygon areas using the GeographicLib C++ library.
+ */
+public final class PolygonArea {
+  static { Native.load(); }
+  private PolygonArea() {}
+
+  /**
+   * Compute the perimeters and areas of many polygons (or polylines).
+   * The vertices of polygon k are the elements [offsets[k], offsets[k+1])
+   * of lat and lon; so for a single polygon offsets = {0, lat.length}.
+   * perimeter[k] and area[k] are set to the results for polygon k; area
+   * may be null if polyline is true.  If reverse is true, clockwise
+   * traversal counts as a positive area; if sign is true, a signed area
+   * is returned instead of the area of the rest of the earth.  The
+   * polygons are spread over nthreads threads.
+   */
+  public static void compute(Geodesic g, boolean polyline, int[] offsets,
+                             double[] lat, double[] lon,
+                             boolean reverse, boolean sign,
+                             double[] perimeter, double[] area,
+                             int nthreads) {
+    compute(g.handle, polyline, offsets, lat, lon, reverse, sign,
+            perimeter, area, nthreads);
+  }
+
+  private static native void compute(long h, boolean polyline,
+                                     int[] offsets,
+                                     double[] lat, double[] lon,
+                                     boolean reverse, boolean sign,
+                                     double[] perimeter, double[] area,
+                                     int nthreads);
+}
@@ -0,0 +1,27 @@
+package net.sf.geographiclib.jni;
+
+/**
+ * UTM and UPS conversions using the GeographicLib C++ library.
+ */
+public final class UTMUPS {
+  static { Native.load(); }
+  private UTMUPS() {}
+
+  /**
+   * Convert (lat[i], lon[i]) to the standard UTM or UPS coordinates,
+   * setting zone[i] (0 means UPS), northp[i], x[i], and y[i] (meters).
+   * A GeographicErr is thrown if any point is illegal.
+   */
+  public static native void forward(double[] lat, double[] lon,
+                                    int[] zone, boolean[] northp,
+                                    double[] x, double[] y, int nthreads);
+
+  /**
+   * Convert UTM or UPS coordinates (zone[i], northp[i], x[i], y[i]) to
+   * (lat[i], lon[i]).  A GeographicErr is thrown if any point is illegal.
+   */
+  public static native void reverse(int[] zone, boolean[] northp,
+                                    double[] x, double[] y,
+                                    double[] lat, double[] lon,
+                                    int nthreads);
+}
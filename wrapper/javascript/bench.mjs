@@ -0,0 +1,92 @@
+// Compare the WebAssembly build of GeographicLib with the pure JavaScript
+// geodesic package (npm install geographiclib-geodesic).  Run with
+//   node bench.mjs [n]
+// in the build directory.
+
+import { load } from "./geographiclib.mjs";
+import geodesic from "geographiclib-geodesic";
+
+const n = Number(process.argv[2] || 100000);
+const a = 6378137, f = 1/298.257223563;
+
+// Reproducible pseudo-random numbers in [0, 1).
+let seed = 1;
+function random() {
+  seed = (seed * 48271) % 2147483647;
+  return (seed - 1) / 2147483646;
+}
+
+function time(name, count, fun) {
+  fun();                        // warm up
+  const t0 = performance.now();
+  const r = fun();
+  const t1 = performance.now();
+  console.log(`${name.padEnd(28)} ${(1e6 * (t1 - t0) / count).toFixed(1)} ns`);
+  return r;
+}
+
+const lat1 = new Float64Array(n), lon1 = new Float64Array(n),
+      lat2 = new Float64Array(n), lon2 = new Float64Array(n);
+for (let i = 0; i < n; ++i) {
+  lat1[i] = 180 * random() - 90; lon1[i] = 360 * random() - 180;
+  lat2[i] = 180 * random() - 90; lon2[i] = 360 * random() - 180;
+}
+// A polygon: a closed track with n vertices around a small circle.
+const plat = new Float64Array(n), plon = new Float64Array(n);
+for (let i = 0; i < n; ++i) {
+  const t = 2 * Math.PI * i / n;
+  plat[i] = 40 + 5 * Math.sin(t); plon[i] = -75 + 5 * Math.cos(t);
+}
+// A route for densification with points every 1 km.
+const rlat = lat1.slice(0, 100), rlon = lon1.slice(0, 100), ds = 1000;
+
+const geo = await load();
+const g = geo.Geodesic(a, f), tm = geo.TransverseMercator(a, f, 0.9996);
+const gjs = new geodesic.Geodesic.Geodesic(a, f);
+
+console.log(`Time per operation for ${n} operations`);
+const sw = time("wasm Inverse", n,
+                () => g.Inverse(lat1, lon1, lat2, lon2).s12);
+const sj = time("js   Inverse", n, () => {
+  const s12 = new Float64Array(n);
+  for (let i = 0; i < n; ++i)
+    s12[i] = gjs.Inverse(lat1[i], lon1[i], lat2[i], lon2[i],
+                         geodesic.Geodesic.DISTANCE).s12;
+  return s12;
+});
+
+const aw = time("wasm Polygon (per vertex)", n,
+                () => g.Polygons([0, n], plat, plon).area[0]);
+const aj = time("js   Polygon (per vertex)", n, () => {
+  const p = gjs.Polygon(false);
+  for (let i = 0; i < n; ++i) p.AddPoint(plat[i], plon[i]);
+  return p.Compute(false, true).area;
+});
+
+const m = g.Densify(rlat, rlon, ds).lat.length;
+const dw = time("wasm Densify (per point)", m,
+                () => g.Densify(rlat, rlon, ds).lat);
+const dj = time("js   Densify (per point)", m, () => {
+  const lat = [];
+  for (let i = 0; i + 1 < rlat.length; ++i) {
+    const l = gjs.InverseLine(rlat[i], rlon[i], rlat[i + 1], rlon[i + 1],
+                              geodesic.Geodesic.LATITUDE |
+                              geodesic.Geodesic.LONGITUDE |
+                              geodesic.Geodesic.DISTANCE_IN);
+    const k = Math.max(1, Math.ceil(l.s13 / ds));
+    for (let j = 0; j < k; ++j) lat.push(l.Position(j * l.s13 / k).lat2);
+  }
+  lat.push(rlat[rlat.length - 1]);
+  return lat;
+});
+
+time("wasm TM Forward", n, () => tm.Forward(0, plat, plon).x);
+
+// Check that the two implementations agree.
+let ds12 = 0, dlat = 0;
+for (let i = 0; i < n; ++i) ds12 = Math.max(ds12, Math.abs(sw[i] - sj[i]));
+for (let i = 0; i < m; ++i) dlat = Math.max(dlat, Math.abs(dw[i] - dj[i]));
+console.log(`Max differences: s12 ${ds12} m, area ${Math.abs(aw - aj)} m^2,` +
+            ` densified lat ${dlat} deg`);
+
+g.close(); tm.close();
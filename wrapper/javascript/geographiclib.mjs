@@ -0,0 +1,145 @@
+// A JavaScript interface to the WebAssembly build of GeographicLib.  The
+// batch functions take and return Float64Arrays (other array-like objects
+// of numbers are converted).  Usage:
+//
+//   import { load } from "./geographiclib.mjs";
+//   const geo = await load();
+//   const g = geo.Geodesic(6378137, 1/298.257223563);
+//   const { s12, azi1, azi2 } = g.Inverse(lat1, lon1, lat2, lon2);
+//   g.close();
+
+import createGeographicLib from "./geographiclib-wasm.mjs";
+
+class Heap {
+  // Room for arrays of doubles in the module's memory; the arrays are
+  // freed together by release.
+  constructor(M) { this.M = M; this.ptrs = []; }
+  alloc(n) {
+    const p = this.M._malloc(8 * Math.max(n, 1));
+    if (!p) throw new Error("GeographicLib: out of memory");
+    this.ptrs.push(p);
+    return p;
+  }
+  // Copy a into the module's memory.
+  input(a) {
+    const p = this.alloc(a.length);
+    this.M.HEAPF64.set(a, p / 8);
+    return p;
+  }
+  // Copy n doubles out of the module's memory.  (HEAPF64 is looked up each
+  // time since it's replaced if the memory grows.)
+  output(p, n) { return this.M.HEAPF64.slice(p / 8, p / 8 + n); }
+  release() { for (const p of this.ptrs) this.M._free(p); this.ptrs = []; }
+}
+
+class Geodesic {
+  constructor(M, a, f) {
+    this.M = M;
+    this.h = M._geodesic_open(a, f);
+    if (!this.h) throw new Error(M.UTF8ToString(
+      M._geographiclib_last_error()));
+  }
+  close() { this.M._geodesic_close(this.h); this.h = 0; }
+  check(r) {
+    if (r < 0) throw new Error(this.M.UTF8ToString(
+      this.M._geographiclib_last_error()));
+    return r;
+  }
+  // Solve the inverse problems for corresponding elements of the arrays.
+  Inverse(lat1, lon1, lat2, lon2) {
+    const n = lat1.length, H = new Heap(this.M);
+    try {
+      const s12 = H.alloc(n), azi1 = H.alloc(n), azi2 = H.alloc(n);
+      this.check(this.M._geodesic_inverse(
+        this.h, n, H.input(lat1), H.input(lon1), H.input(lat2),
+        H.input(lon2), s12, azi1, azi2));
+      return { s12: H.output(s12, n), azi1: H.output(azi1, n),
+               azi2: H.output(azi2, n) };
+    } finally { H.release(); }
+  }
+  // Solve the direct problems for corresponding elements of the arrays.
+  Direct(lat1, lon1, azi1, s12) {
+    const n = lat1.length, H = new Heap(this.M);
+    try {
+      const lat2 = H.alloc(n), lon2 = H.alloc(n), azi2 = H.alloc(n);
+      this.check(this.M._geodesic_direct(
+        this.h, n, H.input(lat1), H.input(lon1), H.input(azi1),
+        H.input(s12), lat2, lon2, azi2));
+      return { lat2: H.output(lat2, n), lon2: H.output(lon2, n),
+               azi2: H.output(azi2, n) };
+    } finally { H.release(); }
+  }
+  // Add points along each edge of the polyline (lat, lon), so that
+  // consecutive points are no more than ds meters apart.
+  Densify(lat, lon, ds) {
+    const n = lat.length, H = new Heap(this.M);
+    try {
+      const plat = H.input(lat), plon = H.input(lon);
+      const m = this.check(this.M._geodesic_densify(
+        this.h, n, plat, plon, ds, 0, 0, 0));
+      const latout = H.alloc(m), lonout = H.alloc(m);
+      this.check(this.M._geodesic_densify(
+        this.h, n, plat, plon, ds, m, latout, lonout));
+      return { lat: H.output(latout, m), lon: H.output(lonout, m) };
+    } finally { H.release(); }
+  }
+  // The perimeters and areas of several polygons; the vertices of polygon
+  // k are elements [offsets[k], offsets[k+1]) of lat and lon.  For a
+  // single polygon, offsets = [0, lat.length].
+  Polygons(offsets, lat, lon, polyline = false, reverse = false,
+           sign = true) {
+    const n = offsets.length - 1, H = new Heap(this.M);
+    try {
+      const poff = H.alloc(Math.ceil((n + 1) / 2));
+      this.M.HEAPU32.set(offsets, poff / 4);
+      const perimeter = H.alloc(n), area = H.alloc(n);
+      this.check(this.M._polygon_compute(
+        this.h, polyline ? 1 : 0, n, poff, H.input(lat), H.input(lon),
+        reverse ? 1 : 0, sign ? 1 : 0, perimeter, area));
+      return { perimeter: H.output(perimeter, n),
+               area: polyline ? null : H.output(area, n) };
+    } finally { H.release(); }
+  }
+}
+
+class TransverseMercator {
+  constructor(M, a, f, k0) {
+    this.M = M;
+    this.h = M._tm_open(a, f, k0);
+    if (!this.h) throw new Error(M.UTF8ToString(
+      M._geographiclib_last_error()));
+  }
+  close() { this.M._tm_close(this.h); this.h = 0; }
+  check(r) { Geodesic.prototype.check.call(this, r); }
+  Forward(lon0, lat, lon) {
+    const n = lat.length, H = new Heap(this.M);
+    try {
+      const x = H.alloc(n), y = H.alloc(n), gamma = H.alloc(n),
+            k = H.alloc(n);
+      this.check(this.M._tm_forward(this.h, lon0, n, H.input(lat),
+                                    H.input(lon), x, y, gamma, k));
+      return { x: H.output(x, n), y: H.output(y, n),
+               gamma: H.output(gamma, n), k: H.output(k, n) };
+    } finally { H.release(); }
+  }
+  Reverse(lon0, x, y) {
+    const n = x.length, H = new Heap(this.M);
+    try {
+      const lat = H.alloc(n), lon = H.alloc(n), gamma = H.alloc(n),
+            k = H.alloc(n);
+      this.check(this.M._tm_reverse(this.h, lon0, n, H.input(x),
+                                    H.input(y), lat, lon, gamma, k));
+      return { lat: H.output(lat, n), lon: H.output(lon, n),
+               gamma: H.output(gamma, n), k: H.output(k, n) };
+    } finally { H.release(); }
+  }
+}
+
+// Load the WebAssembly module and return the constructors.
+export async function load() {
+  const M = await createGeographicLib();
+  return {
+    Geodesic: (a, f) => new Geodesic(M, a, f),
+    TransverseMercator: (a, f, k0) => new TransverseMercator(M, a, f, k0),
+  };
+}
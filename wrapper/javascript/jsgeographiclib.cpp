@@ -0,0 +1,239 @@
+// Batch entry points into GeographicLib for a WebAssembly module.  The
+// arrays are pointers into the module's memory, so JavaScript typed arrays
+// are passed by copying the data into the buffers returned by _malloc; see
+// geographiclib-wasm.mjs.
+
+#include <cmath>
+#include <exception>
+#include <string>
+#include <vector>
+#include "GeographicLib/Geodesic.hpp"
+#include "GeographicLib/GeodesicLine.hpp"
+#include "GeographicLib/PolygonArea.hpp"
+#include "GeographicLib/TransverseMercator.hpp"
+
+#if defined(__EMSCRIPTEN__)
+#  include <emscripten/emscripten.h>
+#  define JSGEO_EXPORT extern "C" EMSCRIPTEN_KEEPALIVE
+#else
+#  define JSGEO_EXPORT extern "C"
+#endif
+
+using GeographicLib::Geodesic;
+using GeographicLib::GeodesicLine;
+using GeographicLib::PolygonArea;
+using GeographicLib::TransverseMercator;
+using GeographicLib::GeographicErr;
+
+namespace {
+  std::string lasterror;
+
+  void SetError(const std::exception& e) { lasterror = e.what(); }
+  void SetError() { lasterror = "Unknown exception"; }
+}
+
+struct geodesic_handle {
+  Geodesic geod;
+  geodesic_handle(double a, double f) : geod(a, f) {}
+};
+
+struct tm_handle {
+  TransverseMercator tm;
+  tm_handle(double a, double f, double k0) : tm(a, f, k0) {}
+};
+
+// Set up the calculators.  Return null on error.
+JSGEO_EXPORT
+geodesic_handle* geodesic_open(double a, double f) {
+  try {
+    lasterror.clear();
+    return new geodesic_handle(a, f);
+  }
+  catch (const std::exception& e) { SetError(e); }
+  catch (...) { SetError(); }
+  return nullptr;
+}
+
+JSGEO_EXPORT
+tm_handle* tm_open(double a, double f, double k0) {
+  try {
+    lasterror.clear();
+    return new tm_handle(a, f, k0);
+  }
+  catch (const std::exception& e) { SetError(e); }
+  catch (...) { SetError(); }
+  return nullptr;
+}
+
+JSGEO_EXPORT
+void geodesic_close(geodesic_handle* g) {
+  delete g;
+}
+
+JSGEO_EXPORT
+void tm_close(tm_handle* t) {
+  delete t;
+}
+
+// n direct problems; azi2 may be null.  Return 0 on success, -1 on error.
+JSGEO_EXPORT
+int geodesic_direct(const geodesic_handle* g, int n,
+                    const double lat1[], const double lon1[],
+                    const double azi1[], const double s12[],
+                    double lat2[], double lon2[], double azi2[]) {
+  try {
+    lasterror.clear();
+    if (!g) throw GeographicErr("Null geodesic handle");
+    unsigned outmask = Geodesic::LATITUDE | Geodesic::LONGITUDE |
+      (azi2 ? unsigned(Geodesic::AZIMUTH) : 0U);
+    double t, azi2x;
+    for (int i = 0; i < n; ++i) {
+      g->geod.GenDirect(lat1[i], lon1[i], azi1[i], false, s12[i], outmask,
+                        lat2[i], lon2[i], azi2x, t, t, t, t, t);
+      if (azi2) azi2[i] = azi2x;
+    }
+    return 0;
+  }
+  catch (const std::exception& e) { SetError(e); }
+  catch (...) { SetError(); }
+  return -1;
+}
+
+// n inverse problems; azi1 and azi2 may be null.
+JSGEO_EXPORT
+int geodesic_inverse(const geodesic_handle* g, int n,
+                     const double lat1[], const double lon1[],
+                     const double lat2[], const double lon2[],
+                     double s12[], double azi1[], double azi2[]) {
+  try {
+    lasterror.clear();
+    if (!g) throw GeographicErr("Null geodesic handle");
+    unsigned outmask = Geodesic::DISTANCE |
+      (azi1 || azi2 ? unsigned(Geodesic::AZIMUTH) : 0U);
+    // GenInverse sets both azimuths, so supply scratch space for a missing
+    // one.
+    std::vector<double> scratch((azi1 == nullptr) != (azi2 == nullptr) ?
+                                n : 0);
+    g->geod.GenInverse(n, lat1, lon1, lat2, lon2, outmask, s12,
+                       azi1 ? azi1 : scratch.data(),
+                       azi2 ? azi2 : scratch.data(),
+                       nullptr, nullptr, nullptr, nullptr);
+    return 0;
+  }
+  catch (const std::exception& e) { SetError(e); }
+  catch (...) { SetError(); }
+  return -1;
+}
+
+// Densify the polyline given by n vertices so that consecutive points are
+// no more than ds apart, each edge being divided into equal pieces.  The
+// result has the original vertices together with the added points.  The
+// number of points in the result is returned; this is only written to
+// (latout, lonout) if there's room for it, i.e., if it doesn't exceed m.
+// Return -1 on error.
+JSGEO_EXPORT
+int geodesic_densify(const geodesic_handle* g, int n,
+                     const double lat[], const double lon[], double ds,
+                     int m, double latout[], double lonout[]) {
+  try {
+    lasterror.clear();
+    if (!g) throw GeographicErr("Null geodesic handle");
+    if (!(ds > 0)) throw GeographicErr("Spacing must be positive");
+    if (n <= 0) return 0;
+    std::vector<GeodesicLine> lines;
+    std::vector<int> pieces;
+    lines.reserve(n - 1); pieces.reserve(n - 1);
+    double count = 1;
+    for (int i = 0; i + 1 < n; ++i) {
+      lines.push_back(g->geod.InverseLine(lat[i], lon[i],
+                                          lat[i + 1], lon[i + 1],
+                                          Geodesic::LATITUDE |
+                                          Geodesic::LONGITUDE |
+                                          Geodesic::DISTANCE_IN));
+      double k = std::fmax(1, std::ceil(lines.back().Distance() / ds));
+      if (!(k < 1e9)) throw GeographicErr("Too many points in result");
+      pieces.push_back(int(k));
+      count += k;
+    }
+    if (!(count < 1e9)) throw GeographicErr("Too many points in result");
+    int num = int(count);
+    if (num <= m) {
+      int j = 0;
+      for (int i = 0; i + 1 < n; ++i) {
+        int k = pieces[i];
+        lines[i].Waypoints(0, lines[i].Distance() / k, k,
+                           latout + j, lonout + j);
+        // Use the given vertex for the start of each edge.
+        latout[j] = lat[i]; lonout[j] = lon[i];
+        j += k;
+      }
+      latout[j] = lat[n - 1]; lonout[j] = lon[n - 1];
+    }
+    return num;
+  }
+  catch (const std::exception& e) { SetError(e); }
+  catch (...) { SetError(); }
+  return -1;
+}
+
+// The perimeters and areas of n polygons (or polylines); the vertices of
+// polygon k are elements [offsets[k], offsets[k+1]) of lat and lon.  area
+// may be null for polylines.
+JSGEO_EXPORT
+int polygon_compute(const geodesic_handle* g, int polyline, int n,
+                    const unsigned offsets[],
+                    const double lat[], const double lon[],
+                    int reverse, int sign,
+                    double perimeter[], double area[]) {
+  try {
+    lasterror.clear();
+    if (!g) throw GeographicErr("Null geodesic handle");
+    PolygonArea poly(g->geod, polyline != 0);
+    std::vector<size_t> off(offsets, offsets + (n + 1));
+    poly.ComputeMany(n, off.data(), lat, lon, reverse != 0, sign != 0,
+                     perimeter, area);
+    return 0;
+  }
+  catch (const std::exception& e) { SetError(e); }
+  catch (...) { SetError(); }
+  return -1;
+}
+
+// Forward and reverse transverse Mercator projections of n points with
+// central meridian lon0; gamma and k may be null.
+JSGEO_EXPORT
+int tm_forward(const tm_handle* t, double lon0, int n,
+               const double lat[], const double lon[],
+               double x[], double y[], double gamma[], double k[]) {
+  try {
+    lasterror.clear();
+    if (!t) throw GeographicErr("Null transverse Mercator handle");
+    t->tm.Forward(lon0, n, lat, lon, x, y, gamma, k);
+    return 0;
+  }
+  catch (const std::exception& e) { SetError(e); }
+  catch (...) { SetError(); }
+  return -1;
+}
+
+JSGEO_EXPORT
+int tm_reverse(const tm_handle* t, double lon0, int n,
+               const double x[], const double y[],
+               double lat[], double lon[], double gamma[], double k[]) {
+  try {
+    lasterror.clear();
+    if (!t) throw GeographicErr("Null transverse Mercator handle");
+    t->tm.Reverse(lon0, n, x, y, lat, lon, gamma, k);
+    return 0;
+  }
+  catch (const std::exception& e) { SetError(e); }
+  catch (...) { SetError(); }
+  return -1;
+}
+
+// The message for the last error (an empty string if there has been no
+// error).
+JSGEO_EXPORT
+const char* geographiclib_last_error() {
+  return lasterror.c_str();
+}
@@ -0,0 +1,101 @@
+/**
+ * \file geodesicdirect.cpp
+ * \brief Matlab mex file for solving the direct geodesic problem
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+// Compile in Matlab with
+// [Unix]
+// mex -I/usr/local/include -L/usr/local/lib -Wl,-rpath=/usr/local/lib
+//    -lGeographicLib geodesicdirect.cpp
+// [Windows]
+// mex -I../include -L../windows/Release
+//    -lGeographicLib geodesicdirect.cpp
+
+#include <algorithm>
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/GeodesicExact.hpp>
+#include "geographiclibmex.hpp"
+
+using namespace std;
+using namespace GeographicLib;
+
+template<class G> void
+compute(double a, double f, mwSize m, const double* geodesic,
+        double* latlong, double* aux, int nthreads) {
+  const double* lat1 = geodesic;
+  const double* lon1 = geodesic + m;
+  const double* azi1 = geodesic + 2*m;
+  const double* s12 = geodesic + 3*m;
+  double* lat2 = latlong;
+  double* lon2 = latlong + m;
+  double* azi2 = latlong + 2*m;
+  unsigned outmask = G::LATITUDE | G::LONGITUDE | G::AZIMUTH;
+  if (aux)
+    outmask |= G::REDUCEDLENGTH | G::GEODESICSCALE | G::AREA;
+
+  const G g(a, f);
+  geographiclibmex::blocks
+    (m, nthreads, [&](mwSize b, mwSize e) -> void {
+      double t;
+      for (mwIndex i = b; i < e; ++i) {
+        if (aux)
+          aux[i] = g.GenDirect(lat1[i], lon1[i], azi1[i], false, s12[i],
+                               outmask, lat2[i], lon2[i], azi2[i], t,
+                               aux[i + m], aux[i + 2*m], aux[i + 3*m],
+                               aux[i + 4*m]);
+        else
+          g.GenDirect(lat1[i], lon1[i], azi1[i], false, s12[i],
+                      outmask, lat2[i], lon2[i], azi2[i], t, t, t, t, t);
+      }
+    });
+}
+
+void mexFunction( int nlhs, mxArray* plhs[],
+                  int nrhs, const mxArray* prhs[] ) {
+
+  if (nrhs < 1)
+    mexErrMsgTxt("One input argument required.");
+  else if (nrhs > 4)
+    mexErrMsgTxt("More than four input arguments specified.");
+  else if (nrhs == 2)
+    mexErrMsgTxt("Must specify flattening with the equatorial radius.");
+  else if (nlhs > 2)
+    mexErrMsgTxt("More than two output arguments specified.");
+
+  const double* geodesic = geographiclibmex::matrix
+    (prhs[0], 4, "geodesic must be M x 4 matrix of doubles.");
+
+  double a = Constants::WGS84_a<double>(), f = Constants::WGS84_f<double>();
+  int nthreads = 1;
+  if (nrhs >= 3) {
+    a = geographiclibmex::scalar
+      (prhs[1], "Equatorial radius is not a real scalar.");
+    f = geographiclibmex::scalar
+      (prhs[2], "Flattening is not a real scalar.");
+  }
+  if (nrhs == 4)
+    nthreads = int(geographiclibmex::scalar
+                   (prhs[3], "Number of threads is not a real scalar."));
+
+  mwSize m = mxGetM(prhs[0]);
+
+  double* latlong = mxGetPr(plhs[0] = mxCreateDoubleMatrix(m, 3, mxREAL));
+
+  double* aux =
+    nlhs == 2 ? mxGetPr(plhs[1] = mxCreateDoubleMatrix(m, 5, mxREAL)) :
+    NULL;
+
+  try {
+    if (std::abs(f) <= 0.02)
+      compute<Geodesic>(a, f, m, geodesic, latlong, aux, nthreads);
+    else
+      compute<GeodesicExact>(a, f, m, geodesic, latlong, aux, nthreads);
+  }
+  catch (const std::exception& e) {
+    mexErrMsgTxt(e.what());
+  }
+}
@@ -0,0 +1,35 @@
+function geodesicdirect(~, ~, ~, ~)
+%geodesicdirect  Solve direct geodesic problem
+%
+%   [latlong, aux] = geodesicdirect(geodesic)
+%   [latlong, aux] = geodesicdirect(geodesic, a, f)
+%   [latlong, aux] = geodesicdirect(geodesic, a, f, nthreads)
+%
+%   geodesic is an M x 4 matrix
+%       latitude of point 1 = geodesic(:,1) in degrees
+%       longitude of point 1 = geodesic(:,2) in degrees
+%       azimuth at point 1 = geodesic(:,3) in degrees
+%       distance between points 1 and 2 = geodesic(:,4) in meters
+%
+%   latlong is an M x 3 matrix
+%       latitude of point 2 = latlong(:,1) in degrees
+%       longitude of point 2 = latlong(:,2) in degrees
+%       azimuth at point 2 = latlong(:,3) in degrees
+%   aux is an M x 5 matrix
+%       spherical arc length = aux(:,1) in degrees
+%       reduced length = aux(:,2) in meters
+%       geodesic scale 1 to 2 = aux(:,3)
+%       geodesic scale 2 to 1 = aux(:,4)
+%       area under geodesic = aux(:,5) in meters^2
+%
+%   a = equatorial radius (meters)
+%   f = flattening (0 means a sphere)
+%   If a and f are omitted, the WGS84 values are used.
+%   nthreads = the number of threads to use (default 1)
+%
+% A native MATLAB implementation is available as GEODRECKON.
+%
+% See also GEODRECKON, GEODESICINVERSE.
+
+  error('Error: executing .m file instead of compiled routine');
+end
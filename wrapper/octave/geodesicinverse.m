@@ -1,8 +1,9 @@
-function geodesicinverse(~, ~, ~)
+function geodesicinverse(~, ~, ~, ~)
 %geodesicinverse  Solve inverse geodesic problem
 %
 %   [geodesic, aux] = geodesicinverse(latlong)
 %   [geodesic, aux] = geodesicinverse(latlong, a, f)
+%   [geodesic, aux] = geodesicinverse(latlong, a, f, nthreads)
 %
 %   latlong is an M x 4 matrix
 %       latitude of point 1 = latlong(:,1) in degrees
@@ -24,10 +25,11 @@ function geodesicinverse(~, ~, ~)
 %   a = equatorial radius (meters)
 %   f = flattening (0 means a sphere)
 %   If a and f are omitted, the WGS84 values are used.
+%   nthreads = the number of threads to use (default 1)
 %
 % A native MATLAB implementation is available as GEODDISTANCE.
 %
-% See also GEODDISTANCE.
+% See also GEODDISTANCE, GEODESICDIRECT.
 
   error('Error: executing .m file instead of compiled routine');
 end
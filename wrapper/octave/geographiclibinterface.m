@@ -29,7 +29,8 @@ function geographiclibinterface(incdir, libdir)
 %
 % Run 'mex -setup' to configure the C++ compiler for Matlab to use.
 
-  funs = { 'geodesicinverse' };
+  funs = { 'geodesicinverse', 'geodesicdirect', 'tranmercforward', ...
+           'tranmercreverse', 'geoidheight' };
   lib='GeographicLib';
   if (nargin < 2)
     if (nargin == 0)
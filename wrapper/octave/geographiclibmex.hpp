@@ -0,0 +1,71 @@
+/**
+ * \file geographiclibmex.hpp
+ * \brief Utilities for the Matlab mex files
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIBMEX_HPP)
+#define GEOGRAPHICLIBMEX_HPP 1
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <vector>
+#include <GeographicLib/Executor.hpp>
+#include <mex.h>
+
+namespace geographiclibmex {
+
+  // The number of rows handled as a block.  The inputs and outputs are the
+  // columns of the Matlab matrices, which are accessed in place.
+  const mwSize blocksize = 4096;
+
+  // Call work(b, e) for blocks of rows [b, e) covering [0, m) on nthreads
+  // threads.  An exception thrown by work is rethrown after all the threads
+  // have finished.
+  template<class F> void blocks(mwSize m, int nthreads, F work) {
+    mwSize nb = (m + blocksize - 1) / blocksize;
+    nthreads = int(std::min(mwSize(std::max(nthreads, 1)), nb));
+    if (nthreads <= 1) {
+      for (mwSize b = 0; b < m; b += blocksize)
+        work(b, std::min(m, b + blocksize));
+      return;
+    }
+    std::atomic<mwSize> next(0);
+    std::vector<std::exception_ptr> errs(nthreads);
+    GeographicLib::Executor::Current().Run
+      (nthreads, [&](int t) -> void {
+        try {
+          for (mwSize b; (b = next++) < nb;)
+            work(b * blocksize, std::min(m, (b + 1) * blocksize));
+        }
+        catch (...) { errs[t] = std::current_exception(); }
+      });
+    for (auto& e : errs)
+      if (e) std::rethrow_exception(e);
+  }
+
+  // Return the real scalar argument arg; mexErrMsgTxt is called with msg if
+  // it isn't one.
+  inline double scalar(const mxArray* arg, const char* msg) {
+    if (!( mxIsDouble(arg) && !mxIsComplex(arg) &&
+           mxGetNumberOfElements(arg) == 1 ))
+      mexErrMsgTxt(msg);
+    return mxGetScalar(arg);
+  }
+
+  // Return a matrix of doubles with m rows and the given number of columns
+  // from the argument arg; mexErrMsgTxt is called if it isn't one.
+  inline const double* matrix(const mxArray* arg, mwSize cols,
+                              const char* msg) {
+    if (!( mxIsDouble(arg) && !mxIsComplex(arg) && mxGetN(arg) == cols ))
+      mexErrMsgTxt(msg);
+    return mxGetPr(arg);
+  }
+
+} // namespace geographiclibmex
+
+#endif  // GEOGRAPHICLIBMEX_HPP
@@ -0,0 +1,80 @@
+/**
+ * \file geoidheight.cpp
+ * \brief Matlab mex file for evaluating geoid heights
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+// Compile in Matlab with
+// [Unix]
+// mex -I/usr/local/include -L/usr/local/lib -Wl,-rpath=/usr/local/lib
+//    -lGeographicLib geoidheight.cpp
+// [Windows]
+// mex -I../include -L../windows/Release
+//    -lGeographicLib geoidheight.cpp
+
+#include <string>
+#include <GeographicLib/Geoid.hpp>
+#include "geographiclibmex.hpp"
+
+using namespace std;
+using namespace GeographicLib;
+
+// Return the string argument arg; mexErrMsgTxt is called with msg if it
+// isn't one.
+static string stringarg(const mxArray* arg, const char* msg) {
+  if (!mxIsChar(arg))
+    mexErrMsgTxt(msg);
+  char* s = mxArrayToString(arg);
+  string r(s);
+  mxFree(s);
+  return r;
+}
+
+void mexFunction( int nlhs, mxArray* plhs[],
+                  int nrhs, const mxArray* prhs[] ) {
+
+  if (nrhs < 1)
+    mexErrMsgTxt("One input argument required.");
+  else if (nrhs > 4)
+    mexErrMsgTxt("More than four input arguments specified.");
+  else if (nlhs > 1)
+    mexErrMsgTxt("More than one output argument specified.");
+
+  const double* latlong = geographiclibmex::matrix
+    (prhs[0], 2, "latlong coordinates must be M x 2 matrix of doubles.");
+
+  string name = "egm96-5", dir;
+  int nthreads = 1;
+  if (nrhs >= 2)
+    name = stringarg(prhs[1], "Geoid name is not a string.");
+  if (nrhs >= 3)
+    dir = stringarg(prhs[2], "Geoid directory is not a string.");
+  if (nrhs == 4)
+    nthreads = int(geographiclibmex::scalar
+                   (prhs[3], "Number of threads is not a real scalar."));
+
+  mwSize m = mxGetM(prhs[0]);
+
+  double* h = mxGetPr(plhs[0] = mxCreateDoubleMatrix(m, 1, mxREAL));
+
+  try {
+    // The geoid data is read into memory if it's to be shared by several
+    // threads.
+    const Geoid g(name, dir, true, nthreads > 1);
+    if (nthreads > 1)
+      geographiclibmex::blocks
+        (m, nthreads, [&](mwSize b, mwSize e) -> void {
+          g(e - b, latlong + b, latlong + m + b, h + b);
+        });
+    else
+      // The array version of operator() visits the points in the order of
+      // the data in the file, so pass all the points at once.
+      g(m, latlong, latlong + m, h);
+  }
+  catch (const std::exception& e) {
+    mexErrMsgTxt(e.what());
+  }
+}
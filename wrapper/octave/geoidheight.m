@@ -0,0 +1,25 @@
+function geoidheight(~, ~, ~, ~)
+%geoidheight  Evaluate the height of the geoid
+%
+%   h = geoidheight(latlong)
+%   h = geoidheight(latlong, name)
+%   h = geoidheight(latlong, name, dir)
+%   h = geoidheight(latlong, name, dir, nthreads)
+%
+%   latlong is an M x 2 matrix
+%       latitude = latlong(:,1) in degrees
+%       longitude = latlong(:,2) in degrees
+%
+%   h is an M x 1 matrix of the heights of the geoid above the ellipsoid
+%   in meters.
+%
+%   name = the name of the geoid (default 'egm96-5')
+%   dir = the directory with the geoid data (default '', which means use
+%   the default directory)
+%   nthreads = the number of threads to use (default 1); if this is more
+%   than 1, the geoid data is read into memory.
+%
+% The heights are obtained by cubic interpolation.
+
+  error('Error: executing .m file instead of compiled routine');
+end
@@ -0,0 +1,72 @@
+/**
+ * \file tranmercforward.cpp
+ * \brief Matlab mex file for the forward transverse Mercator projection
+ *
+ * Copyright (c) Charles Karney (2026) <karney@alum.mit.edu> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+// Compile in Matlab with
+// [Unix]
+// mex -I/usr/local/include -L/usr/local/lib -Wl,-rpath=/usr/local/lib
+//    -lGeographicLib tranmercforward.cpp
+// [Windows]
+// mex -I../include -L../windows/Release
+//    -lGeographicLib tranmercforward.cpp
+
+#include <GeographicLib/TransverseMercator.hpp>
+#include "geographiclibmex.hpp"
+
+using namespace std;
+using namespace GeographicLib;
+
+void mexFunction( int nlhs, mxArray* plhs[],
+                  int nrhs, const mxArray* prhs[] ) {
+
+  if (nrhs < 2)
+    mexErrMsgTxt("Two input arguments required.");
+  else if (nrhs > 6)
+    mexErrMsgTxt("More than six input arguments specified.");
+  else if (nrhs == 3 || nrhs == 4)
+    mexErrMsgTxt("Must specify a, f, and k0 together.");
+  else if (nlhs > 2)
+    mexErrMsgTxt("More than two output arguments specified.");
+
+  const double* latlong = geographiclibmex::matrix
+    (prhs[0], 2, "latlong coordinates must be M x 2 matrix of doubles.");
+  double lon0 = geographiclibmex::scalar
+    (prhs[1], "Central meridian is not a real scalar.");
+
+  double a = Constants::WGS84_a<double>(), f = Constants::WGS84_f<double>(),
+    k0 = Constants::UTM_k0<double>();
+  int nthreads = 1;
+  if (nrhs >= 5) {
+    a = geographiclibmex::scalar
+      (prhs[2], "Equatorial radius is not a real scalar.");
+    f = geographiclibmex::scalar
+      (prhs[3], "Flattening is not a real scalar.");
+    k0 = geographiclibmex::scalar
+      (prhs[4], "Central scale is not a real scalar.");
+  }
+  if (nrhs == 6)
+    nthreads = int(geographiclibmex::scalar
+                   (prhs[5], "Number of threads is not a real scalar."));
+
+  mwSize m = mxGetM(prhs[0]);
+
+  double* xy = mxGetPr(plhs[0] = mxCreateDoubleMatrix(m, 2, mxREAL));
+
+  double* aux =
+    nlhs == 2 ? mxGetPr(plhs[1] = mxCreateDoubleMatrix(m, 2, mxREAL)) :
+    NULL;
+
+  try {
+    const TransverseMercator tm(a, f, k0);
+    tm.Forward(lon0, m, latlong, latlong + m, xy, xy + m,
+               aux, aux ? aux + m : NULL, nthreads);
+  }
+  catch (const std::exception& e) {
+    mexErrMsgTxt(e.what());
+  }
+}
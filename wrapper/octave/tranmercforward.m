@@ -0,0 +1,30 @@
+function tranmercforward(~, ~, ~, ~, ~, ~)
+%tranmercforward  Forward transverse Mercator projection
+%
+%   [xy, aux] = tranmercforward(latlong, lon0)
+%   [xy, aux] = tranmercforward(latlong, lon0, a, f, k0)
+%   [xy, aux] = tranmercforward(latlong, lon0, a, f, k0, nthreads)
+%
+%   latlong is an M x 2 matrix
+%       latitude = latlong(:,1) in degrees
+%       longitude = latlong(:,2) in degrees
+%   lon0 = central meridian in degrees
+%
+%   xy is an M x 2 matrix
+%       easting = xy(:,1) in meters
+%       northing = xy(:,2) in meters
+%   aux is an M x 2 matrix
+%       meridian convergence = aux(:,1) in degrees
+%       scale = aux(:,2)
+%
+%   a = equatorial radius (meters)
+%   f = flattening (0 means a sphere)
+%   k0 = central scale
+%   If a, f, and k0 are omitted, the WGS84 values and the UTM scale are
+%   used.
+%   nthreads = the number of threads to use (default 1)
+%
+% See also TRANMERCREVERSE.
+
+  error('Error: executing .m file instead of compiled routine');
+end
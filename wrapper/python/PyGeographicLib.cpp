@@ -1,21 +1,338 @@
 #include <boost/python.hpp>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 #include <GeographicLib/Geoid.hpp>
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/GravityModel.hpp>
+#include <GeographicLib/TransverseMercator.hpp>
+#include <GeographicLib/UTMUPS.hpp>
 
 using namespace boost::python;
 using namespace GeographicLib;
 
+static_assert(sizeof(Math::real) == sizeof(double),
+              "PyGeographicLib requires GEOGRAPHICLIB_PRECISION = 2");
+
 double EllipsoidHeight(Geoid& geoid,
                        double lat, double lon, double hmsl) {
   return hmsl + Geoid::GEOIDTOELLIPSOID * geoid(lat, lon);
 }
 
+// The array functions accept any object which exports a contiguous buffer of
+// doubles (e.g., a numpy array of dtype float64 or an array.array('d')) and
+// read it in place.  Other sequences of numbers (e.g., lists) are copied.
+// The results are returned as array.array('d') objects which numpy.asarray
+// wraps without copying.  The computation is carried out with the GIL
+// released.
+
+class InArray {
+private:
+  Py_buffer _view;
+  bool _buffer;
+  std::vector<double> _copy;
+public:
+  explicit InArray(const object& obj) : _buffer(false) {
+    PyObject* p = obj.ptr();
+    if (PyObject_CheckBuffer(p) &&
+        PyObject_GetBuffer(p, &_view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT)
+        == 0) {
+      if (_view.itemsize == sizeof(double) && _view.format &&
+          std::string(_view.format) == "d") {
+        _buffer = true;
+        return;
+      }
+      PyBuffer_Release(&_view);
+    } else
+      PyErr_Clear();
+    stl_input_iterator<double> b(obj), e;
+    _copy.assign(b, e);
+  }
+  ~InArray() { if (_buffer) PyBuffer_Release(&_view); }
+  InArray(const InArray&) = delete;
+  InArray& operator=(const InArray&) = delete;
+  size_t size() const
+  { return _buffer ? size_t(_view.len) / sizeof(double) : _copy.size(); }
+  const double* data() const
+  { return _buffer ? static_cast<const double*>(_view.buf) : _copy.data(); }
+};
+
+class OutArray {
+private:
+  object _obj;
+  Py_buffer _view;
+public:
+  explicit OutArray(size_t n) {
+    object array = import("array").attr("array");
+    _obj = n ? array("d", make_tuple(0.0)) * n : array("d");
+    if (PyObject_GetBuffer(_obj.ptr(), &_view, PyBUF_WRITABLE) != 0)
+      throw_error_already_set();
+  }
+  ~OutArray() { PyBuffer_Release(&_view); }
+  OutArray(const OutArray&) = delete;
+  OutArray& operator=(const OutArray&) = delete;
+  double* data() { return static_cast<double*>(_view.buf); }
+  const object& obj() const { return _obj; }
+};
+
+// Release the GIL for the lifetime of the object; it is reacquired before an
+// exception propagates back to boost-python.
+class NoGIL {
+private:
+  PyThreadState* _state;
+public:
+  NoGIL() : _state(PyEval_SaveThread()) {}
+  ~NoGIL() { PyEval_RestoreThread(_state); }
+  NoGIL(const NoGIL&) = delete;
+  NoGIL& operator=(const NoGIL&) = delete;
+};
+
+size_t CommonSize(const InArray& a, const InArray& b) {
+  if (a.size() != b.size())
+    throw GeographicErr("Input arrays must have the same length");
+  return a.size();
+}
+
+size_t CommonSize(const InArray& a, const InArray& b, const InArray& c) {
+  CommonSize(a, b);
+  return CommonSize(b, c);
+}
+
+size_t CommonSize(const InArray& a, const InArray& b,
+                  const InArray& c, const InArray& d) {
+  CommonSize(a, b, c);
+  return CommonSize(c, d);
+}
+
+// Call work(b, e) for blocks [b, e) covering [0, n) on nthreads threads.
+// This is only used for classes whose const member functions are thread
+// safe.
+template<class F> void Blocks(size_t n, int nthreads, F work) {
+  const size_t block = 1024;
+  if (nthreads <= 1 || n <= block) {
+    work(size_t(0), n);
+    return;
+  }
+  size_t nblocks = (n + block - 1) / block,
+    nt = std::min(size_t(nthreads), nblocks);
+  std::vector<std::exception_ptr> err(nt);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < nt; ++t)
+    threads.emplace_back([&, t]() {
+      try {
+        for (size_t i = t; i < nblocks; i += nt)
+          work(i * block, std::min(n, (i + 1) * block));
+      }
+      catch (...) {
+        err[t] = std::current_exception();
+      }
+    });
+  for (auto& th : threads) th.join();
+  for (auto& e : err)
+    if (e) std::rethrow_exception(e);
+}
+
+tuple GeodesicInverse(const Geodesic& g,
+                      const object& lat1, const object& lon1,
+                      const object& lat2, const object& lon2,
+                      int nthreads) {
+  InArray la1(lat1), lo1(lon1), la2(lat2), lo2(lon2);
+  size_t n = CommonSize(la1, lo1, la2, lo2);
+  OutArray s12(n), azi1(n), azi2(n);
+  {
+    NoGIL nogil;
+    Blocks(n, nthreads, [&](size_t b, size_t e) {
+      g.GenInverse(e - b,
+                   la1.data() + b, lo1.data() + b,
+                   la2.data() + b, lo2.data() + b,
+                   Geodesic::DISTANCE | Geodesic::AZIMUTH,
+                   s12.data() + b, azi1.data() + b, azi2.data() + b,
+                   nullptr, nullptr, nullptr, nullptr);
+    });
+  }
+  return make_tuple(s12.obj(), azi1.obj(), azi2.obj());
+}
+
+tuple GeodesicDirect(const Geodesic& g,
+                     const object& lat1, const object& lon1,
+                     const object& azi1, const object& s12,
+                     int nthreads) {
+  InArray la1(lat1), lo1(lon1), az1(azi1), s(s12);
+  size_t n = CommonSize(la1, lo1, az1, s);
+  OutArray lat2(n), lon2(n), azi2(n);
+  {
+    NoGIL nogil;
+    Blocks(n, nthreads, [&](size_t b, size_t e) {
+      for (size_t i = b; i < e; ++i)
+        g.Direct(la1.data()[i], lo1.data()[i], az1.data()[i], s.data()[i],
+                 lat2.data()[i], lon2.data()[i], azi2.data()[i]);
+    });
+  }
+  return make_tuple(lat2.obj(), lon2.obj(), azi2.obj());
+}
+
+tuple TMForward(const TransverseMercator& tm, double lon0,
+                const object& lat, const object& lon, int nthreads) {
+  InArray la(lat), lo(lon);
+  size_t n = CommonSize(la, lo);
+  OutArray x(n), y(n), gamma(n), k(n);
+  {
+    NoGIL nogil;
+    tm.Forward(lon0, n, la.data(), lo.data(), x.data(), y.data(),
+               gamma.data(), k.data(), nthreads);
+  }
+  return make_tuple(x.obj(), y.obj(), gamma.obj(), k.obj());
+}
+
+tuple TMReverse(const TransverseMercator& tm, double lon0,
+                const object& x, const object& y, int nthreads) {
+  InArray xa(x), ya(y);
+  size_t n = CommonSize(xa, ya);
+  OutArray lat(n), lon(n), gamma(n), k(n);
+  {
+    NoGIL nogil;
+    tm.Reverse(lon0, n, xa.data(), ya.data(), lat.data(), lon.data(),
+               gamma.data(), k.data(), nthreads);
+  }
+  return make_tuple(lat.obj(), lon.obj(), gamma.obj(), k.obj());
+}
+
+tuple UTMUPSForward(const object& lat, const object& lon, int nthreads) {
+  InArray la(lat), lo(lon);
+  size_t n = CommonSize(la, lo);
+  OutArray x(n), y(n);
+  std::vector<int> zone(n);
+  // std::vector<bool> doesn't provide a bool array
+  std::unique_ptr<bool[]> northp(new bool[n]);
+  {
+    NoGIL nogil;
+    UTMUPS::Forward(n, la.data(), lo.data(), zone.data(), northp.get(),
+                    x.data(), y.data(), nullptr, nullptr,
+                    UTMUPS::STANDARD, false, nthreads);
+  }
+  list zones, norths;
+  for (size_t i = 0; i < n; ++i) {
+    zones.append(zone[i]); norths.append(northp[i]);
+  }
+  return make_tuple(zones, norths, x.obj(), y.obj());
+}
+
+object GeoidHeights(const Geoid& geoid,
+                    const object& lat, const object& lon) {
+  InArray la(lat), lo(lon);
+  size_t n = CommonSize(la, lo);
+  OutArray h(n);
+  {
+    // Geoid reads the data file and so is not split over threads
+    NoGIL nogil;
+    geoid(n, la.data(), lo.data(), h.data());
+  }
+  return h.obj();
+}
+
+tuple GravityArray(const GravityModel& grav,
+                   const object& lat, const object& lon, const object& h,
+                   int nthreads) {
+  InArray la(lat), lo(lon), ha(h);
+  size_t n = CommonSize(la, lo, ha);
+  OutArray W(n), gx(n), gy(n), gz(n);
+  {
+    NoGIL nogil;
+    Blocks(n, nthreads, [&](size_t b, size_t e) {
+      grav.Gravity(e - b, la.data() + b, lo.data() + b, ha.data() + b,
+                   W.data() + b, gx.data() + b, gy.data() + b, gz.data() + b);
+    });
+  }
+  return make_tuple(W.obj(), gx.obj(), gy.obj(), gz.obj());
+}
+
+object GeoidHeightArray(const GravityModel& grav,
+                        const object& lat, const object& lon, int nthreads) {
+  InArray la(lat), lo(lon);
+  size_t n = CommonSize(la, lo);
+  OutArray N(n);
+  {
+    NoGIL nogil;
+    Blocks(n, nthreads, [&](size_t b, size_t e) {
+      for (size_t i = b; i < e; ++i)
+        N.data()[i] = grav.GeoidHeight(la.data()[i], lo.data()[i]);
+    });
+  }
+  return N.obj();
+}
+
+void TranslateGeographicErr(const GeographicErr& e) {
+  PyErr_SetString(PyExc_ValueError, e.what());
+}
+
 BOOST_PYTHON_MODULE(PyGeographicLib) {
 
+  register_exception_translator<GeographicErr>(&TranslateGeographicErr);
+
   class_<Geoid, boost::noncopyable>("Geoid", init<std::string>())
+    .def(init<std::string, std::string, bool, bool>())
     .def("EllipsoidHeight", &EllipsoidHeight,
          "Return geoid height:\n\
     input: lat, lon, height_above_geoid\n\
     output: height_above_ellipsoid")
+    .def("Height", &GeoidHeights,
+         "Return geoid heights for arrays of points:\n\
+    input: lat[], lon[]\n\
+    output: geoid_height[]")
+    ;
+
+  class_<Geodesic>("Geodesic", init<double, double>())
+    .def("Inverse", &GeodesicInverse,
+         (arg("lat1"), arg("lon1"), arg("lat2"), arg("lon2"),
+          arg("nthreads") = 1),
+         "Solve the inverse geodesic problem for arrays of points:\n\
+    input: lat1[], lon1[], lat2[], lon2[], nthreads=1\n\
+    output: (s12[], azi1[], azi2[])")
+    .def("Direct", &GeodesicDirect,
+         (arg("lat1"), arg("lon1"), arg("azi1"), arg("s12"),
+          arg("nthreads") = 1),
+         "Solve the direct geodesic problem for arrays of points:\n\
+    input: lat1[], lon1[], azi1[], s12[], nthreads=1\n\
+    output: (lat2[], lon2[], azi2[])")
+    ;
+
+  class_<TransverseMercator>("TransverseMercator",
+                             init<double, double, double>())
+    .def(init<double, double, double, bool, bool>())
+    .def("Forward", &TMForward,
+         (arg("lon0"), arg("lat"), arg("lon"), arg("nthreads") = 1),
+         "Forward projection for arrays of points:\n\
+    input: lon0, lat[], lon[], nthreads=1\n\
+    output: (x[], y[], gamma[], k[])")
+    .def("Reverse", &TMReverse,
+         (arg("lon0"), arg("x"), arg("y"), arg("nthreads") = 1),
+         "Reverse projection for arrays of points:\n\
+    input: lon0, x[], y[], nthreads=1\n\
+    output: (lat[], lon[], gamma[], k[])")
+    ;
+
+  def("UTMUPSForward", &UTMUPSForward,
+      (arg("lat"), arg("lon"), arg("nthreads") = 1),
+      "Convert arrays of points to UTM/UPS:\n\
+    input: lat[], lon[], nthreads=1\n\
+    output: (zone list, northp list, x[], y[])");
+
+  class_<GravityModel, boost::noncopyable>("GravityModel",
+                                           init<std::string>())
+    .def(init<std::string, std::string>())
+    .def(init<std::string, std::string, int, int>())
+    .def("Gravity", &GravityArray,
+         (arg("lat"), arg("lon"), arg("h"), arg("nthreads") = 1),
+         "Return the gravity for arrays of points:\n\
+    input: lat[], lon[], h[], nthreads=1\n\
+    output: (W[], gx[], gy[], gz[])")
+    .def("GeoidHeight", &GeoidHeightArray,
+         (arg("lat"), arg("lon"), arg("nthreads") = 1),
+         "Return the geoid height for arrays of points:\n\
+    input: lat[], lon[], nthreads=1\n\
+    output: geoid_height[]")
     ;
 
 }